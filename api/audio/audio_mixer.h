@@ -13,6 +13,7 @@
 
 #include <memory>
 
+#include "webrtc/base/optional.h"
 #include "webrtc/base/refcount.h"
 #include "webrtc/modules/include/module_common_types.h"
 
@@ -48,6 +49,21 @@ class AudioMixer : public rtc::RefCountInterface {
     // with this sample rate or higher will not cause quality loss.
     virtual int PreferredSampleRate() const = 0;
 
+    // The level of the audio this source is about to produce, in -dBov (0 is
+    // the loudest and 127 silence) as signalled by the sender in the RTP
+    // audio level header extension, if known. Lets the mixer rank sources
+    // without getting their audio.
+    virtual rtc::Optional<int> AudioLevelDbov() const {
+      return rtc::Optional<int>();
+    }
+
+    // Called instead of GetAudioFrameWithInfo when the audio of this source
+    // won't be mixed. The source must still advance its playout, but may skip
+    // the work that only matters for the mix. |audio_frame| is scratch space.
+    virtual void SkipAudioFrame(int sample_rate_hz, AudioFrame* audio_frame) {
+      GetAudioFrameWithInfo(sample_rate_hz, audio_frame);
+    }
+
     virtual ~Source() {}
   };
 
@@ -0,0 +1,36 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_API_CALL_AUDIO_LEVEL_SINK_H_
+#define WEBRTC_API_CALL_AUDIO_LEVEL_SINK_H_
+
+#include <stdint.h>
+
+namespace webrtc {
+
+// Receives the audio levels signaled in the RTP audio level header extension
+// (RFC 6464) of received packets. It is called on the packet receive path,
+// before and independently of decoding, so it works also for streams that
+// are never decoded. Implementations must be thread safe and cheap.
+class AudioLevelSinkInterface {
+ public:
+  virtual ~AudioLevelSinkInterface() {}
+
+  // |level_dbov| is the level of the audio in the packet in -dBov, from 0
+  // (loudest) to 127 (silence). |voice_activity| is the V bit of the
+  // extension, which is only meaningful if the sender sets it.
+  virtual void OnAudioLevel(uint32_t ssrc,
+                            uint8_t level_dbov,
+                            bool voice_activity) = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_API_CALL_AUDIO_LEVEL_SINK_H_
@@ -11,6 +11,7 @@
 #include "webrtc/api/mediacontroller.h"
 
 #include <memory>
+#include <utility>
 
 #include "webrtc/base/bind.h"
 #include "webrtc/base/checks.h"
@@ -31,13 +32,16 @@ class MediaController : public webrtc::MediaControllerInterface,
   MediaController(const cricket::MediaConfig& media_config,
                   rtc::Thread* worker_thread,
                   cricket::ChannelManager* channel_manager,
-                  webrtc::RtcEventLog* event_log)
+                  webrtc::RtcEventLog* event_log,
+                  rtc::scoped_refptr<webrtc::SharedProcessThreads>
+                      shared_process_threads)
       : worker_thread_(worker_thread),
         media_config_(media_config),
         channel_manager_(channel_manager),
         call_config_(event_log) {
     RTC_DCHECK(worker_thread);
     RTC_DCHECK(event_log);
+    call_config_.shared_process_threads = std::move(shared_process_threads);
     worker_thread_->Invoke<void>(RTC_FROM_HERE,
                                  rtc::Bind(&MediaController::Construct_w, this,
                                            channel_manager_->media_engine()));
@@ -93,7 +97,9 @@ MediaControllerInterface* MediaControllerInterface::Create(
     const cricket::MediaConfig& config,
     rtc::Thread* worker_thread,
     cricket::ChannelManager* channel_manager,
-    webrtc::RtcEventLog* event_log) {
-  return new MediaController(config, worker_thread, channel_manager, event_log);
+    webrtc::RtcEventLog* event_log,
+    rtc::scoped_refptr<SharedProcessThreads> shared_process_threads) {
+  return new MediaController(config, worker_thread, channel_manager, event_log,
+                             std::move(shared_process_threads));
 }
 }  // namespace webrtc
@@ -11,6 +11,7 @@
 #ifndef WEBRTC_API_MEDIACONTROLLER_H_
 #define WEBRTC_API_MEDIACONTROLLER_H_
 
+#include "webrtc/base/scoped_ref_ptr.h"
 #include "webrtc/base/thread.h"
 
 namespace cricket {
@@ -22,16 +23,21 @@ namespace webrtc {
 class Call;
 class VoiceEngine;
 class RtcEventLog;
+class SharedProcessThreads;
 
 // The MediaController currently owns shared state between media channels, but
 // in the future will create and own RtpSenders and RtpReceivers.
 class MediaControllerInterface {
  public:
+  // |shared_process_threads| is optional, see
+  // Call::Config::shared_process_threads.
   static MediaControllerInterface* Create(
       const cricket::MediaConfig& config,
       rtc::Thread* worker_thread,
       cricket::ChannelManager* channel_manager,
-      webrtc::RtcEventLog* event_log);
+      webrtc::RtcEventLog* event_log,
+      rtc::scoped_refptr<SharedProcessThreads> shared_process_threads =
+          nullptr);
 
   virtual ~MediaControllerInterface() {}
   virtual void Close() = 0;
@@ -504,6 +504,8 @@ bool PeerConnectionInterface::RTCConfiguration::operator==(
     bool presume_writable_when_fully_relayed;
     bool enable_ice_renomination;
     bool redetermine_role_on_ice_restart;
+    bool sctp_bulk_transfer;
+    int sctp_bulk_buffer_size;
     std::string media_crypto_key;
   };
   static_assert(sizeof(stuff_being_tested_for_equality) == sizeof(*this),
@@ -537,6 +539,8 @@ bool PeerConnectionInterface::RTCConfiguration::operator==(
              o.presume_writable_when_fully_relayed &&
          enable_ice_renomination == o.enable_ice_renomination &&
          redetermine_role_on_ice_restart == o.redetermine_role_on_ice_restart &&
+         sctp_bulk_transfer == o.sctp_bulk_transfer &&
+         sctp_bulk_buffer_size == o.sctp_bulk_buffer_size &&
          media_crypto_key == o.media_crypto_key;
 }
 
@@ -752,6 +756,15 @@ bool PeerConnection::Initialize(
   media_controller_.reset(factory_->CreateMediaController(
       configuration.media_config, event_log_.get()));
 
+#ifdef HAVE_SCTP
+  cricket::SctpOptions sctp_options;
+  if (configuration.sctp_bulk_transfer) {
+    sctp_options.send_buffer_size = configuration.sctp_bulk_buffer_size;
+    sctp_options.receive_buffer_size = configuration.sctp_bulk_buffer_size;
+    sctp_options.coalesce_sends = true;
+  }
+#endif
+
   session_.reset(new WebRtcSession(
       media_controller_.get(), factory_->network_thread(),
       factory_->worker_thread(), factory_->signaling_thread(),
@@ -762,7 +775,8 @@ bool PeerConnection::Initialize(
               configuration.redetermine_role_on_ice_restart)),
 #ifdef HAVE_SCTP
       std::unique_ptr<cricket::SctpTransportInternalFactory>(
-          new cricket::SctpTransportFactory(factory_->network_thread()))
+          new cricket::SctpTransportFactory(factory_->network_thread(),
+                                            sctp_options))
 #else
       nullptr
 #endif
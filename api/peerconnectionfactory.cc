@@ -10,6 +10,7 @@
 
 #include "webrtc/api/peerconnectionfactory.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "webrtc/api/audiotrack.h"
@@ -33,6 +34,7 @@
 #include "webrtc/modules/audio_device/include/audio_device.h"
 #include "webrtc/p2p/base/basicpacketsocketfactory.h"
 #include "webrtc/p2p/client/basicportallocator.h"
+#include "webrtc/system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
@@ -136,6 +138,12 @@ PeerConnectionFactory::PeerConnectionFactory(
 PeerConnectionFactory::~PeerConnectionFactory() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
   channel_manager_.reset(nullptr);
+  if (shared_process_threads_) {
+    // The PeerConnections, and with them their Calls, are gone, so this is the
+    // last reference. The threads must be stopped on the worker thread.
+    worker_thread_->Invoke<void>(RTC_FROM_HERE,
+                                 [this] { shared_process_threads_ = nullptr; });
+  }
 
   // Make sure |worker_thread_| and |signaling_thread_| outlive
   // |default_socket_factory_| and |default_network_manager_|.
@@ -181,6 +189,13 @@ bool PeerConnectionFactory::Initialize() {
     return false;
   }
 
+  if (webrtc::field_trial::FindFullName("WebRTC-SharedProcessThreads") ==
+      "Enabled") {
+    shared_process_threads_ =
+        worker_thread_->Invoke<rtc::scoped_refptr<SharedProcessThreads>>(
+            RTC_FROM_HERE, &SharedProcessThreads::Create);
+  }
+
   return true;
 }
 
@@ -189,6 +204,18 @@ void PeerConnectionFactory::SetOptions(const Options& options) {
   if (channel_manager_) {
     channel_manager_->SetCryptoOptions(options.crypto_options);
   }
+  size_t pool_size =
+      static_cast<size_t>(std::max(options.certificate_pool_size, 0));
+  if (pool_size == 0) {
+    certificate_pool_ = nullptr;
+  } else if (!certificate_pool_ || certificate_pool_->size() != pool_size) {
+    // Pool the certificates the default generator would create, on the same
+    // thread.
+    certificate_pool_ = rtc::RTCCertificatePool::Create(
+        network_thread_, rtc::KeyParams(), pool_size);
+  }
+  if (options.enable_dtls_session_resumption && !ssl_session_cache_)
+    ssl_session_cache_ = rtc::SSLSessionCache::Create();
 }
 
 rtc::scoped_refptr<AudioSourceInterface>
@@ -267,8 +294,8 @@ PeerConnectionFactory::CreatePeerConnection(
 
   if (!cert_generator.get()) {
     // No certificate generator specified, use the default one.
-    cert_generator.reset(
-        new rtc::RTCCertificateGenerator(signaling_thread_, network_thread_));
+    cert_generator.reset(new rtc::RTCCertificateGenerator(
+        signaling_thread_, network_thread_, certificate_pool_));
   }
 
   if (!allocator) {
@@ -318,16 +345,21 @@ webrtc::MediaControllerInterface* PeerConnectionFactory::CreateMediaController(
     webrtc::RtcEventLog* event_log) const {
   RTC_DCHECK(signaling_thread_->IsCurrent());
   return MediaControllerInterface::Create(config, worker_thread_,
-                                          channel_manager_.get(), event_log);
+                                          channel_manager_.get(), event_log,
+                                          shared_process_threads_);
 }
 
 cricket::TransportController* PeerConnectionFactory::CreateTransportController(
     cricket::PortAllocator* port_allocator,
     bool redetermine_role_on_ice_restart) {
   RTC_DCHECK(signaling_thread_->IsCurrent());
-  return new cricket::TransportController(signaling_thread_, network_thread_,
-                                          port_allocator,
-                                          redetermine_role_on_ice_restart);
+  cricket::TransportController* transport_controller =
+      new cricket::TransportController(signaling_thread_, network_thread_,
+                                       port_allocator,
+                                       redetermine_role_on_ice_restart);
+  if (options_.enable_dtls_session_resumption)
+    transport_controller->SetSslSessionCache(ssl_session_cache_.get());
+  return transport_controller;
 }
 
 rtc::Thread* PeerConnectionFactory::signaling_thread() {
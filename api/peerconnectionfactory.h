@@ -20,6 +20,9 @@
 #include "webrtc/base/scoped_ref_ptr.h"
 #include "webrtc/base/thread.h"
 #include "webrtc/base/rtccertificategenerator.h"
+#include "webrtc/base/rtccertificatepool.h"
+#include "webrtc/base/sslstreamadapter.h"
+#include "webrtc/call/shared_process_threads.h"
 #include "webrtc/pc/channelmanager.h"
 
 namespace rtc {
@@ -124,10 +127,19 @@ class PeerConnectionFactory : public PeerConnectionFactoryInterface {
   rtc::Thread* worker_thread_;
   rtc::Thread* signaling_thread_;
   Options options_;
+  // Set when |options_| enable the certificate pool.
+  rtc::scoped_refptr<rtc::RTCCertificatePool> certificate_pool_;
+  // Set once |options_| enable DTLS session resumption. Outlives the
+  // transport controllers since PeerConnections reference the factory.
+  std::unique_ptr<rtc::SSLSessionCache> ssl_session_cache_;
   // External Audio device used for audio playback.
   rtc::scoped_refptr<AudioDeviceModule> default_adm_;
   rtc::scoped_refptr<AudioDecoderFactory> audio_decoder_factory_;
   std::unique_ptr<cricket::ChannelManager> channel_manager_;
+  // Process threads shared by the Calls of all PeerConnections, set if the
+  // WebRTC-SharedProcessThreads field trial is enabled. Created and released
+  // on |worker_thread_|.
+  rtc::scoped_refptr<SharedProcessThreads> shared_process_threads_;
   // External Video encoder factory. This can be NULL if the client has not
   // injected any. In that case, video engine will use the internal SW encoder.
   std::unique_ptr<cricket::WebRtcVideoEncoderFactory> video_encoder_factory_;
@@ -347,6 +347,9 @@ class PeerConnectionInterface : public rtc::RefCountInterface {
     static const int kAudioJitterBufferMaxPackets = 50;
     // ICE connection receiving timeout for aggressive configuration.
     static const int kAggressiveIceConnectionReceivingTimeout = 1000;
+    // SCTP buffer size in bulk-transfer mode, enough for ~300 Mbps at a
+    // 100 ms round trip time.
+    static const int kDefaultSctpBulkBufferSize = 4 * 1024 * 1024;
     // TODO(pthatcher): Rename this ice_transport_type, but update
     // Chromium at the same time.
     IceTransportsType type = kAll;
@@ -386,6 +389,12 @@ class PeerConnectionInterface : public rtc::RefCountInterface {
     // If true, ICE role is redetermined when peerconnection sets a local
     // transport description that indicates an ICE restart.
     bool redetermine_role_on_ice_restart = true;
+    // If true, SCTP data channels are set up for bulk transfers: the SCTP
+    // send and receive buffers, which bound the window, are enlarged to
+    // |sctp_bulk_buffer_size| bytes and small messages are bundled into full
+    // packets at the cost of latency.
+    bool sctp_bulk_transfer = false;
+    int sctp_bulk_buffer_size = kDefaultSctpBulkBufferSize;
     // End to end media encryption key
     std::string media_crypto_key;
     //
@@ -736,7 +745,9 @@ class PeerConnectionFactoryInterface : public rtc::RefCountInterface {
           disable_network_monitor(false),
           network_ignore_mask(rtc::kDefaultNetworkIgnoreMask),
           ssl_max_version(rtc::SSL_PROTOCOL_DTLS_12),
-          crypto_options(rtc::CryptoOptions::NoGcm()) {}
+          crypto_options(rtc::CryptoOptions::NoGcm()),
+          certificate_pool_size(0),
+          enable_dtls_session_resumption(false) {}
     bool disable_encryption;
     bool disable_sctp_data_channels;
     bool disable_network_monitor;
@@ -753,6 +764,18 @@ class PeerConnectionFactoryInterface : public rtc::RefCountInterface {
 
     // Sets crypto related options, e.g. enabled cipher suites.
     rtc::CryptoOptions crypto_options;
+
+    // Number of DTLS certificates to generate ahead of time, so that
+    // PeerConnections created in a burst don't each wait for key generation.
+    // Only used by PeerConnections created without a certificate generator.
+    // 0 disables the pool.
+    int certificate_pool_size;
+
+    // Lets PeerConnections created after this is set resume the DTLS sessions
+    // of earlier ones with the same peer, which saves a round trip and the
+    // public key operations when reconnecting. Sessions are only resumed
+    // between the same pair of certificates.
+    bool enable_dtls_session_resumption;
   };
 
   virtual void SetOptions(const Options& options) = 0;
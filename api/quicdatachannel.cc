@@ -129,9 +129,10 @@ bool QuicDataChannel::Send_n(const DataBuffer& buffer) {
 
   // If the message is not empty, then send the message with a FIN.
   bool message_fin = true;
+  // The message is written from |buffer| without a copy, even if it has to
+  // wait for the flow control window.
   rtc::StreamResult message_result =
-      header_fin ? header_result : stream->Write(buffer.data.data<char>(),
-                                                 buffer.size(), message_fin);
+      header_fin ? header_result : stream->Write(buffer.data, message_fin);
 
   if (message_result == rtc::SR_SUCCESS) {
     // The message is sent and we don't need this QUIC stream.
@@ -151,7 +152,7 @@ bool QuicDataChannel::Send_n(const DataBuffer& buffer) {
     // will tell the QUIC stream to send more data.
     LOG(LS_INFO) << "Stream " << stream->id()
                  << " message is write blocked for QUIC data channel " << id_;
-    SetBufferedAmount_w(buffered_amount_ + stream->queued_data_bytes());
+    SetBufferedAmount_w(buffered_amount_ + stream->buffered_bytes());
     stream->SignalQueuedBytesWritten.connect(
         this, &QuicDataChannel::OnQueuedBytesWritten);
     write_blocked_quic_streams_[stream->id()] = stream;
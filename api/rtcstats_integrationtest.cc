@@ -546,6 +546,12 @@ class RTCStatsReportVerifier {
     } else {
       verifier.TestMemberIsUndefined(inbound_stream.frames_decoded);
     }
+    // The calls are not end to end encrypted.
+    verifier.TestMemberIsUndefined(inbound_stream.media_crypto_decrypt_time);
+    verifier.TestMemberIsUndefined(
+        inbound_stream.media_crypto_bytes_decrypted);
+    verifier.TestMemberIsUndefined(inbound_stream.media_crypto_auth_failures);
+    verifier.TestMemberIsUndefined(inbound_stream.media_crypto_replay_drops);
     return verifier.ExpectAllMembersSuccessfullyTested();
   }
 
@@ -570,6 +576,22 @@ class RTCStatsReportVerifier {
     } else {
       verifier.TestMemberIsUndefined(outbound_stream.frames_encoded);
     }
+    // Only defined for video once packets went through the stage.
+    verifier.MarkMemberTested(outbound_stream.pacer_queue_time_p50, true);
+    verifier.MarkMemberTested(outbound_stream.pacer_queue_time_p95, true);
+    verifier.MarkMemberTested(outbound_stream.pacer_queue_time_p99, true);
+    verifier.MarkMemberTested(outbound_stream.media_encrypt_time_p50, true);
+    verifier.MarkMemberTested(outbound_stream.media_encrypt_time_p95, true);
+    verifier.MarkMemberTested(outbound_stream.media_encrypt_time_p99, true);
+    verifier.MarkMemberTested(outbound_stream.send_delay_p50, true);
+    verifier.MarkMemberTested(outbound_stream.send_delay_p95, true);
+    verifier.MarkMemberTested(outbound_stream.send_delay_p99, true);
+    // The calls are not end to end encrypted.
+    verifier.TestMemberIsUndefined(outbound_stream.media_crypto_encrypt_time);
+    verifier.TestMemberIsUndefined(
+        outbound_stream.media_crypto_bytes_encrypted);
+    verifier.TestMemberIsUndefined(
+        outbound_stream.media_crypto_encrypt_failures);
     return verifier.ExpectAllMembersSuccessfullyTested();
   }
 
@@ -587,6 +609,28 @@ class RTCStatsReportVerifier {
         transport.local_certificate_id, RTCCertificateStats::kType);
     verifier.TestMemberIsIDReference(
         transport.remote_certificate_id, RTCCertificateStats::kType);
+    // The SRTP stats are only on the transports that carry SRTP.
+    if (transport.srtp_bytes_encrypted.is_defined()) {
+      verifier.TestMemberIsNonNegative<double>(transport.srtp_encrypt_time);
+      verifier.TestMemberIsNonNegative<double>(transport.srtp_decrypt_time);
+      verifier.TestMemberIsNonNegative<uint64_t>(
+          transport.srtp_bytes_encrypted);
+      verifier.TestMemberIsNonNegative<uint64_t>(
+          transport.srtp_bytes_decrypted);
+      verifier.TestMemberIsNonNegative<uint32_t>(
+          transport.srtp_encrypt_failures);
+      verifier.TestMemberIsNonNegative<uint32_t>(
+          transport.srtp_decrypt_failures);
+      verifier.TestMemberIsNonNegative<uint32_t>(transport.srtp_replay_drops);
+    } else {
+      verifier.TestMemberIsUndefined(transport.srtp_encrypt_time);
+      verifier.TestMemberIsUndefined(transport.srtp_decrypt_time);
+      verifier.TestMemberIsUndefined(transport.srtp_bytes_encrypted);
+      verifier.TestMemberIsUndefined(transport.srtp_bytes_decrypted);
+      verifier.TestMemberIsUndefined(transport.srtp_encrypt_failures);
+      verifier.TestMemberIsUndefined(transport.srtp_decrypt_failures);
+      verifier.TestMemberIsUndefined(transport.srtp_replay_drops);
+    }
     return verifier.ExpectAllMembersSuccessfullyTested();
   }
 
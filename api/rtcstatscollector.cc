@@ -219,6 +219,16 @@ void SetInboundRTPStreamStatsFromVideoReceiverInfo(
   inbound_video->nack_count =
       static_cast<uint32_t>(video_receiver_info.nacks_sent);
   inbound_video->frames_decoded = video_receiver_info.frames_decoded;
+  if (video_receiver_info.media_crypto) {
+    const MediaCryptoStats& media_crypto =
+        *video_receiver_info.media_crypto;
+    inbound_video->media_crypto_decrypt_time =
+        static_cast<double>(media_crypto.decrypt_time_ns) /
+        rtc::kNumNanosecsPerSec;
+    inbound_video->media_crypto_bytes_decrypted = media_crypto.bytes_decrypted;
+    inbound_video->media_crypto_auth_failures = media_crypto.auth_failures;
+    inbound_video->media_crypto_replay_drops = media_crypto.replay_drops;
+  }
 }
 
 // Provides the media independent counters (both audio and video).
@@ -251,6 +261,21 @@ void SetOutboundRTPStreamStatsFromVoiceSenderInfo(
   // purposefully left undefined for audio.
 }
 
+// Sets |p50|, |p95| and |p99| to |percentiles|, in seconds, unless they are
+// unknown. |units_per_second| is the number of units of |percentiles| in a
+// second.
+void SetLatencyPercentiles(const cricket::LatencyPercentiles& percentiles,
+                           double units_per_second,
+                           RTCStatsMember<double>* p50,
+                           RTCStatsMember<double>* p95,
+                           RTCStatsMember<double>* p99) {
+  if (percentiles.p50 < 0)
+    return;
+  *p50 = percentiles.p50 / units_per_second;
+  *p95 = percentiles.p95 / units_per_second;
+  *p99 = percentiles.p99 / units_per_second;
+}
+
 void SetOutboundRTPStreamStatsFromVideoSenderInfo(
     const cricket::VideoSenderInfo& video_sender_info,
     RTCOutboundRTPStreamStats* outbound_video) {
@@ -266,6 +291,31 @@ void SetOutboundRTPStreamStatsFromVideoSenderInfo(
   if (video_sender_info.qp_sum)
     outbound_video->qp_sum = *video_sender_info.qp_sum;
   outbound_video->frames_encoded = video_sender_info.frames_encoded;
+  SetLatencyPercentiles(video_sender_info.pacer_queue_time_ms,
+                        rtc::kNumMillisecsPerSec,
+                        &outbound_video->pacer_queue_time_p50,
+                        &outbound_video->pacer_queue_time_p95,
+                        &outbound_video->pacer_queue_time_p99);
+  SetLatencyPercentiles(video_sender_info.media_encryption_time_us,
+                        rtc::kNumMicrosecsPerSec,
+                        &outbound_video->media_encrypt_time_p50,
+                        &outbound_video->media_encrypt_time_p95,
+                        &outbound_video->media_encrypt_time_p99);
+  SetLatencyPercentiles(video_sender_info.send_delay_ms,
+                        rtc::kNumMillisecsPerSec,
+                        &outbound_video->send_delay_p50,
+                        &outbound_video->send_delay_p95,
+                        &outbound_video->send_delay_p99);
+  if (video_sender_info.media_crypto) {
+    const MediaCryptoStats& media_crypto =
+        *video_sender_info.media_crypto;
+    outbound_video->media_crypto_encrypt_time =
+        static_cast<double>(media_crypto.encrypt_time_ns) /
+        rtc::kNumNanosecsPerSec;
+    outbound_video->media_crypto_bytes_encrypted = media_crypto.bytes_encrypted;
+    outbound_video->media_crypto_encrypt_failures =
+        media_crypto.encrypt_failures;
+  }
 }
 
 void ProduceCertificateStatsFromSSLCertificateStats(
@@ -432,8 +482,10 @@ RTCStatsCollector::RTCStatsCollector(PeerConnection* pc,
       network_thread_(pc->session()->network_thread()),
       num_pending_partial_reports_(0),
       partial_report_timestamp_us_(0),
+      partial_report_categories_(0),
       cache_timestamp_us_(0),
-      cache_lifetime_us_(cache_lifetime_us) {
+      cache_lifetime_us_(cache_lifetime_us),
+      cached_report_categories_(0) {
   RTC_DCHECK(pc_);
   RTC_DCHECK(signaling_thread_);
   RTC_DCHECK(worker_thread_);
@@ -449,29 +501,68 @@ RTCStatsCollector::~RTCStatsCollector() {
 
 void RTCStatsCollector::GetStatsReport(
     rtc::scoped_refptr<RTCStatsCollectorCallback> callback) {
+  GetStatsReport(callback, kAllStats);
+}
+
+void RTCStatsCollector::GetStatsReport(
+    rtc::scoped_refptr<RTCStatsCollectorCallback> callback,
+    uint32_t categories) {
   RTC_DCHECK(signaling_thread_->IsCurrent());
   RTC_DCHECK(callback);
-  callbacks_.push_back(callback);
+  RTC_DCHECK(categories);
+  RTC_DCHECK_EQ(categories & ~kAllStats, 0u);
+  callbacks_.push_back(std::make_pair(callback, categories));
 
   // "Now" using a monotonically increasing timer.
   int64_t cache_now_us = rtc::TimeMicros();
-  if (cached_report_ &&
+  if (cached_report_ && cached_report_categories_ == categories &&
       cache_now_us - cache_timestamp_us_ <= cache_lifetime_us_) {
     // We have a fresh cached report to deliver.
     DeliverCachedReport();
   } else if (!num_pending_partial_reports_) {
     // Only start gathering stats if we're not already gathering stats. In the
     // case of already gathering stats, |callback_| will be invoked when there
-    // are no more pending partial reports.
+    // are no more pending partial reports, or stats are gathered again for it
+    // if it requested other categories.
+    GatherStats_s(categories);
+  }
+}
 
-    // "Now" using a system clock, relative to the UNIX epoch (Jan 1, 1970,
-    // UTC), in microseconds. The system clock could be modified and is not
-    // necessarily monotonically increasing.
-    int64_t timestamp_us = rtc::TimeUTCMicros();
+void RTCStatsCollector::ClearCachedStatsReport() {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  cached_report_ = nullptr;
+}
 
-    num_pending_partial_reports_ = 2;
-    partial_report_timestamp_us_ = cache_now_us;
+void RTCStatsCollector::WaitForPendingRequest() {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  if (num_pending_partial_reports_) {
+    rtc::Thread::Current()->ProcessMessages(0);
+    while (num_pending_partial_reports_) {
+      rtc::Thread::Current()->SleepMs(1);
+      rtc::Thread::Current()->ProcessMessages(0);
+    }
+  }
+}
 
+void RTCStatsCollector::GatherStats_s(uint32_t categories) {
+  RTC_DCHECK(signaling_thread_->IsCurrent());
+  RTC_DCHECK(!num_pending_partial_reports_);
+  // "Now" using a system clock, relative to the UNIX epoch (Jan 1, 1970, UTC),
+  // in microseconds. The system clock could be modified and is not necessarily
+  // monotonically increasing.
+  int64_t timestamp_us = rtc::TimeUTCMicros();
+
+  // The network thread is only invoked if it produces any of the selected
+  // stats, which is where most of the cost of gathering stats is.
+  const bool gather_on_network_thread =
+      (categories & (kCertificateStats | kCodecStats | kIceCandidateStats |
+                     kInboundRTPStreamStats | kOutboundRTPStreamStats |
+                     kTransportStats)) != 0;
+  num_pending_partial_reports_ = gather_on_network_thread ? 2 : 1;
+  partial_report_timestamp_us_ = rtc::TimeMicros();
+  partial_report_categories_ = categories;
+
+  if (gather_on_network_thread) {
     // Prepare |channel_name_pairs_| for use in
     // |ProducePartialResultsOnNetworkThread|.
     channel_name_pairs_.reset(new ChannelNamePairs());
@@ -497,35 +588,23 @@ void RTCStatsCollector::GetStatsReport(
                           *pc_->session()->sctp_transport_name()));
     }
     // Prepare |track_media_info_map_| for use in
-    // |ProducePartialResultsOnNetworkThread| and
-    // |ProducePartialResultsOnSignalingThread|.
-    track_media_info_map_.reset(PrepareTrackMediaInfoMap_s().release());
+    // |ProducePartialResultsOnNetworkThread|. This gets the stats of the media
+    // channels on the worker thread, so it is skipped unless needed.
+    const bool rtp_stream_stats =
+        (categories & (kInboundRTPStreamStats | kOutboundRTPStreamStats)) != 0;
+    if (rtp_stream_stats || (categories & kCodecStats))
+      track_media_info_map_.reset(PrepareTrackMediaInfoMap_s().release());
     // Prepare |track_to_id_| for use in |ProducePartialResultsOnNetworkThread|.
     // This avoids a possible deadlock if |MediaStreamTrackInterface::id| is
     // implemented to invoke on the signaling thread.
-    track_to_id_ = PrepareTrackToID_s();
+    if (rtp_stream_stats)
+      track_to_id_ = PrepareTrackToID_s();
 
     invoker_.AsyncInvoke<void>(RTC_FROM_HERE, network_thread_,
         rtc::Bind(&RTCStatsCollector::ProducePartialResultsOnNetworkThread,
             rtc::scoped_refptr<RTCStatsCollector>(this), timestamp_us));
-    ProducePartialResultsOnSignalingThread(timestamp_us);
-  }
-}
-
-void RTCStatsCollector::ClearCachedStatsReport() {
-  RTC_DCHECK(signaling_thread_->IsCurrent());
-  cached_report_ = nullptr;
-}
-
-void RTCStatsCollector::WaitForPendingRequest() {
-  RTC_DCHECK(signaling_thread_->IsCurrent());
-  if (num_pending_partial_reports_) {
-    rtc::Thread::Current()->ProcessMessages(0);
-    while (num_pending_partial_reports_) {
-      rtc::Thread::Current()->SleepMs(1);
-      rtc::Thread::Current()->ProcessMessages(0);
-    }
   }
+  ProducePartialResultsOnSignalingThread(timestamp_us);
 }
 
 void RTCStatsCollector::ProducePartialResultsOnSignalingThread(
@@ -534,9 +613,12 @@ void RTCStatsCollector::ProducePartialResultsOnSignalingThread(
   rtc::scoped_refptr<RTCStatsReport> report = RTCStatsReport::Create(
       timestamp_us);
 
-  ProduceDataChannelStats_s(timestamp_us, report.get());
-  ProduceMediaStreamAndTrackStats_s(timestamp_us, report.get());
-  ProducePeerConnectionStats_s(timestamp_us, report.get());
+  if (partial_report_categories_ & kDataChannelStats)
+    ProduceDataChannelStats_s(timestamp_us, report.get());
+  if (partial_report_categories_ & kMediaStreamStats)
+    ProduceMediaStreamAndTrackStats_s(timestamp_us, report.get());
+  if (partial_report_categories_ & kPeerConnectionStats)
+    ProducePeerConnectionStats_s(timestamp_us, report.get());
 
   AddPartialResults(report);
 }
@@ -553,16 +635,27 @@ void RTCStatsCollector::ProducePartialResultsOnNetworkThread(
     std::map<std::string, CertificateStatsPair> transport_cert_stats =
         PrepareTransportCertificateStats_n(*session_stats);
 
-    ProduceCertificateStats_n(
-        timestamp_us, transport_cert_stats, report.get());
-    ProduceCodecStats_n(
-        timestamp_us, *track_media_info_map_, report.get());
-    ProduceIceCandidateAndPairStats_n(
-        timestamp_us, *session_stats, report.get());
-    ProduceRTPStreamStats_n(
-        timestamp_us, *session_stats, *track_media_info_map_, report.get());
-    ProduceTransportStats_n(
-        timestamp_us, *session_stats, transport_cert_stats, report.get());
+    const uint32_t categories = partial_report_categories_;
+    if (categories & kCertificateStats) {
+      ProduceCertificateStats_n(
+          timestamp_us, transport_cert_stats, report.get());
+    }
+    if (categories & kCodecStats) {
+      ProduceCodecStats_n(
+          timestamp_us, *track_media_info_map_, report.get());
+    }
+    if (categories & kIceCandidateStats) {
+      ProduceIceCandidateAndPairStats_n(
+          timestamp_us, *session_stats, report.get());
+    }
+    if (categories & (kInboundRTPStreamStats | kOutboundRTPStreamStats)) {
+      ProduceRTPStreamStats_n(
+          timestamp_us, *session_stats, *track_media_info_map_, report.get());
+    }
+    if (categories & kTransportStats) {
+      ProduceTransportStats_n(
+          timestamp_us, *session_stats, transport_cert_stats, report.get());
+    }
   }
 
   AddPartialResults(report);
@@ -592,6 +685,7 @@ void RTCStatsCollector::AddPartialResults_s(
   if (!num_pending_partial_reports_) {
     cache_timestamp_us_ = partial_report_timestamp_us_;
     cached_report_ = partial_report_;
+    cached_report_categories_ = partial_report_categories_;
     partial_report_ = nullptr;
     channel_name_pairs_.reset();
     track_media_info_map_.reset();
@@ -602,13 +696,25 @@ void RTCStatsCollector::AddPartialResults_s(
 
 void RTCStatsCollector::DeliverCachedReport() {
   RTC_DCHECK(signaling_thread_->IsCurrent());
-  RTC_DCHECK(!callbacks_.empty());
   RTC_DCHECK(cached_report_);
+  // Callbacks are invoked after they have been removed from |callbacks_|,
+  // in case they request stats again.
+  std::vector<rtc::scoped_refptr<RTCStatsCollectorCallback>> delivered;
+  auto it = callbacks_.begin();
+  while (it != callbacks_.end()) {
+    if (it->second == cached_report_categories_) {
+      delivered.push_back(it->first);
+      it = callbacks_.erase(it);
+    } else {
+      ++it;
+    }
+  }
   for (const rtc::scoped_refptr<RTCStatsCollectorCallback>& callback :
-       callbacks_) {
+       delivered) {
     callback->OnStatsDelivered(cached_report_);
   }
-  callbacks_.clear();
+  if (!callbacks_.empty() && !num_pending_partial_reports_)
+    GatherStats_s(callbacks_.front().second);
 }
 
 void RTCStatsCollector::ProduceCertificateStats_n(
@@ -770,6 +876,10 @@ void RTCStatsCollector::ProduceRTPStreamStats_n(
     const TrackMediaInfoMap& track_media_info_map,
     RTCStatsReport* report) const {
   RTC_DCHECK(network_thread_->IsCurrent());
+  const bool inbound =
+      (partial_report_categories_ & kInboundRTPStreamStats) != 0;
+  const bool outbound =
+      (partial_report_categories_ & kOutboundRTPStreamStats) != 0;
 
   // Audio
   if (track_media_info_map.voice_media_info()) {
@@ -777,64 +887,70 @@ void RTCStatsCollector::ProduceRTPStreamStats_n(
         session_stats.proxy_to_transport, *pc_->session()->voice_channel());
     RTC_DCHECK(!transport_id.empty());
     // Inbound
-    for (const cricket::VoiceReceiverInfo& voice_receiver_info :
-         track_media_info_map.voice_media_info()->receivers) {
-      // TODO(nisse): SSRC == 0 currently means none. Delete check when that
-      // is fixed.
-      if (voice_receiver_info.ssrc() == 0)
-        continue;
-      std::unique_ptr<RTCInboundRTPStreamStats> inbound_audio(
-          new RTCInboundRTPStreamStats(
-              RTCInboundRTPStreamStatsIDFromSSRC(
-                  true, voice_receiver_info.ssrc()),
-              timestamp_us));
-      SetInboundRTPStreamStatsFromVoiceReceiverInfo(
-          voice_receiver_info, inbound_audio.get());
-      rtc::scoped_refptr<AudioTrackInterface> audio_track =
-          track_media_info_map_->GetAudioTrack(voice_receiver_info);
-      if (audio_track) {
-        RTC_DCHECK(track_to_id_.find(audio_track.get()) != track_to_id_.end());
-        inbound_audio->media_track_id =
-            RTCMediaStreamTrackStatsIDFromTrackID(
-                track_to_id_.find(audio_track.get())->second, false);
-      }
-      inbound_audio->transport_id = transport_id;
-      if (voice_receiver_info.codec_payload_type) {
-        inbound_audio->codec_id =
-            RTCCodecStatsIDFromDirectionMediaAndPayload(
-                true, true, *voice_receiver_info.codec_payload_type);
+    if (inbound) {
+      for (const cricket::VoiceReceiverInfo& voice_receiver_info :
+           track_media_info_map.voice_media_info()->receivers) {
+        // TODO(nisse): SSRC == 0 currently means none. Delete check when that
+        // is fixed.
+        if (voice_receiver_info.ssrc() == 0)
+          continue;
+        std::unique_ptr<RTCInboundRTPStreamStats> inbound_audio(
+            new RTCInboundRTPStreamStats(
+                RTCInboundRTPStreamStatsIDFromSSRC(
+                    true, voice_receiver_info.ssrc()),
+                timestamp_us));
+        SetInboundRTPStreamStatsFromVoiceReceiverInfo(
+            voice_receiver_info, inbound_audio.get());
+        rtc::scoped_refptr<AudioTrackInterface> audio_track =
+            track_media_info_map_->GetAudioTrack(voice_receiver_info);
+        if (audio_track) {
+          RTC_DCHECK(track_to_id_.find(audio_track.get()) !=
+                     track_to_id_.end());
+          inbound_audio->media_track_id =
+              RTCMediaStreamTrackStatsIDFromTrackID(
+                  track_to_id_.find(audio_track.get())->second, false);
+        }
+        inbound_audio->transport_id = transport_id;
+        if (voice_receiver_info.codec_payload_type) {
+          inbound_audio->codec_id =
+              RTCCodecStatsIDFromDirectionMediaAndPayload(
+                  true, true, *voice_receiver_info.codec_payload_type);
+        }
+        report->AddStats(std::move(inbound_audio));
       }
-      report->AddStats(std::move(inbound_audio));
     }
     // Outbound
-    for (const cricket::VoiceSenderInfo& voice_sender_info :
-         track_media_info_map.voice_media_info()->senders) {
-      // TODO(nisse): SSRC == 0 currently means none. Delete check when that
-      // is fixed.
-      if (voice_sender_info.ssrc() == 0)
-        continue;
-      std::unique_ptr<RTCOutboundRTPStreamStats> outbound_audio(
-          new RTCOutboundRTPStreamStats(
-              RTCOutboundRTPStreamStatsIDFromSSRC(
-                  true, voice_sender_info.ssrc()),
-              timestamp_us));
-      SetOutboundRTPStreamStatsFromVoiceSenderInfo(
-          voice_sender_info, outbound_audio.get());
-      rtc::scoped_refptr<AudioTrackInterface> audio_track =
-          track_media_info_map_->GetAudioTrack(voice_sender_info);
-      if (audio_track) {
-        RTC_DCHECK(track_to_id_.find(audio_track.get()) != track_to_id_.end());
-        outbound_audio->media_track_id =
-            RTCMediaStreamTrackStatsIDFromTrackID(
-                track_to_id_.find(audio_track.get())->second, true);
-      }
-      outbound_audio->transport_id = transport_id;
-      if (voice_sender_info.codec_payload_type) {
-        outbound_audio->codec_id =
-            RTCCodecStatsIDFromDirectionMediaAndPayload(
-                false, true, *voice_sender_info.codec_payload_type);
+    if (outbound) {
+      for (const cricket::VoiceSenderInfo& voice_sender_info :
+           track_media_info_map.voice_media_info()->senders) {
+        // TODO(nisse): SSRC == 0 currently means none. Delete check when that
+        // is fixed.
+        if (voice_sender_info.ssrc() == 0)
+          continue;
+        std::unique_ptr<RTCOutboundRTPStreamStats> outbound_audio(
+            new RTCOutboundRTPStreamStats(
+                RTCOutboundRTPStreamStatsIDFromSSRC(
+                    true, voice_sender_info.ssrc()),
+                timestamp_us));
+        SetOutboundRTPStreamStatsFromVoiceSenderInfo(
+            voice_sender_info, outbound_audio.get());
+        rtc::scoped_refptr<AudioTrackInterface> audio_track =
+            track_media_info_map_->GetAudioTrack(voice_sender_info);
+        if (audio_track) {
+          RTC_DCHECK(track_to_id_.find(audio_track.get()) !=
+                     track_to_id_.end());
+          outbound_audio->media_track_id =
+              RTCMediaStreamTrackStatsIDFromTrackID(
+                  track_to_id_.find(audio_track.get())->second, true);
+        }
+        outbound_audio->transport_id = transport_id;
+        if (voice_sender_info.codec_payload_type) {
+          outbound_audio->codec_id =
+              RTCCodecStatsIDFromDirectionMediaAndPayload(
+                  false, true, *voice_sender_info.codec_payload_type);
+        }
+        report->AddStats(std::move(outbound_audio));
       }
-      report->AddStats(std::move(outbound_audio));
     }
   }
   // Video
@@ -843,64 +959,70 @@ void RTCStatsCollector::ProduceRTPStreamStats_n(
         session_stats.proxy_to_transport, *pc_->session()->video_channel());
     RTC_DCHECK(!transport_id.empty());
     // Inbound
-    for (const cricket::VideoReceiverInfo& video_receiver_info :
-         track_media_info_map.video_media_info()->receivers) {
-      // TODO(nisse): SSRC == 0 currently means none. Delete check when that
-      // is fixed.
-      if (video_receiver_info.ssrc() == 0)
-        continue;
-      std::unique_ptr<RTCInboundRTPStreamStats> inbound_video(
-          new RTCInboundRTPStreamStats(
-              RTCInboundRTPStreamStatsIDFromSSRC(
-                  false, video_receiver_info.ssrc()),
-              timestamp_us));
-      SetInboundRTPStreamStatsFromVideoReceiverInfo(
-          video_receiver_info, inbound_video.get());
-      rtc::scoped_refptr<VideoTrackInterface> video_track =
-          track_media_info_map_->GetVideoTrack(video_receiver_info);
-      if (video_track) {
-        RTC_DCHECK(track_to_id_.find(video_track.get()) != track_to_id_.end());
-        inbound_video->media_track_id =
-            RTCMediaStreamTrackStatsIDFromTrackID(
-                track_to_id_.find(video_track.get())->second, false);
-      }
-      inbound_video->transport_id = transport_id;
-      if (video_receiver_info.codec_payload_type) {
-        inbound_video->codec_id =
-            RTCCodecStatsIDFromDirectionMediaAndPayload(
-                true, false, *video_receiver_info.codec_payload_type);
+    if (inbound) {
+      for (const cricket::VideoReceiverInfo& video_receiver_info :
+           track_media_info_map.video_media_info()->receivers) {
+        // TODO(nisse): SSRC == 0 currently means none. Delete check when that
+        // is fixed.
+        if (video_receiver_info.ssrc() == 0)
+          continue;
+        std::unique_ptr<RTCInboundRTPStreamStats> inbound_video(
+            new RTCInboundRTPStreamStats(
+                RTCInboundRTPStreamStatsIDFromSSRC(
+                    false, video_receiver_info.ssrc()),
+                timestamp_us));
+        SetInboundRTPStreamStatsFromVideoReceiverInfo(
+            video_receiver_info, inbound_video.get());
+        rtc::scoped_refptr<VideoTrackInterface> video_track =
+            track_media_info_map_->GetVideoTrack(video_receiver_info);
+        if (video_track) {
+          RTC_DCHECK(track_to_id_.find(video_track.get()) !=
+                     track_to_id_.end());
+          inbound_video->media_track_id =
+              RTCMediaStreamTrackStatsIDFromTrackID(
+                  track_to_id_.find(video_track.get())->second, false);
+        }
+        inbound_video->transport_id = transport_id;
+        if (video_receiver_info.codec_payload_type) {
+          inbound_video->codec_id =
+              RTCCodecStatsIDFromDirectionMediaAndPayload(
+                  true, false, *video_receiver_info.codec_payload_type);
+        }
+        report->AddStats(std::move(inbound_video));
       }
-      report->AddStats(std::move(inbound_video));
     }
     // Outbound
-    for (const cricket::VideoSenderInfo& video_sender_info :
-         track_media_info_map.video_media_info()->senders) {
-      // TODO(nisse): SSRC == 0 currently means none. Delete check when that
-      // is fixed.
-      if (video_sender_info.ssrc() == 0)
-        continue;
-      std::unique_ptr<RTCOutboundRTPStreamStats> outbound_video(
-          new RTCOutboundRTPStreamStats(
-              RTCOutboundRTPStreamStatsIDFromSSRC(
-                  false, video_sender_info.ssrc()),
-              timestamp_us));
-      SetOutboundRTPStreamStatsFromVideoSenderInfo(
-          video_sender_info, outbound_video.get());
-      rtc::scoped_refptr<VideoTrackInterface> video_track =
-          track_media_info_map_->GetVideoTrack(video_sender_info);
-      if (video_track) {
-        RTC_DCHECK(track_to_id_.find(video_track.get()) != track_to_id_.end());
-        outbound_video->media_track_id =
-            RTCMediaStreamTrackStatsIDFromTrackID(
-                track_to_id_.find(video_track.get())->second, true);
-      }
-      outbound_video->transport_id = transport_id;
-      if (video_sender_info.codec_payload_type) {
-        outbound_video->codec_id =
-            RTCCodecStatsIDFromDirectionMediaAndPayload(
-                false, false, *video_sender_info.codec_payload_type);
+    if (outbound) {
+      for (const cricket::VideoSenderInfo& video_sender_info :
+           track_media_info_map.video_media_info()->senders) {
+        // TODO(nisse): SSRC == 0 currently means none. Delete check when that
+        // is fixed.
+        if (video_sender_info.ssrc() == 0)
+          continue;
+        std::unique_ptr<RTCOutboundRTPStreamStats> outbound_video(
+            new RTCOutboundRTPStreamStats(
+                RTCOutboundRTPStreamStatsIDFromSSRC(
+                    false, video_sender_info.ssrc()),
+                timestamp_us));
+        SetOutboundRTPStreamStatsFromVideoSenderInfo(
+            video_sender_info, outbound_video.get());
+        rtc::scoped_refptr<VideoTrackInterface> video_track =
+            track_media_info_map_->GetVideoTrack(video_sender_info);
+        if (video_track) {
+          RTC_DCHECK(track_to_id_.find(video_track.get()) !=
+                     track_to_id_.end());
+          outbound_video->media_track_id =
+              RTCMediaStreamTrackStatsIDFromTrackID(
+                  track_to_id_.find(video_track.get())->second, true);
+        }
+        outbound_video->transport_id = transport_id;
+        if (video_sender_info.codec_payload_type) {
+          outbound_video->codec_id =
+              RTCCodecStatsIDFromDirectionMediaAndPayload(
+                  false, false, *video_sender_info.codec_payload_type);
+        }
+        report->AddStats(std::move(outbound_video));
       }
-      report->AddStats(std::move(outbound_video));
     }
   }
 }
@@ -910,6 +1032,18 @@ void RTCStatsCollector::ProduceTransportStats_n(
     const std::map<std::string, CertificateStatsPair>& transport_cert_stats,
     RTCStatsReport* report) const {
   RTC_DCHECK(network_thread_->IsCurrent());
+  // The SRTP cost of the channels, summed by transport since bundled channels
+  // share one.
+  std::map<std::string, cricket::SrtpCryptoStats> srtp_stats_by_transport;
+  const cricket::BaseChannel* channels[] = {
+      pc_->session()->voice_channel(), pc_->session()->video_channel(),
+      pc_->session()->rtp_data_channel()};
+  for (const cricket::BaseChannel* channel : channels) {
+    cricket::SrtpCryptoStats srtp_stats;
+    if (channel && channel->GetSrtpCryptoStats_n(&srtp_stats))
+      srtp_stats_by_transport[channel->transport_name()] += srtp_stats;
+  }
+
   for (const auto& transport : session_stats.transport_stats) {
     // Get reference to RTCP channel, if it exists.
     std::string rtcp_transport_stats_id;
@@ -966,6 +1100,23 @@ void RTCStatsCollector::ProduceTransportStats_n(
         transport_stats->local_certificate_id = local_certificate_id;
       if (!remote_certificate_id.empty())
         transport_stats->remote_certificate_id = remote_certificate_id;
+      const auto& srtp_stats_it =
+          srtp_stats_by_transport.find(transport.second.transport_name);
+      if (channel_stats.component == cricket::ICE_CANDIDATE_COMPONENT_RTP &&
+          srtp_stats_it != srtp_stats_by_transport.end()) {
+        const cricket::SrtpCryptoStats& srtp_stats = srtp_stats_it->second;
+        transport_stats->srtp_encrypt_time =
+            static_cast<double>(srtp_stats.encrypt_time_ns) /
+            rtc::kNumNanosecsPerSec;
+        transport_stats->srtp_decrypt_time =
+            static_cast<double>(srtp_stats.decrypt_time_ns) /
+            rtc::kNumNanosecsPerSec;
+        transport_stats->srtp_bytes_encrypted = srtp_stats.bytes_encrypted;
+        transport_stats->srtp_bytes_decrypted = srtp_stats.bytes_decrypted;
+        transport_stats->srtp_encrypt_failures = srtp_stats.encrypt_failures;
+        transport_stats->srtp_decrypt_failures = srtp_stats.decrypt_failures;
+        transport_stats->srtp_replay_drops = srtp_stats.replay_drops;
+      }
       report->AddStats(std::move(transport_stats));
     }
   }
@@ -14,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <utility>
 #include <vector>
 
 #include "webrtc/api/datachannel.h"
@@ -63,11 +64,34 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
       PeerConnection* pc,
       int64_t cache_lifetime_us = 50 * rtc::kNumMicrosecsPerMillisec);
 
+  // Categories of stats that can be combined into a bit mask to select the
+  // stats gathered by |GetStatsReport|.
+  enum StatsCategory {
+    kCertificateStats = 1 << 0,
+    kCodecStats = 1 << 1,
+    kDataChannelStats = 1 << 2,
+    // |RTCIceCandidatePairStats| and |RTCIceCandidateStats|.
+    kIceCandidateStats = 1 << 3,
+    // |RTCMediaStreamStats| and |RTCMediaStreamTrackStats|.
+    kMediaStreamStats = 1 << 4,
+    kPeerConnectionStats = 1 << 5,
+    kInboundRTPStreamStats = 1 << 6,
+    kOutboundRTPStreamStats = 1 << 7,
+    kTransportStats = 1 << 8,
+    kAllStats = (1 << 9) - 1,
+  };
+
   // Gets a recent stats report. If there is a report cached that is still fresh
   // it is returned, otherwise new stats are gathered and returned. A report is
   // considered fresh for |cache_lifetime_| ms. const RTCStatsReports are safe
   // to use across multiple threads and may be destructed on any thread.
   void GetStatsReport(rtc::scoped_refptr<RTCStatsCollectorCallback> callback);
+  // Like the above, but the report only contains the stats of |categories|, a
+  // bit mask of |StatsCategory|. Stats of other categories are not gathered,
+  // and threads that only produce unselected stats are not invoked. A cached
+  // report is only returned if it was gathered for the same categories.
+  void GetStatsReport(rtc::scoped_refptr<RTCStatsCollectorCallback> callback,
+                      uint32_t categories);
   // Clears the cache's reference to the most recent stats report. Subsequently
   // calling |GetStatsReport| guarantees fresh stats.
   void ClearCachedStatsReport();
@@ -95,7 +119,11 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
     std::unique_ptr<rtc::SSLCertificateStats> remote;
   };
 
+  // Starts gathering the stats of |categories|.
+  void GatherStats_s(uint32_t categories);
   void AddPartialResults_s(rtc::scoped_refptr<RTCStatsReport> partial_report);
+  // Delivers the cached report to the callbacks that requested its categories.
+  // Starts gathering stats for the remaining callbacks, if any.
   void DeliverCachedReport();
 
   // Produces |RTCCertificateStats|.
@@ -152,12 +180,15 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   int num_pending_partial_reports_;
   int64_t partial_report_timestamp_us_;
   rtc::scoped_refptr<RTCStatsReport> partial_report_;
-  std::vector<rtc::scoped_refptr<RTCStatsCollectorCallback>> callbacks_;
+  // The pending callbacks and the categories of stats they requested.
+  std::vector<std::pair<rtc::scoped_refptr<RTCStatsCollectorCallback>,
+                        uint32_t>> callbacks_;
 
   // Set in |GetStatsReport|, read in |ProducePartialResultsOnNetworkThread| and
   // |ProducePartialResultsOnSignalingThread|, reset after work is complete. Not
   // passed as arguments to avoid copies. This is thread safe - when we
   // set/reset we know there are no pending stats requests in progress.
+  uint32_t partial_report_categories_;
   std::unique_ptr<ChannelNamePairs> channel_name_pairs_;
   std::unique_ptr<TrackMediaInfoMap> track_media_info_map_;
   std::map<MediaStreamTrackInterface*, std::string> track_to_id_;
@@ -169,6 +200,7 @@ class RTCStatsCollector : public virtual rtc::RefCountInterface,
   int64_t cache_timestamp_us_;
   int64_t cache_lifetime_us_;
   rtc::scoped_refptr<const RTCStatsReport> cached_report_;
+  uint32_t cached_report_categories_;
 
   // Data recorded and maintained by the stats collector during its lifetime.
   // Some stats are produced from this record instead of other components.
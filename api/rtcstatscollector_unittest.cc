@@ -566,9 +566,10 @@ class RTCStatsCollectorTest : public testing::Test {
           &test_->pc(), 50 * rtc::kNumMicrosecsPerMillisec)) {
   }
 
-  rtc::scoped_refptr<const RTCStatsReport> GetStatsReport() {
+  rtc::scoped_refptr<const RTCStatsReport> GetStatsReport(
+      uint32_t categories = RTCStatsCollector::kAllStats) {
     rtc::scoped_refptr<RTCStatsObtainer> callback = RTCStatsObtainer::Create();
-    collector_->GetStatsReport(callback);
+    collector_->GetStatsReport(callback, categories);
     EXPECT_TRUE_WAIT(callback->report(), kGetStatsReportTimeoutMs);
     int64_t after = rtc::TimeUTCMicros();
     for (const RTCStats& stats : *callback->report()) {
@@ -657,6 +658,43 @@ TEST_F(RTCStatsCollectorTest, MultipleCallbacksWithInvalidatedCacheInBetween) {
   EXPECT_NE(c.get(), b.get());
 }
 
+TEST_F(RTCStatsCollectorTest, SelectedStatsReports) {
+  // Only the signaling thread produces peer connection stats.
+  EXPECT_CALL(test_->session(), GetStats(_)).Times(0);
+  rtc::scoped_refptr<const RTCStatsReport> a =
+      GetStatsReport(RTCStatsCollector::kPeerConnectionStats);
+  EXPECT_EQ(1u, a->size());
+  EXPECT_EQ(1u, a->GetStatsOfType<RTCPeerConnectionStats>().size());
+  rtc::scoped_refptr<const RTCStatsReport> b =
+      GetStatsReport(RTCStatsCollector::kPeerConnectionStats);
+  EXPECT_EQ(a.get(), b.get());
+  // A report is only cached for the categories it was gathered for.
+  rtc::scoped_refptr<const RTCStatsReport> c =
+      GetStatsReport(RTCStatsCollector::kPeerConnectionStats |
+                     RTCStatsCollector::kDataChannelStats);
+  EXPECT_NE(b.get(), c.get());
+  rtc::scoped_refptr<const RTCStatsReport> d =
+      GetStatsReport(RTCStatsCollector::kPeerConnectionStats);
+  EXPECT_NE(c.get(), d.get());
+}
+
+TEST_F(RTCStatsCollectorTest, MultipleCallbacksWithDifferentCategories) {
+  rtc::scoped_refptr<const RTCStatsReport> a;
+  rtc::scoped_refptr<const RTCStatsReport> b;
+  rtc::scoped_refptr<const RTCStatsReport> c;
+  collector_->GetStatsReport(RTCStatsObtainer::Create(&a));
+  collector_->GetStatsReport(RTCStatsObtainer::Create(&b),
+                             RTCStatsCollector::kPeerConnectionStats);
+  collector_->GetStatsReport(RTCStatsObtainer::Create(&c));
+  EXPECT_TRUE_WAIT(a, kGetStatsReportTimeoutMs);
+  EXPECT_TRUE_WAIT(b, kGetStatsReportTimeoutMs);
+  EXPECT_TRUE_WAIT(c, kGetStatsReportTimeoutMs);
+  EXPECT_EQ(a.get(), c.get());
+  EXPECT_NE(a.get(), b.get());
+  EXPECT_EQ(1u, b->size());
+  EXPECT_EQ(1u, b->GetStatsOfType<RTCPeerConnectionStats>().size());
+}
+
 TEST_F(RTCStatsCollectorTest, CollectRTCCertificateStatsSingle) {
   std::unique_ptr<CertificateInfo> local_certinfo =
       CreateFakeCertificateAndInfoFromDers(
@@ -1626,6 +1664,68 @@ TEST_F(RTCStatsCollectorTest, CollectRTCInboundRTPStreamStats_Audio) {
   EXPECT_TRUE(report->Get(*expected_audio.codec_id));
 }
 
+TEST_F(RTCStatsCollectorTest, CollectOnlyRTCInboundRTPStreamStats) {
+  MockVoiceMediaChannel* voice_media_channel = new MockVoiceMediaChannel();
+  cricket::VoiceChannel voice_channel(
+      test_->worker_thread(), test_->network_thread(), nullptr,
+      test_->media_engine(), voice_media_channel, "VoiceContentName",
+      kDefaultRtcpMuxRequired, kDefaultSrtpRequired);
+
+  test_->SetupRemoteTrackAndReceiver(
+      cricket::MEDIA_TYPE_AUDIO, "RemoteAudioTrackID", 1);
+
+  cricket::VoiceMediaInfo voice_media_info;
+  voice_media_info.receivers.push_back(cricket::VoiceReceiverInfo());
+  voice_media_info.receivers[0].local_stats.push_back(
+      cricket::SsrcReceiverInfo());
+  voice_media_info.receivers[0].local_stats[0].ssrc = 1;
+  voice_media_info.receivers[0].packets_rcvd = 2;
+  voice_media_info.receivers[0].codec_payload_type = rtc::Optional<int>(42);
+  voice_media_info.senders.push_back(cricket::VoiceSenderInfo());
+  voice_media_info.senders[0].local_stats.push_back(cricket::SsrcSenderInfo());
+  voice_media_info.senders[0].local_stats[0].ssrc = 2;
+
+  RtpCodecParameters codec_parameters;
+  codec_parameters.payload_type = 42;
+  codec_parameters.mime_type = "dummy";
+  codec_parameters.clock_rate = 0;
+  voice_media_info.receive_codecs.insert(
+      std::make_pair(codec_parameters.payload_type, codec_parameters));
+
+  EXPECT_CALL(*voice_media_channel, GetStats(_))
+      .WillOnce(DoAll(SetArgPointee<0>(voice_media_info), Return(true)));
+
+  SessionStats session_stats;
+  session_stats.proxy_to_transport["VoiceContentName"] = "TransportName";
+  session_stats.transport_stats["TransportName"].transport_name =
+      "TransportName";
+  cricket::TransportChannelStats channel_stats;
+  channel_stats.component = cricket::ICE_CANDIDATE_COMPONENT_RTP;
+  session_stats.transport_stats["TransportName"].channel_stats.push_back(
+      channel_stats);
+
+  EXPECT_CALL(test_->session(), GetStats(_)).WillRepeatedly(Invoke(
+      [&session_stats](const ChannelNamePairs&) {
+        return std::unique_ptr<SessionStats>(new SessionStats(session_stats));
+      }));
+  EXPECT_CALL(test_->session(), voice_channel())
+      .WillRepeatedly(Return(&voice_channel));
+
+  rtc::scoped_refptr<const RTCStatsReport> report =
+      GetStatsReport(RTCStatsCollector::kInboundRTPStreamStats);
+
+  // The referenced track, transport and codec stats are not produced, and
+  // neither are the outbound RTP stream stats.
+  EXPECT_EQ(1u, report->size());
+  std::vector<const RTCInboundRTPStreamStats*> inbound =
+      report->GetStatsOfType<RTCInboundRTPStreamStats>();
+  ASSERT_EQ(1u, inbound.size());
+  EXPECT_EQ("RTCInboundRTPAudioStream_1", inbound[0]->id());
+  EXPECT_EQ(2u, *inbound[0]->packets_received);
+  EXPECT_EQ("RTCMediaStreamTrack_remote_RemoteAudioTrackID",
+            *inbound[0]->media_track_id);
+}
+
 TEST_F(RTCStatsCollectorTest, CollectRTCInboundRTPStreamStats_Video) {
   MockVideoMediaChannel* video_media_channel = new MockVideoMediaChannel();
   cricket::VideoChannel video_channel(
@@ -1651,6 +1751,13 @@ TEST_F(RTCStatsCollectorTest, CollectRTCInboundRTPStreamStats_Video) {
   video_media_info.receivers[0].plis_sent = 6;
   video_media_info.receivers[0].nacks_sent = 7;
   video_media_info.receivers[0].frames_decoded = 8;
+  MediaCryptoStats media_crypto_stats;
+  media_crypto_stats.decrypt_time_ns = 2 * rtc::kNumNanosecsPerMillisec;
+  media_crypto_stats.bytes_decrypted = 9;
+  media_crypto_stats.auth_failures = 10;
+  media_crypto_stats.replay_drops = 11;
+  video_media_info.receivers[0].media_crypto =
+      rtc::Optional<MediaCryptoStats>(media_crypto_stats);
 
   RtpCodecParameters codec_parameters;
   codec_parameters.payload_type = 42;
@@ -1700,6 +1807,10 @@ TEST_F(RTCStatsCollectorTest, CollectRTCInboundRTPStreamStats_Video) {
   expected_video.packets_lost = 42;
   expected_video.fraction_lost = 4.5;
   expected_video.frames_decoded = 8;
+  expected_video.media_crypto_decrypt_time = 0.002;
+  expected_video.media_crypto_bytes_decrypted = 9;
+  expected_video.media_crypto_auth_failures = 10;
+  expected_video.media_crypto_replay_drops = 11;
 
   ASSERT(report->Get(expected_video.id()));
   const RTCInboundRTPStreamStats& video = report->Get(
@@ -1808,6 +1919,18 @@ TEST_F(RTCStatsCollectorTest, CollectRTCOutboundRTPStreamStats_Video) {
   video_media_info.senders[0].codec_payload_type = rtc::Optional<int>(42);
   video_media_info.senders[0].frames_encoded = 8;
   video_media_info.senders[0].qp_sum = rtc::Optional<uint64_t>(16);
+  video_media_info.senders[0].pacer_queue_time_ms.p50 = 10;
+  video_media_info.senders[0].pacer_queue_time_ms.p95 = 20;
+  video_media_info.senders[0].pacer_queue_time_ms.p99 = 30;
+  video_media_info.senders[0].send_delay_ms.p50 = 1;
+  video_media_info.senders[0].send_delay_ms.p95 = 2;
+  video_media_info.senders[0].send_delay_ms.p99 = 4;
+  MediaCryptoStats media_crypto_stats;
+  media_crypto_stats.encrypt_time_ns = 3 * rtc::kNumNanosecsPerMillisec;
+  media_crypto_stats.bytes_encrypted = 9;
+  media_crypto_stats.encrypt_failures = 10;
+  video_media_info.senders[0].media_crypto =
+      rtc::Optional<MediaCryptoStats>(media_crypto_stats);
 
   RtpCodecParameters codec_parameters;
   codec_parameters.payload_type = 42;
@@ -1856,6 +1979,16 @@ TEST_F(RTCStatsCollectorTest, CollectRTCOutboundRTPStreamStats_Video) {
   expected_video.round_trip_time = 7.5;
   expected_video.frames_encoded = 8;
   expected_video.qp_sum = 16;
+  expected_video.pacer_queue_time_p50 = 0.01;
+  expected_video.pacer_queue_time_p95 = 0.02;
+  expected_video.pacer_queue_time_p99 = 0.03;
+  // |expected_video.media_encrypt_time_p*| should be undefined.
+  expected_video.send_delay_p50 = 0.001;
+  expected_video.send_delay_p95 = 0.002;
+  expected_video.send_delay_p99 = 0.004;
+  expected_video.media_crypto_encrypt_time = 0.003;
+  expected_video.media_crypto_bytes_encrypted = 9;
+  expected_video.media_crypto_encrypt_failures = 10;
 
   ASSERT(report->Get(expected_video.id()));
   const RTCOutboundRTPStreamStats& video = report->Get(
@@ -377,6 +377,13 @@ class RTCInboundRTPStreamStats final : public RTCRTPStreamStats {
   // TODO(hbos): Not collected by |RTCStatsCollector|. crbug.com/657855
   RTCStatsMember<double> gap_discard_rate;
   RTCStatsMember<uint32_t> frames_decoded;
+  // Non-standard. The cost of the inner PERC layer of the stream, only
+  // defined for video when end to end media encryption is enabled. The outer
+  // SRTP layer is in RTCTransportStats. Times are in seconds.
+  RTCStatsMember<double> media_crypto_decrypt_time;
+  RTCStatsMember<uint64_t> media_crypto_bytes_decrypted;
+  RTCStatsMember<uint32_t> media_crypto_auth_failures;
+  RTCStatsMember<uint32_t> media_crypto_replay_drops;
 };
 
 // https://w3c.github.io/webrtc-stats/#outboundrtpstats-dict*
@@ -397,6 +404,24 @@ class RTCOutboundRTPStreamStats final : public RTCRTPStreamStats {
   RTCStatsMember<double> target_bitrate;
   RTCStatsMember<double> round_trip_time;
   RTCStatsMember<uint32_t> frames_encoded;
+  // Non-standard. Percentiles of the time spent by the packets of the stream
+  // in stages of the send path, only defined for video once packets went
+  // through the stage. Times are in seconds.
+  RTCStatsMember<double> pacer_queue_time_p50;
+  RTCStatsMember<double> pacer_queue_time_p95;
+  RTCStatsMember<double> pacer_queue_time_p99;
+  RTCStatsMember<double> media_encrypt_time_p50;
+  RTCStatsMember<double> media_encrypt_time_p95;
+  RTCStatsMember<double> media_encrypt_time_p99;
+  RTCStatsMember<double> send_delay_p50;
+  RTCStatsMember<double> send_delay_p95;
+  RTCStatsMember<double> send_delay_p99;
+  // Non-standard. The cost of the inner PERC layer of the stream, only
+  // defined for video when end to end media encryption is enabled. The outer
+  // SRTP layer is in RTCTransportStats. Times are in seconds.
+  RTCStatsMember<double> media_crypto_encrypt_time;
+  RTCStatsMember<uint64_t> media_crypto_bytes_encrypted;
+  RTCStatsMember<uint32_t> media_crypto_encrypt_failures;
 };
 
 // https://w3c.github.io/webrtc-stats/#transportstats-dict*
@@ -417,6 +442,15 @@ class RTCTransportStats final : public RTCStats {
   RTCStatsMember<std::string> selected_candidate_pair_id;
   RTCStatsMember<std::string> local_certificate_id;
   RTCStatsMember<std::string> remote_certificate_id;
+  // Non-standard. The cost of SRTP for all the channels on the transport,
+  // only defined when SRTP is used. Times are in seconds.
+  RTCStatsMember<double> srtp_encrypt_time;
+  RTCStatsMember<double> srtp_decrypt_time;
+  RTCStatsMember<uint64_t> srtp_bytes_encrypted;
+  RTCStatsMember<uint64_t> srtp_bytes_decrypted;
+  RTCStatsMember<uint32_t> srtp_encrypt_failures;
+  RTCStatsMember<uint32_t> srtp_decrypt_failures;
+  RTCStatsMember<uint32_t> srtp_replay_drops;
 };
 
 }  // namespace webrtc
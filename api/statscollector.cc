@@ -503,8 +503,11 @@ StatsCollector::UpdateStats(PeerConnectionInterface::StatsOutputLevel level) {
     // since we'd be creating/updating the stats report objects consistently on
     // the same thread (this class has no locks right now).
     ExtractSessionInfo();
-    ExtractVoiceInfo();
-    ExtractVideoInfo(level);
+    std::unique_ptr<cricket::VoiceMediaInfo> voice_info;
+    std::unique_ptr<cricket::VideoMediaInfo> video_info;
+    GetMediaInfo(&voice_info, &video_info);
+    ExtractVoiceInfo(voice_info.get());
+    ExtractVideoInfo(level, video_info.get());
     ExtractSenderInfo();
     ExtractDataInfo();
     UpdateTrackReports();
@@ -764,14 +767,38 @@ void StatsCollector::ExtractSessionInfo() {
   }
 }
 
-void StatsCollector::ExtractVoiceInfo() {
+void StatsCollector::GetMediaInfo(
+    std::unique_ptr<cricket::VoiceMediaInfo>* voice_info,
+    std::unique_ptr<cricket::VideoMediaInfo>* video_info) {
+  RTC_DCHECK(pc_->session()->signaling_thread()->IsCurrent());
+
+  cricket::VoiceChannel* voice_channel = pc_->session()->voice_channel();
+  cricket::VideoChannel* video_channel = pc_->session()->video_channel();
+  if (!voice_channel && !video_channel)
+    return;
+
+  pc_->session()->worker_thread()->Invoke<void>(RTC_FROM_HERE, [&] {
+    if (voice_channel) {
+      voice_info->reset(new cricket::VoiceMediaInfo());
+      if (!voice_channel->media_channel()->GetStats(voice_info->get()))
+        voice_info->reset();
+    }
+    if (video_channel) {
+      video_info->reset(new cricket::VideoMediaInfo());
+      if (!video_channel->media_channel()->GetStats(video_info->get()))
+        video_info->reset();
+    }
+  });
+}
+
+void StatsCollector::ExtractVoiceInfo(
+    const cricket::VoiceMediaInfo* voice_info) {
   RTC_DCHECK(pc_->session()->signaling_thread()->IsCurrent());
 
   if (!pc_->session()->voice_channel()) {
     return;
   }
-  cricket::VoiceMediaInfo voice_info;
-  if (!pc_->session()->voice_channel()->GetStats(&voice_info)) {
+  if (!voice_info) {
     LOG(LS_ERROR) << "Failed to get voice channel stats.";
     return;
   }
@@ -788,23 +815,23 @@ void StatsCollector::ExtractVoiceInfo() {
     return;
   }
 
-  ExtractStatsFromList(voice_info.receivers, transport_id, this,
+  ExtractStatsFromList(voice_info->receivers, transport_id, this,
       StatsReport::kReceive);
-  ExtractStatsFromList(voice_info.senders, transport_id, this,
+  ExtractStatsFromList(voice_info->senders, transport_id, this,
       StatsReport::kSend);
 
   UpdateStatsFromExistingLocalAudioTracks();
 }
 
 void StatsCollector::ExtractVideoInfo(
-    PeerConnectionInterface::StatsOutputLevel level) {
+    PeerConnectionInterface::StatsOutputLevel level,
+    const cricket::VideoMediaInfo* video_info) {
   RTC_DCHECK(pc_->session()->signaling_thread()->IsCurrent());
 
   if (!pc_->session()->video_channel())
     return;
 
-  cricket::VideoMediaInfo video_info;
-  if (!pc_->session()->video_channel()->GetStats(&video_info)) {
+  if (!video_info) {
     LOG(LS_ERROR) << "Failed to get video channel stats.";
     return;
   }
@@ -820,17 +847,17 @@ void StatsCollector::ExtractVideoInfo(
                   << pc_->session()->video_channel()->content_name();
     return;
   }
-  ExtractStatsFromList(video_info.receivers, transport_id, this,
+  ExtractStatsFromList(video_info->receivers, transport_id, this,
       StatsReport::kReceive);
-  ExtractStatsFromList(video_info.senders, transport_id, this,
+  ExtractStatsFromList(video_info->senders, transport_id, this,
       StatsReport::kSend);
-  if (video_info.bw_estimations.size() != 1) {
-    LOG(LS_ERROR) << "BWEs count: " << video_info.bw_estimations.size();
+  if (video_info->bw_estimations.size() != 1) {
+    LOG(LS_ERROR) << "BWEs count: " << video_info->bw_estimations.size();
   } else {
     StatsReport::Id report_id(StatsReport::NewBandwidthEstimationId());
     StatsReport* report = reports_.FindOrAddNew(report_id);
     ExtractStats(
-        video_info.bw_estimations[0], stats_gathering_started_, level, report);
+        video_info->bw_estimations[0], stats_gathering_started_, level, report);
   }
 }
 
@@ -15,6 +15,7 @@
 #define WEBRTC_API_STATSCOLLECTOR_H_
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -110,8 +111,14 @@ class StatsCollector {
 
   void ExtractDataInfo();
   void ExtractSessionInfo();
-  void ExtractVoiceInfo();
-  void ExtractVideoInfo(PeerConnectionInterface::StatsOutputLevel level);
+  // Fetches the voice and video media stats with a single call to the worker
+  // thread. Leaves an info null if there is no such channel or it failed to
+  // get stats.
+  void GetMediaInfo(std::unique_ptr<cricket::VoiceMediaInfo>* voice_info,
+                    std::unique_ptr<cricket::VideoMediaInfo>* video_info);
+  void ExtractVoiceInfo(const cricket::VoiceMediaInfo* voice_info);
+  void ExtractVideoInfo(PeerConnectionInterface::StatsOutputLevel level,
+                        const cricket::VideoMediaInfo* video_info);
   void ExtractSenderInfo();
   void BuildSsrcToTransportId();
   webrtc::StatsReport* GetReport(const StatsReport::StatsType& type,
@@ -155,6 +155,12 @@ class FakeAudioCaptureModule
   int32_t PlayoutBuffer(BufferType* type, uint16_t* size_ms) const override;
   int32_t PlayoutDelay(uint16_t* delay_ms) const override;
   int32_t RecordingDelay(uint16_t* delay_ms) const override;
+  int32_t SetLowLatencyMode(bool enable,
+                            uint16_t playout_period_ms,
+                            uint16_t recording_period_ms) override {
+    return -1;
+  }
+  int32_t GetPlayoutUnderrunCount() const override { return -1; }
 
   int32_t CPULoad(uint16_t* load) const override;
 
@@ -73,6 +73,9 @@ enum PeerConnectionMetricsName {
   kTimeToConnect,           // In milliseconds.
   kLocalCandidates_IPv4,    // Number of IPv4 local candidates.
   kLocalCandidates_IPv6,    // Number of IPv6 local candidates.
+  // In milliseconds, for full and resumed DTLS handshakes.
+  kDtlsHandshakeTime,
+  kDtlsResumedHandshakeTime,
   kPeerConnectionMetricsName_Max
 };
 
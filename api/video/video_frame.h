@@ -15,6 +15,7 @@
 
 #include "webrtc/api/video/video_rotation.h"
 #include "webrtc/api/video/video_frame_buffer.h"
+#include "webrtc/base/optional.h"
 
 // TODO(nisse): Transition hack, some downstream applications expect
 // that including this file also defines base/timeutils.h constants.
@@ -25,6 +26,17 @@ namespace webrtc {
 
 class VideoFrame {
  public:
+  // The part of the frame that changed since the previous frame from the same
+  // source, in pixels of this frame.
+  struct UpdateRect {
+    int offset_x;
+    int offset_y;
+    int width;
+    int height;
+
+    bool IsEmpty() const { return width <= 0 || height <= 0; }
+  };
+
   // TODO(nisse): This constructor is consistent with the now deleted
   // cricket::WebRtcVideoFrame. We should consider whether or not we
   // want to stick to this style and deprecate the other constructor.
@@ -89,6 +101,17 @@ class VideoFrame {
   VideoRotation rotation() const { return rotation_; }
   void set_rotation(VideoRotation rotation) { rotation_ = rotation; }
 
+  // Set by sources that know which part of the frame changed, e.g. the
+  // bounding box of the updated region of a screen capture. Unset means that
+  // the whole frame may have changed. An empty rect means that the frame is
+  // identical to the previous one, so the encoder may skip it. Anything that
+  // drops frames on the way to the encoder must merge the rects of the
+  // frames it drops into the next frame it passes on.
+  const rtc::Optional<UpdateRect>& update_rect() const { return update_rect_; }
+  void set_update_rect(const rtc::Optional<UpdateRect>& update_rect) {
+    update_rect_ = update_rect;
+  }
+
   // Set render time in milliseconds.
   void set_render_time_ms(int64_t render_time_ms);
 
@@ -112,6 +135,7 @@ class VideoFrame {
   int64_t ntp_time_ms_;
   int64_t timestamp_us_;
   VideoRotation rotation_;
+  rtc::Optional<UpdateRect> update_rect_;
 };
 
 }  // namespace webrtc
@@ -13,6 +13,7 @@
 #include <ctype.h>
 #include <limits.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <algorithm>
 #include <memory>
@@ -231,7 +232,8 @@ typedef std::vector<SsrcInfo> SsrcInfoVec;
 typedef std::vector<SsrcGroup> SsrcGroupVec;
 
 template <class T>
-static void AddFmtpLine(const T& codec, std::string* message);
+static void AddFmtpLine(const T& codec, std::ostringstream* os,
+                        std::string* message);
 static void BuildMediaDescription(const ContentInfo* content_info,
                                   const TransportInfo* transport_info,
                                   const MediaType media_type,
@@ -442,7 +444,9 @@ static bool GetLine(const std::string& message,
   if (line_end > 0 && (message.at(line_end - 1) == kReturn)) {
     --line_end;
   }
-  *line = message.substr(line_begin, (line_end - line_begin));
+  // Assign instead of copying a substring, so that the capacity of |line| is
+  // reused from line to line.
+  line->assign(message, line_begin, line_end - line_begin);
   const char* cline = line->c_str();
   // RFC 4566
   // An SDP session description consists of a number of lines of text of
@@ -516,32 +520,44 @@ static bool HasAttribute(const std::string& line,
   return (line.compare(kLinePrefixLength, attribute.size(), attribute) == 0);
 }
 
+// Overload for the attribute constants, which doesn't construct a temporary
+// string for every line and attribute that is compared.
+static bool HasAttribute(const std::string& line, const char* attribute) {
+  return (line.compare(kLinePrefixLength, strlen(attribute), attribute) == 0);
+}
+
 static bool AddSsrcLine(uint32_t ssrc_id,
                         const std::string& attribute,
                         const std::string& value,
+                        std::ostringstream* os,
                         std::string* message) {
   // RFC 5576
   // a=ssrc:<ssrc-id> <attribute>:<value>
-  std::ostringstream os;
-  InitAttrLine(kAttributeSsrc, &os);
-  os << kSdpDelimiterColon << ssrc_id << kSdpDelimiterSpace
-     << attribute << kSdpDelimiterColon << value;
-  return AddLine(os.str(), message);
+  InitAttrLine(kAttributeSsrc, os);
+  *os << kSdpDelimiterColon << ssrc_id << kSdpDelimiterSpace
+      << attribute << kSdpDelimiterColon << value;
+  return AddLine(os->str(), message);
 }
 
 // Get value only from <attribute>:<value>.
 static bool GetValue(const std::string& message, const std::string& attribute,
                      std::string* value, SdpParseError* error) {
-  std::string leftpart;
-  if (!rtc::tokenize_first(message, kSdpDelimiterColon, &leftpart, value)) {
+  // Splits like rtc::tokenize_first, without copying the left part.
+  size_t colon = message.find(kSdpDelimiterColon);
+  if (colon == std::string::npos) {
     return ParseFailedGetValue(message, attribute, error);
   }
   // The left part should end with the expected attribute.
-  if (leftpart.length() < attribute.length() ||
-      leftpart.compare(leftpart.length() - attribute.length(),
-                       attribute.length(), attribute) != 0) {
+  if (colon < attribute.length() ||
+      message.compare(colon - attribute.length(), attribute.length(),
+                      attribute) != 0) {
     return ParseFailedGetValue(message, attribute, error);
   }
+  size_t value_begin = message.find_first_not_of(kSdpDelimiterColon, colon);
+  if (value_begin == std::string::npos)
+    value->clear();
+  else
+    value->assign(message, value_begin, std::string::npos);
   return true;
 }
 
@@ -1533,7 +1549,7 @@ void BuildRtpContentAttributes(const MediaContentDescription* media_desc,
       // RFC 5576
       // a=ssrc:<ssrc-id> cname:<value>
       AddSsrcLine(ssrc, kSsrcAttributeCname,
-                  track->cname, message);
+                  track->cname, &os, message);
 
       // draft-alvestrand-mmusic-msid-00
       // a=ssrc:<ssrc-id> msid:identifier [appdata]
@@ -1552,8 +1568,9 @@ void BuildRtpContentAttributes(const MediaContentDescription* media_desc,
       // a=ssrc:<ssrc-id> mslabel:<value>
       // The label isn't yet defined.
       // a=ssrc:<ssrc-id> label:<value>
-      AddSsrcLine(ssrc, kSsrcAttributeMslabel, track->sync_label, message);
-      AddSsrcLine(ssrc, kSSrcAttributeLabel, track->id, message);
+      AddSsrcLine(ssrc, kSsrcAttributeMslabel, track->sync_label, &os,
+                  message);
+      AddSsrcLine(ssrc, kSSrcAttributeLabel, track->id, &os, message);
     }
   }
 }
@@ -1645,32 +1662,32 @@ void GetFmtpParams(const cricket::CodecParameterMap& params,
 }
 
 template <class T>
-void AddFmtpLine(const T& codec, std::string* message) {
+void AddFmtpLine(const T& codec, std::ostringstream* os,
+                 std::string* message) {
   cricket::CodecParameterMap fmtp_parameters;
   GetFmtpParams(codec.params, &fmtp_parameters);
   if (fmtp_parameters.empty()) {
     // No need to add an fmtp if it will have no (optional) parameters.
     return;
   }
-  std::ostringstream os;
-  WriteFmtpHeader(codec.id, &os);
-  WriteFmtpParameters(fmtp_parameters, &os);
-  AddLine(os.str(), message);
+  WriteFmtpHeader(codec.id, os);
+  WriteFmtpParameters(fmtp_parameters, os);
+  AddLine(os->str(), message);
   return;
 }
 
 template <class T>
-void AddRtcpFbLines(const T& codec, std::string* message) {
+void AddRtcpFbLines(const T& codec, std::ostringstream* os,
+                    std::string* message) {
   for (std::vector<cricket::FeedbackParam>::const_iterator iter =
            codec.feedback_params.params().begin();
        iter != codec.feedback_params.params().end(); ++iter) {
-    std::ostringstream os;
-    WriteRtcpFbHeader(codec.id, &os);
-    os << " " << iter->id();
+    WriteRtcpFbHeader(codec.id, os);
+    *os << " " << iter->id();
     if (!iter->param().empty()) {
-      os << " " << iter->param();
+      *os << " " << iter->param();
     }
-    AddLine(os.str(), message);
+    AddLine(os->str(), message);
   }
 }
 
@@ -1737,8 +1754,8 @@ void BuildRtpMap(const MediaContentDescription* media_desc,
          << "/" << kDefaultVideoClockrate;
         AddLine(os.str(), message);
       }
-      AddRtcpFbLines(*it, message);
-      AddFmtpLine(*it, message);
+      AddRtcpFbLines(*it, &os, message);
+      AddFmtpLine(*it, &os, message);
     }
   } else if (media_type == cricket::MEDIA_TYPE_AUDIO) {
     const AudioContentDescription* audio_desc =
@@ -1760,8 +1777,8 @@ void BuildRtpMap(const MediaContentDescription* media_desc,
         os << "/" << it->channels;
       }
       AddLine(os.str(), message);
-      AddRtcpFbLines(*it, message);
-      AddFmtpLine(*it, message);
+      AddRtcpFbLines(*it, &os, message);
+      AddFmtpLine(*it, &os, message);
       int minptime = 0;
       if (GetParameter(kCodecParamMinPTime, it->params, &minptime)) {
         max_minptime = std::max(minptime, max_minptime);
@@ -2494,25 +2511,11 @@ T GetCodecWithPayloadType(const std::vector<T>& codecs, int payload_type) {
 }
 
 // Updates or creates a new codec entry in the audio description.
+// Replaces the codec in place rather than copying all the codecs, since this is
+// done for every rtpmap, fmtp and rtcp-fb line.
 template <class T, class U>
 void AddOrReplaceCodec(MediaContentDescription* content_desc, const U& codec) {
-  T* desc = static_cast<T*>(content_desc);
-  std::vector<U> codecs = desc->codecs();
-  bool found = false;
-
-  typename std::vector<U>::iterator iter;
-  for (iter = codecs.begin(); iter != codecs.end(); ++iter) {
-    if (iter->id == codec.id) {
-      *iter = codec;
-      found = true;
-      break;
-    }
-  }
-  if (!found) {
-    desc->AddCodec(codec);
-    return;
-  }
-  desc->set_codecs(codecs);
+  static_cast<T*>(content_desc)->AddOrReplaceCodec(codec);
 }
 
 // Adds or updates existing codec corresponding to |payload_type| according
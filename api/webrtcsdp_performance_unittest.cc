@@ -0,0 +1,142 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <sstream>
+#include <string>
+
+#include "webrtc/api/jsepsessiondescription.h"
+#include "webrtc/api/webrtcsdp.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/p2p/base/sessiondescription.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+constexpr int kNumMediaSections = 100;
+constexpr int kNumIterations = 20;
+
+const char kFingerprint[] =
+    "a=fingerprint:sha-256 "
+    "4A:AD:B9:B1:3F:82:18:3B:54:02:12:DF:3E:5D:49:6B:"
+    "19:E5:7C:AB:4A:AD:B9:B1:3F:82:18:3B:54:02:12:DF\r\n";
+
+// The codecs, header extensions and feedback offered by a browser for video.
+const char kVideoAttributes[] =
+    "a=extmap:2 urn:ietf:params:rtp-hdrext:toffset\r\n"
+    "a=extmap:3 http://www.webrtc.org/experiments/rtp-hdrext/abs-send-time\r\n"
+    "a=extmap:4 urn:3gpp:video-orientation\r\n"
+    "a=extmap:5 http://www.ietf.org/id/"
+    "draft-holmer-rmcat-transport-wide-cc-extensions-01\r\n"
+    "a=sendrecv\r\n"
+    "a=rtcp-mux\r\n"
+    "a=rtcp-rsize\r\n"
+    "a=rtpmap:96 VP8/90000\r\n"
+    "a=rtcp-fb:96 goog-remb\r\n"
+    "a=rtcp-fb:96 transport-cc\r\n"
+    "a=rtcp-fb:96 ccm fir\r\n"
+    "a=rtcp-fb:96 nack\r\n"
+    "a=rtcp-fb:96 nack pli\r\n"
+    "a=rtpmap:97 rtx/90000\r\n"
+    "a=fmtp:97 apt=96\r\n"
+    "a=rtpmap:98 VP9/90000\r\n"
+    "a=rtcp-fb:98 goog-remb\r\n"
+    "a=rtcp-fb:98 transport-cc\r\n"
+    "a=rtcp-fb:98 ccm fir\r\n"
+    "a=rtcp-fb:98 nack\r\n"
+    "a=rtcp-fb:98 nack pli\r\n"
+    "a=rtpmap:99 rtx/90000\r\n"
+    "a=fmtp:99 apt=98\r\n"
+    "a=rtpmap:100 H264/90000\r\n"
+    "a=rtcp-fb:100 goog-remb\r\n"
+    "a=rtcp-fb:100 transport-cc\r\n"
+    "a=rtcp-fb:100 ccm fir\r\n"
+    "a=rtcp-fb:100 nack\r\n"
+    "a=rtcp-fb:100 nack pli\r\n"
+    "a=fmtp:100 level-asymmetry-allowed=1;packetization-mode=1;"
+    "profile-level-id=42e01f\r\n"
+    "a=rtpmap:101 rtx/90000\r\n"
+    "a=fmtp:101 apt=100\r\n"
+    "a=rtpmap:102 red/90000\r\n"
+    "a=rtpmap:124 rtx/90000\r\n"
+    "a=fmtp:124 apt=102\r\n"
+    "a=rtpmap:127 ulpfec/90000\r\n";
+
+// Builds an offer with one video m= section per remote participant, all of
+// them bundled, like a conferencing server would send.
+std::string CreateOffer() {
+  std::ostringstream os;
+  os << "v=0\r\n"
+     << "o=- 5523461565405398713 2 IN IP4 127.0.0.1\r\n"
+     << "s=-\r\n"
+     << "t=0 0\r\n"
+     << "a=group:BUNDLE";
+  for (int i = 0; i < kNumMediaSections; ++i)
+    os << " video" << i;
+  os << "\r\n"
+     << "a=msid-semantic: WMS";
+  for (int i = 0; i < kNumMediaSections; ++i)
+    os << " stream" << i;
+  os << "\r\n";
+  for (int i = 0; i < kNumMediaSections; ++i) {
+    const uint32_t ssrc = 1000 + 2 * i;
+    const uint32_t rtx_ssrc = ssrc + 1;
+    os << "m=video 9 UDP/TLS/RTP/SAVPF 96 97 98 99 100 101 102 124 127\r\n"
+       << "c=IN IP4 0.0.0.0\r\n"
+       << "a=rtcp:9 IN IP4 0.0.0.0\r\n"
+       << "a=ice-ufrag:eW1J\r\n"
+       << "a=ice-pwd:ZBhBquzOa2kDHSIGbrQvsrOq\r\n"
+       << kFingerprint
+       << "a=setup:actpass\r\n"
+       << "a=mid:video" << i << "\r\n"
+       << kVideoAttributes
+       << "a=ssrc-group:FID " << ssrc << " " << rtx_ssrc << "\r\n";
+    for (uint32_t s : {ssrc, rtx_ssrc}) {
+      os << "a=ssrc:" << s << " cname:participant" << i << "\r\n"
+         << "a=ssrc:" << s << " msid:stream" << i << " track" << i << "\r\n"
+         << "a=ssrc:" << s << " mslabel:stream" << i << "\r\n"
+         << "a=ssrc:" << s << " label:track" << i << "\r\n";
+    }
+  }
+  return os.str();
+}
+}  // namespace
+
+// Time to parse and serialize an offer with 100 video m= sections.
+TEST(WebRtcSdpPerformanceTest, ParseAndSerializeManyMediaSections) {
+  const std::string offer = CreateOffer();
+  int64_t parse_time_us = 0;
+  int64_t serialize_time_us = 0;
+  std::string serialized;
+  for (int i = 0; i < kNumIterations; ++i) {
+    JsepSessionDescription desc(JsepSessionDescription::kOffer);
+    SdpParseError error;
+    int64_t start_time_us = rtc::TimeMicros();
+    ASSERT_TRUE(SdpDeserialize(offer, &desc, &error)) << error.description;
+    int64_t parsed_time_us = rtc::TimeMicros();
+    serialized = SdpSerialize(desc, false);
+    serialize_time_us += rtc::TimeMicros() - parsed_time_us;
+    parse_time_us += parsed_time_us - start_time_us;
+    EXPECT_EQ(static_cast<size_t>(kNumMediaSections),
+              desc.description()->contents().size());
+  }
+
+  // The serialized offer is parsed into the same description.
+  JsepSessionDescription reparsed(JsepSessionDescription::kOffer);
+  ASSERT_TRUE(SdpDeserialize(serialized, &reparsed, nullptr));
+  EXPECT_EQ(serialized, SdpSerialize(reparsed, false));
+
+  test::PrintResult("sdp_parse", "", "100_m_sections",
+                    1.0 * parse_time_us / kNumIterations, "us", false);
+  test::PrintResult("sdp_serialize", "", "100_m_sections",
+                    1.0 * serialize_time_us / kNumIterations, "us", false);
+}
+
+}  // namespace webrtc
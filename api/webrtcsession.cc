@@ -958,20 +958,25 @@ bool WebRtcSession::PushdownMediaDescription(
     cricket::ContentAction action,
     cricket::ContentSource source,
     std::string* err) {
-  auto set_content = [this, action, source, err](cricket::BaseChannel* ch) {
+  const SessionDescription* sdesc =
+      (source == cricket::CS_LOCAL ? local_description()
+                                   : remote_description())->description();
+  auto set_content = [action, source, sdesc, err](cricket::BaseChannel* ch) {
     if (!ch) {
       return true;
     } else if (source == cricket::CS_LOCAL) {
-      return ch->PushdownLocalDescription(local_description()->description(),
-                                          action, err);
+      return ch->PushdownLocalDescription(sdesc, action, err);
     } else {
-      return ch->PushdownRemoteDescription(remote_description()->description(),
-                                           action, err);
+      return ch->PushdownRemoteDescription(sdesc, action, err);
     }
   };
 
-  bool ret = (set_content(voice_channel()) && set_content(video_channel()) &&
-              set_content(rtp_data_channel()));
+  // Push down the contents of all the channels with a single hop to the
+  // worker thread; the channels' own invokes then run synchronously.
+  bool ret = worker_thread()->Invoke<bool>(RTC_FROM_HERE, [&] {
+    return set_content(voice_channel()) && set_content(video_channel()) &&
+           set_content(rtp_data_channel());
+  });
   // Need complete offer/answer with an SCTP m= section before starting SCTP,
   // according to https://tools.ietf.org/html/draft-ietf-mmusic-sctp-sdp-19
   if (sctp_transport_ && local_description() && remote_description() &&
@@ -1018,14 +1023,17 @@ bool WebRtcSession::PushdownLocalTransportDescription(
     return false;
   }
 
-  for (const TransportInfo& tinfo : sdesc->transport_infos()) {
-    if (!transport_controller_->SetLocalTransportDescription(
-            tinfo.content_name, tinfo.description, action, err)) {
-      return false;
+  // A single hop to the network thread for all the transports, instead of
+  // one per transport.
+  return network_thread_->Invoke<bool>(RTC_FROM_HERE, [&] {
+    for (const TransportInfo& tinfo : sdesc->transport_infos()) {
+      if (!transport_controller_->SetLocalTransportDescription(
+              tinfo.content_name, tinfo.description, action, err)) {
+        return false;
+      }
     }
-  }
-
-  return true;
+    return true;
+  });
 }
 
 bool WebRtcSession::PushdownRemoteTransportDescription(
@@ -1038,14 +1046,15 @@ bool WebRtcSession::PushdownRemoteTransportDescription(
     return false;
   }
 
-  for (const TransportInfo& tinfo : sdesc->transport_infos()) {
-    if (!transport_controller_->SetRemoteTransportDescription(
-            tinfo.content_name, tinfo.description, action, err)) {
-      return false;
+  return network_thread_->Invoke<bool>(RTC_FROM_HERE, [&] {
+    for (const TransportInfo& tinfo : sdesc->transport_infos()) {
+      if (!transport_controller_->SetRemoteTransportDescription(
+              tinfo.content_name, tinfo.description, action, err)) {
+        return false;
+      }
     }
-  }
-
-  return true;
+    return true;
+  });
 }
 
 bool WebRtcSession::GetTransportDescription(
@@ -1765,60 +1774,89 @@ bool WebRtcSession::CreateChannels(const SessionDescription* desc) {
   }
   // Creating the media channels and transport proxies.
   const cricket::ContentInfo* voice = cricket::GetFirstAudioContent(desc);
-  if (voice && !voice->rejected && !voice_channel_) {
-    if (!CreateVoiceChannel(voice,
-                            GetBundleTransportName(voice, bundle_group))) {
-      LOG(LS_ERROR) << "Failed to create voice channel.";
-      return false;
-    }
-  }
-
+  const bool create_voice = voice && !voice->rejected && !voice_channel_;
   const cricket::ContentInfo* video = cricket::GetFirstVideoContent(desc);
-  if (video && !video->rejected && !video_channel_) {
-    if (!CreateVideoChannel(video,
-                            GetBundleTransportName(video, bundle_group))) {
-      LOG(LS_ERROR) << "Failed to create video channel.";
+  const bool create_video = video && !video->rejected && !video_channel_;
+  const cricket::ContentInfo* data = cricket::GetFirstDataContent(desc);
+  const bool create_data = data_channel_type_ != cricket::DCT_NONE && data &&
+                           !data->rejected && !rtp_data_channel_ &&
+                           !sctp_transport_;
+  const bool create_rtp_data =
+      create_data && data_channel_type_ == cricket::DCT_RTP;
+
+  // The transport channels are created with a single hop to the network
+  // thread, and the voice, video and RTP data channels with a single call to
+  // the ChannelManager.
+  const bool require_rtcp_mux =
+      rtcp_mux_policy_ == PeerConnectionInterface::kRtcpMuxPolicyRequire;
+  const bool srtp_required = SrtpRequired();
+  std::vector<cricket::ChannelManager::ChannelConfig> configs;
+  auto add_config = [&](cricket::MediaType media_type,
+                        const cricket::ContentInfo* content) {
+    cricket::ChannelManager::ChannelConfig config;
+    config.media_type = media_type;
+    config.content_name = content->name;
+    config.bundle_transport_name =
+        GetBundleTransportName(content, bundle_group);
+    const std::string& transport_name = config.bundle_transport_name
+                                            ? *config.bundle_transport_name
+                                            : content->name;
+    config.rtp_transport = transport_controller_->CreateTransportChannel(
+        transport_name, cricket::ICE_CANDIDATE_COMPONENT_RTP);
+    if (!require_rtcp_mux) {
+      config.rtcp_transport = transport_controller_->CreateTransportChannel(
+          transport_name, cricket::ICE_CANDIDATE_COMPONENT_RTCP);
+    }
+    config.rtcp_mux_required = require_rtcp_mux;
+    config.srtp_required = srtp_required;
+    config.audio_options = audio_options_;
+    config.video_options = video_options_;
+    configs.push_back(config);
+  };
+  network_thread_->Invoke<void>(RTC_FROM_HERE, [&] {
+    if (create_voice)
+      add_config(cricket::MEDIA_TYPE_AUDIO, voice);
+    if (create_video)
+      add_config(cricket::MEDIA_TYPE_VIDEO, video);
+    if (create_rtp_data)
+      add_config(cricket::MEDIA_TYPE_DATA, data);
+  });
+
+  if (!configs.empty()) {
+    std::vector<cricket::BaseChannel*> channels =
+        channel_manager_->CreateChannels(
+            media_controller_, transport_controller_->signaling_thread(),
+            configs);
+    if (channels.empty()) {
+      LOG(LS_ERROR) << "Failed to create media channels.";
       return false;
     }
+    auto channel = channels.begin();
+    if (create_voice) {
+      voice_channel_.reset(static_cast<cricket::VoiceChannel*>(*channel++));
+      InitVoiceChannel();
+    }
+    if (create_video) {
+      video_channel_.reset(static_cast<cricket::VideoChannel*>(*channel++));
+      InitVideoChannel();
+    }
+    if (create_rtp_data) {
+      rtp_data_channel_.reset(
+          static_cast<cricket::RtpDataChannel*>(*channel++));
+      InitRtpDataChannel();
+    }
   }
 
-  const cricket::ContentInfo* data = cricket::GetFirstDataContent(desc);
-  if (data_channel_type_ != cricket::DCT_NONE && data && !data->rejected &&
-      !rtp_data_channel_ && !sctp_transport_) {
-    if (!CreateDataChannel(data, GetBundleTransportName(data, bundle_group))) {
-      LOG(LS_ERROR) << "Failed to create data channel.";
-      return false;
-    }
+  if (create_data && !create_rtp_data &&
+      !CreateDataChannel(data, GetBundleTransportName(data, bundle_group))) {
+    LOG(LS_ERROR) << "Failed to create data channel.";
+    return false;
   }
 
   return true;
 }
 
-bool WebRtcSession::CreateVoiceChannel(const cricket::ContentInfo* content,
-                                       const std::string* bundle_transport) {
-  bool require_rtcp_mux =
-      rtcp_mux_policy_ == PeerConnectionInterface::kRtcpMuxPolicyRequire;
-
-  std::string transport_name =
-      bundle_transport ? *bundle_transport : content->name;
-
-  cricket::TransportChannel* rtp_transport =
-      transport_controller_->CreateTransportChannel(
-          transport_name, cricket::ICE_CANDIDATE_COMPONENT_RTP);
-  cricket::TransportChannel* rtcp_transport = nullptr;
-  if (!require_rtcp_mux) {
-    rtcp_transport = transport_controller_->CreateTransportChannel(
-        transport_name, cricket::ICE_CANDIDATE_COMPONENT_RTCP);
-  }
-
-  voice_channel_.reset(channel_manager_->CreateVoiceChannel(
-      media_controller_, rtp_transport, rtcp_transport,
-      transport_controller_->signaling_thread(), content->name,
-      bundle_transport, require_rtcp_mux, SrtpRequired(), audio_options_));
-  if (!voice_channel_) {
-    return false;
-  }
-
+void WebRtcSession::InitVoiceChannel() {
   if (media_crypto_enabled_)
     voice_channel_->SetMediaCryptoKey(media_crypto_key_);
 
@@ -1830,35 +1868,9 @@ bool WebRtcSession::CreateVoiceChannel(const cricket::ContentInfo* content,
   SignalVoiceChannelCreated();
   voice_channel_->SignalSentPacket.connect(this,
                                            &WebRtcSession::OnSentPacket_w);
-  return true;
 }
 
-bool WebRtcSession::CreateVideoChannel(const cricket::ContentInfo* content,
-                                       const std::string* bundle_transport) {
-  bool require_rtcp_mux =
-      rtcp_mux_policy_ == PeerConnectionInterface::kRtcpMuxPolicyRequire;
-
-  std::string transport_name =
-      bundle_transport ? *bundle_transport : content->name;
-
-  cricket::TransportChannel* rtp_transport =
-      transport_controller_->CreateTransportChannel(
-          transport_name, cricket::ICE_CANDIDATE_COMPONENT_RTP);
-  cricket::TransportChannel* rtcp_transport = nullptr;
-  if (!require_rtcp_mux) {
-    rtcp_transport = transport_controller_->CreateTransportChannel(
-        transport_name, cricket::ICE_CANDIDATE_COMPONENT_RTCP);
-  }
-
-  video_channel_.reset(channel_manager_->CreateVideoChannel(
-      media_controller_, rtp_transport, rtcp_transport,
-      transport_controller_->signaling_thread(), content->name,
-      bundle_transport, require_rtcp_mux, SrtpRequired(), video_options_));
-
-  if (!video_channel_) {
-    return false;
-  }
-  
+void WebRtcSession::InitVideoChannel() {
   if (media_crypto_enabled_)
     video_channel_->SetMediaCryptoKey(media_crypto_key_);
 
@@ -1870,7 +1882,17 @@ bool WebRtcSession::CreateVideoChannel(const cricket::ContentInfo* content,
   SignalVideoChannelCreated();
   video_channel_->SignalSentPacket.connect(this,
                                            &WebRtcSession::OnSentPacket_w);
-  return true;
+}
+
+void WebRtcSession::InitRtpDataChannel() {
+  rtp_data_channel_->SignalRtcpMuxFullyActive.connect(
+      this, &WebRtcSession::DestroyRtcpTransport_n);
+  rtp_data_channel_->SignalDtlsSrtpSetupFailure.connect(
+      this, &WebRtcSession::OnDtlsSrtpSetupFailure);
+  rtp_data_channel_->SignalSentPacket.connect(this,
+                                              &WebRtcSession::OnSentPacket_w);
+
+  SignalDataChannelCreated();
 }
 
 bool WebRtcSession::CreateDataChannel(const cricket::ContentInfo* content,
@@ -1884,49 +1906,16 @@ bool WebRtcSession::CreateDataChannel(const cricket::ContentInfo* content,
     return true;
   }
 #endif  // HAVE_QUIC
-  bool sctp = (data_channel_type_ == cricket::DCT_SCTP);
-  if (sctp) {
-    if (!sctp_factory_) {
-      LOG(LS_ERROR)
-          << "Trying to create SCTP transport, but didn't compile with "
-             "SCTP support (HAVE_SCTP)";
-      return false;
-    }
-    if (!network_thread_->Invoke<bool>(
-            RTC_FROM_HERE, rtc::Bind(&WebRtcSession::CreateSctpTransport_n,
-                                     this, content->name, transport_name))) {
-      return false;
-    };
-  } else {
-    bool require_rtcp_mux =
-        rtcp_mux_policy_ == PeerConnectionInterface::kRtcpMuxPolicyRequire;
-
-    std::string transport_name =
-        bundle_transport ? *bundle_transport : content->name;
-    cricket::TransportChannel* rtp_transport =
-        transport_controller_->CreateTransportChannel(
-            transport_name, cricket::ICE_CANDIDATE_COMPONENT_RTP);
-    cricket::TransportChannel* rtcp_transport = nullptr;
-    if (!require_rtcp_mux) {
-      rtcp_transport = transport_controller_->CreateTransportChannel(
-          transport_name, cricket::ICE_CANDIDATE_COMPONENT_RTCP);
-    }
-
-    rtp_data_channel_.reset(channel_manager_->CreateRtpDataChannel(
-        media_controller_, rtp_transport, rtcp_transport,
-        transport_controller_->signaling_thread(), content->name,
-        bundle_transport, require_rtcp_mux, SrtpRequired()));
-
-    if (!rtp_data_channel_) {
-      return false;
-    }
-
-    rtp_data_channel_->SignalRtcpMuxFullyActive.connect(
-        this, &WebRtcSession::DestroyRtcpTransport_n);
-    rtp_data_channel_->SignalDtlsSrtpSetupFailure.connect(
-        this, &WebRtcSession::OnDtlsSrtpSetupFailure);
-    rtp_data_channel_->SignalSentPacket.connect(this,
-                                                &WebRtcSession::OnSentPacket_w);
+  if (!sctp_factory_) {
+    LOG(LS_ERROR)
+        << "Trying to create SCTP transport, but didn't compile with "
+           "SCTP support (HAVE_SCTP)";
+    return false;
+  }
+  if (!network_thread_->Invoke<bool>(
+          RTC_FROM_HERE, rtc::Bind(&WebRtcSession::CreateSctpTransport_n,
+                                   this, content->name, transport_name))) {
+    return false;
   }
 
   SignalDataChannelCreated();
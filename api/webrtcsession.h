@@ -466,11 +466,11 @@ class WebRtcSession :
   // This method will also delete any existing media channels before creating.
   bool CreateChannels(const cricket::SessionDescription* desc);
 
-  // Helper methods to create media channels.
-  bool CreateVoiceChannel(const cricket::ContentInfo* content,
-                          const std::string* bundle_transport);
-  bool CreateVideoChannel(const cricket::ContentInfo* content,
-                          const std::string* bundle_transport);
+  // Helper methods to set up the media channels once they're created.
+  void InitVoiceChannel();
+  void InitVideoChannel();
+  void InitRtpDataChannel();
+  // Creates an SCTP or QUIC data channel.
   bool CreateDataChannel(const cricket::ContentInfo* content,
                          const std::string* bundle_transport);
 
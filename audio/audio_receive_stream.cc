@@ -127,6 +127,7 @@ AudioReceiveStream::~AudioReceiveStream() {
     Stop();
   }
   channel_proxy_->DisassociateSendChannel();
+  channel_proxy_->SetAudioLevelSink(nullptr);
   channel_proxy_->DeRegisterExternalTransport();
   channel_proxy_->ResetCongestionControlObjects();
   channel_proxy_->SetRtcEventLog(nullptr);
@@ -220,6 +221,11 @@ void AudioReceiveStream::SetSink(std::unique_ptr<AudioSinkInterface> sink) {
   channel_proxy_->SetSink(std::move(sink));
 }
 
+void AudioReceiveStream::SetAudioLevelSink(AudioLevelSinkInterface* sink) {
+  RTC_DCHECK_RUN_ON(&thread_checker_);
+  channel_proxy_->SetAudioLevelSink(sink);
+}
+
 void AudioReceiveStream::SetGain(float gain) {
   RTC_DCHECK_RUN_ON(&thread_checker_);
   channel_proxy_->SetChannelOutputVolumeScaling(gain);
@@ -279,7 +285,10 @@ bool AudioReceiveStream::DeliverRtp(const uint8_t* packet,
                                               header);
   }
 
-  return channel_proxy_->ReceivedRTPPacket(packet, length, packet_time);
+  // Hand the parsed header on so that the channel does not parse it again.
+  // Both parsers have the same extensions registered, see the constructor.
+  return channel_proxy_->ReceivedRTPPacket(packet, length, header,
+                                           packet_time);
 }
 
 AudioMixer::Source::AudioFrameInfo AudioReceiveStream::GetAudioFrameWithInfo(
@@ -296,6 +305,15 @@ int AudioReceiveStream::Ssrc() const {
   return config_.rtp.remote_ssrc;
 }
 
+rtc::Optional<int> AudioReceiveStream::AudioLevelDbov() const {
+  return channel_proxy_->ReceivedAudioLevelDbov();
+}
+
+void AudioReceiveStream::SkipAudioFrame(int sample_rate_hz,
+                                        AudioFrame* audio_frame) {
+  channel_proxy_->SkipAudioFrame(sample_rate_hz, audio_frame);
+}
+
 internal::AudioState* AudioReceiveStream::audio_state() const {
   auto* audio_state = static_cast<internal::AudioState*>(audio_state_.get());
   RTC_DCHECK(audio_state);
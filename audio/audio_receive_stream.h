@@ -48,6 +48,7 @@ class AudioReceiveStream final : public webrtc::AudioReceiveStream,
   void Stop() override;
   webrtc::AudioReceiveStream::Stats GetStats() const override;
   void SetSink(std::unique_ptr<AudioSinkInterface> sink) override;
+  void SetAudioLevelSink(AudioLevelSinkInterface* sink) override;
   void SetGain(float gain) override;
 
   void AssociateSendStream(AudioSendStream* send_stream);
@@ -63,6 +64,8 @@ class AudioReceiveStream final : public webrtc::AudioReceiveStream,
                                        AudioFrame* audio_frame) override;
   int PreferredSampleRate() const override;
   int Ssrc() const override;
+  rtc::Optional<int> AudioLevelDbov() const override;
+  void SkipAudioFrame(int sample_rate_hz, AudioFrame* audio_frame) override;
 
  private:
   VoiceEngine* voice_engine() const;
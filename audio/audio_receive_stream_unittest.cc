@@ -112,6 +112,8 @@ struct ConfigHelper {
               .Times(1)
               .After(expect_set);
           EXPECT_CALL(*channel_proxy_, DisassociateSendChannel()).Times(1);
+          EXPECT_CALL(*channel_proxy_, SetAudioLevelSink(testing::IsNull()))
+              .Times(1);
           return channel_proxy_;
         }));
     stream_config_.voe_channel_id = kChannelId;
@@ -279,6 +281,7 @@ TEST(AudioReceiveStreamTest, ReceiveRtpPacket) {
   EXPECT_CALL(*helper.channel_proxy(),
               ReceivedRTPPacket(&rtp_packet[0],
                                 rtp_packet.size(),
+                                VerifyHeaderExtension(expected_extension),
                                 _))
       .WillOnce(Return(true));
   EXPECT_TRUE(
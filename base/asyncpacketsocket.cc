@@ -26,4 +26,15 @@ AsyncPacketSocket::AsyncPacketSocket() {
 AsyncPacketSocket::~AsyncPacketSocket() {
 }
 
+int AsyncPacketSocket::SendPacketsTo(const OutgoingPacket* packets,
+                                     size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    if (SendTo(packets[i].data, packets[i].size, packets[i].address,
+               *packets[i].options) < 0) {
+      return i == 0 ? -1 : static_cast<int>(i);
+    }
+  }
+  return static_cast<int>(count);
+}
+
 };  // namespace rtc
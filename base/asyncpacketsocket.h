@@ -63,6 +63,15 @@ inline PacketTime CreatePacketTime(int64_t not_before) {
   return PacketTime(TimeMicros(), not_before);
 }
 
+// A packet passed to AsyncPacketSocket::SendPacketsTo(). The data and the
+// options are not copied and must outlive the call.
+struct OutgoingPacket {
+  const void* data;
+  size_t size;
+  SocketAddress address;
+  const PacketOptions* options;
+};
+
 // Provides the ability to receive packets asynchronously. Sends are not
 // buffered since it is acceptable to drop packets under high load.
 class AsyncPacketSocket : public sigslot::has_slots<> {
@@ -90,6 +99,19 @@ class AsyncPacketSocket : public sigslot::has_slots<> {
   virtual int SendTo(const void *pv, size_t cb, const SocketAddress& addr,
                      const PacketOptions& options) = 0;
 
+  // Sends a burst of packets, e.g. the packets released together by the
+  // pacer, with as few system calls as the socket allows. Returns the number
+  // of leading packets that were sent, or -1 if the first one failed. If not
+  // all were sent, GetError() tells why. The default implementation calls
+  // SendTo() for each packet.
+  virtual int SendPacketsTo(const OutgoingPacket* packets, size_t count);
+
+  // Returns how many bytes in front of the data passed to SignalReadPacket
+  // belong to the socket's receive buffer. Handlers may overwrite them, e.g.
+  // to prepend a header and forward the packet without copying it, but only
+  // until they return. The default implementation reserves none.
+  virtual size_t GetReceiveHeadroom() const { return 0; }
+
   // Close the socket.
   virtual int Close() = 0;
 
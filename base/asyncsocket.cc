@@ -19,6 +19,30 @@ AsyncSocket::AsyncSocket() {
 AsyncSocket::~AsyncSocket() {
 }
 
+int AsyncSocket::RecvFromBatch(ReceivedDatagram* datagrams, size_t count) {
+  if (count == 0)
+    return 0;
+  ReceivedDatagram& datagram = datagrams[0];
+  int received = RecvFrom(datagram.buffer, datagram.capacity,
+                          &datagram.address, &datagram.timestamp);
+  if (received < 0)
+    return received;
+  datagram.length = static_cast<size_t>(received);
+  datagram.truncated = false;
+  return 1;
+}
+
+int AsyncSocket::SendToBatch(const OutgoingDatagram* datagrams,
+                             size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    if (SendTo(datagrams[i].data, datagrams[i].length,
+               datagrams[i].address) < 0) {
+      return i == 0 ? -1 : static_cast<int>(i);
+    }
+  }
+  return static_cast<int>(count);
+}
+
 AsyncSocketAdapter::AsyncSocketAdapter(AsyncSocket* socket) : socket_(NULL) {
   Attach(socket);
 }
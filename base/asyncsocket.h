@@ -17,6 +17,25 @@
 
 namespace rtc {
 
+// A datagram read by AsyncSocket::RecvFromBatch(). |buffer| and |capacity|
+// are provided by the caller, the other fields are filled in by the socket.
+struct ReceivedDatagram {
+  char* buffer = nullptr;
+  size_t capacity = 0;
+  size_t length = 0;
+  // True if the datagram did not fit into |buffer| and was cut off.
+  bool truncated = false;
+  SocketAddress address;
+  int64_t timestamp = -1;
+};
+
+// A datagram to be written by AsyncSocket::SendToBatch().
+struct OutgoingDatagram {
+  const void* data;
+  size_t length;
+  SocketAddress address;
+};
+
 // TODO: Remove Socket and rename AsyncSocket to Socket.
 
 // Provides the ability to perform socket I/O asynchronously.
@@ -27,6 +46,17 @@ class AsyncSocket : public Socket {
 
   AsyncSocket* Accept(SocketAddress* paddr) override = 0;
 
+  // Reads up to |count| datagrams with as few system calls as possible.
+  // Returns the number of datagrams read, or -1 if none could be read. The
+  // default implementation reads a single datagram through RecvFrom().
+  virtual int RecvFromBatch(ReceivedDatagram* datagrams, size_t count);
+
+  // Writes |count| datagrams in order with as few system calls as possible.
+  // Returns the number of leading datagrams that were written, or -1 if the
+  // first one failed. If not all were written, GetError() tells why. The
+  // default implementation calls SendTo() for each datagram.
+  virtual int SendToBatch(const OutgoingDatagram* datagrams, size_t count);
+
   // SignalReadEvent and SignalWriteEvent use multi_threaded_local to allow
   // access concurrently from different thread.
   // For example SignalReadEvent::connect will be called in AsyncUDPSocket ctor
@@ -307,21 +307,26 @@ int AsyncTCPSocket::Send(const void *pv, size_t cb,
 void AsyncTCPSocket::ProcessInput(char * data, size_t* len) {
   SocketAddress remote_addr(GetRemoteAddress());
 
+  // Signal every complete packet in place and move the trailing partial
+  // packet to the front once, rather than after every packet.
+  size_t processed = 0;
   while (true) {
-    if (*len < kPacketLenSize)
-      return;
+    size_t remaining = *len - processed;
+    if (remaining < kPacketLenSize)
+      break;
 
-    PacketLength pkt_len = rtc::GetBE16(data);
-    if (*len < kPacketLenSize + pkt_len)
-      return;
+    PacketLength pkt_len = rtc::GetBE16(data + processed);
+    if (remaining < kPacketLenSize + pkt_len)
+      break;
 
-    SignalReadPacket(this, data + kPacketLenSize, pkt_len, remote_addr,
-                     CreatePacketTime(0));
+    SignalReadPacket(this, data + processed + kPacketLenSize, pkt_len,
+                     remote_addr, CreatePacketTime(0));
+    processed += kPacketLenSize + pkt_len;
+  }
 
-    *len -= kPacketLenSize + pkt_len;
-    if (*len > 0) {
-      memmove(data, data + kPacketLenSize + pkt_len, *len);
-    }
+  *len -= processed;
+  if (processed > 0 && *len > 0) {
+    memmove(data, data + processed, *len);
   }
 }
 
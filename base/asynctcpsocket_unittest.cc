@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "webrtc/base/asynctcpsocket.h"
 #include "webrtc/base/gunit.h"
@@ -50,4 +51,48 @@ TEST_F(AsyncTCPSocketTest, OnWriteEvent) {
   EXPECT_TRUE(ready_to_send_);
 }
 
+class AsyncTCPSocketReadTest
+    : public testing::Test,
+      public sigslot::has_slots<> {
+ public:
+  AsyncTCPSocketReadTest()
+      : pss_(new rtc::PhysicalSocketServer),
+        vss_(new rtc::VirtualSocketServer(pss_.get())),
+        tcp_socket_(
+            new AsyncTCPSocket(vss_->CreateAsyncSocket(SOCK_STREAM), false)) {
+    tcp_socket_->SignalReadPacket.connect(
+        this, &AsyncTCPSocketReadTest::OnReadPacket);
+  }
+
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t len,
+                    const SocketAddress& remote_addr,
+                    const PacketTime& packet_time) {
+    received_.push_back(std::string(data, len));
+  }
+
+ protected:
+  std::unique_ptr<PhysicalSocketServer> pss_;
+  std::unique_ptr<VirtualSocketServer> vss_;
+  std::unique_ptr<AsyncTCPSocket> tcp_socket_;
+  std::vector<std::string> received_;
+};
+
+TEST_F(AsyncTCPSocketReadTest, ProcessInputKeepsTrailingPartialPacket) {
+  // Two complete framed packets followed by the first bytes of a third.
+  char data[] = {0, 3, 'a', 'b', 'c', 0, 1, 'd', 0, 4, 'e', 'f'};
+  size_t len = sizeof(data);
+  tcp_socket_->ProcessInput(data, &len);
+
+  ASSERT_EQ(2u, received_.size());
+  EXPECT_EQ("abc", received_[0]);
+  EXPECT_EQ("d", received_[1]);
+  ASSERT_EQ(4u, len);
+  EXPECT_EQ(0, data[0]);
+  EXPECT_EQ(4, data[1]);
+  EXPECT_EQ('e', data[2]);
+  EXPECT_EQ('f', data[3]);
+}
+
 }  // namespace rtc
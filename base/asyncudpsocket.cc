@@ -9,12 +9,24 @@
  */
 
 #include "webrtc/base/asyncudpsocket.h"
+
+#include <algorithm>
+
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/base/timeutils.h"
 
 namespace rtc {
 
 static const int BUF_SIZE = 64 * 1024;
+// Number of datagrams read per read event, if the socket supports batching.
+static const size_t kReceiveBatchSize = 8;
+// Size of the receive buffers besides the first one. Enough for any datagram
+// that fits into an Ethernet frame.
+static const size_t kBatchBufferSize = 2048;
+// Reserved in front of every received datagram, so that a relay can prepend
+// a small header such as a TURN ChannelData header in place.
+static const size_t kReceiveHeadroom = 16;
 
 AsyncUDPSocket* AsyncUDPSocket::Create(
     AsyncSocket* socket,
@@ -37,10 +49,7 @@ AsyncUDPSocket* AsyncUDPSocket::Create(SocketFactory* factory,
 }
 
 AsyncUDPSocket::AsyncUDPSocket(AsyncSocket* socket)
-    : socket_(socket) {
-  size_ = BUF_SIZE;
-  buf_ = new char[size_];
-
+    : socket_(socket), buf_(nullptr), size_(0) {
   // The socket should start out readable but not writable.
   socket_->SignalReadEvent.connect(this, &AsyncUDPSocket::OnReadEvent);
   socket_->SignalWriteEvent.connect(this, &AsyncUDPSocket::OnWriteEvent);
@@ -50,6 +59,22 @@ AsyncUDPSocket::~AsyncUDPSocket() {
   delete [] buf_;
 }
 
+void AsyncUDPSocket::AllocateReceiveBuffers() {
+  RTC_DCHECK(!buf_);
+  size_ = BUF_SIZE;
+  buf_ = new char[kReceiveHeadroom + size_];
+  const size_t batch_stride = kReceiveHeadroom + kBatchBufferSize;
+  batch_buf_.reset(new char[(kReceiveBatchSize - 1) * batch_stride]);
+  received_.resize(kReceiveBatchSize);
+  received_[0].buffer = buf_ + kReceiveHeadroom;
+  received_[0].capacity = size_;
+  for (size_t i = 1; i < kReceiveBatchSize; ++i) {
+    received_[i].buffer =
+        &batch_buf_[(i - 1) * batch_stride + kReceiveHeadroom];
+    received_[i].capacity = kBatchBufferSize;
+  }
+}
+
 SocketAddress AsyncUDPSocket::GetLocalAddress() const {
   return socket_->GetLocalAddress();
 }
@@ -75,6 +100,30 @@ int AsyncUDPSocket::SendTo(const void *pv, size_t cb,
   return ret;
 }
 
+int AsyncUDPSocket::SendPacketsTo(const OutgoingPacket* packets,
+                                  size_t count) {
+  int64_t send_time_ms = rtc::TimeMillis();
+  outgoing_.clear();
+  for (size_t i = 0; i < count; ++i) {
+    outgoing_.push_back(
+        {packets[i].data, packets[i].size, packets[i].address});
+  }
+  int ret = socket_->SendToBatch(outgoing_.data(), count);
+  // Like SendTo(), signal every packet that was attempted, including the one
+  // that failed.
+  size_t attempted =
+      std::min(count, static_cast<size_t>(std::max(ret, 0)) + 1);
+  for (size_t i = 0; i < attempted; ++i) {
+    SignalSentPacket(
+        this, rtc::SentPacket(packets[i].options->packet_id, send_time_ms));
+  }
+  return ret;
+}
+
+size_t AsyncUDPSocket::GetReceiveHeadroom() const {
+  return kReceiveHeadroom;
+}
+
 int AsyncUDPSocket::Close() {
   return socket_->Close();
 }
@@ -102,10 +151,13 @@ void AsyncUDPSocket::SetError(int error) {
 void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
   RTC_DCHECK(socket_.get() == socket);
 
-  SocketAddress remote_addr;
-  int64_t timestamp;
-  int len = socket_->RecvFrom(buf_, size_, &remote_addr, &timestamp);
-  if (len < 0) {
+  if (!buf_)
+    AllocateReceiveBuffers();
+  // The datagrams of a batch were all received at once, so their handling
+  // shares one reading of the clock.
+  ScopedCachedTime cached_time;
+  int count = socket_->RecvFromBatch(received_.data(), received_.size());
+  if (count < 0) {
     // An error here typically means we got an ICMP error in response to our
     // send datagram, indicating the remote address was unreachable.
     // When doing ICE, this kind of thing will often happen.
@@ -116,11 +168,22 @@ void AsyncUDPSocket::OnReadEvent(AsyncSocket* socket) {
     return;
   }
 
-  // TODO: Make sure that we got all of the packet.
-  // If we did not, then we should resize our buffer to be large enough.
-  SignalReadPacket(
-      this, buf_, static_cast<size_t>(len), remote_addr,
-      (timestamp > -1 ? PacketTime(timestamp, 0) : CreatePacketTime(0)));
+  for (int i = 0; i < count; ++i) {
+    const ReceivedDatagram& datagram = received_[i];
+    // TODO: Make sure that we got all of the packet in the first buffer.
+    // If we did not, then we should resize our buffer to be large enough.
+    if (i > 0 && datagram.truncated) {
+      LOG(LS_WARNING) << "AsyncUDPSocket["
+                      << socket_->GetLocalAddress().ToSensitiveString()
+                      << "] dropped a datagram larger than "
+                      << datagram.capacity << " bytes";
+      continue;
+    }
+    SignalReadPacket(this, datagram.buffer, datagram.length, datagram.address,
+                     (datagram.timestamp > -1
+                          ? PacketTime(datagram.timestamp, 0)
+                          : CreatePacketTime(0)));
+  }
 }
 
 void AsyncUDPSocket::OnWriteEvent(AsyncSocket* socket) {
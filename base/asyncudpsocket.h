@@ -12,6 +12,7 @@
 #define WEBRTC_BASE_ASYNCUDPSOCKET_H_
 
 #include <memory>
+#include <vector>
 
 #include "webrtc/base/asyncpacketsocket.h"
 #include "webrtc/base/socketfactory.h"
@@ -43,6 +44,8 @@ class AsyncUDPSocket : public AsyncPacketSocket {
              size_t cb,
              const SocketAddress& addr,
              const rtc::PacketOptions& options) override;
+  int SendPacketsTo(const OutgoingPacket* packets, size_t count) override;
+  size_t GetReceiveHeadroom() const override;
   int Close() override;
 
   State GetState() const override;
@@ -56,10 +59,19 @@ class AsyncUDPSocket : public AsyncPacketSocket {
   void OnReadEvent(AsyncSocket* socket);
   // Called when the underlying socket is ready to send.
   void OnWriteEvent(AsyncSocket* socket);
+  // Sets up the receive buffers. Done on the first read event rather than at
+  // construction, since many sockets (e.g. unused ICE candidates) never
+  // receive anything.
+  void AllocateReceiveBuffers();
 
   std::unique_ptr<AsyncSocket> socket_;
   char* buf_;
   size_t size_;
+  // Additional receive buffers, so that one read event can drain several
+  // datagrams at once. The first datagram of a batch is read into |buf_|.
+  std::unique_ptr<char[]> batch_buf_;
+  std::vector<ReceivedDatagram> received_;
+  std::vector<OutgoingDatagram> outgoing_;
 };
 
 }  // namespace rtc
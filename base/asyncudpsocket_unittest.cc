@@ -8,12 +8,16 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <string.h>
+
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "webrtc/base/asyncudpsocket.h"
 #include "webrtc/base/gunit.h"
 #include "webrtc/base/physicalsocketserver.h"
+#include "webrtc/base/thread.h"
 #include "webrtc/base/virtualsocketserver.h"
 
 namespace rtc {
@@ -50,4 +54,140 @@ TEST_F(AsyncUdpSocketTest, OnWriteEvent) {
   EXPECT_TRUE(ready_to_send_);
 }
 
+namespace {
+const size_t kNumPackets = 20;
+}  // namespace
+
+// Sends a burst of packets with SendPacketsTo() from one socket to another
+// and collects what arrives.
+class AsyncUdpSocketBurstTest
+    : public testing::Test,
+      public sigslot::has_slots<> {
+ public:
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const SocketAddress& remote_addr,
+                    const PacketTime& packet_time) {
+    received_.push_back(std::string(data, size));
+    EXPECT_LE(0, packet_time.timestamp);
+  }
+
+  void OnSentPacket(AsyncPacketSocket* socket, const SentPacket& packet) {
+    sent_packet_ids_.push_back(packet.packet_id);
+  }
+
+  void SendAndReceiveBurst(SocketFactory* factory) {
+    const SocketAddress kAddress(IPAddress(INADDR_LOOPBACK), 0);
+    std::unique_ptr<AsyncUDPSocket> sender(
+        AsyncUDPSocket::Create(factory, kAddress));
+    std::unique_ptr<AsyncUDPSocket> receiver(
+        AsyncUDPSocket::Create(factory, kAddress));
+    ASSERT_TRUE(sender);
+    ASSERT_TRUE(receiver);
+    sender->SignalSentPacket.connect(this,
+                                     &AsyncUdpSocketBurstTest::OnSentPacket);
+    receiver->SignalReadPacket.connect(this,
+                                       &AsyncUdpSocketBurstTest::OnReadPacket);
+
+    std::vector<std::string> payloads;
+    std::vector<PacketOptions> options(kNumPackets);
+    std::vector<OutgoingPacket> packets;
+    for (size_t i = 0; i < kNumPackets; ++i) {
+      // Vary the size to make sure each datagram keeps its own length.
+      payloads.push_back(std::string(100 + i * 50, static_cast<char>('a' + i)));
+      options[i].packet_id = static_cast<int>(i);
+    }
+    for (size_t i = 0; i < kNumPackets; ++i) {
+      packets.push_back({payloads[i].data(), payloads[i].size(),
+                         receiver->GetLocalAddress(), &options[i]});
+    }
+    EXPECT_EQ(static_cast<int>(kNumPackets),
+              sender->SendPacketsTo(packets.data(), packets.size()));
+    ASSERT_EQ(kNumPackets, sent_packet_ids_.size());
+    for (size_t i = 0; i < kNumPackets; ++i)
+      EXPECT_EQ(static_cast<int>(i), sent_packet_ids_[i]);
+
+    EXPECT_EQ_WAIT(kNumPackets, received_.size(), 5000);
+    EXPECT_EQ(payloads, received_);
+  }
+
+ protected:
+  std::vector<std::string> received_;
+  std::vector<int> sent_packet_ids_;
+};
+
+TEST_F(AsyncUdpSocketBurstTest, PhysicalSocketServer) {
+  PhysicalSocketServer pss;
+  SocketServerScope scope(&pss);
+  SendAndReceiveBurst(&pss);
+}
+
+TEST_F(AsyncUdpSocketBurstTest, VirtualSocketServer) {
+  VirtualSocketServer vss(nullptr);
+  SocketServerScope scope(&vss);
+  SendAndReceiveBurst(&vss);
+}
+
+// Forwards every received packet with a header prepended in the receive
+// headroom, like a TURN server relaying to a channel.
+class HeaderPrepender : public sigslot::has_slots<> {
+ public:
+  HeaderPrepender(AsyncPacketSocket* forward_socket,
+                  const SocketAddress& forward_addr)
+      : forward_socket_(forward_socket), forward_addr_(forward_addr) {}
+
+  void OnReadPacket(AsyncPacketSocket* socket,
+                    const char* data,
+                    size_t size,
+                    const SocketAddress& remote_addr,
+                    const PacketTime& packet_time) {
+    ASSERT_LE(sizeof(kHeader), socket->GetReceiveHeadroom());
+    char* packet = const_cast<char*>(data) - sizeof(kHeader);
+    memcpy(packet, kHeader, sizeof(kHeader));
+    forward_socket_->SendTo(packet, sizeof(kHeader) + size, forward_addr_,
+                            PacketOptions());
+  }
+
+  static const char kHeader[4];
+
+ private:
+  AsyncPacketSocket* const forward_socket_;
+  const SocketAddress forward_addr_;
+};
+
+const char HeaderPrepender::kHeader[4] = {'h', 'd', 'r', ':'};
+
+TEST_F(AsyncUdpSocketBurstTest, PrependsHeaderInReceiveHeadroom) {
+  PhysicalSocketServer pss;
+  SocketServerScope scope(&pss);
+  const SocketAddress kAddress(IPAddress(INADDR_LOOPBACK), 0);
+  std::unique_ptr<AsyncUDPSocket> sender(
+      AsyncUDPSocket::Create(&pss, kAddress));
+  std::unique_ptr<AsyncUDPSocket> relay(AsyncUDPSocket::Create(&pss, kAddress));
+  std::unique_ptr<AsyncUDPSocket> receiver(
+      AsyncUDPSocket::Create(&pss, kAddress));
+  ASSERT_TRUE(sender && relay && receiver);
+  HeaderPrepender prepender(relay.get(), receiver->GetLocalAddress());
+  relay->SignalReadPacket.connect(&prepender, &HeaderPrepender::OnReadPacket);
+  receiver->SignalReadPacket.connect(
+      static_cast<AsyncUdpSocketBurstTest*>(this),
+      &AsyncUdpSocketBurstTest::OnReadPacket);
+
+  // Send a burst, so that the batch receive buffers are used as well.
+  std::vector<std::string> expected;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    std::string payload(10 + i, static_cast<char>('a' + i));
+    EXPECT_EQ(static_cast<int>(payload.size()),
+              sender->SendTo(payload.data(), payload.size(),
+                             relay->GetLocalAddress(), PacketOptions()));
+    expected.push_back(std::string(HeaderPrepender::kHeader,
+                                   sizeof(HeaderPrepender::kHeader)) +
+                       payload);
+  }
+
+  EXPECT_EQ_WAIT(kNumPackets, received_.size(), 5000);
+  EXPECT_EQ(expected, received_);
+}
+
 }  // namespace rtc
@@ -17,11 +17,12 @@ CopyOnWriteBuffer::CopyOnWriteBuffer() {
 }
 
 CopyOnWriteBuffer::CopyOnWriteBuffer(const CopyOnWriteBuffer& buf)
-    : buffer_(buf.buffer_) {
+    : buffer_(buf.buffer_), offset_(buf.offset_) {
 }
 
 CopyOnWriteBuffer::CopyOnWriteBuffer(CopyOnWriteBuffer&& buf)
-    : buffer_(std::move(buf.buffer_)) {
+    : buffer_(std::move(buf.buffer_)), offset_(buf.offset_) {
+  buf.offset_ = 0;
 }
 
 CopyOnWriteBuffer::CopyOnWriteBuffer(size_t size)
@@ -42,9 +43,10 @@ bool CopyOnWriteBuffer::operator==(const CopyOnWriteBuffer& buf) const {
   // Must either use the same buffer internally or have the same contents.
   RTC_DCHECK(IsConsistent());
   RTC_DCHECK(buf.IsConsistent());
-  return buffer_.get() == buf.buffer_.get() ||
-      (buffer_.get() && buf.buffer_.get() &&
-      *buffer_.get() == *buf.buffer_.get());
+  if (buffer_.get() == buf.buffer_.get() && offset_ == buf.offset_)
+    return true;
+  return size() == buf.size() &&
+      (size() == 0 || std::memcmp(cdata(), buf.cdata(), size()) == 0);
 }
 
 void CopyOnWriteBuffer::SetSize(size_t size) {
@@ -61,10 +63,10 @@ void CopyOnWriteBuffer::SetSize(size_t size) {
   if (!buffer_->HasOneRef()) {
     buffer_ = new RefCountedObject<Buffer>(
         buffer_->data(),
-        std::min(buffer_->size(), size),
-        std::max(buffer_->capacity(), size));
+        std::min(buffer_->size(), offset_ + size),
+        std::max(buffer_->capacity(), offset_ + size));
   }
-  buffer_->SetSize(size);
+  buffer_->SetSize(offset_ + size);
   RTC_DCHECK(IsConsistent());
 }
 
@@ -76,12 +78,12 @@ void CopyOnWriteBuffer::EnsureCapacity(size_t capacity) {
     }
     RTC_DCHECK(IsConsistent());
     return;
-  } else if (capacity <= buffer_->capacity()) {
+  } else if (offset_ + capacity <= buffer_->capacity()) {
     return;
   }
 
-  CloneDataIfReferenced(std::max(buffer_->capacity(), capacity));
-  buffer_->EnsureCapacity(capacity);
+  CloneDataIfReferenced(std::max(buffer_->capacity(), offset_ + capacity));
+  buffer_->EnsureCapacity(offset_ + capacity);
   RTC_DCHECK(IsConsistent());
 }
 
@@ -90,9 +92,9 @@ void CopyOnWriteBuffer::Clear() {
     return;
 
   if (buffer_->HasOneRef()) {
-    buffer_->Clear();
+    buffer_->SetSize(offset_);
   } else {
-    buffer_ = new RefCountedObject<Buffer>(0, buffer_->capacity());
+    buffer_ = new RefCountedObject<Buffer>(offset_, buffer_->capacity());
   }
   RTC_DCHECK(IsConsistent());
 }
@@ -102,6 +104,7 @@ void CopyOnWriteBuffer::CloneDataIfReferenced(size_t new_capacity) {
     return;
   }
 
+  // The headroom is copied along with the data, so |offset_| stays valid.
   buffer_ = new RefCountedObject<Buffer>(buffer_->data(), buffer_->size(),
       new_capacity);
   RTC_DCHECK(IsConsistent());
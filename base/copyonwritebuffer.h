@@ -12,6 +12,7 @@
 #define WEBRTC_BASE_COPYONWRITEBUFFER_H_
 
 #include <algorithm>
+#include <cstring>
 #include <utility>
 
 #include "webrtc/base/buffer.h"
@@ -51,6 +52,25 @@ class CopyOnWriteBuffer {
     }
   }
 
+  // Construct a buffer and copy the specified number of bytes into it, with
+  // |headroom| bytes reserved in front of the data and |tailroom| bytes behind
+  // it. PrependData and AppendData use that room without reallocating, e.g.
+  // to add a header or an authentication tag to a packet.
+  template <typename T,
+            typename std::enable_if<
+                internal::BufferCompat<uint8_t, T>::value>::type* = nullptr>
+  CopyOnWriteBuffer(const T* data,
+                    size_t size,
+                    size_t headroom,
+                    size_t tailroom)
+      : CopyOnWriteBuffer(headroom + size, headroom + size + tailroom) {
+    if (buffer_) {
+      offset_ = headroom;
+      std::memcpy(buffer_->data() + offset_, data, size);
+    }
+    RTC_DCHECK(IsConsistent());
+  }
+
   // Construct a buffer from the contents of an array.
   template <typename T,
             size_t N,
@@ -81,7 +101,7 @@ class CopyOnWriteBuffer {
       return nullptr;
     }
     CloneDataIfReferenced(buffer_->capacity());
-    return buffer_->data<T>();
+    return buffer_->data<T>() + offset_;
   }
 
   // Get const pointer to the data. This will not create a copy of the
@@ -94,24 +114,37 @@ class CopyOnWriteBuffer {
     if (!buffer_) {
       return nullptr;
     }
-    return buffer_->data<T>();
+    return buffer_->data<T>() + offset_;
   }
 
   size_t size() const {
     RTC_DCHECK(IsConsistent());
-    return buffer_ ? buffer_->size() : 0;
+    return buffer_ ? buffer_->size() - offset_ : 0;
   }
 
+  // The capacity counts from the start of the data, i.e. excludes headroom.
   size_t capacity() const {
     RTC_DCHECK(IsConsistent());
-    return buffer_ ? buffer_->capacity() : 0;
+    return buffer_ ? buffer_->capacity() - offset_ : 0;
   }
 
+  // Bytes that PrependData can add without reallocating, as long as the
+  // underlying data isn't shared with other buffers.
+  size_t headroom() const {
+    RTC_DCHECK(IsConsistent());
+    return offset_;
+  }
+
+  // Bytes that AppendData can add without reallocating, as long as the
+  // underlying data isn't shared with other buffers.
+  size_t tailroom() const { return capacity() - size(); }
+
   CopyOnWriteBuffer& operator=(const CopyOnWriteBuffer& buf) {
     RTC_DCHECK(IsConsistent());
     RTC_DCHECK(buf.IsConsistent());
     if (&buf != this) {
       buffer_ = buf.buffer_;
+      offset_ = buf.offset_;
     }
     return *this;
   }
@@ -120,6 +153,8 @@ class CopyOnWriteBuffer {
     RTC_DCHECK(IsConsistent());
     RTC_DCHECK(buf.IsConsistent());
     buffer_ = std::move(buf.buffer_);
+    offset_ = buf.offset_;
+    buf.offset_ = 0;
     return *this;
   }
 
@@ -149,9 +184,14 @@ class CopyOnWriteBuffer {
     if (!buffer_) {
       buffer_ = size > 0 ? new RefCountedObject<Buffer>(data, size) : nullptr;
     } else if (!buffer_->HasOneRef()) {
-      buffer_ = new RefCountedObject<Buffer>(data, size, buffer_->capacity());
-    } else {
+      buffer_ = new RefCountedObject<Buffer>(
+          offset_ + size, std::max(buffer_->capacity(), offset_ + size));
+      std::memcpy(buffer_->data() + offset_, data, size);
+    } else if (offset_ == 0) {
       buffer_->SetData(data, size);
+    } else {
+      buffer_->SetSize(offset_ + size);
+      std::memcpy(buffer_->data() + offset_, data, size);
     }
     RTC_DCHECK(IsConsistent());
   }
@@ -169,6 +209,7 @@ class CopyOnWriteBuffer {
     RTC_DCHECK(buf.IsConsistent());
     if (&buf != this) {
       buffer_ = buf.buffer_;
+      offset_ = buf.offset_;
     }
   }
 
@@ -202,6 +243,45 @@ class CopyOnWriteBuffer {
     AppendData(buf.data(), buf.size());
   }
 
+  // Insert data in front of the buffer's contents. Accepts the same types as
+  // the constructors. Uses the headroom if there is enough of it and the data
+  // isn't shared with other buffers; otherwise the buffer is reallocated
+  // without headroom, keeping its tailroom.
+  template <typename T,
+            typename std::enable_if<
+                internal::BufferCompat<uint8_t, T>::value>::type* = nullptr>
+  void PrependData(const T* data, size_t size) {
+    RTC_DCHECK(IsConsistent());
+    if (buffer_ && buffer_->HasOneRef() && offset_ >= size) {
+      offset_ -= size;
+      std::memcpy(buffer_->data() + offset_, data, size);
+      RTC_DCHECK(IsConsistent());
+      return;
+    }
+    if (size == 0) {
+      return;
+    }
+
+    const size_t old_size = this->size();
+    scoped_refptr<RefCountedObject<Buffer>> buffer(
+        new RefCountedObject<Buffer>(size + old_size, size + capacity()));
+    std::memcpy(buffer->data(), data, size);
+    if (old_size > 0) {
+      std::memcpy(buffer->data() + size, cdata(), old_size);
+    }
+    buffer_ = std::move(buffer);
+    offset_ = 0;
+    RTC_DCHECK(IsConsistent());
+  }
+
+  template <typename T,
+            size_t N,
+            typename std::enable_if<
+                internal::BufferCompat<uint8_t, T>::value>::type* = nullptr>
+  void PrependData(const T (&array)[N]) {
+    PrependData(array, N);
+  }
+
   // Sets the size of the buffer. If the new size is smaller than the old, the
   // buffer contents will be kept but truncated; if the new size is greater,
   // the existing contents will be kept and the new space will be
@@ -213,13 +293,14 @@ class CopyOnWriteBuffer {
   // the buffer.)
   void EnsureCapacity(size_t capacity);
 
-  // Resets the buffer to zero size without altering capacity. Works even if the
-  // buffer has been moved from.
+  // Resets the buffer to zero size without altering capacity or headroom.
+  // Works even if the buffer has been moved from.
   void Clear();
 
   // Swaps two buffers.
   friend void swap(CopyOnWriteBuffer& a, CopyOnWriteBuffer& b) {
     std::swap(a.buffer_, b.buffer_);
+    std::swap(a.offset_, b.offset_);
   }
 
  private:
@@ -229,11 +310,15 @@ class CopyOnWriteBuffer {
 
   // Pre- and postcondition of all methods.
   bool IsConsistent() const {
-    return (!buffer_ || buffer_->capacity() > 0);
+    return buffer_ ? (buffer_->capacity() > 0 && offset_ <= buffer_->size())
+                   : offset_ == 0;
   }
 
   // buffer_ is either null, or points to an rtc::Buffer with capacity > 0.
   scoped_refptr<RefCountedObject<Buffer>> buffer_;
+  // The data starts |offset_| bytes into |buffer_|; the bytes before it are
+  // headroom. Always 0 if |buffer_| is null.
+  size_t offset_ = 0;
 };
 
 }  // namespace rtc
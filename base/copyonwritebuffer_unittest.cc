@@ -316,4 +316,78 @@ TEST(CopyOnWriteBufferTest, TestBacketWrite) {
   EXPECT_EQ(0, memcmp(buf2.cdata(), kTestData, 3));
 }
 
+TEST(CopyOnWriteBufferTest, TestConstructWithHeadroomAndTailroom) {
+  CopyOnWriteBuffer buf(kTestData, 3, 4, 5);
+  EXPECT_EQ(buf.size(), 3u);
+  EXPECT_EQ(buf.capacity(), 8u);
+  EXPECT_EQ(buf.headroom(), 4u);
+  EXPECT_EQ(buf.tailroom(), 5u);
+  EXPECT_EQ(0, memcmp(buf.cdata(), kTestData, 3));
+  EXPECT_EQ(buf, CopyOnWriteBuffer(kTestData, 3));
+}
+
+TEST(CopyOnWriteBufferTest, TestPrependDataUsesHeadroom) {
+  CopyOnWriteBuffer buf(kTestData + 4, 4, 4, 0);
+  const uint8_t* data = buf.cdata();
+
+  buf.PrependData(kTestData + 2, 2);
+  EXPECT_EQ(buf.cdata(), data - 2);
+  EXPECT_EQ(buf.headroom(), 2u);
+  buf.PrependData(kTestData, 2);
+  EXPECT_EQ(buf.cdata(), data - 4);
+  EXPECT_EQ(buf.headroom(), 0u);
+  EXPECT_EQ(buf.size(), 8u);
+  EXPECT_EQ(0, memcmp(buf.cdata(), kTestData, 8));
+}
+
+TEST(CopyOnWriteBufferTest, TestPrependDataReallocatesWithoutHeadroom) {
+  CopyOnWriteBuffer buf(kTestData + 2, 2, 1, 3);
+
+  buf.PrependData(kTestData, 2);
+  EXPECT_EQ(buf.headroom(), 0u);
+  EXPECT_EQ(buf.size(), 4u);
+  EXPECT_EQ(buf.tailroom(), 3u);
+  EXPECT_EQ(0, memcmp(buf.cdata(), kTestData, 4));
+}
+
+TEST(CopyOnWriteBufferTest, TestPrependDataToSharedBuffer) {
+  CopyOnWriteBuffer buf1(kTestData + 2, 3, 2, 0);
+  CopyOnWriteBuffer buf2(buf1);
+  EnsureBuffersShareData(buf1, buf2);
+
+  buf1.PrependData(kTestData, 2);
+  EnsureBuffersDontShareData(buf1, buf2);
+  EXPECT_EQ(buf1.size(), 5u);
+  EXPECT_EQ(0, memcmp(buf1.cdata(), kTestData, 5));
+  EXPECT_EQ(buf2.size(), 3u);
+  EXPECT_EQ(buf2.headroom(), 2u);
+  EXPECT_EQ(0, memcmp(buf2.cdata(), kTestData + 2, 3));
+}
+
+TEST(CopyOnWriteBufferTest, TestHeadroomKeptOnWrite) {
+  CopyOnWriteBuffer buf1(kTestData, 3, 4, 2);
+  CopyOnWriteBuffer buf2(buf1);
+
+  buf1.AppendData(kTestData + 3, 2);
+  EnsureBuffersDontShareData(buf1, buf2);
+  EXPECT_EQ(buf1.headroom(), 4u);
+  EXPECT_EQ(buf1.size(), 5u);
+  EXPECT_EQ(0, memcmp(buf1.cdata(), kTestData, 5));
+
+  buf1.SetSize(2);
+  EXPECT_EQ(buf1.headroom(), 4u);
+  EXPECT_EQ(0, memcmp(buf1.cdata(), kTestData, 2));
+
+  buf1.SetData(kTestData + 8, 4);
+  EXPECT_EQ(buf1.headroom(), 4u);
+  EXPECT_EQ(0, memcmp(buf1.cdata(), kTestData + 8, 4));
+
+  buf1.Clear();
+  EXPECT_EQ(buf1.headroom(), 4u);
+  EXPECT_EQ(buf1.size(), 0u);
+
+  EXPECT_EQ(buf2.size(), 3u);
+  EXPECT_EQ(0, memcmp(buf2.cdata(), kTestData, 3));
+}
+
 }  // namespace rtc
@@ -43,7 +43,8 @@ size_t File::Read(uint8_t* buffer, size_t length) {
     do {
       read = ::read(file_, buffer + total_read, length - total_read);
     } while (read == -1 && errno == EINTR);
-    if (read == -1)
+    // Stop on errors and at the end of the file.
+    if (read <= 0)
       break;
     total_read += read;
   } while (total_read < length);
@@ -73,7 +74,8 @@ size_t File::ReadAt(uint8_t* buffer, size_t length, size_t offset) {
       read = ::pread(file_, buffer + total_read, length - total_read,
                      offset + total_read);
     } while (read == -1 && errno == EINTR);
-    if (read == -1)
+    // Stop on errors and at the end of the file.
+    if (read <= 0)
       break;
     total_read += read;
   } while (total_read < length);
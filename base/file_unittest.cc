@@ -127,6 +127,23 @@ TEST_F(FileTest, ReadWriteClose) {
   EXPECT_TRUE(VerifyBuffer(out, 10, 0));
 }
 
+TEST_F(FileTest, ReadStopsAtEndOfFile) {
+  File file = File::Open(path_);
+  ASSERT_TRUE(file.IsOpen()) << "Error: " << LastError();
+
+  uint8_t data[] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  uint8_t out[20] = {0};
+  EXPECT_EQ(10u, file.Write(data, 10));
+
+  EXPECT_TRUE(file.Seek(4));
+  EXPECT_EQ(6u, file.Read(out, 20));
+  EXPECT_TRUE(VerifyBuffer(out, 6, 4));
+  EXPECT_EQ(0u, file.Read(out, 20));
+
+  EXPECT_EQ(3u, file.ReadAt(out, 20, 7));
+  EXPECT_TRUE(VerifyBuffer(out, 3, 7));
+}
+
 TEST_F(FileTest, RandomAccessRead) {
   File file = File::Open(path_);
   ASSERT_TRUE(file.IsOpen()) << "Error: " << LastError();
@@ -40,7 +40,9 @@ size_t File::Read(uint8_t* buffer, size_t length) {
   do {
     DWORD read;
     if (!::ReadFile(file_, buffer + total_read,
-                    static_cast<DWORD>(length - total_read), &read, nullptr)) {
+                    static_cast<DWORD>(length - total_read), &read, nullptr) ||
+        read == 0) {
+      // Reading at the end of the file succeeds without reading anything.
       break;
     }
     total_read += read;
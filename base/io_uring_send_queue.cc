@@ -0,0 +1,250 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/io_uring_send_queue.h"
+
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/logging.h"
+
+namespace rtc {
+
+struct IoUringSendQueue::Slot {
+  int fd;
+  msghdr msg;
+  iovec iov;
+  sockaddr_storage addr;
+  char data[kMaxDatagramSize];
+};
+
+namespace {
+
+// There are no libc wrappers for the io_uring system calls.
+int IoUringSetup(unsigned int entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int IoUringEnter(int fd,
+                 unsigned int to_submit,
+                 unsigned int min_complete,
+                 unsigned int flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                  min_complete, flags, nullptr, 0));
+}
+
+template <typename T>
+T* RingField(void* ring, uint32_t offset) {
+  return reinterpret_cast<T*>(static_cast<char*>(ring) + offset);
+}
+
+void* MapRing(int fd, size_t size, off_t offset) {
+  void* ring = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, fd, offset);
+  if (ring == MAP_FAILED) {
+    LOG_E(LS_WARNING, EN, errno) << "mmap";
+    return nullptr;
+  }
+  return ring;
+}
+
+}  // namespace
+
+const size_t IoUringSendQueue::kMaxDatagramSize;
+
+// static
+std::unique_ptr<IoUringSendQueue> IoUringSendQueue::Create(
+    unsigned int num_entries) {
+  std::unique_ptr<IoUringSendQueue> queue(new IoUringSendQueue());
+  if (!queue->Init(num_entries))
+    return nullptr;
+  return queue;
+}
+
+IoUringSendQueue::IoUringSendQueue() {}
+
+IoUringSendQueue::~IoUringSendQueue() {
+  if (slots_) {
+    // The kernel reads the datagrams of sends in flight from |slots_|, so
+    // they have to complete before the slots are freed.
+    Flush();
+    while (in_flight() > 0 && Enter(1))
+      ReapCompletions();
+  }
+  if (ring_fd_ != -1)
+    close(ring_fd_);
+  if (sqes_)
+    munmap(sqes_, sqes_size_);
+  if (cq_ring_ && cq_ring_ != sq_ring_)
+    munmap(cq_ring_, cq_ring_size_);
+  if (sq_ring_)
+    munmap(sq_ring_, sq_ring_size_);
+}
+
+bool IoUringSendQueue::Init(unsigned int num_entries) {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ring_fd_ = IoUringSetup(num_entries, &params);
+  if (ring_fd_ < 0) {
+    LOG_E(LS_INFO, EN, errno) << "io_uring_setup";
+    ring_fd_ = -1;
+    return false;
+  }
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  // Newer kernels map both rings at once.
+  bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (single_mmap) {
+    sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    cq_ring_size_ = sq_ring_size_;
+  }
+  sq_ring_ = MapRing(ring_fd_, sq_ring_size_, IORING_OFF_SQ_RING);
+  if (!sq_ring_)
+    return false;
+  cq_ring_ = single_mmap
+                 ? sq_ring_
+                 : MapRing(ring_fd_, cq_ring_size_, IORING_OFF_CQ_RING);
+  if (!cq_ring_)
+    return false;
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = static_cast<io_uring_sqe*>(
+      MapRing(ring_fd_, sqes_size_, IORING_OFF_SQES));
+  if (!sqes_)
+    return false;
+
+  sq_tail_ = RingField<unsigned int>(sq_ring_, params.sq_off.tail);
+  sq_mask_ = RingField<unsigned int>(sq_ring_, params.sq_off.ring_mask);
+  sq_array_ = RingField<unsigned int>(sq_ring_, params.sq_off.array);
+  cq_head_ = RingField<unsigned int>(cq_ring_, params.cq_off.head);
+  cq_tail_ = RingField<unsigned int>(cq_ring_, params.cq_off.tail);
+  cq_mask_ = RingField<unsigned int>(cq_ring_, params.cq_off.ring_mask);
+  cqes_ = RingField<io_uring_cqe>(cq_ring_, params.cq_off.cqes);
+
+  // With one slot per submission queue entry, neither the submission queue
+  // nor the completion queue, which is at least as large, can overflow.
+  num_slots_ = params.sq_entries;
+  slots_.reset(new Slot[num_slots_]);
+  free_slots_.reserve(num_slots_);
+  for (size_t i = num_slots_; i > 0; --i)
+    free_slots_.push_back(static_cast<unsigned int>(i - 1));
+  return true;
+}
+
+bool IoUringSendQueue::Send(int fd,
+                            const void* data,
+                            size_t length,
+                            const sockaddr* addr,
+                            socklen_t addr_len) {
+  if (length > kMaxDatagramSize || addr_len > sizeof(sockaddr_storage))
+    return false;
+  if (free_slots_.empty()) {
+    // Sends to sockets with room in their buffers complete while they are
+    // submitted.
+    Flush();
+    if (free_slots_.empty())
+      return false;
+  }
+  unsigned int index = free_slots_.back();
+  free_slots_.pop_back();
+
+  Slot& slot = slots_[index];
+  slot.fd = fd;
+  memcpy(slot.data, data, length);
+  slot.iov.iov_base = slot.data;
+  slot.iov.iov_len = length;
+  memset(&slot.msg, 0, sizeof(slot.msg));
+  if (addr) {
+    memcpy(&slot.addr, addr, addr_len);
+    slot.msg.msg_name = &slot.addr;
+    slot.msg.msg_namelen = addr_len;
+  }
+  slot.msg.msg_iov = &slot.iov;
+  slot.msg.msg_iovlen = 1;
+
+  io_uring_sqe* sqe = &sqes_[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = IORING_OP_SENDMSG;
+  sqe->fd = fd;
+  sqe->addr = reinterpret_cast<uint64_t>(&slot.msg);
+  sqe->len = 1;
+  // Fail rather than wait for room in the socket buffer, as the direct sends
+  // on the non-blocking sockets do, so that the caller can be told.
+  sqe->msg_flags = MSG_NOSIGNAL | MSG_DONTWAIT;
+  sqe->user_data = index;
+
+  // Only this side writes the tail, the kernel reads it.
+  unsigned int tail = *sq_tail_;
+  sq_array_[tail & *sq_mask_] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  ++num_queued_;
+  return true;
+}
+
+void IoUringSendQueue::Flush() {
+  if (num_queued_ > 0)
+    Enter(0);
+  ReapCompletions();
+}
+
+bool IoUringSendQueue::TakeWouldBlock(int fd) {
+  auto it = std::find(would_block_fds_.begin(), would_block_fds_.end(), fd);
+  if (it == would_block_fds_.end())
+    return false;
+  would_block_fds_.erase(it);
+  return true;
+}
+
+bool IoUringSendQueue::Enter(unsigned int min_complete) {
+  unsigned int flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+  while (true) {
+    unsigned int to_submit = static_cast<unsigned int>(num_queued_);
+    int submitted = IoUringEnter(ring_fd_, to_submit, min_complete, flags);
+    if (submitted >= 0) {
+      num_queued_ -= std::min(num_queued_, static_cast<size_t>(submitted));
+      return true;
+    }
+    if (errno != EINTR) {
+      LOG_E(LS_ERROR, EN, errno) << "io_uring_enter";
+      return false;
+    }
+  }
+}
+
+void IoUringSendQueue::ReapCompletions() {
+  // Only this side writes the head, the kernel writes the tail.
+  unsigned int head = *cq_head_;
+  unsigned int tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  for (; head != tail; ++head) {
+    const io_uring_cqe& cqe = cqes_[head & *cq_mask_];
+    RTC_DCHECK_LT(cqe.user_data, num_slots_);
+    if (cqe.res == -EWOULDBLOCK || cqe.res == -EAGAIN) {
+      int fd = slots_[cqe.user_data].fd;
+      if (std::find(would_block_fds_.begin(), would_block_fds_.end(), fd) ==
+          would_block_fds_.end()) {
+        would_block_fds_.push_back(fd);
+      }
+    } else if (cqe.res < 0) {
+      LOG_E(LS_VERBOSE, EN, -cqe.res) << "Queued sendmsg";
+    }
+    free_slots_.push_back(static_cast<unsigned int>(cqe.user_data));
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+}
+
+}  // namespace rtc
@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_BASE_IO_URING_SEND_QUEUE_H_
+#define WEBRTC_BASE_IO_URING_SEND_QUEUE_H_
+
+#include <stddef.h>
+#include <sys/socket.h>
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+
+struct io_uring_cqe;
+struct io_uring_sqe;
+
+namespace rtc {
+
+// Queues datagrams on an io_uring submission ring, so that the datagrams of
+// any number of sockets are sent with a single system call. The data is
+// copied when it is queued. Sends that fail because the socket buffer is full
+// are reported through TakeWouldBlock(), other errors are only logged, which
+// is acceptable for UDP since the datagrams could as well be lost on the way.
+// Not thread safe.
+class IoUringSendQueue {
+ public:
+  // Datagrams larger than this are not queued.
+  static const size_t kMaxDatagramSize = 2048;
+
+  // Returns null if io_uring is not supported by the kernel.
+  static std::unique_ptr<IoUringSendQueue> Create(unsigned int num_entries);
+  ~IoUringSendQueue();
+
+  // Copies the datagram and queues it for sending on |fd| to |addr|, which
+  // may be null for a connected socket. Returns false if the datagram could
+  // not be queued, in which case the caller has to send it directly.
+  bool Send(int fd,
+            const void* data,
+            size_t length,
+            const sockaddr* addr,
+            socklen_t addr_len);
+
+  // Submits all queued datagrams. The sockets they are queued for must stay
+  // open until this is called.
+  void Flush();
+
+  // Returns true, once, if a send queued on |fd| has failed because the
+  // socket buffer was full. Sends complete when they are submitted, so this
+  // reflects the datagrams queued up to the last Flush().
+  bool TakeWouldBlock(int fd);
+
+  size_t queued() const { return num_queued_; }
+  size_t in_flight() const { return num_slots_ - free_slots_.size(); }
+
+ private:
+  struct Slot;
+
+  IoUringSendQueue();
+  bool Init(unsigned int num_entries);
+  // Returns the slots of completed sends to |free_slots_|.
+  void ReapCompletions();
+  // Submits the queued datagrams and waits for |min_complete| completions.
+  // Returns false on errors other than interruptions.
+  bool Enter(unsigned int min_complete);
+
+  int ring_fd_ = -1;
+  void* sq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  void* cq_ring_ = nullptr;
+  size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+
+  unsigned int* sq_tail_ = nullptr;
+  unsigned int* sq_mask_ = nullptr;
+  unsigned int* sq_array_ = nullptr;
+  unsigned int* cq_head_ = nullptr;
+  unsigned int* cq_tail_ = nullptr;
+  unsigned int* cq_mask_ = nullptr;
+  io_uring_cqe* cqes_ = nullptr;
+
+  // Every slot holds one datagram from when it is queued until the kernel
+  // reports its completion. Slot i always uses submission queue entry i.
+  std::unique_ptr<Slot[]> slots_;
+  size_t num_slots_ = 0;
+  std::vector<unsigned int> free_slots_;
+  size_t num_queued_ = 0;
+  // Sockets with a send that failed with EWOULDBLOCK, not reported yet.
+  std::vector<int> would_block_fds_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(IoUringSendQueue);
+};
+
+}  // namespace rtc
+
+#endif  // WEBRTC_BASE_IO_URING_SEND_QUEUE_H_
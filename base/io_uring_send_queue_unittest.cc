@@ -0,0 +1,155 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/io_uring_send_queue.h"
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <memory>
+
+#include "webrtc/base/gunit.h"
+#include "webrtc/base/logging.h"
+
+namespace rtc {
+
+namespace {
+
+const int kNumDatagrams = 64;
+
+class IoUringSendQueueTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    queue_ = IoUringSendQueue::Create(16);
+    receiver_ = CreateBoundSocket(&receiver_addr_);
+    sender_ = CreateBoundSocket(nullptr);
+    ASSERT_NE(-1, receiver_);
+    ASSERT_NE(-1, sender_);
+  }
+
+  void TearDown() override {
+    queue_.reset();
+    close(receiver_);
+    close(sender_);
+  }
+
+  static int CreateBoundSocket(sockaddr_in* bound_addr) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    if (fd == -1)
+      return -1;
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    if (bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 ||
+        getsockname(fd, reinterpret_cast<sockaddr*>(&addr), &addr_len) != 0) {
+      close(fd);
+      return -1;
+    }
+    if (bound_addr)
+      *bound_addr = addr;
+    return fd;
+  }
+
+  // Returns the length of the received datagram, or -1 if none arrives.
+  int Receive(char* buffer, size_t size) {
+    pollfd pfd = {receiver_, POLLIN, 0};
+    if (poll(&pfd, 1, 1000) != 1)
+      return -1;
+    return static_cast<int>(recv(receiver_, buffer, size, 0));
+  }
+
+  std::unique_ptr<IoUringSendQueue> queue_;
+  int receiver_ = -1;
+  int sender_ = -1;
+  sockaddr_in receiver_addr_;
+};
+
+}  // namespace
+
+TEST_F(IoUringSendQueueTest, SendsQueuedDatagramsOnFlush) {
+  if (!queue_) {
+    LOG(LS_INFO) << "io_uring not supported, skipping test.";
+    return;
+  }
+  const sockaddr* addr = reinterpret_cast<const sockaddr*>(&receiver_addr_);
+  // More datagrams than there are slots, so that the queue has to submit and
+  // reuse them.
+  for (int i = 0; i < kNumDatagrams; ++i) {
+    ASSERT_TRUE(queue_->Send(sender_, &i, sizeof(i), addr,
+                             sizeof(receiver_addr_)));
+  }
+  queue_->Flush();
+  EXPECT_EQ(0u, queue_->queued());
+
+  for (int i = 0; i < kNumDatagrams; ++i) {
+    int value = -1;
+    ASSERT_EQ(static_cast<int>(sizeof(value)),
+              Receive(reinterpret_cast<char*>(&value), sizeof(value)));
+    EXPECT_EQ(i, value);
+  }
+}
+
+TEST_F(IoUringSendQueueTest, SendsOnConnectedSocket) {
+  if (!queue_) {
+    LOG(LS_INFO) << "io_uring not supported, skipping test.";
+    return;
+  }
+  ASSERT_EQ(0, connect(sender_, reinterpret_cast<sockaddr*>(&receiver_addr_),
+                       sizeof(receiver_addr_)));
+  const char kData[] = "datagram";
+  ASSERT_TRUE(queue_->Send(sender_, kData, sizeof(kData), nullptr, 0));
+  queue_->Flush();
+
+  char buffer[sizeof(kData)] = {0};
+  ASSERT_EQ(static_cast<int>(sizeof(kData)), Receive(buffer, sizeof(buffer)));
+  EXPECT_STREQ(kData, buffer);
+}
+
+TEST_F(IoUringSendQueueTest, RejectsOversizedDatagrams) {
+  if (!queue_) {
+    LOG(LS_INFO) << "io_uring not supported, skipping test.";
+    return;
+  }
+  std::unique_ptr<char[]> data(
+      new char[IoUringSendQueue::kMaxDatagramSize + 1]);
+  EXPECT_FALSE(queue_->Send(sender_, data.get(),
+                            IoUringSendQueue::kMaxDatagramSize + 1,
+                            reinterpret_cast<sockaddr*>(&receiver_addr_),
+                            sizeof(receiver_addr_)));
+  EXPECT_EQ(0u, queue_->queued());
+  EXPECT_EQ(0u, queue_->in_flight());
+}
+
+TEST_F(IoUringSendQueueTest, ReportsWouldBlockOnce) {
+  if (!queue_) {
+    LOG(LS_INFO) << "io_uring not supported, skipping test.";
+    return;
+  }
+  // Nothing reads from |fds[1]|, so its receive queue fills up.
+  int fds[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_DGRAM, 0, fds));
+  const char kData[] = "datagram";
+  for (int i = 0; i < kNumDatagrams * 16; ++i)
+    ASSERT_TRUE(queue_->Send(fds[0], kData, sizeof(kData), nullptr, 0));
+  queue_->Flush();
+
+  EXPECT_FALSE(queue_->TakeWouldBlock(sender_));
+  EXPECT_TRUE(queue_->TakeWouldBlock(fds[0]));
+  EXPECT_FALSE(queue_->TakeWouldBlock(fds[0]));
+  close(fds[0]);
+  close(fds[1]);
+}
+
+}  // namespace rtc
@@ -276,8 +276,16 @@ class LogMessageVoidify {
   void operator&(std::ostream&) { }
 };
 
+#if defined(WEBRTC_RESTRICT_LOGGING)
+// This should compile away logs matching the following condition.
+#define RTC_RESTRICT_LOGGING_PRECONDITION(sev) \
+  sev < rtc::LS_INFO ? (void) 0 :
+#else
+#define RTC_RESTRICT_LOGGING_PRECONDITION(sev)
+#endif
+
 #define LOG_SEVERITY_PRECONDITION(sev) \
-  !(rtc::LogMessage::Loggable(sev)) \
+  RTC_RESTRICT_LOGGING_PRECONDITION(sev) !(rtc::LogMessage::Loggable(sev)) \
     ? (void) 0 \
     : rtc::LogMessageVoidify() &
 
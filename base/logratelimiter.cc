@@ -0,0 +1,46 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/logratelimiter.h"
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/timeutils.h"
+
+namespace rtc {
+
+int LogRateLimiter::Allow() {
+  int now = static_cast<int>(TimeMillis() / kNumMillisecsPerSec);
+  int second = AtomicOps::AcquireLoad(&second_);
+  // Only the thread that moves the limiter to a new second resets the count.
+  if (second != now &&
+      AtomicOps::CompareAndSwap(&second_, second, now) == second) {
+    AtomicOps::ReleaseStore(&count_, 0);
+  }
+  if (AtomicOps::Increment(&count_) > max_per_second_) {
+    AtomicOps::Increment(&suppressed_);
+    return -1;
+  }
+  int suppressed = AtomicOps::AcquireLoad(&suppressed_);
+  while (suppressed > 0) {
+    int previous = AtomicOps::CompareAndSwap(&suppressed_, suppressed, 0);
+    if (previous == suppressed)
+      break;
+    suppressed = previous;
+  }
+  return suppressed;
+}
+
+std::ostream& operator<<(std::ostream& os, const LogSuppressedCount& count) {
+  if (count.count > 0)
+    os << "(" << count.count << " similar messages suppressed) ";
+  return os;
+}
+
+}  // namespace rtc
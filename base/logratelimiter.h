@@ -0,0 +1,65 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_BASE_LOGRATELIMITER_H_
+#define WEBRTC_BASE_LOGRATELIMITER_H_
+
+#include <ostream>
+
+#include "webrtc/base/logging.h"
+
+namespace rtc {
+
+// Limits a log call site to a number of messages per second, for messages
+// that may be hit once per packet (e.g. when decryption fails), where the
+// logging itself would otherwise become the bottleneck. Usage:
+//
+//   LOG_RATE_LIMITED(LS_WARNING, 5) << "Failed to unprotect packet";
+//
+// The first message let through after some were dropped is prefixed with the
+// number dropped. The limiter is thread safe and constant initialized, so it
+// can be a function-local static.
+class LogRateLimiter {
+ public:
+  constexpr explicit LogRateLimiter(int max_per_second)
+      : max_per_second_(max_per_second),
+        second_(-1),
+        count_(0),
+        suppressed_(0) {}
+
+  // Returns -1 if the message should be dropped. Otherwise returns the number
+  // of messages dropped since the last one was let through.
+  int Allow();
+
+ private:
+  const int max_per_second_;
+  int second_;
+  int count_;
+  int suppressed_;
+};
+
+// Streams "(N similar messages suppressed) " if |count| is positive.
+struct LogSuppressedCount {
+  int count;
+};
+std::ostream& operator<<(std::ostream& os, const LogSuppressedCount& count);
+
+}  // namespace rtc
+
+// The lambda gives every call site its own limiter.
+#define LOG_RATE_LIMITED(sev, max_per_second)                              \
+  for (int rtc_log_suppressed = [] {                                       \
+         static rtc::LogRateLimiter limiter(max_per_second);               \
+         return &limiter;                                                  \
+       }()->Allow();                                                       \
+       rtc_log_suppressed >= 0; rtc_log_suppressed = -1)                   \
+    LOG(sev) << rtc::LogSuppressedCount{rtc_log_suppressed}
+
+#endif  // WEBRTC_BASE_LOGRATELIMITER_H_
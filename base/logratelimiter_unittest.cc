@@ -0,0 +1,89 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/logratelimiter.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/fakeclock.h"
+#include "webrtc/base/gunit.h"
+
+namespace rtc {
+namespace {
+
+class LogMessageSink : public LogSink {
+ public:
+  void OnLogMessage(const std::string& message) override {
+    messages.push_back(message);
+  }
+
+  std::vector<std::string> messages;
+};
+
+void LogFromOneCallSite(int* formatted) {
+  LOG_RATE_LIMITED(LS_INFO, 2) << "message " << ++*formatted;
+}
+
+}  // namespace
+
+TEST(LogRateLimiterTest, AllowsMaxPerSecond) {
+  ScopedFakeClock clock;
+  clock.AdvanceTime(TimeDelta::FromSeconds(1));
+  LogRateLimiter limiter(2);
+  EXPECT_EQ(0, limiter.Allow());
+  EXPECT_EQ(0, limiter.Allow());
+  EXPECT_EQ(-1, limiter.Allow());
+  EXPECT_EQ(-1, limiter.Allow());
+
+  clock.AdvanceTime(TimeDelta::FromSeconds(1));
+  // Reports the two dropped messages, once.
+  EXPECT_EQ(2, limiter.Allow());
+  EXPECT_EQ(0, limiter.Allow());
+  EXPECT_EQ(-1, limiter.Allow());
+}
+
+TEST(LogRateLimiterTest, StreamsSuppressedCount) {
+  std::ostringstream none;
+  none << LogSuppressedCount{0} << "message";
+  EXPECT_EQ("message", none.str());
+
+  std::ostringstream some;
+  some << LogSuppressedCount{3} << "message";
+  EXPECT_EQ("(3 similar messages suppressed) message", some.str());
+}
+
+TEST(LogRateLimiterTest, MacroLimitsEachCallSite) {
+  ScopedFakeClock clock;
+  clock.AdvanceTime(TimeDelta::FromSeconds(1));
+  LogMessageSink sink;
+  LogMessage::AddLogToStream(&sink, LS_INFO);
+
+  int formatted = 0;
+  for (int i = 0; i < 5; ++i)
+    LogFromOneCallSite(&formatted);
+  // Dropped messages are not formatted either.
+  EXPECT_EQ(2, formatted);
+  EXPECT_EQ(2u, sink.messages.size());
+
+  clock.AdvanceTime(TimeDelta::FromSeconds(1));
+  LogFromOneCallSite(&formatted);
+  LOG_RATE_LIMITED(LS_INFO, 2) << "other call site";
+  ASSERT_EQ(4u, sink.messages.size());
+  EXPECT_NE(std::string::npos,
+            sink.messages[2].find("(3 similar messages suppressed) message 3"));
+  EXPECT_NE(std::string::npos, sink.messages[3].find("other call site"));
+  EXPECT_EQ(std::string::npos, sink.messages[3].find("suppressed"));
+
+  LogMessage::RemoveLogToStream(&sink);
+}
+
+}  // namespace rtc
@@ -91,6 +91,13 @@ size_t ComputeHmac(MessageDigest* digest, const void* key, size_t key_len,
 size_t ComputeHmac(const std::string& alg, const void* key, size_t key_len,
                    const void* input, size_t in_len,
                    void* output, size_t out_len);
+// Like the first function, but computes the HMAC of |in_len1| bytes of
+// |input1| followed by |in_len2| bytes of |input2|, so that a message whose
+// header has to be changed for the HMAC needn't be copied.
+size_t ComputeHmac(MessageDigest* digest, const void* key, size_t key_len,
+                   const void* input1, size_t in_len1,
+                   const void* input2, size_t in_len2,
+                   void* output, size_t out_len);
 // Computes the HMAC of |input| using the |digest| hash implementation and |key|
 // to key the HMAC, and returns it as a hex-encoded string.
 std::string ComputeHmac(MessageDigest* digest, const std::string& key,
@@ -8,6 +8,8 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <memory>
+
 #include "webrtc/base/gunit.h"
 #include "webrtc/base/messagedigest.h"
 #include "webrtc/base/stringencode.h"
@@ -142,6 +144,22 @@ TEST(MessageDigestTest, TestSha1Hmac) {
           input.c_str(), input.size(), output, sizeof(output) - 1));
 }
 
+TEST(MessageDigestTest, TestSplitInputHmac) {
+  std::string key(20, '\x0b');
+  std::string input("Hi There");
+  std::unique_ptr<MessageDigest> digest(
+      MessageDigestFactory::Create(DIGEST_SHA_1));
+  ASSERT_TRUE(digest);
+  char output[20];
+  for (size_t i = 0; i <= input.size(); ++i) {
+    EXPECT_EQ(sizeof(output),
+        ComputeHmac(digest.get(), key.c_str(), key.size(), input.c_str(), i,
+            input.c_str() + i, input.size() - i, output, sizeof(output)));
+    EXPECT_EQ("b617318655057264e28bc0b6fb378c8ef146be00",
+        hex_encode(output, sizeof(output)));
+  }
+}
+
 TEST(MessageDigestTest, TestBadHmac) {
   std::string output;
   EXPECT_FALSE(ComputeHmac("sha-9000", "key", "abc", &output));
@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_BASE_MPSC_QUEUE_H_
+#define WEBRTC_BASE_MPSC_QUEUE_H_
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/constructormagic.h"
+
+namespace rtc {
+
+// A multi-producer, single-consumer queue of owned items that never blocks.
+// Producers link their item onto the head of a list with a compare-and-swap,
+// and the consumer takes the whole list at once and restores the order in
+// which the items were pushed. Since Push() tells whether the queue was empty,
+// producers can wake up the consumer once per batch instead of once per item.
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() {}
+  ~MpscQueue() {
+    std::vector<std::unique_ptr<T>> items;
+    PopAll(&items);
+  }
+
+  // May be called from any thread. Returns true if the queue was empty, in
+  // which case the consumer has to be told that there is work to do.
+  bool Push(std::unique_ptr<T> item) {
+    Node* node = new Node(std::move(item));
+    Node* head = AtomicOps::AcquireLoadPtr(&head_);
+    while (true) {
+      node->next = head;
+      Node* previous = AtomicOps::CompareAndSwapPtr(&head_, head, node);
+      if (previous == head)
+        return head == nullptr;
+      head = previous;
+    }
+  }
+
+  // Must only be called from the consumer thread. Appends all items to
+  // |items| in the order they were pushed and leaves the queue empty.
+  void PopAll(std::vector<std::unique_ptr<T>>* items) {
+    Node* head = AtomicOps::AcquireLoadPtr(&head_);
+    while (head) {
+      Node* previous = AtomicOps::CompareAndSwapPtr(
+          &head_, head, static_cast<Node*>(nullptr));
+      if (previous == head)
+        break;
+      head = previous;
+    }
+    // The list is linked from the newest item to the oldest one.
+    Node* oldest = nullptr;
+    while (head) {
+      Node* next = head->next;
+      head->next = oldest;
+      oldest = head;
+      head = next;
+    }
+    while (oldest) {
+      items->push_back(std::move(oldest->item));
+      Node* next = oldest->next;
+      delete oldest;
+      oldest = next;
+    }
+  }
+
+ private:
+  struct Node {
+    explicit Node(std::unique_ptr<T> item)
+        : item(std::move(item)), next(nullptr) {}
+    std::unique_ptr<T> item;
+    Node* next;
+  };
+
+  Node* volatile head_ = nullptr;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(MpscQueue);
+};
+
+}  // namespace rtc
+
+#endif  // WEBRTC_BASE_MPSC_QUEUE_H_
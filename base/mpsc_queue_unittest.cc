@@ -0,0 +1,106 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/mpsc_queue.h"
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/gunit.h"
+#include "webrtc/base/platform_thread.h"
+
+namespace rtc {
+
+namespace {
+
+struct Item {
+  Item(int producer, int sequence_number)
+      : producer(producer), sequence_number(sequence_number) {}
+  int producer;
+  int sequence_number;
+};
+
+const int kNumProducers = 4;
+const int kItemsPerProducer = 10000;
+
+struct Producer {
+  MpscQueue<Item>* queue;
+  int id;
+};
+
+bool ProduceItems(void* obj) {
+  Producer* producer = static_cast<Producer*>(obj);
+  for (int i = 0; i < kItemsPerProducer; ++i)
+    producer->queue->Push(std::unique_ptr<Item>(new Item(producer->id, i)));
+  return false;
+}
+
+}  // namespace
+
+TEST(MpscQueueTest, PushReportsWhetherQueueWasEmpty) {
+  MpscQueue<Item> queue;
+  EXPECT_TRUE(queue.Push(std::unique_ptr<Item>(new Item(0, 0))));
+  EXPECT_FALSE(queue.Push(std::unique_ptr<Item>(new Item(0, 1))));
+
+  std::vector<std::unique_ptr<Item>> items;
+  queue.PopAll(&items);
+  EXPECT_EQ(2u, items.size());
+  EXPECT_TRUE(queue.Push(std::unique_ptr<Item>(new Item(0, 2))));
+}
+
+TEST(MpscQueueTest, PopsItemsInPushOrder) {
+  MpscQueue<Item> queue;
+  for (int i = 0; i < 10; ++i)
+    queue.Push(std::unique_ptr<Item>(new Item(0, i)));
+
+  std::vector<std::unique_ptr<Item>> items;
+  queue.PopAll(&items);
+  ASSERT_EQ(10u, items.size());
+  for (int i = 0; i < 10; ++i)
+    EXPECT_EQ(i, items[i]->sequence_number);
+
+  items.clear();
+  queue.PopAll(&items);
+  EXPECT_TRUE(items.empty());
+}
+
+TEST(MpscQueueTest, KeepsOrderOfEachProducer) {
+  MpscQueue<Item> queue;
+  Producer producers[kNumProducers];
+  std::vector<std::unique_ptr<PlatformThread>> threads;
+  for (int i = 0; i < kNumProducers; ++i) {
+    producers[i].queue = &queue;
+    producers[i].id = i;
+    threads.push_back(std::unique_ptr<PlatformThread>(
+        new PlatformThread(&ProduceItems, &producers[i], "MpscProducer")));
+    threads.back()->Start();
+  }
+
+  std::vector<int> next_sequence_numbers(kNumProducers, 0);
+  int num_items = 0;
+  std::vector<std::unique_ptr<Item>> items;
+  while (num_items < kNumProducers * kItemsPerProducer) {
+    items.clear();
+    queue.PopAll(&items);
+    for (const auto& item : items) {
+      EXPECT_EQ(next_sequence_numbers[item->producer], item->sequence_number);
+      next_sequence_numbers[item->producer] = item->sequence_number + 1;
+    }
+    num_items += static_cast<int>(items.size());
+  }
+
+  for (auto& thread : threads)
+    thread->Stop();
+  items.clear();
+  queue.PopAll(&items);
+  EXPECT_TRUE(items.empty());
+}
+
+}  // namespace rtc
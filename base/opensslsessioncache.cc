@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/opensslsessioncache.h"
+
+#include <openssl/rand.h>
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+
+namespace rtc {
+
+const size_t OpenSSLSessionCache::kMaxSessions;
+
+OpenSSLSessionCache::OpenSSLSessionCache() {
+  RTC_CHECK_EQ(1, RAND_bytes(ticket_keys_, sizeof(ticket_keys_)));
+}
+
+OpenSSLSessionCache::~OpenSSLSessionCache() {
+  for (auto& kv : sessions_)
+    SSL_SESSION_free(kv.second);
+}
+
+bool OpenSSLSessionCache::ConfigureContext(SSL_CTX* ctx) {
+  return SSL_CTX_set_tlsext_ticket_keys(ctx, ticket_keys_,
+                                        sizeof(ticket_keys_)) == 1;
+}
+
+SSL_SESSION* OpenSSLSessionCache::LookupSession(const std::string& key) {
+  CritScope cs(&crit_);
+  auto it = sessions_.find(key);
+  if (it == sessions_.end())
+    return nullptr;
+  SSL_SESSION* session = it->second;
+#ifdef OPENSSL_IS_BORINGSSL
+  SSL_SESSION_up_ref(session);
+#else
+  CRYPTO_add(&session->references, 1, CRYPTO_LOCK_SSL_SESSION);
+#endif
+  return session;
+}
+
+void OpenSSLSessionCache::StoreSession(const std::string& key,
+                                       SSL_SESSION* session) {
+  RTC_DCHECK(session);
+  CritScope cs(&crit_);
+  auto it = sessions_.find(key);
+  if (it != sessions_.end()) {
+    SSL_SESSION_free(it->second);
+    it->second = session;
+    return;
+  }
+  if (sessions_.size() >= kMaxSessions) {
+    auto oldest = sessions_.find(keys_.front());
+    SSL_SESSION_free(oldest->second);
+    sessions_.erase(oldest);
+    keys_.pop_front();
+  }
+  sessions_[key] = session;
+  keys_.push_back(key);
+}
+
+void OpenSSLSessionCache::RemoveSession(const std::string& key) {
+  CritScope cs(&crit_);
+  auto it = sessions_.find(key);
+  if (it == sessions_.end())
+    return;
+  SSL_SESSION_free(it->second);
+  sessions_.erase(it);
+  keys_.erase(std::find(keys_.begin(), keys_.end(), key));
+}
+
+size_t OpenSSLSessionCache::num_sessions() const {
+  CritScope cs(&crit_);
+  return sessions_.size();
+}
+
+}  // namespace rtc
@@ -0,0 +1,63 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_BASE_OPENSSLSESSIONCACHE_H_
+#define WEBRTC_BASE_OPENSSLSESSIONCACHE_H_
+
+#include <openssl/ssl.h>
+
+#include <deque>
+#include <map>
+#include <string>
+
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/sslstreamadapter.h"
+#include "webrtc/base/thread_annotations.h"
+
+namespace rtc {
+
+// An implementation of the session cache that uses OpenSSL. Servers resume
+// sessions with session tickets, which every context configured by the cache
+// can decrypt. Clients keep the last session established with each peer.
+class OpenSSLSessionCache : public SSLSessionCache {
+ public:
+  // Number of client sessions kept before the oldest are dropped.
+  static const size_t kMaxSessions = 256;
+
+  OpenSSLSessionCache();
+  ~OpenSSLSessionCache() override;
+
+  // Makes |ctx| issue session tickets that any context configured by this
+  // cache accepts.
+  bool ConfigureContext(SSL_CTX* ctx);
+
+  // Returns a new reference to the session stored under |key|, or null.
+  SSL_SESSION* LookupSession(const std::string& key);
+  // Stores |session| under |key|, replacing any previous session. Takes the
+  // reference to |session|.
+  void StoreSession(const std::string& key, SSL_SESSION* session);
+  void RemoveSession(const std::string& key);
+
+  size_t num_sessions() const;
+
+ private:
+  // Key name, HMAC secret and AES key, as SSL_CTX_set_tlsext_ticket_keys
+  // expects them.
+  uint8_t ticket_keys_[48];
+
+  mutable CriticalSection crit_;
+  std::map<std::string, SSL_SESSION*> sessions_ GUARDED_BY(crit_);
+  // Keys of |sessions_|, oldest first.
+  std::deque<std::string> keys_ GUARDED_BY(crit_);
+};
+
+}  // namespace rtc
+
+#endif  // WEBRTC_BASE_OPENSSLSESSIONCACHE_H_
@@ -35,6 +35,7 @@
 #include "webrtc/base/openssladapter.h"
 #include "webrtc/base/openssldigest.h"
 #include "webrtc/base/opensslidentity.h"
+#include "webrtc/base/opensslsessioncache.h"
 #include "webrtc/base/stringutils.h"
 #include "webrtc/base/timeutils.h"
 #include "webrtc/base/thread.h"
@@ -425,6 +426,10 @@ int OpenSSLStreamAdapter::GetSslVersion() const {
   return -1;
 }
 
+bool OpenSSLStreamAdapter::IsSessionResumed() const {
+  return state_ == SSL_CONNECTED && SSL_session_reused(ssl_);
+}
+
 // Key Extractor interface
 bool OpenSSLStreamAdapter::ExportKeyingMaterial(const std::string& label,
                                                 const uint8_t* context,
@@ -530,6 +535,12 @@ int OpenSSLStreamAdapter::StartSSL() {
   return 0;
 }
 
+void OpenSSLStreamAdapter::SetSessionCache(SSLSessionCache* cache) {
+  RTC_DCHECK(state_ == SSL_NONE);
+  // OpenSSLSessionCache is the only implementation when OpenSSL is used.
+  session_cache_ = static_cast<OpenSSLSessionCache*>(cache);
+}
+
 void OpenSSLStreamAdapter::SetMode(SSLMode mode) {
   RTC_DCHECK(state_ == SSL_NONE);
   ssl_mode_ = mode;
@@ -814,6 +825,22 @@ int OpenSSLStreamAdapter::BeginSSL() {
 
   SSL_set_app_data(ssl_, this);
 
+  if (role_ == SSL_CLIENT && !local_certificate_digest_.empty() &&
+      has_peer_certificate_digest()) {
+    // Only offer a session established between the same certificates.
+    session_cache_key_.assign(local_certificate_digest_.data<char>(),
+                              local_certificate_digest_.size());
+    session_cache_key_ += peer_certificate_digest_algorithm_;
+    session_cache_key_.append(peer_certificate_digest_value_.data<char>(),
+                              peer_certificate_digest_value_.size());
+    SSL_SESSION* session = session_cache_->LookupSession(session_cache_key_);
+    if (session) {
+      LOG(LS_INFO) << "Offering cached session.";
+      SSL_set_session(ssl_, session);
+      SSL_SESSION_free(session);
+    }
+  }
+
   SSL_set_bio(ssl_, bio, bio);  // the SSL object owns the bio now.
   if (ssl_mode_ == SSL_MODE_DTLS) {
 #ifdef OPENSSL_IS_BORINGSSL
@@ -861,6 +888,8 @@ int OpenSSLStreamAdapter::ContinueSSL() {
   switch (ssl_error = SSL_get_error(ssl_, code)) {
     case SSL_ERROR_NONE:
       LOG(LS_VERBOSE) << " -- success";
+      if (SSL_session_reused(ssl_) && !VerifyResumedPeerCertificate())
+        return -1;
       // By this point, OpenSSL should have given us a certificate, or errored
       // out if one was missing.
       RTC_DCHECK(peer_certificate_ || !client_auth_enabled());
@@ -878,6 +907,12 @@ int OpenSSLStreamAdapter::ContinueSSL() {
         StreamAdapterInterface::OnEvent(stream(), SE_OPEN | SE_READ | SE_WRITE,
                                         0);
       }
+      if (!session_cache_key_.empty() && peer_certificate_verified_) {
+        // Keep the session, which may have been updated with a new ticket,
+        // for the next connection.
+        if (SSL_SESSION* session = SSL_get1_session(ssl_))
+          session_cache_->StoreSession(session_cache_key_, session);
+      }
       break;
 
     case SSL_ERROR_WANT_READ: {
@@ -904,6 +939,10 @@ int OpenSSLStreamAdapter::ContinueSSL() {
       if (err_code != 0 && ERR_GET_REASON(err_code) == SSL_R_NO_SHARED_CIPHER) {
         ssl_handshake_err = SSLHandshakeError::INCOMPATIBLE_CIPHERSUITE;
       }
+      if (!session_cache_key_.empty()) {
+        // Don't offer a session that may be the cause of the failure again.
+        session_cache_->RemoveSession(session_cache_key_);
+      }
       SignalSSLHandshakeError(ssl_handshake_err);
       return (ssl_error != 0) ? ssl_error : -1;
   }
@@ -1075,6 +1114,23 @@ SSL_CTX* OpenSSLStreamAdapter::SetupSSLContext() {
     return NULL;
   }
 
+  if (identity_ && session_cache_) {
+    // The session ID context keeps sessions established with another
+    // certificate of ours from being resumed.
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    size_t digest_length;
+    if (!OpenSSLCertificate::ComputeDigest(identity_->certificate().x509(),
+                                           DIGEST_SHA_256, digest,
+                                           sizeof(digest), &digest_length) ||
+        !SSL_CTX_set_session_id_context(
+            ctx, digest, static_cast<unsigned int>(digest_length)) ||
+        !session_cache_->ConfigureContext(ctx)) {
+      SSL_CTX_free(ctx);
+      return NULL;
+    }
+    local_certificate_digest_.SetData(digest, digest_length);
+  }
+
 #if !defined(NDEBUG)
   SSL_CTX_set_info_callback(ctx, OpenSSLAdapter::SSLInfoCallback);
 #endif
@@ -1136,6 +1192,26 @@ bool OpenSSLStreamAdapter::VerifyPeerCertificate() {
   return true;
 }
 
+bool OpenSSLStreamAdapter::VerifyResumedPeerCertificate() {
+  X509* cert = SSL_get_peer_certificate(ssl_);
+  if (!cert) {
+    // Only possible if the server doesn't require a client certificate.
+    return !client_auth_enabled();
+  }
+  peer_certificate_.reset(new OpenSSLCertificate(cert));
+  X509_free(cert);
+
+  // As in SSLVerifyCallback, verification waits for the digest if it isn't
+  // known yet.
+  if (!has_peer_certificate_digest())
+    return true;
+  if (VerifyPeerCertificate())
+    return true;
+  if (!session_cache_key_.empty())
+    session_cache_->RemoveSession(session_cache_key_);
+  return false;
+}
+
 int OpenSSLStreamAdapter::SSLVerifyCallback(int ok, X509_STORE_CTX* store) {
   // Get our SSL structure from the store
   SSL* ssl = reinterpret_cast<SSL*>(
@@ -51,6 +51,7 @@ namespace rtc {
 // Look in sslstreamadapter.h for documentation of the methods.
 
 class OpenSSLIdentity;
+class OpenSSLSessionCache;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -74,6 +75,7 @@ class OpenSSLStreamAdapter : public SSLStreamAdapter {
   // Goes from state SSL_NONE to either SSL_CONNECTING or SSL_WAIT, depending
   // on whether the underlying stream is already open or not.
   int StartSSL() override;
+  void SetSessionCache(SSLSessionCache* cache) override;
   void SetMode(SSLMode mode) override;
   void SetMaxProtocolVersion(SSLProtocolVersion version) override;
 
@@ -94,6 +96,7 @@ class OpenSSLStreamAdapter : public SSLStreamAdapter {
   bool GetSslCipherSuite(int* cipher) override;
 
   int GetSslVersion() const override;
+  bool IsSessionResumed() const override;
 
   // Key Extractor interface
   bool ExportKeyingMaterial(const std::string& label,
@@ -171,6 +174,9 @@ class OpenSSLStreamAdapter : public SSLStreamAdapter {
   SSL_CTX* SetupSSLContext();
   // Verify the peer certificate matches the signaled digest.
   bool VerifyPeerCertificate();
+  // Takes the peer certificate of a resumed session, which the verify
+  // callback doesn't see, and verifies it. Returns false if it doesn't match.
+  bool VerifyResumedPeerCertificate();
   // SSL certification verification error handler, called back from
   // the openssl library. Returns an int interpreted as a boolean in
   // the C style: zero means verification failure, non-zero means
@@ -215,6 +221,13 @@ class OpenSSLStreamAdapter : public SSLStreamAdapter {
 
   // Max. allowed protocol version
   SSLProtocolVersion ssl_max_version_;
+
+  OpenSSLSessionCache* session_cache_ = nullptr;
+  // Digest of our certificate, which binds sessions to it.
+  Buffer local_certificate_digest_;
+  // Key of the session in |session_cache_| the client offers, empty if it
+  // doesn't use the cache.
+  std::string session_cache_key_;
 };
 
 /////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,119 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/packet_trace.h"
+
+#include <vector>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/timeutils.h"
+
+namespace rtc {
+namespace packet_trace {
+
+namespace {
+
+struct Slot {
+  // The index of the event in the slot, or 0 while it is being written.
+  volatile int index;
+  Event event;
+};
+
+// Allocated by the first Start and never freed, since Record may still be
+// writing to it after Stop.
+Slot* volatile g_slots = nullptr;
+// The index of the last event claimed by Record. Indices start at 1 and
+// wrap around; kCapacity divides 2^32, so each index maps to a fixed slot.
+volatile int g_last_index = 0;
+
+GlobalLockPod g_export_lock;
+ExportCallback g_export_callback GUARDED_BY(g_export_lock) = nullptr;
+uint32_t g_last_exported_index GUARDED_BY(g_export_lock) = 0;
+
+}  // namespace
+
+namespace internal {
+
+volatile int g_sample_interval = 0;
+
+void Record(Stage stage, uint32_t ssrc, uint16_t sequence_number) {
+  Slot* slots = AtomicOps::AcquireLoadPtr(&g_slots);
+  if (!slots)
+    return;
+  const int index = AtomicOps::Increment(&g_last_index);
+  Slot* slot = &slots[static_cast<uint32_t>(index) % kCapacity];
+  // Mark the slot as being written. The compare and swap is a full barrier,
+  // so Export can't see the new event with the old index.
+  const int previous_index = AtomicOps::AcquireLoad(&slot->index);
+  AtomicOps::CompareAndSwap(&slot->index, previous_index, 0);
+  slot->event.time_us = SystemTimeNanos() / kNumNanosecsPerMicrosec;
+  slot->event.ssrc = ssrc;
+  slot->event.sequence_number = sequence_number;
+  slot->event.stage = stage;
+  AtomicOps::ReleaseStore(&slot->index, index);
+}
+
+}  // namespace internal
+
+void Start(int sample_interval) {
+  RTC_DCHECK_GT(sample_interval, 0);
+  if (!AtomicOps::AcquireLoadPtr(&g_slots)) {
+    Slot* slots = new Slot[kCapacity]();
+    if (AtomicOps::CompareAndSwapPtr(&g_slots, static_cast<Slot*>(nullptr),
+                                     slots) != nullptr) {
+      delete[] slots;
+    }
+  }
+  AtomicOps::ReleaseStore(&internal::g_sample_interval, sample_interval);
+}
+
+void Stop() {
+  AtomicOps::ReleaseStore(&internal::g_sample_interval, 0);
+}
+
+void SetExportCallback(ExportCallback callback) {
+  GlobalLockScope lock(&g_export_lock);
+  g_export_callback = callback;
+}
+
+void Export() {
+  GlobalLockScope lock(&g_export_lock);
+  Slot* slots = AtomicOps::AcquireLoadPtr(&g_slots);
+  if (!g_export_callback || !slots)
+    return;
+  const uint32_t last_index =
+      static_cast<uint32_t>(AtomicOps::AcquireLoad(&g_last_index));
+  uint32_t first_index = g_last_exported_index + 1;
+  if (last_index - g_last_exported_index > kCapacity)
+    first_index = last_index - kCapacity + 1;
+  g_last_exported_index = last_index;
+
+  std::vector<Event> events;
+  events.reserve(last_index - first_index + 1);
+  for (uint32_t index = first_index; index != last_index + 1; ++index) {
+    Slot* slot = &slots[index % kCapacity];
+    const int expected_index = static_cast<int>(index);
+    if (AtomicOps::AcquireLoad(&slot->index) != expected_index)
+      continue;
+    Event event = slot->event;
+    // Skip the event if it was overwritten while being copied. The compare
+    // and swap doesn't change the index, it is used as a full barrier.
+    if (AtomicOps::CompareAndSwap(&slot->index, expected_index,
+                                  expected_index) != expected_index) {
+      continue;
+    }
+    events.push_back(event);
+  }
+  g_export_callback(events.data(), events.size());
+}
+
+}  // namespace packet_trace
+}  // namespace rtc
@@ -0,0 +1,100 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Low overhead tracing of the stages RTP packets go through on their way to
+// and from the network, meant to be left on in production to find where
+// latency is added.
+//
+// Unlike TRACE_EVENT, recording an event takes no lock, no string and no
+// allocation: one in |sample_interval| packets, picked by sequence number so
+// that every stage of a sampled packet is recorded, gets a timestamp written
+// to a global ring buffer. While tracing is stopped, Record costs one load.
+//
+// The events are handed to the callback set with SetExportCallback when
+// Export is called, e.g. periodically by the application. Events older than
+// the size of the ring buffer, or being written while Export runs, are lost.
+
+#ifndef WEBRTC_BASE_PACKET_TRACE_H_
+#define WEBRTC_BASE_PACKET_TRACE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "webrtc/base/atomicops.h"
+
+namespace rtc {
+namespace packet_trace {
+
+enum class Stage : uint8_t {
+  // Send side.
+  kPacketized,
+  kMediaEncrypted,
+  kPacerEnqueued,
+  kPacerDequeued,
+  kSrtpProtected,
+  kSocketSent,
+  // Receive side.
+  kSocketReceived,
+  kSrtpUnprotected,
+  kCallDelivered,
+  kMediaDecrypted,
+};
+
+struct Event {
+  // From SystemTimeNanos(), which a ScopedCachedTime doesn't hold.
+  int64_t time_us;
+  uint32_t ssrc;
+  uint16_t sequence_number;
+  Stage stage;
+};
+
+// Called by Export with the events recorded since the previous call, oldest
+// first. Must not call Export.
+typedef void (*ExportCallback)(const Event* events, size_t num_events);
+
+// The number of events kept in the ring buffer.
+const size_t kCapacity = 1 << 16;
+
+// Starts recording the packets whose sequence number is a multiple of
+// |sample_interval|, which must be positive.
+void Start(int sample_interval);
+void Stop();
+
+void SetExportCallback(ExportCallback callback);
+void Export();
+
+namespace internal {
+extern volatile int g_sample_interval;
+void Record(Stage stage, uint32_t ssrc, uint16_t sequence_number);
+}  // namespace internal
+
+inline void Record(Stage stage, uint32_t ssrc, uint16_t sequence_number) {
+  const int sample_interval =
+      AtomicOps::AcquireLoad(&internal::g_sample_interval);
+  if (sample_interval > 0 && sequence_number % sample_interval == 0)
+    internal::Record(stage, ssrc, sequence_number);
+}
+
+// Same as Record, for a serialized RTP packet. The header isn't encrypted by
+// SRTP, so this works before protection and after unprotection.
+inline void RecordRtp(Stage stage, const uint8_t* packet, size_t length) {
+  if (AtomicOps::AcquireLoad(&internal::g_sample_interval) <= 0 || length < 12)
+    return;
+  Record(stage,
+         (static_cast<uint32_t>(packet[8]) << 24) |
+             (static_cast<uint32_t>(packet[9]) << 16) |
+             (static_cast<uint32_t>(packet[10]) << 8) | packet[11],
+         static_cast<uint16_t>((packet[2] << 8) | packet[3]));
+}
+
+}  // namespace packet_trace
+}  // namespace rtc
+
+#endif  // WEBRTC_BASE_PACKET_TRACE_H_
@@ -0,0 +1,108 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/packet_trace.h"
+
+#include <vector>
+
+#include "webrtc/base/gunit.h"
+
+namespace rtc {
+namespace packet_trace {
+
+namespace {
+
+std::vector<Event>* g_exported_events = nullptr;
+
+void CollectEvents(const Event* events, size_t num_events) {
+  g_exported_events->insert(g_exported_events->end(), events,
+                            events + num_events);
+}
+
+class PacketTraceTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    g_exported_events = &events_;
+    SetExportCallback(&CollectEvents);
+    // Drop the events left by other tests.
+    Export();
+    events_.clear();
+  }
+
+  void TearDown() override {
+    Stop();
+    SetExportCallback(nullptr);
+    g_exported_events = nullptr;
+  }
+
+  std::vector<Event> events_;
+};
+
+}  // namespace
+
+TEST_F(PacketTraceTest, RecordsSampledPacketsOnly) {
+  Start(4);
+  for (uint16_t sequence_number = 0; sequence_number < 10; ++sequence_number)
+    Record(Stage::kPacketized, 1234, sequence_number);
+  Record(Stage::kSocketSent, 1234, 8);
+  Export();
+
+  ASSERT_EQ(4u, events_.size());
+  EXPECT_EQ(0, events_[0].sequence_number);
+  EXPECT_EQ(4, events_[1].sequence_number);
+  EXPECT_EQ(8, events_[2].sequence_number);
+  EXPECT_EQ(8, events_[3].sequence_number);
+  EXPECT_EQ(Stage::kPacketized, events_[2].stage);
+  EXPECT_EQ(Stage::kSocketSent, events_[3].stage);
+  EXPECT_EQ(1234u, events_[3].ssrc);
+  EXPECT_LE(events_[0].time_us, events_[3].time_us);
+
+  // Events are only exported once.
+  Export();
+  EXPECT_EQ(4u, events_.size());
+}
+
+TEST_F(PacketTraceTest, RecordsNothingWhenStopped) {
+  Start(1);
+  Stop();
+  Record(Stage::kPacketized, 1234, 0);
+  Export();
+  EXPECT_TRUE(events_.empty());
+}
+
+TEST_F(PacketTraceTest, ReadsRtpHeader) {
+  Start(1);
+  const uint8_t packet[] = {0x80, 0x60, 0x12, 0x34, 0, 0, 0, 0,
+                            0x11, 0x22, 0x33, 0x44};
+  RecordRtp(Stage::kSocketReceived, packet, sizeof(packet));
+  // Too short to be an RTP packet.
+  RecordRtp(Stage::kSocketReceived, packet, sizeof(packet) - 1);
+  Export();
+
+  ASSERT_EQ(1u, events_.size());
+  EXPECT_EQ(0x11223344u, events_[0].ssrc);
+  EXPECT_EQ(0x1234, events_[0].sequence_number);
+  EXPECT_EQ(Stage::kSocketReceived, events_[0].stage);
+}
+
+TEST_F(PacketTraceTest, KeepsMostRecentEvents) {
+  Start(1);
+  const size_t kNumEvents = kCapacity + 10;
+  for (size_t i = 0; i < kNumEvents; ++i)
+    Record(Stage::kPacerEnqueued, static_cast<uint32_t>(i), 0);
+  Export();
+
+  ASSERT_EQ(kCapacity, events_.size());
+  EXPECT_EQ(10u, events_.front().ssrc);
+  EXPECT_EQ(kNumEvents - 1, events_.back().ssrc);
+}
+
+}  // namespace packet_trace
+}  // namespace rtc
@@ -28,6 +28,11 @@
 #include <signal.h>
 #endif
 
+#if defined(WEBRTC_USE_EPOLL)
+// "poll" will only be used to wait for the signaling dispatcher.
+#include <poll.h>
+#endif
+
 #if defined(WEBRTC_WIN)
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -154,7 +159,7 @@ bool PhysicalSocket::Create(int family, int type) {
   udp_ = (SOCK_DGRAM == type);
   UpdateLastError();
   if (udp_)
-    enabled_events_ = DE_READ | DE_WRITE;
+    SetEnabledEvents(DE_READ | DE_WRITE);
   return s_ != INVALID_SOCKET;
 }
 
@@ -244,12 +249,12 @@ int PhysicalSocket::DoConnect(const SocketAddress& connect_addr) {
     state_ = CS_CONNECTED;
   } else if (IsBlockingError(GetError())) {
     state_ = CS_CONNECTING;
-    enabled_events_ |= DE_CONNECT;
+    EnableEvents(DE_CONNECT);
   } else {
     return SOCKET_ERROR;
   }
 
-  enabled_events_ |= DE_READ | DE_WRITE;
+  EnableEvents(DE_READ | DE_WRITE);
   return 0;
 }
 
@@ -296,6 +301,18 @@ int PhysicalSocket::SetOption(Option opt, int value) {
 }
 
 int PhysicalSocket::Send(const void* pv, size_t cb) {
+#if defined(WEBRTC_USE_IO_URING)
+  if (udp_) {
+    switch (ss_->QueueUdpSend(s_, pv, cb, nullptr, 0)) {
+      case PhysicalSocketServer::UdpSendResult::kQueued:
+        return static_cast<int>(cb);
+      case PhysicalSocketServer::UdpSendResult::kWouldBlock:
+        return ReportQueuedSendBlocked();
+      case PhysicalSocketServer::UdpSendResult::kSendDirectly:
+        break;
+    }
+  }
+#endif
   int sent = DoSend(s_, reinterpret_cast<const char *>(pv),
       static_cast<int>(cb),
 #if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
@@ -315,7 +332,7 @@ int PhysicalSocket::Send(const void* pv, size_t cb) {
   RTC_DCHECK(sent <= static_cast<int>(cb));
   if ((sent > 0 && sent < static_cast<int>(cb)) ||
       (sent < 0 && IsBlockingError(GetError()))) {
-    enabled_events_ |= DE_WRITE;
+    EnableEvents(DE_WRITE);
   }
   return sent;
 }
@@ -325,6 +342,20 @@ int PhysicalSocket::SendTo(const void* buffer,
                            const SocketAddress& addr) {
   sockaddr_storage saddr;
   size_t len = addr.ToSockAddrStorage(&saddr);
+#if defined(WEBRTC_USE_IO_URING)
+  if (udp_) {
+    switch (ss_->QueueUdpSend(s_, buffer, length,
+                              reinterpret_cast<sockaddr*>(&saddr),
+                              static_cast<socklen_t>(len))) {
+      case PhysicalSocketServer::UdpSendResult::kQueued:
+        return static_cast<int>(length);
+      case PhysicalSocketServer::UdpSendResult::kWouldBlock:
+        return ReportQueuedSendBlocked();
+      case PhysicalSocketServer::UdpSendResult::kSendDirectly:
+        break;
+    }
+  }
+#endif
   int sent = DoSendTo(
       s_, static_cast<const char *>(buffer), static_cast<int>(length),
 #if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
@@ -340,11 +371,19 @@ int PhysicalSocket::SendTo(const void* buffer,
   RTC_DCHECK(sent <= static_cast<int>(length));
   if ((sent > 0 && sent < static_cast<int>(length)) ||
       (sent < 0 && IsBlockingError(GetError()))) {
-    enabled_events_ |= DE_WRITE;
+    EnableEvents(DE_WRITE);
   }
   return sent;
 }
 
+#if defined(WEBRTC_USE_IO_URING)
+int PhysicalSocket::ReportQueuedSendBlocked() {
+  SetError(EWOULDBLOCK);
+  EnableEvents(DE_WRITE);
+  return -1;
+}
+#endif
+
 int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int received = ::recv(s_, static_cast<char*>(buffer),
                         static_cast<int>(length), 0);
@@ -355,7 +394,7 @@ int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
     LOG(LS_WARNING) << "EOF from socket; deferring close event";
     // Must turn this back on so that the select() loop will notice the close
     // event.
-    enabled_events_ |= DE_READ;
+    EnableEvents(DE_READ);
     SetError(EWOULDBLOCK);
     return SOCKET_ERROR;
   }
@@ -366,7 +405,7 @@ int PhysicalSocket::Recv(void* buffer, size_t length, int64_t* timestamp) {
   int error = GetError();
   bool success = (received >= 0) || IsBlockingError(error);
   if (udp_ || success) {
-    enabled_events_ |= DE_READ;
+    EnableEvents(DE_READ);
   }
   if (!success) {
     LOG_F(LS_VERBOSE) << "Error = " << error;
@@ -392,7 +431,7 @@ int PhysicalSocket::RecvFrom(void* buffer,
   int error = GetError();
   bool success = (received >= 0) || IsBlockingError(error);
   if (udp_ || success) {
-    enabled_events_ |= DE_READ;
+    EnableEvents(DE_READ);
   }
   if (!success) {
     LOG_F(LS_VERBOSE) << "Error = " << error;
@@ -400,12 +439,121 @@ int PhysicalSocket::RecvFrom(void* buffer,
   return received;
 }
 
+#if defined(WEBRTC_USE_MMSG)
+// Upper bound of the datagrams passed to a single recvmmsg() or sendmmsg()
+// call, which keeps the message headers on the stack.
+static const size_t kMaxDatagramBatchSize = 32;
+
+int PhysicalSocket::RecvFromBatch(ReceivedDatagram* datagrams,
+                                  size_t count) {
+  if (!udp_)
+    return AsyncSocket::RecvFromBatch(datagrams, count);
+  if (!recv_timestamps_enabled_) {
+    int value = 1;
+    ::setsockopt(s_, SOL_SOCKET, SO_TIMESTAMP, &value, sizeof(value));
+    recv_timestamps_enabled_ = true;
+  }
+  count = std::min(count, kMaxDatagramBatchSize);
+
+  mmsghdr msgs[kMaxDatagramBatchSize];
+  iovec iovs[kMaxDatagramBatchSize];
+  sockaddr_storage addrs[kMaxDatagramBatchSize];
+  char controls[kMaxDatagramBatchSize][CMSG_SPACE(sizeof(timeval))];
+  memset(msgs, 0, count * sizeof(msgs[0]));
+  for (size_t i = 0; i < count; ++i) {
+    iovs[i].iov_base = datagrams[i].buffer;
+    iovs[i].iov_len = datagrams[i].capacity;
+    msgs[i].msg_hdr.msg_name = &addrs[i];
+    msgs[i].msg_hdr.msg_namelen = sizeof(addrs[i]);
+    msgs[i].msg_hdr.msg_iov = &iovs[i];
+    msgs[i].msg_hdr.msg_iovlen = 1;
+    msgs[i].msg_hdr.msg_control = controls[i];
+    msgs[i].msg_hdr.msg_controllen = sizeof(controls[i]);
+  }
+  int received =
+      ::recvmmsg(s_, msgs, static_cast<unsigned int>(count), 0, nullptr);
+  UpdateLastError();
+  int error = GetError();
+  EnableEvents(DE_READ);
+  if (received < 0 && !IsBlockingError(error)) {
+    LOG_F(LS_VERBOSE) << "Error = " << error;
+  }
+
+  for (int i = 0; i < received; ++i) {
+    ReceivedDatagram& datagram = datagrams[i];
+    const msghdr& hdr = msgs[i].msg_hdr;
+    datagram.length = std::min<size_t>(msgs[i].msg_len, datagram.capacity);
+    datagram.truncated = (hdr.msg_flags & MSG_TRUNC) != 0;
+    SocketAddressFromSockAddrStorage(addrs[i], &datagram.address);
+    datagram.timestamp = -1;
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg;
+         cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&hdr), cmsg)) {
+      if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMP) {
+        timeval tv;
+        memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+        datagram.timestamp =
+            kNumMicrosecsPerSec * static_cast<int64_t>(tv.tv_sec) +
+            static_cast<int64_t>(tv.tv_usec);
+      }
+    }
+  }
+  return received;
+}
+
+int PhysicalSocket::SendToBatch(const OutgoingDatagram* datagrams,
+                                size_t count) {
+  if (!udp_)
+    return AsyncSocket::SendToBatch(datagrams, count);
+#if defined(WEBRTC_USE_IO_URING)
+  if (ss_->PrepareDirectUdpSend(s_) ==
+      PhysicalSocketServer::UdpSendResult::kWouldBlock) {
+    return ReportQueuedSendBlocked();
+  }
+#endif
+
+  mmsghdr msgs[kMaxDatagramBatchSize];
+  iovec iovs[kMaxDatagramBatchSize];
+  sockaddr_storage addrs[kMaxDatagramBatchSize];
+  size_t total_sent = 0;
+  int sent = 0;
+  while (total_sent < count) {
+    const OutgoingDatagram* batch = datagrams + total_sent;
+    size_t batch_size = std::min(count - total_sent, kMaxDatagramBatchSize);
+    memset(msgs, 0, batch_size * sizeof(msgs[0]));
+    for (size_t i = 0; i < batch_size; ++i) {
+      iovs[i].iov_base = const_cast<void*>(batch[i].data);
+      iovs[i].iov_len = batch[i].length;
+      msgs[i].msg_hdr.msg_name = &addrs[i];
+      msgs[i].msg_hdr.msg_namelen = static_cast<socklen_t>(
+          batch[i].address.ToSockAddrStorage(&addrs[i]));
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    // Suppress SIGPIPE. See Send() for explanation.
+    sent = ::sendmmsg(s_, msgs, static_cast<unsigned int>(batch_size),
+                      MSG_NOSIGNAL);
+    UpdateLastError();
+    MaybeRemapSendError();
+    if (sent <= 0)
+      break;
+    // If only part of the batch was sent, the next call starts with the
+    // datagram that failed and reports its error.
+    total_sent += sent;
+  }
+  if ((total_sent > 0 && total_sent < count) ||
+      (sent < 0 && IsBlockingError(GetError()))) {
+    EnableEvents(DE_WRITE);
+  }
+  return total_sent > 0 ? static_cast<int>(total_sent) : sent;
+}
+#endif  // WEBRTC_USE_MMSG
+
 int PhysicalSocket::Listen(int backlog) {
   int err = ::listen(s_, backlog);
   UpdateLastError();
   if (err == 0) {
     state_ = CS_CONNECTING;
-    enabled_events_ |= DE_ACCEPT;
+    EnableEvents(DE_ACCEPT);
 #if !defined(NDEBUG)
     dbg_addr_ = "Listening @ ";
     dbg_addr_.append(GetLocalAddress().ToString());
@@ -417,7 +565,7 @@ int PhysicalSocket::Listen(int backlog) {
 AsyncSocket* PhysicalSocket::Accept(SocketAddress* out_addr) {
   // Always re-subscribe DE_ACCEPT to make sure new incoming connections will
   // trigger an event even if DoAccept returns an error here.
-  enabled_events_ |= DE_ACCEPT;
+  EnableEvents(DE_ACCEPT);
   sockaddr_storage addr_storage;
   socklen_t addr_len = sizeof(addr_storage);
   sockaddr* addr = reinterpret_cast<sockaddr*>(&addr_storage);
@@ -433,11 +581,15 @@ AsyncSocket* PhysicalSocket::Accept(SocketAddress* out_addr) {
 int PhysicalSocket::Close() {
   if (s_ == INVALID_SOCKET)
     return 0;
+#if defined(WEBRTC_USE_IO_URING)
+  if (udp_)
+    ss_->FlushUdpSends(s_);
+#endif
   int err = ::closesocket(s_);
   UpdateLastError();
   s_ = INVALID_SOCKET;
   state_ = CS_CLOSED;
-  enabled_events_ = 0;
+  SetEnabledEvents(0);
   if (resolver_) {
     resolver_->Destroy(false);
     resolver_ = nullptr;
@@ -595,6 +747,15 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
       return -1;
     case OPT_RTP_SENDTIME_EXTN_ID:
       return -1;  // No logging is necessary as this not a OS socket option.
+    case OPT_REUSEPORT:
+#if defined(SO_REUSEPORT)
+      *slevel = SOL_SOCKET;
+      *sopt = SO_REUSEPORT;
+      break;
+#else
+      LOG(LS_WARNING) << "Socket::OPT_REUSEPORT not supported.";
+      return -1;
+#endif
     default:
       RTC_NOTREACHED();
       return -1;
@@ -602,6 +763,18 @@ int PhysicalSocket::TranslateOption(Option opt, int* slevel, int* sopt) {
   return 0;
 }
 
+void PhysicalSocket::SetEnabledEvents(uint8_t events) {
+  enabled_events_ = events;
+}
+
+void PhysicalSocket::EnableEvents(uint8_t events) {
+  enabled_events_ |= events;
+}
+
+void PhysicalSocket::DisableEvents(uint8_t events) {
+  enabled_events_ &= ~events;
+}
+
 SocketDispatcher::SocketDispatcher(PhysicalSocketServer *ss)
 #if defined(WEBRTC_WIN)
   : PhysicalSocket(ss), id_(0), signal_close_(false)
@@ -749,7 +922,7 @@ void SocketDispatcher::OnEvent(uint32_t ff, int err) {
   if (((ff & DE_CONNECT) != 0) && (id_ == cache_id)) {
     if (ff != DE_CONNECT)
       LOG(LS_VERBOSE) << "Signalled with DE_CONNECT: " << ff;
-    enabled_events_ &= ~DE_CONNECT;
+    DisableEvents(DE_CONNECT);
 #if !defined(NDEBUG)
     dbg_addr_ = "Connected @ ";
     dbg_addr_.append(GetRemoteAddress().ToString());
@@ -757,15 +930,15 @@ void SocketDispatcher::OnEvent(uint32_t ff, int err) {
     SignalConnectEvent(this);
   }
   if (((ff & DE_ACCEPT) != 0) && (id_ == cache_id)) {
-    enabled_events_ &= ~DE_ACCEPT;
+    DisableEvents(DE_ACCEPT);
     SignalReadEvent(this);
   }
   if ((ff & DE_READ) != 0) {
-    enabled_events_ &= ~DE_READ;
+    DisableEvents(DE_READ);
     SignalReadEvent(this);
   }
   if (((ff & DE_WRITE) != 0) && (id_ == cache_id)) {
-    enabled_events_ &= ~DE_WRITE;
+    DisableEvents(DE_WRITE);
     SignalWriteEvent(this);
   }
   if (((ff & DE_CLOSE) != 0) && (id_ == cache_id)) {
@@ -777,33 +950,79 @@ void SocketDispatcher::OnEvent(uint32_t ff, int err) {
 #elif defined(WEBRTC_POSIX)
 
 void SocketDispatcher::OnEvent(uint32_t ff, int err) {
+#if defined(WEBRTC_USE_EPOLL)
+  StartBatchedEventUpdates();
+#endif
   // Make sure we deliver connect/accept first. Otherwise, consumers may see
   // something like a READ followed by a CONNECT, which would be odd.
   if ((ff & DE_CONNECT) != 0) {
-    enabled_events_ &= ~DE_CONNECT;
+    DisableEvents(DE_CONNECT);
     SignalConnectEvent(this);
   }
   if ((ff & DE_ACCEPT) != 0) {
-    enabled_events_ &= ~DE_ACCEPT;
+    DisableEvents(DE_ACCEPT);
     SignalReadEvent(this);
   }
   if ((ff & DE_READ) != 0) {
-    enabled_events_ &= ~DE_READ;
+    DisableEvents(DE_READ);
     SignalReadEvent(this);
   }
   if ((ff & DE_WRITE) != 0) {
-    enabled_events_ &= ~DE_WRITE;
+    DisableEvents(DE_WRITE);
     SignalWriteEvent(this);
   }
   if ((ff & DE_CLOSE) != 0) {
     // The socket is now dead to us, so stop checking it.
-    enabled_events_ = 0;
+    SetEnabledEvents(0);
     SignalCloseEvent(this, err);
   }
+#if defined(WEBRTC_USE_EPOLL)
+  FinishBatchedEventUpdates();
+#endif
 }
 
 #endif // WEBRTC_POSIX
 
+#if defined(WEBRTC_USE_EPOLL)
+
+void SocketDispatcher::StartBatchedEventUpdates() {
+  RTC_DCHECK_EQ(saved_enabled_events_, -1);
+  saved_enabled_events_ = enabled_events_;
+}
+
+void SocketDispatcher::FinishBatchedEventUpdates() {
+  RTC_DCHECK_NE(saved_enabled_events_, -1);
+  uint8_t old_events = static_cast<uint8_t>(saved_enabled_events_);
+  saved_enabled_events_ = -1;
+  MaybeUpdateDispatcher(old_events);
+}
+
+void SocketDispatcher::MaybeUpdateDispatcher(uint8_t old_events) {
+  if (enabled_events_ != old_events && saved_enabled_events_ == -1) {
+    ss_->Update(this);
+  }
+}
+
+void SocketDispatcher::SetEnabledEvents(uint8_t events) {
+  uint8_t old_events = enabled_events_;
+  PhysicalSocket::SetEnabledEvents(events);
+  MaybeUpdateDispatcher(old_events);
+}
+
+void SocketDispatcher::EnableEvents(uint8_t events) {
+  uint8_t old_events = enabled_events_;
+  PhysicalSocket::EnableEvents(events);
+  MaybeUpdateDispatcher(old_events);
+}
+
+void SocketDispatcher::DisableEvents(uint8_t events) {
+  uint8_t old_events = enabled_events_;
+  PhysicalSocket::DisableEvents(events);
+  MaybeUpdateDispatcher(old_events);
+}
+
+#endif  // WEBRTC_USE_EPOLL
+
 int SocketDispatcher::Close() {
   if (s_ == INVALID_SOCKET)
     return 0;
@@ -1129,8 +1348,58 @@ class Signaler : public EventDispatcher {
   bool *pf_;
 };
 
+#if defined(WEBRTC_USE_IO_URING)
+// Flushes the UDP sends queued by the handlers of one round of socket events.
+// Nested rounds leave the flush to the outermost one.
+class PhysicalSocketServer::ScopedUdpSendBatch {
+ public:
+  explicit ScopedUdpSendBatch(PhysicalSocketServer* ss)
+      : ss_(ss), started_(false) {
+    CritScope cs(&ss_->send_queue_crit_);
+    if (!ss_->send_queue_ || ss_->send_batch_active_)
+      return;
+    ss_->send_batch_active_ = true;
+    ss_->send_batch_thread_ = CurrentThreadRef();
+    started_ = true;
+  }
+
+  ~ScopedUdpSendBatch() {
+    if (!started_)
+      return;
+    CritScope cs(&ss_->send_queue_crit_);
+    ss_->send_queue_->Flush();
+    ss_->send_batch_active_ = false;
+  }
+
+ private:
+  PhysicalSocketServer* const ss_;
+  bool started_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ScopedUdpSendBatch);
+};
+
+// Large enough for the sends of a round of events in most cases; sends that
+// don't fit are made directly after the queued ones have been submitted.
+static const unsigned int kUdpSendQueueEntries = 256;
+#endif
+
 PhysicalSocketServer::PhysicalSocketServer()
     : fWait_(false) {
+#if defined(WEBRTC_USE_EPOLL)
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd_ == -1) {
+    // Not an error, Wait() falls back to select().
+    LOG_E(LS_WARNING, EN, errno) << "epoll_create1";
+    epoll_fd_ = INVALID_SOCKET;
+  }
+#endif
+#if defined(WEBRTC_USE_IO_URING)
+  send_queue_ = IoUringSendQueue::Create(kUdpSendQueueEntries);
+  if (!send_queue_) {
+    // Not an error, UDP sends are made directly.
+    LOG(LS_INFO) << "io_uring not available, not batching UDP sends.";
+  }
+#endif
   signal_wakeup_ = new Signaler(this, &fWait_);
 #if defined(WEBRTC_WIN)
   socket_ev_ = WSACreateEvent();
@@ -1145,6 +1414,11 @@ PhysicalSocketServer::~PhysicalSocketServer() {
   signal_dispatcher_.reset();
 #endif
   delete signal_wakeup_;
+#if defined(WEBRTC_USE_EPOLL)
+  if (epoll_fd_ != INVALID_SOCKET) {
+    close(epoll_fd_);
+  }
+#endif
   RTC_DCHECK(dispatchers_.empty());
 }
 
@@ -1152,6 +1426,52 @@ void PhysicalSocketServer::WakeUp() {
   signal_wakeup_->Signal();
 }
 
+#if defined(WEBRTC_USE_IO_URING)
+PhysicalSocketServer::UdpSendResult PhysicalSocketServer::QueueUdpSend(
+    int fd,
+    const void* data,
+    size_t length,
+    const sockaddr* addr,
+    socklen_t addr_len) {
+  CritScope cs(&send_queue_crit_);
+  if (!send_queue_)
+    return UdpSendResult::kSendDirectly;
+  if (send_queue_->TakeWouldBlock(fd))
+    return UdpSendResult::kWouldBlock;
+  if (send_batch_active_ &&
+      IsThreadRefEqual(send_batch_thread_, CurrentThreadRef()) &&
+      send_queue_->Send(fd, data, length, addr, addr_len)) {
+    return UdpSendResult::kQueued;
+  }
+  return FlushBeforeDirectSend(fd);
+}
+
+PhysicalSocketServer::UdpSendResult PhysicalSocketServer::PrepareDirectUdpSend(
+    int fd) {
+  CritScope cs(&send_queue_crit_);
+  if (!send_queue_)
+    return UdpSendResult::kSendDirectly;
+  return FlushBeforeDirectSend(fd);
+}
+
+PhysicalSocketServer::UdpSendResult PhysicalSocketServer::FlushBeforeDirectSend(
+    int fd) {
+  // A datagram sent directly must not overtake the ones queued before it.
+  send_queue_->Flush();
+  return send_queue_->TakeWouldBlock(fd) ? UdpSendResult::kWouldBlock
+                                         : UdpSendResult::kSendDirectly;
+}
+
+void PhysicalSocketServer::FlushUdpSends(int fd) {
+  CritScope cs(&send_queue_crit_);
+  if (!send_queue_)
+    return;
+  send_queue_->Flush();
+  // The descriptor may be reused by a socket that hasn't blocked.
+  send_queue_->TakeWouldBlock(fd);
+}
+#endif
+
 Socket* PhysicalSocketServer::CreateSocket(int type) {
   return CreateSocket(AF_INET, type);
 }
@@ -1199,6 +1519,11 @@ void PhysicalSocketServer::Add(Dispatcher *pdispatcher) {
   if (pos != dispatchers_.end())
     return;
   dispatchers_.push_back(pdispatcher);
+#if defined(WEBRTC_USE_EPOLL)
+  if (epoll_fd_ != INVALID_SOCKET) {
+    AddEpoll(pdispatcher);
+  }
+#endif
 }
 
 void PhysicalSocketServer::Remove(Dispatcher *pdispatcher) {
@@ -1222,10 +1547,90 @@ void PhysicalSocketServer::Remove(Dispatcher *pdispatcher) {
       --**it;
     }
   }
+#if defined(WEBRTC_USE_EPOLL)
+  if (epoll_fd_ != INVALID_SOCKET) {
+    RemoveEpoll(pdispatcher);
+  }
+#endif
+}
+
+void PhysicalSocketServer::Update(Dispatcher* pdispatcher) {
+#if defined(WEBRTC_USE_EPOLL)
+  if (epoll_fd_ == INVALID_SOCKET) {
+    return;
+  }
+  CritScope cs(&crit_);
+  UpdateEpoll(pdispatcher);
+#endif
 }
 
 #if defined(WEBRTC_POSIX)
+
+static void ProcessEvents(Dispatcher* dispatcher,
+                          bool readable,
+                          bool writable,
+                          bool check_error) {
+  int errcode = 0;
+  // Reap any error code, which can be signaled through reads or writes.
+  // TODO(pthatcher): Should we set errcode if getsockopt fails?
+  if (check_error) {
+    socklen_t len = sizeof(errcode);
+    ::getsockopt(dispatcher->GetDescriptor(), SOL_SOCKET, SO_ERROR, &errcode,
+                 &len);
+  }
+
+  uint32_t ff = 0;
+
+  // Check readable descriptors. If we're waiting on an accept, signal
+  // that. Otherwise we're waiting for data, check to see if we're
+  // readable or really closed.
+  // TODO(pthatcher): Only peek at TCP descriptors.
+  if (readable) {
+    if (dispatcher->GetRequestedEvents() & DE_ACCEPT) {
+      ff |= DE_ACCEPT;
+    } else if (errcode || dispatcher->IsDescriptorClosed()) {
+      ff |= DE_CLOSE;
+    } else {
+      ff |= DE_READ;
+    }
+  }
+
+  // Check writable descriptors. If we're waiting on a connect, detect
+  // success versus failure by the reaped error code.
+  if (writable) {
+    if (dispatcher->GetRequestedEvents() & DE_CONNECT) {
+      if (!errcode) {
+        ff |= DE_CONNECT;
+      } else {
+        ff |= DE_CLOSE;
+      }
+    } else {
+      ff |= DE_WRITE;
+    }
+  }
+
+  // Tell the descriptor about the event.
+  if (ff != 0) {
+    dispatcher->OnPreEvent(ff);
+    dispatcher->OnEvent(ff, errcode);
+  }
+}
+
 bool PhysicalSocketServer::Wait(int cmsWait, bool process_io) {
+#if defined(WEBRTC_USE_EPOLL)
+  // Only the wakeup dispatcher is waited for if I/O is not processed. It is
+  // not part of a dedicated epoll instance, so poll() is used, which unlike
+  // select() supports descriptors beyond FD_SETSIZE.
+  if (!process_io) {
+    return WaitPoll(cmsWait, signal_wakeup_);
+  } else if (epoll_fd_ != INVALID_SOCKET) {
+    return WaitEpoll(cmsWait);
+  }
+#endif
+  return WaitSelect(cmsWait, process_io);
+}
+
+bool PhysicalSocketServer::WaitSelect(int cmsWait, bool process_io) {
   // Calculate timing information
 
   struct timeval *ptvWait = NULL;
@@ -1308,54 +1713,24 @@ bool PhysicalSocketServer::Wait(int cmsWait, bool process_io) {
     } else {
       // We have signaled descriptors
       CritScope cr(&crit_);
+#if defined(WEBRTC_USE_IO_URING)
+      ScopedUdpSendBatch send_batch(this);
+#endif
       for (size_t i = 0; i < dispatchers_.size(); ++i) {
         Dispatcher *pdispatcher = dispatchers_[i];
         int fd = pdispatcher->GetDescriptor();
-        uint32_t ff = 0;
-        int errcode = 0;
-
-        // Reap any error code, which can be signaled through reads or writes.
-        // TODO(pthatcher): Should we set errcode if getsockopt fails?
-        if (FD_ISSET(fd, &fdsRead) || FD_ISSET(fd, &fdsWrite)) {
-          socklen_t len = sizeof(errcode);
-          ::getsockopt(fd, SOL_SOCKET, SO_ERROR, &errcode, &len);
-        }
 
-        // Check readable descriptors. If we're waiting on an accept, signal
-        // that. Otherwise we're waiting for data, check to see if we're
-        // readable or really closed.
-        // TODO(pthatcher): Only peek at TCP descriptors.
-        if (FD_ISSET(fd, &fdsRead)) {
+        bool readable = FD_ISSET(fd, &fdsRead);
+        if (readable) {
           FD_CLR(fd, &fdsRead);
-          if (pdispatcher->GetRequestedEvents() & DE_ACCEPT) {
-            ff |= DE_ACCEPT;
-          } else if (errcode || pdispatcher->IsDescriptorClosed()) {
-            ff |= DE_CLOSE;
-          } else {
-            ff |= DE_READ;
-          }
         }
 
-        // Check writable descriptors. If we're waiting on a connect, detect
-        // success versus failure by the reaped error code.
-        if (FD_ISSET(fd, &fdsWrite)) {
+        bool writable = FD_ISSET(fd, &fdsWrite);
+        if (writable) {
           FD_CLR(fd, &fdsWrite);
-          if (pdispatcher->GetRequestedEvents() & DE_CONNECT) {
-            if (!errcode) {
-              ff |= DE_CONNECT;
-            } else {
-              ff |= DE_CLOSE;
-            }
-          } else {
-            ff |= DE_WRITE;
-          }
         }
 
-        // Tell the descriptor about the event.
-        if (ff != 0) {
-          pdispatcher->OnPreEvent(ff);
-          pdispatcher->OnEvent(ff, errcode);
-        }
+        ProcessEvents(pdispatcher, readable, writable, readable || writable);
       }
     }
 
@@ -1383,6 +1758,225 @@ bool PhysicalSocketServer::Wait(int cmsWait, bool process_io) {
   return true;
 }
 
+#if defined(WEBRTC_USE_EPOLL)
+
+// Initial number of events to process with one call to "epoll_wait".
+static const size_t kInitialEpollEvents = 128;
+
+// Maximum number of events to process with one call to "epoll_wait".
+static const size_t kMaxEpollEvents = 8192;
+
+static uint32_t GetEpollEvents(uint32_t ff) {
+  uint32_t events = 0;
+  if (ff & (DE_READ | DE_ACCEPT)) {
+    events |= EPOLLIN;
+  }
+  if (ff & (DE_WRITE | DE_CONNECT)) {
+    events |= EPOLLOUT;
+  }
+  return events;
+}
+
+void PhysicalSocketServer::AddEpoll(Dispatcher* pdispatcher) {
+  RTC_DCHECK(epoll_registrations_.find(pdispatcher) ==
+             epoll_registrations_.end());
+  EpollRegistration& registration = epoll_registrations_[pdispatcher];
+  registration.key = next_epoll_key_++;
+  registration.events = 0;
+  epoll_dispatchers_[registration.key] = pdispatcher;
+  UpdateEpoll(pdispatcher);
+}
+
+void PhysicalSocketServer::RemoveEpoll(Dispatcher* pdispatcher) {
+  auto it = epoll_registrations_.find(pdispatcher);
+  if (it == epoll_registrations_.end()) {
+    return;
+  }
+  if (it->second.events != 0) {
+    // A non-null event is required by kernels before 2.6.9.
+    struct epoll_event event = {0};
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, pdispatcher->GetDescriptor(),
+                  &event) == -1) {
+      LOG_E(LS_ERROR, EN, errno) << "epoll_ctl EPOLL_CTL_DEL";
+    }
+  }
+  epoll_dispatchers_.erase(it->second.key);
+  epoll_registrations_.erase(it);
+}
+
+void PhysicalSocketServer::UpdateEpoll(Dispatcher* pdispatcher) {
+  auto it = epoll_registrations_.find(pdispatcher);
+  if (it == epoll_registrations_.end()) {
+    return;
+  }
+  EpollRegistration& registration = it->second;
+  const uint32_t events = GetEpollEvents(pdispatcher->GetRequestedEvents());
+  if (events == registration.events) {
+    return;
+  }
+  int op = EPOLL_CTL_MOD;
+  if (registration.events == 0) {
+    op = EPOLL_CTL_ADD;
+  } else if (events == 0) {
+    op = EPOLL_CTL_DEL;
+  }
+  struct epoll_event event = {0};
+  event.events = events;
+  event.data.u64 = registration.key;
+  if (epoll_ctl(epoll_fd_, op, pdispatcher->GetDescriptor(), &event) == -1) {
+    LOG_E(LS_ERROR, EN, errno) << "epoll_ctl " << op;
+    return;
+  }
+  registration.events = events;
+}
+
+bool PhysicalSocketServer::WaitEpoll(int cmsWait) {
+  RTC_DCHECK(epoll_fd_ != INVALID_SOCKET);
+  int64_t tvWait = -1;
+  int64_t tvStop = -1;
+  if (cmsWait != kForever) {
+    tvWait = cmsWait;
+    tvStop = TimeAfter(cmsWait);
+  }
+
+  if (epoll_events_.empty()) {
+    epoll_events_.resize(kInitialEpollEvents);
+  }
+
+  fWait_ = true;
+
+  while (fWait_) {
+    // Wait then call handlers as appropriate
+    // < 0 means error
+    // 0 means timeout
+    // > 0 means count of descriptors ready
+    int n = epoll_wait(epoll_fd_, &epoll_events_[0],
+                       static_cast<int>(epoll_events_.size()),
+                       static_cast<int>(tvWait));
+    if (n < 0) {
+      if (errno != EINTR) {
+        LOG_E(LS_ERROR, EN, errno) << "epoll_wait";
+        return false;
+      }
+      // Else ignore the error and keep going. If this EINTR was for one of the
+      // signals managed by this PhysicalSocketServer, the
+      // PosixSignalDeliveryDispatcher will be in the signaled state in the next
+      // iteration.
+    } else if (n == 0) {
+      // If timeout, return success
+      return true;
+    } else {
+      // We have signaled descriptors
+      CritScope cr(&crit_);
+#if defined(WEBRTC_USE_IO_URING)
+      ScopedUdpSendBatch send_batch(this);
+#endif
+      for (int i = 0; i < n; ++i) {
+        const epoll_event& event = epoll_events_[i];
+        auto it = epoll_dispatchers_.find(event.data.u64);
+        if (it == epoll_dispatchers_.end()) {
+          // The dispatcher was removed while the event was pending, possibly
+          // by the handler of an earlier event.
+          continue;
+        }
+        bool readable = (event.events & (EPOLLIN | EPOLLPRI)) != 0;
+        bool writable = (event.events & EPOLLOUT) != 0;
+        bool error = (event.events & (EPOLLERR | EPOLLHUP)) != 0;
+        // Errors and hangups are reported regardless of the requested events.
+        // Handle them like select() would for a readable descriptor, so that
+        // the close is detected instead of being reported over and over.
+        if (error && !readable && !writable) {
+          readable = true;
+        }
+        ProcessEvents(it->second, readable, writable, readable || writable);
+      }
+    }
+
+    if (static_cast<size_t>(n) == epoll_events_.size() &&
+        epoll_events_.size() < kMaxEpollEvents) {
+      // All the space for events was used, so make room for more events in
+      // the next iteration.
+      epoll_events_.resize(
+          std::min(epoll_events_.size() * 2, kMaxEpollEvents));
+    }
+
+    if (cmsWait != kForever) {
+      tvWait = TimeDiff(tvStop, TimeMillis());
+      if (tvWait < 0) {
+        // Return success on timeout.
+        return true;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool PhysicalSocketServer::WaitPoll(int cmsWait, Dispatcher* dispatcher) {
+  RTC_DCHECK(dispatcher);
+  int64_t tvWait = -1;
+  int64_t tvStop = -1;
+  if (cmsWait != kForever) {
+    tvWait = cmsWait;
+    tvStop = TimeAfter(cmsWait);
+  }
+
+  fWait_ = true;
+
+  struct pollfd fds = {0};
+  fds.fd = dispatcher->GetDescriptor();
+  while (fWait_) {
+    uint32_t ff = dispatcher->GetRequestedEvents();
+    fds.events = 0;
+    if (ff & (DE_READ | DE_ACCEPT)) {
+      fds.events |= POLLIN;
+    }
+    if (ff & (DE_WRITE | DE_CONNECT)) {
+      fds.events |= POLLOUT;
+    }
+    fds.revents = 0;
+
+    // Wait then call handlers as appropriate
+    // < 0 means error
+    // 0 means timeout
+    // > 0 means count of descriptors ready
+    int n = poll(&fds, 1, static_cast<int>(tvWait));
+    if (n < 0) {
+      if (errno != EINTR) {
+        LOG_E(LS_ERROR, EN, errno) << "poll";
+        return false;
+      }
+      // Else ignore the error and keep going. If this EINTR was for one of the
+      // signals managed by this PhysicalSocketServer, the
+      // PosixSignalDeliveryDispatcher will be in the signaled state in the next
+      // iteration.
+    } else if (n == 0) {
+      // If timeout, return success
+      return true;
+    } else {
+      // We have signaled descriptors (should only be the passed dispatcher).
+      RTC_DCHECK_EQ(n, 1);
+      RTC_DCHECK_EQ(fds.fd, dispatcher->GetDescriptor());
+      CritScope cr(&crit_);
+      bool readable = (fds.revents & (POLLIN | POLLPRI)) != 0;
+      bool writable = (fds.revents & POLLOUT) != 0;
+      ProcessEvents(dispatcher, readable, writable, readable || writable);
+    }
+
+    if (cmsWait != kForever) {
+      tvWait = TimeDiff(tvStop, TimeMillis());
+      if (tvWait < 0) {
+        // Return success on timeout.
+        return true;
+      }
+    }
+  }
+
+  return true;
+}
+
+#endif  // WEBRTC_USE_EPOLL
+
 static void GlobalSignalHandler(int signum) {
   PosixSignalHandler::Instance()->OnPosixSignalReceived(signum);
 }
@@ -11,9 +11,23 @@
 #ifndef WEBRTC_BASE_PHYSICALSOCKETSERVER_H__
 #define WEBRTC_BASE_PHYSICALSOCKETSERVER_H__
 
+#if defined(WEBRTC_POSIX) && defined(WEBRTC_LINUX)
+#include <sys/epoll.h>
+#define WEBRTC_USE_EPOLL 1
+#endif
+
+#if defined(WEBRTC_LINUX) && !defined(WEBRTC_ANDROID)
+#define WEBRTC_USE_MMSG 1
+#endif
+
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
+#if defined(WEBRTC_USE_IO_URING)
+#include "webrtc/base/io_uring_send_queue.h"
+#include "webrtc/base/platform_thread.h"
+#endif
 #include "webrtc/base/nethelpers.h"
 #include "webrtc/base/socketserver.h"
 #include "webrtc/base/criticalsection.h"
@@ -76,6 +90,36 @@ class PhysicalSocketServer : public SocketServer {
 
   void Add(Dispatcher* dispatcher);
   void Remove(Dispatcher* dispatcher);
+  // Must be called when the events requested by an added dispatcher have
+  // changed. Only needed by the epoll backend, a no-op otherwise.
+  void Update(Dispatcher* dispatcher);
+
+#if defined(WEBRTC_USE_IO_URING)
+  enum class UdpSendResult {
+    kQueued,
+    // The datagram is not queued and has to be sent directly. The queued
+    // sends have been submitted, so it doesn't overtake them.
+    kSendDirectly,
+    // A queued send on the socket failed because its buffer was full. The
+    // datagram is not sent, the caller reports EWOULDBLOCK.
+    kWouldBlock,
+  };
+  // While socket events are dispatched, UDP sends are queued and submitted
+  // together with a single io_uring_enter() call once the handlers have run.
+  // The datagram is not queued when called from outside a dispatch round or
+  // from another thread, or when it doesn't fit in the queue.
+  UdpSendResult QueueUdpSend(int fd,
+                             const void* data,
+                             size_t length,
+                             const sockaddr* addr,
+                             socklen_t addr_len);
+  // To be called before sending on |fd| without QueueUdpSend(). Returns
+  // kSendDirectly or kWouldBlock as above.
+  UdpSendResult PrepareDirectUdpSend(int fd);
+  // Submits the queued sends. Must be called before the socket |fd| is
+  // closed, since its descriptor could be reused otherwise.
+  void FlushUdpSends(int fd);
+#endif
 
 #if defined(WEBRTC_POSIX)
   // Sets the function to be executed in response to the specified POSIX signal.
@@ -99,9 +143,52 @@ class PhysicalSocketServer : public SocketServer {
   typedef std::vector<size_t*> IteratorList;
 
 #if defined(WEBRTC_POSIX)
+  bool WaitSelect(int cms, bool process_io);
   static bool InstallSignal(int signum, void (*handler)(int));
 
   std::unique_ptr<PosixSignalDispatcher> signal_dispatcher_;
+#endif
+#if defined(WEBRTC_USE_EPOLL)
+  // The epoll backend registers each dispatcher's descriptor once and only
+  // updates it when its requested events change, so a wakeup costs time
+  // proportional to the number of ready descriptors rather than to the
+  // number of dispatchers, and descriptors are not limited to FD_SETSIZE.
+  // If the epoll instance can't be created, select() is used instead.
+  struct EpollRegistration {
+    // Identifies the dispatcher in epoll events. Never reused, so events of
+    // a dispatcher removed while they were pending are detected and dropped.
+    uint64_t key;
+    // The epoll events currently registered with the kernel; the descriptor
+    // is only registered while this is non-zero, since errors and hangups
+    // are always reported and would otherwise wake up the wait repeatedly.
+    uint32_t events;
+  };
+
+  void AddEpoll(Dispatcher* dispatcher);
+  void RemoveEpoll(Dispatcher* dispatcher);
+  void UpdateEpoll(Dispatcher* dispatcher);
+  bool WaitEpoll(int cms);
+  // Waits for the wakeup signal only, used when I/O is not processed.
+  bool WaitPoll(int cms, Dispatcher* dispatcher);
+
+  int epoll_fd_;
+  std::vector<struct epoll_event> epoll_events_;
+  std::unordered_map<Dispatcher*, EpollRegistration> epoll_registrations_;
+  std::unordered_map<uint64_t, Dispatcher*> epoll_dispatchers_;
+  uint64_t next_epoll_key_ = 0;
+#endif
+#if defined(WEBRTC_USE_IO_URING)
+  class ScopedUdpSendBatch;
+
+  UdpSendResult FlushBeforeDirectSend(int fd)
+      EXCLUSIVE_LOCKS_REQUIRED(send_queue_crit_);
+
+  CriticalSection send_queue_crit_;
+  // Null if io_uring is not available.
+  std::unique_ptr<IoUringSendQueue> send_queue_;
+  // Set while the thread |send_batch_thread_| dispatches socket events.
+  bool send_batch_active_ = false;
+  PlatformThreadRef send_batch_thread_;
 #endif
   DispatcherList dispatchers_;
   IteratorList iterators_;
@@ -153,6 +240,12 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
 
   int EstimateMTU(uint16_t* mtu) override;
 
+#if defined(WEBRTC_USE_MMSG)
+  // UDP sockets read and write batches with recvmmsg() and sendmmsg().
+  int RecvFromBatch(ReceivedDatagram* datagrams, size_t count) override;
+  int SendToBatch(const OutgoingDatagram* datagrams, size_t count) override;
+#endif
+
   SocketServer* socketserver() { return ss_; }
 
  protected:
@@ -172,9 +265,19 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
 
   void UpdateLastError();
   void MaybeRemapSendError();
+#if defined(WEBRTC_USE_IO_URING)
+  // Fails a send with EWOULDBLOCK because a queued one on the socket did.
+  int ReportQueuedSendBlocked();
+#endif
 
   static int TranslateOption(Option opt, int* slevel, int* sopt);
 
+  // Changes the events the socket is waiting for. Overridden by
+  // SocketDispatcher to keep the socket server informed.
+  virtual void SetEnabledEvents(uint8_t events);
+  virtual void EnableEvents(uint8_t events);
+  virtual void DisableEvents(uint8_t events);
+
   PhysicalSocketServer* ss_;
   SOCKET s_;
   uint8_t enabled_events_;
@@ -183,6 +286,11 @@ class PhysicalSocket : public AsyncSocket, public sigslot::has_slots<> {
   int error_ GUARDED_BY(crit_);
   ConnState state_;
   AsyncResolver* resolver_;
+#if defined(WEBRTC_USE_MMSG)
+  // Batched reads take the receive time from SO_TIMESTAMP, which is only
+  // turned on once the first batch is read.
+  bool recv_timestamps_enabled_ = false;
+#endif
 
 #if !defined(NDEBUG)
   std::string dbg_addr_;
@@ -215,6 +323,23 @@ class SocketDispatcher : public Dispatcher, public PhysicalSocket {
 
   int Close() override;
 
+#if defined(WEBRTC_USE_EPOLL)
+ protected:
+  void SetEnabledEvents(uint8_t events) override;
+  void EnableEvents(uint8_t events) override;
+  void DisableEvents(uint8_t events) override;
+
+ private:
+  // While an event is dispatched, changes of the enabled events are
+  // collected and passed to the socket server once at the end. Handlers
+  // typically disable and re-enable the same event, which then costs no
+  // system call at all.
+  void StartBatchedEventUpdates();
+  void FinishBatchedEventUpdates();
+  void MaybeUpdateDispatcher(uint8_t old_events);
+
+  int saved_enabled_events_ = -1;
+#endif
 #if defined(WEBRTC_WIN)
  private:
   static int next_id_;
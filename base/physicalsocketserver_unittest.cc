@@ -8,16 +8,22 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <memory>
 #include <signal.h>
 #include <stdarg.h>
+#if defined(WEBRTC_POSIX)
+#include <sys/resource.h>
+#endif
 
 #include "webrtc/base/gunit.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/base/physicalsocketserver.h"
+#include "webrtc/base/random.h"
 #include "webrtc/base/socket_unittest.h"
 #include "webrtc/base/testutils.h"
 #include "webrtc/base/thread.h"
+#include "webrtc/base/timeutils.h"
 
 namespace rtc {
 
@@ -415,6 +421,133 @@ TEST_F(PhysicalSocketTest, TestSocketRecvTimestampIPv6) {
 }
 #endif
 
+// Owns a number of UDP sockets bound to the IPv4 loopback address and counts
+// the packets they receive.
+class UdpSocketPool : public sigslot::has_slots<> {
+ public:
+  explicit UdpSocketPool(PhysicalSocketServer* ss) : ss_(ss) {}
+
+  // Returns false if the socket couldn't be created, e.g. because the process
+  // ran out of file descriptors.
+  bool AddSocket() {
+    std::unique_ptr<AsyncSocket> socket(
+        ss_->CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+    if (!socket ||
+        socket->Bind(SocketAddress(IPAddress(INADDR_LOOPBACK), 0)) != 0) {
+      return false;
+    }
+    socket->SignalReadEvent.connect(this, &UdpSocketPool::OnReadEvent);
+    sockets_.push_back(std::move(socket));
+    return true;
+  }
+
+  AsyncSocket* socket(size_t index) { return sockets_[index].get(); }
+  size_t size() const { return sockets_.size(); }
+  int packets_received() const { return packets_received_; }
+
+ private:
+  void OnReadEvent(AsyncSocket* socket) {
+    char buffer[16];
+    SocketAddress address;
+    while (socket->RecvFrom(buffer, sizeof(buffer), &address, nullptr) >= 0) {
+      ++packets_received_;
+    }
+  }
+
+  PhysicalSocketServer* const ss_;
+  std::vector<std::unique_ptr<AsyncSocket>> sockets_;
+  int packets_received_ = 0;
+};
+
+// Returns how many more sockets this process may open, leaving some room for
+// descriptors used elsewhere.
+static size_t AvailableSocketCount() {
+  static const rlim_t kReservedDescriptors = 64;
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) != 0 ||
+      limit.rlim_cur <= kReservedDescriptors) {
+    return 0;
+  }
+  return static_cast<size_t>(limit.rlim_cur - kReservedDescriptors);
+}
+
+#if defined(WEBRTC_USE_EPOLL)
+// Unlike select(), epoll handles descriptors beyond FD_SETSIZE.
+TEST(PhysicalSocketServerTest, ReceivesOnDescriptorsBeyondFdSetSize) {
+  PhysicalSocketServer ss;
+  UdpSocketPool pool(&ss);
+  const size_t num_sockets =
+      std::min<size_t>(FD_SETSIZE + 100, AvailableSocketCount());
+  while (pool.size() < num_sockets && pool.AddSocket()) {
+  }
+  ASSERT_LE(2u, pool.size());
+
+  // Send from the first to the last socket, which has the highest descriptor.
+  AsyncSocket* receiver = pool.socket(pool.size() - 1);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(1, pool.socket(0)->SendTo("x", 1, receiver->GetLocalAddress()));
+  }
+  for (int i = 0; i < 10 && pool.packets_received() < 3; ++i) {
+    EXPECT_TRUE(ss.Wait(100, true));
+  }
+  EXPECT_EQ(3, pool.packets_received());
+}
+#endif
+
+#if defined(WEBRTC_LINUX)
+TEST(PhysicalSocketServerTest, ReusePortAllowsBindingSameAddress) {
+  PhysicalSocketServer ss;
+  std::unique_ptr<AsyncSocket> socket1(
+      ss.CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  std::unique_ptr<AsyncSocket> socket2(
+      ss.CreateAsyncSocket(AF_INET, SOCK_DGRAM));
+  ASSERT_EQ(0, socket1->SetOption(Socket::OPT_REUSEPORT, 1));
+  ASSERT_EQ(0, socket2->SetOption(Socket::OPT_REUSEPORT, 1));
+  int value = 0;
+  EXPECT_EQ(0, socket1->GetOption(Socket::OPT_REUSEPORT, &value));
+  EXPECT_EQ(1, value);
+
+  ASSERT_EQ(0, socket1->Bind(SocketAddress(IPAddress(INADDR_LOOPBACK), 0)));
+  EXPECT_EQ(0, socket2->Bind(socket1->GetLocalAddress()));
+  EXPECT_EQ(socket1->GetLocalAddress(), socket2->GetLocalAddress());
+}
+#endif
+
+// Measures how the time to dispatch a single ready socket scales with the
+// number of sockets owned by the socket server. Disabled since it only logs
+// the results and needs up to 10000 file descriptors.
+TEST(PhysicalSocketServerTest, DISABLED_SocketScalingBenchmark) {
+  static const int kIterations = 1000;
+  for (size_t num_sockets : {10, 100, 1000, 10000}) {
+    if (num_sockets + 1 > AvailableSocketCount()) {
+      LOG(LS_WARNING) << "Not enough file descriptors for " << num_sockets
+                      << " sockets, skipping.";
+      continue;
+    }
+    PhysicalSocketServer ss;
+    UdpSocketPool pool(&ss);
+    while (pool.size() < num_sockets + 1) {
+      ASSERT_TRUE(pool.AddSocket());
+    }
+    webrtc::Random random(42);
+    AsyncSocket* sender = pool.socket(num_sockets);
+    const int64_t start_us = TimeMicros();
+    for (int i = 0; i < kIterations; ++i) {
+      AsyncSocket* receiver =
+          pool.socket(random.Rand(static_cast<uint32_t>(num_sockets - 1)));
+      ASSERT_EQ(1, sender->SendTo("x", 1, receiver->GetLocalAddress()));
+      // Loopback packets are delivered synchronously, so a single
+      // non-blocking wait normally dispatches the packet.
+      while (pool.packets_received() <= i) {
+        ASSERT_TRUE(ss.Wait(0, true));
+      }
+    }
+    LOG(LS_INFO) << num_sockets << " sockets: "
+                 << (TimeMicros() - start_us) / kIterations
+                 << " us per received packet";
+  }
+}
+
 class PosixSignalDeliveryTest : public testing::Test {
  public:
   static void RecordSignal(int signum) {
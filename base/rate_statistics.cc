@@ -17,44 +17,54 @@
 namespace webrtc {
 
 RateStatistics::RateStatistics(int64_t window_size_ms, float scale)
-    : buckets_(new Bucket[window_size_ms]()),
+    : RateStatistics(window_size_ms, scale, 1) {}
+
+RateStatistics::RateStatistics(int64_t window_size_ms,
+                               float scale,
+                               int64_t bucket_size_ms)
+    : bucket_size_ms_(bucket_size_ms),
+      num_buckets_((window_size_ms + bucket_size_ms - 1) / bucket_size_ms),
+      buckets_(new Bucket[num_buckets_]()),
       accumulated_count_(0),
       num_samples_(0),
-      oldest_time_(-window_size_ms),
+      oldest_time_(-num_buckets_),
       oldest_index_(0),
       scale_(scale),
       max_window_size_ms_(window_size_ms),
-      current_window_size_ms_(max_window_size_ms_) {}
+      current_window_size_ms_(max_window_size_ms_) {
+  RTC_DCHECK_GT(bucket_size_ms, 0);
+}
 
 RateStatistics::~RateStatistics() {}
 
 void RateStatistics::Reset() {
   accumulated_count_ = 0;
   num_samples_ = 0;
-  oldest_time_ = -max_window_size_ms_;
+  oldest_time_ = -num_buckets_;
   oldest_index_ = 0;
   current_window_size_ms_ = max_window_size_ms_;
-  for (int64_t i = 0; i < max_window_size_ms_; i++)
+  for (int64_t i = 0; i < num_buckets_; i++)
     buckets_[i] = Bucket();
 }
 
 void RateStatistics::Update(size_t count, int64_t now_ms) {
-  if (now_ms < oldest_time_) {
+  int64_t now = BucketTime(now_ms);
+  if (now < oldest_time_) {
     // Too old data is ignored.
     return;
   }
 
-  EraseOld(now_ms);
+  EraseOld(now);
 
   // First ever sample, reset window to start now.
   if (!IsInitialized())
-    oldest_time_ = now_ms;
+    oldest_time_ = now;
 
-  uint32_t now_offset = static_cast<uint32_t>(now_ms - oldest_time_);
-  RTC_DCHECK_LT(now_offset, max_window_size_ms_);
+  uint32_t now_offset = static_cast<uint32_t>(now - oldest_time_);
+  RTC_DCHECK_LT(now_offset, num_buckets_);
   uint32_t index = oldest_index_ + now_offset;
-  if (index >= max_window_size_ms_)
-    index -= max_window_size_ms_;
+  if (index >= num_buckets_)
+    index -= num_buckets_;
   buckets_[index].sum += count;
   ++buckets_[index].samples;
   accumulated_count_ += count;
@@ -62,14 +72,16 @@ void RateStatistics::Update(size_t count, int64_t now_ms) {
 }
 
 rtc::Optional<uint32_t> RateStatistics::Rate(int64_t now_ms) const {
+  int64_t now = BucketTime(now_ms);
   // Yeah, this const_cast ain't pretty, but the alternative is to declare most
   // of the members as mutable...
-  const_cast<RateStatistics*>(this)->EraseOld(now_ms);
+  const_cast<RateStatistics*>(this)->EraseOld(now);
 
   // If window is a single bucket or there is only one sample in a data set that
   // has not grown to the full window size, treat this as rate unavailable.
-  int64_t active_window_size = now_ms - oldest_time_ + 1;
-  if (num_samples_ == 0 || active_window_size <= 1 ||
+  int64_t active_buckets = now - oldest_time_ + 1;
+  int64_t active_window_size = active_buckets * bucket_size_ms_;
+  if (num_samples_ == 0 || active_buckets <= 1 ||
       (num_samples_ <= 1 && active_window_size < current_window_size_ms_)) {
     return rtc::Optional<uint32_t>();
   }
@@ -79,12 +91,14 @@ rtc::Optional<uint32_t> RateStatistics::Rate(int64_t now_ms) const {
       static_cast<uint32_t>(accumulated_count_ * scale + 0.5f));
 }
 
-void RateStatistics::EraseOld(int64_t now_ms) {
+void RateStatistics::EraseOld(int64_t now) {
   if (!IsInitialized())
     return;
 
   // New oldest time that is included in data set.
-  int64_t new_oldest_time = now_ms - current_window_size_ms_ + 1;
+  int64_t current_window_buckets =
+      (current_window_size_ms_ + bucket_size_ms_ - 1) / bucket_size_ms_;
+  int64_t new_oldest_time = now - current_window_buckets + 1;
 
   // New oldest time is older than the current one, no need to cull data.
   if (new_oldest_time <= oldest_time_)
@@ -98,7 +112,7 @@ void RateStatistics::EraseOld(int64_t now_ms) {
     accumulated_count_ -= oldest_bucket.sum;
     num_samples_ -= oldest_bucket.samples;
     buckets_[oldest_index_] = Bucket();
-    if (++oldest_index_ >= max_window_size_ms_)
+    if (++oldest_index_ >= num_buckets_)
       oldest_index_ = 0;
     ++oldest_time_;
   }
@@ -110,12 +124,22 @@ bool RateStatistics::SetWindowSize(int64_t window_size_ms, int64_t now_ms) {
     return false;
 
   current_window_size_ms_ = window_size_ms;
-  EraseOld(now_ms);
+  EraseOld(BucketTime(now_ms));
   return true;
 }
 
 bool RateStatistics::IsInitialized() const {
-  return oldest_time_ != -max_window_size_ms_;
+  return oldest_time_ != -num_buckets_;
+}
+
+int64_t RateStatistics::BucketTime(int64_t time_ms) const {
+  if (bucket_size_ms_ == 1)
+    return time_ms;
+  // Rounds down, also for negative times.
+  int64_t bucket_time = time_ms / bucket_size_ms_;
+  if (time_ms % bucket_size_ms_ < 0)
+    --bucket_time;
+  return bucket_time;
 }
 
 }  // namespace webrtc
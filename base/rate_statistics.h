@@ -28,6 +28,13 @@ class RateStatistics {
   // scale = coefficient to convert counts/ms to desired unit
   //         ex: kBpsScale (8000) for bits/s if count represents bytes.
   RateStatistics(int64_t max_window_size_ms, float scale);
+  // Same as above, but counts are kept in buckets of |bucket_size_ms| rather
+  // than one per millisecond. Coarser buckets make the estimate less precise
+  // at the edges of the window, but updates and queries then walk
+  // |bucket_size_ms| times fewer buckets, and use that much less memory.
+  RateStatistics(int64_t max_window_size_ms,
+                 float scale,
+                 int64_t bucket_size_ms);
   ~RateStatistics();
 
   // Reset instance to original state.
@@ -49,11 +56,18 @@ class RateStatistics {
   bool SetWindowSize(int64_t window_size_ms, int64_t now_ms);
 
  private:
-  void EraseOld(int64_t now_ms);
+  // |now| is a bucket time, see BucketTime().
+  void EraseOld(int64_t now);
   bool IsInitialized() const;
+  // Converts a time in ms to the time of the bucket it falls in, which is in
+  // units of |bucket_size_ms_|.
+  int64_t BucketTime(int64_t time_ms) const;
+
+  const int64_t bucket_size_ms_;
+  const int64_t num_buckets_;
 
   // Counters are kept in buckets (circular buffer), with one bucket
-  // per millisecond.
+  // per |bucket_size_ms_|.
   struct Bucket {
     size_t sum;      // Sum of all samples in this bucket.
     size_t samples;  // Number of samples in this bucket.
@@ -66,7 +80,7 @@ class RateStatistics {
   // The total number of samples in the buckets.
   size_t num_samples_;
 
-  // Oldest time recorded in buckets.
+  // Oldest bucket time recorded in buckets.
   int64_t oldest_time_;
 
   // Bucket index of oldest counter recorded in buckets.
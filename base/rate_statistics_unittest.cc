@@ -277,4 +277,41 @@ TEST_F(RateStatisticsTest, HandlesQuietPeriods) {
   EXPECT_TRUE(static_cast<bool>(bitrate));
   EXPECT_EQ(0u, *bitrate);
 }
+
+TEST(RateStatisticsCoarseTest, MatchesSteadyRate) {
+  const int64_t kBucketSizeMs = 10;
+  RateStatistics stats(kWindowMs, 8000, kBucketSizeMs);
+  int64_t now_ms = 0;
+  EXPECT_FALSE(static_cast<bool>(stats.Rate(now_ms)));
+
+  // Samples within a single bucket are not enough for a valid estimate.
+  stats.Update(1000, now_ms);
+  stats.Update(1000, now_ms + kBucketSizeMs - 1);
+  EXPECT_FALSE(static_cast<bool>(stats.Rate(now_ms + kBucketSizeMs - 1)));
+
+  // 1000 bytes per millisecond, once the window is full.
+  for (now_ms = 1; now_ms < 3 * kWindowMs; ++now_ms) {
+    stats.Update(1000, now_ms);
+    if (now_ms >= kWindowMs) {
+      rtc::Optional<uint32_t> bitrate = stats.Rate(now_ms);
+      EXPECT_TRUE(static_cast<bool>(bitrate));
+      // Off by at most the part of the newest bucket still to come.
+      EXPECT_NEAR(8000000u, *bitrate, 8000000u * kBucketSizeMs / kWindowMs);
+    }
+  }
+
+  // Data falls out of the window in whole buckets.
+  now_ms += kWindowMs;
+  EXPECT_FALSE(static_cast<bool>(stats.Rate(now_ms)));
+}
+
+TEST(RateStatisticsCoarseTest, HandlesNegativeTimes) {
+  RateStatistics stats(kWindowMs, 8000, 10);
+  stats.Update(1000, -25);
+  stats.Update(1000, -5);
+  rtc::Optional<uint32_t> bitrate = stats.Rate(-5);
+  EXPECT_TRUE(static_cast<bool>(bitrate));
+  // Two samples over the three buckets [-30, 0).
+  EXPECT_EQ(2000u * 8000 / 30, *bitrate);
+}
 }  // namespace
@@ -33,7 +33,8 @@ enum {
 // Helper class for generating certificates asynchronously; a single task
 // instance is responsible for a single asynchronous certificate generation
 // request. We are using a separate helper class so that a generation request
-// can outlive the |RTCCertificateGenerator| that spawned it.
+// can outlive the |RTCCertificateGenerator| that spawned it. A task created
+// with a |certificate| only delivers it.
 class RTCCertificateGenerationTask : public RefCountInterface,
                                      public MessageHandler {
  public:
@@ -42,12 +43,14 @@ class RTCCertificateGenerationTask : public RefCountInterface,
       Thread* worker_thread,
       const KeyParams& key_params,
       const Optional<uint64_t>& expires_ms,
-      const scoped_refptr<RTCCertificateGeneratorCallback>& callback)
+      const scoped_refptr<RTCCertificateGeneratorCallback>& callback,
+      const scoped_refptr<RTCCertificate>& certificate)
       : signaling_thread_(signaling_thread),
         worker_thread_(worker_thread),
         key_params_(key_params),
         expires_ms_(expires_ms),
-        callback_(callback) {
+        callback_(callback),
+        certificate_(certificate) {
     RTC_DCHECK(signaling_thread_);
     RTC_DCHECK(worker_thread_);
     RTC_DCHECK(callback_);
@@ -132,8 +135,15 @@ RTCCertificateGenerator::GenerateCertificate(
 
 RTCCertificateGenerator::RTCCertificateGenerator(
     Thread* signaling_thread, Thread* worker_thread)
+    : RTCCertificateGenerator(signaling_thread, worker_thread, nullptr) {}
+
+RTCCertificateGenerator::RTCCertificateGenerator(
+    Thread* signaling_thread,
+    Thread* worker_thread,
+    const scoped_refptr<RTCCertificatePool>& pool)
     : signaling_thread_(signaling_thread),
-      worker_thread_(worker_thread) {
+      worker_thread_(worker_thread),
+      pool_(pool) {
   RTC_DCHECK(signaling_thread_);
   RTC_DCHECK(worker_thread_);
 }
@@ -145,6 +155,10 @@ void RTCCertificateGenerator::GenerateCertificateAsync(
   RTC_DCHECK(signaling_thread_->IsCurrent());
   RTC_DCHECK(callback);
 
+  scoped_refptr<RTCCertificate> pooled_certificate;
+  if (pool_ && !expires_ms)
+    pooled_certificate = pool_->Take(key_params);
+
   // Create a new |RTCCertificateGenerationTask| for this generation request. It
   // is reference counted and referenced by the message data, ensuring it lives
   // until the task has completed (independent of |RTCCertificateGenerator|).
@@ -152,7 +166,13 @@ void RTCCertificateGenerator::GenerateCertificateAsync(
       new ScopedRefMessageData<RTCCertificateGenerationTask>(
           new RefCountedObject<RTCCertificateGenerationTask>(
               signaling_thread_, worker_thread_, key_params, expires_ms,
-              callback));
+              callback, pooled_certificate));
+  if (pooled_certificate) {
+    // The callback is still invoked asynchronously, as callers expect.
+    signaling_thread_->Post(RTC_FROM_HERE, msg_data->data().get(),
+                            MSG_GENERATE_DONE, msg_data);
+    return;
+  }
   worker_thread_->Post(RTC_FROM_HERE, msg_data->data().get(), MSG_GENERATE,
                        msg_data);
 }
@@ -14,6 +14,7 @@
 #include "webrtc/base/optional.h"
 #include "webrtc/base/refcount.h"
 #include "webrtc/base/rtccertificate.h"
+#include "webrtc/base/rtccertificatepool.h"
 #include "webrtc/base/scoped_ref_ptr.h"
 #include "webrtc/base/sslidentity.h"
 #include "webrtc/base/thread.h"
@@ -64,6 +65,11 @@ class RTCCertificateGenerator : public RTCCertificateGeneratorInterface {
       const Optional<uint64_t>& expires_ms);
 
   RTCCertificateGenerator(Thread* signaling_thread, Thread* worker_thread);
+  // Hands out certificates from |pool| when it has one for the requested key
+  // parameters and no expiration time is specified, instead of generating one.
+  RTCCertificateGenerator(Thread* signaling_thread,
+                          Thread* worker_thread,
+                          const scoped_refptr<RTCCertificatePool>& pool);
   ~RTCCertificateGenerator() override {}
 
   // |RTCCertificateGeneratorInterface| overrides.
@@ -79,6 +85,7 @@ class RTCCertificateGenerator : public RTCCertificateGeneratorInterface {
  private:
   Thread* const signaling_thread_;
   Thread* const worker_thread_;
+  const scoped_refptr<RTCCertificatePool> pool_;
 };
 
 }  // namespace rtc
@@ -34,6 +34,7 @@ class RTCCertificateGeneratorFixture : public RTCCertificateGeneratorCallback {
   ~RTCCertificateGeneratorFixture() override {}
 
   RTCCertificateGenerator* generator() const { return generator_.get(); }
+  Thread* worker_thread() const { return worker_thread_.get(); }
   RTCCertificate* certificate() const { return certificate_.get(); }
 
   void OnSuccess(const scoped_refptr<RTCCertificate>& certificate) override {
@@ -106,6 +107,34 @@ TEST_F(RTCCertificateGeneratorTest, GenerateAsyncECDSA) {
   EXPECT_TRUE(fixture_->certificate());
 }
 
+TEST_F(RTCCertificateGeneratorTest, PoolFillsAndRefills) {
+  scoped_refptr<RTCCertificatePool> pool = RTCCertificatePool::Create(
+      fixture_->worker_thread(), KeyParams::ECDSA(), 2);
+  EXPECT_EQ_WAIT(2u, pool->available(), kGenerationTimeoutMs);
+  // The pool only holds certificates for its own key parameters.
+  EXPECT_FALSE(pool->Take(KeyParams::RSA()));
+  EXPECT_TRUE(pool->Take(KeyParams::ECDSA()));
+  EXPECT_TRUE(pool->Take(KeyParams::ECDSA()));
+  EXPECT_EQ_WAIT(2u, pool->available(), kGenerationTimeoutMs);
+}
+
+TEST_F(RTCCertificateGeneratorTest, GenerateAsyncTakesPooledCertificate) {
+  scoped_refptr<RTCCertificatePool> pool = RTCCertificatePool::Create(
+      fixture_->worker_thread(), KeyParams::ECDSA(), 1);
+  EXPECT_EQ_WAIT(1u, pool->available(), kGenerationTimeoutMs);
+  // Stop the worker, so that only the pooled certificate can be delivered.
+  fixture_->worker_thread()->Stop();
+  RTCCertificateGenerator generator(Thread::Current(),
+                                    fixture_->worker_thread(), pool);
+  generator.GenerateCertificateAsync(KeyParams::ECDSA(), Optional<uint64_t>(),
+                                     fixture_);
+  EXPECT_EQ(0u, pool->available());
+  // The callback is still asynchronous.
+  EXPECT_FALSE(fixture_->GenerateAsyncCompleted());
+  EXPECT_TRUE_WAIT(fixture_->GenerateAsyncCompleted(), kGenerationTimeoutMs);
+  EXPECT_TRUE(fixture_->certificate());
+}
+
 TEST_F(RTCCertificateGeneratorTest, GenerateWithExpires) {
   // By generating two certificates with different expiration we can compare the
   // two expiration times relative to each other without knowing the current
@@ -0,0 +1,132 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/rtccertificatepool.h"
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/logging.h"
+#include "webrtc/base/optional.h"
+#include "webrtc/base/rtccertificategenerator.h"
+#include "webrtc/base/timeutils.h"
+
+namespace rtc {
+
+namespace {
+
+enum {
+  MSG_GENERATE,
+};
+
+bool SameKeyParams(const KeyParams& a, const KeyParams& b) {
+  if (a.type() != b.type())
+    return false;
+  switch (a.type()) {
+    case KT_RSA:
+      return a.rsa_params().mod_size == b.rsa_params().mod_size &&
+             a.rsa_params().pub_exp == b.rsa_params().pub_exp;
+    case KT_ECDSA:
+      return a.ec_curve() == b.ec_curve();
+    default:
+      return true;
+  }
+}
+
+}  // namespace
+
+// static
+scoped_refptr<RTCCertificatePool> RTCCertificatePool::Create(
+    Thread* worker_thread,
+    const KeyParams& key_params,
+    size_t size) {
+  scoped_refptr<RTCCertificatePool> pool(
+      new RefCountedObject<RTCCertificatePool>(worker_thread, key_params,
+                                               size));
+  pool->Fill();
+  return pool;
+}
+
+RTCCertificatePool::RTCCertificatePool(Thread* worker_thread,
+                                       const KeyParams& key_params,
+                                       size_t size)
+    : worker_thread_(worker_thread),
+      key_params_(key_params),
+      size_(size),
+      generating_(false) {
+  RTC_DCHECK(worker_thread_);
+  RTC_DCHECK(key_params_.IsValid());
+}
+
+RTCCertificatePool::~RTCCertificatePool() {}
+
+scoped_refptr<RTCCertificate> RTCCertificatePool::Take(
+    const KeyParams& key_params) {
+  if (!SameKeyParams(key_params, key_params_))
+    return nullptr;
+  uint64_t now_ms =
+      static_cast<uint64_t>(TimeUTCMicros() / kNumMicrosecsPerMillisec);
+  CritScope cs(&crit_);
+  scoped_refptr<RTCCertificate> certificate;
+  while (!certificate && !certificates_.empty()) {
+    // Certificates that expired while waiting in the pool are dropped.
+    if (!certificates_.front()->HasExpired(now_ms))
+      certificate = certificates_.front();
+    certificates_.pop_front();
+  }
+  MaybeGenerate();
+  return certificate;
+}
+
+size_t RTCCertificatePool::available() const {
+  CritScope cs(&crit_);
+  return certificates_.size();
+}
+
+void RTCCertificatePool::Fill() {
+  CritScope cs(&crit_);
+  MaybeGenerate();
+}
+
+void RTCCertificatePool::OnMessage(Message* msg) {
+  RTC_DCHECK(worker_thread_->IsCurrent());
+  RTC_DCHECK_EQ(MSG_GENERATE, msg->message_id);
+  scoped_refptr<RTCCertificate> certificate =
+      RTCCertificateGenerator::GenerateCertificate(key_params_,
+                                                   Optional<uint64_t>());
+  {
+    CritScope cs(&crit_);
+    generating_ = false;
+    if (certificate) {
+      certificates_.push_back(certificate);
+      MaybeGenerate();
+    } else {
+      // Don't retry right away, the next Take will.
+      LOG(LS_WARNING) << "Failed to generate a pooled certificate.";
+    }
+  }
+  // Destroy |msg->pdata| which references |this| with ref counting. This may
+  // result in |this| being deleted - do not touch member variables after this
+  // line.
+  delete msg->pdata;
+}
+
+void RTCCertificatePool::MaybeGenerate() {
+  if (generating_ || certificates_.size() >= size_)
+    return;
+  // A stopped thread drops posted messages without deleting their data, which
+  // would leak the reference to the pool.
+  if (worker_thread_->IsQuitting())
+    return;
+  generating_ = true;
+  // The message data keeps the pool alive until the certificate is generated.
+  worker_thread_->Post(RTC_FROM_HERE, this, MSG_GENERATE,
+                       new ScopedRefMessageData<RTCCertificatePool>(this));
+}
+
+}  // namespace rtc
@@ -0,0 +1,75 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_BASE_RTCCERTIFICATEPOOL_H_
+#define WEBRTC_BASE_RTCCERTIFICATEPOOL_H_
+
+#include <deque>
+
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/messagehandler.h"
+#include "webrtc/base/refcount.h"
+#include "webrtc/base/rtccertificate.h"
+#include "webrtc/base/scoped_ref_ptr.h"
+#include "webrtc/base/sslidentity.h"
+#include "webrtc/base/thread.h"
+#include "webrtc/base/thread_annotations.h"
+
+namespace rtc {
+
+// Keeps up to |size| certificates generated ahead of time, so that a
+// certificate is available without waiting for key generation, which takes
+// hundreds of milliseconds for RSA keys. Certificates are generated one at a
+// time on the worker thread, which starts as soon as the pool is created, and
+// the pool is refilled whenever one is taken. Thread safe.
+class RTCCertificatePool : public RefCountInterface, public MessageHandler {
+ public:
+  static scoped_refptr<RTCCertificatePool> Create(Thread* worker_thread,
+                                                  const KeyParams& key_params,
+                                                  size_t size);
+
+  // Returns a certificate generated with |key_params| and the default
+  // expiration time, or null if there is none ready. The pool only holds
+  // certificates for the key parameters it was created with.
+  scoped_refptr<RTCCertificate> Take(const KeyParams& key_params);
+
+  const KeyParams& key_params() const { return key_params_; }
+  size_t size() const { return size_; }
+  // Number of certificates ready to be taken.
+  size_t available() const;
+
+ protected:
+  RTCCertificatePool(Thread* worker_thread,
+                     const KeyParams& key_params,
+                     size_t size);
+  ~RTCCertificatePool() override;
+
+ private:
+  // Starts filling the pool. Not done by the constructor, which can't take a
+  // reference to the object yet.
+  void Fill();
+  // Generates a certificate on the worker thread.
+  void OnMessage(Message* msg) override;
+  // Posts the generation of another certificate unless one is being generated
+  // already or the pool is full.
+  void MaybeGenerate() EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  Thread* const worker_thread_;
+  const KeyParams key_params_;
+  const size_t size_;
+
+  mutable CriticalSection crit_;
+  std::deque<scoped_refptr<RTCCertificate>> certificates_ GUARDED_BY(crit_);
+  bool generating_ GUARDED_BY(crit_);
+};
+
+}  // namespace rtc
+
+#endif  // WEBRTC_BASE_RTCCERTIFICATEPOOL_H_
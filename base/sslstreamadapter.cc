@@ -13,6 +13,7 @@
 
 #if SSL_USE_OPENSSL
 
+#include "webrtc/base/opensslsessioncache.h"
 #include "webrtc/base/opensslstreamadapter.h"
 
 #endif  // SSL_USE_OPENSSL
@@ -108,6 +109,14 @@ SSLStreamAdapter* SSLStreamAdapter::Create(StreamInterface* stream) {
 #endif  // SSL_USE_OPENSSL
 }
 
+std::unique_ptr<SSLSessionCache> SSLSessionCache::Create() {
+#if SSL_USE_OPENSSL
+  return std::unique_ptr<SSLSessionCache>(new OpenSSLSessionCache());
+#else  // !SSL_USE_OPENSSL
+  return nullptr;
+#endif  // SSL_USE_OPENSSL
+}
+
 SSLStreamAdapter::SSLStreamAdapter(StreamInterface* stream)
     : StreamAdapterInterface(stream),
       ignore_bad_cert_(false),
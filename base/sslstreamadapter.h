@@ -80,6 +80,11 @@ struct CryptoOptions {
   // Enable GCM crypto suites from RFC 7714 for SRTP. GCM will only be used
   // if both sides enable it.
   bool enable_gcm_crypto_suites = false;
+
+  // Number of threads that unprotect received SRTP packets, sharded by SSRC,
+  // instead of the network thread. Worth it on transports that bundle many
+  // streams, where SRTP is what saturates the network thread. 0 disables it.
+  int srtp_unprotect_threads = 0;
 };
 
 // SSLStreamAdapter : A StreamInterfaceAdapter that does SSL/TLS.
@@ -119,6 +124,18 @@ enum { SSE_MSG_TRUNC = 0xff0001 };
 // Used to send back UMA histogram value. Logged when Dtls handshake fails.
 enum class SSLHandshakeError { UNKNOWN, INCOMPATIBLE_CIPHERSUITE, MAX_VALUE };
 
+// Keeps (D)TLS sessions across stream adapters, so that a reconnect to the
+// same peer can resume the previous session instead of doing a full
+// handshake, saving a round trip and the public key operations. Sessions are
+// only resumed between the same pair of certificates.
+class SSLSessionCache {
+ public:
+  // Creates a cache for the selected implementation for the platform.
+  static std::unique_ptr<SSLSessionCache> Create();
+
+  virtual ~SSLSessionCache() {}
+};
+
 class SSLStreamAdapter : public StreamAdapterInterface {
  public:
   // Instantiate an SSLStreamAdapter wrapping the given stream,
@@ -174,6 +191,11 @@ class SSLStreamAdapter : public StreamAdapterInterface {
   // raised if negotiation fails.
   virtual int StartSSL() = 0;
 
+  // Resumes sessions from, and stores them in, |cache|, which must outlive
+  // the stream and must come from the same implementation. Must be called
+  // before StartSSL.
+  virtual void SetSessionCache(SSLSessionCache* cache) {}
+
   // Specify the digest of the certificate that our peer is expected to use.
   // Only this certificate will be accepted during SSL verification. The
   // certificate is assumed to have been obtained through some other secure
@@ -199,6 +221,10 @@ class SSLStreamAdapter : public StreamAdapterInterface {
 
   virtual int GetSslVersion() const = 0;
 
+  // Returns true if the handshake resumed a cached session rather than doing
+  // a full handshake.
+  virtual bool IsSessionResumed() const { return false; }
+
   // Key Exporter interface from RFC 5705
   // Arguments are:
   // label               -- the exporter label.
@@ -815,6 +815,30 @@ class SSLStreamAdapterTestDTLS
     }
   }
 
+  // Recreates the streams and adapters between the same identities, as a
+  // reconnect to the same peer would.
+  void Reconnect() {
+    rtc::SSLIdentity* client_identity = client_identity_->GetReference();
+    rtc::SSLIdentity* server_identity = server_identity_->GetReference();
+    client_ssl_.reset(nullptr);
+    server_ssl_.reset(nullptr);
+    // Drop the alerts sent while closing.
+    client_buffer_.Clear();
+    server_buffer_.Clear();
+
+    CreateStreams();
+    client_ssl_.reset(rtc::SSLStreamAdapter::Create(client_stream_));
+    server_ssl_.reset(rtc::SSLStreamAdapter::Create(server_stream_));
+    SSLStreamAdapterTestBase* base = this;
+    client_ssl_->SignalEvent.connect(base, &SSLStreamAdapterTestBase::OnEvent);
+    server_ssl_->SignalEvent.connect(base, &SSLStreamAdapterTestBase::OnEvent);
+    client_identity_ = client_identity;
+    server_identity_ = server_identity;
+    client_ssl_->SetIdentity(client_identity_);
+    server_ssl_->SetIdentity(server_identity_);
+    identities_set_ = false;
+  }
+
   void TestTransfer(int count) override {
     count_ = count;
 
@@ -1024,6 +1048,36 @@ TEST_P(SSLStreamAdapterTestDTLS, TestDTLSDelayedIdentityWithBogusDigest) {
 };
 
 // Test DTLS-SRTP with all high ciphers
+// Test that a reconnect resumes the session when both sides keep a session
+// cache.
+TEST_P(SSLStreamAdapterTestDTLS, TestDTLSSessionResumption) {
+  MAYBE_SKIP_TEST(HaveDtls);
+  std::unique_ptr<rtc::SSLSessionCache> client_cache =
+      rtc::SSLSessionCache::Create();
+  std::unique_ptr<rtc::SSLSessionCache> server_cache =
+      rtc::SSLSessionCache::Create();
+  client_ssl_->SetSessionCache(client_cache.get());
+  server_ssl_->SetSessionCache(server_cache.get());
+  TestHandshake();
+  EXPECT_FALSE(client_ssl_->IsSessionResumed());
+  EXPECT_FALSE(server_ssl_->IsSessionResumed());
+
+  Reconnect();
+  client_ssl_->SetSessionCache(client_cache.get());
+  server_ssl_->SetSessionCache(server_cache.get());
+  TestHandshake();
+  EXPECT_TRUE(client_ssl_->IsSessionResumed());
+  EXPECT_TRUE(server_ssl_->IsSessionResumed());
+  // The peer certificates come from the resumed session.
+  EXPECT_TRUE(GetPeerCertificate(true) != nullptr);
+  EXPECT_TRUE(GetPeerCertificate(false) != nullptr);
+  TestTransfer(10);
+
+  // The caches must outlive the adapters.
+  client_ssl_.reset(nullptr);
+  server_ssl_.reset(nullptr);
+}
+
 TEST_P(SSLStreamAdapterTestDTLS, TestDTLSSrtpHigh) {
   MAYBE_SKIP_TEST(HaveDtlsSrtp);
   std::vector<int> high;
@@ -21,6 +21,7 @@
 
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/criticalsection.h"
+#include "webrtc/base/mpsc_queue.h"
 
 #if defined(WEBRTC_WIN) || defined(WEBRTC_BUILD_LIBEVENT)
 #include "webrtc/base/platform_thread.h"
@@ -245,7 +246,8 @@ class LOCKABLE TaskQueue {
   std::unique_ptr<event> wakeup_event_;
   PlatformThread thread_;
   rtc::CriticalSection pending_lock_;
-  std::list<std::unique_ptr<QueuedTask>> pending_ GUARDED_BY(pending_lock_);
+  // Tasks posted from other threads.
+  MpscQueue<QueuedTask> pending_;
   std::list<PostAndReplyTask*> pending_replies_ GUARDED_BY(pending_lock_);
 #elif defined(WEBRTC_MAC)
   struct QueueContext;
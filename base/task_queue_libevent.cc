@@ -14,6 +14,8 @@
 #include <string.h>
 #include <unistd.h>
 
+#include <vector>
+
 #include "base/third_party/libevent/event.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
@@ -210,18 +212,15 @@ void TaskQueue::PostTask(std::unique_ptr<QueuedTask> task) {
       task.release();
     }
   } else {
-    QueuedTask* task_id = task.get();  // Only used for comparison.
-    {
-      CritScope lock(&pending_lock_);
-      pending_.push_back(std::move(task));
-    }
-    char message = kRunTask;
-    if (write(wakeup_pipe_in_, &message, sizeof(message)) != sizeof(message)) {
-      LOG(WARNING) << "Failed to queue task.";
-      CritScope lock(&pending_lock_);
-      pending_.remove_if([task_id](std::unique_ptr<QueuedTask>& t) {
-        return t.get() == task_id;
-      });
+    // Only the post that finds the queue empty wakes up the worker thread,
+    // which then runs everything posted before it gets to it. So there is at
+    // most one kRunTask message in the pipe.
+    if (pending_.Push(std::move(task))) {
+      char message = kRunTask;
+      if (write(wakeup_pipe_in_, &message, sizeof(message)) !=
+          sizeof(message)) {
+        LOG(WARNING) << "Failed to queue task.";
+      }
     }
   }
 }
@@ -286,16 +285,13 @@ void TaskQueue::OnWakeup(int socket, short flags, void* context) {  // NOLINT
       event_base_loopbreak(ctx->queue->event_base_);
       break;
     case kRunTask: {
-      std::unique_ptr<QueuedTask> task;
-      {
-        CritScope lock(&ctx->queue->pending_lock_);
-        RTC_DCHECK(!ctx->queue->pending_.empty());
-        task = std::move(ctx->queue->pending_.front());
-        ctx->queue->pending_.pop_front();
+      std::vector<std::unique_ptr<QueuedTask>> tasks;
+      ctx->queue->pending_.PopAll(&tasks);
+      for (std::unique_ptr<QueuedTask>& task : tasks) {
         RTC_DCHECK(task.get());
+        if (!task->Run())
+          task.release();
       }
-      if (!task->Run())
-        task.release();
       break;
     }
     default:
@@ -14,6 +14,7 @@
 #include "webrtc/base/bind.h"
 #include "webrtc/base/event.h"
 #include "webrtc/base/gunit.h"
+#include "webrtc/base/logging.h"
 #include "webrtc/base/task_queue.h"
 #include "webrtc/base/timeutils.h"
 
@@ -229,8 +230,9 @@ TEST(TaskQueueTest, PostAndReply2) {
   EXPECT_TRUE(event.Wait(1000));
 }
 
-// Tests posting more messages than a queue can queue up.
-// In situations like that, tasks will get dropped.
+// Tests posting more messages than the wakeup pipe of the libevent queue can
+// hold. Since only a post to an empty queue writes to the pipe, none of the
+// tasks are dropped.
 TEST(TaskQueueTest, PostALot) {
   // To destruct the event after the queue has gone out of scope.
   Event event(false, false);
@@ -244,8 +246,7 @@ TEST(TaskQueueTest, PostALot) {
     TaskQueue queue(kQueueName);
 
     // On linux, the limit of pending bytes in the pipe buffer is 0xffff.
-    // So here we post a total of 0xffff+1 messages, which triggers a failure
-    // case inside of the libevent queue implementation.
+    // So here we post a total of 0xffff+1 messages.
 
     queue.PostTask([&event]() { event.Wait(Event::kForever); });
     for (int i = 0; i < kTaskCount; ++i)
@@ -258,4 +259,36 @@ TEST(TaskQueueTest, PostALot) {
   EXPECT_EQ(kTaskCount, tasks_cleaned_up);
 }
 
+// Measures how many tasks per second can be posted to a queue from another
+// thread, and how long it takes until a posted task runs.
+TEST(TaskQueueTest, DISABLED_CrossThreadPostBenchmark) {
+  static const char kQueueName[] = "PostBenchmark";
+  TaskQueue queue(kQueueName);
+
+  static const int kNumTasks = 1000000;
+  int tasks_executed = 0;
+  Event done(false, false);
+  int64_t start_us = TimeMicros();
+  for (int i = 0; i < kNumTasks; ++i) {
+    queue.PostTask([&tasks_executed, &done]() {
+      if (++tasks_executed == kNumTasks)
+        done.Set();
+    });
+  }
+  EXPECT_TRUE(done.Wait(60000));
+  int64_t elapsed_us = TimeMicros() - start_us;
+  LOG(LS_INFO) << "Throughput: " << kNumTasks * 1000000LL / elapsed_us
+               << " tasks/s";
+
+  const int kNumRoundTrips = 10000;
+  start_us = TimeMicros();
+  for (int i = 0; i < kNumRoundTrips; ++i) {
+    queue.PostTask([&done]() { done.Set(); });
+    ASSERT_TRUE(done.Wait(1000));
+  }
+  LOG(LS_INFO) << "Latency: "
+               << (TimeMicros() - start_us) / kNumRoundTrips
+               << " us per post and wait";
+}
+
 }  // namespace rtc
@@ -35,6 +35,11 @@
 #endif
 
 namespace rtc {
+namespace {
+// Synchronous calls that block the caller for longer than this are logged,
+// with where they were made from.
+const int kSlowSendLoggingThresholdMs = 50;
+}  // namespace
 
 ThreadManager* ThreadManager::Instance() {
   RTC_DEFINE_STATIC_LOCAL(ThreadManager, thread_manager, ());
@@ -369,6 +374,8 @@ void Thread::Send(const Location& posted_from,
   Thread *current_thread = Thread::Current();
   RTC_DCHECK(current_thread != NULL);  // AutoThread ensures this
 
+  // The system time, as the caller may hold a ScopedCachedTime.
+  int64_t start_time = SystemTimeMillis();
   bool ready = false;
   {
     CritScope cs(&crit_);
@@ -409,6 +416,15 @@ void Thread::Send(const Location& posted_from,
   if (waited) {
     current_thread->socketserver()->WakeUp();
   }
+
+  // The caller was blocked for all of this, including the time the message
+  // spent queued behind other work on |this| thread.
+  int64_t blocked_ms = TimeDiff(SystemTimeMillis(), start_time);
+  if (blocked_ms >= kSlowSendLoggingThresholdMs) {
+    LOG(LS_INFO) << "Blocked for " << blocked_ms << "ms in a synchronous call"
+                 << " to thread " << name() << ". Sent from: "
+                 << posted_from.ToString();
+  }
 }
 
 void Thread::ReceiveSends() {
@@ -11,8 +11,11 @@
 #include <stdint.h>
 
 #if defined(WEBRTC_POSIX)
+#include <pthread.h>
+#include <sys/resource.h>
 #include <sys/time.h>
 #if defined(WEBRTC_MAC)
+#include <mach/mach.h>
 #include <mach/mach_time.h>
 #endif
 #endif
@@ -33,6 +36,52 @@ namespace rtc {
 
 ClockInterface* g_clock = nullptr;
 
+namespace {
+// Thread local slot holding the innermost ScopedCachedTime of each thread.
+#if defined(WEBRTC_WIN)
+DWORD g_cached_time_tls = 0;
+
+BOOL CALLBACK InitializeCachedTimeTls(PINIT_ONCE init_once,
+                                      void* param,
+                                      void** context) {
+  g_cached_time_tls = TlsAlloc();
+  return TRUE;
+}
+
+const ScopedCachedTime* GetCachedTime() {
+  static INIT_ONCE init_once = INIT_ONCE_STATIC_INIT;
+  InitOnceExecuteOnce(&init_once, InitializeCachedTimeTls, nullptr, nullptr);
+  return static_cast<const ScopedCachedTime*>(TlsGetValue(g_cached_time_tls));
+}
+
+void SetCachedTime(const ScopedCachedTime* cached_time) {
+  GetCachedTime();  // Makes sure the slot is allocated.
+  TlsSetValue(g_cached_time_tls, const_cast<ScopedCachedTime*>(cached_time));
+}
+#else
+pthread_key_t g_cached_time_tls = 0;
+
+void InitializeCachedTimeTls() {
+  RTC_CHECK(pthread_key_create(&g_cached_time_tls, nullptr) == 0);
+}
+
+pthread_key_t GetCachedTimeTls() {
+  static pthread_once_t init_once = PTHREAD_ONCE_INIT;
+  RTC_CHECK(pthread_once(&init_once, &InitializeCachedTimeTls) == 0);
+  return g_cached_time_tls;
+}
+
+const ScopedCachedTime* GetCachedTime() {
+  return static_cast<const ScopedCachedTime*>(
+      pthread_getspecific(GetCachedTimeTls()));
+}
+
+void SetCachedTime(const ScopedCachedTime* cached_time) {
+  pthread_setspecific(GetCachedTimeTls(), cached_time);
+}
+#endif
+}  // namespace
+
 ClockInterface* SetClockForTesting(ClockInterface* clock) {
   ClockInterface* prev = g_clock;
   g_clock = clock;
@@ -92,9 +141,21 @@ int64_t TimeNanos() {
   if (g_clock) {
     return g_clock->TimeNanos();
   }
+  const ScopedCachedTime* cached_time = GetCachedTime();
+  if (cached_time)
+    return cached_time->time_nanos();
   return SystemTimeNanos();
 }
 
+ScopedCachedTime::ScopedCachedTime()
+    : previous_(GetCachedTime()), time_nanos_(TimeNanos()) {
+  SetCachedTime(this);
+}
+
+ScopedCachedTime::~ScopedCachedTime() {
+  SetCachedTime(previous_);
+}
+
 uint32_t Time32() {
   return static_cast<uint32_t>(TimeNanos() / kNumNanosecsPerMillisec);
 }
@@ -203,4 +264,47 @@ int64_t TimeUTCMicros() {
 #endif
 }
 
+int64_t ThreadCpuTimeNanos() {
+#if defined(WEBRTC_LINUX) || defined(WEBRTC_ANDROID)
+  struct rusage usage;
+  if (getrusage(RUSAGE_THREAD, &usage) != 0)
+    return -1;
+  const int64_t seconds = static_cast<int64_t>(usage.ru_utime.tv_sec) +
+                          usage.ru_stime.tv_sec;
+  const int64_t micros = static_cast<int64_t>(usage.ru_utime.tv_usec) +
+                         usage.ru_stime.tv_usec;
+  return seconds * kNumNanosecsPerSec + micros * kNumNanosecsPerMicrosec;
+#elif defined(WEBRTC_MAC)
+  mach_port_t thread = mach_thread_self();
+  thread_basic_info_data_t info;
+  mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+  kern_return_t kr = thread_info(thread, THREAD_BASIC_INFO,
+                                 reinterpret_cast<thread_info_t>(&info),
+                                 &count);
+  mach_port_deallocate(mach_task_self(), thread);
+  if (kr != KERN_SUCCESS)
+    return -1;
+  const int64_t seconds = static_cast<int64_t>(info.user_time.seconds) +
+                          info.system_time.seconds;
+  const int64_t micros = static_cast<int64_t>(info.user_time.microseconds) +
+                         info.system_time.microseconds;
+  return seconds * kNumNanosecsPerSec + micros * kNumNanosecsPerMicrosec;
+#elif defined(WEBRTC_WIN)
+  FILETIME creation_time, exit_time, kernel_time, user_time;
+  if (!GetThreadTimes(GetCurrentThread(), &creation_time, &exit_time,
+                      &kernel_time, &user_time)) {
+    return -1;
+  }
+  // Both are in 100 nanosecond units.
+  ULARGE_INTEGER kernel, user;
+  kernel.LowPart = kernel_time.dwLowDateTime;
+  kernel.HighPart = kernel_time.dwHighDateTime;
+  user.LowPart = user_time.dwLowDateTime;
+  user.HighPart = user_time.dwHighDateTime;
+  return static_cast<int64_t>(kernel.QuadPart + user.QuadPart) * 100;
+#else
+  return -1;
+#endif
+}
+
 } // namespace rtc
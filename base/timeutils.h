@@ -74,6 +74,26 @@ int64_t TimeMicros();
 // Returns the current time in nanoseconds.
 int64_t TimeNanos();
 
+// While an instance is alive, TimeNanos() and the functions built on it
+// return the time the instance was created at on the creating thread, rather
+// than reading the system clock on every call. Use it around a short batch of
+// work that logically happens at one instant and reads the time many times,
+// such as the packets of one socket read. Nested instances keep the outermost
+// time. A clock set with SetClockForTesting() takes
+// precedence. Code that measures how long work takes, and may run within
+// such a batch, must use SystemTimeNanos() instead.
+class ScopedCachedTime {
+ public:
+  ScopedCachedTime();
+  ~ScopedCachedTime();
+
+  int64_t time_nanos() const { return time_nanos_; }
+
+ private:
+  const ScopedCachedTime* const previous_;
+  const int64_t time_nanos_;
+};
+
 
 // Returns a future timestamp, 'elapsed' milliseconds from now.
 int64_t TimeAfter(int64_t elapsed);
@@ -121,6 +141,12 @@ int64_t TmToSeconds(const std::tm& tm);
 // measuring time intervals and timeouts.
 int64_t TimeUTCMicros();
 
+// Returns the CPU time, user and system, consumed so far by the calling
+// thread, in nanoseconds. Unlike the wall-clock time functions above, this
+// doesn't advance while the thread is descheduled. Returns -1 on platforms
+// where it can't be measured.
+int64_t ThreadCpuTimeNanos();
+
 }  // namespace rtc
 
 #endif  // WEBRTC_BASE_TIMEUTILS_H_
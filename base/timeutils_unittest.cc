@@ -28,6 +28,27 @@ TEST(TimeTest, TimeInMs) {
   EXPECT_LT(ts_now, ts_earlier + 1000);
 }
 
+TEST(TimeTest, ThreadCpuTimeAdvancesWhenBusy) {
+  int64_t cpu_time_before = ThreadCpuTimeNanos();
+  if (cpu_time_before == -1)
+    return;  // Not supported on this platform.
+  // Spin for 50 ms of wall-clock time, most of which is spent on the CPU.
+  int64_t start_ms = TimeMillis();
+  volatile int counter = 0;
+  while (TimeMillis() - start_ms < 50)
+    ++counter;
+  EXPECT_GT(ThreadCpuTimeNanos(), cpu_time_before);
+}
+
+TEST(TimeTest, ThreadCpuTimeDoesNotAdvanceWhileSleeping) {
+  int64_t cpu_time_before = ThreadCpuTimeNanos();
+  if (cpu_time_before == -1)
+    return;  // Not supported on this platform.
+  Thread::SleepMs(100);
+  EXPECT_LT(ThreadCpuTimeNanos() - cpu_time_before,
+            50 * kNumNanosecsPerMillisec);
+}
+
 TEST(TimeTest, Intervals) {
   int64_t ts_earlier = TimeMillis();
   int64_t ts_later = TimeAfter(500);
@@ -51,6 +72,36 @@ TEST(TimeTest, Intervals) {
   EXPECT_LE(TimeUntil(ts_later), 500);
 }
 
+TEST(TimeTest, ScopedCachedTimeHoldsTime) {
+  int64_t cached_ns;
+  {
+    ScopedCachedTime cached_time;
+    cached_ns = TimeNanos();
+    Thread::SleepMs(2);
+    EXPECT_EQ(cached_ns, TimeNanos());
+    {
+      // Nested instances keep the outer time.
+      ScopedCachedTime nested_cached_time;
+      EXPECT_EQ(cached_ns, TimeNanos());
+    }
+    EXPECT_EQ(cached_ns, TimeNanos());
+
+    // Other threads still read the clock.
+    Thread other;
+    other.Start();
+    EXPECT_LT(cached_ns, other.Invoke<int64_t>(RTC_FROM_HERE, &TimeNanos));
+  }
+  EXPECT_LT(cached_ns, TimeNanos());
+}
+
+TEST(TimeTest, ScopedCachedTimeDefersToFakeClock) {
+  ScopedFakeClock fake_clock;
+  ScopedCachedTime cached_time;
+  int64_t now_ns = TimeNanos();
+  fake_clock.AdvanceTime(TimeDelta::FromMilliseconds(1));
+  EXPECT_EQ(now_ns + kNumNanosecsPerMillisec, TimeNanos());
+}
+
 TEST(TimeTest, TestTimeDiff64) {
   int64_t ts_diff = 100;
   int64_t ts_earlier = rtc::TimeMillis();
@@ -25,6 +25,7 @@
 #include "webrtc/typedefs.h"
 
 namespace webrtc {
+class AudioLevelSinkInterface;
 class AudioSinkInterface;
 
 // WORK IN PROGRESS
@@ -130,6 +131,12 @@ class AudioReceiveStream {
   // of feeding to the AEC.
   virtual void SetSink(std::unique_ptr<AudioSinkInterface> sink) = 0;
 
+  // Sets a sink that receives the audio level header extension of each
+  // received packet. Unlike SetSink(), this does not depend on the audio being
+  // decoded. The sink is not owned and must outlive the stream or be cleared
+  // by passing null.
+  virtual void SetAudioLevelSink(AudioLevelSinkInterface* sink) = 0;
+
   // Sets playback gain of the stream, applied when mixing, and thus after it
   // is potentially forwarded to any attached AudioSinkInterface implementation.
   virtual void SetGain(float gain) = 0;
@@ -12,7 +12,6 @@
 #include "webrtc/call/bitrate_allocator.h"
 
 #include <algorithm>
-#include <utility>
 
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
@@ -52,6 +51,7 @@ BitrateAllocator::BitrateAllocator(LimitObserver* limit_observer)
       last_non_zero_bitrate_bps_(kDefaultBitrateBps),
       last_fraction_loss_(0),
       last_rtt_(0),
+      last_probing_interval_ms_(0),
       num_pause_events_(0),
       clock_(Clock::GetRealTimeClock()),
       last_bwe_log_time_(0) {
@@ -84,8 +84,9 @@ void BitrateAllocator::OnNetworkChanged(uint32_t target_bitrate_bps,
 
   ObserverAllocation allocation = AllocateBitrates(target_bitrate_bps);
 
-  for (auto& config : bitrate_observer_configs_) {
-    uint32_t allocated_bitrate = allocation[config.observer];
+  for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+    ObserverConfig& config = bitrate_observer_configs_[i];
+    uint32_t allocated_bitrate = allocation[i];
     uint32_t protection_bitrate = config.observer->OnBitrateUpdated(
         allocated_bitrate, last_fraction_loss_, last_rtt_,
         last_probing_interval_ms_);
@@ -141,8 +142,9 @@ void BitrateAllocator::AddObserver(BitrateAllocatorObserver* observer,
   if (last_bitrate_bps_ > 0) {
     // Calculate a new allocation and update all observers.
     allocation = AllocateBitrates(last_bitrate_bps_);
-    for (auto& config : bitrate_observer_configs_) {
-      uint32_t allocated_bitrate = allocation[config.observer];
+    for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+      ObserverConfig& config = bitrate_observer_configs_[i];
+      uint32_t allocated_bitrate = allocation[i];
       uint32_t protection_bitrate = config.observer->OnBitrateUpdated(
           allocated_bitrate, last_fraction_loss_, last_rtt_,
           last_probing_interval_ms_);
@@ -251,38 +253,34 @@ BitrateAllocator::ObserverAllocation BitrateAllocator::AllocateBitrates(
 
 BitrateAllocator::ObserverAllocation BitrateAllocator::ZeroRateAllocation() {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
-  ObserverAllocation allocation;
-  for (const auto& observer_config : bitrate_observer_configs_)
-    allocation[observer_config.observer] = 0;
-  return allocation;
+  return ObserverAllocation(bitrate_observer_configs_.size(), 0);
 }
 
 BitrateAllocator::ObserverAllocation BitrateAllocator::LowRateAllocation(
     uint32_t bitrate) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
-  ObserverAllocation allocation;
+  ObserverAllocation allocation(bitrate_observer_configs_.size(), 0);
   // Start by allocating bitrate to observers enforcing a min bitrate, hence
   // remaining_bitrate might turn negative.
   int64_t remaining_bitrate = bitrate;
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    int32_t allocated_bitrate = 0;
+  for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+    const ObserverConfig& observer_config = bitrate_observer_configs_[i];
     if (observer_config.enforce_min_bitrate)
-      allocated_bitrate = observer_config.min_bitrate_bps;
-
-    allocation[observer_config.observer] = allocated_bitrate;
-    remaining_bitrate -= allocated_bitrate;
+      allocation[i] = observer_config.min_bitrate_bps;
+    remaining_bitrate -= allocation[i];
   }
 
   // Allocate bitrate to all previously active streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : bitrate_observer_configs_) {
+    for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+      const ObserverConfig& observer_config = bitrate_observer_configs_[i];
       if (observer_config.enforce_min_bitrate ||
           LastAllocatedBitrate(observer_config) == 0)
         continue;
 
       uint32_t required_bitrate = MinBitrateWithHysteresis(observer_config);
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        allocation[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
@@ -290,14 +288,15 @@ BitrateAllocator::ObserverAllocation BitrateAllocator::LowRateAllocation(
 
   // Allocate bitrate to previously paused streams.
   if (remaining_bitrate > 0) {
-    for (const auto& observer_config : bitrate_observer_configs_) {
+    for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+      const ObserverConfig& observer_config = bitrate_observer_configs_[i];
       if (LastAllocatedBitrate(observer_config) != 0)
         continue;
 
       // Add a hysteresis to avoid toggling.
       uint32_t required_bitrate = MinBitrateWithHysteresis(observer_config);
       if (remaining_bitrate >= required_bitrate) {
-        allocation[observer_config.observer] = required_bitrate;
+        allocation[i] = required_bitrate;
         remaining_bitrate -= required_bitrate;
       }
     }
@@ -316,8 +315,9 @@ BitrateAllocator::ObserverAllocation BitrateAllocator::NormalRateAllocation(
     uint32_t sum_min_bitrates) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
   ObserverAllocation allocation;
+  allocation.reserve(bitrate_observer_configs_.size());
   for (const auto& observer_config : bitrate_observer_configs_)
-    allocation[observer_config.observer] = observer_config.min_bitrate_bps;
+    allocation.push_back(observer_config.min_bitrate_bps);
 
   bitrate -= sum_min_bitrates;
   if (bitrate > 0)
@@ -331,9 +331,9 @@ BitrateAllocator::ObserverAllocation BitrateAllocator::MaxRateAllocation(
     uint32_t sum_max_bitrates) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
   ObserverAllocation allocation;
-
+  allocation.reserve(bitrate_observer_configs_.size());
   for (const auto& observer_config : bitrate_observer_configs_) {
-    allocation[observer_config.observer] = observer_config.max_bitrate_bps;
+    allocation.push_back(observer_config.max_bitrate_bps);
     bitrate -= observer_config.max_bitrate_bps;
   }
   DistributeBitrateEvenly(bitrate, true, kTransmissionMaxBitrateMultiplier,
@@ -377,31 +377,36 @@ void BitrateAllocator::DistributeBitrateEvenly(uint32_t bitrate,
   RTC_DCHECK_CALLED_SEQUENTIALLY(&sequenced_checker_);
   RTC_DCHECK_EQ(allocation->size(), bitrate_observer_configs_.size());
 
-  ObserverSortingMap list_max_bitrates;
-  for (const auto& observer_config : bitrate_observer_configs_) {
-    if (include_zero_allocations ||
-        allocation->at(observer_config.observer) != 0) {
-      list_max_bitrates.insert(std::pair<uint32_t, const ObserverConfig*>(
-          observer_config.max_bitrate_bps, &observer_config));
-    }
+  // Observers in increasing max bitrate order, keeping the insertion order
+  // for equal ones, so the ones with low max carry over their leftovers.
+  std::vector<size_t> by_max_bitrate;
+  by_max_bitrate.reserve(bitrate_observer_configs_.size());
+  for (size_t i = 0; i < bitrate_observer_configs_.size(); ++i) {
+    if (include_zero_allocations || (*allocation)[i] != 0)
+      by_max_bitrate.push_back(i);
   }
-  auto it = list_max_bitrates.begin();
-  while (it != list_max_bitrates.end()) {
+  std::stable_sort(by_max_bitrate.begin(), by_max_bitrate.end(),
+                   [this](size_t a, size_t b) {
+                     return bitrate_observer_configs_[a].max_bitrate_bps <
+                            bitrate_observer_configs_[b].max_bitrate_bps;
+                   });
+  for (size_t n = 0; n < by_max_bitrate.size(); ++n) {
     RTC_DCHECK_GT(bitrate, 0);
+    const size_t i = by_max_bitrate[n];
+    const uint32_t max_bitrate =
+        max_multiplier * bitrate_observer_configs_[i].max_bitrate_bps;
     uint32_t extra_allocation =
-        bitrate / static_cast<uint32_t>(list_max_bitrates.size());
-    uint32_t total_allocation =
-        extra_allocation + allocation->at(it->second->observer);
+        bitrate / static_cast<uint32_t>(by_max_bitrate.size() - n);
+    uint32_t total_allocation = extra_allocation + (*allocation)[i];
     bitrate -= extra_allocation;
-    if (total_allocation > max_multiplier * it->first) {
+    if (total_allocation > max_bitrate) {
       // There is more than we can fit for this observer, carry over to the
       // remaining observers.
-      bitrate += total_allocation - max_multiplier * it->first;
-      total_allocation = max_multiplier * it->first;
+      bitrate += total_allocation - max_bitrate;
+      total_allocation = max_bitrate;
     }
     // Finally, update the allocation for this observer.
-    allocation->at(it->second->observer) = total_allocation;
-    it = list_max_bitrates.erase(it);
+    (*allocation)[i] = total_allocation;
   }
 }
 
@@ -13,8 +13,6 @@
 
 #include <stdint.h>
 
-#include <map>
-#include <utility>
 #include <vector>
 
 #include "webrtc/base/sequenced_task_checker.h"
@@ -125,8 +123,8 @@ class BitrateAllocator {
   ObserverConfigs::iterator FindObserverConfig(
       const BitrateAllocatorObserver* observer);
 
-  typedef std::multimap<uint32_t, const ObserverConfig*> ObserverSortingMap;
-  typedef std::map<BitrateAllocatorObserver*, int> ObserverAllocation;
+  // Allocated bitrates, in the order of |bitrate_observer_configs_|.
+  typedef std::vector<uint32_t> ObserverAllocation;
 
   ObserverAllocation AllocateBitrates(uint32_t bitrate);
 
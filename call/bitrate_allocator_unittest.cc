@@ -521,4 +521,28 @@ TEST_F(BitrateAllocatorTest, PassProbingInterval) {
   allocator_->RemoveObserver(&observer);
 }
 
+TEST_F(BitrateAllocatorTest, ManyObserversCarryOverToHigherMax) {
+  const size_t kNumObservers = 40;
+  const uint32_t kMinBitrateBps = 10000;
+  const uint32_t kLowMaxBitrateBps = 50000;
+  const uint32_t kHighMaxBitrateBps = 500000;
+  std::vector<TestBitrateObserver> observers(kNumObservers);
+  for (size_t i = 0; i < kNumObservers; ++i) {
+    allocator_->AddObserver(&observers[i], kMinBitrateBps,
+                            i % 2 == 0 ? kLowMaxBitrateBps : kHighMaxBitrateBps,
+                            0, true);
+  }
+
+  // The observers with a low max are capped, the rest is split evenly on the
+  // others.
+  allocator_->OnNetworkChanged(5000000, 0, 0, kDefaultProbingIntervalMs);
+  for (size_t i = 0; i < kNumObservers; ++i) {
+    EXPECT_EQ(i % 2 == 0 ? kLowMaxBitrateBps : 200000u,
+              observers[i].last_bitrate_bps_);
+  }
+
+  for (auto& observer : observers)
+    allocator_->RemoveObserver(&observer);
+}
+
 }  // namespace webrtc
@@ -13,6 +13,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -25,6 +26,7 @@
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/base/optional.h"
+#include "webrtc/base/packet_trace.h"
 #include "webrtc/base/task_queue.h"
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/base/thread_checker.h"
@@ -32,24 +34,35 @@
 #include "webrtc/call/bitrate_allocator.h"
 #include "webrtc/call/call.h"
 #include "webrtc/call/flexfec_receive_stream_impl.h"
+#include "webrtc/call/rtcp_report_batcher.h"
+#include "webrtc/call/shared_congestion_controller_impl.h"
+#include "webrtc/call/shared_process_threads_impl.h"
+#include "webrtc/common_video/include/video_render_scheduler.h"
 #include "webrtc/config.h"
 #include "webrtc/logging/rtc_event_log/rtc_event_log.h"
 #include "webrtc/modules/bitrate_controller/include/bitrate_controller.h"
 #include "webrtc/modules/congestion_controller/include/congestion_controller.h"
 #include "webrtc/modules/pacing/paced_sender.h"
+#include "webrtc/modules/pacing/task_queue_pacer.h"
 #include "webrtc/modules/rtp_rtcp/include/flexfec_receiver.h"
+#include "webrtc/modules/rtp_rtcp/include/media_crypto_context.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_header_parser.h"
 #include "webrtc/modules/rtp_rtcp/source/byte_io.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/bye.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/sdes.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_header_extension.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_packet_received.h"
 #include "webrtc/modules/utility/include/process_thread.h"
 #include "webrtc/system_wrappers/include/clock.h"
 #include "webrtc/system_wrappers/include/cpu_info.h"
 #include "webrtc/system_wrappers/include/critical_section_wrapper.h"
+#include "webrtc/system_wrappers/include/field_trial.h"
 #include "webrtc/system_wrappers/include/metrics.h"
 #include "webrtc/system_wrappers/include/rw_lock_wrapper.h"
 #include "webrtc/system_wrappers/include/trace.h"
 #include "webrtc/video/call_stats.h"
+#include "webrtc/video/decode_thread_pool.h"
 #include "webrtc/video/send_delay_stats.h"
 #include "webrtc/video/stats_counter.h"
 #include "webrtc/video/video_receive_stream.h"
@@ -61,6 +74,42 @@ namespace webrtc {
 
 const int Call::Config::kDefaultStartBitrateBps = 300000;
 
+namespace {
+
+// How long RTCP reports of receive streams are held to be sent together, if
+// the WebRTC-BatchRtcpReports field trial is enabled.
+const int64_t kRtcpReportBatchMaxDelayMs = 20;
+
+// Gets the SSRCs that the packets of the compound RTCP packet |packet| are
+// sent from. Returns false if |packet| can't be parsed.
+bool GetRtcpSenderSsrcs(const uint8_t* packet,
+                        size_t length,
+                        std::vector<uint32_t>* ssrcs) {
+  const uint8_t* const packet_end = packet + length;
+  rtcp::CommonHeader header;
+  for (const uint8_t* next = packet; next != packet_end;
+       next = header.NextPacket()) {
+    if (!header.Parse(next, packet_end - next))
+      return false;
+    const uint8_t* const payload = header.payload();
+    const size_t payload_size = header.payload_size_bytes();
+    if (header.type() == rtcp::Sdes::kPacketType ||
+        header.type() == rtcp::Bye::kPacketType) {
+      // The SSRCs of SDES chunks and BYE packets are 32-bit aligned. Taking
+      // all the words of the payload saves parsing the SDES items, and the
+      // words that aren't SSRCs at worst deliver the packet to another stream.
+      for (size_t i = 0; i + 4 <= payload_size; i += 4)
+        ssrcs->push_back(ByteReader<uint32_t>::ReadBigEndian(payload + i));
+    } else if (payload_size >= 4) {
+      // All other packet types start with the SSRC of their sender.
+      ssrcs->push_back(ByteReader<uint32_t>::ReadBigEndian(payload));
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 namespace internal {
 
 class Call : public webrtc::Call,
@@ -169,11 +218,33 @@ class Call : public webrtc::Call,
   void UpdateHistograms();
   void UpdateAggregateNetworkState();
 
+  // Returns the context shared by all the streams using |key|, creating it on
+  // first use. Returns nullptr if |key| is not valid.
+  MediaCryptoContext* GetMediaCryptoContext(const MediaCryptoKey& key);
+
   Clock* const clock_;
 
   const int num_cpu_cores_;
-  const std::unique_ptr<ProcessThread> module_process_thread_;
-  const std::unique_ptr<ProcessThread> pacer_thread_;
+  // Null when Config::shared_process_threads is set.
+  const std::unique_ptr<ProcessThread> own_module_process_thread_;
+  const std::unique_ptr<ProcessThread> own_pacer_thread_;
+  // Either the own or the shared threads.
+  ProcessThread* const module_process_thread_;
+  ProcessThread* const pacer_thread_;
+  // Decodes the frames of all the video receive streams, instead of a thread
+  // per stream, if the WebRTC-SharedDecodeThreads field trial is enabled.
+  const std::unique_ptr<DecodeThreadPool> decode_thread_pool_;
+  // Releases the frames of all the video receive streams to their renderers,
+  // instead of a thread per stream, if the WebRTC-SharedRenderThread field
+  // trial is enabled.
+  const std::unique_ptr<VideoRenderScheduler> render_scheduler_;
+  // Batches the RTCP reports of the receive streams, if the
+  // WebRTC-BatchRtcpReports field trial is enabled.
+  const std::unique_ptr<RtcpReportBatcher> rtcp_report_batcher_;
+  // The transports that the receive streams were configured with, when
+  // |rtcp_report_batcher_| has replaced them.
+  std::map<webrtc::AudioReceiveStream*, Transport*> audio_rtcp_transports_;
+  std::map<webrtc::VideoReceiveStream*, Transport*> video_rtcp_transports_;
   const std::unique_ptr<CallStats> call_stats_;
   const std::unique_ptr<BitrateAllocator> bitrate_allocator_;
   Call::Config config_;
@@ -184,18 +255,20 @@ class Call : public webrtc::Call,
 
   std::unique_ptr<RWLockWrapper> receive_crit_;
   // Audio, Video, and FlexFEC receive streams are owned by the client that
-  // creates them.
-  std::map<uint32_t, AudioReceiveStream*> audio_receive_ssrcs_
+  // creates them. The SSRC maps are looked up for every received packet, hence
+  // hashed. The read lock held for the lookup also keeps the stream alive
+  // while the packet is delivered to it.
+  std::unordered_map<uint32_t, AudioReceiveStream*> audio_receive_ssrcs_
       GUARDED_BY(receive_crit_);
-  std::map<uint32_t, VideoReceiveStream*> video_receive_ssrcs_
+  std::unordered_map<uint32_t, VideoReceiveStream*> video_receive_ssrcs_
       GUARDED_BY(receive_crit_);
   std::set<VideoReceiveStream*> video_receive_streams_
       GUARDED_BY(receive_crit_);
   // Each media stream could conceivably be protected by multiple FlexFEC
   // streams.
-  std::multimap<uint32_t, FlexfecReceiveStreamImpl*>
+  std::unordered_multimap<uint32_t, FlexfecReceiveStreamImpl*>
       flexfec_receive_ssrcs_media_ GUARDED_BY(receive_crit_);
-  std::map<uint32_t, FlexfecReceiveStreamImpl*>
+  std::unordered_map<uint32_t, FlexfecReceiveStreamImpl*>
       flexfec_receive_ssrcs_protection_ GUARDED_BY(receive_crit_);
   std::set<FlexfecReceiveStreamImpl*> flexfec_receive_streams_
       GUARDED_BY(receive_crit_);
@@ -238,11 +311,28 @@ class Call : public webrtc::Call,
 
   std::map<std::string, rtc::NetworkRoute> network_routes_;
 
-  VieRemb remb_;
-  PacketRouter packet_router_;
+  // End to end media crypto contexts, keyed by crypto suite and key, so all
+  // the video streams of the call share one session per key. Only accessed on
+  // the configuration thread.
+  std::map<std::pair<int, std::vector<uint8_t>>,
+           std::unique_ptr<MediaCryptoContext>>
+      media_crypto_contexts_;
+
+  // Set when the congestion controller is shared with other calls, in which
+  // case |own_congestion_controller_| is not created.
+  const rtc::scoped_refptr<SharedCongestionControllerImpl>
+      shared_congestion_controller_;
+  VieRemb own_remb_;
+  PacketRouter own_packet_router_;
   // TODO(nisse): Could be a direct member, except for constness
   // issues with GetRemoteBitrateEstimator (and maybe others).
-  const std::unique_ptr<CongestionController> congestion_controller_;
+  const std::unique_ptr<CongestionController> own_congestion_controller_;
+  // Either the own or the shared instances.
+  VieRemb* const remb_;
+  PacketRouter* const packet_router_;
+  CongestionController* const congestion_controller_;
+  // Drives the pacer instead of |pacer_thread_| with high resolution pacing.
+  std::unique_ptr<TaskQueuePacer> task_queue_pacer_;
   const std::unique_ptr<SendDelayStats> video_send_delay_stats_;
   const int64_t start_ms_;
   // TODO(perkj): |worker_queue_| is supposed to replace
@@ -276,8 +366,36 @@ namespace internal {
 Call::Call(const Call::Config& config)
     : clock_(Clock::GetRealTimeClock()),
       num_cpu_cores_(CpuInfo::DetectNumberOfCores()),
-      module_process_thread_(ProcessThread::Create("ModuleProcessThread")),
-      pacer_thread_(ProcessThread::Create("PacerThread")),
+      own_module_process_thread_(
+          config.shared_process_threads
+              ? nullptr
+              : ProcessThread::Create("ModuleProcessThread")),
+      own_pacer_thread_(config.shared_process_threads
+                            ? nullptr
+                            : ProcessThread::Create("PacerThread")),
+      module_process_thread_(
+          config.shared_process_threads
+              ? static_cast<SharedProcessThreadsImpl*>(
+                    config.shared_process_threads.get())
+                    ->module_process_thread()
+              : own_module_process_thread_.get()),
+      pacer_thread_(config.shared_process_threads
+                        ? static_cast<SharedProcessThreadsImpl*>(
+                              config.shared_process_threads.get())
+                              ->pacer_thread()
+                        : own_pacer_thread_.get()),
+      decode_thread_pool_(
+          field_trial::FindFullName("WebRTC-SharedDecodeThreads") == "Enabled"
+              ? new DecodeThreadPool(clock_, num_cpu_cores_)
+              : nullptr),
+      render_scheduler_(
+          field_trial::FindFullName("WebRTC-SharedRenderThread") == "Enabled"
+              ? new VideoRenderScheduler()
+              : nullptr),
+      rtcp_report_batcher_(
+          field_trial::FindFullName("WebRTC-BatchRtcpReports") == "Enabled"
+              ? new RtcpReportBatcher(clock_, kRtcpReportBatchMaxDelayMs)
+              : nullptr),
       call_stats_(new CallStats(clock_)),
       bitrate_allocator_(new BitrateAllocator(this)),
       config_(config),
@@ -295,12 +413,33 @@ Call::Call(const Call::Config& config)
       configured_max_padding_bitrate_bps_(0),
       estimated_send_bitrate_kbps_counter_(clock_, nullptr, true),
       pacer_bitrate_kbps_counter_(clock_, nullptr, true),
-      remb_(clock_),
-      congestion_controller_(new CongestionController(clock_,
-                                                      this,
-                                                      &remb_,
-                                                      event_log_,
-                                                      &packet_router_)),
+      shared_congestion_controller_(
+          static_cast<SharedCongestionControllerImpl*>(
+              config.shared_congestion_controller.get())),
+      own_remb_(clock_),
+      own_congestion_controller_(
+          shared_congestion_controller_
+              ? nullptr
+              : new CongestionController(
+                    clock_,
+                    this,
+                    &own_remb_,
+                    event_log_,
+                    &own_packet_router_,
+                    std::unique_ptr<PacedSender>(
+                        new PacedSender(clock_,
+                                        &own_packet_router_,
+                                        config.high_resolution_pacing)))),
+      remb_(shared_congestion_controller_
+                ? shared_congestion_controller_->remb()
+                : &own_remb_),
+      packet_router_(shared_congestion_controller_
+                         ? shared_congestion_controller_->packet_router()
+                         : &own_packet_router_),
+      congestion_controller_(
+          shared_congestion_controller_
+              ? shared_congestion_controller_->congestion_controller()
+              : own_congestion_controller_.get()),
       video_send_delay_stats_(new SendDelayStats(clock_)),
       start_ms_(clock_->TimeInMilliseconds()),
       worker_queue_("call_worker_queue") {
@@ -314,7 +453,22 @@ Call::Call(const Call::Config& config)
                   config.bitrate_config.start_bitrate_bps);
   }
   Trace::CreateTrace();
-  call_stats_->RegisterStatsObserver(congestion_controller_.get());
+  call_stats_->RegisterStatsObserver(congestion_controller_);
+
+  // Shared threads are already running.
+  if (own_module_process_thread_)
+    own_module_process_thread_->Start();
+  module_process_thread_->RegisterModule(call_stats_.get());
+  if (rtcp_report_batcher_)
+    module_process_thread_->RegisterModule(rtcp_report_batcher_.get());
+  if (shared_congestion_controller_) {
+    // The shared controller runs its modules on its own threads.
+    shared_congestion_controller_->AddMember(
+        this, config_.bitrate_config.min_bitrate_bps,
+        config_.bitrate_config.start_bitrate_bps,
+        config_.bitrate_config.max_bitrate_bps);
+    return;
+  }
 
   congestion_controller_->SignalNetworkState(kNetworkDown);
   congestion_controller_->SetBweBitrates(
@@ -322,17 +476,22 @@ Call::Call(const Call::Config& config)
       config_.bitrate_config.start_bitrate_bps,
       config_.bitrate_config.max_bitrate_bps);
 
-  module_process_thread_->Start();
-  module_process_thread_->RegisterModule(call_stats_.get());
-  module_process_thread_->RegisterModule(congestion_controller_.get());
-  pacer_thread_->RegisterModule(congestion_controller_->pacer());
+  module_process_thread_->RegisterModule(congestion_controller_);
+  if (config.high_resolution_pacing) {
+    task_queue_pacer_.reset(
+        new TaskQueuePacer(congestion_controller_->pacer()));
+    task_queue_pacer_->Start();
+  } else {
+    pacer_thread_->RegisterModule(congestion_controller_->pacer());
+  }
   pacer_thread_->RegisterModule(
       congestion_controller_->GetRemoteBitrateEstimator(true));
-  pacer_thread_->Start();
+  if (own_pacer_thread_)
+    own_pacer_thread_->Start();
 }
 
 Call::~Call() {
-  RTC_DCHECK(!remb_.InUse());
+  RTC_DCHECK(!own_remb_.InUse());
   RTC_DCHECK(configuration_thread_checker_.CalledOnValidThread());
 
   RTC_CHECK(audio_send_ssrcs_.empty());
@@ -342,14 +501,25 @@ Call::~Call() {
   RTC_CHECK(video_receive_ssrcs_.empty());
   RTC_CHECK(video_receive_streams_.empty());
 
-  pacer_thread_->Stop();
-  pacer_thread_->DeRegisterModule(congestion_controller_->pacer());
-  pacer_thread_->DeRegisterModule(
-      congestion_controller_->GetRemoteBitrateEstimator(true));
-  module_process_thread_->DeRegisterModule(congestion_controller_.get());
+  if (own_pacer_thread_)
+    own_pacer_thread_->Stop();
+  if (shared_congestion_controller_) {
+    shared_congestion_controller_->RemoveMember(this);
+  } else {
+    if (task_queue_pacer_)
+      task_queue_pacer_->Stop();
+    else
+      pacer_thread_->DeRegisterModule(congestion_controller_->pacer());
+    pacer_thread_->DeRegisterModule(
+        congestion_controller_->GetRemoteBitrateEstimator(true));
+    module_process_thread_->DeRegisterModule(congestion_controller_);
+  }
   module_process_thread_->DeRegisterModule(call_stats_.get());
-  module_process_thread_->Stop();
-  call_stats_->DeregisterStatsObserver(congestion_controller_.get());
+  if (rtcp_report_batcher_)
+    module_process_thread_->DeRegisterModule(rtcp_report_batcher_.get());
+  if (own_module_process_thread_)
+    own_module_process_thread_->Stop();
+  call_stats_->DeregisterStatsObserver(congestion_controller_);
 
   // Only update histograms after process threads have been shut down, so that
   // they won't try to concurrently update stats.
@@ -467,8 +637,8 @@ webrtc::AudioSendStream* Call::CreateAudioSendStream(
   RTC_DCHECK(configuration_thread_checker_.CalledOnValidThread());
   event_log_->LogAudioSendStreamConfig(config);
   AudioSendStream* send_stream = new AudioSendStream(
-      config, config_.audio_state, &worker_queue_, &packet_router_,
-      congestion_controller_.get(), bitrate_allocator_.get(), event_log_,
+      config, config_.audio_state, &worker_queue_, packet_router_,
+      congestion_controller_, bitrate_allocator_.get(), event_log_,
       call_stats_->rtcp_rtt_stats());
   {
     WriteLockScoped write_lock(*send_crit_);
@@ -521,11 +691,18 @@ webrtc::AudioReceiveStream* Call::CreateAudioReceiveStream(
   TRACE_EVENT0("webrtc", "Call::CreateAudioReceiveStream");
   RTC_DCHECK(configuration_thread_checker_.CalledOnValidThread());
   event_log_->LogAudioReceiveStreamConfig(config);
+  webrtc::AudioReceiveStream::Config stream_config = config;
+  if (rtcp_report_batcher_ && config.rtcp_send_transport) {
+    stream_config.rtcp_send_transport =
+        rtcp_report_batcher_->GetTransport(config.rtcp_send_transport);
+  }
   AudioReceiveStream* receive_stream = new AudioReceiveStream(
-      &packet_router_,
+      packet_router_,
       // TODO(nisse): Used only when UseSendSideBwe(config) is true.
-      congestion_controller_->GetRemoteBitrateEstimator(true), config,
+      congestion_controller_->GetRemoteBitrateEstimator(true), stream_config,
       config_.audio_state, event_log_);
+  if (stream_config.rtcp_send_transport != config.rtcp_send_transport)
+    audio_rtcp_transports_[receive_stream] = config.rtcp_send_transport;
   {
     WriteLockScoped write_lock(*receive_crit_);
     RTC_DCHECK(audio_receive_ssrcs_.find(config.rtp.remote_ssrc) ==
@@ -566,7 +743,16 @@ void Call::DestroyAudioReceiveStream(
     }
   }
   UpdateAggregateNetworkState();
+  auto it = audio_rtcp_transports_.find(receive_stream);
+  Transport* rtcp_transport = nullptr;
+  if (it != audio_rtcp_transports_.end()) {
+    rtcp_transport = it->second;
+    audio_rtcp_transports_.erase(it);
+  }
   delete audio_receive_stream;
+  // Released once the stream can't send anymore.
+  if (rtcp_transport)
+    rtcp_report_batcher_->ReleaseTransport(rtcp_transport);
 }
 
 webrtc::VideoSendStream* Call::CreateVideoSendStream(
@@ -582,12 +768,16 @@ webrtc::VideoSendStream* Call::CreateVideoSendStream(
   // the call has already started.
   // Copy ssrcs from |config| since |config| is moved.
   std::vector<uint32_t> ssrcs = config.rtp.ssrcs;
+  MediaCryptoContext* media_crypto_context =
+      config.media_crypto_enabled
+          ? GetMediaCryptoContext(config.media_crypto_key)
+          : nullptr;
   VideoSendStream* send_stream = new VideoSendStream(
-      num_cpu_cores_, module_process_thread_.get(), &worker_queue_,
-      call_stats_.get(), congestion_controller_.get(), &packet_router_,
-      bitrate_allocator_.get(), video_send_delay_stats_.get(), &remb_,
-      event_log_, std::move(config), std::move(encoder_config),
-      suspended_video_send_ssrcs_);
+      num_cpu_cores_, clock_, module_process_thread_, &worker_queue_,
+      call_stats_.get(), congestion_controller_, packet_router_,
+      bitrate_allocator_.get(), video_send_delay_stats_.get(), remb_,
+      event_log_, media_crypto_context, std::move(config),
+      std::move(encoder_config), suspended_video_send_ssrcs_);
 
   {
     WriteLockScoped write_lock(*send_crit_);
@@ -642,10 +832,28 @@ webrtc::VideoReceiveStream* Call::CreateVideoReceiveStream(
     webrtc::VideoReceiveStream::Config configuration) {
   TRACE_EVENT0("webrtc", "Call::CreateVideoReceiveStream");
   RTC_DCHECK(configuration_thread_checker_.CalledOnValidThread());
+  MediaCryptoContext* media_crypto_context =
+      configuration.media_crypto_enabled
+          ? GetMediaCryptoContext(configuration.media_crypto_key)
+          : nullptr;
+  if (media_crypto_context) {
+    // Retransmissions arrive up to the NACK history late.
+    media_crypto_context->SetMinReplayWindowSize(
+        MediaCryptoContext::ReplayWindowSizeForHistory(
+            configuration.rtp.nack.rtp_history_ms));
+  }
+  Transport* rtcp_transport = configuration.rtcp_send_transport;
+  if (rtcp_report_batcher_ && rtcp_transport) {
+    configuration.rtcp_send_transport =
+        rtcp_report_batcher_->GetTransport(rtcp_transport);
+  }
   VideoReceiveStream* receive_stream = new VideoReceiveStream(
-      num_cpu_cores_, congestion_controller_.get(), &packet_router_,
-      std::move(configuration), voice_engine(), module_process_thread_.get(),
-      call_stats_.get(), &remb_);
+      num_cpu_cores_, congestion_controller_, packet_router_,
+      std::move(configuration), voice_engine(), module_process_thread_,
+      call_stats_.get(), remb_, media_crypto_context,
+      decode_thread_pool_.get(), render_scheduler_.get());
+  if (receive_stream->config().rtcp_send_transport != rtcp_transport)
+    video_rtcp_transports_[receive_stream] = rtcp_transport;
 
   const webrtc::VideoReceiveStream::Config& config = receive_stream->config();
   {
@@ -693,7 +901,16 @@ void Call::DestroyVideoReceiveStream(
     ConfigureSync(receive_stream_impl->config().sync_group);
   }
   UpdateAggregateNetworkState();
+  auto it = video_rtcp_transports_.find(receive_stream);
+  Transport* rtcp_transport = nullptr;
+  if (it != video_rtcp_transports_.end()) {
+    rtcp_transport = it->second;
+    video_rtcp_transports_.erase(it);
+  }
   delete receive_stream_impl;
+  // Released once the stream can't send anymore.
+  if (rtcp_transport)
+    rtcp_report_batcher_->ReleaseTransport(rtcp_transport);
 }
 
 FlexfecReceiveStream* Call::CreateFlexfecReceiveStream(
@@ -704,7 +921,7 @@ FlexfecReceiveStream* Call::CreateFlexfecReceiveStream(
   RecoveredPacketReceiver* recovered_packet_receiver = this;
   FlexfecReceiveStreamImpl* receive_stream = new FlexfecReceiveStreamImpl(
       config, recovered_packet_receiver, call_stats_->rtcp_rtt_stats(),
-      module_process_thread_.get());
+      module_process_thread_);
 
   {
     WriteLockScoped write_lock(*receive_crit_);
@@ -816,6 +1033,12 @@ void Call::SetBitrateConfig(
   if (bitrate_config.start_bitrate_bps > 0)
     config_.bitrate_config.start_bitrate_bps = bitrate_config.start_bitrate_bps;
   config_.bitrate_config.max_bitrate_bps = bitrate_config.max_bitrate_bps;
+  if (shared_congestion_controller_) {
+    shared_congestion_controller_->SetBweBitrates(
+        this, bitrate_config.min_bitrate_bps, bitrate_config.start_bitrate_bps,
+        bitrate_config.max_bitrate_bps);
+    return;
+  }
   congestion_controller_->SetBweBitrates(bitrate_config.min_bitrate_bps,
                                          bitrate_config.start_bitrate_bps,
                                          bitrate_config.max_bitrate_bps);
@@ -912,6 +1135,10 @@ void Call::OnNetworkRouteChanged(const std::string& transport_name,
                  << " bps, start: " << config_.bitrate_config.start_bitrate_bps
                  << " bps,  max: " << config_.bitrate_config.start_bitrate_bps
                  << " bps.";
+    if (shared_congestion_controller_) {
+      shared_congestion_controller_->ResetBweAndBitrates(this);
+      return;
+    }
     congestion_controller_->ResetBweAndBitrates(
         config_.bitrate_config.start_bitrate_bps,
         config_.bitrate_config.min_bitrate_bps,
@@ -924,12 +1151,14 @@ void Call::UpdateAggregateNetworkState() {
 
   bool have_audio = false;
   bool have_video = false;
+  bool sending = false;
   {
     ReadLockScoped read_lock(*send_crit_);
     if (audio_send_ssrcs_.size() > 0)
       have_audio = true;
     if (video_send_ssrcs_.size() > 0)
       have_video = true;
+    sending = have_audio || have_video;
   }
   {
     ReadLockScoped read_lock(*receive_crit_);
@@ -948,9 +1177,29 @@ void Call::UpdateAggregateNetworkState() {
   LOG(LS_INFO) << "UpdateAggregateNetworkState: aggregate_state="
                << (aggregate_state == kNetworkUp ? "up" : "down");
 
+  if (shared_congestion_controller_) {
+    shared_congestion_controller_->SignalNetworkState(this, aggregate_state,
+                                                      sending);
+    return;
+  }
   congestion_controller_->SignalNetworkState(aggregate_state);
 }
 
+MediaCryptoContext* Call::GetMediaCryptoContext(const MediaCryptoKey& key) {
+  RTC_DCHECK(configuration_thread_checker_.CalledOnValidThread());
+  auto key_pair = std::make_pair(key.type, key.buffer);
+  auto it = media_crypto_contexts_.find(key_pair);
+  if (it != media_crypto_contexts_.end())
+    return it->second.get();
+  // Failures are not cached, so a later stream with the same key tries again.
+  std::unique_ptr<MediaCryptoContext> context = MediaCryptoContext::Create(key);
+  if (!context)
+    return nullptr;
+  MediaCryptoContext* context_ptr = context.get();
+  media_crypto_contexts_.emplace(std::move(key_pair), std::move(context));
+  return context_ptr;
+}
+
 void Call::OnSentPacket(const rtc::SentPacket& sent_packet) {
   if (first_packet_sent_ms_ == -1)
     first_packet_sent_ms_ = clock_->TimeInMilliseconds();
@@ -1007,8 +1256,13 @@ void Call::OnNetworkChanged(uint32_t target_bitrate_bps,
 
 void Call::OnAllocationLimitsChanged(uint32_t min_send_bitrate_bps,
                                      uint32_t max_padding_bitrate_bps) {
-  congestion_controller_->SetAllocatedSendBitrateLimits(
-      min_send_bitrate_bps, max_padding_bitrate_bps);
+  if (shared_congestion_controller_) {
+    shared_congestion_controller_->SetAllocatedSendBitrateLimits(
+        this, min_send_bitrate_bps, max_padding_bitrate_bps);
+  } else {
+    congestion_controller_->SetAllocatedSendBitrateLimits(
+        min_send_bitrate_bps, max_padding_bitrate_bps);
+  }
   rtc::CritScope lock(&bitrate_crit_);
   min_allocated_send_bitrate_bps_ = min_send_bitrate_bps;
   configured_max_padding_bitrate_bps_ = max_padding_bitrate_bps;
@@ -1074,19 +1328,59 @@ PacketReceiver::DeliveryStatus Call::DeliverRtcp(MediaType media_type,
     received_bytes_per_second_counter_.Add(static_cast<int>(length));
     received_rtcp_bytes_per_second_counter_.Add(static_cast<int>(length));
   }
+  // The RTCP receivers of the receive streams only use the packets sent from
+  // the SSRCs they receive, e.g. sender reports, SDES and BYE. Feedback about
+  // the SSRCs they send from is for the send streams, which get all packets.
+  // Hence the packet is only delivered to the receive streams of its sender
+  // SSRCs, instead of to all of them.
+  std::vector<uint32_t> sender_ssrcs;
+  const bool route_by_ssrc = GetRtcpSenderSsrcs(packet, length, &sender_ssrcs);
   bool rtcp_delivered = false;
   if (media_type == MediaType::ANY || media_type == MediaType::VIDEO) {
     ReadLockScoped read_lock(*receive_crit_);
-    for (VideoReceiveStream* stream : video_receive_streams_) {
-      if (stream->DeliverRtcp(packet, length))
-        rtcp_delivered = true;
+    if (route_by_ssrc) {
+      // A stream may be found by both its media and its RTX SSRC.
+      std::vector<VideoReceiveStream*> streams;
+      for (uint32_t ssrc : sender_ssrcs) {
+        auto it = video_receive_ssrcs_.find(ssrc);
+        if (it != video_receive_ssrcs_.end() &&
+            std::find(streams.begin(), streams.end(), it->second) ==
+                streams.end()) {
+          streams.push_back(it->second);
+        }
+      }
+      for (VideoReceiveStream* stream : streams) {
+        if (stream->DeliverRtcp(packet, length))
+          rtcp_delivered = true;
+      }
+    } else {
+      for (VideoReceiveStream* stream : video_receive_streams_) {
+        if (stream->DeliverRtcp(packet, length))
+          rtcp_delivered = true;
+      }
     }
   }
   if (media_type == MediaType::ANY || media_type == MediaType::AUDIO) {
     ReadLockScoped read_lock(*receive_crit_);
-    for (auto& kv : audio_receive_ssrcs_) {
-      if (kv.second->DeliverRtcp(packet, length))
-        rtcp_delivered = true;
+    if (route_by_ssrc) {
+      std::vector<AudioReceiveStream*> streams;
+      for (uint32_t ssrc : sender_ssrcs) {
+        auto it = audio_receive_ssrcs_.find(ssrc);
+        if (it != audio_receive_ssrcs_.end() &&
+            std::find(streams.begin(), streams.end(), it->second) ==
+                streams.end()) {
+          streams.push_back(it->second);
+        }
+      }
+      for (AudioReceiveStream* stream : streams) {
+        if (stream->DeliverRtcp(packet, length))
+          rtcp_delivered = true;
+      }
+    } else {
+      for (auto& kv : audio_receive_ssrcs_) {
+        if (kv.second->DeliverRtcp(packet, length))
+          rtcp_delivered = true;
+      }
     }
   }
   if (media_type == MediaType::ANY || media_type == MediaType::VIDEO) {
@@ -1118,6 +1412,8 @@ PacketReceiver::DeliveryStatus Call::DeliverRtp(MediaType media_type,
   // Minimum RTP header size.
   if (length < 12)
     return DELIVERY_PACKET_ERROR;
+  rtc::packet_trace::RecordRtp(rtc::packet_trace::Stage::kCallDelivered,
+                               packet, length);
 
   uint32_t ssrc = ByteReader<uint32_t>::ReadBigEndian(&packet[8]);
   ReadLockScoped read_lock(*receive_crit_);
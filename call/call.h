@@ -20,6 +20,8 @@
 #include "webrtc/call/audio_send_stream.h"
 #include "webrtc/call/audio_state.h"
 #include "webrtc/call/flexfec_receive_stream.h"
+#include "webrtc/call/shared_congestion_controller.h"
+#include "webrtc/call/shared_process_threads.h"
 #include "webrtc/common_types.h"
 #include "webrtc/video_receive_stream.h"
 #include "webrtc/video_send_stream.h"
@@ -86,6 +88,19 @@ class Call {
     // RtcEventLog to use for this call. Required.
     // Use webrtc::RtcEventLog::CreateNull() for a null implementation.
     RtcEventLog* event_log = nullptr;
+
+    // Pace packets from a dedicated task queue every millisecond instead of
+    // every 5 ms, so they go out in smaller bursts.
+    bool high_resolution_pacing = false;
+
+    // Congestion controller shared with the other calls using the same
+    // transport, which then share one bandwidth estimate and pacer. Replaces
+    // |high_resolution_pacing| when set.
+    rtc::scoped_refptr<SharedCongestionController> shared_congestion_controller;
+
+    // Process threads shared with other calls, which are used instead of
+    // starting a module process thread and a pacer thread for this call.
+    rtc::scoped_refptr<SharedProcessThreads> shared_process_threads;
   };
 
   struct Stats {
@@ -8,13 +8,19 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
 #include <algorithm>
+#include <ctime>
 #include <limits>
 #include <memory>
 #include <string>
 
 #include "webrtc/base/checks.h"
 #include "webrtc/base/constructormagic.h"
+#include "webrtc/base/sslstreamadapter.h"
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/call/call.h"
 #include "webrtc/config.h"
@@ -24,6 +30,7 @@
 #include "webrtc/modules/rtp_rtcp/include/rtp_header_parser.h"
 #include "webrtc/system_wrappers/include/critical_section_wrapper.h"
 #include "webrtc/system_wrappers/include/metrics_default.h"
+#include "webrtc/system_wrappers/include/sleep.h"
 #include "webrtc/test/call_test.h"
 #include "webrtc/test/direct_transport.h"
 #include "webrtc/test/drifting_clock.h"
@@ -44,6 +51,33 @@ using webrtc::test::DriftingClock;
 using webrtc::test::FakeAudioDevice;
 
 namespace webrtc {
+namespace {
+// AES-256-GCM uses a 32 bytes key and a 12 bytes salt.
+constexpr size_t kMediaCryptoKeyAndSaltSize = 44;
+
+// Returns the value of the |name| line of /proc/self/status, e.g. the
+// resident memory in kB for "VmRSS", or -1 if it can't be read.
+int64_t GetProcessStatus(const char* name) {
+#if defined(WEBRTC_LINUX)
+  FILE* file = fopen("/proc/self/status", "r");
+  if (!file)
+    return -1;
+  const size_t name_length = strlen(name);
+  int64_t value = -1;
+  char line[256];
+  while (fgets(line, sizeof(line), file)) {
+    if (strncmp(line, name, name_length) == 0 && line[name_length] == ':') {
+      value = strtoll(line + name_length + 1, nullptr, 10);
+      break;
+    }
+  }
+  fclose(file);
+  return value;
+#else
+  return -1;
+#endif
+}
+}  // namespace
 
 class CallPerfTest : public test::CallTest {
  protected:
@@ -65,6 +99,8 @@ class CallPerfTest : public test::CallTest {
                           int threshold_ms,
                           int start_time_ms,
                           int run_time_ms);
+
+  void TestStreamScaling(bool media_crypto);
 };
 
 class VideoRtcpAndSyncObserver : public test::RtpRtcpObserver,
@@ -739,4 +775,118 @@ TEST_F(CallPerfTest, KeepsHighBitrateWhenReconfiguringSender) {
   RunBaseTest(&test);
 }
 
+// Sends an increasing number of video streams from one call to another, and
+// reports the CPU, memory and threads of the process for each number. The
+// streams carry the synthetic frames of the fake encoder, so the cost measured
+// is the per-stream overhead of the RTP, crypto and threading code.
+void CallPerfTest::TestStreamScaling(bool media_crypto) {
+  static const size_t kNumStreams[] = {1, 4, 16};
+  static const int kRunTimeMs = 5000;
+  static const uint32_t kFirstSsrc = 0x20000;
+
+  MediaCryptoKey key;
+  key.type = rtc::SRTP_AEAD_AES_256_GCM;
+  for (size_t i = 0; i < kMediaCryptoKeyAndSaltSize; ++i)
+    key.buffer.push_back(static_cast<uint8_t>(i));
+
+  std::vector<double> cpu_percent;
+  std::vector<double> rss_kb;
+  std::vector<double> threads;
+  for (size_t num_streams : kNumStreams) {
+    CreateCalls(Call::Config(&event_log_), Call::Config(&event_log_));
+    test::DirectTransport send_transport(sender_call_.get());
+    test::DirectTransport receive_transport(receiver_call_.get());
+    send_transport.SetReceiver(receiver_call_->Receiver());
+    receive_transport.SetReceiver(sender_call_->Receiver());
+
+    std::vector<std::unique_ptr<test::FakeEncoder>> encoders;
+    std::vector<std::unique_ptr<VideoDecoder>> decoders;
+    std::vector<std::unique_ptr<test::FrameGeneratorCapturer>> capturers;
+    std::vector<VideoSendStream*> send_streams;
+    std::vector<VideoReceiveStream*> receive_streams;
+    for (size_t i = 0; i < num_streams; ++i) {
+      const uint32_t ssrc = kFirstSsrc + static_cast<uint32_t>(i);
+      encoders.emplace_back(new test::FakeEncoder(clock_));
+      VideoSendStream::Config send_config(&send_transport);
+      send_config.rtp.ssrcs.push_back(ssrc);
+      send_config.encoder_settings.encoder = encoders.back().get();
+      send_config.encoder_settings.payload_name = "FAKE";
+      send_config.encoder_settings.payload_type = kFakeVideoSendPayloadType;
+      send_config.media_crypto_enabled = media_crypto;
+      send_config.media_crypto_key = key;
+      VideoEncoderConfig encoder_config;
+      test::FillEncoderConfiguration(1, &encoder_config);
+      send_streams.push_back(sender_call_->CreateVideoSendStream(
+          send_config.Copy(), encoder_config.Copy()));
+
+      VideoReceiveStream::Config receive_config(&receive_transport);
+      receive_config.rtp.remote_ssrc = ssrc;
+      receive_config.rtp.local_ssrc =
+          kReceiverLocalVideoSsrc + static_cast<uint32_t>(i);
+      receive_config.renderer = &fake_renderer_;
+      receive_config.media_crypto_enabled = media_crypto;
+      receive_config.media_crypto_key = key;
+      VideoReceiveStream::Decoder decoder =
+          test::CreateMatchingDecoder(send_config.encoder_settings);
+      decoders.emplace_back(decoder.decoder);
+      receive_config.decoders.push_back(decoder);
+      receive_streams.push_back(
+          receiver_call_->CreateVideoReceiveStream(std::move(receive_config)));
+
+      capturers.emplace_back(test::FrameGeneratorCapturer::Create(
+          kDefaultWidth, kDefaultHeight, kDefaultFramerate, clock_));
+      send_streams.back()->SetSource(
+          capturers.back().get(),
+          VideoSendStream::DegradationPreference::kBalanced);
+    }
+
+    for (size_t i = 0; i < num_streams; ++i) {
+      receive_streams[i]->Start();
+      send_streams[i]->Start();
+      capturers[i]->Start();
+    }
+
+    const std::clock_t start_cpu = std::clock();
+    SleepMs(kRunTimeMs);
+    const std::clock_t end_cpu = std::clock();
+    // Read while all the streams are running, since some threads only exist
+    // while they do.
+    threads.push_back(GetProcessStatus("Threads"));
+    rss_kb.push_back(GetProcessStatus("VmRSS"));
+    // The CPU time of all the threads of the process, in percent of one core.
+    cpu_percent.push_back(100.0 * (end_cpu - start_cpu) / CLOCKS_PER_SEC *
+                          1000 / kRunTimeMs);
+
+    for (size_t i = 0; i < num_streams; ++i) {
+      capturers[i]->Stop();
+      send_streams[i]->Stop();
+      receive_streams[i]->Stop();
+    }
+    send_transport.StopSending();
+    receive_transport.StopSending();
+    for (size_t i = 0; i < num_streams; ++i) {
+      sender_call_->DestroyVideoSendStream(send_streams[i]);
+      receiver_call_->DestroyVideoReceiveStream(receive_streams[i]);
+    }
+    DestroyCalls();
+  }
+
+  // One value per entry of |kNumStreams|.
+  const std::string trace = media_crypto ? "media_crypto" : "no_media_crypto";
+  test::PrintResultList("stream_scaling_cpu", "", trace,
+                        test::ValuesToString(cpu_percent), "%", false);
+  test::PrintResultList("stream_scaling_rss", "", trace,
+                        test::ValuesToString(rss_kb), "kB", false);
+  test::PrintResultList("stream_scaling_threads", "", trace,
+                        test::ValuesToString(threads), "threads", false);
+}
+
+TEST_F(CallPerfTest, StreamScaling) {
+  TestStreamScaling(false);
+}
+
+TEST_F(CallPerfTest, StreamScalingWithMediaCrypto) {
+  TestStreamScaling(true);
+}
+
 }  // namespace webrtc
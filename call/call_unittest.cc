@@ -24,7 +24,9 @@ namespace {
 
 struct CallHelper {
   explicit CallHelper(
-      rtc::scoped_refptr<webrtc::AudioDecoderFactory> decoder_factory = nullptr)
+      rtc::scoped_refptr<webrtc::AudioDecoderFactory> decoder_factory = nullptr,
+      rtc::scoped_refptr<webrtc::SharedProcessThreads> shared_process_threads =
+          nullptr)
       : voice_engine_(decoder_factory) {
     webrtc::AudioState::Config audio_state_config;
     audio_state_config.voice_engine = &voice_engine_;
@@ -34,6 +36,7 @@ struct CallHelper {
     EXPECT_CALL(voice_engine_, audio_transport());
     webrtc::Call::Config config(&event_log_);
     config.audio_state = webrtc::AudioState::Create(audio_state_config);
+    config.shared_process_threads = shared_process_threads;
     call_.reset(webrtc::Call::Create(config));
   }
 
@@ -53,6 +56,24 @@ TEST(CallTest, ConstructDestruct) {
   CallHelper call;
 }
 
+TEST(CallTest, ConstructDestructWithSharedProcessThreads) {
+  rtc::scoped_refptr<SharedProcessThreads> shared_process_threads =
+      SharedProcessThreads::Create();
+  std::unique_ptr<CallHelper> call1(
+      new CallHelper(nullptr, shared_process_threads));
+  {
+    CallHelper call2(nullptr, shared_process_threads);
+    AudioSendStream::Config config(nullptr);
+    config.rtp.ssrc = 42;
+    config.voe_channel_id = 123;
+    AudioSendStream* stream = call2->CreateAudioSendStream(config);
+    EXPECT_NE(stream, nullptr);
+    call2->DestroyAudioSendStream(stream);
+  }
+  // The threads keep running for the remaining call.
+  call1.reset();
+}
+
 TEST(CallTest, CreateDestroy_AudioSendStream) {
   CallHelper call;
   AudioSendStream::Config config(nullptr);
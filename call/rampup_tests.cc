@@ -38,7 +38,8 @@ RampUpTester::RampUpTester(size_t num_video_streams,
                            unsigned int start_bitrate_bps,
                            const std::string& extension_type,
                            bool rtx,
-                           bool red)
+                           bool red,
+                           bool high_resolution_pacing)
     : EndToEndTest(test::CallTest::kLongTimeoutMs),
       event_(false, false),
       clock_(Clock::GetRealTimeClock()),
@@ -46,6 +47,7 @@ RampUpTester::RampUpTester(size_t num_video_streams,
       num_audio_streams_(num_audio_streams),
       rtx_(rtx),
       red_(red),
+      high_resolution_pacing_(high_resolution_pacing),
       sender_call_(nullptr),
       send_stream_(nullptr),
       start_bitrate_bps_(start_bitrate_bps),
@@ -73,6 +75,7 @@ Call::Config RampUpTester::GetSenderCallConfig() {
     call_config.bitrate_config.start_bitrate_bps = start_bitrate_bps_;
   }
   call_config.bitrate_config.min_bitrate_bps = 10000;
+  call_config.high_resolution_pacing = high_resolution_pacing_;
   return call_config;
 }
 
@@ -355,13 +358,15 @@ RampUpDownUpTester::RampUpDownUpTester(size_t num_video_streams,
                                        unsigned int start_bitrate_bps,
                                        const std::string& extension_type,
                                        bool rtx,
-                                       bool red)
+                                       bool red,
+                                       bool high_resolution_pacing)
     : RampUpTester(num_video_streams,
                    num_audio_streams,
                    start_bitrate_bps,
                    extension_type,
                    rtx,
-                   red),
+                   red,
+                   high_resolution_pacing),
       test_state_(kFirstRampup),
       state_start_ms_(clock_->TimeInMilliseconds()),
       interval_start_ms_(clock_->TimeInMilliseconds()),
@@ -415,6 +420,8 @@ std::string RampUpDownUpTester::GetModifierString() const {
   }
   str += (rtx_ ? "" : "no");
   str += "rtx";
+  if (high_resolution_pacing_)
+    str += "_hrpacing";
   return str;
 }
 
@@ -499,61 +506,78 @@ static const uint32_t kStartBitrateBps = 60000;
 
 TEST_F(RampUpTest, UpDownUpAbsSendTimeSimulcastRedRtx) {
   RampUpDownUpTester test(3, 0, kStartBitrateBps, RtpExtension::kAbsSendTimeUri,
-                          true, true);
+                          true, true, false);
   RunBaseTest(&test);
 }
 
 TEST_F(RampUpTest, UpDownUpTransportSequenceNumberRtx) {
   RampUpDownUpTester test(3, 0, kStartBitrateBps,
                           RtpExtension::kTransportSequenceNumberUri, true,
-                          false);
+                          false, false);
+  RunBaseTest(&test);
+}
+
+// Same as above with high resolution pacing, to compare the network latency of
+// both pacing modes.
+TEST_F(RampUpTest, UpDownUpTransportSequenceNumberRtxHighResolutionPacing) {
+  RampUpDownUpTester test(3, 0, kStartBitrateBps,
+                          RtpExtension::kTransportSequenceNumberUri, true,
+                          false, true);
   RunBaseTest(&test);
 }
 
 TEST_F(RampUpTest, UpDownUpAudioVideoTransportSequenceNumberRtx) {
   RampUpDownUpTester test(3, 1, kStartBitrateBps,
                           RtpExtension::kTransportSequenceNumberUri, true,
-                          false);
+                          false, false);
   RunBaseTest(&test);
 }
 
 TEST_F(RampUpTest, UpDownUpAudioTransportSequenceNumberRtx) {
   RampUpDownUpTester test(0, 1, kStartBitrateBps,
                           RtpExtension::kTransportSequenceNumberUri, true,
-                          false);
+                          false, false);
   RunBaseTest(&test);
 }
 
 TEST_F(RampUpTest, TOffsetSimulcastRedRtx) {
-  RampUpTester test(3, 0, 0, RtpExtension::kTimestampOffsetUri, true, true);
+  RampUpTester test(3, 0, 0, RtpExtension::kTimestampOffsetUri, true, true,
+                    false);
   RunBaseTest(&test);
 }
 
 TEST_F(RampUpTest, AbsSendTime) {
-  RampUpTester test(1, 0, 0, RtpExtension::kAbsSendTimeUri, false, false);
+  RampUpTester test(1, 0, 0, RtpExtension::kAbsSendTimeUri, false, false,
+                    false);
   RunBaseTest(&test);
 }
 
 TEST_F(RampUpTest, AbsSendTimeSimulcastRedRtx) {
-  RampUpTester test(3, 0, 0, RtpExtension::kAbsSendTimeUri, true, true);
+  RampUpTester test(3, 0, 0, RtpExtension::kAbsSendTimeUri, true, true, false);
   RunBaseTest(&test);
 }
 
 TEST_F(RampUpTest, TransportSequenceNumber) {
   RampUpTester test(1, 0, 0, RtpExtension::kTransportSequenceNumberUri, false,
-                    false);
+                    false, false);
   RunBaseTest(&test);
 }
 
 TEST_F(RampUpTest, TransportSequenceNumberSimulcast) {
   RampUpTester test(3, 0, 0, RtpExtension::kTransportSequenceNumberUri, false,
-                    false);
+                    false, false);
+  RunBaseTest(&test);
+}
+
+TEST_F(RampUpTest, TransportSequenceNumberSimulcastHighResolutionPacing) {
+  RampUpTester test(3, 0, 0, RtpExtension::kTransportSequenceNumberUri, false,
+                    false, true);
   RunBaseTest(&test);
 }
 
 TEST_F(RampUpTest, TransportSequenceNumberSimulcastRedRtx) {
   RampUpTester test(3, 0, 0, RtpExtension::kTransportSequenceNumberUri, true,
-                    true);
+                    true, false);
   RunBaseTest(&test);
 }
 }  // namespace webrtc
@@ -36,7 +36,8 @@ class RampUpTester : public test::EndToEndTest {
                unsigned int start_bitrate_bps,
                const std::string& extension_type,
                bool rtx,
-               bool red);
+               bool red,
+               bool high_resolution_pacing);
   ~RampUpTester() override;
 
   size_t GetNumVideoStreams() const override;
@@ -66,6 +67,7 @@ class RampUpTester : public test::EndToEndTest {
   const size_t num_audio_streams_;
   const bool rtx_;
   const bool red_;
+  const bool high_resolution_pacing_;
   Call* sender_call_;
   VideoSendStream* send_stream_;
   test::PacketTransport* send_transport_;
@@ -111,7 +113,8 @@ class RampUpDownUpTester : public RampUpTester {
                      unsigned int start_bitrate_bps,
                      const std::string& extension_type,
                      bool rtx,
-                     bool red);
+                     bool red,
+                     bool high_resolution_pacing);
   ~RampUpDownUpTester() override;
 
  protected:
@@ -0,0 +1,166 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/call/rtcp_report_batcher.h"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/common_header.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/sdes.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/sender_report.h"
+#include "webrtc/system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+namespace {
+
+// Returns true if |packet| is a compound RTCP packet made only of sender
+// reports, receiver reports and SDES packets.
+bool IsReport(const uint8_t* packet, size_t length) {
+  const uint8_t* const packet_end = packet + length;
+  rtcp::CommonHeader header;
+  for (const uint8_t* next = packet; next != packet_end;
+       next = header.NextPacket()) {
+    if (!header.Parse(next, packet_end - next))
+      return false;
+    if (header.type() != rtcp::SenderReport::kPacketType &&
+        header.type() != rtcp::ReceiverReport::kPacketType &&
+        header.type() != rtcp::Sdes::kPacketType) {
+      return false;
+    }
+  }
+  return length > 0;
+}
+
+}  // namespace
+
+class RtcpReportBatcher::BatchingTransport : public Transport {
+ public:
+  BatchingTransport(Clock* clock, Transport* transport)
+      : clock_(clock), transport_(transport), users_(0), first_held_ms_(-1) {}
+
+  bool SendRtp(const uint8_t* packet,
+               size_t length,
+               const PacketOptions& options) override {
+    return transport_->SendRtp(packet, length, options);
+  }
+
+  bool SendRtcp(const uint8_t* packet, size_t length) override {
+    if (!IsReport(packet, length) || length > kMaxPacketSize)
+      return transport_->SendRtcp(packet, length);
+
+    std::vector<uint8_t> full_batch;
+    {
+      rtc::CritScope lock(&crit_);
+      if (batch_.size() + length > kMaxPacketSize) {
+        full_batch.swap(batch_);
+        first_held_ms_ = -1;
+      }
+      if (batch_.empty())
+        first_held_ms_ = clock_->TimeInMilliseconds();
+      batch_.insert(batch_.end(), packet, packet + length);
+    }
+    if (!full_batch.empty())
+      transport_->SendRtcp(full_batch.data(), full_batch.size());
+    return true;
+  }
+
+  // Sends the held packets if the first of them has been held since
+  // |held_since_ms| or earlier.
+  void SendBatch(int64_t held_since_ms) {
+    std::vector<uint8_t> batch;
+    {
+      rtc::CritScope lock(&crit_);
+      if (batch_.empty() || first_held_ms_ > held_since_ms)
+        return;
+      batch.swap(batch_);
+      first_held_ms_ = -1;
+    }
+    transport_->SendRtcp(batch.data(), batch.size());
+  }
+
+  // Returns -1 if no packets are held.
+  int64_t first_held_ms() const {
+    rtc::CritScope lock(&crit_);
+    return first_held_ms_;
+  }
+
+  // Counts the GetTransport calls that haven't been released yet. Called with
+  // the batcher's lock held.
+  void AddUser() { ++users_; }
+  // Returns true when the last user is gone.
+  bool RemoveUser() { return --users_ == 0; }
+
+ private:
+  Clock* const clock_;
+  Transport* const transport_;
+  int users_;
+
+  rtc::CriticalSection crit_;
+  std::vector<uint8_t> batch_ GUARDED_BY(crit_);
+  int64_t first_held_ms_ GUARDED_BY(crit_);
+};
+
+RtcpReportBatcher::RtcpReportBatcher(Clock* clock, int64_t max_delay_ms)
+    : clock_(clock), max_delay_ms_(max_delay_ms) {
+  RTC_DCHECK_GT(max_delay_ms, 0);
+}
+
+RtcpReportBatcher::~RtcpReportBatcher() {
+  RTC_DCHECK(transports_.empty());
+}
+
+Transport* RtcpReportBatcher::GetTransport(Transport* transport) {
+  RTC_DCHECK(transport);
+  rtc::CritScope lock(&crit_);
+  std::unique_ptr<BatchingTransport>& batching_transport =
+      transports_[transport];
+  if (!batching_transport)
+    batching_transport.reset(new BatchingTransport(clock_, transport));
+  batching_transport->AddUser();
+  return batching_transport.get();
+}
+
+void RtcpReportBatcher::ReleaseTransport(Transport* transport) {
+  rtc::CritScope lock(&crit_);
+  auto it = transports_.find(transport);
+  RTC_DCHECK(it != transports_.end());
+  if (it == transports_.end() || !it->second->RemoveUser())
+    return;
+  it->second->SendBatch(std::numeric_limits<int64_t>::max());
+  transports_.erase(it);
+}
+
+int64_t RtcpReportBatcher::TimeUntilNextProcess() {
+  const int64_t now_ms = clock_->TimeInMilliseconds();
+  int64_t time_until_next_process_ms = max_delay_ms_;
+  rtc::CritScope lock(&crit_);
+  for (const auto& kv : transports_) {
+    int64_t first_held_ms = kv.second->first_held_ms();
+    if (first_held_ms >= 0) {
+      time_until_next_process_ms = std::min(
+          time_until_next_process_ms, first_held_ms + max_delay_ms_ - now_ms);
+    }
+  }
+  return std::max<int64_t>(time_until_next_process_ms, 0);
+}
+
+void RtcpReportBatcher::Process() {
+  const int64_t held_since_ms = clock_->TimeInMilliseconds() - max_delay_ms_;
+  rtc::CritScope lock(&crit_);
+  for (const auto& kv : transports_)
+    kv.second->SendBatch(held_since_ms);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,77 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_CALL_RTCP_REPORT_BATCHER_H_
+#define WEBRTC_CALL_RTCP_REPORT_BATCHER_H_
+
+#include <map>
+#include <memory>
+
+#include "webrtc/api/call/transport.h"
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/modules/include/module.h"
+
+namespace webrtc {
+
+class Clock;
+
+// Batches the regular RTCP reports of the receive streams of a Call. Each
+// stream sends its receiver reports on its own timer, so a Call with many
+// receive streams sends many small RTCP packets, each paying for SRTCP and a
+// socket send of its own. The batcher holds compound packets made only of
+// SR, RR and SDES packets for up to |max_delay_ms|, and sends the ones held
+// for the same transport concatenated as one compound packet of at most
+// kMaxPacketSize bytes. Packets with feedback, like NACK, PLI or REMB, are
+// sent right away.
+//
+// Holding a receiver report delays the reply to the sender report it refers
+// to, so the RTT measured by the remote sender grows by up to |max_delay_ms|.
+//
+// Process must be called regularly, e.g. by registering the batcher with a
+// ProcessThread.
+class RtcpReportBatcher : public Module {
+ public:
+  // The limit that RTCPSender uses for a compound packet: an ethernet MTU
+  // minus the IPv4 and UDP headers.
+  static const size_t kMaxPacketSize = 1500 - 28;
+
+  RtcpReportBatcher(Clock* clock, int64_t max_delay_ms);
+  ~RtcpReportBatcher() override;
+
+  // Returns a transport that sends RTP and RTCP through |transport|, batching
+  // the RTCP reports. The transports of all the streams that send through
+  // |transport| share the batch. Each call must be balanced by a call to
+  // ReleaseTransport with the same |transport|, which sends the held reports
+  // when the last user releases it.
+  Transport* GetTransport(Transport* transport);
+  void ReleaseTransport(Transport* transport);
+
+  // Implements Module.
+  int64_t TimeUntilNextProcess() override;
+  void Process() override;
+
+ private:
+  class BatchingTransport;
+
+  Clock* const clock_;
+  const int64_t max_delay_ms_;
+
+  rtc::CriticalSection crit_;
+  std::map<Transport*, std::unique_ptr<BatchingTransport>> transports_
+      GUARDED_BY(crit_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(RtcpReportBatcher);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_CALL_RTCP_REPORT_BATCHER_H_
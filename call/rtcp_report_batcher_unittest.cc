@@ -0,0 +1,150 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "webrtc/base/buffer.h"
+#include "webrtc/call/rtcp_report_batcher.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/pli.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/receiver_report.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+const int64_t kMaxDelayMs = 20;
+
+class FakeTransport : public Transport {
+ public:
+  bool SendRtp(const uint8_t* packet,
+               size_t length,
+               const PacketOptions& options) override {
+    ++rtp_packets;
+    return true;
+  }
+
+  bool SendRtcp(const uint8_t* packet, size_t length) override {
+    rtcp_packets.push_back(std::vector<uint8_t>(packet, packet + length));
+    return true;
+  }
+
+  int rtp_packets = 0;
+  std::vector<std::vector<uint8_t>> rtcp_packets;
+};
+
+rtc::Buffer ReceiverReport(uint32_t ssrc) {
+  rtcp::ReceiverReport rr;
+  rr.SetSenderSsrc(ssrc);
+  return rr.Build();
+}
+
+rtc::Buffer Pli(uint32_t ssrc) {
+  rtcp::Pli pli;
+  pli.SetSenderSsrc(ssrc);
+  pli.SetMediaSsrc(ssrc + 1);
+  return pli.Build();
+}
+
+}  // namespace
+
+class RtcpReportBatcherTest : public ::testing::Test {
+ protected:
+  RtcpReportBatcherTest() : clock_(1000), batcher_(&clock_, kMaxDelayMs) {}
+
+  SimulatedClock clock_;
+  RtcpReportBatcher batcher_;
+  FakeTransport transport_;
+};
+
+TEST_F(RtcpReportBatcherTest, SendsReportsTogetherAfterMaxDelay) {
+  Transport* transport1 = batcher_.GetTransport(&transport_);
+  Transport* transport2 = batcher_.GetTransport(&transport_);
+  rtc::Buffer rr1 = ReceiverReport(1);
+  rtc::Buffer rr2 = ReceiverReport(2);
+  EXPECT_TRUE(transport1->SendRtcp(rr1.data(), rr1.size()));
+  clock_.AdvanceTimeMilliseconds(5);
+  EXPECT_TRUE(transport2->SendRtcp(rr2.data(), rr2.size()));
+  EXPECT_EQ(kMaxDelayMs - 5, batcher_.TimeUntilNextProcess());
+
+  batcher_.Process();
+  EXPECT_TRUE(transport_.rtcp_packets.empty());
+
+  clock_.AdvanceTimeMilliseconds(kMaxDelayMs - 5);
+  EXPECT_EQ(0, batcher_.TimeUntilNextProcess());
+  batcher_.Process();
+  ASSERT_EQ(1u, transport_.rtcp_packets.size());
+  std::vector<uint8_t> expected(rr1.data(), rr1.data() + rr1.size());
+  expected.insert(expected.end(), rr2.data(), rr2.data() + rr2.size());
+  EXPECT_EQ(expected, transport_.rtcp_packets[0]);
+  EXPECT_EQ(kMaxDelayMs, batcher_.TimeUntilNextProcess());
+
+  batcher_.ReleaseTransport(&transport_);
+  batcher_.ReleaseTransport(&transport_);
+}
+
+TEST_F(RtcpReportBatcherTest, SendsFeedbackRightAway) {
+  Transport* transport = batcher_.GetTransport(&transport_);
+  rtc::Buffer rr = ReceiverReport(1);
+  rtc::Buffer pli = Pli(1);
+  EXPECT_TRUE(transport->SendRtcp(rr.data(), rr.size()));
+  EXPECT_TRUE(transport->SendRtcp(pli.data(), pli.size()));
+  ASSERT_EQ(1u, transport_.rtcp_packets.size());
+  EXPECT_EQ(pli.size(), transport_.rtcp_packets[0].size());
+
+  PacketOptions options;
+  EXPECT_TRUE(transport->SendRtp(rr.data(), rr.size(), options));
+  EXPECT_EQ(1, transport_.rtp_packets);
+
+  // The held report is sent when the transport is released.
+  batcher_.ReleaseTransport(&transport_);
+  ASSERT_EQ(2u, transport_.rtcp_packets.size());
+  EXPECT_EQ(rr.size(), transport_.rtcp_packets[1].size());
+}
+
+TEST_F(RtcpReportBatcherTest, SendsBatchBeforeExceedingMaxPacketSize) {
+  Transport* transport = batcher_.GetTransport(&transport_);
+  rtc::Buffer rr = ReceiverReport(1);
+  const size_t reports_per_packet =
+      RtcpReportBatcher::kMaxPacketSize / rr.size();
+  for (size_t i = 0; i < reports_per_packet; ++i)
+    EXPECT_TRUE(transport->SendRtcp(rr.data(), rr.size()));
+  EXPECT_TRUE(transport_.rtcp_packets.empty());
+
+  EXPECT_TRUE(transport->SendRtcp(rr.data(), rr.size()));
+  ASSERT_EQ(1u, transport_.rtcp_packets.size());
+  EXPECT_EQ(reports_per_packet * rr.size(),
+            transport_.rtcp_packets[0].size());
+
+  batcher_.ReleaseTransport(&transport_);
+  ASSERT_EQ(2u, transport_.rtcp_packets.size());
+  EXPECT_EQ(rr.size(), transport_.rtcp_packets[1].size());
+}
+
+TEST_F(RtcpReportBatcherTest, KeepsBatchesOfTransportsApart) {
+  FakeTransport other_transport;
+  Transport* transport1 = batcher_.GetTransport(&transport_);
+  Transport* transport2 = batcher_.GetTransport(&other_transport);
+  EXPECT_NE(transport1, transport2);
+  rtc::Buffer rr = ReceiverReport(1);
+  EXPECT_TRUE(transport1->SendRtcp(rr.data(), rr.size()));
+  EXPECT_TRUE(transport2->SendRtcp(rr.data(), rr.size()));
+
+  clock_.AdvanceTimeMilliseconds(kMaxDelayMs);
+  batcher_.Process();
+  EXPECT_EQ(1u, transport_.rtcp_packets.size());
+  EXPECT_EQ(1u, other_transport.rtcp_packets.size());
+
+  batcher_.ReleaseTransport(&transport_);
+  batcher_.ReleaseTransport(&other_transport);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,46 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_CALL_SHARED_CONGESTION_CONTROLLER_H_
+#define WEBRTC_CALL_SHARED_CONGESTION_CONTROLLER_H_
+
+#include "webrtc/base/refcount.h"
+#include "webrtc/base/scoped_ref_ptr.h"
+
+namespace webrtc {
+
+class RtcEventLog;
+
+// SharedCongestionController holds the congestion control state shared by
+// several instances of webrtc::Call sending over the same transport, such as
+// PeerConnections bundled on one TransportController. The Calls then run one
+// bandwidth estimate on the aggregated transport feedback and one pacer, and
+// the estimate is split between them instead of each Call probing the same
+// bottleneck on its own. All the Calls must use the same transport, since
+// they share one transport-wide sequence number space.
+class SharedCongestionController : public rtc::RefCountInterface {
+ public:
+  struct Config {
+    // RtcEventLog for the shared bandwidth estimator. Required, and must
+    // outlive the SharedCongestionController.
+    RtcEventLog* event_log = nullptr;
+
+    // See Call::Config::high_resolution_pacing.
+    bool high_resolution_pacing = false;
+  };
+
+  static rtc::scoped_refptr<SharedCongestionController> Create(
+      const SharedCongestionController::Config& config);
+
+  virtual ~SharedCongestionController() {}
+};
+}  // namespace webrtc
+
+#endif  // WEBRTC_CALL_SHARED_CONGESTION_CONTROLLER_H_
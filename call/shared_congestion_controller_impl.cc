@@ -0,0 +1,312 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/call/shared_congestion_controller_impl.h"
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/logging.h"
+#include "webrtc/base/refcountedobject.h"
+#include "webrtc/modules/pacing/paced_sender.h"
+#include "webrtc/modules/pacing/task_queue_pacer.h"
+#include "webrtc/modules/utility/include/process_thread.h"
+#include "webrtc/system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+rtc::scoped_refptr<SharedCongestionController>
+SharedCongestionController::Create(
+    const SharedCongestionController::Config& config) {
+  return rtc::scoped_refptr<SharedCongestionController>(
+      new rtc::RefCountedObject<SharedCongestionControllerImpl>(
+          Clock::GetRealTimeClock(), config));
+}
+
+SharedCongestionControllerImpl::MemberState::MemberState(
+    CongestionController::Observer* member)
+    : member(member),
+      min_bitrate_bps(0),
+      start_bitrate_bps(0),
+      max_bitrate_bps(-1),
+      network_state(kNetworkDown),
+      sending(false),
+      min_send_bitrate_bps(0),
+      max_padding_bitrate_bps(0) {}
+
+SharedCongestionControllerImpl::SharedCongestionControllerImpl(
+    Clock* clock,
+    const Config& config)
+    : clock_(clock),
+      module_process_thread_(
+          ProcessThread::Create("SharedCongestionControllerThread")),
+      pacer_thread_(ProcessThread::Create("SharedPacerThread")),
+      remb_(clock_),
+      congestion_controller_(
+          clock_,
+          this,
+          &remb_,
+          config.event_log,
+          &packet_router_,
+          std::unique_ptr<PacedSender>(
+              new PacedSender(clock_,
+                              &packet_router_,
+                              config.high_resolution_pacing))),
+      has_estimate_(false),
+      last_bitrate_bps_(0),
+      last_fraction_loss_(0),
+      last_rtt_ms_(0),
+      last_probing_interval_ms_(0) {
+  RTC_DCHECK(config.event_log);
+  congestion_controller_.SignalNetworkState(kNetworkDown);
+
+  module_process_thread_->RegisterModule(&congestion_controller_);
+  module_process_thread_->Start();
+  if (config.high_resolution_pacing) {
+    task_queue_pacer_.reset(new TaskQueuePacer(congestion_controller_.pacer()));
+    task_queue_pacer_->Start();
+  } else {
+    pacer_thread_->RegisterModule(congestion_controller_.pacer());
+  }
+  pacer_thread_->RegisterModule(
+      congestion_controller_.GetRemoteBitrateEstimator(true));
+  pacer_thread_->Start();
+}
+
+SharedCongestionControllerImpl::~SharedCongestionControllerImpl() {
+  RTC_DCHECK(members_.empty());
+  RTC_DCHECK(!remb_.InUse());
+  pacer_thread_->Stop();
+  if (task_queue_pacer_)
+    task_queue_pacer_->Stop();
+  else
+    pacer_thread_->DeRegisterModule(congestion_controller_.pacer());
+  pacer_thread_->DeRegisterModule(
+      congestion_controller_.GetRemoteBitrateEstimator(true));
+  module_process_thread_->Stop();
+  module_process_thread_->DeRegisterModule(&congestion_controller_);
+}
+
+void SharedCongestionControllerImpl::AddMember(
+    CongestionController::Observer* member,
+    int min_bitrate_bps,
+    int start_bitrate_bps,
+    int max_bitrate_bps) {
+  int sum_min_bitrate_bps;
+  int sum_start_bitrate_bps;
+  int sum_max_bitrate_bps;
+  {
+    rtc::CritScope lock(&crit_);
+    RTC_DCHECK(!FindMember(member));
+    members_.push_back(MemberState(member));
+    members_.back().min_bitrate_bps = min_bitrate_bps;
+    members_.back().start_bitrate_bps = start_bitrate_bps;
+    members_.back().max_bitrate_bps = max_bitrate_bps;
+    SumBweBitrates(&sum_min_bitrate_bps, &sum_start_bitrate_bps,
+                   &sum_max_bitrate_bps);
+    // Do not restart an estimate the other members already use.
+    if (members_.size() > 1)
+      sum_start_bitrate_bps = -1;
+  }
+  congestion_controller_.SetBweBitrates(
+      sum_min_bitrate_bps, sum_start_bitrate_bps, sum_max_bitrate_bps);
+}
+
+void SharedCongestionControllerImpl::RemoveMember(
+    CongestionController::Observer* member) {
+  int sum_min_bitrate_bps;
+  int sum_start_bitrate_bps;
+  int sum_max_bitrate_bps;
+  {
+    rtc::CritScope lock(&crit_);
+    auto it = std::find_if(members_.begin(), members_.end(),
+                           [member](const MemberState& state) {
+                             return state.member == member;
+                           });
+    RTC_DCHECK(it != members_.end());
+    members_.erase(it);
+    if (members_.empty())
+      return;
+    SumBweBitrates(&sum_min_bitrate_bps, &sum_start_bitrate_bps,
+                   &sum_max_bitrate_bps);
+  }
+  congestion_controller_.SetBweBitrates(sum_min_bitrate_bps, -1,
+                                        sum_max_bitrate_bps);
+  UpdateNetworkStateAndLimits();
+  rtc::CritScope lock(&crit_);
+  AllocateToMembers();
+}
+
+void SharedCongestionControllerImpl::SetBweBitrates(
+    CongestionController::Observer* member,
+    int min_bitrate_bps,
+    int start_bitrate_bps,
+    int max_bitrate_bps) {
+  int sum_min_bitrate_bps;
+  int sum_start_bitrate_bps;
+  int sum_max_bitrate_bps;
+  {
+    rtc::CritScope lock(&crit_);
+    MemberState* state = FindMember(member);
+    RTC_DCHECK(state);
+    state->min_bitrate_bps = min_bitrate_bps;
+    if (start_bitrate_bps > 0)
+      state->start_bitrate_bps = start_bitrate_bps;
+    state->max_bitrate_bps = max_bitrate_bps;
+    SumBweBitrates(&sum_min_bitrate_bps, &sum_start_bitrate_bps,
+                   &sum_max_bitrate_bps);
+  }
+  congestion_controller_.SetBweBitrates(
+      sum_min_bitrate_bps, start_bitrate_bps > 0 ? sum_start_bitrate_bps : -1,
+      sum_max_bitrate_bps);
+}
+
+void SharedCongestionControllerImpl::ResetBweAndBitrates(
+    CongestionController::Observer* member) {
+  int sum_min_bitrate_bps;
+  int sum_start_bitrate_bps;
+  int sum_max_bitrate_bps;
+  {
+    rtc::CritScope lock(&crit_);
+    RTC_DCHECK(FindMember(member));
+    SumBweBitrates(&sum_min_bitrate_bps, &sum_start_bitrate_bps,
+                   &sum_max_bitrate_bps);
+  }
+  congestion_controller_.ResetBweAndBitrates(
+      sum_start_bitrate_bps, sum_min_bitrate_bps, sum_max_bitrate_bps);
+}
+
+void SharedCongestionControllerImpl::SignalNetworkState(
+    CongestionController::Observer* member,
+    NetworkState state,
+    bool sending) {
+  {
+    rtc::CritScope lock(&crit_);
+    MemberState* member_state = FindMember(member);
+    RTC_DCHECK(member_state);
+    member_state->network_state = state;
+    member_state->sending = sending;
+  }
+  UpdateNetworkStateAndLimits();
+  rtc::CritScope lock(&crit_);
+  AllocateToMembers();
+}
+
+void SharedCongestionControllerImpl::SetAllocatedSendBitrateLimits(
+    CongestionController::Observer* member,
+    uint32_t min_send_bitrate_bps,
+    uint32_t max_padding_bitrate_bps) {
+  {
+    rtc::CritScope lock(&crit_);
+    MemberState* state = FindMember(member);
+    RTC_DCHECK(state);
+    state->min_send_bitrate_bps = min_send_bitrate_bps;
+    state->max_padding_bitrate_bps = max_padding_bitrate_bps;
+  }
+  UpdateNetworkStateAndLimits();
+  rtc::CritScope lock(&crit_);
+  AllocateToMembers();
+}
+
+void SharedCongestionControllerImpl::OnNetworkChanged(
+    uint32_t bitrate_bps,
+    uint8_t fraction_loss,
+    int64_t rtt_ms,
+    int64_t probing_interval_ms) {
+  rtc::CritScope lock(&crit_);
+  has_estimate_ = true;
+  last_bitrate_bps_ = bitrate_bps;
+  last_fraction_loss_ = fraction_loss;
+  last_rtt_ms_ = rtt_ms;
+  last_probing_interval_ms_ = probing_interval_ms;
+  AllocateToMembers();
+}
+
+SharedCongestionControllerImpl::MemberState*
+SharedCongestionControllerImpl::FindMember(
+    CongestionController::Observer* member) {
+  for (MemberState& state : members_) {
+    if (state.member == member)
+      return &state;
+  }
+  return nullptr;
+}
+
+void SharedCongestionControllerImpl::SumBweBitrates(int* min_bitrate_bps,
+                                                    int* start_bitrate_bps,
+                                                    int* max_bitrate_bps) {
+  *min_bitrate_bps = 0;
+  *start_bitrate_bps = 0;
+  *max_bitrate_bps = 0;
+  for (const MemberState& state : members_) {
+    *min_bitrate_bps += state.min_bitrate_bps;
+    *start_bitrate_bps += state.start_bitrate_bps;
+    if (*max_bitrate_bps != -1) {
+      *max_bitrate_bps = state.max_bitrate_bps == -1
+                             ? -1
+                             : *max_bitrate_bps + state.max_bitrate_bps;
+    }
+  }
+}
+
+void SharedCongestionControllerImpl::UpdateNetworkStateAndLimits() {
+  NetworkState network_state = kNetworkDown;
+  uint32_t min_send_bitrate_bps = 0;
+  uint32_t max_padding_bitrate_bps = 0;
+  {
+    rtc::CritScope lock(&crit_);
+    for (const MemberState& state : members_) {
+      if (state.network_state == kNetworkUp)
+        network_state = kNetworkUp;
+      min_send_bitrate_bps += state.min_send_bitrate_bps;
+      max_padding_bitrate_bps += state.max_padding_bitrate_bps;
+    }
+  }
+  congestion_controller_.SignalNetworkState(network_state);
+  congestion_controller_.SetAllocatedSendBitrateLimits(min_send_bitrate_bps,
+                                                       max_padding_bitrate_bps);
+}
+
+void SharedCongestionControllerImpl::AllocateToMembers() {
+  if (!has_estimate_)
+    return;
+
+  size_t num_sending = 0;
+  uint64_t sum_min_send_bitrate_bps = 0;
+  for (const MemberState& state : members_) {
+    if (state.network_state == kNetworkUp && state.sending) {
+      ++num_sending;
+      sum_min_send_bitrate_bps += state.min_send_bitrate_bps;
+    }
+  }
+
+  for (const MemberState& state : members_) {
+    uint32_t bitrate_bps = 0;
+    if (state.network_state == kNetworkUp && state.sending) {
+      if (last_bitrate_bps_ <= sum_min_send_bitrate_bps) {
+        // Not enough for all the min bitrates, scale them down alike.
+        bitrate_bps = static_cast<uint32_t>(
+            sum_min_send_bitrate_bps > 0
+                ? last_bitrate_bps_ * uint64_t{state.min_send_bitrate_bps} /
+                      sum_min_send_bitrate_bps
+                : 0);
+      } else {
+        bitrate_bps = state.min_send_bitrate_bps +
+                      static_cast<uint32_t>(
+                          (last_bitrate_bps_ - sum_min_send_bitrate_bps) /
+                          num_sending);
+      }
+    }
+    state.member->OnNetworkChanged(bitrate_bps, last_fraction_loss_,
+                                   last_rtt_ms_, last_probing_interval_ms_);
+  }
+}
+
+}  // namespace webrtc
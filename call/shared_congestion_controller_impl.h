@@ -0,0 +1,132 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_CALL_SHARED_CONGESTION_CONTROLLER_IMPL_H_
+#define WEBRTC_CALL_SHARED_CONGESTION_CONTROLLER_IMPL_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/call/shared_congestion_controller.h"
+#include "webrtc/modules/congestion_controller/include/congestion_controller.h"
+#include "webrtc/modules/pacing/packet_router.h"
+#include "webrtc/video/vie_remb.h"
+
+namespace webrtc {
+
+class Clock;
+class ProcessThread;
+class TaskQueuePacer;
+
+// Runs one CongestionController for all its members, the webrtc::Calls
+// created with it. The members use its PacketRouter and VieRemb instead of
+// their own, report their bitrate config, network state and allocation
+// limits to it, and get their part of the estimate through
+// CongestionController::Observer::OnNetworkChanged.
+class SharedCongestionControllerImpl : public SharedCongestionController,
+                                       public CongestionController::Observer {
+ public:
+  SharedCongestionControllerImpl(Clock* clock, const Config& config);
+  ~SharedCongestionControllerImpl() override;
+
+  CongestionController* congestion_controller() {
+    return &congestion_controller_;
+  }
+  PacketRouter* packet_router() { return &packet_router_; }
+  VieRemb* remb() { return &remb_; }
+
+  // Adds |member| with the bitrate config of its Call. The start bitrate is
+  // only used if |member| is the first one, the others join the running
+  // estimate.
+  void AddMember(CongestionController::Observer* member,
+                 int min_bitrate_bps,
+                 int start_bitrate_bps,
+                 int max_bitrate_bps);
+  void RemoveMember(CongestionController::Observer* member);
+
+  // The estimate is bounded by the sums of the members' min and max bitrates.
+  // A |start_bitrate_bps| <= 0 keeps the current estimate.
+  void SetBweBitrates(CongestionController::Observer* member,
+                      int min_bitrate_bps,
+                      int start_bitrate_bps,
+                      int max_bitrate_bps);
+  // Resets the estimate to the sum of the members' start bitrates, after
+  // |member| saw the network route change.
+  void ResetBweAndBitrates(CongestionController::Observer* member);
+  // The network is up as long as one member has it up. Only members with the
+  // network up and send streams get a part of the estimate.
+  void SignalNetworkState(CongestionController::Observer* member,
+                          NetworkState state,
+                          bool sending);
+  // The pacer and probing use the sums of the members' limits.
+  void SetAllocatedSendBitrateLimits(CongestionController::Observer* member,
+                                     uint32_t min_send_bitrate_bps,
+                                     uint32_t max_padding_bitrate_bps);
+
+  // Implements CongestionController::Observer.
+  void OnNetworkChanged(uint32_t bitrate_bps,
+                        uint8_t fraction_loss,
+                        int64_t rtt_ms,
+                        int64_t probing_interval_ms) override;
+
+ private:
+  struct MemberState {
+    explicit MemberState(CongestionController::Observer* member);
+
+    CongestionController::Observer* member;
+    int min_bitrate_bps;
+    int start_bitrate_bps;
+    int max_bitrate_bps;
+    NetworkState network_state;
+    bool sending;
+    uint32_t min_send_bitrate_bps;
+    uint32_t max_padding_bitrate_bps;
+  };
+
+  MemberState* FindMember(CongestionController::Observer* member)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Sums of the members' bitrate configs, with -1 as max if one of them has
+  // no max.
+  void SumBweBitrates(int* min_bitrate_bps,
+                      int* start_bitrate_bps,
+                      int* max_bitrate_bps) EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Applies the members' network states and limits to
+  // |congestion_controller_|.
+  void UpdateNetworkStateAndLimits();
+  // Splits the last estimate between the members: the sending ones first get
+  // their min send bitrate, then an even share of the rest.
+  void AllocateToMembers() EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  Clock* const clock_;
+  const std::unique_ptr<ProcessThread> module_process_thread_;
+  const std::unique_ptr<ProcessThread> pacer_thread_;
+  VieRemb remb_;
+  PacketRouter packet_router_;
+  CongestionController congestion_controller_;
+  std::unique_ptr<TaskQueuePacer> task_queue_pacer_;
+
+  rtc::CriticalSection crit_;
+  std::vector<MemberState> members_ GUARDED_BY(crit_);
+  // Whether |congestion_controller_| has signaled an estimate yet.
+  bool has_estimate_ GUARDED_BY(crit_);
+  uint32_t last_bitrate_bps_ GUARDED_BY(crit_);
+  uint8_t last_fraction_loss_ GUARDED_BY(crit_);
+  int64_t last_rtt_ms_ GUARDED_BY(crit_);
+  int64_t last_probing_interval_ms_ GUARDED_BY(crit_);
+
+  RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(SharedCongestionControllerImpl);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_CALL_SHARED_CONGESTION_CONTROLLER_IMPL_H_
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/call/shared_congestion_controller_impl.h"
+
+#include "webrtc/base/refcountedobject.h"
+#include "webrtc/logging/rtc_event_log/rtc_event_log.h"
+#include "webrtc/modules/congestion_controller/include/mock/mock_congestion_controller.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gmock.h"
+#include "webrtc/test/gtest.h"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::NiceMock;
+
+namespace webrtc {
+namespace {
+constexpr uint8_t kFractionLoss = 10;
+constexpr int64_t kRttMs = 50;
+constexpr int64_t kProbingIntervalMs = 3000;
+}  // namespace
+
+class SharedCongestionControllerTest : public ::testing::Test {
+ protected:
+  SharedCongestionControllerTest() : clock_(123456) {
+    SharedCongestionController::Config config;
+    config.event_log = &event_log_;
+    shared_ = new rtc::RefCountedObject<SharedCongestionControllerImpl>(
+        &clock_, config);
+    // The estimate of the real congestion controller may come in at any time.
+    for (test::MockCongestionObserver* member : {&first_, &second_}) {
+      EXPECT_CALL(*member, OnNetworkChanged(_, _, _, _)).Times(AnyNumber());
+      shared_->AddMember(member, 30000, 300000, -1);
+    }
+  }
+
+  ~SharedCongestionControllerTest() override {
+    // Removing a member splits the estimate again.
+    testing::Mock::VerifyAndClearExpectations(&first_);
+    testing::Mock::VerifyAndClearExpectations(&second_);
+    shared_->RemoveMember(&first_);
+    shared_->RemoveMember(&second_);
+  }
+
+  void ExpectBitrate(test::MockCongestionObserver* member,
+                     uint32_t bitrate_bps) {
+    EXPECT_CALL(*member, OnNetworkChanged(bitrate_bps, kFractionLoss, kRttMs,
+                                          kProbingIntervalMs));
+  }
+
+  SimulatedClock clock_;
+  RtcEventLogNullImpl event_log_;
+  NiceMock<test::MockCongestionObserver> first_;
+  NiceMock<test::MockCongestionObserver> second_;
+  rtc::scoped_refptr<SharedCongestionControllerImpl> shared_;
+};
+
+TEST_F(SharedCongestionControllerTest, SplitsEvenlyAboveMinSendBitrates) {
+  shared_->SignalNetworkState(&first_, kNetworkUp, true);
+  shared_->SignalNetworkState(&second_, kNetworkUp, true);
+  shared_->SetAllocatedSendBitrateLimits(&first_, 100000, 0);
+  shared_->SetAllocatedSendBitrateLimits(&second_, 300000, 0);
+
+  ExpectBitrate(&first_, 300000);
+  ExpectBitrate(&second_, 500000);
+  shared_->OnNetworkChanged(800000, kFractionLoss, kRttMs, kProbingIntervalMs);
+}
+
+TEST_F(SharedCongestionControllerTest, ScalesMinSendBitratesWhenLow) {
+  shared_->SignalNetworkState(&first_, kNetworkUp, true);
+  shared_->SignalNetworkState(&second_, kNetworkUp, true);
+  shared_->SetAllocatedSendBitrateLimits(&first_, 100000, 0);
+  shared_->SetAllocatedSendBitrateLimits(&second_, 300000, 0);
+
+  ExpectBitrate(&first_, 50000);
+  ExpectBitrate(&second_, 150000);
+  shared_->OnNetworkChanged(200000, kFractionLoss, kRttMs, kProbingIntervalMs);
+}
+
+TEST_F(SharedCongestionControllerTest, OnlySendingMembersGetBitrate) {
+  shared_->SignalNetworkState(&first_, kNetworkUp, true);
+  shared_->SignalNetworkState(&second_, kNetworkUp, false);
+  shared_->SetAllocatedSendBitrateLimits(&first_, 100000, 0);
+
+  ExpectBitrate(&first_, 800000);
+  ExpectBitrate(&second_, 0);
+  shared_->OnNetworkChanged(800000, kFractionLoss, kRttMs, kProbingIntervalMs);
+}
+
+TEST_F(SharedCongestionControllerTest, ResplitsWhenMemberStopsSending) {
+  shared_->SignalNetworkState(&first_, kNetworkUp, true);
+  shared_->SignalNetworkState(&second_, kNetworkUp, true);
+  shared_->OnNetworkChanged(800000, kFractionLoss, kRttMs, kProbingIntervalMs);
+
+  ExpectBitrate(&first_, 800000);
+  ExpectBitrate(&second_, 0);
+  shared_->SignalNetworkState(&second_, kNetworkDown, true);
+}
+
+}  // namespace webrtc
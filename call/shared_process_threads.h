@@ -0,0 +1,33 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_CALL_SHARED_PROCESS_THREADS_H_
+#define WEBRTC_CALL_SHARED_PROCESS_THREADS_H_
+
+#include "webrtc/base/refcount.h"
+#include "webrtc/base/scoped_ref_ptr.h"
+
+namespace webrtc {
+
+// SharedProcessThreads holds a module process thread and a pacer thread that
+// several instances of webrtc::Call run their modules on, instead of each
+// Call starting a pair of its own. The modules of all the Calls and of their
+// streams are then processed by the same two threads.
+// It must be created, and its last reference released, on the thread the
+// Calls are created on.
+class SharedProcessThreads : public rtc::RefCountInterface {
+ public:
+  static rtc::scoped_refptr<SharedProcessThreads> Create();
+
+  virtual ~SharedProcessThreads() {}
+};
+}  // namespace webrtc
+
+#endif  // WEBRTC_CALL_SHARED_PROCESS_THREADS_H_
@@ -0,0 +1,37 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/call/shared_process_threads_impl.h"
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/refcountedobject.h"
+
+namespace webrtc {
+
+rtc::scoped_refptr<SharedProcessThreads> SharedProcessThreads::Create() {
+  return rtc::scoped_refptr<SharedProcessThreads>(
+      new rtc::RefCountedObject<SharedProcessThreadsImpl>());
+}
+
+SharedProcessThreadsImpl::SharedProcessThreadsImpl()
+    : module_process_thread_(
+          ProcessThread::Create("SharedModuleProcessThread")),
+      pacer_thread_(ProcessThread::Create("SharedPacerThread")) {
+  module_process_thread_->Start();
+  pacer_thread_->Start();
+}
+
+SharedProcessThreadsImpl::~SharedProcessThreadsImpl() {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  pacer_thread_->Stop();
+  module_process_thread_->Stop();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,45 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_CALL_SHARED_PROCESS_THREADS_IMPL_H_
+#define WEBRTC_CALL_SHARED_PROCESS_THREADS_IMPL_H_
+
+#include <memory>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/thread_checker.h"
+#include "webrtc/call/shared_process_threads.h"
+#include "webrtc/modules/utility/include/process_thread.h"
+
+namespace webrtc {
+
+// Starts both threads on construction and stops them on destruction, the
+// Calls only register and deregister their modules.
+class SharedProcessThreadsImpl : public SharedProcessThreads {
+ public:
+  SharedProcessThreadsImpl();
+  ~SharedProcessThreadsImpl() override;
+
+  ProcessThread* module_process_thread() const {
+    return module_process_thread_.get();
+  }
+  ProcessThread* pacer_thread() const { return pacer_thread_.get(); }
+
+ private:
+  rtc::ThreadChecker thread_checker_;
+  const std::unique_ptr<ProcessThread> module_process_thread_;
+  const std::unique_ptr<ProcessThread> pacer_thread_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(SharedProcessThreadsImpl);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_CALL_SHARED_PROCESS_THREADS_IMPL_H_
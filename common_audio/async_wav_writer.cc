@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/async_wav_writer.h"
+
+#include <algorithm>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// 64 KiB of samples per write.
+const size_t kChunkSamples = 32768;
+
+}  // namespace
+
+const int AsyncWavWriterQueue::kDefaultDrainIntervalMs;
+const int AsyncWavWriter::kDefaultBufferMs;
+
+AsyncWavWriterQueue::AsyncWavWriterQueue(int drain_interval_ms)
+    : drain_interval_ms_(drain_interval_ms), queue_("AsyncWavWriterQueue") {
+  RTC_DCHECK_GT(drain_interval_ms, 0);
+  queue_.PostDelayedTask([this]() { Drain(); }, drain_interval_ms_);
+}
+
+AsyncWavWriterQueue::~AsyncWavWriterQueue() {
+  rtc::CritScope cs(&lock_);
+  RTC_DCHECK(writers_.empty());
+}
+
+void AsyncWavWriterQueue::AddWriter(AsyncWavWriter* writer) {
+  rtc::CritScope cs(&lock_);
+  writers_.push_back(writer);
+}
+
+void AsyncWavWriterQueue::RemoveWriter(AsyncWavWriter* writer) {
+  rtc::CritScope cs(&lock_);
+  auto it = std::find(writers_.begin(), writers_.end(), writer);
+  RTC_DCHECK(it != writers_.end());
+  writers_.erase(it);
+}
+
+void AsyncWavWriterQueue::Drain() {
+  RTC_DCHECK(queue_.IsCurrent());
+  {
+    rtc::CritScope cs(&lock_);
+    for (AsyncWavWriter* writer : writers_)
+      writer->DrainToFile(false);
+  }
+  queue_.PostDelayedTask([this]() { Drain(); }, drain_interval_ms_);
+}
+
+AsyncWavWriter::AsyncWavWriter(AsyncWavWriterQueue* queue,
+                               const std::string& filename,
+                               int sample_rate,
+                               size_t num_channels,
+                               int buffer_ms)
+    : queue_(queue),
+      buffer_(static_cast<size_t>(sample_rate * buffer_ms / 1000) *
+              num_channels),
+      dropped_samples_(0),
+      wav_writer_(filename, sample_rate, num_channels),
+      chunk_(new int16_t[kChunkSamples]),
+      chunk_size_(0) {
+  RTC_DCHECK(queue);
+  queue_->AddWriter(this);
+}
+
+AsyncWavWriter::~AsyncWavWriter() {
+  queue_->RemoveWriter(this);
+  DrainToFile(true);
+}
+
+size_t AsyncWavWriter::WriteSamples(const int16_t* samples,
+                                    size_t num_samples) {
+  const size_t written = buffer_.Write(samples, num_samples);
+  if (written < num_samples) {
+    rtc::AtomicOps::ReleaseStore(
+        &dropped_samples_,
+        rtc::AtomicOps::AcquireLoad(&dropped_samples_) +
+            static_cast<int>(num_samples - written));
+  }
+  return written;
+}
+
+int AsyncWavWriter::dropped_samples() const {
+  return rtc::AtomicOps::AcquireLoad(&dropped_samples_);
+}
+
+void AsyncWavWriter::DrainToFile(bool flush) {
+  while (true) {
+    chunk_size_ +=
+        buffer_.Read(&chunk_[chunk_size_], kChunkSamples - chunk_size_);
+    if (chunk_size_ < kChunkSamples)
+      break;
+    wav_writer_.WriteSamples(chunk_.get(), chunk_size_);
+    chunk_size_ = 0;
+  }
+  if (flush && chunk_size_ > 0) {
+    wav_writer_.WriteSamples(chunk_.get(), chunk_size_);
+    chunk_size_ = 0;
+  }
+}
+
+}  // namespace webrtc
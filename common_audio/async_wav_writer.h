@@ -0,0 +1,106 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_COMMON_AUDIO_ASYNC_WAV_WRITER_H_
+#define WEBRTC_COMMON_AUDIO_ASYNC_WAV_WRITER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/task_queue.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/common_audio/spsc_ring_buffer.h"
+#include "webrtc/common_audio/wav_file.h"
+
+namespace webrtc {
+
+class AsyncWavWriter;
+
+// A task queue that periodically moves the buffered samples of any number of
+// AsyncWavWriters to their files, so that recording many tracks needs a
+// single I/O thread.
+class AsyncWavWriterQueue {
+ public:
+  static const int kDefaultDrainIntervalMs = 100;
+
+  explicit AsyncWavWriterQueue(int drain_interval_ms = kDefaultDrainIntervalMs);
+  ~AsyncWavWriterQueue();
+
+  // Called by AsyncWavWriter. RemoveWriter() blocks until a drain that is in
+  // progress has finished.
+  void AddWriter(AsyncWavWriter* writer);
+  void RemoveWriter(AsyncWavWriter* writer);
+
+ private:
+  void Drain();
+
+  const int drain_interval_ms_;
+  rtc::CriticalSection lock_;
+  std::vector<AsyncWavWriter*> writers_ GUARDED_BY(lock_);
+  // Declared last so that no drain runs while the members above are
+  // destroyed.
+  rtc::TaskQueue queue_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(AsyncWavWriterQueue);
+};
+
+// Writes 16-bit PCM WAV files like WavWriter, but without ever touching the
+// file system on the thread that provides the samples. WriteSamples() copies
+// the samples into a lock-free ring, which an AsyncWavWriterQueue drains into
+// the file in large chunks. If the queue falls behind by more than the ring
+// holds, samples are dropped rather than blocking the caller.
+class AsyncWavWriter final {
+ public:
+  static const int kDefaultBufferMs = 2000;
+
+  // Opens the file on the calling thread. |queue| must outlive the writer.
+  AsyncWavWriter(AsyncWavWriterQueue* queue,
+                 const std::string& filename,
+                 int sample_rate,
+                 size_t num_channels,
+                 int buffer_ms = kDefaultBufferMs);
+
+  // Writes the remaining samples and closes the file on the calling thread,
+  // which should therefore not be a real-time audio thread.
+  ~AsyncWavWriter();
+
+  // Must only be called from one thread at a time. Never blocks. Returns the
+  // number of samples accepted; the rest of the |num_samples| interleaved
+  // samples are dropped.
+  size_t WriteSamples(const int16_t* samples, size_t num_samples);
+
+  // Number of samples dropped so far because the ring was full.
+  int dropped_samples() const;
+
+ private:
+  friend class AsyncWavWriterQueue;
+
+  // Moves samples from |buffer_| to |wav_writer_| in chunks of
+  // kChunkSamples. If |flush| is true, the last partial chunk is written as
+  // well.
+  void DrainToFile(bool flush);
+
+  AsyncWavWriterQueue* const queue_;
+  SpscRingBuffer buffer_;
+  volatile int dropped_samples_;
+  // Only accessed while draining.
+  WavWriter wav_writer_;
+  const std::unique_ptr<int16_t[]> chunk_;
+  size_t chunk_size_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(AsyncWavWriter);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_COMMON_AUDIO_ASYNC_WAV_WRITER_H_
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/async_wav_writer.h"
+
+#include <vector>
+
+#include "webrtc/common_audio/wav_file.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/fileutils.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kSampleRate = 48000;
+const size_t kNumChannels = 2;
+const size_t kSamplesPer10Ms = kSampleRate / 100 * kNumChannels;
+
+void ExpectFileContents(const std::string& filename,
+                        const std::vector<int16_t>& expected) {
+  WavReader reader(filename);
+  EXPECT_EQ(kSampleRate, reader.sample_rate());
+  EXPECT_EQ(kNumChannels, reader.num_channels());
+  ASSERT_EQ(expected.size(), reader.num_samples());
+  std::vector<int16_t> contents(expected.size());
+  EXPECT_EQ(expected.size(),
+            reader.ReadSamples(contents.size(), contents.data()));
+  EXPECT_EQ(expected, contents);
+}
+
+}  // namespace
+
+TEST(AsyncWavWriterTest, WritesAllSamples) {
+  const std::string outfile = test::OutputPath() + "asyncwavtest1.wav";
+  std::vector<int16_t> samples(100 * kSamplesPer10Ms);
+  for (size_t i = 0; i < samples.size(); ++i)
+    samples[i] = static_cast<int16_t>(i * 7);
+
+  AsyncWavWriterQueue queue(10);
+  {
+    AsyncWavWriter writer(&queue, outfile, kSampleRate, kNumChannels);
+    for (size_t i = 0; i < samples.size(); i += kSamplesPer10Ms) {
+      EXPECT_EQ(kSamplesPer10Ms,
+                writer.WriteSamples(&samples[i], kSamplesPer10Ms));
+    }
+    EXPECT_EQ(0, writer.dropped_samples());
+  }
+  ExpectFileContents(outfile, samples);
+}
+
+// The queue never drains in time here, so everything beyond the 100 ms ring
+// is dropped and only the remaining samples end up in the file.
+TEST(AsyncWavWriterTest, DropsSamplesWhenTheBufferIsFull) {
+  const std::string outfile = test::OutputPath() + "asyncwavtest2.wav";
+  std::vector<int16_t> samples(20 * kSamplesPer10Ms, 1);
+
+  AsyncWavWriterQueue queue(60 * 1000);
+  {
+    AsyncWavWriter writer(&queue, outfile, kSampleRate, kNumChannels, 100);
+    size_t accepted = 0;
+    for (size_t i = 0; i < samples.size(); i += kSamplesPer10Ms)
+      accepted += writer.WriteSamples(&samples[i], kSamplesPer10Ms);
+    EXPECT_EQ(10 * kSamplesPer10Ms, accepted);
+    EXPECT_EQ(static_cast<int>(10 * kSamplesPer10Ms),
+              writer.dropped_samples());
+  }
+  ExpectFileContents(outfile,
+                     std::vector<int16_t>(10 * kSamplesPer10Ms, 1));
+}
+
+}  // namespace webrtc
@@ -15,6 +15,7 @@
 #include <memory>
 
 #include "webrtc/base/checks.h"
+#include "webrtc/common_audio/fir_filter_avx2.h"
 #include "webrtc/common_audio/fir_filter_neon.h"
 #include "webrtc/common_audio/fir_filter_sse.h"
 #include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
@@ -44,20 +45,26 @@ FIRFilter* FIRFilter::Create(const float* coefficients,
   }
 
   FIRFilter* filter = NULL;
-// If we know the minimum architecture at compile time, avoid CPU detection.
 #if defined(WEBRTC_ARCH_X86_FAMILY)
+  // x86 CPU detection required for AVX2 and FMA3, which are newer than any
+  // compile time baseline.
+  if (WebRtc_GetCPUInfo(kAVX2) && WebRtc_GetCPUInfo(kFMA3)) {
+    filter =
+        new FIRFilterAVX2(coefficients, coefficients_length, max_input_length);
+  } else {
+// If we know the minimum architecture at compile time, avoid CPU detection.
 #if defined(__SSE2__)
-  filter =
-      new FIRFilterSSE2(coefficients, coefficients_length, max_input_length);
-#else
-  // x86 CPU detection required.
-  if (WebRtc_GetCPUInfo(kSSE2)) {
     filter =
         new FIRFilterSSE2(coefficients, coefficients_length, max_input_length);
-  } else {
-    filter = new FIRFilterC(coefficients, coefficients_length);
-  }
+#else
+    if (WebRtc_GetCPUInfo(kSSE2)) {
+      filter = new FIRFilterSSE2(coefficients, coefficients_length,
+                                 max_input_length);
+    } else {
+      filter = new FIRFilterC(coefficients, coefficients_length);
+    }
 #endif
+  }
 #elif defined(WEBRTC_HAS_NEON)
   filter =
       new FIRFilterNEON(coefficients, coefficients_length, max_input_length);
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+#include <string>
+
+#include "webrtc/common_audio/real_fourier.h"
+#include "webrtc/common_audio/real_fourier_ooura.h"
+#include "webrtc/common_audio/real_fourier_radix4.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+constexpr int kNumIterations = 100000;
+
+// Returns the average time in microseconds of a forward and an inverse
+// transform.
+double TimeTransforms(const RealFourier& fft) {
+  const int length = static_cast<int>(RealFourier::FftLength(fft.order()));
+  RealFourier::fft_real_scoper real = RealFourier::AllocRealBuffer(length);
+  RealFourier::fft_cplx_scoper cplx = RealFourier::AllocCplxBuffer(
+      static_cast<int>(RealFourier::ComplexLength(fft.order())));
+  for (int i = 0; i < length; ++i)
+    real[i] = (i % 7) - 3.f;
+
+  Clock* clock = Clock::GetRealTimeClock();
+  int64_t start_time_us = clock->TimeInMicroseconds();
+  for (int i = 0; i < kNumIterations; ++i) {
+    fft.Forward(real.get(), cplx.get());
+    fft.Inverse(cplx.get(), real.get());
+  }
+  return static_cast<double>(clock->TimeInMicroseconds() - start_time_us) /
+         kNumIterations;
+}
+}  // namespace
+
+// Time of a forward and an inverse transform of the sizes used by the audio
+// processing, with the Ooura and the radix-4 implementations. The radix-4 one
+// only uses SIMD stages on CPUs with AVX2 or NEON.
+TEST(RealFourierPerformanceTest, ForwardAndInverse) {
+  for (int order : {7, 8, 9}) {
+    const std::string trace =
+        std::to_string(RealFourier::FftLength(order)) + "_points";
+    test::PrintResult("real_fourier_ooura", "", trace,
+                      TimeTransforms(RealFourierOoura(order)), "us", false);
+    test::PrintResult("real_fourier_radix4", "", trace,
+                      TimeTransforms(RealFourierRadix4(order)), "us", false);
+  }
+}
+
+}  // namespace webrtc
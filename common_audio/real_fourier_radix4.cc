@@ -0,0 +1,232 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/real_fourier_radix4.h"
+
+#include <cmath>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+
+using std::complex;
+
+namespace {
+
+const double kPi = 3.14159265358979323846;
+
+Radix4StageFunction GetSimdStage() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2) != 0)
+    return Radix4Stage_AVX2;
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  return Radix4Stage_NEON;
+#else
+  return nullptr;
+#endif
+}
+
+// The last stage of odd-length radix-4 decompositions: a radix-2 stage whose
+// twiddle factors all are 1.
+void Radix2LastStage(size_t s,
+                     const float* xr,
+                     const float* xi,
+                     float* yr,
+                     float* yi) {
+  for (size_t q = 0; q < s; ++q) {
+    yr[q] = xr[q] + xr[q + s];
+    yi[q] = xi[q] + xi[q + s];
+    yr[q + s] = xr[q] - xr[q + s];
+    yi[q + s] = xi[q] - xi[q + s];
+  }
+}
+
+}  // namespace
+
+void Radix4Stage(size_t n1,
+                 size_t s,
+                 const float* xr,
+                 const float* xi,
+                 float* yr,
+                 float* yi,
+                 const float* w) {
+  const size_t m = n1 * s;
+  for (size_t p = 0; p < n1; ++p) {
+    const float w1r = w[p];
+    const float w1i = w[n1 + p];
+    const float w2r = w[2 * n1 + p];
+    const float w2i = w[3 * n1 + p];
+    const float w3r = w[4 * n1 + p];
+    const float w3i = w[5 * n1 + p];
+    const float* ar = xr + s * p;
+    const float* ai = xi + s * p;
+    float* y0r = yr + 4 * s * p;
+    float* y0i = yi + 4 * s * p;
+    for (size_t q = 0; q < s; ++q) {
+      const float apcr = ar[q] + ar[q + 2 * m];
+      const float apci = ai[q] + ai[q + 2 * m];
+      const float amcr = ar[q] - ar[q + 2 * m];
+      const float amci = ai[q] - ai[q + 2 * m];
+      const float bpdr = ar[q + m] + ar[q + 3 * m];
+      const float bpdi = ai[q + m] + ai[q + 3 * m];
+      const float bmdr = ar[q + m] - ar[q + 3 * m];
+      const float bmdi = ai[q + m] - ai[q + 3 * m];
+      // t1 = (a - c) - i * (b - d), t2 = (a + c) - (b + d) and
+      // t3 = (a - c) + i * (b - d).
+      const float t1r = amcr + bmdi;
+      const float t1i = amci - bmdr;
+      const float t2r = apcr - bpdr;
+      const float t2i = apci - bpdi;
+      const float t3r = amcr - bmdi;
+      const float t3i = amci + bmdr;
+      y0r[q] = apcr + bpdr;
+      y0i[q] = apci + bpdi;
+      y0r[q + s] = w1r * t1r - w1i * t1i;
+      y0i[q + s] = w1r * t1i + w1i * t1r;
+      y0r[q + 2 * s] = w2r * t2r - w2i * t2i;
+      y0i[q + 2 * s] = w2r * t2i + w2i * t2r;
+      y0r[q + 3 * s] = w3r * t3r - w3i * t3i;
+      y0i[q + 3 * s] = w3r * t3i + w3i * t3r;
+    }
+  }
+}
+
+RealFourierRadix4::RealFourierRadix4(int fft_order)
+    : order_(fft_order),
+      length_(FftLength(order_)),
+      complex_length_(ComplexLength(order_)),
+      stage_simd_(GetSimdStage()),
+      work_re_(AllocRealBuffer(static_cast<int>(length_))),
+      work_im_(AllocRealBuffer(static_cast<int>(length_))) {
+  RTC_CHECK_GE(fft_order, 2);
+  const size_t half_length = length_ / 2;
+
+  for (size_t n = half_length; n >= 4; n /= 4) {
+    const size_t n1 = n / 4;
+    const size_t offset = stage_twiddles_.size();
+    stage_twiddles_.resize(offset + 6 * n1);
+    float* w = &stage_twiddles_[offset];
+    for (size_t p = 0; p < n1; ++p) {
+      for (size_t k = 1; k <= 3; ++k) {
+        const double angle = -2.0 * kPi * k * p / n;
+        w[(2 * k - 2) * n1 + p] = static_cast<float>(std::cos(angle));
+        w[(2 * k - 1) * n1 + p] = static_cast<float>(std::sin(angle));
+      }
+    }
+  }
+
+  split_twiddles_re_.resize(half_length);
+  split_twiddles_im_.resize(half_length);
+  for (size_t k = 0; k < half_length; ++k) {
+    const double angle = -2.0 * kPi * k / length_;
+    split_twiddles_re_[k] = static_cast<float>(std::cos(angle));
+    split_twiddles_im_[k] = static_cast<float>(std::sin(angle));
+  }
+}
+
+RealFourierRadix4::~RealFourierRadix4() = default;
+
+bool RealFourierRadix4::IsPreferredForOrder(int fft_order) {
+  return fft_order >= 7 && fft_order <= 9 && GetSimdStage() != nullptr;
+}
+
+size_t RealFourierRadix4::ComplexFft() const {
+  const size_t half_length = length_ / 2;
+  size_t in = 0;
+  size_t s = 1;
+  const float* w = stage_twiddles_.data();
+  for (size_t n = half_length; n >= 4; n /= 4) {
+    const size_t n1 = n / 4;
+    const float* xr = &work_re_[in * half_length];
+    const float* xi = &work_im_[in * half_length];
+    float* yr = &work_re_[(1 - in) * half_length];
+    float* yi = &work_im_[(1 - in) * half_length];
+    if (stage_simd_ && (s % 4 == 0 || (s == 1 && n1 % 4 == 0))) {
+      stage_simd_(n1, s, xr, xi, yr, yi, w);
+    } else {
+      Radix4Stage(n1, s, xr, xi, yr, yi, w);
+    }
+    w += 6 * n1;
+    s *= 4;
+    in = 1 - in;
+  }
+  if (s < half_length) {
+    RTC_DCHECK_EQ(2 * s, half_length);
+    Radix2LastStage(s, &work_re_[in * half_length],
+                    &work_im_[in * half_length],
+                    &work_re_[(1 - in) * half_length],
+                    &work_im_[(1 - in) * half_length]);
+    in = 1 - in;
+  }
+  return in;
+}
+
+void RealFourierRadix4::Forward(const float* src, complex<float>* dest) const {
+  const size_t half_length = length_ / 2;
+  // Pack even samples as real and odd samples as imaginary parts.
+  for (size_t n = 0; n < half_length; ++n) {
+    work_re_[n] = src[2 * n];
+    work_im_[n] = src[2 * n + 1];
+  }
+
+  const size_t out = ComplexFft();
+  const float* zr = &work_re_[out * half_length];
+  const float* zi = &work_im_[out * half_length];
+
+  dest[0] = complex<float>(zr[0] + zi[0], 0.0f);
+  dest[half_length] = complex<float>(zr[0] - zi[0], 0.0f);
+  for (size_t k = 1; k < half_length; ++k) {
+    // The transforms of the even and odd samples are
+    // E = (Z[k] + conj(Z[N/2 - k])) / 2 and
+    // O = (Z[k] - conj(Z[N/2 - k])) / 2i.
+    const float er = 0.5f * (zr[k] + zr[half_length - k]);
+    const float ei = 0.5f * (zi[k] - zi[half_length - k]);
+    const float or_ = 0.5f * (zi[k] + zi[half_length - k]);
+    const float oi = -0.5f * (zr[k] - zr[half_length - k]);
+    const float wr = split_twiddles_re_[k];
+    const float wi = split_twiddles_im_[k];
+    dest[k] = complex<float>(er + wr * or_ - wi * oi, ei + wr * oi + wi * or_);
+  }
+}
+
+void RealFourierRadix4::Inverse(const complex<float>* src, float* dest) const {
+  const size_t half_length = length_ / 2;
+  // Reverse the split of Forward(), Z[k] = E + i * O, and conjugate so that
+  // the inverse transform can be computed with the forward one.
+  for (size_t k = 0; k < half_length; ++k) {
+    const complex<float> x = src[k];
+    const complex<float> y = src[half_length - k];
+    const float er = 0.5f * (x.real() + y.real());
+    const float ei = 0.5f * (x.imag() - y.imag());
+    const float dr = 0.5f * (x.real() - y.real());
+    const float di = 0.5f * (x.imag() + y.imag());
+    // O = D * conj(W^k).
+    const float wr = split_twiddles_re_[k];
+    const float wi = split_twiddles_im_[k];
+    const float or_ = dr * wr + di * wi;
+    const float oi = di * wr - dr * wi;
+    work_re_[k] = er - oi;
+    work_im_[k] = -(ei + or_);
+  }
+
+  const size_t out = ComplexFft();
+  const float* zr = &work_re_[out * half_length];
+  const float* zi = &work_im_[out * half_length];
+
+  const float scale = 1.0f / half_length;
+  for (size_t n = 0; n < half_length; ++n) {
+    dest[2 * n] = scale * zr[n];
+    dest[2 * n + 1] = -scale * zi[n];
+  }
+}
+
+}  // namespace webrtc
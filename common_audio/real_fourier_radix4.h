@@ -0,0 +1,112 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_COMMON_AUDIO_REAL_FOURIER_RADIX4_H_
+#define WEBRTC_COMMON_AUDIO_REAL_FOURIER_RADIX4_H_
+
+#include <complex>
+#include <vector>
+
+#include "webrtc/common_audio/real_fourier.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+// Computes one radix-4 Stockham autosort stage of a forward complex FFT on
+// split real/imaginary arrays. The input consists of four quarters of |n1|
+// blocks of |s| elements each; the output of |4 * n1| blocks of |s| elements.
+// |w| holds the twiddle factors of the stage as six consecutive arrays of |n1|
+// elements: w1 real, w1 imaginary, w2 real, w2 imaginary, w3 real and w3
+// imaginary.
+typedef void (*Radix4StageFunction)(size_t n1,
+                                    size_t s,
+                                    const float* xr,
+                                    const float* xi,
+                                    float* yr,
+                                    float* yi,
+                                    const float* w);
+
+void Radix4Stage(size_t n1,
+                 size_t s,
+                 const float* xr,
+                 const float* xi,
+                 float* yr,
+                 float* yi,
+                 const float* w);
+
+// SIMD versions of Radix4Stage(). They require |s| to be a multiple of 4, or
+// |s| to be 1 and |n1| a multiple of 4.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void Radix4Stage_AVX2(size_t n1,
+                      size_t s,
+                      const float* xr,
+                      const float* xi,
+                      float* yr,
+                      float* yi,
+                      const float* w);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+void Radix4Stage_NEON(size_t n1,
+                      size_t s,
+                      const float* xr,
+                      const float* xi,
+                      float* yr,
+                      float* yi,
+                      const float* w);
+#endif
+
+// Real FFT in the style of pffft. The real input is packed into a complex
+// sequence of half the length, which is transformed by radix-4 Stockham
+// stages (and a final radix-2 stage for even orders) on split real/imaginary
+// arrays, so that the butterflies map directly onto SIMD registers. The
+// spectrum of the real input is then recovered in a single pass.
+class RealFourierRadix4 : public RealFourier {
+ public:
+  // |fft_order| must be at least 2.
+  explicit RealFourierRadix4(int fft_order);
+  ~RealFourierRadix4() override;
+
+  // Returns true if RealFourier::Create() should pick this implementation
+  // over the default one for |fft_order|, i.e. if there is a SIMD stage
+  // implementation for the CPU and the order is one of those used by the
+  // audio processing (128, 256 and 512 points).
+  static bool IsPreferredForOrder(int fft_order);
+
+  void Forward(const float* src, std::complex<float>* dest) const override;
+  void Inverse(const std::complex<float>* src, float* dest) const override;
+
+  int order() const override { return order_; }
+
+ private:
+  // Computes the forward complex FFT of the |length_ / 2| elements in the
+  // first halves of |work_re_| and |work_im_|. Returns the index of the work
+  // buffer half that holds the result.
+  size_t ComplexFft() const;
+
+  const int order_;
+  const size_t length_;
+  const size_t complex_length_;
+  Radix4StageFunction stage_simd_;
+  // Twiddle factors of the radix-4 stages, in the layout expected by
+  // Radix4StageFunction, one stage after the other.
+  std::vector<float> stage_twiddles_;
+  // exp(-2 * pi * i * k / length_) for k < length_ / 2, used to split the
+  // packed transform into the spectrum of the real signal.
+  std::vector<float> split_twiddles_re_;
+  std::vector<float> split_twiddles_im_;
+  // Two split real/imaginary buffers of |length_ / 2| elements each, used in
+  // turn as input and output of the stages.
+  const fft_real_scoper work_re_;
+  const fft_real_scoper work_im_;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_COMMON_AUDIO_REAL_FOURIER_RADIX4_H_
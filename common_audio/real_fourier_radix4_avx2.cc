@@ -0,0 +1,202 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/real_fourier_radix4.h"
+
+#include <immintrin.h>
+
+#include "webrtc/base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// The radix-4 butterfly of Radix4Stage() on vectors of eight elements.
+struct Butterfly256 {
+  __m256 y0r, y0i, t1r, t1i, t2r, t2i, t3r, t3i;
+};
+
+inline Butterfly256 ComputeButterfly256(const float* ar,
+                                        const float* ai,
+                                        size_t m) {
+  const __m256 a_r = _mm256_loadu_ps(ar);
+  const __m256 a_i = _mm256_loadu_ps(ai);
+  const __m256 b_r = _mm256_loadu_ps(ar + m);
+  const __m256 b_i = _mm256_loadu_ps(ai + m);
+  const __m256 c_r = _mm256_loadu_ps(ar + 2 * m);
+  const __m256 c_i = _mm256_loadu_ps(ai + 2 * m);
+  const __m256 d_r = _mm256_loadu_ps(ar + 3 * m);
+  const __m256 d_i = _mm256_loadu_ps(ai + 3 * m);
+  const __m256 apcr = _mm256_add_ps(a_r, c_r);
+  const __m256 apci = _mm256_add_ps(a_i, c_i);
+  const __m256 amcr = _mm256_sub_ps(a_r, c_r);
+  const __m256 amci = _mm256_sub_ps(a_i, c_i);
+  const __m256 bpdr = _mm256_add_ps(b_r, d_r);
+  const __m256 bpdi = _mm256_add_ps(b_i, d_i);
+  const __m256 bmdr = _mm256_sub_ps(b_r, d_r);
+  const __m256 bmdi = _mm256_sub_ps(b_i, d_i);
+  Butterfly256 r;
+  r.y0r = _mm256_add_ps(apcr, bpdr);
+  r.y0i = _mm256_add_ps(apci, bpdi);
+  r.t1r = _mm256_add_ps(amcr, bmdi);
+  r.t1i = _mm256_sub_ps(amci, bmdr);
+  r.t2r = _mm256_sub_ps(apcr, bpdr);
+  r.t2i = _mm256_sub_ps(apci, bpdi);
+  r.t3r = _mm256_sub_ps(amcr, bmdi);
+  r.t3i = _mm256_add_ps(amci, bmdr);
+  return r;
+}
+
+inline void StoreRotated256(__m256 tr,
+                            __m256 ti,
+                            __m256 wr,
+                            __m256 wi,
+                            float* yr,
+                            float* yi) {
+  _mm256_storeu_ps(yr, _mm256_sub_ps(_mm256_mul_ps(wr, tr),
+                                     _mm256_mul_ps(wi, ti)));
+  _mm256_storeu_ps(yi, _mm256_add_ps(_mm256_mul_ps(wr, ti),
+                                     _mm256_mul_ps(wi, tr)));
+}
+
+// The same butterfly on vectors of four elements.
+struct Butterfly128 {
+  __m128 y0r, y0i, t1r, t1i, t2r, t2i, t3r, t3i;
+};
+
+inline Butterfly128 ComputeButterfly128(const float* ar,
+                                        const float* ai,
+                                        size_t m) {
+  const __m128 a_r = _mm_loadu_ps(ar);
+  const __m128 a_i = _mm_loadu_ps(ai);
+  const __m128 b_r = _mm_loadu_ps(ar + m);
+  const __m128 b_i = _mm_loadu_ps(ai + m);
+  const __m128 c_r = _mm_loadu_ps(ar + 2 * m);
+  const __m128 c_i = _mm_loadu_ps(ai + 2 * m);
+  const __m128 d_r = _mm_loadu_ps(ar + 3 * m);
+  const __m128 d_i = _mm_loadu_ps(ai + 3 * m);
+  const __m128 apcr = _mm_add_ps(a_r, c_r);
+  const __m128 apci = _mm_add_ps(a_i, c_i);
+  const __m128 amcr = _mm_sub_ps(a_r, c_r);
+  const __m128 amci = _mm_sub_ps(a_i, c_i);
+  const __m128 bpdr = _mm_add_ps(b_r, d_r);
+  const __m128 bpdi = _mm_add_ps(b_i, d_i);
+  const __m128 bmdr = _mm_sub_ps(b_r, d_r);
+  const __m128 bmdi = _mm_sub_ps(b_i, d_i);
+  Butterfly128 r;
+  r.y0r = _mm_add_ps(apcr, bpdr);
+  r.y0i = _mm_add_ps(apci, bpdi);
+  r.t1r = _mm_add_ps(amcr, bmdi);
+  r.t1i = _mm_sub_ps(amci, bmdr);
+  r.t2r = _mm_sub_ps(apcr, bpdr);
+  r.t2i = _mm_sub_ps(apci, bpdi);
+  r.t3r = _mm_sub_ps(amcr, bmdi);
+  r.t3i = _mm_add_ps(amci, bmdr);
+  return r;
+}
+
+inline __m128 RotateReal128(__m128 tr, __m128 ti, __m128 wr, __m128 wi) {
+  return _mm_sub_ps(_mm_mul_ps(wr, tr), _mm_mul_ps(wi, ti));
+}
+
+inline __m128 RotateImag128(__m128 tr, __m128 ti, __m128 wr, __m128 wi) {
+  return _mm_add_ps(_mm_mul_ps(wr, ti), _mm_mul_ps(wi, tr));
+}
+
+}  // namespace
+
+void Radix4Stage_AVX2(size_t n1,
+                      size_t s,
+                      const float* xr,
+                      const float* xi,
+                      float* yr,
+                      float* yi,
+                      const float* w) {
+  const size_t m = n1 * s;
+  if (s == 1) {
+    // First stage: vectorize over p and transpose the four outputs of each
+    // group of four butterflies so that they can be stored contiguously.
+    RTC_DCHECK_EQ(0, n1 % 4);
+    for (size_t p = 0; p < n1; p += 4) {
+      const Butterfly128 b = ComputeButterfly128(xr + p, xi + p, m);
+      __m128 r0 = b.y0r;
+      __m128 r1 = RotateReal128(b.t1r, b.t1i, _mm_loadu_ps(w + p),
+                                _mm_loadu_ps(w + n1 + p));
+      __m128 r2 = RotateReal128(b.t2r, b.t2i, _mm_loadu_ps(w + 2 * n1 + p),
+                                _mm_loadu_ps(w + 3 * n1 + p));
+      __m128 r3 = RotateReal128(b.t3r, b.t3i, _mm_loadu_ps(w + 4 * n1 + p),
+                                _mm_loadu_ps(w + 5 * n1 + p));
+      __m128 i0 = b.y0i;
+      __m128 i1 = RotateImag128(b.t1r, b.t1i, _mm_loadu_ps(w + p),
+                                _mm_loadu_ps(w + n1 + p));
+      __m128 i2 = RotateImag128(b.t2r, b.t2i, _mm_loadu_ps(w + 2 * n1 + p),
+                                _mm_loadu_ps(w + 3 * n1 + p));
+      __m128 i3 = RotateImag128(b.t3r, b.t3i, _mm_loadu_ps(w + 4 * n1 + p),
+                                _mm_loadu_ps(w + 5 * n1 + p));
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      _MM_TRANSPOSE4_PS(i0, i1, i2, i3);
+      _mm_storeu_ps(yr + 4 * p, r0);
+      _mm_storeu_ps(yr + 4 * p + 4, r1);
+      _mm_storeu_ps(yr + 4 * p + 8, r2);
+      _mm_storeu_ps(yr + 4 * p + 12, r3);
+      _mm_storeu_ps(yi + 4 * p, i0);
+      _mm_storeu_ps(yi + 4 * p + 4, i1);
+      _mm_storeu_ps(yi + 4 * p + 8, i2);
+      _mm_storeu_ps(yi + 4 * p + 12, i3);
+    }
+    return;
+  }
+
+  RTC_DCHECK_EQ(0, s % 4);
+  for (size_t p = 0; p < n1; ++p) {
+    const float* ar = xr + s * p;
+    const float* ai = xi + s * p;
+    float* y0r = yr + 4 * s * p;
+    float* y0i = yi + 4 * s * p;
+    if (s % 8 == 0) {
+      const __m256 w1r = _mm256_set1_ps(w[p]);
+      const __m256 w1i = _mm256_set1_ps(w[n1 + p]);
+      const __m256 w2r = _mm256_set1_ps(w[2 * n1 + p]);
+      const __m256 w2i = _mm256_set1_ps(w[3 * n1 + p]);
+      const __m256 w3r = _mm256_set1_ps(w[4 * n1 + p]);
+      const __m256 w3i = _mm256_set1_ps(w[5 * n1 + p]);
+      for (size_t q = 0; q < s; q += 8) {
+        const Butterfly256 b = ComputeButterfly256(ar + q, ai + q, m);
+        _mm256_storeu_ps(y0r + q, b.y0r);
+        _mm256_storeu_ps(y0i + q, b.y0i);
+        StoreRotated256(b.t1r, b.t1i, w1r, w1i, y0r + q + s, y0i + q + s);
+        StoreRotated256(b.t2r, b.t2i, w2r, w2i, y0r + q + 2 * s,
+                        y0i + q + 2 * s);
+        StoreRotated256(b.t3r, b.t3i, w3r, w3i, y0r + q + 3 * s,
+                        y0i + q + 3 * s);
+      }
+    } else {
+      const __m128 w1r = _mm_set1_ps(w[p]);
+      const __m128 w1i = _mm_set1_ps(w[n1 + p]);
+      const __m128 w2r = _mm_set1_ps(w[2 * n1 + p]);
+      const __m128 w2i = _mm_set1_ps(w[3 * n1 + p]);
+      const __m128 w3r = _mm_set1_ps(w[4 * n1 + p]);
+      const __m128 w3i = _mm_set1_ps(w[5 * n1 + p]);
+      for (size_t q = 0; q < s; q += 4) {
+        const Butterfly128 b = ComputeButterfly128(ar + q, ai + q, m);
+        _mm_storeu_ps(y0r + q, b.y0r);
+        _mm_storeu_ps(y0i + q, b.y0i);
+        _mm_storeu_ps(y0r + q + s, RotateReal128(b.t1r, b.t1i, w1r, w1i));
+        _mm_storeu_ps(y0i + q + s, RotateImag128(b.t1r, b.t1i, w1r, w1i));
+        _mm_storeu_ps(y0r + q + 2 * s, RotateReal128(b.t2r, b.t2i, w2r, w2i));
+        _mm_storeu_ps(y0i + q + 2 * s, RotateImag128(b.t2r, b.t2i, w2r, w2i));
+        _mm_storeu_ps(y0r + q + 3 * s, RotateReal128(b.t3r, b.t3i, w3r, w3i));
+        _mm_storeu_ps(y0i + q + 3 * s, RotateImag128(b.t3r, b.t3i, w3r, w3i));
+      }
+    }
+  }
+}
+
+}  // namespace webrtc
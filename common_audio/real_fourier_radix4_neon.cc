@@ -0,0 +1,133 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/real_fourier_radix4.h"
+
+#include <arm_neon.h>
+
+#include "webrtc/base/checks.h"
+
+namespace webrtc {
+
+namespace {
+
+// The radix-4 butterfly of Radix4Stage() on vectors of four elements.
+struct Butterfly {
+  float32x4_t y0r, y0i, t1r, t1i, t2r, t2i, t3r, t3i;
+};
+
+inline Butterfly ComputeButterfly(const float* ar, const float* ai, size_t m) {
+  const float32x4_t a_r = vld1q_f32(ar);
+  const float32x4_t a_i = vld1q_f32(ai);
+  const float32x4_t b_r = vld1q_f32(ar + m);
+  const float32x4_t b_i = vld1q_f32(ai + m);
+  const float32x4_t c_r = vld1q_f32(ar + 2 * m);
+  const float32x4_t c_i = vld1q_f32(ai + 2 * m);
+  const float32x4_t d_r = vld1q_f32(ar + 3 * m);
+  const float32x4_t d_i = vld1q_f32(ai + 3 * m);
+  const float32x4_t apcr = vaddq_f32(a_r, c_r);
+  const float32x4_t apci = vaddq_f32(a_i, c_i);
+  const float32x4_t amcr = vsubq_f32(a_r, c_r);
+  const float32x4_t amci = vsubq_f32(a_i, c_i);
+  const float32x4_t bpdr = vaddq_f32(b_r, d_r);
+  const float32x4_t bpdi = vaddq_f32(b_i, d_i);
+  const float32x4_t bmdr = vsubq_f32(b_r, d_r);
+  const float32x4_t bmdi = vsubq_f32(b_i, d_i);
+  Butterfly r;
+  r.y0r = vaddq_f32(apcr, bpdr);
+  r.y0i = vaddq_f32(apci, bpdi);
+  r.t1r = vaddq_f32(amcr, bmdi);
+  r.t1i = vsubq_f32(amci, bmdr);
+  r.t2r = vsubq_f32(apcr, bpdr);
+  r.t2i = vsubq_f32(apci, bpdi);
+  r.t3r = vsubq_f32(amcr, bmdi);
+  r.t3i = vaddq_f32(amci, bmdr);
+  return r;
+}
+
+inline float32x4_t RotateReal(float32x4_t tr,
+                              float32x4_t ti,
+                              float32x4_t wr,
+                              float32x4_t wi) {
+  return vmlsq_f32(vmulq_f32(wr, tr), wi, ti);
+}
+
+inline float32x4_t RotateImag(float32x4_t tr,
+                              float32x4_t ti,
+                              float32x4_t wr,
+                              float32x4_t wi) {
+  return vmlaq_f32(vmulq_f32(wr, ti), wi, tr);
+}
+
+}  // namespace
+
+void Radix4Stage_NEON(size_t n1,
+                      size_t s,
+                      const float* xr,
+                      const float* xi,
+                      float* yr,
+                      float* yi,
+                      const float* w) {
+  const size_t m = n1 * s;
+  if (s == 1) {
+    // First stage: vectorize over p and let the interleaving stores put the
+    // four outputs of each butterfly next to each other.
+    RTC_DCHECK_EQ(0, n1 % 4);
+    for (size_t p = 0; p < n1; p += 4) {
+      const Butterfly b = ComputeButterfly(xr + p, xi + p, m);
+      const float32x4_t w1r = vld1q_f32(w + p);
+      const float32x4_t w1i = vld1q_f32(w + n1 + p);
+      const float32x4_t w2r = vld1q_f32(w + 2 * n1 + p);
+      const float32x4_t w2i = vld1q_f32(w + 3 * n1 + p);
+      const float32x4_t w3r = vld1q_f32(w + 4 * n1 + p);
+      const float32x4_t w3i = vld1q_f32(w + 5 * n1 + p);
+      float32x4x4_t real;
+      real.val[0] = b.y0r;
+      real.val[1] = RotateReal(b.t1r, b.t1i, w1r, w1i);
+      real.val[2] = RotateReal(b.t2r, b.t2i, w2r, w2i);
+      real.val[3] = RotateReal(b.t3r, b.t3i, w3r, w3i);
+      float32x4x4_t imag;
+      imag.val[0] = b.y0i;
+      imag.val[1] = RotateImag(b.t1r, b.t1i, w1r, w1i);
+      imag.val[2] = RotateImag(b.t2r, b.t2i, w2r, w2i);
+      imag.val[3] = RotateImag(b.t3r, b.t3i, w3r, w3i);
+      vst4q_f32(yr + 4 * p, real);
+      vst4q_f32(yi + 4 * p, imag);
+    }
+    return;
+  }
+
+  RTC_DCHECK_EQ(0, s % 4);
+  for (size_t p = 0; p < n1; ++p) {
+    const float* ar = xr + s * p;
+    const float* ai = xi + s * p;
+    float* y0r = yr + 4 * s * p;
+    float* y0i = yi + 4 * s * p;
+    const float32x4_t w1r = vdupq_n_f32(w[p]);
+    const float32x4_t w1i = vdupq_n_f32(w[n1 + p]);
+    const float32x4_t w2r = vdupq_n_f32(w[2 * n1 + p]);
+    const float32x4_t w2i = vdupq_n_f32(w[3 * n1 + p]);
+    const float32x4_t w3r = vdupq_n_f32(w[4 * n1 + p]);
+    const float32x4_t w3i = vdupq_n_f32(w[5 * n1 + p]);
+    for (size_t q = 0; q < s; q += 4) {
+      const Butterfly b = ComputeButterfly(ar + q, ai + q, m);
+      vst1q_f32(y0r + q, b.y0r);
+      vst1q_f32(y0i + q, b.y0i);
+      vst1q_f32(y0r + q + s, RotateReal(b.t1r, b.t1i, w1r, w1i));
+      vst1q_f32(y0i + q + s, RotateImag(b.t1r, b.t1i, w1r, w1i));
+      vst1q_f32(y0r + q + 2 * s, RotateReal(b.t2r, b.t2i, w2r, w2i));
+      vst1q_f32(y0i + q + 2 * s, RotateImag(b.t2r, b.t2i, w2r, w2i));
+      vst1q_f32(y0r + q + 3 * s, RotateReal(b.t3r, b.t3i, w3r, w3i));
+      vst1q_f32(y0i + q + 3 * s, RotateImag(b.t3r, b.t3i, w3r, w3i));
+    }
+  }
+}
+
+}  // namespace webrtc
@@ -12,8 +12,14 @@
 
 #include <stdlib.h>
 
+#include <cmath>
+#include <vector>
+
+#include "webrtc/base/random.h"
 #include "webrtc/common_audio/real_fourier_ooura.h"
 #include "webrtc/common_audio/real_fourier_openmax.h"
+#include "webrtc/common_audio/real_fourier_radix4.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/test/gtest.h"
 
 namespace webrtc {
@@ -73,7 +79,8 @@ using FftTypes = ::testing::Types<
 #if defined(RTC_USE_OPENMAX_DL)
     RealFourierOpenmax,
 #endif
-    RealFourierOoura>;
+    RealFourierOoura,
+    RealFourierRadix4>;
 TYPED_TEST_CASE(RealFourierTest, FftTypes);
 
 TYPED_TEST(RealFourierTest, SimpleForwardTransform) {
@@ -105,5 +112,81 @@ TYPED_TEST(RealFourierTest, SimpleBackwardTransform) {
   EXPECT_NEAR(this->real_buffer_[3], 4.0f, 1e-8f);
 }
 
+TEST(RealFourierRadix4Test, MatchesOoura) {
+  Random random(0x1234);
+  for (int order = 2; order <= 10; ++order) {
+    SCOPED_TRACE(order);
+    RealFourierOoura ooura(order);
+    RealFourierRadix4 radix4(order);
+    const int length = static_cast<int>(RealFourier::FftLength(order));
+    const int complex_length =
+        static_cast<int>(RealFourier::ComplexLength(order));
+    RealFourier::fft_real_scoper real = RealFourier::AllocRealBuffer(length);
+    RealFourier::fft_real_scoper result = RealFourier::AllocRealBuffer(length);
+    RealFourier::fft_cplx_scoper expected =
+        RealFourier::AllocCplxBuffer(complex_length);
+    RealFourier::fft_cplx_scoper actual =
+        RealFourier::AllocCplxBuffer(complex_length);
+    for (int i = 0; i < length; ++i)
+      real[i] = 2.f * random.Rand<float>() - 1.f;
+
+    ooura.Forward(real.get(), expected.get());
+    radix4.Forward(real.get(), actual.get());
+    // The error grows with the magnitude of the spectrum, i.e. with sqrt of
+    // the length for white noise.
+    const float tolerance = 1e-5f * std::sqrt(static_cast<float>(length));
+    for (int k = 0; k < complex_length; ++k) {
+      EXPECT_NEAR(expected[k].real(), actual[k].real(), tolerance);
+      EXPECT_NEAR(expected[k].imag(), actual[k].imag(), tolerance);
+    }
+
+    radix4.Inverse(actual.get(), result.get());
+    for (int i = 0; i < length; ++i)
+      EXPECT_NEAR(real[i], result[i], 1e-5f);
+  }
+}
+
+// Verifies that the SIMD stage, if any, gives the same result as the C one
+// for all the stage shapes used by the 128, 256 and 512 point transforms.
+TEST(RealFourierRadix4Test, SimdStageMatchesC) {
+  std::vector<Radix4StageFunction> simd_stages;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2) != 0)
+    simd_stages.push_back(Radix4Stage_AVX2);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+  simd_stages.push_back(Radix4Stage_NEON);
+#endif
+  Random random(0x5678);
+  for (size_t n : {64, 128, 256}) {
+    for (size_t s = 1; s < n; s *= 4) {
+      const size_t n1 = n / (4 * s);
+      if (n1 == 0 || (s % 4 != 0 && n1 % 4 != 0))
+        continue;
+      SCOPED_TRACE(n);
+      SCOPED_TRACE(s);
+      std::vector<float> xr(n), xi(n), w(6 * n1);
+      for (float& x : xr)
+        x = 2.f * random.Rand<float>() - 1.f;
+      for (float& x : xi)
+        x = 2.f * random.Rand<float>() - 1.f;
+      for (float& x : w)
+        x = 2.f * random.Rand<float>() - 1.f;
+      std::vector<float> expected_r(n), expected_i(n);
+      Radix4Stage(n1, s, xr.data(), xi.data(), expected_r.data(),
+                  expected_i.data(), w.data());
+      for (Radix4StageFunction stage : simd_stages) {
+        std::vector<float> actual_r(n), actual_i(n);
+        stage(n1, s, xr.data(), xi.data(), actual_r.data(), actual_i.data(),
+              w.data());
+        for (size_t i = 0; i < n; ++i) {
+          EXPECT_NEAR(expected_r[i], actual_r[i], 1e-6f);
+          EXPECT_NEAR(expected_i[i], actual_i[i], 1e-6f);
+        }
+      }
+    }
+  }
+}
+
 }  // namespace webrtc
 
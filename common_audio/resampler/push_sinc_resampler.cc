@@ -19,12 +19,19 @@ namespace webrtc {
 
 PushSincResampler::PushSincResampler(size_t source_frames,
                                      size_t destination_frames)
+    : PushSincResampler(source_frames, destination_frames, 1) {}
+
+PushSincResampler::PushSincResampler(size_t source_frames,
+                                     size_t destination_frames,
+                                     size_t num_channels)
     : resampler_(new SincResampler(source_frames * 1.0 / destination_frames,
                                    source_frames,
+                                   num_channels,
                                    this)),
       source_ptr_(nullptr),
       source_ptr_int_(nullptr),
       destination_frames_(destination_frames),
+      num_channels_(num_channels),
       first_pass_(true),
       source_available_(0) {}
 
@@ -35,23 +42,24 @@ size_t PushSincResampler::Resample(const int16_t* source,
                                    size_t source_length,
                                    int16_t* destination,
                                    size_t destination_capacity) {
+  const size_t destination_length = destination_frames_ * num_channels_;
   if (!float_buffer_.get())
-    float_buffer_.reset(new float[destination_frames_]);
+    float_buffer_.reset(new float[destination_length]);
 
   source_ptr_int_ = source;
   // Pass nullptr as the float source to have Run() read from the int16 source.
-  Resample(nullptr, source_length, float_buffer_.get(), destination_frames_);
-  FloatS16ToS16(float_buffer_.get(), destination_frames_, destination);
+  Resample(nullptr, source_length, float_buffer_.get(), destination_length);
+  FloatS16ToS16(float_buffer_.get(), destination_length, destination);
   source_ptr_int_ = nullptr;
-  return destination_frames_;
+  return destination_length;
 }
 
 size_t PushSincResampler::Resample(const float* source,
                                    size_t source_length,
                                    float* destination,
                                    size_t destination_capacity) {
-  RTC_CHECK_EQ(source_length, resampler_->request_frames());
-  RTC_CHECK_GE(destination_capacity, destination_frames_);
+  RTC_CHECK_EQ(source_length, resampler_->request_frames() * num_channels_);
+  RTC_CHECK_GE(destination_capacity, destination_frames_ * num_channels_);
   // Cache the source pointer. Calling Resample() will immediately trigger
   // the Run() callback whereupon we provide the cached value.
   source_ptr_ = source;
@@ -75,29 +83,30 @@ size_t PushSincResampler::Resample(const float* source,
 
   resampler_->Resample(destination_frames_, destination);
   source_ptr_ = nullptr;
-  return destination_frames_;
+  return destination_frames_ * num_channels_;
 }
 
 void PushSincResampler::Run(size_t frames, float* destination) {
   // Ensure we are only asked for the available samples. This would fail if
   // Run() was triggered more than once per Resample() call.
-  RTC_CHECK_EQ(source_available_, frames);
+  const size_t length = frames * num_channels_;
+  RTC_CHECK_EQ(source_available_, length);
 
   if (first_pass_) {
     // Provide dummy input on the first pass, the output of which will be
     // discarded, as described in Resample().
-    std::memset(destination, 0, frames * sizeof(*destination));
+    std::memset(destination, 0, length * sizeof(*destination));
     first_pass_ = false;
     return;
   }
 
   if (source_ptr_) {
-    std::memcpy(destination, source_ptr_, frames * sizeof(*destination));
+    std::memcpy(destination, source_ptr_, length * sizeof(*destination));
   } else {
-    for (size_t i = 0; i < frames; ++i)
+    for (size_t i = 0; i < length; ++i)
       destination[i] = static_cast<float>(source_ptr_int_[i]);
   }
-  source_available_ -= frames;
+  source_available_ -= length;
 }
 
 }  // namespace webrtc
@@ -0,0 +1,78 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/common_audio/resampler/push_sinc_resampler.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+constexpr size_t kNumChannels = 2;
+constexpr int kInputRateHz = 48000;
+constexpr int kNumIterations = 10000;
+}  // namespace
+
+// Time to resample 10 ms of stereo audio from 48 kHz, with one resampler per
+// channel and with a single resampler taking the interleaved channels.
+TEST(PushSincResamplerPerformanceTest, Stereo) {
+  const size_t input_frames = kInputRateHz / 100;
+  std::vector<float> interleaved_input(input_frames * kNumChannels);
+  for (size_t i = 0; i < interleaved_input.size(); ++i)
+    interleaved_input[i] = static_cast<float>(10000 * std::sin(0.01 * i));
+  Clock* clock = Clock::GetRealTimeClock();
+
+  for (int output_rate_hz : {16000, 32000}) {
+    const size_t output_frames = output_rate_hz / 100;
+    std::vector<float> interleaved_output(output_frames * kNumChannels);
+    const std::string trace = std::to_string(output_rate_hz) + "_hz";
+
+    std::unique_ptr<PushSincResampler> mono_resamplers[kNumChannels];
+    for (auto& resampler : mono_resamplers)
+      resampler.reset(new PushSincResampler(input_frames, output_frames));
+    std::vector<float> mono_input(input_frames);
+    std::vector<float> mono_output(output_frames);
+    int64_t start_time_us = clock->TimeInMicroseconds();
+    for (int i = 0; i < kNumIterations; ++i) {
+      for (size_t ch = 0; ch < kNumChannels; ++ch) {
+        for (size_t j = 0; j < input_frames; ++j)
+          mono_input[j] = interleaved_input[j * kNumChannels + ch];
+        mono_resamplers[ch]->Resample(mono_input.data(), input_frames,
+                                      mono_output.data(), output_frames);
+        for (size_t j = 0; j < output_frames; ++j)
+          interleaved_output[j * kNumChannels + ch] = mono_output[j];
+      }
+    }
+    test::PrintResult(
+        "push_sinc_resampler_per_channel", "", trace,
+        static_cast<double>(clock->TimeInMicroseconds() - start_time_us) /
+            kNumIterations,
+        "us", false);
+
+    PushSincResampler resampler(input_frames, output_frames, kNumChannels);
+    start_time_us = clock->TimeInMicroseconds();
+    for (int i = 0; i < kNumIterations; ++i) {
+      resampler.Resample(interleaved_input.data(), interleaved_input.size(),
+                         interleaved_output.data(), interleaved_output.size());
+    }
+    test::PrintResult(
+        "push_sinc_resampler_interleaved", "", trace,
+        static_cast<double>(clock->TimeInMicroseconds() - start_time_us) /
+            kNumIterations,
+        "us", false);
+  }
+}
+
+}  // namespace webrtc
@@ -11,6 +11,7 @@
 #include <cmath>
 #include <cstring>
 #include <memory>
+#include <vector>
 
 #include "webrtc/base/timeutils.h"
 #include "webrtc/common_audio/include/audio_util.h"
@@ -255,6 +256,47 @@ TEST_P(PushSincResamplerTest, ResampleInt) { ResampleTest(true); }
 
 TEST_P(PushSincResamplerTest, ResampleFloat) { ResampleTest(false); }
 
+// Resampling interleaved channels in one pass must give exactly the same
+// result as resampling each channel on its own.
+TEST(PushSincResamplerMultiChannelTest, MatchesMonoResamplers) {
+  const size_t kNumChannels = 3;
+  const size_t kInputFrames = 480;
+  const size_t kOutputFrames = 320;
+  const size_t kNumBlocks = 10;
+
+  PushSincResampler multi_channel_resampler(kInputFrames, kOutputFrames,
+                                            kNumChannels);
+  std::unique_ptr<PushSincResampler> mono_resamplers[kNumChannels];
+  for (auto& resampler : mono_resamplers)
+    resampler.reset(new PushSincResampler(kInputFrames, kOutputFrames));
+
+  std::vector<float> interleaved_input(kInputFrames * kNumChannels);
+  std::vector<float> interleaved_output(kOutputFrames * kNumChannels);
+  std::vector<float> mono_input(kInputFrames);
+  std::vector<float> mono_output(kOutputFrames);
+  for (size_t block = 0; block < kNumBlocks; ++block) {
+    for (size_t i = 0; i < kInputFrames; ++i) {
+      for (size_t ch = 0; ch < kNumChannels; ++ch) {
+        interleaved_input[i * kNumChannels + ch] = static_cast<float>(
+            10000 * std::sin(0.01 * (ch + 1) * (block * kInputFrames + i)));
+      }
+    }
+    EXPECT_EQ(kOutputFrames * kNumChannels,
+              multi_channel_resampler.Resample(
+                  interleaved_input.data(), interleaved_input.size(),
+                  interleaved_output.data(), interleaved_output.size()));
+
+    for (size_t ch = 0; ch < kNumChannels; ++ch) {
+      for (size_t i = 0; i < kInputFrames; ++i)
+        mono_input[i] = interleaved_input[i * kNumChannels + ch];
+      mono_resamplers[ch]->Resample(mono_input.data(), kInputFrames,
+                                    mono_output.data(), kOutputFrames);
+      for (size_t i = 0; i < kOutputFrames; ++i)
+        EXPECT_EQ(mono_output[i], interleaved_output[i * kNumChannels + ch]);
+    }
+  }
+}
+
 // Thresholds chosen arbitrarily based on what each resampling reported during
 // testing.  All thresholds are in dbFS, http://en.wikipedia.org/wiki/DBFS.
 INSTANTIATE_TEST_CASE_P(
@@ -91,8 +91,11 @@
 #include <string.h>
 
 #include <limits>
+#include <map>
 
 #include "webrtc/base/checks.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/refcountedobject.h"
 #include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/typedefs.h"
 
@@ -116,25 +119,114 @@ double SincScaleFactor(double io_ratio) {
   return sinc_scale_factor;
 }
 
+// Kernels that are no longer used by any resampler are only evicted once the
+// cache holds this many, so that switching back and forth between a few
+// ratios does not recompute them.
+const size_t kMaxCachedKernels = 16;
+
+typedef std::map<double,
+                 rtc::scoped_refptr<rtc::RefCountedObject<SincResamplerKernel>>>
+    KernelCache;
+
+rtc::GlobalLockPod g_kernel_cache_lock;
+// Intentionally leaked to avoid an exit-time destructor.
+KernelCache* g_kernel_cache = nullptr;
+
 }  // namespace
 
+rtc::scoped_refptr<SincResamplerKernel> SincResamplerKernel::Get(
+    double io_sample_rate_ratio) {
+  rtc::GlobalLockScope lock(&g_kernel_cache_lock);
+  if (!g_kernel_cache)
+    g_kernel_cache = new KernelCache();
+  auto it = g_kernel_cache->find(io_sample_rate_ratio);
+  if (it != g_kernel_cache->end())
+    return it->second;
+
+  if (g_kernel_cache->size() >= kMaxCachedKernels) {
+    // Evict the kernels that only the cache refers to.
+    for (it = g_kernel_cache->begin(); it != g_kernel_cache->end();) {
+      if (it->second->HasOneRef())
+        it = g_kernel_cache->erase(it);
+      else
+        ++it;
+    }
+  }
+  rtc::scoped_refptr<rtc::RefCountedObject<SincResamplerKernel>> kernel(
+      new rtc::RefCountedObject<SincResamplerKernel>(io_sample_rate_ratio));
+  (*g_kernel_cache)[io_sample_rate_ratio] = kernel;
+  return kernel;
+}
+
+size_t SincResamplerKernel::CacheSizeForTesting() {
+  rtc::GlobalLockScope lock(&g_kernel_cache_lock);
+  return g_kernel_cache ? g_kernel_cache->size() : 0;
+}
+
+SincResamplerKernel::SincResamplerKernel(double io_sample_rate_ratio)
+    : storage_(static_cast<float*>(AlignedMalloc(
+          sizeof(float) * SincResampler::kKernelStorageSize, 16))) {
+  // Blackman window parameters.
+  static const double kAlpha = 0.16;
+  static const double kA0 = 0.5 * (1.0 - kAlpha);
+  static const double kA1 = 0.5;
+  static const double kA2 = 0.5 * kAlpha;
+  const size_t kKernelSize = SincResampler::kKernelSize;
+  const size_t kKernelOffsetCount = SincResampler::kKernelOffsetCount;
+
+  // Generates a set of windowed sinc() kernels.
+  // We generate a range of sub-sample offsets from 0.0 to 1.0.
+  const double sinc_scale_factor = SincScaleFactor(io_sample_rate_ratio);
+  for (size_t offset_idx = 0; offset_idx <= kKernelOffsetCount; ++offset_idx) {
+    const float subsample_offset =
+        static_cast<float>(offset_idx) / kKernelOffsetCount;
+
+    for (size_t i = 0; i < kKernelSize; ++i) {
+      const size_t idx = i + offset_idx * kKernelSize;
+      const float pre_sinc = static_cast<float>(M_PI *
+          (static_cast<int>(i) - static_cast<int>(kKernelSize / 2) -
+           subsample_offset));
+
+      // Compute Blackman window, matching the offset of the sinc().
+      const float x = (i - subsample_offset) / kKernelSize;
+      const float window = static_cast<float>(kA0 - kA1 * cos(2.0 * M_PI * x) +
+          kA2 * cos(4.0 * M_PI * x));
+
+      // Compute the sinc with offset, then window the sinc() function and store
+      // at the correct offset.
+      storage_[idx] = static_cast<float>(window *
+          ((pre_sinc == 0) ?
+              sinc_scale_factor :
+              (sin(sinc_scale_factor * pre_sinc) / pre_sinc)));
+    }
+  }
+}
+
+SincResamplerKernel::~SincResamplerKernel() {}
+
 const size_t SincResampler::kKernelSize;
+const size_t SincResampler::kKernelOffsetCount;
+const size_t SincResampler::kKernelStorageSize;
 
-// If we know the minimum architecture at compile time, avoid CPU detection.
 #if defined(WEBRTC_ARCH_X86_FAMILY)
-#if defined(__SSE2__)
-#define CONVOLVE_FUNC Convolve_SSE
-void SincResampler::InitializeCPUSpecificFeatures() {}
-#else
-// x86 CPU detection required.  Function will be set by
-// InitializeCPUSpecificFeatures().
-// TODO(dalecurtis): Once Chrome moves to an SSE baseline this can be removed.
+// x86 CPU detection required, since AVX2 and FMA3 are newer than any compile
+// time baseline.  Function will be set by InitializeCPUSpecificFeatures().
 #define CONVOLVE_FUNC convolve_proc_
 
 void SincResampler::InitializeCPUSpecificFeatures() {
+  if (WebRtc_GetCPUInfo(kAVX2) && WebRtc_GetCPUInfo(kFMA3)) {
+    convolve_proc_ = Convolve_AVX2;
+    return;
+  }
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(__SSE2__)
+  convolve_proc_ = Convolve_SSE;
+#else
+  // TODO(dalecurtis): Once Chrome moves to an SSE baseline this can be
+  // removed.
   convolve_proc_ = WebRtc_GetCPUInfo(kSSE2) ? Convolve_SSE : Convolve_C;
-}
 #endif
+}
 #elif defined(WEBRTC_HAS_NEON)
 #define CONVOLVE_FUNC Convolve_NEON
 void SincResampler::InitializeCPUSpecificFeatures() {}
@@ -147,40 +239,37 @@ void SincResampler::InitializeCPUSpecificFeatures() {}
 SincResampler::SincResampler(double io_sample_rate_ratio,
                              size_t request_frames,
                              SincResamplerCallback* read_cb)
+    : SincResampler(io_sample_rate_ratio, request_frames, 1, read_cb) {}
+
+SincResampler::SincResampler(double io_sample_rate_ratio,
+                             size_t request_frames,
+                             size_t num_channels,
+                             SincResamplerCallback* read_cb)
     : io_sample_rate_ratio_(io_sample_rate_ratio),
       read_cb_(read_cb),
       request_frames_(request_frames),
+      num_channels_(num_channels),
       input_buffer_size_(request_frames_ + kKernelSize),
+      kernel_(SincResamplerKernel::Get(io_sample_rate_ratio)),
       // Create input buffers with a 16-byte alignment for SSE optimizations.
-      kernel_storage_(static_cast<float*>(
-          AlignedMalloc(sizeof(float) * kKernelStorageSize, 16))),
-      kernel_pre_sinc_storage_(static_cast<float*>(
-          AlignedMalloc(sizeof(float) * kKernelStorageSize, 16))),
-      kernel_window_storage_(static_cast<float*>(
-          AlignedMalloc(sizeof(float) * kKernelStorageSize, 16))),
-      input_buffer_(static_cast<float*>(
-          AlignedMalloc(sizeof(float) * input_buffer_size_, 16))),
-#if defined(WEBRTC_CPU_DETECTION)
+      input_buffer_(static_cast<float*>(AlignedMalloc(
+          sizeof(float) * input_buffer_size_ * num_channels_, 16))),
+      interleaved_buffer_(num_channels_ > 1
+                              ? new float[request_frames_ * num_channels_]
+                              : nullptr),
+#if defined(WEBRTC_ARCH_X86_FAMILY)
       convolve_proc_(NULL),
 #endif
       r1_(input_buffer_.get()),
       r2_(input_buffer_.get() + kKernelSize / 2) {
-#if defined(WEBRTC_CPU_DETECTION)
+#if defined(WEBRTC_ARCH_X86_FAMILY)
   InitializeCPUSpecificFeatures();
   RTC_DCHECK(convolve_proc_);
 #endif
   RTC_DCHECK_GT(request_frames_, 0);
+  RTC_DCHECK_GT(num_channels_, 0);
   Flush();
   RTC_DCHECK_GT(block_size_, kKernelSize);
-
-  memset(kernel_storage_.get(), 0,
-         sizeof(*kernel_storage_.get()) * kKernelStorageSize);
-  memset(kernel_pre_sinc_storage_.get(), 0,
-         sizeof(*kernel_pre_sinc_storage_.get()) * kKernelStorageSize);
-  memset(kernel_window_storage_.get(), 0,
-         sizeof(*kernel_window_storage_.get()) * kKernelStorageSize);
-
-  InitializeKernel();
 }
 
 SincResampler::~SincResampler() {}
@@ -201,39 +290,18 @@ void SincResampler::UpdateRegions(bool second_load) {
   RTC_DCHECK_LT(r2_, r3_);
 }
 
-void SincResampler::InitializeKernel() {
-  // Blackman window parameters.
-  static const double kAlpha = 0.16;
-  static const double kA0 = 0.5 * (1.0 - kAlpha);
-  static const double kA1 = 0.5;
-  static const double kA2 = 0.5 * kAlpha;
-
-  // Generates a set of windowed sinc() kernels.
-  // We generate a range of sub-sample offsets from 0.0 to 1.0.
-  const double sinc_scale_factor = SincScaleFactor(io_sample_rate_ratio_);
-  for (size_t offset_idx = 0; offset_idx <= kKernelOffsetCount; ++offset_idx) {
-    const float subsample_offset =
-        static_cast<float>(offset_idx) / kKernelOffsetCount;
-
-    for (size_t i = 0; i < kKernelSize; ++i) {
-      const size_t idx = i + offset_idx * kKernelSize;
-      const float pre_sinc = static_cast<float>(M_PI *
-          (static_cast<int>(i) - static_cast<int>(kKernelSize / 2) -
-           subsample_offset));
-      kernel_pre_sinc_storage_[idx] = pre_sinc;
-
-      // Compute Blackman window, matching the offset of the sinc().
-      const float x = (i - subsample_offset) / kKernelSize;
-      const float window = static_cast<float>(kA0 - kA1 * cos(2.0 * M_PI * x) +
-          kA2 * cos(4.0 * M_PI * x));
-      kernel_window_storage_[idx] = window;
-
-      // Compute the sinc with offset, then window the sinc() function and store
-      // at the correct offset.
-      kernel_storage_[idx] = static_cast<float>(window *
-          ((pre_sinc == 0) ?
-              sinc_scale_factor :
-              (sin(sinc_scale_factor * pre_sinc) / pre_sinc)));
+void SincResampler::ReadInput() {
+  if (num_channels_ == 1) {
+    read_cb_->Run(request_frames_, r0_);
+    return;
+  }
+  read_cb_->Run(request_frames_, interleaved_buffer_.get());
+  for (size_t ch = 0; ch < num_channels_; ++ch) {
+    float* const channel_r0 = r0_ + ch * input_buffer_size_;
+    const float* interleaved = interleaved_buffer_.get() + ch;
+    for (size_t i = 0; i < request_frames_; ++i) {
+      channel_r0[i] = *interleaved;
+      interleaved += num_channels_;
     }
   }
 }
@@ -245,22 +313,7 @@ void SincResampler::SetRatio(double io_sample_rate_ratio) {
   }
 
   io_sample_rate_ratio_ = io_sample_rate_ratio;
-
-  // Optimize reinitialization by reusing values which are independent of
-  // |sinc_scale_factor|.  Provides a 3x speedup.
-  const double sinc_scale_factor = SincScaleFactor(io_sample_rate_ratio_);
-  for (size_t offset_idx = 0; offset_idx <= kKernelOffsetCount; ++offset_idx) {
-    for (size_t i = 0; i < kKernelSize; ++i) {
-      const size_t idx = i + offset_idx * kKernelSize;
-      const float window = kernel_window_storage_[idx];
-      const float pre_sinc = kernel_pre_sinc_storage_[idx];
-
-      kernel_storage_[idx] = static_cast<float>(window *
-          ((pre_sinc == 0) ?
-              sinc_scale_factor :
-              (sin(sinc_scale_factor * pre_sinc) / pre_sinc)));
-    }
-  }
+  kernel_ = SincResamplerKernel::Get(io_sample_rate_ratio_);
 }
 
 void SincResampler::Resample(size_t frames, float* destination) {
@@ -268,14 +321,14 @@ void SincResampler::Resample(size_t frames, float* destination) {
 
   // Step (1) -- Prime the input buffer at the start of the input stream.
   if (!buffer_primed_ && remaining_frames) {
-    read_cb_->Run(request_frames_, r0_);
+    ReadInput();
     buffer_primed_ = true;
   }
 
   // Step (2) -- Resample!  const what we can outside of the loop for speed.  It
   // actually has an impact on ARM performance.  See inner loop comment below.
   const double current_io_ratio = io_sample_rate_ratio_;
-  const float* const kernel_ptr = kernel_storage_.get();
+  const float* const kernel_ptr = kernel_->data();
   while (remaining_frames) {
     // |i| may be negative if the last Resample() call ended on an iteration
     // that put |virtual_source_idx_| over the limit.
@@ -314,6 +367,12 @@ void SincResampler::Resample(size_t frames, float* destination) {
           virtual_offset_idx - offset_idx;
       *destination++ = CONVOLVE_FUNC(
           input_ptr, k1, k2, kernel_interpolation_factor);
+      // The other channels reuse the kernels, which are now in the cache.
+      for (size_t ch = 1; ch < num_channels_; ++ch) {
+        *destination++ =
+            CONVOLVE_FUNC(input_ptr + ch * input_buffer_size_, k1, k2,
+                          kernel_interpolation_factor);
+      }
 
       // Advance the virtual index.
       virtual_source_idx_ += current_io_ratio;
@@ -327,14 +386,17 @@ void SincResampler::Resample(size_t frames, float* destination) {
 
     // Step (3) -- Copy r3_, r4_ to r1_, r2_.
     // This wraps the last input frames back to the start of the buffer.
-    memcpy(r1_, r3_, sizeof(*input_buffer_.get()) * kKernelSize);
+    for (size_t ch = 0; ch < num_channels_; ++ch) {
+      memcpy(r1_ + ch * input_buffer_size_, r3_ + ch * input_buffer_size_,
+             sizeof(*input_buffer_.get()) * kKernelSize);
+    }
 
     // Step (4) -- Reinitialize regions if necessary.
     if (r0_ == r2_)
       UpdateRegions(true);
 
     // Step (5) -- Refresh the buffer with more input.
-    read_cb_->Run(request_frames_, r0_);
+    ReadInput();
   }
 }
 
@@ -348,7 +410,7 @@ void SincResampler::Flush() {
   virtual_source_idx_ = 0;
   buffer_primed_ = false;
   memset(input_buffer_.get(), 0,
-         sizeof(*input_buffer_.get()) * input_buffer_size_);
+         sizeof(*input_buffer_.get()) * input_buffer_size_ * num_channels_);
   UpdateRegions(false);
 }
 
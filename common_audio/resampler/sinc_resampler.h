@@ -18,6 +18,8 @@
 
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/gtest_prod_util.h"
+#include "webrtc/base/refcount.h"
+#include "webrtc/base/scoped_ref_ptr.h"
 #include "webrtc/system_wrappers/include/aligned_malloc.h"
 #include "webrtc/typedefs.h"
 
@@ -25,14 +27,45 @@ namespace webrtc {
 
 // Callback class for providing more data into the resampler.  Expects |frames|
 // of data to be rendered into |destination|; zero padded if not enough frames
-// are available to satisfy the request.
+// are available to satisfy the request.  For resamplers of more than one
+// channel the frames are interleaved.
 class SincResamplerCallback {
  public:
   virtual ~SincResamplerCallback() {}
   virtual void Run(size_t frames, float* destination) = 0;
 };
 
-// SincResampler is a high-quality single-channel sample-rate converter.
+// The windowed sinc() kernels of SincResampler for one sample rate ratio. They
+// are immutable once created and shared by all resamplers with the same ratio,
+// so that creating a resampler, or switching it back to a ratio that is in use
+// elsewhere, does not recompute them.
+class SincResamplerKernel : public rtc::RefCountInterface {
+ public:
+  // Returns the kernels for |io_sample_rate_ratio| from a process-wide cache,
+  // computing them on the first use. Thread safe.
+  static rtc::scoped_refptr<SincResamplerKernel> Get(
+      double io_sample_rate_ratio);
+
+  // Number of kernels currently in the cache. For testing.
+  static size_t CacheSizeForTesting();
+
+  // kKernelOffsetCount + 1 kernels of kKernelSize back-to-back, aligned for
+  // SIMD loads.
+  const float* data() const { return storage_.get(); }
+
+ protected:
+  explicit SincResamplerKernel(double io_sample_rate_ratio);
+  ~SincResamplerKernel() override;
+
+ private:
+  const std::unique_ptr<float[], AlignedFreeDeleter> storage_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(SincResamplerKernel);
+};
+
+// SincResampler is a high-quality sample-rate converter.  All the channels of
+// a multi-channel resampler share the position in the input and the kernels,
+// which are looked up once per output frame.
 class SincResampler {
  public:
   // The kernel size can be adjusted for quality (higher is better) at the
@@ -60,9 +93,15 @@ class SincResampler {
   SincResampler(double io_sample_rate_ratio,
                 size_t request_frames,
                 SincResamplerCallback* read_cb);
+  // As above, for |num_channels| interleaved channels.
+  SincResampler(double io_sample_rate_ratio,
+                size_t request_frames,
+                size_t num_channels,
+                SincResamplerCallback* read_cb);
   virtual ~SincResampler();
 
-  // Resample |frames| of data from |read_cb_| into |destination|.
+  // Resample |frames| of data from |read_cb_| into |destination|, which must
+  // have room for |frames| * num_channels() interleaved samples.
   void Resample(size_t frames, float* destination);
 
   // The maximum size in frames that guarantees Resample() will only make a
@@ -70,27 +109,31 @@ class SincResampler {
   size_t ChunkSize() const;
 
   size_t request_frames() const { return request_frames_; }
+  size_t num_channels() const { return num_channels_; }
 
   // Flush all buffered data and reset internal indices.  Not thread safe, do
   // not call while Resample() is in progress.
   void Flush();
 
-  // Update |io_sample_rate_ratio_|.  SetRatio() will cause a reconstruction of
-  // the kernels used for resampling.  Not thread safe, do not call while
-  // Resample() is in progress.
+  // Update |io_sample_rate_ratio_|.  SetRatio() switches to the kernels for
+  // the new ratio, which are only computed if no other resampler uses them.
+  // Not thread safe, do not call while Resample() is in progress.
   //
   // TODO(ajm): Use this in PushSincResampler rather than reconstructing
   // SincResampler.  We would also need a way to update |request_frames_|.
   void SetRatio(double io_sample_rate_ratio);
 
-  float* get_kernel_for_testing() { return kernel_storage_.get(); }
+  const float* get_kernel_for_testing() const { return kernel_->data(); }
 
  private:
   FRIEND_TEST_ALL_PREFIXES(SincResamplerTest, Convolve);
   FRIEND_TEST_ALL_PREFIXES(SincResamplerTest, ConvolveBenchmark);
+  FRIEND_TEST_ALL_PREFIXES(SincResamplerTest, ConvolveAVX2);
 
-  void InitializeKernel();
   void UpdateRegions(bool second_load);
+  // Requests |request_frames_| frames from |read_cb_| into |r0_| of every
+  // channel.
+  void ReadInput();
 
   // Selects runtime specific CPU features like SSE.  Must be called before
   // using SincResampler.
@@ -107,6 +150,10 @@ class SincResampler {
   static float Convolve_SSE(const float* input_ptr, const float* k1,
                             const float* k2,
                             double kernel_interpolation_factor);
+  // Requires a CPU with both AVX2 and FMA3.
+  static float Convolve_AVX2(const float* input_ptr, const float* k1,
+                             const float* k2,
+                             double kernel_interpolation_factor);
 #elif defined(WEBRTC_HAS_NEON)
   static float Convolve_NEON(const float* input_ptr, const float* k1,
                              const float* k2,
@@ -126,37 +173,44 @@ class SincResampler {
   // Source of data for resampling.
   SincResamplerCallback* read_cb_;
 
-  // The size (in samples) to request from each |read_cb_| execution.
+  // The size (in frames) to request from each |read_cb_| execution.
   const size_t request_frames_;
 
+  const size_t num_channels_;
+
   // The number of source frames processed per pass.
   size_t block_size_;
 
-  // The size (in samples) of the internal buffer used by the resampler.
+  // The size (in samples) of the internal buffer of each channel.
   const size_t input_buffer_size_;
 
   // Contains kKernelOffsetCount kernels back-to-back, each of size kKernelSize.
   // The kernel offsets are sub-sample shifts of a windowed sinc shifted from
   // 0.0 to 1.0 sample.
-  std::unique_ptr<float[], AlignedFreeDeleter> kernel_storage_;
-  std::unique_ptr<float[], AlignedFreeDeleter> kernel_pre_sinc_storage_;
-  std::unique_ptr<float[], AlignedFreeDeleter> kernel_window_storage_;
+  rtc::scoped_refptr<SincResamplerKernel> kernel_;
 
   // Data from the source is copied into this buffer for each processing pass.
+  // The channels are stored one after the other, |input_buffer_size_| samples
+  // apart.
   std::unique_ptr<float[], AlignedFreeDeleter> input_buffer_;
 
+  // Receives the interleaved frames from |read_cb_| when there is more than
+  // one channel.
+  std::unique_ptr<float[]> interleaved_buffer_;
+
   // Stores the runtime selection of which Convolve function to use.
   // TODO(ajm): Move to using a global static which must only be initialized
   // once by the user. We're not doing this initially, because we don't have
   // e.g. a LazyInstance helper in webrtc.
-#if defined(WEBRTC_CPU_DETECTION)
+#if defined(WEBRTC_ARCH_X86_FAMILY)
   typedef float (*ConvolveProc)(const float*, const float*, const float*,
                                 double);
   ConvolveProc convolve_proc_;
 #endif
 
-  // Pointers to the various regions inside |input_buffer_|.  See the diagram at
-  // the top of the .cc file for more information.
+  // Pointers to the various regions of the first channel inside
+  // |input_buffer_|.  See the diagram at the top of the .cc file for more
+  // information.
   float* r0_;
   float* const r1_;
   float* const r2_;
@@ -114,6 +114,35 @@ TEST(SincResamplerTest, DISABLED_SetRatioBench) {
   printf("SetRatio() took %.2fms.\n", total_time_c_us / 1000);
 }
 
+// Resamplers with the same ratio share their kernels, also after SetRatio().
+TEST(SincResamplerTest, SharesKernels) {
+  MockSource mock_source;
+  SincResampler resampler1(kSampleRateRatio, SincResampler::kDefaultRequestSize,
+                           &mock_source);
+  SincResampler resampler2(kSampleRateRatio, SincResampler::kDefaultRequestSize,
+                           2, &mock_source);
+  SincResampler resampler3(1.0 / kSampleRateRatio,
+                           SincResampler::kDefaultRequestSize, &mock_source);
+  EXPECT_EQ(resampler1.get_kernel_for_testing(),
+            resampler2.get_kernel_for_testing());
+  EXPECT_NE(resampler1.get_kernel_for_testing(),
+            resampler3.get_kernel_for_testing());
+
+  resampler3.SetRatio(kSampleRateRatio);
+  EXPECT_EQ(resampler1.get_kernel_for_testing(),
+            resampler3.get_kernel_for_testing());
+}
+
+// The cache does not grow without bounds when kernels are no longer used.
+TEST(SincResamplerTest, EvictsUnusedKernels) {
+  MockSource mock_source;
+  SincResampler resampler(kSampleRateRatio, SincResampler::kDefaultRequestSize,
+                          &mock_source);
+  for (int i = 1; i < 100; ++i)
+    resampler.SetRatio(1.0 + i / 1000.0);
+  EXPECT_LE(SincResamplerKernel::CacheSizeForTesting(), 16u);
+}
+
 
 // Define platform independent function name for Convolve* tests.
 #if defined(WEBRTC_ARCH_X86_FAMILY)
@@ -137,6 +166,7 @@ TEST(SincResamplerTest, Convolve) {
   MockSource mock_source;
   SincResampler resampler(kSampleRateRatio, SincResampler::kDefaultRequestSize,
                           &mock_source);
+  const float* const kernel = resampler.get_kernel_for_testing();
 
   // The optimized Convolve methods are slightly more precise than Convolve_C(),
   // so comparison must be done using an epsilon.
@@ -144,25 +174,48 @@ TEST(SincResamplerTest, Convolve) {
 
   // Use a kernel from SincResampler as input and kernel data, this has the
   // benefit of already being properly sized and aligned for Convolve_SSE().
-  double result = resampler.Convolve_C(
-      resampler.kernel_storage_.get(), resampler.kernel_storage_.get(),
-      resampler.kernel_storage_.get(), kKernelInterpolationFactor);
-  double result2 = resampler.CONVOLVE_FUNC(
-      resampler.kernel_storage_.get(), resampler.kernel_storage_.get(),
-      resampler.kernel_storage_.get(), kKernelInterpolationFactor);
+  double result = resampler.Convolve_C(kernel, kernel, kernel,
+                                       kKernelInterpolationFactor);
+  double result2 = resampler.CONVOLVE_FUNC(kernel, kernel, kernel,
+                                           kKernelInterpolationFactor);
   EXPECT_NEAR(result2, result, kEpsilon);
 
   // Test Convolve() w/ unaligned input pointer.
-  result = resampler.Convolve_C(
-      resampler.kernel_storage_.get() + 1, resampler.kernel_storage_.get(),
-      resampler.kernel_storage_.get(), kKernelInterpolationFactor);
-  result2 = resampler.CONVOLVE_FUNC(
-      resampler.kernel_storage_.get() + 1, resampler.kernel_storage_.get(),
-      resampler.kernel_storage_.get(), kKernelInterpolationFactor);
+  result = resampler.Convolve_C(kernel + 1, kernel, kernel,
+                                kKernelInterpolationFactor);
+  result2 = resampler.CONVOLVE_FUNC(kernel + 1, kernel, kernel,
+                                    kKernelInterpolationFactor);
   EXPECT_NEAR(result2, result, kEpsilon);
 }
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Ensure Convolve_AVX2() returns the same value as Convolve_C(), on CPUs that
+// support it.
+TEST(SincResamplerTest, ConvolveAVX2) {
+  if (!WebRtc_GetCPUInfo(kAVX2) || !WebRtc_GetCPUInfo(kFMA3))
+    return;
+
+  MockSource mock_source;
+  SincResampler resampler(kSampleRateRatio, SincResampler::kDefaultRequestSize,
+                          &mock_source);
+  const float* const kernel = resampler.get_kernel_for_testing();
+
+  // The fused multiply-adds round differently from Convolve_C().
+  static const double kEpsilon = 0.00000005;
+
+  for (int input_offset = 0; input_offset < 8; ++input_offset) {
+    const float* const input = kernel + input_offset;
+    const float* const k1 = kernel;
+    const float* const k2 = k1 + SincResampler::kKernelSize;
+    EXPECT_NEAR(
+        resampler.Convolve_C(input, k1, k2, kKernelInterpolationFactor),
+        resampler.Convolve_AVX2(input, k1, k2, kKernelInterpolationFactor),
+        kEpsilon);
+  }
+}
+#endif
+
 // Benchmark for the various Convolve() methods.  Make sure to build with
 // branding=Chrome so that RTC_DCHECKs are compiled out when benchmarking.
 // Original benchmarks were run with --convolve-iterations=50000000.
@@ -171,6 +224,7 @@ TEST(SincResamplerTest, ConvolveBenchmark) {
   MockSource mock_source;
   SincResampler resampler(kSampleRateRatio, SincResampler::kDefaultRequestSize,
                           &mock_source);
+  const float* const kernel = resampler.get_kernel_for_testing();
 
   // Retrieve benchmark iterations from command line.
   // TODO(ajm): Reintroduce this as a command line option.
@@ -181,9 +235,8 @@ TEST(SincResamplerTest, ConvolveBenchmark) {
   // Benchmark Convolve_C().
   int64_t start = rtc::TimeNanos();
   for (int i = 0; i < kConvolveIterations; ++i) {
-    resampler.Convolve_C(
-        resampler.kernel_storage_.get(), resampler.kernel_storage_.get(),
-        resampler.kernel_storage_.get(), kKernelInterpolationFactor);
+    resampler.Convolve_C(kernel, kernel, kernel,
+                         kKernelInterpolationFactor);
   }
   double total_time_c_us =
       (rtc::TimeNanos() - start) / rtc::kNumNanosecsPerMicrosec;
@@ -199,9 +252,8 @@ TEST(SincResamplerTest, ConvolveBenchmark) {
   // Benchmark with unaligned input pointer.
   start = rtc::TimeNanos();
   for (int j = 0; j < kConvolveIterations; ++j) {
-    resampler.CONVOLVE_FUNC(
-        resampler.kernel_storage_.get() + 1, resampler.kernel_storage_.get(),
-        resampler.kernel_storage_.get(), kKernelInterpolationFactor);
+    resampler.CONVOLVE_FUNC(kernel + 1, kernel, kernel,
+                            kKernelInterpolationFactor);
   }
   double total_time_optimized_unaligned_us =
       (rtc::TimeNanos() - start) / rtc::kNumNanosecsPerMicrosec;
@@ -212,9 +264,8 @@ TEST(SincResamplerTest, ConvolveBenchmark) {
   // Benchmark with aligned input pointer.
   start = rtc::TimeNanos();
   for (int j = 0; j < kConvolveIterations; ++j) {
-    resampler.CONVOLVE_FUNC(
-        resampler.kernel_storage_.get(), resampler.kernel_storage_.get(),
-        resampler.kernel_storage_.get(), kKernelInterpolationFactor);
+    resampler.CONVOLVE_FUNC(kernel, kernel, kernel,
+                            kKernelInterpolationFactor);
   }
   double total_time_optimized_aligned_us =
       (rtc::TimeNanos() - start) / rtc::kNumNanosecsPerMicrosec;
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+
+#include <immintrin.h>
+
+static inline int32_t HorizontalSumAvx2(__m256i sum) {
+  __m128i sum128 = _mm_add_epi32(_mm256_castsi256_si128(sum),
+                                 _mm256_extracti128_si256(sum, 1));
+  sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, 0x4E));
+  sum128 = _mm_add_epi32(sum128, _mm_shuffle_epi32(sum128, 0xB1));
+  return _mm_cvtsi128_si32(sum128);
+}
+
+static inline int32_t DotProductWithScaleAvx2(const int16_t* vector1,
+                                              const int16_t* vector2,
+                                              size_t length,
+                                              int scaling) {
+  const __m128i shift = _mm_cvtsi32_si128(scaling);
+  __m256i sum = _mm256_setzero_si256();
+  int32_t corr = 0;
+  size_t i = 0;
+
+  if (scaling == 0) {
+    // Without shifts, pairs of products can be added before accumulating.
+    for (; i + 16 <= length; i += 16) {
+      const __m256i seq1 = _mm256_loadu_si256((const __m256i*)&vector1[i]);
+      const __m256i seq2 = _mm256_loadu_si256((const __m256i*)&vector2[i]);
+      sum = _mm256_add_epi32(sum, _mm256_madd_epi16(seq1, seq2));
+    }
+  } else {
+    // Each product is shifted before it is accumulated, as in the C version.
+    for (; i + 16 <= length; i += 16) {
+      const __m256i seq1 = _mm256_loadu_si256((const __m256i*)&vector1[i]);
+      const __m256i seq2 = _mm256_loadu_si256((const __m256i*)&vector2[i]);
+      const __m256i low = _mm256_mullo_epi16(seq1, seq2);
+      const __m256i high = _mm256_mulhi_epi16(seq1, seq2);
+      sum = _mm256_add_epi32(
+          sum, _mm256_sra_epi32(_mm256_unpacklo_epi16(low, high), shift));
+      sum = _mm256_add_epi32(
+          sum, _mm256_sra_epi32(_mm256_unpackhi_epi16(low, high), shift));
+    }
+  }
+  corr = HorizontalSumAvx2(sum);
+
+  // Calculate the rest of the samples.
+  for (; i < length; i++)
+    corr += (vector1[i] * vector2[i]) >> scaling;
+
+  return corr;
+}
+
+/* AVX2 version of WebRtcSpl_CrossCorrelation() for x86 platforms. */
+void WebRtcSpl_CrossCorrelationAvx2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2) {
+  size_t i = 0;
+
+  for (i = 0; i < dim_cross_correlation; i++) {
+    *cross_correlation++ =
+        DotProductWithScaleAvx2(seq1, seq2, dim_seq, right_shifts);
+    seq2 += step_seq2;
+  }
+}
@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+
+#include <immintrin.h>
+
+// AVX2 intrinsics version of WebRtcSpl_DownsampleFast() for x86 platforms.
+// Eight output samples are computed at a time. The input samples they need
+// for each coefficient are gathered as 32-bit words, of which the low half is
+// the sample and the high half is the sample after it, which is multiplied by
+// zero.
+int WebRtcSpl_DownsampleFastAvx2(const int16_t* data_in,
+                                 size_t data_in_length,
+                                 int16_t* data_out,
+                                 size_t data_out_length,
+                                 const int16_t* __restrict coefficients,
+                                 size_t coefficients_length,
+                                 int factor,
+                                 size_t delay) {
+  const __m256i round = _mm256_set1_epi32(2048);  // 0.5 in Q12.
+  const __m256i offsets = _mm256_mullo_epi32(
+      _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0), _mm256_set1_epi32(factor));
+  size_t i = 0;
+  size_t j = 0;
+  int32_t out_s32 = 0;
+  size_t endpos = delay + factor * (data_out_length - 1) + 1;
+
+  // Return error if any of the running conditions doesn't meet.
+  if (data_out_length == 0 || coefficients_length == 0
+                           || data_in_length < endpos) {
+    return -1;
+  }
+
+  // Compute blocks of eight samples for as long as the sample after the last
+  // gathered one is within |data_in|.
+  for (i = delay;
+       i + 7 * factor < endpos && i + 7 * factor + 1 < data_in_length;
+       i += 8 * factor) {
+    __m256i out = round;
+    __m128i out16;
+    for (j = 0; j < coefficients_length; j++) {
+      const __m256i in = _mm256_i32gather_epi32(
+          (const int*)&data_in[i - j], offsets, 2);
+      const __m256i coefficient =
+          _mm256_set1_epi32((uint16_t)coefficients[j]);
+      out = _mm256_add_epi32(out, _mm256_madd_epi16(in, coefficient));  // Q12.
+    }
+    out = _mm256_srai_epi32(out, 12);  // Q0.
+
+    // Saturate and store the output.
+    out16 = _mm_packs_epi32(_mm256_castsi256_si128(out),
+                            _mm256_extracti128_si256(out, 1));
+    _mm_storeu_si128((__m128i*)data_out, out16);
+    data_out += 8;
+  }
+
+  for (; i < endpos; i += factor) {
+    out_s32 = 2048;  // Round value, 0.5 in Q12.
+
+    for (j = 0; j < coefficients_length; j++) {
+      out_s32 += coefficients[j] * data_in[i - j];  // Q12.
+    }
+
+    out_s32 >>= 12;  // Q0.
+
+    // Saturate and store the output.
+    *data_out++ = WebRtcSpl_SatW32ToW16(out_s32);
+  }
+
+  return 0;
+}
@@ -10,7 +10,7 @@
 
 
 /*
- * This file contains the function WebRtcSpl_FilterMAFastQ12().
+ * This file contains the function WebRtcSpl_FilterMAFastQ12C().
  * The description header can be found in signal_processing_library.h
  *
  */
@@ -19,11 +19,11 @@
 
 #include "webrtc/base/sanitizer.h"
 
-void WebRtcSpl_FilterMAFastQ12(const int16_t* in_ptr,
-                               int16_t* out_ptr,
-                               const int16_t* B,
-                               size_t B_length,
-                               size_t length)
+void WebRtcSpl_FilterMAFastQ12C(const int16_t* in_ptr,
+                                int16_t* out_ptr,
+                                const int16_t* B,
+                                size_t B_length,
+                                size_t length)
 {
     size_t i, j;
 
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+
+#include <immintrin.h>
+
+// AVX2 version of WebRtcSpl_FilterMAFastQ12() for x86 platforms. Sixteen
+// output samples are computed at a time, two coefficients at a time. The
+// products are accumulated in the order the 16-bit samples are unpacked, which
+// the final packing to 16 bits reverts.
+void WebRtcSpl_FilterMAFastQ12Avx2(const int16_t* in_ptr,
+                                   int16_t* out_ptr,
+                                   const int16_t* B,
+                                   size_t B_length,
+                                   size_t length) {
+  // 2^27 = 134217728, which corresponds to 32768 in Q12.
+  const __m256i max_value = _mm256_set1_epi32(134215679);
+  const __m256i min_value = _mm256_set1_epi32(-134217728);
+  const __m256i round = _mm256_set1_epi32(2048);
+  size_t i = 0;
+  size_t j = 0;
+
+  for (i = 0; i + 16 <= length; i += 16) {
+    __m256i out_low = _mm256_setzero_si256();
+    __m256i out_high = _mm256_setzero_si256();
+    for (j = 0; j + 2 <= B_length; j += 2) {
+      const __m256i in0 =
+          _mm256_loadu_si256((const __m256i*)&in_ptr[i - j]);
+      const __m256i in1 =
+          _mm256_loadu_si256((const __m256i*)&in_ptr[i - j - 1]);
+      const __m256i coefficients = _mm256_set1_epi32(
+          (int32_t)(((uint32_t)(uint16_t)B[j + 1] << 16) | (uint16_t)B[j]));
+      out_low = _mm256_add_epi32(
+          out_low,
+          _mm256_madd_epi16(_mm256_unpacklo_epi16(in0, in1), coefficients));
+      out_high = _mm256_add_epi32(
+          out_high,
+          _mm256_madd_epi16(_mm256_unpackhi_epi16(in0, in1), coefficients));
+    }
+    if (j < B_length) {
+      const __m256i in0 =
+          _mm256_loadu_si256((const __m256i*)&in_ptr[i - j]);
+      const __m256i coefficients = _mm256_set1_epi32((uint16_t)B[j]);
+      const __m256i zero = _mm256_setzero_si256();
+      out_low = _mm256_add_epi32(
+          out_low,
+          _mm256_madd_epi16(_mm256_unpacklo_epi16(in0, zero), coefficients));
+      out_high = _mm256_add_epi32(
+          out_high,
+          _mm256_madd_epi16(_mm256_unpackhi_epi16(in0, zero), coefficients));
+    }
+
+    // Saturate the output.
+    out_low = _mm256_min_epi32(_mm256_max_epi32(out_low, min_value), max_value);
+    out_high =
+        _mm256_min_epi32(_mm256_max_epi32(out_high, min_value), max_value);
+    out_low = _mm256_srai_epi32(_mm256_add_epi32(out_low, round), 12);
+    out_high = _mm256_srai_epi32(_mm256_add_epi32(out_high, round), 12);
+    _mm256_storeu_si256((__m256i*)&out_ptr[i],
+                        _mm256_packs_epi32(out_low, out_high));
+  }
+
+  for (; i < length; i++) {
+    int32_t o = 0;
+
+    for (j = 0; j < B_length; j++) {
+      o += B[j] * in_ptr[i - j];
+    }
+
+    // Saturate the output.
+    o = WEBRTC_SPL_SAT((int32_t)134215679, o, (int32_t)-134217728);
+
+    out_ptr[i] = (int16_t)((o + (int32_t)2048) >> 12);
+  }
+}
@@ -105,8 +105,9 @@ extern "C" {
 
 // Initialize SPL. Currently it contains only function pointer initialization.
 // If the underlying platform is known to be ARM-Neon (WEBRTC_HAS_NEON defined),
-// the pointers will be assigned to code optimized for Neon; otherwise, generic
-// C code will be assigned.
+// the pointers will be assigned to code optimized for Neon. On x86, the
+// pointers of the functions having AVX2 versions are assigned to those if the
+// CPU supports AVX2. Otherwise, generic C code will be assigned.
 // Note that this function MUST be called in any application that uses SPL
 // functions.
 void WebRtcSpl_Init();
@@ -150,6 +151,9 @@ void WebRtcSpl_ZerosArrayW32(int32_t* vector,
 typedef int16_t (*MaxAbsValueW16)(const int16_t* vector, size_t length);
 extern MaxAbsValueW16 WebRtcSpl_MaxAbsValueW16;
 int16_t WebRtcSpl_MaxAbsValueW16C(const int16_t* vector, size_t length);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+int16_t WebRtcSpl_MaxAbsValueW16Avx2(const int16_t* vector, size_t length);
+#endif
 #if defined(WEBRTC_HAS_NEON)
 int16_t WebRtcSpl_MaxAbsValueW16Neon(const int16_t* vector, size_t length);
 #endif
@@ -201,6 +205,9 @@ int16_t WebRtcSpl_MaxValueW16_mips(const int16_t* vector, size_t length);
 typedef int32_t (*MaxValueW32)(const int32_t* vector, size_t length);
 extern MaxValueW32 WebRtcSpl_MaxValueW32;
 int32_t WebRtcSpl_MaxValueW32C(const int32_t* vector, size_t length);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+int32_t WebRtcSpl_MaxValueW32Avx2(const int32_t* vector, size_t length);
+#endif
 #if defined(WEBRTC_HAS_NEON)
 int32_t WebRtcSpl_MaxValueW32Neon(const int32_t* vector, size_t length);
 #endif
@@ -528,6 +535,15 @@ void WebRtcSpl_CrossCorrelationC(int32_t* cross_correlation,
                                  size_t dim_cross_correlation,
                                  int right_shifts,
                                  int step_seq2);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcSpl_CrossCorrelationAvx2(int32_t* cross_correlation,
+                                    const int16_t* seq1,
+                                    const int16_t* seq2,
+                                    size_t dim_seq,
+                                    size_t dim_cross_correlation,
+                                    int right_shifts,
+                                    int step_seq2);
+#endif
 #if defined(WEBRTC_HAS_NEON)
 void WebRtcSpl_CrossCorrelationNeon(int32_t* cross_correlation,
                                     const int16_t* seq1,
@@ -640,11 +656,24 @@ size_t WebRtcSpl_FilterAR(const int16_t* ar_coef,
 // Output:
 //      - out_vector        : Filtered samples
 //
-void WebRtcSpl_FilterMAFastQ12(const int16_t* in_vector,
-                               int16_t* out_vector,
-                               const int16_t* ma_coef,
-                               size_t ma_coef_length,
-                               size_t vector_length);
+typedef void (*FilterMAFastQ12)(const int16_t* in_vector,
+                                int16_t* out_vector,
+                                const int16_t* ma_coef,
+                                size_t ma_coef_length,
+                                size_t vector_length);
+extern FilterMAFastQ12 WebRtcSpl_FilterMAFastQ12;
+void WebRtcSpl_FilterMAFastQ12C(const int16_t* in_vector,
+                                int16_t* out_vector,
+                                const int16_t* ma_coef,
+                                size_t ma_coef_length,
+                                size_t vector_length);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcSpl_FilterMAFastQ12Avx2(const int16_t* in_vector,
+                                   int16_t* out_vector,
+                                   const int16_t* ma_coef,
+                                   size_t ma_coef_length,
+                                   size_t vector_length);
+#endif
 
 // Performs a AR filtering on a vector in Q12
 // Input:
@@ -695,6 +724,16 @@ int WebRtcSpl_DownsampleFastC(const int16_t* data_in,
                               size_t coefficients_length,
                               int factor,
                               size_t delay);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+int WebRtcSpl_DownsampleFastAvx2(const int16_t* data_in,
+                                 size_t data_in_length,
+                                 int16_t* data_out,
+                                 size_t data_out_length,
+                                 const int16_t* __restrict coefficients,
+                                 size_t coefficients_length,
+                                 int factor,
+                                 size_t delay);
+#endif
 #if defined(WEBRTC_HAS_NEON)
 int WebRtcSpl_DownsampleFastNeon(const int16_t* data_in,
                                  size_t data_in_length,
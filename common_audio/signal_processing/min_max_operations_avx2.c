@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <immintrin.h>
+#include <stdlib.h>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+
+// Maximum absolute value of word16 vector. AVX2 version for x86 platforms.
+int16_t WebRtcSpl_MaxAbsValueW16Avx2(const int16_t* vector, size_t length) {
+  __m256i maximum256 = _mm256_setzero_si256();
+  __m128i maximum128;
+  int maximum = 0;
+  size_t i = 0;
+
+  RTC_DCHECK_GT(length, 0);
+
+  // abs(-32768) is 0x8000, which is the largest value when compared unsigned.
+  for (; i + 16 <= length; i += 16) {
+    const __m256i in = _mm256_loadu_si256((const __m256i*)&vector[i]);
+    maximum256 = _mm256_max_epu16(maximum256, _mm256_abs_epi16(in));
+  }
+  maximum128 = _mm_max_epu16(_mm256_castsi256_si128(maximum256),
+                             _mm256_extracti128_si256(maximum256, 1));
+  maximum128 = _mm_max_epu16(maximum128, _mm_srli_si128(maximum128, 8));
+  maximum128 = _mm_max_epu16(maximum128, _mm_srli_si128(maximum128, 4));
+  maximum128 = _mm_max_epu16(maximum128, _mm_srli_si128(maximum128, 2));
+  maximum = _mm_extract_epi16(maximum128, 0);
+
+  for (; i < length; i++) {
+    int absolute = abs((int)vector[i]);
+    if (absolute > maximum)
+      maximum = absolute;
+  }
+
+  // Guard the case for abs(-32768).
+  if (maximum > WEBRTC_SPL_WORD16_MAX)
+    maximum = WEBRTC_SPL_WORD16_MAX;
+
+  return (int16_t)maximum;
+}
+
+// Maximum value of word32 vector. AVX2 version for x86 platforms.
+int32_t WebRtcSpl_MaxValueW32Avx2(const int32_t* vector, size_t length) {
+  __m256i maximum256 = _mm256_set1_epi32(WEBRTC_SPL_WORD32_MIN);
+  __m128i maximum128;
+  int32_t maximum = WEBRTC_SPL_WORD32_MIN;
+  size_t i = 0;
+
+  RTC_DCHECK_GT(length, 0);
+
+  for (; i + 8 <= length; i += 8) {
+    const __m256i in = _mm256_loadu_si256((const __m256i*)&vector[i]);
+    maximum256 = _mm256_max_epi32(maximum256, in);
+  }
+  maximum128 = _mm_max_epi32(_mm256_castsi256_si128(maximum256),
+                             _mm256_extracti128_si256(maximum256, 1));
+  maximum128 = _mm_max_epi32(maximum128, _mm_srli_si128(maximum128, 8));
+  maximum128 = _mm_max_epi32(maximum128, _mm_srli_si128(maximum128, 4));
+  maximum = _mm_cvtsi128_si32(maximum128);
+
+  for (; i < length; i++) {
+    if (vector[i] > maximum)
+      maximum = vector[i];
+  }
+  return maximum;
+}
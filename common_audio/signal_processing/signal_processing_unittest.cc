@@ -11,7 +11,9 @@
 #include <algorithm>
 #include <sstream>
 
+#include "webrtc/base/random.h"
 #include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/test/gtest.h"
 
 static const size_t kVector16Size = 9;
@@ -471,14 +473,14 @@ TEST_F(SplTest, CrossCorrelationTest) {
                              kCrossCorrelationDimension, kShift, kStep);
 
   // WebRtcSpl_CrossCorrelationC() and WebRtcSpl_CrossCorrelationNeon()
-  // are not bit-exact.
+  // are not bit-exact, while WebRtcSpl_CrossCorrelationAvx2() is.
   const int32_t kExpected[kCrossCorrelationDimension] =
       {-266947903, -15579555, -171282001};
   const int32_t* expected = kExpected;
-#if !defined(MIPS32_LE)
+#if defined(WEBRTC_HAS_NEON)
   const int32_t kExpectedNeon[kCrossCorrelationDimension] =
       {-266947901, -15579553, -171281999};
-  if (WebRtcSpl_CrossCorrelation != WebRtcSpl_CrossCorrelationC) {
+  if (WebRtcSpl_CrossCorrelation == WebRtcSpl_CrossCorrelationNeon) {
     expected = kExpectedNeon;
   }
 #endif
@@ -487,6 +489,84 @@ TEST_F(SplTest, CrossCorrelationTest) {
   }
 }
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Checks that the AVX2 versions of the functions are bit-exact with the C
+// versions, on random input with many saturated samples.
+TEST_F(SplTest, Avx2MatchesC) {
+  if (!WebRtc_GetCPUInfo(kAVX2))
+    return;
+  webrtc::Random random(42);
+  auto random_sample = [&random]() {
+    switch (random.Rand(3)) {
+      case 0:
+        return static_cast<int16_t>(WEBRTC_SPL_WORD16_MIN);
+      case 1:
+        return static_cast<int16_t>(WEBRTC_SPL_WORD16_MAX);
+      default:
+        return static_cast<int16_t>(random.Rand(WEBRTC_SPL_WORD16_MIN,
+                                                WEBRTC_SPL_WORD16_MAX));
+    }
+  };
+
+  for (int iteration = 0; iteration < 1000; ++iteration) {
+    int16_t in16[400];
+    int32_t in32[200];
+    for (int16_t& sample : in16)
+      sample = random_sample();
+    for (int32_t& sample : in32)
+      sample = static_cast<int32_t>(random.Rand<uint32_t>());
+    const size_t length = random.Rand(1, 200);
+    EXPECT_EQ(WebRtcSpl_MaxAbsValueW16C(in16, length),
+              WebRtcSpl_MaxAbsValueW16Avx2(in16, length));
+    EXPECT_EQ(WebRtcSpl_MaxValueW32C(in32, length),
+              WebRtcSpl_MaxValueW32Avx2(in32, length));
+
+    // The cross-correlations stay within the second half of |in16|.
+    int32_t correlation_c[20];
+    int32_t correlation_avx2[20];
+    const size_t seq_length = random.Rand(1, 100);
+    const size_t num_correlations = random.Rand(1, 20);
+    const int shift = random.Rand(0, 7);
+    const int step = random.Rand(0, 1) ? 1 : -1;
+    WebRtcSpl_CrossCorrelationC(correlation_c, in16, &in16[250], seq_length,
+                                num_correlations, shift, step);
+    WebRtcSpl_CrossCorrelationAvx2(correlation_avx2, in16, &in16[250],
+                                   seq_length, num_correlations, shift, step);
+    for (size_t i = 0; i < num_correlations; ++i)
+      EXPECT_EQ(correlation_c[i], correlation_avx2[i]);
+
+    // The filters have up to 12 states before |in16| + 20.
+    int16_t coefficients[12];
+    const size_t num_coefficients = random.Rand(1, 12);
+    for (size_t i = 0; i < num_coefficients; ++i)
+      coefficients[i] = random_sample();
+    int16_t out_c[200];
+    int16_t out_avx2[200];
+    const int factor = random.Rand(1, 12);
+    const size_t out_length = random.Rand(1, 30);
+    const size_t delay = random.Rand(0, 4);
+    const size_t in_length =
+        delay + factor * (out_length - 1) + 1 + random.Rand(0, 2);
+    ASSERT_EQ(0, WebRtcSpl_DownsampleFastC(&in16[20], in_length, out_c,
+                                           out_length, coefficients,
+                                           num_coefficients, factor, delay));
+    ASSERT_EQ(0, WebRtcSpl_DownsampleFastAvx2(&in16[20], in_length, out_avx2,
+                                              out_length, coefficients,
+                                              num_coefficients, factor,
+                                              delay));
+    for (size_t i = 0; i < out_length; ++i)
+      EXPECT_EQ(out_c[i], out_avx2[i]);
+
+    WebRtcSpl_FilterMAFastQ12C(&in16[20], out_c, coefficients,
+                               num_coefficients, length);
+    WebRtcSpl_FilterMAFastQ12Avx2(&in16[20], out_avx2, coefficients,
+                                  num_coefficients, length);
+    for (size_t i = 0; i < length; ++i)
+      EXPECT_EQ(out_c[i], out_avx2[i]);
+  }
+}
+#endif
+
 TEST_F(SplTest, AutoCorrelationTest) {
   int scale = 0;
   int32_t vector32[kVector16Size];
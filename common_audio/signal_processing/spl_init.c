@@ -9,7 +9,7 @@
  */
 
 /* The global function contained in this file initializes SPL function
- * pointers, currently only for ARM platforms.
+ * pointers, currently only for ARM, MIPS and x86 (AVX2) platforms.
  *
  * Some code came from common/rtcd.c in the WebM project.
  */
@@ -26,6 +26,7 @@ MinValueW16 WebRtcSpl_MinValueW16;
 MinValueW32 WebRtcSpl_MinValueW32;
 CrossCorrelation WebRtcSpl_CrossCorrelation;
 DownsampleFast WebRtcSpl_DownsampleFast;
+FilterMAFastQ12 WebRtcSpl_FilterMAFastQ12;
 ScaleAndAddVectorsWithRound WebRtcSpl_ScaleAndAddVectorsWithRound;
 
 #if (!defined(WEBRTC_HAS_NEON)) && !defined(MIPS32_LE)
@@ -39,11 +40,23 @@ static void InitPointersToC() {
   WebRtcSpl_MinValueW32 = WebRtcSpl_MinValueW32C;
   WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationC;
   WebRtcSpl_DownsampleFast = WebRtcSpl_DownsampleFastC;
+  WebRtcSpl_FilterMAFastQ12 = WebRtcSpl_FilterMAFastQ12C;
   WebRtcSpl_ScaleAndAddVectorsWithRound =
       WebRtcSpl_ScaleAndAddVectorsWithRoundC;
 }
 #endif
 
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+/* Initialize the function pointers having an AVX2 version to it. */
+static void InitPointersToAvx2() {
+  WebRtcSpl_MaxAbsValueW16 = WebRtcSpl_MaxAbsValueW16Avx2;
+  WebRtcSpl_MaxValueW32 = WebRtcSpl_MaxValueW32Avx2;
+  WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationAvx2;
+  WebRtcSpl_DownsampleFast = WebRtcSpl_DownsampleFastAvx2;
+  WebRtcSpl_FilterMAFastQ12 = WebRtcSpl_FilterMAFastQ12Avx2;
+}
+#endif
+
 #if defined(WEBRTC_HAS_NEON)
 /* Initialize function pointers to the Neon version. */
 static void InitPointersToNeon() {
@@ -55,6 +68,7 @@ static void InitPointersToNeon() {
   WebRtcSpl_MinValueW32 = WebRtcSpl_MinValueW32Neon;
   WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelationNeon;
   WebRtcSpl_DownsampleFast = WebRtcSpl_DownsampleFastNeon;
+  WebRtcSpl_FilterMAFastQ12 = WebRtcSpl_FilterMAFastQ12C;
   WebRtcSpl_ScaleAndAddVectorsWithRound =
       WebRtcSpl_ScaleAndAddVectorsWithRoundC;
 }
@@ -70,6 +84,7 @@ static void InitPointersToMIPS() {
   WebRtcSpl_MinValueW32 = WebRtcSpl_MinValueW32_mips;
   WebRtcSpl_CrossCorrelation = WebRtcSpl_CrossCorrelation_mips;
   WebRtcSpl_DownsampleFast = WebRtcSpl_DownsampleFast_mips;
+  WebRtcSpl_FilterMAFastQ12 = WebRtcSpl_FilterMAFastQ12C;
 #if defined(MIPS_DSP_R1_LE)
   WebRtcSpl_MaxAbsValueW32 = WebRtcSpl_MaxAbsValueW32_mips;
   WebRtcSpl_ScaleAndAddVectorsWithRound =
@@ -89,6 +104,10 @@ static void InitFunctionPointers(void) {
   InitPointersToMIPS();
 #else
   InitPointersToC();
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2))
+    InitPointersToAvx2();
+#endif
 #endif  /* WEBRTC_HAS_NEON */
 }
 
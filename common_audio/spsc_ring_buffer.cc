@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/spsc_ring_buffer.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <limits>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+
+namespace webrtc {
+
+SpscRingBuffer::SpscRingBuffer(size_t capacity)
+    : size_(static_cast<int>(capacity) + 1),
+      data_(new int16_t[capacity + 1]),
+      read_pos_(0),
+      write_pos_(0) {
+  RTC_CHECK_GT(capacity, 0u);
+  RTC_CHECK_LT(capacity,
+               static_cast<size_t>(std::numeric_limits<int>::max()));
+}
+
+SpscRingBuffer::~SpscRingBuffer() = default;
+
+size_t SpscRingBuffer::Write(const int16_t* data, size_t num_samples) {
+  // Only this thread moves |write_pos_|, so a plain load suffices for it.
+  const int write_pos = write_pos_;
+  const int read_pos = rtc::AtomicOps::AcquireLoad(&read_pos_);
+  const size_t space = (read_pos + size_ - write_pos - 1) % size_;
+  num_samples = std::min(num_samples, space);
+
+  const size_t first = std::min(num_samples,
+                                static_cast<size_t>(size_ - write_pos));
+  memcpy(&data_[write_pos], data, first * sizeof(int16_t));
+  memcpy(&data_[0], data + first, (num_samples - first) * sizeof(int16_t));
+
+  rtc::AtomicOps::ReleaseStore(
+      &write_pos_, static_cast<int>((write_pos + num_samples) % size_));
+  return num_samples;
+}
+
+size_t SpscRingBuffer::Read(int16_t* data, size_t num_samples) {
+  // Only this thread moves |read_pos_|, so a plain load suffices for it.
+  const int read_pos = read_pos_;
+  const int write_pos = rtc::AtomicOps::AcquireLoad(&write_pos_);
+  const size_t available = (write_pos + size_ - read_pos) % size_;
+  num_samples = std::min(num_samples, available);
+
+  const size_t first = std::min(num_samples,
+                                static_cast<size_t>(size_ - read_pos));
+  memcpy(data, &data_[read_pos], first * sizeof(int16_t));
+  memcpy(data + first, &data_[0], (num_samples - first) * sizeof(int16_t));
+
+  rtc::AtomicOps::ReleaseStore(
+      &read_pos_, static_cast<int>((read_pos + num_samples) % size_));
+  return num_samples;
+}
+
+void SpscRingBuffer::Clear() {
+  rtc::AtomicOps::ReleaseStore(&read_pos_,
+                               rtc::AtomicOps::AcquireLoad(&write_pos_));
+}
+
+size_t SpscRingBuffer::ReadSamplesAvailable() const {
+  const int read_pos = rtc::AtomicOps::AcquireLoad(&read_pos_);
+  const int write_pos = rtc::AtomicOps::AcquireLoad(&write_pos_);
+  return (write_pos + size_ - read_pos) % size_;
+}
+
+size_t SpscRingBuffer::WriteSamplesAvailable() const {
+  return capacity() - ReadSamplesAvailable();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_COMMON_AUDIO_SPSC_RING_BUFFER_H_
+#define WEBRTC_COMMON_AUDIO_SPSC_RING_BUFFER_H_
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+// A lock-free ring buffer of 16-bit samples for exactly one producer thread
+// and one consumer thread. Unlike RingBuffer and AudioRingBuffer, Write() and
+// Read() may run concurrently without any locking, as long as each is only
+// called from a single thread at a time. Only the producer moves the write
+// position and only the consumer moves the read position, and each publishes
+// its position with release semantics after copying the samples.
+class SpscRingBuffer final {
+ public:
+  // Creates a buffer that holds at most |capacity| samples.
+  explicit SpscRingBuffer(size_t capacity);
+  ~SpscRingBuffer();
+
+  // Producer side. Copies as many of the |num_samples| samples in |data| as
+  // fit and returns the number of samples written.
+  size_t Write(const int16_t* data, size_t num_samples);
+
+  // Consumer side. Copies up to |num_samples| samples to |data| and returns
+  // the number of samples read.
+  size_t Read(int16_t* data, size_t num_samples);
+
+  // Consumer side. Discards all samples currently in the buffer.
+  void Clear();
+
+  // May be called from either side; the result is only a snapshot.
+  size_t ReadSamplesAvailable() const;
+  size_t WriteSamplesAvailable() const;
+
+  size_t capacity() const { return size_ - 1; }
+
+ private:
+  // One slot is always left empty to tell a full buffer from an empty one.
+  const int size_;
+  const std::unique_ptr<int16_t[]> data_;
+  volatile int read_pos_;
+  volatile int write_pos_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(SpscRingBuffer);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_COMMON_AUDIO_SPSC_RING_BUFFER_H_
@@ -0,0 +1,103 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/spsc_ring_buffer.h"
+
+#include <vector>
+
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+TEST(SpscRingBufferTest, WritesAndReadsAcrossTheWrapAround) {
+  SpscRingBuffer buffer(5);
+  EXPECT_EQ(5u, buffer.capacity());
+  EXPECT_EQ(0u, buffer.ReadSamplesAvailable());
+  EXPECT_EQ(5u, buffer.WriteSamplesAvailable());
+
+  const int16_t kInput[] = {1, 2, 3, 4, 5, 6, 7};
+  int16_t output[7] = {0};
+  EXPECT_EQ(3u, buffer.Write(kInput, 3));
+  EXPECT_EQ(2u, buffer.Read(output, 2));
+  EXPECT_EQ(1, output[0]);
+  EXPECT_EQ(2, output[1]);
+
+  // Only four samples fit; the write wraps around the end of the storage.
+  EXPECT_EQ(4u, buffer.Write(&kInput[3], 4));
+  EXPECT_EQ(5u, buffer.ReadSamplesAvailable());
+  EXPECT_EQ(0u, buffer.WriteSamplesAvailable());
+  EXPECT_EQ(0u, buffer.Write(kInput, 1));
+
+  EXPECT_EQ(5u, buffer.Read(output, 7));
+  for (int i = 0; i < 5; ++i)
+    EXPECT_EQ(kInput[i + 2], output[i]);
+  EXPECT_EQ(0u, buffer.Read(output, 1));
+}
+
+TEST(SpscRingBufferTest, Clear) {
+  SpscRingBuffer buffer(8);
+  const int16_t kInput[] = {1, 2, 3};
+  buffer.Write(kInput, 3);
+  buffer.Clear();
+  EXPECT_EQ(0u, buffer.ReadSamplesAvailable());
+  EXPECT_EQ(8u, buffer.WriteSamplesAvailable());
+}
+
+namespace {
+
+const int kNumStressSamples = 1 << 20;
+
+struct StressState {
+  explicit StressState(size_t capacity) : buffer(capacity) {}
+  SpscRingBuffer buffer;
+  std::vector<int16_t> received;
+};
+
+bool ProduceSamples(void* obj) {
+  StressState* state = static_cast<StressState*>(obj);
+  int16_t chunk[37];
+  int next = 0;
+  while (next < kNumStressSamples) {
+    size_t count = 0;
+    for (; count < 37 && next + static_cast<int>(count) < kNumStressSamples;
+         ++count) {
+      chunk[count] = static_cast<int16_t>(next + count);
+    }
+    size_t written = 0;
+    while (written < count)
+      written += state->buffer.Write(&chunk[written], count - written);
+    next += static_cast<int>(count);
+  }
+  return false;
+}
+
+}  // namespace
+
+// Moves a counting sequence between two threads with chunk sizes that do not
+// divide the capacity, and checks that no sample is lost, duplicated or
+// reordered.
+TEST(SpscRingBufferTest, ConcurrentProducerAndConsumer) {
+  StressState state(160);
+  rtc::PlatformThread producer(&ProduceSamples, &state, "SpscProducer");
+  producer.Start();
+
+  int16_t chunk[53];
+  while (state.received.size() < static_cast<size_t>(kNumStressSamples)) {
+    const size_t read = state.buffer.Read(chunk, 53);
+    state.received.insert(state.received.end(), chunk, chunk + read);
+  }
+  producer.Stop();
+
+  for (int i = 0; i < kNumStressSamples; ++i)
+    ASSERT_EQ(static_cast<int16_t>(i), state.received[i]) << i;
+}
+
+}  // namespace webrtc
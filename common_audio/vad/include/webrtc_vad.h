@@ -70,6 +70,27 @@ int WebRtcVad_set_mode(VadInst* handle, int mode);
 int WebRtcVad_Process(VadInst* handle, int fs, const int16_t* audio_frame,
                       size_t frame_length);
 
+// Calculates a VAD decision for one frame of each of |num_handles| streams
+// with the same sampling frequency and frame length, e.g. the participants of
+// a conference on a server. The decisions are the same as those of
+// WebRtcVad_Process() on each stream, but the streams are processed together,
+// several at a time, with SIMD where available.
+//
+// - handles      [i/o] : VAD instances, one per stream. Need to be
+//                        initialized by WebRtcVad_Init() before call.
+// - num_handles  [i]   : Number of streams.
+// - fs           [i]   : Sampling frequency (Hz): 8000, 16000, or 32000
+// - audio_frames [i]   : Audio frame buffer of each stream.
+// - frame_length [i]   : Length of each audio frame buffer in number of
+//                        samples.
+// - vad          [o]   : VAD decision of each stream: 1 - (Active Voice) or
+//                        0 - (Non-active Voice).
+//
+// returns              : 0 - (OK), -1 - (Error)
+int WebRtcVad_ProcessBatch(VadInst* const* handles, size_t num_handles,
+                           int fs, const int16_t* const* audio_frames,
+                           size_t frame_length, int* vad);
+
 // Checks for valid combinations of |rate| and |frame_length|. We support 10,
 // 20 and 30 ms frames and the rates 8000, 16000 and 32000 Hz.
 //
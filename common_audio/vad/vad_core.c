@@ -10,6 +10,7 @@
 
 #include "webrtc/common_audio/vad/vad_core.h"
 
+#include "webrtc/base/checks.h"
 #include "webrtc/base/sanitizer.h"
 #include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
 #include "webrtc/common_audio/vad/vad_filterbank.h"
@@ -602,72 +603,79 @@ int WebRtcVad_set_mode_core(VadInstT* self, int mode) {
   return return_value;
 }
 
-// Calculate VAD decision by first extracting feature values and then calculate
-// probability for both speech and background noise.
-
-int WebRtcVad_CalcVad48khz(VadInstT* inst, const int16_t* speech_frame,
-                           size_t frame_length) {
-  int vad;
-  size_t i;
-  int16_t speech_nb[240];  // 30 ms in 8 kHz.
+// Downsamples |speech_frame| of |inst| from |fs| (16000, 32000 or 48000 Hz)
+// to 8 kHz and returns the number of samples written to |speech_nb|.
+static size_t DownsampleTo8khz(VadInstT* inst, int fs,
+                               const int16_t* speech_frame,
+                               size_t frame_length, int16_t* speech_nb) {
+  int16_t speech_wb[480];  // 30 ms in 16 kHz.
   // |tmp_mem| is a temporary memory used by resample function, length is
   // frame length in 10 ms (480 samples) + 256 extra.
   int32_t tmp_mem[480 + 256] = { 0 };
   const size_t kFrameLen10ms48khz = 480;
   const size_t kFrameLen10ms8khz = 80;
-  size_t num_10ms_frames = frame_length / kFrameLen10ms48khz;
+  size_t i;
 
-  for (i = 0; i < num_10ms_frames; i++) {
-    WebRtcSpl_Resample48khzTo8khz(speech_frame,
-                                  &speech_nb[i * kFrameLen10ms8khz],
-                                  &inst->state_48_to_8,
-                                  tmp_mem);
+  switch (fs) {
+    case 48000:
+      for (i = 0; i < frame_length / kFrameLen10ms48khz; i++) {
+        WebRtcSpl_Resample48khzTo8khz(speech_frame,
+                                      &speech_nb[i * kFrameLen10ms8khz],
+                                      &inst->state_48_to_8, tmp_mem);
+      }
+      return frame_length / 6;
+    case 32000:
+      WebRtcVad_Downsampling(speech_frame, speech_wb,
+                             &inst->downsampling_filter_states[2],
+                             frame_length);
+      WebRtcVad_Downsampling(speech_wb, speech_nb,
+                             inst->downsampling_filter_states,
+                             frame_length / 2);
+      return frame_length / 4;
+    default:
+      RTC_DCHECK_EQ(16000, fs);
+      WebRtcVad_Downsampling(speech_frame, speech_nb,
+                             inst->downsampling_filter_states, frame_length);
+      return frame_length / 2;
   }
+}
 
-  // Do VAD on an 8 kHz signal
-  vad = WebRtcVad_CalcVad8khz(inst, speech_nb, frame_length / 6);
+// Calculate VAD decision by first extracting feature values and then calculate
+// probability for both speech and background noise.
+
+int WebRtcVad_CalcVad48khz(VadInstT* inst, const int16_t* speech_frame,
+                           size_t frame_length) {
+  int16_t speech_nb[240];  // 30 ms in 8 kHz.
+  const size_t len = DownsampleTo8khz(inst, 48000, speech_frame, frame_length,
+                                      speech_nb);
 
-  return vad;
+  // Do VAD on an 8 kHz signal
+  return WebRtcVad_CalcVad8khz(inst, speech_nb, len);
 }
 
 int WebRtcVad_CalcVad32khz(VadInstT* inst, const int16_t* speech_frame,
                            size_t frame_length)
 {
-    size_t len;
-    int vad;
-    int16_t speechWB[480]; // Downsampled speech frame: 960 samples (30ms in SWB)
     int16_t speechNB[240]; // Downsampled speech frame: 480 samples (30ms in WB)
 
-
     // Downsample signal 32->16->8 before doing VAD
-    WebRtcVad_Downsampling(speech_frame, speechWB, &(inst->downsampling_filter_states[2]),
-                           frame_length);
-    len = frame_length / 2;
-
-    WebRtcVad_Downsampling(speechWB, speechNB, inst->downsampling_filter_states, len);
-    len /= 2;
+    const size_t len = DownsampleTo8khz(inst, 32000, speech_frame,
+                                        frame_length, speechNB);
 
     // Do VAD on an 8 kHz signal
-    vad = WebRtcVad_CalcVad8khz(inst, speechNB, len);
-
-    return vad;
+    return WebRtcVad_CalcVad8khz(inst, speechNB, len);
 }
 
 int WebRtcVad_CalcVad16khz(VadInstT* inst, const int16_t* speech_frame,
                            size_t frame_length)
 {
-    size_t len;
-    int vad;
     int16_t speechNB[240]; // Downsampled speech frame: 480 samples (30ms in WB)
 
     // Wideband: Downsample signal before doing VAD
-    WebRtcVad_Downsampling(speech_frame, speechNB, inst->downsampling_filter_states,
-                           frame_length);
+    const size_t len = DownsampleTo8khz(inst, 16000, speech_frame,
+                                        frame_length, speechNB);
 
-    len = frame_length / 2;
-    vad = WebRtcVad_CalcVad8khz(inst, speechNB, len);
-
-    return vad;
+    return WebRtcVad_CalcVad8khz(inst, speechNB, len);
 }
 
 int WebRtcVad_CalcVad8khz(VadInstT* inst, const int16_t* speech_frame,
@@ -684,3 +692,42 @@ int WebRtcVad_CalcVad8khz(VadInstT* inst, const int16_t* speech_frame,
 
     return inst->vad;
 }
+
+void WebRtcVad_CalcVadBatch(VadInstT* const* insts, size_t num_insts, int fs,
+                            const int16_t* const* speech_frames,
+                            size_t frame_length, int* vad) {
+  int16_t speech_nb[kVadBatchLanes][240];  // 30 ms in 8 kHz.
+  const int16_t* data_in[kVadBatchLanes];
+  int16_t features[kVadBatchLanes][kNumChannels];
+  int16_t total_energy[kVadBatchLanes];
+  size_t length = frame_length;
+  size_t n;
+  size_t k;
+
+  for (n = 0; n < num_insts; n += kVadBatchLanes) {
+    const size_t lanes = num_insts - n < kVadBatchLanes ? num_insts - n
+                                                        : kVadBatchLanes;
+    VadInstT* const* lane_insts = &insts[n];
+
+    // Downsampling has a different structure than the filter bank and is
+    // kept per stream; 8 kHz frames are used as is.
+    for (k = 0; k < lanes; k++) {
+      if (fs == 8000) {
+        data_in[k] = speech_frames[n + k];
+      } else {
+        length = DownsampleTo8khz(lane_insts[k], fs, speech_frames[n + k],
+                                  frame_length, speech_nb[k]);
+        data_in[k] = speech_nb[k];
+      }
+    }
+
+    WebRtcVad_CalculateFeaturesBatch(lane_insts, lanes, data_in, length,
+                                     features, total_energy);
+
+    for (k = 0; k < lanes; k++) {
+      lane_insts[k]->vad = GmmProbability(lane_insts[k], features[k],
+                                          total_energy[k], length);
+      vad[n + k] = lane_insts[k]->vad;
+    }
+  }
+}
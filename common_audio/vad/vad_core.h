@@ -23,6 +23,7 @@ enum { kNumChannels = 6 };  // Number of frequency bands (named channels).
 enum { kNumGaussians = 2 };  // Number of Gaussians per channel in the GMM.
 enum { kTableSize = kNumChannels * kNumGaussians };
 enum { kMinEnergy = 10 };  // Minimum energy required to trigger audio signal.
+enum { kVadBatchLanes = 8 };  // Number of streams filtered together.
 
 typedef struct VadInstT_
 {
@@ -112,4 +113,20 @@ int WebRtcVad_CalcVad16khz(VadInstT* inst, const int16_t* speech_frame,
 int WebRtcVad_CalcVad8khz(VadInstT* inst, const int16_t* speech_frame,
                           size_t frame_length);
 
+// Calculates the VAD decisions of one frame for each of |num_insts| streams,
+// sampled at the same rate |fs|. The decisions are the same as those of
+// WebRtcVad_CalcVad48khz() etc. called on each instance, but the filter bank
+// of |kVadBatchLanes| streams at a time runs with one stream per SIMD lane.
+//
+// - insts         [i/o] : VAD instances, one per stream.
+// - num_insts     [i]   : Number of streams.
+// - fs            [i]   : Sampling frequency (Hz): 8000, 16000, 32000 or 48000.
+// - speech_frames [i]   : Input speech frame of each stream.
+// - frame_length  [i]   : Number of input samples of each stream.
+// - vad           [o]   : VAD decision of each stream, 0 (no active speech) or
+//                         1-6 (active speech).
+void WebRtcVad_CalcVadBatch(VadInstT* const* insts, size_t num_insts, int fs,
+                            const int16_t* const* speech_frames,
+                            size_t frame_length, int* vad);
+
 #endif  // WEBRTC_COMMON_AUDIO_VAD_VAD_CORE_H_
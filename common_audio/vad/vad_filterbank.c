@@ -12,6 +12,7 @@
 
 #include "webrtc/base/checks.h"
 #include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/typedefs.h"
 
 // Constants used in LogOfEnergy().
@@ -328,3 +329,178 @@ int16_t WebRtcVad_CalculateFeatures(VadInstT* self, const int16_t* data_in,
 
   return total_energy;
 }
+
+void WebRtcVad_SplitFilterLanes_C(const int16_t* data_in,
+                                  size_t data_length,
+                                  int16_t upper_coefficient,
+                                  int16_t lower_coefficient,
+                                  int16_t* upper_state,
+                                  int16_t* lower_state,
+                                  int16_t* hp_data_out,
+                                  int16_t* lp_data_out) {
+  const size_t half_length = data_length >> 1;
+  size_t i;
+  int k;
+
+  // Same as SplitFilter() on each stream; see AllPassFilter() for the
+  // fixed-point details.
+  for (k = 0; k < kVadBatchLanes; k++) {
+    int32_t upper_state32 = ((int32_t) upper_state[k] << 16);  // Q15
+    int32_t lower_state32 = ((int32_t) lower_state[k] << 16);  // Q15
+    const int16_t* in_ptr = &data_in[k];
+
+    for (i = 0; i < half_length; i++) {
+      const int16_t upper_in = in_ptr[0];
+      const int16_t lower_in = in_ptr[kVadBatchLanes];
+      const int16_t hp = (int16_t) ((upper_state32 +
+          upper_coefficient * upper_in) >> 16);  // Q(-1)
+      const int16_t lp = (int16_t) ((lower_state32 +
+          lower_coefficient * lower_in) >> 16);  // Q(-1)
+      upper_state32 = ((upper_in << 14) - upper_coefficient * hp) << 1;
+      lower_state32 = ((lower_in << 14) - lower_coefficient * lp) << 1;
+      hp_data_out[i * kVadBatchLanes + k] = hp - lp;
+      lp_data_out[i * kVadBatchLanes + k] = lp + hp;
+      in_ptr += 2 * kVadBatchLanes;
+    }
+
+    upper_state[k] = (int16_t) (upper_state32 >> 16);  // Q(-1)
+    lower_state[k] = (int16_t) (lower_state32 >> 16);  // Q(-1)
+  }
+}
+
+static VadSplitFilterLanes GetSplitFilterLanes(void) {
+#if defined(WEBRTC_HAS_NEON)
+  return WebRtcVad_SplitFilterLanes_NEON;
+#elif defined(WEBRTC_ARCH_X86_FAMILY) && defined(__SSE2__)
+  return WebRtcVad_SplitFilterLanes_SSE2;
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  return WebRtc_GetCPUInfo(kSSE2) ? WebRtcVad_SplitFilterLanes_SSE2
+                                  : WebRtcVad_SplitFilterLanes_C;
+#else
+  return WebRtcVad_SplitFilterLanes_C;
+#endif
+}
+
+// Runs the split filter of |frequency_band| on the interleaved |data_in| of
+// all the lanes, with the filter states of the |num_insts| streams.
+static void SplitFilterBatch(VadSplitFilterLanes split_filter,
+                             VadInstT* const* insts, size_t num_insts,
+                             int frequency_band, const int16_t* data_in,
+                             size_t data_length, int16_t* hp_data_out,
+                             int16_t* lp_data_out) {
+  int16_t upper_state[kVadBatchLanes] = { 0 };
+  int16_t lower_state[kVadBatchLanes] = { 0 };
+  size_t k;
+
+  for (k = 0; k < num_insts; k++) {
+    upper_state[k] = insts[k]->upper_state[frequency_band];
+    lower_state[k] = insts[k]->lower_state[frequency_band];
+  }
+  split_filter(data_in, data_length, kAllPassCoefsQ15[0], kAllPassCoefsQ15[1],
+               upper_state, lower_state, hp_data_out, lp_data_out);
+  for (k = 0; k < num_insts; k++) {
+    insts[k]->upper_state[frequency_band] = upper_state[k];
+    insts[k]->lower_state[frequency_band] = lower_state[k];
+  }
+}
+
+// Runs LogOfEnergy() on the interleaved |data_in| of each of the |num_insts|
+// streams, for feature |feature_index|.
+static void LogOfEnergyBatch(const int16_t* data_in, size_t num_insts,
+                             size_t data_length, int feature_index,
+                             int16_t* total_energy,
+                             int16_t (*features)[kNumChannels]) {
+  int16_t data[60];
+  size_t i, k;
+
+  for (k = 0; k < num_insts; k++) {
+    for (i = 0; i < data_length; i++) {
+      data[i] = data_in[i * kVadBatchLanes + k];
+    }
+    LogOfEnergy(data, data_length, kOffsetVector[feature_index],
+                &total_energy[k], &features[k][feature_index]);
+  }
+}
+
+void WebRtcVad_CalculateFeaturesBatch(VadInstT* const* insts,
+                                      size_t num_insts,
+                                      const int16_t* const* data_in,
+                                      size_t data_length,
+                                      int16_t (*features)[kNumChannels],
+                                      int16_t* total_energy) {
+  // The same buffers as in WebRtcVad_CalculateFeatures(), for all the lanes.
+  int16_t in_lanes[240 * kVadBatchLanes];
+  int16_t hp_120[120 * kVadBatchLanes], lp_120[120 * kVadBatchLanes];
+  int16_t hp_60[60 * kVadBatchLanes], lp_60[60 * kVadBatchLanes];
+  int16_t lp_data[60], hp_data[60];
+  const size_t half_data_length = data_length >> 1;
+  size_t length = half_data_length;
+  const VadSplitFilterLanes split_filter = GetSplitFilterLanes();
+  size_t i, k;
+
+  RTC_DCHECK_LE(data_length, 240);
+  RTC_DCHECK_GT(num_insts, 0);
+  RTC_DCHECK_LE(num_insts, kVadBatchLanes);
+
+  // Interleave the streams. Unused lanes are filtered as silence.
+  for (i = 0; i < data_length; i++) {
+    for (k = 0; k < num_insts; k++) {
+      in_lanes[i * kVadBatchLanes + k] = data_in[k][i];
+    }
+    for (; k < kVadBatchLanes; k++) {
+      in_lanes[i * kVadBatchLanes + k] = 0;
+    }
+  }
+  for (k = 0; k < num_insts; k++) {
+    total_energy[k] = 0;
+  }
+
+  // Split at 2000 Hz and downsample.
+  SplitFilterBatch(split_filter, insts, num_insts, 0, in_lanes, data_length,
+                   hp_120, lp_120);
+
+  // For the upper band (2000 Hz - 4000 Hz) split at 3000 Hz and downsample.
+  SplitFilterBatch(split_filter, insts, num_insts, 1, hp_120, length, hp_60,
+                   lp_60);
+
+  // Energy in 3000 Hz - 4000 Hz and 2000 Hz - 3000 Hz.
+  length >>= 1;
+  LogOfEnergyBatch(hp_60, num_insts, length, 5, total_energy, features);
+  LogOfEnergyBatch(lp_60, num_insts, length, 4, total_energy, features);
+
+  // For the lower band (0 Hz - 2000 Hz) split at 1000 Hz and downsample.
+  length = half_data_length;
+  SplitFilterBatch(split_filter, insts, num_insts, 2, lp_120, length, hp_60,
+                   lp_60);
+
+  // Energy in 1000 Hz - 2000 Hz.
+  length >>= 1;
+  LogOfEnergyBatch(hp_60, num_insts, length, 3, total_energy, features);
+
+  // For the lower band (0 Hz - 1000 Hz) split at 500 Hz and downsample.
+  SplitFilterBatch(split_filter, insts, num_insts, 3, lp_60, length, hp_120,
+                   lp_120);
+
+  // Energy in 500 Hz - 1000 Hz.
+  length >>= 1;
+  LogOfEnergyBatch(hp_120, num_insts, length, 2, total_energy, features);
+
+  // For the lower band (0 Hz - 500 Hz) split at 250 Hz and downsample.
+  SplitFilterBatch(split_filter, insts, num_insts, 4, lp_120, length, hp_60,
+                   lp_60);
+
+  // Energy in 250 Hz - 500 Hz.
+  length >>= 1;
+  LogOfEnergyBatch(hp_60, num_insts, length, 1, total_energy, features);
+
+  // Remove 0 Hz - 80 Hz, by high pass filtering the lower band, and compute
+  // the energy in 80 Hz - 250 Hz. These short stages run per stream.
+  for (k = 0; k < num_insts; k++) {
+    for (i = 0; i < length; i++) {
+      lp_data[i] = lp_60[i * kVadBatchLanes + k];
+    }
+    HighPassFilter(lp_data, length, insts[k]->hp_filter_state, hp_data);
+    LogOfEnergy(hp_data, length, kOffsetVector[0], &total_energy[k],
+                &features[k][0]);
+  }
+}
@@ -41,4 +41,75 @@
 int16_t WebRtcVad_CalculateFeatures(VadInstT* self, const int16_t* data_in,
                                     size_t data_length, int16_t* features);
 
+// Does WebRtcVad_CalculateFeatures() for up to |kVadBatchLanes| streams at
+// once, with the same result.
+//
+// - insts        [i/o] : State information of the VAD of each stream.
+// - num_insts    [i]   : Number of streams, at most |kVadBatchLanes|.
+// - data_in      [i]   : Input audio data of each stream.
+// - data_length  [i]   : Audio data size of each stream, in number of samples.
+// - features     [o]   : 10 * log10(energy in each frequency band) of each
+//                        stream, Q4.
+// - total_energy [o]   : Total energy of the signal of each stream.
+void WebRtcVad_CalculateFeaturesBatch(VadInstT* const* insts,
+                                      size_t num_insts,
+                                      const int16_t* const* data_in,
+                                      size_t data_length,
+                                      int16_t (*features)[kNumChannels],
+                                      int16_t* total_energy);
+
+// The all-pass split filter of the filter bank on |kVadBatchLanes| streams,
+// with the samples of the streams interleaved: sample n of stream k is at
+// index n * kVadBatchLanes + k of the data arrays and the filter states of
+// stream k at index k of the state arrays.
+//
+// - data_in           [i]   : Input audio data, |data_length| samples per
+//                             stream.
+// - data_length       [i]   : Length of the input of each stream.
+// - upper_coefficient [i]   : All-pass coefficient of the upper branch, Q15.
+// - lower_coefficient [i]   : All-pass coefficient of the lower branch, Q15.
+// - upper_state       [i/o] : State of the upper filters, given in Q(-1).
+// - lower_state       [i/o] : State of the lower filters, given in Q(-1).
+// - hp_data_out       [o]   : Upper half of the spectrum, |data_length| / 2
+//                             samples per stream.
+// - lp_data_out       [o]   : Lower half of the spectrum, |data_length| / 2
+//                             samples per stream.
+typedef void (*VadSplitFilterLanes)(const int16_t* data_in,
+                                    size_t data_length,
+                                    int16_t upper_coefficient,
+                                    int16_t lower_coefficient,
+                                    int16_t* upper_state,
+                                    int16_t* lower_state,
+                                    int16_t* hp_data_out,
+                                    int16_t* lp_data_out);
+
+void WebRtcVad_SplitFilterLanes_C(const int16_t* data_in,
+                                  size_t data_length,
+                                  int16_t upper_coefficient,
+                                  int16_t lower_coefficient,
+                                  int16_t* upper_state,
+                                  int16_t* lower_state,
+                                  int16_t* hp_data_out,
+                                  int16_t* lp_data_out);
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+void WebRtcVad_SplitFilterLanes_SSE2(const int16_t* data_in,
+                                     size_t data_length,
+                                     int16_t upper_coefficient,
+                                     int16_t lower_coefficient,
+                                     int16_t* upper_state,
+                                     int16_t* lower_state,
+                                     int16_t* hp_data_out,
+                                     int16_t* lp_data_out);
+#endif
+#if defined(WEBRTC_HAS_NEON)
+void WebRtcVad_SplitFilterLanes_NEON(const int16_t* data_in,
+                                     size_t data_length,
+                                     int16_t upper_coefficient,
+                                     int16_t lower_coefficient,
+                                     int16_t* upper_state,
+                                     int16_t* lower_state,
+                                     int16_t* hp_data_out,
+                                     int16_t* lp_data_out);
+#endif
+
 #endif  // WEBRTC_COMMON_AUDIO_VAD_VAD_FILTERBANK_H_
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/vad/vad_filterbank.h"
+
+#include <arm_neon.h>
+
+// One step of AllPassFilter() in vad_filterbank.c on four streams.
+static inline int16x4_t AllPassStep(int16x4_t in, int16_t coefficient,
+                                    int32x4_t* state) {
+  // tmp32 = state32 + filter_coefficient * *data_in, out = tmp32 >> 16, which
+  // always fits in 16 bits.
+  const int16x4_t out =
+      vshrn_n_s32(vmlal_n_s16(*state, in, coefficient), 16);
+  // state32 = ((*data_in << 14) - filter_coefficient * out) << 1.
+  *state = vshlq_n_s32(vmlsl_n_s16(vshll_n_s16(in, 14), out, coefficient), 1);
+  return out;
+}
+
+void WebRtcVad_SplitFilterLanes_NEON(const int16_t* data_in,
+                                     size_t data_length,
+                                     int16_t upper_coefficient,
+                                     int16_t lower_coefficient,
+                                     int16_t* upper_state,
+                                     int16_t* lower_state,
+                                     int16_t* hp_data_out,
+                                     int16_t* lp_data_out) {
+  const size_t half_length = data_length >> 1;
+  // The states in Q15.
+  int32x4_t upper_lo = vshll_n_s16(vld1_s16(upper_state), 16);
+  int32x4_t upper_hi = vshll_n_s16(vld1_s16(upper_state + 4), 16);
+  int32x4_t lower_lo = vshll_n_s16(vld1_s16(lower_state), 16);
+  int32x4_t lower_hi = vshll_n_s16(vld1_s16(lower_state + 4), 16);
+  size_t i;
+
+  for (i = 0; i < half_length; i++) {
+    const int16_t* upper_in = &data_in[2 * i * kVadBatchLanes];
+    const int16_t* lower_in = upper_in + kVadBatchLanes;
+    const int16x8_t hp = vcombine_s16(
+        AllPassStep(vld1_s16(upper_in), upper_coefficient, &upper_lo),
+        AllPassStep(vld1_s16(upper_in + 4), upper_coefficient, &upper_hi));
+    const int16x8_t lp = vcombine_s16(
+        AllPassStep(vld1_s16(lower_in), lower_coefficient, &lower_lo),
+        AllPassStep(vld1_s16(lower_in + 4), lower_coefficient, &lower_hi));
+    vst1q_s16(&hp_data_out[i * kVadBatchLanes], vsubq_s16(hp, lp));
+    vst1q_s16(&lp_data_out[i * kVadBatchLanes], vaddq_s16(lp, hp));
+  }
+
+  vst1_s16(upper_state, vshrn_n_s32(upper_lo, 16));
+  vst1_s16(upper_state + 4, vshrn_n_s32(upper_hi, 16));
+  vst1_s16(lower_state, vshrn_n_s32(lower_lo, 16));
+  vst1_s16(lower_state + 4, vshrn_n_s32(lower_hi, 16));
+}
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_audio/vad/vad_filterbank.h"
+
+#include <emmintrin.h>
+
+// Multiplies the eight int16 lanes of |a| and |b| into 32 bits, returning the
+// products of the lower four lanes in |lo| and of the upper four in |hi|.
+static inline void MultiplyWiden(__m128i a, __m128i b, __m128i* lo,
+                                 __m128i* hi) {
+  const __m128i products_lo = _mm_mullo_epi16(a, b);
+  const __m128i products_hi = _mm_mulhi_epi16(a, b);
+  *lo = _mm_unpacklo_epi16(products_lo, products_hi);
+  *hi = _mm_unpackhi_epi16(products_lo, products_hi);
+}
+
+// One step of AllPassFilter() in vad_filterbank.c on eight streams.
+static inline __m128i AllPassStep(__m128i in, __m128i coefficient,
+                                  __m128i* state_lo, __m128i* state_hi) {
+  const __m128i zero = _mm_setzero_si128();
+  __m128i product_lo, product_hi;
+  __m128i out;
+  // tmp32 = state32 + filter_coefficient * *data_in, out = tmp32 >> 16, which
+  // always fits in 16 bits.
+  MultiplyWiden(coefficient, in, &product_lo, &product_hi);
+  out = _mm_packs_epi32(
+      _mm_srai_epi32(_mm_add_epi32(*state_lo, product_lo), 16),
+      _mm_srai_epi32(_mm_add_epi32(*state_hi, product_hi), 16));
+  // state32 = ((*data_in << 14) - filter_coefficient * out) << 1.
+  MultiplyWiden(coefficient, out, &product_lo, &product_hi);
+  *state_lo = _mm_slli_epi32(
+      _mm_sub_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(zero, in), 2),
+                    product_lo), 1);
+  *state_hi = _mm_slli_epi32(
+      _mm_sub_epi32(_mm_srai_epi32(_mm_unpackhi_epi16(zero, in), 2),
+                    product_hi), 1);
+  return out;
+}
+
+void WebRtcVad_SplitFilterLanes_SSE2(const int16_t* data_in,
+                                     size_t data_length,
+                                     int16_t upper_coefficient,
+                                     int16_t lower_coefficient,
+                                     int16_t* upper_state,
+                                     int16_t* lower_state,
+                                     int16_t* hp_data_out,
+                                     int16_t* lp_data_out) {
+  const size_t half_length = data_length >> 1;
+  const __m128i upper_coef = _mm_set1_epi16(upper_coefficient);
+  const __m128i lower_coef = _mm_set1_epi16(lower_coefficient);
+  const __m128i zero = _mm_setzero_si128();
+  // The states in Q15, i.e. the 16-bit states in the upper half of each
+  // 32-bit lane.
+  const __m128i upper = _mm_loadu_si128((const __m128i*) upper_state);
+  const __m128i lower = _mm_loadu_si128((const __m128i*) lower_state);
+  __m128i upper_lo = _mm_unpacklo_epi16(zero, upper);
+  __m128i upper_hi = _mm_unpackhi_epi16(zero, upper);
+  __m128i lower_lo = _mm_unpacklo_epi16(zero, lower);
+  __m128i lower_hi = _mm_unpackhi_epi16(zero, lower);
+  size_t i;
+
+  for (i = 0; i < half_length; i++) {
+    const __m128i upper_in = _mm_loadu_si128(
+        (const __m128i*) &data_in[2 * i * kVadBatchLanes]);
+    const __m128i lower_in = _mm_loadu_si128(
+        (const __m128i*) &data_in[(2 * i + 1) * kVadBatchLanes]);
+    const __m128i hp = AllPassStep(upper_in, upper_coef, &upper_lo,
+                                   &upper_hi);
+    const __m128i lp = AllPassStep(lower_in, lower_coef, &lower_lo,
+                                   &lower_hi);
+    _mm_storeu_si128((__m128i*) &hp_data_out[i * kVadBatchLanes],
+                     _mm_sub_epi16(hp, lp));
+    _mm_storeu_si128((__m128i*) &lp_data_out[i * kVadBatchLanes],
+                     _mm_add_epi16(lp, hp));
+  }
+
+  _mm_storeu_si128((__m128i*) upper_state,
+                   _mm_packs_epi32(_mm_srai_epi32(upper_lo, 16),
+                                   _mm_srai_epi32(upper_hi, 16)));
+  _mm_storeu_si128((__m128i*) lower_state,
+                   _mm_packs_epi32(_mm_srai_epi32(lower_lo, 16),
+                                   _mm_srai_epi32(lower_hi, 16)));
+}
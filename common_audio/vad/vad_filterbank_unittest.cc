@@ -10,7 +10,10 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
+
 #include "webrtc/common_audio/vad/vad_unittest.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 #include "webrtc/test/gtest.h"
 #include "webrtc/typedefs.h"
 
@@ -89,4 +92,95 @@ TEST_F(VadTest, vad_filterbank) {
 
   free(self);
 }
+
+TEST_F(VadTest, vad_filterbank_batch) {
+  // Streams with different signals, which are also different from frame to
+  // frame, so that the filter states of the lanes diverge.
+  const size_t kNumStreams = kVadBatchLanes + 3;
+  VadInstT selves[kNumStreams];
+  VadInstT batch_selves[kNumStreams];
+  VadInstT* batch_insts[kNumStreams];
+  int16_t speech[kNumStreams][240];
+  const int16_t* data_in[kNumStreams];
+  int16_t features[kNumChannels];
+  int16_t batch_features[kVadBatchLanes][kNumChannels];
+  int16_t batch_total_energy[kVadBatchLanes];
+
+  for (size_t n = 0; n < kNumStreams; ++n) {
+    ASSERT_EQ(0, WebRtcVad_InitCore(&selves[n]));
+    ASSERT_EQ(0, WebRtcVad_InitCore(&batch_selves[n]));
+    batch_insts[n] = &batch_selves[n];
+    data_in[n] = speech[n];
+  }
+  srand(17);
+  for (int frame = 0; frame < 20; ++frame) {
+    const size_t frame_length = kFrameLengths[frame % 4 == 1 ? 2 : frame % 4];
+    for (size_t n = 0; n < kNumStreams; ++n) {
+      for (size_t i = 0; i < frame_length; ++i) {
+        speech[n][i] = n % 3 == 0 ? static_cast<int16_t>(i * i * (n + 1))
+            : static_cast<int16_t>((rand() % 65536) >> (n % 8));
+      }
+    }
+    for (size_t n = 0; n < kNumStreams; n += kVadBatchLanes) {
+      const size_t lanes = std::min<size_t>(kVadBatchLanes, kNumStreams - n);
+      WebRtcVad_CalculateFeaturesBatch(&batch_insts[n], lanes, &data_in[n],
+                                       frame_length, batch_features,
+                                       batch_total_energy);
+      for (size_t k = 0; k < lanes; ++k) {
+        EXPECT_EQ(WebRtcVad_CalculateFeatures(&selves[n + k], speech[n + k],
+                                              frame_length, features),
+                  batch_total_energy[k]);
+        for (int c = 0; c < kNumChannels; ++c) {
+          EXPECT_EQ(features[c], batch_features[k][c]);
+        }
+      }
+    }
+  }
+}
+
+TEST_F(VadTest, vad_filterbank_split_filter_lanes) {
+  const size_t kLength = 240;
+  int16_t data_in[kLength * kVadBatchLanes];
+  int16_t upper_state[kVadBatchLanes];
+  int16_t lower_state[kVadBatchLanes];
+  int16_t hp_out[kLength / 2 * kVadBatchLanes];
+  int16_t lp_out[kLength / 2 * kVadBatchLanes];
+  int16_t simd_upper_state[kVadBatchLanes];
+  int16_t simd_lower_state[kVadBatchLanes];
+  int16_t simd_hp_out[kLength / 2 * kVadBatchLanes];
+  int16_t simd_lp_out[kLength / 2 * kVadBatchLanes];
+  VadSplitFilterLanes simd_split_filter = nullptr;
+#if defined(WEBRTC_HAS_NEON)
+  simd_split_filter = WebRtcVad_SplitFilterLanes_NEON;
+#elif defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2) != 0)
+    simd_split_filter = WebRtcVad_SplitFilterLanes_SSE2;
+#endif
+  if (!simd_split_filter)
+    return;
+
+  srand(17);
+  for (size_t i = 0; i < kLength * kVadBatchLanes; ++i) {
+    // Full scale input, to exercise the extremes of the fixed-point math.
+    data_in[i] = static_cast<int16_t>(rand() % 65536 - 32768);
+  }
+  for (int k = 0; k < kVadBatchLanes; ++k) {
+    upper_state[k] = simd_upper_state[k] =
+        static_cast<int16_t>(rand() % 65536 - 32768);
+    lower_state[k] = simd_lower_state[k] =
+        static_cast<int16_t>(rand() % 65536 - 32768);
+  }
+  WebRtcVad_SplitFilterLanes_C(data_in, kLength, 20972, 5571, upper_state,
+                               lower_state, hp_out, lp_out);
+  simd_split_filter(data_in, kLength, 20972, 5571, simd_upper_state,
+                    simd_lower_state, simd_hp_out, simd_lp_out);
+  for (size_t i = 0; i < kLength / 2 * kVadBatchLanes; ++i) {
+    EXPECT_EQ(hp_out[i], simd_hp_out[i]);
+    EXPECT_EQ(lp_out[i], simd_lp_out[i]);
+  }
+  for (int k = 0; k < kVadBatchLanes; ++k) {
+    EXPECT_EQ(upper_state[k], simd_upper_state[k]);
+    EXPECT_EQ(lower_state[k], simd_lower_state[k]);
+  }
+}
 }  // namespace
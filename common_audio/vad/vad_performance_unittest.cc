@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "webrtc/common_audio/vad/include/webrtc_vad.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+constexpr size_t kNumStreams = 100;
+constexpr int kNumIterations = 1000;
+}  // namespace
+
+// Time to run the VAD on 10 ms of each of |kNumStreams| streams, as for the
+// participants of a conference on a server, one stream at a time and with
+// the streams in a batch.
+TEST(VadPerformanceTest, ManyStreams) {
+  Clock* clock = Clock::GetRealTimeClock();
+
+  for (int rate_hz : {8000, 16000, 48000}) {
+    const size_t frame_length = rate_hz / 100;
+    const std::string trace = std::to_string(rate_hz) + "_hz";
+    std::vector<std::vector<int16_t>> speech(
+        kNumStreams, std::vector<int16_t>(frame_length));
+    std::vector<const int16_t*> frames(kNumStreams);
+    std::vector<VadInst*> handles(kNumStreams);
+    std::vector<int> vad(kNumStreams);
+    srand(17);
+    for (size_t n = 0; n < kNumStreams; ++n) {
+      for (size_t i = 0; i < frame_length; ++i)
+        speech[n][i] = static_cast<int16_t>(rand() % 4000 - 2000);
+      frames[n] = speech[n].data();
+      handles[n] = WebRtcVad_Create();
+      ASSERT_EQ(0, WebRtcVad_Init(handles[n]));
+    }
+
+    int64_t start_time_us = clock->TimeInMicroseconds();
+    for (int i = 0; i < kNumIterations; ++i) {
+      for (size_t n = 0; n < kNumStreams; ++n) {
+        vad[n] = WebRtcVad_Process(handles[n], rate_hz, frames[n],
+                                   frame_length);
+      }
+    }
+    test::PrintResult(
+        "vad_per_stream", "", trace,
+        static_cast<double>(clock->TimeInMicroseconds() - start_time_us) /
+            kNumIterations,
+        "us", false);
+
+    start_time_us = clock->TimeInMicroseconds();
+    for (int i = 0; i < kNumIterations; ++i) {
+      ASSERT_EQ(0, WebRtcVad_ProcessBatch(handles.data(), kNumStreams,
+                                          rate_hz, frames.data(),
+                                          frame_length, vad.data()));
+    }
+    test::PrintResult(
+        "vad_batch", "", trace,
+        static_cast<double>(clock->TimeInMicroseconds() - start_time_us) /
+            kNumIterations,
+        "us", false);
+
+    for (VadInst* handle : handles)
+      WebRtcVad_Free(handle);
+  }
+}
+
+}  // namespace webrtc
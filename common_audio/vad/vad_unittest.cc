@@ -150,6 +150,72 @@ TEST_F(VadTest, ValidRatesFrameLengths) {
   }
 }
 
+TEST_F(VadTest, ProcessBatch) {
+  // More streams than SIMD lanes, so that the last batch is partial.
+  const size_t kNumStreams = 11;
+  VadInst* handles[kNumStreams];
+  VadInst* batch_handles[kNumStreams];
+  int16_t speech[kNumStreams][kMaxFrameLength];
+  const int16_t* frames[kNumStreams];
+  int vad[kNumStreams];
+
+  EXPECT_EQ(-1, WebRtcVad_ProcessBatch(nullptr, kNumStreams, kRates[0],
+                                       frames, kFrameLengths[0], vad));
+
+  for (size_t n = 0; n < kNumStreams; ++n) {
+    handles[n] = WebRtcVad_Create();
+    batch_handles[n] = WebRtcVad_Create();
+    frames[n] = speech[n];
+  }
+  // Not initialized.
+  EXPECT_EQ(-1, WebRtcVad_ProcessBatch(batch_handles, kNumStreams, kRates[0],
+                                       frames, kFrameLengths[0], vad));
+
+  srand(17);
+  for (size_t k = 0; k < kModesSize; k++) {
+    for (size_t i = 0; i < kRatesSize; i++) {
+      for (size_t j = 0; j < kFrameLengthsSize; j++) {
+        for (size_t n = 0; n < kNumStreams; ++n) {
+          ASSERT_EQ(0, WebRtcVad_Init(handles[n]));
+          ASSERT_EQ(0, WebRtcVad_Init(batch_handles[n]));
+          ASSERT_EQ(0, WebRtcVad_set_mode(handles[n], kModes[k]));
+          ASSERT_EQ(0, WebRtcVad_set_mode(batch_handles[n], kModes[k]));
+        }
+        if (!ValidRatesAndFrameLengths(kRates[i], kFrameLengths[j])) {
+          EXPECT_EQ(-1, WebRtcVad_ProcessBatch(batch_handles, kNumStreams,
+                                               kRates[i], frames,
+                                               kFrameLengths[j], vad));
+          continue;
+        }
+        for (int frame = 0; frame < 10; ++frame) {
+          // Alternate speech-like, noise and silent frames between streams.
+          for (size_t n = 0; n < kNumStreams; ++n) {
+            const size_t type = (n + frame / 3) % 3;
+            for (size_t m = 0; m < kFrameLengths[j]; ++m) {
+              speech[n][m] = type == 0 ? static_cast<int16_t>(m * m * (n + 1))
+                  : type == 1 ? static_cast<int16_t>(rand() % 2000 - 1000)
+                  : 0;
+            }
+          }
+          ASSERT_EQ(0, WebRtcVad_ProcessBatch(batch_handles, kNumStreams,
+                                              kRates[i], frames,
+                                              kFrameLengths[j], vad));
+          for (size_t n = 0; n < kNumStreams; ++n) {
+            EXPECT_EQ(WebRtcVad_Process(handles[n], kRates[i], speech[n],
+                                        kFrameLengths[j]),
+                      vad[n]);
+          }
+        }
+      }
+    }
+  }
+
+  for (size_t n = 0; n < kNumStreams; ++n) {
+    WebRtcVad_Free(handles[n]);
+    WebRtcVad_Free(batch_handles[n]);
+  }
+}
+
 // TODO(bjornv): Add a process test, run on file.
 
 }  // namespace
@@ -90,6 +90,38 @@ int WebRtcVad_Process(VadInst* handle, int fs, const int16_t* audio_frame,
   return vad;
 }
 
+int WebRtcVad_ProcessBatch(VadInst* const* handles, size_t num_handles,
+                           int fs, const int16_t* const* audio_frames,
+                           size_t frame_length, int* vad) {
+  VadInstT* const* selves = (VadInstT* const*) handles;
+  size_t i;
+
+  if (handles == NULL || audio_frames == NULL || vad == NULL) {
+    return -1;
+  }
+  for (i = 0; i < num_handles; i++) {
+    if (handles[i] == NULL || audio_frames[i] == NULL) {
+      return -1;
+    }
+    if (selves[i]->init_flag != kInitCheck) {
+      return -1;
+    }
+  }
+  if (WebRtcVad_ValidRateAndFrameLength(fs, frame_length) != 0) {
+    return -1;
+  }
+
+  WebRtcVad_CalcVadBatch(selves, num_handles, fs, audio_frames, frame_length,
+                         vad);
+
+  for (i = 0; i < num_handles; i++) {
+    if (vad[i] > 0) {
+      vad[i] = 1;
+    }
+  }
+  return 0;
+}
+
 int WebRtcVad_ValidRateAndFrameLength(int rate, size_t frame_length) {
   int return_value = -1;
   size_t i;
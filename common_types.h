@@ -298,6 +298,12 @@ class SendPacketObserver {
   virtual void OnSendPacket(uint16_t packet_id,
                             int64_t capture_time_ms,
                             uint32_t ssrc) = 0;
+  // Called when a media packet taken out of the pacer queue is sent to the
+  // transport, |queue_time_ms| after it was put in the queue.
+  virtual void OnPacketDequeued(uint32_t ssrc, int64_t queue_time_ms) {}
+  // Called when the end to end media encryption of the packets of a frame
+  // took |encryption_time_us|.
+  virtual void OnMediaEncrypted(uint32_t ssrc, int64_t encryption_time_us) {}
 };
 
 // Callback, used to notify an observer when the overhead per packet
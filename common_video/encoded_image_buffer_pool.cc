@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_video/include/encoded_image_buffer_pool.h"
+
+#include "webrtc/base/checks.h"
+
+namespace webrtc {
+namespace {
+// Enough for the frames in flight between the packet buffer and the decoder.
+constexpr size_t kDefaultMaxBuffersPerClass = 8;
+}  // namespace
+
+constexpr size_t EncodedImageBufferPool::kMinBufferSize;
+constexpr size_t EncodedImageBufferPool::kMaxPooledBufferSize;
+
+EncodedImageBufferPool::EncodedImageBufferPool()
+    : EncodedImageBufferPool(kDefaultMaxBuffersPerClass) {}
+
+EncodedImageBufferPool::EncodedImageBufferPool(size_t max_buffers_per_class)
+    : max_buffers_per_class_(max_buffers_per_class) {
+  static_assert(kMinBufferSize << (kNumSizeClasses - 1) == kMaxPooledBufferSize,
+                "Size classes must span kMinBufferSize to kMaxPooledBufferSize");
+}
+
+EncodedImageBufferPool::~EncodedImageBufferPool() {}
+
+int EncodedImageBufferPool::SizeClass(size_t size) {
+  size_t class_size = kMinBufferSize;
+  for (int i = 0; i < kNumSizeClasses; ++i) {
+    if (size <= class_size)
+      return i;
+    class_size *= 2;
+  }
+  return -1;
+}
+
+uint8_t* EncodedImageBufferPool::Allocate(size_t* size) {
+  const int size_class = SizeClass(*size);
+  if (size_class >= 0)
+    *size = kMinBufferSize << size_class;
+  {
+    rtc::CritScope lock(&crit_);
+    if (size_class >= 0 && !free_buffers_[size_class].empty()) {
+      std::vector<std::unique_ptr<uint8_t[]>>& buffers =
+          free_buffers_[size_class];
+      ++stats_.reuses;
+      stats_.pooled_bytes -= *size;
+      uint8_t* buffer = buffers.back().release();
+      buffers.pop_back();
+      return buffer;
+    }
+    ++stats_.allocations;
+  }
+  return new uint8_t[*size];
+}
+
+void EncodedImageBufferPool::Return(uint8_t* buffer, size_t size) {
+  if (!buffer)
+    return;
+
+  // Only buffers of exactly a class size can be handed out again.
+  const int size_class = SizeClass(size);
+  if (size_class < 0 || size != kMinBufferSize << size_class) {
+    delete[] buffer;
+    return;
+  }
+
+  rtc::CritScope lock(&crit_);
+  std::vector<std::unique_ptr<uint8_t[]>>& buffers = free_buffers_[size_class];
+  if (buffers.size() >= max_buffers_per_class_) {
+    delete[] buffer;
+    return;
+  }
+  buffers.emplace_back(buffer);
+  stats_.pooled_bytes += size;
+}
+
+EncodedImageBufferPool::Stats EncodedImageBufferPool::GetStats() const {
+  rtc::CritScope lock(&crit_);
+  return stats_;
+}
+
+}  // namespace webrtc
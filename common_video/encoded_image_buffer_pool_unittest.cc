@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/refcount.h"
+#include "webrtc/base/scoped_ref_ptr.h"
+#include "webrtc/common_video/include/encoded_image_buffer_pool.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+class TestEncodedImageBufferPool : public ::testing::Test {
+ protected:
+  TestEncodedImageBufferPool()
+      : pool_(new rtc::RefCountedObject<EncodedImageBufferPool>(2)) {}
+
+  rtc::scoped_refptr<EncodedImageBufferPool> pool_;
+};
+
+TEST_F(TestEncodedImageBufferPool, RoundsUpToSizeClass) {
+  size_t size = 1;
+  uint8_t* buffer = pool_->Allocate(&size);
+  EXPECT_EQ(EncodedImageBufferPool::kMinBufferSize, size);
+  pool_->Return(buffer, size);
+
+  size = EncodedImageBufferPool::kMinBufferSize + 1;
+  buffer = pool_->Allocate(&size);
+  EXPECT_EQ(2 * EncodedImageBufferPool::kMinBufferSize, size);
+  pool_->Return(buffer, size);
+}
+
+TEST_F(TestEncodedImageBufferPool, ReusesBuffersOfTheSameClass) {
+  size_t size = 5000;
+  uint8_t* buffer = pool_->Allocate(&size);
+  pool_->Return(buffer, size);
+  EXPECT_EQ(size, pool_->GetStats().pooled_bytes);
+
+  size_t other_size = 7000;
+  EXPECT_EQ(buffer, pool_->Allocate(&other_size));
+  EXPECT_EQ(size, other_size);
+  pool_->Return(buffer, other_size);
+
+  EncodedImageBufferPool::Stats stats = pool_->GetStats();
+  EXPECT_EQ(1u, stats.allocations);
+  EXPECT_EQ(1u, stats.reuses);
+}
+
+TEST_F(TestEncodedImageBufferPool, DoesNotMixSizeClasses) {
+  size_t small_size = 5000;
+  uint8_t* small_buffer = pool_->Allocate(&small_size);
+  pool_->Return(small_buffer, small_size);
+
+  size_t large_size = 500000;
+  uint8_t* large_buffer = pool_->Allocate(&large_size);
+  EXPECT_NE(small_buffer, large_buffer);
+  EXPECT_GE(large_size, 500000u);
+  pool_->Return(large_buffer, large_size);
+  EXPECT_EQ(2u, pool_->GetStats().allocations);
+}
+
+TEST_F(TestEncodedImageBufferPool, KeepsAtMostMaxBuffersPerClass) {
+  size_t size = 100;
+  uint8_t* buffers[3];
+  for (uint8_t*& buffer : buffers)
+    buffer = pool_->Allocate(&size);
+  for (uint8_t* buffer : buffers)
+    pool_->Return(buffer, size);
+  EXPECT_EQ(2 * size, pool_->GetStats().pooled_bytes);
+}
+
+TEST_F(TestEncodedImageBufferPool, DoesNotPoolOversizedBuffers) {
+  size_t size = EncodedImageBufferPool::kMaxPooledBufferSize + 1;
+  uint8_t* buffer = pool_->Allocate(&size);
+  EXPECT_EQ(EncodedImageBufferPool::kMaxPooledBufferSize + 1, size);
+  pool_->Return(buffer, size);
+  EXPECT_EQ(0u, pool_->GetStats().pooled_bytes);
+}
+
+TEST_F(TestEncodedImageBufferPool, FreesBuffersWhichAreNotAClassSize) {
+  pool_->Return(new uint8_t[1000], 1000);
+  EXPECT_EQ(0u, pool_->GetStats().pooled_bytes);
+}
+
+}  // namespace webrtc
@@ -9,6 +9,8 @@
  */
 #include "webrtc/common_video/h264/h264_bitstream_parser.h"
 
+#include <string.h>
+
 #include <memory>
 #include <vector>
 
@@ -23,6 +25,11 @@ namespace {
 const int kMaxAbsQpDeltaValue = 51;
 const int kMinQpValue = 0;
 const int kMaxQpValue = 51;
+
+bool HasBytes(const rtc::Buffer& buffer, const uint8_t* data, size_t length) {
+  return buffer.size() == length &&
+         (length == 0 || memcmp(buffer.data(), data, length) == 0);
+}
 }
 
 namespace webrtc {
@@ -46,13 +53,12 @@ H264BitstreamParser::Result H264BitstreamParser::ParseNonParameterSetNalu(
     return kInvalidStream;
 
   last_slice_qp_delta_ = rtc::Optional<int32_t>();
-  std::unique_ptr<rtc::Buffer> slice_rbsp(
-      H264::ParseRbsp(source, source_length));
-  if (slice_rbsp->size() < H264::kNaluTypeSize)
+  H264::ParseRbsp(source, source_length, &slice_rbsp_);
+  if (slice_rbsp_.size() < H264::kNaluTypeSize)
     return kInvalidStream;
 
-  rtc::BitBuffer slice_reader(slice_rbsp->data() + H264::kNaluTypeSize,
-                              slice_rbsp->size() - H264::kNaluTypeSize);
+  rtc::BitBuffer slice_reader(slice_rbsp_.data() + H264::kNaluTypeSize,
+                              slice_rbsp_.size() - H264::kNaluTypeSize);
   // Check to see if this is an IDR slice, which has an extra field to parse
   // out.
   bool is_idr = (source[0] & 0x0F) == H264::NaluType::kIdr;
@@ -271,17 +277,23 @@ void H264BitstreamParser::ParseSlice(const uint8_t* slice, size_t length) {
   H264::NaluType nalu_type = H264::ParseNaluType(slice[0]);
   switch (nalu_type) {
     case H264::NaluType::kSps: {
+      if (sps_ && HasBytes(sps_bytes_, slice, length))
+        break;
       sps_ = SpsParser::ParseSps(slice + H264::kNaluTypeSize,
                                  length - H264::kNaluTypeSize);
       if (!sps_)
         LOG(LS_WARNING) << "Unable to parse SPS from H264 bitstream.";
+      sps_bytes_.SetData(slice, length);
       break;
     }
     case H264::NaluType::kPps: {
+      if (pps_ && HasBytes(pps_bytes_, slice, length))
+        break;
       pps_ = PpsParser::ParsePps(slice + H264::kNaluTypeSize,
                                  length - H264::kNaluTypeSize);
       if (!pps_)
         LOG(LS_WARNING) << "Unable to parse PPS from H264 bitstream.";
+      pps_bytes_.SetData(slice, length);
       break;
     }
     default:
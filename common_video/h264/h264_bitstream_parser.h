@@ -13,6 +13,7 @@
 #include <stddef.h>
 #include <stdint.h>
 
+#include "webrtc/base/buffer.h"
 #include "webrtc/base/optional.h"
 #include "webrtc/common_video/h264/pps_parser.h"
 #include "webrtc/common_video/h264/sps_parser.h"
@@ -55,6 +56,13 @@ class H264BitstreamParser {
   // SPS/PPS state, updated when parsing new SPS/PPS, used to parse slices.
   rtc::Optional<SpsParser::SpsState> sps_;
   rtc::Optional<PpsParser::PpsState> pps_;
+  // The bytes |sps_| and |pps_| were parsed from. Encoders repeat the same
+  // SPS and PPS with every key frame, they are only parsed when they change.
+  rtc::Buffer sps_bytes_;
+  rtc::Buffer pps_bytes_;
+
+  // RBSP of the last slice, kept to reuse its allocation.
+  rtc::Buffer slice_rbsp_;
 
   // Last parsed slice QP.
   rtc::Optional<int32_t> last_slice_qp_delta_;
@@ -62,24 +62,31 @@ NaluType ParseNaluType(uint8_t data) {
 
 std::unique_ptr<rtc::Buffer> ParseRbsp(const uint8_t* data, size_t length) {
   std::unique_ptr<rtc::Buffer> rbsp_buffer(new rtc::Buffer(0, length));
-  const char* sps_bytes = reinterpret_cast<const char*>(data);
-  for (size_t i = 0; i < length;) {
-    // Be careful about over/underflow here. byte_length_ - 3 can underflow, and
-    // i + 3 can overflow, but byte_length_ - i can't, because i < byte_length_
-    // above, and that expression will produce the number of bytes left in
-    // the stream including the byte at i.
-    if (length - i >= 3 && data[i] == 0 && data[i + 1] == 0 &&
-        data[i + 2] == 3) {
+  ParseRbsp(data, length, rbsp_buffer.get());
+  return rbsp_buffer;
+}
+
+void ParseRbsp(const uint8_t* data, size_t length, rtc::Buffer* rbsp) {
+  rbsp->Clear();
+  rbsp->EnsureCapacity(length);
+  // The bytes between emulation bytes are copied in bulk. As in
+  // FindNaluIndices, if the 3rd byte looked at is above 3, no escape sequence
+  // can start at any of the 3 bytes.
+  size_t run_start = 0;
+  size_t i = 0;
+  while (length - i >= 3) {
+    if (data[i + 2] > 3) {
+      i += 3;
+    } else if (data[i + 2] == 3 && data[i + 1] == 0 && data[i] == 0) {
       // Two rbsp bytes + the emulation byte.
-      rbsp_buffer->AppendData(sps_bytes + i, 2);
+      rbsp->AppendData(data + run_start, i + 2 - run_start);
       i += 3;
+      run_start = i;
     } else {
-      // Single rbsp byte.
-      rbsp_buffer->AppendData(sps_bytes[i]);
       ++i;
     }
   }
-  return rbsp_buffer;
+  rbsp->AppendData(data + run_start, length - run_start);
 }
 
 void WriteRbsp(const uint8_t* bytes, size_t length, rtc::Buffer* destination) {
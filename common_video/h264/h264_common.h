@@ -79,6 +79,10 @@ NaluType ParseNaluType(uint8_t data);
 // Parse the given data and remove any emulation byte escaping.
 std::unique_ptr<rtc::Buffer> ParseRbsp(const uint8_t* data, size_t length);
 
+// Same as above, but replaces the contents of |rbsp|, so that a buffer can be
+// reused for every NAL unit of a stream.
+void ParseRbsp(const uint8_t* data, size_t length, rtc::Buffer* rbsp);
+
 // Write the given data to the destination buffer, inserting and emulation
 // bytes in order to escape any data the could be interpreted as a start
 // sequence.
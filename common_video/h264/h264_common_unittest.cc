@@ -0,0 +1,54 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_video/h264/h264_common.h"
+
+#include <vector>
+
+#include "webrtc/test/gmock.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
+
+TEST(H264CommonTest, ParseRbspRemovesEmulationBytes) {
+  const uint8_t kData[] = {0x00, 0x00, 0x03, 0x01, 0x42, 0x00, 0x00,
+                           0x03, 0x00, 0x00, 0x03, 0x03, 0x00, 0x00};
+  std::unique_ptr<rtc::Buffer> rbsp = H264::ParseRbsp(kData, sizeof(kData));
+  EXPECT_THAT(std::vector<uint8_t>(rbsp->data(), rbsp->data() + rbsp->size()),
+              ElementsAre(0x00, 0x00, 0x01, 0x42, 0x00, 0x00, 0x00, 0x00,
+                          0x03, 0x00, 0x00));
+}
+
+TEST(H264CommonTest, ParseRbspKeepsUnescapedData) {
+  const uint8_t kData[] = {0x00, 0x03, 0x00, 0x00, 0x02, 0xFF, 0x00, 0x03};
+  std::unique_ptr<rtc::Buffer> rbsp = H264::ParseRbsp(kData, sizeof(kData));
+  EXPECT_THAT(std::vector<uint8_t>(rbsp->data(), rbsp->data() + rbsp->size()),
+              ElementsAreArray(kData));
+}
+
+TEST(H264CommonTest, ParseRbspUndoesWriteRbsp) {
+  std::vector<uint8_t> data;
+  for (int i = 0; i < 1000; ++i)
+    data.push_back(i % 7 < 4 ? 0 : static_cast<uint8_t>(i % 5));
+  rtc::Buffer escaped;
+  H264::WriteRbsp(data.data(), data.size(), &escaped);
+  EXPECT_GT(escaped.size(), data.size());
+
+  // The buffer is reused, its previous contents are replaced.
+  rtc::Buffer rbsp(16);
+  H264::ParseRbsp(escaped.data(), escaped.size(), &rbsp);
+  EXPECT_THAT(std::vector<uint8_t>(rbsp.data(), rbsp.data() + rbsp.size()),
+              ElementsAreArray(data));
+}
+
+}  // namespace webrtc
@@ -10,6 +10,7 @@
 
 #include "webrtc/common_video/h264/pps_parser.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "webrtc/common_video/h264/h264_common.h"
@@ -25,6 +26,10 @@
 namespace {
 const int kMaxPicInitQpDeltaValue = 25;
 const int kMinPicInitQpDeltaValue = -26;
+// The slice header fields up to pic_parameter_set_id are 3 ue(v) values of
+// at most 32 bits, 24 bytes of RBSP. There are at least 2 RBSP bytes per 3
+// bytes of escaped data, so this many bytes of the slice are enough.
+const size_t kMaxSlicePpsIdPrefixSize = 36;
 }
 
 namespace webrtc {
@@ -59,7 +64,9 @@ bool PpsParser::ParsePpsIds(const uint8_t* data,
 
 rtc::Optional<uint32_t> PpsParser::ParsePpsIdFromSlice(const uint8_t* data,
                                                        size_t length) {
-  std::unique_ptr<rtc::Buffer> slice_rbsp(H264::ParseRbsp(data, length));
+  // Only RBSP-decode the start of the slice, not the whole slice data.
+  std::unique_ptr<rtc::Buffer> slice_rbsp(
+      H264::ParseRbsp(data, std::min(length, kMaxSlicePpsIdPrefixSize)));
   rtc::BitBuffer slice_reader(slice_rbsp->data(), slice_rbsp->size());
 
   uint32_t golomb_tmp;
@@ -11,6 +11,8 @@
 
 #include "webrtc/common_video/h264/sps_vui_rewriter.h"
 
+#include <string.h>
+
 #include <algorithm>
 #include <memory>
 
@@ -146,6 +148,40 @@ SpsVuiRewriter::ParseResult SpsVuiRewriter::ParseAndRewriteSps(
   return ParseResult::kVuiRewritten;
 }
 
+SpsVuiRewriteCache::SpsVuiRewriteCache()
+    : result_(SpsVuiRewriter::ParseResult::kFailure) {}
+
+SpsVuiRewriteCache::~SpsVuiRewriteCache() {}
+
+SpsVuiRewriter::ParseResult SpsVuiRewriteCache::ParseAndRewriteSpsNalu(
+    const uint8_t* nalu,
+    size_t length,
+    rtc::Optional<SpsParser::SpsState>* sps) {
+  if (length < H264::kNaluTypeSize) {
+    *sps = rtc::Optional<SpsParser::SpsState>();
+    return SpsVuiRewriter::ParseResult::kFailure;
+  }
+  if (length != nalu_.size() || memcmp(nalu_.data(), nalu, length) != 0) {
+    nalu_.SetData(nalu, length);
+    // Add the type header first, so that the rewriter can append the
+    // modified payload on top of that.
+    rtc::Buffer rewritten_nalu;
+    rewritten_nalu.AppendData(nalu[0]);
+    sps_ = rtc::Optional<SpsParser::SpsState>();
+    result_ = SpsVuiRewriter::ParseAndRewriteSps(
+        nalu + H264::kNaluTypeSize, length - H264::kNaluTypeSize, &sps_,
+        &rewritten_nalu);
+    // Assigning doesn't modify the buffer shared with previous callers.
+    rewritten_nalu_ =
+        result_ == SpsVuiRewriter::ParseResult::kVuiRewritten
+            ? rtc::CopyOnWriteBuffer(rewritten_nalu.data(),
+                                     rewritten_nalu.size())
+            : rtc::CopyOnWriteBuffer();
+  }
+  *sps = sps_;
+  return result_;
+}
+
 bool CopyAndRewriteVui(Sps sps,
                        rtc::BitBuffer* source,
                        rtc::BitBufferWriter* destination,
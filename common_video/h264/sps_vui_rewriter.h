@@ -13,6 +13,7 @@
 #define WEBRTC_COMMON_VIDEO_H264_SPS_VUI_REWRITER_H_
 
 #include "webrtc/base/buffer.h"
+#include "webrtc/base/copyonwritebuffer.h"
 #include "webrtc/base/optional.h"
 #include "webrtc/common_video/h264/sps_parser.h"
 
@@ -49,6 +50,37 @@ class SpsVuiRewriter : private SpsParser {
                                         rtc::Buffer* destination);
 };
 
+// Keeps the result of rewriting the last SPS of a stream. Encoders repeat the
+// same SPS with every key frame, so it is only parsed and rewritten again
+// when its bytes change.
+class SpsVuiRewriteCache {
+ public:
+  SpsVuiRewriteCache();
+  ~SpsVuiRewriteCache();
+
+  // Same as SpsVuiRewriter::ParseAndRewriteSps, but for a whole SPS NAL unit
+  // including its type header. If the result is kVuiRewritten, the rewritten
+  // NAL unit is returned by rewritten_nalu() instead of being appended to a
+  // buffer. Returns the previous results without parsing if |nalu| holds the
+  // same bytes as in the previous call.
+  SpsVuiRewriter::ParseResult ParseAndRewriteSpsNalu(
+      const uint8_t* nalu,
+      size_t length,
+      rtc::Optional<SpsParser::SpsState>* sps);
+
+  // The buffer is shared, not copied, and a copy stays valid after the next
+  // call of ParseAndRewriteSpsNalu.
+  const rtc::CopyOnWriteBuffer& rewritten_nalu() const {
+    return rewritten_nalu_;
+  }
+
+ private:
+  rtc::Buffer nalu_;
+  SpsVuiRewriter::ParseResult result_;
+  rtc::Optional<SpsParser::SpsState> sps_;
+  rtc::CopyOnWriteBuffer rewritten_nalu_;
+};
+
 }  // namespace webrtc
 
 #endif  // WEBRTC_COMMON_VIDEO_H264_SPS_VUI_REWRITER_H_
@@ -188,4 +188,51 @@ REWRITE_TEST(RewriteSuboptimalVui,
              kRewriteRequired_VuiSuboptimal,
              SpsVuiRewriter::ParseResult::kVuiRewritten);
 
+TEST(SpsVuiRewriteCacheTest, RewritesRepeatedSpsOnce) {
+  rtc::Buffer buffer;
+  GenerateFakeSps(kRewriteRequired_NoVui, &buffer);
+  // Skip the start sequence, the cache takes the NAL unit with its header.
+  const uint8_t* nalu = buffer.data() + H264::kNaluLongStartSequenceSize;
+  const size_t nalu_size = buffer.size() - H264::kNaluLongStartSequenceSize;
+
+  rtc::Buffer expected_sps;
+  expected_sps.AppendData(nalu[0]);
+  rtc::Optional<SpsParser::SpsState> expected_state;
+  ASSERT_EQ(SpsVuiRewriter::ParseResult::kVuiRewritten,
+            SpsVuiRewriter::ParseAndRewriteSps(
+                nalu + H264::kNaluTypeSize, nalu_size - H264::kNaluTypeSize,
+                &expected_state, &expected_sps));
+
+  SpsVuiRewriteCache cache;
+  rtc::Optional<SpsParser::SpsState> sps;
+  ASSERT_EQ(SpsVuiRewriter::ParseResult::kVuiRewritten,
+            cache.ParseAndRewriteSpsNalu(nalu, nalu_size, &sps));
+  ASSERT_TRUE(sps);
+  EXPECT_EQ(kWidth, sps->width);
+  EXPECT_EQ(kHeight, sps->height);
+  rtc::CopyOnWriteBuffer rewritten_sps = cache.rewritten_nalu();
+  EXPECT_EQ(rtc::CopyOnWriteBuffer(expected_sps.data(), expected_sps.size()),
+            rewritten_sps);
+
+  // The same SPS in another buffer gives the same, shared, rewritten SPS.
+  rtc::Buffer repeated_sps(nalu, nalu_size);
+  sps = rtc::Optional<SpsParser::SpsState>();
+  EXPECT_EQ(SpsVuiRewriter::ParseResult::kVuiRewritten,
+            cache.ParseAndRewriteSpsNalu(repeated_sps.data(),
+                                         repeated_sps.size(), &sps));
+  EXPECT_TRUE(sps);
+  EXPECT_EQ(rewritten_sps.cdata(), cache.rewritten_nalu().cdata());
+
+  // A different SPS is parsed again, without changing the previous one.
+  rtc::Buffer other_buffer;
+  GenerateFakeSps(kNoRewriteRequired_PocCorrect, &other_buffer);
+  EXPECT_EQ(SpsVuiRewriter::ParseResult::kPocOk,
+            cache.ParseAndRewriteSpsNalu(
+                other_buffer.data() + H264::kNaluLongStartSequenceSize,
+                other_buffer.size() - H264::kNaluLongStartSequenceSize, &sps));
+  EXPECT_EQ(0u, cache.rewritten_nalu().size());
+  EXPECT_EQ(rtc::CopyOnWriteBuffer(expected_sps.data(), expected_sps.size()),
+            rewritten_sps);
+}
+
 }  // namespace webrtc
@@ -10,14 +10,31 @@
 
 #include "webrtc/common_video/include/i420_buffer_pool.h"
 
+#include <iterator>
+
 #include "webrtc/base/checks.h"
 
 namespace webrtc {
 
+namespace {
+
+size_t BufferSize(const I420Buffer& buffer) {
+  const int chroma_height = (buffer.height() + 1) / 2;
+  return static_cast<size_t>(buffer.StrideY()) * buffer.height() +
+         static_cast<size_t>(buffer.StrideU() + buffer.StrideV()) *
+             chroma_height;
+}
+
+}  // namespace
+
+const size_t I420BufferPool::kDefaultMaxIdleBytes;
+
 I420BufferPool::I420BufferPool(bool zero_initialize,
-                               size_t max_number_of_buffers)
+                               size_t max_number_of_buffers,
+                               size_t max_idle_bytes)
     : zero_initialize_(zero_initialize),
-      max_number_of_buffers_(max_number_of_buffers) {}
+      max_number_of_buffers_(max_number_of_buffers),
+      max_idle_bytes_(max_idle_bytes) {}
 
 void I420BufferPool::Release() {
   buffers_.clear();
@@ -26,32 +43,63 @@ void I420BufferPool::Release() {
 rtc::scoped_refptr<I420Buffer> I420BufferPool::CreateBuffer(int width,
                                                             int height) {
   RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
-  // Release buffers with wrong resolution.
-  for (auto it = buffers_.begin(); it != buffers_.end();) {
-    if ((*it)->width() != width || (*it)->height() != height)
-      it = buffers_.erase(it);
-    else
-      ++it;
-  }
+  EvictIdleBuffers(width, height);
   // Look for a free buffer.
-  for (const rtc::scoped_refptr<PooledI420Buffer>& buffer : buffers_) {
+  for (auto it = buffers_.begin(); it != buffers_.end(); ++it) {
     // If the buffer is in use, the ref count will be >= 2, one from the list we
     // are looping over and one from the application. If the ref count is 1,
     // then the list we are looping over holds the only reference and it's safe
     // to reuse.
-    if (buffer->HasOneRef())
-      return buffer;
+    if ((*it)->width() == width && (*it)->height() == height &&
+        (*it)->HasOneRef()) {
+      buffers_.splice(buffers_.begin(), buffers_, it);
+      ++stats_.hits;
+      return buffers_.front();
+    }
   }
+  ++stats_.misses;
 
-  if (buffers_.size() >= max_number_of_buffers_)
-    return nullptr;
+  if (buffers_.size() >= max_number_of_buffers_) {
+    // Make room by freeing the least recently used free buffer, which has
+    // another resolution.
+    auto it = buffers_.end();
+    while (it != buffers_.begin() && !(*std::prev(it))->HasOneRef())
+      --it;
+    if (it == buffers_.begin())
+      return nullptr;
+    buffers_.erase(std::prev(it));
+  }
   // Allocate new buffer.
   rtc::scoped_refptr<PooledI420Buffer> buffer =
       new PooledI420Buffer(width, height);
   if (zero_initialize_)
     buffer->InitializeData();
-  buffers_.push_back(buffer);
+  buffers_.push_front(buffer);
   return buffer;
 }
 
+I420BufferPool::Stats I420BufferPool::GetStats() const {
+  Stats stats = stats_;
+  for (const rtc::scoped_refptr<PooledI420Buffer>& buffer : buffers_)
+    stats.pooled_bytes += BufferSize(*buffer);
+  return stats;
+}
+
+void I420BufferPool::EvictIdleBuffers(int width, int height) {
+  size_t idle_bytes = 0;
+  for (auto it = buffers_.begin(); it != buffers_.end();) {
+    if (((*it)->width() == width && (*it)->height() == height) ||
+        !(*it)->HasOneRef()) {
+      ++it;
+      continue;
+    }
+    idle_bytes += BufferSize(**it);
+    if (idle_bytes > max_idle_bytes_) {
+      it = buffers_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 }  // namespace webrtc
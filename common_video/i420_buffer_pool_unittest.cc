@@ -70,4 +70,41 @@ TEST(TestI420BufferPool, MaxNumberOfBuffers) {
   EXPECT_EQ(nullptr, pool.CreateBuffer(16, 16).get());
 }
 
+TEST(TestI420BufferPool, MaxNumberOfBuffersFreesOtherResolutions) {
+  I420BufferPool pool(false, 1);
+  EXPECT_NE(nullptr, pool.CreateBuffer(16, 16).get());
+  EXPECT_NE(nullptr, pool.CreateBuffer(32, 32).get());
+}
+
+TEST(TestI420BufferPool, ReusesBuffersOfPreviousResolution) {
+  I420BufferPool pool;
+  rtc::scoped_refptr<VideoFrameBuffer> buffer = pool.CreateBuffer(16, 16);
+  const uint8_t* y_ptr = buffer->DataY();
+  buffer = pool.CreateBuffer(32, 32);
+  buffer = pool.CreateBuffer(16, 16);
+  EXPECT_EQ(y_ptr, buffer->DataY());
+
+  I420BufferPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(1u, stats.hits);
+  EXPECT_EQ(2u, stats.misses);
+  // 16x16 and 32x32 buffers with 8x8 and 16x16 chroma planes.
+  EXPECT_EQ(16u * 16 * 3 / 2 + 32u * 32 * 3 / 2, stats.pooled_bytes);
+}
+
+TEST(TestI420BufferPool, EvictsLeastRecentlyUsedBuffers) {
+  const size_t k32x32Bytes = 32 * 32 * 3 / 2;
+  I420BufferPool pool(false, std::numeric_limits<size_t>::max(),
+                      k32x32Bytes);
+  pool.CreateBuffer(16, 16);
+  rtc::scoped_refptr<VideoFrameBuffer> buffer = pool.CreateBuffer(32, 32);
+  const uint8_t* y_ptr = buffer->DataY();
+  buffer = nullptr;
+  // Only the most recently used 32x32 buffer fits in the limit.
+  pool.CreateBuffer(64, 64);
+  EXPECT_EQ(y_ptr, pool.CreateBuffer(32, 32)->DataY());
+  EXPECT_EQ(1u, pool.GetStats().hits);
+  pool.CreateBuffer(16, 16);
+  EXPECT_EQ(1u, pool.GetStats().hits);
+}
+
 }  // namespace webrtc
@@ -0,0 +1,75 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_video/include/i420_scale_pyramid.h"
+
+#include "libyuv/scale.h"
+#include "webrtc/base/checks.h"
+
+namespace webrtc {
+
+I420ScalePyramid::I420ScalePyramid() {}
+
+I420ScalePyramid::~I420ScalePyramid() {}
+
+void I420ScalePyramid::Update(
+    const rtc::scoped_refptr<VideoFrameBuffer>& source,
+    const std::vector<Resolution>& resolutions) {
+  RTC_DCHECK(source);
+  while (pools_.size() < resolutions.size())
+    pools_.emplace_back(new I420BufferPool());
+  layers_.assign(resolutions.size(), nullptr);
+
+  // Walk down from the highest resolution, scaling each needed layer from the
+  // smallest buffer so far that is at least as large in both dimensions.
+  rtc::scoped_refptr<VideoFrameBuffer> parent = source;
+  for (size_t i = resolutions.size(); i-- > 0;) {
+    const Resolution& resolution = resolutions[i];
+    if (resolution.width <= 0 || resolution.height <= 0)
+      continue;
+    if (resolution.width == source->width() &&
+        resolution.height == source->height()) {
+      layers_[i] = source;
+      continue;
+    }
+    const VideoFrameBuffer& src =
+        (parent->width() >= resolution.width &&
+         parent->height() >= resolution.height)
+            ? *parent
+            : *source;
+    rtc::scoped_refptr<I420Buffer> buffer =
+        pools_[i]->CreateBuffer(resolution.width, resolution.height);
+    // Bilinear rather than the box filter of I420Buffer::ScaleFrom, which is
+    // what the layers were scaled with before they were shared.
+    libyuv::I420Scale(src.DataY(), src.StrideY(), src.DataU(), src.StrideU(),
+                      src.DataV(), src.StrideV(), src.width(), src.height(),
+                      buffer->MutableDataY(), buffer->StrideY(),
+                      buffer->MutableDataU(), buffer->StrideU(),
+                      buffer->MutableDataV(), buffer->StrideV(),
+                      resolution.width, resolution.height,
+                      libyuv::kFilterBilinear);
+    layers_[i] = buffer;
+    parent = buffer;
+  }
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> I420ScalePyramid::layer(
+    size_t layer_idx) const {
+  if (layer_idx >= layers_.size())
+    return nullptr;
+  return layers_[layer_idx];
+}
+
+void I420ScalePyramid::Release() {
+  layers_.clear();
+  pools_.clear();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,116 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <vector>
+
+#include "libyuv/scale.h"
+#include "webrtc/api/video/i420_buffer.h"
+#include "webrtc/common_video/include/i420_scale_pyramid.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+std::vector<I420ScalePyramid::Resolution> ThreeLayers() {
+  return {I420ScalePyramid::Resolution(160, 90),
+          I420ScalePyramid::Resolution(320, 180),
+          I420ScalePyramid::Resolution(640, 360)};
+}
+
+}  // namespace
+
+TEST(TestI420ScalePyramid, ScalesToAllLayers) {
+  I420ScalePyramid pyramid;
+  rtc::scoped_refptr<I420Buffer> source = I420Buffer::Create(640, 360);
+  I420Buffer::SetBlack(source.get());
+  pyramid.Update(source, ThreeLayers());
+
+  // The full resolution layer is the source itself.
+  EXPECT_EQ(source.get(), pyramid.layer(2).get());
+  ASSERT_TRUE(pyramid.layer(1));
+  EXPECT_EQ(320, pyramid.layer(1)->width());
+  EXPECT_EQ(180, pyramid.layer(1)->height());
+  ASSERT_TRUE(pyramid.layer(0));
+  EXPECT_EQ(160, pyramid.layer(0)->width());
+  EXPECT_EQ(90, pyramid.layer(0)->height());
+  EXPECT_FALSE(pyramid.layer(3));
+}
+
+TEST(TestI420ScalePyramid, SkipsLayersThatAreNotNeeded) {
+  I420ScalePyramid pyramid;
+  rtc::scoped_refptr<I420Buffer> source = I420Buffer::Create(640, 360);
+  I420Buffer::SetBlack(source.get());
+  std::vector<I420ScalePyramid::Resolution> resolutions = ThreeLayers();
+  resolutions[1] = I420ScalePyramid::Resolution(0, 0);
+  pyramid.Update(source, resolutions);
+
+  EXPECT_FALSE(pyramid.layer(1));
+  ASSERT_TRUE(pyramid.layer(0));
+  EXPECT_EQ(160, pyramid.layer(0)->width());
+}
+
+TEST(TestI420ScalePyramid, ReusesBuffersOfPreviousFrames) {
+  I420ScalePyramid pyramid;
+  rtc::scoped_refptr<I420Buffer> source = I420Buffer::Create(640, 360);
+  I420Buffer::SetBlack(source.get());
+  pyramid.Update(source, ThreeLayers());
+  const uint8_t* y_ptr = pyramid.layer(0)->DataY();
+
+  // Once the previous layers are no longer referenced, the next frame is
+  // scaled into the same memory.
+  pyramid.Update(source, ThreeLayers());
+  EXPECT_EQ(y_ptr, pyramid.layer(0)->DataY());
+}
+
+TEST(TestI420ScalePyramid, KeepsBuffersStillInUse) {
+  I420ScalePyramid pyramid;
+  rtc::scoped_refptr<I420Buffer> source = I420Buffer::Create(640, 360);
+  I420Buffer::SetBlack(source.get());
+  pyramid.Update(source, ThreeLayers());
+  rtc::scoped_refptr<VideoFrameBuffer> in_use = pyramid.layer(0);
+
+  pyramid.Update(source, ThreeLayers());
+  EXPECT_NE(in_use->DataY(), pyramid.layer(0)->DataY());
+}
+
+TEST(TestI420ScalePyramid, ScalesWithBilinearFilter) {
+  I420ScalePyramid pyramid;
+  rtc::scoped_refptr<I420Buffer> source = I420Buffer::Create(640, 360);
+  I420Buffer::SetBlack(source.get());
+  // A pattern that the box and the bilinear filters scale differently.
+  for (int y = 0; y < source->height(); ++y) {
+    for (int x = 0; x < source->width(); ++x)
+      source->MutableDataY()[y * source->StrideY() + x] =
+          static_cast<uint8_t>(x * 7 + y * 13);
+  }
+  pyramid.Update(source, {I420ScalePyramid::Resolution(240, 135)});
+
+  rtc::scoped_refptr<I420Buffer> expected = I420Buffer::Create(240, 135);
+  libyuv::I420Scale(source->DataY(), source->StrideY(), source->DataU(),
+                    source->StrideU(), source->DataV(), source->StrideV(),
+                    source->width(), source->height(),
+                    expected->MutableDataY(), expected->StrideY(),
+                    expected->MutableDataU(), expected->StrideU(),
+                    expected->MutableDataV(), expected->StrideV(),
+                    expected->width(), expected->height(),
+                    libyuv::kFilterBilinear);
+  rtc::scoped_refptr<VideoFrameBuffer> layer = pyramid.layer(0);
+  ASSERT_TRUE(layer);
+  for (int y = 0; y < expected->height(); ++y) {
+    ASSERT_EQ(0, memcmp(expected->DataY() + y * expected->StrideY(),
+                        layer->DataY() + y * layer->StrideY(),
+                        expected->width()));
+  }
+}
+
+}  // namespace webrtc
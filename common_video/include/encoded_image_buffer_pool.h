@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+#define WEBRTC_COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/refcount.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+// Pool of buffers for encoded bitstreams, the EncodedImage counterpart of
+// I420BufferPool. Buffers are handed out in power of two size classes, from
+// kMinBufferSize to kMaxPooledBufferSize, so frames of varying sizes can
+// reuse each other's buffers. Larger buffers are allocated and freed as
+// requested. Thread safe, buffers may be returned from another thread than
+// the one which allocated them.
+class EncodedImageBufferPool : public rtc::RefCountInterface {
+ public:
+  static constexpr size_t kMinBufferSize = 4 * 1024;
+  static constexpr size_t kMaxPooledBufferSize = 4 * 1024 * 1024;
+
+  struct Stats {
+    // Buffers allocated from the heap.
+    uint32_t allocations = 0;
+    // Buffers handed out from the pool.
+    uint32_t reuses = 0;
+    // Bytes held by the free buffers.
+    size_t pooled_bytes = 0;
+  };
+
+  EncodedImageBufferPool();
+  // Keeps at most |max_buffers_per_class| free buffers of each size class.
+  explicit EncodedImageBufferPool(size_t max_buffers_per_class);
+
+  // Returns a buffer of at least |*size| bytes and sets |*size| to its
+  // capacity, which is what must be passed to Return.
+  uint8_t* Allocate(size_t* size);
+  // Takes ownership of |buffer|, from Allocate or of |size| bytes allocated
+  // with new[], and keeps it for reuse or frees it.
+  void Return(uint8_t* buffer, size_t size);
+
+  Stats GetStats() const;
+
+ protected:
+  ~EncodedImageBufferPool() override;
+
+ private:
+  static const int kNumSizeClasses = 11;
+
+  // Index of the smallest size class holding |size| bytes, or -1 if |size|
+  // is larger than kMaxPooledBufferSize.
+  static int SizeClass(size_t size);
+
+  const size_t max_buffers_per_class_;
+  rtc::CriticalSection crit_;
+  std::vector<std::unique_ptr<uint8_t[]>> free_buffers_[kNumSizeClasses]
+      GUARDED_BY(crit_);
+  Stats stats_ GUARDED_BY(crit_);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_COMMON_VIDEO_INCLUDE_ENCODED_IMAGE_BUFFER_POOL_H_
@@ -22,22 +22,42 @@ namespace webrtc {
 // Simple buffer pool to avoid unnecessary allocations of I420Buffer objects.
 // The pool manages the memory of the I420Buffer returned from CreateBuffer.
 // When the I420Buffer is destructed, the memory is returned to the pool for use
-// by subsequent calls to CreateBuffer. If the resolution passed to CreateBuffer
-// changes, old buffers will be purged from the pool.
+// by subsequent calls to CreateBuffer. Free buffers of other resolutions than
+// the one last passed to CreateBuffer are kept up to |max_idle_bytes|, least
+// recently used first, so switching back and forth between resolutions, e.g.
+// when the sender adapts, doesn't reallocate every time.
 // Note that CreateBuffer will crash if more than kMaxNumberOfFramesBeforeCrash
 // are created. This is to prevent memory leaks where frames are not returned.
 class I420BufferPool {
  public:
+  static const size_t kDefaultMaxIdleBytes = 8 * 1024 * 1024;
+
+  struct Stats {
+    // Number of CreateBuffer calls that reused a pooled buffer.
+    uint64_t hits = 0;
+    // Number of CreateBuffer calls that had to allocate a buffer, or failed.
+    uint64_t misses = 0;
+    // Size of all buffers held by the pool, free or not.
+    size_t pooled_bytes = 0;
+  };
+
   I420BufferPool()
       : I420BufferPool(false) {}
   explicit I420BufferPool(bool zero_initialize)
       : I420BufferPool(zero_initialize, std::numeric_limits<size_t>::max()) {}
-  I420BufferPool(bool zero_initialze, size_t max_number_of_buffers);
+  I420BufferPool(bool zero_initialze, size_t max_number_of_buffers)
+      : I420BufferPool(zero_initialze,
+                       max_number_of_buffers,
+                       kDefaultMaxIdleBytes) {}
+  I420BufferPool(bool zero_initialze,
+                 size_t max_number_of_buffers,
+                 size_t max_idle_bytes);
 
   // Returns a buffer from the pool. If no suitable buffer exist in the pool
   // and there are less than |max_number_of_buffers| pending, a buffer is
   // created. Returns null otherwise.
   rtc::scoped_refptr<I420Buffer> CreateBuffer(int width, int height);
+  Stats GetStats() const;
   // Clears buffers_ and detaches the thread checker so that it can be reused
   // later from another thread.
   void Release();
@@ -47,7 +67,12 @@ class I420BufferPool {
   // needed by the pool to check exclusive access.
   using PooledI420Buffer = rtc::RefCountedObject<I420Buffer>;
 
+  // Frees buffers of other resolutions than |width|x|height| that aren't in
+  // use and don't fit in |max_idle_bytes_|.
+  void EvictIdleBuffers(int width, int height);
+
   rtc::RaceChecker race_checker_;
+  // Most recently used first.
   std::list<rtc::scoped_refptr<PooledI420Buffer>> buffers_;
   // If true, newly allocated buffers are zero-initialized. Note that recycled
   // buffers are not zero'd before reuse. This is required of buffers used by
@@ -57,6 +82,8 @@ class I420BufferPool {
   const bool zero_initialize_;
   // Max number of buffers this pool can have pending.
   const size_t max_number_of_buffers_;
+  const size_t max_idle_bytes_;
+  Stats stats_;
 };
 
 }  // namespace webrtc
@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_COMMON_VIDEO_INCLUDE_I420_SCALE_PYRAMID_H_
+#define WEBRTC_COMMON_VIDEO_INCLUDE_I420_SCALE_PYRAMID_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/api/video/video_frame_buffer.h"
+#include "webrtc/common_video/include/i420_buffer_pool.h"
+
+namespace webrtc {
+
+// Downscales a frame to a set of resolutions, such as those of the simulcast
+// layers of a stream. Each layer is scaled from the next larger one rather
+// than from the full resolution source, which is considerably cheaper for the
+// lowest layers, and the scaled buffers come from an I420BufferPool per layer
+// so that no frames are allocated in the steady state. The layers of the last
+// scaled frame can be read by any number of consumers.
+// Not thread safe, Update and layer must be called on the same thread.
+class I420ScalePyramid {
+ public:
+  struct Resolution {
+    Resolution(int width, int height) : width(width), height(height) {}
+    int width;
+    int height;
+  };
+
+  I420ScalePyramid();
+  ~I420ScalePyramid();
+
+  // Scales |source| to |resolutions|, which must be ordered from the lowest
+  // to the highest. Layers with a zero width or height are not needed and are
+  // left unset. Layers with the resolution of the source reference it
+  // directly, without copying.
+  void Update(const rtc::scoped_refptr<VideoFrameBuffer>& source,
+              const std::vector<Resolution>& resolutions);
+
+  // Returns the scaled buffer of layer |layer_idx| of the last Update, or null
+  // if the layer wasn't needed.
+  rtc::scoped_refptr<VideoFrameBuffer> layer(size_t layer_idx) const;
+
+  // Drops the scaled buffers and the pools.
+  void Release();
+
+ private:
+  std::vector<std::unique_ptr<I420BufferPool>> pools_;
+  std::vector<rtc::scoped_refptr<VideoFrameBuffer>> layers_;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_COMMON_VIDEO_INCLUDE_I420_SCALE_PYRAMID_H_
@@ -18,16 +18,23 @@
 #include "webrtc/base/race_checker.h"
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/base/thread_checker.h"
+#include "webrtc/common_video/include/video_render_scheduler.h"
 #include "webrtc/common_video/video_render_frames.h"
 #include "webrtc/media/base/videosinkinterface.h"
 
 namespace webrtc {
 class EventTimerWrapper;
 
-class IncomingVideoStream : public rtc::VideoSinkInterface<VideoFrame> {
+class IncomingVideoStream : public rtc::VideoSinkInterface<VideoFrame>,
+                            public VideoRenderScheduler::Stream {
  public:
   IncomingVideoStream(int32_t delay_ms,
                       rtc::VideoSinkInterface<VideoFrame>* callback);
+  // If |render_scheduler| is not null, frames are released to |callback| by
+  // the scheduler's thread instead of a thread of this stream.
+  IncomingVideoStream(int32_t delay_ms,
+                      rtc::VideoSinkInterface<VideoFrame>* callback,
+                      VideoRenderScheduler* render_scheduler);
   ~IncomingVideoStream() override;
 
  protected:
@@ -41,10 +48,14 @@ class IncomingVideoStream : public rtc::VideoSinkInterface<VideoFrame> {
 
   void OnFrame(const VideoFrame& video_frame) override;
 
+  // Implements VideoRenderScheduler::Stream.
+  int64_t RenderDueFrames() override;
+
   rtc::ThreadChecker main_thread_checker_;
   rtc::ThreadChecker render_thread_checker_;
   rtc::RaceChecker decoder_race_checker_;
 
+  VideoRenderScheduler* const render_scheduler_;
   rtc::CriticalSection buffer_critsect_;
   rtc::PlatformThread incoming_render_thread_;
   std::unique_ptr<EventTimerWrapper> deliver_buffer_event_;
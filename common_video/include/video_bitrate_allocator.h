@@ -23,6 +23,11 @@ class VideoBitrateAllocator {
   virtual BitrateAllocation GetAllocation(uint32_t total_bitrate,
                                           uint32_t framerate) = 0;
   virtual uint32_t GetPreferredBitrateBps(uint32_t framerate) = 0;
+
+  // Stops allocating bitrate to the simulcast stream |simulcast_id|, leaving
+  // it to the others, until called again with |paused| false. Encoders don't
+  // encode streams allocated no bitrate.
+  virtual void SetStreamPaused(size_t simulcast_id, bool paused) {}
 };
 
 class VideoBitrateAllocationObserver {
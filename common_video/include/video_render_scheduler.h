@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_COMMON_VIDEO_INCLUDE_VIDEO_RENDER_SCHEDULER_H_
+#define WEBRTC_COMMON_VIDEO_INCLUDE_VIDEO_RENDER_SCHEDULER_H_
+
+#include <map>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/thread_annotations.h"
+
+namespace webrtc {
+
+// A single thread releasing the frames of many incoming video streams to
+// their renderers, instead of one timer and thread per stream. The thread
+// sleeps until the earliest frame of any stream is due.
+class VideoRenderScheduler {
+ public:
+  class Stream {
+   public:
+    // Renders the frames that are due without blocking. Returns the time in
+    // ms until the next frame is due, or -1 to wait for WakeUp.
+    virtual int64_t RenderDueFrames() = 0;
+
+   protected:
+    virtual ~Stream() {}
+  };
+
+  VideoRenderScheduler();
+  ~VideoRenderScheduler();
+
+  // Starts rendering |stream|, which must be removed before it is destroyed.
+  void AddStream(Stream* stream);
+  // Stops rendering |stream|. Blocks while its frames are being rendered.
+  void RemoveStream(Stream* stream);
+  // Renders |stream| as soon as possible, typically because a frame has been
+  // queued while it was empty.
+  void WakeUp(Stream* stream);
+
+ private:
+  struct StreamState {
+    // Time at which the stream should render next, -1 if it waits for WakeUp.
+    int64_t next_render_ms = -1;
+    // Set if WakeUp is called while the stream is rendering.
+    bool woken_up = false;
+  };
+
+  static bool RenderThreadFunction(void* ptr);
+  // Renders the due streams or waits until one is due. Returns false when the
+  // scheduler is being destroyed.
+  bool Run();
+
+  // Signaled when a stream may have become due earlier than the thread was
+  // waiting for.
+  rtc::Event wake_up_event_;
+  rtc::PlatformThread render_thread_;
+
+  // Held while streams are rendering, so that RemoveStream can wait for it.
+  // Acquired before |crit_|.
+  rtc::CriticalSection render_crit_;
+  rtc::CriticalSection crit_;
+  std::map<Stream*, StreamState> streams_ GUARDED_BY(crit_);
+  bool stopped_ GUARDED_BY(crit_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(VideoRenderScheduler);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_COMMON_VIDEO_INCLUDE_VIDEO_RENDER_SCHEDULER_H_
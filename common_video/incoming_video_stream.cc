@@ -20,16 +20,27 @@ namespace webrtc {
 IncomingVideoStream::IncomingVideoStream(
     int32_t delay_ms,
     rtc::VideoSinkInterface<VideoFrame>* callback)
-    : incoming_render_thread_(&IncomingVideoStreamThreadFun,
+    : IncomingVideoStream(delay_ms, callback, nullptr) {}
+
+IncomingVideoStream::IncomingVideoStream(
+    int32_t delay_ms,
+    rtc::VideoSinkInterface<VideoFrame>* callback,
+    VideoRenderScheduler* render_scheduler)
+    : render_scheduler_(render_scheduler),
+      incoming_render_thread_(&IncomingVideoStreamThreadFun,
                               this,
                               "IncomingVideoStreamThread"),
-      deliver_buffer_event_(EventTimerWrapper::Create()),
       external_callback_(callback),
       render_buffers_(new VideoRenderFrames(delay_ms)) {
   RTC_DCHECK(external_callback_);
 
   render_thread_checker_.DetachFromThread();
 
+  if (render_scheduler_) {
+    render_scheduler_->AddStream(this);
+    return;
+  }
+  deliver_buffer_event_.reset(EventTimerWrapper::Create());
   deliver_buffer_event_->StartTimer(false, kEventStartupTimeMs);
   incoming_render_thread_.Start();
   incoming_render_thread_.SetPriority(rtc::kRealtimePriority);
@@ -38,25 +49,54 @@ IncomingVideoStream::IncomingVideoStream(
 IncomingVideoStream::~IncomingVideoStream() {
   RTC_DCHECK(main_thread_checker_.CalledOnValidThread());
 
+  if (render_scheduler_)
+    render_scheduler_->RemoveStream(this);
+
   {
     rtc::CritScope cs(&buffer_critsect_);
     render_buffers_.reset();
   }
 
-  deliver_buffer_event_->Set();
-  incoming_render_thread_.Stop();
-  deliver_buffer_event_->StopTimer();
+  if (deliver_buffer_event_) {
+    deliver_buffer_event_->Set();
+    incoming_render_thread_.Stop();
+    deliver_buffer_event_->StopTimer();
+  }
 }
 
 void IncomingVideoStream::OnFrame(const VideoFrame& video_frame) {
   RTC_CHECK_RUNS_SERIALIZED(&decoder_race_checker_);
   // Hand over or insert frame.
-  rtc::CritScope csB(&buffer_critsect_);
-  if (render_buffers_->AddFrame(video_frame) == 1) {
+  bool was_empty;
+  {
+    rtc::CritScope csB(&buffer_critsect_);
+    was_empty = render_buffers_->AddFrame(video_frame) == 1;
+  }
+  if (!was_empty)
+    return;
+  if (render_scheduler_) {
+    render_scheduler_->WakeUp(this);
+  } else {
     deliver_buffer_event_->Set();
   }
 }
 
+int64_t IncomingVideoStream::RenderDueFrames() {
+  RTC_DCHECK_RUN_ON(&render_thread_checker_);
+  rtc::Optional<VideoFrame> frame_to_render;
+  int64_t wait_time_ms;
+  {
+    rtc::CritScope cs(&buffer_critsect_);
+    frame_to_render = render_buffers_->FrameToRender();
+    wait_time_ms = render_buffers_->HasFrames()
+                       ? render_buffers_->TimeToNextFrameRelease()
+                       : -1;
+  }
+  if (frame_to_render)
+    external_callback_->OnFrame(*frame_to_render);
+  return wait_time_ms;
+}
+
 bool IncomingVideoStream::IncomingVideoStreamThreadFun(void* obj) {
   return static_cast<IncomingVideoStream*>(obj)->IncomingVideoStreamProcess();
 }
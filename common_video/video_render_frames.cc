@@ -10,6 +10,7 @@
 
 #include "webrtc/common_video/video_render_frames.h"
 
+#include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/base/timeutils.h"
 #include "webrtc/modules/include/module_common_types.h"
@@ -31,14 +32,15 @@ uint32_t EnsureValidRenderDelay(uint32_t render_delay) {
 }  // namespace
 
 VideoRenderFrames::VideoRenderFrames(uint32_t render_delay_ms)
-    : render_delay_ms_(EnsureValidRenderDelay(render_delay_ms)) {}
+    : incoming_frames_(KMaxNumberOfFrames),
+      render_delay_ms_(EnsureValidRenderDelay(render_delay_ms)) {}
 
 int32_t VideoRenderFrames::AddFrame(const VideoFrame& new_frame) {
   const int64_t time_now = rtc::TimeMillis();
 
   // Drop old frames only when there are other frames in the queue, otherwise, a
   // really slow system never renders any frames.
-  if (!incoming_frames_.empty() &&
+  if (HasFrames() &&
       new_frame.render_time_ms() + KOldRenderTimestampMS < time_now) {
     WEBRTC_TRACE(kTraceWarning,
                  kTraceVideoRenderer,
@@ -56,30 +58,50 @@ int32_t VideoRenderFrames::AddFrame(const VideoFrame& new_frame) {
     return -1;
   }
 
-  incoming_frames_.push_back(new_frame);
-  if (incoming_frames_.size() > kMaxIncomingFramesBeforeLogged)
-    LOG(LS_WARNING) << "Stored incoming frames: " << incoming_frames_.size();
-  return static_cast<int32_t>(incoming_frames_.size());
+  if (num_frames_ == incoming_frames_.size()) {
+    LOG(LS_WARNING) << "Render queue full, dropping the oldest frame.";
+    PopOldestFrame();
+  }
+  incoming_frames_[(oldest_frame_index_ + num_frames_) %
+                   incoming_frames_.size()] =
+      rtc::Optional<VideoFrame>(new_frame);
+  ++num_frames_;
+  if (num_frames_ > kMaxIncomingFramesBeforeLogged)
+    LOG(LS_WARNING) << "Stored incoming frames: " << num_frames_;
+  return static_cast<int32_t>(num_frames_);
 }
 
 rtc::Optional<VideoFrame> VideoRenderFrames::FrameToRender() {
   rtc::Optional<VideoFrame> render_frame;
   // Get the newest frame that can be released for rendering.
-  while (!incoming_frames_.empty() && TimeToNextFrameRelease() <= 0) {
-    render_frame = rtc::Optional<VideoFrame>(incoming_frames_.front());
-    incoming_frames_.pop_front();
+  while (HasFrames() && TimeToNextFrameRelease() <= 0) {
+    render_frame = rtc::Optional<VideoFrame>(OldestFrame());
+    PopOldestFrame();
   }
   return render_frame;
 }
 
 uint32_t VideoRenderFrames::TimeToNextFrameRelease() {
-  if (incoming_frames_.empty()) {
+  if (!HasFrames()) {
     return kEventMaxWaitTimeMs;
   }
-  const int64_t time_to_release = incoming_frames_.front().render_time_ms() -
+  const int64_t time_to_release = OldestFrame().render_time_ms() -
                                   render_delay_ms_ -
                                   rtc::TimeMillis();
   return time_to_release < 0 ? 0u : static_cast<uint32_t>(time_to_release);
 }
 
+const VideoFrame& VideoRenderFrames::OldestFrame() const {
+  RTC_DCHECK(HasFrames());
+  return *incoming_frames_[oldest_frame_index_];
+}
+
+void VideoRenderFrames::PopOldestFrame() {
+  RTC_DCHECK(HasFrames());
+  // Release the frame buffer right away.
+  incoming_frames_[oldest_frame_index_] = rtc::Optional<VideoFrame>();
+  oldest_frame_index_ = (oldest_frame_index_ + 1) % incoming_frames_.size();
+  --num_frames_;
+}
+
 }  // namespace webrtc
@@ -13,7 +13,7 @@
 
 #include <stdint.h>
 
-#include <list>
+#include <vector>
 
 #include "webrtc/api/video/video_frame.h"
 #include "webrtc/base/optional.h"
@@ -35,6 +35,8 @@ class VideoRenderFrames {
   // Returns the number of ms to next frame to render
   uint32_t TimeToNextFrameRelease();
 
+  bool HasFrames() const { return num_frames_ > 0; }
+
  private:
   // 10 seconds for 30 fps.
   enum { KMaxNumberOfFrames = 300 };
@@ -43,8 +45,14 @@ class VideoRenderFrames {
   // Don't render frames with timestamp more than 10s into the future.
   enum { KFutureRenderTimestampMS = 10000 };
 
-  // Sorted list with framed to be rendered, oldest first.
-  std::list<VideoFrame> incoming_frames_;
+  const VideoFrame& OldestFrame() const;
+  void PopOldestFrame();
+
+  // Ring of the frames to be rendered, oldest first, so no allocation is
+  // needed per frame. The oldest frame is dropped when it is full.
+  std::vector<rtc::Optional<VideoFrame>> incoming_frames_;
+  size_t oldest_frame_index_ = 0;
+  size_t num_frames_ = 0;
 
   // Estimated delay from a frame is released until it's rendered.
   const uint32_t render_delay_ms_;
@@ -0,0 +1,98 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_video/video_render_frames.h"
+
+#include "webrtc/api/video/i420_buffer.h"
+#include "webrtc/base/fakeclock.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace {
+constexpr uint32_t kRenderDelayMs = 10;
+constexpr int kMaxNumberOfFrames = 300;
+
+class VideoRenderFramesTest : public ::testing::Test {
+ protected:
+  VideoRenderFramesTest()
+      : buffer_(I420Buffer::Create(16, 16)), frames_(kRenderDelayMs) {
+    clock_.SetTimeMicros(1000 * rtc::kNumMicrosecsPerMillisec);
+  }
+
+  VideoFrame CreateFrame(int64_t render_time_ms) {
+    return VideoFrame(buffer_, 0, render_time_ms, kVideoRotation_0);
+  }
+
+  void AdvanceTimeMs(int64_t ms) {
+    clock_.AdvanceTimeMicros(ms * rtc::kNumMicrosecsPerMillisec);
+  }
+
+  rtc::ScopedFakeClock clock_;
+  rtc::scoped_refptr<I420Buffer> buffer_;
+  VideoRenderFrames frames_;
+};
+}  // namespace
+
+TEST_F(VideoRenderFramesTest, ReleasesNewestDueFrame) {
+  const int64_t now_ms = rtc::TimeMillis();
+  EXPECT_FALSE(frames_.HasFrames());
+  EXPECT_EQ(1, frames_.AddFrame(CreateFrame(now_ms + 20)));
+  EXPECT_EQ(2, frames_.AddFrame(CreateFrame(now_ms + 30)));
+  EXPECT_EQ(3, frames_.AddFrame(CreateFrame(now_ms + 100)));
+  EXPECT_EQ(10u, frames_.TimeToNextFrameRelease());
+  EXPECT_FALSE(frames_.FrameToRender());
+
+  AdvanceTimeMs(20);
+  rtc::Optional<VideoFrame> frame = frames_.FrameToRender();
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(now_ms + 30, frame->render_time_ms());
+  EXPECT_EQ(70u, frames_.TimeToNextFrameRelease());
+  EXPECT_TRUE(frames_.HasFrames());
+
+  AdvanceTimeMs(70);
+  frame = frames_.FrameToRender();
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(now_ms + 100, frame->render_time_ms());
+  EXPECT_FALSE(frames_.HasFrames());
+}
+
+TEST_F(VideoRenderFramesTest, RejectsFramesTooFarInTheFuture) {
+  const int64_t now_ms = rtc::TimeMillis();
+  EXPECT_EQ(-1, frames_.AddFrame(CreateFrame(now_ms + 20000)));
+  EXPECT_FALSE(frames_.HasFrames());
+}
+
+TEST_F(VideoRenderFramesTest, DropsOldestFrameWhenFull) {
+  const int64_t now_ms = rtc::TimeMillis();
+  for (int i = 0; i < kMaxNumberOfFrames; ++i)
+    EXPECT_EQ(i + 1, frames_.AddFrame(CreateFrame(now_ms + 100 + i)));
+  for (int i = kMaxNumberOfFrames; i < kMaxNumberOfFrames + 10; ++i) {
+    EXPECT_EQ(kMaxNumberOfFrames,
+              frames_.AddFrame(CreateFrame(now_ms + 100 + i)));
+  }
+  // The first 10 frames have been dropped.
+  EXPECT_EQ(100u, frames_.TimeToNextFrameRelease());
+
+  AdvanceTimeMs(1000);
+  rtc::Optional<VideoFrame> frame = frames_.FrameToRender();
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(now_ms + 100 + kMaxNumberOfFrames + 9, frame->render_time_ms());
+  EXPECT_FALSE(frames_.HasFrames());
+
+  // The ring is reused after wrapping around.
+  EXPECT_EQ(1, frames_.AddFrame(CreateFrame(now_ms + 1100)));
+  AdvanceTimeMs(100);
+  frame = frames_.FrameToRender();
+  ASSERT_TRUE(frame);
+  EXPECT_EQ(now_ms + 1100, frame->render_time_ms());
+}
+
+}  // namespace webrtc
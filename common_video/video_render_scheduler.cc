@@ -0,0 +1,122 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_video/include/video_render_scheduler.h"
+
+#include <vector>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/timeutils.h"
+
+namespace webrtc {
+
+VideoRenderScheduler::VideoRenderScheduler()
+    : wake_up_event_(false, false),
+      render_thread_(RenderThreadFunction, this, "SharedRenderThread"),
+      stopped_(false) {
+  render_thread_.Start();
+  render_thread_.SetPriority(rtc::kRealtimePriority);
+}
+
+VideoRenderScheduler::~VideoRenderScheduler() {
+  {
+    rtc::CritScope lock(&crit_);
+    RTC_DCHECK(streams_.empty());
+    stopped_ = true;
+  }
+  wake_up_event_.Set();
+  render_thread_.Stop();
+}
+
+void VideoRenderScheduler::AddStream(Stream* stream) {
+  rtc::CritScope lock(&crit_);
+  RTC_DCHECK(streams_.find(stream) == streams_.end());
+  streams_[stream].next_render_ms = rtc::TimeMillis();
+  wake_up_event_.Set();
+}
+
+void VideoRenderScheduler::RemoveStream(Stream* stream) {
+  rtc::CritScope render_lock(&render_crit_);
+  rtc::CritScope lock(&crit_);
+  RTC_DCHECK(streams_.find(stream) != streams_.end());
+  streams_.erase(stream);
+}
+
+void VideoRenderScheduler::WakeUp(Stream* stream) {
+  rtc::CritScope lock(&crit_);
+  auto it = streams_.find(stream);
+  if (it == streams_.end())
+    return;
+  StreamState& state = it->second;
+  state.woken_up = true;
+  int64_t now_ms = rtc::TimeMillis();
+  if (state.next_render_ms == -1 || state.next_render_ms > now_ms) {
+    state.next_render_ms = now_ms;
+    wake_up_event_.Set();
+  }
+}
+
+bool VideoRenderScheduler::RenderThreadFunction(void* ptr) {
+  return static_cast<VideoRenderScheduler*>(ptr)->Run();
+}
+
+bool VideoRenderScheduler::Run() {
+  std::vector<Stream*> due_streams;
+  int64_t wait_ms = rtc::Event::kForever;
+  {
+    rtc::CritScope lock(&crit_);
+    if (stopped_)
+      return false;
+    int64_t now_ms = rtc::TimeMillis();
+    for (auto& entry : streams_) {
+      StreamState& state = entry.second;
+      if (state.next_render_ms == -1)
+        continue;
+      if (state.next_render_ms > now_ms) {
+        int64_t time_until_due_ms = state.next_render_ms - now_ms;
+        if (wait_ms == rtc::Event::kForever || time_until_due_ms < wait_ms)
+          wait_ms = time_until_due_ms;
+        continue;
+      }
+      state.next_render_ms = -1;
+      state.woken_up = false;
+      due_streams.push_back(entry.first);
+    }
+  }
+
+  if (due_streams.empty()) {
+    wake_up_event_.Wait(static_cast<int>(wait_ms));
+    return true;
+  }
+
+  rtc::CritScope render_lock(&render_crit_);
+  for (Stream* stream : due_streams) {
+    {
+      // The stream may have been removed since it was found due.
+      rtc::CritScope lock(&crit_);
+      if (streams_.find(stream) == streams_.end())
+        continue;
+    }
+    int64_t delay_ms = stream->RenderDueFrames();
+
+    rtc::CritScope lock(&crit_);
+    StreamState& state = streams_[stream];
+    int64_t now_ms = rtc::TimeMillis();
+    if (state.woken_up) {
+      state.next_render_ms = now_ms;
+    } else {
+      state.next_render_ms = delay_ms < 0 ? -1 : now_ms + delay_ms;
+    }
+    state.woken_up = false;
+  }
+  return true;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,120 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/common_video/include/video_render_scheduler.h"
+
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace {
+constexpr int kTimeoutMs = 5000;
+
+class FakeStream : public VideoRenderScheduler::Stream {
+ public:
+  FakeStream() : render_event_(false, false), num_renders_(0), delay_ms_(-1) {}
+  ~FakeStream() override {}
+
+  int64_t RenderDueFrames() override {
+    rtc::CritScope lock(&crit_);
+    ++num_renders_;
+    render_event_.Set();
+    return delay_ms_;
+  }
+
+  bool WaitForRender(int timeout_ms = kTimeoutMs) {
+    return render_event_.Wait(timeout_ms);
+  }
+
+  void set_delay_ms(int64_t delay_ms) {
+    rtc::CritScope lock(&crit_);
+    delay_ms_ = delay_ms;
+  }
+  int num_renders() const {
+    rtc::CritScope lock(&crit_);
+    return num_renders_;
+  }
+
+ private:
+  rtc::Event render_event_;
+  rtc::CriticalSection crit_;
+  int num_renders_ GUARDED_BY(crit_);
+  int64_t delay_ms_ GUARDED_BY(crit_);
+};
+}  // namespace
+
+TEST(VideoRenderSchedulerTest, RendersAddedStream) {
+  VideoRenderScheduler scheduler;
+  FakeStream stream;
+  scheduler.AddStream(&stream);
+  EXPECT_TRUE(stream.WaitForRender());
+  scheduler.RemoveStream(&stream);
+}
+
+TEST(VideoRenderSchedulerTest, WaitsForWakeUp) {
+  VideoRenderScheduler scheduler;
+  FakeStream stream;
+  scheduler.AddStream(&stream);
+  ASSERT_TRUE(stream.WaitForRender());
+  EXPECT_FALSE(stream.WaitForRender(50));
+  EXPECT_EQ(1, stream.num_renders());
+
+  scheduler.WakeUp(&stream);
+  EXPECT_TRUE(stream.WaitForRender());
+  EXPECT_EQ(2, stream.num_renders());
+  scheduler.RemoveStream(&stream);
+}
+
+TEST(VideoRenderSchedulerTest, RendersWhenNextFrameIsDue) {
+  VideoRenderScheduler scheduler;
+  FakeStream stream;
+  stream.set_delay_ms(10);
+  scheduler.AddStream(&stream);
+  ASSERT_TRUE(stream.WaitForRender());
+  EXPECT_TRUE(stream.WaitForRender());
+  stream.set_delay_ms(-1);
+  ASSERT_TRUE(stream.WaitForRender());
+  scheduler.RemoveStream(&stream);
+}
+
+TEST(VideoRenderSchedulerTest, RendersSeveralStreams) {
+  VideoRenderScheduler scheduler;
+  FakeStream stream1;
+  FakeStream stream2;
+  stream2.set_delay_ms(10);
+  scheduler.AddStream(&stream1);
+  scheduler.AddStream(&stream2);
+  ASSERT_TRUE(stream1.WaitForRender());
+  ASSERT_TRUE(stream2.WaitForRender());
+
+  // |stream2| keeps rendering while |stream1| waits.
+  EXPECT_TRUE(stream2.WaitForRender());
+  scheduler.WakeUp(&stream1);
+  EXPECT_TRUE(stream1.WaitForRender());
+  scheduler.RemoveStream(&stream1);
+  scheduler.RemoveStream(&stream2);
+}
+
+TEST(VideoRenderSchedulerTest, DoesNotRenderRemovedStream) {
+  VideoRenderScheduler scheduler;
+  FakeStream stream;
+  stream.set_delay_ms(1);
+  scheduler.AddStream(&stream);
+  ASSERT_TRUE(stream.WaitForRender());
+  scheduler.RemoveStream(&stream);
+  // RemoveStream waits for a render in progress, no render starts after it.
+  const int num_renders = stream.num_renders();
+  scheduler.WakeUp(&stream);
+  stream.WaitForRender(50);
+  EXPECT_EQ(num_renders, stream.num_renders());
+}
+
+}  // namespace webrtc
@@ -15,6 +15,17 @@
 #include "webrtc/base/checks.h"
 
 namespace webrtc {
+MediaCryptoStats& MediaCryptoStats::operator+=(const MediaCryptoStats& other) {
+  encrypt_time_ns += other.encrypt_time_ns;
+  decrypt_time_ns += other.decrypt_time_ns;
+  bytes_encrypted += other.bytes_encrypted;
+  bytes_decrypted += other.bytes_decrypted;
+  encrypt_failures += other.encrypt_failures;
+  auth_failures += other.auth_failures;
+  replay_drops += other.replay_drops;
+  return *this;
+}
+
 std::string NackConfig::ToString() const {
   std::stringstream ss;
   ss << "{rtp_history_ms: " << rtp_history_ms;
@@ -30,8 +30,29 @@ namespace webrtc {
 struct MediaCryptoKey {
   int type = rtc::SRTP_INVALID_CRYPTO_SUITE;
   std::vector<uint8_t> buffer;
+  // Sent in the OHB of every packet, so receivers holding both the previous
+  // and the next key during a rotation know which one to use.
+  uint8_t id = 0;
   bool Parse(int crypto_suite, const std::string &str);
 };
+
+// Cumulative cost of the inner PERC layer of one stream.
+struct MediaCryptoStats {
+  MediaCryptoStats& operator+=(const MediaCryptoStats& other);
+
+  int64_t encrypt_time_ns = 0;
+  int64_t decrypt_time_ns = 0;
+  // Size of the inner packets transformed successfully, before the
+  // transformation.
+  uint64_t bytes_encrypted = 0;
+  uint64_t bytes_decrypted = 0;
+  uint32_t encrypt_failures = 0;
+  // Received packets that failed to authenticate or decrypt for other reasons
+  // than a replay, including those protected with an unknown key.
+  uint32_t auth_failures = 0;
+  // Received packets dropped as replayed or too old.
+  uint32_t replay_drops = 0;
+};
   
 
 // Settings for NACK, see RFC 4585 for details.
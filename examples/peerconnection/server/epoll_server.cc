@@ -0,0 +1,201 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/examples/peerconnection/server/epoll_server.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <sys/epoll.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/examples/peerconnection/server/data_socket.h"
+#include "webrtc/examples/peerconnection/server/peer_channel.h"
+#include "webrtc/examples/peerconnection/server/request_handler.h"
+#include "webrtc/examples/peerconnection/server/utils.h"
+
+namespace {
+
+const int kMaxEventsPerWait = 64;
+// How long a worker waits for events before checking whether it should stop.
+const int kWorkerWaitMs = 100;
+// How long the accepting thread waits for a connection before checking for
+// "/quit" and timed out peers.
+const int kAcceptWaitMs = 1000;
+
+}  // namespace
+
+EpollServer::Worker::Worker(EpollServer* server, int index)
+    : server(server), epoll_fd(epoll_create1(EPOLL_CLOEXEC)) {
+  std::string name = "Worker" + int2str(index);
+  thread.reset(new rtc::PlatformThread(&EpollServer::WorkerThreadRun, this,
+                                       name.c_str()));
+}
+
+EpollServer::Worker::~Worker() {
+  for (DataSocket* ds : sockets)
+    delete ds;
+  if (epoll_fd != -1)
+    close(epoll_fd);
+}
+
+EpollServer::EpollServer(ListeningSocket* listener, PeerChannel* clients,
+                         int num_workers)
+    : listener_(listener), clients_(clients), quit_(0) {
+  assert(listener_ && listener_->valid());
+  assert(clients_);
+  assert(num_workers > 0);
+  for (int i = 0; i < num_workers; ++i)
+    workers_.push_back(std::unique_ptr<Worker>(new Worker(this, i)));
+}
+
+EpollServer::~EpollServer() {
+  // Stop all workers before any of them deletes its sockets, since a peer on
+  // one worker may still be waiting on a socket owned by another.
+  for (const auto& worker : workers_)
+    worker->thread->Stop();
+}
+
+bool EpollServer::Run() {
+  int listen_fd = epoll_create1(EPOLL_CLOEXEC);
+  if (listen_fd == -1) {
+    printf("epoll_create1 failed\n");
+    return false;
+  }
+  for (const auto& worker : workers_) {
+    if (worker->epoll_fd == -1) {
+      printf("epoll_create1 failed\n");
+      close(listen_fd);
+      return false;
+    }
+  }
+
+  struct epoll_event event = {0};
+  event.events = EPOLLIN;
+  if (epoll_ctl(listen_fd, EPOLL_CTL_ADD, listener_->socket(), &event) == -1) {
+    printf("epoll_ctl failed\n");
+    close(listen_fd);
+    return false;
+  }
+
+  for (const auto& worker : workers_)
+    worker->thread->Start();
+
+  size_t next_worker = 0;
+  time_t last_timeout_check = time(NULL);
+  while (true) {
+    int count = epoll_wait(listen_fd, &event, 1, kAcceptWaitMs);
+    if (count == -1 && errno != EINTR) {
+      printf("epoll_wait failed\n");
+      break;
+    }
+
+    if (rtc::AtomicOps::AcquireLoad(&quit_)) {
+      printf("Quitting...\n");
+      listener_->Close();
+      rtc::CritScope cs(&clients_lock_);
+      clients_->CloseAll();
+      break;
+    }
+
+    if (count > 0) {
+      DataSocket* s = listener_->Accept();
+      if (s) {
+        AddSocket(workers_[next_worker].get(), s);
+        next_worker = (next_worker + 1) % workers_.size();
+        printf("New connection...\n");
+      }
+    }
+
+    // Peers are timed out with one second resolution, so there is no need to
+    // scan all of them for every accepted connection.
+    time_t now = time(NULL);
+    if (now != last_timeout_check) {
+      last_timeout_check = now;
+      rtc::CritScope cs(&clients_lock_);
+      clients_->CheckForTimeout();
+    }
+  }
+
+  close(listen_fd);
+  return true;
+}
+
+// static
+bool EpollServer::WorkerThreadRun(void* obj) {
+  Worker* worker = static_cast<Worker*>(obj);
+  return worker->server->ProcessWorkerEvents(worker);
+}
+
+bool EpollServer::ProcessWorkerEvents(Worker* worker) {
+  struct epoll_event events[kMaxEventsPerWait];
+  int count =
+      epoll_wait(worker->epoll_fd, events, kMaxEventsPerWait, kWorkerWaitMs);
+  if (count == -1) {
+    if (errno == EINTR)
+      return true;
+    printf("epoll_wait failed\n");
+    return false;
+  }
+
+  for (int i = 0; i < count; ++i) {
+    DataSocket* s = static_cast<DataSocket*>(events[i].data.ptr);
+    // Only the owning worker reads from |s|, so it is parsed without holding
+    // |clients_lock_|.  Other workers merely send on it once it is parked as
+    // a peer's waiting socket, which does not touch the parser state.
+    bool socket_done = true;
+    if (s->OnDataAvailable(&socket_done) && s->request_received()) {
+      bool quit = false;
+      {
+        rtc::CritScope cs(&clients_lock_);
+        HandleRequest(clients_, s, &quit);
+      }
+      if (quit)
+        rtc::AtomicOps::ReleaseStore(&quit_, 1);
+    }
+
+    if (socket_done) {
+      printf("Disconnecting socket\n");
+      CloseSocket(worker, s);
+    }
+  }
+  return true;
+}
+
+void EpollServer::AddSocket(Worker* worker, DataSocket* ds) {
+  {
+    rtc::CritScope cs(&worker->lock);
+    worker->sockets.insert(ds);
+  }
+  struct epoll_event event = {0};
+  event.events = EPOLLIN;
+  event.data.ptr = ds;
+  if (epoll_ctl(worker->epoll_fd, EPOLL_CTL_ADD, ds->socket(), &event) == -1) {
+    printf("epoll_ctl failed\n");
+    CloseSocket(worker, ds);
+  }
+}
+
+void EpollServer::CloseSocket(Worker* worker, DataSocket* ds) {
+  {
+    rtc::CritScope cs(&clients_lock_);
+    clients_->OnClosing(ds);
+  }
+  assert(ds->valid());  // Close must not have been called yet.
+  epoll_ctl(worker->epoll_fd, EPOLL_CTL_DEL, ds->socket(), NULL);
+  {
+    rtc::CritScope cs(&worker->lock);
+    worker->sockets.erase(ds);
+  }
+  delete ds;
+}
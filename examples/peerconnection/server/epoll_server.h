@@ -0,0 +1,76 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_EXAMPLES_PEERCONNECTION_SERVER_EPOLL_SERVER_H_
+#define WEBRTC_EXAMPLES_PEERCONNECTION_SERVER_EPOLL_SERVER_H_
+#pragma once
+
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/platform_thread.h"
+
+class DataSocket;
+class ListeningSocket;
+class PeerChannel;
+
+// Serves the signaling protocol with epoll instead of select(), so that the
+// number of connections is not limited by FD_SETSIZE.  The calling thread
+// accepts connections and hands them out round-robin to a number of worker
+// threads, each of which waits on its own epoll instance and owns the sockets
+// it was given.  Requests are dispatched to the shared PeerChannel under a
+// single lock, since forwarding a message touches the member (and the waiting
+// socket) of another peer that may live on any worker.
+class EpollServer {
+ public:
+  EpollServer(ListeningSocket* listener, PeerChannel* clients,
+              int num_workers);
+  ~EpollServer();
+
+  // Serves requests until a "/quit" request is received.  Returns false if
+  // the server could not be set up.
+  bool Run();
+
+ private:
+  struct Worker {
+    Worker(EpollServer* server, int index);
+    ~Worker();
+
+    EpollServer* const server;
+    int epoll_fd;
+    std::unique_ptr<rtc::PlatformThread> thread;
+    // Guards |sockets|, which the accepting thread adds to.
+    rtc::CriticalSection lock;
+    std::unordered_set<DataSocket*> sockets;
+  };
+
+  static bool WorkerThreadRun(void* obj);
+  bool ProcessWorkerEvents(Worker* worker);
+
+  // Registers a newly accepted socket with |worker|, which takes ownership.
+  void AddSocket(Worker* worker, DataSocket* ds);
+  // Unregisters |ds| from |worker| and from the peers, and deletes it.
+  void CloseSocket(Worker* worker, DataSocket* ds);
+
+  ListeningSocket* const listener_;
+  PeerChannel* const clients_;
+  // Guards |clients_| and every ChannelMember in it.
+  rtc::CriticalSection clients_lock_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  // Set by a worker when a "/quit" request is received.
+  volatile int quit_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(EpollServer);
+};
+
+#endif  // WEBRTC_EXAMPLES_PEERCONNECTION_SERVER_EPOLL_SERVER_H_
@@ -15,44 +15,27 @@
 #include <vector>
 
 #include "webrtc/examples/peerconnection/server/data_socket.h"
+#if defined(WEBRTC_LINUX)
+#include "webrtc/examples/peerconnection/server/epoll_server.h"
+#endif
 #include "webrtc/examples/peerconnection/server/peer_channel.h"
+#include "webrtc/examples/peerconnection/server/request_handler.h"
 #include "webrtc/examples/peerconnection/server/utils.h"
 #include "webrtc/tools/simple_command_line_parser.h"
 
 static const size_t kMaxConnections = (FD_SETSIZE - 2);
 
-void HandleBrowserRequest(DataSocket* ds, bool* quit) {
-  assert(ds && ds->valid());
-  assert(quit);
-
-  const std::string& path = ds->request_path();
-
-  *quit = (path.compare("/quit") == 0);
-
-  if (*quit) {
-    ds->Send("200 OK", true, "text/html", "",
-             "<html><body>Quitting...</body></html>");
-  } else if (ds->method() == DataSocket::OPTIONS) {
-    // We'll get this when a browsers do cross-resource-sharing requests.
-    // The headers to allow cross-origin script support will be set inside
-    // Send.
-    ds->Send("200 OK", true, "", "", "");
-  } else {
-    // Here we could write some useful output back to the browser depending on
-    // the path.
-    printf("Received an invalid request: %s\n", ds->request_path().c_str());
-    ds->Send("500 Sorry", true, "text/html", "",
-             "<html><body>Sorry, not yet implemented</body></html>");
-  }
-}
-
 int main(int argc, char** argv) {
   std::string program_name = argv[0];
-  std::string usage = "Example usage: " + program_name + " --port=8888";
+  std::string usage = "Example usage: " + program_name +
+                      " --port=8888 [--threads=4]";
   webrtc::test::CommandLineParser parser;
   parser.Init(argc, argv);
   parser.SetUsageMessage(usage);
   parser.SetFlag("port", "8888");
+  // With a positive number of threads, connections are served by that many
+  // epoll workers instead of the single threaded select() loop (Linux only).
+  parser.SetFlag("threads", "0");
   parser.SetFlag("help", "false");
   parser.ProcessFlags();
 
@@ -82,6 +65,18 @@ int main(int argc, char** argv) {
   printf("Server listening on port %i\n", port);
 
   PeerChannel clients;
+
+  int threads = strtol((parser.GetFlag("threads")).c_str(), NULL, 10);
+  if (threads > 0) {
+#if defined(WEBRTC_LINUX)
+    printf("Serving with %i epoll worker threads\n", threads);
+    EpollServer server(&listener, &clients, threads);
+    return server.Run() ? 0 : -1;
+#else
+    printf("Warning: --threads is only supported on Linux, ignoring it.\n");
+#endif
+  }
+
   typedef std::vector<DataSocket*> SocketArray;
   SocketArray sockets;
   bool quit = false;
@@ -105,41 +100,12 @@ int main(int argc, char** argv) {
       bool socket_done = true;
       if (FD_ISSET(s->socket(), &socket_set)) {
         if (s->OnDataAvailable(&socket_done) && s->request_received()) {
-          ChannelMember* member = clients.Lookup(s);
-          if (member || PeerChannel::IsPeerConnection(s)) {
-            if (!member) {
-              if (s->PathEquals("/sign_in")) {
-                clients.AddMember(s);
-              } else {
-                printf("No member found for: %s\n",
-                    s->request_path().c_str());
-                s->Send("500 Error", true, "text/plain", "",
-                        "Peer most likely gone.");
-              }
-            } else if (member->is_wait_request(s)) {
-              // no need to do anything.
-              socket_done = false;
-            } else {
-              ChannelMember* target = clients.IsTargetedRequest(s);
-              if (target) {
-                member->ForwardRequestToPeer(s, target);
-              } else if (s->PathEquals("/sign_out")) {
-                s->Send("200 OK", true, "text/plain", "", "");
-              } else {
-                printf("Couldn't find target for request: %s\n",
-                    s->request_path().c_str());
-                s->Send("500 Error", true, "text/plain", "",
-                        "Peer most likely gone.");
-              }
-            }
-          } else {
-            HandleBrowserRequest(s, &quit);
-            if (quit) {
-              printf("Quitting...\n");
-              FD_CLR(listener.socket(), &socket_set);
-              listener.Close();
-              clients.CloseAll();
-            }
+          HandleRequest(&clients, s, &quit);
+          if (quit) {
+            printf("Quitting...\n");
+            FD_CLR(listener.socket(), &socket_set);
+            listener.Close();
+            clients.CloseAll();
           }
         }
       } else {
@@ -198,18 +198,16 @@ ChannelMember* PeerChannel::Lookup(DataSocket* ds) const {
     return NULL;
 
   int id = atoi(&args[found + ARRAYSIZE(kPeerId) - 1]);
-  Members::const_iterator iter = members_.begin();
-  for (; iter != members_.end(); ++iter) {
-    if (id == (*iter)->id()) {
-      if (i == kWait)
-        (*iter)->SetWaitingSocket(ds);
-      if (i == kSignOut)
-        (*iter)->set_disconnected();
-      return *iter;
-    }
-  }
+  auto iter = members_by_id_.find(id);
+  if (iter == members_by_id_.end())
+    return NULL;
 
-  return NULL;
+  ChannelMember* member = iter->second;
+  if (i == kWait)
+    member->SetWaitingSocket(ds);
+  if (i == kSignOut)
+    member->set_disconnected();
+  return member;
 }
 
 ChannelMember* PeerChannel::IsTargetedRequest(const DataSocket* ds) const {
@@ -233,13 +231,8 @@ ChannelMember* PeerChannel::IsTargetedRequest(const DataSocket* ds) const {
     args = found + ARRAYSIZE(kTargetPeerIdParam) - 1;
   } while (true);
   int id = atoi(&path[found]);
-  Members::const_iterator i = members_.begin();
-  for (; i != members_.end(); ++i) {
-    if ((*i)->id() == id) {
-      return *i;
-    }
-  }
-  return NULL;
+  auto i = members_by_id_.find(id);
+  return i != members_by_id_.end() ? i->second : NULL;
 }
 
 bool PeerChannel::AddMember(DataSocket* ds) {
@@ -249,6 +242,7 @@ bool PeerChannel::AddMember(DataSocket* ds) {
   BroadcastChangedState(*new_guy, &failures);
   HandleDeliveryFailures(&failures);
   members_.push_back(new_guy);
+  members_by_id_[new_guy->id()] = new_guy;
 
   printf("New member added (total=%s): %s\n",
       size_t2str(members_.size()).c_str(), new_guy->name().c_str());
@@ -274,7 +268,7 @@ void PeerChannel::OnClosing(DataSocket* ds) {
     ChannelMember* m = (*i);
     m->OnClosing(ds);
     if (!m->connected()) {
-      i = members_.erase(i);
+      i = EraseMember(i);
       Members failures;
       BroadcastChangedState(*m, &failures);
       HandleDeliveryFailures(&failures);
@@ -292,7 +286,7 @@ void PeerChannel::CheckForTimeout() {
     if (m->TimedOut()) {
       printf("Timeout: %s\n", m->name().c_str());
       m->set_disconnected();
-      i = members_.erase(i);
+      i = EraseMember(i);
       Members failures;
       BroadcastChangedState(*m, &failures);
       HandleDeliveryFailures(&failures);
@@ -307,6 +301,12 @@ void PeerChannel::DeleteAll() {
   for (Members::iterator i = members_.begin(); i != members_.end(); ++i)
     delete (*i);
   members_.clear();
+  members_by_id_.clear();
+}
+
+PeerChannel::Members::iterator PeerChannel::EraseMember(Members::iterator i) {
+  members_by_id_.erase((*i)->id());
+  return members_.erase(i);
 }
 
 void PeerChannel::BroadcastChangedState(const ChannelMember& member,
@@ -324,7 +324,7 @@ void PeerChannel::BroadcastChangedState(const ChannelMember& member,
       if (!(*i)->NotifyOfOtherMember(member)) {
         (*i)->set_disconnected();
         delivery_failures->push_back(*i);
-        i = members_.erase(i);
+        i = EraseMember(i);
         if (i == members_.end())
           break;
       }
@@ -16,6 +16,7 @@
 
 #include <queue>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 class DataSocket;
@@ -105,6 +106,9 @@ class PeerChannel {
 
  protected:
   void DeleteAll();
+  // Removes the member at |i| from |members_| and |members_by_id_|, without
+  // deleting it. Returns the iterator following |i|.
+  Members::iterator EraseMember(Members::iterator i);
   void BroadcastChangedState(const ChannelMember& member,
                              Members* delivery_failures);
   void HandleDeliveryFailures(Members* failures);
@@ -115,6 +119,9 @@ class PeerChannel {
 
  protected:
   Members members_;
+  // The members of |members_| by id, so that requests find their peer without
+  // scanning all members.
+  std::unordered_map<int, ChannelMember*> members_by_id_;
 };
 
 #endif  // WEBRTC_EXAMPLES_PEERCONNECTION_SERVER_PEER_CHANNEL_H_
@@ -0,0 +1,79 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/examples/peerconnection/server/request_handler.h"
+
+#include <assert.h>
+#include <stdio.h>
+
+#include "webrtc/examples/peerconnection/server/data_socket.h"
+#include "webrtc/examples/peerconnection/server/peer_channel.h"
+
+void HandleBrowserRequest(DataSocket* ds, bool* quit) {
+  assert(ds && ds->valid());
+  assert(quit);
+
+  const std::string& path = ds->request_path();
+
+  *quit = (path.compare("/quit") == 0);
+
+  if (*quit) {
+    ds->Send("200 OK", true, "text/html", "",
+             "<html><body>Quitting...</body></html>");
+  } else if (ds->method() == DataSocket::OPTIONS) {
+    // We'll get this when a browsers do cross-resource-sharing requests.
+    // The headers to allow cross-origin script support will be set inside
+    // Send.
+    ds->Send("200 OK", true, "", "", "");
+  } else {
+    // Here we could write some useful output back to the browser depending on
+    // the path.
+    printf("Received an invalid request: %s\n", ds->request_path().c_str());
+    ds->Send("500 Sorry", true, "text/html", "",
+             "<html><body>Sorry, not yet implemented</body></html>");
+  }
+}
+
+void HandleRequest(PeerChannel* clients, DataSocket* ds, bool* quit) {
+  assert(clients);
+  assert(ds && ds->request_received());
+  assert(quit);
+
+  *quit = false;
+
+  ChannelMember* member = clients->Lookup(ds);
+  if (member || PeerChannel::IsPeerConnection(ds)) {
+    if (!member) {
+      if (ds->PathEquals("/sign_in")) {
+        clients->AddMember(ds);
+      } else {
+        printf("No member found for: %s\n", ds->request_path().c_str());
+        ds->Send("500 Error", true, "text/plain", "",
+                 "Peer most likely gone.");
+      }
+    } else if (member->is_wait_request(ds)) {
+      // no need to do anything.
+    } else {
+      ChannelMember* target = clients->IsTargetedRequest(ds);
+      if (target) {
+        member->ForwardRequestToPeer(ds, target);
+      } else if (ds->PathEquals("/sign_out")) {
+        ds->Send("200 OK", true, "text/plain", "", "");
+      } else {
+        printf("Couldn't find target for request: %s\n",
+            ds->request_path().c_str());
+        ds->Send("500 Error", true, "text/plain", "",
+                 "Peer most likely gone.");
+      }
+    }
+  } else {
+    HandleBrowserRequest(ds, quit);
+  }
+}
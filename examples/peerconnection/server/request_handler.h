@@ -0,0 +1,29 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_EXAMPLES_PEERCONNECTION_SERVER_REQUEST_HANDLER_H_
+#define WEBRTC_EXAMPLES_PEERCONNECTION_SERVER_REQUEST_HANDLER_H_
+#pragma once
+
+class DataSocket;
+class PeerChannel;
+
+// Answers a request that is not peerconnection related, e.g. one sent by a
+// browser.  Sets |quit| if the request asked the server to shut down.
+void HandleBrowserRequest(DataSocket* ds, bool* quit);
+
+// Handles a fully received request on |ds|: signs peers in and out, parks
+// wait requests and forwards messages to their target peer in |clients|.
+// Other requests go to HandleBrowserRequest.  If the request asked the server
+// to shut down, |quit| is set and the caller is expected to close the
+// listening socket and all of |clients|.
+void HandleRequest(PeerChannel* clients, DataSocket* ds, bool* quit);
+
+#endif  // WEBRTC_EXAMPLES_PEERCONNECTION_SERVER_REQUEST_HANDLER_H_
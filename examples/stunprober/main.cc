@@ -15,6 +15,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "webrtc/base/checks.h"
 #include "webrtc/base/flags.h"
@@ -35,6 +36,9 @@ using stunprober::AsyncCallback;
 DEFINE_bool(help, false, "Prints this message");
 DEFINE_int(interval, 10, "Interval of consecutive stun pings in milliseconds");
 DEFINE_bool(shared_socket, false, "Share socket mode for different remote IPs");
+DEFINE_bool(batch,
+            false,
+            "Ping all servers at once every interval, in one batch per socket");
 DEFINE_int(pings_per_ip,
            10,
            "Number of consecutive stun pings to send for each IP");
@@ -63,6 +67,12 @@ const char* PrintNatType(stunprober::NatType type) {
   }
 }
 
+// Returns the |percentile|th percentile of the sorted, non-empty |values|.
+int GetPercentile(const std::vector<int>& values, int percentile) {
+  size_t index = (values.size() - 1) * percentile / 100;
+  return values[index];
+}
+
 void PrintStats(StunProber* prober) {
   StunProber::Stats stats;
   if (!prober->GetStats(&stats)) {
@@ -84,6 +94,13 @@ void PrintStats(StunProber* prober) {
 
   LOG(LS_INFO) << "Success Precent: " << stats.success_percent;
   LOG(LS_INFO) << "Response Latency:" << stats.average_rtt_ms;
+  if (!stats.rtts_us.empty()) {
+    const std::vector<int>& rtts = stats.rtts_us;
+    LOG(LS_INFO) << "Response Latency (us): min " << rtts.front() << ", p50 "
+                 << GetPercentile(rtts, 50) << ", p90 "
+                 << GetPercentile(rtts, 90) << ", p99 "
+                 << GetPercentile(rtts, 99) << ", max " << rtts.back();
+  }
 }
 
 void StopTrial(rtc::Thread* thread, StunProber* prober, int result) {
@@ -128,6 +145,7 @@ int main(int argc, char** argv) {
   network_manager->GetNetworks(&networks);
   StunProber* prober =
       new StunProber(socket_factory.get(), rtc::Thread::Current(), networks);
+  prober->set_batch_mode(FLAG_batch);
   auto finish_callback = [thread](StunProber* prober, int result) {
     StopTrial(thread, prober, result);
   };
@@ -21,6 +21,7 @@
 #include "webrtc/base/timeutils.h"
 #include "webrtc/call/call.h"
 #include "webrtc/logging/rtc_event_log/rtc_event_log_helper_thread.h"
+#include "webrtc/logging/rtc_event_log/rtp_packet_batch.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "webrtc/modules/rtp_rtcp/source/byte_io.h"
 #include "webrtc/modules/rtp_rtcp/source/rtcp_packet/app.h"
@@ -87,6 +88,10 @@ class RtcEventLogImpl final : public RtcEventLog {
   // Message queue for passing events to the logging thread.
   SwapQueue<std::unique_ptr<rtclog::Event> > event_queue_;
 
+  // Message queue for passing RTP packets to the logging thread. The records
+  // are preallocated, so logging a packet doesn't allocate memory.
+  SwapQueue<RtpPacketRecord> rtp_queue_;
+
   RtcEventLogHelperThread helper_thread_;
   rtc::ThreadChecker thread_checker_;
 
@@ -130,6 +135,7 @@ rtclog::MediaType ConvertMediaType(MediaType media_type) {
 // The RTP and RTCP buffers reserve space for twice the expected number of
 // sent packets because they also contain received packets.
 static const int kEventsPerSecond = 1000;
+static const int kRtpPacketsPerSecond = 2000;
 static const int kControlMessagesPerSecond = 10;
 }  // namespace
 
@@ -138,7 +144,8 @@ RtcEventLogImpl::RtcEventLogImpl()
     // Allocate buffers for roughly one second of history.
     : message_queue_(kControlMessagesPerSecond),
       event_queue_(kEventsPerSecond),
-      helper_thread_(&message_queue_, &event_queue_),
+      rtp_queue_(kRtpPacketsPerSecond),
+      helper_thread_(&message_queue_, &event_queue_, &rtp_queue_),
       thread_checker_() {
   thread_checker_.DetachFromThread();
 }
@@ -352,6 +359,22 @@ void RtcEventLogImpl::LogRtpHeader(PacketDirection direction,
     header_length += (x_len + 1) * 4;
   }
 
+  if (header_length <= RtpPacketRecord::kMaxHeaderSize) {
+    RtpPacketRecord record;
+    record.timestamp_us = rtc::TimeMicros();
+    record.incoming = direction == kIncomingPacket;
+    record.type = ConvertMediaType(media_type);
+    record.packet_length = static_cast<uint32_t>(packet_length);
+    record.header_length = header_length;
+    memcpy(record.header, header, header_length);
+    if (!rtp_queue_.Insert(&record)) {
+      LOG(LS_ERROR) << "WebRTC event log queue full. Dropping RTP packet.";
+    }
+    helper_thread_.SignalNewEvent();
+    return;
+  }
+
+  // Unusually long headers are logged as separate events.
   std::unique_ptr<rtclog::Event> rtp_event(new rtclog::Event());
   rtp_event->set_timestamp_us(rtc::TimeMicros());
   rtp_event->set_type(rtclog::Event::RTP_EVENT);
@@ -454,7 +477,24 @@ bool RtcEventLog::ParseRtcEventLog(const std::string& file_name,
     dump_buffer.append(tmp_buffer, bytes_read);
   }
   dump_file->CloseFile();
-  return result->ParseFromString(dump_buffer);
+  if (!result->ParseFromString(dump_buffer)) {
+    return false;
+  }
+  // Expand batches of RTP packets into one event per packet.
+  std::vector<rtclog::Event> events;
+  events.reserve(result->stream_size());
+  for (const rtclog::Event& event : result->stream()) {
+    if (event.type() != rtclog::Event::RTP_BATCH_EVENT) {
+      events.push_back(event);
+    } else if (!DecodeRtpPacketBatch(event, &events)) {
+      return false;
+    }
+  }
+  result->clear_stream();
+  for (rtclog::Event& event : events) {
+    result->add_stream()->Swap(&event);
+  }
+  return true;
 }
 
 #endif  // ENABLE_RTC_EVENT_LOG
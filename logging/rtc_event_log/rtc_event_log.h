@@ -120,6 +120,7 @@ class RtcEventLog {
   // The current implementation writes a LOG_START event, then the old
   // configurations, then the remaining events in timestamp order and finally
   // a LOG_END event. However, this might change without further notice.
+  // Batches of RTP packets are expanded into one RTP event per packet.
   // TODO(terelius): Change result type to a vector?
   static bool ParseRtcEventLog(const std::string& file_name,
                                rtclog::EventStream* result);
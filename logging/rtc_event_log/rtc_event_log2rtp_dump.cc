@@ -8,6 +8,8 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <string.h>
+
 #include <iostream>
 #include <memory>
 #include <sstream>
@@ -15,10 +17,7 @@
 
 #include "gflags/gflags.h"
 #include "webrtc/base/checks.h"
-#include "webrtc/call/call.h"
-#include "webrtc/logging/rtc_event_log/rtc_event_log.h"
-#include "webrtc/logging/rtc_event_log/rtc_event_log_parser.h"
-#include "webrtc/modules/rtp_rtcp/source/byte_io.h"
+#include "webrtc/logging/rtc_event_log/rtc_event_log_reader.h"
 #include "webrtc/test/rtp_file_writer.h"
 
 namespace {
@@ -89,9 +88,17 @@ int main(int argc, char* argv[]) {
     RTC_CHECK(ParseSsrc(FLAGS_ssrc, &ssrc_filter))
         << "Flag verification has failed.";
 
-  webrtc::ParsedRtcEventLog parsed_stream;
-  if (!parsed_stream.ParseFile(input_file)) {
-    std::cerr << "Error while parsing input file: " << input_file << std::endl;
+  // The log is read one event at a time, skipping the events that aren't
+  // needed, so that large logs don't have to fit in memory.
+  webrtc::RtcEventLogReader reader;
+  if (!FLAGS_nortp)
+    reader.AddEventType(webrtc::rtclog::Event::RTP_EVENT);
+  if (!FLAGS_nortcp)
+    reader.AddEventType(webrtc::rtclog::Event::RTCP_EVENT);
+  if (!FLAGS_ssrc.empty())
+    reader.AddSsrc(ssrc_filter);
+  if (!reader.OpenFile(input_file)) {
+    std::cerr << "Error while opening input file: " << input_file << std::endl;
     return -1;
   }
 
@@ -105,80 +112,69 @@ int main(int argc, char* argv[]) {
     return -1;
   }
 
-  std::cout << "Found " << parsed_stream.GetNumberOfEvents()
-            << " events in the input file." << std::endl;
   int rtp_counter = 0, rtcp_counter = 0;
   bool header_only = false;
-  for (size_t i = 0; i < parsed_stream.GetNumberOfEvents(); i++) {
-    // The parsed_stream will assert if the protobuf event is missing
-    // some required fields and we attempt to access them. We could consider
-    // a softer failure option, but it does not seem useful to generate
-    // RTP dumps based on broken event logs.
-    if (!FLAGS_nortp &&
-        parsed_stream.GetEventType(i) == webrtc::ParsedRtcEventLog::RTP_EVENT) {
-      webrtc::test::RtpPacket packet;
-      webrtc::PacketDirection direction;
-      webrtc::MediaType media_type;
-      parsed_stream.GetRtpHeader(i, &direction, &media_type, packet.data,
-                                 &packet.length, &packet.original_length);
+  webrtc::rtclog::Event event;
+  while (reader.Next(&event)) {
+    // We assert if the protobuf event is missing some required fields. We
+    // could consider a softer failure option, but it does not seem useful to
+    // generate RTP dumps based on broken event logs.
+    RTC_CHECK(event.has_timestamp_us());
+    webrtc::rtclog::MediaType media_type;
+    webrtc::test::RtpPacket packet;
+    if (!FLAGS_nortp && event.type() == webrtc::rtclog::Event::RTP_EVENT) {
+      const webrtc::rtclog::RtpPacket& rtp_packet = event.rtp_packet();
+      RTC_CHECK(rtp_packet.has_incoming());
+      RTC_CHECK(rtp_packet.has_type());
+      RTC_CHECK(rtp_packet.has_packet_length());
+      RTC_CHECK_LE(rtp_packet.header().size(), sizeof(packet.data));
+      // TODO(terelius): Maybe add a flag to dump outgoing traffic instead?
+      if (!rtp_packet.incoming())
+        continue;
+      media_type = rtp_packet.type();
+      packet.length = rtp_packet.header().size();
+      memcpy(packet.data, rtp_packet.header().data(), packet.length);
+      packet.original_length = rtp_packet.packet_length();
       if (packet.original_length > packet.length)
         header_only = true;
-      packet.time_ms = parsed_stream.GetTimestamp(i) / 1000;
-
+    } else if (!FLAGS_nortcp &&
+               event.type() == webrtc::rtclog::Event::RTCP_EVENT) {
+      const webrtc::rtclog::RtcpPacket& rtcp_packet = event.rtcp_packet();
+      RTC_CHECK(rtcp_packet.has_incoming());
+      RTC_CHECK(rtcp_packet.has_type());
+      RTC_CHECK_LE(rtcp_packet.packet_data().size(), sizeof(packet.data));
       // TODO(terelius): Maybe add a flag to dump outgoing traffic instead?
-      if (direction == webrtc::kOutgoingPacket)
+      if (!rtcp_packet.incoming())
         continue;
-      if (FLAGS_noaudio && media_type == webrtc::MediaType::AUDIO)
-        continue;
-      if (FLAGS_novideo && media_type == webrtc::MediaType::VIDEO)
-        continue;
-      if (FLAGS_nodata && media_type == webrtc::MediaType::DATA)
-        continue;
-      if (!FLAGS_ssrc.empty()) {
-        const uint32_t packet_ssrc =
-            webrtc::ByteReader<uint32_t>::ReadBigEndian(
-                reinterpret_cast<const uint8_t*>(packet.data + 8));
-        if (packet_ssrc != ssrc_filter)
-          continue;
-      }
-
-      rtp_writer->WritePacket(&packet);
-      rtp_counter++;
-    }
-    if (!FLAGS_nortcp &&
-        parsed_stream.GetEventType(i) ==
-            webrtc::ParsedRtcEventLog::RTCP_EVENT) {
-      webrtc::test::RtpPacket packet;
-      webrtc::PacketDirection direction;
-      webrtc::MediaType media_type;
-      parsed_stream.GetRtcpPacket(i, &direction, &media_type, packet.data,
-                                  &packet.length);
+      media_type = rtcp_packet.type();
+      packet.length = rtcp_packet.packet_data().size();
+      memcpy(packet.data, rtcp_packet.packet_data().data(), packet.length);
       // For RTCP packets the original_length should be set to 0 in the
       // RTPdump format.
       packet.original_length = 0;
-      packet.time_ms = parsed_stream.GetTimestamp(i) / 1000;
+    } else {
+      continue;
+    }
+    packet.time_ms = event.timestamp_us() / 1000;
 
-      // TODO(terelius): Maybe add a flag to dump outgoing traffic instead?
-      if (direction == webrtc::kOutgoingPacket)
-        continue;
-      if (FLAGS_noaudio && media_type == webrtc::MediaType::AUDIO)
-        continue;
-      if (FLAGS_novideo && media_type == webrtc::MediaType::VIDEO)
-        continue;
-      if (FLAGS_nodata && media_type == webrtc::MediaType::DATA)
-        continue;
-      if (!FLAGS_ssrc.empty()) {
-        const uint32_t packet_ssrc =
-            webrtc::ByteReader<uint32_t>::ReadBigEndian(
-                reinterpret_cast<const uint8_t*>(packet.data + 4));
-        if (packet_ssrc != ssrc_filter)
-          continue;
-      }
-
-      rtp_writer->WritePacket(&packet);
+    if (FLAGS_noaudio && media_type == webrtc::rtclog::AUDIO)
+      continue;
+    if (FLAGS_novideo && media_type == webrtc::rtclog::VIDEO)
+      continue;
+    if (FLAGS_nodata && media_type == webrtc::rtclog::DATA)
+      continue;
+
+    rtp_writer->WritePacket(&packet);
+    if (event.type() == webrtc::rtclog::Event::RTP_EVENT) {
+      rtp_counter++;
+    } else {
       rtcp_counter++;
     }
   }
+  if (reader.failed()) {
+    std::cerr << "Error while parsing input file: " << input_file << std::endl;
+    return -1;
+  }
   std::cout << "Wrote " << rtp_counter << (header_only ? " header-only" : "")
             << " RTP packets and " << rtcp_counter << " RTCP packets to the "
             << "output file." << std::endl;
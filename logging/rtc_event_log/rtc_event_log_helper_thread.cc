@@ -35,10 +35,13 @@ bool IsConfigEvent(const rtclog::Event& event) {
 // RtcEventLogImpl member functions.
 RtcEventLogHelperThread::RtcEventLogHelperThread(
     SwapQueue<ControlMessage>* message_queue,
-    SwapQueue<std::unique_ptr<rtclog::Event>>* event_queue)
+    SwapQueue<std::unique_ptr<rtclog::Event>>* event_queue,
+    SwapQueue<RtpPacketRecord>* rtp_queue)
     : message_queue_(message_queue),
       event_queue_(event_queue),
+      rtp_queue_(rtp_queue),
       history_(kEventsInHistory),
+      rtp_history_(kEventsInHistory),
       config_history_(),
       file_(FileWrapper::Create()),
       thread_(&ThreadOutputFunction, this, "RtcEventLog thread"),
@@ -48,12 +51,14 @@ RtcEventLogHelperThread::RtcEventLogHelperThread(
       stop_time_(std::numeric_limits<int64_t>::max()),
       has_recent_event_(false),
       most_recent_event_(),
+      has_recent_rtp_packet_(false),
       output_string_(),
       wake_periodically_(false, false),
       wake_from_hibernation_(false, false),
       file_finished_(false, false) {
   RTC_DCHECK(message_queue_);
   RTC_DCHECK(event_queue_);
+  RTC_DCHECK(rtp_queue_);
   thread_.Start();
 }
 
@@ -104,6 +109,34 @@ bool RtcEventLogHelperThread::AppendEventToString(rtclog::Event* event) {
   return stop;
 }
 
+bool RtcEventLogHelperThread::AppendRtpPacket(const RtpPacketRecord& packet) {
+  if (rtp_batch_.Add(packet)) {
+    return false;
+  }
+  bool stop = AppendRtpBatchToString();
+  if (!stop) {
+    // An empty batch has room for any packet.
+    bool added = rtp_batch_.Add(packet);
+    RTC_DCHECK(added);
+  }
+  return stop;
+}
+
+bool RtcEventLogHelperThread::AppendRtpBatchToString() {
+  if (rtp_batch_.empty()) {
+    return false;
+  }
+  bool stop = AppendEventToString(rtp_batch_.event());
+  rtp_batch_.Clear();
+  return stop;
+}
+
+bool RtcEventLogHelperThread::NextEventIsRtpPacket() const {
+  return has_recent_rtp_packet_ &&
+         (!has_recent_event_ || most_recent_rtp_packet_.timestamp_us <=
+                                    most_recent_event_->timestamp_us());
+}
+
 bool RtcEventLogHelperThread::LogToMemory() {
   RTC_DCHECK(!file_->is_open());
   bool message_received = false;
@@ -124,6 +157,15 @@ bool RtcEventLogHelperThread::LogToMemory() {
     has_recent_event_ = event_queue_->Remove(&most_recent_event_);
     message_received = true;
   }
+  if (!has_recent_rtp_packet_) {
+    has_recent_rtp_packet_ = rtp_queue_->Remove(&most_recent_rtp_packet_);
+  }
+  while (has_recent_rtp_packet_ &&
+         most_recent_rtp_packet_.timestamp_us <= current_time) {
+    rtp_history_.push_back(most_recent_rtp_packet_);
+    has_recent_rtp_packet_ = rtp_queue_->Remove(&most_recent_rtp_packet_);
+    message_received = true;
+  }
   return message_received;
 }
 
@@ -143,13 +185,26 @@ void RtcEventLogHelperThread::StartLogFile() {
     AppendEventToString(event.get());
   }
 
-  // Serialize the events in the event queue.
-  while (!history_.empty() && !stop) {
-    stop = AppendEventToString(history_.front().get());
-    if (!stop) {
-      history_.pop_front();
+  // Serialize the events in the histories in timestamp order.
+  while (!stop && (!history_.empty() || !rtp_history_.empty())) {
+    if (!rtp_history_.empty() &&
+        (history_.empty() || rtp_history_.front().timestamp_us <=
+                                 history_.front()->timestamp_us())) {
+      stop = AppendRtpPacket(rtp_history_.front());
+      rtp_history_.pop_front();
+    } else {
+      stop = AppendRtpBatchToString();
+      if (!stop) {
+        stop = AppendEventToString(history_.front().get());
+      }
+      if (!stop) {
+        history_.pop_front();
+      }
     }
   }
+  if (!stop) {
+    stop = AppendRtpBatchToString();
+  }
 
   // Write to file.
   if (!file_->Write(output_string_.data(), output_string_.size())) {
@@ -183,18 +238,38 @@ bool RtcEventLogHelperThread::LogToFile() {
   if (!has_recent_event_) {
     has_recent_event_ = event_queue_->Remove(&most_recent_event_);
   }
+  if (!has_recent_rtp_packet_) {
+    has_recent_rtp_packet_ = rtp_queue_->Remove(&most_recent_rtp_packet_);
+  }
   bool stop = false;
-  while (!stop && has_recent_event_ &&
-         most_recent_event_->timestamp_us() <= time_limit) {
-    stop = AppendEventToString(most_recent_event_.get());
-    if (!stop) {
-      if (IsConfigEvent(*most_recent_event_)) {
-        config_history_.push_back(std::move(most_recent_event_));
+  while (!stop) {
+    if (NextEventIsRtpPacket()) {
+      if (most_recent_rtp_packet_.timestamp_us > time_limit) {
+        break;
+      }
+      stop = AppendRtpPacket(most_recent_rtp_packet_);
+      has_recent_rtp_packet_ = rtp_queue_->Remove(&most_recent_rtp_packet_);
+    } else if (has_recent_event_ &&
+               most_recent_event_->timestamp_us() <= time_limit) {
+      // Write the pending RTP packets first to keep the timestamp order.
+      stop = AppendRtpBatchToString();
+      if (!stop) {
+        stop = AppendEventToString(most_recent_event_.get());
+      }
+      if (!stop) {
+        if (IsConfigEvent(*most_recent_event_)) {
+          config_history_.push_back(std::move(most_recent_event_));
+        }
+        has_recent_event_ = event_queue_->Remove(&most_recent_event_);
       }
-      has_recent_event_ = event_queue_->Remove(&most_recent_event_);
+    } else {
+      break;
     }
     message_received = true;
   }
+  if (!stop) {
+    stop = AppendRtpBatchToString();
+  }
 
   // Write string to file.
   if (!file_->Write(output_string_.data(), output_string_.size())) {
@@ -210,6 +285,8 @@ bool RtcEventLogHelperThread::LogToFile() {
   // time limit, or in other words if we have terminated the loop despite
   // having more events in the queue.
   if ((has_recent_event_ && most_recent_event_->timestamp_us() > stop_time_) ||
+      (has_recent_rtp_packet_ &&
+       most_recent_rtp_packet_.timestamp_us > stop_time_) ||
       stop) {
     RTC_DCHECK(file_->is_open());
     StopLogFile();
@@ -220,6 +297,7 @@ bool RtcEventLogHelperThread::LogToFile() {
 void RtcEventLogHelperThread::StopLogFile() {
   RTC_DCHECK(file_->is_open());
   output_string_.clear();
+  rtp_batch_.Clear();
 
   rtclog::Event end_event;
   // This function can be called either because we have reached the stop time,
@@ -23,6 +23,7 @@
 #include "webrtc/base/platform_thread.h"
 #include "webrtc/base/swap_queue.h"
 #include "webrtc/logging/rtc_event_log/ringbuffer.h"
+#include "webrtc/logging/rtc_event_log/rtp_packet_batch.h"
 #include "webrtc/system_wrappers/include/file_wrapper.h"
 
 #ifdef ENABLE_RTC_EVENT_LOG
@@ -68,7 +69,8 @@ class RtcEventLogHelperThread final {
 
   RtcEventLogHelperThread(
       SwapQueue<ControlMessage>* message_queue,
-      SwapQueue<std::unique_ptr<rtclog::Event>>* event_queue);
+      SwapQueue<std::unique_ptr<rtclog::Event>>* event_queue,
+      SwapQueue<RtpPacketRecord>* rtp_queue);
   ~RtcEventLogHelperThread();
 
   // This function MUST be called once a STOP_FILE message is added to the
@@ -84,6 +86,15 @@ class RtcEventLogHelperThread final {
   static bool ThreadOutputFunction(void* obj);
 
   bool AppendEventToString(rtclog::Event* event);
+  // Adds |packet| to |rtp_batch_|, first appending the batch to the output
+  // string if it is full. Returns true if the file size limit is reached.
+  bool AppendRtpPacket(const RtpPacketRecord& packet);
+  // Appends |rtp_batch_| to the output string, unless it is empty, and
+  // starts a new batch. Returns true if the file size limit is reached.
+  bool AppendRtpBatchToString();
+  // Returns true if the next event to log is the RTP packet in
+  // |most_recent_rtp_packet_|.
+  bool NextEventIsRtpPacket() const;
   bool LogToMemory();
   void StartLogFile();
   bool LogToFile();
@@ -93,9 +104,11 @@ class RtcEventLogHelperThread final {
   // Message queues for passing events to the logging thread.
   SwapQueue<ControlMessage>* message_queue_;
   SwapQueue<std::unique_ptr<rtclog::Event>>* event_queue_;
+  SwapQueue<RtpPacketRecord>* rtp_queue_;
 
   // History containing the most recent events (~ 10 s).
   RingBuffer<std::unique_ptr<rtclog::Event>> history_;
+  RingBuffer<RtpPacketRecord> rtp_history_;
 
   // History containing all past configuration events.
   std::vector<std::unique_ptr<rtclog::Event>> config_history_;
@@ -110,6 +123,11 @@ class RtcEventLogHelperThread final {
 
   bool has_recent_event_;
   std::unique_ptr<rtclog::Event> most_recent_event_;
+  bool has_recent_rtp_packet_;
+  RtpPacketRecord most_recent_rtp_packet_;
+
+  // RTP packets are written in batches, see RtpPacketBatchEncoder.
+  RtpPacketBatchEncoder rtp_batch_;
 
   // Temporary space for serializing profobuf data.
   std::string output_string_;
@@ -20,6 +20,7 @@
 #include "webrtc/base/logging.h"
 #include "webrtc/call/call.h"
 #include "webrtc/logging/rtc_event_log/rtc_event_log.h"
+#include "webrtc/logging/rtc_event_log/rtp_packet_batch.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "webrtc/system_wrappers/include/file_wrapper.h"
 
@@ -79,6 +80,9 @@ ParsedRtcEventLog::EventType GetRuntimeEventType(
       return ParsedRtcEventLog::EventType::AUDIO_RECEIVER_CONFIG_EVENT;
     case rtclog::Event::AUDIO_SENDER_CONFIG_EVENT:
       return ParsedRtcEventLog::EventType::AUDIO_SENDER_CONFIG_EVENT;
+    case rtclog::Event::RTP_BATCH_EVENT:
+      // Batches are expanded into RTP events when the log is parsed.
+      break;
   }
   RTC_NOTREACHED();
   return ParsedRtcEventLog::EventType::UNKNOWN_EVENT;
@@ -188,6 +192,13 @@ bool ParsedRtcEventLog::ParseStream(std::istream& stream) {
       LOG(LS_WARNING) << "Failed to parse protobuf message.";
       return false;
     }
+    if (event.type() == rtclog::Event::RTP_BATCH_EVENT) {
+      if (!DecodeRtpPacketBatch(event, &events_)) {
+        LOG(LS_WARNING) << "Failed to decode RTP packet batch.";
+        return false;
+      }
+      continue;
+    }
     events_.push_back(event);
   }
 }
@@ -31,6 +31,9 @@ namespace webrtc {
 
 enum class MediaType;
 
+// Parses a whole RtcEventLog into memory, for random access to its events.
+// Tools that read the events in order should use RtcEventLogReader, which
+// doesn't need memory for more than one event at a time.
 class ParsedRtcEventLog {
   friend class RtcEventLogTestHelper;
 
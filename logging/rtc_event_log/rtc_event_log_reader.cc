@@ -0,0 +1,378 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/logging/rtc_event_log/rtc_event_log_reader.h"
+
+#if defined(WEBRTC_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <sstream>
+#endif
+
+#include "webrtc/base/logging.h"
+#include "webrtc/logging/rtc_event_log/rtp_packet_batch.h"
+
+namespace webrtc {
+
+namespace {
+
+enum WireType {
+  kVarint = 0,
+  kFixed64 = 1,
+  kLengthDelimited = 2,
+  kFixed32 = 5,
+};
+
+// Field numbers of the messages in rtc_event_log.proto that the filters look
+// at.
+const int kEventStreamEventField = 1;
+const int kEventTypeField = 2;
+const int kEventRtpPacketField = 3;
+const int kEventRtcpPacketField = 4;
+const int kEventAudioPlayoutField = 5;
+const int kEventRtpPacketBatchField = 12;
+const int kRtpPacketHeaderField = 4;
+const int kRtcpPacketDataField = 3;
+const int kAudioPlayoutLocalSsrcField = 2;
+const int kRtpPacketBatchSsrcsField = 5;
+
+uint32_t ReadUint32(const uint8_t* data) {
+  return (static_cast<uint32_t>(data[0]) << 24) | (data[1] << 16) |
+         (data[2] << 8) | data[3];
+}
+
+uint32_t ReadLittleEndianUint32(const uint8_t* data) {
+  return (static_cast<uint32_t>(data[3]) << 24) | (data[2] << 16) |
+         (data[1] << 8) | data[0];
+}
+
+// Reads the protobuf wire format one field at a time, so that a few fields of
+// a message can be looked at without decoding all of it.
+class WireReader {
+ public:
+  WireReader(const uint8_t* data, size_t size)
+      : start_(data),
+        data_(data),
+        end_(data + size),
+        field_number_(0),
+        wire_type_(0),
+        value_(0),
+        field_data_(nullptr) {}
+
+  // Moves to the next field. Returns false at the end of the message or if
+  // the message is malformed.
+  bool NextField() {
+    uint64_t tag;
+    if (!ReadVarint(&tag))
+      return false;
+    field_number_ = static_cast<int>(tag >> 3);
+    wire_type_ = static_cast<int>(tag & 7);
+    field_data_ = data_;
+    switch (wire_type_) {
+      case kVarint:
+        return ReadVarint(&value_);
+      case kFixed64:
+        value_ = 8;
+        break;
+      case kLengthDelimited:
+        if (!ReadVarint(&value_))
+          return false;
+        field_data_ = data_;
+        break;
+      case kFixed32:
+        value_ = 4;
+        break;
+      default:
+        // Groups aren't used by rtc_event_log.proto.
+        return false;
+    }
+    if (value_ > static_cast<uint64_t>(end_ - data_))
+      return false;
+    data_ += value_;
+    return true;
+  }
+
+  int field_number() const { return field_number_; }
+  int wire_type() const { return wire_type_; }
+  // The value of a varint field.
+  uint64_t varint() const { return value_; }
+  // The contents of a length delimited or fixed size field.
+  const uint8_t* field_data() const { return field_data_; }
+  size_t field_size() const { return static_cast<size_t>(value_); }
+
+  // The number of bytes read so far.
+  size_t bytes_read() const { return data_ - start_; }
+
+ private:
+  bool ReadVarint(uint64_t* value) {
+    *value = 0;
+    for (int shift = 0; shift < 64 && data_ < end_; shift += 7) {
+      uint8_t byte = *data_++;
+      *value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+        return true;
+    }
+    return false;
+  }
+
+  const uint8_t* const start_;
+  const uint8_t* data_;
+  const uint8_t* const end_;
+  int field_number_;
+  int wire_type_;
+  uint64_t value_;
+  const uint8_t* field_data_;
+};
+
+// Returns the contents of the last occurrence of the length delimited field
+// |field_number| in the message |data|, which is how protobuf resolves
+// repeated occurrences of a non-repeated field.
+bool FindBytesField(const uint8_t* data,
+                    size_t size,
+                    int field_number,
+                    const uint8_t** field_data,
+                    size_t* field_size) {
+  WireReader reader(data, size);
+  bool found = false;
+  while (reader.NextField()) {
+    if (reader.field_number() == field_number &&
+        reader.wire_type() == kLengthDelimited) {
+      *field_data = reader.field_data();
+      *field_size = reader.field_size();
+      found = true;
+    }
+  }
+  return found;
+}
+
+}  // namespace
+
+RtcEventLogReader::RtcEventLogReader()
+    : data_(nullptr),
+      size_(0),
+      position_(0),
+      mapped_data_(nullptr),
+      mapped_size_(0),
+      batch_index_(0),
+      failed_(false) {}
+
+RtcEventLogReader::~RtcEventLogReader() {
+  Close();
+}
+
+bool RtcEventLogReader::OpenFile(const std::string& file_name) {
+  Close();
+#if defined(WEBRTC_POSIX)
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG(LS_WARNING) << "Could not open file for reading.";
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0) {
+    LOG(LS_WARNING) << "Could not get the size of the file.";
+    close(fd);
+    return false;
+  }
+  size_t size = static_cast<size_t>(file_stat.st_size);
+  if (size > 0) {
+    void* mapped_data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped_data == MAP_FAILED) {
+      LOG(LS_WARNING) << "Could not map file into memory.";
+      close(fd);
+      return false;
+    }
+    // The events are read once, front to back.
+    madvise(mapped_data, size, MADV_SEQUENTIAL);
+    mapped_data_ = mapped_data;
+    mapped_size_ = size;
+  }
+  // The mapping stays valid after the file is closed.
+  close(fd);
+  data_ = static_cast<const uint8_t*>(mapped_data_);
+  size_ = mapped_size_;
+#else
+  std::ifstream file(file_name, std::ios_base::in | std::ios_base::binary);
+  if (!file.good() || !file.is_open()) {
+    LOG(LS_WARNING) << "Could not open file for reading.";
+    return false;
+  }
+  std::ostringstream contents;
+  contents << file.rdbuf();
+  file_contents_ = contents.str();
+  data_ = reinterpret_cast<const uint8_t*>(file_contents_.data());
+  size_ = file_contents_.size();
+#endif
+  return true;
+}
+
+void RtcEventLogReader::OpenBuffer(const uint8_t* data, size_t size) {
+  Close();
+  data_ = data;
+  size_ = size;
+}
+
+void RtcEventLogReader::AddEventType(rtclog::Event::EventType type) {
+  event_types_.insert(type);
+}
+
+void RtcEventLogReader::AddSsrc(uint32_t ssrc) {
+  ssrcs_.insert(ssrc);
+}
+
+bool RtcEventLogReader::Next(rtclog::Event* event) {
+  while (true) {
+    while (batch_index_ < batch_events_.size()) {
+      rtclog::Event& packet = batch_events_[batch_index_++];
+      const uint8_t* header = reinterpret_cast<const uint8_t*>(
+          packet.rtp_packet().header().data());
+      if (PassesSsrcFilter(ReadUint32(header + 8))) {
+        event->Swap(&packet);
+        return true;
+      }
+    }
+    batch_events_.clear();
+    batch_index_ = 0;
+
+    if (position_ == size_)
+      return false;
+
+    // The log is a sequence of length delimited events, each of which looks
+    // like an EventStream with a single event.
+    WireReader reader(data_ + position_, size_ - position_);
+    if (!reader.NextField() ||
+        reader.field_number() != kEventStreamEventField ||
+        reader.wire_type() != kLengthDelimited) {
+      Fail("Unexpected field tag at beginning of protobuf event.");
+      return false;
+    }
+    const uint8_t* event_data = reader.field_data();
+    const size_t event_size = reader.field_size();
+    position_ += reader.bytes_read();
+
+    if (!MaybePassesFilters(event_data, event_size))
+      continue;
+    if (!event->ParseFromArray(event_data, static_cast<int>(event_size))) {
+      Fail("Failed to parse protobuf message.");
+      return false;
+    }
+    if (event->type() != rtclog::Event::RTP_BATCH_EVENT)
+      return true;
+    if (!DecodeRtpPacketBatch(*event, &batch_events_)) {
+      Fail("Failed to decode RTP packet batch.");
+      return false;
+    }
+  }
+}
+
+void RtcEventLogReader::Close() {
+#if defined(WEBRTC_POSIX)
+  if (mapped_data_)
+    munmap(mapped_data_, mapped_size_);
+#endif
+  mapped_data_ = nullptr;
+  mapped_size_ = 0;
+  file_contents_.clear();
+  data_ = nullptr;
+  size_ = 0;
+  position_ = 0;
+  batch_events_.clear();
+  batch_index_ = 0;
+  failed_ = false;
+}
+
+bool RtcEventLogReader::MaybePassesFilters(const uint8_t* event,
+                                           size_t size) const {
+  if (event_types_.empty() && ssrcs_.empty())
+    return true;
+
+  int type = rtclog::Event::UNKNOWN_EVENT;
+  bool has_ssrc = false;
+  bool ssrc_passes = false;
+  const uint8_t* data;
+  size_t data_size;
+  WireReader reader(event, size);
+  while (reader.NextField()) {
+    const int field_number = reader.field_number();
+    if (field_number == kEventTypeField && reader.wire_type() == kVarint) {
+      type = static_cast<int>(reader.varint());
+      continue;
+    }
+    if (ssrcs_.empty() || reader.wire_type() != kLengthDelimited)
+      continue;
+    if (field_number == kEventRtpPacketField) {
+      if (FindBytesField(reader.field_data(), reader.field_size(),
+                         kRtpPacketHeaderField, &data, &data_size) &&
+          data_size >= 12) {
+        has_ssrc = true;
+        ssrc_passes = PassesSsrcFilter(ReadUint32(data + 8));
+      }
+    } else if (field_number == kEventRtcpPacketField) {
+      if (FindBytesField(reader.field_data(), reader.field_size(),
+                         kRtcpPacketDataField, &data, &data_size) &&
+          data_size >= 8) {
+        has_ssrc = true;
+        ssrc_passes = PassesSsrcFilter(ReadUint32(data + 4));
+      }
+    } else if (field_number == kEventAudioPlayoutField) {
+      WireReader playout(reader.field_data(), reader.field_size());
+      while (playout.NextField()) {
+        if (playout.field_number() == kAudioPlayoutLocalSsrcField &&
+            playout.wire_type() == kVarint) {
+          has_ssrc = true;
+          ssrc_passes =
+              PassesSsrcFilter(static_cast<uint32_t>(playout.varint()));
+        }
+      }
+    } else if (field_number == kEventRtpPacketBatchField) {
+      // The batch is skipped if none of its SSRCs pass. Otherwise, its
+      // packets are filtered one by one once it has been decoded.
+      WireReader batch(reader.field_data(), reader.field_size());
+      while (batch.NextField()) {
+        if (batch.field_number() != kRtpPacketBatchSsrcsField)
+          continue;
+        has_ssrc = true;
+        if (batch.wire_type() == kFixed32) {
+          ssrc_passes |= PassesSsrcFilter(
+              ReadLittleEndianUint32(batch.field_data()));
+        } else if (batch.wire_type() == kLengthDelimited) {
+          for (size_t i = 0; i + 4 <= batch.field_size(); i += 4) {
+            ssrc_passes |= PassesSsrcFilter(
+                ReadLittleEndianUint32(batch.field_data() + i));
+          }
+        }
+      }
+    }
+  }
+
+  if (!event_types_.empty()) {
+    if (type == rtclog::Event::RTP_BATCH_EVENT)
+      type = rtclog::Event::RTP_EVENT;
+    if (event_types_.count(type) == 0)
+      return false;
+  }
+  return !has_ssrc || ssrc_passes;
+}
+
+bool RtcEventLogReader::PassesSsrcFilter(uint32_t ssrc) const {
+  return ssrcs_.empty() || ssrcs_.count(ssrc) > 0;
+}
+
+void RtcEventLogReader::Fail(const char* reason) {
+  LOG(LS_WARNING) << reason;
+  failed_ = true;
+  position_ = size_;
+}
+
+}  // namespace webrtc
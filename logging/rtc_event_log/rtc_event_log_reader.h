@@ -0,0 +1,110 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_LOGGING_RTC_EVENT_LOG_RTC_EVENT_LOG_READER_H_
+#define WEBRTC_LOGGING_RTC_EVENT_LOG_RTC_EVENT_LOG_READER_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/ignore_wundef.h"
+
+// Files generated at build-time by the protobuf compiler.
+RTC_PUSH_IGNORING_WUNDEF()
+#ifdef WEBRTC_ANDROID_PLATFORM_BUILD
+#include "external/webrtc/webrtc/logging/rtc_event_log/rtc_event_log.pb.h"
+#else
+#include "webrtc/logging/rtc_event_log/rtc_event_log.pb.h"
+#endif
+RTC_POP_IGNORING_WUNDEF()
+
+namespace webrtc {
+
+// Reads the events of an RtcEventLog one at a time. Unlike ParsedRtcEventLog,
+// the memory used doesn't grow with the size of the log: the file is mapped
+// into memory and every event is decoded only when it is read. Events that
+// don't pass the filters are skipped without being decoded. Batches of RTP
+// packets are returned as one RTP_EVENT per packet.
+//
+// Example:
+//   RtcEventLogReader reader;
+//   reader.AddEventType(rtclog::Event::RTP_EVENT);
+//   if (!reader.OpenFile(file_name))
+//     return;
+//   rtclog::Event event;
+//   while (reader.Next(&event))
+//     HandleRtpPacket(event.rtp_packet());
+//   if (reader.failed())
+//     ...
+class RtcEventLogReader {
+ public:
+  RtcEventLogReader();
+  ~RtcEventLogReader();
+
+  // Maps |file_name| into memory and starts reading at its first event.
+  // Returns false if the file can't be read.
+  bool OpenFile(const std::string& file_name);
+  // Starts reading the log in |data|, which must outlive the reader or the
+  // next call to OpenFile or OpenBuffer.
+  void OpenBuffer(const uint8_t* data, size_t size);
+
+  // Makes Next return events of |type|, which can be called several times to
+  // add more types. All events are returned if it is never called.
+  void AddEventType(rtclog::Event::EventType type);
+  // Makes Next return RTP, RTCP and audio playout events only if they belong
+  // to |ssrc|, which can be called several times to add more SSRCs. RTCP
+  // packets belong to the SSRC of their sender. Events of other types aren't
+  // filtered by SSRC.
+  void AddSsrc(uint32_t ssrc);
+
+  // Decodes the next event that passes the filters into |event|. Returns
+  // false at the end of the log or if the log is malformed, see failed().
+  bool Next(rtclog::Event* event);
+
+  // True if reading stopped at a malformed event.
+  bool failed() const { return failed_; }
+
+ private:
+  void Close();
+  // Returns false if |event| certainly doesn't pass the filters. Only reads
+  // the few fields it needs from the wire format.
+  bool MaybePassesFilters(const uint8_t* event, size_t size) const;
+  bool PassesSsrcFilter(uint32_t ssrc) const;
+  void Fail(const char* reason);
+
+  const uint8_t* data_;
+  size_t size_;
+  size_t position_;
+  // The memory mapping of the file, if any.
+  void* mapped_data_;
+  size_t mapped_size_;
+  // The file contents, on platforms where it can't be mapped.
+  std::string file_contents_;
+
+  std::set<int> event_types_;
+  std::set<uint32_t> ssrcs_;
+
+  // Events expanded from the current RTP packet batch.
+  std::vector<rtclog::Event> batch_events_;
+  size_t batch_index_;
+
+  bool failed_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(RtcEventLogReader);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_LOGGING_RTC_EVENT_LOG_RTC_EVENT_LOG_READER_H_
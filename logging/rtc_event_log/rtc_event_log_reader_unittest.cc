@@ -0,0 +1,252 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "webrtc/logging/rtc_event_log/rtc_event_log_reader.h"
+#include "webrtc/logging/rtc_event_log/rtp_packet_batch.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/fileutils.h"
+
+namespace webrtc {
+
+namespace {
+
+const uint32_t kSsrc1 = 0x11111111;
+const uint32_t kSsrc2 = 0x22222222;
+
+void WriteUint32(uint32_t value, uint8_t* data) {
+  data[0] = static_cast<uint8_t>(value >> 24);
+  data[1] = static_cast<uint8_t>(value >> 16);
+  data[2] = static_cast<uint8_t>(value >> 8);
+  data[3] = static_cast<uint8_t>(value);
+}
+
+uint32_t ReadUint32(const std::string& data, size_t offset) {
+  const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.data());
+  return (static_cast<uint32_t>(bytes[offset]) << 24) |
+         (bytes[offset + 1] << 16) | (bytes[offset + 2] << 8) |
+         bytes[offset + 3];
+}
+
+// Builds a log the way RtcEventLogHelperThread writes it, one EventStream per
+// event.
+class LogBuilder {
+ public:
+  void AddRtpPacket(int64_t timestamp_us, uint32_t ssrc) {
+    rtclog::Event event;
+    event.set_timestamp_us(timestamp_us);
+    event.set_type(rtclog::Event::RTP_EVENT);
+    event.mutable_rtp_packet()->set_incoming(true);
+    event.mutable_rtp_packet()->set_type(rtclog::VIDEO);
+    event.mutable_rtp_packet()->set_packet_length(1000);
+    uint8_t header[12] = {0x80, 96};
+    WriteUint32(ssrc, header + 8);
+    event.mutable_rtp_packet()->set_header(header, sizeof(header));
+    Add(&event);
+  }
+
+  void AddRtpPacketBatch(int64_t timestamp_us,
+                         const std::vector<uint32_t>& ssrcs) {
+    RtpPacketBatchEncoder encoder;
+    for (size_t i = 0; i < ssrcs.size(); ++i) {
+      RtpPacketRecord packet;
+      memset(&packet, 0, sizeof(packet));
+      packet.timestamp_us = timestamp_us + static_cast<int64_t>(i);
+      packet.type = rtclog::AUDIO;
+      packet.packet_length = 200;
+      packet.header_length = 12;
+      packet.header[0] = 0x80;
+      packet.header[3] = static_cast<uint8_t>(i);
+      WriteUint32(ssrcs[i], packet.header + 8);
+      EXPECT_TRUE(encoder.Add(packet));
+    }
+    Add(encoder.event());
+  }
+
+  void AddRtcpPacket(int64_t timestamp_us, uint32_t sender_ssrc) {
+    rtclog::Event event;
+    event.set_timestamp_us(timestamp_us);
+    event.set_type(rtclog::Event::RTCP_EVENT);
+    event.mutable_rtcp_packet()->set_incoming(false);
+    event.mutable_rtcp_packet()->set_type(rtclog::VIDEO);
+    uint8_t packet[8] = {0x80, 201, 0, 1};
+    WriteUint32(sender_ssrc, packet + 4);
+    event.mutable_rtcp_packet()->set_packet_data(packet, sizeof(packet));
+    Add(&event);
+  }
+
+  void AddAudioPlayout(int64_t timestamp_us, uint32_t ssrc) {
+    rtclog::Event event;
+    event.set_timestamp_us(timestamp_us);
+    event.set_type(rtclog::Event::AUDIO_PLAYOUT_EVENT);
+    event.mutable_audio_playout_event()->set_local_ssrc(ssrc);
+    Add(&event);
+  }
+
+  void AddBweEvent(int64_t timestamp_us) {
+    rtclog::Event event;
+    event.set_timestamp_us(timestamp_us);
+    event.set_type(rtclog::Event::BWE_PACKET_LOSS_EVENT);
+    event.mutable_bwe_packet_loss_event()->set_bitrate(300000);
+    event.mutable_bwe_packet_loss_event()->set_fraction_loss(0);
+    event.mutable_bwe_packet_loss_event()->set_total_packets(10);
+    Add(&event);
+  }
+
+  const std::string& log() const { return log_; }
+  const uint8_t* data() const {
+    return reinterpret_cast<const uint8_t*>(log_.data());
+  }
+  size_t size() const { return log_.size(); }
+
+ private:
+  void Add(rtclog::Event* event) {
+    rtclog::EventStream stream;
+    *stream.add_stream() = *event;
+    stream.AppendToString(&log_);
+  }
+
+  std::string log_;
+};
+
+// Builds a log with events of all the types the reader filters.
+void BuildLog(LogBuilder* builder) {
+  builder->AddRtpPacket(1, kSsrc1);
+  builder->AddRtcpPacket(2, kSsrc2);
+  builder->AddRtpPacketBatch(3, {kSsrc2, kSsrc1, kSsrc2});
+  builder->AddAudioPlayout(6, kSsrc2);
+  builder->AddBweEvent(7);
+  builder->AddRtpPacket(8, kSsrc2);
+  builder->AddRtcpPacket(9, kSsrc1);
+}
+
+std::vector<int64_t> ReadTimestamps(RtcEventLogReader* reader) {
+  std::vector<int64_t> timestamps;
+  rtclog::Event event;
+  while (reader->Next(&event))
+    timestamps.push_back(event.timestamp_us());
+  EXPECT_FALSE(reader->failed());
+  return timestamps;
+}
+
+}  // namespace
+
+TEST(RtcEventLogReaderTest, ReadsAllEvents) {
+  LogBuilder builder;
+  BuildLog(&builder);
+  RtcEventLogReader reader;
+  reader.OpenBuffer(builder.data(), builder.size());
+
+  rtclog::Event event;
+  ASSERT_TRUE(reader.Next(&event));
+  EXPECT_EQ(rtclog::Event::RTP_EVENT, event.type());
+  EXPECT_EQ(kSsrc1, ReadUint32(event.rtp_packet().header(), 8));
+  ASSERT_TRUE(reader.Next(&event));
+  EXPECT_EQ(rtclog::Event::RTCP_EVENT, event.type());
+  // The batch is expanded into one event per packet.
+  for (int64_t timestamp_us = 3; timestamp_us < 6; ++timestamp_us) {
+    ASSERT_TRUE(reader.Next(&event));
+    EXPECT_EQ(rtclog::Event::RTP_EVENT, event.type());
+    EXPECT_EQ(timestamp_us, event.timestamp_us());
+    EXPECT_EQ(rtclog::AUDIO, event.rtp_packet().type());
+  }
+  ASSERT_TRUE(reader.Next(&event));
+  EXPECT_EQ(rtclog::Event::AUDIO_PLAYOUT_EVENT, event.type());
+  ASSERT_TRUE(reader.Next(&event));
+  EXPECT_EQ(rtclog::Event::BWE_PACKET_LOSS_EVENT, event.type());
+  EXPECT_EQ(300000, event.bwe_packet_loss_event().bitrate());
+  ASSERT_TRUE(reader.Next(&event));
+  EXPECT_EQ(8, event.timestamp_us());
+  ASSERT_TRUE(reader.Next(&event));
+  EXPECT_EQ(9, event.timestamp_us());
+  EXPECT_FALSE(reader.Next(&event));
+  EXPECT_FALSE(reader.failed());
+}
+
+TEST(RtcEventLogReaderTest, FiltersByEventType) {
+  LogBuilder builder;
+  BuildLog(&builder);
+  RtcEventLogReader reader;
+  reader.AddEventType(rtclog::Event::RTP_EVENT);
+  reader.AddEventType(rtclog::Event::BWE_PACKET_LOSS_EVENT);
+  reader.OpenBuffer(builder.data(), builder.size());
+  EXPECT_EQ(std::vector<int64_t>({1, 3, 4, 5, 7, 8}), ReadTimestamps(&reader));
+}
+
+TEST(RtcEventLogReaderTest, FiltersBySsrc) {
+  LogBuilder builder;
+  BuildLog(&builder);
+  RtcEventLogReader reader;
+  reader.AddSsrc(kSsrc1);
+  reader.OpenBuffer(builder.data(), builder.size());
+  // Events without an SSRC, like BWE updates, aren't filtered.
+  EXPECT_EQ(std::vector<int64_t>({1, 4, 7, 9}), ReadTimestamps(&reader));
+}
+
+TEST(RtcEventLogReaderTest, FiltersByEventTypeAndSsrc) {
+  LogBuilder builder;
+  BuildLog(&builder);
+  RtcEventLogReader reader;
+  reader.AddEventType(rtclog::Event::RTP_EVENT);
+  reader.AddEventType(rtclog::Event::AUDIO_PLAYOUT_EVENT);
+  reader.AddSsrc(kSsrc2);
+  reader.OpenBuffer(builder.data(), builder.size());
+  EXPECT_EQ(std::vector<int64_t>({3, 5, 6, 8}), ReadTimestamps(&reader));
+}
+
+TEST(RtcEventLogReaderTest, StopsAtMalformedEvent) {
+  LogBuilder builder;
+  builder.AddRtpPacket(1, kSsrc1);
+  builder.AddRtpPacket(2, kSsrc1);
+  RtcEventLogReader reader;
+  // Truncate the last event.
+  reader.OpenBuffer(builder.data(), builder.size() - 1);
+
+  rtclog::Event event;
+  EXPECT_TRUE(reader.Next(&event));
+  EXPECT_FALSE(reader.Next(&event));
+  EXPECT_TRUE(reader.failed());
+  EXPECT_FALSE(reader.Next(&event));
+}
+
+TEST(RtcEventLogReaderTest, ReadsFile) {
+  LogBuilder builder;
+  BuildLog(&builder);
+  const std::string file_name =
+      test::TempFilename(test::OutputPath(), "rtc_event_log_reader");
+  FILE* file = fopen(file_name.c_str(), "wb");
+  ASSERT_TRUE(file);
+  ASSERT_EQ(builder.size(), fwrite(builder.data(), 1, builder.size(), file));
+  fclose(file);
+
+  RtcEventLogReader reader;
+  reader.AddSsrc(kSsrc2);
+  ASSERT_TRUE(reader.OpenFile(file_name));
+  EXPECT_EQ(std::vector<int64_t>({2, 3, 5, 6, 7, 8}),
+            ReadTimestamps(&reader));
+  remove(file_name.c_str());
+
+  EXPECT_FALSE(reader.OpenFile(file_name));
+}
+
+TEST(RtcEventLogReaderTest, ReadsEmptyLog) {
+  RtcEventLogReader reader;
+  reader.OpenBuffer(nullptr, 0);
+  rtclog::Event event;
+  EXPECT_FALSE(reader.Next(&event));
+  EXPECT_FALSE(reader.failed());
+}
+
+}  // namespace webrtc
@@ -0,0 +1,178 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/logging/rtc_event_log/rtp_packet_batch.h"
+
+#include <string>
+#include <utility>
+
+#include "webrtc/base/checks.h"
+
+namespace webrtc {
+
+namespace {
+const size_t kFixedHeaderSize = 12;
+
+uint16_t ReadUint16(const uint8_t* data) {
+  return (data[0] << 8) | data[1];
+}
+
+uint32_t ReadUint32(const uint8_t* data) {
+  return (static_cast<uint32_t>(data[0]) << 24) | (data[1] << 16) |
+         (data[2] << 8) | data[3];
+}
+
+void WriteUint16(uint16_t value, uint8_t* data) {
+  data[0] = static_cast<uint8_t>(value >> 8);
+  data[1] = static_cast<uint8_t>(value);
+}
+
+void WriteUint32(uint32_t value, uint8_t* data) {
+  data[0] = static_cast<uint8_t>(value >> 24);
+  data[1] = static_cast<uint8_t>(value >> 16);
+  data[2] = static_cast<uint8_t>(value >> 8);
+  data[3] = static_cast<uint8_t>(value);
+}
+}  // namespace
+
+const size_t RtpPacketRecord::kMaxHeaderSize;
+const size_t RtpPacketBatchEncoder::kMaxPackets;
+const size_t RtpPacketBatchEncoder::kMaxHeaderTailBytes;
+
+RtpPacketBatchEncoder::RtpPacketBatchEncoder()
+    : num_packets_(0), last_timestamp_us_(0) {}
+
+RtpPacketBatchEncoder::~RtpPacketBatchEncoder() {}
+
+bool RtpPacketBatchEncoder::Add(const RtpPacketRecord& packet) {
+  RTC_DCHECK_GE(packet.header_length, kFixedHeaderSize);
+  RTC_DCHECK_LE(packet.header_length, RtpPacketRecord::kMaxHeaderSize);
+  const size_t tail_length = packet.header_length - kFixedHeaderSize;
+  rtclog::RtpPacketBatch* batch = event_.mutable_rtp_packet_batch();
+  if (num_packets_ >= kMaxPackets ||
+      batch->header_tails().size() + tail_length > kMaxHeaderTailBytes) {
+    return false;
+  }
+
+  if (num_packets_ == 0) {
+    event_.set_timestamp_us(packet.timestamp_us);
+    event_.set_type(rtclog::Event::RTP_BATCH_EVENT);
+    last_timestamp_us_ = packet.timestamp_us;
+  }
+  batch->add_timestamp_deltas_us(packet.timestamp_us - last_timestamp_us_);
+  last_timestamp_us_ = packet.timestamp_us;
+
+  batch->add_info((static_cast<uint32_t>(packet.type) << 1) |
+                  (packet.incoming ? 1 : 0));
+  batch->add_packet_length(packet.packet_length);
+  batch->add_first_bytes(ReadUint16(packet.header));
+
+  const uint16_t sequence_number = ReadUint16(packet.header + 2);
+  const uint32_t rtp_timestamp = ReadUint32(packet.header + 4);
+  const uint32_t ssrc = ReadUint32(packet.header + 8);
+  size_t index = 0;
+  while (index < ssrcs_.size() && ssrcs_[index].ssrc != ssrc)
+    ++index;
+  if (index == ssrcs_.size()) {
+    ssrcs_.push_back(SsrcState{ssrc, 0, 0});
+    batch->add_ssrcs(ssrc);
+  }
+  SsrcState& state = ssrcs_[index];
+  batch->add_ssrc_index(static_cast<uint32_t>(index));
+  batch->add_sequence_number_deltas(
+      static_cast<int16_t>(sequence_number - state.sequence_number));
+  batch->add_rtp_timestamp_deltas(
+      static_cast<int32_t>(rtp_timestamp - state.rtp_timestamp));
+  state.sequence_number = sequence_number;
+  state.rtp_timestamp = rtp_timestamp;
+
+  batch->mutable_header_tails()->append(
+      reinterpret_cast<const char*>(packet.header + kFixedHeaderSize),
+      tail_length);
+  ++num_packets_;
+  return true;
+}
+
+void RtpPacketBatchEncoder::Clear() {
+  // Clearing the event keeps the memory of its fields for the next batch.
+  event_.Clear();
+  num_packets_ = 0;
+  last_timestamp_us_ = 0;
+  ssrcs_.clear();
+}
+
+bool DecodeRtpPacketBatch(const rtclog::Event& batch_event,
+                          std::vector<rtclog::Event>* events) {
+  if (!batch_event.has_timestamp_us() || !batch_event.has_rtp_packet_batch())
+    return false;
+  const rtclog::RtpPacketBatch& batch = batch_event.rtp_packet_batch();
+  const int num_packets = batch.timestamp_deltas_us_size();
+  if (batch.info_size() != num_packets ||
+      batch.packet_length_size() != num_packets ||
+      batch.first_bytes_size() != num_packets ||
+      batch.ssrc_index_size() != num_packets ||
+      batch.sequence_number_deltas_size() != num_packets ||
+      batch.rtp_timestamp_deltas_size() != num_packets) {
+    return false;
+  }
+
+  // Sequence number and RTP timestamp of the last packet of each SSRC.
+  std::vector<std::pair<uint16_t, uint32_t>> last(batch.ssrcs_size());
+  const std::string& tails = batch.header_tails();
+  size_t tail_pos = 0;
+  int64_t timestamp_us = batch_event.timestamp_us();
+  for (int i = 0; i < num_packets; ++i) {
+    const uint32_t info = batch.info(i);
+    const uint32_t first_bytes = batch.first_bytes(i);
+    const uint32_t index = batch.ssrc_index(i);
+    if (!rtclog::MediaType_IsValid(info >> 1) || first_bytes > 0xFFFF ||
+        index >= last.size()) {
+      return false;
+    }
+    last[index].first += batch.sequence_number_deltas(i);
+    last[index].second += batch.rtp_timestamp_deltas(i);
+
+    uint8_t fixed_header[kFixedHeaderSize];
+    WriteUint16(static_cast<uint16_t>(first_bytes), fixed_header);
+    WriteUint16(last[index].first, fixed_header + 2);
+    WriteUint32(last[index].second, fixed_header + 4);
+    WriteUint32(batch.ssrcs(index), fixed_header + 8);
+
+    // The CSRCs, followed by the extension if the X bit is set.
+    size_t tail_length = (fixed_header[0] & 0x0f) * 4u;
+    if (fixed_header[0] & 0x10) {
+      if (tail_pos + tail_length + 4 > tails.size())
+        return false;
+      const uint8_t* extension_header = reinterpret_cast<const uint8_t*>(
+          tails.data() + tail_pos + tail_length);
+      tail_length += 4 + ReadUint16(extension_header + 2) * 4u;
+    }
+    if (tail_pos + tail_length > tails.size())
+      return false;
+
+    timestamp_us += batch.timestamp_deltas_us(i);
+    events->push_back(rtclog::Event());
+    rtclog::Event& event = events->back();
+    event.set_timestamp_us(timestamp_us);
+    event.set_type(rtclog::Event::RTP_EVENT);
+    rtclog::RtpPacket* rtp_packet = event.mutable_rtp_packet();
+    rtp_packet->set_incoming((info & 1) != 0);
+    rtp_packet->set_type(static_cast<rtclog::MediaType>(info >> 1));
+    rtp_packet->set_packet_length(batch.packet_length(i));
+    std::string* header = rtp_packet->mutable_header();
+    header->assign(reinterpret_cast<const char*>(fixed_header),
+                   kFixedHeaderSize);
+    header->append(tails, tail_pos, tail_length);
+    tail_pos += tail_length;
+  }
+  return tail_pos == tails.size();
+}
+
+}  // namespace webrtc
@@ -0,0 +1,96 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_LOGGING_RTC_EVENT_LOG_RTP_PACKET_BATCH_H_
+#define WEBRTC_LOGGING_RTC_EVENT_LOG_RTP_PACKET_BATCH_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/ignore_wundef.h"
+
+// Files generated at build-time by the protobuf compiler.
+RTC_PUSH_IGNORING_WUNDEF()
+#ifdef WEBRTC_ANDROID_PLATFORM_BUILD
+#include "external/webrtc/webrtc/logging/rtc_event_log/rtc_event_log.pb.h"
+#else
+#include "webrtc/logging/rtc_event_log/rtc_event_log.pb.h"
+#endif
+RTC_POP_IGNORING_WUNDEF()
+
+namespace webrtc {
+
+// A logged RTP packet. Plain data, so that queues and histories of packets
+// can be preallocated.
+struct RtpPacketRecord {
+  // Headers longer than this are logged as separate RTP events.
+  static const size_t kMaxHeaderSize = 128;
+
+  int64_t timestamp_us;
+  bool incoming;
+  rtclog::MediaType type;
+  uint32_t packet_length;
+  // Length of the header, including CSRCs and the header extension.
+  size_t header_length;
+  uint8_t header[kMaxHeaderSize];
+};
+
+// Accumulates RTP packets into a single RTP_BATCH_EVENT. The buffers of the
+// event are kept between batches, so a steady stream of packets is encoded
+// without allocating memory.
+class RtpPacketBatchEncoder {
+ public:
+  // Limits that keep an encoded batch below the 64 kB that
+  // ParsedRtcEventLog accepts for a single event.
+  static const size_t kMaxPackets = 512;
+  static const size_t kMaxHeaderTailBytes = 32 * 1024;
+
+  RtpPacketBatchEncoder();
+  ~RtpPacketBatchEncoder();
+
+  // Appends |packet|. Returns false, leaving the batch unchanged, if the
+  // batch is full.
+  bool Add(const RtpPacketRecord& packet);
+
+  size_t size() const { return num_packets_; }
+  bool empty() const { return num_packets_ == 0; }
+
+  // The batch as an RTP_BATCH_EVENT. Only valid if the batch isn't empty.
+  rtclog::Event* event() { return &event_; }
+
+  // Starts a new batch.
+  void Clear();
+
+ private:
+  struct SsrcState {
+    uint32_t ssrc;
+    uint16_t sequence_number;
+    uint32_t rtp_timestamp;
+  };
+
+  rtclog::Event event_;
+  size_t num_packets_;
+  int64_t last_timestamp_us_;
+  std::vector<SsrcState> ssrcs_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(RtpPacketBatchEncoder);
+};
+
+// Appends one RTP_EVENT per packet in the RTP_BATCH_EVENT |batch| to
+// |events|. Returns false if the batch is malformed.
+bool DecodeRtpPacketBatch(const rtclog::Event& batch,
+                          std::vector<rtclog::Event>* events);
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_LOGGING_RTC_EVENT_LOG_RTP_PACKET_BATCH_H_
@@ -0,0 +1,157 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <vector>
+
+#include "webrtc/logging/rtc_event_log/rtp_packet_batch.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+RtpPacketRecord CreatePacket(int64_t timestamp_us,
+                             uint32_t ssrc,
+                             uint16_t sequence_number,
+                             uint32_t rtp_timestamp,
+                             size_t num_csrcs,
+                             size_t extension_words) {
+  RtpPacketRecord packet;
+  memset(&packet, 0, sizeof(packet));
+  packet.timestamp_us = timestamp_us;
+  packet.incoming = (sequence_number % 2) == 0;
+  packet.type = rtclog::VIDEO;
+  packet.packet_length = 1000 + sequence_number % 200;
+  uint8_t* header = packet.header;
+  header[0] = 0x80 | static_cast<uint8_t>(num_csrcs);
+  if (extension_words > 0)
+    header[0] |= 0x10;
+  header[1] = 0x80 | 96;
+  header[2] = static_cast<uint8_t>(sequence_number >> 8);
+  header[3] = static_cast<uint8_t>(sequence_number);
+  for (int i = 0; i < 4; ++i) {
+    header[4 + i] = static_cast<uint8_t>(rtp_timestamp >> (24 - 8 * i));
+    header[8 + i] = static_cast<uint8_t>(ssrc >> (24 - 8 * i));
+  }
+  size_t length = 12;
+  for (size_t i = 0; i < num_csrcs * 4; ++i)
+    header[length++] = static_cast<uint8_t>(i + 1);
+  if (extension_words > 0) {
+    header[length++] = 0xBE;
+    header[length++] = 0xDE;
+    header[length++] = static_cast<uint8_t>(extension_words >> 8);
+    header[length++] = static_cast<uint8_t>(extension_words);
+    for (size_t i = 0; i < extension_words * 4; ++i)
+      header[length++] = static_cast<uint8_t>(0x40 + i);
+  }
+  packet.header_length = length;
+  return packet;
+}
+
+void ExpectEventMatches(const RtpPacketRecord& packet,
+                        const rtclog::Event& event) {
+  EXPECT_EQ(rtclog::Event::RTP_EVENT, event.type());
+  EXPECT_EQ(packet.timestamp_us, event.timestamp_us());
+  const rtclog::RtpPacket& rtp_packet = event.rtp_packet();
+  EXPECT_EQ(packet.incoming, rtp_packet.incoming());
+  EXPECT_EQ(packet.type, rtp_packet.type());
+  EXPECT_EQ(packet.packet_length, rtp_packet.packet_length());
+  ASSERT_EQ(packet.header_length, rtp_packet.header().size());
+  EXPECT_EQ(0, memcmp(packet.header, rtp_packet.header().data(),
+                      packet.header_length));
+}
+
+}  // namespace
+
+TEST(RtpPacketBatchTest, EncodesAndDecodesPackets) {
+  std::vector<RtpPacketRecord> packets;
+  packets.push_back(CreatePacket(1000, 0x12345678, 65534, 0xFFFFFF00, 0, 0));
+  packets.push_back(CreatePacket(1500, 0xCAFEBABE, 7, 3000, 2, 0));
+  packets.push_back(CreatePacket(1500, 0x12345678, 65535, 0xFFFFFF00, 0, 2));
+  // Sequence number and RTP timestamp wrap around.
+  packets.push_back(CreatePacket(2200, 0x12345678, 0, 0x00000100, 1, 1));
+  // Reordered packet.
+  packets.push_back(CreatePacket(2300, 0xCAFEBABE, 5, 1500, 0, 3));
+  packets.push_back(CreatePacket(2100, 0xCAFEBABE, 8, 6000, 15, 0));
+
+  RtpPacketBatchEncoder encoder;
+  for (const RtpPacketRecord& packet : packets)
+    EXPECT_TRUE(encoder.Add(packet));
+  EXPECT_EQ(packets.size(), encoder.size());
+  EXPECT_EQ(rtclog::Event::RTP_BATCH_EVENT, encoder.event()->type());
+  EXPECT_EQ(2, encoder.event()->rtp_packet_batch().ssrcs_size());
+
+  // The batch survives serialization.
+  std::string serialized;
+  ASSERT_TRUE(encoder.event()->SerializeToString(&serialized));
+  rtclog::Event batch;
+  ASSERT_TRUE(batch.ParseFromString(serialized));
+
+  std::vector<rtclog::Event> events;
+  ASSERT_TRUE(DecodeRtpPacketBatch(batch, &events));
+  ASSERT_EQ(packets.size(), events.size());
+  for (size_t i = 0; i < packets.size(); ++i)
+    ExpectEventMatches(packets[i], events[i]);
+}
+
+TEST(RtpPacketBatchTest, ClearStartsNewBatch) {
+  RtpPacketBatchEncoder encoder;
+  EXPECT_TRUE(encoder.Add(CreatePacket(1000, 1, 100, 0, 0, 1)));
+  EXPECT_TRUE(encoder.Add(CreatePacket(2000, 1, 101, 90, 0, 1)));
+  encoder.Clear();
+  EXPECT_TRUE(encoder.empty());
+
+  // The new batch doesn't depend on the packets of the previous one.
+  RtpPacketRecord packet = CreatePacket(3000, 1, 102, 180, 0, 1);
+  EXPECT_TRUE(encoder.Add(packet));
+  std::vector<rtclog::Event> events;
+  ASSERT_TRUE(DecodeRtpPacketBatch(*encoder.event(), &events));
+  ASSERT_EQ(1u, events.size());
+  ExpectEventMatches(packet, events[0]);
+}
+
+TEST(RtpPacketBatchTest, LimitsNumberOfPackets) {
+  RtpPacketBatchEncoder encoder;
+  for (size_t i = 0; i < RtpPacketBatchEncoder::kMaxPackets; ++i) {
+    EXPECT_TRUE(encoder.Add(CreatePacket(i, 1, static_cast<uint16_t>(i),
+                                         static_cast<uint32_t>(i), 0, 0)));
+  }
+  EXPECT_FALSE(encoder.Add(CreatePacket(1000, 1, 1000, 1000, 0, 0)));
+  EXPECT_EQ(RtpPacketBatchEncoder::kMaxPackets, encoder.size());
+}
+
+TEST(RtpPacketBatchTest, LimitsSizeOfHeaderTails) {
+  RtpPacketBatchEncoder encoder;
+  RtpPacketRecord packet = CreatePacket(0, 1, 0, 0, 15, 10);
+  const size_t tail_length = packet.header_length - 12;
+  size_t num_packets = 0;
+  while (encoder.Add(packet))
+    ++num_packets;
+  EXPECT_EQ(RtpPacketBatchEncoder::kMaxHeaderTailBytes / tail_length,
+            num_packets);
+
+  // The batch stays below the maximum event size of ParsedRtcEventLog.
+  EXPECT_LT(encoder.event()->ByteSize(), 1 << 16);
+}
+
+TEST(RtpPacketBatchTest, RejectsTruncatedHeaderTails) {
+  RtpPacketBatchEncoder encoder;
+  EXPECT_TRUE(encoder.Add(CreatePacket(1000, 1, 100, 0, 2, 1)));
+  rtclog::Event batch = *encoder.event();
+  std::string* tails = batch.mutable_rtp_packet_batch()->mutable_header_tails();
+  tails->resize(tails->size() - 1);
+
+  std::vector<rtclog::Event> events;
+  EXPECT_FALSE(DecodeRtpPacketBatch(batch, &events));
+}
+
+}  // namespace webrtc
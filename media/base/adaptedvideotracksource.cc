@@ -83,6 +83,7 @@ void AdaptedVideoTrackSource::OnSinkWantsChanged(
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
   video_adapter_.OnResolutionRequest(wants.max_pixel_count,
                                      wants.max_pixel_count_step_up);
+  video_adapter_.OnFramerateRequest(wants.max_framerate_fps);
 }
 
 bool AdaptedVideoTrackSource::AdaptFrame(int width,
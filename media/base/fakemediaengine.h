@@ -417,6 +417,13 @@ class FakeVoiceMediaChannel : public RtpHelper<VoiceMediaChannel> {
     sink_ = std::move(sink);
   }
 
+  virtual void SetAudioLevelSink(webrtc::AudioLevelSinkInterface* sink) {
+    audio_level_sink_ = sink;
+  }
+  webrtc::AudioLevelSinkInterface* audio_level_sink() const {
+    return audio_level_sink_;
+  }
+
  private:
   class VoiceChannelAudioSink : public AudioSource::Sink {
    public:
@@ -492,6 +499,7 @@ class FakeVoiceMediaChannel : public RtpHelper<VoiceMediaChannel> {
   AudioOptions options_;
   std::map<uint32_t, VoiceChannelAudioSink*> local_sinks_;
   std::unique_ptr<webrtc::AudioSinkInterface> sink_;
+  webrtc::AudioLevelSinkInterface* audio_level_sink_ = nullptr;
   int max_bps_;
 };
 
@@ -42,6 +42,7 @@ class Timing;
 }
 
 namespace webrtc {
+class AudioLevelSinkInterface;
 class AudioSinkInterface;
 class VideoFrame;
 }
@@ -132,6 +133,10 @@ struct MediaConfig {
 
     // Enables periodic bandwidth probing in application-limited region.
     bool periodic_alr_bandwidth_probing = false;
+
+    // Stops padding in long application-limited regions, see
+    // webrtc::VideoSendStream::Config::suppress_padding_in_alr.
+    bool suppress_padding_in_alr = false;
   } video;
 
   bool operator==(const MediaConfig& o) const {
@@ -143,7 +148,8 @@ struct MediaConfig {
            video.disable_prerenderer_smoothing ==
                o.video.disable_prerenderer_smoothing &&
            video.periodic_alr_bandwidth_probing ==
-               o.video.periodic_alr_bandwidth_probing;
+               o.video.periodic_alr_bandwidth_probing &&
+           video.suppress_padding_in_alr == o.video.suppress_padding_in_alr;
   }
 
   bool operator!=(const MediaConfig& o) const { return !(*this == o); }
@@ -719,6 +725,13 @@ struct VoiceReceiverInfo : public MediaReceiverInfo {
   int64_t capture_start_ntp_time_ms;
 };
 
+// Percentiles of the time spent in a stage of the send path, -1 if unknown.
+struct LatencyPercentiles {
+  int64_t p50 = -1;
+  int64_t p95 = -1;
+  int64_t p99 = -1;
+};
+
 struct VideoSenderInfo : public MediaSenderInfo {
   VideoSenderInfo()
       : packets_cached(0),
@@ -756,6 +769,14 @@ struct VideoSenderInfo : public MediaSenderInfo {
   int encode_usage_percent;
   uint32_t frames_encoded;
   rtc::Optional<uint64_t> qp_sum;
+  // Percentiles of the time spent in the stages of the send path by the
+  // packets of the first SSRC, -1 if unknown.
+  LatencyPercentiles pacer_queue_time_ms;
+  LatencyPercentiles media_encryption_time_us;
+  LatencyPercentiles send_delay_ms;
+  // Cost of end to end media encryption summed over the SSRCs, only set when
+  // it is enabled.
+  rtc::Optional<webrtc::MediaCryptoStats> media_crypto;
 };
 
 struct VideoReceiverInfo : public MediaReceiverInfo {
@@ -822,6 +843,9 @@ struct VideoReceiverInfo : public MediaReceiverInfo {
 
   // Estimated capture start time in NTP time in ms.
   int64_t capture_start_ntp_time_ms;
+
+  // Cost of end to end media decryption, only set when it is enabled.
+  rtc::Optional<webrtc::MediaCryptoStats> media_crypto;
 };
 
 struct DataSenderInfo : public MediaSenderInfo {
@@ -1029,6 +1053,11 @@ class VoiceMediaChannel : public MediaChannel {
   virtual void SetRawAudioSink(
       uint32_t ssrc,
       std::unique_ptr<webrtc::AudioSinkInterface> sink) = 0;
+
+  // Sets a sink that receives the RTP audio level header extension of the
+  // packets of all receive streams, present and future, without decoding
+  // them. The sink is not owned; passing null clears it.
+  virtual void SetAudioLevelSink(webrtc::AudioLevelSinkInterface* sink) = 0;
 };
 
 // TODO(deadbeef): Rename to VideoSenderParameters, since they're intended to
@@ -318,7 +318,8 @@ bool RtpDataMediaChannel::SendData(
   rtp_clock_by_send_ssrc_[header.ssrc]->Tick(
       now, &header.seq_num, &header.timestamp);
 
-  rtc::CopyOnWriteBuffer packet(kMinRtpPacketLen, packet_len);
+  rtc::CopyOnWriteBuffer packet(kMinRtpPacketLen,
+                                packet_len + kMaxSrtpTrailerLen);
   if (!SetRtpHeader(packet.data(), packet.size(), header)) {
     return false;
   }
@@ -22,6 +22,10 @@ namespace cricket {
 const size_t kMinRtpPacketLen = 12;
 const size_t kMaxRtpPacketLen = 2048;
 const size_t kMinRtcpPacketLen = 4;
+// The most SRTP or SRTCP adds to the end of a packet: a 16 byte authentication
+// tag, plus the 4 byte index for SRTCP. Send buffers reserve this much room so
+// that packets can be protected in place.
+const size_t kMaxSrtpTrailerLen = 20;
 
 struct RtpHeader {
   int payload_type;
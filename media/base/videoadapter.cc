@@ -19,6 +19,7 @@
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/base/optional.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/media/base/mediaconstants.h"
 #include "webrtc/media/base/videocommon.h"
 
@@ -75,15 +76,23 @@ VideoAdapter::VideoAdapter(int required_resolution_alignment)
       previous_height_(0),
       required_resolution_alignment_(required_resolution_alignment),
       resolution_request_max_pixel_count_(std::numeric_limits<int>::max()),
-      step_up_(false) {}
+      step_up_(false),
+      framerate_request_interval_ns_(0) {}
 
 VideoAdapter::VideoAdapter() : VideoAdapter(1) {}
 
 VideoAdapter::~VideoAdapter() {}
 
+int64_t VideoAdapter::RequestedIntervalNs() const {
+  const int64_t format_interval_ns =
+      requested_format_ ? requested_format_->interval : 0;
+  return std::max(format_interval_ns, framerate_request_interval_ns_);
+}
+
 bool VideoAdapter::KeepFrame(int64_t in_timestamp_ns) {
   rtc::CritScope cs(&critical_section_);
-  if (!requested_format_ || requested_format_->interval == 0)
+  const int64_t interval_ns = RequestedIntervalNs();
+  if (interval_ns == 0)
     return true;
 
   if (next_frame_timestamp_ns_) {
@@ -92,12 +101,12 @@ bool VideoAdapter::KeepFrame(int64_t in_timestamp_ns) {
         (*next_frame_timestamp_ns_ - in_timestamp_ns);
 
     // Continue if timestamp is withing expected range.
-    if (std::abs(time_until_next_frame_ns) < 2 * requested_format_->interval) {
+    if (std::abs(time_until_next_frame_ns) < 2 * interval_ns) {
       // Drop if a frame shouldn't be outputted yet.
       if (time_until_next_frame_ns > 0)
         return false;
       // Time to output new frame.
-      *next_frame_timestamp_ns_ += requested_format_->interval;
+      *next_frame_timestamp_ns_ += interval_ns;
       return true;
     }
   }
@@ -106,7 +115,7 @@ bool VideoAdapter::KeepFrame(int64_t in_timestamp_ns) {
   // reset. Set first timestamp target to just half the interval to prefer
   // keeping frames in case of jitter.
   next_frame_timestamp_ns_ =
-      rtc::Optional<int64_t>(in_timestamp_ns + requested_format_->interval / 2);
+      rtc::Optional<int64_t>(in_timestamp_ns + interval_ns / 2);
   return true;
 }
 
@@ -230,4 +239,15 @@ void VideoAdapter::OnResolutionRequest(
   step_up_ = static_cast<bool>(max_pixel_count_step_up);
 }
 
+void VideoAdapter::OnFramerateRequest(rtc::Optional<int> max_framerate_fps) {
+  rtc::CritScope cs(&critical_section_);
+  const int64_t interval_ns =
+      max_framerate_fps && *max_framerate_fps > 0
+          ? rtc::kNumNanosecsPerSec / *max_framerate_fps
+          : 0;
+  if (interval_ns != framerate_request_interval_ns_)
+    next_frame_timestamp_ns_ = rtc::Optional<int64_t>();
+  framerate_request_interval_ns_ = interval_ns;
+}
+
 }  // namespace cricket
@@ -54,9 +54,18 @@ class VideoAdapter {
   void OnResolutionRequest(rtc::Optional<int> max_pixel_count,
                            rtc::Optional<int> max_pixel_count_step_up);
 
+  // Requests the frame interval from |AdaptFrameResolution| to not be shorter
+  // than that of |max_framerate_fps|, on top of the interval of any
+  // OnOutputFormatRequest.
+  void OnFramerateRequest(rtc::Optional<int> max_framerate_fps);
+
  private:
   // Determine if frame should be dropped based on input fps and requested fps.
   bool KeepFrame(int64_t in_timestamp_ns);
+  // The longest of the intervals requested by OnOutputFormatRequest and
+  // OnFramerateRequest, 0 if no frames should be dropped.
+  int64_t RequestedIntervalNs() const
+      EXCLUSIVE_LOCKS_REQUIRED(critical_section_);
 
   int frames_in_;         // Number of input frames.
   int frames_out_;        // Number of output frames.
@@ -75,6 +84,7 @@ class VideoAdapter {
   rtc::Optional<VideoFormat> requested_format_ GUARDED_BY(critical_section_);
   int resolution_request_max_pixel_count_ GUARDED_BY(critical_section_);
   bool step_up_ GUARDED_BY(critical_section_);
+  int64_t framerate_request_interval_ns_ GUARDED_BY(critical_section_);
 
   // The critical section to protect the above variables.
   rtc::CriticalSection critical_section_;
@@ -381,6 +381,24 @@ TEST_F(VideoAdapterTest, AdaptFramerateOntheFly) {
   EXPECT_GT(listener_->GetStats().dropped_frames, 0);
 }
 
+// Request half of the capture frame rate through OnFramerateRequest, as a
+// sink does through VideoSinkWants::max_framerate_fps. Expect every other
+// frame to be dropped, and no drops once the request is cleared.
+TEST_F(VideoAdapterTest, AdaptFramerateByFramerateRequest) {
+  adapter_.OnFramerateRequest(
+      rtc::Optional<int>(capture_format_.framerate() / 2));
+  EXPECT_EQ(CS_RUNNING, capturer_->Start(capture_format_));
+  for (int i = 0; i < 10; ++i)
+    capturer_->CaptureFrame();
+  EXPECT_GE(listener_->GetStats().captured_frames, 10);
+  EXPECT_EQ(5, listener_->GetStats().dropped_frames);
+
+  adapter_.OnFramerateRequest(rtc::Optional<int>());
+  for (int i = 0; i < 10; ++i)
+    capturer_->CaptureFrame();
+  EXPECT_EQ(5, listener_->GetStats().dropped_frames);
+}
+
 // Set a very high output pixel resolution. Expect no cropping or resolution
 // change.
 TEST_F(VideoAdapterTest, AdaptFrameResolutionHighLimit) {
@@ -15,6 +15,7 @@
 #include "webrtc/api/video/i420_buffer.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/base/optional.h"
 
 namespace rtc {
 
@@ -36,9 +37,13 @@ void VideoBroadcaster::RemoveSink(
     VideoSinkInterface<webrtc::VideoFrame>* sink) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
   RTC_DCHECK(sink != nullptr);
-  rtc::CritScope cs(&sinks_and_wants_lock_);
-  VideoSourceBase::RemoveSink(sink);
-  UpdateWants();
+  {
+    rtc::CritScope cs(&sinks_and_wants_lock_);
+    VideoSourceBase::RemoveSink(sink);
+    UpdateWants();
+  }
+  // Wait for a frame that may be in flight to the removed sink.
+  rtc::CritScope cs(&delivery_lock_);
 }
 
 bool VideoBroadcaster::frame_wanted() const {
@@ -52,21 +57,54 @@ VideoSinkWants VideoBroadcaster::wants() const {
 }
 
 void VideoBroadcaster::OnFrame(const webrtc::VideoFrame& frame) {
-  rtc::CritScope cs(&sinks_and_wants_lock_);
-  for (auto& sink_pair : sink_pairs()) {
-    if (sink_pair.wants.rotation_applied &&
-        frame.rotation() != webrtc::kVideoRotation_0) {
-      // Calls to OnFrame are not synchronized with changes to the sink wants.
-      // When rotation_applied is set to true, one or a few frames may get here
-      // with rotation still pending. Protect sinks that don't expect any
-      // pending rotation.
-      LOG(LS_VERBOSE) << "Discarding frame with unexpected rotation.";
-      continue;
-    }
+  rtc::CritScope delivery_cs(&delivery_lock_);
+  {
+    rtc::CritScope cs(&sinks_and_wants_lock_);
+    delivery_sinks_.assign(sink_pairs().begin(), sink_pairs().end());
+  }
+
+  const bool rotation_pending = frame.rotation() != webrtc::kVideoRotation_0;
+  const bool swaps_dimensions = frame.rotation() == webrtc::kVideoRotation_90 ||
+                                frame.rotation() == webrtc::kVideoRotation_270;
+  // Created on first use and shared by all sinks wanting the same version.
+  rtc::Optional<webrtc::VideoFrame> rotated_frame;
+  rtc::Optional<webrtc::VideoFrame> black_frame;
+  rtc::Optional<webrtc::VideoFrame> rotated_black_frame;
+  for (const auto& sink_pair : delivery_sinks_) {
+    const bool apply_rotation =
+        sink_pair.wants.rotation_applied && rotation_pending;
     if (sink_pair.wants.black_frames) {
-      sink_pair.sink->OnFrame(webrtc::VideoFrame(
-          GetBlackFrameBuffer(frame.width(), frame.height()), frame.rotation(),
-          frame.timestamp_us()));
+      rtc::Optional<webrtc::VideoFrame>& black =
+          apply_rotation ? rotated_black_frame : black_frame;
+      if (!black) {
+        const bool swap = apply_rotation && swaps_dimensions;
+        black.emplace(
+            GetBlackFrameBuffer(swap ? frame.height() : frame.width(),
+                                swap ? frame.width() : frame.height()),
+            apply_rotation ? webrtc::kVideoRotation_0 : frame.rotation(),
+            frame.timestamp_us());
+      }
+      sink_pair.sink->OnFrame(*black);
+    } else if (apply_rotation) {
+      if (!rotated_frame) {
+        if (frame.video_frame_buffer()->native_handle()) {
+          // Calls to OnFrame are not synchronized with changes to the sink
+          // wants. When rotation_applied is set to true, one or a few frames
+          // may get here with rotation still pending. Native buffers can't be
+          // rotated here, so protect sinks that don't expect any pending
+          // rotation.
+          LOG(LS_VERBOSE) << "Discarding frame with unexpected rotation.";
+          continue;
+        }
+        rotated_frame.emplace(
+            webrtc::I420Buffer::Rotate(*frame.video_frame_buffer(),
+                                       frame.rotation()),
+            frame.timestamp(), frame.render_time_ms(),
+            webrtc::kVideoRotation_0);
+        rotated_frame->set_timestamp_us(frame.timestamp_us());
+        rotated_frame->set_ntp_time_ms(frame.ntp_time_ms());
+      }
+      sink_pair.sink->OnFrame(*rotated_frame);
     } else {
       sink_pair.sink->OnFrame(frame);
     }
@@ -96,6 +134,12 @@ void VideoBroadcaster::UpdateWants() {
           *wants.max_pixel_count_step_up))) {
       wants.max_pixel_count_step_up = sink.wants.max_pixel_count_step_up;
     }
+    // wants.max_framerate_fps == MIN(sink.wants.max_framerate_fps)
+    if (sink.wants.max_framerate_fps &&
+        (!wants.max_framerate_fps ||
+         (*sink.wants.max_framerate_fps < *wants.max_framerate_fps))) {
+      wants.max_framerate_fps = sink.wants.max_framerate_fps;
+    }
   }
 
   if (wants.max_pixel_count && wants.max_pixel_count_step_up &&
@@ -28,7 +28,9 @@ namespace rtc {
 // rtc::VideoSourceInterface and rtc::VideoSinkInterface.
 // Sinks must be added and removed on one and only one thread.
 // Video frames can be broadcasted on any thread. I.e VideoBroadcaster::OnFrame
-// can be called on any thread.
+// can be called on any thread. Frames are delivered to a snapshot of the sinks,
+// without holding the lock that guards the sinks and wants, but once
+// RemoveSink returns the removed sink gets no more frames.
 class VideoBroadcaster : public VideoSourceBase,
                          public VideoSinkInterface<webrtc::VideoFrame> {
  public:
@@ -47,20 +49,28 @@ class VideoBroadcaster : public VideoSourceBase,
   // This method ensures that if a sink sets rotation_applied == true,
   // it will never receive a frame with pending rotation. Our caller
   // may pass in frames without precise synchronization with changes
-  // to the VideoSinkWants.
+  // to the VideoSinkWants. The rotated and black versions of |frame| are
+  // created at most once and shared by all sinks that want them.
   void OnFrame(const webrtc::VideoFrame& frame) override;
 
  protected:
   void UpdateWants() EXCLUSIVE_LOCKS_REQUIRED(sinks_and_wants_lock_);
   const rtc::scoped_refptr<webrtc::VideoFrameBuffer>& GetBlackFrameBuffer(
       int width, int height)
-      EXCLUSIVE_LOCKS_REQUIRED(sinks_and_wants_lock_);
+      EXCLUSIVE_LOCKS_REQUIRED(delivery_lock_);
 
   ThreadChecker thread_checker_;
   rtc::CriticalSection sinks_and_wants_lock_;
+  // Held while a frame is delivered. Taken by RemoveSink after the sink is
+  // removed, to wait for a delivery that may still be using it.
+  rtc::CriticalSection delivery_lock_;
 
   VideoSinkWants current_wants_ GUARDED_BY(sinks_and_wants_lock_);
-  rtc::scoped_refptr<webrtc::VideoFrameBuffer> black_frame_buffer_;
+  // The sinks the current frame is delivered to. A member so that its storage
+  // is reused from frame to frame.
+  std::vector<SinkPair> delivery_sinks_ GUARDED_BY(delivery_lock_);
+  rtc::scoped_refptr<webrtc::VideoFrameBuffer> black_frame_buffer_
+      GUARDED_BY(delivery_lock_);
 };
 
 }  // namespace rtc
@@ -127,6 +127,27 @@ TEST(VideoBroadcasterTest, AppliesMinOfSinkWantsMaxPixelCountStepUp) {
   EXPECT_EQ(1280 * 720, *broadcaster.wants().max_pixel_count_step_up);
 }
 
+TEST(VideoBroadcasterTest, AppliesMinOfSinkWantsMaxFramerate) {
+  VideoBroadcaster broadcaster;
+  EXPECT_TRUE(!broadcaster.wants().max_framerate_fps);
+
+  FakeVideoRenderer sink1;
+  VideoSinkWants wants1;
+  wants1.max_framerate_fps = rtc::Optional<int>(30);
+
+  broadcaster.AddOrUpdateSink(&sink1, wants1);
+  EXPECT_EQ(30, *broadcaster.wants().max_framerate_fps);
+
+  FakeVideoRenderer sink2;
+  VideoSinkWants wants2;
+  wants2.max_framerate_fps = rtc::Optional<int>(15);
+  broadcaster.AddOrUpdateSink(&sink2, wants2);
+  EXPECT_EQ(15, *broadcaster.wants().max_framerate_fps);
+
+  broadcaster.RemoveSink(&sink2);
+  EXPECT_EQ(30, *broadcaster.wants().max_framerate_fps);
+}
+
 TEST(VideoBroadcasterTest, SinkWantsBlackFrames) {
   VideoBroadcaster broadcaster;
   EXPECT_TRUE(!broadcaster.wants().black_frames);
@@ -168,3 +189,60 @@ TEST(VideoBroadcasterTest, SinkWantsBlackFrames) {
   EXPECT_TRUE(sink2.black_frame());
   EXPECT_EQ(30, sink2.timestamp_us());
 }
+
+TEST(VideoBroadcasterTest, RotatesOnceForSinksWantingRotationApplied) {
+  VideoBroadcaster broadcaster;
+
+  FakeVideoRenderer sink1;
+  FakeVideoRenderer sink2;
+  FakeVideoRenderer sink3;
+  VideoSinkWants rotated_wants;
+  rotated_wants.rotation_applied = true;
+  broadcaster.AddOrUpdateSink(&sink1, rotated_wants);
+  broadcaster.AddOrUpdateSink(&sink2, rotated_wants);
+  broadcaster.AddOrUpdateSink(&sink3, rtc::VideoSinkWants());
+
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer(
+      webrtc::I420Buffer::Create(100, 50));
+  webrtc::I420Buffer::SetBlack(buffer);
+  webrtc::VideoFrame frame(buffer, webrtc::kVideoRotation_90,
+                           20 /* timestamp_us */);
+  broadcaster.OnFrame(frame);
+
+  EXPECT_EQ(1, sink1.num_rendered_frames());
+  EXPECT_EQ(webrtc::kVideoRotation_0, sink1.rotation());
+  EXPECT_EQ(50, sink1.width());
+  EXPECT_EQ(100, sink1.height());
+  EXPECT_EQ(20, sink1.timestamp_us());
+  EXPECT_EQ(1, sink2.num_rendered_frames());
+  EXPECT_EQ(webrtc::kVideoRotation_0, sink2.rotation());
+  EXPECT_EQ(50, sink2.width());
+  EXPECT_EQ(100, sink2.height());
+  EXPECT_EQ(1, sink3.num_rendered_frames());
+  EXPECT_EQ(webrtc::kVideoRotation_90, sink3.rotation());
+  EXPECT_EQ(100, sink3.width());
+  EXPECT_EQ(50, sink3.height());
+}
+
+TEST(VideoBroadcasterTest, SinkWantsRotatedBlackFrames) {
+  VideoBroadcaster broadcaster;
+
+  FakeVideoRenderer sink;
+  VideoSinkWants wants;
+  wants.black_frames = true;
+  wants.rotation_applied = true;
+  broadcaster.AddOrUpdateSink(&sink, wants);
+
+  rtc::scoped_refptr<webrtc::I420Buffer> buffer(
+      webrtc::I420Buffer::Create(100, 200));
+  // Makes it not all black.
+  buffer->InitializeData();
+  webrtc::VideoFrame frame(buffer, webrtc::kVideoRotation_270,
+                           10 /* timestamp_us */);
+  broadcaster.OnFrame(frame);
+
+  EXPECT_TRUE(sink.black_frame());
+  EXPECT_EQ(webrtc::kVideoRotation_0, sink.rotation());
+  EXPECT_EQ(200, sink.width());
+  EXPECT_EQ(100, sink.height());
+}
@@ -152,6 +152,7 @@ void VideoCapturer::OnSinkWantsChanged(const rtc::VideoSinkWants& wants) {
   if (video_adapter()) {
     video_adapter()->OnResolutionRequest(wants.max_pixel_count,
                                          wants.max_pixel_count_step_up);
+    video_adapter()->OnFramerateRequest(wants.max_framerate_fps);
   }
 }
 
@@ -34,6 +34,10 @@ struct VideoSinkWants {
   // pixels but wants more and the source should produce a resolution one
   // "step" higher than this but not higher.
   rtc::Optional<int> max_pixel_count_step_up;
+
+  // Tells the source the maximum framerate the sink wants. Frames above this
+  // rate should be dropped by the source, before any conversion or scaling.
+  rtc::Optional<int> max_framerate_fps;
 };
 
 template <typename VideoFrameT>
@@ -96,6 +96,11 @@ void FakeAudioReceiveStream::SetSink(
   sink_ = std::move(sink);
 }
 
+void FakeAudioReceiveStream::SetAudioLevelSink(
+    webrtc::AudioLevelSinkInterface* sink) {
+  audio_level_sink_ = sink;
+}
+
 void FakeAudioReceiveStream::SetGain(float gain) {
   gain_ = gain;
 }
@@ -294,6 +299,8 @@ void FakeVideoReceiveStream::Stop() {
   receiving_ = false;
 }
 
+void FakeVideoReceiveStream::SetSinkActive(bool active) {}
+
 void FakeVideoReceiveStream::SetStats(
     const webrtc::VideoReceiveStream::Stats& stats) {
   stats_ = stats;
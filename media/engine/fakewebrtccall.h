@@ -79,6 +79,9 @@ class FakeAudioReceiveStream final : public webrtc::AudioReceiveStream {
   int received_packets() const { return received_packets_; }
   bool VerifyLastPacket(const uint8_t* data, size_t length) const;
   const webrtc::AudioSinkInterface* sink() const { return sink_.get(); }
+  const webrtc::AudioLevelSinkInterface* audio_level_sink() const {
+    return audio_level_sink_;
+  }
   float gain() const { return gain_; }
   bool DeliverRtp(const uint8_t* packet,
                   size_t length,
@@ -92,12 +95,14 @@ class FakeAudioReceiveStream final : public webrtc::AudioReceiveStream {
 
   webrtc::AudioReceiveStream::Stats GetStats() const override;
   void SetSink(std::unique_ptr<webrtc::AudioSinkInterface> sink) override;
+  void SetAudioLevelSink(webrtc::AudioLevelSinkInterface* sink) override;
   void SetGain(float gain) override;
 
   webrtc::AudioReceiveStream::Config config_;
   webrtc::AudioReceiveStream::Stats stats_;
   int received_packets_ = 0;
   std::unique_ptr<webrtc::AudioSinkInterface> sink_;
+  webrtc::AudioLevelSinkInterface* audio_level_sink_ = nullptr;
   float gain_ = 1.0f;
   rtc::Buffer last_packet_;
   bool started_ = false;
@@ -190,6 +195,7 @@ class FakeVideoReceiveStream final : public webrtc::VideoReceiveStream {
   // webrtc::VideoReceiveStream implementation.
   void Start() override;
   void Stop() override;
+  void SetSinkActive(bool active) override;
 
   webrtc::VideoReceiveStream::Stats GetStats() const override;
 
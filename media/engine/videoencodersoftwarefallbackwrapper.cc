@@ -95,6 +95,16 @@ int32_t VideoEncoderSoftwareFallbackWrapper::InitEncode(
   return ret;
 }
 
+int32_t VideoEncoderSoftwareFallbackWrapper::ReconfigureEncode(
+    const VideoCodec* codec_settings) {
+  int32_t ret = fallback_encoder_
+                    ? fallback_encoder_->ReconfigureEncode(codec_settings)
+                    : encoder_->ReconfigureEncode(codec_settings);
+  if (ret == WEBRTC_VIDEO_CODEC_OK)
+    codec_settings_ = *codec_settings;
+  return ret;
+}
+
 int32_t VideoEncoderSoftwareFallbackWrapper::RegisterEncodeCompleteCallback(
     EncodedImageCallback* callback) {
   callback_ = callback;
@@ -118,23 +128,39 @@ int32_t VideoEncoderSoftwareFallbackWrapper::Encode(
     const CodecSpecificInfo* codec_specific_info,
     const std::vector<FrameType>* frame_types) {
   if (fallback_encoder_)
-    return fallback_encoder_->Encode(frame, codec_specific_info, frame_types);
+    return EncodeWithFallback(frame, codec_specific_info, frame_types);
   int32_t ret = encoder_->Encode(frame, codec_specific_info, frame_types);
   // If requested, try a software fallback.
   if (ret == WEBRTC_VIDEO_CODEC_FALLBACK_SOFTWARE && InitFallbackEncoder()) {
-    if (frame.video_frame_buffer()->native_handle() &&
-        !fallback_encoder_->SupportsNativeHandle()) {
-      LOG(LS_WARNING) << "Fallback encoder doesn't support native frames, "
-                      << "dropping one frame.";
-      return WEBRTC_VIDEO_CODEC_ERROR;
-    }
-
     // Fallback was successful, so start using it with this frame.
-    return fallback_encoder_->Encode(frame, codec_specific_info, frame_types);
+    return EncodeWithFallback(frame, codec_specific_info, frame_types);
   }
   return ret;
 }
 
+int32_t VideoEncoderSoftwareFallbackWrapper::EncodeWithFallback(
+    const VideoFrame& frame,
+    const CodecSpecificInfo* codec_specific_info,
+    const std::vector<FrameType>* frame_types) {
+  if (!frame.video_frame_buffer()->native_handle() ||
+      fallback_encoder_->SupportsNativeHandle()) {
+    return fallback_encoder_->Encode(frame, codec_specific_info, frame_types);
+  }
+  // The frame was sent native for the hardware encoder, map it to I420 for
+  // the software encoder only now that its pixels are actually needed.
+  rtc::scoped_refptr<VideoFrameBuffer> i420_buffer =
+      frame.video_frame_buffer()->NativeToI420Buffer();
+  if (!i420_buffer) {
+    LOG(LS_WARNING) << "Failed to map native frame for the fallback encoder, "
+                    << "dropping one frame.";
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  return fallback_encoder_->Encode(
+      VideoFrame(i420_buffer, frame.timestamp(), frame.render_time_ms(),
+                 frame.rotation()),
+      codec_specific_info, frame_types);
+}
+
 int32_t VideoEncoderSoftwareFallbackWrapper::SetChannelParameters(
     uint32_t packet_loss,
     int64_t rtt) {
@@ -160,8 +186,9 @@ int32_t VideoEncoderSoftwareFallbackWrapper::SetRateAllocation(
 }
 
 bool VideoEncoderSoftwareFallbackWrapper::SupportsNativeHandle() const {
-  if (fallback_encoder_)
-    return fallback_encoder_->SupportsNativeHandle();
+  // Native frames are mapped to I420 in EncodeWithFallback() if the fallback
+  // encoder doesn't support them, so report what the primary encoder supports
+  // and let frames stay native up to here.
   return encoder_->SupportsNativeHandle();
 }
 
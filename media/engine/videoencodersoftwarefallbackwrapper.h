@@ -31,6 +31,7 @@ class VideoEncoderSoftwareFallbackWrapper : public VideoEncoder {
   int32_t InitEncode(const VideoCodec* codec_settings,
                      int32_t number_of_cores,
                      size_t max_payload_size) override;
+  int32_t ReconfigureEncode(const VideoCodec* codec_settings) override;
 
   int32_t RegisterEncodeCompleteCallback(
       EncodedImageCallback* callback) override;
@@ -47,6 +48,11 @@ class VideoEncoderSoftwareFallbackWrapper : public VideoEncoder {
 
  private:
   bool InitFallbackEncoder();
+  // Encodes |frame| with |fallback_encoder_|, mapping native frames to I420
+  // if it doesn't support them.
+  int32_t EncodeWithFallback(const VideoFrame& frame,
+                             const CodecSpecificInfo* codec_specific_info,
+                             const std::vector<FrameType>* frame_types);
 
   // Settings used in the last InitEncode call and used if a dynamic fallback to
   // software is required.
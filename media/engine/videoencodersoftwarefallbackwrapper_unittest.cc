@@ -14,6 +14,7 @@
 
 #include "webrtc/api/video/i420_buffer.h"
 #include "webrtc/base/checks.h"
+#include "webrtc/common_video/include/video_frame_buffer.h"
 #include "webrtc/modules/video_coding/codecs/vp8/temporal_layers.h"
 #include "webrtc/modules/video_coding/include/video_codec_interface.h"
 #include "webrtc/modules/video_coding/include/video_error_codes.h"
@@ -275,10 +276,42 @@ TEST_F(VideoEncoderSoftwareFallbackWrapperTest,
 }
 
 TEST_F(VideoEncoderSoftwareFallbackWrapperTest,
-       SupportsNativeHandleNotForwardedDuringFallback) {
+       SupportsNativeHandleForwardedDuringFallback) {
   UtilizeFallbackEncoder();
   fallback_wrapper_.SupportsNativeHandle();
-  EXPECT_EQ(0, fake_encoder_.supports_native_handle_count_);
+  EXPECT_EQ(1, fake_encoder_.supports_native_handle_count_);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, fallback_wrapper_.Release());
+}
+
+class FakeNativeHandleBuffer : public NativeHandleBuffer {
+ public:
+  FakeNativeHandleBuffer(void* native_handle, int width, int height)
+      : NativeHandleBuffer(native_handle, width, height) {}
+  rtc::scoped_refptr<VideoFrameBuffer> NativeToI420Buffer() override {
+    ++num_mapped_;
+    rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
+    I420Buffer::SetBlack(buffer);
+    return buffer;
+  }
+  int num_mapped_ = 0;
+};
+
+TEST_F(VideoEncoderSoftwareFallbackWrapperTest,
+       MapsNativeFramesForFallbackEncoder) {
+  FallbackFromEncodeRequest();
+  rtc::scoped_refptr<FakeNativeHandleBuffer> buffer(
+      new rtc::RefCountedObject<FakeNativeHandleBuffer>(this, kWidth,
+                                                        kHeight));
+  std::vector<FrameType> types(1, kVideoFrameKey);
+  int callback_count = callback_.callback_count_;
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            fallback_wrapper_.Encode(
+                VideoFrame(buffer, 0, 0, webrtc::kVideoRotation_0), nullptr,
+                &types));
+  // The software encoder got the pixels of the native frame.
+  EXPECT_EQ(1, buffer->num_mapped_);
+  EXPECT_EQ(callback_count + 1, callback_.callback_count_);
+  CheckLastEncoderName("libvpx");
   EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, fallback_wrapper_.Release());
 }
 
@@ -109,6 +109,8 @@ WebRtcVideoCapturer::WebRtcVideoCapturer()
     : factory_(new WebRtcVcmFactory),
       module_(nullptr),
       captured_frames_(0),
+      adapted_input_width_(0),
+      adapted_input_height_(0),
       start_thread_(nullptr),
       async_invoker_(nullptr) {}
 
@@ -116,6 +118,8 @@ WebRtcVideoCapturer::WebRtcVideoCapturer(WebRtcVcmFactoryInterface* factory)
     : factory_(factory),
       module_(nullptr),
       captured_frames_(0),
+      adapted_input_width_(0),
+      adapted_input_height_(0),
       start_thread_(nullptr),
       async_invoker_(nullptr) {}
 
@@ -273,8 +277,10 @@ CaptureState WebRtcVideoCapturer::Start(const VideoFormat& capture_format) {
 
   int64_t start = rtc::TimeMillis();
   module_->RegisterCaptureDataCallback(this);
+  module_->RegisterFrameAdapter(this);
   if (module_->StartCapture(cap) != 0) {
     LOG(LS_ERROR) << "Camera '" << GetId() << "' failed to start";
+    module_->RegisterFrameAdapter(nullptr);
     module_->DeRegisterCaptureDataCallback();
     async_invoker_.reset();
     SetCaptureFormat(nullptr);
@@ -303,6 +309,7 @@ void WebRtcVideoCapturer::Stop() {
     // we stop it we will get no further callbacks.
     module_->StopCapture();
   }
+  module_->RegisterFrameAdapter(nullptr);
   module_->DeRegisterCaptureDataCallback();
 
   // TODO(juberti): Determine if the VCM exposes any drop stats we can use.
@@ -350,7 +357,28 @@ void WebRtcVideoCapturer::OnFrame(
                  << ". Expected format " << GetCaptureFormat()->ToString();
   }
 
-  VideoCapturer::OnFrame(sample, sample.width(), sample.height());
+  if (adapted_input_width_ > 0) {
+    VideoCapturer::OnFrame(sample, adapted_input_width_,
+                           adapted_input_height_);
+  } else {
+    VideoCapturer::OnFrame(sample, sample.width(), sample.height());
+  }
+}
+
+bool WebRtcVideoCapturer::AdaptCapturedFrame(int width,
+                                             int height,
+                                             int64_t timestamp_us,
+                                             int* out_width,
+                                             int* out_height,
+                                             int* crop_width,
+                                             int* crop_height,
+                                             int* crop_x,
+                                             int* crop_y) {
+  adapted_input_width_ = width;
+  adapted_input_height_ = height;
+  return AdaptFrame(width, height, timestamp_us, timestamp_us, out_width,
+                    out_height, crop_width, crop_height, crop_x, crop_y,
+                    nullptr);
 }
 
 }  // namespace cricket
@@ -38,8 +38,10 @@ class WebRtcVcmFactoryInterface {
 };
 
 // WebRTC-based implementation of VideoCapturer.
-class WebRtcVideoCapturer : public VideoCapturer,
-                            public rtc::VideoSinkInterface<webrtc::VideoFrame> {
+class WebRtcVideoCapturer
+    : public VideoCapturer,
+      public rtc::VideoSinkInterface<webrtc::VideoFrame>,
+      public webrtc::VideoCaptureModule::FrameAdapter {
  public:
   WebRtcVideoCapturer();
   explicit WebRtcVideoCapturer(WebRtcVcmFactoryInterface* factory);
@@ -65,6 +67,18 @@ class WebRtcVideoCapturer : public VideoCapturer,
   // Callback when a frame is captured by camera.
   void OnFrame(const webrtc::VideoFrame& frame) override;
 
+  // Adapts raw frames to the sink wants while the capture module converts
+  // them, called right before OnFrame for the frames not dropped.
+  bool AdaptCapturedFrame(int width,
+                          int height,
+                          int64_t timestamp_us,
+                          int* out_width,
+                          int* out_height,
+                          int* crop_width,
+                          int* crop_height,
+                          int* crop_x,
+                          int* crop_y) override;
+
   // Used to signal captured frames on the same thread as invoked Start().
   // With WebRTC's current VideoCapturer implementations, this will mean a
   // thread hop, but in other implementations (e.g. Chrome) it will be called
@@ -76,6 +90,10 @@ class WebRtcVideoCapturer : public VideoCapturer,
   std::unique_ptr<WebRtcVcmFactoryInterface> factory_;
   rtc::scoped_refptr<webrtc::VideoCaptureModule> module_;
   int captured_frames_;
+  // Size of the last frame passed to AdaptCapturedFrame, 0 if the module
+  // doesn't adapt frames. Only accessed on the capture thread.
+  int adapted_input_width_;
+  int adapted_input_height_;
   std::vector<uint8_t> capture_buffer_;
   rtc::Thread* start_thread_;  // Set in Start(), unset in Stop();
 
@@ -344,6 +344,14 @@ class EncoderStreamFactory
   const bool conference_mode_;
 };
 
+void CopyLatencyPercentiles(
+    const webrtc::VideoSendStream::LatencyPercentiles& from,
+    LatencyPercentiles* to) {
+  to->p50 = from.p50;
+  to->p95 = from.p95;
+  to->p99 = from.p99;
+}
+
 }  // namespace
 
 // Constants defined in webrtc/media/engine/constants.h
@@ -1075,6 +1083,7 @@ bool WebRtcVideoChannel2::AddSendStream(const StreamParams& sp) {
   config.suspend_below_min_bitrate = video_config_.suspend_below_min_bitrate;
   config.periodic_alr_bandwidth_probing =
       video_config_.periodic_alr_bandwidth_probing;
+  config.suppress_padding_in_alr = video_config_.suppress_padding_in_alr;
   // Enable end to end media encryption
   if (media_crypto_enabled()) {
     config.media_crypto_enabled = true;
@@ -1497,14 +1506,14 @@ void WebRtcVideoChannel2::SetInterface(NetworkInterface* iface) {
 bool WebRtcVideoChannel2::SendRtp(const uint8_t* data,
                                   size_t len,
                                   const webrtc::PacketOptions& options) {
-  rtc::CopyOnWriteBuffer packet(data, len, kMaxRtpPacketLen);
+  rtc::CopyOnWriteBuffer packet(data, len, len + kMaxSrtpTrailerLen);
   rtc::PacketOptions rtc_options;
   rtc_options.packet_id = options.packet_id;
   return MediaChannel::SendPacket(&packet, rtc_options);
 }
 
 bool WebRtcVideoChannel2::SendRtcp(const uint8_t* data, size_t len) {
-  rtc::CopyOnWriteBuffer packet(data, len, kMaxRtpPacketLen);
+  rtc::CopyOnWriteBuffer packet(data, len, len + kMaxSrtpTrailerLen);
   return MediaChannel::SendRtcp(&packet, rtc::PacketOptions());
 }
 
@@ -2028,6 +2037,12 @@ VideoSenderInfo WebRtcVideoChannel2::WebRtcVideoSendStream::GetVideoSenderInfo(
     info.firs_rcvd += stream_stats.rtcp_packet_type_counts.fir_packets;
     info.nacks_rcvd += stream_stats.rtcp_packet_type_counts.nack_packets;
     info.plis_rcvd += stream_stats.rtcp_packet_type_counts.pli_packets;
+    if (stream_stats.media_crypto) {
+      if (!info.media_crypto)
+        info.media_crypto = rtc::Optional<webrtc::MediaCryptoStats>(
+            webrtc::MediaCryptoStats());
+      *info.media_crypto += *stream_stats.media_crypto;
+    }
   }
 
   if (!stats.substreams.empty()) {
@@ -2037,6 +2052,12 @@ VideoSenderInfo WebRtcVideoChannel2::WebRtcVideoSendStream::GetVideoSenderInfo(
     info.fraction_lost =
         static_cast<float>(first_stream_stats.rtcp_stats.fraction_lost) /
         (1 << 8);
+    CopyLatencyPercentiles(first_stream_stats.pacer_queue_time_ms,
+                           &info.pacer_queue_time_ms);
+    CopyLatencyPercentiles(first_stream_stats.media_encryption_time_us,
+                           &info.media_encryption_time_us);
+    CopyLatencyPercentiles(first_stream_stats.send_delay_ms,
+                           &info.send_delay_ms);
   }
 
   return info;
@@ -2401,6 +2422,7 @@ WebRtcVideoChannel2::WebRtcVideoReceiveStream::GetVideoReceiverInfo(
   info.min_playout_delay_ms = stats.min_playout_delay_ms;
   info.render_delay_ms = stats.render_delay_ms;
   info.frames_decoded = stats.frames_decoded;
+  info.media_crypto = stats.media_crypto;
 
   info.codec_name = GetCodecNameFromPayloadType(stats.current_payload_type);
 
@@ -1606,6 +1606,12 @@ class WebRtcVoiceMediaChannel::WebRtcAudioReceiveStream {
     stream_->SetSink(std::move(sink));
   }
 
+  void SetAudioLevelSink(webrtc::AudioLevelSinkInterface* sink) {
+    RTC_DCHECK(worker_thread_checker_.CalledOnValidThread());
+    audio_level_sink_ = sink;
+    stream_->SetAudioLevelSink(sink);
+  }
+
   void SetOutputVolume(double volume) {
     RTC_DCHECK(worker_thread_checker_.CalledOnValidThread());
     stream_->SetGain(volume);
@@ -1642,6 +1648,7 @@ class WebRtcVoiceMediaChannel::WebRtcAudioReceiveStream {
     RTC_DCHECK(!stream_);
     stream_ = call_->CreateAudioReceiveStream(config_);
     RTC_CHECK(stream_);
+    stream_->SetAudioLevelSink(audio_level_sink_);
     SetPlayout(playout_);
   }
 
@@ -1651,6 +1658,8 @@ class WebRtcVoiceMediaChannel::WebRtcAudioReceiveStream {
   // The stream is owned by WebRtcAudioReceiveStream and may be reallocated if
   // configuration changes.
   webrtc::AudioReceiveStream* stream_ = nullptr;
+  // Not owned; reapplied when |stream_| is recreated.
+  webrtc::AudioLevelSinkInterface* audio_level_sink_ = nullptr;
   bool playout_ = false;
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(WebRtcAudioReceiveStream);
@@ -2323,6 +2332,7 @@ bool WebRtcVoiceMediaChannel::AddRecvStream(const StreamParams& sp) {
                                          call_, this,
                                          engine()->decoder_factory_)));
   recv_streams_[ssrc]->SetPlayout(playout_);
+  recv_streams_[ssrc]->SetAudioLevelSink(audio_level_sink_);
 
   return true;
 }
@@ -2702,6 +2712,15 @@ void WebRtcVoiceMediaChannel::SetRawAudioSink(
   it->second->SetRawAudioSink(std::move(sink));
 }
 
+void WebRtcVoiceMediaChannel::SetAudioLevelSink(
+    webrtc::AudioLevelSinkInterface* sink) {
+  RTC_DCHECK(worker_thread_checker_.CalledOnValidThread());
+  audio_level_sink_ = sink;
+  for (const auto& kv : recv_streams_) {
+    kv.second->SetAudioLevelSink(sink);
+  }
+}
+
 int WebRtcVoiceMediaChannel::GetOutputLevel(int channel) {
   unsigned int ulevel = 0;
   int ret = engine()->voe()->volume()->GetSpeechOutputLevel(channel, ulevel);
@@ -207,19 +207,20 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
   void SetRawAudioSink(
       uint32_t ssrc,
       std::unique_ptr<webrtc::AudioSinkInterface> sink) override;
+  void SetAudioLevelSink(webrtc::AudioLevelSinkInterface* sink) override;
 
   // implements Transport interface
   bool SendRtp(const uint8_t* data,
                size_t len,
                const webrtc::PacketOptions& options) override {
-    rtc::CopyOnWriteBuffer packet(data, len, kMaxRtpPacketLen);
+    rtc::CopyOnWriteBuffer packet(data, len, len + kMaxSrtpTrailerLen);
     rtc::PacketOptions rtc_options;
     rtc_options.packet_id = options.packet_id;
     return VoiceMediaChannel::SendPacket(&packet, rtc_options);
   }
 
   bool SendRtcp(const uint8_t* data, size_t len) override {
-    rtc::CopyOnWriteBuffer packet(data, len, kMaxRtpPacketLen);
+    rtc::CopyOnWriteBuffer packet(data, len, len + kMaxSrtpTrailerLen);
     return VoiceMediaChannel::SendRtcp(&packet, rtc::PacketOptions());
   }
 
@@ -269,6 +270,8 @@ class WebRtcVoiceMediaChannel final : public VoiceMediaChannel,
   double default_recv_volume_ = 1.0;
   // Sink for unsignalled stream, which may be set before the stream exists.
   std::unique_ptr<webrtc::AudioSinkInterface> default_sink_;
+  // Audio level sink of all the receive streams.
+  webrtc::AudioLevelSinkInterface* audio_level_sink_ = nullptr;
   // Default SSRC to use for RTCP receiver reports in case of no signaled
   // send streams. See: https://code.google.com/p/webrtc/issues/detail?id=4740
   // and https://code.google.com/p/chromium/issues/detail?id=547661
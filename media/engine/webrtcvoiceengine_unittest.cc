@@ -96,6 +96,13 @@ class FakeAudioSink : public webrtc::AudioSinkInterface {
   void OnData(const Data& audio) override {}
 };
 
+class FakeAudioLevelSink : public webrtc::AudioLevelSinkInterface {
+ public:
+  void OnAudioLevel(uint32_t ssrc,
+                    uint8_t level_dbov,
+                    bool voice_activity) override {}
+};
+
 class FakeAudioSource : public cricket::AudioSource {
   void SetSink(Sink* sink) override {}
 };
@@ -3476,6 +3483,29 @@ TEST_F(WebRtcVoiceEngineTestFake, SetRawAudioSinkDefaultRecvStream) {
   EXPECT_NE(nullptr, GetRecvStream(0x01).sink());
 }
 
+TEST_F(WebRtcVoiceEngineTestFake, SetAudioLevelSink) {
+  EXPECT_TRUE(SetupChannel());
+  FakeAudioLevelSink sink;
+
+  // The sink applies to existing and new recv streams.
+  EXPECT_TRUE(AddRecvStream(kSsrc1));
+  channel_->SetAudioLevelSink(&sink);
+  EXPECT_EQ(&sink, GetRecvStream(kSsrc1).audio_level_sink());
+  EXPECT_TRUE(AddRecvStream(kSsrc2));
+  EXPECT_EQ(&sink, GetRecvStream(kSsrc2).audio_level_sink());
+
+  // It survives the recreation of the streams on configuration changes.
+  recv_parameters_.extensions.push_back(
+      webrtc::RtpExtension(webrtc::RtpExtension::kAudioLevelUri, 2));
+  EXPECT_TRUE(channel_->SetRecvParameters(recv_parameters_));
+  EXPECT_EQ(&sink, GetRecvStream(kSsrc1).audio_level_sink());
+  EXPECT_EQ(&sink, GetRecvStream(kSsrc2).audio_level_sink());
+
+  channel_->SetAudioLevelSink(nullptr);
+  EXPECT_EQ(nullptr, GetRecvStream(kSsrc1).audio_level_sink());
+  EXPECT_EQ(nullptr, GetRecvStream(kSsrc2).audio_level_sink());
+}
+
 // Test that, just like the video channel, the voice channel communicates the
 // network state to the call.
 TEST_F(WebRtcVoiceEngineTestFake, OnReadyToSendSignalsNetworkState) {
@@ -384,8 +384,10 @@ class SctpTransport::UsrSctpWrapper {
 };
 
 SctpTransport::SctpTransport(rtc::Thread* network_thread,
-                             TransportChannel* channel)
+                             TransportChannel* channel,
+                             const SctpOptions& options)
     : network_thread_(network_thread),
+      options_(options),
       transport_channel_(channel),
       was_ever_writable_(channel->writable()) {
   RTC_DCHECK(network_thread_);
@@ -653,10 +655,15 @@ bool SctpTransport::OpenSctpSocket() {
   // still have to do something reasonable here.  Look up what the buffer's
   // real size is and set our threshold to something reasonable.
   static const int kSendThreshold = usrsctp_sysctl_get_sctp_sendspace() / 2;
+  // With a larger send buffer, ask for more room before signaling that we're
+  // ready to send again, so that the buffer is refilled in big batches.
+  int send_threshold = options_.send_buffer_size > 0
+                           ? options_.send_buffer_size / 2
+                           : kSendThreshold;
 
   sock_ = usrsctp_socket(
       AF_CONN, SOCK_STREAM, IPPROTO_SCTP, &UsrSctpWrapper::OnSctpInboundPacket,
-      &UsrSctpWrapper::SendThresholdCallback, kSendThreshold, this);
+      &UsrSctpWrapper::SendThresholdCallback, send_threshold, this);
   if (!sock_) {
     LOG_ERRNO(LS_ERROR) << debug_name_ << "->OpenSctpSocket(): "
                         << "Failed to create SCTP socket.";
@@ -712,8 +719,27 @@ bool SctpTransport::ConfigureSctpSocket() {
     return false;
   }
 
+  // The buffers must be resized before connecting, since the receive window
+  // is advertised in the INIT chunk. Failing to do so only costs throughput.
+  if (options_.send_buffer_size > 0 &&
+      usrsctp_setsockopt(sock_, SOL_SOCKET, SO_SNDBUF,
+                         &options_.send_buffer_size,
+                         sizeof(options_.send_buffer_size))) {
+    LOG_ERRNO(LS_WARNING) << debug_name_ << "->ConfigureSctpSocket(): "
+                          << "Failed to set SO_SNDBUF to "
+                          << options_.send_buffer_size;
+  }
+  if (options_.receive_buffer_size > 0 &&
+      usrsctp_setsockopt(sock_, SOL_SOCKET, SO_RCVBUF,
+                         &options_.receive_buffer_size,
+                         sizeof(options_.receive_buffer_size))) {
+    LOG_ERRNO(LS_WARNING) << debug_name_ << "->ConfigureSctpSocket(): "
+                          << "Failed to set SO_RCVBUF to "
+                          << options_.receive_buffer_size;
+  }
+
   // Nagle.
-  uint32_t nodelay = 1;
+  uint32_t nodelay = options_.coalesce_sends ? 0 : 1;
   if (usrsctp_setsockopt(sock_, IPPROTO_SCTP, SCTP_NODELAY, &nodelay,
                          sizeof(nodelay))) {
     LOG_ERRNO(LS_ERROR) << debug_name_ << "->ConfigureSctpSocket(): "
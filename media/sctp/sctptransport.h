@@ -67,7 +67,8 @@ class SctpTransport : public SctpTransportInternal,
   // methods can be called.
   // |channel| is required (must not be null).
   SctpTransport(rtc::Thread* network_thread,
-                cricket::TransportChannel* channel);
+                cricket::TransportChannel* channel,
+                const SctpOptions& options = SctpOptions());
   ~SctpTransport() override;
 
   // SctpTransportInternal overrides (see sctptransportinternal.h for comments).
@@ -137,6 +138,7 @@ class SctpTransport : public SctpTransportInternal,
   // Responsible for marshalling incoming data to the channels listeners, and
   // outgoing data to the network interface.
   rtc::Thread* network_thread_;
+  const SctpOptions options_;
   // Helps pass inbound/outbound packets asynchronously to the network thread.
   rtc::AsyncInvoker invoker_;
   // Underlying DTLS channel.
@@ -175,17 +177,19 @@ class SctpTransport : public SctpTransportInternal,
 
 class SctpTransportFactory : public SctpTransportInternalFactory {
  public:
-  explicit SctpTransportFactory(rtc::Thread* network_thread)
-      : network_thread_(network_thread) {}
+  explicit SctpTransportFactory(rtc::Thread* network_thread,
+                                const SctpOptions& options = SctpOptions())
+      : network_thread_(network_thread), options_(options) {}
 
   std::unique_ptr<SctpTransportInternal> CreateSctpTransport(
       TransportChannel* channel) override {
     return std::unique_ptr<SctpTransportInternal>(
-        new SctpTransport(network_thread_, channel));
+        new SctpTransport(network_thread_, channel, options_));
   }
 
  private:
   rtc::Thread* network_thread_;
+  const SctpOptions options_;
 };
 
 }  // namespace cricket
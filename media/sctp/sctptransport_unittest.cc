@@ -129,16 +129,19 @@ class SctpTransportTest : public testing::Test, public sigslot::has_slots<> {
   // so we need to initialize SSL.
   static void SetUpTestCase() {}
 
-  void SetupConnectedTransportsWithTwoStreams() {
+  void SetupConnectedTransportsWithTwoStreams(
+      const SctpOptions& options = SctpOptions()) {
     fake_dtls1_.reset(new FakeTransportChannel("fake dtls 1", 0));
     fake_dtls2_.reset(new FakeTransportChannel("fake dtls 2", 0));
     recv1_.reset(new SctpFakeDataReceiver());
     recv2_.reset(new SctpFakeDataReceiver());
-    transport1_.reset(CreateTransport(fake_dtls1_.get(), recv1_.get()));
+    transport1_.reset(
+        CreateTransport(fake_dtls1_.get(), recv1_.get(), options));
     transport1_->set_debug_name_for_testing("transport1");
     transport1_->SignalReadyToSendData.connect(
         this, &SctpTransportTest::OnChan1ReadyToSend);
-    transport2_.reset(CreateTransport(fake_dtls2_.get(), recv2_.get()));
+    transport2_.reset(
+        CreateTransport(fake_dtls2_.get(), recv2_.get(), options));
     transport2_->set_debug_name_for_testing("transport2");
     transport2_->SignalReadyToSendData.connect(
         this, &SctpTransportTest::OnChan2ReadyToSend);
@@ -165,9 +168,10 @@ class SctpTransportTest : public testing::Test, public sigslot::has_slots<> {
   }
 
   SctpTransport* CreateTransport(FakeTransportChannel* fake_dtls,
-                                 SctpFakeDataReceiver* recv) {
+                                 SctpFakeDataReceiver* recv,
+                                 const SctpOptions& options = SctpOptions()) {
     SctpTransport* transport =
-        new SctpTransport(rtc::Thread::Current(), fake_dtls);
+        new SctpTransport(rtc::Thread::Current(), fake_dtls, options);
     // When data is received, pass it to the SctpFakeDataReceiver.
     transport->SignalDataReceived.connect(
         recv, &SctpFakeDataReceiver::OnDataReceived);
@@ -443,6 +447,31 @@ TEST_F(SctpTransportTest, SendDataBlocked) {
   EXPECT_EQ(SDR_BLOCK, result);
 }
 
+// With a send buffer larger than the 256 kB default, more data can be queued
+// before SDR_BLOCK is returned, and it all reaches the peer.
+TEST_F(SctpTransportTest, SendDataWithLargerBuffers) {
+  SctpOptions options;
+  options.send_buffer_size = 1024 * 1024;
+  options.receive_buffer_size = 1024 * 1024;
+  options.coalesce_sends = true;
+  SetupConnectedTransportsWithTwoStreams(options);
+
+  SendDataResult result;
+  SendDataParams params;
+  params.sid = 1;
+
+  std::vector<char> buffer(1024 * 64, 0);
+  for (size_t i = 0; i < 8; ++i) {
+    buffer[0] = static_cast<char>('a' + i);
+    ASSERT_TRUE(transport1()->SendData(
+        params, rtc::CopyOnWriteBuffer(&buffer[0], buffer.size()), &result));
+    EXPECT_EQ(SDR_SUCCESS, result);
+  }
+  EXPECT_TRUE_WAIT(
+      ReceivedData(receiver2(), 1, std::string(&buffer[0], buffer.size())),
+      kDefaultTimeout);
+}
+
 // Trying to send data for a nonexistent stream should fail.
 TEST_F(SctpTransportTest, SendDataWithNonexistentStreamFails) {
   SetupConnectedTransportsWithTwoStreams();
@@ -48,6 +48,20 @@ constexpr uint16_t kMinSctpSid = 0;
 // usrsctp.h)
 const int kSctpDefaultPort = 5000;
 
+// Socket options for SCTP associations.
+struct SctpOptions {
+  // Size of the association send and receive buffers, in bytes. The receive
+  // buffer is the window advertised to the peer and the send buffer holds the
+  // data in flight, so together they bound the throughput to
+  // buffer size / round trip time. 0 keeps the usrsctp default of 256 kB.
+  int send_buffer_size = 0;
+  int receive_buffer_size = 0;
+  // If true, small messages are held back while data is in flight and bundled
+  // into full packets (Nagle's algorithm), which saves packets and per-packet
+  // overhead at the cost of latency.
+  bool coalesce_sends = false;
+};
+
 // Abstract SctpTransport interface for use internally (by
 // PeerConnection/WebRtcSession/etc.). Exists to allow mock/fake SctpTransports
 // to be created.
@@ -61,6 +61,11 @@ void AudioNetworkAdaptorImpl::SetOverhead(size_t overhead_bytes_per_packet) {
   DumpNetworkMetrics();
 }
 
+void AudioNetworkAdaptorImpl::SetEncodeUsage(float encode_usage) {
+  last_metrics_.encode_usage = rtc::Optional<float>(encode_usage);
+  DumpNetworkMetrics();
+}
+
 AudioNetworkAdaptor::EncoderRuntimeConfig
 AudioNetworkAdaptorImpl::GetEncoderRuntimeConfig() {
   EncoderRuntimeConfig config;
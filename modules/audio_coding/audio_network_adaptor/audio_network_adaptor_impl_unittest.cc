@@ -22,6 +22,7 @@ namespace webrtc {
 using ::testing::_;
 using ::testing::NiceMock;
 using ::testing::Return;
+using ::testing::ReturnRefOfCopy;
 using ::testing::SetArgPointee;
 
 namespace {
@@ -73,7 +74,7 @@ AudioNetworkAdaptorStates CreateAudioNetworkAdaptor() {
   EXPECT_CALL(*controller_manager, GetControllers())
       .WillRepeatedly(Return(controllers));
   EXPECT_CALL(*controller_manager, GetSortedControllers(_))
-      .WillRepeatedly(Return(controllers));
+      .WillRepeatedly(ReturnRefOfCopy(controllers));
 
   states.simulated_clock.reset(new SimulatedClock(kClockInitialTimeMs * 1000));
 
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_coding/audio_network_adaptor/complexity_controller.h"
+
+#include "webrtc/base/checks.h"
+
+namespace webrtc {
+
+ComplexityController::Config::Config(int initial_complexity,
+                                     int min_complexity,
+                                     int max_complexity,
+                                     float complexity_decreasing_encode_usage,
+                                     float complexity_increasing_encode_usage,
+                                     int min_update_interval_ms,
+                                     const Clock* clock)
+    : initial_complexity(initial_complexity),
+      min_complexity(min_complexity),
+      max_complexity(max_complexity),
+      complexity_decreasing_encode_usage(complexity_decreasing_encode_usage),
+      complexity_increasing_encode_usage(complexity_increasing_encode_usage),
+      min_update_interval_ms(min_update_interval_ms),
+      clock(clock) {}
+
+ComplexityController::ComplexityController(const Config& config)
+    : config_(config), complexity_(config_.initial_complexity) {
+  RTC_DCHECK_LE(config_.min_complexity, config_.initial_complexity);
+  RTC_DCHECK_LE(config_.initial_complexity, config_.max_complexity);
+  RTC_DCHECK_LT(config_.complexity_increasing_encode_usage,
+                config_.complexity_decreasing_encode_usage);
+}
+
+void ComplexityController::MakeDecision(
+    const NetworkMetrics& metrics,
+    AudioNetworkAdaptor::EncoderRuntimeConfig* config) {
+  // Decision on |complexity| should not have been made.
+  RTC_DCHECK(!config->complexity);
+
+  if (metrics.encode_usage) {
+    const int64_t now_ms = config_.clock->TimeInMilliseconds();
+    if (!last_update_time_ms_ ||
+        now_ms - *last_update_time_ms_ >= config_.min_update_interval_ms) {
+      if (*metrics.encode_usage >= config_.complexity_decreasing_encode_usage &&
+          complexity_ > config_.min_complexity) {
+        --complexity_;
+        last_update_time_ms_ = rtc::Optional<int64_t>(now_ms);
+      } else if (*metrics.encode_usage <=
+                     config_.complexity_increasing_encode_usage &&
+                 complexity_ < config_.max_complexity) {
+        ++complexity_;
+        last_update_time_ms_ = rtc::Optional<int64_t>(now_ms);
+      }
+    }
+  }
+  config->complexity = rtc::Optional<int>(complexity_);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,61 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_COMPLEXITY_CONTROLLER_H_
+#define WEBRTC_MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_COMPLEXITY_CONTROLLER_H_
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/optional.h"
+#include "webrtc/modules/audio_coding/audio_network_adaptor/controller.h"
+#include "webrtc/system_wrappers/include/clock.h"
+
+namespace webrtc {
+
+// Steps the encoder complexity down while encoding takes a large share of real
+// time, and back up once it becomes cheap again.
+class ComplexityController final : public Controller {
+ public:
+  struct Config {
+    Config(int initial_complexity,
+           int min_complexity,
+           int max_complexity,
+           float complexity_decreasing_encode_usage,
+           float complexity_increasing_encode_usage,
+           int min_update_interval_ms,
+           const Clock* clock);
+    int initial_complexity;
+    int min_complexity;
+    int max_complexity;
+    // Encode usage, i.e., encode time over audio duration, at or above which
+    // the complexity should decrease.
+    float complexity_decreasing_encode_usage;
+    // Encode usage at or below which the complexity can increase.
+    float complexity_increasing_encode_usage;
+    // Least time between two complexity changes, giving the encoder time to
+    // report the usage at the new complexity.
+    int min_update_interval_ms;
+    const Clock* clock;
+  };
+
+  explicit ComplexityController(const Config& config);
+
+  void MakeDecision(const NetworkMetrics& metrics,
+                    AudioNetworkAdaptor::EncoderRuntimeConfig* config) override;
+
+ private:
+  const Config config_;
+  int complexity_;
+  rtc::Optional<int64_t> last_update_time_ms_;
+  RTC_DISALLOW_COPY_AND_ASSIGN(ComplexityController);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_CODING_AUDIO_NETWORK_ADAPTOR_COMPLEXITY_CONTROLLER_H_
@@ -0,0 +1,107 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <memory>
+
+#include "webrtc/modules/audio_coding/audio_network_adaptor/complexity_controller.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+constexpr int kInitialComplexity = 9;
+constexpr int kMinComplexity = 7;
+constexpr float kComplexityDecreasingEncodeUsage = 0.1f;
+constexpr float kComplexityIncreasingEncodeUsage = 0.05f;
+constexpr float kMediumEncodeUsage =
+    (kComplexityDecreasingEncodeUsage + kComplexityIncreasingEncodeUsage) / 2;
+constexpr int kMinUpdateIntervalMs = 1000;
+constexpr int64_t kClockInitialTimeMs = 123456789;
+
+std::unique_ptr<ComplexityController> CreateController(const Clock* clock) {
+  std::unique_ptr<ComplexityController> controller(
+      new ComplexityController(ComplexityController::Config(
+          kInitialComplexity, kMinComplexity, kInitialComplexity,
+          kComplexityDecreasingEncodeUsage, kComplexityIncreasingEncodeUsage,
+          kMinUpdateIntervalMs, clock)));
+  return controller;
+}
+
+void CheckDecision(ComplexityController* controller,
+                   const rtc::Optional<float>& encode_usage,
+                   int expected_complexity) {
+  AudioNetworkAdaptor::EncoderRuntimeConfig config;
+  Controller::NetworkMetrics metrics;
+  metrics.encode_usage = encode_usage;
+  controller->MakeDecision(metrics, &config);
+  EXPECT_EQ(rtc::Optional<int>(expected_complexity), config.complexity);
+}
+
+}  // namespace
+
+TEST(ComplexityControllerTest, OutputInitValueWhenEncodeUsageUnknown) {
+  SimulatedClock clock(kClockInitialTimeMs);
+  auto controller = CreateController(&clock);
+  CheckDecision(controller.get(), rtc::Optional<float>(), kInitialComplexity);
+}
+
+TEST(ComplexityControllerTest, MaintainComplexityForMediumEncodeUsage) {
+  SimulatedClock clock(kClockInitialTimeMs);
+  auto controller = CreateController(&clock);
+  CheckDecision(controller.get(), rtc::Optional<float>(kMediumEncodeUsage),
+                kInitialComplexity);
+}
+
+TEST(ComplexityControllerTest, DecreaseComplexityForHighEncodeUsage) {
+  SimulatedClock clock(kClockInitialTimeMs);
+  auto controller = CreateController(&clock);
+  CheckDecision(controller.get(),
+                rtc::Optional<float>(kComplexityDecreasingEncodeUsage),
+                kInitialComplexity - 1);
+}
+
+TEST(ComplexityControllerTest, DoNotExceedInitialComplexity) {
+  SimulatedClock clock(kClockInitialTimeMs);
+  auto controller = CreateController(&clock);
+  CheckDecision(controller.get(),
+                rtc::Optional<float>(kComplexityIncreasingEncodeUsage),
+                kInitialComplexity);
+}
+
+TEST(ComplexityControllerTest, WaitForUpdateIntervalBetweenChanges) {
+  SimulatedClock clock(kClockInitialTimeMs);
+  auto controller = CreateController(&clock);
+  const rtc::Optional<float> kHighUsage(kComplexityDecreasingEncodeUsage);
+  CheckDecision(controller.get(), kHighUsage, kInitialComplexity - 1);
+  clock.AdvanceTimeMilliseconds(kMinUpdateIntervalMs - 1);
+  CheckDecision(controller.get(), kHighUsage, kInitialComplexity - 1);
+  clock.AdvanceTimeMilliseconds(1);
+  CheckDecision(controller.get(), kHighUsage, kInitialComplexity - 2);
+}
+
+TEST(ComplexityControllerTest, CheckBehaviorOnChangingEncodeUsage) {
+  SimulatedClock clock(kClockInitialTimeMs);
+  auto controller = CreateController(&clock);
+  const rtc::Optional<float> kHighUsage(kComplexityDecreasingEncodeUsage);
+  const rtc::Optional<float> kLowUsage(kComplexityIncreasingEncodeUsage);
+  CheckDecision(controller.get(), kHighUsage, 8);
+  clock.AdvanceTimeMilliseconds(kMinUpdateIntervalMs);
+  CheckDecision(controller.get(), kHighUsage, 7);
+  clock.AdvanceTimeMilliseconds(kMinUpdateIntervalMs);
+  // Already at the minimum complexity.
+  CheckDecision(controller.get(), kHighUsage, kMinComplexity);
+  CheckDecision(controller.get(), kLowUsage, 8);
+  clock.AdvanceTimeMilliseconds(kMinUpdateIntervalMs);
+  CheckDecision(controller.get(), rtc::Optional<float>(kMediumEncodeUsage), 8);
+  CheckDecision(controller.get(), kLowUsage, 9);
+}
+
+}  // namespace webrtc
@@ -26,6 +26,8 @@ class Controller {
     rtc::Optional<int> target_audio_bitrate_bps;
     rtc::Optional<int> rtt_ms;
     rtc::Optional<size_t> overhead_bytes_per_packet;
+    // Time spent encoding as a fraction of the duration of the encoded audio.
+    rtc::Optional<float> encode_usage;
   };
 
   virtual ~Controller() = default;
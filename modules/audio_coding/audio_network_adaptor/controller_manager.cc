@@ -10,12 +10,15 @@
 
 #include "webrtc/modules/audio_coding/audio_network_adaptor/controller_manager.h"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <utility>
 
 #include "webrtc/base/ignore_wundef.h"
 #include "webrtc/modules/audio_coding/audio_network_adaptor/bitrate_controller.h"
 #include "webrtc/modules/audio_coding/audio_network_adaptor/channel_controller.h"
+#include "webrtc/modules/audio_coding/audio_network_adaptor/complexity_controller.h"
 #include "webrtc/modules/audio_coding/audio_network_adaptor/dtx_controller.h"
 #include "webrtc/modules/audio_coding/audio_network_adaptor/fec_controller.h"
 #include "webrtc/modules/audio_coding/audio_network_adaptor/frame_length_controller.h"
@@ -35,6 +38,11 @@ namespace webrtc {
 
 namespace {
 
+// Granularity of the network metrics buckets, see
+// ControllerManagerImpl::MetricsBucket.
+constexpr int kUplinkBandwidthBucketBps = 1000;
+constexpr float kUplinkPacketLossBucket = 0.001f;
+
 #ifdef WEBRTC_AUDIO_NETWORK_ADAPTOR_DEBUG_DUMP
 
 std::unique_ptr<FecController> CreateFecController(
@@ -126,6 +134,25 @@ std::unique_ptr<BitrateController> CreateBitrateController(
   return std::unique_ptr<BitrateController>(new BitrateController(
       BitrateController::Config(initial_bitrate_bps, initial_frame_length_ms)));
 }
+
+std::unique_ptr<ComplexityController> CreateComplexityController(
+    const audio_network_adaptor::config::ComplexityController& config,
+    int initial_complexity,
+    const Clock* clock) {
+  RTC_CHECK(config.has_min_complexity());
+  RTC_CHECK(config.has_complexity_decreasing_encode_usage());
+  RTC_CHECK(config.has_complexity_increasing_encode_usage());
+  RTC_CHECK(config.has_min_update_interval_ms());
+
+  // The complexity the encoder was configured with is the most it may use.
+  return std::unique_ptr<ComplexityController>(
+      new ComplexityController(ComplexityController::Config(
+          initial_complexity,
+          std::min(config.min_complexity(), initial_complexity),
+          initial_complexity, config.complexity_decreasing_encode_usage(),
+          config.complexity_increasing_encode_usage(),
+          config.min_update_interval_ms(), clock)));
+}
 #endif  // WEBRTC_AUDIO_NETWORK_ADAPTOR_DEBUG_DUMP
 
 }  // namespace
@@ -148,6 +175,7 @@ std::unique_ptr<ControllerManager> ControllerManagerImpl::Create(
     int initial_bitrate_bps,
     bool initial_fec_enabled,
     bool initial_dtx_enabled,
+    int initial_complexity,
     const Clock* clock) {
 #ifdef WEBRTC_AUDIO_NETWORK_ADAPTOR_DEBUG_DUMP
   audio_network_adaptor::config::ControllerManager controller_manager_config;
@@ -182,6 +210,11 @@ std::unique_ptr<ControllerManager> ControllerManagerImpl::Create(
         controller = CreateBitrateController(initial_bitrate_bps,
                                              initial_frame_length_ms);
         break;
+      case audio_network_adaptor::config::Controller::kComplexityController:
+        controller = CreateComplexityController(
+            controller_config.complexity_controller(), initial_complexity,
+            clock);
+        break;
       default:
         RTC_NOTREACHED();
     }
@@ -224,19 +257,23 @@ ControllerManagerImpl::ControllerManagerImpl(
       controllers_(std::move(controllers)),
       last_reordering_time_ms_(rtc::Optional<int64_t>()),
       last_scoring_point_(0, 0.0) {
-  for (auto& controller : controllers_)
+  for (auto& controller : controllers_) {
     default_sorted_controllers_.push_back(controller.get());
-  sorted_controllers_ = default_sorted_controllers_;
-  for (auto& controller_point : chracteristic_points) {
-    controller_scoring_points_.insert(std::make_pair(
-        controller_point.first, ScoringPoint(controller_point.second.first,
-                                             controller_point.second.second)));
+    auto point = chracteristic_points.find(controller.get());
+    controller_scoring_points_.push_back(
+        point == chracteristic_points.end()
+            ? rtc::Optional<ScoringPoint>()
+            : rtc::Optional<ScoringPoint>(ScoringPoint(
+                  point->second.first, point->second.second)));
   }
+  sorted_controllers_ = default_sorted_controllers_;
+  candidate_controllers_.reserve(default_sorted_controllers_.size());
+  candidate_distances_.reserve(default_sorted_controllers_.size());
 }
 
 ControllerManagerImpl::~ControllerManagerImpl() = default;
 
-std::vector<Controller*> ControllerManagerImpl::GetSortedControllers(
+const std::vector<Controller*>& ControllerManagerImpl::GetSortedControllers(
     const Controller::NetworkMetrics& metrics) {
   int64_t now_ms = config_.clock->TimeInMilliseconds();
 
@@ -247,6 +284,13 @@ std::vector<Controller*> ControllerManagerImpl::GetSortedControllers(
       now_ms - *last_reordering_time_ms_ < config_.min_reordering_time_ms)
     return sorted_controllers_;
 
+  const MetricsBucket bucket = {
+      *metrics.uplink_bandwidth_bps / kUplinkBandwidthBucketBps,
+      static_cast<int>(*metrics.uplink_packet_loss_fraction /
+                       kUplinkPacketLossBucket)};
+  if (last_sorted_bucket_ && *last_sorted_bucket_ == bucket)
+    return sorted_controllers_;
+
   ScoringPoint scoring_point(*metrics.uplink_bandwidth_bps,
                              *metrics.uplink_packet_loss_fraction);
 
@@ -255,6 +299,8 @@ std::vector<Controller*> ControllerManagerImpl::GetSortedControllers(
           config_.min_reordering_squared_distance)
     return sorted_controllers_;
 
+  last_sorted_bucket_ = rtc::Optional<MetricsBucket>(bucket);
+
   // Sort controllers according to the distances of |scoring_point| to the
   // characteristic scoring points of controllers.
   //
@@ -263,25 +309,29 @@ std::vector<Controller*> ControllerManagerImpl::GetSortedControllers(
   // 1) they are less important than any controller that has a scoring point,
   // 2) they are equally important to any controller that has no scoring point,
   //    and their relative order will follow |default_sorted_controllers_|.
-  std::vector<Controller*> sorted_controllers(default_sorted_controllers_);
-  std::stable_sort(
-      sorted_controllers.begin(), sorted_controllers.end(),
-      [this, &scoring_point](const Controller* lhs, const Controller* rhs) {
-        auto lhs_scoring_point = controller_scoring_points_.find(lhs);
-        auto rhs_scoring_point = controller_scoring_points_.find(rhs);
-
-        if (lhs_scoring_point == controller_scoring_points_.end())
-          return false;
-
-        if (rhs_scoring_point == controller_scoring_points_.end())
-          return true;
-
-        return lhs_scoring_point->second.SquaredDistanceTo(scoring_point) <
-               rhs_scoring_point->second.SquaredDistanceTo(scoring_point);
-      });
+  //
+  // There are only a handful of controllers, so a stable insertion sort on
+  // precomputed distances is used, which does not allocate.
+  candidate_controllers_.clear();
+  candidate_distances_.clear();
+  for (size_t i = 0; i < default_sorted_controllers_.size(); ++i) {
+    const float distance =
+        controller_scoring_points_[i]
+            ? controller_scoring_points_[i]->SquaredDistanceTo(scoring_point)
+            : std::numeric_limits<float>::infinity();
+    size_t j = candidate_distances_.size();
+    candidate_controllers_.push_back(nullptr);
+    candidate_distances_.push_back(0.0f);
+    for (; j > 0 && distance < candidate_distances_[j - 1]; --j) {
+      candidate_controllers_[j] = candidate_controllers_[j - 1];
+      candidate_distances_[j] = candidate_distances_[j - 1];
+    }
+    candidate_controllers_[j] = default_sorted_controllers_[i];
+    candidate_distances_[j] = distance;
+  }
 
-  if (sorted_controllers_ != sorted_controllers) {
-    sorted_controllers_ = sorted_controllers;
+  if (sorted_controllers_ != candidate_controllers_) {
+    sorted_controllers_.swap(candidate_controllers_);
     last_reordering_time_ms_ = rtc::Optional<int64_t>(now_ms);
     last_scoring_point_ = scoring_point;
   }
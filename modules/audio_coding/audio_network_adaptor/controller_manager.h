@@ -26,8 +26,9 @@ class ControllerManager {
  public:
   virtual ~ControllerManager() = default;
 
-  // Sort controllers based on their significance.
-  virtual std::vector<Controller*> GetSortedControllers(
+  // Sort controllers based on their significance. The returned reference
+  // stays valid until the next call.
+  virtual const std::vector<Controller*>& GetSortedControllers(
       const Controller::NetworkMetrics& metrics) = 0;
 
   virtual std::vector<Controller*> GetControllers() const = 0;
@@ -57,6 +58,7 @@ class ControllerManagerImpl final : public ControllerManager {
       int initial_bitrate_bps,
       bool initial_fec_enabled,
       bool initial_dtx_enabled,
+      int initial_complexity,
       const Clock* clock);
 
   explicit ControllerManagerImpl(const Config& config);
@@ -71,7 +73,7 @@ class ControllerManagerImpl final : public ControllerManager {
   ~ControllerManagerImpl() override;
 
   // Sort controllers based on their significance.
-  std::vector<Controller*> GetSortedControllers(
+  const std::vector<Controller*>& GetSortedControllers(
       const Controller::NetworkMetrics& metrics) override;
 
   std::vector<Controller*> GetControllers() const override;
@@ -89,6 +91,18 @@ class ControllerManagerImpl final : public ControllerManager {
     float uplink_packet_loss_fraction;
   };
 
+  // Quantized network metrics. Controllers are only re-sorted when the bucket
+  // of the network metrics differs from that of the last sorting, since the
+  // ANA is queried far more often than the network conditions change.
+  struct MetricsBucket {
+    bool operator==(const MetricsBucket& other) const {
+      return uplink_bandwidth == other.uplink_bandwidth &&
+             uplink_packet_loss == other.uplink_packet_loss;
+    }
+    int uplink_bandwidth;
+    int uplink_packet_loss;
+  };
+
   const Config config_;
 
   std::vector<std::unique_ptr<Controller>> controllers_;
@@ -100,9 +114,16 @@ class ControllerManagerImpl final : public ControllerManager {
 
   std::vector<Controller*> sorted_controllers_;
 
-  // |scoring_points_| saves the characteristic scoring points of various
-  // controllers.
-  std::map<const Controller*, ScoringPoint> controller_scoring_points_;
+  // The characteristic scoring points of the controllers, in the order of
+  // |default_sorted_controllers_|. Controllers without a scoring point have
+  // none.
+  std::vector<rtc::Optional<ScoringPoint>> controller_scoring_points_;
+
+  // Scratch buffers for sorting, kept between calls to avoid allocations.
+  std::vector<Controller*> candidate_controllers_;
+  std::vector<float> candidate_distances_;
+
+  rtc::Optional<MetricsBucket> last_sorted_bucket_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(ControllerManagerImpl);
 };
@@ -8,9 +8,12 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <stdio.h>
+
 #include <utility>
 
 #include "webrtc/base/ignore_wundef.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/modules/audio_coding/audio_network_adaptor/controller_manager.h"
 #include "webrtc/modules/audio_coding/audio_network_adaptor/mock/mock_controller.h"
 #include "webrtc/system_wrappers/include/clock.h"
@@ -201,6 +204,49 @@ TEST(ControllerManagerTest, DoNotReorderIfNetworkMetricsChangeTooSmall) {
       {kNumControllers - 2, kNumControllers - 1, 0, 1});
 }
 
+TEST(ControllerManagerTest, KeepOrderWithinNetworkMetricsBucket) {
+  auto states = CreateControllerManager();
+  constexpr int kBandwidthBps =
+      (kChracteristicBandwithBps[0] + kChracteristicBandwithBps[1]) / 2;
+  constexpr float kPacketLossFraction = (kChracteristicPacketLossFraction[0] +
+                                         kChracteristicPacketLossFraction[1]) /
+                                        2.0f;
+  CheckControllersOrder(&states, rtc::Optional<int>(kBandwidthBps),
+                        rtc::Optional<float>(kPacketLossFraction),
+                        {kNumControllers - 2, kNumControllers - 1, 0, 1});
+  states.simulated_clock->AdvanceTimeMilliseconds(kMinReorderingTimeMs);
+  // The same network metrics are not re-sorted, and do not change the order.
+  CheckControllersOrder(&states, rtc::Optional<int>(kBandwidthBps),
+                        rtc::Optional<float>(kPacketLossFraction),
+                        {kNumControllers - 2, kNumControllers - 1, 0, 1});
+  // Leaving the bucket still reorders.
+  CheckControllersOrder(
+      &states, rtc::Optional<int>(kBandwidthBps - kMinBandwithChangeBps - 1),
+      rtc::Optional<float>(kPacketLossFraction),
+      {kNumControllers - 2, kNumControllers - 1, 1, 0});
+}
+
+// Benchmark for GetSortedControllers() with network metrics that jitter
+// slightly around a fixed point, as reported by a typical client every 100 ms.
+TEST(ControllerManagerTest, GetSortedControllersBenchmark) {
+  auto states = CreateControllerManager();
+  constexpr int kIterations = 100000;
+  Controller::NetworkMetrics metrics;
+  int64_t start = rtc::TimeNanos();
+  for (int i = 0; i < kIterations; ++i) {
+    metrics.uplink_bandwidth_bps = rtc::Optional<int>(32000 + i % 4 * 100);
+    metrics.uplink_packet_loss_fraction =
+        rtc::Optional<float>(0.05f + i % 3 * 0.0002f);
+    states.simulated_clock->AdvanceTimeMilliseconds(100);
+    EXPECT_EQ(kNumControllers,
+              states.controller_manager->GetSortedControllers(metrics).size());
+  }
+  double total_time_us =
+      (rtc::TimeNanos() - start) / rtc::kNumNanosecsPerMicrosec;
+  printf("GetSortedControllers took %.3fus per call.\n",
+         total_time_us / kIterations);
+}
+
 #ifdef WEBRTC_AUDIO_NETWORK_ADAPTOR_DEBUG_DUMP
 
 namespace {
@@ -268,6 +314,7 @@ void AddFrameLengthControllerConfig(
 constexpr int kInitialBitrateBps = 24000;
 constexpr size_t kIntialChannelsToEncode = 1;
 constexpr bool kInitialDtxEnabled = true;
+constexpr int kInitialComplexity = 9;
 constexpr bool kInitialFecEnabled = true;
 constexpr int kInitialFrameLengthMs = 60;
 
@@ -280,7 +327,8 @@ ControllerManagerStates CreateControllerManager(
   states.controller_manager = ControllerManagerImpl::Create(
       config_string, kNumEncoderChannels, encoder_frame_lengths_ms,
       kIntialChannelsToEncode, kInitialFrameLengthMs, kInitialBitrateBps,
-      kInitialFecEnabled, kInitialDtxEnabled, states.simulated_clock.get());
+      kInitialFecEnabled, kInitialDtxEnabled, kInitialComplexity,
+      states.simulated_clock.get());
   return states;
 }
 
@@ -34,6 +34,9 @@ class AudioNetworkAdaptor {
     // better use of the bandwidth. |num_channels| sets the number of channels
     // to encode.
     rtc::Optional<size_t> num_channels;
+
+    // Encoder complexity, for encoders that can trade quality for CPU.
+    rtc::Optional<int> complexity;
   };
 
   virtual ~AudioNetworkAdaptor() = default;
@@ -49,6 +52,9 @@ class AudioNetworkAdaptor {
 
   virtual void SetOverhead(size_t overhead_bytes_per_packet) = 0;
 
+  // Time spent encoding as a fraction of the duration of the encoded audio.
+  virtual void SetEncodeUsage(float encode_usage) = 0;
+
   virtual EncoderRuntimeConfig GetEncoderRuntimeConfig() = 0;
 
   virtual void StartDebugDump(FILE* file_handle) = 0;
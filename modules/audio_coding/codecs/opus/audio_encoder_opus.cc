@@ -37,6 +37,10 @@ constexpr int kSupportedFrameLengths[] = {20, 60};
 // of -1.0 / ln(0.9999) = 10000 ms.
 constexpr float kAlphaForPacketLossFractionSmoother = 0.9999f;
 
+// Amount of encoded audio over which the encode usage is measured before it is
+// reported to the audio network adaptor.
+constexpr int kEncodeUsageUpdateIntervalMs = 1000;
+
 AudioEncoderOpus::Config CreateConfig(const CodecInst& codec_inst) {
   AudioEncoderOpus::Config config;
   config.frame_size_ms = rtc::CheckedDivExact(codec_inst.pacsize, 48);
@@ -176,6 +180,8 @@ AudioEncoderOpus::AudioEncoderOpus(
     std::unique_ptr<SmoothingFilter> bitrate_smoother)
     : packet_loss_rate_(0.0),
       inst_(nullptr),
+      encode_time_us_(0),
+      encoded_audio_ms_(0),
       packet_loss_fraction_smoother_(new PacketLossFractionSmoother(
           config.clock)),
       audio_network_adaptor_creator_(
@@ -279,6 +285,8 @@ bool AudioEncoderOpus::EnableAudioNetworkAdaptor(
 
 void AudioEncoderOpus::DisableAudioNetworkAdaptor() {
   audio_network_adaptor_.reset(nullptr);
+  encode_time_us_ = 0;
+  encoded_audio_ms_ = 0;
 }
 
 void AudioEncoderOpus::OnReceivedUplinkPacketLossFraction(
@@ -386,6 +394,9 @@ AudioEncoder::EncodedInfo AudioEncoderOpus::EncodeImpl(
                Num10msFramesPerPacket() * SamplesPer10msFrame());
 
   const size_t max_encoded_bytes = SufficientOutputBufferSize();
+  // Encode time is only needed by the audio network adaptor.
+  const int64_t encode_start_us =
+      audio_network_adaptor_ ? rtc::TimeMicros() : 0;
   EncodedInfo info;
   info.encoded_bytes =
       encoded->AppendData(
@@ -403,6 +414,12 @@ AudioEncoder::EncodedInfo AudioEncoderOpus::EncodeImpl(
           });
   input_buffer_.clear();
 
+  if (audio_network_adaptor_) {
+    encode_time_us_ += rtc::TimeMicros() - encode_start_us;
+    encoded_audio_ms_ += config_.frame_size_ms;
+    MaybeUpdateEncodeUsage();
+  }
+
   // Will use new packet size for next encoding.
   config_.frame_size_ms = next_frame_length_ms_;
 
@@ -508,6 +525,13 @@ void AudioEncoderOpus::SetTargetBitrate(int bits_per_second) {
   }
 }
 
+void AudioEncoderOpus::SetComplexity(int complexity) {
+  if (complexity_ == complexity)
+    return;
+  complexity_ = complexity;
+  RTC_CHECK_EQ(0, WebRtcOpus_SetComplexity(inst_, complexity_));
+}
+
 void AudioEncoderOpus::ApplyAudioNetworkAdaptor() {
   auto config = audio_network_adaptor_->GetEncoderRuntimeConfig();
   RTC_DCHECK(!config.frame_length_ms || *config.frame_length_ms == 20 ||
@@ -525,6 +549,9 @@ void AudioEncoderOpus::ApplyAudioNetworkAdaptor() {
     SetDtx(*config.enable_dtx);
   if (config.num_channels)
     SetNumChannelsToEncode(*config.num_channels);
+  // Applied after the bitrate, which may otherwise switch the complexity.
+  if (config.complexity)
+    SetComplexity(*config.complexity);
 }
 
 std::unique_ptr<AudioNetworkAdaptor>
@@ -539,7 +566,8 @@ AudioEncoderOpus::DefaultAudioNetworkAdaptorCreator(
       config, ControllerManagerImpl::Create(
                   config_string, NumChannels(), supported_frame_lengths_ms(),
                   num_channels_to_encode_, next_frame_length_ms_,
-                  GetTargetBitrate(), config_.fec_enabled, GetDtx(), clock)));
+                  GetTargetBitrate(), config_.fec_enabled, GetDtx(),
+                  complexity_, clock)));
 }
 
 void AudioEncoderOpus::MaybeUpdateUplinkBandwidth() {
@@ -556,4 +584,16 @@ void AudioEncoderOpus::MaybeUpdateUplinkBandwidth() {
   }
 }
 
+void AudioEncoderOpus::MaybeUpdateEncodeUsage() {
+  RTC_DCHECK(audio_network_adaptor_);
+  if (encoded_audio_ms_ < kEncodeUsageUpdateIntervalMs)
+    return;
+  audio_network_adaptor_->SetEncodeUsage(
+      static_cast<float>(encode_time_us_) /
+      (encoded_audio_ms_ * rtc::kNumMicrosecsPerMillisec));
+  encode_time_us_ = 0;
+  encoded_audio_ms_ = 0;
+  ApplyAudioNetworkAdaptor();
+}
+
 }  // namespace webrtc
@@ -147,6 +147,7 @@ class AudioEncoderOpus final : public AudioEncoder {
   void SetFrameLength(int frame_length_ms);
   void SetNumChannelsToEncode(size_t num_channels_to_encode);
   void SetProjectedPacketLossRate(float fraction);
+  void SetComplexity(int complexity);
 
   // TODO(minyue): remove "override" when we can deprecate
   // |AudioEncoder::SetTargetBitrate|.
@@ -159,6 +160,9 @@ class AudioEncoderOpus final : public AudioEncoder {
       const Clock* clock) const;
 
   void MaybeUpdateUplinkBandwidth();
+  // Reports the encode usage to the audio network adaptor once enough audio
+  // has been encoded since the last report.
+  void MaybeUpdateEncodeUsage();
 
   Config config_;
   float packet_loss_rate_;
@@ -168,6 +172,8 @@ class AudioEncoderOpus final : public AudioEncoder {
   size_t num_channels_to_encode_;
   int next_frame_length_ms_;
   int complexity_;
+  int64_t encode_time_us_;
+  int encoded_audio_ms_;
   std::unique_ptr<PacketLossFractionSmoother> packet_loss_fraction_smoother_;
   AudioNetworkAdaptorCreator audio_network_adaptor_creator_;
   std::unique_ptr<AudioNetworkAdaptor> audio_network_adaptor_;
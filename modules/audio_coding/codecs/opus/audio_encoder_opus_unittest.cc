@@ -499,4 +499,29 @@ TEST(AudioEncoderOpusTest, UpdateUplinkBandwidthInAudioNetworkAdaptor) {
   }
 }
 
+TEST(AudioEncoderOpusTest, ReportEncodeUsageToAudioNetworkAdaptor) {
+  rtc::ScopedFakeClock fake_clock;
+  auto states = CreateCodec(2);
+  states.encoder->EnableAudioNetworkAdaptor("", nullptr, nullptr);
+  std::array<int16_t, 480 * 2> audio;
+  audio.fill(0);
+  rtc::Buffer encoded;
+  EXPECT_CALL(*states.mock_bitrate_smoother, GetAverage())
+      .WillOnce(Return(rtc::Optional<float>()));
+
+  // The usage is reported once per second of encoded audio. The fake clock
+  // does not advance, so encoding appears to take no time.
+  constexpr int kNum10msFramesPerSecond = 100;
+  EXPECT_CALL(**states.mock_audio_network_adaptor, SetEncodeUsage(0.0f))
+      .Times(0);
+  for (int i = 0; i < kNum10msFramesPerSecond - 1; ++i) {
+    states.encoder->Encode(
+        0, rtc::ArrayView<const int16_t>(audio.data(), audio.size()), &encoded);
+  }
+
+  EXPECT_CALL(**states.mock_audio_network_adaptor, SetEncodeUsage(0.0f));
+  states.encoder->Encode(
+      0, rtc::ArrayView<const int16_t>(audio.data(), audio.size()), &encoded);
+}
+
 }  // namespace webrtc
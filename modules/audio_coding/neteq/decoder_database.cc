@@ -22,7 +22,9 @@ DecoderDatabase::DecoderDatabase(
     const rtc::scoped_refptr<AudioDecoderFactory>& decoder_factory)
     : active_decoder_type_(-1),
       active_cng_decoder_type_(-1),
-      decoder_factory_(decoder_factory) {}
+      decoder_factory_(decoder_factory) {
+  decoder_table_.fill(nullptr);
+}
 
 DecoderDatabase::~DecoderDatabase() = default;
 
@@ -120,6 +122,7 @@ int DecoderDatabase::Size() const { return static_cast<int>(decoders_.size()); }
 
 void DecoderDatabase::Reset() {
   decoders_.clear();
+  decoder_table_.fill(nullptr);
   active_decoder_type_ = -1;
   active_cng_decoder_type_ = -1;
 }
@@ -147,6 +150,7 @@ int DecoderDatabase::RegisterPayload(uint8_t rtp_payload_type,
     // Database already contains a decoder with type |rtp_payload_type|.
     return kDecoderExists;
   }
+  decoder_table_[rtp_payload_type] = &ret.first->second;
   return kOK;
 }
 
@@ -161,6 +165,7 @@ int DecoderDatabase::RegisterPayload(int rtp_payload_type,
     // Database already contains a decoder with type |rtp_payload_type|.
     return kDecoderExists;
   }
+  decoder_table_[rtp_payload_type] = &ret.first->second;
   return kOK;
 }
 
@@ -186,6 +191,7 @@ int DecoderDatabase::InsertExternal(uint8_t rtp_payload_type,
     // Database already contains a decoder with type |rtp_payload_type|.
     return kDecoderExists;
   }
+  decoder_table_[rtp_payload_type] = &ret.first->second;
   return kOK;
 }
 
@@ -194,6 +200,7 @@ int DecoderDatabase::Remove(uint8_t rtp_payload_type) {
     // No decoder with that |rtp_payload_type|.
     return kDecoderNotFound;
   }
+  decoder_table_[rtp_payload_type] = nullptr;
   if (active_decoder_type_ == rtp_payload_type) {
     active_decoder_type_ = -1;  // No active decoder.
   }
@@ -205,18 +212,18 @@ int DecoderDatabase::Remove(uint8_t rtp_payload_type) {
 
 void DecoderDatabase::RemoveAll() {
   decoders_.clear();
+  decoder_table_.fill(nullptr);
   active_decoder_type_ = -1;      // No active decoder.
   active_cng_decoder_type_ = -1;  // No active CNG decoder.
 }
 
 const DecoderDatabase::DecoderInfo* DecoderDatabase::GetDecoderInfo(
     uint8_t rtp_payload_type) const {
-  DecoderMap::const_iterator it = decoders_.find(rtp_payload_type);
-  if (it == decoders_.end()) {
-    // Decoder not found.
+  if (rtp_payload_type >= decoder_table_.size()) {
+    // Not a valid RTP payload type, so it cannot be registered.
     return NULL;
   }
-  return &it->second;
+  return decoder_table_[rtp_payload_type];
 }
 
 int DecoderDatabase::SetActiveDecoder(uint8_t rtp_payload_type,
@@ -11,6 +11,7 @@
 #ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ_DECODER_DATABASE_H_
 #define WEBRTC_MODULES_AUDIO_CODING_NETEQ_DECODER_DATABASE_H_
 
+#include <array>
 #include <map>
 #include <memory>
 #include <string>
@@ -228,6 +229,10 @@ class DecoderDatabase {
   typedef std::map<uint8_t, DecoderInfo> DecoderMap;
 
   DecoderMap decoders_;
+  // Direct index into |decoders_| by payload type, so that the per packet
+  // lookups don't walk the map. Map nodes are stable, so the pointers stay
+  // valid until the entry is removed.
+  std::array<const DecoderInfo*, 128> decoder_table_;
   int active_decoder_type_;
   int active_cng_decoder_type_;
   mutable std::unique_ptr<ComfortNoiseDecoder> active_cng_decoder_;
@@ -94,6 +94,11 @@ class NetEq {
     NetEqPlayoutMode playout_mode;
     bool enable_fast_accelerate;
     bool enable_muted_state = false;
+    // If set, comfort noise periods (RFC 3389 CNG or codec-internal CNG such
+    // as Opus DTX) are output as muted frames once the first frame of comfort
+    // noise has been generated, until the next packet is due. This saves the
+    // cost of generating the noise when the output is not listened to.
+    bool enable_muted_comfort_noise = false;
   };
 
   enum ReturnCodes {
@@ -153,7 +158,8 @@ class NetEq {
   // If muted state is enabled (through Config::enable_muted_state), |muted|
   // may be set to true after a prolonged expand period. When this happens, the
   // |data_| in |audio_frame| is not written, but should be interpreted as being
-  // all zeros.
+  // all zeros. The same applies during comfort noise periods if
+  // Config::enable_muted_comfort_noise is set.
   // Returns kOK on success, or kFail in case of an error.
   virtual int GetAudio(AudioFrame* audio_frame, bool* muted) = 0;
 
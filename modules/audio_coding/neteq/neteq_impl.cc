@@ -105,7 +105,8 @@ NetEqImpl::NetEqImpl(const NetEq::Config& config,
       playout_mode_(config.playout_mode),
       enable_fast_accelerate_(config.enable_fast_accelerate),
       nack_enabled_(false),
-      enable_muted_state_(config.enable_muted_state) {
+      enable_muted_state_(config.enable_muted_state),
+      enable_muted_comfort_noise_(config.enable_muted_comfort_noise) {
   LOG(LS_INFO) << "NetEq config: " << config.ToString();
   int fs = config.sample_rate_hz;
   if (fs != 8000 && fs != 16000 && fs != 32000 && fs != 48000) {
@@ -879,6 +880,28 @@ int NetEqImpl::GetAudioInternal(AudioFrame* audio_frame, bool* muted) {
     return return_value;
   }
 
+  // Check for muted comfort noise. The decision logic still runs on every
+  // call, so that the next packet is picked up on time, but the noise itself
+  // is not generated. The |sync_buffer_| timestamps do not advance during
+  // comfort noise anyway; the elapsed time is tracked by
+  // |generated_noise_stopwatch_|.
+  if (enable_muted_comfort_noise_ && !play_dtmf &&
+      ((operation == kRfc3389CngNoPacket && last_mode_ == kModeRfc3389Cng) ||
+       (operation == kCodecInternalCng &&
+        last_mode_ == kModeCodecInternalCng))) {
+    last_operation_ = operation;
+    audio_frame->sample_rate_hz_ = fs_hz_;
+    audio_frame->samples_per_channel_ = output_size_samples_;
+    audio_frame->timestamp_ =
+        first_packet_
+            ? 0
+            : timestamp_scaler_->ToExternal(playout_timestamp_) -
+                  static_cast<uint32_t>(audio_frame->samples_per_channel_);
+    audio_frame->num_channels_ = sync_buffer_->Channels();
+    *muted = true;
+    return 0;
+  }
+
   AudioDecoder::SpeechType speech_type;
   int length = 0;
   int decode_return_value = Decode(&packet_list, &operation,
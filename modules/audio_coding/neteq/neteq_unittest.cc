@@ -1468,6 +1468,58 @@ TEST_F(NetEqDecodingTestWithMutedState, RecoverAfterExtendedCngWithoutPackets) {
   GetAudioUntilNormal();
 }
 
+class NetEqDecodingTestWithMutedComfortNoise
+    : public NetEqDecodingTestWithMutedState {
+ public:
+  NetEqDecodingTestWithMutedComfortNoise() {
+    config_.enable_muted_comfort_noise = true;
+  }
+};
+
+// Verifies that only the first frame of a comfort noise period is generated,
+// and that NetEq goes back to normal when speech resumes.
+TEST_F(NetEqDecodingTestWithMutedComfortNoise, MuteCngWithoutPackets) {
+  // Insert one CNG packet.
+  InsertCngPacket(0);
+
+  bool muted = false;
+  EXPECT_EQ(0, neteq_->GetAudio(&out_frame_, &muted));
+  EXPECT_FALSE(muted);
+  EXPECT_EQ(AudioFrame::kCNG, out_frame_.speech_type_);
+
+  AudioFrame new_frame;
+  for (auto& d : new_frame.data_) {
+    d = 17;
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(0, neteq_->GetAudio(&new_frame, &muted));
+    ASSERT_TRUE(muted);
+    ++counter_;
+  }
+  // Muted frames are not written, but their parameters are correct.
+  for (auto d : new_frame.data_) {
+    EXPECT_EQ(17, d);
+  }
+  EXPECT_EQ(AudioFrame::kCNG, new_frame.speech_type_);
+  EXPECT_EQ(out_frame_.samples_per_channel_, new_frame.samples_per_channel_);
+  EXPECT_EQ(out_frame_.sample_rate_hz_, new_frame.sample_rate_hz_);
+  EXPECT_EQ(out_frame_.num_channels_, new_frame.num_channels_);
+
+  // Insert new data. Timestamp is corrected for the time elapsed since the last
+  // packet. Verify that normal operation resumes.
+  InsertPacket(kSamples * counter_);
+  GetAudioUntilNormal();
+}
+
+// Verifies that comfort noise is still generated without the config flag.
+TEST_F(NetEqDecodingTestWithMutedState, DoNotMuteCngByDefault) {
+  InsertCngPacket(0);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_FALSE(GetAudioReturnMuted());
+  }
+  EXPECT_EQ(AudioFrame::kCNG, out_frame_.speech_type_);
+}
+
 class NetEqDecodingTestTwoInstances : public NetEqDecodingTest {
  public:
   NetEqDecodingTestTwoInstances() : NetEqDecodingTest() {}
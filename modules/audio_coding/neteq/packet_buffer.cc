@@ -8,13 +8,14 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
-// This is the implementation of the PacketBuffer class. It is mostly based on
-// an STL list. The list is kept sorted at all times so that the next packet to
-// decode is at the beginning of the list.
+// This is the implementation of the PacketBuffer class. It is based on a ring
+// of packets with room for the maximum number of packets in the buffer. The
+// ring is kept sorted at all times so that the next packet to decode is at its
+// front.
 
 #include "webrtc/modules/audio_coding/neteq/packet_buffer.h"
 
-#include <algorithm>  // find_if()
+#include <algorithm>
 
 #include "webrtc/base/logging.h"
 #include "webrtc/modules/audio_coding/codecs/audio_decoder.h"
@@ -23,21 +24,6 @@
 
 namespace webrtc {
 namespace {
-// Predicate used when inserting packets in the buffer list.
-// Operator() returns true when |packet| goes before |new_packet|.
-class NewTimestampIsLarger {
- public:
-  explicit NewTimestampIsLarger(const Packet& new_packet)
-      : new_packet_(new_packet) {
-  }
-  bool operator()(const Packet& packet) {
-    return (new_packet_ >= packet);
-  }
-
- private:
-  const Packet& new_packet_;
-};
-
 // Returns true if both payload types are known to the decoder database, and
 // have the same sample rate.
 bool EqualSampleRates(uint8_t pt1,
@@ -51,7 +37,13 @@ bool EqualSampleRates(uint8_t pt1,
 
 PacketBuffer::PacketBuffer(size_t max_number_of_packets,
                            const TickTimer* tick_timer)
-    : max_number_of_packets_(max_number_of_packets), tick_timer_(tick_timer) {}
+    : max_number_of_packets_(max_number_of_packets),
+      // The buffer holds one packet even if |max_number_of_packets| is zero,
+      // since it's flushed before inserting a packet when full.
+      buffer_(std::max<size_t>(max_number_of_packets, 1)),
+      first_(0),
+      size_(0),
+      tick_timer_(tick_timer) {}
 
 // Destructor. All packets in the buffer will be destroyed.
 PacketBuffer::~PacketBuffer() {
@@ -60,11 +52,14 @@ PacketBuffer::~PacketBuffer() {
 
 // Flush the buffer. All packets in the buffer will be destroyed.
 void PacketBuffer::Flush() {
-  buffer_.clear();
+  for (size_t i = 0; i < size_; ++i)
+    PacketAt(i) = Packet();
+  first_ = 0;
+  size_ = 0;
 }
 
 bool PacketBuffer::Empty() const {
-  return buffer_.empty();
+  return size_ == 0;
 }
 
 int PacketBuffer::InsertPacket(Packet&& packet) {
@@ -80,35 +75,41 @@ int PacketBuffer::InsertPacket(Packet&& packet) {
 
   packet.waiting_time = tick_timer_->GetNewStopwatch();
 
-  if (buffer_.size() >= max_number_of_packets_) {
+  if (size_ >= max_number_of_packets_) {
     // Buffer is full. Flush it.
     Flush();
     LOG(LS_WARNING) << "Packet buffer flushed";
     return_val = kFlushed;
   }
 
-  // Get an iterator pointing to the place in the buffer where the new packet
-  // should be inserted. The list is searched from the back, since the most
-  // likely case is that the new packet should be near the end of the list.
-  PacketList::reverse_iterator rit = std::find_if(
-      buffer_.rbegin(), buffer_.rend(),
-      NewTimestampIsLarger(packet));
-
-  // The new packet is to be inserted to the right of |rit|. If it has the same
-  // timestamp as |rit|, which has a higher priority, do not insert the new
-  // packet to list.
-  if (rit != buffer_.rend() && packet.timestamp == rit->timestamp) {
+  // Find the index in the buffer where the new packet should be inserted. The
+  // buffer is searched from the back, since the most likely case is that the
+  // new packet should be near the end of the buffer.
+  size_t index = size_;
+  while (index > 0 && packet < PacketAt(index - 1))
+    --index;
+
+  // The new packet is to be inserted to the right of |index| - 1. If it has
+  // the same timestamp as that packet, which has a higher priority, do not
+  // insert the new packet to the buffer.
+  if (index > 0 && packet.timestamp == PacketAt(index - 1).timestamp) {
     return return_val;
   }
 
-  // The new packet is to be inserted to the left of |it|. If it has the same
-  // timestamp as |it|, which has a lower priority, replace |it| with the new
-  // packet.
-  PacketList::iterator it = rit.base();
-  if (it != buffer_.end() && packet.timestamp == it->timestamp) {
-    it = buffer_.erase(it);
+  // The new packet is to be inserted to the left of |index|. If it has the
+  // same timestamp as that packet, which has a lower priority, replace it with
+  // the new packet.
+  if (index < size_ && packet.timestamp == PacketAt(index).timestamp) {
+    PacketAt(index) = std::move(packet);
+    return return_val;
   }
-  buffer_.insert(it, std::move(packet));  // Insert the packet at that position.
+
+  // Make room for the packet by moving the later packets one slot back.
+  RTC_DCHECK_LT(size_, buffer_.size());
+  for (size_t i = size_; i > index; --i)
+    PacketAt(i) = std::move(PacketAt(i - 1));
+  PacketAt(index) = std::move(packet);
+  ++size_;
 
   return return_val;
 }
@@ -165,7 +166,7 @@ int PacketBuffer::NextTimestamp(uint32_t* next_timestamp) const {
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  *next_timestamp = buffer_.front().timestamp;
+  *next_timestamp = PacketAt(0).timestamp;
   return kOK;
 }
 
@@ -177,11 +178,11 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
   if (!next_timestamp) {
     return kInvalidPointer;
   }
-  PacketList::const_iterator it;
-  for (it = buffer_.begin(); it != buffer_.end(); ++it) {
-    if (it->timestamp >= timestamp) {
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = PacketAt(i);
+    if (packet.timestamp >= timestamp) {
       // Found a packet matching the search.
-      *next_timestamp = it->timestamp;
+      *next_timestamp = packet.timestamp;
       return kOK;
     }
   }
@@ -189,7 +190,7 @@ int PacketBuffer::NextHigherTimestamp(uint32_t timestamp,
 }
 
 const Packet* PacketBuffer::PeekNextPacket() const {
-  return buffer_.empty() ? nullptr : &buffer_.front();
+  return Empty() ? nullptr : &PacketAt(0);
 }
 
 rtc::Optional<Packet> PacketBuffer::GetNextPacket() {
@@ -198,10 +199,10 @@ rtc::Optional<Packet> PacketBuffer::GetNextPacket() {
     return rtc::Optional<Packet>();
   }
 
-  rtc::Optional<Packet> packet(std::move(buffer_.front()));
+  rtc::Optional<Packet> packet(std::move(PacketAt(0)));
   // Assert that the packet sanity checks in InsertPacket method works.
   RTC_DCHECK(!packet->empty());
-  buffer_.pop_front();
+  PopFront();
 
   return packet;
 }
@@ -211,15 +212,15 @@ int PacketBuffer::DiscardNextPacket() {
     return kBufferEmpty;
   }
   // Assert that the packet sanity checks in InsertPacket method works.
-  RTC_DCHECK(!buffer_.front().empty());
-  buffer_.pop_front();
+  RTC_DCHECK(!PacketAt(0).empty());
+  PopFront();
   return kOK;
 }
 
 int PacketBuffer::DiscardOldPackets(uint32_t timestamp_limit,
                                     uint32_t horizon_samples) {
-  while (!Empty() && timestamp_limit != buffer_.front().timestamp &&
-         IsObsoleteTimestamp(buffer_.front().timestamp, timestamp_limit,
+  while (!Empty() && timestamp_limit != PacketAt(0).timestamp &&
+         IsObsoleteTimestamp(PacketAt(0).timestamp, timestamp_limit,
                              horizon_samples)) {
     if (DiscardNextPacket() != kOK) {
       assert(false);  // Must be ok by design.
@@ -233,24 +234,29 @@ int PacketBuffer::DiscardAllOldPackets(uint32_t timestamp_limit) {
 }
 
 void PacketBuffer::DiscardPacketsWithPayloadType(uint8_t payload_type) {
-  for (auto it = buffer_.begin(); it != buffer_.end(); /* */) {
-    const Packet& packet = *it;
-    if (packet.payload_type == payload_type) {
-      it = buffer_.erase(it);
-    } else {
-      ++it;
-    }
+  // Move the packets to keep towards the front, in order.
+  size_t num_kept = 0;
+  for (size_t i = 0; i < size_; ++i) {
+    if (PacketAt(i).payload_type == payload_type)
+      continue;
+    if (num_kept != i)
+      PacketAt(num_kept) = std::move(PacketAt(i));
+    ++num_kept;
   }
+  for (size_t i = num_kept; i < size_; ++i)
+    PacketAt(i) = Packet();
+  size_ = num_kept;
 }
 
 size_t PacketBuffer::NumPacketsInBuffer() const {
-  return buffer_.size();
+  return size_;
 }
 
 size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
   size_t num_samples = 0;
   size_t last_duration = last_decoded_length;
-  for (const Packet& packet : buffer_) {
+  for (size_t i = 0; i < size_; ++i) {
+    const Packet& packet = PacketAt(i);
     if (packet.frame) {
       // TODO(hlundin): Verify that it's fine to count all packets and remove
       // this check.
@@ -268,8 +274,26 @@ size_t PacketBuffer::NumSamplesInBuffer(size_t last_decoded_length) const {
 }
 
 void PacketBuffer::BufferStat(int* num_packets, int* max_num_packets) const {
-  *num_packets = static_cast<int>(buffer_.size());
+  *num_packets = static_cast<int>(size_);
   *max_num_packets = static_cast<int>(max_number_of_packets_);
 }
 
+Packet& PacketBuffer::PacketAt(size_t index) {
+  RTC_DCHECK_LT(index, buffer_.size());
+  return buffer_[(first_ + index) % buffer_.size()];
+}
+
+const Packet& PacketBuffer::PacketAt(size_t index) const {
+  RTC_DCHECK_LT(index, buffer_.size());
+  return buffer_[(first_ + index) % buffer_.size()];
+}
+
+void PacketBuffer::PopFront() {
+  RTC_DCHECK_GT(size_, 0);
+  // Release the payload of the packet, if it wasn't moved out.
+  PacketAt(0) = Packet();
+  first_ = (first_ + 1) % buffer_.size();
+  --size_;
+}
+
 }  // namespace webrtc
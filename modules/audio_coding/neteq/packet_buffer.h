@@ -11,6 +11,8 @@
 #ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 #define WEBRTC_MODULES_AUDIO_CODING_NETEQ_PACKET_BUFFER_H_
 
+#include <vector>
+
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/optional.h"
 #include "webrtc/modules/audio_coding/neteq/packet.h"
@@ -22,7 +24,9 @@ namespace webrtc {
 class DecoderDatabase;
 class TickTimer;
 
-// This is the actual buffer holding the packets before decoding.
+// This is the actual buffer holding the packets before decoding. The packets
+// are kept sorted in a ring of preallocated slots, so that inserting and
+// extracting packets doesn't allocate.
 class PacketBuffer {
  public:
   enum BufferReturnCodes {
@@ -134,8 +138,20 @@ class PacketBuffer {
   }
 
  private:
+  // Returns the packet |index| places from the front of the buffer.
+  Packet& PacketAt(size_t index);
+  const Packet& PacketAt(size_t index) const;
+
+  // Removes the first packet of the buffer.
+  void PopFront();
+
   size_t max_number_of_packets_;
-  PacketList buffer_;
+  // The ring of packets, of which |size_| starting at |first_| are in the
+  // buffer, sorted so that the next packet to decode is first. Unused slots
+  // hold empty packets.
+  std::vector<Packet> buffer_;
+  size_t first_;
+  size_t size_;
   const TickTimer* tick_timer_;
   RTC_DISALLOW_COPY_AND_ASSIGN(PacketBuffer);
 };
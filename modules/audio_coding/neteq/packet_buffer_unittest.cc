@@ -368,6 +368,35 @@ TEST(PacketBuffer, Reordering) {
   EXPECT_CALL(decoder_database, Die());  // Called when object is deleted.
 }
 
+// Test that the packets stay in order when the buffer is cycled through many
+// times, with every other packet inserted out of order.
+TEST(PacketBuffer, ReorderingWhileCycling) {
+  TickTimer tick_timer;
+  PacketBuffer buffer(4, &tick_timer);  // 4 packets.
+  const uint32_t start_ts = 4711;
+  const uint32_t ts_increment = 10;
+  PacketGenerator gen(17, start_ts, 0, ts_increment);
+  const int payload_len = 10;
+
+  uint32_t current_ts = start_ts;
+  for (int i = 0; i < 10; ++i) {
+    // Insert two packets in reverse order, then extract them.
+    Packet first = gen.NextPacket(payload_len);
+    Packet second = gen.NextPacket(payload_len);
+    EXPECT_EQ(PacketBuffer::kOK, buffer.InsertPacket(std::move(second)));
+    EXPECT_EQ(PacketBuffer::kOK, buffer.InsertPacket(std::move(first)));
+    EXPECT_EQ(2u, buffer.NumPacketsInBuffer());
+    for (int j = 0; j < 2; ++j) {
+      const rtc::Optional<Packet> packet = buffer.GetNextPacket();
+      ASSERT_TRUE(packet);
+      EXPECT_EQ(current_ts, packet->timestamp);
+      EXPECT_EQ(static_cast<size_t>(payload_len), packet->payload.size());
+      current_ts += ts_increment;
+    }
+    EXPECT_TRUE(buffer.Empty());
+  }
+}
+
 // The test first inserts a packet with narrow-band CNG, then a packet with
 // wide-band speech. The expected behavior of the packet buffer is to detect a
 // change in sample rate, even though no speech packet has been inserted before,
@@ -10,6 +10,8 @@
 
 #include "webrtc/modules/audio_coding/neteq/tools/audio_sink.h"
 
+#include <utility>
+
 namespace webrtc {
 namespace test {
 
@@ -17,5 +19,31 @@ bool AudioSinkFork::WriteArray(const int16_t* audio, size_t num_samples) {
   return left_sink_->WriteArray(audio, num_samples) &&
          right_sink_->WriteArray(audio, num_samples);
 }
+
+BufferedAudioSink::BufferedAudioSink(std::unique_ptr<AudioSink> sink,
+                                     size_t block_size)
+    : sink_(std::move(sink)), block_size_(block_size) {
+  buffer_.reserve(block_size_);
+}
+
+BufferedAudioSink::~BufferedAudioSink() {
+  Flush();
+}
+
+bool BufferedAudioSink::WriteArray(const int16_t* audio, size_t num_samples) {
+  buffer_.insert(buffer_.end(), audio, audio + num_samples);
+  if (buffer_.size() < block_size_)
+    return true;
+  return Flush();
+}
+
+bool BufferedAudioSink::Flush() {
+  if (buffer_.empty())
+    return true;
+  const bool success = sink_->WriteArray(buffer_.data(), buffer_.size());
+  buffer_.clear();
+  return success;
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -11,6 +11,9 @@
 #ifndef WEBRTC_MODULES_AUDIO_CODING_NETEQ_TOOLS_AUDIO_SINK_H_
 #define WEBRTC_MODULES_AUDIO_CODING_NETEQ_TOOLS_AUDIO_SINK_H_
 
+#include <memory>
+#include <vector>
+
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/typedefs.h"
@@ -56,6 +59,29 @@ class AudioSinkFork : public AudioSink {
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioSinkFork);
 };
 
+// Collects the output audio in blocks of at least |block_size| samples before
+// writing it to |sink|, so that the sink gets a few large writes rather than
+// one per 10 ms frame. The remaining audio is written when the object is
+// destroyed, or by calling Flush().
+class BufferedAudioSink : public AudioSink {
+ public:
+  BufferedAudioSink(std::unique_ptr<AudioSink> sink, size_t block_size);
+  ~BufferedAudioSink() override;
+
+  bool WriteArray(const int16_t* audio, size_t num_samples) override;
+
+  // Writes the buffered audio to the sink. Returns true if successful,
+  // otherwise false.
+  bool Flush();
+
+ private:
+  const std::unique_ptr<AudioSink> sink_;
+  const size_t block_size_;
+  std::vector<int16_t> buffer_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(BufferedAudioSink);
+};
+
 }  // namespace test
 }  // namespace webrtc
 #endif  // WEBRTC_MODULES_AUDIO_CODING_NETEQ_TOOLS_AUDIO_SINK_H_
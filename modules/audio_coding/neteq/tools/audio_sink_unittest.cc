@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Unit tests for test AudioSink classes.
+
+#include "webrtc/modules/audio_coding/neteq/tools/audio_sink.h"
+
+#include <vector>
+
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+
+// Records the sizes and contents of the writes to it.
+class RecordingAudioSink : public AudioSink {
+ public:
+  RecordingAudioSink(std::vector<size_t>* write_sizes,
+                     std::vector<int16_t>* audio)
+      : write_sizes_(write_sizes), audio_(audio) {}
+
+  bool WriteArray(const int16_t* audio, size_t num_samples) override {
+    write_sizes_->push_back(num_samples);
+    audio_->insert(audio_->end(), audio, audio + num_samples);
+    return true;
+  }
+
+ private:
+  std::vector<size_t>* const write_sizes_;
+  std::vector<int16_t>* const audio_;
+};
+
+}  // namespace
+
+TEST(BufferedAudioSink, WritesInBlocks) {
+  static const size_t kFrameSize = 80;
+  static const size_t kBlockSize = 200;
+  std::vector<size_t> write_sizes;
+  std::vector<int16_t> audio;
+  {
+    BufferedAudioSink sink(std::unique_ptr<AudioSink>(
+                               new RecordingAudioSink(&write_sizes, &audio)),
+                           kBlockSize);
+    int16_t frame[kFrameSize];
+    for (int i = 0; i < 6; ++i) {
+      for (size_t j = 0; j < kFrameSize; ++j)
+        frame[j] = static_cast<int16_t>(i * kFrameSize + j);
+      EXPECT_TRUE(sink.WriteArray(frame, kFrameSize));
+    }
+    // Two blocks of three frames each have been written.
+    EXPECT_EQ(std::vector<size_t>({240, 240}), write_sizes);
+
+    EXPECT_TRUE(sink.WriteArray(frame, kFrameSize));
+    EXPECT_EQ(2u, write_sizes.size());
+  }
+  // The last frame is written when the sink is destroyed.
+  EXPECT_EQ(std::vector<size_t>({240, 240, kFrameSize}), write_sizes);
+  ASSERT_EQ(7 * kFrameSize, audio.size());
+  for (size_t i = 0; i < 6 * kFrameSize; ++i)
+    EXPECT_EQ(static_cast<int16_t>(i), audio[i]);
+}
+
+}  // namespace test
+}  // namespace webrtc
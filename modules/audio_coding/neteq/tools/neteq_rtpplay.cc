@@ -19,6 +19,7 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "gflags/gflags.h"
 #include "webrtc/base/checks.h"
@@ -159,6 +160,18 @@ const bool audio_level_dummy =
 DEFINE_int32(abs_send_time, 3, "Extension ID for absolute sender time");
 const bool abs_send_time_dummy =
     google::RegisterFlagValidator(&FLAGS_abs_send_time, &ValidateExtensionId);
+DEFINE_int32(threads, 1, "Number of threads decoding the input files");
+static bool ValidateThreads(const char* flagname, int32_t value) {
+  if (value > 0)
+    return true;
+  printf("Invalid value for --%s: %d\n", flagname, static_cast<int>(value));
+  return false;
+}
+const bool threads_dummy =
+    google::RegisterFlagValidator(&FLAGS_threads, &ValidateThreads);
+DEFINE_int32(output_block_ms, 0,
+             "Write the output audio in blocks of this many ms rather than "
+             "for every 10 ms frame, 0 to disable");
 
 // Maps a codec type to a printable name string.
 std::string CodecName(NetEqDecoder codec) {
@@ -309,35 +322,19 @@ class FilterSsrcInput : public NetEqInput {
   uint32_t ssrc_;
 };
 
-int RunTest(int argc, char* argv[]) {
-  std::string program_name = argv[0];
-  std::string usage = "Tool for decoding an RTP dump file using NetEq.\n"
-      "Run " + program_name + " --helpshort for usage.\n"
-      "Example usage:\n" + program_name +
-      " input.rtp output.{pcm, wav}\n";
-  google::SetUsageMessage(usage);
-  google::ParseCommandLineFlags(&argc, &argv, true);
-
-  if (FLAGS_codec_map) {
-    PrintCodecMapping();
-  }
-
-  if (argc != 3) {
-    if (FLAGS_codec_map) {
-      // We have already printed the codec map. Just end the program.
-      return 0;
-    }
-    // Print usage information.
-    std::cout << google::ProgramUsage();
-    return 0;
-  }
-
+// Creates a test decoding |input_file_name| to |output_file_name|. The
+// decoder replacing the audio of the input, if any, is returned in
+// |replacement_decoder| and must outlive the test.
+std::unique_ptr<NetEqTest> CreateTest(
+    const std::string& input_file_name,
+    const std::string& output_file_name,
+    NetEqTestErrorCallback* error_cb,
+    std::unique_ptr<AudioDecoder>* replacement_decoder) {
   // Gather RTP header extensions in a map.
   NetEqPacketSourceInput::RtpHeaderExtensionMap rtp_ext_map = {
       {FLAGS_audio_level, kRtpExtensionAudioLevel},
       {FLAGS_abs_send_time, kRtpExtensionAbsoluteSendTime}};
 
-  const std::string input_file_name = argv[1];
   std::unique_ptr<NetEqInput> input;
   if (RtpFileSource::ValidRtpDump(input_file_name) ||
       RtpFileSource::ValidPcap(input_file_name)) {
@@ -365,7 +362,6 @@ int RunTest(int argc, char* argv[]) {
 
   // Open the output file now that we know the sample rate. (Rate is only needed
   // for wav files.)
-  const std::string output_file_name = argv[2];
   std::unique_ptr<AudioSink> output;
   if (output_file_name.size() >= 4 &&
       output_file_name.substr(output_file_name.size() - 4) == ".wav") {
@@ -375,6 +371,11 @@ int RunTest(int argc, char* argv[]) {
     // Open a pcm file.
     output.reset(new OutputAudioFile(output_file_name));
   }
+  if (FLAGS_output_block_ms > 0) {
+    // Write the output in blocks rather than one 10 ms frame at a time.
+    output.reset(new BufferedAudioSink(
+        std::move(output), FLAGS_output_block_ms * sample_rate_hz / 1000));
+  }
 
   std::cout << "Output file: " << output_file_name << std::endl;
 
@@ -409,7 +410,6 @@ int RunTest(int argc, char* argv[]) {
        std::make_pair(NetEqDecoder::kDecoderCNGswb48kHz, "cng-swb48")}};
 
   // Check if a replacement audio file was provided.
-  std::unique_ptr<AudioDecoder> replacement_decoder;
   NetEqTest::ExtDecoderMap ext_codecs;
   if (!FLAGS_replacement_audio_file.empty()) {
     // Find largest unused payload type.
@@ -436,25 +436,24 @@ int RunTest(int argc, char* argv[]) {
     input.reset(new NetEqReplacementInput(std::move(input), replacement_pt,
                                           cn_types, forbidden_types));
 
-    replacement_decoder.reset(new FakeDecodeFromFile(
+    replacement_decoder->reset(new FakeDecodeFromFile(
         std::unique_ptr<InputAudioFile>(
             new InputAudioFile(FLAGS_replacement_audio_file)),
         48000, false));
     NetEqTest::ExternalDecoderInfo ext_dec_info = {
-        replacement_decoder.get(), NetEqDecoder::kDecoderArbitrary,
+        replacement_decoder->get(), NetEqDecoder::kDecoderArbitrary,
         "replacement codec"};
     ext_codecs[replacement_pt] = ext_dec_info;
   }
 
-  DefaultNetEqTestErrorCallback error_cb;
   NetEq::Config config;
   config.sample_rate_hz = sample_rate_hz;
-  NetEqTest test(config, codecs, ext_codecs, std::move(input),
-                 std::move(output), &error_cb);
-
-  int64_t test_duration_ms = test.Run();
-  NetEqNetworkStatistics stats = test.SimulationStats();
+  return std::unique_ptr<NetEqTest>(new NetEqTest(
+      config, codecs, ext_codecs, std::move(input), std::move(output),
+      error_cb));
+}
 
+void PrintStats(int64_t test_duration_ms, const NetEqNetworkStatistics& stats) {
   printf("Simulation statistics:\n");
   printf("  output duration: %" PRId64 " ms\n", test_duration_ms);
   printf("  packet_loss_rate: %f %%\n",
@@ -473,6 +472,54 @@ int RunTest(int argc, char* argv[]) {
   printf("  median_waiting_time_ms: %d ms\n", stats.median_waiting_time_ms);
   printf("  min_waiting_time_ms: %d ms\n", stats.min_waiting_time_ms);
   printf("  max_waiting_time_ms: %d ms\n", stats.max_waiting_time_ms);
+}
+
+int RunTest(int argc, char* argv[]) {
+  std::string program_name = argv[0];
+  std::string usage = "Tool for decoding an RTP dump file using NetEq.\n"
+      "Run " + program_name + " --helpshort for usage.\n"
+      "Example usage:\n" + program_name +
+      " input.rtp output.{pcm, wav}\n"
+      "Several files can be decoded in parallel by giving more pairs of input\n"
+      "and output files, e.g.:\n" + program_name +
+      " --threads=4 input1.rtp output1.wav input2.rtp output2.wav\n";
+  google::SetUsageMessage(usage);
+  google::ParseCommandLineFlags(&argc, &argv, true);
+
+  if (FLAGS_codec_map) {
+    PrintCodecMapping();
+  }
+
+  if (argc < 3 || argc % 2 == 0) {
+    if (FLAGS_codec_map) {
+      // We have already printed the codec map. Just end the program.
+      return 0;
+    }
+    // Print usage information.
+    std::cout << google::ProgramUsage();
+    return 0;
+  }
+
+  DefaultNetEqTestErrorCallback error_cb;
+  const size_t num_tests = (argc - 1) / 2;
+  // The replacement decoders must outlive the tests using them.
+  std::vector<std::unique_ptr<AudioDecoder>> replacement_decoders(num_tests);
+  std::vector<std::unique_ptr<NetEqTest>> tests(num_tests);
+  std::vector<NetEqTest*> test_ptrs;
+  for (size_t i = 0; i < num_tests; ++i) {
+    tests[i] = CreateTest(argv[1 + 2 * i], argv[2 + 2 * i], &error_cb,
+                          &replacement_decoders[i]);
+    test_ptrs.push_back(tests[i].get());
+  }
+
+  const std::vector<int64_t> test_durations_ms =
+      RunNetEqTestsInParallel(test_ptrs, FLAGS_threads);
+
+  for (size_t i = 0; i < num_tests; ++i) {
+    if (num_tests > 1)
+      printf("Input file: %s\n", argv[1 + 2 * i]);
+    PrintStats(test_durations_ms[i], tests[i]->SimulationStats());
+  }
 
   return 0;
 }
@@ -10,12 +10,37 @@
 
 #include "webrtc/modules/audio_coding/neteq/tools/neteq_test.h"
 
+#include <algorithm>
 #include <iostream>
 
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/modules/audio_coding/codecs/builtin_audio_decoder_factory.h"
 
 namespace webrtc {
 namespace test {
+namespace {
+
+struct ParallelTestRun {
+  const std::vector<NetEqTest*>* tests;
+  std::vector<int64_t>* durations_ms;
+  volatile int next_test;
+};
+
+// Runs tests from |obj|, a ParallelTestRun, until all have been started.
+bool RunNextNetEqTests(void* obj) {
+  ParallelTestRun* run = static_cast<ParallelTestRun*>(obj);
+  const int num_tests = static_cast<int>(run->tests->size());
+  int index;
+  while ((index = rtc::AtomicOps::Increment(&run->next_test) - 1) <
+         num_tests) {
+    (*run->durations_ms)[index] = (*run->tests)[index]->Run();
+  }
+  // Don't run again.
+  return false;
+}
+
+}  // namespace
 
 void DefaultNetEqTestErrorCallback::OnInsertPacketError(
     int error_code,
@@ -132,5 +157,24 @@ void NetEqTest::RegisterExternalDecoders(const ExtDecoderMap& codecs) {
   }
 }
 
+std::vector<int64_t> RunNetEqTestsInParallel(
+    const std::vector<NetEqTest*>& tests,
+    int num_threads) {
+  RTC_CHECK_GT(num_threads, 0);
+  std::vector<int64_t> durations_ms(tests.size());
+  ParallelTestRun run = {&tests, &durations_ms, 0};
+  const size_t num_workers =
+      std::min(static_cast<size_t>(num_threads), tests.size());
+  std::vector<std::unique_ptr<rtc::PlatformThread>> workers;
+  for (size_t i = 0; i < num_workers; ++i) {
+    workers.emplace_back(
+        new rtc::PlatformThread(&RunNextNetEqTests, &run, "NetEqTestWorker"));
+    workers.back()->Start();
+  }
+  for (auto& worker : workers)
+    worker->Stop();
+  return durations_ms;
+}
+
 }  // namespace test
 }  // namespace webrtc
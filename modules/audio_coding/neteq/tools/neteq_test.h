@@ -15,6 +15,7 @@
 #include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "webrtc/modules/audio_coding/neteq/include/neteq.h"
 #include "webrtc/modules/audio_coding/neteq/tools/audio_sink.h"
@@ -80,6 +81,14 @@ class NetEqTest {
   int sample_rate_hz_;
 };
 
+// Runs each of |tests| to completion, spreading them over up to |num_threads|
+// threads. The tests are driven by the timing of their NetEqInput rather than
+// by the wall clock, so they run as fast as the threads allow. Returns the
+// duration of the audio produced by each test in ms.
+std::vector<int64_t> RunNetEqTestsInParallel(
+    const std::vector<NetEqTest*>& tests,
+    int num_threads);
+
 }  // namespace test
 }  // namespace webrtc
 #endif  // WEBRTC_MODULES_AUDIO_CODING_NETEQ_TOOLS_NETEQ_TEST_H_
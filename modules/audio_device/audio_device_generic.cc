@@ -47,6 +47,17 @@ int32_t AudioDeviceGeneric::SoundDeviceControl(unsigned int par1,
   return -1;
 }
 
+int32_t AudioDeviceGeneric::SetLowLatencyMode(bool enable,
+                                              uint16_t playoutPeriodMS,
+                                              uint16_t recordingPeriodMS) {
+  LOG_F(LS_ERROR) << "Not supported on this platform";
+  return -1;
+}
+
+int32_t AudioDeviceGeneric::GetPlayoutUnderrunCount() const {
+  return -1;
+}
+
 bool AudioDeviceGeneric::BuiltInAECIsAvailable() const {
   LOG_F(LS_ERROR) << "Not supported on this platform";
   return false;
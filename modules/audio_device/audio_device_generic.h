@@ -154,6 +154,12 @@ class AudioDeviceGeneric {
                                      unsigned int par3 = 0,
                                      unsigned int par4 = 0);
 
+  // Linux ALSA and PulseAudio only.
+  virtual int32_t SetLowLatencyMode(bool enable,
+                                    uint16_t playoutPeriodMS,
+                                    uint16_t recordingPeriodMS);
+  virtual int32_t GetPlayoutUnderrunCount() const;
+
   // Android only
   virtual bool BuiltInAECIsAvailable() const;
   virtual bool BuiltInAGCIsAvailable() const;
@@ -1654,6 +1654,42 @@ int32_t AudioDeviceModuleImpl::RecordingDelay(uint16_t* delayMS) const {
   return (0);
 }
 
+// ----------------------------------------------------------------------------
+//  SetLowLatencyMode
+// ----------------------------------------------------------------------------
+
+int32_t AudioDeviceModuleImpl::SetLowLatencyMode(bool enable,
+                                                 uint16_t playoutPeriodMS,
+                                                 uint16_t recordingPeriodMS) {
+  LOG(INFO) << __FUNCTION__ << "(" << enable << ", " << playoutPeriodMS
+            << "ms, " << recordingPeriodMS << "ms)";
+  CHECK_INITIALIZED();
+
+  if (enable && (playoutPeriodMS < kAdmMinLowLatencyPeriodMs ||
+                 playoutPeriodMS > kAdmMaxLowLatencyPeriodMs ||
+                 recordingPeriodMS < kAdmMinLowLatencyPeriodMs ||
+                 recordingPeriodMS > kAdmMaxLowLatencyPeriodMs)) {
+    LOG(LERROR) << "period parameter is out of range";
+    return -1;
+  }
+
+  int32_t ret = _ptrAudioDevice->SetLowLatencyMode(enable, playoutPeriodMS,
+                                                   recordingPeriodMS);
+  if (ret == -1) {
+    LOG(LERROR) << "failed to set the low-latency mode";
+  }
+  return ret;
+}
+
+// ----------------------------------------------------------------------------
+//  GetPlayoutUnderrunCount
+// ----------------------------------------------------------------------------
+
+int32_t AudioDeviceModuleImpl::GetPlayoutUnderrunCount() const {
+  CHECK_INITIALIZED();
+  return _ptrAudioDevice->GetPlayoutUnderrunCount();
+}
+
 // ----------------------------------------------------------------------------
 //  CPULoad
 // ----------------------------------------------------------------------------
@@ -155,6 +155,10 @@ class AudioDeviceModuleImpl : public AudioDeviceModule {
   int32_t PlayoutBuffer(BufferType* type, uint16_t* sizeMS) const override;
   int32_t PlayoutDelay(uint16_t* delayMS) const override;
   int32_t RecordingDelay(uint16_t* delayMS) const override;
+  int32_t SetLowLatencyMode(bool enable,
+                            uint16_t playoutPeriodMS,
+                            uint16_t recordingPeriodMS) override;
+  int32_t GetPlayoutUnderrunCount() const override;
 
   // CPU load
   int32_t CPULoad(uint16_t* load) const override;
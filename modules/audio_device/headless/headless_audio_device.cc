@@ -0,0 +1,351 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_device/headless/headless_audio_device.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/refcountedobject.h"
+#include "webrtc/base/timeutils.h"
+
+namespace webrtc {
+
+namespace {
+
+uint16_t SamplesToMs(size_t samples, int sample_rate_hz, size_t channels) {
+  return static_cast<uint16_t>(samples * 1000 / (sample_rate_hz * channels));
+}
+
+}  // namespace
+
+const int HeadlessAudioDeviceScheduler::kTickMs;
+const int HeadlessAudioDeviceScheduler::kMaxLagMs;
+const int HeadlessAudioDevice::kBufferMs;
+
+HeadlessAudioDeviceScheduler::HeadlessAudioDeviceScheduler()
+    : clock_restarts_(0),
+      start_time_ms_(0),
+      num_ticks_(0),
+      queue_("HeadlessAudioDeviceScheduler") {
+  queue_.PostTask([this]() {
+    start_time_ms_ = rtc::TimeMillis();
+    queue_.PostDelayedTask([this]() { Tick(); }, kTickMs);
+  });
+}
+
+HeadlessAudioDeviceScheduler::~HeadlessAudioDeviceScheduler() {
+  rtc::CritScope cs(&lock_);
+  RTC_DCHECK(devices_.empty());
+}
+
+void HeadlessAudioDeviceScheduler::AddDevice(HeadlessAudioDevice* device) {
+  rtc::CritScope cs(&lock_);
+  RTC_DCHECK(std::find(devices_.begin(), devices_.end(), device) ==
+             devices_.end());
+  devices_.push_back(device);
+}
+
+void HeadlessAudioDeviceScheduler::RemoveDevice(HeadlessAudioDevice* device) {
+  RTC_DCHECK(!queue_.IsCurrent());
+  rtc::CritScope cs(&lock_);
+  auto it = std::find(devices_.begin(), devices_.end(), device);
+  RTC_DCHECK(it != devices_.end());
+  // The order of the devices does not matter.
+  *it = devices_.back();
+  devices_.pop_back();
+}
+
+int HeadlessAudioDeviceScheduler::clock_restarts() const {
+  rtc::CritScope cs(&lock_);
+  return clock_restarts_;
+}
+
+void HeadlessAudioDeviceScheduler::Tick() {
+  RTC_DCHECK(queue_.IsCurrent());
+  {
+    rtc::CritScope cs(&lock_);
+    for (HeadlessAudioDevice* device : devices_)
+      device->Process();
+  }
+
+  ++num_ticks_;
+  const int64_t now_ms = rtc::TimeMillis();
+  int64_t next_tick_ms = start_time_ms_ + num_ticks_ * kTickMs;
+  if (now_ms - next_tick_ms > kMaxLagMs) {
+    start_time_ms_ = now_ms;
+    num_ticks_ = 0;
+    next_tick_ms = now_ms + kTickMs;
+    rtc::CritScope cs(&lock_);
+    ++clock_restarts_;
+  }
+  queue_.PostDelayedTask(
+      [this]() { Tick(); },
+      static_cast<uint32_t>(std::max<int64_t>(next_tick_ms - now_ms, 0)));
+}
+
+rtc::scoped_refptr<HeadlessAudioDevice> HeadlessAudioDevice::Create(
+    HeadlessAudioDeviceScheduler* scheduler,
+    int sample_rate_hz,
+    size_t num_channels) {
+  return new rtc::RefCountedObject<HeadlessAudioDevice>(
+      scheduler, sample_rate_hz, num_channels);
+}
+
+HeadlessAudioDevice::HeadlessAudioDevice(
+    HeadlessAudioDeviceScheduler* scheduler,
+    int sample_rate_hz,
+    size_t num_channels)
+    : scheduler_(scheduler),
+      sample_rate_hz_(sample_rate_hz),
+      num_channels_(num_channels),
+      frames_per_tick_(static_cast<size_t>(
+          sample_rate_hz * HeadlessAudioDeviceScheduler::kTickMs / 1000)),
+      audio_callback_(nullptr),
+      initialized_(false),
+      play_is_initialized_(false),
+      playing_(false),
+      rec_is_initialized_(false),
+      recording_(false),
+      capture_frame_(new int16_t[frames_per_tick_ * num_channels]),
+      render_frame_(new int16_t[frames_per_tick_ * num_channels]),
+      capture_buffer_(sample_rate_hz * kBufferMs / 1000 * num_channels),
+      render_buffer_(sample_rate_hz * kBufferMs / 1000 * num_channels),
+      capture_underrun_count_(0),
+      render_overflow_count_(0),
+      playout_underrun_count_(0) {
+  RTC_DCHECK(scheduler);
+  RTC_DCHECK_GT(frames_per_tick_, 0u);
+  RTC_DCHECK(num_channels == 1 || num_channels == 2);
+}
+
+HeadlessAudioDevice::~HeadlessAudioDevice() {
+  Terminate();
+}
+
+size_t HeadlessAudioDevice::PushCaptureAudio(const int16_t* audio,
+                                             size_t num_frames) {
+  return capture_buffer_.Write(audio, num_frames * num_channels_) /
+         num_channels_;
+}
+
+size_t HeadlessAudioDevice::PullRenderAudio(int16_t* audio,
+                                            size_t num_frames) {
+  const size_t num_samples = num_frames * num_channels_;
+  const size_t read = render_buffer_.Read(audio, num_samples);
+  if (read < num_samples) {
+    memset(audio + read, 0, (num_samples - read) * sizeof(int16_t));
+    rtc::AtomicOps::Increment(&playout_underrun_count_);
+  }
+  return read / num_channels_;
+}
+
+int HeadlessAudioDevice::capture_underrun_count() const {
+  return rtc::AtomicOps::AcquireLoad(&capture_underrun_count_);
+}
+
+int HeadlessAudioDevice::render_overflow_count() const {
+  return rtc::AtomicOps::AcquireLoad(&render_overflow_count_);
+}
+
+int32_t HeadlessAudioDevice::RegisterAudioCallback(
+    AudioTransport* audio_callback) {
+  rtc::CritScope cs(&lock_);
+  audio_callback_ = audio_callback;
+  return 0;
+}
+
+int32_t HeadlessAudioDevice::Init() {
+  {
+    rtc::CritScope cs(&lock_);
+    if (initialized_)
+      return 0;
+    initialized_ = true;
+  }
+  // Not called under |lock_|, since ticks lock the scheduler before the
+  // devices.
+  scheduler_->AddDevice(this);
+  return 0;
+}
+
+int32_t HeadlessAudioDevice::Terminate() {
+  {
+    rtc::CritScope cs(&lock_);
+    if (!initialized_)
+      return 0;
+    initialized_ = false;
+    play_is_initialized_ = false;
+    playing_ = false;
+    rec_is_initialized_ = false;
+    recording_ = false;
+  }
+  scheduler_->RemoveDevice(this);
+  return 0;
+}
+
+bool HeadlessAudioDevice::Initialized() const {
+  rtc::CritScope cs(&lock_);
+  return initialized_;
+}
+
+int32_t HeadlessAudioDevice::InitPlayout() {
+  rtc::CritScope cs(&lock_);
+  if (!initialized_ || playing_)
+    return -1;
+  play_is_initialized_ = true;
+  return 0;
+}
+
+bool HeadlessAudioDevice::PlayoutIsInitialized() const {
+  rtc::CritScope cs(&lock_);
+  return play_is_initialized_;
+}
+
+int32_t HeadlessAudioDevice::StartPlayout() {
+  rtc::CritScope cs(&lock_);
+  if (!play_is_initialized_)
+    return -1;
+  playing_ = true;
+  return 0;
+}
+
+int32_t HeadlessAudioDevice::StopPlayout() {
+  rtc::CritScope cs(&lock_);
+  playing_ = false;
+  play_is_initialized_ = false;
+  return 0;
+}
+
+bool HeadlessAudioDevice::Playing() const {
+  rtc::CritScope cs(&lock_);
+  return playing_;
+}
+
+int32_t HeadlessAudioDevice::InitRecording() {
+  rtc::CritScope cs(&lock_);
+  if (!initialized_ || recording_)
+    return -1;
+  rec_is_initialized_ = true;
+  return 0;
+}
+
+bool HeadlessAudioDevice::RecordingIsInitialized() const {
+  rtc::CritScope cs(&lock_);
+  return rec_is_initialized_;
+}
+
+int32_t HeadlessAudioDevice::StartRecording() {
+  rtc::CritScope cs(&lock_);
+  if (!rec_is_initialized_)
+    return -1;
+  recording_ = true;
+  return 0;
+}
+
+int32_t HeadlessAudioDevice::StopRecording() {
+  rtc::CritScope cs(&lock_);
+  recording_ = false;
+  rec_is_initialized_ = false;
+  return 0;
+}
+
+bool HeadlessAudioDevice::Recording() const {
+  rtc::CritScope cs(&lock_);
+  return recording_;
+}
+
+int32_t HeadlessAudioDevice::StereoPlayoutIsAvailable(bool* available) const {
+  *available = num_channels_ == 2;
+  return 0;
+}
+
+int32_t HeadlessAudioDevice::StereoPlayout(bool* enabled) const {
+  *enabled = num_channels_ == 2;
+  return 0;
+}
+
+int32_t HeadlessAudioDevice::StereoRecordingIsAvailable(
+    bool* available) const {
+  *available = num_channels_ == 2;
+  return 0;
+}
+
+int32_t HeadlessAudioDevice::StereoRecording(bool* enabled) const {
+  *enabled = num_channels_ == 2;
+  return 0;
+}
+
+int32_t HeadlessAudioDevice::PlayoutDelay(uint16_t* delay_ms) const {
+  *delay_ms = SamplesToMs(render_buffer_.ReadSamplesAvailable(),
+                          sample_rate_hz_, num_channels_);
+  return 0;
+}
+
+int32_t HeadlessAudioDevice::RecordingDelay(uint16_t* delay_ms) const {
+  *delay_ms = SamplesToMs(capture_buffer_.ReadSamplesAvailable(),
+                          sample_rate_hz_, num_channels_);
+  return 0;
+}
+
+int32_t HeadlessAudioDevice::GetPlayoutUnderrunCount() const {
+  return rtc::AtomicOps::AcquireLoad(&playout_underrun_count_);
+}
+
+int32_t HeadlessAudioDevice::RecordingSampleRate(
+    uint32_t* samples_per_sec) const {
+  *samples_per_sec = sample_rate_hz_;
+  return 0;
+}
+
+int32_t HeadlessAudioDevice::PlayoutSampleRate(
+    uint32_t* samples_per_sec) const {
+  *samples_per_sec = sample_rate_hz_;
+  return 0;
+}
+
+void HeadlessAudioDevice::Process() {
+  rtc::CritScope cs(&lock_);
+  if (!audio_callback_)
+    return;
+
+  const size_t num_samples = frames_per_tick_ * num_channels_;
+  const size_t bytes_per_frame = num_channels_ * sizeof(int16_t);
+  if (recording_) {
+    const size_t read = capture_buffer_.Read(capture_frame_.get(), num_samples);
+    if (read < num_samples) {
+      memset(capture_frame_.get() + read, 0,
+             (num_samples - read) * sizeof(int16_t));
+      rtc::AtomicOps::Increment(&capture_underrun_count_);
+    }
+    const uint32_t delay_ms =
+        SamplesToMs(capture_buffer_.ReadSamplesAvailable(), sample_rate_hz_,
+                    num_channels_);
+    uint32_t new_mic_level = 0;
+    audio_callback_->RecordedDataIsAvailable(
+        capture_frame_.get(), frames_per_tick_, bytes_per_frame,
+        num_channels_, sample_rate_hz_, delay_ms, 0, 0, false, new_mic_level);
+  }
+
+  if (playing_) {
+    size_t frames_out = 0;
+    int64_t elapsed_time_ms = -1;
+    int64_t ntp_time_ms = -1;
+    audio_callback_->NeedMorePlayData(
+        frames_per_tick_, bytes_per_frame, num_channels_, sample_rate_hz_,
+        render_frame_.get(), frames_out, &elapsed_time_ms, &ntp_time_ms);
+    if (render_buffer_.Write(render_frame_.get(), num_samples) < num_samples)
+      rtc::AtomicOps::Increment(&render_overflow_count_);
+  }
+}
+
+}  // namespace webrtc
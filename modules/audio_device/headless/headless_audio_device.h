@@ -0,0 +1,170 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_DEVICE_HEADLESS_HEADLESS_AUDIO_DEVICE_H_
+#define WEBRTC_MODULES_AUDIO_DEVICE_HEADLESS_HEADLESS_AUDIO_DEVICE_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/scoped_ref_ptr.h"
+#include "webrtc/base/task_queue.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/common_audio/spsc_ring_buffer.h"
+#include "webrtc/modules/audio_device/include/fake_audio_device.h"
+
+namespace webrtc {
+
+class HeadlessAudioDevice;
+
+// Drives any number of HeadlessAudioDevices from a single task queue with a
+// 10 ms clock. The tick deadlines are derived from the start time rather than
+// from the previous tick, so the clock does not drift when a tick is late; if
+// the queue falls more than kMaxLagMs behind, the clock is restarted instead
+// of running a burst of catch-up ticks.
+class HeadlessAudioDeviceScheduler {
+ public:
+  static const int kTickMs = 10;
+  static const int kMaxLagMs = 100;
+
+  HeadlessAudioDeviceScheduler();
+  ~HeadlessAudioDeviceScheduler();
+
+  // Called by HeadlessAudioDevice::Init() and Terminate(). RemoveDevice()
+  // blocks until a tick that is in progress has finished, so the device is
+  // never called again once it returns. It must therefore not be called from
+  // within an AudioTransport callback.
+  void AddDevice(HeadlessAudioDevice* device);
+  void RemoveDevice(HeadlessAudioDevice* device);
+
+  // Number of times the clock was restarted because the queue fell behind.
+  int clock_restarts() const;
+
+ private:
+  void Tick();
+
+  mutable rtc::CriticalSection lock_;
+  std::vector<HeadlessAudioDevice*> devices_ GUARDED_BY(lock_);
+  int clock_restarts_ GUARDED_BY(lock_);
+  // Only accessed on |queue_|.
+  int64_t start_time_ms_;
+  int64_t num_ticks_;
+  // Declared last so that it is destroyed, and stops running ticks, before
+  // the members above.
+  rtc::TaskQueue queue_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(HeadlessAudioDeviceScheduler);
+};
+
+// An AudioDeviceModule without any audio hardware, for servers that run many
+// calls in one process. Captured audio is pushed in by the application with
+// PushCaptureAudio() and rendered audio is pulled out with PullRenderAudio();
+// both move 16-bit interleaved samples through lock-free single-producer,
+// single-consumer rings, so the application threads never contend with the
+// scheduler thread. The AudioTransport callbacks run on the scheduler's
+// task queue, which is shared by all devices created with it.
+class HeadlessAudioDevice : public FakeAudioDeviceModule {
+ public:
+  // Each ring holds this much audio.
+  static const int kBufferMs = 100;
+
+  // |scheduler| must outlive the device.
+  static rtc::scoped_refptr<HeadlessAudioDevice> Create(
+      HeadlessAudioDeviceScheduler* scheduler,
+      int sample_rate_hz,
+      size_t num_channels);
+
+  // Capture producer; call from a single application thread. Returns the
+  // number of frames accepted, which is less than |num_frames| if the
+  // capture ring is full.
+  size_t PushCaptureAudio(const int16_t* audio, size_t num_frames);
+
+  // Render consumer; call from a single application thread. Always fills
+  // |num_frames| frames of |audio|, padding with silence and counting a
+  // playout underrun if the ring holds too little. Returns the number of
+  // frames that were actually rendered.
+  size_t PullRenderAudio(int16_t* audio, size_t num_frames);
+
+  // Ticks on which a 10 ms capture frame was padded with silence.
+  int capture_underrun_count() const;
+  // Ticks on which rendered audio was dropped because the render ring was
+  // full.
+  int render_overflow_count() const;
+
+  // AudioDeviceModule implementation.
+  int32_t RegisterAudioCallback(AudioTransport* audio_callback) override;
+  int32_t Init() override;
+  int32_t Terminate() override;
+  bool Initialized() const override;
+  int32_t InitPlayout() override;
+  bool PlayoutIsInitialized() const override;
+  int32_t StartPlayout() override;
+  int32_t StopPlayout() override;
+  bool Playing() const override;
+  int32_t InitRecording() override;
+  bool RecordingIsInitialized() const override;
+  int32_t StartRecording() override;
+  int32_t StopRecording() override;
+  bool Recording() const override;
+  int32_t StereoPlayoutIsAvailable(bool* available) const override;
+  int32_t StereoPlayout(bool* enabled) const override;
+  int32_t StereoRecordingIsAvailable(bool* available) const override;
+  int32_t StereoRecording(bool* enabled) const override;
+  int32_t PlayoutDelay(uint16_t* delay_ms) const override;
+  int32_t RecordingDelay(uint16_t* delay_ms) const override;
+  int32_t GetPlayoutUnderrunCount() const override;
+  int32_t RecordingSampleRate(uint32_t* samples_per_sec) const override;
+  int32_t PlayoutSampleRate(uint32_t* samples_per_sec) const override;
+
+ protected:
+  HeadlessAudioDevice(HeadlessAudioDeviceScheduler* scheduler,
+                      int sample_rate_hz,
+                      size_t num_channels);
+  ~HeadlessAudioDevice() override;
+
+ private:
+  friend class HeadlessAudioDeviceScheduler;
+
+  // Runs one 10 ms period; called on the scheduler's task queue.
+  void Process();
+
+  HeadlessAudioDeviceScheduler* const scheduler_;
+  const int sample_rate_hz_;
+  const size_t num_channels_;
+  const size_t frames_per_tick_;
+
+  mutable rtc::CriticalSection lock_;
+  AudioTransport* audio_callback_ GUARDED_BY(lock_);
+  bool initialized_ GUARDED_BY(lock_);
+  bool play_is_initialized_ GUARDED_BY(lock_);
+  bool playing_ GUARDED_BY(lock_);
+  bool rec_is_initialized_ GUARDED_BY(lock_);
+  bool recording_ GUARDED_BY(lock_);
+  // Scratch buffers of one tick, only used on the scheduler's task queue.
+  std::unique_ptr<int16_t[]> capture_frame_;
+  std::unique_ptr<int16_t[]> render_frame_;
+
+  // Written by the application, read on the scheduler's task queue.
+  SpscRingBuffer capture_buffer_;
+  // Written on the scheduler's task queue, read by the application.
+  SpscRingBuffer render_buffer_;
+
+  volatile int capture_underrun_count_;
+  volatile int render_overflow_count_;
+  volatile int playout_underrun_count_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(HeadlessAudioDevice);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_DEVICE_HEADLESS_HEADLESS_AUDIO_DEVICE_H_
@@ -0,0 +1,173 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_device/headless/headless_audio_device.h"
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/event.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+const int kSampleRateHz = 16000;
+const size_t kFramesPer10Ms = kSampleRateHz / 100;
+const int kWaitMs = 5000;
+
+// Records the first captured frame, renders a constant value and signals
+// |done_| after |num_callbacks| callbacks of each kind that is enabled.
+class FakeTransport : public AudioTransport {
+ public:
+  FakeTransport(int num_callbacks, int16_t render_value)
+      : num_callbacks_(num_callbacks),
+        render_value_(render_value),
+        done_(false, false),
+        recorded_(0),
+        played_(0) {}
+
+  int32_t RecordedDataIsAvailable(const void* audio_samples,
+                                  const size_t n_samples,
+                                  const size_t n_bytes_per_sample,
+                                  const size_t n_channels,
+                                  const uint32_t samples_per_sec,
+                                  const uint32_t total_delay_ms,
+                                  const int32_t clock_drift,
+                                  const uint32_t current_mic_level,
+                                  const bool key_pressed,
+                                  uint32_t& new_mic_level) override {
+    EXPECT_EQ(kFramesPer10Ms, n_samples);
+    if (first_capture_.empty()) {
+      const int16_t* samples = static_cast<const int16_t*>(audio_samples);
+      first_capture_.assign(samples, samples + n_samples * n_channels);
+    }
+    if (rtc::AtomicOps::Increment(&recorded_) == num_callbacks_)
+      done_.Set();
+    return 0;
+  }
+
+  int32_t NeedMorePlayData(const size_t n_samples,
+                           const size_t n_bytes_per_sample,
+                           const size_t n_channels,
+                           const uint32_t samples_per_sec,
+                           void* audio_samples,
+                           size_t& n_samples_out,
+                           int64_t* elapsed_time_ms,
+                           int64_t* ntp_time_ms) override {
+    int16_t* samples = static_cast<int16_t*>(audio_samples);
+    for (size_t i = 0; i < n_samples * n_channels; ++i)
+      samples[i] = render_value_;
+    n_samples_out = n_samples;
+    if (rtc::AtomicOps::Increment(&played_) == num_callbacks_)
+      done_.Set();
+    return 0;
+  }
+
+  void PushCaptureData(int voe_channel,
+                       const void* audio_data,
+                       int bits_per_sample,
+                       int sample_rate,
+                       size_t number_of_channels,
+                       size_t number_of_frames) override {}
+
+  void PullRenderData(int bits_per_sample,
+                      int sample_rate,
+                      size_t number_of_channels,
+                      size_t number_of_frames,
+                      void* audio_data,
+                      int64_t* elapsed_time_ms,
+                      int64_t* ntp_time_ms) override {}
+
+  bool Wait() { return done_.Wait(kWaitMs); }
+  const std::vector<int16_t>& first_capture() const { return first_capture_; }
+
+ private:
+  const int num_callbacks_;
+  const int16_t render_value_;
+  rtc::Event done_;
+  volatile int recorded_;
+  volatile int played_;
+  std::vector<int16_t> first_capture_;
+};
+
+}  // namespace
+
+TEST(HeadlessAudioDeviceTest, DeliversCapturedAudio) {
+  HeadlessAudioDeviceScheduler scheduler;
+  rtc::scoped_refptr<HeadlessAudioDevice> device =
+      HeadlessAudioDevice::Create(&scheduler, kSampleRateHz, 2);
+  FakeTransport transport(1, 0);
+
+  std::vector<int16_t> capture(kFramesPer10Ms * 2);
+  for (size_t i = 0; i < capture.size(); ++i)
+    capture[i] = static_cast<int16_t>(i);
+  EXPECT_EQ(kFramesPer10Ms,
+            device->PushCaptureAudio(capture.data(), kFramesPer10Ms));
+
+  EXPECT_EQ(0, device->RegisterAudioCallback(&transport));
+  EXPECT_EQ(0, device->Init());
+  EXPECT_EQ(0, device->InitRecording());
+  EXPECT_EQ(0, device->StartRecording());
+  ASSERT_TRUE(transport.Wait());
+  EXPECT_EQ(0, device->Terminate());
+
+  EXPECT_EQ(capture, transport.first_capture());
+}
+
+TEST(HeadlessAudioDeviceTest, RendersPlayoutAudio) {
+  HeadlessAudioDeviceScheduler scheduler;
+  rtc::scoped_refptr<HeadlessAudioDevice> device =
+      HeadlessAudioDevice::Create(&scheduler, kSampleRateHz, 1);
+  FakeTransport transport(3, 1234);
+
+  // Pulling from an empty ring renders silence and counts an underrun.
+  std::vector<int16_t> render(kFramesPer10Ms, 1);
+  EXPECT_EQ(0u, device->PullRenderAudio(render.data(), kFramesPer10Ms));
+  EXPECT_EQ(std::vector<int16_t>(kFramesPer10Ms, 0), render);
+  EXPECT_EQ(1, device->GetPlayoutUnderrunCount());
+
+  EXPECT_EQ(0, device->RegisterAudioCallback(&transport));
+  EXPECT_EQ(0, device->Init());
+  EXPECT_EQ(-1, device->StartPlayout());
+  EXPECT_EQ(0, device->InitPlayout());
+  EXPECT_EQ(0, device->StartPlayout());
+  ASSERT_TRUE(transport.Wait());
+  EXPECT_EQ(0, device->StopPlayout());
+
+  EXPECT_EQ(kFramesPer10Ms,
+            device->PullRenderAudio(render.data(), kFramesPer10Ms));
+  EXPECT_EQ(std::vector<int16_t>(kFramesPer10Ms, 1234), render);
+  EXPECT_EQ(1, device->GetPlayoutUnderrunCount());
+  EXPECT_EQ(0, device->Terminate());
+}
+
+TEST(HeadlessAudioDeviceTest, ManyDevicesShareOneScheduler) {
+  const int kNumDevices = 200;
+  HeadlessAudioDeviceScheduler scheduler;
+  std::vector<rtc::scoped_refptr<HeadlessAudioDevice>> devices;
+  std::vector<std::unique_ptr<FakeTransport>> transports;
+  for (int i = 0; i < kNumDevices; ++i) {
+    devices.push_back(HeadlessAudioDevice::Create(&scheduler, 48000, 2));
+    transports.emplace_back(new FakeTransport(10, 0));
+    devices[i]->RegisterAudioCallback(transports[i].get());
+    devices[i]->Init();
+    devices[i]->InitPlayout();
+    devices[i]->StartPlayout();
+  }
+  for (int i = 0; i < kNumDevices; ++i)
+    EXPECT_TRUE(transports[i]->Wait());
+  // Releasing the devices terminates them.
+  devices.clear();
+}
+
+}  // namespace webrtc
@@ -169,6 +169,18 @@ class AudioDeviceModule : public RefCountedModule {
   virtual int32_t PlayoutDelay(uint16_t* delayMS) const = 0;
   virtual int32_t RecordingDelay(uint16_t* delayMS) const = 0;
 
+  // Low-latency mode, only supported by the Linux ALSA and PulseAudio audio
+  // layers. Requests device periods (ALSA) or fragments (PulseAudio) of
+  // |playoutPeriodMS| and |recordingPeriodMS| instead of the default buffer
+  // sizes, and grows the playout buffer by one period at a time on underruns.
+  // Takes effect the next time playout or recording is initialized.
+  virtual int32_t SetLowLatencyMode(bool enable,
+                                    uint16_t playoutPeriodMS,
+                                    uint16_t recordingPeriodMS) = 0;
+  // Returns the number of playout underruns since playout was initialized, or
+  // -1 if not supported by the audio layer.
+  virtual int32_t GetPlayoutUnderrunCount() const = 0;
+
   // CPU load
   virtual int32_t CPULoad(uint16_t* load) const = 0;
 
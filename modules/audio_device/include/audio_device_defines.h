@@ -24,6 +24,9 @@ static const int kAdmMaxGuidSize = 128;
 static const int kAdmMinPlayoutBufferSizeMs = 10;
 static const int kAdmMaxPlayoutBufferSizeMs = 250;
 
+static const int kAdmMinLowLatencyPeriodMs = 2;
+static const int kAdmMaxLowLatencyPeriodMs = 20;
+
 // ----------------------------------------------------------------------------
 //  AudioDeviceObserver
 // ----------------------------------------------------------------------------
@@ -123,6 +123,12 @@ class FakeAudioDeviceModule : public AudioDeviceModule {
   }
   virtual int32_t PlayoutDelay(uint16_t* delayMS) const { return 0; }
   virtual int32_t RecordingDelay(uint16_t* delayMS) const { return 0; }
+  virtual int32_t SetLowLatencyMode(bool enable,
+                                    uint16_t playoutPeriodMS,
+                                    uint16_t recordingPeriodMS) {
+    return -1;
+  }
+  virtual int32_t GetPlayoutUnderrunCount() const { return -1; }
   virtual int32_t CPULoad(uint16_t* load) const { return 0; }
   virtual int32_t StartRawOutputFileRecording(
       const char pcmFileNameUTF8[kAdmMaxFileNameSize]) {
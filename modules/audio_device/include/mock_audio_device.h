@@ -106,6 +106,10 @@ class MockAudioDeviceModule : public AudioDeviceModule {
                                             uint16_t* sizeMS));
   MOCK_CONST_METHOD1(PlayoutDelay, int32_t(uint16_t* delayMS));
   MOCK_CONST_METHOD1(RecordingDelay, int32_t(uint16_t* delayMS));
+  MOCK_METHOD3(SetLowLatencyMode, int32_t(bool enable,
+                                          uint16_t playoutPeriodMS,
+                                          uint16_t recordingPeriodMS));
+  MOCK_CONST_METHOD0(GetPlayoutUnderrunCount, int32_t());
   MOCK_CONST_METHOD1(CPULoad, int32_t(uint16_t* load));
   MOCK_METHOD1(StartRawOutputFileRecording,
                int32_t(const char pcmFileNameUTF8[kAdmMaxFileNameSize]));
@@ -56,6 +56,13 @@ static const unsigned int ALSA_CAPTURE_CH = 2;
 static const unsigned int ALSA_CAPTURE_LATENCY = 40*1000; // in us
 static const unsigned int ALSA_CAPTURE_WAIT_TIMEOUT = 5; // in ms
 
+// Low-latency mode, see AudioDeviceModule::SetLowLatencyMode(). The playout
+// buffer starts at two periods and grows by one period on each underrun, up to
+// ALSA_PLAYOUT_LATENCY. Capture latency is bounded by the period size, so a
+// deeper capture buffer only guards against overruns.
+static const unsigned int ALSA_LOW_LATENCY_PLAYOUT_PERIODS = 2;
+static const unsigned int ALSA_LOW_LATENCY_CAPTURE_PERIODS = 4;
+
 #define FUNC_GET_NUM_OF_DEVICE 0
 #define FUNC_GET_DEVICE_NAME 1
 #define FUNC_GET_DEVICE_NAME_FOR_AN_ENUM 2
@@ -101,7 +108,11 @@ AudioDeviceLinuxALSA::AudioDeviceLinuxALSA(const int32_t id) :
     _recWarning(0),
     _recError(0),
     _playBufDelay(80),
-    _playBufDelayFixed(80)
+    _playBufDelayFixed(80),
+    _lowLatencyMode(false),
+    _lowLatencyPlayPeriodMs(0),
+    _lowLatencyRecPeriodMs(0),
+    _playUnderrunCount(0)
 {
     memset(_oldKeyState, 0, sizeof(_oldKeyState));
     WEBRTC_TRACE(kTraceMemory, kTraceAudioDevice, id,
@@ -1087,18 +1098,9 @@ int32_t AudioDeviceLinuxALSA::InitPlayout()
     }
 
     _playoutFramesIn10MS = _playoutFreq/100;
-    if ((errVal = LATE(snd_pcm_set_params)( _handlePlayout,
-#if defined(WEBRTC_ARCH_BIG_ENDIAN)
-        SND_PCM_FORMAT_S16_BE,
-#else
-        SND_PCM_FORMAT_S16_LE, //format
-#endif
-        SND_PCM_ACCESS_RW_INTERLEAVED, //access
-        _playChannels, //channels
-        _playoutFreq, //rate
-        1, //soft_resample
-        ALSA_PLAYOUT_LATENCY //40*1000 //latency required overall latency in us
-    )) < 0)
+    if ((errVal = SetPcmParams(_handlePlayout, _playChannels, _playoutFreq,
+                               ALSA_PLAYOUT_LATENCY, _lowLatencyPlayPeriodMs,
+                               ALSA_LOW_LATENCY_PLAYOUT_PERIODS)) < 0)
     {   /* 0.5sec */
         _playoutFramesIn10MS = 0;
         WEBRTC_TRACE(kTraceError, kTraceAudioDevice, _id,
@@ -1143,6 +1145,7 @@ int32_t AudioDeviceLinuxALSA::InitPlayout()
     // Init varaibles used for play
     _playWarning = 0;
     _playError = 0;
+    rtc::AtomicOps::ReleaseStore(&_playUnderrunCount, 0);
 
     if (_handlePlayout != NULL)
     {
@@ -1243,18 +1246,9 @@ int32_t AudioDeviceLinuxALSA::InitRecording()
     }
 
     _recordingFramesIn10MS = _recordingFreq/100;
-    if ((errVal = LATE(snd_pcm_set_params)(_handleRecord,
-#if defined(WEBRTC_ARCH_BIG_ENDIAN)
-        SND_PCM_FORMAT_S16_BE, //format
-#else
-        SND_PCM_FORMAT_S16_LE, //format
-#endif
-        SND_PCM_ACCESS_RW_INTERLEAVED, //access
-        _recChannels, //channels
-        _recordingFreq, //rate
-        1, //soft_resample
-        ALSA_CAPTURE_LATENCY //latency in us
-    )) < 0)
+    if ((errVal = SetPcmParams(_handleRecord, _recChannels, _recordingFreq,
+                               ALSA_CAPTURE_LATENCY, _lowLatencyRecPeriodMs,
+                               ALSA_LOW_LATENCY_CAPTURE_PERIODS)) < 0)
     {
          // Fall back to another mode then.
          if (_recChannels == 1)
@@ -1262,18 +1256,10 @@ int32_t AudioDeviceLinuxALSA::InitRecording()
          else
            _recChannels = 1;
 
-         if ((errVal = LATE(snd_pcm_set_params)(_handleRecord,
-#if defined(WEBRTC_ARCH_BIG_ENDIAN)
-             SND_PCM_FORMAT_S16_BE, //format
-#else
-             SND_PCM_FORMAT_S16_LE, //format
-#endif
-             SND_PCM_ACCESS_RW_INTERLEAVED, //access
-             _recChannels, //channels
-             _recordingFreq, //rate
-             1, //soft_resample
-             ALSA_CAPTURE_LATENCY //latency in us
-         )) < 0)
+         if ((errVal = SetPcmParams(_handleRecord, _recChannels,
+                                    _recordingFreq, ALSA_CAPTURE_LATENCY,
+                                    _lowLatencyRecPeriodMs,
+                                    ALSA_LOW_LATENCY_CAPTURE_PERIODS)) < 0)
          {
              _recordingFramesIn10MS = 0;
              WEBRTC_TRACE(kTraceError, kTraceAudioDevice, _id,
@@ -1625,6 +1611,21 @@ int32_t AudioDeviceLinuxALSA::PlayoutBuffer(
     return 0;
 }
 
+int32_t AudioDeviceLinuxALSA::SetLowLatencyMode(bool enable,
+                                                uint16_t playoutPeriodMS,
+                                                uint16_t recordingPeriodMS)
+{
+    _lowLatencyMode = enable;
+    _lowLatencyPlayPeriodMs = playoutPeriodMS;
+    _lowLatencyRecPeriodMs = recordingPeriodMS;
+    return 0;
+}
+
+int32_t AudioDeviceLinuxALSA::GetPlayoutUnderrunCount() const
+{
+    return rtc::AtomicOps::AcquireLoad(&_playUnderrunCount);
+}
+
 int32_t AudioDeviceLinuxALSA::CPULoad(uint16_t& load) const
 {
 
@@ -1956,6 +1957,135 @@ int32_t AudioDeviceLinuxALSA::ErrorRecovery(int32_t error,
     return res;
 }
 
+void AudioDeviceLinuxALSA::PlayoutErrorRecovery(int32_t error)
+{
+    if (error == -EPIPE)
+    {
+        rtc::AtomicOps::Increment(&_playUnderrunCount);
+        if (_lowLatencyMode && GrowLowLatencyPlayoutBuffer())
+        {
+            return;
+        }
+    }
+    ErrorRecovery(error, _handlePlayout);
+}
+
+int32_t AudioDeviceLinuxALSA::SetPcmParams(snd_pcm_t* deviceHandle,
+                                           uint8_t channels,
+                                           uint32_t rate,
+                                           unsigned int latencyUs,
+                                           uint16_t lowLatencyPeriodMs,
+                                           unsigned int lowLatencyPeriods)
+{
+    if (_lowLatencyMode)
+    {
+        // snd_pcm_set_params() always uses four periods or more, which would
+        // keep up to four periods queued for playout.
+        const snd_pcm_uframes_t periodFrames = rate * lowLatencyPeriodMs / 1000;
+        return SetLowLatencyPcmParams(deviceHandle, channels, rate,
+                                      periodFrames,
+                                      lowLatencyPeriods * periodFrames);
+    }
+
+    return LATE(snd_pcm_set_params)(deviceHandle,
+#if defined(WEBRTC_ARCH_BIG_ENDIAN)
+        SND_PCM_FORMAT_S16_BE, //format
+#else
+        SND_PCM_FORMAT_S16_LE, //format
+#endif
+        SND_PCM_ACCESS_RW_INTERLEAVED, //access
+        channels, //channels
+        rate, //rate
+        1, //soft_resample
+        latencyUs //latency in us
+    );
+}
+
+int32_t AudioDeviceLinuxALSA::SetLowLatencyPcmParams(
+    snd_pcm_t* deviceHandle,
+    uint8_t channels,
+    uint32_t rate,
+    snd_pcm_uframes_t periodFrames,
+    snd_pcm_uframes_t bufferFrames)
+{
+    snd_pcm_hw_params_t* params = NULL;
+    int errVal = LATE(snd_pcm_hw_params_malloc)(&params);
+    if (errVal < 0)
+    {
+        return errVal;
+    }
+
+#if defined(WEBRTC_ARCH_BIG_ENDIAN)
+    const snd_pcm_format_t format = SND_PCM_FORMAT_S16_BE;
+#else
+    const snd_pcm_format_t format = SND_PCM_FORMAT_S16_LE;
+#endif
+    unsigned int actualRate = rate;
+    int dir = 0;
+    if ((errVal = LATE(snd_pcm_hw_params_any)(deviceHandle, params)) >= 0 &&
+        (errVal = LATE(snd_pcm_hw_params_set_access)(deviceHandle, params,
+            SND_PCM_ACCESS_RW_INTERLEAVED)) >= 0 &&
+        (errVal = LATE(snd_pcm_hw_params_set_format)(deviceHandle, params,
+            format)) >= 0 &&
+        (errVal = LATE(snd_pcm_hw_params_set_channels)(deviceHandle, params,
+            channels)) >= 0 &&
+        (errVal = LATE(snd_pcm_hw_params_set_rate_near)(deviceHandle, params,
+            &actualRate, &dir)) >= 0 &&
+        (errVal = LATE(snd_pcm_hw_params_set_period_size_near)(deviceHandle,
+            params, &periodFrames, &dir)) >= 0 &&
+        (errVal = LATE(snd_pcm_hw_params_set_buffer_size_near)(deviceHandle,
+            params, &bufferFrames)) >= 0)
+    {
+        // The rest of the device code assumes the requested rate.
+        errVal = (actualRate == rate) ?
+            LATE(snd_pcm_hw_params)(deviceHandle, params) : -EINVAL;
+    }
+
+    LATE(snd_pcm_hw_params_free)(params);
+    return errVal;
+}
+
+bool AudioDeviceLinuxALSA::GrowLowLatencyPlayoutBuffer()
+{
+    const snd_pcm_uframes_t maxBufferFrames =
+        _playoutFreq / 1000 * (ALSA_PLAYOUT_LATENCY / 1000);
+    const snd_pcm_uframes_t bufferFrames =
+        _playoutBufferSizeInFrame + _playoutPeriodSizeInFrame;
+    if (_playoutPeriodSizeInFrame == 0 || bufferFrames > maxBufferFrames)
+    {
+        return false;
+    }
+
+    // The hardware parameters can only be changed on a stopped stream. Once
+    // they are installed the stream is prepared, and restarts on the next
+    // write.
+    LATE(snd_pcm_drop)(_handlePlayout);
+    int errVal = SetLowLatencyPcmParams(_handlePlayout, _playChannels,
+                                        _playoutFreq,
+                                        _playoutPeriodSizeInFrame,
+                                        bufferFrames);
+    if (errVal < 0)
+    {
+        WEBRTC_TRACE(kTraceError, kTraceAudioDevice, _id,
+                     "    unable to grow the playout buffer: %s",
+                     LATE(snd_strerror)(errVal));
+        return false;
+    }
+
+    errVal = LATE(snd_pcm_get_params)(_handlePlayout,
+        &_playoutBufferSizeInFrame, &_playoutPeriodSizeInFrame);
+    if (errVal < 0)
+    {
+        WEBRTC_TRACE(kTraceError, kTraceAudioDevice, _id,
+                     "    snd_pcm_get_params %s",
+                     LATE(snd_strerror)(errVal));
+    }
+    WEBRTC_TRACE(kTraceWarning, kTraceAudioDevice, _id,
+                 "  Playout underrun, buffer_size increased to %d",
+                 _playoutBufferSizeInFrame);
+    return true;
+}
+
 // ============================================================================
 //                                  Thread Methods
 // ============================================================================
@@ -1987,7 +2117,7 @@ bool AudioDeviceLinuxALSA::PlayThreadProcess()
         WEBRTC_TRACE(kTraceError, kTraceAudioDevice, _id,
                    "playout snd_pcm_avail_update error: %s",
                    LATE(snd_strerror)(avail_frames));
-        ErrorRecovery(avail_frames, _handlePlayout);
+        PlayoutErrorRecovery(avail_frames);
         UnLock();
         return true;
     }
@@ -2032,7 +2162,7 @@ bool AudioDeviceLinuxALSA::PlayThreadProcess()
                      "playout snd_pcm_writei error: %s",
                      LATE(snd_strerror)(frames));
         _playoutFramesLeft = 0;
-        ErrorRecovery(frames, _handlePlayout);
+        PlayoutErrorRecovery(frames);
         UnLock();
         return true;
     }
@@ -13,6 +13,7 @@
 
 #include <memory>
 
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/platform_thread.h"
 #include "webrtc/modules/audio_device/audio_device_generic.h"
 #include "webrtc/modules/audio_device/linux/audio_mixer_manager_alsa_linux.h"
@@ -142,6 +143,12 @@ public:
     int32_t PlayoutDelay(uint16_t& delayMS) const override;
     int32_t RecordingDelay(uint16_t& delayMS) const override;
 
+    // Low-latency mode
+    int32_t SetLowLatencyMode(bool enable,
+                              uint16_t playoutPeriodMS,
+                              uint16_t recordingPeriodMS) override;
+    int32_t GetPlayoutUnderrunCount() const override;
+
     // CPU load
     int32_t CPULoad(uint16_t& load) const override;
 
@@ -165,6 +172,19 @@ private:
                            char* enumDeviceName = NULL,
                            const int32_t ednLen = 0) const;
     int32_t ErrorRecovery(int32_t error, snd_pcm_t* deviceHandle);
+    void PlayoutErrorRecovery(int32_t error);
+    int32_t SetPcmParams(snd_pcm_t* deviceHandle,
+                         uint8_t channels,
+                         uint32_t rate,
+                         unsigned int latencyUs,
+                         uint16_t lowLatencyPeriodMs,
+                         unsigned int lowLatencyPeriods);
+    int32_t SetLowLatencyPcmParams(snd_pcm_t* deviceHandle,
+                                   uint8_t channels,
+                                   uint32_t rate,
+                                   snd_pcm_uframes_t periodFrames,
+                                   snd_pcm_uframes_t bufferFrames);
+    bool GrowLowLatencyPlayoutBuffer();
 
 private:
     bool KeyPressed() const;
@@ -245,6 +265,13 @@ private:
     uint16_t _playBufDelay;                 // playback delay
     uint16_t _playBufDelayFixed;            // fixed playback delay
 
+    // Low-latency mode, see AudioDeviceModule::SetLowLatencyMode().
+    bool _lowLatencyMode;
+    uint16_t _lowLatencyPlayPeriodMs;
+    uint16_t _lowLatencyRecPeriodMs;
+    // Incremented on the playout thread.
+    volatile int _playUnderrunCount;
+
     char _oldKeyState[32];
 #if defined(USE_X11)
     Display* _XDisplay;
@@ -57,6 +57,10 @@ AudioDeviceLinuxPulse::AudioDeviceLinuxPulse(const int32_t id) :
     _AGC(false),
     update_speaker_volume_at_startup_(false),
     _playBufDelayFixed(20),
+    _lowLatencyMode(false),
+    _lowLatencyPlayPeriodMs(0),
+    _lowLatencyRecPeriodMs(0),
+    _playUnderrunCount(0),
     _sndCardPlayDelay(0),
     _sndCardRecDelay(0),
     _writeErrors(0),
@@ -1176,9 +1180,10 @@ int32_t AudioDeviceLinuxPulse::InitPlayout()
         }
 
         size_t bytesPerSec = LATE(pa_bytes_per_second)(spec);
-        uint32_t latency = bytesPerSec *
-                           WEBRTC_PA_PLAYBACK_LATENCY_MINIMUM_MSECS /
-                           WEBRTC_PA_MSECS_PER_SEC;
+        uint32_t latencyMs = _lowLatencyMode ?
+            _lowLatencyPlayPeriodMs * WEBRTC_PA_PLAYBACK_REQUEST_FACTOR :
+            WEBRTC_PA_PLAYBACK_LATENCY_MINIMUM_MSECS;
+        uint32_t latency = bytesPerSec * latencyMs / WEBRTC_PA_MSECS_PER_SEC;
 
         // Set the play buffer attributes
         _playBufferAttr.maxlength = latency; // num bytes stored in the buffer
@@ -1197,6 +1202,8 @@ int32_t AudioDeviceLinuxPulse::InitPlayout()
     _playbackBufferUnused = _playbackBufferSize;
     _playBuffer = new int8_t[_playbackBufferSize];
 
+    rtc::AtomicOps::ReleaseStore(&_playUnderrunCount, 0);
+
     // Enable underflow callback
     LATE(pa_stream_set_underflow_callback)(_playStream,
                                            PaStreamUnderflowCallback, this);
@@ -1292,8 +1299,9 @@ int32_t AudioDeviceLinuxPulse::InitRecording()
         }
 
         size_t bytesPerSec = LATE(pa_bytes_per_second)(spec);
-        uint32_t latency = bytesPerSec
-            * WEBRTC_PA_LOW_CAPTURE_LATENCY_MSECS / WEBRTC_PA_MSECS_PER_SEC;
+        uint32_t latencyMs = _lowLatencyMode ?
+            _lowLatencyRecPeriodMs : WEBRTC_PA_LOW_CAPTURE_LATENCY_MSECS;
+        uint32_t latency = bytesPerSec * latencyMs / WEBRTC_PA_MSECS_PER_SEC;
 
         // Set the rec buffer attributes
         // Note: fragsize specifies a maximum transfer size, not a minimum, so
@@ -1621,6 +1629,23 @@ int32_t AudioDeviceLinuxPulse::PlayoutBuffer(
     return 0;
 }
 
+int32_t AudioDeviceLinuxPulse::SetLowLatencyMode(bool enable,
+                                                 uint16_t playoutPeriodMS,
+                                                 uint16_t recordingPeriodMS)
+{
+    RTC_DCHECK(thread_checker_.CalledOnValidThread());
+    _lowLatencyMode = enable;
+    _lowLatencyPlayPeriodMs = playoutPeriodMS;
+    _lowLatencyRecPeriodMs = recordingPeriodMS;
+
+    return 0;
+}
+
+int32_t AudioDeviceLinuxPulse::GetPlayoutUnderrunCount() const
+{
+    return rtc::AtomicOps::AcquireLoad(&_playUnderrunCount);
+}
+
 int32_t AudioDeviceLinuxPulse::CPULoad(uint16_t& /*load*/) const
 {
 
@@ -2286,6 +2311,8 @@ void AudioDeviceLinuxPulse::PaStreamUnderflowCallbackHandler()
     WEBRTC_TRACE(kTraceWarning, kTraceAudioDevice, _id,
                  "  Playout underflow");
 
+    rtc::AtomicOps::Increment(&_playUnderrunCount);
+
     if (_configuredLatencyPlay == WEBRTC_PA_NO_LATENCY_REQUIREMENTS)
     {
         // We didn't configure a pa_buffer_attr before, so switching to
@@ -2304,8 +2331,9 @@ void AudioDeviceLinuxPulse::PaStreamUnderflowCallbackHandler()
     }
 
     size_t bytesPerSec = LATE(pa_bytes_per_second)(spec);
-    uint32_t newLatency = _configuredLatencyPlay + bytesPerSec *
-                          WEBRTC_PA_PLAYBACK_LATENCY_INCREMENT_MSECS /
+    uint32_t incrementMs = _lowLatencyMode ?
+        _lowLatencyPlayPeriodMs : WEBRTC_PA_PLAYBACK_LATENCY_INCREMENT_MSECS;
+    uint32_t newLatency = _configuredLatencyPlay + bytesPerSec * incrementMs /
                           WEBRTC_PA_MSECS_PER_SEC;
 
     // Set the play buffer attributes
@@ -13,6 +13,7 @@
 
 #include <memory>
 
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/platform_thread.h"
 #include "webrtc/base/thread_checker.h"
 #include "webrtc/modules/audio_device/audio_device_generic.h"
@@ -64,6 +65,10 @@ const uint32_t WEBRTC_PA_PLAYBACK_LATENCY_INCREMENT_MSECS = 20;
 // would be a buffer underflow risk. We set it to half of the buffer size.
 const uint32_t WEBRTC_PA_PLAYBACK_REQUEST_FACTOR = 2;
 
+// In low-latency mode the target latency is instead the configured period
+// times WEBRTC_PA_PLAYBACK_REQUEST_FACTOR, so that the server requests one
+// period at a time, and each underflow adds a single period.
+
 // Capture.
 
 // For capture, low latency is not a buffer overflow risk, but it makes us burn
@@ -204,6 +209,12 @@ public:
     int32_t PlayoutDelay(uint16_t& delayMS) const override;
     int32_t RecordingDelay(uint16_t& delayMS) const override;
 
+    // Low-latency mode
+    int32_t SetLowLatencyMode(bool enable,
+                              uint16_t playoutPeriodMS,
+                              uint16_t recordingPeriodMS) override;
+    int32_t GetPlayoutUnderrunCount() const override;
+
     // CPU load
     int32_t CPULoad(uint16_t& load) const override;
 
@@ -324,6 +335,13 @@ private:
 
     uint16_t _playBufDelayFixed; // fixed playback delay
 
+    // Low-latency mode, see AudioDeviceModule::SetLowLatencyMode().
+    bool _lowLatencyMode;
+    uint16_t _lowLatencyPlayPeriodMs;
+    uint16_t _lowLatencyRecPeriodMs;
+    // Incremented on the PulseAudio mainloop thread.
+    volatile int _playUnderrunCount;
+
     uint32_t _sndCardPlayDelay;
     uint32_t _sndCardRecDelay;
 
@@ -1572,6 +1572,28 @@ TEST_F(AudioDeviceAPITest, PlayoutBufferTests) {
 #endif
 }
 
+TEST_F(AudioDeviceAPITest, LowLatencyModeTests) {
+  // fail tests
+  EXPECT_EQ(-1, audio_device_->SetLowLatencyMode(
+      true, kAdmMinLowLatencyPeriodMs - 1, kAdmMinLowLatencyPeriodMs));
+  EXPECT_EQ(-1, audio_device_->SetLowLatencyMode(
+      true, kAdmMinLowLatencyPeriodMs, kAdmMaxLowLatencyPeriodMs + 1));
+
+#if defined(WEBRTC_LINUX) && !defined(ANDROID)
+  EXPECT_EQ(0, audio_device_->SetLowLatencyMode(true, 5, 5));
+  EXPECT_EQ(0, audio_device_->SetPlayoutDevice(
+      MACRO_DEFAULT_COMMUNICATION_DEVICE));
+  EXPECT_EQ(0, audio_device_->InitPlayout());
+  EXPECT_EQ(0, audio_device_->GetPlayoutUnderrunCount());
+  EXPECT_EQ(0, audio_device_->StopPlayout());
+  // restore default
+  EXPECT_EQ(0, audio_device_->SetLowLatencyMode(false, 0, 0));
+#else
+  EXPECT_EQ(-1, audio_device_->SetLowLatencyMode(true, 5, 5));
+  EXPECT_EQ(-1, audio_device_->GetPlayoutUnderrunCount());
+#endif
+}
+
 TEST_F(AudioDeviceAPITest, PlayoutDelay) {
   // NOTE: this API is better tested in a functional test
   uint16_t sizeMS(0);
@@ -11,6 +11,7 @@
 #include "webrtc/audio/utility/audio_frame_operations.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/modules/audio_mixer/audio_frame_manipulator.h"
+#include "webrtc/modules/audio_mixer/mixing_kernels_c.h"
 #include "webrtc/modules/include/module_common_types.h"
 
 namespace webrtc {
@@ -26,6 +27,13 @@ uint32_t AudioMixerCalculateEnergy(const AudioFrame& audio_frame) {
 }
 
 void Ramp(float start_gain, float target_gain, AudioFrame* audio_frame) {
+  Ramp(MixingKernelsC(), start_gain, target_gain, audio_frame);
+}
+
+void Ramp(const MixingKernels& kernels,
+          float start_gain,
+          float target_gain,
+          AudioFrame* audio_frame) {
   RTC_DCHECK(audio_frame);
   RTC_DCHECK_GE(start_gain, 0.0f);
   RTC_DCHECK_GE(target_gain, 0.0f);
@@ -35,16 +43,20 @@ void Ramp(float start_gain, float target_gain, AudioFrame* audio_frame) {
 
   size_t samples = audio_frame->samples_per_channel_;
   RTC_DCHECK_LT(0, samples);
+  const size_t num_channels = audio_frame->num_channels_;
+  float gains[AudioFrame::kMaxDataSizeSamples];
+  RTC_DCHECK_LE(samples * num_channels, AudioFrame::kMaxDataSizeSamples);
   float increment = (target_gain - start_gain) / samples;
   float gain = start_gain;
   for (size_t i = 0; i < samples; ++i) {
     // If the audio is interleaved of several channels, we want to
     // apply the same gain change to the ith sample of every channel.
-    for (size_t ch = 0; ch < audio_frame->num_channels_; ++ch) {
-      audio_frame->data_[audio_frame->num_channels_ * i + ch] *= gain;
+    for (size_t ch = 0; ch < num_channels; ++ch) {
+      gains[num_channels * i + ch] = gain;
     }
     gain += increment;
   }
+  kernels.ApplyGains(gains, samples * num_channels, audio_frame->data_);
 }
 
 void RemixFrame(size_t target_number_of_channels, AudioFrame* frame) {
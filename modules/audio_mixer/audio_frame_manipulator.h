@@ -11,6 +11,7 @@
 #ifndef WEBRTC_MODULES_AUDIO_MIXER_AUDIO_FRAME_MANIPULATOR_H_
 #define WEBRTC_MODULES_AUDIO_MIXER_AUDIO_FRAME_MANIPULATOR_H_
 
+#include "webrtc/modules/audio_mixer/mixing_kernels.h"
 #include "webrtc/modules/include/module_common_types.h"
 
 namespace webrtc {
@@ -21,6 +22,11 @@ uint32_t AudioMixerCalculateEnergy(const AudioFrame& audio_frame);
 // Ramps up or down the provided audio frame. Ramp(0, 1, frame) will
 // linearly increase the samples in the frame from 0 to full volume.
 void Ramp(float start_gain, float target_gain, AudioFrame* audio_frame);
+// Same as above, applying the gains with |kernels|.
+void Ramp(const MixingKernels& kernels,
+          float start_gain,
+          float target_gain,
+          AudioFrame* audio_frame);
 
 // Downmixes or upmixes a frame between stereo and mono.
 void RemixFrame(size_t target_number_of_channels, AudioFrame* frame);
@@ -9,8 +9,11 @@
  */
 
 #include <algorithm>
+#include <memory>
 
+#include "webrtc/base/random.h"
 #include "webrtc/modules/audio_mixer/audio_frame_manipulator.h"
+#include "webrtc/modules/audio_mixer/mixing_kernels_c.h"
 #include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/test/gtest.h"
 
@@ -60,4 +63,40 @@ TEST(AudioFrameManipulator, CompareBackwardRampWithExpectedResultMono) {
       std::equal(frame.data_, frame.data_ + total_samples, expected_result));
 }
 
+// The kernels picked for the CPU must give the same results as the C ones,
+// including saturation and for lengths that aren't a multiple of the vector
+// size.
+TEST(AudioFrameManipulator, MixingKernelsMatchC) {
+  constexpr size_t kLength = 2 * 480 + 5;
+  Random random(0x1234);
+  MixingKernelsC kernels_c;
+  std::unique_ptr<MixingKernels> kernels = MixingKernels::Create();
+
+  int16_t src[kLength];
+  int32_t acc_c[kLength];
+  int32_t acc[kLength];
+  float gains[kLength];
+  for (size_t i = 0; i < kLength; ++i) {
+    src[i] = random.Rand(-32768, 32767);
+    acc_c[i] = acc[i] = random.Rand(-100000, 100000);
+    gains[i] = random.Rand<float>();
+  }
+
+  for (int shift = 0; shift <= 1; ++shift) {
+    kernels_c.Accumulate(src, kLength, shift, acc_c);
+    kernels->Accumulate(src, kLength, shift, acc);
+    EXPECT_TRUE(std::equal(acc_c, acc_c + kLength, acc));
+  }
+
+  int16_t dst_c[kLength];
+  int16_t dst[kLength];
+  kernels_c.Saturate(acc_c, kLength, dst_c);
+  kernels->Saturate(acc, kLength, dst);
+  EXPECT_TRUE(std::equal(dst_c, dst_c + kLength, dst));
+
+  kernels_c.ApplyGains(gains, kLength, dst_c);
+  kernels->ApplyGains(gains, kLength, dst);
+  EXPECT_TRUE(std::equal(dst_c, dst_c + kLength, dst));
+}
+
 }  // namespace webrtc
@@ -19,6 +19,7 @@
 #include "webrtc/base/logging.h"
 #include "webrtc/modules/audio_mixer/audio_frame_manipulator.h"
 #include "webrtc/modules/audio_mixer/default_output_rate_calculator.h"
+#include "webrtc/system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 namespace {
@@ -70,10 +71,11 @@ bool ShouldMixBefore(const SourceFrame& a, const SourceFrame& b) {
 }
 
 void RampAndUpdateGain(
+    const MixingKernels& kernels,
     const std::vector<SourceFrame>& mixed_sources_and_frames) {
   for (const auto& source_frame : mixed_sources_and_frames) {
     float target_gain = source_frame.source_status->is_mixed ? 1.0f : 0.0f;
-    Ramp(source_frame.source_status->gain, target_gain,
+    Ramp(kernels, source_frame.source_status->gain, target_gain,
          source_frame.audio_frame);
     source_frame.source_status->gain = target_gain;
   }
@@ -82,7 +84,8 @@ void RampAndUpdateGain(
 // Mix the AudioFrames stored in audioFrameList into mixed_audio.
 int32_t MixFromList(AudioFrame* mixed_audio,
                     const AudioFrameList& audio_frame_list,
-                    bool use_limiter) {
+                    bool use_limiter,
+                    const MixingKernels& kernels) {
   if (audio_frame_list.empty()) {
     return 0;
   }
@@ -97,6 +100,14 @@ int32_t MixFromList(AudioFrame* mixed_audio,
     mixed_audio->elapsed_time_ms_ = -1;
   }
 
+  // Sum the frames in 32 bits and saturate once, instead of saturating after
+  // adding each frame.
+  const size_t samples_per_channel =
+      audio_frame_list.front()->samples_per_channel_;
+  const size_t length = samples_per_channel * mixed_audio->num_channels_;
+  RTC_DCHECK_LE(length, AudioFrame::kMaxDataSizeSamples);
+  int32_t mixed_samples[AudioFrame::kMaxDataSizeSamples];
+  std::fill(mixed_samples, mixed_samples + length, 0);
   for (const auto& frame : audio_frame_list) {
     RTC_DCHECK_EQ(mixed_audio->sample_rate_hz_, frame->sample_rate_hz_);
     RTC_DCHECK_EQ(
@@ -104,20 +115,54 @@ int32_t MixFromList(AudioFrame* mixed_audio,
         static_cast<size_t>((mixed_audio->sample_rate_hz_ *
                              webrtc::AudioMixerImpl::kFrameDurationInMs) /
                             1000));
+    RTC_DCHECK_EQ(frame->num_channels_, mixed_audio->num_channels_);
 
-    // Mix |f.frame| into |mixed_audio|, with saturation protection.
-    // These effect is applied to |f.frame| itself prior to mixing.
-    if (use_limiter) {
-      // This is to avoid saturation in the mixing. It is only
-      // meaningful if the limiter will be used.
-      AudioFrameOperations::ApplyHalfGain(frame);
+    // Mix |frame| into |mixed_samples|. If the limiter will be used, halve
+    // the frame to avoid saturation in the mixing.
+    kernels.Accumulate(frame->data_, length, use_limiter ? 1 : 0,
+                       mixed_samples);
+
+    if (mixed_audio->vad_activity_ == AudioFrame::kVadActive ||
+        frame->vad_activity_ == AudioFrame::kVadActive) {
+      mixed_audio->vad_activity_ = AudioFrame::kVadActive;
+    } else if (mixed_audio->vad_activity_ == AudioFrame::kVadUnknown ||
+               frame->vad_activity_ == AudioFrame::kVadUnknown) {
+      mixed_audio->vad_activity_ = AudioFrame::kVadUnknown;
     }
-    RTC_DCHECK_EQ(frame->num_channels_, mixed_audio->num_channels_);
-    AudioFrameOperations::Add(*frame, mixed_audio);
+    if (mixed_audio->speech_type_ != frame->speech_type_)
+      mixed_audio->speech_type_ = AudioFrame::kUndefined;
   }
+  mixed_audio->samples_per_channel_ = samples_per_channel;
+  kernels.Saturate(mixed_samples, length, mixed_audio->data_);
   return 0;
 }
 
+// Returns which sources can't make it into the mix according to the audio
+// levels they signal, i.e. all but the kMaximumAmountOfMixedAudioSources
+// loudest ones. Sources without a known level, and those mixed in the last
+// round so that they can be ramped out, are never skipped.
+std::vector<bool> SourcesToSkip(
+    const AudioMixerImpl::SourceStatusList& audio_source_list) {
+  std::vector<bool> skip(audio_source_list.size(), false);
+  // Pairs of level in -dBov and index in |audio_source_list|.
+  std::vector<std::pair<int, size_t>> levels;
+  for (size_t i = 0; i < audio_source_list.size(); ++i) {
+    const AudioMixerImpl::SourceStatus& status = *audio_source_list[i];
+    const rtc::Optional<int> level = status.audio_source->AudioLevelDbov();
+    if (level && !status.is_mixed)
+      levels.emplace_back(*level, i);
+  }
+  const size_t kNumCandidates =
+      AudioMixerImpl::kMaximumAmountOfMixedAudioSources;
+  if (levels.size() <= kNumCandidates)
+    return skip;
+  // Lowest -dBov, i.e. loudest, first.
+  std::sort(levels.begin(), levels.end());
+  for (size_t i = kNumCandidates; i < levels.size(); ++i)
+    skip[levels[i].second] = true;
+  return skip;
+}
+
 AudioMixerImpl::SourceStatusList::const_iterator FindSourceInList(
     AudioMixerImpl::Source const* audio_source,
     AudioMixerImpl::SourceStatusList const* audio_source_list) {
@@ -185,7 +230,11 @@ AudioMixerImpl::AudioMixerImpl(
       audio_source_list_(),
       use_limiter_(true),
       time_stamp_(0),
-      limiter_(std::move(limiter)) {}
+      limiter_(std::move(limiter)),
+      kernels_(MixingKernels::Create()),
+      level_gating_enabled_(
+          field_trial::FindFullName("WebRTC-AudioMixerLevelGating") ==
+          "Enabled") {}
 
 AudioMixerImpl::~AudioMixerImpl() {}
 
@@ -228,7 +277,7 @@ void AudioMixerImpl::Mix(size_t number_of_channels,
     use_limiter_ = mix_list.size() > 1;
 
     // We only use the limiter if we're actually mixing multiple streams.
-    MixFromList(audio_frame_for_mixing, mix_list, use_limiter_);
+    MixFromList(audio_frame_for_mixing, mix_list, use_limiter_, *kernels_);
   }
 
   if (audio_frame_for_mixing->samples_per_channel_ == 0) {
@@ -288,8 +337,22 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
   std::vector<SourceFrame> audio_source_mixing_data_list;
   std::vector<SourceFrame> ramp_list;
 
+  // With level gating, only the sources that may be among the loudest
+  // according to their signalled audio levels produce their audio.
+  const std::vector<bool> skip =
+      level_gating_enabled_ ? SourcesToSkip(audio_source_list_)
+                            : std::vector<bool>(audio_source_list_.size());
+
   // Get audio from the audio sources and put it in the SourceFrame vector.
-  for (auto& source_and_status : audio_source_list_) {
+  for (size_t i = 0; i < audio_source_list_.size(); ++i) {
+    auto& source_and_status = audio_source_list_[i];
+    if (skip[i]) {
+      source_and_status->audio_source->SkipAudioFrame(
+          OutputFrequency(), &source_and_status->audio_frame);
+      // Wasn't mixed last round either, so there is nothing to ramp out.
+      source_and_status->is_mixed = false;
+      continue;
+    }
     const auto audio_frame_info =
         source_and_status->audio_source->GetAudioFrameWithInfo(
             OutputFrequency(), &source_and_status->audio_frame);
@@ -327,7 +390,7 @@ AudioFrameList AudioMixerImpl::GetAudioFromSources() {
     }
     p.source_status->is_mixed = is_mixed;
   }
-  RampAndUpdateGain(ramp_list);
+  RampAndUpdateGain(*kernels_, ramp_list);
   return result;
 }
 
@@ -18,6 +18,7 @@
 #include "webrtc/base/scoped_ref_ptr.h"
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/base/race_checker.h"
+#include "webrtc/modules/audio_mixer/mixing_kernels.h"
 #include "webrtc/modules/audio_mixer/output_rate_calculator.h"
 #include "webrtc/modules/audio_processing/include/audio_processing.h"
 #include "webrtc/modules/include/module_common_types.h"
@@ -77,7 +78,9 @@ class AudioMixerImpl : public AudioMixer {
 
   // Compute what audio sources to mix from audio_source_list_. Ramp
   // in and out. Update mixed status. Mixes up to
-  // kMaximumAmountOfMixedAudioSources audio sources.
+  // kMaximumAmountOfMixedAudioSources audio sources. With level gating,
+  // sources that can't be mixed according to their signalled audio levels
+  // are skipped without getting their audio.
   AudioFrameList GetAudioFromSources() EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   // Add/remove the MixerAudioSource to the specified
@@ -112,6 +115,13 @@ class AudioMixerImpl : public AudioMixer {
   // Used for inhibiting saturation in mixing.
   std::unique_ptr<AudioProcessing> limiter_ GUARDED_BY(race_checker_);
 
+  // Sample loops for ramping and mixing.
+  const std::unique_ptr<MixingKernels> kernels_;
+
+  // If sources that signal audio levels too low to be mixed are skipped
+  // rather than asked for their audio.
+  const bool level_gating_enabled_;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(AudioMixerImpl);
 };
 }  // namespace webrtc
@@ -19,6 +19,7 @@
 #include "webrtc/base/thread.h"
 #include "webrtc/modules/audio_mixer/audio_mixer_impl.h"
 #include "webrtc/modules/audio_mixer/default_output_rate_calculator.h"
+#include "webrtc/test/field_trial.h"
 #include "webrtc/test/gmock.h"
 
 using testing::_;
@@ -59,6 +60,8 @@ class MockMixerAudioSource : public AudioMixer::Source {
             Invoke(this, &MockMixerAudioSource::FakeAudioFrameWithInfo));
     ON_CALL(*this, PreferredSampleRate())
         .WillByDefault(Return(kDefaultSampleRateHz));
+    ON_CALL(*this, AudioLevelDbov())
+        .WillByDefault(Return(rtc::Optional<int>()));
   }
 
   MOCK_METHOD2(GetAudioFrameWithInfo,
@@ -66,6 +69,8 @@ class MockMixerAudioSource : public AudioMixer::Source {
 
   MOCK_CONST_METHOD0(PreferredSampleRate, int());
   MOCK_CONST_METHOD0(Ssrc, int());
+  MOCK_CONST_METHOD0(AudioLevelDbov, rtc::Optional<int>());
+  MOCK_METHOD2(SkipAudioFrame, void(int sample_rate_hz, AudioFrame* frame));
 
   AudioFrame* fake_frame() { return &fake_frame_; }
   AudioFrameInfo fake_info() { return fake_audio_frame_info_; }
@@ -354,6 +359,44 @@ TEST(AudioMixer, RampedOutSourcesShouldNotBeMarkedMixed) {
   }
 }
 
+// With level gating, only the sources that signal the loudest audio levels
+// and those that don't signal levels at all are asked for audio.
+TEST(AudioMixer, LevelGatingSkipsSourcesTooQuietToBeMixed) {
+  test::ScopedFieldTrials field_trials("WebRTC-AudioMixerLevelGating/Enabled/");
+  constexpr int kLevelSources =
+      AudioMixerImpl::kMaximumAmountOfMixedAudioSources + 2;
+  constexpr int kAudioSources = kLevelSources + 1;
+
+  const auto mixer = AudioMixerImpl::Create();
+  MockMixerAudioSource participants[kAudioSources];
+
+  for (int i = 0; i < kAudioSources; i++) {
+    ResetFrame(participants[i].fake_frame());
+    // The signalled levels get quieter with the index |i|, and the last
+    // participant doesn't signal any.
+    if (i < kLevelSources) {
+      ON_CALL(participants[i], AudioLevelDbov())
+          .WillByDefault(Return(rtc::Optional<int>(10 * i)));
+    }
+    EXPECT_TRUE(mixer->AddSource(&participants[i]));
+    const bool skipped =
+        i >= AudioMixerImpl::kMaximumAmountOfMixedAudioSources &&
+        i < kLevelSources;
+    EXPECT_CALL(participants[i], GetAudioFrameWithInfo(kDefaultSampleRateHz, _))
+        .Times(Exactly(skipped ? 0 : 1));
+    EXPECT_CALL(participants[i], SkipAudioFrame(kDefaultSampleRateHz, _))
+        .Times(Exactly(skipped ? 1 : 0));
+  }
+
+  mixer->Mix(1, &frame_for_mixing);
+
+  for (int i = AudioMixerImpl::kMaximumAmountOfMixedAudioSources;
+       i < kLevelSources; i++) {
+    EXPECT_FALSE(mixer->GetAudioSourceMixabilityStatusForTest(&participants[i]))
+        << "Mixed status of AudioSource #" << i << " wrong.";
+  }
+}
+
 // This test checks that the initialization and participant addition
 // can be done on a different thread.
 TEST(AudioMixer, ConstructFromOtherThread) {
@@ -0,0 +1,126 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/random.h"
+#include "webrtc/modules/audio_mixer/audio_frame_manipulator.h"
+#include "webrtc/modules/audio_mixer/audio_mixer_impl.h"
+#include "webrtc/modules/audio_mixer/mixing_kernels.h"
+#include "webrtc/modules/audio_mixer/mixing_kernels_c.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+constexpr int kSampleRateHz = 48000;
+constexpr size_t kNumChannels = 2;
+constexpr size_t kSamplesPerChannel = kSampleRateHz / 100;
+constexpr int kNumIterations = 10000;
+
+// A source of loud stereo noise, with a different energy per source.
+class NoiseSource : public AudioMixer::Source {
+ public:
+  NoiseSource(int ssrc, Random* random) : ssrc_(ssrc) {
+    frame_.UpdateFrame(-1, 0, nullptr, kSamplesPerChannel, kSampleRateHz,
+                       AudioFrame::kNormalSpeech, AudioFrame::kVadActive,
+                       kNumChannels);
+    const int amplitude = 1000 + 1000 * ssrc;
+    for (size_t i = 0; i < kSamplesPerChannel * kNumChannels; ++i)
+      frame_.data_[i] = random->Rand(-amplitude, amplitude);
+  }
+
+  AudioFrameInfo GetAudioFrameWithInfo(int sample_rate_hz,
+                                       AudioFrame* audio_frame) override {
+    audio_frame->CopyFrom(frame_);
+    return AudioFrameInfo::kNormal;
+  }
+  int Ssrc() const override { return ssrc_; }
+  int PreferredSampleRate() const override { return kSampleRateHz; }
+
+ private:
+  const int ssrc_;
+  AudioFrame frame_;
+};
+
+int64_t TimeKernels(const MixingKernels& kernels,
+                    const std::vector<AudioFrame>& frames) {
+  const size_t length = kSamplesPerChannel * kNumChannels;
+  int32_t mixed_samples[AudioFrame::kMaxDataSizeSamples];
+  AudioFrame mixed;
+  Clock* clock = Clock::GetRealTimeClock();
+  int64_t start_time_us = clock->TimeInMicroseconds();
+  for (int i = 0; i < kNumIterations; ++i) {
+    AudioFrame ramped;
+    ramped.CopyFrom(frames[0]);
+    Ramp(kernels, 0.0f, 1.0f, &ramped);
+    std::fill(mixed_samples, mixed_samples + length, 0);
+    for (const AudioFrame& frame : frames)
+      kernels.Accumulate(frame.data_, length, 1, mixed_samples);
+    kernels.Saturate(mixed_samples, length, mixed.data_);
+  }
+  return clock->TimeInMicroseconds() - start_time_us;
+}
+}  // namespace
+
+// Time to mix 10 ms of 48 kHz stereo audio from a number of sources, of which
+// the loudest AudioMixerImpl::kMaximumAmountOfMixedAudioSources are mixed.
+TEST(AudioMixerPerformanceTest, Mix) {
+  Random random(0x5678);
+  for (int num_sources : {3, 4, 8, 16}) {
+    std::vector<std::unique_ptr<NoiseSource>> sources;
+    const auto mixer = AudioMixerImpl::Create();
+    for (int i = 0; i < num_sources; ++i) {
+      sources.emplace_back(new NoiseSource(i, &random));
+      mixer->AddSource(sources.back().get());
+    }
+    AudioFrame mixed;
+    Clock* clock = Clock::GetRealTimeClock();
+    int64_t start_time_us = clock->TimeInMicroseconds();
+    for (int i = 0; i < kNumIterations; ++i)
+      mixer->Mix(kNumChannels, &mixed);
+    int64_t mix_time_us = clock->TimeInMicroseconds() - start_time_us;
+
+    test::PrintResult("audio_mixer_mix", "",
+                      std::to_string(num_sources) + "_sources",
+                      static_cast<double>(mix_time_us) / kNumIterations, "us",
+                      false);
+  }
+}
+
+// Time to ramp one frame and sum a number of frames, with the plain C kernels
+// and the ones picked for the CPU.
+TEST(AudioMixerPerformanceTest, MixingKernels) {
+  Random random(0x5678);
+  std::unique_ptr<MixingKernels> kernels = MixingKernels::Create();
+  for (int num_frames : {3, 8, 16}) {
+    std::vector<AudioFrame> frames(num_frames);
+    for (int i = 0; i < num_frames; ++i) {
+      NoiseSource source(i, &random);
+      source.GetAudioFrameWithInfo(kSampleRateHz, &frames[i]);
+    }
+    const std::string trace = std::to_string(num_frames) + "_frames";
+    test::PrintResult(
+        "mixing_kernels_c", "", trace,
+        static_cast<double>(TimeKernels(MixingKernelsC(), frames)) /
+            kNumIterations,
+        "us", false);
+    test::PrintResult("mixing_kernels_simd", "", trace,
+                      static_cast<double>(TimeKernels(*kernels, frames)) /
+                          kNumIterations,
+                      "us", false);
+  }
+}
+
+}  // namespace webrtc
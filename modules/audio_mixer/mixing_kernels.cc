@@ -0,0 +1,38 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_mixer/mixing_kernels.h"
+
+#include "webrtc/modules/audio_mixer/mixing_kernels_c.h"
+#include "webrtc/modules/audio_mixer/mixing_kernels_neon.h"
+#include "webrtc/modules/audio_mixer/mixing_kernels_sse2.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+
+namespace webrtc {
+
+std::unique_ptr<MixingKernels> MixingKernels::Create() {
+// If we know the minimum architecture at compile time, avoid CPU detection.
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#if defined(__SSE2__)
+  return std::unique_ptr<MixingKernels>(new MixingKernelsSSE2());
+#else
+  // x86 CPU detection required.
+  if (WebRtc_GetCPUInfo(kSSE2))
+    return std::unique_ptr<MixingKernels>(new MixingKernelsSSE2());
+  return std::unique_ptr<MixingKernels>(new MixingKernelsC());
+#endif
+#elif defined(WEBRTC_HAS_NEON)
+  return std::unique_ptr<MixingKernels>(new MixingKernelsNEON());
+#else
+  return std::unique_ptr<MixingKernels>(new MixingKernelsC());
+#endif
+}
+
+}  // namespace webrtc
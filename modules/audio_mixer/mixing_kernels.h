@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_MIXER_MIXING_KERNELS_H_
+#define WEBRTC_MODULES_AUDIO_MIXER_MIXING_KERNELS_H_
+
+#include <stddef.h>
+
+#include <memory>
+
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+// Sample loops used for mixing and ramping, with SSE2 and NEON versions.
+// All of them work on |length| interleaved samples.
+class MixingKernels {
+ public:
+  // Returns the fastest kernels supported by the CPU.
+  static std::unique_ptr<MixingKernels> Create();
+
+  virtual ~MixingKernels() {}
+
+  // Adds |src| shifted right by |shift| bits to |acc|. Mixing into 32 bits
+  // needs a single saturation at the end, whatever the number of sources.
+  virtual void Accumulate(const int16_t* src,
+                          size_t length,
+                          int shift,
+                          int32_t* acc) const = 0;
+
+  // Saturates |acc| to 16 bits into |dst|.
+  virtual void Saturate(const int32_t* acc,
+                        size_t length,
+                        int16_t* dst) const = 0;
+
+  // Multiplies |data| by |gains|, truncating the results towards zero.
+  virtual void ApplyGains(const float* gains,
+                          size_t length,
+                          int16_t* data) const = 0;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_MIXER_MIXING_KERNELS_H_
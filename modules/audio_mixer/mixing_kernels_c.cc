@@ -0,0 +1,39 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_mixer/mixing_kernels_c.h"
+
+#include "webrtc/base/safe_conversions.h"
+
+namespace webrtc {
+
+void MixingKernelsC::Accumulate(const int16_t* src,
+                                size_t length,
+                                int shift,
+                                int32_t* acc) const {
+  for (size_t i = 0; i < length; ++i)
+    acc[i] += src[i] >> shift;
+}
+
+void MixingKernelsC::Saturate(const int32_t* acc,
+                              size_t length,
+                              int16_t* dst) const {
+  for (size_t i = 0; i < length; ++i)
+    dst[i] = rtc::saturated_cast<int16_t>(acc[i]);
+}
+
+void MixingKernelsC::ApplyGains(const float* gains,
+                                size_t length,
+                                int16_t* data) const {
+  for (size_t i = 0; i < length; ++i)
+    data[i] *= gains[i];
+}
+
+}  // namespace webrtc
@@ -0,0 +1,32 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_MIXER_MIXING_KERNELS_C_H_
+#define WEBRTC_MODULES_AUDIO_MIXER_MIXING_KERNELS_C_H_
+
+#include "webrtc/modules/audio_mixer/mixing_kernels.h"
+
+namespace webrtc {
+
+class MixingKernelsC : public MixingKernels {
+ public:
+  void Accumulate(const int16_t* src,
+                  size_t length,
+                  int shift,
+                  int32_t* acc) const override;
+  void Saturate(const int32_t* acc, size_t length, int16_t* dst) const override;
+  void ApplyGains(const float* gains,
+                  size_t length,
+                  int16_t* data) const override;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_MIXER_MIXING_KERNELS_C_H_
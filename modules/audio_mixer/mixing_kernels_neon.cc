@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_mixer/mixing_kernels_neon.h"
+
+#include <arm_neon.h>
+
+#include "webrtc/base/safe_conversions.h"
+
+namespace webrtc {
+
+void MixingKernelsNEON::Accumulate(const int16_t* src,
+                                   size_t length,
+                                   int shift,
+                                   int32_t* acc) const {
+  // A left shift by a negative amount is an arithmetic right shift.
+  const int16x8_t shift_count = vdupq_n_s16(-shift);
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const int16x8_t samples = vshlq_s16(vld1q_s16(src + i), shift_count);
+    vst1q_s32(acc + i,
+              vaddq_s32(vld1q_s32(acc + i), vmovl_s16(vget_low_s16(samples))));
+    vst1q_s32(acc + i + 4, vaddq_s32(vld1q_s32(acc + i + 4),
+                                     vmovl_s16(vget_high_s16(samples))));
+  }
+  for (; i < length; ++i)
+    acc[i] += src[i] >> shift;
+}
+
+void MixingKernelsNEON::Saturate(const int32_t* acc,
+                                 size_t length,
+                                 int16_t* dst) const {
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(vld1q_s32(acc + i)),
+                                    vqmovn_s32(vld1q_s32(acc + i + 4))));
+  }
+  for (; i < length; ++i)
+    dst[i] = rtc::saturated_cast<int16_t>(acc[i]);
+}
+
+void MixingKernelsNEON::ApplyGains(const float* gains,
+                                   size_t length,
+                                   int16_t* data) const {
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const int16x8_t samples = vld1q_s16(data + i);
+    const float32x4_t low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(samples)));
+    const float32x4_t high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(samples)));
+    // Truncating conversions, like the float to integer conversion in C.
+    const int32x4_t scaled_low =
+        vcvtq_s32_f32(vmulq_f32(low, vld1q_f32(gains + i)));
+    const int32x4_t scaled_high =
+        vcvtq_s32_f32(vmulq_f32(high, vld1q_f32(gains + i + 4)));
+    vst1q_s16(data + i,
+              vcombine_s16(vqmovn_s32(scaled_low), vqmovn_s32(scaled_high)));
+  }
+  for (; i < length; ++i)
+    data[i] *= gains[i];
+}
+
+}  // namespace webrtc
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_mixer/mixing_kernels_sse2.h"
+
+#include <emmintrin.h>
+
+#include "webrtc/base/safe_conversions.h"
+
+namespace webrtc {
+
+void MixingKernelsSSE2::Accumulate(const int16_t* src,
+                                   size_t length,
+                                   int shift,
+                                   int32_t* acc) const {
+  const __m128i shift_count = _mm_cvtsi32_si128(shift);
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    __m128i samples =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    samples = _mm_sra_epi16(samples, shift_count);
+    // Sign extend to 32 bits by placing the samples in the high halves.
+    const __m128i low =
+        _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16);
+    const __m128i high =
+        _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16);
+    __m128i* acc_low = reinterpret_cast<__m128i*>(acc + i);
+    __m128i* acc_high = reinterpret_cast<__m128i*>(acc + i + 4);
+    _mm_storeu_si128(acc_low, _mm_add_epi32(_mm_loadu_si128(acc_low), low));
+    _mm_storeu_si128(acc_high,
+                     _mm_add_epi32(_mm_loadu_si128(acc_high), high));
+  }
+  for (; i < length; ++i)
+    acc[i] += src[i] >> shift;
+}
+
+void MixingKernelsSSE2::Saturate(const int32_t* acc,
+                                 size_t length,
+                                 int16_t* dst) const {
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const __m128i low =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i));
+    const __m128i high =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc + i + 4));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                     _mm_packs_epi32(low, high));
+  }
+  for (; i < length; ++i)
+    dst[i] = rtc::saturated_cast<int16_t>(acc[i]);
+}
+
+void MixingKernelsSSE2::ApplyGains(const float* gains,
+                                   size_t length,
+                                   int16_t* data) const {
+  size_t i = 0;
+  for (; i + 8 <= length; i += 8) {
+    const __m128i samples =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+    const __m128 low = _mm_cvtepi32_ps(
+        _mm_srai_epi32(_mm_unpacklo_epi16(samples, samples), 16));
+    const __m128 high = _mm_cvtepi32_ps(
+        _mm_srai_epi32(_mm_unpackhi_epi16(samples, samples), 16));
+    // Truncating conversions, like the float to integer conversion in C.
+    const __m128i scaled_low =
+        _mm_cvttps_epi32(_mm_mul_ps(low, _mm_loadu_ps(gains + i)));
+    const __m128i scaled_high =
+        _mm_cvttps_epi32(_mm_mul_ps(high, _mm_loadu_ps(gains + i + 4)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data + i),
+                     _mm_packs_epi32(scaled_low, scaled_high));
+  }
+  for (; i < length; ++i)
+    data[i] *= gains[i];
+}
+
+}  // namespace webrtc
@@ -449,6 +449,87 @@ void AudioBuffer::InterleaveTo(AudioFrame* frame, bool data_changed) {
   }
 }
 
+void AudioBuffer::DeinterleaveToFloatFrom(AudioFrame* frame) {
+  RTC_DCHECK_EQ(frame->num_channels_, num_input_channels_);
+  RTC_DCHECK_EQ(frame->samples_per_channel_, input_num_frames_);
+  InitForNewData();
+  if ((input_num_frames_ != proc_num_frames_) && !input_buffer_) {
+    input_buffer_.reset(
+        new IFChannelBuffer(input_num_frames_, num_proc_channels_));
+  }
+  activity_ = frame->vad_activity_;
+
+  float* const* deinterleaved;
+  if (input_num_frames_ == proc_num_frames_) {
+    deinterleaved = data_->fbuf()->channels();
+  } else {
+    deinterleaved = input_buffer_->fbuf()->channels();
+  }
+  const int16_t* interleaved = frame->data_;
+  if (num_proc_channels_ == 1) {
+    // Downmix and deinterleave simultaneously.
+    for (size_t i = 0; i < input_num_frames_; ++i) {
+      int32_t sum = 0;
+      for (size_t j = 0; j < num_input_channels_; ++j) {
+        sum += *interleaved++;
+      }
+      deinterleaved[0][i] = static_cast<float>(sum) / num_input_channels_;
+    }
+  } else {
+    RTC_DCHECK_EQ(num_proc_channels_, num_input_channels_);
+    for (size_t i = 0; i < input_num_frames_; ++i) {
+      for (size_t j = 0; j < num_proc_channels_; ++j) {
+        deinterleaved[j][i] = *interleaved++;
+      }
+    }
+  }
+
+  // Resample.
+  if (input_num_frames_ != proc_num_frames_) {
+    for (size_t i = 0; i < num_proc_channels_; ++i) {
+      input_resamplers_[i]->Resample(input_buffer_->fbuf_const()->channels()[i],
+                                     input_num_frames_,
+                                     data_->fbuf()->channels()[i],
+                                     proc_num_frames_);
+    }
+  }
+}
+
+void AudioBuffer::InterleaveFromFloatTo(AudioFrame* frame,
+                                        bool data_changed) {
+  frame->vad_activity_ = activity_;
+  if (!data_changed) {
+    return;
+  }
+
+  RTC_DCHECK(frame->num_channels_ == num_channels_ || num_channels_ == 1);
+  RTC_DCHECK_EQ(frame->samples_per_channel_, output_num_frames_);
+
+  // Resample if necessary.
+  const float* const* deinterleaved = data_->fbuf_const()->channels();
+  if (proc_num_frames_ != output_num_frames_) {
+    if (!output_buffer_) {
+      output_buffer_.reset(
+          new IFChannelBuffer(output_num_frames_, num_channels_));
+    }
+    for (size_t i = 0; i < num_channels_; ++i) {
+      output_resamplers_[i]->Resample(
+          deinterleaved[i], proc_num_frames_,
+          output_buffer_->fbuf()->channels()[i], output_num_frames_);
+    }
+    deinterleaved = output_buffer_->fbuf_const()->channels();
+  }
+
+  // Interleave, or upmix from mono, while converting to int16.
+  int16_t* interleaved = frame->data_;
+  for (size_t i = 0; i < output_num_frames_; ++i) {
+    for (size_t j = 0; j < frame->num_channels_; ++j) {
+      *interleaved++ =
+          FloatS16ToS16(deinterleaved[num_channels_ == 1 ? 0 : j][i]);
+    }
+  }
+}
+
 void AudioBuffer::CopyLowPassToReference() {
   reference_copied_ = true;
   if (!low_pass_reference_channels_.get() ||
@@ -111,6 +111,11 @@ class AudioBuffer {
   // If |data_changed| is false, only the non-audio data members will be copied
   // to |frame|.
   void InterleaveTo(AudioFrame* frame, bool data_changed);
+  // Same as DeinterleaveFrom() and InterleaveTo(), but the audio is converted
+  // directly to and from the float representation. Used when the capture
+  // processing stays in float, so that no full int16 copy is ever produced.
+  void DeinterleaveToFloatFrom(AudioFrame* audioFrame);
+  void InterleaveFromFloatTo(AudioFrame* frame, bool data_changed);
 
   // Use for float deinterleaved data.
   void CopyFrom(const float* const* data, const StreamConfig& stream_config);
@@ -36,10 +36,12 @@
 #include "webrtc/modules/audio_processing/level_estimator_impl.h"
 #include "webrtc/modules/audio_processing/low_cut_filter.h"
 #include "webrtc/modules/audio_processing/noise_suppression_impl.h"
+#include "webrtc/modules/audio_processing/processing_time_stats.h"
 #include "webrtc/modules/audio_processing/residual_echo_detector.h"
 #include "webrtc/modules/audio_processing/transient/transient_suppressor.h"
 #include "webrtc/modules/audio_processing/voice_detection_impl.h"
 #include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/system_wrappers/include/cpu_info.h"
 #include "webrtc/system_wrappers/include/file_wrapper.h"
 #include "webrtc/system_wrappers/include/logging.h"
 #include "webrtc/system_wrappers/include/metrics.h"
@@ -75,6 +77,9 @@ constexpr int AudioProcessing::kNativeSampleRatesHz[];
 
 namespace {
 
+// Every 10th capture frame is timed per submodule.
+const int kProcessingTimeSamplingInterval = 10;
+
 static bool LayoutHasKeyboard(AudioProcessing::ChannelLayout layout) {
   switch (layout) {
     case AudioProcessing::kMono:
@@ -127,6 +132,8 @@ static const size_t kMaxAllowedValuesOfSamplesPerFrame = 160;
 // TODO(peah): Decrease this once we properly handle hugely unbalanced
 // reverse and forward call numbers.
 static const size_t kMaxNumFramesToBuffer = 100;
+// Maximum number of render frames that can wait for the render worker.
+static const size_t kMaxNumRenderWorkerFrames = 10;
 
 class HighPassFilterImpl : public HighPassFilter {
  public:
@@ -351,9 +358,40 @@ AudioProcessingImpl::AudioProcessingImpl(const webrtc::Config& config,
   }
 
   SetExtraOptions(config);
+
+  // A render worker only helps if it can run in parallel with the audio
+  // device threads.
+  if (config.Get<RenderWorker>().enabled &&
+      CpuInfo::DetectNumberOfCores() > 1) {
+    render_worker_frames_.reset(
+        new SwapQueue<std::unique_ptr<AudioFrame>>(kMaxNumRenderWorkerFrames));
+    AllocateRenderWorkerFrames();
+    render_worker_.reset(new rtc::TaskQueue("ApmRenderWorker"));
+  }
+}
+
+void AudioProcessingImpl::AllocateRenderWorkerFrames() {
+  // The frames are swapped in and out of the queue, so once every slot and
+  // both ends hold one, frames are only ever recycled. Fill the slots by
+  // queueing new frames, and then taking them out in exchange for others.
+  rtc::CritScope cs(&crit_render_);
+  render_worker_input_frame_.reset(new AudioFrame());
+  render_worker_output_frame_.reset(new AudioFrame());
+  for (size_t i = 0; i < kMaxNumRenderWorkerFrames; ++i) {
+    std::unique_ptr<AudioFrame> frame(new AudioFrame());
+    bool inserted = render_worker_frames_->Insert(&frame);
+    RTC_DCHECK(inserted);
+  }
+  for (size_t i = 0; i < kMaxNumRenderWorkerFrames; ++i) {
+    bool removed = render_worker_frames_->Remove(&render_worker_output_frame_);
+    RTC_DCHECK(removed);
+  }
 }
 
 AudioProcessingImpl::~AudioProcessingImpl() {
+  // Stop the render worker before any of the state it accesses is destroyed.
+  render_worker_.reset();
+
   // Depends on gain_control_ and
   // public_submodules_->gain_control_for_experimental_agc.
   private_submodules_->agc_manager.reset();
@@ -646,6 +684,8 @@ void AudioProcessingImpl::ApplyConfig(const AudioProcessing::Config& config) {
 
   LOG(LS_INFO) << "Highpass filter activated: "
                << config_.high_pass_filter.enabled;
+  LOG(LS_INFO) << "Float capture pipeline activated: "
+               << config_.float_capture_pipeline.enabled;
 
   config_ok = EchoCanceller3::Validate(config_.echo_canceller3);
   if (!config_ok) {
@@ -782,6 +822,7 @@ int AudioProcessingImpl::ProcessStream(const float* const* src,
   TRACE_EVENT0("webrtc", "AudioProcessing::ProcessStream_StreamConfig");
   ProcessingConfig processing_config;
   bool reinitialization_required = false;
+  bool format_changed = false;
   {
     // Acquire the capture lock in order to safely call the function
     // that retrieves the render side data. This function accesses apm
@@ -795,13 +836,16 @@ int AudioProcessingImpl::ProcessStream(const float* const* src,
 
     processing_config = formats_.api_format;
     reinitialization_required = UpdateActiveSubmoduleStates();
+    processing_config.input_stream() = input_config;
+    processing_config.output_stream() = output_config;
+    // The formats are only written while holding both locks, so the render
+    // lock is not needed to detect whether the format has changed.
+    format_changed = !(processing_config == formats_.api_format);
   }
 
-  processing_config.input_stream() = input_config;
-  processing_config.output_stream() = output_config;
-
-  {
-    // Do conditional reinitialization.
+  if (reinitialization_required || format_changed) {
+    // Do conditional reinitialization. This is the only place where the
+    // capture side waits for the render side.
     rtc::CritScope cs_render(&crit_render_);
     RETURN_ON_ERR(
         MaybeInitializeCapture(processing_config, reinitialization_required));
@@ -1050,6 +1094,7 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
 
   ProcessingConfig processing_config;
   bool reinitialization_required = false;
+  bool format_changed = false;
   {
     // Aquire lock for the access of api_format.
     // The lock is released immediately due to the conditional
@@ -1060,14 +1105,20 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
     processing_config = formats_.api_format;
 
     reinitialization_required = UpdateActiveSubmoduleStates();
-  }
-  processing_config.input_stream().set_sample_rate_hz(frame->sample_rate_hz_);
-  processing_config.input_stream().set_num_channels(frame->num_channels_);
-  processing_config.output_stream().set_sample_rate_hz(frame->sample_rate_hz_);
-  processing_config.output_stream().set_num_channels(frame->num_channels_);
-
-  {
-    // Do conditional reinitialization.
+    processing_config.input_stream().set_sample_rate_hz(
+        frame->sample_rate_hz_);
+    processing_config.input_stream().set_num_channels(frame->num_channels_);
+    processing_config.output_stream().set_sample_rate_hz(
+        frame->sample_rate_hz_);
+    processing_config.output_stream().set_num_channels(frame->num_channels_);
+    // The formats are only written while holding both locks, so the render
+    // lock is not needed to detect whether the format has changed.
+    format_changed = !(processing_config == formats_.api_format);
+  }
+
+  if (reinitialization_required || format_changed) {
+    // Do conditional reinitialization. This is the only place where the
+    // capture side waits for the render side.
     rtc::CritScope cs_render(&crit_render_);
     RETURN_ON_ERR(
         MaybeInitializeCapture(processing_config, reinitialization_required));
@@ -1090,10 +1141,17 @@ int AudioProcessingImpl::ProcessStream(AudioFrame* frame) {
   }
 #endif
 
-  capture_.capture_audio->DeinterleaveFrom(frame);
-  RETURN_ON_ERR(ProcessCaptureStreamLocked());
-  capture_.capture_audio->InterleaveTo(
-      frame, submodule_states_.CaptureMultiBandProcessingActive());
+  if (config_.float_capture_pipeline.enabled) {
+    capture_.capture_audio->DeinterleaveToFloatFrom(frame);
+    RETURN_ON_ERR(ProcessCaptureStreamLocked());
+    capture_.capture_audio->InterleaveFromFloatTo(
+        frame, submodule_states_.CaptureMultiBandProcessingActive());
+  } else {
+    capture_.capture_audio->DeinterleaveFrom(frame);
+    RETURN_ON_ERR(ProcessCaptureStreamLocked());
+    capture_.capture_audio->InterleaveTo(
+        frame, submodule_states_.CaptureMultiBandProcessingActive());
+  }
 
 #ifdef WEBRTC_AUDIOPROC_DEBUG_DUMP
   if (debug_dump_.debug_file->is_open()) {
@@ -1131,10 +1189,17 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   MaybeUpdateHistograms();
 
   AudioBuffer* capture_buffer = capture_.capture_audio.get();  // For brevity.
+  const bool float_pipeline = config_.float_capture_pipeline.enabled;
 
-  capture_input_rms_.Analyze(rtc::ArrayView<const int16_t>(
-      capture_buffer->channels_const()[0],
-      capture_nonlocked_.capture_processing_format.num_frames()));
+  if (float_pipeline) {
+    capture_input_rms_.Analyze(rtc::ArrayView<const float>(
+        capture_buffer->channels_const_f()[0],
+        capture_nonlocked_.capture_processing_format.num_frames()));
+  } else {
+    capture_input_rms_.Analyze(rtc::ArrayView<const int16_t>(
+        capture_buffer->channels_const()[0],
+        capture_nonlocked_.capture_processing_format.num_frames()));
+  }
   const bool log_rms = ++capture_rms_interval_counter_ >= 1000;
   if (log_rms) {
     capture_rms_interval_counter_ = 0;
@@ -1145,7 +1210,36 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
                                 levels.peak, 1, RmsLevel::kMinLevelDb, 64);
   }
 
+  const bool time_submodules = ++processing_time_interval_counter_ >=
+                               kProcessingTimeSamplingInterval;
+  if (time_submodules) {
+    processing_time_interval_counter_ = 0;
+  }
+  ProcessingTimeStats* const aec3_time =
+      time_submodules && private_submodules_->echo_canceller3
+          ? &processing_times_.echo_canceller3
+          : nullptr;
+  ProcessingTimeStats* const level_controller_time =
+      time_submodules && capture_nonlocked_.level_controller_enabled
+          ? &processing_times_.level_controller
+          : nullptr;
+  ProcessingTimeStats* const ns_time =
+      time_submodules && public_submodules_->noise_suppression->is_enabled()
+          ? &processing_times_.noise_suppression
+          : nullptr;
+  ProcessingTimeStats* const agc_time =
+      time_submodules && public_submodules_->gain_control->is_enabled()
+          ? &processing_times_.gain_control
+          : nullptr;
+  // The timed frames end on every return path, including the errors
+  // returned from within a timed submodule.
+  ScopedProcessingFrame aec3_frame(aec3_time);
+  ScopedProcessingFrame level_controller_frame(level_controller_time);
+  ScopedProcessingFrame ns_frame(ns_time);
+  ScopedProcessingFrame agc_frame(agc_time);
+
   if (private_submodules_->echo_canceller3) {
+    ScopedProcessingTimer timer(aec3_time);
     private_submodules_->echo_canceller3->AnalyzeCapture(capture_buffer);
   }
 
@@ -1172,11 +1266,21 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   // TODO(peah): Move the AEC3 low-cut filter to this place.
   if (private_submodules_->low_cut_filter &&
       !private_submodules_->echo_canceller3) {
-    private_submodules_->low_cut_filter->Process(capture_buffer);
+    if (float_pipeline) {
+      private_submodules_->low_cut_filter->ProcessFloat(capture_buffer);
+    } else {
+      private_submodules_->low_cut_filter->Process(capture_buffer);
+    }
+  }
+  {
+    ScopedProcessingTimer timer(agc_time);
+    RETURN_ON_ERR(
+        public_submodules_->gain_control->AnalyzeCaptureAudio(capture_buffer));
+  }
+  {
+    ScopedProcessingTimer timer(ns_time);
+    public_submodules_->noise_suppression->AnalyzeCaptureAudio(capture_buffer);
   }
-  RETURN_ON_ERR(
-      public_submodules_->gain_control->AnalyzeCaptureAudio(capture_buffer));
-  public_submodules_->noise_suppression->AnalyzeCaptureAudio(capture_buffer);
 
   // Ensure that the stream delay was set before the call to the
   // AEC ProcessCaptureAudio function.
@@ -1186,6 +1290,7 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   }
 
   if (private_submodules_->echo_canceller3) {
+    ScopedProcessingTimer timer(aec3_time);
     private_submodules_->echo_canceller3->ProcessCapture(capture_buffer, false);
   }
 
@@ -1196,7 +1301,10 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
       public_submodules_->noise_suppression->is_enabled()) {
     capture_buffer->CopyLowPassToReference();
   }
-  public_submodules_->noise_suppression->ProcessCaptureAudio(capture_buffer);
+  {
+    ScopedProcessingTimer timer(ns_time);
+    public_submodules_->noise_suppression->ProcessCaptureAudio(capture_buffer);
+  }
 #if WEBRTC_INTELLIGIBILITY_ENHANCER
   if (capture_nonlocked_.intelligibility_enabled) {
     RTC_DCHECK(public_submodules_->noise_suppression->is_enabled());
@@ -1243,8 +1351,11 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
         capture_buffer->split_bands_const(0)[kBand0To8kHz],
         capture_buffer->num_frames_per_band(), capture_nonlocked_.split_rate);
   }
-  RETURN_ON_ERR(public_submodules_->gain_control->ProcessCaptureAudio(
-      capture_buffer, echo_cancellation()->stream_has_echo()));
+  {
+    ScopedProcessingTimer timer(agc_time);
+    RETURN_ON_ERR(public_submodules_->gain_control->ProcessCaptureAudio(
+        capture_buffer, echo_cancellation()->stream_has_echo()));
+  }
 
   if (submodule_states_.CaptureMultiBandProcessingActive() &&
       SampleRateSupportsMultiBand(
@@ -1270,15 +1381,22 @@ int AudioProcessingImpl::ProcessCaptureStreamLocked() {
   }
 
   if (capture_nonlocked_.level_controller_enabled) {
+    ScopedProcessingTimer timer(level_controller_time);
     private_submodules_->level_controller->Process(capture_buffer);
   }
 
   // The level estimator operates on the recombined data.
   public_submodules_->level_estimator->ProcessStream(capture_buffer);
 
-  capture_output_rms_.Analyze(rtc::ArrayView<const int16_t>(
-      capture_buffer->channels_const()[0],
-      capture_nonlocked_.capture_processing_format.num_frames()));
+  if (float_pipeline) {
+    capture_output_rms_.Analyze(rtc::ArrayView<const float>(
+        capture_buffer->channels_const_f()[0],
+        capture_nonlocked_.capture_processing_format.num_frames()));
+  } else {
+    capture_output_rms_.Analyze(rtc::ArrayView<const int16_t>(
+        capture_buffer->channels_const()[0],
+        capture_nonlocked_.capture_processing_format.num_frames()));
+  }
   if (log_rms) {
     RmsLevel::Levels levels = capture_output_rms_.AverageAndPeak();
     RTC_HISTOGRAM_COUNTS_LINEAR("WebRTC.Audio.ApmCaptureOutputLevelAverageRms",
@@ -1371,7 +1489,51 @@ int AudioProcessingImpl::AnalyzeReverseStreamLocked(
 
 int AudioProcessingImpl::ProcessReverseStream(AudioFrame* frame) {
   TRACE_EVENT0("webrtc", "AudioProcessing::ProcessReverseStream_AudioFrame");
+  // Hand the frame over to the render worker if APM will not modify it and it
+  // passes the checks that do not depend on the APM state. Anything else is
+  // processed synchronously so that errors and output are reported as usual.
+  if (render_worker_ && frame != nullptr &&
+      !capture_nonlocked_.intelligibility_enabled &&
+      (frame->sample_rate_hz_ == kSampleRate8kHz ||
+       frame->sample_rate_hz_ == kSampleRate16kHz ||
+       frame->sample_rate_hz_ == kSampleRate32kHz ||
+       frame->sample_rate_hz_ == kSampleRate48kHz) &&
+      frame->num_channels_ > 0 &&
+      frame->samples_per_channel_ ==
+          static_cast<size_t>(frame->sample_rate_hz_ * kChunkSizeMs / 1000)) {
+    render_worker_input_frame_->CopyFrom(*frame);
+    if (render_worker_frames_->Insert(&render_worker_input_frame_)) {
+      render_worker_->PostTask([this] { ProcessQueuedRenderFrames(); });
+      return kNoError;
+    }
+    // The worker is lagging behind. Process the frame on this thread after
+    // the queued ones.
+  }
+
   rtc::CritScope cs(&crit_render_);
+  if (render_worker_) {
+    ProcessQueuedRenderFramesLocked();
+  }
+  return ProcessReverseStreamLocked(frame);
+}
+
+void AudioProcessingImpl::ProcessQueuedRenderFrames() {
+  RTC_DCHECK(render_worker_->IsCurrent());
+  rtc::CritScope cs(&crit_render_);
+  ProcessQueuedRenderFramesLocked();
+}
+
+void AudioProcessingImpl::ProcessQueuedRenderFramesLocked() {
+  while (render_worker_frames_->Remove(&render_worker_output_frame_)) {
+    const int err =
+        ProcessReverseStreamLocked(render_worker_output_frame_.get());
+    if (err != kNoError) {
+      LOG(LS_ERROR) << "Render worker failed to process a frame: " << err;
+    }
+  }
+}
+
+int AudioProcessingImpl::ProcessReverseStreamLocked(AudioFrame* frame) {
   if (frame == nullptr) {
     return kNullPointerError;
   }
@@ -1624,6 +1786,12 @@ AudioProcessing::AudioProcessingStatistics AudioProcessingImpl::GetStatistics()
   public_submodules_->echo_cancellation->GetDelayMetrics(
       &stats.delay_median, &stats.delay_standard_deviation,
       &stats.fraction_poor_delays);
+  stats.echo_canceller3_time_us = processing_times_.echo_canceller3.GetStats();
+  stats.level_controller_time_us =
+      processing_times_.level_controller.GetStats();
+  stats.noise_suppression_time_us =
+      processing_times_.noise_suppression.GetStats();
+  stats.gain_control_time_us = processing_times_.gain_control.GetStats();
   return stats;
 }
 
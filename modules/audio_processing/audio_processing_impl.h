@@ -21,9 +21,11 @@
 #include "webrtc/base/gtest_prod_util.h"
 #include "webrtc/base/ignore_wundef.h"
 #include "webrtc/base/swap_queue.h"
+#include "webrtc/base/task_queue.h"
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/modules/audio_processing/audio_buffer.h"
 #include "webrtc/modules/audio_processing/include/audio_processing.h"
+#include "webrtc/modules/audio_processing/processing_time_stats.h"
 #include "webrtc/modules/audio_processing/render_queue_item_verifier.h"
 #include "webrtc/modules/audio_processing/rms_level.h"
 #include "webrtc/system_wrappers/include/file_wrapper.h"
@@ -274,6 +276,14 @@ class AudioProcessingImpl : public AudioProcessing {
                                  const StreamConfig& output_config)
       EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
   int ProcessRenderStreamLocked() EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
+  int ProcessReverseStreamLocked(AudioFrame* frame)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
+
+  // Render worker methods. ProcessQueuedRenderFrames() runs on the render
+  // worker and processes the frames queued by ProcessReverseStream().
+  void AllocateRenderWorkerFrames();
+  void ProcessQueuedRenderFrames();
+  void ProcessQueuedRenderFramesLocked() EXCLUSIVE_LOCKS_REQUIRED(crit_render_);
 
 // Debug dump methods that are internal and called without locks.
 // TODO(peah): Make thread safe.
@@ -419,6 +429,17 @@ class AudioProcessingImpl : public AudioProcessing {
   RmsLevel capture_output_rms_ GUARDED_BY(crit_capture_);
   int capture_rms_interval_counter_ GUARDED_BY(crit_capture_) = 0;
 
+  // Capture side processing time of the most expensive submodules. Only
+  // every kProcessingTimeSamplingInterval-th frame is timed to keep the
+  // overhead low. The stats are internally synchronized.
+  struct SubmoduleProcessingTimes {
+    ProcessingTimeStats echo_canceller3;
+    ProcessingTimeStats level_controller;
+    ProcessingTimeStats noise_suppression;
+    ProcessingTimeStats gain_control;
+  } processing_times_;
+  int processing_time_interval_counter_ GUARDED_BY(crit_capture_) = 0;
+
   // Lock protection not needed.
   std::unique_ptr<SwapQueue<std::vector<float>, RenderQueueItemVerifier<float>>>
       aec_render_signal_queue_;
@@ -430,6 +451,18 @@ class AudioProcessingImpl : public AudioProcessing {
       agc_render_signal_queue_;
   std::unique_ptr<SwapQueue<std::vector<float>, RenderQueueItemVerifier<float>>>
       red_render_signal_queue_;
+
+  // Render frames handed over from the render API thread to |render_worker_|.
+  // Only allocated when the render worker is used, and then filled with
+  // frames up front, like the two below, by AllocateRenderWorkerFrames().
+  std::unique_ptr<SwapQueue<std::unique_ptr<AudioFrame>>> render_worker_frames_;
+  // Only accessed from the render API thread.
+  std::unique_ptr<AudioFrame> render_worker_input_frame_;
+  std::unique_ptr<AudioFrame> render_worker_output_frame_
+      GUARDED_BY(crit_render_);
+
+  // Declared last so that it is destroyed before the state its tasks access.
+  std::unique_ptr<rtc::TaskQueue> render_worker_;
 };
 
 }  // namespace webrtc
@@ -10,6 +10,8 @@
 
 #include "webrtc/modules/audio_processing/audio_processing_impl.h"
 
+#include <memory>
+
 #include "webrtc/config.h"
 #include "webrtc/modules/audio_processing/test/test_utils.h"
 #include "webrtc/modules/include/module_common_types.h"
@@ -72,4 +74,29 @@ TEST(AudioProcessingImplTest, AudioParameterChangeTriggersInit) {
   EXPECT_NOERR(mock.ProcessReverseStream(&frame));
 }
 
+TEST(AudioProcessingImplTest, RenderWorkerProcessesReverseStream) {
+  webrtc::Config config;
+  config.Set<RenderWorker>(new RenderWorker(true));
+  std::unique_ptr<AudioProcessing> apm(AudioProcessing::Create(config));
+  EXPECT_NOERR(apm->echo_cancellation()->Enable(true));
+
+  AudioFrame frame;
+  frame.num_channels_ = 1;
+  SetFrameSampleRate(&frame, 16000);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_NOERR(apm->ProcessReverseStream(&frame));
+    EXPECT_NOERR(apm->set_stream_delay_ms(0));
+    EXPECT_NOERR(apm->ProcessStream(&frame));
+  }
+
+  // Frames that fail validation are still rejected synchronously.
+  frame.sample_rate_hz_ = 12345;
+  EXPECT_EQ(AudioProcessing::kBadSampleRateError,
+            apm->ProcessReverseStream(&frame));
+  SetFrameSampleRate(&frame, 16000);
+  frame.samples_per_channel_ = 80;
+  EXPECT_EQ(AudioProcessing::kBadDataLengthError,
+            apm->ProcessReverseStream(&frame));
+}
+
 }  // namespace webrtc
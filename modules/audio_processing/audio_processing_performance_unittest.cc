@@ -13,6 +13,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "webrtc/base/array_view.h"
@@ -712,6 +713,74 @@ bool TimedThreadApiProcessor::Process() {
 
 const float CallSimulator::kRenderInputFloatLevel = 0.5f;
 const float CallSimulator::kCaptureInputFloatLevel = 0.03125f;
+
+// Returns the average duration in microseconds of a capture-side AudioFrame
+// ProcessStream call, with only submodules that operate on float data active.
+// This isolates the cost of the int16 <-> float conversions that the
+// float_capture_pipeline setting removes.
+size_t MeasureAudioFrameCaptureDurationUs(int sample_rate_hz,
+                                          bool float_pipeline) {
+  static const int kNumFramesToProcess = 1000;
+  std::unique_ptr<AudioProcessing> apm(AudioProcessing::Create());
+  AudioProcessing::Config apm_config;
+  apm_config.high_pass_filter.enabled = true;
+  apm_config.float_capture_pipeline.enabled = float_pipeline;
+  apm->ApplyConfig(apm_config);
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->noise_suppression()->Enable(true));
+
+  Random rand_gen(42);
+  AudioFrame frame;
+  frame.sample_rate_hz_ = sample_rate_hz;
+  frame.samples_per_channel_ =
+      static_cast<size_t>(AudioProcessing::kChunkSizeMs * sample_rate_hz /
+                          1000);
+  frame.num_channels_ = 1;
+
+  Clock* clock = Clock::GetRealTimeClock();
+  int64_t total_duration_us = 0;
+  for (int i = 0; i < kNumFramesToProcess; ++i) {
+    for (size_t k = 0; k < frame.samples_per_channel_; ++k) {
+      frame.data_[k] = static_cast<int16_t>(rand_gen.Rand(-1024, 1024));
+    }
+    const int64_t start_time_us = clock->TimeInMicroseconds();
+    EXPECT_EQ(AudioProcessing::kNoError, apm->ProcessStream(&frame));
+    total_duration_us += clock->TimeInMicroseconds() - start_time_us;
+  }
+  return rtc::checked_cast<size_t>(total_duration_us / kNumFramesToProcess);
+}
+
+// Runs a capture-only call with AEC3, the level controller, NS and AGC active
+// and returns the per-submodule processing times reported by APM.
+AudioProcessing::AudioProcessingStatistics MeasureSubmoduleProcessingTimes(
+    int sample_rate_hz) {
+  static const int kNumFramesToProcess = 1000;
+  std::unique_ptr<AudioProcessing> apm(AudioProcessing::Create());
+  AudioProcessing::Config apm_config;
+  apm_config.echo_canceller3.enabled = true;
+  apm_config.level_controller.enabled = true;
+  apm->ApplyConfig(apm_config);
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->noise_suppression()->Enable(true));
+  EXPECT_EQ(AudioProcessing::kNoError,
+            apm->gain_control()->set_mode(GainControl::kAdaptiveDigital));
+  EXPECT_EQ(AudioProcessing::kNoError, apm->gain_control()->Enable(true));
+
+  Random rand_gen(42);
+  AudioFrame frame;
+  frame.sample_rate_hz_ = sample_rate_hz;
+  frame.samples_per_channel_ =
+      static_cast<size_t>(AudioProcessing::kChunkSizeMs * sample_rate_hz /
+                          1000);
+  frame.num_channels_ = 1;
+  for (int i = 0; i < kNumFramesToProcess; ++i) {
+    for (size_t k = 0; k < frame.samples_per_channel_; ++k) {
+      frame.data_[k] = static_cast<int16_t>(rand_gen.Rand(-1024, 1024));
+    }
+    EXPECT_EQ(AudioProcessing::kNoError, apm->ProcessStream(&frame));
+  }
+  return apm->GetStatistics();
+}
 }  // anonymous namespace
 
 TEST_P(CallSimulator, ApiCallDurationTest) {
@@ -724,4 +793,42 @@ INSTANTIATE_TEST_CASE_P(
     CallSimulator,
     ::testing::ValuesIn(SimulationConfig::GenerateSimulationConfigs()));
 
+TEST(AudioProcessingPerformanceTest, CaptureConversionOverhead) {
+  for (int sample_rate_hz : {16000, 32000, 48000}) {
+    const std::string sample_rate_name =
+        "_" + std::to_string(sample_rate_hz) + "Hz";
+    webrtc::test::PrintResult(
+        "apm_capture_conversion", sample_rate_name, "int16_pipeline",
+        MeasureAudioFrameCaptureDurationUs(sample_rate_hz, false), "us",
+        false);
+    webrtc::test::PrintResult(
+        "apm_capture_conversion", sample_rate_name, "float_pipeline",
+        MeasureAudioFrameCaptureDurationUs(sample_rate_hz, true), "us",
+        false);
+  }
+}
+
+TEST(AudioProcessingPerformanceTest, SubmoduleProcessingTimes) {
+  for (int sample_rate_hz : {16000, 32000, 48000}) {
+    const std::string sample_rate_name =
+        "_" + std::to_string(sample_rate_hz) + "Hz";
+    const AudioProcessing::AudioProcessingStatistics stats =
+        MeasureSubmoduleProcessingTimes(sample_rate_hz);
+    const std::pair<const char*, AudioProcessing::Stat> submodules[] = {
+        {"echo_canceller3", stats.echo_canceller3_time_us},
+        {"level_controller", stats.level_controller_time_us},
+        {"noise_suppression", stats.noise_suppression_time_us},
+        {"gain_control", stats.gain_control_time_us}};
+    for (const auto& submodule : submodules) {
+      EXPECT_LT(0.f, submodule.second.maximum()) << submodule.first;
+      webrtc::test::PrintResult(
+          "apm_submodule_timing_average", sample_rate_name, submodule.first,
+          std::to_string(submodule.second.average()), "us", false);
+      webrtc::test::PrintResult(
+          "apm_submodule_timing_max", sample_rate_name, submodule.first,
+          std::to_string(submodule.second.maximum()), "us", false);
+    }
+  }
+}
+
 }  // namespace webrtc
@@ -145,6 +145,19 @@ struct Beamforming {
   const SphericalPointf target_direction;
 };
 
+// Use to run the render-side analysis of ProcessReverseStream(AudioFrame*) on
+// a dedicated worker thread. The render API call then only queues the frame,
+// and neither it nor the capture side waits for the render processing. Only
+// frames that APM does not modify are offloaded. Has no effect on single-core
+// machines. Must be provided through the constructor. It will have no impact
+// if used with AudioProcessing::SetExtraOptions().
+struct RenderWorker {
+  RenderWorker() : enabled(false) {}
+  explicit RenderWorker(bool enabled) : enabled(enabled) {}
+  static const ConfigOptionID identifier = ConfigOptionID::kRenderWorker;
+  bool enabled;
+};
+
 // Use to enable intelligibility enhancer in audio processing.
 //
 // Note: If enabled and the reverse stream has more than one output channel,
@@ -267,6 +280,14 @@ class AudioProcessing {
     struct EchoCanceller3 {
       bool enabled = false;
     } echo_canceller3;
+
+    // Keeps the capture audio in the float representation from the moment it
+    // enters APM until it leaves it, also for int16 AudioFrames. Submodules
+    // that only have a fixed-point implementation (AECM, fixed NS, AGC, VAD)
+    // and the 32 kHz band split still convert internally when they are used.
+    struct FloatCapturePipeline {
+      bool enabled = false;
+    } float_capture_pipeline;
   };
 
   // TODO(mgraczyk): Remove once all methods that use ChannelLayout are gone.
@@ -542,6 +563,14 @@ class AudioProcessing {
     float residual_echo_likelihood = -1.0f;
     // Maximum residual echo likelihood from the last time period.
     float residual_echo_likelihood_recent_max = -1.0f;
+
+    // Capture side processing time per 10 ms frame of the costliest
+    // submodules, in microseconds. Measured on every 10th frame while the
+    // submodule is enabled; all zero if it has never been measured.
+    Stat echo_canceller3_time_us;
+    Stat level_controller_time_us;
+    Stat noise_suppression_time_us;
+    Stat gain_control_time_us;
   };
 
   // TODO(ivoc): Make this pure virtual when all subclasses have been updated.
@@ -10,6 +10,8 @@
 
 #include "webrtc/modules/audio_processing/low_cut_filter.h"
 
+#include <algorithm>
+
 #include "webrtc/common_audio/signal_processing/include/signal_processing_library.h"
 #include "webrtc/modules/audio_processing/audio_buffer.h"
 #include "webrtc/system_wrappers/include/critical_section_wrapper.h"
@@ -28,6 +30,12 @@ class LowCutFilter::BiquadFilter {
                 : kFilterCoefficients) {
     std::memset(x_, 0, sizeof(x_));
     std::memset(y_, 0, sizeof(y_));
+    for (size_t i = 0; i < 5; ++i) {
+      // The fixed-point coefficients are in Q12.
+      ba_float_[i] = ba_[i] / 4096.f;
+    }
+    std::memset(x_float_, 0, sizeof(x_float_));
+    std::memset(y_float_, 0, sizeof(y_float_));
   }
 
   void Process(int16_t* data, size_t length) {
@@ -74,10 +82,33 @@ class LowCutFilter::BiquadFilter {
     }
   }
 
+  // Float counterpart of the filter above, operating on samples in the int16
+  // range.
+  void Process(float* data, size_t length) {
+    const float* const ba = ba_float_;
+    float* x = x_float_;
+    float* y = y_float_;
+
+    for (size_t i = 0; i < length; i++) {
+      const float filtered = ba[0] * data[i] + ba[1] * x[0] + ba[2] * x[1] +
+                             ba[3] * y[0] + ba[4] * y[1];
+      x[1] = x[0];
+      x[0] = data[i];
+      y[1] = y[0];
+      y[0] = filtered;
+
+      // Saturate so that the HP filtered signal does not overflow.
+      data[i] = std::min(32767.f, std::max(-32768.f, filtered));
+    }
+  }
+
  private:
   const int16_t* const ba_ = nullptr;
   int16_t x_[2];
   int16_t y_[4];
+  float ba_float_[5];
+  float x_float_[2];
+  float y_float_[2];
 };
 
 LowCutFilter::LowCutFilter(size_t channels, int sample_rate_hz) {
@@ -99,4 +130,14 @@ void LowCutFilter::Process(AudioBuffer* audio) {
   }
 }
 
+void LowCutFilter::ProcessFloat(AudioBuffer* audio) {
+  RTC_DCHECK(audio);
+  RTC_DCHECK_GE(160, audio->num_frames_per_band());
+  RTC_DCHECK_EQ(filters_.size(), audio->num_channels());
+  for (size_t i = 0; i < filters_.size(); i++) {
+    filters_[i]->Process(audio->split_bands_f(i)[kBand0To8kHz],
+                         audio->num_frames_per_band());
+  }
+}
+
 }  // namespace webrtc
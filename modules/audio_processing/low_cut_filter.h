@@ -25,6 +25,10 @@ class LowCutFilter {
   LowCutFilter(size_t channels, int sample_rate_hz);
   ~LowCutFilter();
   void Process(AudioBuffer* audio);
+  // Filters the float representation of the lowest band instead of the int16
+  // one, so that a float-only capture pipeline does not have to convert the
+  // split bands to int16 for this filter.
+  void ProcessFloat(AudioBuffer* audio);
 
  private:
   class BiquadFilter;
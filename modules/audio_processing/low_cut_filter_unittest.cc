@@ -7,6 +7,8 @@
  *  in the file PATENTS.  All contributing project authors may
  *  be found in the AUTHORS file in the root of the source tree.
  */
+#include <math.h>
+
 #include <vector>
 
 #include "webrtc/base/array_view.h"
@@ -22,14 +24,19 @@ namespace {
 // Process one frame of data and produce the output.
 std::vector<float> ProcessOneFrame(const std::vector<float>& frame_input,
                                    const StreamConfig& stream_config,
-                                   LowCutFilter* low_cut_filter) {
+                                   LowCutFilter* low_cut_filter,
+                                   bool use_float) {
   AudioBuffer audio_buffer(
       stream_config.num_frames(), stream_config.num_channels(),
       stream_config.num_frames(), stream_config.num_channels(),
       stream_config.num_frames());
 
   test::CopyVectorToAudioBuffer(stream_config, frame_input, &audio_buffer);
-  low_cut_filter->Process(&audio_buffer);
+  if (use_float) {
+    low_cut_filter->ProcessFloat(&audio_buffer);
+  } else {
+    low_cut_filter->Process(&audio_buffer);
+  }
   std::vector<float> frame_output;
   test::ExtractVectorFromAudioBuffer(stream_config, &audio_buffer,
                                      &frame_output);
@@ -58,7 +65,8 @@ void RunBitexactnessTest(int sample_rate,
             stream_config.num_frames() * stream_config.num_channels() *
                 (frame_no + 1));
 
-    output = ProcessOneFrame(frame_input, stream_config, &low_cut_filter);
+    output =
+        ProcessOneFrame(frame_input, stream_config, &low_cut_filter, false);
   }
 
   // Form vector to compare the reference to. Only the last frame processed
@@ -679,4 +687,32 @@ TEST(LowCutFilterBitExactnessTest, Stereo16kHzConverged) {
       16000, 2, CreateVector(rtc::ArrayView<const float>(kReferenceInput)),
       CreateVector(rtc::ArrayView<const float>(kReference)));
 }
+
+TEST(LowCutFilterTest, FloatProcessingMatchesFixedPoint) {
+  for (int sample_rate : {8000, 16000}) {
+    const StreamConfig stream_config(sample_rate, 2, false);
+    LowCutFilter fixed_point_filter(2, sample_rate);
+    LowCutFilter float_filter(2, sample_rate);
+    const size_t frame_length =
+        stream_config.num_frames() * stream_config.num_channels();
+    std::vector<float> frame_input(frame_length);
+    for (size_t frame_no = 0; frame_no < 100; ++frame_no) {
+      for (size_t k = 0; k < frame_length; ++k) {
+        frame_input[k] = 0.5f * sin(0.01f * (frame_no * frame_length + k)) +
+                         0.1f;
+      }
+      const std::vector<float> fixed_point_output = ProcessOneFrame(
+          frame_input, stream_config, &fixed_point_filter, false);
+      const std::vector<float> float_output =
+          ProcessOneFrame(frame_input, stream_config, &float_filter, true);
+
+      // The fixed-point filter rounds its output and state to int16, so allow
+      // for a difference of a couple of int16 steps.
+      const float kElementErrorBound = 2.0f / 32768.0f;
+      EXPECT_TRUE(test::VerifyDeinterleavedArray(
+          stream_config.num_frames(), stream_config.num_channels(),
+          fixed_point_output, float_output, kElementErrorBound));
+    }
+  }
+}
 }  // namespace webrtc
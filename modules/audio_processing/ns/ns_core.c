@@ -18,6 +18,19 @@
 #include "webrtc/modules/audio_processing/ns/noise_suppression.h"
 #include "webrtc/modules/audio_processing/ns/ns_core.h"
 #include "webrtc/modules/audio_processing/ns/windows_private.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+
+MagnitudeSpectrum WebRtcNs_MagnitudeSpectrum;
+ComputeDdBasedWienerFilter WebRtcNs_ComputeDdBasedWienerFilter;
+
+static void MagnitudeSpectrumC(const float* time_data,
+                               size_t magnitude_length,
+                               float* real,
+                               float* imag,
+                               float* magn);
+static void ComputeDdBasedWienerFilterC(const NoiseSuppressionC* self,
+                                        const float* magn,
+                                        float* theFilter);
 
 // Set Feature Extraction Parameters.
 static void set_feature_extraction_parameters(NoiseSuppressionC* self) {
@@ -97,6 +110,15 @@ int WebRtcNs_InitCore(NoiseSuppressionC* self, uint32_t fs) {
   }
   self->magnLen = self->anaLen / 2 + 1;  // Number of frequency bins.
 
+  // Initialize function pointers.
+  WebRtcNs_MagnitudeSpectrum = MagnitudeSpectrumC;
+  WebRtcNs_ComputeDdBasedWienerFilter = ComputeDdBasedWienerFilterC;
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kSSE2)) {
+    WebRtcNs_InitSse2();
+  }
+#endif
+
   // Initialize FFT work arrays.
   self->ip[0] = 0;  // Setting this triggers initialization.
   memset(self->dataBuf, 0, sizeof(float) * ANAL_BLOCKL_MAX);
@@ -903,6 +925,16 @@ static void FFT(NoiseSuppressionC* self,
   imag[magnitude_length - 1] = 0;
   real[magnitude_length - 1] = time_data[1];
   magn[magnitude_length - 1] = fabsf(real[magnitude_length - 1]) + 1.f;
+  WebRtcNs_MagnitudeSpectrum(time_data, magnitude_length, real, imag, magn);
+}
+
+static void MagnitudeSpectrumC(const float* time_data,
+                               size_t magnitude_length,
+                               float* real,
+                               float* imag,
+                               float* magn) {
+  size_t i;
+
   for (i = 1; i < magnitude_length - 1; ++i) {
     real[i] = time_data[2 * i];
     imag[i] = time_data[2 * i + 1];
@@ -983,9 +1015,9 @@ static void Windowing(const float* window,
 //   * |magn| is the signal magnitude spectrum estimate.
 // Output:
 //   * |theFilter| is the frequency response of the computed Wiener filter.
-static void ComputeDdBasedWienerFilter(const NoiseSuppressionC* self,
-                                       const float* magn,
-                                       float* theFilter) {
+static void ComputeDdBasedWienerFilterC(const NoiseSuppressionC* self,
+                                        const float* magn,
+                                        float* theFilter) {
   size_t i;
   float snrPrior, previousEstimateStsa, currentEstimateStsa;
 
@@ -1272,7 +1304,7 @@ void WebRtcNs_ProcessCore(NoiseSuppressionC* self,
     }
   }
 
-  ComputeDdBasedWienerFilter(self, magn, theFilter);
+  WebRtcNs_ComputeDdBasedWienerFilter(self, magn, theFilter);
 
   for (i = 0; i < self->magnLen; i++) {
     // Flooring bottom.
@@ -12,6 +12,7 @@
 #define WEBRTC_MODULES_AUDIO_PROCESSING_NS_NS_CORE_H_
 
 #include "webrtc/modules/audio_processing/ns/defines.h"
+#include "webrtc/typedefs.h"
 
 typedef struct NSParaExtract_ {
   // Bin size of histogram.
@@ -184,6 +185,33 @@ void WebRtcNs_ProcessCore(NoiseSuppressionC* self,
                           size_t num_bands,
                           float* const* outFrame);
 
+/****************************************************************************
+ * Function pointers for the per-bin kernels shared by the SSE2 and generic C
+ * code. They are set by WebRtcNs_InitCore().
+ */
+// Splits the packed |time_data| output of the real FFT into |real| and |imag|
+// and computes the magnitude spectrum |magn| for bins 1 to
+// |magnitude_length| - 2. The first and last bins are handled by the caller.
+typedef void (*MagnitudeSpectrum)(const float* time_data,
+                                  size_t magnitude_length,
+                                  float* real,
+                                  float* imag,
+                                  float* magn);
+extern MagnitudeSpectrum WebRtcNs_MagnitudeSpectrum;
+
+// Estimates the prior SNR decision-directed and computes the DD based Wiener
+// filter |theFilter| from the signal magnitude spectrum |magn|.
+typedef void (*ComputeDdBasedWienerFilter)(const NoiseSuppressionC* self,
+                                           const float* magn,
+                                           float* theFilter);
+extern ComputeDdBasedWienerFilter WebRtcNs_ComputeDdBasedWienerFilter;
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+// Sets the function pointers above to their SSE2 versions, which are bit
+// exact with the generic C code.
+void WebRtcNs_InitSse2(void);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
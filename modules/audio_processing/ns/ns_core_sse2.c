@@ -0,0 +1,97 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+/*
+ * SSE2 versions of the per-bin noise suppression kernels. Every operation
+ * is done in the same order as in the generic C code, so the output is bit
+ * exact.
+ */
+
+#include <emmintrin.h>
+#include <math.h>
+
+#include "webrtc/modules/audio_processing/ns/defines.h"
+#include "webrtc/modules/audio_processing/ns/ns_core.h"
+
+static void MagnitudeSpectrumSSE2(const float* time_data,
+                                  size_t magnitude_length,
+                                  float* real,
+                                  float* imag,
+                                  float* magn) {
+  const __m128 one = _mm_set1_ps(1.f);
+  size_t i = 1;
+
+  for (; i + 4 < magnitude_length; i += 4) {
+    // Deinterleave four (real, imag) pairs.
+    const __m128 a = _mm_loadu_ps(&time_data[2 * i]);
+    const __m128 b = _mm_loadu_ps(&time_data[2 * i + 4]);
+    const __m128 re = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    const __m128 im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    const __m128 energy = _mm_add_ps(_mm_mul_ps(re, re), _mm_mul_ps(im, im));
+    _mm_storeu_ps(&real[i], re);
+    _mm_storeu_ps(&imag[i], im);
+    _mm_storeu_ps(&magn[i], _mm_add_ps(_mm_sqrt_ps(energy), one));
+  }
+  for (; i < magnitude_length - 1; ++i) {
+    real[i] = time_data[2 * i];
+    imag[i] = time_data[2 * i + 1];
+    magn[i] = sqrtf(real[i] * real[i] + imag[i] * imag[i]) + 1.f;
+  }
+}
+
+static void ComputeDdBasedWienerFilterSSE2(const NoiseSuppressionC* self,
+                                           const float* magn,
+                                           float* theFilter) {
+  const __m128 one = _mm_set1_ps(1.f);
+  const __m128 regularization = _mm_set1_ps(0.0001f);
+  const __m128 dd_pr_snr = _mm_set1_ps(DD_PR_SNR);
+  const __m128 one_minus_dd_pr_snr = _mm_set1_ps(1.f - DD_PR_SNR);
+  const __m128 overdrive = _mm_set1_ps(self->overdrive);
+  size_t i = 0;
+
+  for (; i + 3 < self->magnLen; i += 4) {
+    const __m128 magn_prev_process = _mm_loadu_ps(&self->magnPrevProcess[i]);
+    const __m128 noise_prev = _mm_loadu_ps(&self->noisePrev[i]);
+    const __m128 smooth = _mm_loadu_ps(&self->smooth[i]);
+    const __m128 magn_i = _mm_loadu_ps(&magn[i]);
+    const __m128 noise = _mm_loadu_ps(&self->noise[i]);
+    const __m128 previous_estimate_stsa = _mm_mul_ps(
+        _mm_div_ps(magn_prev_process, _mm_add_ps(noise_prev, regularization)),
+        smooth);
+    // The current estimate is zero where |magn| does not exceed |noise|.
+    const __m128 current_estimate_stsa = _mm_and_ps(
+        _mm_cmpgt_ps(magn_i, noise),
+        _mm_sub_ps(_mm_div_ps(magn_i, _mm_add_ps(noise, regularization)),
+                   one));
+    const __m128 snr_prior =
+        _mm_add_ps(_mm_mul_ps(dd_pr_snr, previous_estimate_stsa),
+                   _mm_mul_ps(one_minus_dd_pr_snr, current_estimate_stsa));
+    _mm_storeu_ps(&theFilter[i],
+                  _mm_div_ps(snr_prior, _mm_add_ps(overdrive, snr_prior)));
+  }
+  for (; i < self->magnLen; i++) {
+    const float previousEstimateStsa = self->magnPrevProcess[i] /
+                                       (self->noisePrev[i] + 0.0001f) *
+                                       self->smooth[i];
+    float currentEstimateStsa = 0.f;
+    float snrPrior;
+    if (magn[i] > self->noise[i]) {
+      currentEstimateStsa = magn[i] / (self->noise[i] + 0.0001f) - 1.f;
+    }
+    snrPrior = DD_PR_SNR * previousEstimateStsa +
+               (1.f - DD_PR_SNR) * currentEstimateStsa;
+    theFilter[i] = snrPrior / (self->overdrive + snrPrior);
+  }
+}
+
+void WebRtcNs_InitSse2(void) {
+  WebRtcNs_MagnitudeSpectrum = MagnitudeSpectrumSSE2;
+  WebRtcNs_ComputeDdBasedWienerFilter = ComputeDdBasedWienerFilterSSE2;
+}
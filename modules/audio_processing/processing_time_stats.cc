@@ -0,0 +1,79 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_processing/processing_time_stats.h"
+
+#include <algorithm>
+
+#include "webrtc/base/timeutils.h"
+
+namespace webrtc {
+
+ProcessingTimeStats::ProcessingTimeStats() = default;
+
+ProcessingTimeStats::~ProcessingTimeStats() = default;
+
+void ProcessingTimeStats::AddTime(int64_t duration_ns) {
+  frame_duration_ns_ += duration_ns;
+  frame_timed_ = true;
+}
+
+void ProcessingTimeStats::EndFrame() {
+  if (!frame_timed_) {
+    return;
+  }
+  const int64_t duration_ns = frame_duration_ns_;
+  frame_duration_ns_ = 0;
+  frame_timed_ = false;
+
+  rtc::CritScope cs(&crit_);
+  last_ns_ = duration_ns;
+  sum_ns_ += duration_ns;
+  if (num_frames_ == 0) {
+    max_ns_ = duration_ns;
+    min_ns_ = duration_ns;
+  } else {
+    max_ns_ = std::max(max_ns_, duration_ns);
+    min_ns_ = std::min(min_ns_, duration_ns);
+  }
+  ++num_frames_;
+}
+
+AudioProcessing::Stat ProcessingTimeStats::GetStats() const {
+  const float kNanosecsPerMicrosec = rtc::kNumNanosecsPerMicrosec;
+  AudioProcessing::Stat stat;
+  rtc::CritScope cs(&crit_);
+  if (num_frames_ > 0) {
+    stat.Set(last_ns_ / kNanosecsPerMicrosec,
+             sum_ns_ / (kNanosecsPerMicrosec * num_frames_),
+             max_ns_ / kNanosecsPerMicrosec, min_ns_ / kNanosecsPerMicrosec);
+  }
+  return stat;
+}
+
+ScopedProcessingTimer::ScopedProcessingTimer(ProcessingTimeStats* stats)
+    : stats_(stats), start_time_ns_(stats ? rtc::TimeNanos() : 0) {}
+
+ScopedProcessingTimer::~ScopedProcessingTimer() {
+  if (stats_) {
+    stats_->AddTime(rtc::TimeNanos() - start_time_ns_);
+  }
+}
+
+ScopedProcessingFrame::ScopedProcessingFrame(ProcessingTimeStats* stats)
+    : stats_(stats) {}
+
+ScopedProcessingFrame::~ScopedProcessingFrame() {
+  if (stats_) {
+    stats_->EndFrame();
+  }
+}
+
+}  // namespace webrtc
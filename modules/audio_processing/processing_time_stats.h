@@ -0,0 +1,83 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_AUDIO_PROCESSING_PROCESSING_TIME_STATS_H_
+#define WEBRTC_MODULES_AUDIO_PROCESSING_PROCESSING_TIME_STATS_H_
+
+#include <stdint.h>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/modules/audio_processing/include/audio_processing.h"
+
+namespace webrtc {
+
+// Aggregates the time an APM submodule spends per 10 ms frame. The time of a
+// frame may be added in several parts through AddTime() and is committed by
+// EndFrame(). AddTime() and EndFrame() must be called from the processing
+// thread, while GetStats() may be called from any thread.
+class ProcessingTimeStats {
+ public:
+  ProcessingTimeStats();
+  ~ProcessingTimeStats();
+
+  void AddTime(int64_t duration_ns);
+
+  // Commits the time added since the previous call. Frames without any time
+  // added are not counted.
+  void EndFrame();
+
+  // Returns the processing time per frame in microseconds.
+  AudioProcessing::Stat GetStats() const;
+
+ private:
+  int64_t frame_duration_ns_ = 0;
+  bool frame_timed_ = false;
+
+  rtc::CriticalSection crit_;
+  int64_t num_frames_ GUARDED_BY(crit_) = 0;
+  int64_t sum_ns_ GUARDED_BY(crit_) = 0;
+  int64_t last_ns_ GUARDED_BY(crit_) = 0;
+  int64_t max_ns_ GUARDED_BY(crit_) = 0;
+  int64_t min_ns_ GUARDED_BY(crit_) = 0;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ProcessingTimeStats);
+};
+
+// Adds the lifetime of the object to |stats|, if |stats| is non-null.
+class ScopedProcessingTimer {
+ public:
+  explicit ScopedProcessingTimer(ProcessingTimeStats* stats);
+  ~ScopedProcessingTimer();
+
+ private:
+  ProcessingTimeStats* const stats_;
+  const int64_t start_time_ns_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ScopedProcessingTimer);
+};
+
+// Calls EndFrame() on |stats| when going out of scope, if |stats| is
+// non-null, so that the frame is committed on early returns as well.
+class ScopedProcessingFrame {
+ public:
+  explicit ScopedProcessingFrame(ProcessingTimeStats* stats);
+  ~ScopedProcessingFrame();
+
+ private:
+  ProcessingTimeStats* const stats_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(ScopedProcessingFrame);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_AUDIO_PROCESSING_PROCESSING_TIME_STATS_H_
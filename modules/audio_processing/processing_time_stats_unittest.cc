@@ -0,0 +1,80 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/audio_processing/processing_time_stats.h"
+
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+TEST(ProcessingTimeStatsTest, NoStatsBeforeFirstFrame) {
+  ProcessingTimeStats stats;
+  stats.EndFrame();
+  AudioProcessing::Stat stat = stats.GetStats();
+  EXPECT_EQ(0.f, stat.instant());
+  EXPECT_EQ(0.f, stat.average());
+  EXPECT_EQ(0.f, stat.maximum());
+  EXPECT_EQ(0.f, stat.minimum());
+}
+
+TEST(ProcessingTimeStatsTest, AggregatesFrames) {
+  ProcessingTimeStats stats;
+  // The first frame is added in two parts.
+  stats.AddTime(100000);
+  stats.AddTime(200000);
+  stats.EndFrame();
+  stats.AddTime(500000);
+  stats.EndFrame();
+  // Frames without any time added are ignored.
+  stats.EndFrame();
+  stats.AddTime(400000);
+  stats.EndFrame();
+
+  AudioProcessing::Stat stat = stats.GetStats();
+  EXPECT_EQ(400.f, stat.instant());
+  EXPECT_EQ(400.f, stat.average());
+  EXPECT_EQ(500.f, stat.maximum());
+  EXPECT_EQ(300.f, stat.minimum());
+}
+
+TEST(ProcessingTimeStatsTest, ScopedTimerAddsTime) {
+  ProcessingTimeStats stats;
+  {
+    ScopedProcessingTimer timer(&stats);
+  }
+  {
+    // Timing with a null stats object is a no-op.
+    ScopedProcessingTimer timer(nullptr);
+  }
+  stats.EndFrame();
+  AudioProcessing::Stat stat = stats.GetStats();
+  EXPECT_LE(0.f, stat.minimum());
+  EXPECT_EQ(stat.instant(), stat.maximum());
+}
+
+TEST(ProcessingTimeStatsTest, ScopedFrameEndsFrame) {
+  ProcessingTimeStats stats;
+  {
+    ScopedProcessingFrame frame(&stats);
+    stats.AddTime(300000);
+  }
+  {
+    // A frame with a null stats object is a no-op.
+    ScopedProcessingFrame frame(nullptr);
+    stats.AddTime(100000);
+  }
+  // The time added outside of the scoped frame is committed separately.
+  stats.EndFrame();
+  AudioProcessing::Stat stat = stats.GetStats();
+  EXPECT_EQ(100.f, stat.instant());
+  EXPECT_EQ(300.f, stat.maximum());
+}
+
+}  // namespace webrtc
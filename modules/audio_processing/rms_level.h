@@ -43,6 +43,8 @@ class RmsLevel {
 
   // Pass each chunk of audio to Analyze() to accumulate the level.
   void Analyze(rtc::ArrayView<const int16_t> data);
+  // Same as above, for float samples in the int16 range [-32768, 32767].
+  void Analyze(rtc::ArrayView<const float> data);
 
   // If all samples with the given |length| have a magnitude of zero, this is
   // a shortcut to avoid some computation.
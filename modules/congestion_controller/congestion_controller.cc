@@ -280,6 +280,10 @@ void CongestionController::EnablePeriodicAlrProbing(bool enable) {
   probe_controller_->EnablePeriodicAlrProbing(enable);
 }
 
+void CongestionController::EnableAlrPaddingSuppression(bool enable) {
+  pacer_->EnableAlrPaddingSuppression(enable);
+}
+
 void CongestionController::SetAllocatedSendBitrateLimits(
     int min_send_bitrate_bps,
     int max_padding_bitrate_bps) {
@@ -246,21 +246,12 @@ DelayBasedBwe::Result DelayBasedBwe::IncomingPacketFeedbackVector(
                               BweNames::kBweNamesMax);
     uma_recorded_ = true;
   }
-  Result aggregated_result;
-  for (const auto& packet_info : packet_feedback_vector) {
-    Result result = IncomingPacketInfo(packet_info);
-    if (result.updated)
-      aggregated_result = result;
-  }
-  return aggregated_result;
-}
-
-DelayBasedBwe::Result DelayBasedBwe::IncomingPacketInfo(
-    const PacketInfo& info) {
-  int64_t now_ms = clock_->TimeInMilliseconds();
+  if (packet_feedback_vector.empty())
+    return Result();
 
-  receiver_incoming_bitrate_.Update(info.arrival_time_ms, info.payload_size);
-  Result result;
+  // The whole feedback vector is handled at the same time, so the estimators
+  // are reset at most once per vector.
+  const int64_t now_ms = clock_->TimeInMilliseconds();
   // Reset if the stream has timed out.
   if (last_seen_packet_ms_ == -1 ||
       now_ms - last_seen_packet_ms_ > kStreamTimeOutMs) {
@@ -276,6 +267,20 @@ DelayBasedBwe::Result DelayBasedBwe::IncomingPacketInfo(
   }
   last_seen_packet_ms_ = now_ms;
 
+  Result aggregated_result;
+  for (const auto& packet_info : packet_feedback_vector) {
+    Result result = IncomingPacketInfo(packet_info, now_ms);
+    if (result.updated)
+      aggregated_result = result;
+  }
+  return aggregated_result;
+}
+
+DelayBasedBwe::Result DelayBasedBwe::IncomingPacketInfo(const PacketInfo& info,
+                                                        int64_t now_ms) {
+  receiver_incoming_bitrate_.Update(info.arrival_time_ms, info.payload_size);
+  Result result;
+
   uint32_t send_time_24bits =
       static_cast<uint32_t>(
           ((static_cast<uint64_t>(info.send_time_ms) << kAbsSendTimeFraction) +
@@ -93,6 +93,8 @@ class CongestionController : public CallStatsObserver, public Module {
   virtual TransportFeedbackObserver* GetTransportFeedbackObserver();
   RateLimiter* GetRetransmissionRateLimiter();
   void EnablePeriodicAlrProbing(bool enable);
+  // See PacedSender::EnableAlrPaddingSuppression.
+  void EnableAlrPaddingSuppression(bool enable);
 
   // SetAllocatedSendBitrateLimits sets bitrates limits imposed by send codec
   // settings.
@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <vector>
 
+#include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/modules/remote_bitrate_estimator/include/bwe_defines.h"
 #include "webrtc/modules/remote_bitrate_estimator/test/bwe_test_logging.h"
@@ -27,9 +28,15 @@ MedianSlopeEstimator::MedianSlopeEstimator(size_t window_size,
       threshold_gain_(threshold_gain),
       num_of_deltas_(0),
       accumulated_delay_(0),
-      delay_hist_(),
+      hist_begin_(0),
+      hist_size_(0),
       median_filter_(0.5),
-      trendline_(0) {}
+      trendline_(0) {
+  RTC_DCHECK_GT(window_size, 0u);
+  delay_hist_.reserve(window_size);
+  for (size_t i = 0; i < window_size; ++i)
+    delay_hist_.emplace_back(0, 0, window_size - 1);
+}
 
 MedianSlopeEstimator::~MedianSlopeEstimator() {}
 
@@ -47,15 +54,19 @@ void MedianSlopeEstimator::Update(double recv_delta_ms,
 
   // If the window is full, remove the |window_size_| - 1 slopes that belong to
   // the oldest point.
-  if (delay_hist_.size() == window_size_) {
-    for (double slope : delay_hist_.front().slopes) {
+  if (hist_size_ == window_size_) {
+    DelayInfo& oldest = delay_hist_[hist_begin_];
+    for (double slope : oldest.slopes) {
       const bool success = median_filter_.Erase(slope);
       RTC_CHECK(success);
     }
-    delay_hist_.pop_front();
+    oldest.slopes.clear();
+    hist_begin_ = (hist_begin_ + 1) % window_size_;
+    --hist_size_;
   }
   // Add |window_size_| - 1 new slopes.
-  for (auto& old_delay : delay_hist_) {
+  for (size_t i = 0; i < hist_size_; ++i) {
+    DelayInfo& old_delay = delay_hist_[(hist_begin_ + i) % window_size_];
     if (arrival_time_ms - old_delay.time != 0) {
       // The C99 standard explicitly states that casts and assignments must
       // perform the associated conversions. This means that |slope| will be
@@ -72,10 +83,13 @@ void MedianSlopeEstimator::Update(double recv_delta_ms,
       old_delay.slopes.push_back(slope);
     }
   }
-  delay_hist_.emplace_back(arrival_time_ms, accumulated_delay_,
-                           window_size_ - 1);
+  DelayInfo& newest = delay_hist_[(hist_begin_ + hist_size_) % window_size_];
+  newest.time = arrival_time_ms;
+  newest.delay = accumulated_delay_;
+  newest.slopes.clear();
+  ++hist_size_;
   // Recompute the median slope.
-  if (delay_hist_.size() == window_size_)
+  if (hist_size_ == window_size_)
     trendline_ = median_filter_.GetPercentileValue();
 
   BWE_TEST_LOGGING_PLOT(1, "trendline_slope", arrival_time_ms, trendline_);
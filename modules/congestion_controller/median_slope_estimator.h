@@ -13,7 +13,6 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <list>
 #include <vector>
 
 #include "webrtc/base/constructormagic.h"
@@ -63,7 +62,12 @@ class MedianSlopeEstimator {
   unsigned int num_of_deltas_;
   // Theil-Sen robust line fitting
   double accumulated_delay_;
-  std::list<DelayInfo> delay_hist_;
+  // Ring of the last |window_size_| points starting at |hist_begin_|. The
+  // entries, and the capacity of their |slopes|, are reused as the window
+  // moves.
+  std::vector<DelayInfo> delay_hist_;
+  size_t hist_begin_;
+  size_t hist_size_;
   PercentileFilter<double> median_filter_;
   double trendline_;
 
@@ -59,6 +59,7 @@ class TransportFeedbackAdapter : public TransportFeedbackObserver,
 
   rtc::CriticalSection lock_;
   rtc::CriticalSection bwe_lock_;
+  const bool send_side_bwe_with_overhead_;
   int transport_overhead_bytes_per_packet_ GUARDED_BY(&lock_);
   SendTimeHistory send_time_history_ GUARDED_BY(&lock_);
   std::unique_ptr<DelayBasedBwe> delay_based_bwe_ GUARDED_BY(&bwe_lock_);
@@ -13,37 +13,10 @@
 #include <algorithm>
 
 #include "webrtc/base/checks.h"
-#include "webrtc/base/optional.h"
 #include "webrtc/modules/remote_bitrate_estimator/test/bwe_test_logging.h"
 
 namespace webrtc {
 
-namespace {
-rtc::Optional<double> LinearFitSlope(
-    const std::list<std::pair<double, double>> points) {
-  RTC_DCHECK(points.size() >= 2);
-  // Compute the "center of mass".
-  double sum_x = 0;
-  double sum_y = 0;
-  for (const auto& point : points) {
-    sum_x += point.first;
-    sum_y += point.second;
-  }
-  double x_avg = sum_x / points.size();
-  double y_avg = sum_y / points.size();
-  // Compute the slope k = \sum (x_i-x_avg)(y_i-y_avg) / \sum (x_i-x_avg)^2
-  double numerator = 0;
-  double denominator = 0;
-  for (const auto& point : points) {
-    numerator += (point.first - x_avg) * (point.second - y_avg);
-    denominator += (point.first - x_avg) * (point.first - x_avg);
-  }
-  if (denominator == 0)
-    return rtc::Optional<double>();
-  return rtc::Optional<double>(numerator / denominator);
-}
-}  // namespace
-
 enum { kDeltaCounterMax = 1000 };
 
 TrendlineEstimator::TrendlineEstimator(size_t window_size,
@@ -56,8 +29,18 @@ TrendlineEstimator::TrendlineEstimator(size_t window_size,
       first_arrival_time_ms(-1),
       accumulated_delay_(0),
       smoothed_delay_(0),
-      delay_hist_(),
-      trendline_(0) {}
+      delay_hist_(window_size),
+      hist_begin_(0),
+      hist_size_(0),
+      updates_until_recompute_(window_size),
+      x_origin_(0),
+      sum_x_(0),
+      sum_y_(0),
+      sum_xx_(0),
+      sum_xy_(0),
+      trendline_(0) {
+  RTC_DCHECK_GT(window_size, 0u);
+}
 
 TrendlineEstimator::~TrendlineEstimator() {}
 
@@ -81,17 +64,61 @@ void TrendlineEstimator::Update(double recv_delta_ms,
                         smoothed_delay_);
 
   // Simple linear regression.
-  delay_hist_.push_back(std::make_pair(
+  const std::pair<double, double> point(
       static_cast<double>(arrival_time_ms - first_arrival_time_ms),
-      smoothed_delay_));
-  if (delay_hist_.size() > window_size_)
-    delay_hist_.pop_front();
-  if (delay_hist_.size() == window_size_) {
+      smoothed_delay_);
+  if (hist_size_ == window_size_) {
+    const std::pair<double, double>& oldest = delay_hist_[hist_begin_];
+    const double x = oldest.first - x_origin_;
+    sum_x_ -= x;
+    sum_y_ -= oldest.second;
+    sum_xx_ -= x * x;
+    sum_xy_ -= x * oldest.second;
+    delay_hist_[hist_begin_] = point;
+    hist_begin_ = (hist_begin_ + 1) % window_size_;
+  } else {
+    delay_hist_[(hist_begin_ + hist_size_) % window_size_] = point;
+    ++hist_size_;
+  }
+  if (--updates_until_recompute_ == 0) {
+    RecomputeSums();
+  } else {
+    const double x = point.first - x_origin_;
+    sum_x_ += x;
+    sum_y_ += point.second;
+    sum_xx_ += x * x;
+    sum_xy_ += x * point.second;
+  }
+
+  if (hist_size_ == window_size_) {
+    // k = (n \sum x_i y_i - \sum x_i \sum y_i) / (n \sum x_i^2 - (\sum x_i)^2)
+    const double n = static_cast<double>(hist_size_);
+    const double denominator = n * sum_xx_ - sum_x_ * sum_x_;
     // Only update trendline_ if it is possible to fit a line to the data.
-    trendline_ = LinearFitSlope(delay_hist_).value_or(trendline_);
+    if (denominator != 0)
+      trendline_ = (n * sum_xy_ - sum_x_ * sum_y_) / denominator;
   }
 
   BWE_TEST_LOGGING_PLOT(1, "trendline_slope", arrival_time_ms, trendline_);
 }
 
+void TrendlineEstimator::RecomputeSums() {
+  // Measure x from the oldest point, so the sums stay small as time goes by.
+  x_origin_ = delay_hist_[hist_begin_].first;
+  sum_x_ = 0;
+  sum_y_ = 0;
+  sum_xx_ = 0;
+  sum_xy_ = 0;
+  for (size_t i = 0; i < hist_size_; ++i) {
+    const std::pair<double, double>& point =
+        delay_hist_[(hist_begin_ + i) % window_size_];
+    const double x = point.first - x_origin_;
+    sum_x_ += x;
+    sum_y_ += point.second;
+    sum_xx_ += x * x;
+    sum_xy_ += x * point.second;
+  }
+  updates_until_recompute_ = window_size_;
+}
+
 }  // namespace webrtc
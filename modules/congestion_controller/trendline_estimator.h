@@ -13,8 +13,8 @@
 #include <stddef.h>
 #include <stdint.h>
 
-#include <list>
 #include <utility>
+#include <vector>
 
 #include "webrtc/base/constructormagic.h"
 
@@ -49,6 +49,10 @@ class TrendlineEstimator {
   unsigned int num_of_deltas() const { return num_of_deltas_; }
 
  private:
+  // Recomputes the regression sums from the points in the window, dropping
+  // the rounding errors of the incremental updates.
+  void RecomputeSums();
+
   // Parameters.
   const size_t window_size_;
   const double smoothing_coef_;
@@ -60,8 +64,19 @@ class TrendlineEstimator {
   // Exponential backoff filtering.
   double accumulated_delay_;
   double smoothed_delay_;
-  // Linear least squares regression.
-  std::list<std::pair<double, double>> delay_hist_;
+  // Linear least squares regression over the last |window_size_| points,
+  // kept in a ring starting at |hist_begin_|. The sums are taken relative to
+  // |x_origin_| and updated as points enter and leave the window, then
+  // recomputed from the ring once per window.
+  std::vector<std::pair<double, double>> delay_hist_;
+  size_t hist_begin_;
+  size_t hist_size_;
+  size_t updates_until_recompute_;
+  double x_origin_;
+  double sum_x_;
+  double sum_y_;
+  double sum_xx_;
+  double sum_xy_;
   double trendline_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(TrendlineEstimator);
@@ -70,4 +70,21 @@ TEST(TrendlineEstimator, JitteryLineSlopeZero) {
   TestEstimator(0, kAvgTimeBetweenPackets / 3.0, 0.02);
 }
 
+// The regression sums are updated incrementally, check the rounding errors do
+// not build up over a long call.
+TEST(TrendlineEstimator, PerfectLineAfterManyWindows) {
+  TrendlineEstimator estimator(kWindowSize, kSmoothing, kGain);
+  const int64_t kNumWindows = 10001;
+  for (int64_t i = 0; i < kNumWindows * static_cast<int64_t>(kWindowSize);
+       ++i) {
+    // Alternate between windows with slope -1 and slope 0.5.
+    const bool increasing = (i / kWindowSize) % 2 == 0;
+    const double delay_delta =
+        increasing ? kAvgTimeBetweenPackets / 2.0 : -kAvgTimeBetweenPackets;
+    estimator.Update(kAvgTimeBetweenPackets + delay_delta,
+                     kAvgTimeBetweenPackets, i * kAvgTimeBetweenPackets);
+  }
+  EXPECT_NEAR(0.5, estimator.trendline_slope(), 0.001);
+}
+
 }  // namespace webrtc
@@ -0,0 +1,79 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/desktop_capture/alpha_blend.h"
+
+#include <string.h>
+
+#include "webrtc/modules/desktop_capture/alpha_blend_sse2.h"
+#include "webrtc/modules/desktop_capture/desktop_frame.h"
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+namespace {
+
+void AlphaBlendRow_C(uint8_t* dest, const uint8_t* src, int width) {
+  for (int x = 0; x < width; ++x) {
+    uint32_t base_alpha = 255 - src[x * DesktopFrame::kBytesPerPixel + 3];
+    if (base_alpha == 255) {
+      continue;
+    } else if (base_alpha == 0) {
+      memcpy(dest + x * DesktopFrame::kBytesPerPixel,
+             src + x * DesktopFrame::kBytesPerPixel,
+             DesktopFrame::kBytesPerPixel);
+    } else {
+      dest[x * DesktopFrame::kBytesPerPixel] =
+          dest[x * DesktopFrame::kBytesPerPixel] * base_alpha / 255 +
+          src[x * DesktopFrame::kBytesPerPixel];
+      dest[x * DesktopFrame::kBytesPerPixel + 1] =
+          dest[x * DesktopFrame::kBytesPerPixel + 1] * base_alpha / 255 +
+          src[x * DesktopFrame::kBytesPerPixel + 1];
+      dest[x * DesktopFrame::kBytesPerPixel + 2] =
+          dest[x * DesktopFrame::kBytesPerPixel + 2] * base_alpha / 255 +
+          src[x * DesktopFrame::kBytesPerPixel + 2];
+    }
+  }
+}
+
+}  // namespace
+
+void AlphaBlend(uint8_t* dest,
+                int dest_stride,
+                const uint8_t* src,
+                int src_stride,
+                const DesktopSize& size) {
+  static bool use_sse2 = false;
+  static bool initialized = false;
+  if (!initialized) {
+#if !defined(WEBRTC_ARCH_ARM_FAMILY) && !defined(WEBRTC_ARCH_MIPS_FAMILY)
+    use_sse2 = WebRtc_GetCPUInfo(kSSE2) != 0;
+#endif
+    initialized = true;
+  }
+
+  // The SSE2 version blends 4 pixels at a time, the rest of the row is left
+  // to the C version.
+  const int simd_width = use_sse2 ? size.width() & ~3 : 0;
+  for (int y = 0; y < size.height(); ++y) {
+#if !defined(WEBRTC_ARCH_ARM_FAMILY) && !defined(WEBRTC_ARCH_MIPS_FAMILY)
+    if (simd_width > 0)
+      AlphaBlendRow_SSE2(dest, src, simd_width);
+#endif
+    AlphaBlendRow_C(dest + simd_width * DesktopFrame::kBytesPerPixel,
+                    src + simd_width * DesktopFrame::kBytesPerPixel,
+                    size.width() - simd_width);
+    src += src_stride;
+    dest += dest_stride;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,78 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/desktop_capture/alpha_blend_sse2.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <mmintrin.h>
+#include <emmintrin.h>
+#endif
+
+namespace webrtc {
+
+namespace {
+
+// Returns the bits of |a| where |mask| is set and the bits of |b| elsewhere.
+__m128i Select(__m128i mask, __m128i a, __m128i b) {
+  return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// Returns |value| * |alpha| / 255 for 16-bit lanes holding 8-bit values,
+// rounded down like the integer division.
+__m128i MultiplyAlpha(__m128i value, __m128i alpha) {
+  const __m128i product = _mm_mullo_epi16(value, alpha);
+  return _mm_srli_epi16(
+      _mm_add_epi16(_mm_add_epi16(product, _mm_set1_epi16(1)),
+                    _mm_srli_epi16(product, 8)),
+      8);
+}
+
+}  // namespace
+
+extern void AlphaBlendRow_SSE2(uint8_t* dest, const uint8_t* src, int width) {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i alpha_mask = _mm_set1_epi32(0xff000000);
+  const __m128i* src_pixels = reinterpret_cast<const __m128i*>(src);
+  __m128i* dest_pixels = reinterpret_cast<__m128i*>(dest);
+  for (int x = 0; x < width; x += 4, ++src_pixels, ++dest_pixels) {
+    const __m128i s = _mm_loadu_si128(src_pixels);
+    const __m128i src_alpha = _mm_and_si128(s, alpha_mask);
+    // Pixels with a transparent source keep the destination.
+    const __m128i transparent = _mm_cmpeq_epi32(src_alpha, zero);
+    if (_mm_movemask_epi8(transparent) == 0xffff)
+      continue;
+    const __m128i opaque = _mm_cmpeq_epi32(src_alpha, alpha_mask);
+
+    const __m128i d = _mm_loadu_si128(dest_pixels);
+    // 255 - source alpha, in every byte of the pixel.
+    __m128i base_alpha = _mm_srli_epi32(s, 24);
+    base_alpha = _mm_or_si128(base_alpha, _mm_slli_epi32(base_alpha, 8));
+    base_alpha = _mm_or_si128(base_alpha, _mm_slli_epi32(base_alpha, 16));
+    base_alpha = _mm_andnot_si128(base_alpha, _mm_set1_epi8(-1));
+
+    const __m128i blended_lo =
+        MultiplyAlpha(_mm_unpacklo_epi8(d, zero),
+                      _mm_unpacklo_epi8(base_alpha, zero));
+    const __m128i blended_hi =
+        MultiplyAlpha(_mm_unpackhi_epi8(d, zero),
+                      _mm_unpackhi_epi8(base_alpha, zero));
+    __m128i result =
+        _mm_add_epi8(_mm_packus_epi16(blended_lo, blended_hi), s);
+    // The alpha of the destination is kept, unless the source is opaque.
+    result = Select(alpha_mask, d, result);
+    result = Select(opaque, s, result);
+    result = Select(transparent, d, result);
+    _mm_storeu_si128(dest_pixels, result);
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,27 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// This header file is used only by alpha_blend.cc. It defines the SSE2
+// routine for blending the cursor into a frame.
+
+#ifndef WEBRTC_MODULES_DESKTOP_CAPTURE_ALPHA_BLEND_SSE2_H_
+#define WEBRTC_MODULES_DESKTOP_CAPTURE_ALPHA_BLEND_SSE2_H_
+
+#include <stdint.h>
+
+namespace webrtc {
+
+// Blends a row of |width| pixels of |src| into |dest|, with the same results
+// as the C version. |width| must be a multiple of 4.
+extern void AlphaBlendRow_SSE2(uint8_t* dest, const uint8_t* src, int width);
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_DESKTOP_CAPTURE_ALPHA_BLEND_SSE2_H_
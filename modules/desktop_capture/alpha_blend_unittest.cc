@@ -0,0 +1,72 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/desktop_capture/alpha_blend.h"
+
+#include <stdlib.h>
+
+#include <vector>
+
+#include "webrtc/modules/desktop_capture/desktop_frame.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+namespace {
+
+// Blends one pre-multiplied pixel into an opaque one.
+void BlendPixel(uint8_t* dest, const uint8_t* src) {
+  const int base_alpha = 255 - src[3];
+  if (base_alpha == 255)
+    return;
+  for (int i = 0; i < 3; ++i)
+    dest[i] = static_cast<uint8_t>(dest[i] * base_alpha / 255 + src[i]);
+  if (base_alpha == 0)
+    dest[3] = src[3];
+}
+
+}  // namespace
+
+// Blends images of every width up to 20 pixels, so both the SIMD and the C
+// code paths are covered, and compares the result with a per pixel blend.
+TEST(AlphaBlendTest, MatchesPerPixelBlend) {
+  srand(0);
+  const int kHeight = 3;
+  const int kStride = 24 * DesktopFrame::kBytesPerPixel;
+  for (int width = 1; width <= 20; ++width) {
+    std::vector<uint8_t> src(kHeight * kStride);
+    std::vector<uint8_t> dest(kHeight * kStride);
+    for (size_t i = 0; i < src.size(); i += DesktopFrame::kBytesPerPixel) {
+      // Mostly transparent and opaque pixels, like a cursor.
+      const int alpha_type = rand() % 4;
+      const int alpha =
+          alpha_type == 0 ? 0 : alpha_type == 1 ? 255 : rand() % 256;
+      for (int j = 0; j < 3; ++j)
+        src[i + j] = static_cast<uint8_t>(rand() % 256 * alpha / 255);
+      src[i + 3] = static_cast<uint8_t>(alpha);
+      for (int j = 0; j < DesktopFrame::kBytesPerPixel; ++j)
+        dest[i + j] = static_cast<uint8_t>(rand());
+    }
+
+    std::vector<uint8_t> expected = dest;
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 0; x < width; ++x) {
+        const int offset = y * kStride + x * DesktopFrame::kBytesPerPixel;
+        BlendPixel(&expected[offset], &src[offset]);
+      }
+    }
+
+    AlphaBlend(dest.data(), kStride, src.data(), kStride,
+               DesktopSize(width, kHeight));
+    EXPECT_EQ(expected, dest) << "width " << width;
+  }
+}
+
+}  // namespace webrtc
@@ -10,9 +10,8 @@
 
 #include "webrtc/modules/desktop_capture/desktop_and_cursor_composer.h"
 
-#include <string.h>
-
 #include "webrtc/base/constructormagic.h"
+#include "webrtc/modules/desktop_capture/alpha_blend.h"
 #include "webrtc/modules/desktop_capture/desktop_capturer.h"
 #include "webrtc/modules/desktop_capture/desktop_frame.h"
 #include "webrtc/modules/desktop_capture/mouse_cursor.h"
@@ -21,37 +20,6 @@ namespace webrtc {
 
 namespace {
 
-// Helper function that blends one image into another. Source image must be
-// pre-multiplied with the alpha channel. Destination is assumed to be opaque.
-void AlphaBlend(uint8_t* dest, int dest_stride,
-                const uint8_t* src, int src_stride,
-                const DesktopSize& size) {
-  for (int y = 0; y < size.height(); ++y) {
-    for (int x = 0; x < size.width(); ++x) {
-      uint32_t base_alpha = 255 - src[x * DesktopFrame::kBytesPerPixel + 3];
-      if (base_alpha == 255) {
-        continue;
-      } else if (base_alpha == 0) {
-        memcpy(dest + x * DesktopFrame::kBytesPerPixel,
-               src + x * DesktopFrame::kBytesPerPixel,
-               DesktopFrame::kBytesPerPixel);
-      } else {
-        dest[x * DesktopFrame::kBytesPerPixel] =
-            dest[x * DesktopFrame::kBytesPerPixel] * base_alpha / 255 +
-            src[x * DesktopFrame::kBytesPerPixel];
-        dest[x * DesktopFrame::kBytesPerPixel + 1] =
-            dest[x * DesktopFrame::kBytesPerPixel + 1] * base_alpha / 255 +
-            src[x * DesktopFrame::kBytesPerPixel + 1];
-        dest[x * DesktopFrame::kBytesPerPixel + 2] =
-            dest[x * DesktopFrame::kBytesPerPixel + 2] * base_alpha / 255 +
-            src[x * DesktopFrame::kBytesPerPixel + 2];
-      }
-    }
-    src += src_stride;
-    dest += dest_stride;
-  }
-}
-
 // DesktopFrame wrapper that draws mouse on a frame and restores original
 // content before releasing the underlying frame.
 class DesktopFrameWithCursor : public DesktopFrame {
@@ -62,6 +30,9 @@ class DesktopFrameWithCursor : public DesktopFrame {
                          const DesktopVector& position);
   ~DesktopFrameWithCursor() override;
 
+  // The area covered by the cursor, empty if it is outside of the frame.
+  DesktopRect cursor_rect() const;
+
  private:
   std::unique_ptr<DesktopFrame> original_frame_;
 
@@ -112,6 +83,14 @@ DesktopFrameWithCursor::DesktopFrameWithCursor(
              target_rect.size());
 }
 
+DesktopRect DesktopFrameWithCursor::cursor_rect() const {
+  if (!restore_frame_)
+    return DesktopRect();
+  DesktopRect rect = DesktopRect::MakeSize(restore_frame_->size());
+  rect.Translate(restore_position_);
+  return rect;
+}
+
 DesktopFrameWithCursor::~DesktopFrameWithCursor() {
   // Restore original content of the frame.
   if (restore_frame_.get()) {
@@ -158,9 +137,25 @@ void DesktopAndCursorComposer::SetExcludedWindow(WindowId window) {
 void DesktopAndCursorComposer::OnCaptureResult(
     DesktopCapturer::Result result,
     std::unique_ptr<DesktopFrame> frame) {
-  if (frame && cursor_ && cursor_state_ == MouseCursorMonitor::INSIDE) {
-    frame = std::unique_ptr<DesktopFrameWithCursor>(new DesktopFrameWithCursor(
-        std::move(frame), *cursor_, cursor_position_));
+  if (frame) {
+    DesktopRect cursor_rect;
+    if (cursor_ && cursor_state_ == MouseCursorMonitor::INSIDE) {
+      std::unique_ptr<DesktopFrameWithCursor> frame_with_cursor(
+          new DesktopFrameWithCursor(std::move(frame), *cursor_,
+                                     cursor_position_));
+      cursor_rect = frame_with_cursor->cursor_rect();
+      frame = std::move(frame_with_cursor);
+    }
+
+    // Compared to the previous frame, the cursor changed only the area under
+    // its old and new positions.
+    if (cursor_changed_ || !cursor_rect.equals(previous_cursor_rect_)) {
+      previous_cursor_rect_.IntersectWith(DesktopRect::MakeSize(frame->size()));
+      frame->mutable_updated_region()->AddRect(previous_cursor_rect_);
+      frame->mutable_updated_region()->AddRect(cursor_rect);
+    }
+    previous_cursor_rect_ = cursor_rect;
+    cursor_changed_ = false;
   }
 
   callback_->OnCaptureResult(result, std::move(frame));
@@ -168,6 +163,7 @@ void DesktopAndCursorComposer::OnCaptureResult(
 
 void DesktopAndCursorComposer::OnMouseCursor(MouseCursor* cursor) {
   cursor_.reset(cursor);
+  cursor_changed_ = true;
 }
 
 void DesktopAndCursorComposer::OnMouseCursorPosition(
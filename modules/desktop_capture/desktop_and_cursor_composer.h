@@ -15,6 +15,7 @@
 
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/modules/desktop_capture/desktop_capturer.h"
+#include "webrtc/modules/desktop_capture/desktop_geometry.h"
 #include "webrtc/modules/desktop_capture/mouse_cursor_monitor.h"
 
 namespace webrtc {
@@ -59,6 +60,12 @@ class DesktopAndCursorComposer : public DesktopCapturer,
   MouseCursorMonitor::CursorState cursor_state_;
   DesktopVector cursor_position_;
 
+  // The area covered by the cursor in the previous frame, empty if the cursor
+  // wasn't drawn.
+  DesktopRect previous_cursor_rect_;
+  // Set when the cursor shape changed since the previous frame.
+  bool cursor_changed_ = false;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(DesktopAndCursorComposer);
 };
 
@@ -125,6 +125,7 @@ class FakeMouseMonitor : public MouseCursorMonitor {
       }
 
       callback_->OnMouseCursor(new MouseCursor(image.release(), hotspot_));
+      changed_ = false;
     }
 
     callback_->OnMouseCursorPosition(state_, position_);
@@ -247,6 +248,37 @@ TEST_F(DesktopAndCursorComposerTest, Blend) {
   }
 }
 
+TEST_F(DesktopAndCursorComposerTest, UpdatedRegionCoversCursorChanges) {
+  blender_.Start(this);
+  fake_cursor_->SetHotspot(DesktopVector());
+
+  // Captures a frame without changes, so only the cursor can update it.
+  auto capture = [this](const DesktopVector& pos) {
+    fake_cursor_->SetState(MouseCursorMonitor::INSIDE, pos);
+    std::unique_ptr<DesktopFrame> frame(CreateTestFrame());
+    frame->mutable_updated_region()->Clear();
+    fake_screen_->SetNextFrame(std::move(frame));
+    blender_.CaptureFrame();
+  };
+
+  capture(DesktopVector(10, 10));
+  DesktopRegion expected(DesktopRect::MakeXYWH(10, 10, kCursorWidth,
+                                               kCursorHeight));
+  EXPECT_TRUE(frame_->updated_region().Equals(expected));
+
+  // Not moved.
+  capture(DesktopVector(10, 10));
+  EXPECT_TRUE(frame_->updated_region().is_empty());
+
+  // Moved, partly outside of the frame.
+  capture(DesktopVector(95, 50));
+  expected.SetRect(DesktopRect::MakeXYWH(10, 10, kCursorWidth,
+                                         kCursorHeight));
+  expected.AddRect(DesktopRect::MakeLTRB(95, 50, kScreenWidth,
+                                         50 + kCursorHeight));
+  EXPECT_TRUE(frame_->updated_region().Equals(expected));
+}
+
 }  // namespace
 
 }  // namespace webrtc
@@ -13,6 +13,7 @@
 #include <string.h>
 
 #include "webrtc/typedefs.h"
+#include "webrtc/modules/desktop_capture/differ_vector_avx2.h"
 #include "webrtc/modules/desktop_capture/differ_vector_sse2.h"
 #include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
 
@@ -24,6 +25,20 @@ bool VectorDifference_C(const uint8_t* image1, const uint8_t* image2) {
   return memcmp(image1, image2, kBlockSize * kBytesPerPixel) != 0;
 }
 
+bool BlockDifference_C(const uint8_t* image1,
+                       const uint8_t* image2,
+                       int height,
+                       int stride) {
+  for (int i = 0; i < height; i++) {
+    if (VectorDifference(image1, image2)) {
+      return true;
+    }
+    image1 += stride;
+    image2 += stride;
+  }
+  return false;
+}
+
 }  // namespace
 
 bool VectorDifference(const uint8_t* image1, const uint8_t* image2) {
@@ -35,9 +50,14 @@ bool VectorDifference(const uint8_t* image1, const uint8_t* image2) {
     // TODO(hclam): Implement a NEON version.
     diff_proc = &VectorDifference_C;
 #else
+    bool have_avx2 = WebRtc_GetCPUInfo(kAVX2) != 0;
     bool have_sse2 = WebRtc_GetCPUInfo(kSSE2) != 0;
-    // For x86 processors, check if SSE2 is supported.
-    if (have_sse2 && kBlockSize == 32) {
+    // For x86 processors, check if AVX2 or SSE2 is supported.
+    if (have_avx2 && kBlockSize == 32) {
+      diff_proc = &VectorDifference_AVX2_W32;
+    } else if (have_avx2 && kBlockSize == 16) {
+      diff_proc = &VectorDifference_AVX2_W16;
+    } else if (have_sse2 && kBlockSize == 32) {
       diff_proc = &VectorDifference_SSE2_W32;
     } else if (have_sse2 && kBlockSize == 16) {
       diff_proc = &VectorDifference_SSE2_W16;
@@ -54,14 +74,22 @@ bool BlockDifference(const uint8_t* image1,
                      const uint8_t* image2,
                      int height,
                      int stride) {
-  for (int i = 0; i < height; i++) {
-    if (VectorDifference(image1, image2)) {
-      return true;
+  static bool (*diff_proc)(const uint8_t*, const uint8_t*, int, int) = nullptr;
+
+  if (!diff_proc) {
+#if defined(WEBRTC_ARCH_ARM_FAMILY) || defined(WEBRTC_ARCH_MIPS_FAMILY)
+    diff_proc = &BlockDifference_C;
+#else
+    // Comparing the whole block in one call saves an indirect call per row.
+    if (WebRtc_GetCPUInfo(kAVX2) != 0 && kBlockSize == 32) {
+      diff_proc = &BlockDifference_AVX2_W32;
+    } else {
+      diff_proc = &BlockDifference_C;
     }
-    image1 += stride;
-    image2 += stride;
+#endif
   }
-  return false;
+
+  return diff_proc(image1, image2, height, stride);
 }
 
 bool BlockDifference(const uint8_t* image1, const uint8_t* image2, int stride) {
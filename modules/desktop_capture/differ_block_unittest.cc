@@ -83,4 +83,21 @@ TEST(BlockDifferenceTestFirst, BlockDifference) {
   }
 }
 
+TEST(BlockDifferenceTestEveryByte, BlockDifference) {
+  uint8_t* block1;
+  uint8_t* block2;
+  PrepareBuffers(block1, block2);
+  const int stride = kBlockSize * kBytesPerPixel;
+
+  for (int i = 0; i < kSizeOfBlock; ++i) {
+    block2[i] += 1;
+    EXPECT_TRUE(BlockDifference(block1, block2, stride));
+    EXPECT_TRUE(VectorDifference(block1 + i / stride * stride,
+                                 block2 + i / stride * stride));
+    // Rows above the changed one don't differ.
+    EXPECT_FALSE(BlockDifference(block1, block2, i / stride, stride));
+    block2[i] -= 1;
+  }
+}
+
 }  // namespace webrtc
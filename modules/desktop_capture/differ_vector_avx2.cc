@@ -0,0 +1,60 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/desktop_capture/differ_vector_avx2.h"
+
+#include <immintrin.h>
+
+namespace webrtc {
+
+namespace {
+
+// Returns the bits that differ between the 32 bytes at |image1| and |image2|.
+inline __m256i Xor256(const uint8_t* image1, const uint8_t* image2) {
+  return _mm256_xor_si256(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(image1)),
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(image2)));
+}
+
+// 32 pixels of 4 bytes.
+inline bool RowDifference_W32(const uint8_t* image1, const uint8_t* image2) {
+  __m256i acc = Xor256(image1, image2);
+  acc = _mm256_or_si256(acc, Xor256(image1 + 32, image2 + 32));
+  acc = _mm256_or_si256(acc, Xor256(image1 + 64, image2 + 64));
+  acc = _mm256_or_si256(acc, Xor256(image1 + 96, image2 + 96));
+  return !_mm256_testz_si256(acc, acc);
+}
+
+}  // namespace
+
+bool VectorDifference_AVX2_W16(const uint8_t* image1, const uint8_t* image2) {
+  __m256i acc = Xor256(image1, image2);
+  acc = _mm256_or_si256(acc, Xor256(image1 + 32, image2 + 32));
+  return !_mm256_testz_si256(acc, acc);
+}
+
+bool VectorDifference_AVX2_W32(const uint8_t* image1, const uint8_t* image2) {
+  return RowDifference_W32(image1, image2);
+}
+
+bool BlockDifference_AVX2_W32(const uint8_t* image1,
+                              const uint8_t* image2,
+                              int height,
+                              int stride) {
+  for (int i = 0; i < height; i++) {
+    if (RowDifference_W32(image1, image2))
+      return true;
+    image1 += stride;
+    image2 += stride;
+  }
+  return false;
+}
+
+}  // namespace webrtc
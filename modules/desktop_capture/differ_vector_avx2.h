@@ -0,0 +1,36 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// This header file is used only by differ_block.cc. It defines the AVX2
+// routines for finding vector and block difference.
+
+#ifndef WEBRTC_MODULES_DESKTOP_CAPTURE_DIFFER_VECTOR_AVX2_H_
+#define WEBRTC_MODULES_DESKTOP_CAPTURE_DIFFER_VECTOR_AVX2_H_
+
+#include <stdint.h>
+
+namespace webrtc {
+
+// Find vector difference of dimension 16.
+bool VectorDifference_AVX2_W16(const uint8_t* image1, const uint8_t* image2);
+
+// Find vector difference of dimension 32.
+bool VectorDifference_AVX2_W32(const uint8_t* image1, const uint8_t* image2);
+
+// Find block difference of dimension 32x|height|, returning as soon as a row
+// differs.
+bool BlockDifference_AVX2_W32(const uint8_t* image1,
+                              const uint8_t* image2,
+                              int height,
+                              int stride);
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_DESKTOP_CAPTURE_DIFFER_VECTOR_AVX2_H_
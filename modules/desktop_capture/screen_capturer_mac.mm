@@ -36,6 +36,7 @@
 #include "webrtc/modules/desktop_capture/screen_capture_frame_queue.h"
 #include "webrtc/modules/desktop_capture/screen_capturer_helper.h"
 #include "webrtc/modules/desktop_capture/shared_desktop_frame.h"
+#include "webrtc/modules/desktop_capture/shared_memory.h"
 #include "webrtc/system_wrappers/include/logging.h"
 
 // Once Chrome no longer supports OSX 10.8, everything within this
@@ -283,6 +284,8 @@ class ScreenCapturerMac : public DesktopCapturer {
 
   // DesktopCapturer interface.
   void Start(Callback* callback) override;
+  void SetSharedMemoryFactory(
+      std::unique_ptr<SharedMemoryFactory> shared_memory_factory) override;
   void CaptureFrame() override;
   void SetExcludedWindow(WindowId window) override;
   bool GetSourceList(SourceList* screens) override;
@@ -307,6 +310,7 @@ class ScreenCapturerMac : public DesktopCapturer {
   void ScreenRefresh(CGRectCount count, const CGRect *rect_array);
   void ReleaseBuffers();
 
+  // Returns nullptr if the frame buffer can't be allocated.
   std::unique_ptr<DesktopFrame> CreateFrame();
 
   Callback* callback_ = nullptr;
@@ -317,6 +321,10 @@ class ScreenCapturerMac : public DesktopCapturer {
   // Queue of the frames buffers.
   ScreenCaptureFrameQueue<SharedDesktopFrame> queue_;
 
+  // Frames are allocated from |shared_memory_factory_| if it is set, so they
+  // can be passed to another process without copying.
+  std::unique_ptr<SharedMemoryFactory> shared_memory_factory_;
+
   // Current display configuration.
   MacDesktopConfiguration desktop_config_;
 
@@ -424,6 +432,11 @@ void ScreenCapturerMac::Start(Callback* callback) {
   callback_ = callback;
 }
 
+void ScreenCapturerMac::SetSharedMemoryFactory(
+    std::unique_ptr<SharedMemoryFactory> shared_memory_factory) {
+  shared_memory_factory_ = std::move(shared_memory_factory);
+}
+
 void ScreenCapturerMac::CaptureFrame() {
   int64_t capture_start_time_nanos = rtc::TimeNanos();
 
@@ -449,8 +462,16 @@ void ScreenCapturerMac::CaptureFrame() {
   // If the current buffer is from an older generation then allocate a new one.
   // Note that we can't reallocate other buffers at this point, since the caller
   // may still be reading from them.
-  if (!queue_.current_frame())
-    queue_.ReplaceCurrentFrame(SharedDesktopFrame::Wrap(CreateFrame()));
+  if (!queue_.current_frame()) {
+    std::unique_ptr<DesktopFrame> frame = CreateFrame();
+    if (!frame) {
+      LOG(LS_ERROR) << "Failed to allocate a new DesktopFrame.";
+      desktop_config_monitor_->Unlock();
+      callback_->OnCaptureResult(Result::ERROR_PERMANENT, nullptr);
+      return;
+    }
+    queue_.ReplaceCurrentFrame(SharedDesktopFrame::Wrap(std::move(frame)));
+  }
 
   DesktopFrame* current_frame = queue_.current_frame();
 
@@ -1002,8 +1023,15 @@ void ScreenCapturerMac::ScreenRefresh(CGRectCount count,
 }
 
 std::unique_ptr<DesktopFrame> ScreenCapturerMac::CreateFrame() {
-  std::unique_ptr<DesktopFrame> frame(
-      new BasicDesktopFrame(screen_pixel_bounds_.size()));
+  std::unique_ptr<DesktopFrame> frame;
+  if (shared_memory_factory_) {
+    frame = SharedMemoryDesktopFrame::Create(screen_pixel_bounds_.size(),
+                                             shared_memory_factory_.get());
+    if (!frame)
+      return nullptr;
+  } else {
+    frame.reset(new BasicDesktopFrame(screen_pixel_bounds_.size()));
+  }
   frame->set_dpi(DesktopVector(kStandardDPI * dip_to_pixel_scale_,
                                kStandardDPI * dip_to_pixel_scale_));
   return frame;
@@ -139,8 +139,6 @@ TEST_F(ScreenCapturerTest, Capture) {
   EXPECT_TRUE(it.IsAtEnd());
 }
 
-#if defined(WEBRTC_WIN)
-
 TEST_F(ScreenCapturerTest, UseSharedBuffers) {
   std::unique_ptr<DesktopFrame> frame;
   EXPECT_CALL(callback_,
@@ -157,6 +155,8 @@ TEST_F(ScreenCapturerTest, UseSharedBuffers) {
   EXPECT_EQ(frame->shared_memory()->id(), kTestSharedMemoryId);
 }
 
+#if defined(WEBRTC_WIN)
+
 TEST_F(ScreenCapturerTest, UseMagnifier) {
   CreateMagnifierCapturer();
   std::unique_ptr<DesktopFrame> frame;
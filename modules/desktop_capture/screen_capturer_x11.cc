@@ -28,6 +28,7 @@
 #include "webrtc/modules/desktop_capture/screen_capture_frame_queue.h"
 #include "webrtc/modules/desktop_capture/screen_capturer_helper.h"
 #include "webrtc/modules/desktop_capture/shared_desktop_frame.h"
+#include "webrtc/modules/desktop_capture/shared_memory.h"
 #include "webrtc/modules/desktop_capture/x11/x_server_pixel_buffer.h"
 #include "webrtc/system_wrappers/include/logging.h"
 
@@ -52,6 +53,8 @@ class ScreenCapturerLinux : public DesktopCapturer,
 
   // DesktopCapturer interface.
   void Start(Callback* delegate) override;
+  void SetSharedMemoryFactory(
+      std::unique_ptr<SharedMemoryFactory> shared_memory_factory) override;
   void CaptureFrame() override;
   bool GetSourceList(SourceList* sources) override;
   bool SelectSource(SourceId id) override;
@@ -113,6 +116,10 @@ class ScreenCapturerLinux : public DesktopCapturer,
   // Queue of the frames buffers.
   ScreenCaptureFrameQueue<SharedDesktopFrame> queue_;
 
+  // Frames are allocated from |shared_memory_factory_| if it is set, so they
+  // can be passed to another process without copying.
+  std::unique_ptr<SharedMemoryFactory> shared_memory_factory_;
+
   // Invalid region from the previous capture. This is used to synchronize the
   // current with the last buffer used.
   DesktopRegion last_invalid_region_;
@@ -224,6 +231,11 @@ void ScreenCapturerLinux::Start(Callback* callback) {
   callback_ = callback;
 }
 
+void ScreenCapturerLinux::SetSharedMemoryFactory(
+    std::unique_ptr<SharedMemoryFactory> shared_memory_factory) {
+  shared_memory_factory_ = std::move(shared_memory_factory);
+}
+
 void ScreenCapturerLinux::CaptureFrame() {
   int64_t capture_start_time_nanos = rtc::TimeNanos();
 
@@ -246,9 +258,20 @@ void ScreenCapturerLinux::CaptureFrame() {
   // Note that we can't reallocate other buffers at this point, since the caller
   // may still be reading from them.
   if (!queue_.current_frame()) {
-    queue_.ReplaceCurrentFrame(
-        SharedDesktopFrame::Wrap(std::unique_ptr<DesktopFrame>(
-            new BasicDesktopFrame(x_server_pixel_buffer_.window_size()))));
+    std::unique_ptr<DesktopFrame> new_frame;
+    if (shared_memory_factory_) {
+      new_frame = SharedMemoryDesktopFrame::Create(
+          x_server_pixel_buffer_.window_size(), shared_memory_factory_.get());
+    } else {
+      new_frame.reset(
+          new BasicDesktopFrame(x_server_pixel_buffer_.window_size()));
+    }
+    if (!new_frame) {
+      LOG(LS_ERROR) << "Failed to allocate a new DesktopFrame.";
+      callback_->OnCaptureResult(Result::ERROR_PERMANENT, nullptr);
+      return;
+    }
+    queue_.ReplaceCurrentFrame(SharedDesktopFrame::Wrap(std::move(new_frame)));
   }
 
   std::unique_ptr<DesktopFrame> result = CaptureScreen();
@@ -182,7 +182,14 @@ bool DxgiOutputDuplicator::Duplicate(Context* context,
       frame_info.AccumulatedFrames > 0 &&
       resource) {
     DetectUpdatedRegion(frame_info, offset, &context->updated_region);
-    if (!texture_->CopyFrom(frame_info, resource.Get())) {
+    DesktopRegion texture_region;
+    for (DesktopRegion::Iterator it(context->updated_region); !it.IsAtEnd();
+         it.Advance()) {
+      texture_region.AddRect(
+          RotateRect(ReverseTranslate(it.rect(), offset),
+                     desktop_rect().size(), ReverseRotation(rotation_)));
+    }
+    if (!texture_->CopyFrom(frame_info, resource.Get(), texture_region)) {
       return false;
     }
     SpreadContextChange(context);
@@ -32,9 +32,12 @@ class DxgiTexture {
   virtual ~DxgiTexture();
 
   // Copies selected regions of a frame represented by frame_info and resource.
+  // |updated_region| is the part of the texture changed since the previous
+  // CopyFrom() call, implementations may copy only this part.
   // Returns false if anything wrong.
   virtual bool CopyFrom(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-                        IDXGIResource* resource) = 0;
+                        IDXGIResource* resource,
+                        const DesktopRegion& updated_region) = 0;
 
   const DesktopSize& desktop_size() const { return desktop_size_; }
 
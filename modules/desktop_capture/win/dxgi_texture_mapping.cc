@@ -28,7 +28,8 @@ DxgiTextureMapping::DxgiTextureMapping(const DesktopSize& desktop_size,
 DxgiTextureMapping::~DxgiTextureMapping() = default;
 
 bool DxgiTextureMapping::CopyFrom(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-                                  IDXGIResource* resource) {
+                                  IDXGIResource* resource,
+                                  const DesktopRegion& updated_region) {
   RTC_DCHECK(resource && frame_info.AccumulatedFrames > 0);
   rect_ = {0};
   _com_error error = duplication_->MapDesktopSurface(&rect_);
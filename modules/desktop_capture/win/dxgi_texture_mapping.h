@@ -34,7 +34,8 @@ class DxgiTextureMapping : public DxgiTexture {
   ~DxgiTextureMapping() override;
 
   bool CopyFrom(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-                IDXGIResource* resource) override;
+                IDXGIResource* resource,
+                const DesktopRegion& updated_region) override;
 
   bool DoRelease() override;
 
@@ -16,6 +16,7 @@
 #include <DXGI1_2.h>
 
 #include "webrtc/base/checks.h"
+#include "webrtc/modules/desktop_capture/desktop_region.h"
 #include "webrtc/system_wrappers/include/logging.h"
 
 using Microsoft::WRL::ComPtr;
@@ -61,6 +62,7 @@ bool DxgiTextureStaging::InitializeStage(ID3D11Texture2D* texture) {
   } else {
     RTC_DCHECK(!surface_);
   }
+  stage_is_stale_ = true;
 
   _com_error error = device_.d3d_device()->CreateTexture2D(
       &desc, nullptr, stage_.GetAddressOf());
@@ -91,7 +93,8 @@ void DxgiTextureStaging::AssertStageAndSurfaceAreSameObject() {
 }
 
 bool DxgiTextureStaging::CopyFrom(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-                                  IDXGIResource* resource) {
+                                  IDXGIResource* resource,
+                                  const DesktopRegion& updated_region) {
   RTC_DCHECK(resource && frame_info.AccumulatedFrames > 0);
   ComPtr<ID3D11Texture2D> texture;
   _com_error error = resource->QueryInterface(
@@ -110,18 +113,39 @@ bool DxgiTextureStaging::CopyFrom(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
     return false;
   }
 
-  device_.context()->CopyResource(static_cast<ID3D11Resource*>(stage_.Get()),
-                                  static_cast<ID3D11Resource*>(texture.Get()));
+  // stage_ keeps its content between frames, so only the updated region needs
+  // to be read back from the GPU, which is usually a small part of the screen.
+  if (stage_is_stale_) {
+    device_.context()->CopyResource(
+        static_cast<ID3D11Resource*>(stage_.Get()),
+        static_cast<ID3D11Resource*>(texture.Get()));
+  } else {
+    for (DesktopRegion::Iterator it(updated_region); !it.IsAtEnd();
+         it.Advance()) {
+      const DesktopRect& rect = it.rect();
+      D3D11_BOX box = {static_cast<UINT>(rect.left()),
+                       static_cast<UINT>(rect.top()),
+                       0,
+                       static_cast<UINT>(rect.right()),
+                       static_cast<UINT>(rect.bottom()),
+                       1};
+      device_.context()->CopySubresourceRegion(
+          static_cast<ID3D11Resource*>(stage_.Get()), 0, rect.left(),
+          rect.top(), 0, static_cast<ID3D11Resource*>(texture.Get()), 0, &box);
+    }
+  }
 
   rect_ = {0};
   error = surface_->Map(&rect_, DXGI_MAP_READ);
   if (error.Error() != S_OK) {
     rect_ = {0};
+    stage_is_stale_ = true;
     LOG(LS_ERROR) << "Failed to map the IDXGISurface to a bitmap, error "
                   << error.ErrorMessage() << ", code " << error.Error();
     return false;
   }
 
+  stage_is_stale_ = false;
   return true;
 }
 
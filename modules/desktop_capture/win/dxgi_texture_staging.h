@@ -40,7 +40,8 @@ class DxgiTextureStaging : public DxgiTexture {
   // Copies selected regions of a frame represented by frame_info and resource.
   // Returns false if anything wrong.
   bool CopyFrom(const DXGI_OUTDUPL_FRAME_INFO& frame_info,
-                IDXGIResource* resource) override;
+                IDXGIResource* resource,
+                const DesktopRegion& updated_region) override;
 
   bool DoRelease() override;
 
@@ -60,6 +61,9 @@ class DxgiTextureStaging : public DxgiTexture {
   const D3dDevice device_;
   Microsoft::WRL::ComPtr<ID3D11Texture2D> stage_;
   Microsoft::WRL::ComPtr<IDXGISurface> surface_;
+  // Set when stage_ doesn't hold the latest content of the whole texture, so
+  // the next CopyFrom() can't copy only the updated region.
+  bool stage_is_stale_ = true;
 };
 
 }  // namespace webrtc
@@ -11,9 +11,10 @@
 #include "webrtc/modules/pacing/paced_sender.h"
 
 #include <algorithm>
-#include <map>
+#include <deque>
+#include <limits>
 #include <queue>
-#include <set>
+#include <utility>
 #include <vector>
 
 #include "webrtc/base/checks.h"
@@ -33,6 +34,14 @@ const int64_t kMinPacketLimitMs = 5;
 // time.
 const int64_t kMaxIntervalTimeMs = 30;
 
+// Initial capacity of the set of queued packet ids, must be a power of two.
+const size_t kMinPacketIdSetCapacity = 64;
+const uint64_t kEmptyPacketId = 0;
+
+// How long the sender has to stay application limited before padding is
+// suppressed, so short pauses in the media do not toggle padding.
+const int64_t kAlrPaddingSuppressionDelayMs = 2000;
+
 }  // namespace
 
 // TODO(sprang): Move at least PacketQueue and MediaBudget out to separate
@@ -56,7 +65,8 @@ struct Packet {
         enqueue_time_ms(enqueue_time_ms),
         bytes(length_in_bytes),
         retransmission(retransmission),
-        enqueue_order(enqueue_order) {}
+        enqueue_order(enqueue_order),
+        slot(0) {}
 
   RtpPacketSender::Priority priority;
   uint32_t ssrc;
@@ -66,7 +76,7 @@ struct Packet {
   size_t bytes;
   bool retransmission;
   uint64_t enqueue_order;
-  std::list<Packet>::iterator this_it;
+  size_t slot;  // Index of the packet in PacketQueue storage.
 };
 
 // Used by priority queue to sort packets.
@@ -88,29 +98,116 @@ struct Comparator {
   }
 };
 
+// Set of the ssrc/seqno identifiers of the queued packets, for checking
+// duplicates. Open addressing with linear probing in a single array, so
+// adding and removing packets does not allocate once the set has grown to
+// the largest queue seen.
+class PacketIdSet {
+ public:
+  PacketIdSet() : size_(0), ids_(kMinPacketIdSetCapacity, kEmptyPacketId) {}
+
+  // Returns false if the id is already in the set.
+  bool Insert(uint32_t ssrc, uint16_t sequence_number) {
+    const uint64_t id = Id(ssrc, sequence_number);
+    size_t index = Bucket(id);
+    while (ids_[index] != kEmptyPacketId) {
+      if (ids_[index] == id)
+        return false;
+      index = (index + 1) & (ids_.size() - 1);
+    }
+    ids_[index] = id;
+    // Keep the load factor at or below one half.
+    if (++size_ * 2 > ids_.size())
+      Grow();
+    return true;
+  }
+
+  void Erase(uint32_t ssrc, uint16_t sequence_number) {
+    const uint64_t id = Id(ssrc, sequence_number);
+    const size_t mask = ids_.size() - 1;
+    size_t hole = Bucket(id);
+    while (ids_[hole] != id) {
+      RTC_DCHECK_NE(kEmptyPacketId, ids_[hole]);
+      hole = (hole + 1) & mask;
+    }
+    ids_[hole] = kEmptyPacketId;
+    --size_;
+    // Move back the following ids that can not be found past the hole.
+    for (size_t index = (hole + 1) & mask; ids_[index] != kEmptyPacketId;
+         index = (index + 1) & mask) {
+      size_t distance = (index - Bucket(ids_[index])) & mask;
+      if (distance >= ((index - hole) & mask)) {
+        ids_[hole] = ids_[index];
+        ids_[index] = kEmptyPacketId;
+        hole = index;
+      }
+    }
+  }
+
+ private:
+  static uint64_t Id(uint32_t ssrc, uint16_t sequence_number) {
+    // Offset by one so that no id is kEmptyPacketId.
+    return ((static_cast<uint64_t>(ssrc) << 16) | sequence_number) + 1;
+  }
+
+  size_t Bucket(uint64_t id) const {
+    // Fibonacci hashing, the sequence numbers of a stream are consecutive.
+    return static_cast<size_t>((id * 0x9E3779B97F4A7C15ull) >> 32) &
+           (ids_.size() - 1);
+  }
+
+  void Grow() {
+    std::vector<uint64_t> ids(ids_.size() * 2, kEmptyPacketId);
+    ids.swap(ids_);
+    for (uint64_t id : ids) {
+      if (id == kEmptyPacketId)
+        continue;
+      size_t index = Bucket(id);
+      while (ids_[index] != kEmptyPacketId)
+        index = (index + 1) & (ids_.size() - 1);
+      ids_[index] = id;
+    }
+  }
+
+  size_t size_;
+  std::vector<uint64_t> ids_;
+};
+
 // Class encapsulating a priority queue with some extensions.
 class PacketQueue {
  public:
   explicit PacketQueue(Clock* clock)
-      : bytes_(0),
+      : num_packets_(0),
+        bytes_(0),
         clock_(clock),
         queue_time_sum_(0),
         time_last_updated_(clock_->TimeInMilliseconds()) {}
   virtual ~PacketQueue() {}
 
   void Push(const Packet& packet) {
-    if (!AddToDupeSet(packet))
+    if (!packet_ids_.Insert(packet.ssrc, packet.sequence_number))
       return;
 
     UpdateQueueTime(packet.enqueue_time_ms);
 
-    // Store packet in list, use pointers in priority queue for cheaper moves.
-    // Packets have a handle to its own iterator in the list, for easy removal
-    // when popping from queue.
-    packet_list_.push_front(packet);
-    std::list<Packet>::iterator it = packet_list_.begin();
-    it->this_it = it;          // Handle for direct removal from list.
-    prio_queue_.push(&(*it));  // Pointer into list.
+    // Store the packet in a free slot, or append one. std::deque does not
+    // move the elements when growing at the end, so pointers to the packets
+    // stay valid while the lock is released to send one of them.
+    Packet* stored;
+    if (free_slots_.empty()) {
+      storage_.push_back(packet);
+      stored = &storage_.back();
+      stored->slot = storage_.size() - 1;
+    } else {
+      size_t slot = free_slots_.back();
+      free_slots_.pop_back();
+      stored = &storage_[slot];
+      *stored = packet;
+      stored->slot = slot;
+    }
+    prio_queue_.push(stored);
+    enqueue_fifo_.push_back(std::make_pair(packet.enqueue_order, stored));
+    ++num_packets_;
     bytes_ += packet.bytes;
   }
 
@@ -120,16 +217,32 @@ class PacketQueue {
     return packet;
   }
 
-  void CancelPop(const Packet& packet) { prio_queue_.push(&(*packet.this_it)); }
+  void CancelPop(const Packet& packet) {
+    prio_queue_.push(&storage_[packet.slot]);
+  }
 
   void FinalizePop(const Packet& packet) {
-    RemoveFromDupeSet(packet);
+    packet_ids_.Erase(packet.ssrc, packet.sequence_number);
     bytes_ -= packet.bytes;
     queue_time_sum_ -= (time_last_updated_ - packet.enqueue_time_ms);
-    packet_list_.erase(packet.this_it);
-    RTC_DCHECK_EQ(packet_list_.size(), prio_queue_.size());
-    if (packet_list_.empty())
+    --num_packets_;
+    Packet* stored = &storage_[packet.slot];
+    // No valid enqueue order is this high, marks the slot as free in
+    // |enqueue_fifo_|.
+    stored->enqueue_order = std::numeric_limits<uint64_t>::max();
+    free_slots_.push_back(stored->slot);
+    // Drop the entries of the packets already sent from the front, the
+    // others are dropped once they get there.
+    while (!enqueue_fifo_.empty() &&
+           enqueue_fifo_.front().first !=
+               enqueue_fifo_.front().second->enqueue_order) {
+      enqueue_fifo_.pop_front();
+    }
+    RTC_DCHECK_EQ(num_packets_, prio_queue_.size());
+    if (num_packets_ == 0) {
       RTC_DCHECK_EQ(0, queue_time_sum_);
+      RTC_DCHECK(enqueue_fifo_.empty());
+    }
   }
 
   bool Empty() const { return prio_queue_.empty(); }
@@ -139,63 +252,45 @@ class PacketQueue {
   uint64_t SizeInBytes() const { return bytes_; }
 
   int64_t OldestEnqueueTimeMs() const {
-    auto it = packet_list_.rbegin();
-    if (it == packet_list_.rend())
+    if (enqueue_fifo_.empty())
       return 0;
-    return it->enqueue_time_ms;
+    return enqueue_fifo_.front().second->enqueue_time_ms;
   }
 
   void UpdateQueueTime(int64_t timestamp_ms) {
     RTC_DCHECK_GE(timestamp_ms, time_last_updated_);
     int64_t delta = timestamp_ms - time_last_updated_;
-    // Use packet packet_list_.size() not prio_queue_.size() here, as there
-    // might be an outstanding element popped from prio_queue_ currently in the
-    // SendPacket() call, while packet_list_ will always be correct.
-    queue_time_sum_ += delta * packet_list_.size();
+    // Use num_packets_ not prio_queue_.size() here, as there might be an
+    // outstanding element popped from prio_queue_ currently in the
+    // SendPacket() call, while num_packets_ will always be correct.
+    queue_time_sum_ += delta * num_packets_;
     time_last_updated_ = timestamp_ms;
   }
 
   int64_t AverageQueueTimeMs() const {
     if (prio_queue_.empty())
       return 0;
-    return queue_time_sum_ / packet_list_.size();
+    return queue_time_sum_ / num_packets_;
   }
 
  private:
-  // Try to add a packet to the set of ssrc/seqno identifiers currently in the
-  // queue. Return true if inserted, false if this is a duplicate.
-  bool AddToDupeSet(const Packet& packet) {
-    SsrcSeqNoMap::iterator it = dupe_map_.find(packet.ssrc);
-    if (it == dupe_map_.end()) {
-      // First for this ssrc, just insert.
-      dupe_map_[packet.ssrc].insert(packet.sequence_number);
-      return true;
-    }
-
-    // Insert returns a pair, where second is a bool set to true if new element.
-    return it->second.insert(packet.sequence_number).second;
-  }
-
-  void RemoveFromDupeSet(const Packet& packet) {
-    SsrcSeqNoMap::iterator it = dupe_map_.find(packet.ssrc);
-    RTC_DCHECK(it != dupe_map_.end());
-    it->second.erase(packet.sequence_number);
-    if (it->second.empty()) {
-      dupe_map_.erase(it);
-    }
-  }
-
-  // List of packets, in the order the were enqueued. Since dequeueing may
-  // occur out of order, use list instead of vector.
-  std::list<Packet> packet_list_;
+  // Storage for the packets, slots of the sent ones are listed in
+  // |free_slots_| and reused, so that keyframes and retransmission bursts do
+  // not allocate per packet once the storage has grown.
+  std::deque<Packet> storage_;
+  std::vector<size_t> free_slots_;
   // Priority queue of the packets, sorted according to Comparator.
-  // Use pointers into list, to avoid moving whole struct within heap.
+  // Use pointers into storage, to avoid moving whole struct within heap.
   std::priority_queue<Packet*, std::vector<Packet*>, Comparator> prio_queue_;
+  // Enqueue order and packet, in the order they were enqueued. Entries of
+  // sent packets are left in place until they reach the front, they are told
+  // apart by the enqueue order no longer matching the stored packet.
+  std::deque<std::pair<uint64_t, Packet*>> enqueue_fifo_;
+  // Packets stored, including one popped but not finalized.
+  size_t num_packets_;
   // Total number of bytes in the queue.
   uint64_t bytes_;
-  // Map<ssrc, set<seq_no> >, for checking duplicates.
-  typedef std::map<uint32_t, std::set<uint16_t> > SsrcSeqNoMap;
-  SsrcSeqNoMap dupe_map_;
+  PacketIdSet packet_ids_;
   Clock* const clock_;
   int64_t queue_time_sum_;
   int64_t time_last_updated_;
@@ -235,6 +330,13 @@ class IntervalBudget {
 
   int target_rate_kbps() const { return target_rate_kbps_; }
 
+  // Time until the budget allows sending again after being overused.
+  int64_t TimeUntilAvailableMs() const {
+    if (bytes_remaining_ >= 0 || target_rate_kbps_ <= 0)
+      return 0;
+    return -8 * static_cast<int64_t>(bytes_remaining_) / target_rate_kbps_ + 1;
+  }
+
  private:
   static const int kWindowMs = 500;
 
@@ -245,10 +347,17 @@ class IntervalBudget {
 
 const int64_t PacedSender::kMaxQueueLengthMs = 2000;
 const float PacedSender::kDefaultPaceMultiplier = 2.5f;
+const int64_t PacedSender::kHighResolutionProcessIntervalMs = 1;
 
 PacedSender::PacedSender(Clock* clock, PacketSender* packet_sender)
+    : PacedSender(clock, packet_sender, false) {}
+
+PacedSender::PacedSender(Clock* clock,
+                         PacketSender* packet_sender,
+                         bool high_resolution)
     : clock_(clock),
       packet_sender_(packet_sender),
+      high_resolution_(high_resolution),
       alr_detector_(new AlrDetector()),
       critsect_(CriticalSectionWrapper::CreateCriticalSection()),
       paused_(false),
@@ -259,6 +368,8 @@ PacedSender::PacedSender(Clock* clock, PacketSender* packet_sender)
       min_send_bitrate_kbps_(0u),
       max_padding_bitrate_kbps_(0u),
       pacing_bitrate_kbps_(0),
+      alr_padding_suppression_(false),
+      alr_suppressed_padding_bytes_(0),
       time_last_update_us_(clock->TimeInMicroseconds()),
       packets_(new paced_sender::PacketQueue(clock)),
       packet_counter_(0) {
@@ -290,6 +401,18 @@ void PacedSender::SetProbingEnabled(bool enabled) {
   prober_->SetEnabled(enabled);
 }
 
+void PacedSender::EnableAlrPaddingSuppression(bool enable) {
+  LOG(LS_INFO) << "Padding suppression in ALR "
+               << (enable ? "enabled" : "disabled");
+  CriticalSectionScoped cs(critsect_.get());
+  alr_padding_suppression_ = enable;
+}
+
+uint64_t PacedSender::AlrSuppressedPaddingBytes() const {
+  CriticalSectionScoped cs(critsect_.get());
+  return alr_suppressed_padding_bytes_;
+}
+
 void PacedSender::SetEstimatedBitrate(uint32_t bitrate_bps) {
   if (bitrate_bps == 0)
     LOG(LS_ERROR) << "PacedSender is not designed to handle 0 bitrate.";
@@ -336,6 +459,24 @@ void PacedSender::InsertPacket(RtpPacketSender::Priority priority,
                                       retransmission, packet_counter_++));
 }
 
+void PacedSender::InsertPackets(RtpPacketSender::Priority priority,
+                                const std::vector<PacketToInsert>& packets,
+                                bool retransmission) {
+  CriticalSectionScoped cs(critsect_.get());
+  RTC_DCHECK(estimated_bitrate_bps_ > 0)
+        << "SetEstimatedBitrate must be called before InsertPackets.";
+
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  for (const PacketToInsert& packet : packets) {
+    prober_->OnIncomingPacket(packet.bytes);
+    int64_t capture_time_ms =
+        packet.capture_time_ms < 0 ? now_ms : packet.capture_time_ms;
+    packets_->Push(paced_sender::Packet(
+        priority, packet.ssrc, packet.sequence_number, capture_time_ms, now_ms,
+        packet.bytes, retransmission, packet_counter_++));
+  }
+}
+
 int64_t PacedSender::ExpectedQueueTimeMs() const {
   CriticalSectionScoped cs(critsect_.get());
   RTC_DCHECK_GT(pacing_bitrate_kbps_, 0);
@@ -379,6 +520,15 @@ int64_t PacedSender::TimeUntilNextProcess() {
   }
   int64_t elapsed_time_us = clock_->TimeInMicroseconds() - time_last_update_us_;
   int64_t elapsed_time_ms = (elapsed_time_us + 500) / 1000;
+  if (high_resolution_ && !paused_ && !packets_->Empty()) {
+    // Wake up when the budget allows sending the next packet, but no later
+    // than the normal interval so that audio is not delayed.
+    int64_t interval_ms =
+        std::min(kMinPacketLimitMs,
+                 std::max(kHighResolutionProcessIntervalMs,
+                          media_budget_->TimeUntilAvailableMs()));
+    return std::max<int64_t>(interval_ms - elapsed_time_ms, 0);
+  }
   return std::max<int64_t>(kMinPacketLimitMs - elapsed_time_ms, 0);
 }
 
@@ -386,7 +536,14 @@ void PacedSender::Process() {
   int64_t now_us = clock_->TimeInMicroseconds();
   CriticalSectionScoped cs(critsect_.get());
   int64_t elapsed_time_ms = (now_us - time_last_update_us_ + 500) / 1000;
-  time_last_update_us_ = now_us;
+  if (high_resolution_ && elapsed_time_ms <= kMaxIntervalTimeMs) {
+    // Rounding would lose or add up to half of each 1 ms interval, only
+    // account for whole milliseconds and carry the rest over.
+    elapsed_time_ms = (now_us - time_last_update_us_) / 1000;
+    time_last_update_us_ += elapsed_time_ms * 1000;
+  } else {
+    time_last_update_us_ = now_us;
+  }
   int target_bitrate_kbps = pacing_bitrate_kbps_;
   // TODO(holmer): Remove the !paused_ check when issue 5307 has been fixed.
   if (!paused_ && elapsed_time_ms > 0) {
@@ -395,7 +552,7 @@ void PacedSender::Process() {
       // Assuming equal size packets and input/output rate, the average packet
       // has avg_time_left_ms left to get queue_size_bytes out of the queue, if
       // time constraint shall be met. Determine bitrate needed for that.
-      packets_->UpdateQueueTime(clock_->TimeInMilliseconds());
+      packets_->UpdateQueueTime(now_us / 1000);
       int64_t avg_time_left_ms = std::max<int64_t>(
           1, kMaxQueueLengthMs - packets_->AverageQueueTimeMs());
       int min_bitrate_needed_kbps =
@@ -446,8 +603,15 @@ void PacedSender::Process() {
           static_cast<int>(is_probing ? (recommended_probe_size - bytes_sent)
                                       : padding_budget_->bytes_remaining());
 
-      if (padding_needed > 0)
+      if (padding_needed > 0 && !is_probing &&
+          IsPaddingSuppressed(now_us / 1000)) {
+        // Account for the padding as if it was sent, so the budget does not
+        // pile up while suppressed.
+        alr_suppressed_padding_bytes_ += padding_needed;
+        padding_budget_->UseBudget(padding_needed);
+      } else if (padding_needed > 0) {
         bytes_sent += SendPadding(padding_needed, probe_cluster_id);
+      }
     }
   }
   if (is_probing && bytes_sent > 0)
@@ -498,6 +662,15 @@ size_t PacedSender::SendPadding(size_t padding_needed, int probe_cluster_id) {
   return bytes_sent;
 }
 
+bool PacedSender::IsPaddingSuppressed(int64_t now_ms) const {
+  if (!alr_padding_suppression_)
+    return false;
+  rtc::Optional<int64_t> alr_start_time_ms =
+      alr_detector_->GetApplicationLimitedRegionStartTime();
+  return alr_start_time_ms &&
+         now_ms - *alr_start_time_ms >= kAlrPaddingSuppressionDelayMs;
+}
+
 void PacedSender::UpdateBudgetWithElapsedTime(int64_t delta_time_ms) {
   media_budget_->IncreaseBudget(delta_time_ms);
   padding_budget_->IncreaseBudget(delta_time_ms);
@@ -14,6 +14,7 @@
 #include <list>
 #include <memory>
 #include <set>
+#include <vector>
 
 #include "webrtc/base/optional.h"
 #include "webrtc/base/thread_annotations.h"
@@ -69,7 +70,16 @@ class PacedSender : public Module, public RtpPacketSender {
 
   static const size_t kMinProbePacketSize = 200;
 
+  // Process interval of the high resolution mode.
+  static const int64_t kHighResolutionProcessIntervalMs;
+
   PacedSender(Clock* clock, PacketSender* packet_sender);
+  // In high resolution mode, the pacer wants Process to be called every
+  // kHighResolutionProcessIntervalMs while it has packets to send, or as soon
+  // as the budget allows the next one, so that it sends much smaller bursts
+  // than every 5 ms. Use a TaskQueuePacer to drive it, as ProcessThread wakes
+  // up too late for such short intervals.
+  PacedSender(Clock* clock, PacketSender* packet_sender, bool high_resolution);
 
   virtual ~PacedSender();
 
@@ -103,6 +113,14 @@ class PacedSender : public Module, public RtpPacketSender {
   void SetSendBitrateLimits(int min_send_bitrate_bps,
                             int max_padding_bitrate_bps);
 
+  // Stops sending padding, other than for probing, once the sender has been
+  // application limited for a while. The padding only keeps the estimate up
+  // for media that is not being sent, so periodic ALR probing should be used
+  // instead to validate the estimate.
+  void EnableAlrPaddingSuppression(bool enable);
+  // Padding bytes not sent because of EnableAlrPaddingSuppression.
+  uint64_t AlrSuppressedPaddingBytes() const;
+
   // Returns true if we send the packet now, else it will add the packet
   // information to the queue and call TimeToSendPacket when it's time to send.
   void InsertPacket(RtpPacketSender::Priority priority,
@@ -111,6 +129,9 @@ class PacedSender : public Module, public RtpPacketSender {
                     int64_t capture_time_ms,
                     size_t bytes,
                     bool retransmission) override;
+  void InsertPackets(RtpPacketSender::Priority priority,
+                     const std::vector<PacketToInsert>& packets,
+                     bool retransmission) override;
 
   // Returns the time since the oldest queued packet was enqueued.
   virtual int64_t QueueInMs() const;
@@ -119,7 +140,7 @@ class PacedSender : public Module, public RtpPacketSender {
 
   // Returns the number of milliseconds it will take to send the current
   // packets in the queue, given the current size and bitrate, ignoring prio.
-  virtual int64_t ExpectedQueueTimeMs() const;
+  int64_t ExpectedQueueTimeMs() const override;
 
   // Returns time in milliseconds when the current application-limited region
   // started or empty result if the sender is currently not application-limited.
@@ -151,9 +172,12 @@ class PacedSender : public Module, public RtpPacketSender {
       EXCLUSIVE_LOCKS_REQUIRED(critsect_);
   size_t SendPadding(size_t padding_needed, int probe_cluster_id)
       EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  bool IsPaddingSuppressed(int64_t now_ms) const
+      EXCLUSIVE_LOCKS_REQUIRED(critsect_);
 
   Clock* const clock_;
   PacketSender* const packet_sender_;
+  const bool high_resolution_;
   std::unique_ptr<AlrDetector> alr_detector_ GUARDED_BY(critsect_);
 
   std::unique_ptr<CriticalSectionWrapper> critsect_;
@@ -176,6 +200,9 @@ class PacedSender : public Module, public RtpPacketSender {
   uint32_t max_padding_bitrate_kbps_ GUARDED_BY(critsect_);
   uint32_t pacing_bitrate_kbps_ GUARDED_BY(critsect_);
 
+  bool alr_padding_suppression_ GUARDED_BY(critsect_);
+  uint64_t alr_suppressed_padding_bytes_ GUARDED_BY(critsect_);
+
   int64_t time_last_update_us_ GUARDED_BY(critsect_);
 
   std::unique_ptr<paced_sender::PacketQueue> packets_ GUARDED_BY(critsect_);
@@ -0,0 +1,92 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/pacing/paced_sender.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+constexpr int kNumFrames = 200;
+constexpr int kPacketsPerFrame = 2000;
+constexpr size_t kPacketSize = 1200;
+constexpr uint32_t kSsrc = 12345;
+constexpr uint32_t kRtxSsrc = 12346;
+
+class CountingPacketSender : public PacedSender::PacketSender {
+ public:
+  CountingPacketSender() : packets_sent_(0) {}
+
+  bool TimeToSendPacket(uint32_t ssrc,
+                        uint16_t sequence_number,
+                        int64_t capture_time_ms,
+                        bool retransmission,
+                        int probe_cluster_id) override {
+    ++packets_sent_;
+    return true;
+  }
+
+  size_t TimeToSendPadding(size_t bytes, int probe_cluster_id) override {
+    return 0;
+  }
+
+  int packets_sent() const { return packets_sent_; }
+
+ private:
+  int packets_sent_;
+};
+}  // namespace
+
+// Time to queue and send the packets of keyframes, with a tenth of them
+// retransmitted in the middle of the frame.
+TEST(PacedSenderPerformanceTest, EnqueueDequeue) {
+  SimulatedClock clock(123456);
+  CountingPacketSender packet_sender;
+  PacedSender pacer(&clock, &packet_sender);
+  pacer.SetProbingEnabled(false);
+  pacer.SetEstimatedBitrate(1000000000);
+  Clock* real_clock = Clock::GetRealTimeClock();
+
+  uint16_t sequence_number = 0;
+  uint16_t rtx_sequence_number = 0;
+  int64_t enqueue_time_us = 0;
+  int64_t dequeue_time_us = 0;
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    int64_t start_time_us = real_clock->TimeInMicroseconds();
+    for (int i = 0; i < kPacketsPerFrame; ++i) {
+      pacer.InsertPacket(PacedSender::kNormalPriority, kSsrc,
+                         sequence_number++, clock.TimeInMilliseconds(),
+                         kPacketSize, false);
+      if (i % 10 == 5) {
+        pacer.InsertPacket(PacedSender::kNormalPriority, kRtxSsrc,
+                           rtx_sequence_number++,
+                           clock.TimeInMilliseconds() - 100, kPacketSize,
+                           true);
+      }
+    }
+    int64_t enqueued_time_us = real_clock->TimeInMicroseconds();
+    enqueue_time_us += enqueued_time_us - start_time_us;
+    while (pacer.QueueSizePackets() > 0) {
+      clock.AdvanceTimeMilliseconds(5);
+      pacer.Process();
+    }
+    dequeue_time_us += real_clock->TimeInMicroseconds() - enqueued_time_us;
+  }
+  const int kNumPackets = kNumFrames * kPacketsPerFrame * 11 / 10;
+  EXPECT_EQ(kNumPackets, packet_sender.packets_sent());
+
+  test::PrintResult("pacer_enqueue", "", "keyframe",
+                    1000.0 * enqueue_time_us / kNumPackets, "ns", false);
+  test::PrintResult("pacer_dequeue", "", "keyframe",
+                    1000.0 * dequeue_time_us / kNumPackets, "ns", false);
+}
+
+}  // namespace webrtc
@@ -10,6 +10,7 @@
 
 #include <list>
 #include <memory>
+#include <vector>
 
 #include "webrtc/modules/pacing/paced_sender.h"
 #include "webrtc/system_wrappers/include/clock.h"
@@ -18,6 +19,7 @@
 
 using testing::_;
 using testing::Return;
+using testing::ReturnArg;
 
 namespace {
 constexpr unsigned kFirstClusterBps = 900000;
@@ -181,6 +183,27 @@ TEST_F(PacedSenderTest, QueuePacket) {
   EXPECT_EQ(1u, send_bucket_->QueueSizePackets());
 }
 
+TEST_F(PacedSenderTest, InsertPacketsQueuesInOrder) {
+  uint32_t ssrc = 12345;
+  uint16_t sequence_number = 1234;
+  int64_t capture_time_ms = clock_.TimeInMilliseconds();
+  std::vector<RtpPacketSender::PacketToInsert> packets;
+  for (uint16_t i = 0; i < 3; ++i)
+    packets.push_back({ssrc, static_cast<uint16_t>(sequence_number + i),
+                       capture_time_ms, 250});
+  send_bucket_->InsertPackets(PacedSender::kNormalPriority, packets, true);
+  EXPECT_EQ(packets.size(), send_bucket_->QueueSizePackets());
+
+  testing::InSequence in_sequence;
+  for (const RtpPacketSender::PacketToInsert& packet : packets) {
+    EXPECT_CALL(callback_, TimeToSendPacket(ssrc, packet.sequence_number,
+                                            capture_time_ms, true, _))
+        .WillOnce(Return(true));
+  }
+  send_bucket_->Process();
+  EXPECT_EQ(0u, send_bucket_->QueueSizePackets());
+}
+
 TEST_F(PacedSenderTest, PaceQueuedPackets) {
   uint32_t ssrc = 12345;
   uint16_t sequence_number = 1234;
@@ -400,6 +423,43 @@ TEST_F(PacedSenderTest, VerifyPaddingUpToBitrate) {
   }
 }
 
+TEST_F(PacedSenderTest, SuppressesPaddingInLongAlr) {
+  const uint32_t kPaddingBitrateBps = kTargetBitrateBps / 8;
+  const int kTimeStep = 5;
+  send_bucket_->SetSendBitrateLimits(0, kPaddingBitrateBps);
+  send_bucket_->EnableAlrPaddingSuppression(true);
+  SendAndExpectPacket(PacedSender::kNormalPriority, 12345, 1234,
+                      clock_.TimeInMilliseconds(), 250, false);
+  send_bucket_->Process();
+
+  // Only padding is sent, well below the estimate, so the sender is
+  // application limited. Padding goes on until that has lasted a while.
+  EXPECT_CALL(callback_, TimeToSendPadding(_, _))
+      .WillRepeatedly(ReturnArg<0>());
+  for (int64_t elapsed_ms = 0; elapsed_ms < 1000; elapsed_ms += kTimeStep) {
+    clock_.AdvanceTimeMilliseconds(kTimeStep);
+    send_bucket_->Process();
+  }
+  EXPECT_EQ(0u, send_bucket_->AlrSuppressedPaddingBytes());
+
+  for (int64_t elapsed_ms = 0; elapsed_ms < 1500; elapsed_ms += kTimeStep) {
+    clock_.AdvanceTimeMilliseconds(kTimeStep);
+    send_bucket_->Process();
+  }
+  testing::Mock::VerifyAndClearExpectations(&callback_);
+
+  // Then the padding budget is used up without sending anything.
+  EXPECT_CALL(callback_, TimeToSendPadding(_, _)).Times(0);
+  uint64_t suppressed_bytes = send_bucket_->AlrSuppressedPaddingBytes();
+  for (int64_t elapsed_ms = 0; elapsed_ms < 1000; elapsed_ms += kTimeStep) {
+    clock_.AdvanceTimeMilliseconds(kTimeStep);
+    send_bucket_->Process();
+  }
+  EXPECT_NEAR(kPaddingBitrateBps / 8,
+              send_bucket_->AlrSuppressedPaddingBytes() - suppressed_bytes,
+              kPaddingBitrateBps / 8 / 20);
+}
+
 TEST_F(PacedSenderTest, VerifyAverageBitrateVaryingMediaPayload) {
   uint32_t ssrc = 12345;
   uint16_t sequence_number = 1234;
@@ -1037,5 +1097,157 @@ TEST_F(PacedSenderTest, ProbeClusterId) {
   send_bucket_->Process();
 }
 
+TEST_F(PacedSenderTest, LargeQueueWithDuplicates) {
+  const uint32_t kSsrc = 12345;
+  const uint16_t kFirstSequenceNumber = 0xff00;
+  const size_t kNumPackets = 2000;
+  const size_t kPacketSize = 1200;
+  send_bucket_->SetEstimatedBitrate(100000000);
+
+  // A keyframe on two streams, with every packet inserted twice and the
+  // sequence numbers wrapping around.
+  for (int round = 0; round < 2; ++round) {
+    for (size_t i = 0; i < kNumPackets; ++i) {
+      uint16_t sequence_number = kFirstSequenceNumber + i;
+      for (uint32_t ssrc = kSsrc; ssrc < kSsrc + 2; ++ssrc) {
+        send_bucket_->InsertPacket(PacedSender::kNormalPriority, ssrc,
+                                   sequence_number,
+                                   clock_.TimeInMilliseconds(), kPacketSize,
+                                   false);
+      }
+    }
+  }
+  EXPECT_EQ(2 * kNumPackets, send_bucket_->QueueSizePackets());
+
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    uint16_t sequence_number = kFirstSequenceNumber + i;
+    EXPECT_CALL(callback_, TimeToSendPacket(kSsrc, sequence_number, _, _, _))
+        .WillOnce(Return(true));
+    EXPECT_CALL(callback_,
+                TimeToSendPacket(kSsrc + 1, sequence_number, _, _, _))
+        .WillOnce(Return(true));
+  }
+  while (send_bucket_->QueueSizePackets() > 0) {
+    clock_.AdvanceTimeMilliseconds(5);
+    send_bucket_->Process();
+  }
+  EXPECT_EQ(0, send_bucket_->QueueInMs());
+
+  // Sent packets no longer count as duplicates.
+  send_bucket_->InsertPacket(PacedSender::kNormalPriority, kSsrc,
+                             kFirstSequenceNumber, clock_.TimeInMilliseconds(),
+                             kPacketSize, false);
+  EXPECT_EQ(1u, send_bucket_->QueueSizePackets());
+}
+
+TEST_F(PacedSenderTest, QueueInMsAfterSendingNewerPacketFirst) {
+  const uint32_t kSsrc = 12345;
+  const uint16_t kSequenceNumber = 1234;
+  send_bucket_->Pause();
+
+  int64_t first_enqueue_time_ms = clock_.TimeInMilliseconds();
+  send_bucket_->InsertPacket(PacedSender::kLowPriority, kSsrc,
+                             kSequenceNumber, first_enqueue_time_ms, 250,
+                             false);
+  clock_.AdvanceTimeMilliseconds(100);
+  send_bucket_->InsertPacket(PacedSender::kHighPriority, kSsrc + 1,
+                             kSequenceNumber, clock_.TimeInMilliseconds(), 250,
+                             false);
+  clock_.AdvanceTimeMilliseconds(100);
+
+  // Audio is sent even while paused.
+  EXPECT_CALL(callback_, TimeToSendPacket(kSsrc + 1, kSequenceNumber, _, _, _))
+      .WillOnce(Return(true));
+  send_bucket_->Process();
+  EXPECT_EQ(1u, send_bucket_->QueueSizePackets());
+  EXPECT_EQ(clock_.TimeInMilliseconds() - first_enqueue_time_ms,
+            send_bucket_->QueueInMs());
+
+  send_bucket_->Resume();
+  EXPECT_CALL(callback_, TimeToSendPacket(kSsrc, kSequenceNumber, _, _, _))
+      .WillOnce(Return(true));
+  clock_.AdvanceTimeMilliseconds(5);
+  send_bucket_->Process();
+  EXPECT_EQ(0, send_bucket_->QueueInMs());
+}
+
+TEST_F(PacedSenderTest, HighResolutionSendsOnePacketPerMillisecond) {
+  const uint32_t kSsrc = 12345;
+  uint16_t sequence_number = 1234;
+  // 800 kbps * 2.5 allows 250 bytes per ms.
+  const size_t kPacketSize = 250;
+  send_bucket_.reset(new PacedSender(&clock_, &callback_, true));
+  send_bucket_->SetProbingEnabled(false);
+  send_bucket_->SetEstimatedBitrate(kTargetBitrateBps);
+  for (int i = 0; i < 10; ++i) {
+    send_bucket_->InsertPacket(PacedSender::kNormalPriority, kSsrc,
+                               sequence_number + i, clock_.TimeInMilliseconds(),
+                               kPacketSize, false);
+  }
+
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(1, send_bucket_->TimeUntilNextProcess());
+    clock_.AdvanceTimeMilliseconds(1);
+    EXPECT_CALL(callback_, TimeToSendPacket(kSsrc, sequence_number++, _, _, _))
+        .WillOnce(Return(true));
+    send_bucket_->Process();
+  }
+  EXPECT_EQ(0u, send_bucket_->QueueSizePackets());
+  // Back to the normal interval when there is nothing to send.
+  EXPECT_EQ(5, send_bucket_->TimeUntilNextProcess());
+}
+
+TEST_F(PacedSenderTest, HighResolutionWaitsUntilBudgetAllowsNextPacket) {
+  const uint32_t kSsrc = 12345;
+  const uint16_t kSequenceNumber = 1234;
+  const size_t kPacketSize = 1000;
+  send_bucket_.reset(new PacedSender(&clock_, &callback_, true));
+  send_bucket_->SetProbingEnabled(false);
+  send_bucket_->SetEstimatedBitrate(kTargetBitrateBps);
+  for (int i = 0; i < 2; ++i) {
+    send_bucket_->InsertPacket(PacedSender::kNormalPriority, kSsrc,
+                               kSequenceNumber + i, clock_.TimeInMilliseconds(),
+                               kPacketSize, false);
+  }
+
+  clock_.AdvanceTimeMilliseconds(1);
+  EXPECT_CALL(callback_, TimeToSendPacket(kSsrc, kSequenceNumber, _, _, _))
+      .WillOnce(Return(true));
+  send_bucket_->Process();
+  // 750 bytes overused at 250 bytes per ms.
+  EXPECT_EQ(4, send_bucket_->TimeUntilNextProcess());
+
+  clock_.AdvanceTimeMilliseconds(3);
+  send_bucket_->Process();
+  EXPECT_EQ(1, send_bucket_->TimeUntilNextProcess());
+  clock_.AdvanceTimeMilliseconds(1);
+  EXPECT_CALL(callback_, TimeToSendPacket(kSsrc, kSequenceNumber + 1, _, _, _))
+      .WillOnce(Return(true));
+  send_bucket_->Process();
+}
+
+TEST_F(PacedSenderTest, HighResolutionKeepsFractionsOfMilliseconds) {
+  const uint32_t kSsrc = 12345;
+  const size_t kPacketSize = 250;
+  send_bucket_.reset(new PacedSender(&clock_, &callback_, true));
+  send_bucket_->SetProbingEnabled(false);
+  send_bucket_->SetEstimatedBitrate(kTargetBitrateBps);
+  for (uint16_t i = 0; i < 30; ++i) {
+    send_bucket_->InsertPacket(PacedSender::kNormalPriority, kSsrc, i,
+                               clock_.TimeInMilliseconds(), kPacketSize,
+                               false);
+  }
+
+  // One packet per 1 ms of budget, neither rounding 1.5 ms up nor down.
+  EXPECT_CALL(callback_, TimeToSendPacket(kSsrc, _, _, _, _))
+      .Times(18)
+      .WillRepeatedly(Return(true));
+  for (int i = 0; i < 12; ++i) {
+    clock_.AdvanceTimeMicroseconds(1500);
+    send_bucket_->Process();
+  }
+  EXPECT_EQ(12u, send_bucket_->QueueSizePackets());
+}
+
 }  // namespace test
 }  // namespace webrtc
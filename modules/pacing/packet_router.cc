@@ -38,6 +38,35 @@ void PacketRouter::RemoveRtpModule(RtpRtcp* rtp_module) {
   RTC_DCHECK(std::find(rtp_modules_.begin(), rtp_modules_.end(), rtp_module) !=
              rtp_modules_.end());
   rtp_modules_.remove(rtp_module);
+  for (auto it = send_modules_by_ssrc_.begin();
+       it != send_modules_by_ssrc_.end();) {
+    if (it->second == rtp_module)
+      it = send_modules_by_ssrc_.erase(it);
+    else
+      ++it;
+  }
+}
+
+RtpRtcp* PacketRouter::FindSendingModule(uint32_t ssrc) {
+  RtpRtcp* cached_module = nullptr;
+  auto it = send_modules_by_ssrc_.find(ssrc);
+  if (it != send_modules_by_ssrc_.end()) {
+    cached_module = it->second;
+    if (cached_module->SendingMedia() &&
+        (ssrc == cached_module->SSRC() ||
+         ssrc == cached_module->FlexfecSsrc())) {
+      return cached_module;
+    }
+  }
+  for (auto* rtp_module : rtp_modules_) {
+    if (rtp_module == cached_module || !rtp_module->SendingMedia())
+      continue;
+    if (ssrc == rtp_module->SSRC() || ssrc == rtp_module->FlexfecSsrc()) {
+      send_modules_by_ssrc_[ssrc] = rtp_module;
+      return rtp_module;
+    }
+  }
+  return nullptr;
 }
 
 bool PacketRouter::TimeToSendPacket(uint32_t ssrc,
@@ -47,16 +76,11 @@ bool PacketRouter::TimeToSendPacket(uint32_t ssrc,
                                     int probe_cluster_id) {
   RTC_DCHECK(pacer_thread_checker_.CalledOnValidThread());
   rtc::CritScope cs(&modules_crit_);
-  for (auto* rtp_module : rtp_modules_) {
-    if (!rtp_module->SendingMedia())
-      continue;
-    if (ssrc == rtp_module->SSRC() || ssrc == rtp_module->FlexfecSsrc()) {
-      return rtp_module->TimeToSendPacket(ssrc, sequence_number,
-                                          capture_timestamp, retransmission,
-                                          probe_cluster_id);
-    }
-  }
-  return true;
+  RtpRtcp* rtp_module = FindSendingModule(ssrc);
+  if (!rtp_module)
+    return true;
+  return rtp_module->TimeToSendPacket(ssrc, sequence_number, capture_timestamp,
+                                      retransmission, probe_cluster_id);
 }
 
 size_t PacketRouter::TimeToSendPadding(size_t bytes_to_send,
@@ -12,6 +12,7 @@
 #define WEBRTC_MODULES_PACING_PACKET_ROUTER_H_
 
 #include <list>
+#include <unordered_map>
 
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/criticalsection.h"
@@ -55,9 +56,18 @@ class PacketRouter : public PacedSender::PacketSender,
   virtual bool SendFeedback(rtcp::TransportFeedback* packet);
 
  private:
+  // Returns the module sending media with |ssrc|, or nullptr.
+  RtpRtcp* FindSendingModule(uint32_t ssrc)
+      EXCLUSIVE_LOCKS_REQUIRED(modules_crit_);
+
   rtc::ThreadChecker pacer_thread_checker_;
   rtc::CriticalSection modules_crit_;
   std::list<RtpRtcp*> rtp_modules_ GUARDED_BY(modules_crit_);
+  // Module last found sending each SSRC. Modules usually get their SSRCs after
+  // being added and may change them, so entries are filled on the first
+  // packet, checked on each use and only dropped when the module is removed.
+  std::unordered_map<uint32_t, RtpRtcp*> send_modules_by_ssrc_
+      GUARDED_BY(modules_crit_);
 
   volatile int transport_seq_;
 
@@ -162,6 +162,50 @@ TEST_F(PacketRouterTest, TimeToSendPadding) {
   packet_router_->RemoveRtpModule(&rtp_2);
 }
 
+TEST_F(PacketRouterTest, TimeToSendPacketAfterSsrcChanges) {
+  const uint32_t kSsrc1 = 1234;
+  const uint32_t kSsrc2 = 4567;
+  NiceMock<MockRtpRtcp> rtp_1;
+  NiceMock<MockRtpRtcp> rtp_2;
+  ON_CALL(rtp_1, SendingMedia()).WillByDefault(Return(true));
+  ON_CALL(rtp_2, SendingMedia()).WillByDefault(Return(true));
+  ON_CALL(rtp_1, SSRC()).WillByDefault(Return(kSsrc1));
+  ON_CALL(rtp_2, SSRC()).WillByDefault(Return(kSsrc2));
+  packet_router_->AddRtpModule(&rtp_1);
+  packet_router_->AddRtpModule(&rtp_2);
+
+  EXPECT_CALL(rtp_1, TimeToSendPacket(kSsrc1, 1, _, _, _))
+      .WillOnce(Return(true));
+  EXPECT_TRUE(packet_router_->TimeToSendPacket(kSsrc1, 1, 0, false,
+                                               PacketInfo::kNotAProbe));
+  EXPECT_CALL(rtp_2, TimeToSendPacket(kSsrc2, 1, _, _, _))
+      .WillOnce(Return(true));
+  EXPECT_TRUE(packet_router_->TimeToSendPacket(kSsrc2, 1, 0, false,
+                                               PacketInfo::kNotAProbe));
+
+  // The modules swap SSRCs, packets must follow.
+  ON_CALL(rtp_1, SSRC()).WillByDefault(Return(kSsrc2));
+  ON_CALL(rtp_2, SSRC()).WillByDefault(Return(kSsrc1));
+  EXPECT_CALL(rtp_2, TimeToSendPacket(kSsrc1, 2, _, _, _))
+      .WillOnce(Return(true));
+  EXPECT_TRUE(packet_router_->TimeToSendPacket(kSsrc1, 2, 0, false,
+                                               PacketInfo::kNotAProbe));
+  EXPECT_CALL(rtp_1, TimeToSendPacket(kSsrc2, 2, _, _, _))
+      .WillOnce(Return(true));
+  EXPECT_TRUE(packet_router_->TimeToSendPacket(kSsrc2, 2, 0, false,
+                                               PacketInfo::kNotAProbe));
+
+  // Nothing is sent for an SSRC no module uses anymore.
+  ON_CALL(rtp_1, SSRC()).WillByDefault(Return(kSsrc1 + kSsrc2));
+  EXPECT_CALL(rtp_1, TimeToSendPacket(_, _, _, _, _)).Times(0);
+  EXPECT_CALL(rtp_2, TimeToSendPacket(_, _, _, _, _)).Times(0);
+  EXPECT_TRUE(packet_router_->TimeToSendPacket(kSsrc2, 3, 0, false,
+                                               PacketInfo::kNotAProbe));
+
+  packet_router_->RemoveRtpModule(&rtp_1);
+  packet_router_->RemoveRtpModule(&rtp_2);
+}
+
 TEST_F(PacketRouterTest, SenderOnlyFunctionsRespectSendingMedia) {
   MockRtpRtcp rtp;
   packet_router_->AddRtpModule(&rtp);
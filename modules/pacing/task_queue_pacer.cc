@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/pacing/task_queue_pacer.h"
+
+#include <memory>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/event.h"
+#include "webrtc/modules/pacing/paced_sender.h"
+
+namespace webrtc {
+
+class TaskQueuePacer::ProcessTask : public rtc::QueuedTask {
+ public:
+  ProcessTask(TaskQueuePacer* owner, int generation)
+      : owner_(owner), generation_(generation) {}
+
+ private:
+  bool Run() override {
+    if (generation_ != owner_->generation_)
+      return true;
+    owner_->pacer_->Process();
+    int64_t delay_ms = owner_->pacer_->TimeUntilNextProcess();
+    std::unique_ptr<rtc::QueuedTask> task(this);
+    if (delay_ms > 0) {
+      rtc::TaskQueue::Current()->PostDelayedTask(
+          std::move(task), static_cast<uint32_t>(delay_ms));
+    } else {
+      rtc::TaskQueue::Current()->PostTask(std::move(task));
+    }
+    // Ownership has been transferred to the next occurrence.
+    return false;
+  }
+
+  TaskQueuePacer* const owner_;
+  const int generation_;
+};
+
+TaskQueuePacer::TaskQueuePacer(PacedSender* pacer)
+    : pacer_(pacer),
+      generation_(0),
+      started_(false),
+      task_queue_("PacerQueue") {}
+
+TaskQueuePacer::~TaskQueuePacer() {
+  Stop();
+}
+
+void TaskQueuePacer::Start() {
+  task_queue_.PostTask([this]() {
+    if (started_)
+      return;
+    started_ = true;
+    ++generation_;
+    rtc::TaskQueue::Current()->PostTask(std::unique_ptr<rtc::QueuedTask>(
+        new ProcessTask(this, generation_)));
+  });
+}
+
+void TaskQueuePacer::Stop() {
+  RTC_DCHECK(!task_queue_.IsCurrent());
+  rtc::Event stopped(false, false);
+  task_queue_.PostTask([this, &stopped]() {
+    if (started_) {
+      started_ = false;
+      ++generation_;
+    }
+    stopped.Set();
+  });
+  stopped.Wait(rtc::Event::kForever);
+}
+
+}  // namespace webrtc
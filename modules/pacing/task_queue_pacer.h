@@ -0,0 +1,51 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_PACING_TASK_QUEUE_PACER_H_
+#define WEBRTC_MODULES_PACING_TASK_QUEUE_PACER_H_
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/task_queue.h"
+
+namespace webrtc {
+
+class PacedSender;
+
+// Calls Process on a PacedSender from a dedicated task queue, waking up when
+// TimeUntilNextProcess says so. Unlike a ProcessThread shared with other
+// modules, this keeps up with the 1 ms intervals of the high resolution
+// pacing mode.
+class TaskQueuePacer {
+ public:
+  explicit TaskQueuePacer(PacedSender* pacer);
+  // Stops processing if still started.
+  ~TaskQueuePacer();
+
+  void Start();
+  // Blocks until the pacer is no longer processed.
+  void Stop();
+
+ private:
+  class ProcessTask;
+
+  PacedSender* const pacer_;
+  // Incremented on each Start and Stop, a ProcessTask only reposts itself
+  // while it matches the generation it was started for. Only accessed on
+  // |task_queue_|.
+  int generation_;
+  bool started_;
+  rtc::TaskQueue task_queue_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(TaskQueuePacer);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_PACING_TASK_QUEUE_PACER_H_
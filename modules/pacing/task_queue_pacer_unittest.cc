@@ -0,0 +1,100 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+
+#include "webrtc/modules/pacing/task_queue_pacer.h"
+
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/modules/pacing/paced_sender.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace {
+constexpr uint32_t kSsrc = 12345;
+constexpr size_t kPacketSize = 1200;
+constexpr int kNumPackets = 20;
+constexpr int kTimeoutMs = 5000;
+
+class CountingPacketSender : public PacedSender::PacketSender {
+ public:
+  CountingPacketSender() : done_(false, false), packets_sent_(0) {}
+
+  bool TimeToSendPacket(uint32_t ssrc,
+                        uint16_t sequence_number,
+                        int64_t capture_time_ms,
+                        bool retransmission,
+                        int probe_cluster_id) override {
+    rtc::CritScope lock(&crit_);
+    if (++packets_sent_ == kNumPackets)
+      done_.Set();
+    return true;
+  }
+
+  size_t TimeToSendPadding(size_t bytes, int probe_cluster_id) override {
+    return 0;
+  }
+
+  int packets_sent() const {
+    rtc::CritScope lock(&crit_);
+    return packets_sent_;
+  }
+
+  rtc::Event done_;
+
+ private:
+  rtc::CriticalSection crit_;
+  int packets_sent_ GUARDED_BY(crit_);
+};
+
+class TaskQueuePacerTest : public ::testing::Test {
+ protected:
+  TaskQueuePacerTest()
+      : pacer_(Clock::GetRealTimeClock(), &packet_sender_, true),
+        task_queue_pacer_(&pacer_) {
+    pacer_.SetProbingEnabled(false);
+    pacer_.SetEstimatedBitrate(10000000);
+  }
+
+  void InsertPackets(uint16_t first_sequence_number) {
+    for (int i = 0; i < kNumPackets; ++i) {
+      pacer_.InsertPacket(PacedSender::kNormalPriority, kSsrc,
+                          first_sequence_number + i, -1, kPacketSize, false);
+    }
+  }
+
+  CountingPacketSender packet_sender_;
+  PacedSender pacer_;
+  TaskQueuePacer task_queue_pacer_;
+};
+}  // namespace
+
+TEST_F(TaskQueuePacerTest, SendsQueuedPackets) {
+  task_queue_pacer_.Start();
+  InsertPackets(0);
+  EXPECT_TRUE(packet_sender_.done_.Wait(kTimeoutMs));
+  task_queue_pacer_.Stop();
+  EXPECT_EQ(0u, pacer_.QueueSizePackets());
+}
+
+TEST_F(TaskQueuePacerTest, DoesNotSendAfterStop) {
+  task_queue_pacer_.Start();
+  task_queue_pacer_.Stop();
+  InsertPackets(0);
+  EXPECT_FALSE(packet_sender_.done_.Wait(50));
+  EXPECT_EQ(0, packet_sender_.packets_sent());
+
+  // And can be started again.
+  task_queue_pacer_.Start();
+  EXPECT_TRUE(packet_sender_.done_.Wait(kTimeoutMs));
+}
+
+}  // namespace webrtc
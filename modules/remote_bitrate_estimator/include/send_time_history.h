@@ -11,7 +11,7 @@
 #ifndef WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_INCLUDE_SEND_TIME_HISTORY_H_
 #define WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_INCLUDE_SEND_TIME_HISTORY_H_
 
-#include <map>
+#include <vector>
 
 #include "webrtc/base/basictypes.h"
 #include "webrtc/base/constructormagic.h"
@@ -43,10 +43,35 @@ class SendTimeHistory {
   bool GetInfo(PacketInfo* packet_info, bool remove);
 
  private:
+  // Entry in |history_|, empty when |unwrapped_seq_num| is -1.
+  struct Slot {
+    Slot();
+
+    int64_t unwrapped_seq_num;
+    int64_t creation_time_ms;
+    int64_t send_time_ms;
+    size_t payload_size;
+    int probe_cluster_id;
+  };
+
+  Slot* Find(int64_t unwrapped_seq_num);
+  // Drops the oldest sequence number still in the history.
+  void PopFront();
+  // Makes room for |unwrapped_seq_num|, growing or dropping the oldest
+  // entries. Returns false if it is too old to fit.
+  bool MakeRoom(int64_t unwrapped_seq_num);
+  void Grow();
+
   Clock* const clock_;
   const int64_t packet_age_limit_ms_;
   SequenceNumberUnwrapper seq_num_unwrapper_;
-  std::map<int64_t, PacketInfo> history_;
+  // Ring indexed by unwrapped sequence number modulo its size, which is a
+  // power of two. Only the sequence numbers in [begin_seq_num_, end_seq_num_)
+  // can have non-empty slots; transport sequence numbers increase with each
+  // packet, so the ring only reallocates while the send rate ramps up.
+  std::vector<Slot> history_;
+  int64_t begin_seq_num_;
+  int64_t end_seq_num_;
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(SendTimeHistory);
 };
@@ -40,14 +40,12 @@ enum {
 static const double kTimestampToMs = 1000.0 /
     static_cast<double>(1 << kInterArrivalShift);
 
-template<typename K, typename V>
-std::vector<K> Keys(const std::map<K, V>& map) {
-  std::vector<K> keys;
-  keys.reserve(map.size());
-  for (typename std::map<K, V>::const_iterator it = map.begin();
-      it != map.end(); ++it) {
-    keys.push_back(it->first);
-  }
+std::vector<uint32_t> Keys(
+    const std::vector<std::pair<uint32_t, int64_t>>& ssrcs) {
+  std::vector<uint32_t> keys;
+  keys.reserve(ssrcs.size());
+  for (const auto& ssrc : ssrcs)
+    keys.push_back(ssrc.first);
   return keys;
 }
 
@@ -70,15 +68,6 @@ bool RemoteBitrateEstimatorAbsSendTime::IsWithinClusterBounds(
     return fabs(static_cast<float>(send_delta_ms) - cluster_mean) < 2.5f;
   }
 
-  void RemoteBitrateEstimatorAbsSendTime::AddCluster(
-      std::list<Cluster>* clusters,
-      Cluster* cluster) {
-    cluster->send_mean_ms /= static_cast<float>(cluster->count);
-    cluster->recv_mean_ms /= static_cast<float>(cluster->count);
-    cluster->mean_size /= cluster->count;
-    clusters->push_back(*cluster);
-  }
-
   RemoteBitrateEstimatorAbsSendTime::RemoteBitrateEstimatorAbsSendTime(
       RemoteBitrateObserver* observer,
       Clock* clock)
@@ -89,6 +78,7 @@ bool RemoteBitrateEstimatorAbsSendTime::IsWithinClusterBounds(
         detector_(),
         incoming_bitrate_(kBitrateWindowMs, 8000),
         incoming_bitrate_initialized_(false),
+        current_cluster_stored_(false),
         total_probes_received_(0),
         first_packet_time_ms_(-1),
         last_update_ms_(-1),
@@ -98,43 +88,67 @@ bool RemoteBitrateEstimatorAbsSendTime::IsWithinClusterBounds(
     network_thread_.DetachFromThread();
 }
 
-void RemoteBitrateEstimatorAbsSendTime::ComputeClusters(
-    std::list<Cluster>* clusters) const {
-  Cluster current;
-  int64_t prev_send_time = -1;
-  int64_t prev_recv_time = -1;
-  for (std::list<Probe>::const_iterator it = probes_.begin();
-       it != probes_.end();
-       ++it) {
-    if (prev_send_time >= 0) {
-      int send_delta_ms = it->send_time_ms - prev_send_time;
-      int recv_delta_ms = it->recv_time_ms - prev_recv_time;
-      if (send_delta_ms >= 1 && recv_delta_ms >= 1) {
-        ++current.num_above_min_delta;
-      }
-      if (!IsWithinClusterBounds(send_delta_ms, current)) {
-        if (current.count >= kMinClusterSize)
-          AddCluster(clusters, &current);
-        current = Cluster();
-      }
-      current.send_mean_ms += send_delta_ms;
-      current.recv_mean_ms += recv_delta_ms;
-      current.mean_size += it->payload_size;
-      ++current.count;
+void RemoteBitrateEstimatorAbsSendTime::AddProbe(const Probe& probe) {
+  if (!probes_.empty()) {
+    int send_delta_ms = probe.send_time_ms - probes_.back().send_time_ms;
+    int recv_delta_ms = probe.recv_time_ms - probes_.back().recv_time_ms;
+    if (send_delta_ms >= 1 && recv_delta_ms >= 1) {
+      ++current_cluster_.num_above_min_delta;
     }
-    prev_send_time = it->send_time_ms;
-    prev_recv_time = it->recv_time_ms;
+    if (!IsWithinClusterBounds(send_delta_ms, current_cluster_)) {
+      // The delta above is counted in the cluster it ends.
+      UpdateCurrentCluster();
+      current_cluster_ = Cluster();
+      current_cluster_stored_ = false;
+    }
+    current_cluster_.send_mean_ms += send_delta_ms;
+    current_cluster_.recv_mean_ms += recv_delta_ms;
+    current_cluster_.mean_size += probe.payload_size;
+    ++current_cluster_.count;
+    UpdateCurrentCluster();
   }
-  if (current.count >= kMinClusterSize)
-    AddCluster(clusters, &current);
+  probes_.push_back(probe);
 }
 
-std::list<Cluster>::const_iterator
+void RemoteBitrateEstimatorAbsSendTime::UpdateCurrentCluster() {
+  if (current_cluster_.count < kMinClusterSize)
+    return;
+  Cluster cluster = current_cluster_;
+  cluster.send_mean_ms /= static_cast<float>(cluster.count);
+  cluster.recv_mean_ms /= static_cast<float>(cluster.count);
+  cluster.mean_size /= cluster.count;
+  if (current_cluster_stored_) {
+    clusters_.back() = cluster;
+  } else {
+    clusters_.push_back(cluster);
+    current_cluster_stored_ = true;
+  }
+}
+
+void RemoteBitrateEstimatorAbsSendTime::ClearProbes() {
+  probes_.clear();
+  clusters_.clear();
+  current_cluster_ = Cluster();
+  current_cluster_stored_ = false;
+}
+
+void RemoteBitrateEstimatorAbsSendTime::RemoveOldestProbe() {
+  // The deltas are relative to the previous probe, so the clusters have to be
+  // rebuilt. This only happens while no cluster is found, on a few probes.
+  std::deque<Probe> probes;
+  probes.swap(probes_);
+  probes.pop_front();
+  ClearProbes();
+  for (const Probe& probe : probes)
+    AddProbe(probe);
+}
+
+std::vector<Cluster>::const_iterator
 RemoteBitrateEstimatorAbsSendTime::FindBestProbe(
-    const std::list<Cluster>& clusters) const {
+    const std::vector<Cluster>& clusters) const {
   int highest_probe_bitrate_bps = 0;
-  std::list<Cluster>::const_iterator best_it = clusters.end();
-  for (std::list<Cluster>::const_iterator it = clusters.begin();
+  std::vector<Cluster>::const_iterator best_it = clusters.end();
+  for (std::vector<Cluster>::const_iterator it = clusters.begin();
        it != clusters.end();
        ++it) {
     if (it->send_mean_ms == 0 || it->recv_mean_ms == 0)
@@ -164,18 +178,16 @@ RemoteBitrateEstimatorAbsSendTime::FindBestProbe(
 
 RemoteBitrateEstimatorAbsSendTime::ProbeResult
 RemoteBitrateEstimatorAbsSendTime::ProcessClusters(int64_t now_ms) {
-  std::list<Cluster> clusters;
-  ComputeClusters(&clusters);
-  if (clusters.empty()) {
+  if (clusters_.empty()) {
     // If we reach the max number of probe packets and still have no clusters,
     // we will remove the oldest one.
     if (probes_.size() >= kMaxProbePackets)
-      probes_.pop_front();
+      RemoveOldestProbe();
     return ProbeResult::kNoUpdate;
   }
 
-  std::list<Cluster>::const_iterator best_it = FindBestProbe(clusters);
-  if (best_it != clusters.end()) {
+  std::vector<Cluster>::const_iterator best_it = FindBestProbe(clusters_);
+  if (best_it != clusters_.end()) {
     int probe_bitrate_bps =
         std::min(best_it->GetSendBitrateBps(), best_it->GetRecvBitrateBps());
     // Make sure that a probe sent on a lower bitrate than our estimate can't
@@ -194,8 +206,8 @@ RemoteBitrateEstimatorAbsSendTime::ProcessClusters(int64_t now_ms) {
 
   // Not probing and received non-probe packet, or finished with current set
   // of probes.
-  if (clusters.size() >= kExpectedNumberOfProbes)
-    probes_.clear();
+  if (clusters_.size() >= kExpectedNumberOfProbes)
+    ClearProbes();
   return ProbeResult::kNoUpdate;
 }
 
@@ -281,7 +293,16 @@ void RemoteBitrateEstimatorAbsSendTime::IncomingPacketInfo(
     TimeoutStreams(now_ms);
     RTC_DCHECK(inter_arrival_.get());
     RTC_DCHECK(estimator_.get());
-    ssrcs_[ssrc] = now_ms;
+    auto it = std::lower_bound(
+        ssrcs_.begin(), ssrcs_.end(), ssrc,
+        [](const std::pair<uint32_t, int64_t>& entry, uint32_t ssrc) {
+          return entry.first < ssrc;
+        });
+    if (it != ssrcs_.end() && it->first == ssrc) {
+      it->second = now_ms;
+    } else {
+      ssrcs_.insert(it, std::make_pair(ssrc, now_ms));
+    }
 
     // For now only try to detect probes while we don't have a valid estimate.
     // We currently assume that only packets larger than 200 bytes are paced by
@@ -302,7 +323,7 @@ void RemoteBitrateEstimatorAbsSendTime::IncomingPacketInfo(
                      << " ms, send delta=" << send_delta_ms
                      << " ms, recv delta=" << recv_delta_ms << " ms.";
       }
-      probes_.push_back(Probe(send_time_ms, arrival_time_ms, payload_size));
+      AddProbe(Probe(send_time_ms, arrival_time_ms, payload_size));
       ++total_probes_received_;
       // Make sure that a probe which updated the bitrate immediately has an
       // effect by calling the OnReceiveBitrateChanged callback.
@@ -362,13 +383,12 @@ int64_t RemoteBitrateEstimatorAbsSendTime::TimeUntilNextProcess() {
 }
 
 void RemoteBitrateEstimatorAbsSendTime::TimeoutStreams(int64_t now_ms) {
-  for (Ssrcs::iterator it = ssrcs_.begin(); it != ssrcs_.end();) {
-    if ((now_ms - it->second) > kStreamTimeOutMs) {
-      ssrcs_.erase(it++);
-    } else {
-      ++it;
-    }
-  }
+  ssrcs_.erase(
+      std::remove_if(ssrcs_.begin(), ssrcs_.end(),
+                     [now_ms](const std::pair<uint32_t, int64_t>& entry) {
+                       return now_ms - entry.second > kStreamTimeOutMs;
+                     }),
+      ssrcs_.end());
   if (ssrcs_.empty()) {
     // We can't update the estimate if we don't have any active streams.
     inter_arrival_.reset(
@@ -388,7 +408,12 @@ void RemoteBitrateEstimatorAbsSendTime::OnRttUpdate(int64_t avg_rtt_ms,
 
 void RemoteBitrateEstimatorAbsSendTime::RemoveStream(uint32_t ssrc) {
   rtc::CritScope lock(&crit_);
-  ssrcs_.erase(ssrc);
+  ssrcs_.erase(
+      std::remove_if(ssrcs_.begin(), ssrcs_.end(),
+                     [ssrc](const std::pair<uint32_t, int64_t>& entry) {
+                       return entry.first == ssrc;
+                     }),
+      ssrcs_.end());
 }
 
 bool RemoteBitrateEstimatorAbsSendTime::LatestEstimate(
@@ -11,9 +11,9 @@
 #ifndef WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_REMOTE_BITRATE_ESTIMATOR_ABS_SEND_TIME_H_
 #define WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_REMOTE_BITRATE_ESTIMATOR_ABS_SEND_TIME_H_
 
-#include <list>
-#include <map>
+#include <deque>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "webrtc/base/checks.h"
@@ -91,23 +91,28 @@ class RemoteBitrateEstimatorAbsSendTime : public RemoteBitrateEstimator {
   void SetMinBitrate(int min_bitrate_bps) override;
 
  private:
-  typedef std::map<uint32_t, int64_t> Ssrcs;
+  // The time the last packet of each SSRC was received, sorted by SSRC.
+  // There are only a few streams, so a vector beats a map on every packet.
+  typedef std::vector<std::pair<uint32_t, int64_t>> Ssrcs;
   enum class ProbeResult { kBitrateUpdated, kNoUpdate };
 
   static bool IsWithinClusterBounds(int send_delta_ms,
                                     const Cluster& cluster_aggregate);
 
-  static void AddCluster(std::list<Cluster>* clusters, Cluster* cluster);
-
   void IncomingPacketInfo(int64_t arrival_time_ms,
                           uint32_t send_time_24bits,
                           size_t payload_size,
                           uint32_t ssrc);
 
-  void ComputeClusters(std::list<Cluster>* clusters) const;
+  // Appends |probe| to |probes_|, updating the clusters with it.
+  void AddProbe(const Probe& probe);
+  // Stores |current_cluster_| in |clusters_| once it is large enough.
+  void UpdateCurrentCluster();
+  void ClearProbes();
+  void RemoveOldestProbe();
 
-  std::list<Cluster>::const_iterator FindBestProbe(
-      const std::list<Cluster>& clusters) const;
+  std::vector<Cluster>::const_iterator FindBestProbe(
+      const std::vector<Cluster>& clusters) const;
 
   // Returns true if a probe which changed the estimate was detected.
   ProbeResult ProcessClusters(int64_t now_ms) EXCLUSIVE_LOCKS_REQUIRED(&crit_);
@@ -127,7 +132,14 @@ class RemoteBitrateEstimatorAbsSendTime : public RemoteBitrateEstimator {
   bool incoming_bitrate_initialized_;
   std::vector<int> recent_propagation_delta_ms_;
   std::vector<int64_t> recent_update_time_ms_;
-  std::list<Probe> probes_;
+  std::deque<Probe> probes_;
+  // The clusters of |probes_|, updated as probes are added rather than
+  // recomputed for each one. The last one is |current_cluster_| if it has
+  // enough probes.
+  std::vector<Cluster> clusters_;
+  // Sums of the deltas and sizes of the probes of the last cluster.
+  Cluster current_cluster_;
+  bool current_cluster_stored_;
   size_t total_probes_received_;
   int64_t first_packet_time_ms_;
   int64_t last_update_ms_;
@@ -33,6 +33,14 @@ const int RemoteEstimatorProxy::kDefaultSendIntervalMs = 100;
 static constexpr int64_t kMaxTimeMs =
     std::numeric_limits<int64_t>::max() / 1000;
 
+// Arrivals kept for kBackWindowMs plus a feedback interval fit in the initial
+// ring up to about 1000 packets per second. Sequence numbers more than half
+// the range apart can not be unwrapped reliably, so the ring stops growing
+// there.
+static constexpr size_t kInitialArrivalTimesSize = 1 << 10;
+static constexpr size_t kMaxArrivalTimesSize = 1 << 15;
+static constexpr int64_t kNoSeq = -1;
+
 RemoteEstimatorProxy::RemoteEstimatorProxy(Clock* clock,
                                            PacketRouter* packet_router)
     : clock_(clock),
@@ -41,6 +49,10 @@ RemoteEstimatorProxy::RemoteEstimatorProxy(Clock* clock,
       media_ssrc_(0),
       feedback_sequence_(0),
       window_start_seq_(-1),
+      packet_arrival_times_(kInitialArrivalTimesSize,
+                            std::make_pair(kNoSeq, int64_t{-1})),
+      arrivals_begin_seq_(0),
+      arrivals_end_seq_(0),
       send_interval_ms_(kDefaultSendIntervalMs) {}
 
 RemoteEstimatorProxy::~RemoteEstimatorProxy() {}
@@ -135,18 +147,27 @@ void RemoteEstimatorProxy::OnPacketArrival(uint16_t sequence_number,
     return;
   }
 
-  if (packet_arrival_times_.lower_bound(window_start_seq_) ==
-      packet_arrival_times_.end()) {
+  if (FirstArrivalFrom(window_start_seq_) == arrivals_end_seq_) {
     // Start new feedback packet, cull old packets.
-    for (auto it = packet_arrival_times_.begin();
-         it != packet_arrival_times_.end() && it->first < seq &&
-         arrival_time - it->second >= kBackWindowMs;) {
-      auto delete_it = it;
-      ++it;
-      packet_arrival_times_.erase(delete_it);
+    while (arrivals_begin_seq_ < arrivals_end_seq_) {
+      const int64_t* oldest_time = FindArrivalTime(arrivals_begin_seq_);
+      if (oldest_time &&
+          (arrivals_begin_seq_ >= seq ||
+           arrival_time - *oldest_time < kBackWindowMs)) {
+        break;
+      }
+      PopFrontArrival();
     }
   }
 
+  if (!MakeRoomForArrival(seq)) {
+    LOG(LS_WARNING) << "Skipping this sequence number (" << sequence_number
+                    << ") since it is too old to be reported. Feedback window "
+                       "starts at "
+                    << window_start_seq_ << ".";
+    return;
+  }
+
   if (window_start_seq_ == -1) {
     window_start_seq_ = sequence_number;
   } else if (seq < window_start_seq_) {
@@ -154,10 +175,11 @@ void RemoteEstimatorProxy::OnPacketArrival(uint16_t sequence_number,
   }
 
   // We are only interested in the first time a packet is received.
-  if (packet_arrival_times_.find(seq) != packet_arrival_times_.end())
+  if (FindArrivalTime(seq))
     return;
 
-  packet_arrival_times_[seq] = arrival_time;
+  packet_arrival_times_[seq & (packet_arrival_times_.size() - 1)] =
+      std::make_pair(seq, arrival_time);
 }
 
 bool RemoteEstimatorProxy::BuildFeedbackPacket(
@@ -166,28 +188,31 @@ bool RemoteEstimatorProxy::BuildFeedbackPacket(
   // feedback packet. Some older may still be in the map, in case a reordering
   // happens and we need to retransmit them.
   rtc::CritScope cs(&lock_);
-  auto it = packet_arrival_times_.lower_bound(window_start_seq_);
-  if (it == packet_arrival_times_.end()) {
+  int64_t seq = FirstArrivalFrom(window_start_seq_);
+  if (seq == arrivals_end_seq_) {
     // Feedback for all packets already sent.
     return false;
   }
 
   // TODO(sprang): Measure receive times in microseconds and remove the
   // conversions below.
-  const int64_t first_sequence = it->first;
+  const int64_t first_sequence = seq;
   feedback_packet->SetMediaSsrc(media_ssrc_);
   // Base sequence is the expected next (window_start_seq_). This is known, but
   // we might not have actually received it, so the base time shall be the time
   // of the first received packet in the feedback.
   feedback_packet->SetBase(static_cast<uint16_t>(window_start_seq_ & 0xFFFF),
-                           it->second * 1000);
+                           *FindArrivalTime(seq) * 1000);
   feedback_packet->SetFeedbackSequenceNumber(feedback_sequence_++);
-  for (; it != packet_arrival_times_.end(); ++it) {
-    if (!feedback_packet->AddReceivedPacket(
-            static_cast<uint16_t>(it->first & 0xFFFF), it->second * 1000)) {
+  for (; seq < arrivals_end_seq_; ++seq) {
+    const int64_t* arrival_time = FindArrivalTime(seq);
+    if (!arrival_time)
+      continue;
+    if (!feedback_packet->AddReceivedPacket(static_cast<uint16_t>(seq & 0xFFFF),
+                                            *arrival_time * 1000)) {
       // If we can't even add the first seq to the feedback packet, we won't be
       // able to build it at all.
-      RTC_CHECK_NE(first_sequence, it->first);
+      RTC_CHECK_NE(first_sequence, seq);
 
       // Could not add timestamp, feedback packet might be full. Return and
       // try again with a fresh packet.
@@ -197,10 +222,85 @@ bool RemoteEstimatorProxy::BuildFeedbackPacket(
     // Note: Don't erase items from packet_arrival_times_ after sending, in case
     // they need to be re-sent after a reordering. Removal will be handled
     // by OnPacketArrival once packets are too old.
-    window_start_seq_ = it->first + 1;
+    window_start_seq_ = seq + 1;
   }
 
   return true;
 }
 
+int64_t* RemoteEstimatorProxy::FindArrivalTime(int64_t seq) {
+  if (seq < arrivals_begin_seq_ || seq >= arrivals_end_seq_)
+    return nullptr;
+  std::pair<int64_t, int64_t>& slot =
+      packet_arrival_times_[seq & (packet_arrival_times_.size() - 1)];
+  return slot.first == seq ? &slot.second : nullptr;
+}
+
+int64_t RemoteEstimatorProxy::FirstArrivalFrom(int64_t seq) {
+  for (seq = std::max(seq, arrivals_begin_seq_); seq < arrivals_end_seq_;
+       ++seq) {
+    if (FindArrivalTime(seq))
+      return seq;
+  }
+  return arrivals_end_seq_;
+}
+
+void RemoteEstimatorProxy::PopFrontArrival() {
+  RTC_DCHECK_LT(arrivals_begin_seq_, arrivals_end_seq_);
+  std::pair<int64_t, int64_t>& slot =
+      packet_arrival_times_[arrivals_begin_seq_ &
+                            (packet_arrival_times_.size() - 1)];
+  if (slot.first == arrivals_begin_seq_)
+    slot.first = kNoSeq;
+  ++arrivals_begin_seq_;
+}
+
+bool RemoteEstimatorProxy::MakeRoomForArrival(int64_t seq) {
+  if (arrivals_begin_seq_ == arrivals_end_seq_) {
+    arrivals_begin_seq_ = seq;
+    arrivals_end_seq_ = seq + 1;
+    return true;
+  }
+
+  if (seq < arrivals_begin_seq_) {
+    while (arrivals_end_seq_ - seq >
+               static_cast<int64_t>(packet_arrival_times_.size()) &&
+           packet_arrival_times_.size() < kMaxArrivalTimesSize) {
+      GrowArrivals();
+    }
+    if (arrivals_end_seq_ - seq >
+        static_cast<int64_t>(packet_arrival_times_.size())) {
+      return false;
+    }
+    arrivals_begin_seq_ = seq;
+    return true;
+  }
+
+  while (seq - arrivals_begin_seq_ >=
+         static_cast<int64_t>(packet_arrival_times_.size())) {
+    if (packet_arrival_times_.size() < kMaxArrivalTimesSize) {
+      GrowArrivals();
+    } else if (arrivals_begin_seq_ == arrivals_end_seq_) {
+      arrivals_begin_seq_ = seq;
+    } else {
+      PopFrontArrival();
+    }
+  }
+  arrivals_end_seq_ = std::max(arrivals_end_seq_, seq + 1);
+  return true;
+}
+
+void RemoteEstimatorProxy::GrowArrivals() {
+  std::vector<std::pair<int64_t, int64_t>> arrival_times(
+      2 * packet_arrival_times_.size(), std::make_pair(kNoSeq, int64_t{-1}));
+  for (int64_t seq = arrivals_begin_seq_; seq < arrivals_end_seq_; ++seq) {
+    const int64_t* arrival_time = FindArrivalTime(seq);
+    if (arrival_time) {
+      arrival_times[seq & (arrival_times.size() - 1)] =
+          std::make_pair(seq, *arrival_time);
+    }
+  }
+  packet_arrival_times_.swap(arrival_times);
+}
+
 }  // namespace webrtc
@@ -11,7 +11,6 @@
 #ifndef WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_REMOTE_ESTIMATOR_PROXY_H_
 #define WEBRTC_MODULES_REMOTE_BITRATE_ESTIMATOR_REMOTE_ESTIMATOR_PROXY_H_
 
-#include <map>
 #include <vector>
 
 #include "webrtc/base/criticalsection.h"
@@ -59,6 +58,18 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
       EXCLUSIVE_LOCKS_REQUIRED(&lock_);
   bool BuildFeedbackPacket(rtcp::TransportFeedback* feedback_packet);
 
+  // Arrival time of the packet with unwrapped sequence number |seq|, nullptr
+  // if it has not been received or was culled.
+  int64_t* FindArrivalTime(int64_t seq) EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  // First received sequence number not older than |seq|, or
+  // |arrivals_end_seq_| if there is none.
+  int64_t FirstArrivalFrom(int64_t seq) EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  void PopFrontArrival() EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  // Makes room for |seq| in |packet_arrival_times_|, growing it or dropping
+  // the oldest arrivals. Returns false if |seq| is too old to fit.
+  bool MakeRoomForArrival(int64_t seq) EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+  void GrowArrivals() EXCLUSIVE_LOCKS_REQUIRED(&lock_);
+
   Clock* const clock_;
   PacketRouter* const packet_router_;
   int64_t last_process_time_ms_;
@@ -69,8 +80,14 @@ class RemoteEstimatorProxy : public RemoteBitrateEstimator {
   uint8_t feedback_sequence_ GUARDED_BY(&lock_);
   SequenceNumberUnwrapper unwrapper_ GUARDED_BY(&lock_);
   int64_t window_start_seq_ GUARDED_BY(&lock_);
-  // Map unwrapped seq -> time.
-  std::map<int64_t, int64_t> packet_arrival_times_ GUARDED_BY(&lock_);
+  // Ring of (unwrapped seq, time) indexed by unwrapped seq modulo its size,
+  // which is a power of two. Only the sequence numbers in
+  // [arrivals_begin_seq_, arrivals_end_seq_) can have non-empty slots, where
+  // the seq is -1 when empty.
+  std::vector<std::pair<int64_t, int64_t>> packet_arrival_times_
+      GUARDED_BY(&lock_);
+  int64_t arrivals_begin_seq_ GUARDED_BY(&lock_);
+  int64_t arrivals_end_seq_ GUARDED_BY(&lock_);
   int64_t send_interval_ms_ GUARDED_BY(&lock_);
 };
 
@@ -350,6 +350,30 @@ TEST_F(RemoteEstimatorProxyTest, RemovesTimestampsOutOfScope) {
   Process();
 }
 
+TEST_F(RemoteEstimatorProxyTest, ReportsManyPacketsAcrossWrap) {
+  const uint16_t kFirstSeq = 30000;
+  const size_t kPacketsPerFeedback = 1000;
+  const size_t kNumPackets = 40 * kPacketsPerFeedback;
+
+  size_t reported_packets = 0;
+  EXPECT_CALL(router_, SendFeedback(_))
+      .WillRepeatedly(
+          Invoke([&reported_packets](rtcp::TransportFeedback* packet) {
+            packet->Build();
+            reported_packets += packet->GetReceiveDeltasUs().size();
+            return true;
+          }));
+
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    // Every third packet lost.
+    if (i % 3 != 2)
+      IncomingPacket(static_cast<uint16_t>(kFirstSeq + i), kBaseTimeMs + i);
+    if (i % kPacketsPerFeedback == kPacketsPerFeedback - 1)
+      Process();
+  }
+  EXPECT_EQ(kNumPackets - kNumPackets / 3, reported_packets);
+}
+
 TEST_F(RemoteEstimatorProxyTest, TimeUntilNextProcessIsZeroBeforeFirstProcess) {
   EXPECT_EQ(0, proxy_.TimeUntilNextProcess());
 }
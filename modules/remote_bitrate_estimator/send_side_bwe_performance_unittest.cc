@@ -0,0 +1,330 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <stdlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <iomanip>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/buffer.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/logging/rtc_event_log/rtc_event_log.h"
+#include "webrtc/modules/bitrate_controller/include/bitrate_controller.h"
+#include "webrtc/modules/bitrate_controller/send_side_bandwidth_estimation.h"
+#include "webrtc/modules/congestion_controller/delay_based_bwe.h"
+#include "webrtc/modules/congestion_controller/transport_feedback_adapter.h"
+#include "webrtc/modules/pacing/packet_router.h"
+#include "webrtc/modules/remote_bitrate_estimator/remote_estimator_proxy.h"
+#include "webrtc/modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+#if defined(WEBRTC_BWE_PERF_COUNT_ALLOCATIONS)
+// Counts the heap allocations made while a ScopedAllocationCounter is alive.
+// This replaces the global operators for the whole executable, so BUILD.gn
+// builds this test into send_side_bwe_perf_tests on its own, and only sets
+// the define for builds without a sanitizer.
+namespace {
+std::atomic<bool> g_count_allocations(false);
+std::atomic<int64_t> g_allocations(0);
+}  // namespace
+
+void* operator new(size_t size) {
+  if (g_count_allocations.load(std::memory_order_relaxed))
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = malloc(size ? size : 1);
+  RTC_CHECK(ptr);
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  free(ptr);
+}
+#endif  // defined(WEBRTC_BWE_PERF_COUNT_ALLOCATIONS)
+
+namespace webrtc {
+namespace {
+constexpr int kNumPackets = 1000000;
+constexpr size_t kPacketSize = 1200;
+constexpr uint32_t kSsrc = 12345;
+constexpr int kMinBitrateBps = 100000;
+constexpr int kStartBitrateBps = 1000000;
+constexpr int kMaxBitrateBps = 30000000;
+// The bottleneck alternates between the two capacities, so the estimators
+// keep ramping up and backing off instead of idling at a steady state.
+constexpr int kHighCapacityBps = 20000000;
+constexpr int kLowCapacityBps = 8000000;
+constexpr int64_t kCapacityPeriodMs = 10000;
+constexpr int64_t kPropagationDelayMs = 25;
+// Packets which would queue longer than this at the bottleneck are dropped.
+constexpr int64_t kMaxQueueDelayMs = 300;
+// Every |kLossInterval|th packet is lost on top of the queue drops.
+constexpr int kLossInterval = 101;
+// Time between the receiver building a feedback packet and the sender
+// handling it.
+constexpr int64_t kFeedbackDelayMs = 20;
+constexpr int64_t kReceiverReportIntervalMs = 1000;
+
+#if defined(WEBRTC_BWE_PERF_COUNT_ALLOCATIONS)
+class ScopedAllocationCounter {
+ public:
+  explicit ScopedAllocationCounter(int64_t* allocations)
+      : allocations_(allocations), start_(g_allocations.load()) {
+    g_count_allocations.store(true);
+  }
+  ~ScopedAllocationCounter() {
+    g_count_allocations.store(false);
+    *allocations_ += g_allocations.load() - start_;
+  }
+
+ private:
+  int64_t* const allocations_;
+  const int64_t start_;
+};
+#else
+class ScopedAllocationCounter {
+ public:
+  explicit ScopedAllocationCounter(int64_t* allocations) {}
+};
+#endif  // defined(WEBRTC_BWE_PERF_COUNT_ALLOCATIONS)
+
+// Wall clock time and heap allocations spent in one component.
+struct ComponentCost {
+  ComponentCost() : time_ns(0), allocations(0) {}
+  int64_t time_ns;
+  int64_t allocations;
+};
+
+class ScopedCost {
+ public:
+  explicit ScopedCost(ComponentCost* cost)
+      : cost_(cost),
+        allocation_counter_(&cost->allocations),
+        start_ns_(rtc::TimeNanos()) {}
+  ~ScopedCost() { cost_->time_ns += rtc::TimeNanos() - start_ns_; }
+
+ private:
+  ComponentCost* const cost_;
+  ScopedAllocationCounter allocation_counter_;
+  const int64_t start_ns_;
+};
+
+// Keeps the serialized feedback packets instead of sending them to an RTP
+// module, so the sender side parses them as it would off the wire.
+class FeedbackQueue : public PacketRouter {
+ public:
+  bool SendFeedback(rtcp::TransportFeedback* packet) override {
+    packets_.push_back(packet->Build());
+    return true;
+  }
+
+  std::vector<rtc::Buffer> TakePackets() {
+    std::vector<rtc::Buffer> packets;
+    packets.swap(packets_);
+    return packets;
+  }
+
+ private:
+  std::vector<rtc::Buffer> packets_;
+};
+
+struct PacketInFlight {
+  int64_t arrival_time_ms;
+  uint16_t sequence_number;
+};
+
+struct FeedbackInFlight {
+  int64_t delivery_time_ms;
+  rtc::Buffer packet;
+};
+
+void PrintCost(const std::string& trace, const ComponentCost& cost) {
+  test::PrintResult("send_side_bwe_time", "", trace,
+                    static_cast<double>(cost.time_ns) / kNumPackets, "ns",
+                    false);
+#if defined(WEBRTC_BWE_PERF_COUNT_ALLOCATIONS)
+  // The size_t overload would truncate the average to a whole number.
+  std::ostringstream allocations;
+  allocations << std::fixed << std::setprecision(3)
+              << static_cast<double>(cost.allocations) / kNumPackets;
+  test::PrintResult("send_side_bwe_allocations", "", trace, allocations.str(),
+                    "allocations", false);
+#endif
+}
+}  // namespace
+
+// Replays |kNumPackets| packets through the send side bandwidth estimation
+// components over a simulated bottleneck, with the send rate following the
+// estimate, and reports their CPU and heap allocation costs per packet sent.
+// The transport feedback adapter cost includes the DelayBasedBwe it owns; a
+// separate DelayBasedBwe and SendSideBandwidthEstimation are fed the same
+// feedback so they are reported on their own too.
+TEST(SendSideBwePerformanceTest, VaryingCapacity) {
+  SimulatedClock clock(100000);
+  RtcEventLogNullImpl event_log;
+  FeedbackQueue feedback_queue;
+  RemoteEstimatorProxy proxy(&clock, &feedback_queue);
+  std::unique_ptr<BitrateController> bitrate_controller(
+      BitrateController::CreateBitrateController(&clock, &event_log));
+  bitrate_controller->SetBitrates(kStartBitrateBps, kMinBitrateBps,
+                                  kMaxBitrateBps);
+  TransportFeedbackAdapter adapter(&clock, bitrate_controller.get());
+  adapter.InitBwe();
+  adapter.SetMinBitrate(kMinBitrateBps);
+  DelayBasedBwe delay_based_bwe(&clock);
+  delay_based_bwe.SetMinBitrate(kMinBitrateBps);
+  SendSideBandwidthEstimation send_side_bwe(&event_log);
+  send_side_bwe.SetBitrates(kStartBitrateBps, kMinBitrateBps, kMaxBitrateBps);
+
+  ComponentCost proxy_cost;
+  ComponentCost adapter_cost;
+  ComponentCost delay_based_bwe_cost;
+  ComponentCost send_side_bwe_cost;
+
+  std::deque<PacketInFlight> packets_in_flight;
+  std::deque<FeedbackInFlight> feedback_in_flight;
+  RTPHeader header;
+  header.ssrc = kSsrc;
+  header.extension.hasTransportSequenceNumber = true;
+  int packets_sent = 0;
+  int packets_received = 0;
+  int feedback_packets = 0;
+  int report_packets_sent = 0;
+  int report_packets_lost = 0;
+  int64_t next_report_ms = clock.TimeInMilliseconds();
+  double send_budget_bytes = 0;
+  double link_free_time_ms = 0;
+  uint16_t sequence_number = 0;
+  while (packets_sent < kNumPackets) {
+    const int64_t now_ms = clock.TimeInMilliseconds();
+
+    // Sender.
+    uint32_t target_bitrate_bps = kStartBitrateBps;
+    bitrate_controller->AvailableBandwidth(&target_bitrate_bps);
+    send_budget_bytes =
+        std::min(send_budget_bytes + target_bitrate_bps / 8000.0,
+                 10.0 * kPacketSize);
+    while (send_budget_bytes >= kPacketSize && packets_sent < kNumPackets) {
+      send_budget_bytes -= kPacketSize;
+      ++sequence_number;
+      {
+        ScopedCost cost(&adapter_cost);
+        adapter.AddPacket(sequence_number, kPacketSize,
+                          PacketInfo::kNotAProbe);
+        adapter.OnSentPacket(sequence_number, now_ms);
+      }
+      ++packets_sent;
+      ++report_packets_sent;
+
+      // Bottleneck link.
+      const int capacity_bps = (now_ms / kCapacityPeriodMs) % 2 == 0
+                                   ? kHighCapacityBps
+                                   : kLowCapacityBps;
+      link_free_time_ms = std::max<double>(link_free_time_ms, now_ms);
+      if (packets_sent % kLossInterval == 0 ||
+          link_free_time_ms - now_ms > kMaxQueueDelayMs) {
+        ++report_packets_lost;
+        continue;
+      }
+      link_free_time_ms += 8000.0 * kPacketSize / capacity_bps;
+      packets_in_flight.push_back(
+          {static_cast<int64_t>(link_free_time_ms) + kPropagationDelayMs,
+           sequence_number});
+    }
+
+    // Receiver.
+    while (!packets_in_flight.empty() &&
+           packets_in_flight.front().arrival_time_ms <= now_ms) {
+      header.extension.transportSequenceNumber =
+          packets_in_flight.front().sequence_number;
+      {
+        ScopedCost cost(&proxy_cost);
+        proxy.IncomingPacket(packets_in_flight.front().arrival_time_ms,
+                             kPacketSize, header);
+      }
+      packets_in_flight.pop_front();
+      ++packets_received;
+    }
+    if (proxy.TimeUntilNextProcess() <= 0) {
+      ScopedCost cost(&proxy_cost);
+      proxy.Process();
+    }
+    for (rtc::Buffer& packet : feedback_queue.TakePackets())
+      feedback_in_flight.push_back({now_ms + kFeedbackDelayMs,
+                                    std::move(packet)});
+
+    // Sender side feedback handling.
+    while (!feedback_in_flight.empty() &&
+           feedback_in_flight.front().delivery_time_ms <= now_ms) {
+      const rtc::Buffer& packet = feedback_in_flight.front().packet;
+      std::unique_ptr<rtcp::TransportFeedback> feedback =
+          rtcp::TransportFeedback::ParseFrom(packet.data(), packet.size());
+      ASSERT_TRUE(feedback);
+      {
+        ScopedCost cost(&adapter_cost);
+        adapter.OnTransportFeedback(*feedback);
+      }
+      const std::vector<PacketInfo> feedback_vector =
+          adapter.GetTransportFeedbackVector();
+      DelayBasedBwe::Result result;
+      {
+        ScopedCost cost(&delay_based_bwe_cost);
+        result = delay_based_bwe.IncomingPacketFeedbackVector(feedback_vector);
+      }
+      if (result.updated) {
+        ScopedCost cost(&send_side_bwe_cost);
+        send_side_bwe.UpdateDelayBasedEstimate(now_ms,
+                                               result.target_bitrate_bps);
+      }
+      feedback_in_flight.pop_front();
+      ++feedback_packets;
+    }
+    if (now_ms >= next_report_ms) {
+      const int fraction_lost =
+          report_packets_sent > 0
+              ? 255 * report_packets_lost / report_packets_sent
+              : 0;
+      {
+        ScopedCost cost(&send_side_bwe_cost);
+        send_side_bwe.UpdateReceiverBlock(
+            static_cast<uint8_t>(fraction_lost),
+            2 * kPropagationDelayMs + kFeedbackDelayMs, report_packets_sent,
+            now_ms);
+      }
+      report_packets_sent = 0;
+      report_packets_lost = 0;
+      next_report_ms = now_ms + kReceiverReportIntervalMs;
+    }
+    {
+      ScopedCost cost(&send_side_bwe_cost);
+      send_side_bwe.UpdateEstimate(now_ms);
+    }
+
+    clock.AdvanceTimeMilliseconds(1);
+  }
+  EXPECT_GT(packets_received, kNumPackets / 2);
+  EXPECT_GT(feedback_packets, 0);
+
+  PrintCost("remote_estimator_proxy", proxy_cost);
+  PrintCost("transport_feedback_adapter", adapter_cost);
+  PrintCost("delay_based_bwe", delay_based_bwe_cost);
+  PrintCost("send_side_bandwidth_estimation", send_side_bwe_cost);
+}
+
+}  // namespace webrtc
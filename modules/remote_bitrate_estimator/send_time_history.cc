@@ -10,51 +10,78 @@
 
 #include "webrtc/modules/remote_bitrate_estimator/include/send_time_history.h"
 
+#include <algorithm>
+
 #include "webrtc/base/checks.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "webrtc/system_wrappers/include/clock.h"
 
 namespace webrtc {
 
+namespace {
+// Enough for a few seconds of audio and low rate video. Transport sequence
+// numbers more than half the range apart can not be unwrapped reliably, so
+// there is no point in keeping more.
+constexpr size_t kInitialHistorySize = 1 << 8;
+constexpr size_t kMaxHistorySize = 1 << 15;
+}  // namespace
+
+SendTimeHistory::Slot::Slot()
+    : unwrapped_seq_num(-1),
+      creation_time_ms(-1),
+      send_time_ms(-1),
+      payload_size(0),
+      probe_cluster_id(PacketInfo::kNotAProbe) {}
+
 SendTimeHistory::SendTimeHistory(Clock* clock, int64_t packet_age_limit_ms)
-    : clock_(clock), packet_age_limit_ms_(packet_age_limit_ms) {}
+    : clock_(clock),
+      packet_age_limit_ms_(packet_age_limit_ms),
+      history_(kInitialHistorySize),
+      begin_seq_num_(0),
+      end_seq_num_(0) {}
 
 SendTimeHistory::~SendTimeHistory() {}
 
 void SendTimeHistory::Clear() {
-  history_.clear();
+  std::fill(history_.begin(), history_.end(), Slot());
+  begin_seq_num_ = 0;
+  end_seq_num_ = 0;
 }
 
 void SendTimeHistory::AddAndRemoveOld(uint16_t sequence_number,
                                       size_t payload_size,
                                       int probe_cluster_id) {
   int64_t now_ms = clock_->TimeInMilliseconds();
-  // Remove old.
-  while (!history_.empty() &&
-         now_ms - history_.begin()->second.creation_time_ms >
-             packet_age_limit_ms_) {
+  // Remove old, and the slots already emptied by GetInfo in front of them.
+  while (begin_seq_num_ < end_seq_num_) {
+    Slot* oldest = Find(begin_seq_num_);
+    if (oldest && now_ms - oldest->creation_time_ms <= packet_age_limit_ms_)
+      break;
     // TODO(sprang): Warn if erasing (too many) old items?
-    history_.erase(history_.begin());
+    PopFront();
   }
 
   // Add new.
   int64_t unwrapped_seq_num = seq_num_unwrapper_.Unwrap(sequence_number);
-  int64_t creation_time_ms = now_ms;
-  constexpr int64_t kNoArrivalTimeMs = -1;  // Arrival time is ignored.
-  constexpr int64_t kNoSendTimeMs = -1;     // Send time is set by OnSentPacket.
-  history_.insert(std::make_pair(
-      unwrapped_seq_num,
-      PacketInfo(creation_time_ms, kNoArrivalTimeMs, kNoSendTimeMs,
-                 sequence_number, payload_size, probe_cluster_id)));
+  if (!MakeRoom(unwrapped_seq_num))
+    return;
+  Slot& slot = history_[unwrapped_seq_num & (history_.size() - 1)];
+  if (slot.unwrapped_seq_num == unwrapped_seq_num)
+    return;
+  slot.unwrapped_seq_num = unwrapped_seq_num;
+  slot.creation_time_ms = now_ms;
+  slot.send_time_ms = -1;  // Send time is set by OnSentPacket.
+  slot.payload_size = payload_size;
+  slot.probe_cluster_id = probe_cluster_id;
 }
 
 bool SendTimeHistory::OnSentPacket(uint16_t sequence_number,
                                    int64_t send_time_ms) {
   int64_t unwrapped_seq_num = seq_num_unwrapper_.Unwrap(sequence_number);
-  auto it = history_.find(unwrapped_seq_num);
-  if (it == history_.end())
+  Slot* slot = Find(unwrapped_seq_num);
+  if (!slot)
     return false;
-  it->second.send_time_ms = send_time_ms;
+  slot->send_time_ms = send_time_ms;
   return true;
 }
 
@@ -62,18 +89,82 @@ bool SendTimeHistory::GetInfo(PacketInfo* packet_info, bool remove) {
   RTC_DCHECK(packet_info);
   int64_t unwrapped_seq_num =
       seq_num_unwrapper_.Unwrap(packet_info->sequence_number);
-  auto it = history_.find(unwrapped_seq_num);
-  if (it == history_.end())
+  Slot* slot = Find(unwrapped_seq_num);
+  if (!slot)
     return false;
 
-  // Save arrival_time not to overwrite it.
-  int64_t arrival_time_ms = packet_info->arrival_time_ms;
-  *packet_info = it->second;
-  packet_info->arrival_time_ms = arrival_time_ms;
+  // Keep arrival_time, it is not part of the history.
+  packet_info->creation_time_ms = slot->creation_time_ms;
+  packet_info->send_time_ms = slot->send_time_ms;
+  packet_info->sequence_number =
+      static_cast<uint16_t>(unwrapped_seq_num & 0xFFFF);
+  packet_info->payload_size = slot->payload_size;
+  packet_info->probe_cluster_id = slot->probe_cluster_id;
 
   if (remove)
-    history_.erase(it);
+    *slot = Slot();
+  return true;
+}
+
+SendTimeHistory::Slot* SendTimeHistory::Find(int64_t unwrapped_seq_num) {
+  if (unwrapped_seq_num < begin_seq_num_ || unwrapped_seq_num >= end_seq_num_)
+    return nullptr;
+  Slot& slot = history_[unwrapped_seq_num & (history_.size() - 1)];
+  return slot.unwrapped_seq_num == unwrapped_seq_num ? &slot : nullptr;
+}
+
+void SendTimeHistory::PopFront() {
+  RTC_DCHECK_LT(begin_seq_num_, end_seq_num_);
+  Slot& slot = history_[begin_seq_num_ & (history_.size() - 1)];
+  if (slot.unwrapped_seq_num == begin_seq_num_)
+    slot = Slot();
+  ++begin_seq_num_;
+}
+
+bool SendTimeHistory::MakeRoom(int64_t unwrapped_seq_num) {
+  if (begin_seq_num_ == end_seq_num_) {
+    begin_seq_num_ = unwrapped_seq_num;
+    end_seq_num_ = unwrapped_seq_num + 1;
+    return true;
+  }
+
+  if (unwrapped_seq_num < begin_seq_num_) {
+    // Reordered before the oldest packet we have.
+    while (end_seq_num_ - unwrapped_seq_num >
+               static_cast<int64_t>(history_.size()) &&
+           history_.size() < kMaxHistorySize) {
+      Grow();
+    }
+    if (end_seq_num_ - unwrapped_seq_num >
+        static_cast<int64_t>(history_.size())) {
+      return false;
+    }
+    begin_seq_num_ = unwrapped_seq_num;
+    return true;
+  }
+
+  while (unwrapped_seq_num - begin_seq_num_ >=
+         static_cast<int64_t>(history_.size())) {
+    if (history_.size() < kMaxHistorySize) {
+      Grow();
+    } else if (begin_seq_num_ == end_seq_num_) {
+      begin_seq_num_ = unwrapped_seq_num;
+    } else {
+      PopFront();
+    }
+  }
+  end_seq_num_ = std::max(end_seq_num_, unwrapped_seq_num + 1);
   return true;
 }
 
+void SendTimeHistory::Grow() {
+  std::vector<Slot> history(2 * history_.size());
+  for (int64_t seq_num = begin_seq_num_; seq_num < end_seq_num_; ++seq_num) {
+    Slot* slot = Find(seq_num);
+    if (slot)
+      history[seq_num & (history.size() - 1)] = *slot;
+  }
+  history_.swap(history);
+}
+
 }  // namespace webrtc
@@ -208,6 +208,25 @@ TEST_F(SendTimeHistoryTest, HistorySizeWithWraparound) {
   EXPECT_TRUE(history_.GetInfo(&info10, false));
 }
 
+TEST_F(SendTimeHistoryTest, ManyPacketsWithinAgeLimitAcrossWrap) {
+  const uint16_t kFirstSeqNo = std::numeric_limits<uint16_t>::max() - 1000;
+  const int kNumPackets = 5000;
+  for (int i = 0; i < kNumPackets; ++i) {
+    AddPacketWithSendTime(static_cast<uint16_t>(kFirstSeqNo + i), i, i,
+                          PacketInfo::kNotAProbe);
+  }
+  for (int i = 0; i < kNumPackets; i += 2) {
+    PacketInfo info(0, static_cast<uint16_t>(kFirstSeqNo + i));
+    EXPECT_TRUE(history_.GetInfo(&info, true));
+    EXPECT_EQ(static_cast<size_t>(i), info.payload_size);
+    EXPECT_EQ(i, info.send_time_ms);
+  }
+  for (int i = 0; i < kNumPackets; ++i) {
+    PacketInfo info(0, static_cast<uint16_t>(kFirstSeqNo + i));
+    EXPECT_EQ(i % 2 == 1, history_.GetInfo(&info, false));
+  }
+}
+
 TEST_F(SendTimeHistoryTest, InterlievedGetAndRemove) {
   const uint16_t kSeqNo = 1;
   const int64_t kTimestamp = 2;
@@ -0,0 +1,108 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_RTP_RTCP_INCLUDE_MEDIA_CRYPTO_CONTEXT_H_
+#define WEBRTC_MODULES_RTP_RTCP_INCLUDE_MEDIA_CRYPTO_CONTEXT_H_
+
+#include <memory>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/config.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+class MediaCryptoCipher;
+
+// Inner PERC layer state shared by all the streams using the same key. Holds
+// one outbound and one inbound cipher, which keep their per-SSRC state
+// internally, so adding a stream does not set up a new session nor expand the
+// key again. Each cipher is only created when first used, so streams that
+// never carry media cost nothing. Thread safe.
+class MediaCryptoContext {
+ public:
+  // Returns nullptr if |key| is not valid.
+  static std::unique_ptr<MediaCryptoContext> Create(const MediaCryptoKey& key);
+  ~MediaCryptoContext();
+
+  // Replay window, in packets, covering the reordering retransmissions and
+  // FEC recovery can cause with |rtp_history_ms| of NACK history.
+  static size_t ReplayWindowSizeForHistory(int rtp_history_ms);
+
+  // Bytes appended to each inner packet by Protect.
+  size_t auth_tag_length() const { return auth_tag_length_; }
+  uint8_t key_id() const { return key_.id; }
+  // Names of the cipher backends, nullptr until the cipher has been created.
+  const char* outbound_cipher_name() const;
+  const char* inbound_cipher_name() const;
+
+  // Create the ciphers ahead of the first packet, for streams where the key
+  // expansion should not delay the first frame. Return false on failure.
+  bool PrewarmOutbound();
+  bool PrewarmInbound();
+
+  // Grows the inbound replay window to at least |packets|. Returns false if
+  // the inbound cipher already exists with a smaller window.
+  bool SetMinReplayWindowSize(size_t packets);
+  // Inbound packets dropped as replayed or too old.
+  size_t replayed_packets() const;
+
+  // See MediaCryptoCipher::Protect and MediaCryptoCipher::Unprotect. On
+  // failure, |*replayed| is set if the packet was dropped by the replay check.
+  bool Protect(uint8_t* packet, size_t length, size_t* out_length);
+  bool Unprotect(uint8_t* packet,
+                 size_t length,
+                 size_t* out_length,
+                 bool* replayed);
+
+ private:
+  // Cipher for one direction, created on first use.
+  class LazyCipher {
+   public:
+    LazyCipher(const MediaCryptoKey& key, bool outbound);
+    ~LazyCipher();
+
+    const char* name() const;
+    size_t replayed_packets() const;
+    bool Prewarm();
+    bool SetMinReplayWindowSize(size_t packets);
+    bool Protect(uint8_t* packet, size_t length, size_t* out_length);
+    bool Unprotect(uint8_t* packet,
+                   size_t length,
+                   size_t* out_length,
+                   bool* replayed);
+
+   private:
+    MediaCryptoCipher* GetOrCreate() EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+    const MediaCryptoKey& key_;
+    const bool outbound_;
+    rtc::CriticalSection crit_;
+    std::unique_ptr<MediaCryptoCipher> cipher_ GUARDED_BY(crit_);
+    // Set if creating the cipher failed, so it is not retried on every packet.
+    bool failed_ GUARDED_BY(crit_);
+    size_t replay_window_size_ GUARDED_BY(crit_);
+  };
+
+  MediaCryptoContext(const MediaCryptoKey& key, size_t auth_tag_length);
+
+  const MediaCryptoKey key_;
+  const size_t auth_tag_length_;
+  LazyCipher outbound_;
+  LazyCipher inbound_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(MediaCryptoContext);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_RTP_RTCP_INCLUDE_MEDIA_CRYPTO_CONTEXT_H_
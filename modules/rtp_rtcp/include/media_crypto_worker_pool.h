@@ -0,0 +1,49 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_RTP_RTCP_INCLUDE_MEDIA_CRYPTO_WORKER_POOL_H_
+#define WEBRTC_MODULES_RTP_RTCP_INCLUDE_MEDIA_CRYPTO_WORKER_POOL_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/task_queue.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+// Pool of worker queues used to run the inner PERC encryption off the thread
+// calling into RTPSender. All the tasks posted for the same SSRC run on the
+// same worker in the order they were posted, so each stream keeps its packet
+// order while different streams (e.g. simulcast layers) are encrypted in
+// parallel.
+class MediaCryptoWorkerPool {
+ public:
+  explicit MediaCryptoWorkerPool(size_t num_workers);
+  ~MediaCryptoWorkerPool();
+
+  void PostTask(uint32_t ssrc, std::unique_ptr<rtc::QueuedTask> task);
+
+  // Blocks until all the tasks posted before this call have run. Must not be
+  // called from one of the workers.
+  void Flush();
+
+  size_t num_workers() const { return workers_.size(); }
+
+ private:
+  std::vector<std::unique_ptr<rtc::TaskQueue>> workers_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(MediaCryptoWorkerPool);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_RTP_RTCP_INCLUDE_MEDIA_CRYPTO_WORKER_POOL_H_
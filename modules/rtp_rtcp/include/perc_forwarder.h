@@ -0,0 +1,95 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_RTP_RTCP_INCLUDE_PERC_FORWARDER_H_
+#define WEBRTC_MODULES_RTP_RTCP_INCLUDE_PERC_FORWARDER_H_
+
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_header_extension.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+// Selective forwarding of one sender's video to one receiver, for the media
+// distributor side of PERC. The distributor only reads the outer RTP header
+// and the FrameMarking extension: the original sequence number, timestamp and
+// SSRC travel in the OHB of the inner encrypted payload, so the outer fields
+// can be rewritten freely without touching the payload.
+//
+// Packets are expected with the outer SRTP already removed. Forwarded packets
+// are rewritten in place and still need the receiver's outer SRTP applied.
+// Sequence numbers are kept contiguous across dropped layers assuming the
+// forwarded stream arrives in order, which is what the sender's pacer emits.
+class PercForwarder {
+ public:
+  // |simulcast_ssrcs| lists the sender's streams, from the lowest to the
+  // highest quality. Forwarded packets all carry |output_ssrc|.
+  PercForwarder(const RtpHeaderExtensionMap& extensions,
+                const std::vector<uint32_t>& simulcast_ssrcs,
+                uint32_t output_ssrc);
+  ~PercForwarder();
+
+  // Selects the simulcast stream, as an index into |simulcast_ssrcs|, and the
+  // highest temporal layer to forward. Moving to another stream waits for an
+  // independent frame on it, and moving up a temporal layer waits for a base
+  // layer sync frame; moving down takes effect at the next frame.
+  void SetTargetLayers(size_t stream_index, uint8_t max_temporal_layer);
+
+  // Returns true if the RTP packet in |data| must be sent to the receiver, in
+  // which case its sequence number, timestamp and SSRC have been rewritten.
+  // |arrival_time_ms| is used to continue the timestamps across a stream
+  // switch.
+  bool ForwardPacket(uint8_t* data, size_t length, int64_t arrival_time_ms);
+
+  // True while waiting for an independent frame on the target stream; the
+  // distributor should ask the sender for one.
+  bool NeedsKeyFrame() const { return target_stream_ != current_stream_; }
+
+  size_t packets_forwarded() const { return packets_forwarded_; }
+  size_t packets_dropped() const { return packets_dropped_; }
+
+ private:
+  static constexpr size_t kNoStream = static_cast<size_t>(-1);
+
+  size_t StreamIndex(uint32_t ssrc) const;
+  void SwitchToStream(size_t stream_index,
+                      uint16_t sequence_number,
+                      uint32_t timestamp,
+                      int64_t arrival_time_ms);
+
+  // Not const since RtpHeaderParser::Parse takes a mutable map.
+  RtpHeaderExtensionMap extensions_;
+  const std::vector<uint32_t> simulcast_ssrcs_;
+  const uint32_t output_ssrc_;
+
+  size_t target_stream_;
+  uint8_t target_temporal_layer_;
+  size_t current_stream_;
+  uint8_t current_temporal_layer_;
+
+  // Added to the sequence numbers and timestamps of |current_stream_|.
+  uint16_t sequence_number_offset_;
+  uint32_t timestamp_offset_;
+  bool has_forwarded_;
+  uint16_t last_sequence_number_;
+  uint32_t last_timestamp_;
+  int64_t last_arrival_time_ms_;
+
+  size_t packets_forwarded_;
+  size_t packets_dropped_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(PercForwarder);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_RTP_RTCP_INCLUDE_PERC_FORWARDER_H_
@@ -12,6 +12,7 @@
 #define WEBRTC_MODULES_RTP_RTCP_INCLUDE_RTP_RECEIVER_H_
 
 #include "webrtc/config.h"
+#include "webrtc/modules/rtp_rtcp/include/media_crypto_context.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "webrtc/typedefs.h"
 
@@ -93,6 +94,34 @@ class RtpReceiver {
   
   // Double PERC stuff
   virtual bool EnableMediaCrypto(const MediaCryptoKey &key) = 0;
+  // Same as above, but shares |context| with the other streams using it.
+  // |context| must outlive the receiver.
+  virtual bool EnableMediaCrypto(MediaCryptoContext* context) = 0;
+
+  // The inner PERC cipher is created when the first packet is received. Call
+  // to create it right away, for streams where the first frame latency
+  // matters.
+  virtual bool PrewarmMediaCrypto() = 0;
+  // Adds |key| for an upcoming key rotation. Packets protected with either
+  // the previous key or |key| are decrypted, picked by their key id.
+  virtual bool UpdateMediaCryptoKey(const MediaCryptoKey& key) = 0;
+
+  // Returns the number of payload bytes copied while decrypting the inner
+  // PERC layer.
+  virtual size_t MediaCryptoBytesCopied() const = 0;
+
+  // Returns the name of the cipher backend decrypting the inner PERC layer,
+  // or nullptr if media crypto is not enabled.
+  virtual const char* MediaCryptoCipherName() const = 0;
+
+  // Returns the cost of the inner PERC layer on the received packets, or
+  // false if media crypto is not enabled.
+  virtual bool GetMediaCryptoStats(MediaCryptoStats* stats) const = 0;
+
+  // When set, packets whose FrameMarking places them above the base temporal
+  // layer are not decrypted and are passed on without payload, like padding,
+  // so the inner cipher only runs on the frames that will be decoded.
+  virtual void SetDecryptBaseLayerOnly(bool base_layer_only) = 0;
 };
 }  // namespace webrtc
 
@@ -21,6 +21,8 @@
 #include "webrtc/base/optional.h"
 #include "webrtc/modules/include/module.h"
 #include "webrtc/modules/rtp_rtcp/include/flexfec_sender.h"
+#include "webrtc/modules/rtp_rtcp/include/media_crypto_context.h"
+#include "webrtc/modules/rtp_rtcp/include/media_crypto_worker_pool.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 
 namespace webrtc {
@@ -96,6 +98,15 @@ class RtpRtcp : public Module {
     // End to end media encryption
     bool media_crypto_enabled = false;
     const MediaCryptoKey* media_crypto_key;
+    // Optional context shared with other streams using the same key, used
+    // instead of |media_crypto_key| when set. Must outlive the module.
+    MediaCryptoContext* media_crypto_context = nullptr;
+    // Media crypto ciphers are created when the first packet is sent. Set to
+    // create it with the module instead, to keep it off the first frame path.
+    bool media_crypto_prewarm = false;
+    // Optional pool used to encrypt and send video frames off the encoder
+    // thread. Must outlive the module.
+    MediaCryptoWorkerPool* media_crypto_worker_pool = nullptr;
 
    private:
     RTC_DISALLOW_COPY_AND_ASSIGN(Configuration);
@@ -331,6 +342,10 @@ class RtpRtcp : public Module {
       StreamDataCounters* rtp_counters,
       StreamDataCounters* rtx_counters) const = 0;
 
+  // Returns the cost of the inner PERC layer on the sent packets, or false if
+  // media crypto is not enabled.
+  virtual bool GetMediaCryptoStats(MediaCryptoStats* stats) const = 0;
+
   // Returns packet loss statistics for the RTP stream.
   virtual void GetRtpPacketLossStats(
       bool outgoing,
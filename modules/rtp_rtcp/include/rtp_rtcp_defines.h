@@ -229,6 +229,11 @@ class RtcpIntraFrameObserver {
   virtual void OnReceivedRPSI(uint32_t ssrc,
                               uint64_t picture_id) = 0;
 
+  // The remote end asked to stop (|paused| true) or resume sending |ssrc|, by
+  // a TMMBR of zero bitrate or of any other bitrate respectively. Used by the
+  // PERC media distributor when a simulcast stream has no subscribers.
+  virtual void OnReceivedPauseRequest(uint32_t ssrc, bool paused) {}
+
   virtual ~RtcpIntraFrameObserver() {}
 };
 
@@ -390,6 +395,26 @@ class RtpPacketSender {
                             int64_t capture_time_ms,
                             size_t bytes,
                             bool retransmission) = 0;
+
+  struct PacketToInsert {
+    uint32_t ssrc;
+    uint16_t sequence_number;
+    int64_t capture_time_ms;
+    size_t bytes;
+  };
+  // Same as calling InsertPacket for each of |packets|, in order. Senders
+  // which lock on insertion should override it and lock only once.
+  virtual void InsertPackets(Priority priority,
+                             const std::vector<PacketToInsert>& packets,
+                             bool retransmission) {
+    for (const PacketToInsert& packet : packets) {
+      InsertPacket(priority, packet.ssrc, packet.sequence_number,
+                   packet.capture_time_ms, packet.bytes, retransmission);
+    }
+  }
+  // Returns the number of milliseconds it will take to send the packets
+  // currently queued, 0 for senders that don't queue.
+  virtual int64_t ExpectedQueueTimeMs() const { return 0; }
 };
 
 class TransportSequenceNumberAllocator {
@@ -148,6 +148,7 @@ class MockRtpRtcp : public RtpRtcp {
                      int32_t(size_t* bytes_sent, uint32_t* packets_sent));
   MOCK_CONST_METHOD2(GetSendStreamDataCounters,
                      void(StreamDataCounters*, StreamDataCounters*));
+  MOCK_CONST_METHOD1(GetMediaCryptoStats, bool(MediaCryptoStats*));
   MOCK_CONST_METHOD3(GetRtpPacketLossStats,
                      void(bool, uint32_t, struct RtpPacketLossStats*));
   MOCK_METHOD1(RemoteRTCPStat, int32_t(RTCPSenderInfo* sender_info));
@@ -0,0 +1,69 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/rtp_rtcp/source/fec_xor.h"
+
+#include <string.h>
+
+#include "webrtc/system_wrappers/include/cpu_features_wrapper.h"
+
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+#include "webrtc/modules/rtp_rtcp/source/fec_xor_avx2.h"
+#include "webrtc/modules/rtp_rtcp/source/fec_xor_sse2.h"
+#elif defined(WEBRTC_HAS_NEON)
+#include "webrtc/modules/rtp_rtcp/source/fec_xor_neon.h"
+#endif
+
+namespace webrtc {
+namespace {
+
+using FecXorProc = void (*)(const uint8_t* src, size_t length, uint8_t* dst);
+
+FecXorProc SelectFecXor() {
+#if defined(WEBRTC_ARCH_X86_FAMILY)
+  if (WebRtc_GetCPUInfo(kAVX2))
+    return &FecXor_AVX2;
+#if defined(__SSE2__)
+  return &FecXor_SSE2;
+#else
+  // x86 CPU detection required.
+  return WebRtc_GetCPUInfo(kSSE2) ? &FecXor_SSE2 : &FecXor_C;
+#endif
+#elif defined(WEBRTC_HAS_NEON)
+  return &FecXor_NEON;
+#else
+  return &FecXor_C;
+#endif
+}
+
+}  // namespace
+
+void FecXor(const uint8_t* src, size_t length, uint8_t* dst) {
+  // Thread-safe initialization, FEC is generated on several threads.
+  static const FecXorProc xor_proc = SelectFecXor();
+  xor_proc(src, length, dst);
+}
+
+void FecXor_C(const uint8_t* src, size_t length, uint8_t* dst) {
+  // A word at a time, memcpy keeps unaligned accesses well defined.
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t)) {
+    uint64_t a;
+    uint64_t b;
+    memcpy(&a, src + i, sizeof(a));
+    memcpy(&b, dst + i, sizeof(b));
+    a ^= b;
+    memcpy(dst + i, &a, sizeof(a));
+  }
+  for (; i < length; ++i)
+    dst[i] ^= src[i];
+}
+
+}  // namespace webrtc
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/rtp_rtcp/source/fec_xor.h"
+
+#include <vector>
+
+#include "webrtc/base/random.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kMaxLength = 1500;
+// Not a multiple of any vector width, to cover the scalar tails too.
+constexpr size_t kLengths[] = {0, 1, 7, 15, 16, 17, 31, 33, 100, 1199, 1500};
+
+using FecXorProc = void (*)(const uint8_t* src, size_t length, uint8_t* dst);
+
+// Checks |xor_proc| against a plain byte loop, at every alignment.
+void ExpectXorsCorrectly(FecXorProc xor_proc) {
+  Random random(0x1234);
+  std::vector<uint8_t> src(kMaxLength + 32);
+  std::vector<uint8_t> dst(kMaxLength + 32);
+  for (uint8_t& byte : src)
+    byte = random.Rand<uint8_t>();
+  for (uint8_t& byte : dst)
+    byte = random.Rand<uint8_t>();
+
+  for (size_t length : kLengths) {
+    for (size_t offset = 0; offset < 32; offset += 3) {
+      std::vector<uint8_t> expected = dst;
+      for (size_t i = 0; i < length; ++i)
+        expected[offset + i] ^= src[offset + i];
+      std::vector<uint8_t> actual = dst;
+      xor_proc(&src[offset], length, &actual[offset]);
+      EXPECT_EQ(expected, actual) << "length " << length << ", offset "
+                                  << offset;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(FecXorTest, PortableVersion) {
+  ExpectXorsCorrectly(&FecXor_C);
+}
+
+TEST(FecXorTest, FastestVersion) {
+  ExpectXorsCorrectly(&FecXor);
+}
+
+}  // namespace webrtc
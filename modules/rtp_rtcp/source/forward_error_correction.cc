@@ -20,6 +20,7 @@
 #include "webrtc/base/logging.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "webrtc/modules/rtp_rtcp/source/byte_io.h"
+#include "webrtc/modules/rtp_rtcp/source/fec_xor.h"
 #include "webrtc/modules/rtp_rtcp/source/flexfec_header_reader_writer.h"
 #include "webrtc/modules/rtp_rtcp/source/forward_error_correction_internal.h"
 #include "webrtc/modules/rtp_rtcp/source/ulpfec_header_reader_writer.h"
@@ -29,6 +30,21 @@ namespace webrtc {
 namespace {
 // Transport header size in bytes. Assume UDP/IPv4 as a reasonable minimum.
 constexpr size_t kTransportOverhead = 28;
+
+// Returns true if none of the media packets after |media_pkt_idx| is
+// protected by |packet_mask|.
+bool IsLastProtectedPacket(const uint8_t* packet_mask,
+                           size_t packet_mask_size,
+                           size_t media_pkt_idx) {
+  const size_t byte_idx = media_pkt_idx / 8;
+  if (packet_mask[byte_idx] & (0xff >> (media_pkt_idx % 8 + 1)))
+    return false;
+  for (size_t i = byte_idx + 1; i < packet_mask_size; ++i) {
+    if (packet_mask[i])
+      return false;
+  }
+  return true;
+}
 }  // namespace
 
 ForwardErrorCorrection::Packet::Packet() : length(0), data(), ref_count_(0) {}
@@ -53,7 +69,7 @@ int32_t ForwardErrorCorrection::Packet::Release() {
 template <typename S, typename T>
 bool ForwardErrorCorrection::SortablePacket::LessThan::operator() (
     const S& first,
-    const T& second) {
+    const T& second) const {
   return IsNewerSequenceNumber(second->seq_num, first->seq_num);
 }
 
@@ -75,7 +91,12 @@ ForwardErrorCorrection::ForwardErrorCorrection(
     : fec_header_reader_(std::move(fec_header_reader)),
       fec_header_writer_(std::move(fec_header_writer)),
       generated_fec_packets_(fec_header_writer_->MaxFecPackets()),
-      packet_mask_size_(0) {}
+      packet_mask_size_(0),
+      fec_group_num_media_packets_(0),
+      fec_group_num_fec_packets_(0),
+      fec_group_num_added_(0),
+      fec_group_ssrc_(0),
+      fec_group_seq_num_base_(0) {}
 
 ForwardErrorCorrection::~ForwardErrorCorrection() = default;
 
@@ -170,6 +191,94 @@ int ForwardErrorCorrection::EncodeFec(const PacketList& media_packets,
   return 0;
 }
 
+int ForwardErrorCorrection::StartFecGroup(size_t num_media_packets,
+                                          uint8_t protection_factor,
+                                          FecMaskType fec_mask_type) {
+  RTC_DCHECK_GT(num_media_packets, 0);
+  fec_group_num_media_packets_ = 0;
+  fec_group_num_fec_packets_ = 0;
+  fec_group_num_added_ = 0;
+  const size_t max_media_packets = fec_header_writer_->MaxMediaPackets();
+  if (num_media_packets > max_media_packets) {
+    LOG(LS_WARNING) << "Can't protect " << num_media_packets
+                    << " media packets per frame. Max is " << max_media_packets
+                    << ".";
+    return -1;
+  }
+
+  int num_fec_packets = NumFecPackets(num_media_packets, protection_factor);
+  if (num_fec_packets == 0) {
+    return 0;
+  }
+  for (int i = 0; i < num_fec_packets; ++i) {
+    memset(generated_fec_packets_[i].data, 0, IP_PACKET_SIZE);
+    generated_fec_packets_[i].length = 0;
+  }
+
+  const internal::PacketMaskTable mask_table(fec_mask_type, num_media_packets);
+  packet_mask_size_ = internal::PacketMaskSize(num_media_packets);
+  memset(packet_masks_, 0, num_fec_packets * packet_mask_size_);
+  constexpr int kNumImportantPackets = 0;
+  constexpr bool kUseUnequalProtection = false;
+  internal::GeneratePacketMasks(num_media_packets, num_fec_packets,
+                                kNumImportantPackets, kUseUnequalProtection,
+                                mask_table, packet_masks_);
+
+  fec_group_num_media_packets_ = num_media_packets;
+  fec_group_num_fec_packets_ = num_fec_packets;
+  return num_fec_packets;
+}
+
+int ForwardErrorCorrection::AddMediaPacketToFecGroup(
+    const Packet& media_packet,
+    std::list<Packet*>* fec_packets) {
+  if (fec_group_num_added_ == fec_group_num_media_packets_) {
+    return -1;
+  }
+  if (media_packet.length < kRtpHeaderSize) {
+    LOG(LS_WARNING) << "Media packet " << media_packet.length << " bytes "
+                    << "is smaller than RTP header.";
+    fec_group_num_media_packets_ = 0;
+    return -1;
+  }
+  // TODO(brandtr): Generalize this when multistream protection support is
+  // added.
+  const uint16_t seq_num = ByteReader<uint16_t>::ReadBigEndian(
+      &media_packet.data[2]);
+  if (fec_group_num_added_ == 0) {
+    fec_group_ssrc_ = ByteReader<uint32_t>::ReadBigEndian(
+        &media_packet.data[8]);
+    fec_group_seq_num_base_ = seq_num;
+  } else if (seq_num != static_cast<uint16_t>(fec_group_seq_num_base_ +
+                                              fec_group_num_added_)) {
+    fec_group_num_media_packets_ = 0;
+    return -1;
+  }
+
+  const size_t media_pkt_idx = fec_group_num_added_++;
+  const uint8_t media_pkt_bit = 1 << (7 - media_pkt_idx % 8);
+  for (size_t i = 0; i < fec_group_num_fec_packets_; ++i) {
+    const uint8_t* packet_mask = &packet_masks_[i * packet_mask_size_];
+    if (!(packet_mask[media_pkt_idx / 8] & media_pkt_bit)) {
+      continue;
+    }
+    Packet* const fec_packet = &generated_fec_packets_[i];
+    const size_t min_packet_mask_size =
+        fec_header_writer_->MinPacketMaskSize(packet_mask, packet_mask_size_);
+    XorMediaPacket(media_packet,
+                   fec_header_writer_->FecHeaderSize(min_packet_mask_size),
+                   fec_packet);
+    if (IsLastProtectedPacket(packet_mask, packet_mask_size_, media_pkt_idx)) {
+      fec_header_writer_->FinalizeFecHeader(fec_group_ssrc_,
+                                            fec_group_seq_num_base_,
+                                            packet_mask, packet_mask_size_,
+                                            fec_packet);
+      fec_packets->push_back(fec_packet);
+    }
+  }
+  return 0;
+}
+
 int ForwardErrorCorrection::NumFecPackets(int num_media_packets,
                                           int protection_factor) {
   // Result in Q0 with an unsigned round.
@@ -201,34 +310,7 @@ void ForwardErrorCorrection::GenerateFecPayloads(
       Packet* const media_packet = media_packets_it->get();
       // Should |media_packet| be protected by |fec_packet|?
       if (packet_masks_[pkt_mask_idx] & (1 << (7 - media_pkt_idx))) {
-        size_t media_payload_length = media_packet->length - kRtpHeaderSize;
-
-        bool first_protected_packet = (fec_packet->length == 0);
-        size_t fec_packet_length = fec_header_size + media_payload_length;
-        if (fec_packet_length > fec_packet->length) {
-          // Recall that XORing with zero (which the FEC packets are prefilled
-          // with) is the identity operator, thus all prior XORs are
-          // still correct even though we expand the packet length here.
-          fec_packet->length = fec_packet_length;
-        }
-        if (first_protected_packet) {
-          // Write P, X, CC, M, and PT recovery fields.
-          // Note that bits 0, 1, and 16 are overwritten in FinalizeFecHeaders.
-          memcpy(&fec_packet->data[0], &media_packet->data[0], 2);
-          // Write length recovery field. (This is a temporary location for
-          // ULPFEC.)
-          ByteWriter<uint16_t>::WriteBigEndian(&fec_packet->data[2],
-                                               media_payload_length);
-          // Write timestamp recovery field.
-          memcpy(&fec_packet->data[4], &media_packet->data[4], 4);
-          // Write payload.
-          memcpy(&fec_packet->data[fec_header_size],
-                 &media_packet->data[kRtpHeaderSize], media_payload_length);
-        } else {
-          XorHeaders(*media_packet, fec_packet);
-          XorPayloads(*media_packet, media_payload_length, fec_header_size,
-                      fec_packet);
-        }
+        XorMediaPacket(*media_packet, fec_header_size, fec_packet);
       }
       media_packets_it++;
       if (media_packets_it != media_packets.end()) {
@@ -244,6 +326,39 @@ void ForwardErrorCorrection::GenerateFecPayloads(
   }
 }
 
+void ForwardErrorCorrection::XorMediaPacket(const Packet& media_packet,
+                                            size_t fec_header_size,
+                                            Packet* fec_packet) {
+  size_t media_payload_length = media_packet.length - kRtpHeaderSize;
+
+  bool first_protected_packet = (fec_packet->length == 0);
+  size_t fec_packet_length = fec_header_size + media_payload_length;
+  if (fec_packet_length > fec_packet->length) {
+    // Recall that XORing with zero (which the FEC packets are prefilled
+    // with) is the identity operator, thus all prior XORs are
+    // still correct even though we expand the packet length here.
+    fec_packet->length = fec_packet_length;
+  }
+  if (first_protected_packet) {
+    // Write P, X, CC, M, and PT recovery fields.
+    // Note that bits 0, 1, and 16 are overwritten in FinalizeFecHeaders.
+    memcpy(&fec_packet->data[0], &media_packet.data[0], 2);
+    // Write length recovery field. (This is a temporary location for
+    // ULPFEC.)
+    ByteWriter<uint16_t>::WriteBigEndian(&fec_packet->data[2],
+                                         media_payload_length);
+    // Write timestamp recovery field.
+    memcpy(&fec_packet->data[4], &media_packet.data[4], 4);
+    // Write payload.
+    memcpy(&fec_packet->data[fec_header_size],
+           &media_packet.data[kRtpHeaderSize], media_payload_length);
+  } else {
+    XorHeaders(media_packet, fec_packet);
+    XorPayloads(media_packet, media_payload_length, fec_header_size,
+                fec_packet);
+  }
+}
+
 int ForwardErrorCorrection::InsertZerosInPacketMasks(
     const PacketList& media_packets,
     size_t num_fec_packets) {
@@ -330,6 +445,8 @@ void ForwardErrorCorrection::ResetState(
   // Free the memory for any existing recovered packets, if the caller hasn't.
   recovered_packets->clear();
   received_fec_packets_.clear();
+  fec_packets_by_protected_seq_num_.clear();
+  fec_packets_to_check_.clear();
 }
 
 void ForwardErrorCorrection::InsertMediaPacket(
@@ -362,17 +479,40 @@ void ForwardErrorCorrection::InsertMediaPacket(
 
 void ForwardErrorCorrection::UpdateCoveringFecPackets(
     const RecoveredPacket& packet) {
-  for (auto& fec_packet : received_fec_packets_) {
-    // Is this FEC packet protecting the media packet |packet|?
+  auto range = fec_packets_by_protected_seq_num_.equal_range(packet.seq_num);
+  for (auto it = range.first; it != range.second; ++it) {
+    ReceivedFecPacket* fec_packet = it->second;
     auto protected_it = std::lower_bound(fec_packet->protected_packets.begin(),
                                          fec_packet->protected_packets.end(),
                                          &packet, SortablePacket::LessThan());
-    if (protected_it != fec_packet->protected_packets.end() &&
-        (*protected_it)->seq_num == packet.seq_num) {
-      // Found an FEC packet which is protecting |packet|.
-      (*protected_it)->pkt = packet.pkt;
+    RTC_DCHECK(protected_it != fec_packet->protected_packets.end());
+    RTC_DCHECK_EQ((*protected_it)->seq_num, packet.seq_num);
+    (*protected_it)->pkt = packet.pkt;
+    fec_packets_to_check_.insert(fec_packet);
+  }
+}
+
+void ForwardErrorCorrection::EraseFecPacket(
+    const ReceivedFecPacket* fec_packet) {
+  for (const auto& protected_packet : fec_packet->protected_packets) {
+    auto range =
+        fec_packets_by_protected_seq_num_.equal_range(protected_packet->seq_num);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second == fec_packet) {
+        fec_packets_by_protected_seq_num_.erase(it);
+        break;
+      }
     }
   }
+  fec_packets_to_check_.erase(const_cast<ReceivedFecPacket*>(fec_packet));
+  auto it = std::find_if(received_fec_packets_.begin(),
+                         received_fec_packets_.end(),
+                         [fec_packet](const std::unique_ptr<ReceivedFecPacket>&
+                                          received_fec_packet) {
+                           return received_fec_packet.get() == fec_packet;
+                         });
+  RTC_DCHECK(it != received_fec_packets_.end());
+  received_fec_packets_.erase(it);
 }
 
 void ForwardErrorCorrection::InsertFecPacket(
@@ -417,6 +557,11 @@ void ForwardErrorCorrection::InsertFecPacket(
     LOG(LS_WARNING) << "Received FEC packet has an all-zero packet mask.";
   } else {
     AssignRecoveredPackets(recovered_packets, fec_packet.get());
+    for (const auto& protected_packet : fec_packet->protected_packets) {
+      fec_packets_by_protected_seq_num_.insert(
+          std::make_pair(protected_packet->seq_num, fec_packet.get()));
+    }
+    fec_packets_to_check_.insert(fec_packet.get());
     // TODO(holmer): Consider replacing this with a binary search for the right
     // position, and then just insert the new packet. Would get rid of the sort.
     //
@@ -428,7 +573,7 @@ void ForwardErrorCorrection::InsertFecPacket(
     received_fec_packets_.sort(SortablePacket::LessThan());
     const size_t max_fec_packets = fec_header_reader_->MaxFecPackets();
     if (received_fec_packets_.size() > max_fec_packets) {
-      received_fec_packets_.pop_front();
+      EraseFecPacket(received_fec_packets_.front().get());
     }
     RTC_DCHECK_LE(received_fec_packets_.size(), max_fec_packets);
   }
@@ -479,7 +624,7 @@ void ForwardErrorCorrection::InsertPackets(
           abs(static_cast<int>(received_packet->seq_num) -
               static_cast<int>(received_fec_packets_.front()->seq_num));
       if (seq_num_diff > 0x3fff) {
-        received_fec_packets_.pop_front();
+        EraseFecPacket(received_fec_packets_.front().get());
       }
     }
 
@@ -580,9 +725,7 @@ void ForwardErrorCorrection::XorPayloads(const Packet& src,
   // XOR the payload.
   RTC_DCHECK_LE(kRtpHeaderSize + payload_length, sizeof(src.data));
   RTC_DCHECK_LE(dst_offset + payload_length, sizeof(dst->data));
-  for (size_t i = 0; i < payload_length; ++i) {
-    dst->data[dst_offset + i] ^= src.data[kRtpHeaderSize + i];
-  }
+  FecXor(&src.data[kRtpHeaderSize], payload_length, &dst->data[dst_offset]);
 }
 
 bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
@@ -608,45 +751,38 @@ bool ForwardErrorCorrection::RecoverPacket(const ReceivedFecPacket& fec_packet,
 
 void ForwardErrorCorrection::AttemptRecovery(
     RecoveredPacketList* recovered_packets) {
-  auto fec_packet_it = received_fec_packets_.begin();
-  while (fec_packet_it != received_fec_packets_.end()) {
-    // Search for each FEC packet's protected media packets.
-    int packets_missing = NumCoveredPacketsMissing(**fec_packet_it);
+  // Only FEC packets that are new, or that had a protected packet arrive, can
+  // have become able to recover a packet. A recovered packet in turn queues
+  // the FEC packets covering it.
+  while (!fec_packets_to_check_.empty()) {
+    ReceivedFecPacket* fec_packet = *fec_packets_to_check_.begin();
+    fec_packets_to_check_.erase(fec_packets_to_check_.begin());
+    int packets_missing = NumCoveredPacketsMissing(*fec_packet);
 
     // We can only recover one packet with an FEC packet.
+    if (packets_missing > 1)
+      continue;
     if (packets_missing == 1) {
       // Recovery possible.
       std::unique_ptr<RecoveredPacket> recovered_packet(new RecoveredPacket());
       recovered_packet->pkt = nullptr;
-      if (!RecoverPacket(**fec_packet_it, recovered_packet.get())) {
-        // Can't recover using this packet, drop it.
-        fec_packet_it = received_fec_packets_.erase(fec_packet_it);
-        continue;
+      if (RecoverPacket(*fec_packet, recovered_packet.get())) {
+        auto recovered_packet_ptr = recovered_packet.get();
+        // Add recovered packet to the list of recovered packets and update any
+        // FEC packets covering this packet with a pointer to the data.
+        // TODO(holmer): Consider replacing this with a binary search for the
+        // right position, and then just insert the new packet. Would get rid
+        // of the sort.
+        recovered_packets->push_back(std::move(recovered_packet));
+        recovered_packets->sort(SortablePacket::LessThan());
+        UpdateCoveringFecPackets(*recovered_packet_ptr);
+        DiscardOldRecoveredPackets(recovered_packets);
       }
-
-      auto recovered_packet_ptr = recovered_packet.get();
-      // Add recovered packet to the list of recovered packets and update any
-      // FEC packets covering this packet with a pointer to the data.
-      // TODO(holmer): Consider replacing this with a binary search for the
-      // right position, and then just insert the new packet. Would get rid of
-      // the sort.
-      recovered_packets->push_back(std::move(recovered_packet));
-      recovered_packets->sort(SortablePacket::LessThan());
-      UpdateCoveringFecPackets(*recovered_packet_ptr);
-      DiscardOldRecoveredPackets(recovered_packets);
-      fec_packet_it = received_fec_packets_.erase(fec_packet_it);
-
-      // A packet has been recovered. We need to check the FEC list again, as
-      // this may allow additional packets to be recovered.
-      // Restart for first FEC packet.
-      fec_packet_it = received_fec_packets_.begin();
-    } else if (packets_missing == 0) {
-      // Either all protected packets arrived or have been recovered. We can
-      // discard this FEC packet.
-      fec_packet_it = received_fec_packets_.erase(fec_packet_it);
-    } else {
-      fec_packet_it++;
     }
+    // Either a packet was recovered, the recovery failed, or all protected
+    // packets arrived or have been recovered. In all cases we are done with
+    // this FEC packet.
+    EraseFecPacket(fec_packet);
   }
 }
 
@@ -14,7 +14,9 @@
 #include <stdint.h>
 
 #include <list>
+#include <map>
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "webrtc/base/basictypes.h"
@@ -65,7 +67,7 @@ class ForwardErrorCorrection {
     // is < the sequence number of |second|.
     struct LessThan {
       template <typename S, typename T>
-      bool operator() (const S& first, const T& second);
+      bool operator() (const S& first, const T& second) const;
     };
 
     uint16_t seq_num;
@@ -196,6 +198,26 @@ class ForwardErrorCorrection {
                 FecMaskType fec_mask_type,
                 std::list<Packet*>* fec_packets);
 
+  // Incremental version of EncodeFec(), without unequal protection, for
+  // |num_media_packets| media packets with consecutive sequence numbers. The
+  // packet masks are chosen up front, so each FEC packet is complete as soon
+  // as the last media packet it protects has been added with
+  // AddMediaPacketToFecGroup(), instead of after the whole group.
+  //
+  // Returns the number of FEC packets the group will produce, -1 on failure.
+  int StartFecGroup(size_t num_media_packets,
+                    uint8_t protection_factor,
+                    FecMaskType fec_mask_type);
+
+  // Adds the next media packet of the group started by StartFecGroup() and
+  // appends the FEC packets it completes to |fec_packets|. Their memory is
+  // valid until the next call to StartFecGroup() or EncodeFec().
+  //
+  // Returns 0 on success, -1 if |media_packet| is not the next one of the
+  // group. The FEC packets not completed yet are then lost.
+  int AddMediaPacketToFecGroup(const Packet& media_packet,
+                               std::list<Packet*>* fec_packets);
+
   // Decodes a list of received media and FEC packets. It will parse the
   // |received_packets|, storing FEC packets internally, and move
   // media packets to |recovered_packets|. The recovered list will be
@@ -258,6 +280,12 @@ class ForwardErrorCorrection {
   void GenerateFecPayloads(const PacketList& media_packets,
                            size_t num_fec_packets);
 
+  // Adds |media_packet| to the recovery fields and payload of |fec_packet|,
+  // whose FEC header is |fec_header_size| bytes.
+  static void XorMediaPacket(const Packet& media_packet,
+                             size_t fec_header_size,
+                             Packet* fec_packet);
+
   // Writes the FEC header fields that are not written by GenerateFecPayloads.
   // This includes writing the packet masks.
   void FinalizeFecHeaders(size_t num_fec_packets,
@@ -280,6 +308,10 @@ class ForwardErrorCorrection {
   // packets covered by the FEC packet.
   void UpdateCoveringFecPackets(const RecoveredPacket& packet);
 
+  // Removes |fec_packet| from |received_fec_packets_| and from the lookup
+  // structures that refer to it.
+  void EraseFecPacket(const ReceivedFecPacket* fec_packet);
+
   // Insert |received_packet| into internal FEC list. Deletes duplicates.
   void InsertFecPacket(const RecoveredPacketList& recovered_packets,
                        ReceivedPacket* received_packet);
@@ -335,6 +367,13 @@ class ForwardErrorCorrection {
 
   std::vector<Packet> generated_fec_packets_;
   ReceivedFecPacketList received_fec_packets_;
+  // The packets of |received_fec_packets_| by the sequence numbers of the
+  // media packets they protect, so that a received or recovered media packet
+  // only has to update the FEC packets covering it.
+  std::multimap<uint16_t, ReceivedFecPacket*> fec_packets_by_protected_seq_num_;
+  // FEC packets which were received, or had a protected packet arrive, since
+  // AttemptRecovery() last looked at them. Oldest first.
+  std::set<ReceivedFecPacket*, SortablePacket::LessThan> fec_packets_to_check_;
 
   // Arrays used to avoid dynamically allocating memory when generating
   // the packet masks.
@@ -342,6 +381,13 @@ class ForwardErrorCorrection {
   uint8_t packet_masks_[kUlpfecMaxMediaPackets * kUlpfecMaxPacketMaskSize];
   uint8_t tmp_packet_masks_[kUlpfecMaxMediaPackets * kUlpfecMaxPacketMaskSize];
   size_t packet_mask_size_;
+
+  // State of the group started by StartFecGroup().
+  size_t fec_group_num_media_packets_;
+  size_t fec_group_num_fec_packets_;
+  size_t fec_group_num_added_;
+  uint32_t fec_group_ssrc_;
+  uint16_t fec_group_seq_num_base_;
 };
 
 // Classes derived from FecHeader{Reader,Writer} encapsulate the
@@ -179,7 +179,8 @@ FecMaskType PacketMaskTable::InitMaskType(FecMaskType fec_mask_type,
 
 // Returns the pointer to the packet mask tables corresponding to type
 // |fec_mask_type|.
-const uint8_t*** PacketMaskTable::InitMaskTable(FecMaskType fec_mask_type) {
+const uint8_t* const* const* PacketMaskTable::InitMaskTable(
+    FecMaskType fec_mask_type) {
   switch (fec_mask_type) {
     case kFecMaskRandom: {
       return kPacketMaskRandomTbl;
@@ -206,10 +207,8 @@ void RemainingPacketProtection(int num_media_packets,
     const int res_mask_bytes =
         PacketMaskSize(num_media_packets - num_fec_for_imp_packets);
 
-    const uint8_t* packet_mask_sub_21 =
-        mask_table.fec_packet_mask_table()[num_media_packets -
-                                           num_fec_for_imp_packets -
-                                           1][num_fec_remaining - 1];
+    const uint8_t* packet_mask_sub_21 = mask_table.LookUp(
+        num_media_packets - num_fec_for_imp_packets, num_fec_remaining);
 
     ShiftFitSubMask(num_mask_bytes, res_mask_bytes, num_fec_for_imp_packets,
                     (num_fec_for_imp_packets + num_fec_remaining),
@@ -219,8 +218,7 @@ void RemainingPacketProtection(int num_media_packets,
     // sub_mask22
 
     const uint8_t* packet_mask_sub_22 =
-        mask_table.fec_packet_mask_table()[num_media_packets -
-                                           1][num_fec_remaining - 1];
+        mask_table.LookUp(num_media_packets, num_fec_remaining);
 
     FitSubMask(num_mask_bytes, num_mask_bytes, num_fec_remaining,
                packet_mask_sub_22,
@@ -247,8 +245,7 @@ void ImportantPacketProtection(int num_fec_for_imp_packets,
 
   // Get sub_mask1 from table
   const uint8_t* packet_mask_sub_1 =
-      mask_table.fec_packet_mask_table()[num_imp_packets -
-                                         1][num_fec_for_imp_packets - 1];
+      mask_table.LookUp(num_imp_packets, num_fec_for_imp_packets);
 
   FitSubMask(num_mask_bytes, num_imp_mask_bytes, num_fec_for_imp_packets,
              packet_mask_sub_1, packet_mask);
@@ -378,9 +375,7 @@ void GeneratePacketMasks(int num_media_packets,
     // Retrieve corresponding mask table directly:for equal-protection case.
     // Mask = (k,n-k), with protection factor = (n-k)/k,
     // where k = num_media_packets, n=total#packets, (n-k)=num_fec_packets.
-    memcpy(packet_mask,
-           mask_table.fec_packet_mask_table()[num_media_packets -
-                                              1][num_fec_packets - 1],
+    memcpy(packet_mask, mask_table.LookUp(num_media_packets, num_fec_packets),
            num_fec_packets * num_mask_bytes);
   } else {  // UEP case
     UnequalProtectionMask(num_media_packets, num_fec_packets, num_imp_packets,
@@ -35,15 +35,21 @@ class PacketMaskTable {
   PacketMaskTable(FecMaskType fec_mask_type, int num_media_packets);
   ~PacketMaskTable() {}
   FecMaskType fec_mask_type() const { return fec_mask_type_; }
-  const uint8_t*** fec_packet_mask_table() const {
+  const uint8_t* const* const* fec_packet_mask_table() const {
     return fec_packet_mask_table_;
   }
+  // Returns the equal protection mask of |num_fec_packets| FEC packets for
+  // |num_media_packets| media packets, PacketMaskSize(num_media_packets) bytes
+  // per FEC packet. Points into the constant tables, so nothing is copied.
+  const uint8_t* LookUp(int num_media_packets, int num_fec_packets) const {
+    return fec_packet_mask_table_[num_media_packets - 1][num_fec_packets - 1];
+  }
 
  private:
   FecMaskType InitMaskType(FecMaskType fec_mask_type, int num_media_packets);
-  const uint8_t*** InitMaskTable(FecMaskType fec_mask_type_);
+  const uint8_t* const* const* InitMaskTable(FecMaskType fec_mask_type_);
   const FecMaskType fec_mask_type_;
-  const uint8_t*** fec_packet_mask_table_;
+  const uint8_t* const* const* fec_packet_mask_table_;
 };
 
 // Returns an array of packet masks. The mask of a single FEC packet
@@ -1,320 +1,402 @@
-/*
- *  Copyright 2009 The WebRTC project authors. All Rights Reserved.
- *
- *  Use of this source code is governed by a BSD-style license
- *  that can be found in the LICENSE file in the root of the source
- *  tree. An additional intellectual property rights grant can be found
- *  in the file PATENTS.  All contributing project authors may
- *  be found in the AUTHORS file in the root of the source tree.
- */
-
-#include "webrtc/modules/rtp_rtcp/source/media_crypto.h"
-
-#include <string.h>
-
-#include "third_party/libsrtp/include/srtp.h"
-#include "webrtc/base/base64.h"
-#include "webrtc/base/buffer.h"
-#include "webrtc/base/sslstreamadapter.h"
-#include "webrtc/modules/rtp_rtcp/source/media_crypto.h"
-
-/* OHB data
- *   0                   1                   2                   3
- *   0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
- *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
- *  |M|     PT      |       sequence number         |  timestamp    |
- *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
- *  |                  timestamp                    |  SSRC         |
- *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
- *  |                  SSRC(cont                    |
- *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
- */
-static size_t ohb_size = 11;
-
-namespace webrtc {
-  
-  
-bool MediaCryptoKey::Parse(int crypto_suite, const std::string &str) {
-  size_t len;
-  
-  // Decode 
-  if (!rtc::Base64::DecodeFromArray(
-    str.c_str(),
-    str.length(),
-    rtc::Base64::DecodeOption::DO_STRICT,
-    &buffer,
-    &len)) {
-    LOG(LS_WARNING) << "Error decoding E2E Media Crypto key" << str;
-    return false;
-  }
-  
-  // Check size
-  int expected_key_len;
-  int expected_salt_len;
-  if (!rtc::GetSrtpKeyAndSaltLengths(crypto_suite, &expected_key_len,
-      &expected_salt_len)) {
-    // This should never happen.
-    LOG(LS_WARNING) << "Failed to create MediaCryptoKey: unsupported"
-                    << " cipher_suite without length information"
-                    << crypto_suite;
-    return false;
-  }
-  size_t expected = static_cast<size_t>(expected_key_len + expected_salt_len);
-  if ( buffer.size() != expected) {
-    LOG(LS_WARNING) << "Failed to create SRTP session: invalid key"
-                    << " key length" << buffer.size()
-                    << " expected" << expected;
-    return false;
-  }
-  
-  type = crypto_suite;
-  return true;
-}
-  
-MediaCrypto::MediaCrypto()
-    : session_(nullptr),
-      rtp_auth_tag_len_(0),
-      rtcp_auth_tag_len_(0) {
-}
-
-MediaCrypto::~MediaCrypto() {
-  if (session_) {
-    srtp_dealloc(session_);
-  }
-}
-bool MediaCrypto::SetOutboundKey(const MediaCryptoKey& key) {
-  LOG(LS_ERROR) << "E2E media encryption oubound key set";
-  return SetKey(ssrc_any_outbound, key.type, key.buffer.data(), key.buffer.size());
-}
-
-bool MediaCrypto::SetInboundKey(const MediaCryptoKey& key) {
-  LOG(LS_INFO) << "E2E media encryption inbound key set";
-  return SetKey(ssrc_any_inbound, key.type, key.buffer.data(), key.buffer.size());
-}
-
-bool MediaCrypto::SetKey(int type, int cs, const uint8_t* key, size_t len) {
-
-  if (session_) {
-    LOG(LS_ERROR) << "Failed to create SRTP session: "
-                  << "SRTP session already created";
-    return false;
-  }
-
-  srtp_policy_t policy;
-  memset(&policy, 0, sizeof(policy));
-  if (cs == rtc::SRTP_AES128_CM_SHA1_80) {
-    srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtp);
-    srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
-  } else if (cs == rtc::SRTP_AES128_CM_SHA1_32) {
-    // RTP HMAC is shortened to 32 bits, but RTCP remains 80 bits.
-    srtp_crypto_policy_set_aes_cm_128_hmac_sha1_32(&policy.rtp);
-    srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
-  } else if (cs == rtc::SRTP_AEAD_AES_128_GCM ) {
-    srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtp);
-    srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtcp);
-  } else if (cs == rtc::SRTP_AEAD_AES_256_GCM ) {
-    srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtp);
-    srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtcp);
-  } else {
-    LOG(LS_WARNING) << "Failed to create SRTP session: unsupported"
-                    << " cipher_suite " << cs;
-    return false;
-  }
-
-  int expected_key_len;
-  int expected_salt_len;
-  if (!rtc::GetSrtpKeyAndSaltLengths(cs, &expected_key_len,
-      &expected_salt_len)) {
-    // This should never happen.
-    LOG(LS_WARNING) << "Failed to create SRTP session: unsupported"
-                    << " cipher_suite without length information" << cs;
-    return false;
-  }
-
-  if (!key ||
-      len != static_cast<size_t>(expected_key_len + expected_salt_len)) {
-    LOG(LS_WARNING) << "Failed to create SRTP session: invalid key";
-    return false;
-  }
-
-  policy.ssrc.type = static_cast<srtp_ssrc_type_t>(type);
-  policy.ssrc.value = 0;
-  policy.key = const_cast<uint8_t*>(key);
-  // TODO(astor) parse window size from WSH session-param
-  policy.window_size = 1024;
-  policy.allow_repeat_tx = 1;
-
-  policy.next = nullptr;
-
-  int err = srtp_create(&session_, &policy);
-  if (err != srtp_err_status_ok) {
-    session_ = nullptr;
-    LOG(LS_ERROR) << "Failed to create SRTP session, err=" << err;
-    return false;
-  }
-
-  rtp_auth_tag_len_ = policy.rtp.auth_tag_len;
-  rtcp_auth_tag_len_ = policy.rtcp.auth_tag_len;
-  return true;
-}
-
-bool MediaCrypto::ProtectRtp(void* p, int in_len, int max_len, int* out_len) {
-  if (!session_) {
-    LOG(LS_WARNING) << "Failed to protect SRTP packet: no SRTP Session";
-    return false;
-  }
-
-  int need_len = in_len + rtp_auth_tag_len_;  // NOLINT
-  if (max_len < need_len) {
-    LOG(LS_WARNING) << "Failed to protect SRTP packet: The buffer length "
-                    << max_len << " is less than the needed " << need_len;
-    return false;
-  }
-
-  *out_len = in_len;
-  int err = srtp_protect(session_, p, out_len);
-  if (err != srtp_err_status_ok) {
-    LOG(LS_WARNING) << "Failed to encrypt double packet";
-    return false;
-  }
-  return true;
-}
-
-
-bool MediaCrypto::UnprotectRtp(void* p, int in_len, int* out_len) {
-  
-  if (!session_) {
-    LOG(LS_WARNING) << "Failed to unprotect SRTP packet: no SRTP Session";
-    return false;
-  }
-
-  *out_len = in_len;
-  int err = srtp_unprotect(session_, p, out_len);
-
-  if (err == srtp_err_status_replay_fail) {
-     LOG(LS_WARNING) << "Replay failed";
-  } else if (err != srtp_err_status_ok) {
-    LOG(LS_WARNING) << "Failed to unprotect SRTP packet, err=" << err;
-    return false;
-  }
-  return true;
-}
-
-size_t MediaCrypto::GetEncryptionOverhead()
-{
-	return ohb_size + rtp_auth_tag_len_;
-}
-
-bool MediaCrypto::Encrypt(rtp::Packet *packet)
-{
-  // Calculate payload size for encrypted version
-  size_t encrypted_payload_size = ohb_size + packet->payload_size() + rtp_auth_tag_len_;
-  
-  //Check it is enought
-  if (encrypted_payload_size > packet->MaxPayloadSize()) {
-    LOG(LS_WARNING) << "Failed to perform DOUBLE PERC"
-      << " encrypted size will exceed max payload size available";
-    return false;
-  }
-  // Alloc temporal buffer for encryption
-  size_t size = encrypted_payload_size + 1;
-  uint8_t* inner = (uint8_t*) malloc(size);
-  
-  //Get packet values
-  bool mark = packet->Marker ();
-  uint8_t pt = packet->PayloadType ();
-  uint16_t seq = packet->SequenceNumber();
-  uint32_t ts = packet->Timestamp();
-  uint32_t ssrc = packet->Ssrc();
-  
-  // Innert RTP packet has no padding,csrcs or extensions
-  inner[0] = 0x80;
-  
-  // marker & pt
-  inner[1] = mark ? 0x80 | pt : pt;
-  //SEQ
-  inner[2] = seq >> 8;
-  inner[3] = seq;
-  // TS
-  inner[4] = ts >> 24;
-  inner[5] = ts >> 16;
-  inner[6] = ts >> 8;
-  inner[7] = ts;
-  // SSRC
-  inner[8] = ssrc >> 24;
-  inner[9] = ssrc >> 16;
-  inner[10] = ssrc >> 8;
-  inner[11] = ssrc;
-  
-  //Copy the rest of the payload
-  memcpy(inner + 1 + ohb_size, packet->payload().data(), packet->payload_size());
-
-  // Protect inner rtp packet
-  int out_len;
-  bool result = ProtectRtp(inner,
-                           1 + ohb_size + packet->payload_size(),
-                           size,
-                           &out_len);
-  //Set encrypted payload
-  if (result) {
-    // Allocate new payload size
-    uint8_t* buffer = packet->AllocatePayload(out_len - 1);
-    
-    if (buffer) {
-      // Copy the encrypted inner rtp packet except first byte  of rtp header
-      memcpy(buffer, inner + 1, out_len - 1);
-      // Set new payload size
-      packet->SetPayloadSize(out_len - 1);
-    } else {
-      LOG(LS_WARNING) << "Failed to perform DOUBLE PERC"
-        << " could not allocate payload for encrypted data";
-      result = false;
-    }
-  }
-
-  //Free aux
-  free(inner);
-  
-  return result;
-}
-
-bool MediaCrypto::Decrypt(uint8_t* payload,size_t* payload_length) {
-  //Check we have enought data on payload
-  if (*payload_length < ohb_size + rtp_auth_tag_len_) {
-    LOG(LS_WARNING) << "Failed to perform DOUBLE PERC"
-      << " encrypted payload is smaller than the minimum possible";
-    return false;
-  }
-  
-  // Alloc temporal buffer for decryption
-  uint8_t* inner = (uint8_t*) malloc(*payload_length + 1);
-  
-   // Reconstruct RTP header
-  inner[0] = 0x80;
-  // Copy the rest of the header
-  memcpy(inner + 1, payload, *payload_length);
-
-  // UnProtect inner rtp packet
-  int out_length;
-  bool result = UnprotectRtp(inner,
-                           1 + *payload_length,
-                           &out_length);
-  
-  //Set decyrpted payload
-  if (result) {
-    // Remove the OHB data
-    *payload_length = out_length - ohb_size - 1;
-    // Copy the encrypted inner rtp packet except first byte  of rtp header
-    memcpy(payload, inner + ohb_size + 1, *payload_length);
-  } else {
-      LOG(LS_WARNING) << "Failed to perform DOUBLE PERC";
-      result = false;
-  }
- 
-  //Free aux
-  free(inner);
-  
-  return result;
-}
-
-}
\ No newline at end of file
+/*
+ *  Copyright 2009 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/rtp_rtcp/source/media_crypto.h"
+
+#include <string.h>
+
+#include "webrtc/base/base64.h"
+#include "webrtc/base/buffer.h"
+#include "webrtc/base/logratelimiter.h"
+#include "webrtc/base/packet_trace.h"
+#include "webrtc/base/sslstreamadapter.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/modules/rtp_rtcp/source/media_crypto.h"
+
+/* OHB data
+ *   0                   1                   2                   3
+ *   0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+ *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *  |    key id     |M|     PT      |       sequence number         |
+ *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *  |                           timestamp                           |
+ *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *  |                             SSRC                              |
+ *  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+ *
+ * The inner SRTP packet starts at the key id, which is replaced by the first
+ * byte of the inner RTP header (0x80) while the packet is transformed.
+ */
+static size_t ohb_size = 12;
+
+namespace webrtc {
+  
+  
+bool MediaCryptoKey::Parse(int crypto_suite, const std::string &str) {
+  size_t len;
+  
+  // Decode 
+  if (!rtc::Base64::DecodeFromArray(
+    str.c_str(),
+    str.length(),
+    rtc::Base64::DecodeOption::DO_STRICT,
+    &buffer,
+    &len)) {
+    LOG(LS_WARNING) << "Error decoding E2E Media Crypto key" << str;
+    return false;
+  }
+  
+  // Check size
+  int expected_key_len;
+  int expected_salt_len;
+  if (!rtc::GetSrtpKeyAndSaltLengths(crypto_suite, &expected_key_len,
+      &expected_salt_len)) {
+    // This should never happen.
+    LOG(LS_WARNING) << "Failed to create MediaCryptoKey: unsupported"
+                    << " cipher_suite without length information"
+                    << crypto_suite;
+    return false;
+  }
+  size_t expected = static_cast<size_t>(expected_key_len + expected_salt_len);
+  if ( buffer.size() != expected) {
+    LOG(LS_WARNING) << "Failed to create SRTP session: invalid key"
+                    << " key length" << buffer.size()
+                    << " expected" << expected;
+    return false;
+  }
+  
+  type = crypto_suite;
+  return true;
+}
+  
+MediaCrypto::MediaCrypto()
+    : context_(nullptr),
+      previous_context_(nullptr),
+      outbound_(false),
+      rtp_auth_tag_len_(0),
+      bytes_copied_(0) {
+}
+
+MediaCrypto::~MediaCrypto() {
+}
+
+bool MediaCrypto::SetOutboundKey(const MediaCryptoKey& key) {
+  LOG(LS_ERROR) << "E2E media encryption oubound key set";
+  std::unique_ptr<MediaCryptoContext> context = MediaCryptoContext::Create(key);
+  if (!SetOutboundContext(context.get()))
+    return false;
+  rtc::CritScope lock(&crit_);
+  own_context_ = std::move(context);
+  return true;
+}
+
+bool MediaCrypto::SetInboundKey(const MediaCryptoKey& key) {
+  LOG(LS_INFO) << "E2E media encryption inbound key set";
+  std::unique_ptr<MediaCryptoContext> context = MediaCryptoContext::Create(key);
+  if (!SetInboundContext(context.get()))
+    return false;
+  rtc::CritScope lock(&crit_);
+  own_context_ = std::move(context);
+  return true;
+}
+
+bool MediaCrypto::SetOutboundContext(MediaCryptoContext* context) {
+  return SetContext(context, true);
+}
+
+bool MediaCrypto::SetInboundContext(MediaCryptoContext* context) {
+  return SetContext(context, false);
+}
+
+bool MediaCrypto::SetContext(MediaCryptoContext* context, bool outbound) {
+  if (!context)
+    return false;
+
+  rtc::CritScope lock(&crit_);
+  if (context_) {
+    LOG(LS_ERROR) << "Failed to create SRTP session: "
+                  << "SRTP session already created";
+    return false;
+  }
+
+  context_ = context;
+  outbound_ = outbound;
+  rtp_auth_tag_len_ = context_->auth_tag_length();
+  return true;
+}
+
+bool MediaCrypto::UpdateKey(const MediaCryptoKey& key) {
+  rtc::CritScope lock(&crit_);
+  if (!context_) {
+    LOG(LS_ERROR) << "Failed to update E2E media crypto key: no key set";
+    return false;
+  }
+  if (key.id == context_->key_id()) {
+    LOG(LS_ERROR) << "Failed to update E2E media crypto key: key id "
+                  << static_cast<int>(key.id) << " already in use";
+    return false;
+  }
+
+  std::unique_ptr<MediaCryptoContext> context = MediaCryptoContext::Create(key);
+  if (!context)
+    return false;
+  // The packetizer reserves room for the tag, it must not change.
+  if (context->auth_tag_length() != rtp_auth_tag_len_) {
+    LOG(LS_ERROR) << "Failed to update E2E media crypto key: crypto suite "
+                  << "changed";
+    return false;
+  }
+
+  LOG(LS_INFO) << "E2E media crypto key updated to id "
+               << static_cast<int>(key.id);
+  if (outbound_) {
+    own_previous_context_.reset();
+    previous_context_ = nullptr;
+  } else {
+    own_previous_context_ = std::move(own_context_);
+    previous_context_ = context_;
+  }
+  own_context_ = std::move(context);
+  context_ = own_context_.get();
+  return true;
+}
+
+MediaCryptoContext* MediaCrypto::GetInboundContext(uint8_t key_id) {
+  if (context_ && context_->key_id() == key_id)
+    return context_;
+  if (previous_context_ && previous_context_->key_id() == key_id)
+    return previous_context_;
+  return nullptr;
+}
+
+bool MediaCrypto::Prewarm() {
+  rtc::CritScope lock(&crit_);
+  if (!context_)
+    return false;
+  return outbound_ ? context_->PrewarmOutbound() : context_->PrewarmInbound();
+}
+
+const char* MediaCrypto::cipher_name() const {
+  rtc::CritScope lock(&crit_);
+  if (!context_)
+    return nullptr;
+  return outbound_ ? context_->outbound_cipher_name()
+                   : context_->inbound_cipher_name();
+}
+
+MediaCryptoStats MediaCrypto::stats() const {
+  rtc::CritScope lock(&crit_);
+  return stats_;
+}
+
+size_t MediaCrypto::GetEncryptionOverhead()
+{
+	return ohb_size + rtp_auth_tag_len_;
+}
+
+bool MediaCrypto::Encrypt(rtp::Packet *packet)
+{
+  rtc::CritScope lock(&crit_);
+  if (!context_) {
+    LOG_RATE_LIMITED(LS_WARNING, 5)
+        << "Failed to protect SRTP packet: no SRTP Session";
+    return false;
+  }
+  
+  //Check it is enought
+  if (!CanEncrypt(*packet)) {
+    LOG_RATE_LIMITED(LS_WARNING, 5) << "Failed to perform DOUBLE PERC"
+      << " encrypted size will exceed max payload size available";
+    return false;
+  }
+  
+  return EncryptInPlace(packet);
+}
+
+bool MediaCrypto::EncryptBatch(rtc::ArrayView<rtp::Packet* const> packets)
+{
+  rtc::CritScope lock(&crit_);
+  if (!context_) {
+    LOG_RATE_LIMITED(LS_WARNING, 5)
+        << "Failed to protect SRTP packet: no SRTP Session";
+    return false;
+  }
+  
+  // Check the whole frame first, so it is either fully encrypted or untouched
+  for (const rtp::Packet* packet : packets) {
+    if (!CanEncrypt(*packet)) {
+      LOG_RATE_LIMITED(LS_WARNING, 5) << "Failed to perform DOUBLE PERC"
+        << " encrypted size will exceed max payload size available";
+      return false;
+    }
+  }
+  
+  for (rtp::Packet* packet : packets) {
+    if (!EncryptInPlace(packet))
+      return false;
+  }
+  
+  return true;
+}
+
+bool MediaCrypto::CanEncrypt(const rtp::Packet& packet) const
+{
+  // Calculate payload size for encrypted version
+  size_t encrypted_payload_size =
+      ohb_size + packet.payload_size() + rtp_auth_tag_len_;
+  return encrypted_payload_size <= packet.MaxPayloadSize();
+}
+
+bool MediaCrypto::EncryptInPlace(rtp::Packet *packet)
+{
+  size_t payload_size = packet->payload_size();
+  size_t encrypted_payload_size = ohb_size + payload_size + rtp_auth_tag_len_;
+  
+  // Grow the payload inside the packet buffer, keeping the media data already
+  // written by the packetizer, so the inner transform can run in place.
+  uint8_t* payload = packet->ExtendPayload(encrypted_payload_size);
+  if (!payload) {
+    LOG_RATE_LIMITED(LS_WARNING, 5) << "Failed to perform DOUBLE PERC"
+      << " could not allocate payload for encrypted data";
+    return false;
+  }
+  
+  // Make room for the OHB in front of the media data
+  memmove(payload + ohb_size, payload, payload_size);
+  bytes_copied_ += payload_size;
+  
+  // The inner RTP packet starts at the key id
+  uint8_t* inner = payload;
+  
+  //Get packet values
+  bool mark = packet->Marker ();
+  uint8_t pt = packet->PayloadType ();
+  uint16_t seq = packet->SequenceNumber();
+  uint32_t ts = packet->Timestamp();
+  uint32_t ssrc = packet->Ssrc();
+  
+  // Innert RTP packet has no padding,csrcs or extensions
+  inner[0] = 0x80;
+  
+  // marker & pt
+  inner[1] = mark ? 0x80 | pt : pt;
+  //SEQ
+  inner[2] = seq >> 8;
+  inner[3] = seq;
+  // TS
+  inner[4] = ts >> 24;
+  inner[5] = ts >> 16;
+  inner[6] = ts >> 8;
+  inner[7] = ts;
+  // SSRC
+  inner[8] = ssrc >> 24;
+  inner[9] = ssrc >> 16;
+  inner[10] = ssrc >> 8;
+  inner[11] = ssrc;
+
+  // Protect inner rtp packet, size has already been checked by the caller
+  size_t out_len;
+  int64_t start_ns = rtc::SystemTimeNanos();
+  bool result = context_->Protect(inner, ohb_size + payload_size, &out_len);
+  stats_.encrypt_time_ns += rtc::SystemTimeNanos() - start_ns;
+  
+  // Tell the receiver which key to use
+  inner[0] = context_->key_id();
+  
+  if (!result) {
+    ++stats_.encrypt_failures;
+    LOG_RATE_LIMITED(LS_WARNING, 5) << "Failed to encrypt double packet";
+    // Leave the packet as it was before the transform
+    memmove(payload, payload + ohb_size, payload_size);
+    packet->SetPayloadSize(payload_size);
+    return false;
+  }
+  
+  //Set encrypted payload size
+  packet->SetPayloadSize(out_len);
+  stats_.bytes_encrypted += ohb_size + payload_size;
+  rtc::packet_trace::Record(rtc::packet_trace::Stage::kMediaEncrypted, ssrc,
+                            seq);
+  return true;
+}
+
+bool MediaCrypto::DecryptInPlace(uint8_t** payload, size_t* payload_length) {
+  rtc::CritScope lock(&crit_);
+  if (!context_) {
+    LOG_RATE_LIMITED(LS_WARNING, 5)
+        << "Failed to unprotect SRTP packet: no SRTP Session";
+    return false;
+  }
+  
+  //Check we have enought data on payload
+  if (*payload_length < ohb_size + rtp_auth_tag_len_) {
+    ++stats_.auth_failures;
+    LOG_RATE_LIMITED(LS_WARNING, 5) << "Failed to perform DOUBLE PERC"
+      << " encrypted payload is smaller than the minimum possible";
+    return false;
+  }
+  
+  // The inner RTP packet starts at the key id, which is restored after the
+  // transform.
+  uint8_t* inner = *payload;
+  uint8_t key_id = inner[0];
+  MediaCryptoContext* context = GetInboundContext(key_id);
+  if (!context) {
+    ++stats_.auth_failures;
+    LOG_RATE_LIMITED(LS_WARNING, 5)
+        << "Failed to perform DOUBLE PERC: unknown key id "
+        << static_cast<int>(key_id);
+    return false;
+  }
+  
+  // Reconstruct RTP header
+  inner[0] = 0x80;
+
+  // UnProtect inner rtp packet
+  size_t out_length;
+  bool replayed;
+  int64_t start_ns = rtc::SystemTimeNanos();
+  bool result =
+      context->Unprotect(inner, *payload_length, &out_length, &replayed);
+  stats_.decrypt_time_ns += rtc::SystemTimeNanos() - start_ns;
+  
+  // Restore key id
+  inner[0] = key_id;
+  
+  //Set decyrpted payload
+  if (result) {
+    stats_.bytes_decrypted += *payload_length;
+    // Skip the OHB data
+    *payload += ohb_size;
+    *payload_length = out_length - ohb_size;
+  } else if (replayed) {
+    // Already logged by the cipher.
+    ++stats_.replay_drops;
+  } else {
+    ++stats_.auth_failures;
+    LOG_RATE_LIMITED(LS_WARNING, 5) << "Failed to perform DOUBLE PERC";
+  }
+  
+  return result;
+}
+
+bool MediaCrypto::Decrypt(uint8_t* payload,size_t* payload_length) {
+  uint8_t* decrypted = payload;
+  if (!DecryptInPlace(&decrypted, payload_length))
+    return false;
+  
+  // Move the decrypted inner payload over the OHB data
+  memmove(payload, decrypted, *payload_length);
+  bytes_copied_ += *payload_length;
+  
+  return true;
+}
+
+}
@@ -1,49 +1,89 @@
-/*
- *  Copyright (c) 2012 The WebRTC project authors. All Rights Reserved.
- *
- *  Use of this source code is governed by a BSD-style license
- *  that can be found in the LICENSE file in the root of the source
- *  tree. An additional intellectual property rights grant can be found
- *  in the file PATENTS.  All contributing project authors may
- *  be found in the AUTHORS file in the root of the source tree.
- */
-
-#ifndef WEBRTC_MODULES_RTP_RTCP_SOURCE_DOUBLE_PERC_H_
-#define WEBRTC_MODULES_RTP_RTCP_SOURCE_DOUBLE_PERC_H_
-
-#include "webrtc/config.h"
-#include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
-#include "webrtc/modules/rtp_rtcp/source/rtp_packet.h"
-#include "webrtc/typedefs.h"
-
-// Forward declaration to avoid pulling in libsrtp headers here
-struct srtp_ctx_t_;
-
-namespace webrtc {
-	
-class MediaCrypto {
- public:
-  MediaCrypto();
-  ~MediaCrypto();
-
-  
-  bool SetOutboundKey(const MediaCryptoKey& key);
-  bool SetInboundKey(const MediaCryptoKey& key);
-  bool Encrypt(rtp::Packet *packet);
-  bool Decrypt(uint8_t* payload,size_t* payload_length);
-  
-  size_t GetEncryptionOverhead();
-  
- private:
-  bool SetKey(int type, int cs, const uint8_t* key, size_t len);
-  bool ProtectRtp(void* data, int in_len, int max_len, int* out_len);
-  bool UnprotectRtp(void* data, int in_len, int* out_len);  
-  srtp_ctx_t_* session_;
-  int rtp_auth_tag_len_;
-  int rtcp_auth_tag_len_;
-  RTC_DISALLOW_COPY_AND_ASSIGN(MediaCrypto);  
-};
-
-}
-#endif /* WEBRTC_MODULES_RTP_RTCP_SOURCE_DOUBLE_PERC_H_ */
-
+/*
+ *  Copyright (c) 2012 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_RTP_RTCP_SOURCE_DOUBLE_PERC_H_
+#define WEBRTC_MODULES_RTP_RTCP_SOURCE_DOUBLE_PERC_H_
+
+#include <memory>
+
+#include "webrtc/base/array_view.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/thread_annotations.h"
+#include "webrtc/config.h"
+#include "webrtc/modules/rtp_rtcp/include/media_crypto_context.h"
+#include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_packet.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+	
+class MediaCrypto {
+ public:
+  MediaCrypto();
+  ~MediaCrypto();
+
+  
+  bool SetOutboundKey(const MediaCryptoKey& key);
+  bool SetInboundKey(const MediaCryptoKey& key);
+  // Use a context shared with other streams instead of a key of our own.
+  // |context| must outlive this object.
+  bool SetOutboundContext(MediaCryptoContext* context);
+  bool SetInboundContext(MediaCryptoContext* context);
+  // Rotates to |key|, which must use the same crypto suite and a different
+  // id than the current one. Outbound, it is used from the next packet on.
+  // Inbound, the previous key is kept so packets still in flight decrypt,
+  // the key id in each packet picks which one is used. Install the new key
+  // on the receivers before the senders switch to it.
+  bool UpdateKey(const MediaCryptoKey& key);
+  // The cipher is created on the first Encrypt or Decrypt call. Prewarm
+  // creates it right away instead.
+  bool Prewarm();
+  bool Encrypt(rtp::Packet *packet);
+  // Encrypts all the packets of a frame. The session and size checks are done
+  // once for the whole batch before any packet is modified.
+  bool EncryptBatch(rtc::ArrayView<rtp::Packet* const> packets);
+  // Decrypts the inner layer in place. On success |*payload| and
+  // |*payload_length| are updated to the plaintext, which is left inside the
+  // original buffer so nothing is copied.
+  bool DecryptInPlace(uint8_t** payload, size_t* payload_length);
+  // Same as DecryptInPlace, but moves the plaintext to the start of |payload|.
+  bool Decrypt(uint8_t* payload,size_t* payload_length);
+  
+  size_t GetEncryptionOverhead();
+  // Total number of payload bytes moved by Encrypt and Decrypt.
+  size_t bytes_copied() const { return bytes_copied_; }
+  // Name of the cipher backend in use, or nullptr if no key has been set.
+  const char* cipher_name() const;
+  // Cost of the packets transformed so far, see MediaCryptoStats.
+  MediaCryptoStats stats() const;
+  
+ private:
+  bool SetContext(MediaCryptoContext* context, bool outbound);
+  bool CanEncrypt(const rtp::Packet& packet) const;
+  bool EncryptInPlace(rtp::Packet *packet) EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  MediaCryptoContext* GetInboundContext(uint8_t key_id)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  rtc::CriticalSection crit_;
+  // Set when created from a key rather than shared.
+  std::unique_ptr<MediaCryptoContext> own_context_ GUARDED_BY(crit_);
+  MediaCryptoContext* context_ GUARDED_BY(crit_);
+  // Inbound only, key being rotated out.
+  std::unique_ptr<MediaCryptoContext> own_previous_context_ GUARDED_BY(crit_);
+  MediaCryptoContext* previous_context_ GUARDED_BY(crit_);
+  bool outbound_;
+  size_t rtp_auth_tag_len_;
+  size_t bytes_copied_;
+  MediaCryptoStats stats_ GUARDED_BY(crit_);
+  RTC_DISALLOW_COPY_AND_ASSIGN(MediaCrypto);  
+};
+
+}
+#endif /* WEBRTC_MODULES_RTP_RTCP_SOURCE_DOUBLE_PERC_H_ */
+
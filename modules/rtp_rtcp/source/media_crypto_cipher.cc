@@ -0,0 +1,84 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/rtp_rtcp/source/media_crypto_cipher.h"
+
+#include "webrtc/base/logging.h"
+#include "webrtc/base/sslstreamadapter.h"
+#include "webrtc/base/timeutils.h"
+
+namespace webrtc {
+namespace {
+constexpr int64_t kReplayLogIntervalMs = 5000;
+}  // namespace
+
+constexpr size_t MediaCryptoCipher::kDefaultReplayWindowSize;
+
+MediaCryptoCipher::MediaCryptoCipher()
+    : replayed_packets_(0),
+      logged_replayed_packets_(0),
+      last_replay_log_ms_(-1) {}
+
+void MediaCryptoCipher::OnReplayedPacket() {
+  ++replayed_packets_;
+  int64_t now_ms = rtc::TimeMillis();
+  if (last_replay_log_ms_ != -1 &&
+      now_ms - last_replay_log_ms_ < kReplayLogIntervalMs) {
+    return;
+  }
+  LOG(LS_WARNING) << "Dropped "
+                  << replayed_packets_ - logged_replayed_packets_
+                  << " replayed or too old inner packets, "
+                  << replayed_packets_ << " in total";
+  logged_replayed_packets_ = replayed_packets_;
+  last_replay_log_ms_ = now_ms;
+}
+
+bool MediaCryptoCipher::GetAuthTagLength(const MediaCryptoKey& key,
+                                         size_t* auth_tag_length) {
+  int key_len;
+  int salt_len;
+  if (!rtc::GetSrtpKeyAndSaltLengths(key.type, &key_len, &salt_len)) {
+    LOG(LS_WARNING) << "Unsupported E2E media crypto suite " << key.type;
+    return false;
+  }
+  if (key.buffer.size() != static_cast<size_t>(key_len + salt_len)) {
+    LOG(LS_WARNING) << "Invalid E2E media crypto key length "
+                    << key.buffer.size();
+    return false;
+  }
+
+  switch (key.type) {
+    case rtc::SRTP_AES128_CM_SHA1_80:
+      *auth_tag_length = 10;
+      return true;
+    case rtc::SRTP_AES128_CM_SHA1_32:
+      *auth_tag_length = 4;
+      return true;
+    case rtc::SRTP_AEAD_AES_128_GCM:
+    case rtc::SRTP_AEAD_AES_256_GCM:
+      *auth_tag_length = 16;
+      return true;
+  }
+  return false;
+}
+
+std::unique_ptr<MediaCryptoCipher> MediaCryptoCipher::Create(
+    Direction direction,
+    const MediaCryptoKey& key,
+    size_t replay_window_size) {
+  std::unique_ptr<MediaCryptoCipher> cipher =
+      CreateAead(direction, key, replay_window_size);
+  if (!cipher)
+    cipher = CreateSrtp(direction, key, replay_window_size);
+  return cipher;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_RTP_RTCP_SOURCE_MEDIA_CRYPTO_CIPHER_H_
+#define WEBRTC_MODULES_RTP_RTCP_SOURCE_MEDIA_CRYPTO_CIPHER_H_
+
+#include <memory>
+
+#include "webrtc/config.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+// Cipher backend for the inner PERC layer. It transforms a complete inner RTP
+// packet (fixed 12 bytes header, no CSRCs nor extensions) in place, using the
+// SRTP packet format so all the backends interoperate.
+class MediaCryptoCipher {
+ public:
+  enum class Direction { kOutbound, kInbound };
+
+  // Replay window used unless the NACK history calls for a larger one.
+  static constexpr size_t kDefaultReplayWindowSize = 1024;
+
+  // Creates the fastest backend available for |key|: the BoringSSL AEAD one
+  // for AES-GCM suites when the CPU has AES instructions, libsrtp otherwise.
+  // Inbound, packets already received or more than |replay_window_size|
+  // packets older than the newest one are dropped. Returns nullptr if |key|
+  // is not valid.
+  static std::unique_ptr<MediaCryptoCipher> Create(Direction direction,
+                                                   const MediaCryptoKey& key,
+                                                   size_t replay_window_size);
+  // Backend using a libsrtp session, supports all the SRTP crypto suites.
+  // libsrtp caps the replay window to 32767 packets.
+  static std::unique_ptr<MediaCryptoCipher> CreateSrtp(
+      Direction direction,
+      const MediaCryptoKey& key,
+      size_t replay_window_size);
+  // Backend using BoringSSL EVP_AEAD, which picks AES-NI/PCLMULQDQ or ARMv8
+  // crypto extensions when present. Returns nullptr if not built against
+  // BoringSSL, if the CPU lacks AES instructions or if |key| is not AES-GCM.
+  static std::unique_ptr<MediaCryptoCipher> CreateAead(
+      Direction direction,
+      const MediaCryptoKey& key,
+      size_t replay_window_size);
+
+  // Checks |key| can be used to create a cipher, without expanding it, and
+  // returns the length of the authentication tag the cipher will append.
+  static bool GetAuthTagLength(const MediaCryptoKey& key,
+                               size_t* auth_tag_length);
+
+  virtual ~MediaCryptoCipher() {}
+
+  // Name of the backend, for stats and logging.
+  virtual const char* name() const = 0;
+  // Bytes appended by Protect after the inner packet.
+  virtual size_t auth_tag_length() const = 0;
+
+  // Protects the |length| bytes inner packet at |packet|, which must have
+  // room for auth_tag_length() more bytes.
+  virtual bool Protect(uint8_t* packet, size_t length, size_t* out_length) = 0;
+  // Authenticates and decrypts the inner packet at |packet| in place.
+  virtual bool Unprotect(uint8_t* packet,
+                         size_t length,
+                         size_t* out_length) = 0;
+
+  // Packets Unprotect dropped because they were replayed or too old.
+  size_t replayed_packets() const { return replayed_packets_; }
+
+ protected:
+  MediaCryptoCipher();
+
+  // Counts a packet rejected by the replay check. Reordering past the window
+  // comes in bursts, so this logs at most once every few seconds.
+  void OnReplayedPacket();
+
+ private:
+  size_t replayed_packets_;
+  size_t logged_replayed_packets_;
+  int64_t last_replay_log_ms_;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_RTP_RTCP_SOURCE_MEDIA_CRYPTO_CIPHER_H_
@@ -0,0 +1,258 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/rtp_rtcp/source/media_crypto_cipher.h"
+
+#include <openssl/crypto.h>
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+
+#if defined(OPENSSL_IS_BORINGSSL)
+#include <openssl/aead.h>
+#include <openssl/aes.h>
+#endif
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/logging.h"
+#include "webrtc/base/logratelimiter.h"
+#include "webrtc/base/sslstreamadapter.h"
+#include "webrtc/modules/rtp_rtcp/source/byte_io.h"
+#include "webrtc/modules/rtp_rtcp/source/media_crypto_replay_window.h"
+
+namespace webrtc {
+
+#if defined(OPENSSL_IS_BORINGSSL)
+namespace {
+
+constexpr size_t kRtpHeaderSize = 12;
+constexpr size_t kIvSize = 12;
+constexpr size_t kSaltSize = 12;
+constexpr size_t kTagSize = 16;
+constexpr size_t kMaxKeySize = 32;
+// SRTP key derivation labels, RFC 3711 section 4.3.2.
+constexpr uint8_t kCipherKeyLabel = 0x00;
+constexpr uint8_t kCipherSaltLabel = 0x02;
+
+// SRTP key derivation (RFC 3711 section 4.3) with a key derivation rate of
+// zero: AES counter mode keyed with the master key over the master salt,
+// with the label xored into the eighth byte. The 96 bits AES-GCM salt is
+// zero padded to 112 bits, as libsrtp does.
+void DeriveSessionKey(const uint8_t* master_key,
+                      size_t master_key_size,
+                      const uint8_t* master_salt,
+                      uint8_t label,
+                      uint8_t* out,
+                      size_t out_size) {
+  AES_KEY aes_key;
+  AES_set_encrypt_key(master_key, static_cast<unsigned>(master_key_size * 8),
+                      &aes_key);
+  uint8_t counter[AES_BLOCK_SIZE] = {0};
+  memcpy(counter, master_salt, kSaltSize);
+  counter[7] ^= label;
+  for (size_t offset = 0; offset < out_size; offset += AES_BLOCK_SIZE) {
+    uint8_t block[AES_BLOCK_SIZE];
+    AES_encrypt(counter, block, &aes_key);
+    memcpy(out + offset, block,
+           std::min<size_t>(AES_BLOCK_SIZE, out_size - offset));
+    ByteWriter<uint16_t>::WriteBigEndian(
+        &counter[14], ByteReader<uint16_t>::ReadBigEndian(&counter[14]) + 1);
+  }
+  OPENSSL_cleanse(&aes_key, sizeof(aes_key));
+}
+
+class AeadMediaCryptoCipher : public MediaCryptoCipher {
+ public:
+  explicit AeadMediaCryptoCipher(size_t replay_window_size)
+      : replay_window_size_(replay_window_size) {
+    EVP_AEAD_CTX_zero(&ctx_);
+    memset(salt_, 0, sizeof(salt_));
+  }
+  ~AeadMediaCryptoCipher() override {
+    EVP_AEAD_CTX_cleanup(&ctx_);
+    OPENSSL_cleanse(salt_, sizeof(salt_));
+  }
+
+  bool Init(const EVP_AEAD* aead,
+            const uint8_t* master_key,
+            size_t master_key_size) {
+    const uint8_t* master_salt = master_key + master_key_size;
+    uint8_t key[kMaxKeySize];
+    DeriveSessionKey(master_key, master_key_size, master_salt,
+                     kCipherKeyLabel, key, master_key_size);
+    DeriveSessionKey(master_key, master_key_size, master_salt,
+                     kCipherSaltLabel, salt_, kSaltSize);
+    bool result = EVP_AEAD_CTX_init(&ctx_, aead, key, master_key_size,
+                                    kTagSize, nullptr) == 1;
+    OPENSSL_cleanse(key, sizeof(key));
+    return result;
+  }
+
+  const char* name() const override { return "boringssl"; }
+  size_t auth_tag_length() const override { return kTagSize; }
+
+  bool Protect(uint8_t* packet, size_t length, size_t* out_length) override {
+    if (length < kRtpHeaderSize)
+      return false;
+    uint16_t seq = ByteReader<uint16_t>::ReadBigEndian(&packet[2]);
+    uint32_t ssrc = ByteReader<uint32_t>::ReadBigEndian(&packet[8]);
+    Stream* stream = &streams_[ssrc];
+    uint32_t roc = stream->EstimateRoc(seq);
+    uint8_t iv[kIvSize];
+    ComputeIv(ssrc, roc, seq, iv);
+
+    size_t payload_length = length - kRtpHeaderSize;
+    size_t sealed_length;
+    if (!EVP_AEAD_CTX_seal(&ctx_, packet + kRtpHeaderSize, &sealed_length,
+                           payload_length + kTagSize, iv, kIvSize,
+                           packet + kRtpHeaderSize, payload_length, packet,
+                           kRtpHeaderSize)) {
+      LOG_RATE_LIMITED(LS_WARNING, 5) << "Failed to seal inner packet";
+      return false;
+    }
+    stream->Update(roc, seq);
+    *out_length = kRtpHeaderSize + sealed_length;
+    return true;
+  }
+
+  bool Unprotect(uint8_t* packet, size_t length, size_t* out_length) override {
+    if (length < kRtpHeaderSize + kTagSize)
+      return false;
+    uint16_t seq = ByteReader<uint16_t>::ReadBigEndian(&packet[2]);
+    uint32_t ssrc = ByteReader<uint32_t>::ReadBigEndian(&packet[8]);
+    Stream* stream = &streams_[ssrc];
+    uint32_t roc = stream->EstimateRoc(seq);
+    // Drop replays before spending any time decrypting them.
+    uint64_t index = (static_cast<uint64_t>(roc) << 16) | seq;
+    MediaCryptoReplayWindow* replay_window = GetReplayWindow(ssrc);
+    if (!replay_window->Check(index)) {
+      OnReplayedPacket();
+      return false;
+    }
+    uint8_t iv[kIvSize];
+    ComputeIv(ssrc, roc, seq, iv);
+
+    size_t sealed_length = length - kRtpHeaderSize;
+    size_t opened_length;
+    if (!EVP_AEAD_CTX_open(&ctx_, packet + kRtpHeaderSize, &opened_length,
+                           sealed_length, iv, kIvSize,
+                           packet + kRtpHeaderSize, sealed_length, packet,
+                           kRtpHeaderSize)) {
+      LOG_RATE_LIMITED(LS_WARNING, 5) << "Failed to open inner packet";
+      return false;
+    }
+    replay_window->Add(index);
+    stream->Update(roc, seq);
+    *out_length = kRtpHeaderSize + opened_length;
+    return true;
+  }
+
+ private:
+  // Rollover counter tracking, RFC 3711 section 3.3.1.
+  struct Stream {
+    uint32_t EstimateRoc(uint16_t seq) const {
+      if (!started)
+        return 0;
+      if (highest_seq < 0x8000) {
+        if (seq > highest_seq + 0x8000 && roc > 0)
+          return roc - 1;
+      } else if (seq < highest_seq - 0x8000) {
+        return roc + 1;
+      }
+      return roc;
+    }
+    void Update(uint32_t packet_roc, uint16_t seq) {
+      if (!started || packet_roc > roc ||
+          (packet_roc == roc && seq > highest_seq)) {
+        started = true;
+        roc = packet_roc;
+        highest_seq = seq;
+      }
+    }
+
+    bool started = false;
+    uint32_t roc = 0;
+    uint16_t highest_seq = 0;
+  };
+
+  MediaCryptoReplayWindow* GetReplayWindow(uint32_t ssrc) {
+    auto it = replay_windows_.find(ssrc);
+    if (it == replay_windows_.end()) {
+      it = replay_windows_
+               .insert(std::make_pair(
+                   ssrc, MediaCryptoReplayWindow(replay_window_size_)))
+               .first;
+    }
+    return &it->second;
+  }
+
+  // RFC 7714 section 8.1.
+  void ComputeIv(uint32_t ssrc, uint32_t roc, uint16_t seq, uint8_t* iv) {
+    iv[0] = 0;
+    iv[1] = 0;
+    ByteWriter<uint32_t>::WriteBigEndian(&iv[2], ssrc);
+    ByteWriter<uint32_t>::WriteBigEndian(&iv[6], roc);
+    ByteWriter<uint16_t>::WriteBigEndian(&iv[10], seq);
+    for (size_t i = 0; i < kIvSize; ++i)
+      iv[i] ^= salt_[i];
+  }
+
+  EVP_AEAD_CTX ctx_;
+  uint8_t salt_[kSaltSize];
+  std::map<uint32_t, Stream> streams_;
+  const size_t replay_window_size_;
+  std::map<uint32_t, MediaCryptoReplayWindow> replay_windows_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(AeadMediaCryptoCipher);
+};
+
+}  // namespace
+#endif  // defined(OPENSSL_IS_BORINGSSL)
+
+std::unique_ptr<MediaCryptoCipher> MediaCryptoCipher::CreateAead(
+    Direction direction,
+    const MediaCryptoKey& key,
+    size_t replay_window_size) {
+#if defined(OPENSSL_IS_BORINGSSL)
+  const EVP_AEAD* aead;
+  if (key.type == rtc::SRTP_AEAD_AES_128_GCM) {
+    aead = EVP_aead_aes_128_gcm();
+  } else if (key.type == rtc::SRTP_AEAD_AES_256_GCM) {
+    aead = EVP_aead_aes_256_gcm();
+  } else {
+    return nullptr;
+  }
+  // Software AES is no faster than libsrtp, keep using it in that case.
+  if (!EVP_has_aes_hardware())
+    return nullptr;
+
+  int key_len;
+  int salt_len;
+  if (!rtc::GetSrtpKeyAndSaltLengths(key.type, &key_len, &salt_len) ||
+      static_cast<size_t>(salt_len) != kSaltSize ||
+      key.buffer.size() != static_cast<size_t>(key_len + salt_len)) {
+    LOG(LS_WARNING) << "Failed to create AEAD cipher: invalid key";
+    return nullptr;
+  }
+
+  std::unique_ptr<AeadMediaCryptoCipher> cipher(
+      new AeadMediaCryptoCipher(replay_window_size));
+  if (!cipher->Init(aead, key.buffer.data(), key_len)) {
+    LOG(LS_ERROR) << "Failed to create AEAD cipher";
+    return nullptr;
+  }
+  return std::move(cipher);
+#else
+  return nullptr;
+#endif
+}
+
+}  // namespace webrtc
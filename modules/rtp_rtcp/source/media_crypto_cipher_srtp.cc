@@ -0,0 +1,139 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/rtp_rtcp/source/media_crypto_cipher.h"
+
+#include <string.h>
+
+#include <algorithm>
+
+#include "third_party/libsrtp/include/srtp.h"
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/logging.h"
+#include "webrtc/base/logratelimiter.h"
+#include "webrtc/base/sslstreamadapter.h"
+
+namespace webrtc {
+namespace {
+// Bounds of the libsrtp replay database.
+constexpr size_t kMinSrtpReplayWindowSize = 64;
+constexpr size_t kMaxSrtpReplayWindowSize = 0x7fff;
+
+class SrtpMediaCryptoCipher : public MediaCryptoCipher {
+ public:
+  SrtpMediaCryptoCipher(srtp_t session, size_t auth_tag_length)
+      : session_(session), auth_tag_length_(auth_tag_length) {}
+  ~SrtpMediaCryptoCipher() override { srtp_dealloc(session_); }
+
+  const char* name() const override { return "libsrtp"; }
+  size_t auth_tag_length() const override { return auth_tag_length_; }
+
+  bool Protect(uint8_t* packet, size_t length, size_t* out_length) override {
+    int len = static_cast<int>(length);
+    int err = srtp_protect(session_, packet, &len);
+    if (err != srtp_err_status_ok) {
+      LOG_RATE_LIMITED(LS_WARNING, 5)
+          << "Failed to protect SRTP packet, err=" << err;
+      return false;
+    }
+    *out_length = len;
+    return true;
+  }
+
+  bool Unprotect(uint8_t* packet, size_t length, size_t* out_length) override {
+    int len = static_cast<int>(length);
+    int err = srtp_unprotect(session_, packet, &len);
+    if (err == srtp_err_status_replay_fail ||
+        err == srtp_err_status_replay_old) {
+      OnReplayedPacket();
+      return false;
+    }
+    if (err != srtp_err_status_ok) {
+      LOG_RATE_LIMITED(LS_WARNING, 5)
+          << "Failed to unprotect SRTP packet, err=" << err;
+      return false;
+    }
+    *out_length = len;
+    return true;
+  }
+
+ private:
+  const srtp_t session_;
+  const size_t auth_tag_length_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(SrtpMediaCryptoCipher);
+};
+
+}  // namespace
+
+std::unique_ptr<MediaCryptoCipher> MediaCryptoCipher::CreateSrtp(
+    Direction direction,
+    const MediaCryptoKey& key,
+    size_t replay_window_size) {
+  int cs = key.type;
+  srtp_policy_t policy;
+  memset(&policy, 0, sizeof(policy));
+  if (cs == rtc::SRTP_AES128_CM_SHA1_80) {
+    srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtp);
+    srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
+  } else if (cs == rtc::SRTP_AES128_CM_SHA1_32) {
+    // RTP HMAC is shortened to 32 bits, but RTCP remains 80 bits.
+    srtp_crypto_policy_set_aes_cm_128_hmac_sha1_32(&policy.rtp);
+    srtp_crypto_policy_set_aes_cm_128_hmac_sha1_80(&policy.rtcp);
+  } else if (cs == rtc::SRTP_AEAD_AES_128_GCM) {
+    srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtp);
+    srtp_crypto_policy_set_aes_gcm_128_16_auth(&policy.rtcp);
+  } else if (cs == rtc::SRTP_AEAD_AES_256_GCM) {
+    srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtp);
+    srtp_crypto_policy_set_aes_gcm_256_16_auth(&policy.rtcp);
+  } else {
+    LOG(LS_WARNING) << "Failed to create SRTP session: unsupported"
+                    << " cipher_suite " << cs;
+    return nullptr;
+  }
+
+  int expected_key_len;
+  int expected_salt_len;
+  if (!rtc::GetSrtpKeyAndSaltLengths(cs, &expected_key_len,
+                                     &expected_salt_len)) {
+    // This should never happen.
+    LOG(LS_WARNING) << "Failed to create SRTP session: unsupported"
+                    << " cipher_suite without length information" << cs;
+    return nullptr;
+  }
+
+  if (key.buffer.size() !=
+      static_cast<size_t>(expected_key_len + expected_salt_len)) {
+    LOG(LS_WARNING) << "Failed to create SRTP session: invalid key";
+    return nullptr;
+  }
+
+  policy.ssrc.type = direction == Direction::kOutbound ? ssrc_any_outbound
+                                                       : ssrc_any_inbound;
+  policy.ssrc.value = 0;
+  policy.key = const_cast<uint8_t*>(key.buffer.data());
+  policy.window_size =
+      std::min(std::max(replay_window_size, kMinSrtpReplayWindowSize),
+               kMaxSrtpReplayWindowSize);
+  policy.allow_repeat_tx = 1;
+  policy.next = nullptr;
+
+  srtp_t session = nullptr;
+  int err = srtp_create(&session, &policy);
+  if (err != srtp_err_status_ok) {
+    LOG(LS_ERROR) << "Failed to create SRTP session, err=" << err;
+    return nullptr;
+  }
+
+  return std::unique_ptr<MediaCryptoCipher>(
+      new SrtpMediaCryptoCipher(session, policy.rtp.auth_tag_len));
+}
+
+}  // namespace webrtc
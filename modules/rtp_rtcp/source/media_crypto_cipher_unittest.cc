@@ -0,0 +1,187 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <memory>
+#include <vector>
+
+#include "third_party/libsrtp/include/srtp.h"
+#include "webrtc/base/sslstreamadapter.h"
+#include "webrtc/modules/rtp_rtcp/source/media_crypto_cipher.h"
+#include "webrtc/test/gmock.h"
+#include "webrtc/test/gtest.h"
+
+using testing::ElementsAreArray;
+using testing::make_tuple;
+
+namespace webrtc {
+namespace {
+constexpr size_t kHeaderSize = 12;
+constexpr size_t kPayloadSize = 100;
+constexpr size_t kMaxTagSize = 16;
+// AES-128-GCM uses a 16 bytes key and a 12 bytes salt.
+constexpr size_t kKeyAndSaltSize = 28;
+constexpr size_t kReplayWindowSize = 128;
+
+using Direction = MediaCryptoCipher::Direction;
+
+MediaCryptoKey CreateKey() {
+  MediaCryptoKey key;
+  key.type = rtc::SRTP_AEAD_AES_128_GCM;
+  for (size_t i = 0; i < kKeyAndSaltSize; ++i)
+    key.buffer.push_back(static_cast<uint8_t>(i));
+  return key;
+}
+
+std::vector<uint8_t> CreateInnerPacket(uint16_t seq) {
+  std::vector<uint8_t> packet(kHeaderSize + kPayloadSize + kMaxTagSize);
+  packet[0] = 0x80;
+  packet[1] = 100;
+  packet[2] = seq >> 8;
+  packet[3] = seq;
+  packet[11] = 0x42;
+  for (size_t i = 0; i < kPayloadSize; ++i)
+    packet[kHeaderSize + i] = static_cast<uint8_t>(i);
+  return packet;
+}
+
+// Protects a packet with |sender| and checks |receiver| recovers it.
+void ExpectRoundTrip(MediaCryptoCipher* sender,
+                     MediaCryptoCipher* receiver,
+                     uint16_t seq) {
+  std::vector<uint8_t> plain = CreateInnerPacket(seq);
+  std::vector<uint8_t> packet = plain;
+  size_t length;
+  ASSERT_TRUE(sender->Protect(packet.data(), kHeaderSize + kPayloadSize,
+                              &length));
+  EXPECT_EQ(kHeaderSize + kPayloadSize + sender->auth_tag_length(), length);
+
+  ASSERT_TRUE(receiver->Unprotect(packet.data(), length, &length));
+  EXPECT_THAT(make_tuple(packet.data(), length),
+              ElementsAreArray(plain.data(), kHeaderSize + kPayloadSize));
+}
+}  // namespace
+
+class MediaCryptoCipherTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() { srtp_init(); }
+};
+
+TEST_F(MediaCryptoCipherTest, CreateSelectsABackend) {
+  std::unique_ptr<MediaCryptoCipher> cipher =
+      MediaCryptoCipher::Create(Direction::kOutbound, CreateKey(),
+                                kReplayWindowSize);
+  ASSERT_TRUE(cipher);
+  EXPECT_TRUE(cipher->name());
+  EXPECT_EQ(16u, cipher->auth_tag_length());
+}
+
+TEST_F(MediaCryptoCipherTest, CreateFailsWithInvalidKey) {
+  MediaCryptoKey key = CreateKey();
+  key.buffer.pop_back();
+  EXPECT_FALSE(
+      MediaCryptoCipher::Create(Direction::kOutbound, key, kReplayWindowSize));
+  EXPECT_FALSE(MediaCryptoCipher::CreateAead(Direction::kOutbound, key,
+                                             kReplayWindowSize));
+}
+
+TEST_F(MediaCryptoCipherTest, SrtpRoundTrip) {
+  std::unique_ptr<MediaCryptoCipher> sender =
+      MediaCryptoCipher::CreateSrtp(Direction::kOutbound, CreateKey(),
+                                    kReplayWindowSize);
+  std::unique_ptr<MediaCryptoCipher> receiver =
+      MediaCryptoCipher::CreateSrtp(Direction::kInbound, CreateKey(),
+                                    kReplayWindowSize);
+  ASSERT_TRUE(sender);
+  ASSERT_TRUE(receiver);
+  EXPECT_STREQ("libsrtp", sender->name());
+  ExpectRoundTrip(sender.get(), receiver.get(), 1);
+}
+
+// The AEAD backend must produce packets libsrtp can decrypt and the other way
+// around, including across a sequence number rollover.
+TEST_F(MediaCryptoCipherTest, AeadInteroperatesWithSrtp) {
+  std::unique_ptr<MediaCryptoCipher> aead_sender =
+      MediaCryptoCipher::CreateAead(Direction::kOutbound, CreateKey(),
+                                    kReplayWindowSize);
+  if (!aead_sender)
+    return;  // Not built with BoringSSL or no AES instructions.
+  std::unique_ptr<MediaCryptoCipher> aead_receiver =
+      MediaCryptoCipher::CreateAead(Direction::kInbound, CreateKey(),
+                                    kReplayWindowSize);
+  std::unique_ptr<MediaCryptoCipher> srtp_sender =
+      MediaCryptoCipher::CreateSrtp(Direction::kOutbound, CreateKey(),
+                                    kReplayWindowSize);
+  std::unique_ptr<MediaCryptoCipher> srtp_receiver =
+      MediaCryptoCipher::CreateSrtp(Direction::kInbound, CreateKey(),
+                                    kReplayWindowSize);
+  ASSERT_TRUE(aead_receiver);
+  EXPECT_STREQ("boringssl", aead_sender->name());
+
+  for (uint16_t seq : {0xfffe, 0xffff, 0x0000, 0x0001}) {
+    ExpectRoundTrip(aead_sender.get(), srtp_receiver.get(), seq);
+    ExpectRoundTrip(srtp_sender.get(), aead_receiver.get(), seq);
+  }
+}
+
+TEST_F(MediaCryptoCipherTest, AeadRejectsTamperedPacket) {
+  std::unique_ptr<MediaCryptoCipher> sender =
+      MediaCryptoCipher::CreateAead(Direction::kOutbound, CreateKey(),
+                                    kReplayWindowSize);
+  if (!sender)
+    return;  // Not built with BoringSSL or no AES instructions.
+  std::unique_ptr<MediaCryptoCipher> receiver =
+      MediaCryptoCipher::CreateAead(Direction::kInbound, CreateKey(),
+                                    kReplayWindowSize);
+
+  std::vector<uint8_t> packet = CreateInnerPacket(1);
+  size_t length;
+  ASSERT_TRUE(sender->Protect(packet.data(), kHeaderSize + kPayloadSize,
+                              &length));
+  // The header is authenticated too.
+  packet[1] ^= 0x80;
+  EXPECT_FALSE(receiver->Unprotect(packet.data(), length, &length));
+}
+
+TEST_F(MediaCryptoCipherTest, AeadDropsReplayedPackets) {
+  std::unique_ptr<MediaCryptoCipher> sender =
+      MediaCryptoCipher::CreateAead(Direction::kOutbound, CreateKey(),
+                                    kReplayWindowSize);
+  if (!sender)
+    return;  // Not built with BoringSSL or no AES instructions.
+  std::unique_ptr<MediaCryptoCipher> receiver =
+      MediaCryptoCipher::CreateAead(Direction::kInbound, CreateKey(),
+                                    kReplayWindowSize);
+
+  std::vector<std::vector<uint8_t>> packets;
+  for (uint16_t seq = 0; seq < 2 * kReplayWindowSize; ++seq) {
+    packets.push_back(CreateInnerPacket(seq));
+    size_t length;
+    ASSERT_TRUE(sender->Protect(packets.back().data(),
+                                kHeaderSize + kPayloadSize, &length));
+  }
+  const size_t length = kHeaderSize + kPayloadSize + kMaxTagSize;
+
+  // The newest packet first, then one just within the window, twice.
+  std::vector<uint8_t> packet = packets.back();
+  size_t out_length;
+  EXPECT_TRUE(receiver->Unprotect(packet.data(), length, &out_length));
+  packet = packets[kReplayWindowSize];
+  EXPECT_TRUE(receiver->Unprotect(packet.data(), length, &out_length));
+  packet = packets[kReplayWindowSize];
+  EXPECT_FALSE(receiver->Unprotect(packet.data(), length, &out_length));
+  // Older than the window.
+  packet = packets[kReplayWindowSize - 1];
+  EXPECT_FALSE(receiver->Unprotect(packet.data(), length, &out_length));
+  EXPECT_EQ(2u, receiver->replayed_packets());
+}
+
+}  // namespace webrtc
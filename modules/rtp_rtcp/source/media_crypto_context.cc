@@ -0,0 +1,172 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/rtp_rtcp/include/media_crypto_context.h"
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/logging.h"
+#include "webrtc/modules/rtp_rtcp/source/media_crypto_cipher.h"
+
+namespace webrtc {
+namespace {
+// Highest packet rate the replay window is sized for, about 20 Mbps of full
+// size packets.
+constexpr size_t kMaxPacketsPerSecond = 2000;
+}  // namespace
+
+MediaCryptoContext::LazyCipher::LazyCipher(const MediaCryptoKey& key,
+                                           bool outbound)
+    : key_(key),
+      outbound_(outbound),
+      failed_(false),
+      replay_window_size_(MediaCryptoCipher::kDefaultReplayWindowSize) {}
+
+MediaCryptoContext::LazyCipher::~LazyCipher() {}
+
+const char* MediaCryptoContext::LazyCipher::name() const {
+  rtc::CritScope lock(&crit_);
+  return cipher_ ? cipher_->name() : nullptr;
+}
+
+size_t MediaCryptoContext::LazyCipher::replayed_packets() const {
+  rtc::CritScope lock(&crit_);
+  return cipher_ ? cipher_->replayed_packets() : 0;
+}
+
+bool MediaCryptoContext::LazyCipher::Prewarm() {
+  rtc::CritScope lock(&crit_);
+  return GetOrCreate() != nullptr;
+}
+
+bool MediaCryptoContext::LazyCipher::SetMinReplayWindowSize(size_t packets) {
+  rtc::CritScope lock(&crit_);
+  if (packets <= replay_window_size_)
+    return true;
+  if (cipher_) {
+    LOG(LS_WARNING) << "E2E media crypto replay window of "
+                    << replay_window_size_ << " packets can not grow to "
+                    << packets << ", cipher already created";
+    return false;
+  }
+  replay_window_size_ = packets;
+  return true;
+}
+
+bool MediaCryptoContext::LazyCipher::Protect(uint8_t* packet,
+                                             size_t length,
+                                             size_t* out_length) {
+  rtc::CritScope lock(&crit_);
+  MediaCryptoCipher* cipher = GetOrCreate();
+  return cipher && cipher->Protect(packet, length, out_length);
+}
+
+bool MediaCryptoContext::LazyCipher::Unprotect(uint8_t* packet,
+                                               size_t length,
+                                               size_t* out_length,
+                                               bool* replayed) {
+  rtc::CritScope lock(&crit_);
+  *replayed = false;
+  MediaCryptoCipher* cipher = GetOrCreate();
+  if (!cipher)
+    return false;
+  // The lock is held, so only this packet can have been counted.
+  const size_t replayed_packets = cipher->replayed_packets();
+  if (cipher->Unprotect(packet, length, out_length))
+    return true;
+  *replayed = cipher->replayed_packets() != replayed_packets;
+  return false;
+}
+
+MediaCryptoCipher* MediaCryptoContext::LazyCipher::GetOrCreate() {
+  if (cipher_ || failed_)
+    return cipher_.get();
+
+  cipher_ = MediaCryptoCipher::Create(
+      outbound_ ? MediaCryptoCipher::Direction::kOutbound
+                : MediaCryptoCipher::Direction::kInbound,
+      key_, replay_window_size_);
+  if (!cipher_) {
+    LOG(LS_ERROR) << "Failed to create E2E media crypto "
+                  << (outbound_ ? "outbound" : "inbound") << " cipher";
+    failed_ = true;
+    return nullptr;
+  }
+  LOG(LS_INFO) << "E2E media crypto " << (outbound_ ? "outbound" : "inbound")
+               << " cipher created using " << cipher_->name() << " backend";
+  return cipher_.get();
+}
+
+std::unique_ptr<MediaCryptoContext> MediaCryptoContext::Create(
+    const MediaCryptoKey& key) {
+  size_t auth_tag_length;
+  if (!MediaCryptoCipher::GetAuthTagLength(key, &auth_tag_length)) {
+    LOG(LS_ERROR) << "Failed to create E2E media crypto context";
+    return nullptr;
+  }
+  return std::unique_ptr<MediaCryptoContext>(
+      new MediaCryptoContext(key, auth_tag_length));
+}
+
+MediaCryptoContext::MediaCryptoContext(const MediaCryptoKey& key,
+                                       size_t auth_tag_length)
+    : key_(key),
+      auth_tag_length_(auth_tag_length),
+      outbound_(key_, true),
+      inbound_(key_, false) {}
+
+MediaCryptoContext::~MediaCryptoContext() {}
+
+size_t MediaCryptoContext::ReplayWindowSizeForHistory(int rtp_history_ms) {
+  size_t packets = rtp_history_ms > 0
+                       ? rtp_history_ms * kMaxPacketsPerSecond / 1000
+                       : 0;
+  return std::max(packets, MediaCryptoCipher::kDefaultReplayWindowSize);
+}
+
+const char* MediaCryptoContext::outbound_cipher_name() const {
+  return outbound_.name();
+}
+
+const char* MediaCryptoContext::inbound_cipher_name() const {
+  return inbound_.name();
+}
+
+bool MediaCryptoContext::PrewarmOutbound() {
+  return outbound_.Prewarm();
+}
+
+bool MediaCryptoContext::PrewarmInbound() {
+  return inbound_.Prewarm();
+}
+
+bool MediaCryptoContext::SetMinReplayWindowSize(size_t packets) {
+  return inbound_.SetMinReplayWindowSize(packets);
+}
+
+size_t MediaCryptoContext::replayed_packets() const {
+  return inbound_.replayed_packets();
+}
+
+bool MediaCryptoContext::Protect(uint8_t* packet,
+                                 size_t length,
+                                 size_t* out_length) {
+  return outbound_.Protect(packet, length, out_length);
+}
+
+bool MediaCryptoContext::Unprotect(uint8_t* packet,
+                                   size_t length,
+                                   size_t* out_length,
+                                   bool* replayed) {
+  return inbound_.Unprotect(packet, length, out_length, replayed);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,294 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "third_party/libsrtp/include/srtp.h"
+#include "webrtc/base/rate_limiter.h"
+#include "webrtc/base/sslstreamadapter.h"
+#include "webrtc/modules/rtp_rtcp/include/media_crypto_worker_pool.h"
+#include "webrtc/modules/rtp_rtcp/source/media_crypto.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_sender.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_sender_video.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+// Roughly a 1080p key frame.
+constexpr size_t kPacketsPerFrame = 120;
+constexpr size_t kPayloadSize = 1100;
+constexpr size_t kMaxPacketSize = 1500;
+constexpr size_t kNumFrames = 200;
+// From an audio frame up to a full video packet.
+constexpr size_t kPayloadSizes[] = {60, 200, 500, 1200};
+constexpr size_t kNumPackets = 10000;
+constexpr uint32_t kSsrc = 0x12345678;
+constexpr int8_t kVideoPayloadType = 96;
+// Roughly a 720p key frame.
+constexpr size_t kVideoFrameSize = 100000;
+// AES-256-GCM uses a 32 bytes key and a 12 bytes salt.
+constexpr size_t kKeyAndSaltSize = 44;
+
+MediaCryptoKey CreateKey() {
+  MediaCryptoKey key;
+  key.type = rtc::SRTP_AEAD_AES_256_GCM;
+  for (size_t i = 0; i < kKeyAndSaltSize; ++i)
+    key.buffer.push_back(static_cast<uint8_t>(i));
+  return key;
+}
+
+class Frame {
+ public:
+  explicit Frame(uint16_t first_sequence_number) {
+    const uint8_t payload[kPayloadSize] = {0};
+    for (size_t i = 0; i < kPacketsPerFrame; ++i) {
+      packets_.emplace_back(new RtpPacketToSend(nullptr, kMaxPacketSize));
+      RtpPacketToSend* packet = packets_.back().get();
+      packet->SetPayloadType(96);
+      packet->SetSequenceNumber(first_sequence_number + i);
+      packet->SetTimestamp(first_sequence_number * 3000);
+      packet->SetSsrc(kSsrc);
+      packet->SetMarker(i == kPacketsPerFrame - 1);
+      memcpy(packet->AllocatePayload(kPayloadSize), payload, kPayloadSize);
+      raw_packets_.push_back(packet);
+    }
+  }
+
+  const std::vector<rtp::Packet*>& packets() const { return raw_packets_; }
+
+ private:
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets_;
+  std::vector<rtp::Packet*> raw_packets_;
+};
+
+// Returns the average time in microseconds spent encrypting one frame.
+double EncryptFrames(bool batch) {
+  MediaCrypto media_crypto;
+  EXPECT_TRUE(media_crypto.SetOutboundKey(CreateKey()));
+
+  std::vector<std::unique_ptr<Frame>> frames;
+  for (size_t i = 0; i < kNumFrames; ++i)
+    frames.emplace_back(new Frame(i * kPacketsPerFrame));
+
+  Clock* clock = Clock::GetRealTimeClock();
+  int64_t start_time_us = clock->TimeInMicroseconds();
+  for (const auto& frame : frames) {
+    if (batch) {
+      EXPECT_TRUE(media_crypto.EncryptBatch(frame->packets()));
+    } else {
+      for (rtp::Packet* packet : frame->packets())
+        EXPECT_TRUE(media_crypto.Encrypt(packet));
+    }
+  }
+  return static_cast<double>(clock->TimeInMicroseconds() - start_time_us) /
+         kNumFrames;
+}
+
+// Packets as seen by the receiver: the outer header and the encrypted
+// payload.
+struct ReceivedPacket {
+  std::vector<uint8_t> data;
+  size_t headers_size;
+};
+
+struct PacketResults {
+  double encrypt_ns;
+  double decrypt_ns;
+  double reallocations;
+  double encrypt_bytes_copied;
+  double decrypt_bytes_copied;
+};
+
+// Encrypts then decrypts |kNumPackets| packets one at a time. Times are per
+// packet, reallocations counts the packets whose buffer moved while growing
+// for the OHB and tag.
+PacketResults EncryptDecryptPackets(size_t payload_size) {
+  MediaCrypto sender;
+  MediaCrypto receiver;
+  EXPECT_TRUE(sender.SetOutboundKey(CreateKey()));
+  EXPECT_TRUE(receiver.SetInboundKey(CreateKey()));
+
+  const std::vector<uint8_t> payload(payload_size, 0);
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  std::vector<const uint8_t*> buffers;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    packets.emplace_back(new RtpPacketToSend(nullptr, kMaxPacketSize));
+    RtpPacketToSend* packet = packets.back().get();
+    packet->SetPayloadType(kVideoPayloadType);
+    packet->SetSequenceNumber(i);
+    packet->SetTimestamp(i * 3000);
+    packet->SetSsrc(kSsrc);
+    memcpy(packet->AllocatePayload(payload_size), payload.data(),
+           payload_size);
+    buffers.push_back(packet->data());
+  }
+
+  PacketResults results;
+  Clock* clock = Clock::GetRealTimeClock();
+  int64_t start_time_us = clock->TimeInMicroseconds();
+  for (const auto& packet : packets)
+    EXPECT_TRUE(sender.Encrypt(packet.get()));
+  results.encrypt_ns =
+      1000.0 * (clock->TimeInMicroseconds() - start_time_us) / kNumPackets;
+
+  size_t reallocations = 0;
+  std::vector<ReceivedPacket> received;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    if (packets[i]->data() != buffers[i])
+      ++reallocations;
+    received.push_back(ReceivedPacket{
+        std::vector<uint8_t>(packets[i]->data(),
+                             packets[i]->data() + packets[i]->size()),
+        packets[i]->headers_size()});
+  }
+
+  start_time_us = clock->TimeInMicroseconds();
+  for (ReceivedPacket& packet : received) {
+    uint8_t* data = packet.data.data() + packet.headers_size;
+    size_t length = packet.data.size() - packet.headers_size;
+    EXPECT_TRUE(receiver.DecryptInPlace(&data, &length));
+  }
+  results.decrypt_ns =
+      1000.0 * (clock->TimeInMicroseconds() - start_time_us) / kNumPackets;
+
+  results.reallocations = static_cast<double>(reallocations) / kNumPackets;
+  results.encrypt_bytes_copied =
+      static_cast<double>(sender.bytes_copied()) / kNumPackets;
+  results.decrypt_bytes_copied =
+      static_cast<double>(receiver.bytes_copied()) / kNumPackets;
+  return results;
+}
+
+class CountingTransport : public Transport {
+ public:
+  CountingTransport() : packets_sent_(0) {}
+
+  bool SendRtp(const uint8_t* data,
+               size_t len,
+               const PacketOptions& options) override {
+    ++packets_sent_;
+    return true;
+  }
+  bool SendRtcp(const uint8_t* data, size_t len) override { return false; }
+
+  size_t packets_sent() const { return packets_sent_; }
+
+ private:
+  size_t packets_sent_;
+};
+
+enum class SendMode { kNoCrypto, kCrypto, kCryptoWorkerPool };
+
+// Returns the average time in microseconds from handing a key frame to
+// RTPSenderVideo to all its packets reaching the transport.
+double SendKeyFrames(SendMode mode) {
+  SimulatedClock fake_clock(123456);
+  RateLimiter retransmission_rate_limiter(&fake_clock, 1000);
+  CountingTransport transport;
+  MediaCryptoWorkerPool worker_pool(2);
+  std::unique_ptr<RTPSender> rtp_sender(new RTPSender(
+      false, &fake_clock, &transport, nullptr, nullptr, nullptr, nullptr,
+      nullptr, nullptr, nullptr, nullptr, nullptr,
+      &retransmission_rate_limiter, nullptr));
+  rtp_sender->SetSSRC(kSsrc);
+  rtp_sender->SetSequenceNumber(0);
+  if (mode != SendMode::kNoCrypto) {
+    EXPECT_TRUE(rtp_sender->EnableMediaCrypto(CreateKey()));
+  }
+  if (mode == SendMode::kCryptoWorkerPool)
+    rtp_sender->SetMediaCryptoWorkerPool(&worker_pool);
+  RTPSenderVideo rtp_sender_video(&fake_clock, rtp_sender.get(), nullptr);
+
+  const std::vector<uint8_t> frame(kVideoFrameSize, 0);
+  RTPVideoHeader video_header = {0};
+  Clock* clock = Clock::GetRealTimeClock();
+  int64_t start_time_us = clock->TimeInMicroseconds();
+  for (size_t i = 0; i < kNumFrames; ++i) {
+    EXPECT_TRUE(rtp_sender_video.SendVideo(
+        kRtpVideoGeneric, kVideoFrameKey, kVideoPayloadType, i * 3000,
+        fake_clock.TimeInMilliseconds(), frame.data(), frame.size(), nullptr,
+        &video_header));
+    if (mode == SendMode::kCryptoWorkerPool)
+      worker_pool.Flush();
+  }
+  double frame_us =
+      static_cast<double>(clock->TimeInMicroseconds() - start_time_us) /
+      kNumFrames;
+  EXPECT_GE(transport.packets_sent(), kNumFrames * kVideoFrameSize /
+                                          kMaxPacketSize);
+  return frame_us;
+}
+
+}  // namespace
+
+class MediaCryptoPerformanceTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() { srtp_init(); }
+};
+
+// Compares encrypting a packetized key frame packet by packet with
+// encrypting it as one batch.
+TEST_F(MediaCryptoPerformanceTest, EncryptKeyFrame) {
+  double per_packet_us = EncryptFrames(false);
+  double batch_us = EncryptFrames(true);
+
+  test::PrintResult("media_crypto_encrypt_frame", "", "per_packet",
+                    per_packet_us, "us", false);
+  test::PrintResult("media_crypto_encrypt_frame", "", "batch", batch_us, "us",
+                    false);
+}
+
+TEST_F(MediaCryptoPerformanceTest, EncryptDecryptPayloadSizes) {
+  for (size_t payload_size : kPayloadSizes) {
+    PacketResults results = EncryptDecryptPackets(payload_size);
+    std::string modifier = "_" + std::to_string(payload_size) + "B";
+
+    test::PrintResult("media_crypto_encrypt", modifier, "time_per_packet",
+                      results.encrypt_ns, "ns", false);
+    test::PrintResult("media_crypto_decrypt", modifier, "time_per_packet",
+                      results.decrypt_ns, "ns", false);
+    test::PrintResult("media_crypto_encrypt", modifier, "throughput",
+                      8 * payload_size / results.encrypt_ns * 1000, "Mbps",
+                      false);
+    test::PrintResult("media_crypto_decrypt", modifier, "throughput",
+                      8 * payload_size / results.decrypt_ns * 1000, "Mbps",
+                      false);
+    test::PrintResult("media_crypto_encrypt", modifier,
+                      "reallocations_per_packet", results.reallocations, "",
+                      false);
+    test::PrintResult("media_crypto_encrypt", modifier,
+                      "bytes_copied_per_packet", results.encrypt_bytes_copied,
+                      "bytes", false);
+    test::PrintResult("media_crypto_decrypt", modifier,
+                      "bytes_copied_per_packet", results.decrypt_bytes_copied,
+                      "bytes", false);
+  }
+}
+
+// Cost of the inner layer on the send path, from RTPSenderVideo::SendVideo to
+// the transport.
+TEST_F(MediaCryptoPerformanceTest, SendLatency) {
+  test::PrintResult("media_crypto_send_key_frame", "", "no_crypto",
+                    SendKeyFrames(SendMode::kNoCrypto), "us", false);
+  test::PrintResult("media_crypto_send_key_frame", "", "crypto",
+                    SendKeyFrames(SendMode::kCrypto), "us", false);
+  test::PrintResult("media_crypto_send_key_frame", "", "crypto_worker_pool",
+                    SendKeyFrames(SendMode::kCryptoWorkerPool), "us", false);
+}
+
+}  // namespace webrtc
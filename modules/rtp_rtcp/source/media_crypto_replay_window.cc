@@ -0,0 +1,82 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/rtp_rtcp/source/media_crypto_replay_window.h"
+
+#include <algorithm>
+
+namespace webrtc {
+namespace {
+constexpr uint64_t kBitsPerWord = 64;
+
+uint64_t Bit(uint64_t index) {
+  return uint64_t{1} << (index % kBitsPerWord);
+}
+}  // namespace
+
+MediaCryptoReplayWindow::MediaCryptoReplayWindow(size_t size)
+    : bitmap_((std::max<size_t>(size, 1) + kBitsPerWord - 1) / kBitsPerWord,
+              0),
+      started_(false),
+      highest_index_(0) {}
+
+MediaCryptoReplayWindow::~MediaCryptoReplayWindow() {}
+
+bool MediaCryptoReplayWindow::Check(uint64_t index) const {
+  if (!started_ || index > highest_index_)
+    return true;
+  if (highest_index_ - index >= size())
+    return false;
+  return (*Word(index) & Bit(index)) == 0;
+}
+
+void MediaCryptoReplayWindow::Add(uint64_t index) {
+  if (!started_) {
+    started_ = true;
+    highest_index_ = index;
+  } else if (index > highest_index_) {
+    // Forget the indexes the window slides over, a word at a time when
+    // possible.
+    if (index - highest_index_ >= size()) {
+      std::fill(bitmap_.begin(), bitmap_.end(), 0);
+    } else {
+      uint64_t i = highest_index_ + 1;
+      while (i <= index) {
+        if (i % kBitsPerWord == 0 && index - i >= kBitsPerWord - 1) {
+          *Word(i) = 0;
+          i += kBitsPerWord;
+        } else {
+          *Word(i) &= ~Bit(i);
+          ++i;
+        }
+      }
+    }
+    highest_index_ = index;
+  } else if (highest_index_ - index >= size()) {
+    return;
+  }
+  *Word(index) |= Bit(index);
+}
+
+bool MediaCryptoReplayWindow::Contains(uint64_t index) const {
+  if (!started_ || index > highest_index_ || highest_index_ - index >= size())
+    return false;
+  return (*Word(index) & Bit(index)) != 0;
+}
+
+uint64_t* MediaCryptoReplayWindow::Word(uint64_t index) {
+  return &bitmap_[(index / kBitsPerWord) % bitmap_.size()];
+}
+
+const uint64_t* MediaCryptoReplayWindow::Word(uint64_t index) const {
+  return &bitmap_[(index / kBitsPerWord) % bitmap_.size()];
+}
+
+}  // namespace webrtc
@@ -0,0 +1,54 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_RTP_RTCP_SOURCE_MEDIA_CRYPTO_REPLAY_WINDOW_H_
+#define WEBRTC_MODULES_RTP_RTCP_SOURCE_MEDIA_CRYPTO_REPLAY_WINDOW_H_
+
+#include <stddef.h>
+
+#include <vector>
+
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+// Replay protection for one inner PERC stream, RFC 3711 section 3.3.2. The
+// packets received within |size| of the highest index are kept in a circular
+// bitmap, so a window covering the whole NACK history costs a few hundred
+// bytes and checking a packet is a single bit test. Not thread safe.
+class MediaCryptoReplayWindow {
+ public:
+  // |size| is rounded up to a multiple of 64 packets.
+  explicit MediaCryptoReplayWindow(size_t size);
+  ~MediaCryptoReplayWindow();
+
+  size_t size() const { return bitmap_.size() * 64; }
+
+  // Returns false if the packet with the 48 bits |index| (ROC and sequence
+  // number) was already received, or is too old to tell.
+  bool Check(uint64_t index) const;
+  // Records |index| as received. Call once the packet has been authenticated.
+  void Add(uint64_t index);
+  // Returns true if |index| was added and is still within the window. Unlike
+  // Check, packets too old to tell are not reported.
+  bool Contains(uint64_t index) const;
+
+ private:
+  uint64_t* Word(uint64_t index);
+  const uint64_t* Word(uint64_t index) const;
+
+  std::vector<uint64_t> bitmap_;
+  bool started_;
+  uint64_t highest_index_;
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_RTP_RTCP_SOURCE_MEDIA_CRYPTO_REPLAY_WINDOW_H_
@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/rtp_rtcp/source/media_crypto_replay_window.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+TEST(MediaCryptoReplayWindowTest, RoundsSizeUpToWords) {
+  EXPECT_EQ(64u, MediaCryptoReplayWindow(1).size());
+  EXPECT_EQ(2048u, MediaCryptoReplayWindow(2000).size());
+}
+
+TEST(MediaCryptoReplayWindowTest, RejectsDuplicates) {
+  MediaCryptoReplayWindow window(128);
+  EXPECT_TRUE(window.Check(1000));
+  window.Add(1000);
+  EXPECT_FALSE(window.Check(1000));
+  EXPECT_TRUE(window.Check(1001));
+  EXPECT_TRUE(window.Check(999));
+  window.Add(999);
+  EXPECT_FALSE(window.Check(999));
+}
+
+TEST(MediaCryptoReplayWindowTest, AcceptsReorderingWithinWindow) {
+  MediaCryptoReplayWindow window(2048);
+  for (uint64_t index = 0; index < 5000; index += 2)
+    window.Add(index);
+  // Odd indexes within the last 2048 packets are still accepted, once.
+  for (uint64_t index = 4999 - 2046; index < 5000; index += 2) {
+    EXPECT_TRUE(window.Check(index)) << index;
+    window.Add(index);
+    EXPECT_FALSE(window.Check(index)) << index;
+  }
+  // Older than the window.
+  EXPECT_FALSE(window.Check(4998 - 2048));
+}
+
+TEST(MediaCryptoReplayWindowTest, ForgetsIndexesWhenSliding) {
+  MediaCryptoReplayWindow window(64);
+  window.Add(10);
+  // Slides by exactly the window size, so slot 10 is reused for index 74.
+  window.Add(73);
+  EXPECT_TRUE(window.Check(74));
+  window.Add(74 + 1000);
+  EXPECT_FALSE(window.Check(73));
+  EXPECT_TRUE(window.Check(74 + 999));
+  EXPECT_FALSE(window.Check(74 + 1000));
+}
+
+TEST(MediaCryptoReplayWindowTest, ContainsOnlyAddedIndexesWithinWindow) {
+  MediaCryptoReplayWindow window(64);
+  EXPECT_FALSE(window.Contains(10));
+  window.Add(10);
+  EXPECT_TRUE(window.Contains(10));
+  EXPECT_FALSE(window.Contains(11));
+  window.Add(100);
+  // Too old to tell: rejected by Check, but not known to have been added.
+  EXPECT_FALSE(window.Check(20));
+  EXPECT_FALSE(window.Contains(20));
+  EXPECT_FALSE(window.Contains(10));
+  EXPECT_TRUE(window.Contains(100));
+}
+
+}  // namespace webrtc
@@ -0,0 +1,344 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <vector>
+
+#include "third_party/libsrtp/include/srtp.h"
+#include "webrtc/base/sslstreamadapter.h"
+#include "webrtc/modules/rtp_rtcp/source/media_crypto.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "webrtc/test/gmock.h"
+#include "webrtc/test/gtest.h"
+
+using testing::ElementsAreArray;
+using testing::make_tuple;
+
+namespace webrtc {
+namespace {
+constexpr uint8_t kPayloadType = 100;
+constexpr uint16_t kSeqNum = 0x1234;
+constexpr uint32_t kTimestamp = 0x65431278;
+constexpr uint32_t kSsrc = 0x12345678;
+constexpr size_t kPayloadSize = 200;
+constexpr size_t kMaxPacketSize = 1500;
+// AES-256-GCM uses a 32 bytes key and a 12 bytes salt.
+constexpr size_t kKeyAndSaltSize = 44;
+
+MediaCryptoKey CreateKey(uint8_t seed) {
+  MediaCryptoKey key;
+  key.type = rtc::SRTP_AEAD_AES_256_GCM;
+  key.id = seed;
+  for (size_t i = 0; i < kKeyAndSaltSize; ++i)
+    key.buffer.push_back(static_cast<uint8_t>(seed + i));
+  return key;
+}
+
+std::unique_ptr<RtpPacketToSend> CreatePacket(const uint8_t* payload,
+                                              size_t payload_size) {
+  std::unique_ptr<RtpPacketToSend> packet(
+      new RtpPacketToSend(nullptr, kMaxPacketSize));
+  packet->SetMarker(true);
+  packet->SetPayloadType(kPayloadType);
+  packet->SetSequenceNumber(kSeqNum);
+  packet->SetTimestamp(kTimestamp);
+  packet->SetSsrc(kSsrc);
+  memcpy(packet->AllocatePayload(payload_size), payload, payload_size);
+  return packet;
+}
+
+// Decrypts a copy of |packet| with |receiver|, checks it matches |expected|.
+bool DecryptMatches(MediaCrypto* receiver,
+                    const RtpPacketToSend& packet,
+                    const std::vector<uint8_t>& expected) {
+  std::vector<uint8_t> received(packet.data(), packet.data() + packet.size());
+  uint8_t* payload = received.data() + packet.headers_size();
+  size_t length = packet.payload_size();
+  if (!receiver->DecryptInPlace(&payload, &length))
+    return false;
+  return std::vector<uint8_t>(payload, payload + length) == expected;
+}
+}  // namespace
+
+class MediaCryptoTest : public ::testing::Test {
+ protected:
+  static void SetUpTestCase() { srtp_init(); }
+
+  MediaCryptoTest() : payload_(kPayloadSize) {
+    for (size_t i = 0; i < payload_.size(); ++i)
+      payload_[i] = static_cast<uint8_t>(i);
+  }
+
+  void SetUp() override {
+    ASSERT_TRUE(sender_.SetOutboundKey(CreateKey(1)));
+    ASSERT_TRUE(receiver_.SetInboundKey(CreateKey(1)));
+  }
+
+  std::vector<uint8_t> payload_;
+  MediaCrypto sender_;
+  MediaCrypto receiver_;
+};
+
+TEST_F(MediaCryptoTest, EncryptKeepsOuterHeader) {
+  std::unique_ptr<RtpPacketToSend> packet =
+      CreatePacket(payload_.data(), payload_.size());
+  std::vector<uint8_t> header(packet->data(),
+                              packet->data() + packet->headers_size());
+
+  ASSERT_TRUE(sender_.Encrypt(packet.get()));
+  EXPECT_EQ(kPayloadSize + sender_.GetEncryptionOverhead(),
+            packet->payload_size());
+  EXPECT_THAT(make_tuple(packet->data(), header.size()),
+              ElementsAreArray(header));
+  EXPECT_TRUE(packet->Marker());
+  EXPECT_EQ(kPayloadType, packet->PayloadType());
+  EXPECT_EQ(kSeqNum, packet->SequenceNumber());
+  EXPECT_EQ(kTimestamp, packet->Timestamp());
+  EXPECT_EQ(kSsrc, packet->Ssrc());
+}
+
+TEST_F(MediaCryptoTest, EncryptDecryptRoundTrip) {
+  std::unique_ptr<RtpPacketToSend> packet =
+      CreatePacket(payload_.data(), payload_.size());
+  ASSERT_TRUE(sender_.Encrypt(packet.get()));
+
+  std::vector<uint8_t> received(packet->data(),
+                                packet->data() + packet->size());
+  uint8_t* payload = received.data() + packet->headers_size();
+  size_t length = packet->payload_size();
+  ASSERT_TRUE(receiver_.Decrypt(payload, &length));
+  EXPECT_THAT(make_tuple(payload, length), ElementsAreArray(payload_));
+  EXPECT_EQ(kPayloadSize, receiver_.bytes_copied());
+}
+
+TEST_F(MediaCryptoTest, DecryptInPlaceDoesNotCopy) {
+  std::unique_ptr<RtpPacketToSend> packet =
+      CreatePacket(payload_.data(), payload_.size());
+  ASSERT_TRUE(sender_.Encrypt(packet.get()));
+
+  std::vector<uint8_t> received(packet->data(),
+                                packet->data() + packet->size());
+  uint8_t* payload = received.data() + packet->headers_size();
+  uint8_t* decrypted = payload;
+  size_t length = packet->payload_size();
+  ASSERT_TRUE(receiver_.DecryptInPlace(&decrypted, &length));
+  EXPECT_GT(decrypted, payload);
+  EXPECT_LT(decrypted + length, received.data() + received.size());
+  EXPECT_THAT(make_tuple(decrypted, length), ElementsAreArray(payload_));
+  // Outer header must be left untouched.
+  EXPECT_THAT(make_tuple(received.data(), packet->headers_size()),
+              ElementsAreArray(packet->data(), packet->headers_size()));
+  EXPECT_EQ(0u, receiver_.bytes_copied());
+}
+
+TEST_F(MediaCryptoTest, CountsCryptoStats) {
+  std::unique_ptr<RtpPacketToSend> packet =
+      CreatePacket(payload_.data(), payload_.size());
+  ASSERT_TRUE(sender_.Encrypt(packet.get()));
+  MediaCryptoStats stats = sender_.stats();
+  EXPECT_GT(stats.encrypt_time_ns, 0);
+  EXPECT_EQ(12 + kPayloadSize, stats.bytes_encrypted);
+  EXPECT_EQ(0u, stats.encrypt_failures);
+
+  EXPECT_TRUE(DecryptMatches(&receiver_, *packet, payload_));
+  // The same packet again is a replay.
+  EXPECT_FALSE(DecryptMatches(&receiver_, *packet, payload_));
+  // A packet with a corrupted tag fails to authenticate.
+  packet = CreatePacket(payload_.data(), payload_.size());
+  packet->SetSequenceNumber(kSeqNum + 1);
+  ASSERT_TRUE(sender_.Encrypt(packet.get()));
+  packet->data()[packet->size() - 1] ^= 0xff;
+  EXPECT_FALSE(DecryptMatches(&receiver_, *packet, payload_));
+
+  stats = receiver_.stats();
+  EXPECT_GT(stats.decrypt_time_ns, 0);
+  EXPECT_EQ(kPayloadSize + sender_.GetEncryptionOverhead(),
+            stats.bytes_decrypted);
+  EXPECT_EQ(1u, stats.replay_drops);
+  EXPECT_EQ(1u, stats.auth_failures);
+}
+
+TEST_F(MediaCryptoTest, EncryptFailsWithoutRoomForOverhead) {
+  std::unique_ptr<RtpPacketToSend> packet(
+      new RtpPacketToSend(nullptr, 12 + kPayloadSize));
+  memcpy(packet->AllocatePayload(kPayloadSize), payload_.data(), kPayloadSize);
+
+  EXPECT_FALSE(sender_.Encrypt(packet.get()));
+  EXPECT_THAT(make_tuple(packet->payload().data(), packet->payload_size()),
+              ElementsAreArray(payload_));
+}
+
+TEST_F(MediaCryptoTest, EncryptBatchEncryptsAllPackets) {
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  std::vector<rtp::Packet*> batch;
+  for (uint16_t i = 0; i < 3; ++i) {
+    packets.push_back(CreatePacket(payload_.data(), payload_.size()));
+    packets.back()->SetSequenceNumber(kSeqNum + i);
+    batch.push_back(packets.back().get());
+  }
+  ASSERT_TRUE(sender_.EncryptBatch(batch));
+
+  for (const auto& packet : packets) {
+    std::vector<uint8_t> received(packet->data(),
+                                  packet->data() + packet->size());
+    uint8_t* payload = received.data() + packet->headers_size();
+    size_t length = packet->payload_size();
+    ASSERT_TRUE(receiver_.DecryptInPlace(&payload, &length));
+    EXPECT_THAT(make_tuple(payload, length), ElementsAreArray(payload_));
+  }
+}
+
+TEST_F(MediaCryptoTest, EncryptBatchLeavesFrameUntouchedOnFailure) {
+  std::unique_ptr<RtpPacketToSend> fits =
+      CreatePacket(payload_.data(), payload_.size());
+  std::unique_ptr<RtpPacketToSend> too_big(
+      new RtpPacketToSend(nullptr, 12 + kPayloadSize));
+  memcpy(too_big->AllocatePayload(kPayloadSize), payload_.data(),
+         kPayloadSize);
+  std::vector<rtp::Packet*> batch = {fits.get(), too_big.get()};
+
+  EXPECT_FALSE(sender_.EncryptBatch(batch));
+  EXPECT_THAT(make_tuple(fits->payload().data(), fits->payload_size()),
+              ElementsAreArray(payload_));
+  EXPECT_THAT(make_tuple(too_big->payload().data(), too_big->payload_size()),
+              ElementsAreArray(payload_));
+}
+
+TEST_F(MediaCryptoTest, DecryptFailsOnTamperedPayload) {
+  std::unique_ptr<RtpPacketToSend> packet =
+      CreatePacket(payload_.data(), payload_.size());
+  ASSERT_TRUE(sender_.Encrypt(packet.get()));
+
+  std::vector<uint8_t> received(packet->data(),
+                                packet->data() + packet->size());
+  received[packet->headers_size() + packet->payload_size() / 2] ^= 0xff;
+  uint8_t* payload = received.data() + packet->headers_size();
+  size_t length = packet->payload_size();
+  EXPECT_FALSE(receiver_.DecryptInPlace(&payload, &length));
+  EXPECT_EQ(received.data() + packet->headers_size(), payload);
+  EXPECT_EQ(packet->payload_size(), length);
+}
+
+TEST_F(MediaCryptoTest, StreamsShareOneContext) {
+  std::unique_ptr<MediaCryptoContext> context =
+      MediaCryptoContext::Create(CreateKey(2));
+  ASSERT_TRUE(context);
+  MediaCrypto sender1;
+  MediaCrypto sender2;
+  MediaCrypto receiver1;
+  MediaCrypto receiver2;
+  ASSERT_TRUE(sender1.SetOutboundContext(context.get()));
+  ASSERT_TRUE(sender2.SetOutboundContext(context.get()));
+  ASSERT_TRUE(receiver1.SetInboundContext(context.get()));
+  ASSERT_TRUE(receiver2.SetInboundContext(context.get()));
+  EXPECT_FALSE(receiver1.SetInboundKey(CreateKey(2)));
+
+  std::unique_ptr<RtpPacketToSend> packet1 =
+      CreatePacket(payload_.data(), payload_.size());
+  std::unique_ptr<RtpPacketToSend> packet2 =
+      CreatePacket(payload_.data(), payload_.size());
+  packet2->SetSsrc(kSsrc + 1);
+  ASSERT_TRUE(sender1.Encrypt(packet1.get()));
+  ASSERT_TRUE(sender2.Encrypt(packet2.get()));
+
+  std::vector<std::pair<MediaCrypto*, RtpPacketToSend*>> streams = {
+      {&receiver1, packet1.get()}, {&receiver2, packet2.get()}};
+  for (const auto& stream : streams) {
+    RtpPacketToSend* packet = stream.second;
+    std::vector<uint8_t> received(packet->data(),
+                                  packet->data() + packet->size());
+    uint8_t* payload = received.data() + packet->headers_size();
+    size_t length = packet->payload_size();
+    ASSERT_TRUE(stream.first->DecryptInPlace(&payload, &length));
+    EXPECT_THAT(make_tuple(payload, length), ElementsAreArray(payload_));
+  }
+}
+
+TEST_F(MediaCryptoTest, CreatesCipherOnFirstPacket) {
+  MediaCrypto media_crypto;
+  ASSERT_TRUE(media_crypto.SetOutboundKey(CreateKey(1)));
+  // The overhead (OHB and GCM tag) is known before the cipher exists.
+  EXPECT_EQ(12u + 16u, media_crypto.GetEncryptionOverhead());
+  EXPECT_FALSE(media_crypto.cipher_name());
+
+  std::unique_ptr<RtpPacketToSend> packet =
+      CreatePacket(payload_.data(), payload_.size());
+  ASSERT_TRUE(media_crypto.Encrypt(packet.get()));
+  EXPECT_TRUE(media_crypto.cipher_name());
+}
+
+TEST_F(MediaCryptoTest, PrewarmCreatesCipher) {
+  std::unique_ptr<MediaCryptoContext> context =
+      MediaCryptoContext::Create(CreateKey(1));
+  ASSERT_TRUE(context);
+  MediaCrypto media_crypto;
+  EXPECT_FALSE(media_crypto.Prewarm());
+  ASSERT_TRUE(media_crypto.SetInboundContext(context.get()));
+  ASSERT_TRUE(media_crypto.Prewarm());
+  EXPECT_TRUE(context->inbound_cipher_name());
+  EXPECT_FALSE(context->outbound_cipher_name());
+}
+
+TEST_F(MediaCryptoTest, KeyRotationKeepsPacketsInFlight) {
+  std::unique_ptr<RtpPacketToSend> old_packet =
+      CreatePacket(payload_.data(), payload_.size());
+  ASSERT_TRUE(sender_.Encrypt(old_packet.get()));
+  EXPECT_EQ(1, old_packet->payload()[0]);
+
+  // Receivers learn the new key before the sender starts using it.
+  ASSERT_TRUE(receiver_.UpdateKey(CreateKey(2)));
+  ASSERT_TRUE(sender_.UpdateKey(CreateKey(2)));
+  std::unique_ptr<RtpPacketToSend> new_packet =
+      CreatePacket(payload_.data(), payload_.size());
+  new_packet->SetSequenceNumber(kSeqNum + 1);
+  ASSERT_TRUE(sender_.Encrypt(new_packet.get()));
+  EXPECT_EQ(2, new_packet->payload()[0]);
+
+  // Reordered, the packet under the old key arrives last.
+  EXPECT_TRUE(DecryptMatches(&receiver_, *new_packet, payload_));
+  EXPECT_TRUE(DecryptMatches(&receiver_, *old_packet, payload_));
+
+  // Once rotated again, the first key is dropped.
+  ASSERT_TRUE(receiver_.UpdateKey(CreateKey(3)));
+  EXPECT_FALSE(DecryptMatches(&receiver_, *old_packet, payload_));
+  EXPECT_TRUE(DecryptMatches(&receiver_, *new_packet, payload_));
+}
+
+TEST_F(MediaCryptoTest, UpdateKeyRejectsInvalidKeys) {
+  // Same id as the current key.
+  EXPECT_FALSE(sender_.UpdateKey(CreateKey(1)));
+  // Different tag length than the current crypto suite.
+  MediaCryptoKey key = CreateKey(2);
+  key.type = rtc::SRTP_AES128_CM_SHA1_80;
+  key.buffer.resize(30);
+  EXPECT_FALSE(sender_.UpdateKey(key));
+  MediaCrypto media_crypto;
+  EXPECT_FALSE(media_crypto.UpdateKey(CreateKey(2)));
+}
+
+TEST_F(MediaCryptoTest, DecryptFailsWithUnknownKeyId) {
+  ASSERT_TRUE(sender_.UpdateKey(CreateKey(2)));
+  std::unique_ptr<RtpPacketToSend> packet =
+      CreatePacket(payload_.data(), payload_.size());
+  ASSERT_TRUE(sender_.Encrypt(packet.get()));
+  EXPECT_FALSE(DecryptMatches(&receiver_, *packet, payload_));
+}
+
+TEST_F(MediaCryptoTest, ContextRejectsInvalidKey) {
+  MediaCryptoKey key = CreateKey(1);
+  key.buffer.resize(kKeyAndSaltSize - 1);
+  EXPECT_FALSE(MediaCryptoContext::Create(key));
+  MediaCrypto media_crypto;
+  EXPECT_FALSE(media_crypto.SetOutboundKey(key));
+  EXPECT_FALSE(media_crypto.cipher_name());
+}
+
+}  // namespace webrtc
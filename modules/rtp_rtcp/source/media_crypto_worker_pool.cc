@@ -0,0 +1,48 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/rtp_rtcp/include/media_crypto_worker_pool.h"
+
+#include <string>
+#include <utility>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/event.h"
+
+namespace webrtc {
+
+MediaCryptoWorkerPool::MediaCryptoWorkerPool(size_t num_workers) {
+  RTC_DCHECK_GT(num_workers, 0u);
+  for (size_t i = 0; i < num_workers; ++i) {
+    std::string name = "MediaCryptoWorker" + std::to_string(i);
+    workers_.emplace_back(new rtc::TaskQueue(name.c_str()));
+  }
+}
+
+MediaCryptoWorkerPool::~MediaCryptoWorkerPool() {
+  // Make sure no task is left referencing its sender.
+  Flush();
+}
+
+void MediaCryptoWorkerPool::PostTask(uint32_t ssrc,
+                                     std::unique_ptr<rtc::QueuedTask> task) {
+  workers_[ssrc % workers_.size()]->PostTask(std::move(task));
+}
+
+void MediaCryptoWorkerPool::Flush() {
+  for (const auto& worker : workers_) {
+    RTC_DCHECK(!worker->IsCurrent());
+    rtc::Event done(false, false);
+    worker->PostTask([&done] { done.Set(); });
+    done.Wait(rtc::Event::kForever);
+  }
+}
+
+}  // namespace webrtc
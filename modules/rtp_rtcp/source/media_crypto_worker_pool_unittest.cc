@@ -0,0 +1,76 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/modules/rtp_rtcp/include/media_crypto_worker_pool.h"
+#include "webrtc/test/gmock.h"
+#include "webrtc/test/gtest.h"
+
+using testing::ElementsAre;
+
+namespace webrtc {
+namespace {
+constexpr size_t kNumWorkers = 2;
+constexpr uint32_t kSsrc1 = 1000;
+constexpr uint32_t kSsrc2 = 1001;
+
+class RecordingTask : public rtc::QueuedTask {
+ public:
+  RecordingTask(rtc::CriticalSection* crit, std::vector<int>* log, int value)
+      : crit_(crit), log_(log), value_(value) {}
+
+ private:
+  bool Run() override {
+    rtc::CritScope lock(crit_);
+    log_->push_back(value_);
+    return true;
+  }
+
+  rtc::CriticalSection* const crit_;
+  std::vector<int>* const log_;
+  const int value_;
+};
+}  // namespace
+
+TEST(MediaCryptoWorkerPoolTest, RunsTasksOfOneSsrcInOrder) {
+  rtc::CriticalSection crit;
+  std::vector<int> ssrc1_log;
+  std::vector<int> ssrc2_log;
+  MediaCryptoWorkerPool pool(kNumWorkers);
+  EXPECT_EQ(kNumWorkers, pool.num_workers());
+
+  for (int i = 0; i < 3; ++i) {
+    pool.PostTask(kSsrc1, std::unique_ptr<rtc::QueuedTask>(
+                              new RecordingTask(&crit, &ssrc1_log, i)));
+    pool.PostTask(kSsrc2, std::unique_ptr<rtc::QueuedTask>(
+                              new RecordingTask(&crit, &ssrc2_log, i)));
+  }
+  pool.Flush();
+
+  rtc::CritScope lock(&crit);
+  EXPECT_THAT(ssrc1_log, ElementsAre(0, 1, 2));
+  EXPECT_THAT(ssrc2_log, ElementsAre(0, 1, 2));
+}
+
+TEST(MediaCryptoWorkerPoolTest, DestructorRunsPendingTasks) {
+  rtc::CriticalSection crit;
+  std::vector<int> log;
+  {
+    MediaCryptoWorkerPool pool(kNumWorkers);
+    pool.PostTask(kSsrc1, std::unique_ptr<rtc::QueuedTask>(
+                              new RecordingTask(&crit, &log, 1)));
+  }
+  rtc::CritScope lock(&crit);
+  EXPECT_THAT(log, ElementsAre(1));
+}
+
+}  // namespace webrtc
@@ -0,0 +1,157 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/rtp_rtcp/include/perc_forwarder.h"
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "webrtc/modules/rtp_rtcp/source/byte_io.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_utility.h"
+
+namespace webrtc {
+namespace {
+constexpr int64_t kTimestampTicksPerMs = kVideoPayloadTypeFrequency / 1000;
+// Forward all the temporal layers until told otherwise.
+constexpr uint8_t kAllTemporalLayers = 0xFF;
+}  // namespace
+
+constexpr size_t PercForwarder::kNoStream;
+
+PercForwarder::PercForwarder(const RtpHeaderExtensionMap& extensions,
+                             const std::vector<uint32_t>& simulcast_ssrcs,
+                             uint32_t output_ssrc)
+    : extensions_(extensions),
+      simulcast_ssrcs_(simulcast_ssrcs),
+      output_ssrc_(output_ssrc),
+      target_stream_(0),
+      target_temporal_layer_(kAllTemporalLayers),
+      current_stream_(kNoStream),
+      current_temporal_layer_(kAllTemporalLayers),
+      sequence_number_offset_(0),
+      timestamp_offset_(0),
+      has_forwarded_(false),
+      last_sequence_number_(0),
+      last_timestamp_(0),
+      last_arrival_time_ms_(0),
+      packets_forwarded_(0),
+      packets_dropped_(0) {
+  RTC_DCHECK(!simulcast_ssrcs_.empty());
+}
+
+PercForwarder::~PercForwarder() = default;
+
+void PercForwarder::SetTargetLayers(size_t stream_index,
+                                    uint8_t max_temporal_layer) {
+  RTC_DCHECK_LT(stream_index, simulcast_ssrcs_.size());
+  target_stream_ = stream_index;
+  target_temporal_layer_ = max_temporal_layer;
+}
+
+bool PercForwarder::ForwardPacket(uint8_t* data,
+                                  size_t length,
+                                  int64_t arrival_time_ms) {
+  RTPHeader header;
+  RtpUtility::RtpHeaderParser parser(data, length);
+  if (!parser.Parse(&header, &extensions_))
+    return false;
+
+  size_t stream_index = StreamIndex(header.ssrc);
+  if (stream_index == kNoStream) {
+    ++packets_dropped_;
+    return false;
+  }
+
+  // Without frame marking every packet is treated as base layer. Frame
+  // boundaries are unknown, so the first stream is picked up at any packet,
+  // relying on the receiver to ask for a key frame, and is never switched.
+  const bool has_frame_marks = header.extension.hasFrameMarks;
+  const FrameMarks& frame_marks = header.extension.frameMarks;
+  const bool start_of_frame = has_frame_marks && frame_marks.startOfFrame;
+  const bool independent = start_of_frame && frame_marks.independent;
+  const uint8_t temporal_layer =
+      has_frame_marks ? frame_marks.temporalLayerId : 0;
+
+  if (stream_index != current_stream_) {
+    const bool can_switch =
+        has_frame_marks ? independent : current_stream_ == kNoStream;
+    if (stream_index != target_stream_ || !can_switch) {
+      ++packets_dropped_;
+      return false;
+    }
+    SwitchToStream(stream_index, header.sequenceNumber, header.timestamp,
+                   arrival_time_ms);
+    current_temporal_layer_ = target_temporal_layer_;
+  } else if (start_of_frame) {
+    if (target_temporal_layer_ < current_temporal_layer_ || independent) {
+      current_temporal_layer_ = target_temporal_layer_;
+    } else if (frame_marks.baseLayerSync &&
+               temporal_layer <= target_temporal_layer_) {
+      // This frame only depends on the base layer, so its layer can be
+      // forwarded from here on.
+      current_temporal_layer_ =
+          std::max(current_temporal_layer_, temporal_layer);
+    }
+  }
+
+  if (temporal_layer > current_temporal_layer_) {
+    // Pull the following packets back so the receiver sees no gap.
+    --sequence_number_offset_;
+    ++packets_dropped_;
+    return false;
+  }
+
+  uint16_t sequence_number = header.sequenceNumber + sequence_number_offset_;
+  uint32_t timestamp = header.timestamp + timestamp_offset_;
+  ByteWriter<uint16_t>::WriteBigEndian(data + 2, sequence_number);
+  ByteWriter<uint32_t>::WriteBigEndian(data + 4, timestamp);
+  ByteWriter<uint32_t>::WriteBigEndian(data + 8, output_ssrc_);
+
+  if (!has_forwarded_ ||
+      IsNewerSequenceNumber(sequence_number, last_sequence_number_)) {
+    has_forwarded_ = true;
+    last_sequence_number_ = sequence_number;
+    last_timestamp_ = timestamp;
+    last_arrival_time_ms_ = arrival_time_ms;
+  }
+  ++packets_forwarded_;
+  return true;
+}
+
+size_t PercForwarder::StreamIndex(uint32_t ssrc) const {
+  for (size_t i = 0; i < simulcast_ssrcs_.size(); ++i) {
+    if (simulcast_ssrcs_[i] == ssrc)
+      return i;
+  }
+  return kNoStream;
+}
+
+void PercForwarder::SwitchToStream(size_t stream_index,
+                                   uint16_t sequence_number,
+                                   uint32_t timestamp,
+                                   int64_t arrival_time_ms) {
+  current_stream_ = stream_index;
+  if (!has_forwarded_) {
+    sequence_number_offset_ = 0;
+    timestamp_offset_ = 0;
+    return;
+  }
+  // Simulcast streams have unrelated sequence numbers and timestamps, so
+  // continue right after the last forwarded packet, advancing the timestamp
+  // by the time elapsed since.
+  uint32_t elapsed_ticks = static_cast<uint32_t>(std::max<int64_t>(
+      (arrival_time_ms - last_arrival_time_ms_) * kTimestampTicksPerMs, 1));
+  sequence_number_offset_ = last_sequence_number_ + 1 - sequence_number;
+  timestamp_offset_ = last_timestamp_ + elapsed_ticks - timestamp;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,85 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "webrtc/base/arraysize.h"
+#include "webrtc/modules/rtp_rtcp/include/perc_forwarder.h"
+#include "webrtc/modules/rtp_rtcp/source/byte_io.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+constexpr int kNumIterations = 1000000;
+constexpr size_t kPayloadSize = 1100;
+constexpr uint32_t kSsrc = 0x12345678;
+// Temporal layer of each frame in an L1T3 pattern.
+constexpr uint8_t kTemporalPattern[] = {0, 2, 1, 2};
+}  // namespace
+
+// Forwarding rate of a three layer stream to a receiver taking two of them,
+// as seen by one core of the distributor.
+TEST(PercForwarderPerformanceTest, ForwardPackets) {
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<AbsoluteSendTime>(3);
+  extensions.Register<TransportSequenceNumber>(5);
+  extensions.Register<FrameMarking>(7);
+
+  std::vector<std::vector<uint8_t>> packets;
+  for (size_t i = 0; i < arraysize(kTemporalPattern); ++i) {
+    RtpPacketToSend packet(&extensions);
+    packet.SetPayloadType(96);
+    packet.SetSsrc(kSsrc);
+    FrameMarks frame_marks = {};
+    frame_marks.startOfFrame = true;
+    frame_marks.endOfFrame = true;
+    frame_marks.independent = i == 0;
+    frame_marks.baseLayerSync = kTemporalPattern[i] != 0;
+    frame_marks.temporalLayerId = kTemporalPattern[i];
+    frame_marks.tl0PicIdx = 1;
+    EXPECT_TRUE(packet.SetExtension<AbsoluteSendTime>(0x123456));
+    EXPECT_TRUE(packet.SetExtension<TransportSequenceNumber>(0x4321));
+    EXPECT_TRUE(packet.SetExtension<FrameMarking>(frame_marks));
+    memset(packet.AllocatePayload(kPayloadSize), 0, kPayloadSize);
+    packets.emplace_back(packet.data(), packet.data() + packet.size());
+  }
+
+  PercForwarder forwarder(extensions, {kSsrc}, kSsrc + 1);
+  forwarder.SetTargetLayers(0, 1);
+  Clock* clock = Clock::GetRealTimeClock();
+  int64_t start_time_us = clock->TimeInMicroseconds();
+  for (int i = 0; i < kNumIterations; ++i) {
+    std::vector<uint8_t>& packet = packets[i % packets.size()];
+    // Undo the rewrite of the previous round, as if a new packet arrived.
+    ByteWriter<uint16_t>::WriteBigEndian(&packet[2], static_cast<uint16_t>(i));
+    ByteWriter<uint32_t>::WriteBigEndian(&packet[8], kSsrc);
+    forwarder.ForwardPacket(packet.data(), packet.size(), i / 30);
+  }
+  int64_t elapsed_us = clock->TimeInMicroseconds() - start_time_us;
+
+  EXPECT_EQ(static_cast<size_t>(kNumIterations),
+            forwarder.packets_forwarded() + forwarder.packets_dropped());
+  EXPECT_EQ(static_cast<size_t>(kNumIterations / 2),
+            forwarder.packets_dropped());
+  test::PrintResult(
+      "perc_forwarder", "", "packets_per_second",
+      static_cast<size_t>(1e6 * kNumIterations /
+                          std::max<int64_t>(elapsed_us, 1)),
+      "packets/s", false);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,172 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "webrtc/modules/rtp_rtcp/include/perc_forwarder.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace {
+constexpr uint8_t kFrameMarkingId = 7;
+constexpr uint32_t kLowSsrc = 1111;
+constexpr uint32_t kHighSsrc = 2222;
+constexpr uint32_t kOutputSsrc = 3333;
+constexpr size_t kPayloadSize = 100;
+
+class PercForwarderTest : public ::testing::Test {
+ protected:
+  PercForwarderTest() : forwarder_(CreateExtensions(), {kLowSsrc, kHighSsrc},
+                                   kOutputSsrc) {}
+
+  static RtpHeaderExtensionMap CreateExtensions() {
+    RtpHeaderExtensionMap extensions;
+    extensions.Register<FrameMarking>(kFrameMarkingId);
+    return extensions;
+  }
+
+  // Builds a single packet frame and returns whether it was forwarded.
+  bool Forward(uint32_t ssrc,
+               uint16_t sequence_number,
+               uint32_t timestamp,
+               uint8_t temporal_layer,
+               bool independent,
+               bool base_layer_sync,
+               int64_t arrival_time_ms) {
+    RtpHeaderExtensionMap extensions = CreateExtensions();
+    RtpPacketToSend packet(&extensions);
+    packet.SetPayloadType(96);
+    packet.SetSequenceNumber(sequence_number);
+    packet.SetTimestamp(timestamp);
+    packet.SetSsrc(ssrc);
+    FrameMarks frame_marks = {};
+    frame_marks.startOfFrame = true;
+    frame_marks.endOfFrame = true;
+    frame_marks.independent = independent;
+    frame_marks.baseLayerSync = base_layer_sync;
+    frame_marks.temporalLayerId = temporal_layer;
+    frame_marks.tl0PicIdx = 1;
+    EXPECT_TRUE(packet.SetExtension<FrameMarking>(frame_marks));
+    packet.AllocatePayload(kPayloadSize);
+
+    std::vector<uint8_t> data(packet.data(), packet.data() + packet.size());
+    if (!forwarder_.ForwardPacket(data.data(), data.size(), arrival_time_ms))
+      return false;
+    EXPECT_TRUE(last_forwarded_.Parse(data.data(), data.size()));
+    EXPECT_EQ(kPayloadSize, last_forwarded_.payload_size());
+    return true;
+  }
+
+  bool ForwardWithoutFrameMarking(uint32_t ssrc,
+                                  uint16_t sequence_number,
+                                  uint32_t timestamp,
+                                  int64_t arrival_time_ms) {
+    RtpPacketToSend packet(nullptr);
+    packet.SetPayloadType(96);
+    packet.SetSequenceNumber(sequence_number);
+    packet.SetTimestamp(timestamp);
+    packet.SetSsrc(ssrc);
+    packet.AllocatePayload(kPayloadSize);
+
+    std::vector<uint8_t> data(packet.data(), packet.data() + packet.size());
+    if (!forwarder_.ForwardPacket(data.data(), data.size(), arrival_time_ms))
+      return false;
+    EXPECT_TRUE(last_forwarded_.Parse(data.data(), data.size()));
+    return true;
+  }
+
+  PercForwarder forwarder_;
+  RtpPacketReceived last_forwarded_;
+};
+}  // namespace
+
+TEST_F(PercForwarderTest, WaitsForIndependentFrameOnTargetStream) {
+  EXPECT_TRUE(forwarder_.NeedsKeyFrame());
+  EXPECT_FALSE(Forward(kLowSsrc, 10, 1000, 0, false, false, 0));
+  EXPECT_FALSE(Forward(kHighSsrc, 20, 5000, 0, true, false, 0));
+  EXPECT_TRUE(Forward(kLowSsrc, 11, 4000, 0, true, false, 0));
+  EXPECT_FALSE(forwarder_.NeedsKeyFrame());
+
+  EXPECT_EQ(kOutputSsrc, last_forwarded_.Ssrc());
+  EXPECT_EQ(11, last_forwarded_.SequenceNumber());
+  EXPECT_EQ(4000u, last_forwarded_.Timestamp());
+  EXPECT_EQ(1u, forwarder_.packets_forwarded());
+  EXPECT_EQ(2u, forwarder_.packets_dropped());
+}
+
+TEST_F(PercForwarderTest, DropsHigherTemporalLayersWithoutSequenceGaps) {
+  forwarder_.SetTargetLayers(0, 0);
+  ASSERT_TRUE(Forward(kLowSsrc, 100, 0, 0, true, false, 0));
+  EXPECT_FALSE(Forward(kLowSsrc, 101, 3000, 1, false, false, 33));
+  EXPECT_TRUE(Forward(kLowSsrc, 102, 6000, 0, false, false, 66));
+  EXPECT_EQ(101, last_forwarded_.SequenceNumber());
+  EXPECT_EQ(6000u, last_forwarded_.Timestamp());
+}
+
+TEST_F(PercForwarderTest, MovesUpTemporalLayersAtBaseLayerSync) {
+  forwarder_.SetTargetLayers(0, 0);
+  ASSERT_TRUE(Forward(kLowSsrc, 100, 0, 0, true, false, 0));
+  forwarder_.SetTargetLayers(0, 1);
+  // Not a switching point, depends on a layer 1 frame that was dropped.
+  EXPECT_FALSE(Forward(kLowSsrc, 101, 3000, 1, false, false, 33));
+  EXPECT_TRUE(Forward(kLowSsrc, 102, 6000, 0, false, false, 66));
+  EXPECT_TRUE(Forward(kLowSsrc, 103, 9000, 1, false, true, 100));
+  EXPECT_EQ(102, last_forwarded_.SequenceNumber());
+
+  // Moving down applies at the next frame.
+  forwarder_.SetTargetLayers(0, 0);
+  EXPECT_FALSE(Forward(kLowSsrc, 104, 12000, 1, false, false, 133));
+}
+
+TEST_F(PercForwarderTest, SwitchesStreamAtIndependentFrame) {
+  ASSERT_TRUE(Forward(kLowSsrc, 100, 10000, 0, true, false, 0));
+  forwarder_.SetTargetLayers(1, 0);
+  EXPECT_TRUE(forwarder_.NeedsKeyFrame());
+  // Keeps forwarding the current stream until the target one can be decoded.
+  EXPECT_FALSE(Forward(kHighSsrc, 5000, 700000, 0, false, false, 10));
+  EXPECT_TRUE(Forward(kLowSsrc, 101, 10900, 0, false, false, 10));
+
+  EXPECT_TRUE(Forward(kHighSsrc, 5001, 701800, 0, true, false, 30));
+  EXPECT_FALSE(forwarder_.NeedsKeyFrame());
+  EXPECT_EQ(kOutputSsrc, last_forwarded_.Ssrc());
+  EXPECT_EQ(102, last_forwarded_.SequenceNumber());
+  // 20 ms after the last forwarded packet.
+  EXPECT_EQ(10900u + 20 * 90, last_forwarded_.Timestamp());
+
+  EXPECT_FALSE(Forward(kLowSsrc, 102, 12700, 0, false, false, 40));
+  EXPECT_TRUE(Forward(kHighSsrc, 5002, 702700, 0, false, false, 40));
+  EXPECT_EQ(103, last_forwarded_.SequenceNumber());
+  EXPECT_EQ(10900u + 20 * 90 + 900, last_forwarded_.Timestamp());
+}
+
+TEST_F(PercForwarderTest, ForwardsStreamWithoutFrameMarking) {
+  EXPECT_FALSE(ForwardWithoutFrameMarking(kHighSsrc, 20, 5000, 0));
+  EXPECT_TRUE(ForwardWithoutFrameMarking(kLowSsrc, 10, 1000, 0));
+  EXPECT_FALSE(forwarder_.NeedsKeyFrame());
+  EXPECT_TRUE(ForwardWithoutFrameMarking(kLowSsrc, 11, 1000, 0));
+  EXPECT_EQ(kOutputSsrc, last_forwarded_.Ssrc());
+  EXPECT_EQ(11, last_forwarded_.SequenceNumber());
+
+  // Frame boundaries are unknown, so the stream can't be switched.
+  forwarder_.SetTargetLayers(1, 0);
+  EXPECT_FALSE(ForwardWithoutFrameMarking(kHighSsrc, 21, 8000, 33));
+  EXPECT_TRUE(ForwardWithoutFrameMarking(kLowSsrc, 12, 4000, 33));
+  EXPECT_EQ(12, last_forwarded_.SequenceNumber());
+}
+
+TEST_F(PercForwarderTest, DropsUnknownStreams) {
+  EXPECT_FALSE(Forward(4444, 1, 0, 0, true, false, 0));
+  EXPECT_EQ(1u, forwarder_.packets_dropped());
+}
+
+}  // namespace webrtc
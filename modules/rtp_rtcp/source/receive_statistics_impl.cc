@@ -14,6 +14,7 @@
 
 #include <cstdlib>
 
+#include "webrtc/base/checks.h"
 #include "webrtc/modules/remote_bitrate_estimator/test/bwe_test_logging.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_rtcp_config.h"
 #include "webrtc/modules/rtp_rtcp/source/time_util.h"
@@ -22,17 +23,22 @@ namespace webrtc {
 
 const int64_t kStatisticsTimeoutMs = 8000;
 const int64_t kStatisticsProcessIntervalMs = 1000;
+// The received bitrate is only reported in stats, so 10 ms resolution is
+// plenty and saves walking a bucket per millisecond on every packet.
+const int64_t kIncomingBitrateBucketSizeMs = 10;
 
 StreamStatistician::~StreamStatistician() {}
 
 StreamStatisticianImpl::StreamStatisticianImpl(
+    uint32_t ssrc,
     Clock* clock,
     RtcpStatisticsCallback* rtcp_callback,
     StreamDataCountersCallback* rtp_callback)
-    : clock_(clock),
+    : ssrc_(ssrc),
+      clock_(clock),
       incoming_bitrate_(kStatisticsProcessIntervalMs,
-                        RateStatistics::kBpsScale),
-      ssrc_(0),
+                        RateStatistics::kBpsScale,
+                        kIncomingBitrateBucketSizeMs),
       max_reordering_threshold_(kDefaultMaxReorderingThreshold),
       jitter_q4_(0),
       cumulative_loss_(0),
@@ -61,8 +67,8 @@ void StreamStatisticianImpl::UpdateCounters(const RTPHeader& header,
                                             size_t packet_length,
                                             bool retransmitted) {
   rtc::CritScope cs(&stream_lock_);
+  RTC_DCHECK_EQ(ssrc_, header.ssrc);
   bool in_order = InOrderPacketInternal(header.sequenceNumber);
-  ssrc_ = header.ssrc;
   incoming_bitrate_.Update(packet_length, clock_->TimeInMilliseconds());
   receive_counters_.transmitted.AddPacket(packet_length, header);
   if (!in_order && retransmitted) {
@@ -106,6 +112,18 @@ void StreamStatisticianImpl::UpdateCounters(const RTPHeader& header,
   // Our measured overhead. Filter from RFC 5104 4.2.1.2:
   // avg_OH (new) = 15/16*avg_OH (old) + 1/16*pckt_OH,
   received_packet_overhead_ = (15 * received_packet_overhead_ + packet_oh) >> 4;
+  PublishSnapshot();
+}
+
+void StreamStatisticianImpl::PublishSnapshot() {
+  rtc::CritScope cs(&snapshot_lock_);
+  snapshot_.counters = receive_counters_;
+  snapshot_.last_receive_time_ntp = last_receive_time_ntp_;
+}
+
+StreamStatisticianImpl::Snapshot StreamStatisticianImpl::ReadSnapshot() const {
+  rtc::CritScope cs(&snapshot_lock_);
+  return snapshot_;
 }
 
 void StreamStatisticianImpl::UpdateJitter(const RTPHeader& header,
@@ -148,25 +166,16 @@ void StreamStatisticianImpl::UpdateJitter(const RTPHeader& header,
 }
 
 void StreamStatisticianImpl::NotifyRtpCallback() {
-  StreamDataCounters data;
-  uint32_t ssrc;
-  {
-    rtc::CritScope cs(&stream_lock_);
-    data = receive_counters_;
-    ssrc = ssrc_;
-  }
-  rtp_callback_->DataCountersUpdated(data, ssrc);
+  rtp_callback_->DataCountersUpdated(ReadSnapshot().counters, ssrc_);
 }
 
 void StreamStatisticianImpl::NotifyRtcpCallback() {
   RtcpStatistics data;
-  uint32_t ssrc;
   {
     rtc::CritScope cs(&stream_lock_);
     data = last_reported_statistics_;
-    ssrc = ssrc_;
   }
-  rtcp_callback_->StatisticsUpdated(data, ssrc);
+  rtcp_callback_->StatisticsUpdated(data, ssrc_);
 }
 
 void StreamStatisticianImpl::FecPacketReceived(const RTPHeader& header,
@@ -174,6 +183,7 @@ void StreamStatisticianImpl::FecPacketReceived(const RTPHeader& header,
   {
     rtc::CritScope cs(&stream_lock_);
     receive_counters_.fec.AddPacket(packet_length, header);
+    PublishSnapshot();
   }
   NotifyRtpCallback();
 }
@@ -289,21 +299,20 @@ RtcpStatistics StreamStatisticianImpl::CalculateRtcpStatistics() {
 
 void StreamStatisticianImpl::GetDataCounters(
     size_t* bytes_received, uint32_t* packets_received) const {
-  rtc::CritScope cs(&stream_lock_);
+  const StreamDataCounters counters = ReadSnapshot().counters;
   if (bytes_received) {
-    *bytes_received = receive_counters_.transmitted.payload_bytes +
-                      receive_counters_.transmitted.header_bytes +
-                      receive_counters_.transmitted.padding_bytes;
+    *bytes_received = counters.transmitted.payload_bytes +
+                      counters.transmitted.header_bytes +
+                      counters.transmitted.padding_bytes;
   }
   if (packets_received) {
-    *packets_received = receive_counters_.transmitted.packets;
+    *packets_received = counters.transmitted.packets;
   }
 }
 
 void StreamStatisticianImpl::GetReceiveStreamDataCounters(
     StreamDataCounters* data_counters) const {
-  rtc::CritScope cs(&stream_lock_);
-  *data_counters = receive_counters_;
+  *data_counters = ReadSnapshot().counters;
 }
 
 uint32_t StreamStatisticianImpl::BitrateReceived() const {
@@ -313,9 +322,9 @@ uint32_t StreamStatisticianImpl::BitrateReceived() const {
 
 void StreamStatisticianImpl::LastReceiveTimeNtp(uint32_t* secs,
                                                 uint32_t* frac) const {
-  rtc::CritScope cs(&stream_lock_);
-  *secs = last_receive_time_ntp_.seconds();
-  *frac = last_receive_time_ntp_.fractions();
+  const NtpTime last_receive_time_ntp = ReadSnapshot().last_receive_time_ntp;
+  *secs = last_receive_time_ntp.seconds();
+  *frac = last_receive_time_ntp.fractions();
 }
 
 bool StreamStatisticianImpl::IsRetransmitOfOldPacket(
@@ -380,7 +389,10 @@ ReceiveStatistics* ReceiveStatistics::Create(Clock* clock) {
 ReceiveStatisticsImpl::ReceiveStatisticsImpl(Clock* clock)
     : clock_(clock),
       rtcp_stats_callback_(NULL),
-      rtp_stats_callback_(NULL) {}
+      rtp_stats_callback_(NULL) {
+  for (size_t i = 0; i < kMaxFastLookupStatisticians; ++i)
+    fast_lookup_[i] = nullptr;
+}
 
 ReceiveStatisticsImpl::~ReceiveStatisticsImpl() {
   while (!statisticians_.empty()) {
@@ -389,18 +401,41 @@ ReceiveStatisticsImpl::~ReceiveStatisticsImpl() {
   }
 }
 
+StreamStatisticianImpl* ReceiveStatisticsImpl::FindStatistician(
+    uint32_t ssrc) const {
+  StreamStatisticianImpl* volatile* fast_lookup =
+      const_cast<StreamStatisticianImpl* volatile*>(fast_lookup_);
+  for (size_t i = 0; i < kMaxFastLookupStatisticians; ++i) {
+    StreamStatisticianImpl* impl =
+        rtc::AtomicOps::AcquireLoadPtr(&fast_lookup[i]);
+    if (!impl)
+      break;
+    if (impl->ssrc() == ssrc)
+      return impl;
+  }
+  return nullptr;
+}
+
 void ReceiveStatisticsImpl::IncomingPacket(const RTPHeader& header,
                                            size_t packet_length,
                                            bool retransmitted) {
-  StreamStatisticianImpl* impl;
-  {
+  StreamStatisticianImpl* impl = FindStatistician(header.ssrc);
+  if (!impl) {
     rtc::CritScope cs(&receive_statistics_lock_);
     StatisticianImplMap::iterator it = statisticians_.find(header.ssrc);
     if (it != statisticians_.end()) {
       impl = it->second;
     } else {
-      impl = new StreamStatisticianImpl(clock_, this, this);
+      impl = new StreamStatisticianImpl(header.ssrc, clock_, this, this);
       statisticians_[header.ssrc] = impl;
+      for (size_t i = 0; i < kMaxFastLookupStatisticians; ++i) {
+        if (!fast_lookup_[i]) {
+          rtc::AtomicOps::CompareAndSwapPtr(
+              &fast_lookup_[i], static_cast<StreamStatisticianImpl*>(nullptr),
+              impl);
+          break;
+        }
+      }
     }
   }
   // StreamStatisticianImpl instance is created once and only destroyed when
@@ -412,12 +447,16 @@ void ReceiveStatisticsImpl::IncomingPacket(const RTPHeader& header,
 
 void ReceiveStatisticsImpl::FecPacketReceived(const RTPHeader& header,
                                               size_t packet_length) {
-  rtc::CritScope cs(&receive_statistics_lock_);
-  StatisticianImplMap::iterator it = statisticians_.find(header.ssrc);
-  // Ignore FEC if it is the first packet.
-  if (it != statisticians_.end()) {
-    it->second->FecPacketReceived(header, packet_length);
+  StreamStatisticianImpl* impl = FindStatistician(header.ssrc);
+  if (!impl) {
+    rtc::CritScope cs(&receive_statistics_lock_);
+    StatisticianImplMap::iterator it = statisticians_.find(header.ssrc);
+    // Ignore FEC if it is the first packet.
+    if (it == statisticians_.end())
+      return;
+    impl = it->second;
   }
+  impl->FecPacketReceived(header, packet_length);
 }
 
 StatisticianMap ReceiveStatisticsImpl::GetActiveStatisticians() const {
@@ -438,6 +477,9 @@ StatisticianMap ReceiveStatisticsImpl::GetActiveStatisticians() const {
 
 StreamStatistician* ReceiveStatisticsImpl::GetStatistician(
     uint32_t ssrc) const {
+  StreamStatisticianImpl* impl = FindStatistician(ssrc);
+  if (impl)
+    return impl;
   rtc::CritScope cs(&receive_statistics_lock_);
   StatisticianImplMap::const_iterator it = statisticians_.find(ssrc);
   if (it == statisticians_.end())
@@ -456,7 +498,7 @@ void ReceiveStatisticsImpl::SetMaxReorderingThreshold(
 
 void ReceiveStatisticsImpl::RegisterRtcpStatisticsCallback(
     RtcpStatisticsCallback* callback) {
-  rtc::CritScope cs(&receive_statistics_lock_);
+  rtc::CritScope cs(&callback_lock_);
   if (callback != NULL)
     assert(rtcp_stats_callback_ == NULL);
   rtcp_stats_callback_ = callback;
@@ -464,20 +506,20 @@ void ReceiveStatisticsImpl::RegisterRtcpStatisticsCallback(
 
 void ReceiveStatisticsImpl::StatisticsUpdated(const RtcpStatistics& statistics,
                                               uint32_t ssrc) {
-  rtc::CritScope cs(&receive_statistics_lock_);
+  rtc::CritScope cs(&callback_lock_);
   if (rtcp_stats_callback_)
     rtcp_stats_callback_->StatisticsUpdated(statistics, ssrc);
 }
 
 void ReceiveStatisticsImpl::CNameChanged(const char* cname, uint32_t ssrc) {
-  rtc::CritScope cs(&receive_statistics_lock_);
+  rtc::CritScope cs(&callback_lock_);
   if (rtcp_stats_callback_)
     rtcp_stats_callback_->CNameChanged(cname, ssrc);
 }
 
 void ReceiveStatisticsImpl::RegisterRtpStatisticsCallback(
     StreamDataCountersCallback* callback) {
-  rtc::CritScope cs(&receive_statistics_lock_);
+  rtc::CritScope cs(&callback_lock_);
   if (callback != NULL)
     assert(rtp_stats_callback_ == NULL);
   rtp_stats_callback_ = callback;
@@ -485,7 +527,7 @@ void ReceiveStatisticsImpl::RegisterRtpStatisticsCallback(
 
 void ReceiveStatisticsImpl::DataCountersUpdated(const StreamDataCounters& stats,
                                                 uint32_t ssrc) {
-  rtc::CritScope cs(&receive_statistics_lock_);
+  rtc::CritScope cs(&callback_lock_);
   if (rtp_stats_callback_) {
     rtp_stats_callback_->DataCountersUpdated(stats, ssrc);
   }
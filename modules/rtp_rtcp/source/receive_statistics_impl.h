@@ -16,15 +16,18 @@
 #include <algorithm>
 #include <map>
 
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/rate_statistics.h"
+#include "webrtc/base/thread_annotations.h"
 #include "webrtc/system_wrappers/include/ntp_time.h"
 
 namespace webrtc {
 
 class StreamStatisticianImpl : public StreamStatistician {
  public:
-  StreamStatisticianImpl(Clock* clock,
+  StreamStatisticianImpl(uint32_t ssrc,
+                         Clock* clock,
                          RtcpStatisticsCallback* rtcp_callback,
                          StreamDataCountersCallback* rtp_callback);
   virtual ~StreamStatisticianImpl() {}
@@ -46,7 +49,18 @@ class StreamStatisticianImpl : public StreamStatistician {
   void SetMaxReorderingThreshold(int max_reordering_threshold);
   virtual void LastReceiveTimeNtp(uint32_t* secs, uint32_t* frac) const;
 
+  uint32_t ssrc() const { return ssrc_; }
+
  private:
+  // Values read by the stats getters, copied out of the packet path state
+  // after each update. Readers copy it under |snapshot_lock_|, which is only
+  // held for the copy, so polling stats does not take |stream_lock_| and
+  // holds up the packet path for no longer than a copy.
+  struct Snapshot {
+    StreamDataCounters counters;
+    NtpTime last_receive_time_ntp;
+  };
+
   bool InOrderPacketInternal(uint16_t sequence_number) const;
   RtcpStatistics CalculateRtcpStatistics();
   void UpdateJitter(const RTPHeader& header, NtpTime receive_time);
@@ -55,11 +69,14 @@ class StreamStatisticianImpl : public StreamStatistician {
                       bool retransmitted);
   void NotifyRtpCallback() LOCKS_EXCLUDED(stream_lock_);
   void NotifyRtcpCallback() LOCKS_EXCLUDED(stream_lock_);
+  void PublishSnapshot() EXCLUSIVE_LOCKS_REQUIRED(stream_lock_)
+      LOCKS_EXCLUDED(snapshot_lock_);
+  Snapshot ReadSnapshot() const LOCKS_EXCLUDED(snapshot_lock_);
 
+  const uint32_t ssrc_;
   Clock* const clock_;
   rtc::CriticalSection stream_lock_;
   RateStatistics incoming_bitrate_;
-  uint32_t ssrc_;
   int max_reordering_threshold_;  // In number of packets or sequence numbers.
 
   // Stats on received RTP packets.
@@ -85,6 +102,10 @@ class StreamStatisticianImpl : public StreamStatistician {
   uint16_t last_report_seq_max_;
   RtcpStatistics last_reported_statistics_;
 
+  // Taken inside |stream_lock_| by the packet path.
+  rtc::CriticalSection snapshot_lock_;
+  Snapshot snapshot_ GUARDED_BY(snapshot_lock_);
+
   RtcpStatisticsCallback* const rtcp_callback_;
   StreamDataCountersCallback* const rtp_callback_;
 };
@@ -122,12 +143,26 @@ class ReceiveStatisticsImpl : public ReceiveStatistics,
 
   typedef std::map<uint32_t, StreamStatisticianImpl*> StatisticianImplMap;
 
+  // Receivers rarely see more than a handful of SSRCs (media, RTX, FEC).
+  static const size_t kMaxFastLookupStatisticians = 8;
+
+  // Looks |ssrc| up in |fast_lookup_| without taking any lock.
+  StreamStatisticianImpl* FindStatistician(uint32_t ssrc) const;
+
   Clock* const clock_;
   rtc::CriticalSection receive_statistics_lock_;
-  StatisticianImplMap statisticians_;
-
-  RtcpStatisticsCallback* rtcp_stats_callback_;
-  StreamDataCountersCallback* rtp_stats_callback_;
+  StatisticianImplMap statisticians_ GUARDED_BY(receive_statistics_lock_);
+  // Statisticians are never removed before the destructor, so the first ones
+  // created are also published here for the packet path to find them without
+  // contending with stats polling on |receive_statistics_lock_|. Filled in
+  // order, with |receive_statistics_lock_| held.
+  StreamStatisticianImpl* volatile fast_lookup_[kMaxFastLookupStatisticians];
+
+  // Separate from |receive_statistics_lock_|, as the callbacks run for every
+  // packet.
+  rtc::CriticalSection callback_lock_;
+  RtcpStatisticsCallback* rtcp_stats_callback_ GUARDED_BY(callback_lock_);
+  StreamDataCountersCallback* rtp_stats_callback_ GUARDED_BY(callback_lock_);
 };
 }  // namespace webrtc
 #endif  // WEBRTC_MODULES_RTP_RTCP_SOURCE_RECEIVE_STATISTICS_IMPL_H_
@@ -10,6 +10,7 @@
 
 #include <memory>
 
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/modules/rtp_rtcp/include/receive_statistics.h"
 #include "webrtc/system_wrappers/include/clock.h"
 #include "webrtc/test/gmock.h"
@@ -150,6 +151,65 @@ TEST_F(ReceiveStatisticsTest, GetReceiveStreamDataCounters) {
   EXPECT_EQ(2u, counters.transmitted.packets);
 }
 
+TEST_F(ReceiveStatisticsTest, ManyIncomingSsrcs) {
+  // More streams than the statisticians looked up without locking.
+  const uint32_t kNumSsrcs = 20;
+  for (int i = 0; i < 3; ++i) {
+    for (uint32_t ssrc = 1; ssrc <= kNumSsrcs; ++ssrc) {
+      header1_.ssrc = ssrc;
+      receive_statistics_->IncomingPacket(header1_, kPacketSize1, false);
+    }
+    ++header1_.sequenceNumber;
+  }
+  receive_statistics_->FecPacketReceived(header1_, kPacketSize2);
+
+  EXPECT_EQ(kNumSsrcs, receive_statistics_->GetActiveStatisticians().size());
+  for (uint32_t ssrc = 1; ssrc <= kNumSsrcs; ++ssrc) {
+    StreamStatistician* statistician =
+        receive_statistics_->GetStatistician(ssrc);
+    ASSERT_TRUE(statistician != NULL);
+    StreamDataCounters counters;
+    statistician->GetReceiveStreamDataCounters(&counters);
+    EXPECT_EQ(3u, counters.transmitted.packets);
+    EXPECT_EQ(ssrc == kNumSsrcs ? 1u : 0u, counters.fec.packets);
+  }
+  EXPECT_TRUE(receive_statistics_->GetStatistician(kNumSsrcs + 1) == NULL);
+}
+
+// Stats read from another thread must always be a consistent copy of the
+// counters, never one torn by a packet arriving at the same time.
+TEST_F(ReceiveStatisticsTest, CountersReadWhilePacketsArrive) {
+  const uint32_t kNumPackets = 100000;
+  receive_statistics_->IncomingPacket(header1_, kPacketSize1, false);
+  StreamStatistician* statistician =
+      receive_statistics_->GetStatistician(kSsrc1);
+  ASSERT_TRUE(statistician != NULL);
+
+  struct Reader {
+    static bool Run(void* obj) {
+      Reader* reader = static_cast<Reader*>(obj);
+      StreamDataCounters counters;
+      reader->statistician->GetReceiveStreamDataCounters(&counters);
+      if (counters.transmitted.payload_bytes !=
+          counters.transmitted.packets * kPacketSize1) {
+        ++reader->torn_reads;
+      }
+      return counters.transmitted.packets < kNumPackets;
+    }
+    StreamStatistician* statistician;
+    int torn_reads;
+  } reader = {statistician, 0};
+
+  rtc::PlatformThread thread(&Reader::Run, &reader, "StatsReader");
+  thread.Start();
+  for (uint32_t i = 1; i < kNumPackets; ++i) {
+    ++header1_.sequenceNumber;
+    receive_statistics_->IncomingPacket(header1_, kPacketSize1, false);
+  }
+  thread.Stop();
+  EXPECT_EQ(0, reader.torn_reads);
+}
+
 TEST_F(ReceiveStatisticsTest, RtcpCallbacks) {
   class TestCallback : public RtcpStatisticsCallback {
    public:
@@ -434,7 +434,8 @@ bool TransportFeedback::Parse(const CommonHeader& packet) {
     return false;
   }
 
-  std::vector<uint8_t> delta_sizes;
+  std::vector<DeltaSize>& delta_sizes = parsed_delta_sizes_;
+  delta_sizes.clear();
   delta_sizes.reserve(status_count);
   while (delta_sizes.size() < status_count) {
     if (index + kChunkSizeBytes > end_index) {
@@ -99,6 +99,9 @@ class TransportFeedback : public Rtpfb {
   std::vector<uint16_t> encoded_chunks_;
   const std::unique_ptr<LastChunk> last_chunk_;
   size_t size_bytes_;
+  // Scratch space for Parse, kept so parsing into the same object again does
+  // not allocate.
+  std::vector<DeltaSize> parsed_delta_sizes_;
 
   RTC_DISALLOW_COPY_AND_ASSIGN(TransportFeedback);
 };
@@ -67,8 +67,37 @@ struct RTCPReceiver::PacketInformation {
   uint8_t sli_picture_id = 0;
   uint64_t rpsi_picture_id = 0;
   uint32_t receiver_estimated_max_bitrate_bps = 0;
-  std::unique_ptr<rtcp::TransportFeedback> transport_feedback;
+  // Points into the ParseContext, valid until the next packet is parsed.
+  const rtcp::TransportFeedback* transport_feedback = nullptr;
   rtc::Optional<BitrateAllocation> target_bitrate_allocation;
+  // Set when a TMMBR changed whether the remote end wants the stream paused.
+  rtc::Optional<bool> pause_requested;
+
+  // Clears all the fields, keeping the capacity of the containers.
+  void Reset() {
+    packet_type_flags = 0;
+    remote_ssrc = 0;
+    nack_sequence_numbers.clear();
+    report_blocks.clear();
+    rtt_ms = 0;
+    sli_picture_id = 0;
+    rpsi_picture_id = 0;
+    receiver_estimated_max_bitrate_bps = 0;
+    transport_feedback = nullptr;
+    target_bitrate_allocation = rtc::Optional<BitrateAllocation>();
+    pause_requested = rtc::Optional<bool>();
+  }
+};
+
+// Packets are parsed into the same objects every time, so the vectors in them
+// keep their capacity and steady state parsing does not allocate.
+struct RTCPReceiver::ParseContext {
+  PacketInformation packet_information;
+  rtcp::SenderReport sender_report;
+  rtcp::ReceiverReport receiver_report;
+  rtcp::ExtendedReports xr;
+  rtcp::Nack nack;
+  rtcp::TransportFeedback transport_feedback;
 };
 
 struct RTCPReceiver::ReceiveInformation {
@@ -118,10 +147,12 @@ RTCPReceiver::RTCPReceiver(
       remote_ssrc_(0),
       xr_rrtr_status_(false),
       xr_rr_rtt_ms_(0),
+      paused_by_remote_(false),
       last_received_rr_ms_(0),
       last_increased_sequence_number_ms_(0),
       stats_callback_(nullptr),
       packet_type_counter_observer_(packet_type_counter_observer),
+      parse_context_(new ParseContext()),
       num_skipped_packets_(0),
       last_skipped_packets_warning_ms_(clock->TimeInMilliseconds()) {
   RTC_DCHECK(owner);
@@ -136,7 +167,9 @@ bool RTCPReceiver::IncomingPacket(const uint8_t* packet, size_t packet_size) {
     return false;
   }
 
-  PacketInformation packet_information;
+  rtc::CritScope lock(&parse_lock_);
+  PacketInformation& packet_information = parse_context_->packet_information;
+  packet_information.Reset();
   if (!ParseCompoundPacket(packet, packet + packet_size, &packet_information))
     return false;
   TriggerCallbacksFromRtcpPacket(packet_information);
@@ -399,7 +432,7 @@ bool RTCPReceiver::ParseCompoundPacket(const uint8_t* packet_begin,
 
 void RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
                                       PacketInformation* packet_information) {
-  rtcp::SenderReport sender_report;
+  rtcp::SenderReport& sender_report = parse_context_->sender_report;
   if (!sender_report.Parse(rtcp_block)) {
     ++num_skipped_packets_;
     return;
@@ -433,13 +466,13 @@ void RTCPReceiver::HandleSenderReport(const CommonHeader& rtcp_block,
     packet_information->packet_type_flags |= kRtcpRr;
   }
 
-  for (const rtcp::ReportBlock report_block : sender_report.report_blocks())
+  for (const ReportBlock& report_block : sender_report.report_blocks())
     HandleReportBlock(report_block, packet_information, remote_ssrc);
 }
 
 void RTCPReceiver::HandleReceiverReport(const CommonHeader& rtcp_block,
                                         PacketInformation* packet_information) {
-  rtcp::ReceiverReport receiver_report;
+  rtcp::ReceiverReport& receiver_report = parse_context_->receiver_report;
   if (!receiver_report.Parse(rtcp_block)) {
     ++num_skipped_packets_;
     return;
@@ -639,7 +672,7 @@ void RTCPReceiver::HandleSdes(const CommonHeader& rtcp_block,
 
 void RTCPReceiver::HandleNack(const CommonHeader& rtcp_block,
                               PacketInformation* packet_information) {
-  rtcp::Nack nack;
+  rtcp::Nack& nack = parse_context_->nack;
   if (!nack.Parse(rtcp_block)) {
     ++num_skipped_packets_;
     return;
@@ -684,7 +717,7 @@ void RTCPReceiver::HandleBye(const CommonHeader& rtcp_block) {
 
 void RTCPReceiver::HandleXr(const CommonHeader& rtcp_block,
                             PacketInformation* packet_information) {
-  rtcp::ExtendedReports xr;
+  rtcp::ExtendedReports& xr = parse_context_->xr;
   if (!xr.Parse(rtcp_block)) {
     ++num_skipped_packets_;
     return;
@@ -785,7 +818,21 @@ void RTCPReceiver::HandleTmmbr(const CommonHeader& rtcp_block,
   }
 
   for (const rtcp::TmmbItem& request : tmmbr.requests()) {
-    if (main_ssrc_ == request.ssrc() && request.bitrate_bps()) {
+    if (main_ssrc_ != request.ssrc())
+      continue;
+    // A zero bitrate asks to stop sending the stream altogether, the next
+    // non-zero one to resume it.
+    bool pause = request.bitrate_bps() == 0;
+    if (pause != paused_by_remote_) {
+      paused_by_remote_ = pause;
+      packet_information->pause_requested = rtc::Optional<bool>(pause);
+    }
+    if (pause) {
+      // Drop the limit from before the pause, so that it no longer bounds
+      // the bitrate and the limit requested on resume is taken as new.
+      if (receive_info->tmmbr.erase(sender_ssrc) > 0)
+        packet_information->packet_type_flags |= kRtcpTmmbr;
+    } else {
       auto* entry = &receive_info->tmmbr[sender_ssrc];
       entry->tmmbr_item = rtcp::TmmbItem(sender_ssrc,
                                          request.bitrate_bps(),
@@ -905,15 +952,18 @@ void RTCPReceiver::HandleFir(const CommonHeader& rtcp_block,
 void RTCPReceiver::HandleTransportFeedback(
     const CommonHeader& rtcp_block,
     PacketInformation* packet_information) {
-  std::unique_ptr<rtcp::TransportFeedback> transport_feedback(
-      new rtcp::TransportFeedback());
+  rtcp::TransportFeedback* transport_feedback =
+      &parse_context_->transport_feedback;
   if (!transport_feedback->Parse(rtcp_block)) {
     ++num_skipped_packets_;
+    // A feedback parsed earlier in this compound packet has been overwritten.
+    packet_information->packet_type_flags &= ~kRtcpTransportFeedback;
+    packet_information->transport_feedback = nullptr;
     return;
   }
 
   packet_information->packet_type_flags |= kRtcpTransportFeedback;
-  packet_information->transport_feedback = std::move(transport_feedback);
+  packet_information->transport_feedback = transport_feedback;
 }
 
 void RTCPReceiver::UpdateTmmbr() {
@@ -996,6 +1046,10 @@ void RTCPReceiver::TriggerCallbacksFromRtcpPacket(
       rtcp_intra_frame_observer_->OnReceivedRPSI(
           local_ssrc, packet_information.rpsi_picture_id);
     }
+    if (packet_information.pause_requested) {
+      rtcp_intra_frame_observer_->OnReceivedPauseRequest(
+          local_ssrc, *packet_information.pause_requested);
+    }
   }
   if (rtcp_bandwidth_observer_) {
     RTC_DCHECK(!receiver_only_);
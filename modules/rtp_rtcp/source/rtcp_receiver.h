@@ -12,6 +12,7 @@
 #define WEBRTC_MODULES_RTP_RTCP_SOURCE_RTCP_RECEIVER_H_
 
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -117,6 +118,7 @@ class RTCPReceiver {
 
  private:
   struct PacketInformation;
+  struct ParseContext;
   struct ReceiveInformation;
   struct ReportBlockWithRtt;
   // Mapped by remote ssrc.
@@ -241,6 +243,9 @@ class RTCPReceiver {
   bool xr_rrtr_status_ GUARDED_BY(rtcp_receiver_lock_);
   int64_t xr_rr_rtt_ms_;
 
+  // Whether the last TMMBR for |main_ssrc_| had a zero bitrate.
+  bool paused_by_remote_ GUARDED_BY(rtcp_receiver_lock_);
+
   // Received report blocks.
   ReportBlockMap received_report_blocks_ GUARDED_BY(rtcp_receiver_lock_);
   ReceivedInfoMap received_infos_ GUARDED_BY(rtcp_receiver_lock_);
@@ -259,6 +264,11 @@ class RTCPReceiver {
   RtcpPacketTypeCounterObserver* const packet_type_counter_observer_;
   RtcpPacketTypeCounter packet_type_counter_;
 
+  // Held while a packet is parsed and its callbacks run, as they use the
+  // objects in |parse_context_|.
+  rtc::CriticalSection parse_lock_;
+  const std::unique_ptr<ParseContext> parse_context_;
+
   RTCPUtility::NackStats nack_stats_;
 
   size_t num_skipped_packets_;
@@ -45,9 +45,11 @@ namespace {
 
 using ::testing::_;
 using ::testing::AllOf;
+using ::testing::AnyNumber;
 using ::testing::ElementsAreArray;
 using ::testing::Field;
 using ::testing::IsEmpty;
+using ::testing::Mock;
 using ::testing::NiceMock;
 using ::testing::Property;
 using ::testing::SizeIs;
@@ -67,6 +69,7 @@ class MockRtcpIntraFrameObserver : public RtcpIntraFrameObserver {
   MOCK_METHOD1(OnReceivedIntraFrameRequest, void(uint32_t));
   MOCK_METHOD2(OnReceivedSLI, void(uint32_t, uint8_t));
   MOCK_METHOD2(OnReceivedRPSI, void(uint32_t, uint64_t));
+  MOCK_METHOD2(OnReceivedPauseRequest, void(uint32_t, bool));
 };
 
 class MockRtcpCallbackImpl : public RtcpStatisticsCallback {
@@ -1056,11 +1059,80 @@ TEST_F(RtcpReceiverTest, TmmbrPacketZeroRateIgnored) {
   EXPECT_CALL(rtp_rtcp_impl_, OnReceivedRtcpReportBlocks(_));
   EXPECT_CALL(bandwidth_observer_, OnReceivedRtcpReceiverReport(_, _, _));
   EXPECT_CALL(bandwidth_observer_, OnReceivedEstimatedBitrate(_)).Times(0);
+  EXPECT_CALL(intra_frame_observer_,
+              OnReceivedPauseRequest(kReceiverMainSsrc, true));
   InjectRtcpPacket(compound);
 
   EXPECT_EQ(0u, rtcp_receiver_.TmmbrReceived().size());
 }
 
+TEST_F(RtcpReceiverTest, TmmbrZeroRatePausesUntilNonZeroRate) {
+  auto inject_tmmbr = [this](uint32_t bitrate_bps) {
+    rtcp::Tmmbr tmmbr;
+    tmmbr.SetSenderSsrc(kSenderSsrc);
+    tmmbr.AddTmmbr(rtcp::TmmbItem(kReceiverMainSsrc, bitrate_bps, 0));
+    rtcp::SenderReport sr;
+    sr.SetSenderSsrc(kSenderSsrc);
+    rtcp::CompoundPacket compound;
+    compound.Append(&sr);
+    compound.Append(&tmmbr);
+    InjectRtcpPacket(compound);
+  };
+  EXPECT_CALL(rtp_rtcp_impl_, OnReceivedRtcpReportBlocks(_)).Times(4);
+  EXPECT_CALL(bandwidth_observer_, OnReceivedRtcpReceiverReport(_, _, _))
+      .Times(4);
+
+  // Only changes of the pause state are reported.
+  EXPECT_CALL(intra_frame_observer_,
+              OnReceivedPauseRequest(kReceiverMainSsrc, true));
+  inject_tmmbr(0);
+  inject_tmmbr(0);
+  Mock::VerifyAndClearExpectations(&intra_frame_observer_);
+
+  EXPECT_CALL(intra_frame_observer_,
+              OnReceivedPauseRequest(kReceiverMainSsrc, false));
+  EXPECT_CALL(rtp_rtcp_impl_, SetTmmbn(SizeIs(1))).Times(2);
+  EXPECT_CALL(bandwidth_observer_, OnReceivedEstimatedBitrate(30000)).Times(2);
+  inject_tmmbr(30000);
+  inject_tmmbr(30000);
+}
+
+TEST_F(RtcpReceiverTest, TmmbrZeroRateClearsPreviousLimit) {
+  auto inject_tmmbr = [this](uint32_t bitrate_bps) {
+    rtcp::Tmmbr tmmbr;
+    tmmbr.SetSenderSsrc(kSenderSsrc);
+    tmmbr.AddTmmbr(rtcp::TmmbItem(kReceiverMainSsrc, bitrate_bps, 0));
+    rtcp::SenderReport sr;
+    sr.SetSenderSsrc(kSenderSsrc);
+    rtcp::CompoundPacket compound;
+    compound.Append(&sr);
+    compound.Append(&tmmbr);
+    EXPECT_CALL(rtp_rtcp_impl_, OnReceivedRtcpReportBlocks(_));
+    EXPECT_CALL(bandwidth_observer_, OnReceivedRtcpReceiverReport(_, _, _));
+    InjectRtcpPacket(compound);
+  };
+  EXPECT_CALL(intra_frame_observer_, OnReceivedPauseRequest(_, _))
+      .Times(AnyNumber());
+
+  EXPECT_CALL(rtp_rtcp_impl_, SetTmmbn(SizeIs(1)));
+  EXPECT_CALL(bandwidth_observer_, OnReceivedEstimatedBitrate(30000));
+  inject_tmmbr(30000);
+  Mock::VerifyAndClearExpectations(&rtp_rtcp_impl_);
+  Mock::VerifyAndClearExpectations(&bandwidth_observer_);
+
+  // The pause removes the limit and announces the empty bounding set.
+  EXPECT_CALL(rtp_rtcp_impl_, SetTmmbn(IsEmpty()));
+  inject_tmmbr(0);
+  EXPECT_EQ(0u, rtcp_receiver_.TmmbrReceived().size());
+  Mock::VerifyAndClearExpectations(&rtp_rtcp_impl_);
+
+  // The same limit on resume is applied again.
+  EXPECT_CALL(rtp_rtcp_impl_, SetTmmbn(SizeIs(1)));
+  EXPECT_CALL(bandwidth_observer_, OnReceivedEstimatedBitrate(30000));
+  inject_tmmbr(30000);
+  EXPECT_EQ(1u, rtcp_receiver_.TmmbrReceived().size());
+}
+
 TEST_F(RtcpReceiverTest, TmmbrThreeConstraintsTimeOut) {
   // Inject 3 packets "from" kSenderSsrc, kSenderSsrc+1, kSenderSsrc+2.
   // The times of arrival are starttime + 0, starttime + 5 and starttime + 10.
@@ -1164,6 +1236,36 @@ TEST_F(RtcpReceiverTest, ReceivesTransportFeedback) {
   InjectRtcpPacket(packet);
 }
 
+// Feedbacks are parsed into the same object, nothing may leak from one into
+// the next.
+TEST_F(RtcpReceiverTest, ReceivesConsecutiveTransportFeedbacks) {
+  rtcp::TransportFeedback large;
+  large.SetMediaSsrc(kReceiverMainSsrc);
+  large.SetSenderSsrc(kSenderSsrc);
+  large.SetBase(1, 1000);
+  for (uint16_t seq = 1; seq <= 100; ++seq)
+    large.AddReceivedPacket(seq, 1000 + seq * 1000);
+  rtcp::TransportFeedback small;
+  small.SetMediaSsrc(kReceiverMainSsrc);
+  small.SetSenderSsrc(kSenderSsrc);
+  small.SetBase(200, 2000);
+  small.AddReceivedPacket(200, 2000);
+
+  testing::InSequence in_sequence;
+  EXPECT_CALL(transport_feedback_observer_,
+              OnTransportFeedback(AllOf(
+                  Property(&rtcp::TransportFeedback::GetBaseSequence, 1),
+                  Property(&rtcp::TransportFeedback::GetStatusVector,
+                           SizeIs(100)))));
+  EXPECT_CALL(transport_feedback_observer_,
+              OnTransportFeedback(AllOf(
+                  Property(&rtcp::TransportFeedback::GetBaseSequence, 200),
+                  Property(&rtcp::TransportFeedback::GetStatusVector,
+                           SizeIs(1)))));
+  InjectRtcpPacket(large);
+  InjectRtcpPacket(small);
+}
+
 TEST_F(RtcpReceiverTest, ReceivesRemb) {
   const uint32_t kBitrateBps = 500000;
   rtcp::Remb remb;
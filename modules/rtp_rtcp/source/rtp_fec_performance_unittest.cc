@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/random.h"
+#include "webrtc/modules/rtp_rtcp/source/byte_io.h"
+#include "webrtc/modules/rtp_rtcp/source/fec_test_helper.h"
+#include "webrtc/modules/rtp_rtcp/source/fec_xor.h"
+#include "webrtc/modules/rtp_rtcp/source/forward_error_correction.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+constexpr uint32_t kMediaSsrc = 83542;
+constexpr size_t kPacketSize = 1200;
+constexpr int kNumMediaPackets = 12;
+// 50% protection, in Q8.
+constexpr int kProtectionFactor = 128;
+constexpr int kNumFrames = 500;
+constexpr int kNumXorIterations = 100000;
+
+// Time, in ns, to XOR one |kPacketSize| bytes payload using |xor_function|.
+double XorTime(void (*xor_function)(const uint8_t*, size_t, uint8_t*)) {
+  std::vector<uint8_t> src(kPacketSize, 0x5a);
+  std::vector<uint8_t> dst(kPacketSize, 0);
+  Clock* clock = Clock::GetRealTimeClock();
+  int64_t start_time_us = clock->TimeInMicroseconds();
+  for (int i = 0; i < kNumXorIterations; ++i)
+    xor_function(src.data(), src.size(), dst.data());
+  return 1000.0 * (clock->TimeInMicroseconds() - start_time_us) /
+         kNumXorIterations;
+}
+
+struct FecResults {
+  double encode_ns;
+  double decode_ns;
+};
+
+// Protects |kNumFrames| frames of |kNumMediaPackets| packets then recovers
+// them with every other media packet lost. Times are per media packet.
+FecResults EncodeDecodeFrames(ForwardErrorCorrection* fec) {
+  Random random(0xabcdef123456);
+  test::fec::MediaPacketGenerator generator(kPacketSize, kPacketSize,
+                                            kMediaSsrc, &random);
+  Clock* clock = Clock::GetRealTimeClock();
+  int64_t encode_time_us = 0;
+  int64_t decode_time_us = 0;
+  for (int frame = 0; frame < kNumFrames; ++frame) {
+    ForwardErrorCorrection::PacketList media_packets =
+        generator.ConstructMediaPackets(kNumMediaPackets);
+    std::list<ForwardErrorCorrection::Packet*> fec_packets;
+    int64_t start_time_us = clock->TimeInMicroseconds();
+    EXPECT_EQ(0, fec->EncodeFec(media_packets, kProtectionFactor, 0, false,
+                                kFecMaskBursty, &fec_packets));
+    encode_time_us += clock->TimeInMicroseconds() - start_time_us;
+
+    ForwardErrorCorrection::ReceivedPacketList received_packets;
+    int index = 0;
+    for (const auto& packet : media_packets) {
+      if (index++ % 2 == 0)
+        continue;
+      std::unique_ptr<ForwardErrorCorrection::ReceivedPacket> received(
+          new ForwardErrorCorrection::ReceivedPacket());
+      received->pkt = new ForwardErrorCorrection::Packet();
+      received->pkt->length = packet->length;
+      memcpy(received->pkt->data, packet->data, packet->length);
+      received->is_fec = false;
+      received->seq_num =
+          ByteReader<uint16_t>::ReadBigEndian(&packet->data[2]);
+      received_packets.push_back(std::move(received));
+    }
+    uint16_t fec_seq_num = generator.GetFecSeqNum();
+    for (const ForwardErrorCorrection::Packet* packet : fec_packets) {
+      std::unique_ptr<ForwardErrorCorrection::ReceivedPacket> received(
+          new ForwardErrorCorrection::ReceivedPacket());
+      received->pkt = new ForwardErrorCorrection::Packet();
+      received->pkt->length = packet->length;
+      memcpy(received->pkt->data, packet->data, packet->length);
+      received->is_fec = true;
+      received->seq_num = fec_seq_num++;
+      received->ssrc = kMediaSsrc;
+      received_packets.push_back(std::move(received));
+    }
+
+    ForwardErrorCorrection::RecoveredPacketList recovered_packets;
+    start_time_us = clock->TimeInMicroseconds();
+    EXPECT_EQ(0, fec->DecodeFec(&received_packets, &recovered_packets));
+    decode_time_us += clock->TimeInMicroseconds() - start_time_us;
+    EXPECT_EQ(media_packets.size(), recovered_packets.size());
+  }
+  const double num_packets = kNumFrames * kNumMediaPackets;
+  return {1000.0 * encode_time_us / num_packets,
+          1000.0 * decode_time_us / num_packets};
+}
+
+void PrintFecResults(const std::string& name, const FecResults& results) {
+  test::PrintResult(name + "_encode", "", "time_per_packet",
+                    results.encode_ns, "ns", false);
+  test::PrintResult(name + "_decode", "", "time_per_packet",
+                    results.decode_ns, "ns", false);
+  test::PrintResult(name + "_encode", "", "throughput",
+                    8 * kPacketSize / results.encode_ns * 1000, "Mbps", false);
+  test::PrintResult(name + "_decode", "", "throughput",
+                    8 * kPacketSize / results.decode_ns * 1000, "Mbps", false);
+}
+}  // namespace
+
+TEST(RtpFecPerformanceTest, XorKernel) {
+  double portable_ns = XorTime(&FecXor_C);
+  double fastest_ns = XorTime(&FecXor);
+
+  test::PrintResult("fec_xor", "", "portable", portable_ns, "ns", false);
+  test::PrintResult("fec_xor", "", "fastest", fastest_ns, "ns", false);
+}
+
+TEST(RtpFecPerformanceTest, UlpfecEncodeDecode) {
+  std::unique_ptr<ForwardErrorCorrection> fec =
+      ForwardErrorCorrection::CreateUlpfec();
+  PrintFecResults("ulpfec", EncodeDecodeFrames(fec.get()));
+}
+
+TEST(RtpFecPerformanceTest, FlexfecEncodeDecode) {
+  std::unique_ptr<ForwardErrorCorrection> fec =
+      ForwardErrorCorrection::CreateFlexfec();
+  PrintFecResults("flexfec", EncodeDecodeFrames(fec.get()));
+}
+
+}  // namespace webrtc
@@ -22,11 +22,21 @@ RtpPacketizer* RtpPacketizer::Create(RtpVideoCodecTypes type,
                                      size_t max_payload_len,
                                      const RTPVideoTypeHeader* rtp_type_header,
                                      FrameType frame_type) {
+  return Create(type, max_payload_len, rtp_type_header, frame_type, nullptr);
+}
+
+RtpPacketizer* RtpPacketizer::Create(
+    RtpVideoCodecTypes type,
+    size_t max_payload_len,
+    const RTPVideoTypeHeader* rtp_type_header,
+    FrameType frame_type,
+    SpsVuiRewriteCache* h264_sps_rewrite_cache) {
   switch (type) {
     case kRtpVideoH264:
       RTC_CHECK(rtp_type_header);
       return new RtpPacketizerH264(max_payload_len,
-                                   rtp_type_header->H264.packetization_mode);
+                                   rtp_type_header->H264.packetization_mode,
+                                   h264_sps_rewrite_cache);
     case kRtpVideoVp8:
       RTC_CHECK(rtp_type_header);
       return new RtpPacketizerVp8(rtp_type_header->VP8, max_payload_len);
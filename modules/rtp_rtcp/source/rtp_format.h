@@ -19,6 +19,7 @@
 
 namespace webrtc {
 class RtpPacketToSend;
+class SpsVuiRewriteCache;
 
 class RtpPacketizer {
  public:
@@ -26,6 +27,13 @@ class RtpPacketizer {
                                size_t max_payload_len,
                                const RTPVideoTypeHeader* rtp_type_header,
                                FrameType frame_type);
+  // Same as above, with the cache that the H264 packetizers of a stream
+  // share to rewrite their SPS, see RtpPacketizerH264.
+  static RtpPacketizer* Create(RtpVideoCodecTypes type,
+                               size_t max_payload_len,
+                               const RTPVideoTypeHeader* rtp_type_header,
+                               FrameType frame_type,
+                               SpsVuiRewriteCache* h264_sps_rewrite_cache);
 
   virtual ~RtpPacketizer() {}
 
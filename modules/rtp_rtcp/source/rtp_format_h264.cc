@@ -53,6 +53,12 @@ enum NalDefs : uint8_t { kFBit = 0x80, kNriMask = 0x60, kTypeMask = 0x1F };
 // Bit masks for FU (A and B) headers.
 enum FuDefs : uint8_t { kSBit = 0x80, kEBit = 0x40, kRBit = 0x20 };
 
+// Returns true if |buffer| holds the |length| bytes at |data|.
+bool HasBytes(const rtc::Buffer& buffer, const uint8_t* data, size_t length) {
+  return buffer.size() == length &&
+         (length == 0 || memcmp(buffer.data(), data, length) == 0);
+}
+
 // TODO(pbos): Avoid parsing this here as well as inside the jitter buffer.
 bool ParseStapAStartOffsets(const uint8_t* nalu_ptr,
                             size_t length_remaining,
@@ -80,8 +86,15 @@ bool ParseStapAStartOffsets(const uint8_t* nalu_ptr,
 
 RtpPacketizerH264::RtpPacketizerH264(size_t max_payload_len,
                                      H264PacketizationMode packetization_mode)
+    : RtpPacketizerH264(max_payload_len, packetization_mode, nullptr) {}
+
+RtpPacketizerH264::RtpPacketizerH264(size_t max_payload_len,
+                                     H264PacketizationMode packetization_mode,
+                                     SpsVuiRewriteCache* sps_rewrite_cache)
     : max_payload_len_(max_payload_len),
-      packetization_mode_(packetization_mode) {
+      packetization_mode_(packetization_mode),
+      sps_rewrite_cache_(sps_rewrite_cache ? sps_rewrite_cache
+                                           : &own_sps_rewrite_cache_) {
   // Guard against uninitialized memory in packetization_mode.
   RTC_CHECK(packetization_mode == H264PacketizationMode::NonInterleaved ||
             packetization_mode == H264PacketizationMode::SingleNalUnit);
@@ -122,26 +135,25 @@ void RtpPacketizerH264::SetPayloadData(
       // RtpDepacketizerH264::ParseSingleNalu (receive side, in orderer to
       // protect us from unknown or legacy send clients).
 
+      // The rewritten SPS is cached, so the SPS repeated with every key frame
+      // is neither parsed nor copied again. The fragment shares its buffer.
       rtc::Optional<SpsParser::SpsState> sps;
-
-      std::unique_ptr<rtc::Buffer> output_buffer(new rtc::Buffer());
-      // Add the type header to the output buffer first, so that the rewriter
-      // can append modified payload on top of that.
-      output_buffer->AppendData(buffer[0]);
-      SpsVuiRewriter::ParseResult result = SpsVuiRewriter::ParseAndRewriteSps(
-          buffer + H264::kNaluTypeSize, length - H264::kNaluTypeSize, &sps,
-          output_buffer.get());
+      SpsVuiRewriter::ParseResult result =
+          sps_rewrite_cache_->ParseAndRewriteSpsNalu(buffer, length, &sps);
 
       switch (result) {
-        case SpsVuiRewriter::ParseResult::kVuiRewritten:
+        case SpsVuiRewriter::ParseResult::kVuiRewritten: {
+          const rtc::CopyOnWriteBuffer& rewritten_sps =
+              sps_rewrite_cache_->rewritten_nalu();
           input_fragments_.push_back(
-              Fragment(output_buffer->data(), output_buffer->size()));
-          input_fragments_.rbegin()->tmp_buffer = std::move(output_buffer);
+              Fragment(rewritten_sps.cdata(), rewritten_sps.size()));
+          input_fragments_.rbegin()->tmp_buffer = rewritten_sps;
           updated_sps = true;
           RTC_HISTOGRAM_ENUMERATION(kSpsValidHistogramName,
                                     SpsValidEvent::kSentSpsRewritten,
                                     SpsValidEvent::kSpsRewrittenMax);
           break;
+        }
         case SpsVuiRewriter::ParseResult::kPocOk:
           RTC_HISTOGRAM_ENUMERATION(kSpsValidHistogramName,
                                     SpsValidEvent::kSentSpsPocOk,
@@ -349,7 +361,12 @@ std::string RtpPacketizerH264::ToString() {
   return "RtpPacketizerH264";
 }
 
-RtpDepacketizerH264::RtpDepacketizerH264() : offset_(0), length_(0) {}
+RtpDepacketizerH264::RtpDepacketizerH264()
+    : offset_(0),
+      length_(0),
+      last_pps_parsed_(false),
+      last_pps_id_(0),
+      last_pps_sps_id_(0) {}
 RtpDepacketizerH264::~RtpDepacketizerH264() {}
 
 bool RtpDepacketizerH264::Parse(ParsedPayload* parsed_payload,
@@ -447,18 +464,23 @@ bool RtpDepacketizerH264::ProcessStapAOrSingleNalu(
         // avoid
         // excessive decoder latency.
 
-        // Copy any previous data first (likely just the first header).
-        std::unique_ptr<rtc::Buffer> output_buffer(new rtc::Buffer());
-        if (start_offset)
-          output_buffer->AppendData(payload_data, start_offset);
-
         rtc::Optional<SpsParser::SpsState> sps;
 
-        SpsVuiRewriter::ParseResult result = SpsVuiRewriter::ParseAndRewriteSps(
-            &payload_data[start_offset], end_offset - start_offset, &sps,
-            output_buffer.get());
+        SpsVuiRewriter::ParseResult result =
+            sps_rewrite_cache_.ParseAndRewriteSpsNalu(
+                &payload_data[start_offset - H264::kNaluTypeSize],
+                end_offset - start_offset + H264::kNaluTypeSize, &sps);
         switch (result) {
-          case SpsVuiRewriter::ParseResult::kVuiRewritten:
+          case SpsVuiRewriter::ParseResult::kVuiRewritten: {
+            // Copy any previous data first (likely just the first header).
+            std::unique_ptr<rtc::Buffer> output_buffer(new rtc::Buffer());
+            if (start_offset)
+              output_buffer->AppendData(payload_data, start_offset);
+            const rtc::CopyOnWriteBuffer& rewritten_sps =
+                sps_rewrite_cache_.rewritten_nalu();
+            output_buffer->AppendData(
+                rewritten_sps.cdata() + H264::kNaluTypeSize,
+                rewritten_sps.size() - H264::kNaluTypeSize);
             if (modified_buffer_) {
               LOG(LS_WARNING)
                   << "More than one H264 SPS NAL units needing "
@@ -489,6 +511,7 @@ bool RtpDepacketizerH264::ProcessStapAOrSingleNalu(
                                       SpsValidEvent::kReceivedSpsRewritten,
                                       SpsValidEvent::kSpsRewrittenMax);
             break;
+          }
           case SpsVuiRewriter::ParseResult::kPocOk:
             RTC_HISTOGRAM_ENUMERATION(kSpsValidHistogramName,
                                       SpsValidEvent::kReceivedSpsPocOk,
@@ -519,9 +542,8 @@ bool RtpDepacketizerH264::ProcessStapAOrSingleNalu(
       case H264::NaluType::kPps: {
         uint32_t pps_id;
         uint32_t sps_id;
-        if (PpsParser::ParsePpsIds(&payload_data[start_offset],
-                                    end_offset - start_offset, &pps_id,
-                                    &sps_id)) {
+        if (ParsePpsIds(&payload_data[start_offset], end_offset - start_offset,
+                        &pps_id, &sps_id)) {
           nalu.pps_id = pps_id;
           nalu.sps_id = sps_id;
         } else {
@@ -571,6 +593,20 @@ bool RtpDepacketizerH264::ProcessStapAOrSingleNalu(
   return true;
 }
 
+bool RtpDepacketizerH264::ParsePpsIds(const uint8_t* data,
+                                      size_t length,
+                                      uint32_t* pps_id,
+                                      uint32_t* sps_id) {
+  if (!HasBytes(last_pps_, data, length)) {
+    last_pps_parsed_ = PpsParser::ParsePpsIds(data, length, &last_pps_id_,
+                                              &last_pps_sps_id_);
+    last_pps_.SetData(data, length);
+  }
+  *pps_id = last_pps_id_;
+  *sps_id = last_pps_sps_id_;
+  return last_pps_parsed_;
+}
+
 bool RtpDepacketizerH264::ParseFuaNalu(
     RtpDepacketizer::ParsedPayload* parsed_payload,
     const uint8_t* payload_data) {
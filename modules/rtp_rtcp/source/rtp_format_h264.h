@@ -18,6 +18,10 @@
 
 #include "webrtc/base/buffer.h"
 #include "webrtc/base/constructormagic.h"
+#include "webrtc/base/copyonwritebuffer.h"
+#include "webrtc/base/optional.h"
+#include "webrtc/common_video/h264/sps_parser.h"
+#include "webrtc/common_video/h264/sps_vui_rewriter.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_format.h"
 
 namespace webrtc {
@@ -28,6 +32,12 @@ class RtpPacketizerH264 : public RtpPacketizer {
   // The payload_data must be exactly one encoded H264 frame.
   RtpPacketizerH264(size_t max_payload_len,
                     H264PacketizationMode packetization_mode);
+  // Same as above, but the SPS are rewritten through |sps_rewrite_cache|,
+  // which is shared by the packetizers of a stream and must outlive
+  // SetPayloadData.
+  RtpPacketizerH264(size_t max_payload_len,
+                    H264PacketizationMode packetization_mode,
+                    SpsVuiRewriteCache* sps_rewrite_cache);
 
   virtual ~RtpPacketizerH264();
 
@@ -49,14 +59,14 @@ class RtpPacketizerH264 : public RtpPacketizer {
   std::string ToString() override;
 
  private:
-  // Input fragments (NAL units), with an optionally owned temporary buffer,
+  // Input fragments (NAL units), with an optionally shared temporary buffer,
   // used in case the fragment gets modified.
   struct Fragment {
     Fragment(const uint8_t* buffer, size_t length);
     explicit Fragment(const Fragment& fragment);
     const uint8_t* buffer = nullptr;
     size_t length = 0;
-    std::unique_ptr<rtc::Buffer> tmp_buffer;
+    rtc::CopyOnWriteBuffer tmp_buffer;
   };
 
   // A packet unit (H264 packet), to be put into an RTP packet:
@@ -93,6 +103,9 @@ class RtpPacketizerH264 : public RtpPacketizer {
 
   const size_t max_payload_len_;
   const H264PacketizationMode packetization_mode_;
+  // Used if no cache is shared with the packetizer.
+  SpsVuiRewriteCache own_sps_rewrite_cache_;
+  SpsVuiRewriteCache* const sps_rewrite_cache_;
   std::deque<Fragment> input_fragments_;
   std::queue<PacketUnit> packets_;
 
@@ -114,10 +127,25 @@ class RtpDepacketizerH264 : public RtpDepacketizer {
                     const uint8_t* payload_data);
   bool ProcessStapAOrSingleNalu(RtpDepacketizer::ParsedPayload* parsed_payload,
                                 const uint8_t* payload_data);
+  // Same as PpsParser::ParsePpsIds, but returns the results of the previous
+  // call if the PPS is the same.
+  bool ParsePpsIds(const uint8_t* data,
+                   size_t length,
+                   uint32_t* pps_id,
+                   uint32_t* sps_id);
 
   size_t offset_;
   size_t length_;
   std::unique_ptr<rtc::Buffer> modified_buffer_;
+
+  // The last SPS and PPS received and their parse results. The depacketizer
+  // lives as long as the stream, and senders repeat the same parameter sets
+  // with every key frame, so they are only parsed when they change.
+  SpsVuiRewriteCache sps_rewrite_cache_;
+  rtc::Buffer last_pps_;
+  bool last_pps_parsed_;
+  uint32_t last_pps_id_;
+  uint32_t last_pps_sps_id_;
 };
 }  // namespace webrtc
 #endif  // WEBRTC_MODULES_RTP_RTCP_SOURCE_RTP_FORMAT_H264_H_
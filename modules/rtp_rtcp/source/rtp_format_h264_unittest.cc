@@ -13,10 +13,12 @@
 
 #include "webrtc/base/array_view.h"
 #include "webrtc/common_video/h264/h264_common.h"
+#include "webrtc/common_video/h264/sps_vui_rewriter.h"
 #include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/modules/rtp_rtcp/mocks/mock_rtp_rtcp.h"
 #include "webrtc/modules/rtp_rtcp/source/byte_io.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_format.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_format_h264.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_packet_to_send.h"
 #include "webrtc/test/gmock.h"
 #include "webrtc/test/gtest.h"
@@ -539,6 +541,20 @@ TEST_F(RtpPacketizerH264TestSpsRewriting, StapASps) {
               ElementsAreArray(kRewrittenSps));
 }
 
+TEST_F(RtpPacketizerH264TestSpsRewriting, SharedCacheRewritesRepeatedSps) {
+  SpsVuiRewriteCache cache;
+  for (int i = 0; i < 2; ++i) {
+    RtpPacketizerH264 packetizer(kMaxPayloadSize,
+                                 H264PacketizationMode::SingleNalUnit, &cache);
+    packetizer.SetPayloadData(in_buffer_.data(), in_buffer_.size(),
+                              &fragmentation_header_);
+    bool last_packet = true;
+    RtpPacketToSend packet(kNoExtensions);
+    ASSERT_TRUE(packetizer.NextPacket(&packet, &last_packet));
+    EXPECT_THAT(packet.payload(), ElementsAreArray(kRewrittenSps));
+  }
+}
+
 class RtpDepacketizerH264Test : public ::testing::Test {
  protected:
   RtpDepacketizerH264Test()
@@ -758,6 +774,27 @@ TEST_F(RtpDepacketizerH264Test, DepacketizeWithDoubleRewriting) {
       ::testing::ElementsAreArray(payload.payload, payload.payload_length));
 }
 
+TEST_F(RtpDepacketizerH264Test, DepacketizeRepeatedSpsWithRewriting) {
+  // The second SPS is rewritten the same way from the cached parse results.
+  for (int i = 0; i < 2; ++i) {
+    RtpDepacketizer::ParsedPayload payload;
+    ASSERT_TRUE(
+        depacketizer_->Parse(&payload, kOriginalSps, sizeof(kOriginalSps)));
+    ExpectPacket(&payload, kRewrittenSps, sizeof(kRewrittenSps));
+    EXPECT_EQ(kVideoFrameKey, payload.frame_type);
+  }
+
+  // A different SPS is parsed again.
+  uint8_t packet[] = {kSps, 0x7A, 0x00, 0x1F, 0xBC, 0xD9, 0x40, 0x50,
+                      0x05, 0xBA, 0x10, 0x00, 0x00, 0x03, 0x00, 0xC0,
+                      0x00, 0x00, 0x03, 0x2A, 0xE0, 0xF1, 0x83, 0x25};
+  RtpDepacketizer::ParsedPayload payload;
+  ASSERT_TRUE(depacketizer_->Parse(&payload, packet, sizeof(packet)));
+  ExpectPacket(&payload, packet, sizeof(packet));
+  EXPECT_EQ(1280u, payload.type.Video.width);
+  EXPECT_EQ(720u, payload.type.Video.height);
+}
+
 TEST_F(RtpDepacketizerH264Test, TestStapADelta) {
   uint8_t packet[16] = {kStapA,  // F=0, NRI=0, Type=24.
                         // Length, nal header, payload.
@@ -10,6 +10,8 @@
 
 #include "webrtc/modules/rtp_rtcp/source/rtp_header_extension.h"
 
+#include <string.h>
+
 #include "webrtc/base/arraysize.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
@@ -57,6 +59,13 @@ size_t ValueSize(RTPExtensionType type) {
   return 0;
 }
 
+// Frame marking omits its scalability fields for non-scalable streams.
+constexpr size_t kFrameMarkingNonScalableSize = 1;
+
+uint8_t ElementHeader(uint8_t id, size_t value_size) {
+  return (id << 4) | (value_size - 1);
+}
+
 }  // namespace
 
 constexpr RTPExtensionType RtpHeaderExtensionMap::kInvalidType;
@@ -70,6 +79,7 @@ RtpHeaderExtensionMap::RtpHeaderExtensionMap() {
     type = kInvalidType;
   for (auto& id : ids_)
     id = kInvalidId;
+  memset(element_types_, kInvalidType, sizeof(element_types_));
 }
 
 RtpHeaderExtensionMap::RtpHeaderExtensionMap(
@@ -106,6 +116,8 @@ int32_t RtpHeaderExtensionMap::Deregister(RTPExtensionType type) {
   if (IsRegistered(type)) {
     uint8_t id = GetId(type);
     total_values_size_bytes_ -= (ValueSize(type) + 1);
+    for (size_t length = 0; length < 16; ++length)
+      element_types_[ElementHeader(id, length + 1)] = kInvalidType;
     types_[id] = kInvalidType;
     ids_[type] = kInvalidId;
   }
@@ -144,6 +156,9 @@ bool RtpHeaderExtensionMap::Register(uint8_t id,
 
   types_[id] = type;
   ids_[type] = id;
+  element_types_[ElementHeader(id, value_size)] = type;
+  if (type == kRtpExtensionFrameMarking)
+    element_types_[ElementHeader(id, kFrameMarkingNonScalableSize)] = type;
   total_values_size_bytes_ += (value_size + 1);
   return true;
 }
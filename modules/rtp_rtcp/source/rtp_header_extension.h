@@ -71,6 +71,15 @@ class RtpHeaderExtensionMap {
     return ids_[type];
   }
 
+  // Type registered with the id of the one-byte header extension element
+  // starting with |element_header|, if the element has a valid length for
+  // that type. Returns kInvalidType for padding, unregistered ids and
+  // unexpected lengths, which parsers then handle separately, so the
+  // registered extensions are found with a single lookup.
+  RTPExtensionType GetTypeForElement(uint8_t element_header) const {
+    return static_cast<RTPExtensionType>(element_types_[element_header]);
+  }
+
   size_t GetTotalLengthInBytes() const;
 
   // TODO(danilchap): Remove use of the functions below.
@@ -90,6 +99,9 @@ class RtpHeaderExtensionMap {
   size_t total_values_size_bytes_ = 0;
   RTPExtensionType types_[kMaxId + 1];
   uint8_t ids_[kRtpExtensionNumberOfExtensions];
+  // Indexed by the one-byte element header, id in the 4 high bits and length
+  // minus one in the 4 low bits. Updated when an extension is (de)registered.
+  uint8_t element_types_[256];
 };
 
 }  // namespace webrtc
@@ -99,6 +99,25 @@ TEST(RtpHeaderExtensionTest, GetType) {
   EXPECT_EQ(TransmissionOffset::kId, map.GetType(3));
 }
 
+TEST(RtpHeaderExtensionTest, GetTypeForElement) {
+  RtpHeaderExtensionMap map;
+  EXPECT_TRUE(map.Register<TransmissionOffset>(3));
+  EXPECT_TRUE(map.Register<FrameMarking>(4));
+
+  // Id in the high nibble, value size minus one in the low nibble.
+  EXPECT_EQ(TransmissionOffset::kId, map.GetTypeForElement(0x32));
+  EXPECT_EQ(RtpHeaderExtensionMap::kInvalidType, map.GetTypeForElement(0x31));
+  EXPECT_EQ(RtpHeaderExtensionMap::kInvalidType, map.GetTypeForElement(0x52));
+  EXPECT_EQ(RtpHeaderExtensionMap::kInvalidType, map.GetTypeForElement(0x00));
+  // Frame marking has a short form without the scalability fields.
+  EXPECT_EQ(FrameMarking::kId, map.GetTypeForElement(0x40));
+  EXPECT_EQ(FrameMarking::kId, map.GetTypeForElement(0x42));
+  EXPECT_EQ(RtpHeaderExtensionMap::kInvalidType, map.GetTypeForElement(0x41));
+
+  EXPECT_EQ(0, map.Deregister(TransmissionOffset::kId));
+  EXPECT_EQ(RtpHeaderExtensionMap::kInvalidType, map.GetTypeForElement(0x32));
+}
+
 TEST(RtpHeaderExtensionTest, GetId) {
   RtpHeaderExtensionMap map;
   EXPECT_EQ(RtpHeaderExtensionMap::kInvalidId,
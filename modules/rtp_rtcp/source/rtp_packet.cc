@@ -66,6 +66,7 @@ Packet::Packet(const ExtensionManager* extensions, size_t capacity)
   } else {
     for (size_t i = 0; i < kMaxExtensionHeaders; ++i)
       extension_entries_[i].type = ExtensionManager::kInvalidType;
+    UpdateExtensionIndex();
   }
 }
 
@@ -74,6 +75,7 @@ Packet::~Packet() {}
 void Packet::IdentifyExtensions(const ExtensionManager& extensions) {
   for (size_t i = 0; i < kMaxExtensionHeaders; ++i)
     extension_entries_[i].type = extensions.GetType(i + 1);
+  UpdateExtensionIndex();
 }
 
 bool Packet::Parse(const uint8_t* buffer, size_t buffer_size) {
@@ -164,6 +166,8 @@ void Packet::GetHeader(RTPHeader* header) const {
       &header->extension.voiceActivity, &header->extension.audioLevel);
   header->extension.hasVideoRotation =
       GetExtension<VideoOrientation>(&header->extension.videoRotation);
+  header->extension.hasFrameMarks =
+      GetExtension<FrameMarking>(&header->extension.frameMarks);
 }
 
 size_t Packet::headers_size() const {
@@ -220,6 +224,7 @@ void Packet::CopyHeaderFrom(const Packet& packet) {
   for (size_t i = 0; i < kMaxExtensionHeaders; ++i) {
     extension_entries_[i] = packet.extension_entries_[i];
   }
+  memcpy(extension_index_, packet.extension_index_, sizeof(extension_index_));
   extensions_size_ = packet.extensions_size_;
   buffer_.SetData(packet.data(), packet.headers_size());
   // Reset payload and padding.
@@ -287,6 +292,20 @@ uint8_t* Packet::AllocatePayload(size_t size_bytes) {
   return WriteAt(payload_offset_);
 }
 
+uint8_t* Packet::ExtendPayload(size_t size_bytes) {
+  RTC_DCHECK_EQ(padding_size_, 0);
+  RTC_DCHECK_GE(size_bytes, payload_size_);
+  if (payload_offset_ + size_bytes > capacity()) {
+    LOG(LS_WARNING) << "Cannot extend payload, not enough space in buffer.";
+    return nullptr;
+  }
+  // If CopyOnWrite buffer_ was shared, this will cause reallocation and memcpy
+  // of the current headers and payload only.
+  payload_size_ = size_bytes;
+  buffer_.SetSize(payload_offset_ + payload_size_);
+  return WriteAt(payload_offset_);
+}
+
 void Packet::SetPayloadSize(size_t size_bytes) {
   RTC_DCHECK_EQ(padding_size_, 0);
   RTC_DCHECK_LE(size_bytes, payload_size_);
@@ -444,31 +463,24 @@ bool Packet::FindExtension(ExtensionType type,
                            uint8_t* length,
                            uint16_t* offset) const {
   RTC_DCHECK(offset);
-  for (size_t i = 0; i < kMaxExtensionHeaders; ++i) {
-    if (extension_entries_[i].type == type) {
-      *length = extension_entries_[i].length;
-      *offset = extension_entries_[i].offset;
-      return true;
-    }
-  }
-  return false;
+  RTC_DCHECK_LT(type, kRtpExtensionNumberOfExtensions);
+  uint8_t index = extension_index_[type];
+  if (index == 0)
+    return false;
+  *length = extension_entries_[index - 1].length;
+  *offset = extension_entries_[index - 1].offset;
+  return true;
 }
 
 bool Packet::AllocateExtension(ExtensionType type,
                                uint8_t length,
                                uint16_t* offset) {
-  uint8_t extension_id = ExtensionManager::kInvalidId;
-  ExtensionInfo* extension_entry = nullptr;
-  for (size_t i = 0; i < kMaxExtensionHeaders; ++i) {
-    if (extension_entries_[i].type == type) {
-      extension_id = i + 1;
-      extension_entry = &extension_entries_[i];
-      break;
-    }
-  }
-
-  if (!extension_entry)  // Extension not registered.
+  RTC_DCHECK_LT(type, kRtpExtensionNumberOfExtensions);
+  // Entry i holds the extension with id i + 1.
+  const uint8_t extension_id = extension_index_[type];
+  if (extension_id == ExtensionManager::kInvalidId)  // Extension not registered.
     return false;
+  ExtensionInfo* extension_entry = &extension_entries_[extension_id - 1];
 
   if (extension_entry->length != 0) {  // Already allocated.
     if (length != extension_entry->length) {
@@ -536,6 +548,17 @@ bool Packet::AllocateExtension(ExtensionType type,
   return true;
 }
 
+void Packet::UpdateExtensionIndex() {
+  memset(extension_index_, 0, sizeof(extension_index_));
+  for (size_t i = 0; i < kMaxExtensionHeaders; ++i) {
+    ExtensionType type = extension_entries_[i].type;
+    // As when scanning the entries, the lowest id wins if a type is
+    // registered twice.
+    if (type != ExtensionManager::kInvalidType && extension_index_[type] == 0)
+      extension_index_[type] = i + 1;
+  }
+}
+
 uint8_t* Packet::WriteAt(size_t offset) {
   return buffer_.data() + offset;
 }
@@ -97,6 +97,9 @@ class Packet {
 
   // Reserve size_bytes for payload. Returns nullptr on failure.
   uint8_t* AllocatePayload(size_t size_bytes);
+  // Same as AllocatePayload, but keeps the payload already written, so the
+  // payload can be transformed in place. Returns nullptr on failure.
+  uint8_t* ExtendPayload(size_t size_bytes);
   void SetPayloadSize(size_t size_bytes);
   bool SetPadding(uint8_t size_bytes, Random* random);
 
@@ -140,6 +143,9 @@ class Packet {
   // unchanged.
   bool AllocateExtension(ExtensionType type, uint8_t length, uint16_t* offset);
 
+  // Rebuilds |extension_index_| from the types in |extension_entries_|.
+  void UpdateExtensionIndex();
+
   uint8_t* WriteAt(size_t offset);
   void WriteAt(size_t offset, uint8_t byte);
 
@@ -154,6 +160,10 @@ class Packet {
   size_t payload_size_;
 
   ExtensionInfo extension_entries_[kMaxExtensionHeaders];
+  // Position + 1 in |extension_entries_| of each registered extension type, 0
+  // if not registered, so that rewriting an extension, e.g. the frame marking
+  // of every packet of a frame, is a direct store at its offset.
+  uint8_t extension_index_[kRtpExtensionNumberOfExtensions];
   uint16_t extensions_size_ = 0;  // Unaligned.
   rtc::CopyOnWriteBuffer buffer_;
 };
@@ -11,7 +11,6 @@
 #include "webrtc/modules/rtp_rtcp/source/rtp_packet_history.h"
 
 #include <algorithm>
-#include <limits>
 
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
@@ -21,11 +20,24 @@
 namespace webrtc {
 namespace {
 constexpr size_t kMinPacketRequestBytes = 50;
+// Number of slots allocated when storing is enabled. The history then
+// doubles each time it wraps around, up to the requested number of packets,
+// so streams that send little never pay for the full history.
+constexpr size_t kInitialCapacity = 32;
 }  // namespace
 constexpr size_t RtpPacketHistory::kMaxCapacity;
+constexpr size_t RtpPacketHistory::kSizeBucketBytes;
+constexpr size_t RtpPacketHistory::kNumSizeBuckets;
+constexpr uint16_t RtpPacketHistory::kNoSlot;
 
 RtpPacketHistory::RtpPacketHistory(Clock* clock)
-    : clock_(clock), store_(false), prev_index_(0) {}
+    : clock_(clock),
+      store_(false),
+      prev_index_(0),
+      capacity_(0),
+      seq_mask_(0) {
+  std::fill(size_index_, size_index_ + kNumSizeBuckets, kNoSlot);
+}
 
 RtpPacketHistory::~RtpPacketHistory() {}
 
@@ -48,7 +60,29 @@ void RtpPacketHistory::Allocate(size_t number_to_store) {
   RTC_DCHECK_GT(number_to_store, 0);
   RTC_DCHECK_LE(number_to_store, kMaxCapacity);
   store_ = true;
-  stored_packets_.resize(number_to_store);
+  capacity_ = number_to_store;
+  Resize(std::min(number_to_store, kInitialCapacity));
+}
+
+void RtpPacketHistory::Resize(size_t size) {
+  stored_packets_.resize(size);
+  RebuildSeqIndex();
+}
+
+void RtpPacketHistory::RebuildSeqIndex() {
+  size_t index_size = 1;
+  while (index_size < 2 * stored_packets_.size())
+    index_size *= 2;
+  seq_index_.assign(index_size, kNoSlot);
+  seq_mask_ = static_cast<uint16_t>(index_size - 1);
+  // Most recent packets last, so they win if old ones collide.
+  for (size_t i = 0; i < stored_packets_.size(); ++i) {
+    int index = (prev_index_ + i) % stored_packets_.size();
+    if (stored_packets_[index].packet || stored_packets_[index].send_time) {
+      seq_index_[stored_packets_[index].sequence_number & seq_mask_] =
+          static_cast<uint16_t>(index);
+    }
+  }
 }
 
 void RtpPacketHistory::Free() {
@@ -57,9 +91,12 @@ void RtpPacketHistory::Free() {
   }
 
   stored_packets_.clear();
+  seq_index_.clear();
+  std::fill(size_index_, size_index_ + kNumSizeBuckets, kNoSlot);
 
   store_ = false;
   prev_index_ = 0;
+  capacity_ = 0;
 }
 
 bool RtpPacketHistory::StorePackets() const {
@@ -85,7 +122,8 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
     if (current_size < kMaxCapacity) {
       size_t expanded_size = std::max(current_size * 3 / 2, current_size + 1);
       expanded_size = std::min(expanded_size, kMaxCapacity);
-      Allocate(expanded_size);
+      capacity_ = std::max(capacity_, expanded_size);
+      Resize(expanded_size);
       // Causes discontinuity, but that's OK-ish. FindSeqNum() will still work,
       // but may be slower - at least until buffer has wrapped around once.
       prev_index_ = current_size;
@@ -93,6 +131,10 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
   }
 
   // Store packet.
+  uint16_t& old_entry =
+      seq_index_[stored_packets_[prev_index_].sequence_number & seq_mask_];
+  if (old_entry == prev_index_)
+    old_entry = kNoSlot;
   if (packet->capture_time_ms() <= 0)
     packet->set_capture_time_ms(clock_->TimeInMilliseconds());
   stored_packets_[prev_index_].sequence_number = packet->SequenceNumber();
@@ -100,11 +142,19 @@ void RtpPacketHistory::PutRtpPacket(std::unique_ptr<RtpPacketToSend> packet,
       (sent ? clock_->TimeInMilliseconds() : 0);
   stored_packets_[prev_index_].storage_type = type;
   stored_packets_[prev_index_].has_been_retransmitted = false;
+  stored_packets_[prev_index_].retransmit_when_returned = false;
   stored_packets_[prev_index_].packet = std::move(packet);
+  IndexSlot(prev_index_);
 
   ++prev_index_;
   if (prev_index_ >= stored_packets_.size()) {
-    prev_index_ = 0;
+    if (stored_packets_.size() < capacity_) {
+      // Grow rather than wrap; the new slots come right after the newest
+      // packet, so the history stays in order.
+      Resize(std::min(stored_packets_.size() * 2, capacity_));
+    } else {
+      prev_index_ = 0;
+    }
   }
 }
 
@@ -123,14 +173,114 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
     int64_t min_elapsed_time_ms,
     bool retransmit) {
   rtc::CritScope cs(&critsect_);
-  if (!store_) {
+  int index = FindPacketAndSetSendTime(sequence_number, min_elapsed_time_ms,
+                                       retransmit);
+  if (index < 0)
     return nullptr;
+  return GetPacket(index);
+}
+
+std::unique_ptr<RtpPacketToSend> RtpPacketHistory::TakePacketAndSetSendTime(
+    uint16_t sequence_number,
+    int64_t min_elapsed_time_ms,
+    bool retransmit) {
+  rtc::CritScope cs(&critsect_);
+  int index = FindPacketAndSetSendTime(sequence_number, min_elapsed_time_ms,
+                                       retransmit);
+  if (index < 0) {
+    if (retransmit)
+      DeferRetransmission(sequence_number, min_elapsed_time_ms);
+    return nullptr;
+  }
+  return std::move(stored_packets_[index].packet);
+}
+
+void RtpPacketHistory::GetRetransmittable(
+    const std::vector<uint16_t>& sequence_numbers,
+    int64_t min_elapsed_time_ms,
+    std::vector<RetransmittedPacket>* packets) {
+  rtc::CritScope cs(&critsect_);
+  for (uint16_t sequence_number : sequence_numbers) {
+    int index = FindPacketToSend(sequence_number, min_elapsed_time_ms, true);
+    if (index < 0) {
+      DeferRetransmission(sequence_number, min_elapsed_time_ms);
+      continue;
+    }
+    const RtpPacketToSend& packet = *stored_packets_[index].packet;
+    packets->push_back({packet.Ssrc(), sequence_number,
+                        packet.capture_time_ms(), packet.payload_size(),
+                        packet.size()});
+  }
+}
+
+void RtpPacketHistory::SetRetransmitted(
+    const std::vector<RetransmittedPacket>& packets) {
+  rtc::CritScope cs(&critsect_);
+  if (!store_)
+    return;
+  for (const RetransmittedPacket& packet : packets) {
+    // The slot may have been reused since GetRetransmittable.
+    int index = 0;
+    if (FindSeqNum(packet.sequence_number, &index))
+      SetSendTime(index, true);
+  }
+}
+
+bool RtpPacketHistory::ReturnPacket(std::unique_ptr<RtpPacketToSend> packet) {
+  RTC_DCHECK(packet);
+  rtc::CritScope cs(&critsect_);
+  if (!store_)
+    return false;
+  // Taken packets keep their slot, with the send time set.
+  int index = 0;
+  if (!FindSlot(packet->SequenceNumber(), &index) ||
+      stored_packets_[index].packet || stored_packets_[index].send_time == 0) {
+    return false;
+  }
+  bool retransmit = stored_packets_[index].retransmit_when_returned;
+  stored_packets_[index].retransmit_when_returned = false;
+  stored_packets_[index].packet = std::move(packet);
+  // Only take the size bucket back if no newer packet took it meanwhile.
+  size_t bucket = SizeBucket(stored_packets_[index].packet->size());
+  uint16_t entry = size_index_[bucket];
+  if (entry == kNoSlot || !stored_packets_[entry].packet ||
+      SizeBucket(stored_packets_[entry].packet->size()) != bucket) {
+    size_index_[bucket] = static_cast<uint16_t>(index);
+  }
+  return retransmit;
+}
+
+void RtpPacketHistory::IndexSlot(int index) {
+  const StoredPacket& stored = stored_packets_[index];
+  seq_index_[stored.sequence_number & seq_mask_] = static_cast<uint16_t>(index);
+  size_index_[SizeBucket(stored.packet->size())] = static_cast<uint16_t>(index);
+}
+
+size_t RtpPacketHistory::SizeBucket(size_t size) {
+  return std::min(size / kSizeBucketBytes, kNumSizeBuckets - 1);
+}
+
+int RtpPacketHistory::FindPacketAndSetSendTime(uint16_t sequence_number,
+                                               int64_t min_elapsed_time_ms,
+                                               bool retransmit) {
+  int index =
+      FindPacketToSend(sequence_number, min_elapsed_time_ms, retransmit);
+  if (index >= 0)
+    SetSendTime(index, retransmit);
+  return index;
+}
+
+int RtpPacketHistory::FindPacketToSend(uint16_t sequence_number,
+                                       int64_t min_elapsed_time_ms,
+                                       bool retransmit) const {
+  if (!store_) {
+    return -1;
   }
 
   int index = 0;
   if (!FindSeqNum(sequence_number, &index)) {
     LOG(LS_WARNING) << "No match for getting seqNum " << sequence_number;
-    return nullptr;
+    return -1;
   }
   RTC_DCHECK_EQ(sequence_number,
                 stored_packets_[index].packet->SequenceNumber());
@@ -141,18 +291,38 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacketAndSetSendTime(
   if (min_elapsed_time_ms > 0 && retransmit &&
       stored_packets_[index].has_been_retransmitted &&
       ((now - stored_packets_[index].send_time) < min_elapsed_time_ms)) {
-    return nullptr;
+    return -1;
   }
 
-  if (retransmit) {
-    if (stored_packets_[index].storage_type == kDontRetransmit) {
-      // No bytes copied since this packet shouldn't be retransmitted.
-      return nullptr;
-    }
-    stored_packets_[index].has_been_retransmitted = true;
+  if (retransmit && stored_packets_[index].storage_type == kDontRetransmit) {
+    // No bytes copied since this packet shouldn't be retransmitted.
+    return -1;
   }
+  return index;
+}
+
+void RtpPacketHistory::SetSendTime(int index, bool retransmit) {
+  if (retransmit)
+    stored_packets_[index].has_been_retransmitted = true;
   stored_packets_[index].send_time = clock_->TimeInMilliseconds();
-  return GetPacket(index);
+}
+
+void RtpPacketHistory::DeferRetransmission(uint16_t sequence_number,
+                                           int64_t min_elapsed_time_ms) {
+  int index = 0;
+  if (!store_ || !FindSlot(sequence_number, &index))
+    return;
+  StoredPacket& stored = stored_packets_[index];
+  // Same checks as FindPacketToSend, against the time the packet was taken.
+  if (stored.packet || stored.send_time == 0 ||
+      stored.storage_type == kDontRetransmit) {
+    return;
+  }
+  if (min_elapsed_time_ms > 0 && stored.has_been_retransmitted &&
+      clock_->TimeInMilliseconds() - stored.send_time < min_elapsed_time_ms) {
+    return;
+  }
+  stored.retransmit_when_returned = true;
 }
 
 std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetPacket(int index) const {
@@ -172,50 +342,44 @@ std::unique_ptr<RtpPacketToSend> RtpPacketHistory::GetBestFittingPacket(
 }
 
 bool RtpPacketHistory::FindSeqNum(uint16_t sequence_number, int* index) const {
-  if (prev_index_ > 0) {
-    *index = prev_index_ - 1;
-  } else {
-    *index = stored_packets_.size() - 1;  // Wrap.
-  }
-  uint16_t temp_sequence_number = stored_packets_[*index].sequence_number;
-
-  int idx = *index - (temp_sequence_number - sequence_number);
-  if (idx >= 0 && idx < static_cast<int>(stored_packets_.size())) {
-    *index = idx;
-    temp_sequence_number = stored_packets_[*index].sequence_number;
-  }
+  return FindSlot(sequence_number, index) && stored_packets_[*index].packet;
+}
 
-  if (temp_sequence_number != sequence_number) {
-    // We did not found a match, search all.
-    for (uint16_t m = 0; m < stored_packets_.size(); m++) {
-      if (stored_packets_[m].sequence_number == sequence_number) {
-        *index = m;
-        temp_sequence_number = stored_packets_[*index].sequence_number;
-        break;
-      }
-    }
+bool RtpPacketHistory::FindSlot(uint16_t sequence_number, int* index) const {
+  if (seq_index_.empty())
+    return false;
+  uint16_t entry = seq_index_[sequence_number & seq_mask_];
+  if (entry == kNoSlot ||
+      stored_packets_[entry].sequence_number != sequence_number) {
+    return false;
   }
-  return temp_sequence_number == sequence_number &&
-         stored_packets_[*index].packet;
+  *index = entry;
+  return true;
 }
 
 int RtpPacketHistory::FindBestFittingPacket(size_t size) const {
   if (size < kMinPacketRequestBytes || stored_packets_.empty())
     return -1;
-  size_t min_diff = std::numeric_limits<size_t>::max();
-  int best_index = -1;  // Returned unchanged if we don't find anything.
-  for (size_t i = 0; i < stored_packets_.size(); ++i) {
-    if (!stored_packets_[i].packet)
-      continue;
-    size_t stored_size = stored_packets_[i].packet->size();
-    size_t diff =
-        (stored_size > size) ? (stored_size - size) : (size - stored_size);
-    if (diff < min_diff) {
-      min_diff = diff;
-      best_index = static_cast<int>(i);
+  // Check the buckets closest to |size| first, alternating between smaller
+  // and larger packets. A bucket is empty if its packet has been overwritten
+  // or taken out.
+  int bucket = static_cast<int>(SizeBucket(size));
+  for (int distance = 0; distance < static_cast<int>(kNumSizeBuckets);
+       ++distance) {
+    for (int candidate : {bucket - distance, bucket + distance}) {
+      if (candidate < 0 || candidate >= static_cast<int>(kNumSizeBuckets))
+        continue;
+      uint16_t entry = size_index_[candidate];
+      if (entry != kNoSlot && stored_packets_[entry].packet &&
+          SizeBucket(stored_packets_[entry].packet->size()) ==
+              static_cast<size_t>(candidate)) {
+        return entry;
+      }
+      if (distance == 0)
+        break;
     }
   }
-  return best_index;
+  return -1;
 }
 
 }  // namespace webrtc
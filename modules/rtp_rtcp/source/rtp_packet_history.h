@@ -44,40 +44,115 @@ class RtpPacketHistory {
   // the last time the packet was resent (parameter is ignored if set to zero).
   // If the packet is found but the minimum time has not elapsed, returns
   // nullptr.
+  // The returned copy shares the payload with the stored packet, writing to
+  // it (e.g. updating header extensions) copies the whole packet.
   std::unique_ptr<RtpPacketToSend> GetPacketAndSetSendTime(
       uint16_t sequence_number,
       int64_t min_elapsed_time_ms,
       bool retransmit);
 
+  // Same as GetPacketAndSetSendTime, but moves the stored packet out rather
+  // than sharing it, so it can be updated and sent without any copy. It is
+  // not found by other lookups until handed back with ReturnPacket; a
+  // retransmission requested meanwhile is deferred until then.
+  std::unique_ptr<RtpPacketToSend> TakePacketAndSetSendTime(
+      uint16_t sequence_number,
+      int64_t min_elapsed_time_ms,
+      bool retransmit);
+  // Stores back a packet from TakePacketAndSetSendTime, unless its slot has
+  // been reused since. Returns true if a retransmission of the packet was
+  // requested while it was taken out, which is then up to the caller.
+  bool ReturnPacket(std::unique_ptr<RtpPacketToSend> packet);
+
+  struct RetransmittedPacket {
+    uint32_t ssrc;
+    uint16_t sequence_number;
+    int64_t capture_time_ms;
+    size_t payload_size;
+    size_t size;
+  };
+  // Appends to |packets|, in order, the packets in |sequence_numbers| that
+  // GetPacketAndSetSendTime(sequence_number, min_elapsed_time_ms, true) would
+  // return, locking only once and without copying them. The packets are not
+  // marked as retransmitted; call SetRetransmitted for those actually sent.
+  void GetRetransmittable(const std::vector<uint16_t>& sequence_numbers,
+                          int64_t min_elapsed_time_ms,
+                          std::vector<RetransmittedPacket>* packets);
+  // Marks |packets| as retransmitted now, as GetPacketAndSetSendTime would.
+  void SetRetransmitted(const std::vector<RetransmittedPacket>& packets);
+
+  // Returns a copy of a stored packet with a size close to |packet_size|,
+  // preferring recent packets. Packets are grouped by size, so the match is
+  // only exact to within kSizeBucketBytes.
   std::unique_ptr<RtpPacketToSend> GetBestFittingPacket(
       size_t packet_size) const;
 
   bool HasRtpPacket(uint16_t sequence_number) const;
 
  private:
+  static constexpr size_t kSizeBucketBytes = 32;
+  static constexpr size_t kNumSizeBuckets = IP_PACKET_SIZE / kSizeBucketBytes;
+  static constexpr uint16_t kNoSlot = 0xffff;
+
   struct StoredPacket {
     uint16_t sequence_number = 0;
     int64_t send_time = 0;
     StorageType storage_type = kDontRetransmit;
     bool has_been_retransmitted = false;
+    // A retransmission was requested while the packet was taken out.
+    bool retransmit_when_returned = false;
 
     std::unique_ptr<RtpPacketToSend> packet;
   };
 
   std::unique_ptr<RtpPacketToSend> GetPacket(int index) const
       EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  // Returns the index of the packet to send, or -1.
+  int FindPacketAndSetSendTime(uint16_t sequence_number,
+                               int64_t min_elapsed_time_ms,
+                               bool retransmit)
+      EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  // Same as FindPacketAndSetSendTime, but leaves the send time unchanged.
+  int FindPacketToSend(uint16_t sequence_number,
+                       int64_t min_elapsed_time_ms,
+                       bool retransmit) const
+      EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  void SetSendTime(int index, bool retransmit)
+      EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  // If the packet is taken out, e.g. being sent by the pacer, and could be
+  // retransmitted otherwise, defers the retransmission until it is returned.
+  void DeferRetransmission(uint16_t sequence_number,
+                           int64_t min_elapsed_time_ms)
+      EXCLUSIVE_LOCKS_REQUIRED(critsect_);
   void Allocate(size_t number_to_store) EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  void Resize(size_t size) EXCLUSIVE_LOCKS_REQUIRED(critsect_);
   void Free() EXCLUSIVE_LOCKS_REQUIRED(critsect_);
   bool FindSeqNum(uint16_t sequence_number, int* index) const
       EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  // Same as FindSeqNum, but also finds the slot of a packet taken out.
+  bool FindSlot(uint16_t sequence_number, int* index) const
+      EXCLUSIVE_LOCKS_REQUIRED(critsect_);
   int FindBestFittingPacket(size_t size) const
       EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  // Points the sequence number and size indexes at the packet in |index|.
+  void IndexSlot(int index) EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  void RebuildSeqIndex() EXCLUSIVE_LOCKS_REQUIRED(critsect_);
+  static size_t SizeBucket(size_t size);
 
   Clock* clock_;
   rtc::CriticalSection critsect_;
   bool store_ GUARDED_BY(critsect_);
   uint32_t prev_index_ GUARDED_BY(critsect_);
   std::vector<StoredPacket> stored_packets_ GUARDED_BY(critsect_);
+  // Number of slots |stored_packets_| may grow to as packets are stored.
+  size_t capacity_ GUARDED_BY(critsect_);
+  // Slot of each stored sequence number, at |sequence_number & seq_mask_|.
+  // Holds at least twice as many entries as there are slots, so consecutive
+  // sequence numbers never collide and a lookup is a single probe.
+  std::vector<uint16_t> seq_index_ GUARDED_BY(critsect_);
+  uint16_t seq_mask_ GUARDED_BY(critsect_);
+  // Slot of the most recent packet in each size bucket, used for padding.
+  uint16_t size_index_[kNumSizeBuckets] GUARDED_BY(critsect_);
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RtpPacketHistory);
 };
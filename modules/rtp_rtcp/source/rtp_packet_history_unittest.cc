@@ -11,6 +11,7 @@
 #include "webrtc/modules/rtp_rtcp/source/rtp_packet_history.h"
 
 #include <memory>
+#include <vector>
 
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_packet_to_send.h"
@@ -83,6 +84,124 @@ TEST_F(RtpPacketHistoryTest, GetRtpPacket) {
   EXPECT_EQ(capture_time_ms, packet_out->capture_time_ms());
 }
 
+TEST_F(RtpPacketHistoryTest, TakeAndReturnPacket) {
+  hist_.SetStorePacketsStatus(true, 10);
+  std::unique_ptr<RtpPacketToSend> packet = CreateRtpPacket(kSeqNum);
+  const uint8_t* data = packet->data();
+  hist_.PutRtpPacket(std::move(packet), kAllowRetransmission, false);
+
+  // Taken, not copied: the payload is not shared so writing to it is free.
+  std::unique_ptr<RtpPacketToSend> packet_out =
+      hist_.TakePacketAndSetSendTime(kSeqNum, 0, false);
+  ASSERT_TRUE(packet_out);
+  EXPECT_EQ(data, packet_out->data());
+  EXPECT_FALSE(hist_.HasRtpPacket(kSeqNum));
+  EXPECT_FALSE(hist_.GetBestFittingPacket(packet_out->size()));
+
+  packet_out->SetMarker(true);
+  EXPECT_FALSE(hist_.ReturnPacket(std::move(packet_out)));
+  EXPECT_TRUE(hist_.HasRtpPacket(kSeqNum));
+  packet_out = hist_.GetPacketAndSetSendTime(kSeqNum, 0, true);
+  ASSERT_TRUE(packet_out);
+  EXPECT_TRUE(packet_out->Marker());
+}
+
+TEST_F(RtpPacketHistoryTest, DefersRetransmissionOfTakenPacket) {
+  hist_.SetStorePacketsStatus(true, 10);
+  hist_.PutRtpPacket(CreateRtpPacket(kSeqNum), kAllowRetransmission, false);
+  // Taken out by the pacer for its first transmission.
+  std::unique_ptr<RtpPacketToSend> packet_out =
+      hist_.TakePacketAndSetSendTime(kSeqNum, 0, false);
+  ASSERT_TRUE(packet_out);
+
+  // NACKed meanwhile, both paced and not.
+  std::vector<RtpPacketHistory::RetransmittedPacket> packets;
+  hist_.GetRetransmittable({kSeqNum}, 100, &packets);
+  EXPECT_TRUE(packets.empty());
+  EXPECT_FALSE(hist_.TakePacketAndSetSendTime(kSeqNum, 100, true));
+
+  // Resent once returned, and only once.
+  EXPECT_TRUE(hist_.ReturnPacket(std::move(packet_out)));
+  packet_out = hist_.TakePacketAndSetSendTime(kSeqNum, 0, true);
+  ASSERT_TRUE(packet_out);
+  EXPECT_FALSE(hist_.ReturnPacket(std::move(packet_out)));
+}
+
+TEST_F(RtpPacketHistoryTest, DoesNotDeferRetransmissionTooSoon) {
+  hist_.SetStorePacketsStatus(true, 10);
+  hist_.PutRtpPacket(CreateRtpPacket(kSeqNum), kAllowRetransmission, true);
+  // Taken out for a retransmission, so another one must wait.
+  std::unique_ptr<RtpPacketToSend> packet_out =
+      hist_.TakePacketAndSetSendTime(kSeqNum, 100, true);
+  ASSERT_TRUE(packet_out);
+  fake_clock_.AdvanceTimeMilliseconds(99);
+  EXPECT_FALSE(hist_.TakePacketAndSetSendTime(kSeqNum, 100, true));
+  EXPECT_FALSE(hist_.ReturnPacket(std::move(packet_out)));
+}
+
+TEST_F(RtpPacketHistoryTest, ReturnPacketAfterSlotReused) {
+  hist_.SetStorePacketsStatus(true, 2);
+  hist_.PutRtpPacket(CreateRtpPacket(kSeqNum), kAllowRetransmission, true);
+  std::unique_ptr<RtpPacketToSend> packet_out =
+      hist_.TakePacketAndSetSendTime(kSeqNum, 0, true);
+  ASSERT_TRUE(packet_out);
+
+  // Wraps around, so the slot of the taken packet is overwritten.
+  hist_.PutRtpPacket(CreateRtpPacket(kSeqNum + 1), kAllowRetransmission, true);
+  hist_.PutRtpPacket(CreateRtpPacket(kSeqNum + 2), kAllowRetransmission, true);
+  hist_.ReturnPacket(std::move(packet_out));
+  EXPECT_FALSE(hist_.HasRtpPacket(kSeqNum));
+  EXPECT_TRUE(hist_.HasRtpPacket(kSeqNum + 1));
+  EXPECT_TRUE(hist_.HasRtpPacket(kSeqNum + 2));
+}
+
+TEST_F(RtpPacketHistoryTest, GrowsToRequestedSize) {
+  static const uint16_t kNumberToStore = 100;
+  hist_.SetStorePacketsStatus(true, kNumberToStore);
+  for (uint16_t i = 0; i < kNumberToStore + 1; ++i)
+    hist_.PutRtpPacket(CreateRtpPacket(kSeqNum + i), kAllowRetransmission, true);
+
+  // Only the oldest packet is overwritten once the history is full.
+  EXPECT_FALSE(hist_.HasRtpPacket(kSeqNum));
+  for (uint16_t i = 1; i < kNumberToStore + 1; ++i)
+    EXPECT_TRUE(hist_.HasRtpPacket(kSeqNum + i));
+}
+
+TEST_F(RtpPacketHistoryTest, FindsPacketsAcrossSequenceNumberWrap) {
+  hist_.SetStorePacketsStatus(true, 10);
+  for (uint16_t seq = 0xfffa; seq != 6; ++seq)
+    hist_.PutRtpPacket(CreateRtpPacket(seq), kAllowRetransmission, true);
+
+  // The two oldest packets have been overwritten.
+  EXPECT_FALSE(hist_.HasRtpPacket(0xfffa));
+  EXPECT_FALSE(hist_.HasRtpPacket(0xfffb));
+  for (uint16_t seq = 0xfffc; seq != 6; ++seq)
+    EXPECT_TRUE(hist_.HasRtpPacket(seq)) << seq;
+  EXPECT_FALSE(hist_.HasRtpPacket(6));
+}
+
+TEST_F(RtpPacketHistoryTest, GetBestFittingPacket) {
+  hist_.SetStorePacketsStatus(true, 10);
+  EXPECT_FALSE(hist_.GetBestFittingPacket(500));
+  for (size_t payload_size : {100, 400, 1000}) {
+    std::unique_ptr<RtpPacketToSend> packet = CreateRtpPacket(kSeqNum);
+    packet->AllocatePayload(payload_size);
+    hist_.PutRtpPacket(std::move(packet), kAllowRetransmission, true);
+  }
+
+  std::unique_ptr<RtpPacketToSend> packet = hist_.GetBestFittingPacket(450);
+  ASSERT_TRUE(packet);
+  EXPECT_EQ(400u, packet->payload_size());
+  packet = hist_.GetBestFittingPacket(900);
+  ASSERT_TRUE(packet);
+  EXPECT_EQ(1000u, packet->payload_size());
+  packet = hist_.GetBestFittingPacket(1500);
+  ASSERT_TRUE(packet);
+  EXPECT_EQ(1000u, packet->payload_size());
+  // Too small to be worth sending.
+  EXPECT_FALSE(hist_.GetBestFittingPacket(10));
+}
+
 TEST_F(RtpPacketHistoryTest, NoCaptureTime) {
   hist_.SetStorePacketsStatus(true, 10);
   fake_clock_.AdvanceTimeMilliseconds(1);
@@ -0,0 +1,96 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include "webrtc/common_types.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_header_extension.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_header_extensions.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_packet_received.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_utility.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+constexpr int kNumIterations = 1000000;
+constexpr size_t kPayloadSize = 1000;
+
+// A packet with the extensions most senders use.
+RtpPacketToSend CreatePacket(const RtpHeaderExtensionMap* extensions) {
+  RtpPacketToSend packet(extensions);
+  packet.SetPayloadType(100);
+  packet.SetSequenceNumber(0x1234);
+  packet.SetTimestamp(0x12345678);
+  packet.SetSsrc(0x87654321);
+  FrameMarks frame_marks = {};
+  frame_marks.startOfFrame = true;
+  EXPECT_TRUE(packet.SetExtension<AbsoluteSendTime>(0x123456));
+  EXPECT_TRUE(packet.SetExtension<TransportSequenceNumber>(0x4321));
+  EXPECT_TRUE(packet.SetExtension<FrameMarking>(frame_marks));
+  EXPECT_TRUE(packet.SetExtension<AudioLevel>(true, 0x2a));
+  memset(packet.AllocatePayload(kPayloadSize), 0, kPayloadSize);
+  return packet;
+}
+
+class RtpPacketPerformanceTest : public ::testing::Test {
+ protected:
+  RtpPacketPerformanceTest() {
+    extensions_.Register<AbsoluteSendTime>(3);
+    extensions_.Register<TransportSequenceNumber>(5);
+    extensions_.Register<FrameMarking>(7);
+    extensions_.Register<AudioLevel>(9);
+  }
+
+  RtpHeaderExtensionMap extensions_;
+};
+}  // namespace
+
+// Time to parse the RTP header and the extensions of a received packet, with
+// both parsers.
+TEST_F(RtpPacketPerformanceTest, ParseHeader) {
+  const RtpPacketToSend packet = CreatePacket(&extensions_);
+  Clock* clock = Clock::GetRealTimeClock();
+
+  int64_t start_time_us = clock->TimeInMicroseconds();
+  uint32_t checksum = 0;
+  for (int i = 0; i < kNumIterations; ++i) {
+    RTPHeader header;
+    RtpUtility::RtpHeaderParser parser(packet.data(), packet.size());
+    EXPECT_TRUE(parser.Parse(&header, &extensions_));
+    checksum += header.extension.transportSequenceNumber;
+  }
+  double header_parser_ns =
+      1000.0 * (clock->TimeInMicroseconds() - start_time_us) / kNumIterations;
+  EXPECT_EQ(static_cast<uint32_t>(0x4321 * kNumIterations), checksum);
+
+  RtpPacketReceived received(&extensions_);
+  start_time_us = clock->TimeInMicroseconds();
+  checksum = 0;
+  for (int i = 0; i < kNumIterations; ++i) {
+    EXPECT_TRUE(received.Parse(packet.data(), packet.size()));
+    uint16_t transport_sequence_number = 0;
+    EXPECT_TRUE(received.GetExtension<TransportSequenceNumber>(
+        &transport_sequence_number));
+    checksum += transport_sequence_number;
+  }
+  double packet_ns =
+      1000.0 * (clock->TimeInMicroseconds() - start_time_us) / kNumIterations;
+  EXPECT_EQ(static_cast<uint32_t>(0x4321 * kNumIterations), checksum);
+
+  test::PrintResult("rtp_parse_header", "", "rtp_header_parser",
+                    header_parser_ns, "ns", false);
+  test::PrintResult("rtp_parse_header", "", "rtp_packet_received", packet_ns,
+                    "ns", false);
+}
+
+}  // namespace webrtc
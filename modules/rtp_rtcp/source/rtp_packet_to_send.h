@@ -26,9 +26,15 @@ class RtpPacketToSend : public rtp::Packet {
   // Time in local time base as close as it can to frame capture time.
   int64_t capture_time_ms() const { return capture_time_ms_; }
   void set_capture_time_ms(int64_t time) { capture_time_ms_ = time; }
+  // Time the packet was put in the pacer queue, 0 if it wasn't.
+  int64_t pacer_enqueue_time_ms() const { return pacer_enqueue_time_ms_; }
+  void set_pacer_enqueue_time_ms(int64_t time) {
+    pacer_enqueue_time_ms_ = time;
+  }
 
  private:
   int64_t capture_time_ms_ = 0;
+  int64_t pacer_enqueue_time_ms_ = 0;
 };
 
 }  // namespace webrtc
@@ -132,6 +132,32 @@ TEST(RtpPacketTest, SetReservedExtensionsAfterPayload) {
   EXPECT_TRUE(packet.SetExtension<TransmissionOffset>(kTimeOffset));
 }
 
+// Per packet updates of an extension copied from a header template rewrite it
+// in place.
+TEST(RtpPacketTest, RewriteExtensionOfCopiedHeader) {
+  constexpr uint8_t kFrameMarkingExtensionId = 4;
+  RtpPacketToSend::ExtensionManager extensions;
+  extensions.Register(kRtpExtensionAudioLevel, kAudioLevelExtensionId);
+  extensions.Register(kRtpExtensionFrameMarking, kFrameMarkingExtensionId);
+  RtpPacketToSend header(&extensions);
+  FrameMarks frame_marks = {};
+  ASSERT_TRUE(header.SetExtension<FrameMarking>(frame_marks));
+
+  RtpPacketToSend packet(header);
+  frame_marks.startOfFrame = true;
+  frame_marks.endOfFrame = true;
+  EXPECT_TRUE(packet.SetExtension<FrameMarking>(frame_marks));
+  EXPECT_EQ(header.headers_size(), packet.headers_size());
+  FrameMarks parsed = {};
+  EXPECT_TRUE(packet.GetExtension<FrameMarking>(&parsed));
+  EXPECT_TRUE(parsed.startOfFrame);
+  EXPECT_TRUE(parsed.endOfFrame);
+  EXPECT_TRUE(header.GetExtension<FrameMarking>(&parsed));
+  EXPECT_FALSE(parsed.startOfFrame);
+  EXPECT_FALSE(packet.HasExtension<TransmissionOffset>());
+  EXPECT_FALSE(packet.SetExtension<TransmissionOffset>(kTimeOffset));
+}
+
 TEST(RtpPacketTest, CreatePurePadding) {
   const size_t kPaddingSize = kMaxPaddingSize - 1;
   RtpPacketToSend packet(nullptr, 12 + kPaddingSize);
@@ -162,6 +188,40 @@ TEST(RtpPacketTest, CreateUnalignedPadding) {
   EXPECT_EQ(packet.size(), packet.capacity());
 }
 
+TEST(RtpPacketTest, ExtendPayloadKeepsPayload) {
+  const size_t kExtraSize = 16;
+  RtpPacketToSend packet(nullptr, 12 + sizeof(kPayload) + kExtraSize);
+  packet.SetPayloadType(kPayloadType);
+  packet.SetSequenceNumber(kSeqNum);
+  packet.SetTimestamp(kTimestamp);
+  packet.SetSsrc(kSsrc);
+  uint8_t* payload = packet.AllocatePayload(sizeof(kPayload));
+  memcpy(payload, kPayload, sizeof(kPayload));
+
+  EXPECT_FALSE(packet.ExtendPayload(sizeof(kPayload) + kExtraSize + 1));
+  uint8_t* extended = packet.ExtendPayload(sizeof(kPayload) + kExtraSize);
+  ASSERT_TRUE(extended);
+  EXPECT_EQ(payload, extended);
+  EXPECT_EQ(sizeof(kPayload) + kExtraSize, packet.payload_size());
+  EXPECT_EQ(packet.size(), packet.capacity());
+  EXPECT_THAT(make_tuple(packet.payload().data(), sizeof(kPayload)),
+              ElementsAreArray(kPayload));
+}
+
+TEST(RtpPacketTest, ExtendPayloadOfSharedBuffer) {
+  RtpPacketToSend packet(nullptr);
+  packet.SetSsrc(kSsrc);
+  uint8_t* payload = packet.AllocatePayload(sizeof(kPayload));
+  memcpy(payload, kPayload, sizeof(kPayload));
+  rtc::CopyOnWriteBuffer shared = packet.Buffer();
+
+  ASSERT_TRUE(packet.ExtendPayload(2 * sizeof(kPayload)));
+  EXPECT_NE(shared.cdata(), packet.data());
+  EXPECT_EQ(12 + sizeof(kPayload), shared.size());
+  EXPECT_THAT(make_tuple(packet.payload().data(), sizeof(kPayload)),
+              ElementsAreArray(kPayload));
+}
+
 TEST(RtpPacketTest, ParseMinimum) {
   RtpPacketReceived packet;
   EXPECT_TRUE(packet.Parse(kMinimumPacket, sizeof(kMinimumPacket)));
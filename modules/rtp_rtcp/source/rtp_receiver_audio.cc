@@ -314,8 +314,10 @@ int32_t RTPReceiverAudio::ParseAudioCodecSpecific(
   }
   
   if (is_double_enabled) {
-    if (!media_crypto->Decrypt((uint8_t*)payload_data, &payload_length))
+    uint8_t* decrypted = (uint8_t*)payload_data;
+    if (!media_crypto->DecryptInPlace(&decrypted, &payload_length))
       return -1;
+    payload_data = decrypted;
   }
     
   rtp_header->type.Audio.channel = audio_specific.channels;
@@ -19,6 +19,7 @@
 #include "webrtc/common_types.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_payload_registry.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "webrtc/modules/rtp_rtcp/source/media_crypto_cipher.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_receiver_strategy.h"
 
 namespace webrtc {
@@ -69,7 +70,11 @@ RtpReceiverImpl::RtpReceiverImpl(
       current_remote_csrc_(),
       last_received_timestamp_(0),
       last_received_frame_time_ms_(-1),
-      last_received_sequence_number_(0) {
+      last_received_sequence_number_(0),
+      media_crypto_enabled_(false),
+      media_crypto_bytes_copied_(0),
+      decrypt_base_layer_only_(false),
+      decrypted_packets_(MediaCryptoCipher::kDefaultReplayWindowSize) {
   assert(incoming_messages_callback);
 
   memset(current_remote_csrc_, 0, sizeof(current_remote_csrc_));
@@ -163,8 +168,21 @@ bool RtpReceiverImpl::IncomingRtpPacket(
   size_t payload_data_length = payload_length - rtp_header.paddingLength;
 
   bool is_first_packet_in_frame = false;
+  bool skip_payload = false;
+  bool decrypt = false;
   {
     rtc::CritScope lock(&critical_section_rtp_receiver_);
+    skip_payload = media_crypto_enabled_ && decrypt_base_layer_only_ &&
+                   rtp_header.extension.hasFrameMarks &&
+                   rtp_header.extension.frameMarks.temporalLayerId > 0;
+    decrypt = media_crypto_enabled_ && !skip_payload && payload_data_length > 0;
+    // The depacketizer already has what a duplicate brings, and the cipher
+    // would only reject it as a replay after taking the context lock.
+    if (decrypt &&
+        decrypted_packets_.Contains(decrypted_unwrapper_.UnwrapWithoutUpdate(
+            rtp_header.sequenceNumber))) {
+      return true;
+    }
     if (HaveReceivedFrame()) {
       is_first_packet_in_frame =
           last_received_sequence_number_ + 1 == rtp_header.sequenceNumber &&
@@ -174,8 +192,11 @@ bool RtpReceiverImpl::IncomingRtpPacket(
     }
   }
 
+  // A payload-less packet still advances the sequence numbers downstream, so
+  // it is neither NACKed nor seen as a gap.
   int32_t ret_val = rtp_media_receiver_->ParseRtpPacket(
-      &webrtc_rtp_header, payload_specific, is_red, payload, payload_data_length,
+      &webrtc_rtp_header, payload_specific, is_red,
+      skip_payload ? nullptr : payload, payload_data_length,
       clock_->TimeInMilliseconds(), is_first_packet_in_frame,
       media_crypto_enabled_, &media_crypto_);
 
@@ -188,6 +209,11 @@ bool RtpReceiverImpl::IncomingRtpPacket(
 
     last_receive_time_ = clock_->TimeInMilliseconds();
     last_received_payload_length_ = payload_data_length;
+    media_crypto_bytes_copied_ = media_crypto_.bytes_copied();
+    if (decrypt) {
+      decrypted_packets_.Add(
+          decrypted_unwrapper_.Unwrap(rtp_header.sequenceNumber));
+    }
 
     if (in_order) {
       if (last_received_timestamp_ != rtp_header.timestamp) {
@@ -245,6 +271,9 @@ void RtpReceiverImpl::CheckSSRCChanged(const RTPHeader& rtp_header) {
       last_received_timestamp_ = 0;
       last_received_sequence_number_ = 0;
       last_received_frame_time_ms_ = -1;
+      decrypted_unwrapper_ = SequenceNumberUnwrapper();
+      decrypted_packets_ =
+          MediaCryptoReplayWindow(MediaCryptoCipher::kDefaultReplayWindowSize);
 
       // Do we have a SSRC? Then the stream is restarted.
       if (ssrc_ != 0) {
@@ -470,4 +499,45 @@ bool RtpReceiverImpl::EnableMediaCrypto(const MediaCryptoKey &key) {
   media_crypto_enabled_ = media_crypto_.SetInboundKey(key);
   return  media_crypto_enabled_;
 }
+
+bool RtpReceiverImpl::EnableMediaCrypto(MediaCryptoContext* context) {
+  LOG(LS_INFO) << "Enabling End to End Media Encription with shared context";
+
+  rtc::CritScope cs(&critical_section_rtp_receiver_);
+  media_crypto_enabled_ = media_crypto_.SetInboundContext(context);
+  return media_crypto_enabled_;
+}
+
+bool RtpReceiverImpl::PrewarmMediaCrypto() {
+  rtc::CritScope cs(&critical_section_rtp_receiver_);
+  return media_crypto_enabled_ && media_crypto_.Prewarm();
+}
+
+bool RtpReceiverImpl::UpdateMediaCryptoKey(const MediaCryptoKey& key) {
+  rtc::CritScope cs(&critical_section_rtp_receiver_);
+  return media_crypto_enabled_ && media_crypto_.UpdateKey(key);
+}
+
+size_t RtpReceiverImpl::MediaCryptoBytesCopied() const {
+  rtc::CritScope lock(&critical_section_rtp_receiver_);
+  return media_crypto_bytes_copied_;
+}
+
+const char* RtpReceiverImpl::MediaCryptoCipherName() const {
+  rtc::CritScope lock(&critical_section_rtp_receiver_);
+  return media_crypto_.cipher_name();
+}
+
+bool RtpReceiverImpl::GetMediaCryptoStats(MediaCryptoStats* stats) const {
+  rtc::CritScope lock(&critical_section_rtp_receiver_);
+  if (!media_crypto_enabled_)
+    return false;
+  *stats = media_crypto_.stats();
+  return true;
+}
+
+void RtpReceiverImpl::SetDecryptBaseLayerOnly(bool base_layer_only) {
+  rtc::CritScope lock(&critical_section_rtp_receiver_);
+  decrypt_base_layer_only_ = base_layer_only;
+}
 }  // namespace webrtc
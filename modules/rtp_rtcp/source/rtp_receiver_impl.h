@@ -16,7 +16,9 @@
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_receiver.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/modules/rtp_rtcp/source/media_crypto.h"
+#include "webrtc/modules/rtp_rtcp/source/media_crypto_replay_window.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_receiver_strategy.h"
 #include "webrtc/typedefs.h"
 
@@ -59,6 +61,13 @@ class RtpReceiverImpl : public RtpReceiver {
   
   // End to end media encryption
   bool EnableMediaCrypto(const MediaCryptoKey &key) override;
+  bool EnableMediaCrypto(MediaCryptoContext* context) override;
+  bool PrewarmMediaCrypto() override;
+  bool UpdateMediaCryptoKey(const MediaCryptoKey& key) override;
+  size_t MediaCryptoBytesCopied() const override;
+  const char* MediaCryptoCipherName() const override;
+  bool GetMediaCryptoStats(MediaCryptoStats* stats) const override;
+  void SetDecryptBaseLayerOnly(bool base_layer_only) override;
 
  private:
   bool HaveReceivedFrame() const;
@@ -92,6 +101,15 @@ class RtpReceiverImpl : public RtpReceiver {
   // Double PERC encryption
   bool media_crypto_enabled_;
   MediaCrypto media_crypto_;
+  // Copy of media_crypto_.bytes_copied() guarded by
+  // critical_section_rtp_receiver_, so it can be read from any thread.
+  size_t media_crypto_bytes_copied_;
+  bool decrypt_base_layer_only_;
+  // The sequence numbers already decrypted, so the copies of a packet
+  // recovered by FEC or retransmitted after it arrived are dropped before
+  // reaching the cipher.
+  SequenceNumberUnwrapper decrypted_unwrapper_;
+  MediaCryptoReplayWindow decrypted_packets_;
 };
 }  // namespace webrtc
 #endif  // WEBRTC_MODULES_RTP_RTCP_SOURCE_RTP_RECEIVER_IMPL_H_
@@ -17,6 +17,7 @@
 
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/base/packet_trace.h"
 #include "webrtc/base/trace_event.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_cvo.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_payload_registry.h"
@@ -77,16 +78,22 @@ int32_t RTPReceiverVideo::ParseRtpPacket(WebRtcRTPHeader* rtp_header,
   }
 
   // We are not allowed to hold a critical section when calling below functions.
-  std::unique_ptr<RtpDepacketizer> depacketizer(
-      RtpDepacketizer::Create(rtp_header->type.Video.codec));
-  if (depacketizer.get() == NULL) {
+  RtpDepacketizer* depacketizer =
+      GetDepacketizer(rtp_header->type.Video.codec);
+  if (depacketizer == NULL) {
     LOG(LS_ERROR) << "Failed to create depacketizer.";
     return -1;
   }
   
   if (is_double_enabled) {
-    if (!media_crypto->Decrypt((uint8_t*)payload, &payload_data_length))
+    // Decrypt in place and hand the plaintext to the depacketizer as is.
+    uint8_t* decrypted = (uint8_t*)payload;
+    if (!media_crypto->DecryptInPlace(&decrypted, &payload_data_length))
       return -1;
+    payload = decrypted;
+    rtc::packet_trace::Record(rtc::packet_trace::Stage::kMediaDecrypted,
+                              rtp_header->header.ssrc,
+                              rtp_header->header.sequenceNumber);
   }
 
   rtp_header->type.Video.is_first_packet_in_frame = is_first_packet;
@@ -114,6 +121,14 @@ int32_t RTPReceiverVideo::ParseRtpPacket(WebRtcRTPHeader* rtp_header,
              : -1;
 }
 
+RtpDepacketizer* RTPReceiverVideo::GetDepacketizer(RtpVideoCodecTypes codec) {
+  RTC_DCHECK_LE(codec, kRtpVideoH264);
+  std::unique_ptr<RtpDepacketizer>& depacketizer = depacketizers_[codec];
+  if (!depacketizer)
+    depacketizer.reset(RtpDepacketizer::Create(codec));
+  return depacketizer.get();
+}
+
 RTPAliveType RTPReceiverVideo::ProcessDeadOrAlive(
     uint16_t last_payload_length) const {
   return kRtpDead;
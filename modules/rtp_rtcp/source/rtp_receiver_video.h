@@ -11,8 +11,11 @@
 #ifndef WEBRTC_MODULES_RTP_RTCP_SOURCE_RTP_RECEIVER_VIDEO_H_
 #define WEBRTC_MODULES_RTP_RTCP_SOURCE_RTP_RECEIVER_VIDEO_H_
 
+#include <memory>
+
 #include "webrtc/base/onetimeevent.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_format.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_receiver_strategy.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_utility.h"
 #include "webrtc/typedefs.h"
@@ -52,7 +55,13 @@ class RTPReceiverVideo : public RTPReceiverStrategy {
   void SetPacketOverHead(uint16_t packet_over_head);
 
  private:
+  // Returns the depacketizer for |codec|, created on first use.
+  RtpDepacketizer* GetDepacketizer(RtpVideoCodecTypes codec);
+
   OneTimeEvent first_packet_received_;
+  // Depacketizers only depend on the codec and keep no state across packets,
+  // so one per codec serves all the payload types mapped to it.
+  std::unique_ptr<RtpDepacketizer> depacketizers_[kRtpVideoH264 + 1];
 };
 }  // namespace webrtc
 
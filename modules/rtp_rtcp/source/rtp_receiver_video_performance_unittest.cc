@@ -0,0 +1,153 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/common_types.h"
+#include "webrtc/modules/rtp_rtcp/include/rtp_payload_registry.h"
+#include "webrtc/modules/rtp_rtcp/include/rtp_receiver.h"
+#include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_format.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr size_t kNumStreams = 320;
+constexpr size_t kPacketsPerStream = 200;
+constexpr size_t kPayloadSize = 1100;
+constexpr int8_t kPayloadType = 100;
+constexpr uint32_t kFirstSsrc = 1000;
+// VP8 payload descriptor with only the start of partition bit set.
+constexpr uint8_t kVp8Descriptor = 0x10;
+
+class CountingRtpData : public NullRtpData {
+ public:
+  CountingRtpData() : packets_(0) {}
+
+  int32_t OnReceivedPayloadData(const uint8_t* payload_data,
+                                size_t payload_size,
+                                const WebRtcRTPHeader* rtp_header) override {
+    ++packets_;
+    return 0;
+  }
+
+  size_t packets() const { return packets_; }
+
+ private:
+  size_t packets_;
+};
+
+class Stream {
+ public:
+  Stream(Clock* clock, RtpData* data_callback, uint32_t ssrc)
+      : ssrc_(ssrc),
+        rtp_receiver_(RtpReceiver::CreateVideoReceiver(
+            clock, data_callback, &rtp_feedback_, &rtp_payload_registry_)) {
+    VideoCodec video_codec;
+    memset(&video_codec, 0, sizeof(video_codec));
+    video_codec.codecType = kVideoCodecVP8;
+    video_codec.plType = kPayloadType;
+    strncpy(video_codec.plName, "VP8", RTP_PAYLOAD_NAME_SIZE);
+    EXPECT_EQ(0, rtp_receiver_->RegisterReceivePayload(video_codec));
+    EXPECT_TRUE(rtp_payload_registry_.GetPayloadSpecifics(kPayloadType,
+                                                          &payload_specific_));
+  }
+
+  bool ReceivePacket(uint16_t sequence_number, const uint8_t* payload) {
+    RTPHeader header;
+    header.payloadType = kPayloadType;
+    header.sequenceNumber = sequence_number;
+    header.timestamp = (sequence_number / 10) * 3000;
+    header.ssrc = ssrc_;
+    header.headerLength = 12;
+    header.markerBit = sequence_number % 10 == 9;
+    return rtp_receiver_->IncomingRtpPacket(header, payload, kPayloadSize,
+                                            payload_specific_, true);
+  }
+
+ private:
+  const uint32_t ssrc_;
+  NullRtpFeedback rtp_feedback_;
+  RTPPayloadRegistry rtp_payload_registry_;
+  std::unique_ptr<RtpReceiver> rtp_receiver_;
+  PayloadUnion payload_specific_;
+};
+
+std::vector<uint8_t> CreateVp8Payload() {
+  std::vector<uint8_t> payload(kPayloadSize, 0);
+  payload[0] = kVp8Descriptor;
+  return payload;
+}
+
+}  // namespace
+
+// Packets interleaved across many receive streams, as on a conference server.
+TEST(RtpReceiverVideoPerformanceTest, ManyStreams) {
+  SimulatedClock fake_clock(123456);
+  CountingRtpData data_callback;
+  std::vector<std::unique_ptr<Stream>> streams;
+  for (size_t i = 0; i < kNumStreams; ++i)
+    streams.emplace_back(new Stream(&fake_clock, &data_callback,
+                                    kFirstSsrc + i));
+  const std::vector<uint8_t> payload = CreateVp8Payload();
+
+  Clock* clock = Clock::GetRealTimeClock();
+  int64_t start_time_us = clock->TimeInMicroseconds();
+  for (size_t seq = 0; seq < kPacketsPerStream; ++seq) {
+    for (const auto& stream : streams)
+      EXPECT_TRUE(stream->ReceivePacket(seq, payload.data()));
+  }
+  int64_t elapsed_us = clock->TimeInMicroseconds() - start_time_us;
+  EXPECT_EQ(kNumStreams * kPacketsPerStream, data_callback.packets());
+
+  test::PrintResult("rtp_receiver_video_many_streams", "", "packet_rate",
+                    1e6 * data_callback.packets() / elapsed_us, "packets/s",
+                    false);
+}
+
+// Depacketizing with a depacketizer created per packet, as RTPReceiverVideo
+// used to, against reusing one.
+TEST(RtpReceiverVideoPerformanceTest, DepacketizerReuse) {
+  const size_t kNumPackets = kNumStreams * kPacketsPerStream;
+  const std::vector<uint8_t> payload = CreateVp8Payload();
+  RtpDepacketizer::ParsedPayload parsed_payload;
+  Clock* clock = Clock::GetRealTimeClock();
+
+  int64_t start_time_us = clock->TimeInMicroseconds();
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    std::unique_ptr<RtpDepacketizer> depacketizer(
+        RtpDepacketizer::Create(kRtpVideoVp8));
+    EXPECT_TRUE(
+        depacketizer->Parse(&parsed_payload, payload.data(), payload.size()));
+  }
+  int64_t create_us = clock->TimeInMicroseconds() - start_time_us;
+
+  std::unique_ptr<RtpDepacketizer> depacketizer(
+      RtpDepacketizer::Create(kRtpVideoVp8));
+  start_time_us = clock->TimeInMicroseconds();
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    EXPECT_TRUE(
+        depacketizer->Parse(&parsed_payload, payload.data(), payload.size()));
+  }
+  int64_t reuse_us = clock->TimeInMicroseconds() - start_time_us;
+
+  test::PrintResult("rtp_depacketizer_vp8", "", "create_per_packet",
+                    1e6 * kNumPackets / create_us, "packets/s", false);
+  test::PrintResult("rtp_depacketizer_vp8", "", "reused",
+                    1e6 * kNumPackets / reuse_us, "packets/s", false);
+}
+
+}  // namespace webrtc
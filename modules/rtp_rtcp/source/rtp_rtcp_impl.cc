@@ -130,8 +130,16 @@ ModuleRtpRtcpImpl::ModuleRtpRtcpImpl(const Configuration& configuration)
   SetMaxRtpPacketSize(IP_PACKET_SIZE - kTcpOverIpv4HeaderSize);
   
   // Check if e2e media encryption key is set to enable it
-  if (configuration.media_crypto_enabled)
-    rtp_sender_.EnableMediaCrypto(*configuration.media_crypto_key);
+  if (configuration.media_crypto_enabled) {
+    if (configuration.media_crypto_context)
+      rtp_sender_.EnableMediaCrypto(configuration.media_crypto_context);
+    else
+      rtp_sender_.EnableMediaCrypto(*configuration.media_crypto_key);
+    if (configuration.media_crypto_prewarm)
+      rtp_sender_.PrewarmMediaCrypto();
+    rtp_sender_.SetMediaCryptoWorkerPool(
+        configuration.media_crypto_worker_pool);
+  }
 }
 
 // Returns the number of milliseconds until the module want a worker thread
@@ -564,6 +572,10 @@ void ModuleRtpRtcpImpl::GetSendStreamDataCounters(
   rtp_sender_.GetDataCounters(rtp_counters, rtx_counters);
 }
 
+bool ModuleRtpRtcpImpl::GetMediaCryptoStats(MediaCryptoStats* stats) const {
+  return rtp_sender_.GetMediaCryptoStats(stats);
+}
+
 void ModuleRtpRtcpImpl::GetRtpPacketLossStats(
     bool outgoing,
     uint32_t ssrc,
@@ -180,6 +180,8 @@ class ModuleRtpRtcpImpl : public RtpRtcp, public RTCPReceiver::ModuleRtpRtcp {
       StreamDataCounters* rtp_counters,
       StreamDataCounters* rtx_counters) const override;
 
+  bool GetMediaCryptoStats(MediaCryptoStats* stats) const override;
+
   void GetRtpPacketLossStats(
       bool outgoing,
       uint32_t ssrc,
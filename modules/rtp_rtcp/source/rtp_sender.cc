@@ -15,6 +15,7 @@
 
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/base/packet_trace.h"
 #include "webrtc/base/rate_limiter.h"
 #include "webrtc/base/trace_event.h"
 #include "webrtc/base/timeutils.h"
@@ -123,8 +124,15 @@ RTPSender::RTPSender(
       csrcs_(),
       rtx_(kRtxOff),
       rtp_overhead_bytes_per_packet_(0),
+      padding_packet_has_transmission_offset_(false),
+      padding_packet_version_(0),
       retransmission_rate_limiter_(retransmission_rate_limiter),
-      overhead_observer_(overhead_observer) {
+      overhead_observer_(overhead_observer),
+      send_side_bwe_with_overhead_(
+          webrtc::field_trial::FindFullName(
+              "WebRTC-SendSideBwe-WithOverhead") == "Enabled"),
+      media_crypto_enabled_(false),
+      media_crypto_worker_pool_(nullptr) {
   ssrc_ = ssrc_db_->CreateSSRC();
   RTC_DCHECK(ssrc_ != 0);
   ssrc_rtx_ = ssrc_db_->CreateSSRC();
@@ -154,6 +162,11 @@ RTPSender::~RTPSender() {
   // variables but we grab them in all other methods. (what's the design?)
   // Start documenting what thread we're on in what method so that it's easier
   // to understand performance attributes and possibly remove locks.
+
+  // Frames may still be pending encryption on the worker pool.
+  if (media_crypto_worker_pool_)
+    media_crypto_worker_pool_->Flush();
+
   if (remote_ssrc_ != 0) {
     ssrc_db_->ReturnSSRC(remote_ssrc_);
   }
@@ -205,6 +218,7 @@ int32_t RTPSender::RegisterRtpHeaderExtension(RTPExtensionType type,
     case kRtpExtensionAudioLevel:
     case kRtpExtensionTransportSequenceNumber:
     case kRtpExtensionFrameMarking:
+      ResetPaddingPacket();
       return rtp_header_extension_map_.Register(type, id);
     case kRtpExtensionNone:
     case kRtpExtensionNumberOfExtensions:
@@ -221,6 +235,7 @@ bool RTPSender::IsRtpHeaderExtensionRegistered(RTPExtensionType type) {
 
 int32_t RTPSender::DeregisterRtpHeaderExtension(RTPExtensionType type) {
   rtc::CritScope lock(&send_critsect_);
+  ResetPaddingPacket();
   return rtp_header_extension_map_.Deregister(type);
 }
 
@@ -472,7 +487,7 @@ size_t RTPSender::TrySendRedundantPayloads(size_t bytes_to_send,
     if (!packet)
       break;
     size_t payload_size = packet->payload_size();
-    if (!PrepareAndSendPacket(std::move(packet), true, false, probe_cluster_id))
+    if (!PrepareAndSendPacket(packet.get(), true, false, probe_cluster_id))
       break;
     bytes_left -= payload_size;
   }
@@ -494,6 +509,8 @@ size_t RTPSender::SendPadData(size_t bytes, int probe_cluster_id) {
     uint16_t sequence_number;
     int payload_type;
     bool over_rtx;
+    std::unique_ptr<RtpPacketToSend> padding_packet;
+    uint32_t padding_packet_version;
     {
       rtc::CritScope lock(&send_critsect_);
       if (!sending_media_)
@@ -534,40 +551,85 @@ size_t RTPSender::SendPadData(size_t bytes, int probe_cluster_id) {
         payload_type = rtx_payload_type_map_.begin()->second;
         over_rtx = true;
       }
+      padding_packet = TakePaddingPacket(
+          ssrc, payload_type, capture_time_ms > 0, padding_bytes_in_packet,
+          &padding_packet_version);
     }
 
-    RtpPacketToSend padding_packet(&rtp_header_extension_map_);
-    padding_packet.SetPayloadType(payload_type);
-    padding_packet.SetMarker(false);
-    padding_packet.SetSequenceNumber(sequence_number);
-    padding_packet.SetTimestamp(timestamp);
-    padding_packet.SetSsrc(ssrc);
-
+    padding_packet->SetSequenceNumber(sequence_number);
+    padding_packet->SetTimestamp(timestamp);
     if (capture_time_ms > 0) {
-      padding_packet.SetExtension<TransmissionOffset>(
+      padding_packet->SetExtension<TransmissionOffset>(
           (now_ms - capture_time_ms) * kTimestampTicksPerMs);
     }
-    padding_packet.SetExtension<AbsoluteSendTime>(now_ms);
+    padding_packet->SetExtension<AbsoluteSendTime>(now_ms);
     PacketOptions options;
     bool has_transport_seq_num =
-        UpdateTransportSequenceNumber(&padding_packet, &options.packet_id);
-    padding_packet.SetPadding(padding_bytes_in_packet, &random_);
+        UpdateTransportSequenceNumber(padding_packet.get(), &options.packet_id);
 
     if (has_transport_seq_num) {
-      AddPacketToTransportFeedback(options.packet_id, padding_packet,
+      AddPacketToTransportFeedback(options.packet_id, *padding_packet,
                                    probe_cluster_id);
     }
 
-    if (!SendPacketToNetwork(padding_packet, options))
+    if (!SendPacketToNetwork(*padding_packet, options))
       break;
 
     bytes_sent += padding_bytes_in_packet;
-    UpdateRtpStats(padding_packet, over_rtx, false);
+    UpdateRtpStats(*padding_packet, over_rtx, false);
+    ReturnPaddingPacket(std::move(padding_packet), padding_packet_version);
   }
 
   return bytes_sent;
 }
 
+std::unique_ptr<RtpPacketToSend> RTPSender::TakePaddingPacket(
+    uint32_t ssrc,
+    int payload_type,
+    bool with_transmission_offset,
+    size_t padding_bytes,
+    uint32_t* version) {
+  if (!padding_packet_ || padding_packet_->Ssrc() != ssrc ||
+      padding_packet_->PayloadType() != payload_type ||
+      padding_packet_has_transmission_offset_ != with_transmission_offset ||
+      padding_packet_->padding_size() != padding_bytes) {
+    ResetPaddingPacket();
+    padding_packet_.reset(new RtpPacketToSend(&rtp_header_extension_map_));
+    padding_packet_->SetPayloadType(payload_type);
+    padding_packet_->SetMarker(false);
+    padding_packet_->SetSsrc(ssrc);
+    // Same order as the extensions are set when sending.
+    padding_packet_has_transmission_offset_ = with_transmission_offset;
+    if (with_transmission_offset)
+      padding_packet_->ReserveExtension<TransmissionOffset>();
+    padding_packet_->ReserveExtension<AbsoluteSendTime>();
+    if (transport_sequence_number_allocator_)
+      padding_packet_->ReserveExtension<TransportSequenceNumber>();
+    padding_packet_->SetPadding(padding_bytes, &random_);
+  }
+  *version = padding_packet_version_;
+  // A spare packet already owns its buffer, so writing the per packet fields
+  // does not copy it again.
+  if (spare_padding_packet_)
+    return std::move(spare_padding_packet_);
+  // The copy shares the buffer until the first field is written.
+  return std::unique_ptr<RtpPacketToSend>(
+      new RtpPacketToSend(*padding_packet_));
+}
+
+void RTPSender::ReturnPaddingPacket(std::unique_ptr<RtpPacketToSend> packet,
+                                    uint32_t version) {
+  rtc::CritScope lock(&send_critsect_);
+  if (padding_packet_ && version == padding_packet_version_)
+    spare_padding_packet_ = std::move(packet);
+}
+
+void RTPSender::ResetPaddingPacket() {
+  padding_packet_.reset();
+  spare_padding_packet_.reset();
+  ++padding_packet_version_;
+}
+
 void RTPSender::SetStorePacketsStatus(bool enable, uint16_t number_to_store) {
   packet_history_.SetStorePacketsStatus(enable, number_to_store);
 }
@@ -577,37 +639,45 @@ bool RTPSender::StorePackets() const {
 }
 
 int32_t RTPSender::ReSendPacket(uint16_t packet_id, int64_t min_resend_time) {
+  // Taken out of the history rather than copied, it goes back once done with.
   std::unique_ptr<RtpPacketToSend> packet =
-      packet_history_.GetPacketAndSetSendTime(packet_id, min_resend_time, true);
+      packet_history_.TakePacketAndSetSendTime(packet_id, min_resend_time,
+                                               true);
   if (!packet) {
     // Packet not found.
     return 0;
   }
+  int32_t packet_size = static_cast<int32_t>(packet->size());
 
   // Check if we're overusing retransmission bitrate.
   // TODO(sprang): Add histograms for nack success or failure reasons.
   RTC_DCHECK(retransmission_rate_limiter_);
-  if (!retransmission_rate_limiter_->TryUseRate(packet->size()))
+  if (!retransmission_rate_limiter_->TryUseRate(packet->size())) {
+    packet_history_.ReturnPacket(std::move(packet));
     return -1;
+  }
 
   if (paced_sender_) {
     // Convert from TickTime to Clock since capture_time_ms is based on
     // TickTime.
     int64_t corrected_capture_tims_ms =
         packet->capture_time_ms() + clock_delta_ms_;
-    paced_sender_->InsertPacket(RtpPacketSender::kNormalPriority,
-                                packet->Ssrc(), packet->SequenceNumber(),
-                                corrected_capture_tims_ms,
-                                packet->payload_size(), true);
+    uint32_t ssrc = packet->Ssrc();
+    uint16_t sequence_number = packet->SequenceNumber();
+    size_t payload_size = packet->payload_size();
+    // Back in the history before the pacer can ask for it.
+    packet_history_.ReturnPacket(std::move(packet));
+    paced_sender_->InsertPacket(RtpPacketSender::kNormalPriority, ssrc,
+                                sequence_number, corrected_capture_tims_ms,
+                                payload_size, true);
 
-    return packet->size();
+    return packet_size;
   }
   bool rtx = (RtxStatus() & kRtxRetransmitted) > 0;
-  int32_t packet_size = static_cast<int32_t>(packet->size());
-  if (!PrepareAndSendPacket(std::move(packet), rtx, true,
-                            PacketInfo::kNotAProbe))
-    return -1;
-  return packet_size;
+  bool sent =
+      PrepareAndSendPacket(packet.get(), rtx, true, PacketInfo::kNotAProbe);
+  packet_history_.ReturnPacket(std::move(packet));
+  return sent ? packet_size : -1;
 }
 
 bool RTPSender::SendPacketToNetwork(const RtpPacketToSend& packet,
@@ -653,6 +723,10 @@ void RTPSender::OnReceivedNack(
   TRACE_EVENT2(TRACE_DISABLED_BY_DEFAULT("webrtc_rtp"),
                "RTPSender::OnReceivedNACK", "num_seqnum",
                nack_sequence_numbers.size(), "avg_rtt", avg_rtt);
+  if (paced_sender_) {
+    ReSendPacketsPaced(nack_sequence_numbers, 5 + avg_rtt);
+    return;
+  }
   for (uint16_t seq_no : nack_sequence_numbers) {
     const int32_t bytes_sent = ReSendPacket(seq_no, 5 + avg_rtt);
     if (bytes_sent < 0) {
@@ -664,6 +738,54 @@ void RTPSender::OnReceivedNack(
   }
 }
 
+void RTPSender::ReSendPacketsPaced(
+    const std::vector<uint16_t>& sequence_numbers,
+    int64_t min_resend_time) {
+  std::vector<RtpPacketHistory::RetransmittedPacket> packets;
+  packets.reserve(sequence_numbers.size());
+  packet_history_.GetRetransmittable(sequence_numbers, min_resend_time,
+                                     &packets);
+  if (packets.empty())
+    return;
+
+  // Check if we're overusing retransmission bitrate. If the whole NACK does
+  // not fit, resend the packets that do, in order, as one by one would.
+  RTC_DCHECK(retransmission_rate_limiter_);
+  size_t total_size = 0;
+  for (const RtpPacketHistory::RetransmittedPacket& packet : packets)
+    total_size += packet.size;
+  size_t num_packets = packets.size();
+  if (!retransmission_rate_limiter_->TryUseRate(total_size)) {
+    for (num_packets = 0; num_packets < packets.size(); ++num_packets) {
+      size_t size = packets[num_packets].size;
+      if (!retransmission_rate_limiter_->TryUseRate(size)) {
+        LOG(LS_WARNING) << "Failed resending RTP packet "
+                        << packets[num_packets].sequence_number
+                        << ", Discard rest of packets";
+        break;
+      }
+    }
+    // Only the packets queued count as retransmitted, so the rest are
+    // resent on the next NACK rather than held back by |min_resend_time|.
+    packets.resize(num_packets);
+    if (packets.empty())
+      return;
+  }
+  packet_history_.SetRetransmitted(packets);
+
+  std::vector<RtpPacketSender::PacketToInsert> to_insert;
+  to_insert.reserve(num_packets);
+  for (size_t i = 0; i < num_packets; ++i) {
+    // Convert from TickTime to Clock since capture_time_ms is based on
+    // TickTime.
+    to_insert.push_back({packets[i].ssrc, packets[i].sequence_number,
+                         packets[i].capture_time_ms + clock_delta_ms_,
+                         packets[i].payload_size});
+  }
+  paced_sender_->InsertPackets(RtpPacketSender::kNormalPriority, to_insert,
+                               true);
+}
+
 void RTPSender::OnReceivedRtcpReportBlocks(
     const ReportBlockList& report_blocks) {
   playout_delay_oracle_.OnReceivedRtcpReportBlocks(report_blocks);
@@ -678,33 +800,43 @@ bool RTPSender::TimeToSendPacket(uint32_t ssrc,
   if (!SendingMedia())
     return true;
 
-  std::unique_ptr<RtpPacketToSend> packet;
+  RtpPacketHistory* history = nullptr;
   if (ssrc == SSRC()) {
-    packet = packet_history_.GetPacketAndSetSendTime(sequence_number, 0,
-                                                     retransmission);
+    history = &packet_history_;
   } else if (ssrc == FlexfecSsrc()) {
-    packet = flexfec_packet_history_.GetPacketAndSetSendTime(sequence_number, 0,
-                                                             retransmission);
+    history = &flexfec_packet_history_;
   }
 
+  // The packet is updated and sent in place, without a copy, then returned to
+  // the history for later retransmissions.
+  std::unique_ptr<RtpPacketToSend> packet =
+      history ? history->TakePacketAndSetSendTime(sequence_number, 0,
+                                                  retransmission)
+              : nullptr;
   if (!packet) {
     // Packet cannot be found.
     return true;
   }
-
-  return PrepareAndSendPacket(
-      std::move(packet),
-      retransmission && (RtxStatus() & kRtxRetransmitted) > 0, retransmission,
-      probe_cluster_id);
+  rtc::packet_trace::Record(rtc::packet_trace::Stage::kPacerDequeued, ssrc,
+                            sequence_number);
+
+  bool sent = PrepareAndSendPacket(
+      packet.get(), retransmission && (RtxStatus() & kRtxRetransmitted) > 0,
+      retransmission, probe_cluster_id);
+  if (history->ReturnPacket(std::move(packet))) {
+    // NACKed while it was out of the history, resend it now that it is back.
+    ReSendPacket(sequence_number, 0);
+  }
+  return sent;
 }
 
-bool RTPSender::PrepareAndSendPacket(std::unique_ptr<RtpPacketToSend> packet,
+bool RTPSender::PrepareAndSendPacket(RtpPacketToSend* packet,
                                      bool send_over_rtx,
                                      bool is_retransmit,
                                      int probe_cluster_id) {
   RTC_DCHECK(packet);
   int64_t capture_time_ms = packet->capture_time_ms();
-  RtpPacketToSend* packet_to_send = packet.get();
+  RtpPacketToSend* packet_to_send = packet;
 
   if (!is_retransmit && packet->Marker()) {
     TRACE_EVENT_ASYNC_END0(TRACE_DISABLED_BY_DEFAULT("webrtc_rtp"), "PacedSend",
@@ -739,6 +871,10 @@ bool RTPSender::PrepareAndSendPacket(std::unique_ptr<RtpPacketToSend> packet,
     UpdateDelayStatistics(packet->capture_time_ms(), now_ms);
     UpdateOnSendPacket(options.packet_id, packet->capture_time_ms(),
                        packet->Ssrc());
+    if (send_packet_observer_ && packet->pacer_enqueue_time_ms() > 0) {
+      send_packet_observer_->OnPacketDequeued(
+          packet->Ssrc(), now_ms - packet->pacer_enqueue_time_ms());
+    }
   }
 
   if (!SendPacketToNetwork(*packet_to_send, options))
@@ -840,6 +976,7 @@ bool RTPSender::SendToNetwork(std::unique_ptr<RtpPacketToSend> packet,
     // TickTime and Clock.
     int64_t corrected_time_ms = packet->capture_time_ms() + clock_delta_ms_;
     size_t payload_length = packet->payload_size();
+    packet->set_pacer_enqueue_time_ms(now_ms);
     if (ssrc == flexfec_ssrc) {
       // Store FlexFEC packets in the history here, so they can be found
       // when the pacer calls TimeToSendPacket.
@@ -848,6 +985,8 @@ bool RTPSender::SendToNetwork(std::unique_ptr<RtpPacketToSend> packet,
       packet_history_.PutRtpPacket(std::move(packet), storage, false);
     }
 
+    rtc::packet_trace::Record(rtc::packet_trace::Stage::kPacerEnqueued, ssrc,
+                              seq_no);
     paced_sender_->InsertPacket(priority, ssrc, seq_no, corrected_time_ms,
                                 payload_length, false);
     if (last_capture_time_ms_sent_ == 0 ||
@@ -1258,8 +1397,7 @@ void RTPSender::AddPacketToTransportFeedback(uint16_t packet_id,
                                              const RtpPacketToSend& packet,
                                              int probe_cluster_id) {
   size_t packet_size = packet.payload_size() + packet.padding_size();
-  if (webrtc::field_trial::FindFullName("WebRTC-SendSideBwe-WithOverhead") ==
-      "Enabled") {
+  if (send_side_bwe_with_overhead_) {
     packet_size = packet.size();
   }
 
@@ -1292,16 +1430,79 @@ bool RTPSender::EnableMediaCrypto(const MediaCryptoKey &key) {
   return  media_crypto_enabled_;
 }
 
+bool RTPSender::EnableMediaCrypto(MediaCryptoContext* context) {
+  LOG(LS_INFO) << "Enabling E2E Media Encryption with shared context";
+
+  rtc::CritScope cs(&send_critsect_);
+  media_crypto_enabled_ = media_crypto_.SetOutboundContext(context);
+  return media_crypto_enabled_;
+}
+
+bool RTPSender::PrewarmMediaCrypto() {
+  rtc::CritScope cs(&send_critsect_);
+  return media_crypto_enabled_ && media_crypto_.Prewarm();
+}
+
+bool RTPSender::UpdateMediaCryptoKey(const MediaCryptoKey& key) {
+  rtc::CritScope cs(&send_critsect_);
+  return media_crypto_enabled_ && media_crypto_.UpdateKey(key);
+}
+
 bool RTPSender::MediaEncrypt(rtp::Packet *packet)
 {
   if (media_crypto_enabled_)
     return media_crypto_.Encrypt(packet);
   return true;
 }
+
+bool RTPSender::MediaEncryptBatch(rtc::ArrayView<rtp::Packet* const> packets)
+{
+  if (!media_crypto_enabled_)
+    return true;
+  if (!send_packet_observer_ || packets.empty())
+    return media_crypto_.EncryptBatch(packets);
+  const int64_t start_us = clock_->TimeInMicroseconds();
+  const bool encrypted = media_crypto_.EncryptBatch(packets);
+  if (encrypted) {
+    send_packet_observer_->OnMediaEncrypted(
+        packets[0]->Ssrc(), clock_->TimeInMicroseconds() - start_us);
+  }
+  return encrypted;
+}
+void RTPSender::SetMediaCryptoWorkerPool(MediaCryptoWorkerPool* worker_pool)
+{
+  media_crypto_worker_pool_ = worker_pool;
+}
+
+MediaCryptoWorkerPool* RTPSender::media_crypto_worker_pool() const
+{
+  if (media_crypto_enabled_)
+    return media_crypto_worker_pool_;
+  return nullptr;
+}
+
+int64_t RTPSender::ExpectedPacerQueueTimeMs() const {
+  return paced_sender_ ? paced_sender_->ExpectedQueueTimeMs() : 0;
+}
+
 size_t RTPSender::GetMediaEncryptionOverhead()
 {
  if (media_crypto_enabled_)
     return media_crypto_.GetEncryptionOverhead();
   return 0;	
 }
+
+const char* RTPSender::MediaCryptoCipherName() const
+{
+  if (media_crypto_enabled_)
+    return media_crypto_.cipher_name();
+  return nullptr;
+}
+
+bool RTPSender::GetMediaCryptoStats(MediaCryptoStats* stats) const {
+  if (!media_crypto_enabled_)
+    return false;
+  *stats = media_crypto_.stats();
+  return true;
+}
 }  // namespace webrtc
@@ -26,6 +26,7 @@
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/common_types.h"
 #include "webrtc/modules/rtp_rtcp/include/flexfec_sender.h"
+#include "webrtc/modules/rtp_rtcp/include/media_crypto_worker_pool.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "webrtc/modules/rtp_rtcp/source/media_crypto.h"
 #include "webrtc/modules/rtp_rtcp/source/playout_delay_oracle.h"
@@ -212,8 +213,28 @@ class RTPSender {
 
   // End to End media crypto
   bool EnableMediaCrypto(const MediaCryptoKey &key);
+  // Shares |context| with the other streams using it, must outlive this.
+  bool EnableMediaCrypto(MediaCryptoContext* context);
+  // Creates the media crypto cipher now rather than on the first packet.
+  bool PrewarmMediaCrypto();
+  // Switches to |key| from the next packet on, see MediaCrypto::UpdateKey.
+  bool UpdateMediaCryptoKey(const MediaCryptoKey& key);
   bool MediaEncrypt(rtp::Packet *packet);
+  bool MediaEncryptBatch(rtc::ArrayView<rtp::Packet* const> packets);
   size_t GetMediaEncryptionOverhead();
+  // Name of the cipher backend used for media crypto, nullptr if disabled.
+  const char* MediaCryptoCipherName() const;
+  // Returns false if media crypto is disabled.
+  bool GetMediaCryptoStats(MediaCryptoStats* stats) const;
+  // Encrypt and send video frames on |worker_pool| instead of the calling
+  // thread. Must be set before sending starts, |worker_pool| must outlive
+  // this object.
+  void SetMediaCryptoWorkerPool(MediaCryptoWorkerPool* worker_pool);
+  // Returns the worker pool to use, or nullptr if media crypto runs inline.
+  MediaCryptoWorkerPool* media_crypto_worker_pool() const;
+
+  // Time in ms to send what is queued in the pacer, 0 without a pacer.
+  int64_t ExpectedPacerQueueTimeMs() const;
   
  protected:
   int32_t CheckPayloadType(int8_t payload_type, RtpVideoCodecTypes* video_type);
@@ -226,7 +247,11 @@ class RTPSender {
 
   size_t SendPadData(size_t bytes, int probe_cluster_id);
 
-  bool PrepareAndSendPacket(std::unique_ptr<RtpPacketToSend> packet,
+  // Queues the retransmissions of a whole NACK in the pacer at once.
+  void ReSendPacketsPaced(const std::vector<uint16_t>& sequence_numbers,
+                          int64_t min_resend_time);
+
+  bool PrepareAndSendPacket(RtpPacketToSend* packet,
                             bool send_over_rtx,
                             bool is_retransmit,
                             int probe_cluster_id);
@@ -249,6 +274,24 @@ class RTPSender {
   bool UpdateTransportSequenceNumber(RtpPacketToSend* packet,
                                      int* packet_id) const;
 
+  // Returns a padding packet for |ssrc| and |payload_type|, which only needs
+  // its sequence number, timestamp and header extensions set. Probe clusters
+  // send many of them back to back, so the header layout and the random
+  // padding are only built again when they would change, and a packet handed
+  // back through ReturnPaddingPacket is reused as is. |version| identifies the
+  // template the packet was built from.
+  std::unique_ptr<RtpPacketToSend> TakePaddingPacket(
+      uint32_t ssrc,
+      int payload_type,
+      bool with_transmission_offset,
+      size_t padding_bytes,
+      uint32_t* version) EXCLUSIVE_LOCKS_REQUIRED(send_critsect_);
+  // Keeps |packet| for the next TakePaddingPacket call unless the template
+  // changed since it was taken.
+  void ReturnPaddingPacket(std::unique_ptr<RtpPacketToSend> packet,
+                           uint32_t version);
+  void ResetPaddingPacket() EXCLUSIVE_LOCKS_REQUIRED(send_critsect_);
+
   void UpdateRtpStats(const RtpPacketToSend& packet,
                       bool is_rtx,
                       bool is_retransmit);
@@ -329,13 +372,24 @@ class RTPSender {
   // Mapping rtx_payload_type_map_[associated] = rtx.
   std::map<int8_t, int8_t> rtx_payload_type_map_ GUARDED_BY(send_critsect_);
   size_t rtp_overhead_bytes_per_packet_ GUARDED_BY(send_critsect_);
+  // Template for the padding only packets, see TakePaddingPacket.
+  std::unique_ptr<RtpPacketToSend> padding_packet_ GUARDED_BY(send_critsect_);
+  bool padding_packet_has_transmission_offset_ GUARDED_BY(send_critsect_);
+  // Bumped every time |padding_packet_| is rebuilt or dropped.
+  uint32_t padding_packet_version_ GUARDED_BY(send_critsect_);
+  // Padding packet already sent once, owning its buffer so that it can be
+  // rewritten in place instead of copying the template again.
+  std::unique_ptr<RtpPacketToSend> spare_padding_packet_
+      GUARDED_BY(send_critsect_);
 
   RateLimiter* const retransmission_rate_limiter_;
   OverheadObserver* overhead_observer_;
+  const bool send_side_bwe_with_overhead_;
 
   // Double PERC encryption
   bool media_crypto_enabled_;
   MediaCrypto media_crypto_;
+  MediaCryptoWorkerPool* media_crypto_worker_pool_;
   
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(RTPSender);
 };
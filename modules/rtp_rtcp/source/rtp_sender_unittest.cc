@@ -11,6 +11,7 @@
 #include <memory>
 #include <vector>
 
+#include "webrtc/base/arraysize.h"
 #include "webrtc/base/buffer.h"
 #include "webrtc/base/rate_limiter.h"
 #include "webrtc/logging/rtc_event_log/mock/mock_rtc_event_log.h"
@@ -18,6 +19,7 @@
 #include "webrtc/modules/rtp_rtcp/include/rtp_header_parser.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "webrtc/modules/rtp_rtcp/source/rtcp_packet/transport_feedback.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_format.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_format_video_generic.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_header_extension.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_header_extensions.h"
@@ -26,6 +28,9 @@
 #include "webrtc/modules/rtp_rtcp/source/rtp_sender.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_sender_video.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_utility.h"
+#include "webrtc/modules/video_coding/frame_object.h"
+#include "webrtc/modules/video_coding/packet_buffer.h"
+#include "webrtc/modules/video_coding/rtp_frame_reference_finder.h"
 #include "webrtc/test/field_trial.h"
 #include "webrtc/test/gmock.h"
 #include "webrtc/test/gtest.h"
@@ -51,6 +56,7 @@ const int kAudioPayload = 103;
 const uint64_t kStartTime = 123456789;
 const size_t kMaxPaddingSize = 224u;
 const int kVideoRotationExtensionId = 5;
+const int kFrameMarkingExtensionId = 6;
 const size_t kGenericHeaderLength = 1;
 const uint8_t kPayloadData[] = {47, 11, 32, 93, 89};
 
@@ -74,6 +80,8 @@ class LoopbackTransportTest : public webrtc::Transport {
                                    kVideoRotationExtensionId);
     receivers_extensions_.Register(kRtpExtensionAudioLevel,
                                    kAudioLevelExtensionId);
+    receivers_extensions_.Register(kRtpExtensionFrameMarking,
+                                   kFrameMarkingExtensionId);
   }
 
   bool SendRtp(const uint8_t* data,
@@ -111,6 +119,11 @@ class MockRtpPacketSender : public RtpPacketSender {
                     int64_t capture_time_ms,
                     size_t bytes,
                     bool retransmission));
+  MOCK_METHOD3(InsertPackets,
+               void(Priority priority,
+                    const std::vector<PacketToInsert>& packets,
+                    bool retransmission));
+  MOCK_CONST_METHOD0(ExpectedQueueTimeMs, int64_t());
 };
 
 class MockTransportSequenceNumberAllocator
@@ -338,6 +351,34 @@ TEST_F(RtpSenderTestWithoutPacer, AssignSequenceNumberSetPaddingTimestamps) {
   EXPECT_EQ(kTimestamp, transport_.last_sent_packet().Timestamp());
 }
 
+TEST_F(RtpSenderTestWithoutPacer, PaddingPacketsFollowRegisteredExtensions) {
+  constexpr size_t kPaddingSize = 100;
+  auto packet = rtp_sender_->AllocatePacket();
+  ASSERT_TRUE(packet);
+  packet->SetMarker(true);
+  ASSERT_TRUE(rtp_sender_->AssignSequenceNumber(packet.get()));
+
+  ASSERT_TRUE(rtp_sender_->TimeToSendPadding(kPaddingSize, -1));
+  ASSERT_TRUE(rtp_sender_->TimeToSendPadding(kPaddingSize, -1));
+  EXPECT_EQ(0, rtp_sender_->RegisterRtpHeaderExtension(
+                   kRtpExtensionAbsoluteSendTime, kAbsoluteSendTimeExtensionId));
+  ASSERT_TRUE(rtp_sender_->TimeToSendPadding(kPaddingSize, -1));
+
+  ASSERT_EQ(3u, transport_.sent_packets_.size());
+  const RtpPacketReceived& first = transport_.sent_packets_[0];
+  const RtpPacketReceived& second = transport_.sent_packets_[1];
+  const RtpPacketReceived& third = transport_.sent_packets_[2];
+  EXPECT_EQ(kMaxPaddingSize, first.padding_size());
+  EXPECT_EQ(kMaxPaddingSize, third.padding_size());
+  EXPECT_EQ(first.SequenceNumber() + 1, second.SequenceNumber());
+  EXPECT_EQ(second.SequenceNumber() + 1, third.SequenceNumber());
+  // The packet built before the extension was registered is not reused.
+  EXPECT_EQ(first.headers_size(), second.headers_size());
+  EXPECT_LT(second.headers_size(), third.headers_size());
+  uint32_t absolute_send_time;
+  EXPECT_TRUE(third.GetExtension<AbsoluteSendTime>(&absolute_send_time));
+}
+
 TEST_F(RtpSenderTestWithoutPacer, SendsPacketsWithTransportSequenceNumber) {
   rtp_sender_.reset(new RTPSender(
       false, &fake_clock_, &transport_, nullptr, nullptr, &seq_num_allocator_,
@@ -1299,6 +1340,112 @@ TEST_F(RtpSenderTestWithoutPacer, RespectsNackBitrateLimit) {
   EXPECT_EQ(kNumPackets * 2, transport_.packets_sent());
 }
 
+TEST_F(RtpSenderTest, QueuesNackedPacketsInOneBatch) {
+  const size_t kPacketSize = 100;
+  rtp_sender_->SetStorePacketsStatus(true, 10);
+  EXPECT_CALL(mock_paced_sender_, InsertPacket(_, kSsrc, _, _, _, false))
+      .Times(3);
+  const uint16_t kStartSequenceNumber = rtp_sender_->SequenceNumber();
+  for (int i = 0; i < 3; ++i)
+    SendPacket(fake_clock_.TimeInMilliseconds(), kPacketSize);
+
+  // The last sequence number has not been sent.
+  std::vector<uint16_t> sequence_numbers;
+  for (uint16_t i = 0; i < 4; ++i)
+    sequence_numbers.push_back(kStartSequenceNumber + i);
+  std::vector<RtpPacketSender::PacketToInsert> packets;
+  EXPECT_CALL(mock_paced_sender_,
+              InsertPackets(RtpPacketSender::kNormalPriority, _, true))
+      .WillOnce(testing::SaveArg<1>(&packets));
+  rtp_sender_->OnReceivedNack(sequence_numbers, 0);
+  ASSERT_EQ(3u, packets.size());
+  for (size_t i = 0; i < packets.size(); ++i) {
+    EXPECT_EQ(kSsrc, packets[i].ssrc);
+    EXPECT_EQ(kStartSequenceNumber + i, packets[i].sequence_number);
+    EXPECT_EQ(kPacketSize, packets[i].bytes);
+  }
+
+  // Too soon after the previous retransmission.
+  EXPECT_CALL(mock_paced_sender_, InsertPackets(_, _, _)).Times(0);
+  rtp_sender_->OnReceivedNack(sequence_numbers, 0);
+}
+
+TEST_F(RtpSenderTest, ResendsNackedPacketsOverRateLimitOnNextNack) {
+  const size_t kPacketSize = 100;
+  rtp_sender_->SetStorePacketsStatus(true, 10);
+  EXPECT_CALL(mock_paced_sender_, InsertPacket(_, kSsrc, _, _, _, false))
+      .Times(5);
+  const uint16_t kStartSequenceNumber = rtp_sender_->SequenceNumber();
+  for (int i = 0; i < 5; ++i)
+    SendPacket(fake_clock_.TimeInMilliseconds(), kPacketSize);
+  std::vector<RtpPacketSender::PacketToInsert> packets;
+  EXPECT_CALL(mock_paced_sender_,
+              InsertPackets(RtpPacketSender::kNormalPriority, _, true))
+      .WillRepeatedly(testing::SaveArg<1>(&packets));
+
+  // A first retransmission starts the rate measurement.
+  rtp_sender_->OnReceivedNack({kStartSequenceNumber}, 0);
+  ASSERT_EQ(1u, packets.size());
+  const size_t kRtpPacketSize = kPacketSize + kRtpHeaderSize;
+  fake_clock_.AdvanceTimeMilliseconds(999);
+
+  // Room for two more packets within a second.
+  retransmission_rate_limiter_.SetMaxRate(kRtpPacketSize * 8 * 3);
+  std::vector<uint16_t> sequence_numbers;
+  for (uint16_t i = 1; i < 5; ++i)
+    sequence_numbers.push_back(kStartSequenceNumber + i);
+  rtp_sender_->OnReceivedNack(sequence_numbers, 0);
+  ASSERT_EQ(2u, packets.size());
+  EXPECT_EQ(kStartSequenceNumber + 1, packets[0].sequence_number);
+  EXPECT_EQ(kStartSequenceNumber + 2, packets[1].sequence_number);
+
+  // Once the first retransmission leaves the rate window, the packets that
+  // did not fit are resent right away, as they were never retransmitted.
+  fake_clock_.AdvanceTimeMilliseconds(1);
+  retransmission_rate_limiter_.SetMaxRate(kRtpPacketSize * 8 * 4);
+  rtp_sender_->OnReceivedNack(sequence_numbers, 0);
+  ASSERT_EQ(2u, packets.size());
+  EXPECT_EQ(kStartSequenceNumber + 3, packets[0].sequence_number);
+  EXPECT_EQ(kStartSequenceNumber + 4, packets[1].sequence_number);
+}
+
+TEST_F(RtpSenderTest, ResendsPacketNackedWhilePacerSendsIt) {
+  // NACKs the packet from the transport, while it is out of the history.
+  class NackingTransport : public Transport {
+   public:
+    bool SendRtp(const uint8_t* data,
+                 size_t len,
+                 const PacketOptions& options) override {
+      if (sender_) {
+        RTPSender* sender = sender_;
+        sender_ = nullptr;
+        sender->OnReceivedNack({kSeqNum}, 0);
+      }
+      return true;
+    }
+    bool SendRtcp(const uint8_t* data, size_t len) override { return false; }
+    RTPSender* sender_ = nullptr;
+  } nacking_transport;
+  rtp_sender_.reset(new RTPSender(
+      false, &fake_clock_, &nacking_transport, &mock_paced_sender_, nullptr,
+      nullptr, nullptr, nullptr, nullptr, nullptr, &mock_rtc_event_log_,
+      nullptr, &retransmission_rate_limiter_, nullptr));
+  rtp_sender_->SetSequenceNumber(kSeqNum);
+  rtp_sender_->SetSSRC(kSsrc);
+  rtp_sender_->SetStorePacketsStatus(true, 10);
+  EXPECT_CALL(mock_paced_sender_, InsertPacket(_, kSsrc, kSeqNum, _, _, false));
+  SendPacket(fake_clock_.TimeInMilliseconds(), 100);
+
+  nacking_transport.sender_ = rtp_sender_.get();
+  EXPECT_CALL(mock_paced_sender_,
+              InsertPacket(RtpPacketSender::kNormalPriority, kSsrc, kSeqNum, _,
+                           _, true));
+  EXPECT_TRUE(rtp_sender_->TimeToSendPacket(
+      kSsrc, kSeqNum, fake_clock_.TimeInMilliseconds(), false,
+      PacketInfo::kNotAProbe));
+  EXPECT_FALSE(nacking_transport.sender_);
+}
+
 TEST_F(RtpSenderVideoTest, KeyFrameHasCVO) {
   uint8_t kFrame[kMaxPacketLength];
   EXPECT_EQ(0, rtp_sender_->RegisterRtpHeaderExtension(
@@ -1361,6 +1508,36 @@ TEST_F(RtpSenderVideoTest, DeltaFrameHasCVOWhenNonZero) {
 
 // Make sure rotation is parsed correctly when the Camera (C) and Flip (F) bits
 // are set in the CVO byte.
+TEST_F(RtpSenderVideoTest, Vp9FrameMarksHaveSpatialLayerOfEachPacket) {
+  uint8_t kFrame[3 * kMaxPacketLength];
+  EXPECT_EQ(0, rtp_sender_->RegisterRtpHeaderExtension(
+                   kRtpExtensionFrameMarking, kFrameMarkingExtensionId));
+
+  RTPVideoHeader hdr = {0};
+  hdr.codecHeader.VP9.InitRTPVideoHeaderVP9();
+  hdr.codecHeader.VP9.num_spatial_layers = 2;
+  hdr.codecHeader.VP9.spatial_idx = 1;
+  hdr.codecHeader.VP9.inter_layer_predicted = true;
+  hdr.codecHeader.VP9.tl0_pic_idx = 7;
+  ASSERT_TRUE(rtp_sender_video_->SendVideo(
+      kRtpVideoVp9, kVideoFrameKey, kPayload, kTimestamp, 0, kFrame,
+      sizeof(kFrame), nullptr, &hdr));
+
+  ASSERT_GT(transport_.packets_sent(), 2);
+  for (int i = 0; i < transport_.packets_sent(); ++i) {
+    FrameMarks frame_marks;
+    ASSERT_TRUE(
+        transport_.sent_packets_[i].GetExtension<FrameMarking>(&frame_marks));
+    EXPECT_EQ(i == 0, frame_marks.startOfFrame);
+    EXPECT_EQ(i == transport_.packets_sent() - 1, frame_marks.endOfFrame);
+    // The upper spatial layer of a key frame depends on the lower one.
+    EXPECT_FALSE(frame_marks.independent);
+    EXPECT_EQ(0, frame_marks.temporalLayerId);
+    EXPECT_EQ(1, frame_marks.spatialLayerId);
+    EXPECT_EQ(7, frame_marks.tl0PicIdx);
+  }
+}
+
 TEST_F(RtpSenderVideoTest, SendVideoWithCameraAndFlipCVO) {
   // Test extracting rotation when Camera (C) and Flip (F) bits are zero.
   EXPECT_EQ(kVideoRotation_0, ConvertCVOByteToVideoRotation(0));
@@ -1380,6 +1557,146 @@ TEST_F(RtpSenderVideoTest, SendVideoWithCameraAndFlipCVO) {
             ConvertCVOByteToVideoRotation(flip_bit | camera_bit | 3));
 }
 
+TEST_F(RtpSenderTest, DropsDiscardableFramesWhenPacerQueueIsLong) {
+  test::ScopedFieldTrials override_field_trials(
+      "WebRTC-DropDiscardableVideoFrames/Enabled/");
+  RTPSenderVideo rtp_sender_video(&fake_clock_, rtp_sender_.get(), nullptr);
+  uint8_t kFrame[kMaxPacketLength];
+  RTPVideoHeader hdr = {0};
+  hdr.codecHeader.VP8.InitRTPVideoHeaderVP8();
+  hdr.codecHeader.VP8.temporalIdx = 1;
+  hdr.codecHeader.VP8.nonReference = true;
+
+  EXPECT_CALL(mock_paced_sender_, ExpectedQueueTimeMs())
+      .WillRepeatedly(testing::Return(1000));
+  EXPECT_CALL(mock_paced_sender_, InsertPacket(_, _, _, _, _, _)).Times(0);
+  EXPECT_TRUE(rtp_sender_video.SendVideo(kRtpVideoVp8, kVideoFrameDelta,
+                                         kPayload, kTimestamp, 0, kFrame,
+                                         sizeof(kFrame), nullptr, &hdr));
+  testing::Mock::VerifyAndClearExpectations(&mock_paced_sender_);
+
+  // Base layer frames are always sent.
+  hdr.codecHeader.VP8.temporalIdx = 0;
+  EXPECT_CALL(mock_paced_sender_, ExpectedQueueTimeMs())
+      .WillRepeatedly(testing::Return(1000));
+  EXPECT_CALL(mock_paced_sender_, InsertPacket(_, _, _, _, _, _))
+      .Times(testing::AtLeast(1));
+  EXPECT_TRUE(rtp_sender_video.SendVideo(kRtpVideoVp8, kVideoFrameDelta,
+                                         kPayload, kTimestamp, 0, kFrame,
+                                         sizeof(kFrame), nullptr, &hdr));
+  testing::Mock::VerifyAndClearExpectations(&mock_paced_sender_);
+
+  // So are higher layer frames when the queue is short.
+  hdr.codecHeader.VP8.temporalIdx = 1;
+  EXPECT_CALL(mock_paced_sender_, ExpectedQueueTimeMs())
+      .WillRepeatedly(testing::Return(0));
+  EXPECT_CALL(mock_paced_sender_, InsertPacket(_, _, _, _, _, _))
+      .Times(testing::AtLeast(1));
+  EXPECT_TRUE(rtp_sender_video.SendVideo(kRtpVideoVp8, kVideoFrameDelta,
+                                         kPayload, kTimestamp, 0, kFrame,
+                                         sizeof(kFrame), nullptr, &hdr));
+}
+
+namespace {
+// Reassembles the frames of a received VP8 stream and resolves their
+// references, as the receive stream does.
+class Vp8FrameReceiver : public video_coding::OnReceivedFrameCallback,
+                         public video_coding::OnCompleteFrameCallback {
+ public:
+  explicit Vp8FrameReceiver(Clock* clock)
+      : packet_buffer_(video_coding::PacketBuffer::Create(clock, 16, 64, this)),
+        reference_finder_(this),
+        depacketizer_(RtpDepacketizer::Create(kRtpVideoVp8)) {}
+
+  void OnRtpPacket(const RtpPacketReceived& rtp_packet) {
+    RtpDepacketizer::ParsedPayload parsed_payload;
+    ASSERT_TRUE(depacketizer_->Parse(&parsed_payload,
+                                     rtp_packet.payload().data(),
+                                     rtp_packet.payload_size()));
+    WebRtcRTPHeader rtp_header;
+    memset(&rtp_header, 0, sizeof(rtp_header));
+    rtp_packet.GetHeader(&rtp_header.header);
+    rtp_header.frameType = parsed_payload.frame_type;
+    rtp_header.type = parsed_payload.type;
+    VCMPacket packet(parsed_payload.payload, parsed_payload.payload_length,
+                     rtp_header);
+    uint8_t* data = new uint8_t[packet.sizeBytes];
+    memcpy(data, packet.dataPtr, packet.sizeBytes);
+    packet.dataPtr = data;
+    packet_buffer_->InsertPacket(&packet);
+  }
+
+  void OnReceivedFrame(
+      std::unique_ptr<video_coding::RtpFrameObject> frame) override {
+    reference_finder_.ManageFrame(std::move(frame));
+  }
+
+  void OnCompleteFrame(
+      std::unique_ptr<video_coding::FrameObject> frame) override {
+    complete_picture_ids_.push_back(frame->picture_id);
+  }
+
+  const std::vector<uint16_t>& complete_picture_ids() const {
+    return complete_picture_ids_;
+  }
+
+ private:
+  rtc::scoped_refptr<video_coding::PacketBuffer> packet_buffer_;
+  video_coding::RtpFrameReferenceFinder reference_finder_;
+  std::unique_ptr<RtpDepacketizer> depacketizer_;
+  std::vector<uint16_t> complete_picture_ids_;
+};
+}  // namespace
+
+TEST_F(RtpSenderTest, ReceiverResolvesFramesAfterDroppedDiscardableFrames) {
+  test::ScopedFieldTrials override_field_trials(
+      "WebRTC-DropDiscardableVideoFrames/Enabled/");
+  rtp_sender_->SetStorePacketsStatus(true, 10);
+  RTPSenderVideo rtp_sender_video(&fake_clock_, rtp_sender_.get(), nullptr);
+  std::vector<uint16_t> sequence_numbers;
+  EXPECT_CALL(mock_paced_sender_, ExpectedQueueTimeMs())
+      .WillRepeatedly(testing::Return(1000));
+  EXPECT_CALL(mock_paced_sender_, InsertPacket(_, kSsrc, _, _, _, false))
+      .WillRepeatedly(testing::WithArg<2>(testing::Invoke(
+          [&sequence_numbers](uint16_t sequence_number) {
+            sequence_numbers.push_back(sequence_number);
+          })));
+
+  // Two groups of a base layer frame followed by frames of temporal layers 2,
+  // 1 and 2, of which the layer 2 frames are discardable and dropped. The
+  // first layer 1 frame is a layer sync frame.
+  const uint8_t kTemporalIdx[] = {0, 2, 1, 2, 0, 2, 1, 2};
+  const uint16_t kStartPictureId = 100;
+  uint8_t frame[100] = {0};
+  for (uint16_t i = 0; i < arraysize(kTemporalIdx); ++i) {
+    RTPVideoHeader hdr = {0};
+    hdr.codecHeader.VP8.InitRTPVideoHeaderVP8();
+    hdr.codecHeader.VP8.pictureId = kStartPictureId + i;
+    hdr.codecHeader.VP8.temporalIdx = kTemporalIdx[i];
+    hdr.codecHeader.VP8.tl0PicIdx = i / 4;
+    hdr.codecHeader.VP8.layerSync = i == 2;
+    hdr.codecHeader.VP8.nonReference = kTemporalIdx[i] == 2;
+    FrameType frame_type = i == 0 ? kVideoFrameKey : kVideoFrameDelta;
+    // The inverse key frame bit of the VP8 payload header.
+    frame[0] = i == 0 ? 0 : 1;
+    EXPECT_TRUE(rtp_sender_video.SendVideo(
+        kRtpVideoVp8, frame_type, kPayload, kTimestamp + i * 3000, 0, frame,
+        sizeof(frame), nullptr, &hdr));
+  }
+  for (uint16_t sequence_number : sequence_numbers)
+    rtp_sender_->TimeToSendPacket(kSsrc, sequence_number, 0, false,
+                                  PacketInfo::kNotAProbe);
+
+  Vp8FrameReceiver receiver(&fake_clock_);
+  for (const RtpPacketReceived& packet : transport_.sent_packets_)
+    receiver.OnRtpPacket(packet);
+  // The layer 1 frames wait for no dropped frame.
+  const std::vector<uint16_t>& picture_ids = receiver.complete_picture_ids();
+  ASSERT_EQ(4u, picture_ids.size());
+  for (size_t i = 0; i < picture_ids.size(); ++i)
+    EXPECT_EQ(kStartPictureId + i, picture_ids[i]);
+}
+
 namespace {
 class MockOverheadObserver : public OverheadObserver {
  public:
@@ -19,6 +19,7 @@
 
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/base/packet_trace.h"
 #include "webrtc/base/trace_event.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "webrtc/modules/rtp_rtcp/source/byte_io.h"
@@ -27,11 +28,57 @@
 #include "webrtc/modules/rtp_rtcp/source/rtp_format_vp9.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_header_extensions.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "webrtc/system_wrappers/include/field_trial.h"
 
 namespace webrtc {
 
+namespace {
+// VP8 picture ids are 15 bits.
+constexpr uint16_t kMaxVp8PictureId = 0x7FFF;
+}  // namespace
+
+// Encrypts a packetized frame on a MediaCryptoWorkerPool worker and sends it
+// from there.
+class RTPSenderVideo::EncryptAndSendTask : public rtc::QueuedTask {
+ public:
+  EncryptAndSendTask(RTPSenderVideo* sender_video,
+                     RTPSender* rtp_sender,
+                     std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+                     std::vector<rtp::Packet*> packets_to_encrypt,
+                     StorageType storage,
+                     bool protect_packets,
+                     bool red_enabled)
+      : sender_video_(sender_video),
+        rtp_sender_(rtp_sender),
+        packets_(std::move(packets)),
+        packets_to_encrypt_(std::move(packets_to_encrypt)),
+        storage_(storage),
+        protect_packets_(protect_packets),
+        red_enabled_(red_enabled) {}
+
+ private:
+  bool Run() override {
+    if (rtp_sender_->MediaEncryptBatch(packets_to_encrypt_)) {
+      sender_video_->SendVideoPackets(std::move(packets_), storage_,
+                                      protect_packets_, red_enabled_);
+    }
+    return true;
+  }
+
+  RTPSenderVideo* const sender_video_;
+  RTPSender* const rtp_sender_;
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets_;
+  const std::vector<rtp::Packet*> packets_to_encrypt_;
+  const StorageType storage_;
+  const bool protect_packets_;
+  const bool red_enabled_;
+};
+
 namespace {
 constexpr size_t kRedForFecHeaderLength = 1;
+// Pacer queue time above which discardable frames of higher temporal layers
+// are dropped instead of sent.
+constexpr int64_t kMaxQueueTimeForDiscardableFramesMs = 300;
 
 void BuildRedPayload(const RtpPacketToSend& media_packet,
                      RtpPacketToSend* red_packet) {
@@ -57,6 +104,10 @@ RTPSenderVideo::RTPSenderVideo(Clock* clock,
       red_payload_type_(-1),
       ulpfec_payload_type_(-1),
       flexfec_sender_(flexfec_sender),
+      drop_discardable_frames_(
+          field_trial::FindFullName("WebRTC-DropDiscardableVideoFrames") ==
+          "Enabled"),
+      num_dropped_vp8_pictures_(0),
       delta_fec_params_{0, 1, kFecMaskRandom},
       key_fec_params_{0, 1, kFecMaskRandom},
       fec_bitrate_(1000, RateStatistics::kBpsScale),
@@ -281,6 +332,25 @@ rtc::Optional<uint32_t> RTPSenderVideo::FlexfecSsrc() const {
   return rtc::Optional<uint32_t>();
 }
 
+bool RTPSenderVideo::ShouldDropDiscardableFrame(
+    RtpVideoCodecTypes video_type,
+    FrameType frame_type,
+    const RTPVideoHeader* video_header) const {
+  if (!drop_discardable_frames_ || frame_type == kVideoFrameKey ||
+      !video_header || video_type != kRtpVideoVp8) {
+    return false;
+  }
+  // Same as the discardable and temporal layer id frame marks. Base layer
+  // frames are never dropped, so the stream stays decodable.
+  const RTPVideoHeaderVP8& vp8 = video_header->codecHeader.VP8;
+  if (!vp8.nonReference || vp8.temporalIdx == kNoTemporalIdx ||
+      vp8.temporalIdx == 0) {
+    return false;
+  }
+  return rtp_sender_->ExpectedPacerQueueTimeMs() >
+         kMaxQueueTimeForDiscardableFramesMs;
+}
+
 bool RTPSenderVideo::SendVideo(RtpVideoCodecTypes video_type,
                                FrameType frame_type,
                                int8_t payload_type,
@@ -293,6 +363,36 @@ bool RTPSenderVideo::SendVideo(RtpVideoCodecTypes video_type,
   if (payload_size == 0)
     return false;
 
+  // Shed higher temporal layers before spending time on packetization and
+  // encryption. The frame is reported as sent, as it is not an error.
+  bool drop = ShouldDropDiscardableFrame(video_type, frame_type, video_header);
+
+  // The encoder has already assigned the dropped frames a picture id, and a
+  // receiver waits for every picture id between a frame and the frames it
+  // references, so the picture ids of the frames sent are shifted down to
+  // close the gaps.
+  RTPVideoHeader renumbered_header;
+  if (video_type == kRtpVideoVp8 && video_header &&
+      video_header->codecHeader.VP8.pictureId != kNoPictureId) {
+    rtc::CritScope cs(&crit_);
+    if (drop) {
+      ++num_dropped_vp8_pictures_;
+    } else if (num_dropped_vp8_pictures_ != 0) {
+      renumbered_header = *video_header;
+      renumbered_header.codecHeader.VP8.pictureId =
+          (video_header->codecHeader.VP8.pictureId -
+           num_dropped_vp8_pictures_) &
+          kMaxVp8PictureId;
+      video_header = &renumbered_header;
+    }
+  }
+
+  if (drop) {
+    LOG(LS_VERBOSE) << "Dropping discardable frame " << rtp_timestamp
+                    << ", pacer queue is too long.";
+    return true;
+  }
+
   // Create header that will be reused in all packets.
   std::unique_ptr<RtpPacketToSend> rtp_header = rtp_sender_->AllocatePacket();
   rtp_header->SetPayloadType(payload_type);
@@ -363,19 +463,24 @@ bool RTPSenderVideo::SendVideo(RtpVideoCodecTypes video_type,
       frame_marks.spatialLayerId = 0;
       frame_marks.tl0PicIdx = video_header->codecHeader.VP8.tl0PicIdx;
       break;
-    case kRtpVideoVp9:
+    case kRtpVideoVp9: {
+      // The VP9 encoder outputs each spatial layer of an SVC frame as a frame
+      // of its own, packetized by a separate call, so the spatial layer is
+      // the same for all packets sent here, and the start and end of frame
+      // marks set per packet below are those of the layer frame.
+      const RTPVideoHeaderVP9& vp9 = video_header->codecHeader.VP9;
+      frame_marks.independent =
+          !vp9.inter_pic_predicted && !vp9.inter_layer_predicted;
       frame_marks.discardable = false;
-      frame_marks.temporalLayerId = video_header->codecHeader.VP9.temporal_idx;
-      frame_marks.spatialLayerId = 0;
-      frame_marks.tl0PicIdx = video_header->codecHeader.VP9.tl0_pic_idx;
-      // TODO: This will need to be changed to support VP9 SVC, but videoheader
-      // I set per-frame, not per packet, so we can't have access to this values
-      // Also, small modifications to the extensions will be needed to not
-      // change size of the extension between sid:0 and sid:1
-      // frame_marks.startOfFrame = video_header->codecHeader.VP9.beginning_of_frame;
-      // frame_marks.endOfFrame = video_header->codecHeader.VP9.end_of_frame;     
-      // frame_marks.spatialLayerId = video_header->codecHeader.VP9.spatial_idx;
+      frame_marks.baseLayerSync = vp9.temporal_up_switch;
+      frame_marks.temporalLayerId =
+          vp9.temporal_idx == kNoTemporalIdx ? 0 : vp9.temporal_idx;
+      frame_marks.spatialLayerId =
+          vp9.spatial_idx == kNoSpatialIdx ? 0 : vp9.spatial_idx;
+      frame_marks.tl0PicIdx =
+          vp9.tl0_pic_idx == kNoTl0PicIdx ? 0 : vp9.tl0_pic_idx;
       break;
+    }
     default:
       // Do not use frame marking
       frame_marking_enabled = false;
@@ -395,7 +500,8 @@ bool RTPSenderVideo::SendVideo(RtpVideoCodecTypes video_type,
 
   std::unique_ptr<RtpPacketizer> packetizer(RtpPacketizer::Create(
       video_type, max_data_payload_length,
-      video_header ? &(video_header->codecHeader) : nullptr, frame_type));
+      video_header ? &(video_header->codecHeader) : nullptr, frame_type,
+      &h264_sps_rewrite_cache_));
   // Media packet storage.
   StorageType storage = packetizer->GetStorageType(retransmission_settings);
 
@@ -404,9 +510,14 @@ bool RTPSenderVideo::SendVideo(RtpVideoCodecTypes video_type,
   // issue is fixed.
   const RTPFragmentationHeader* frag =
       (video_type == kRtpVideoVp8) ? nullptr : fragmentation;
-  packetizer->SetPayloadData(payload_data, payload_size, frag);
+  {
+    rtc::CritScope cs(&packetizer_crit_);
+    packetizer->SetPayloadData(payload_data, payload_size, frag);
+  }
 
-  bool first_frame = first_frame_sent_();
+  // Packetize the whole frame first, so it can be encrypted in one batch.
+  std::vector<std::unique_ptr<RtpPacketToSend>> packets;
+  std::vector<rtp::Packet*> packets_to_encrypt;
   bool first = true;
   bool last = false;
   while (!last) {
@@ -427,40 +538,75 @@ bool RTPSenderVideo::SendVideo(RtpVideoCodecTypes video_type,
   
     if (!rtp_sender_->AssignSequenceNumber(packet.get()))
       return false;
+    rtc::packet_trace::Record(rtc::packet_trace::Stage::kPacketized,
+                              packet->Ssrc(), packet->SequenceNumber());
     
-    // End to End media encryption
-    if (!rtp_sender_->MediaEncrypt(packet.get()))
+    packets_to_encrypt.push_back(packet.get());
+    packets.push_back(std::move(packet));
+    first = false;
+  }
+  
+  const bool protect_packet =
+      (packetizer->GetProtectionType() == kProtectedPacket);
+
+  // End to End media encryption
+  MediaCryptoWorkerPool* worker_pool = rtp_sender_->media_crypto_worker_pool();
+  if (worker_pool) {
+    // Encrypt and send on the worker owning this SSRC, so streams are
+    // encrypted in parallel while each one keeps its packet order.
+    worker_pool->PostTask(
+        rtp_header->Ssrc(),
+        std::unique_ptr<rtc::QueuedTask>(new EncryptAndSendTask(
+            this, rtp_sender_, std::move(packets), std::move(packets_to_encrypt),
+            storage, protect_packet, red_enabled)));
+  } else {
+    if (!rtp_sender_->MediaEncryptBatch(packets_to_encrypt))
       return false;
-    
-    const bool protect_packet =
-        (packetizer->GetProtectionType() == kProtectedPacket);
+    SendVideoPackets(std::move(packets), storage, protect_packet, red_enabled);
+  }
+
+  TRACE_EVENT_ASYNC_END1("webrtc", "Video", capture_time_ms, "timestamp",
+                         rtp_timestamp);
+  return true;
+}
+
+void RTPSenderVideo::SendVideoPackets(
+    std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+    StorageType storage,
+    bool protect_packets,
+    bool red_enabled) {
+  bool first_frame = first_frame_sent_();
+  if (red_enabled && protect_packets && !flexfec_enabled()) {
+    // The whole frame is known, so its FEC packets can be sent as soon as
+    // they are complete rather than after its last packet.
+    rtc::CritScope cs(&crit_);
+    if (ulpfec_enabled())
+      ulpfec_generator_.StartFrame(packets.size());
+  }
+  for (size_t i = 0; i < packets.size(); ++i) {
+    std::unique_ptr<RtpPacketToSend> packet = std::move(packets[i]);
     if (flexfec_enabled()) {
       // TODO(brandtr): Remove the FlexFEC code path when FlexfecSender
       // is wired up to PacedSender instead.
-      SendVideoPacketWithFlexfec(std::move(packet), storage, protect_packet);
+      SendVideoPacketWithFlexfec(std::move(packet), storage, protect_packets);
     } else if (red_enabled) {
       SendVideoPacketAsRedMaybeWithUlpfec(std::move(packet), storage,
-                                          protect_packet);
+                                          protect_packets);
     } else {
       SendVideoPacket(std::move(packet), storage);
     }
 
     if (first_frame) {
-      if (first) {
+      if (i == 0) {
         LOG(LS_INFO)
             << "Sent first RTP packet of the first video frame (pre-pacer)";
       }
-      if (last) {
+      if (i == packets.size() - 1) {
         LOG(LS_INFO)
             << "Sent last RTP packet of the first video frame (pre-pacer)";
       }
     }
-    first = false;
   }
-
-  TRACE_EVENT_ASYNC_END1("webrtc", "Video", capture_time_ms, "timestamp",
-                         rtp_timestamp);
-  return true;
 }
 
 uint32_t RTPSenderVideo::VideoBitrateSent() const {
@@ -22,6 +22,7 @@
 #include "webrtc/base/sequenced_task_checker.h"
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/common_types.h"
+#include "webrtc/common_video/h264/sps_vui_rewriter.h"
 #include "webrtc/modules/rtp_rtcp/include/flexfec_sender.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_rtcp_defines.h"
 #include "webrtc/modules/rtp_rtcp/source/rtp_rtcp_config.h"
@@ -82,6 +83,8 @@ class RTPSenderVideo {
   void SetSelectiveRetransmissions(uint8_t settings);
   
  private:
+  class EncryptAndSendTask;
+
   size_t CalculateFecPacketOverhead() const EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   void SendVideoPacket(std::unique_ptr<RtpPacketToSend> packet,
@@ -98,6 +101,13 @@ class RTPSenderVideo {
                                   StorageType media_packet_storage,
                                   bool protect_media_packet);
 
+  // Sends all the packets of a frame, already encrypted when media crypto is
+  // enabled.
+  void SendVideoPackets(std::vector<std::unique_ptr<RtpPacketToSend>> packets,
+                        StorageType storage,
+                        bool protect_packets,
+                        bool red_enabled);
+
   bool red_enabled() const EXCLUSIVE_LOCKS_REQUIRED(crit_) {
     return red_payload_type_ >= 0;
   }
@@ -108,6 +118,12 @@ class RTPSenderVideo {
 
   bool flexfec_enabled() const { return flexfec_sender_ != nullptr; }
 
+  // Returns true if the frame is a discardable frame of a higher temporal
+  // layer, and the pacer queue is too long to send it in time.
+  bool ShouldDropDiscardableFrame(RtpVideoCodecTypes video_type,
+                                  FrameType frame_type,
+                                  const RTPVideoHeader* video_header) const;
+
   RTPSender* const rtp_sender_;
   Clock* const clock_;
 
@@ -126,6 +142,19 @@ class RTPSenderVideo {
   // FlexFEC.
   FlexfecSender* const flexfec_sender_;
 
+  // Drop discardable temporal layer frames when the pacer queue is long,
+  // instead of sending them late.
+  const bool drop_discardable_frames_;
+  // Number of VP8 picture ids dropped so far, subtracted from the picture id
+  // of the frames sent, so the receiver sees no gap where frames were dropped.
+  uint16_t num_dropped_vp8_pictures_ GUARDED_BY(crit_);
+
+  // Shared by the H264 packetizers of the frames, so that the SPS repeated
+  // with every key frame is only rewritten when it changes. The packetizers
+  // use it in SetPayloadData, which is called with |packetizer_crit_| held.
+  rtc::CriticalSection packetizer_crit_;
+  SpsVuiRewriteCache h264_sps_rewrite_cache_;
+
   // FEC parameters, applicable to either ULPFEC or FlexFEC.
   FecProtectionParams delta_fec_params_ GUARDED_BY(crit_);
   FecProtectionParams key_fec_params_ GUARDED_BY(crit_);
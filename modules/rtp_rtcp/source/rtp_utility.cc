@@ -314,19 +314,25 @@ void RtpHeaderParser::ParseOneByteExtensionHeader(
 
     // Note that 'len' is the header extension element length, which is the
     // number of bytes - 1.
-    const int id = (*ptr & 0xf0) >> 4;
-    const int len = (*ptr & 0x0f);
+    const uint8_t element_header = *ptr;
+    const int len = (element_header & 0x0f);
     ptr++;
 
-    if (id == 0) {
-      // Padding byte, skip ignoring len.
-      continue;
-    }
+    // The map only resolves the elements of registered extensions with a
+    // valid length, everything else is sorted out below.
+    RTPExtensionType type = ptrExtensionMap->GetTypeForElement(element_header);
+    const int id = (element_header & 0xf0) >> 4;
+    if (type == RtpHeaderExtensionMap::kInvalidType) {
+      if (id == 0) {
+        // Padding byte, skip ignoring len.
+        continue;
+      }
 
-    if (id == 15) {
-      LOG(LS_VERBOSE)
-          << "RTP extension header 15 encountered. Terminate parsing.";
-      return;
+      if (id == 15) {
+        LOG(LS_VERBOSE)
+            << "RTP extension header 15 encountered. Terminate parsing.";
+        return;
+      }
     }
 
     if (ptrRTPDataExtensionEnd - ptr < (len + 1)) {
@@ -336,18 +342,18 @@ void RtpHeaderParser::ParseOneByteExtensionHeader(
       return;
     }
 
-    RTPExtensionType type = ptrExtensionMap->GetType(id);
     if (type == RtpHeaderExtensionMap::kInvalidType) {
+      if (ptrExtensionMap->GetType(id) != RtpHeaderExtensionMap::kInvalidType) {
+        LOG(LS_WARNING) << "Incorrect len " << len << " for extension type "
+                        << ptrExtensionMap->GetType(id);
+        return;
+      }
       // If we encounter an unknown extension, just skip over it.
       LOG(LS_WARNING) << "Failed to find extension id: " << id;
     } else {
       switch (type) {
         case kRtpExtensionTransmissionTimeOffset: {
-          if (len != 2) {
-            LOG(LS_WARNING) << "Incorrect transmission time offset len: "
-                            << len;
-            return;
-          }
+          RTC_DCHECK_EQ(2, len);
           //  0                   1                   2                   3
           //  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
           // +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -360,10 +366,7 @@ void RtpHeaderParser::ParseOneByteExtensionHeader(
           break;
         }
         case kRtpExtensionAudioLevel: {
-          if (len != 0) {
-            LOG(LS_WARNING) << "Incorrect audio level len: " << len;
-            return;
-          }
+          RTC_DCHECK_EQ(0, len);
           //  0                   1
           //  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5
           // +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -376,10 +379,7 @@ void RtpHeaderParser::ParseOneByteExtensionHeader(
           break;
         }
         case kRtpExtensionAbsoluteSendTime: {
-          if (len != 2) {
-            LOG(LS_WARNING) << "Incorrect absolute send time len: " << len;
-            return;
-          }
+          RTC_DCHECK_EQ(2, len);
           //  0                   1                   2                   3
           //  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
           // +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -392,11 +392,7 @@ void RtpHeaderParser::ParseOneByteExtensionHeader(
           break;
         }
         case kRtpExtensionVideoRotation: {
-          if (len != 0) {
-            LOG(LS_WARNING)
-                << "Incorrect coordination of video coordination len: " << len;
-            return;
-          }
+          RTC_DCHECK_EQ(0, len);
           //  0                   1
           //  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5
           // +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -408,11 +404,7 @@ void RtpHeaderParser::ParseOneByteExtensionHeader(
           break;
         }
         case kRtpExtensionTransportSequenceNumber: {
-          if (len != 1) {
-            LOG(LS_WARNING) << "Incorrect transport sequence number len: "
-                            << len;
-            return;
-          }
+          RTC_DCHECK_EQ(1, len);
           //   0                   1                   2
           //   0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3
           //  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -426,10 +418,7 @@ void RtpHeaderParser::ParseOneByteExtensionHeader(
           break;
         }
         case kRtpExtensionPlayoutDelay: {
-          if (len != 2) {
-            LOG(LS_WARNING) << "Incorrect playout delay len: " << len;
-            return;
-          }
+          RTC_DCHECK_EQ(2, len);
           //   0                   1                   2                   3
           //   0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
           //  +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -445,10 +434,7 @@ void RtpHeaderParser::ParseOneByteExtensionHeader(
           break;
         }
         case kRtpExtensionFrameMarking: {
-          if (len != 0 && len != 2) {
-            LOG(LS_WARNING) << "Incorrect frame marking len: " << len;
-            return;
-          }
+          RTC_DCHECK(len == 0 || len == 2);
           // For Frame Marking RTP Header Extension:
           // 
           // https://tools.ietf.org/html/draft-ietf-avtext-framemarking-04#page-4
@@ -473,24 +459,25 @@ void RtpHeaderParser::ParseOneByteExtensionHeader(
           //    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
           //        
           // Set frame marking data
+          header->extension.hasFrameMarks = true;
           header->extension.frameMarks.startOfFrame = ptr[0] & 0x80;
           header->extension.frameMarks.endOfFrame = ptr[0] & 0x40;
           header->extension.frameMarks.independent = ptr[0] & 0x20;
           header->extension.frameMarks.discardable = ptr[0] & 0x10;
 
           // Check variable length
-          if (len==1) {
+          if (len == 0) {
             // We are non-scalable
             header->extension.frameMarks.baseLayerSync = 0;
             header->extension.frameMarks.temporalLayerId = 0;
             header->extension.frameMarks.spatialLayerId = 0;
             header->extension.frameMarks.tl0PicIdx = 0;
-          } else if (len==3) {
+          } else {
             // Set scalable parts
             header->extension.frameMarks.baseLayerSync = ptr[0] & 0x08;
             header->extension.frameMarks.temporalLayerId = ptr[0] & 0x07;
             header->extension.frameMarks.spatialLayerId = ptr[1];
-            header->extension.frameMarks.tl0PicIdx = ptr[2]; 
+            header->extension.frameMarks.tl0PicIdx = ptr[2];
           }
           break;
         }
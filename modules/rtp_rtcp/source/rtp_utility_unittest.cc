@@ -201,6 +201,36 @@ TEST(RtpHeaderParser, ParseAll6Extensions) {
             header.extension.playout_delay.max_ms);
 }
 
+TEST(RtpHeaderParser, ParseFrameMarkingSkippingUnknownExtension) {
+  // clang-format off
+  const uint8_t kPacket[] = {
+      0x90, kPayloadType, 0x00, kSeqNum,
+      0x65, 0x43, 0x12, 0x78,  // kTimestamp.
+      0x12, 0x34, 0x56, 0x78,  // kSsrc.
+      0xbe, 0xde, 0x00, 0x02,  // Extension of size 2x32bit word.
+      0x31, 0x11, 0x22,        // Unknown extension.
+      0x72, 0xa9, 0x02, 0x05,  // Scalable FrameMarking.
+      0x00,                    // Padding to 32bit boundary.
+  };
+  // clang-format on
+  ASSERT_EQ(sizeof(kPacket) % 4, 0u);
+
+  RtpHeaderExtensionMap extensions;
+  extensions.Register<FrameMarking>(7);
+  RtpUtility::RtpHeaderParser parser(kPacket, sizeof(kPacket));
+  RTPHeader header;
+
+  EXPECT_TRUE(parser.Parse(&header, &extensions));
+
+  EXPECT_TRUE(header.extension.frameMarks.startOfFrame);
+  EXPECT_FALSE(header.extension.frameMarks.endOfFrame);
+  EXPECT_TRUE(header.extension.frameMarks.independent);
+  EXPECT_TRUE(header.extension.frameMarks.baseLayerSync);
+  EXPECT_EQ(1, header.extension.frameMarks.temporalLayerId);
+  EXPECT_EQ(2, header.extension.frameMarks.spatialLayerId);
+  EXPECT_EQ(5, header.extension.frameMarks.tl0PicIdx);
+}
+
 TEST(RtpHeaderParser, ParseWithCsrcsExtensionAndPadding) {
   const uint8_t kPacketPaddingSize = 8;
   const uint32_t kCsrcs[] = {0x34567890, 0x32435465};
@@ -99,7 +99,9 @@ UlpfecGenerator::UlpfecGenerator()
 UlpfecGenerator::UlpfecGenerator(std::unique_ptr<ForwardErrorCorrection> fec)
     : fec_(std::move(fec)),
       num_protected_frames_(0),
-      min_num_media_packets_(1) {
+      min_num_media_packets_(1),
+      streaming_(false),
+      streaming_num_packets_(0) {
   memset(&params_, 0, sizeof(params_));
   memset(&new_params_, 0, sizeof(new_params_));
 }
@@ -133,11 +135,32 @@ void UlpfecGenerator::SetFecParameters(const FecProtectionParams& params) {
   }
 }
 
+void UlpfecGenerator::StartFrame(size_t num_packets) {
+  RTC_DCHECK(generated_fec_packets_.empty());
+  streaming_ = false;
+  // A group already spanning earlier frames is completed the usual way.
+  if (!media_packets_.empty() || num_packets == 0 ||
+      num_packets > kUlpfecMaxMediaPackets) {
+    return;
+  }
+  params_ = new_params_;
+  // Same conditions as in AddRtpPacketAndGenerateFec, for a group of one
+  // frame.
+  if (params_.max_fec_frames != 1 &&
+      !(ExcessOverheadBelowMax(num_packets) &&
+        MinimumMediaPacketsReached(num_packets, 1))) {
+    return;
+  }
+  streaming_ = fec_->StartFecGroup(num_packets, params_.fec_rate,
+                                   params_.fec_mask_type) > 0;
+  streaming_num_packets_ = num_packets;
+}
+
 int UlpfecGenerator::AddRtpPacketAndGenerateFec(const uint8_t* data_buffer,
                                                 size_t payload_length,
                                                 size_t rtp_header_length) {
   RTC_DCHECK(generated_fec_packets_.empty());
-  if (media_packets_.empty()) {
+  if (media_packets_.empty() && !streaming_) {
     params_ = new_params_;
   }
   bool complete_frame = false;
@@ -154,13 +177,30 @@ int UlpfecGenerator::AddRtpPacketAndGenerateFec(const uint8_t* data_buffer,
     ++num_protected_frames_;
     complete_frame = true;
   }
+  if (streaming_) {
+    int ret = fec_->AddMediaPacketToFecGroup(*media_packets_.back(),
+                                             &generated_fec_packets_);
+    if (ret == 0 && !complete_frame &&
+        media_packets_.size() < streaming_num_packets_) {
+      return 0;
+    }
+    // Either the group is complete, or the frame did not match what
+    // StartFrame was told and the FEC packets not completed yet are dropped.
+    streaming_ = false;
+    if (generated_fec_packets_.empty()) {
+      ResetState();
+    }
+    return ret;
+  }
   // Produce FEC over at most |params_.max_fec_frames| frames, or as soon as:
   // (1) the excess overhead (actual overhead - requested/target overhead) is
   // less than |kMaxExcessOverhead|, and
   // (2) at least |min_num_media_packets_| media packets is reached.
   if (complete_frame &&
       (num_protected_frames_ == params_.max_fec_frames ||
-       (ExcessOverheadBelowMax() && MinimumMediaPacketsReached()))) {
+       (ExcessOverheadBelowMax(media_packets_.size()) &&
+        MinimumMediaPacketsReached(media_packets_.size(),
+                                   num_protected_frames_)))) {
     // We are not using Unequal Protection feature of the parity erasure code.
     constexpr int kNumImportantPackets = 0;
     constexpr bool kUseUnequalProtection = false;
@@ -175,20 +215,21 @@ int UlpfecGenerator::AddRtpPacketAndGenerateFec(const uint8_t* data_buffer,
   return 0;
 }
 
-bool UlpfecGenerator::ExcessOverheadBelowMax() const {
-  return ((Overhead() - params_.fec_rate) < kMaxExcessOverhead);
+bool UlpfecGenerator::ExcessOverheadBelowMax(size_t num_media_packets) const {
+  return ((Overhead(num_media_packets) - params_.fec_rate) <
+          kMaxExcessOverhead);
 }
 
-bool UlpfecGenerator::MinimumMediaPacketsReached() const {
+bool UlpfecGenerator::MinimumMediaPacketsReached(size_t num_media_packets,
+                                                 int num_frames) const {
   float average_num_packets_per_frame =
-      static_cast<float>(media_packets_.size()) / num_protected_frames_;
-  int num_media_packets = static_cast<int>(media_packets_.size());
+      static_cast<float>(num_media_packets) / num_frames;
   if (average_num_packets_per_frame < kMinMediaPacketsAdaptationThreshold) {
-    return num_media_packets >= min_num_media_packets_;
+    return static_cast<int>(num_media_packets) >= min_num_media_packets_;
   } else {
     // For larger rates (more packets/frame), increase the threshold.
     // TODO(brandtr): Investigate what impact this adaptation has.
-    return num_media_packets >= min_num_media_packets_ + 1;
+    return static_cast<int>(num_media_packets) >= min_num_media_packets_ + 1;
   }
 }
 
@@ -229,23 +270,27 @@ std::vector<std::unique_ptr<RedPacket>> UlpfecGenerator::GetUlpfecPacketsAsRed(
     red_packets.push_back(std::move(red_packet));
   }
 
-  ResetState();
+  generated_fec_packets_.clear();
+  // While streaming, the rest of the group's FEC packets are still to come.
+  if (!streaming_)
+    ResetState();
 
   return red_packets;
 }
 
-int UlpfecGenerator::Overhead() const {
-  RTC_DCHECK(!media_packets_.empty());
+int UlpfecGenerator::Overhead(size_t num_media_packets) const {
+  RTC_DCHECK_GT(num_media_packets, 0);
   int num_fec_packets =
-      fec_->NumFecPackets(media_packets_.size(), params_.fec_rate);
+      fec_->NumFecPackets(num_media_packets, params_.fec_rate);
   // Return the overhead in Q8.
-  return (num_fec_packets << 8) / media_packets_.size();
+  return (num_fec_packets << 8) / num_media_packets;
 }
 
 void UlpfecGenerator::ResetState() {
   media_packets_.clear();
   generated_fec_packets_.clear();
   num_protected_frames_ = 0;
+  streaming_ = false;
 }
 
 }  // namespace webrtc
@@ -55,6 +55,13 @@ class UlpfecGenerator {
 
   void SetFecParameters(const FecProtectionParams& params);
 
+  // Announces that the next |num_packets| packets added make up one frame.
+  // When that frame completes an FEC group on its own, the FEC packets are
+  // generated while the media packets are added, and each one is available
+  // as soon as the last media packet it protects has been added instead of
+  // after the whole frame.
+  void StartFrame(size_t num_packets);
+
   // Adds a media packet to the internal buffer. When enough media packets
   // have been added, the FEC packets are generated and stored internally.
   // These FEC packets are then obtained by calling GetFecPacketsAsRed().
@@ -84,20 +91,21 @@ class UlpfecGenerator {
   // relative to total number of packets. This definition is inherited from the
   // protection factor produced by video_coding module and how the FEC
   // generation is implemented.
-  int Overhead() const;
+  int Overhead(size_t num_media_packets) const;
 
   // Returns true if the excess overhead (actual - target) for the FEC is below
   // the amount |kMaxExcessOverhead|. This effects the lower protection level
   // cases and low number of media packets/frame. The target overhead is given
   // by |params_.fec_rate|, and is only achievable in the limit of large number
   // of media packets.
-  bool ExcessOverheadBelowMax() const;
+  bool ExcessOverheadBelowMax(size_t num_media_packets) const;
 
   // Returns true if the number of added media packets is at least
   // |min_num_media_packets_|. This condition tries to capture the effect
   // that, for the same amount of protection/overhead, longer codes
   // (e.g. (2k,2m) vs (k,m)) are generally more effective at recovering losses.
-  bool MinimumMediaPacketsReached() const;
+  bool MinimumMediaPacketsReached(size_t num_media_packets,
+                                  int num_frames) const;
 
   void ResetState();
 
@@ -108,6 +116,10 @@ class UlpfecGenerator {
   int min_num_media_packets_;
   FecProtectionParams params_;
   FecProtectionParams new_params_;
+  // Set while the FEC packets of the current frame are generated as its
+  // media packets are added, see StartFrame().
+  bool streaming_;
+  size_t streaming_num_packets_;
 };
 
 }  // namespace webrtc
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <list>
 #include <memory>
 #include <utility>
@@ -167,6 +168,51 @@ TEST_F(UlpfecGeneratorTest, TwoFrameFec) {
                red_packets.front().get(), false);
 }
 
+// Announcing the frame size gets each FEC packet out right after the last
+// media packet it protects, with the same content as generating FEC for the
+// whole frame at its end.
+TEST_F(UlpfecGeneratorTest, StreamsFecPacketsWithinFrame) {
+  constexpr size_t kNumPackets = 8;
+  FecProtectionParams params = {128, 1, kFecMaskBursty};
+  UlpfecGenerator batch_generator;
+  batch_generator.SetFecParameters(params);
+  ulpfec_generator_.SetFecParameters(params);
+
+  packet_generator_.NewFrame(kNumPackets);
+  ulpfec_generator_.StartFrame(kNumPackets);
+  std::vector<std::vector<uint8_t>> streamed_payloads;
+  bool fec_before_last_packet = false;
+  for (size_t i = 0; i < kNumPackets; ++i) {
+    std::unique_ptr<AugmentedPacket> packet =
+        packet_generator_.NextPacket(i, 10 + i);
+    EXPECT_EQ(0, ulpfec_generator_.AddRtpPacketAndGenerateFec(
+                     packet->data, packet->length, kRtpHeaderSize));
+    EXPECT_EQ(0, batch_generator.AddRtpPacketAndGenerateFec(
+                     packet->data, packet->length, kRtpHeaderSize));
+    if (!ulpfec_generator_.FecAvailable())
+      continue;
+    fec_before_last_packet |= i + 1 < kNumPackets;
+    for (const auto& red_packet : ulpfec_generator_.GetUlpfecPacketsAsRed(
+             kRedPayloadType, kFecPayloadType, 0, kRtpHeaderSize)) {
+      streamed_payloads.emplace_back(red_packet->data() + kRtpHeaderSize,
+                                     red_packet->data() + red_packet->length());
+    }
+  }
+  EXPECT_TRUE(fec_before_last_packet);
+  EXPECT_FALSE(ulpfec_generator_.FecAvailable());
+
+  std::vector<std::vector<uint8_t>> batch_payloads;
+  for (const auto& red_packet : batch_generator.GetUlpfecPacketsAsRed(
+           kRedPayloadType, kFecPayloadType, 0, kRtpHeaderSize)) {
+    batch_payloads.emplace_back(red_packet->data() + kRtpHeaderSize,
+                                red_packet->data() + red_packet->length());
+  }
+  ASSERT_EQ(4u, batch_payloads.size());
+  std::sort(streamed_payloads.begin(), streamed_payloads.end());
+  std::sort(batch_payloads.begin(), batch_payloads.end());
+  EXPECT_EQ(batch_payloads, streamed_payloads);
+}
+
 TEST_F(UlpfecGeneratorTest, BuildRedPacket) {
   packet_generator_.NewFrame(1);
   std::unique_ptr<AugmentedPacket> packet = packet_generator_.NextPacket(0, 10);
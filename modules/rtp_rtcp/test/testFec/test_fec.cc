@@ -20,6 +20,7 @@
 
 #include "webrtc/base/random.h"
 #include "webrtc/modules/rtp_rtcp/source/byte_io.h"
+#include "webrtc/modules/rtp_rtcp/source/fec_private_tables_bursty.h"
 #include "webrtc/modules/rtp_rtcp/source/forward_error_correction.h"
 #include "webrtc/modules/rtp_rtcp/source/forward_error_correction_internal.h"
 #include "webrtc/test/gtest.h"
@@ -28,9 +29,6 @@
 // #define VERBOSE_OUTPUT
 
 namespace webrtc {
-namespace fec_private_tables {
-extern const uint8_t** kPacketMaskBurstyTbl[12];
-}
 namespace test {
 using fec_private_tables::kPacketMaskBurstyTbl;
 
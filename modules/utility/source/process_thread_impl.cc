@@ -72,8 +72,8 @@ void ProcessThreadImpl::Start() {
     // the modules_ collection even on the controller thread.
     // Once we've cleaned up those places, we can remove this lock.
     rtc::CritScope lock(&lock_);
-    for (ModuleCallback& m : modules_)
-      m.module->ProcessThreadAttached(this);
+    for (auto& m : modules_)
+      m.first->ProcessThreadAttached(this);
   }
 
   thread_.reset(
@@ -104,18 +104,17 @@ void ProcessThreadImpl::Stop() {
   // Once we've cleaned up those places, we can remove this lock.
   rtc::CritScope lock(&lock_);
   thread_.reset();
-  for (ModuleCallback& m : modules_)
-    m.module->ProcessThreadAttached(nullptr);
+  for (auto& m : modules_)
+    m.first->ProcessThreadAttached(nullptr);
 }
 
 void ProcessThreadImpl::WakeUp(Module* module) {
   // Allowed to be called on any thread.
   {
     rtc::CritScope lock(&lock_);
-    for (ModuleCallback& m : modules_) {
-      if (m.module == module)
-        m.next_callback = kCallProcessImmediately;
-    }
+    auto it = modules_.find(module);
+    if (it != modules_.end())
+      Reschedule(it, kCallProcessImmediately);
   }
   wake_up_->Set();
 }
@@ -137,8 +136,7 @@ void ProcessThreadImpl::RegisterModule(Module* module) {
   {
     // Catch programmer error.
     rtc::CritScope lock(&lock_);
-    for (const ModuleCallback& mc : modules_)
-      RTC_DCHECK(mc.module != module);
+    RTC_DCHECK(modules_.find(module) == modules_.end());
   }
 #endif
 
@@ -150,7 +148,8 @@ void ProcessThreadImpl::RegisterModule(Module* module) {
 
   {
     rtc::CritScope lock(&lock_);
-    modules_.push_back(ModuleCallback(module));
+    modules_[module] = 0;
+    schedule_.insert(std::make_pair(0, module));
   }
 
   // Wake the thread calling ProcessThreadImpl::Process() to update the
@@ -166,9 +165,11 @@ void ProcessThreadImpl::DeRegisterModule(Module* module) {
 
   {
     rtc::CritScope lock(&lock_);
-    modules_.remove_if([&module](const ModuleCallback& m) {
-        return m.module == module;
-      });
+    auto it = modules_.find(module);
+    if (it != modules_.end()) {
+      schedule_.erase(std::make_pair(it->second, module));
+      modules_.erase(it);
+    }
 
     // TODO(tommi): we currently need to hold the lock while calling out to
     // ProcessThreadAttached.  This is to make sure that the thread hasn't been
@@ -196,28 +197,43 @@ bool ProcessThreadImpl::Process() {
     rtc::CritScope lock(&lock_);
     if (stop_)
       return false;
-    for (ModuleCallback& m : modules_) {
+    // Newly registered modules (next callback 0) and modules that have been
+    // woken up (kCallProcessImmediately) sort first, followed by the modules
+    // whose next callback is due. The modules that aren't due aren't visited.
+    due_modules_.clear();
+    auto due_end = schedule_.begin();
+    for (; due_end != schedule_.end() && due_end->first <= now; ++due_end)
+      due_modules_.push_back(due_end->second);
+    schedule_.erase(schedule_.begin(), due_end);
+
+    for (Module* module : due_modules_) {
+      // A module may deregister, or wake up, a module in |due_modules_| from
+      // its Process call.
+      auto it = modules_.find(module);
+      if (it == modules_.end())
+        continue;
+      int64_t next_callback = it->second;
       // TODO(tommi): Would be good to measure the time TimeUntilNextProcess
       // takes and dcheck if it takes too long (e.g. >=10ms).  Ideally this
       // operation should not require taking a lock, so querying all modules
       // should run in a matter of nanoseconds.
-      if (m.next_callback == 0)
-        m.next_callback = GetNextCallbackTime(m.module, now);
+      if (next_callback == 0)
+        next_callback = GetNextCallbackTime(module, now);
 
-      if (m.next_callback <= now ||
-          m.next_callback == kCallProcessImmediately) {
-        m.module->Process();
+      if (next_callback <= now) {
+        module->Process();
         // Use a new 'now' reference to calculate when the next callback
         // should occur.  We'll continue to use 'now' above for the baseline
         // of calculating how long we should wait, to reduce variance.
         int64_t new_now = rtc::TimeMillis();
-        m.next_callback = GetNextCallbackTime(m.module, new_now);
+        next_callback = GetNextCallbackTime(module, new_now);
       }
-
-      if (m.next_callback < next_checkpoint)
-        next_checkpoint = m.next_callback;
+      Reschedule(it, next_callback);
     }
 
+    if (!schedule_.empty() && schedule_.begin()->first < next_checkpoint)
+      next_checkpoint = schedule_.begin()->first;
+
     while (!queue_.empty()) {
       rtc::QueuedTask* task = queue_.front();
       queue_.pop();
@@ -234,4 +250,11 @@ bool ProcessThreadImpl::Process() {
 
   return true;
 }
+
+void ProcessThreadImpl::Reschedule(ModuleMap::iterator module,
+                                   int64_t next_callback) {
+  schedule_.erase(std::make_pair(module->second, module->first));
+  module->second = next_callback;
+  schedule_.insert(std::make_pair(next_callback, module->first));
+}
 }  // namespace webrtc
@@ -11,9 +11,12 @@
 #ifndef WEBRTC_MODULES_UTILITY_SOURCE_PROCESS_THREAD_IMPL_H_
 #define WEBRTC_MODULES_UTILITY_SOURCE_PROCESS_THREAD_IMPL_H_
 
-#include <list>
+#include <map>
 #include <memory>
 #include <queue>
+#include <set>
+#include <utility>
+#include <vector>
 
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/platform_thread.h"
@@ -43,23 +46,15 @@ class ProcessThreadImpl : public ProcessThread {
   bool Process();
 
  private:
-  struct ModuleCallback {
-    ModuleCallback() : module(nullptr), next_callback(0) {}
-    ModuleCallback(const ModuleCallback& cb)
-        : module(cb.module), next_callback(cb.next_callback) {}
-    ModuleCallback(Module* module) : module(module), next_callback(0) {}
-    bool operator==(const ModuleCallback& cb) const {
-      return cb.module == module;
-    }
+  // Maps each module to the absolute time of its next callback. A time of 0
+  // means that TimeUntilNextProcess hasn't been asked yet.
+  typedef std::map<Module*, int64_t> ModuleMap;
+  // The modules ordered by the time of their next callback, so that Process
+  // only visits the modules that are due instead of all of them.
+  typedef std::set<std::pair<int64_t, Module*>> Schedule;
 
-    Module* const module;
-    int64_t next_callback;  // Absolute timestamp.
-
-   private:
-    ModuleCallback& operator=(ModuleCallback&);
-  };
-
-  typedef std::list<ModuleCallback> ModuleList;
+  // Moves |module| to |next_callback| in |schedule_|.
+  void Reschedule(ModuleMap::iterator module, int64_t next_callback);
 
   // Warning: For some reason, if |lock_| comes immediately before |modules_|
   // with the current class layout, we will  start to have mysterious crashes
@@ -67,14 +62,18 @@ class ProcessThreadImpl : public ProcessThread {
   // issues, but I haven't figured out what they are, if there are alignment
   // requirements for mutexes on Mac or if there's something else to it.
   // So be careful with changing the layout.
-  rtc::CriticalSection lock_;  // Used to guard modules_, tasks_ and stop_.
+  rtc::CriticalSection lock_;  // Used to guard modules_, schedule_, tasks_
+                               // and stop_.
 
   rtc::ThreadChecker thread_checker_;
   const std::unique_ptr<EventWrapper> wake_up_;
   // TODO(pbos): Remove unique_ptr and stop recreating the thread.
   std::unique_ptr<rtc::PlatformThread> thread_;
 
-  ModuleList modules_;
+  ModuleMap modules_;
+  Schedule schedule_;
+  // Scratch space for Process, kept to reuse its capacity.
+  std::vector<Module*> due_modules_;
   std::queue<rtc::QueuedTask*> queue_;
   bool stop_;
   const char* thread_name_;
@@ -299,6 +299,34 @@ TEST(ProcessThreadImpl, WakeUp) {
   EXPECT_LE(diff, 100u);
 }
 
+// Tests that a module that isn't due is neither queried nor processed while
+// another module is processed repeatedly.
+TEST(ProcessThreadImpl, ModuleNotDueIsNotVisited) {
+  ProcessThreadImpl thread("ProcessThread");
+  std::unique_ptr<EventWrapper> event(EventWrapper::Create());
+
+  MockModule idle_module;
+  EXPECT_CALL(idle_module, TimeUntilNextProcess()).WillOnce(Return(10000));
+  EXPECT_CALL(idle_module, Process()).Times(0);
+  EXPECT_CALL(idle_module, ProcessThreadAttached(_)).Times(2);
+
+  int process_count = 0;
+  MockModule busy_module;
+  EXPECT_CALL(busy_module, TimeUntilNextProcess()).WillRepeatedly(Return(1));
+  EXPECT_CALL(busy_module, Process())
+      .WillRepeatedly(DoAll(Increment(&process_count), Invoke([&] {
+                              if (process_count == 10)
+                                event->Set();
+                            })));
+  EXPECT_CALL(busy_module, ProcessThreadAttached(_)).Times(2);
+
+  thread.RegisterModule(&idle_module);
+  thread.RegisterModule(&busy_module);
+  thread.Start();
+  EXPECT_EQ(kEventSignaled, event->Wait(kEventWaitTimeout));
+  thread.Stop();
+}
+
 // Tests that we can post a task that gets run straight away on the worker
 // thread.
 TEST(ProcessThreadImpl, PostTask) {
@@ -353,6 +353,46 @@ TEST_F(VideoCaptureTest, DISABLED_TestTwoCameras) {
 
 // Test class for testing external capture and capture feedback information
 // such as frame rate and picture alarm.
+class HalfSizeFrameAdapter : public VideoCaptureModule::FrameAdapter {
+ public:
+  HalfSizeFrameAdapter() : drop_frames_(false) {}
+
+  bool AdaptCapturedFrame(int width,
+                          int height,
+                          int64_t timestamp_us,
+                          int* out_width,
+                          int* out_height,
+                          int* crop_width,
+                          int* crop_height,
+                          int* crop_x,
+                          int* crop_y) override {
+    *out_width = width / 2;
+    *out_height = height / 2;
+    *crop_width = width;
+    *crop_height = height;
+    *crop_x = 0;
+    *crop_y = 0;
+    return !drop_frames_;
+  }
+
+  bool drop_frames_;
+};
+
+class FrameSizeSink : public rtc::VideoSinkInterface<webrtc::VideoFrame> {
+ public:
+  FrameSizeSink() : frames_(0), width_(0), height_(0) {}
+
+  void OnFrame(const webrtc::VideoFrame& frame) override {
+    ++frames_;
+    width_ = frame.width();
+    height_ = frame.height();
+  }
+
+  int frames_;
+  int width_;
+  int height_;
+};
+
 class VideoCaptureExternalTest : public testing::Test {
  public:
   void SetUp() {
@@ -403,6 +443,36 @@ TEST_F(VideoCaptureExternalTest, TestExternalCapture) {
   EXPECT_TRUE(capture_callback_.CompareLastFrame(*test_frame_));
 }
 
+TEST_F(VideoCaptureExternalTest, ScalesWhenConvertingWithFrameAdapter) {
+  HalfSizeFrameAdapter adapter;
+  FrameSizeSink sink;
+  capture_module_->RegisterCaptureDataCallback(&sink);
+  capture_module_->RegisterFrameAdapter(&adapter);
+  size_t length = webrtc::CalcBufferSize(webrtc::kI420,
+                                         test_frame_->width(),
+                                         test_frame_->height());
+  std::unique_ptr<uint8_t[]> test_buffer(new uint8_t[length]);
+  webrtc::ExtractBuffer(*test_frame_, length, test_buffer.get());
+
+  // YV12 is converted, I420 is scaled straight from the captured frame.
+  VideoCaptureCapability capability = capture_callback_.capability();
+  EXPECT_EQ(0, capture_input_interface_->IncomingFrame(test_buffer.get(),
+      length, capability, 0));
+  capability.rawType = webrtc::kVideoI420;
+  EXPECT_EQ(0, capture_input_interface_->IncomingFrame(test_buffer.get(),
+      length, capability, 0));
+  EXPECT_EQ(2, sink.frames_);
+  EXPECT_EQ(kTestWidth / 2, sink.width_);
+  EXPECT_EQ(kTestHeight / 2, sink.height_);
+
+  adapter.drop_frames_ = true;
+  EXPECT_EQ(0, capture_input_interface_->IncomingFrame(test_buffer.get(),
+      length, capability, 0));
+  EXPECT_EQ(2, sink.frames_);
+  capture_module_->RegisterFrameAdapter(nullptr);
+  capture_module_->DeRegisterCaptureDataCallback();
+}
+
 TEST_F(VideoCaptureExternalTest, Rotation) {
   EXPECT_EQ(0, capture_module_->SetCaptureRotation(webrtc::kVideoRotation_0));
   size_t length = webrtc::CalcBufferSize(webrtc::kI420,
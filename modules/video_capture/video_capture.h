@@ -76,9 +76,34 @@ class VideoCaptureModule: public rtc::RefCountInterface {
     virtual ~DeviceInfo() {}
   };
 
+  // Interface for adapting the resolution of raw captured frames as part of
+  // their conversion to I420, so that frames which are going to be cropped
+  // or downscaled are not first converted in full.
+  class FrameAdapter {
+   public:
+    // Called with the size of a raw frame, after any rotation is applied.
+    // Returns false if the frame should be dropped, otherwise sets the
+    // region of the frame to crop and the size to scale it to.
+    virtual bool AdaptCapturedFrame(int width,
+                                    int height,
+                                    int64_t timestamp_us,
+                                    int* out_width,
+                                    int* out_height,
+                                    int* crop_width,
+                                    int* crop_height,
+                                    int* crop_x,
+                                    int* crop_y) = 0;
+
+   protected:
+    virtual ~FrameAdapter() {}
+  };
+
   //   Register capture data callback
   virtual void RegisterCaptureDataCallback(
       rtc::VideoSinkInterface<VideoFrame> *dataCallback) = 0;
+  // Register an adapter for the raw captured frames, or nullptr to deliver
+  // them at the captured resolution.
+  virtual void RegisterFrameAdapter(FrameAdapter* adapter) {}
 
   //  Remove capture data callback
   virtual void DeRegisterCaptureDataCallback() = 0;
@@ -16,6 +16,7 @@
 #include "webrtc/base/refcount.h"
 #include "webrtc/base/timeutils.h"
 #include "webrtc/base/trace_event.h"
+#include "webrtc/common_video/include/video_frame_buffer.h"
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
 #include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/modules/video_capture/video_capture_config.h"
@@ -89,7 +90,8 @@ VideoCaptureImpl::VideoCaptureImpl()
       _dataCallBack(NULL),
       _lastProcessFrameTimeNanos(rtc::TimeNanos()),
       _rotateFrame(kVideoRotation_0),
-      apply_rotation_(false) {
+      apply_rotation_(false),
+      frame_adapter_(nullptr) {
     _requestedCapability.width = kDefaultWidth;
     _requestedCapability.height = kDefaultHeight;
     _requestedCapability.maxFPS = 30;
@@ -117,6 +119,12 @@ void VideoCaptureImpl::DeRegisterCaptureDataCallback() {
     CriticalSectionScoped cs(&_apiCs);
     _dataCallBack = NULL;
 }
+
+void VideoCaptureImpl::RegisterFrameAdapter(FrameAdapter* adapter) {
+    CriticalSectionScoped cs(&_apiCs);
+    frame_adapter_ = adapter;
+}
+
 int32_t VideoCaptureImpl::DeliverCapturedFrame(VideoFrame& captureFrame) {
   UpdateFrameCount();  // frame count used for local frame rate callback.
 
@@ -154,13 +162,13 @@ int32_t VideoCaptureImpl::IncomingFrame(
             return -1;
         }
 
-        int stride_y = width;
-        int stride_uv = (width + 1) / 2;
         int target_width = width;
         int target_height = height;
 
         // SetApplyRotation doesn't take any lock. Make a local copy here.
         bool apply_rotation = apply_rotation_;
+        const VideoRotation rotation =
+            apply_rotation ? _rotateFrame : kVideoRotation_0;
 
         if (apply_rotation) {
           // Rotating resolution when for 90/270 degree rotations.
@@ -175,18 +183,71 @@ int32_t VideoCaptureImpl::IncomingFrame(
         // In Windows, the image starts bottom left, instead of top left.
         // Setting a negative source height, inverts the image (within LibYuv).
 
-        // TODO(nisse): Use a pool?
-        rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(
-            target_width, abs(target_height), stride_y, stride_uv, stride_uv);
-        const int conversionResult = ConvertToI420(
-            commonVideoType, videoFrame, 0, 0,  // No cropping
-            width, height, videoFrameLength,
-            apply_rotation ? _rotateFrame : kVideoRotation_0, buffer.get());
-        if (conversionResult < 0)
-        {
-          LOG(LS_ERROR) << "Failed to convert capture frame from type "
-                        << frameInfo.rawType << "to I420.";
-            return -1;
+        target_height = abs(target_height);
+        int out_width = target_width;
+        int out_height = target_height;
+        int crop_width = target_width;
+        int crop_height = target_height;
+        int crop_x = 0;
+        int crop_y = 0;
+        if (frame_adapter_ &&
+            !frame_adapter_->AdaptCapturedFrame(
+                target_width, target_height, rtc::TimeMicros(), &out_width,
+                &out_height, &crop_width, &crop_height, &crop_x, &crop_y)) {
+            return 0;  // Dropped by the adapter.
+        }
+        // Keep the chroma planes aligned with the luma plane.
+        crop_x &= ~1;
+        crop_y &= ~1;
+
+        rtc::scoped_refptr<I420Buffer> buffer;
+        if (commonVideoType == kI420 && rotation == kVideoRotation_0 &&
+            height > 0) {
+            // Crop and scale straight from the captured memory.
+            const int stride_uv = (width + 1) / 2;
+            const uint8_t* plane_u = videoFrame + width * height;
+            const uint8_t* plane_v = plane_u + stride_uv * ((height + 1) / 2);
+            rtc::scoped_refptr<VideoFrameBuffer> captured(
+                new rtc::RefCountedObject<WrappedI420Buffer>(
+                    width, height, videoFrame, width, plane_u, stride_uv,
+                    plane_v, stride_uv, rtc::Callback0<void>()));
+            buffer = scaled_buffer_pool_.CreateBuffer(out_width, out_height);
+            buffer->CropAndScaleFrom(*captured, crop_x, crop_y, crop_width,
+                                     crop_height);
+        } else {
+            // Without rotation, only the cropped region is converted, and
+            // what remains is scaling.
+            const bool crop_when_converting = rotation == kVideoRotation_0;
+            rtc::scoped_refptr<I420Buffer> converted =
+                crop_when_converting
+                    ? conversion_buffer_pool_.CreateBuffer(crop_width,
+                                                           crop_height)
+                    : conversion_buffer_pool_.CreateBuffer(target_width,
+                                                           target_height);
+            const int conversionResult = ConvertToI420(
+                commonVideoType, videoFrame,
+                crop_when_converting ? crop_x : 0,
+                crop_when_converting ? crop_y : 0, width, height,
+                videoFrameLength, rotation, converted.get());
+            if (conversionResult < 0)
+            {
+              LOG(LS_ERROR) << "Failed to convert capture frame from type "
+                            << frameInfo.rawType << "to I420.";
+                return -1;
+            }
+            if (out_width == converted->width() &&
+                out_height == converted->height()) {
+                buffer = converted;
+            } else {
+                buffer = scaled_buffer_pool_.CreateBuffer(out_width,
+                                                          out_height);
+                if (crop_when_converting) {
+                    buffer->ScaleFrom(*converted);
+                } else {
+                    buffer->CropAndScaleFrom(*converted, crop_x, crop_y,
+                                             crop_width, crop_height);
+                }
+            }
         }
 
         VideoFrame captureFrame(
@@ -17,6 +17,7 @@
 
 #include "webrtc/api/video/video_frame.h"
 #include "webrtc/base/scoped_ref_ptr.h"
+#include "webrtc/common_video/include/i420_buffer_pool.h"
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
 #include "webrtc/modules/video_capture/video_capture.h"
 #include "webrtc/modules/video_capture/video_capture_config.h"
@@ -60,6 +61,7 @@ public:
     void RegisterCaptureDataCallback(
         rtc::VideoSinkInterface<VideoFrame>* dataCallback) override;
     void DeRegisterCaptureDataCallback() override;
+    void RegisterFrameAdapter(FrameAdapter* adapter) override;
 
     int32_t SetCaptureRotation(VideoRotation rotation) override;
     bool SetApplyRotation(bool enable) override;
@@ -115,6 +117,12 @@ private:
 
     // Indicate whether rotation should be applied before delivered externally.
     bool apply_rotation_;
+
+    FrameAdapter* frame_adapter_;
+    // Buffers for frames converted to I420, and for the frames delivered
+    // when they are cropped or scaled.
+    I420BufferPool conversion_buffer_pool_;
+    I420BufferPool scaled_buffer_pool_;
 };
 }  // namespace videocapturemodule
 }  // namespace webrtc
@@ -231,6 +231,14 @@ bool VCMCodecDataBase::SetSendCodec(const VideoCodec* send_codec,
 
   if (!reset_required) {
     reset_required = RequiresEncoderReset(new_send_codec);
+    // Let the encoder apply the change in place if it can, e.g. a new
+    // resolution. A new InitEncode() restarts rate control and the reference
+    // state, which is costly when the quality scaler changes resolution often.
+    if (reset_required && ptr_encoder_ &&
+        ptr_encoder_->ReconfigureEncode(&new_send_codec) == 0) {
+      LOG(LS_INFO) << "Reconfigured video encoder without reinitializing it.";
+      reset_required = false;
+    }
   }
 
   memcpy(&send_codec_, &new_send_codec, sizeof(send_codec_));
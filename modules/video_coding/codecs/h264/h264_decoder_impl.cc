@@ -33,6 +33,8 @@ namespace webrtc {
 namespace {
 
 const AVPixelFormat kPixelFormat = AV_PIX_FMT_YUV420P;
+// Max number of threads decoding the slices of a frame.
+const int kMaxSliceThreads = 8;
 const size_t kYPlaneIndex = 0;
 const size_t kUPlaneIndex = 1;
 const size_t kVPlaneIndex = 2;
@@ -228,9 +230,14 @@ int32_t H264DecoderImpl::InitDecode(const VideoCodec* codec_settings,
   av_context_->extradata = nullptr;
   av_context_->extradata_size = 0;
 
-  // If this is ever increased, look at |av_context_->thread_safe_callbacks| and
-  // make it possible to disable the thread checker in the frame buffer pool.
-  av_context_->thread_count = 1;
+  // Frames with multiple slices are decoded with one thread per core. Frame
+  // threading isn't used since it delays the output by one frame per thread.
+  // With slice threading |AVGetBuffer2| is only called on the decoding thread.
+  // If frame threading is ever enabled, look at
+  // |av_context_->thread_safe_callbacks| and make it possible to disable the
+  // thread checker in the frame buffer pool.
+  av_context_->thread_count =
+      std::max(1, std::min<int>(number_of_cores, kMaxSliceThreads));
   av_context_->thread_type = FF_THREAD_SLICE;
 
   // Function used by FFmpeg to get buffers to store decoded frames in.
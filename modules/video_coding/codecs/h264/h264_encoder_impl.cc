@@ -23,6 +23,7 @@
 #include "webrtc/base/logging.h"
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
 #include "webrtc/media/base/mediaconstants.h"
+#include "webrtc/modules/video_coding/utility/encoder_thread_budget.h"
 #include "webrtc/system_wrappers/include/metrics.h"
 
 namespace webrtc {
@@ -165,6 +166,8 @@ H264EncoderImpl::H264EncoderImpl(const cricket::VideoCodec& codec)
       packetization_mode_(H264PacketizationMode::SingleNalUnit),
       max_payload_size_(0),
       number_of_cores_(0),
+      thread_budget_id_(-1),
+      num_threads_(1),
       encoded_image_callback_(nullptr),
       has_reported_init_(false),
       has_reported_error_(false) {
@@ -232,6 +235,14 @@ int32_t H264EncoderImpl::InitEncode(const VideoCodec* codec_settings,
   key_frame_interval_ = codec_settings->H264().keyFrameInterval;
   max_payload_size_ = max_payload_size;
 
+  // Take threads from the budget shared by all encoders in the process.
+  // OpenH264 can't change its thread count without being reinitialized, so
+  // unlike VP8 and VP9 the grant is only followed on the next InitEncode.
+  thread_budget_id_ = EncoderThreadBudget::GetInstance()->Register(
+      NumberOfThreads(width_, height_, number_of_cores_));
+  num_threads_ =
+      EncoderThreadBudget::GetInstance()->GetGrantedThreads(thread_budget_id_);
+
   // Codec_settings uses kbits/second; encoder uses bits/second.
   max_bps_ = codec_settings->maxBitrate * 1000;
   if (codec_settings->targetBitrate == 0)
@@ -266,6 +277,10 @@ int32_t H264EncoderImpl::InitEncode(const VideoCodec* codec_settings,
 }
 
 int32_t H264EncoderImpl::Release() {
+  if (thread_budget_id_ != -1) {
+    EncoderThreadBudget::GetInstance()->Unregister(thread_budget_id_);
+    thread_budget_id_ = -1;
+  }
   if (openh264_encoder_) {
     RTC_CHECK_EQ(0, openh264_encoder_->Uninitialize());
     WelsDestroySVCEncoder(openh264_encoder_);
@@ -435,8 +450,7 @@ SEncParamExt H264EncoderImpl::CreateEncoderParams() const {
   //  0: auto (dynamic imp. internal encoder)
   //  1: single thread (default value)
   // >1: number of threads
-  encoder_params.iMultipleThreadIdc = NumberOfThreads(
-      encoder_params.iPicWidth, encoder_params.iPicHeight, number_of_cores_);
+  encoder_params.iMultipleThreadIdc = num_threads_;
   // The base spatial layer 0 is the only one we use.
   encoder_params.sSpatialLayers[0].iVideoWidth = encoder_params.iPicWidth;
   encoder_params.sSpatialLayers[0].iVideoHeight = encoder_params.iPicHeight;
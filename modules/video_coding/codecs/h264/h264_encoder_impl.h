@@ -90,6 +90,10 @@ class H264EncoderImpl : public H264Encoder {
 
   size_t max_payload_size_;
   int32_t number_of_cores_;
+  // Registration with the process-wide EncoderThreadBudget, or -1 while not
+  // initialized, and the number of threads it granted.
+  int thread_budget_id_;
+  int num_threads_;
 
   EncodedImage encoded_image_;
   std::unique_ptr<uint8_t[]> encoded_image_buffer_;
@@ -0,0 +1,460 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/video_coding/codecs/test/video_pipeline.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <deque>
+#include <utility>
+
+#include "webrtc/api/video/i420_buffer.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/copyonwritebuffer.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/logging.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/common_video/h264/h264_common.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_format.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_packet_to_send.h"
+#include "webrtc/modules/rtp_rtcp/source/rtp_utility.h"
+
+namespace webrtc {
+namespace test {
+namespace {
+const uint8_t kPayloadType = 96;
+const uint32_t kSsrc = 0x12345678;
+const int kRtpTimestampRate = 90000;
+const uint8_t kH264StartCode[] = {0, 0, 0, 1};
+const size_t kH264NalHeaderSize = 1;
+const size_t kH264LengthFieldSize = 2;
+// AES-256-GCM uses a 32 bytes key and a 12 bytes salt.
+const size_t kKeyAndSaltSize = 44;
+
+MediaCryptoKey CreateKey() {
+  MediaCryptoKey key;
+  key.type = rtc::SRTP_AEAD_AES_256_GCM;
+  for (size_t i = 0; i < kKeyAndSaltSize; ++i)
+    key.buffer.push_back(static_cast<uint8_t>(i));
+  return key;
+}
+
+RtpVideoCodecTypes RtpCodecType(VideoCodecType codec_type) {
+  switch (codec_type) {
+    case kVideoCodecVP8:
+      return kRtpVideoVp8;
+    case kVideoCodecVP9:
+      return kRtpVideoVp9;
+    case kVideoCodecH264:
+      return kRtpVideoH264;
+    default:
+      return kRtpVideoGeneric;
+  }
+}
+
+void UpdateStats(int64_t time_us, VideoPipeline::StageStats* stats) {
+  ++stats->frames;
+  stats->total_time_us += time_us;
+  stats->max_time_us = std::max(stats->max_time_us, time_us);
+}
+}  // namespace
+
+const int VideoPipeline::kNumStages;
+
+struct VideoPipeline::Frame {
+  int64_t start_time_us = 0;
+  // Points either to |buffer| or to the caller's frames.
+  EncodedImage encoded_image;
+  std::vector<uint8_t> buffer;
+  std::vector<rtc::CopyOnWriteBuffer> packets;
+};
+
+// Blocking queue between two stages, with one thread on each side. A null
+// frame ends the stream.
+class VideoPipeline::FrameQueue {
+ public:
+  explicit FrameQueue(size_t max_size)
+      : max_size_(max_size), not_full_(false, false), not_empty_(false, false) {
+    RTC_DCHECK_GT(max_size, 0u);
+  }
+
+  void Push(std::unique_ptr<Frame> frame) {
+    while (true) {
+      {
+        rtc::CritScope lock(&crit_);
+        if (frames_.size() < max_size_) {
+          frames_.push_back(std::move(frame));
+          not_empty_.Set();
+          return;
+        }
+      }
+      not_full_.Wait(rtc::Event::kForever);
+    }
+  }
+
+  std::unique_ptr<Frame> Pop() {
+    while (true) {
+      {
+        rtc::CritScope lock(&crit_);
+        if (!frames_.empty()) {
+          std::unique_ptr<Frame> frame = std::move(frames_.front());
+          frames_.pop_front();
+          not_full_.Set();
+          return frame;
+        }
+      }
+      not_empty_.Wait(rtc::Event::kForever);
+    }
+  }
+
+ private:
+  const size_t max_size_;
+  rtc::CriticalSection crit_;
+  std::deque<std::unique_ptr<Frame>> frames_ GUARDED_BY(crit_);
+  rtc::Event not_full_;
+  rtc::Event not_empty_;
+};
+
+class VideoPipeline::EncodeCallback : public EncodedImageCallback {
+ public:
+  explicit EncodeCallback(VideoPipeline* pipeline) : pipeline_(pipeline) {}
+
+  Result OnEncodedImage(const EncodedImage& encoded_image,
+                        const CodecSpecificInfo* codec_specific_info,
+                        const RTPFragmentationHeader* fragmentation) override {
+    pipeline_->OnEncodedImage(encoded_image);
+    return Result(Result::OK, encoded_image._timeStamp);
+  }
+
+ private:
+  VideoPipeline* const pipeline_;
+};
+
+class VideoPipeline::DecodeCallback : public DecodedImageCallback {
+ public:
+  int32_t Decoded(VideoFrame& decoded_image) override { return 0; }
+};
+
+double VideoPipeline::StageStats::AverageTimeUs() const {
+  return frames > 0 ? static_cast<double>(total_time_us) / frames : 0.0;
+}
+
+double VideoPipeline::Results::FramesPerSecond() const {
+  return duration_us > 0 ? 1e6 * frames / duration_us : 0.0;
+}
+
+double VideoPipeline::Results::AverageLatencyUs() const {
+  return frames > 0 ? static_cast<double>(total_latency_us) / frames : 0.0;
+}
+
+VideoPipeline::VideoPipeline(const Config& config,
+                             VideoEncoder* encoder,
+                             VideoDecoder* decoder)
+    : config_(config),
+      encoder_(encoder),
+      decoder_(decoder),
+      encode_callback_(new EncodeCallback(this)),
+      decode_callback_(new DecodeCallback()),
+      depacketizer_(
+          RtpDepacketizer::Create(RtpCodecType(config.codec_type))),
+      frame_reader_(nullptr),
+      frame_rate_(0),
+      encoded_frames_(nullptr),
+      encode_start_time_us_(0),
+      hand_off_time_us_(0),
+      sequence_number_(0) {
+  if (config_.media_crypto) {
+    RTC_CHECK(sender_crypto_.SetOutboundKey(CreateKey()));
+    RTC_CHECK(receiver_crypto_.SetInboundKey(CreateKey()));
+  }
+  if (encoder_)
+    encoder_->RegisterEncodeCompleteCallback(encode_callback_.get());
+  if (decoder_)
+    decoder_->RegisterDecodeCompleteCallback(decode_callback_.get());
+}
+
+VideoPipeline::~VideoPipeline() {
+  if (encoder_)
+    encoder_->RegisterEncodeCompleteCallback(nullptr);
+  if (decoder_)
+    decoder_->RegisterDecodeCompleteCallback(nullptr);
+}
+
+VideoPipeline::Results VideoPipeline::RunFromRawFrames(
+    FrameReader* frame_reader,
+    int frame_rate) {
+  RTC_CHECK(encoder_);
+  RTC_DCHECK_GT(frame_rate, 0);
+  frame_reader_ = frame_reader;
+  frame_rate_ = frame_rate;
+  return Run(kEncode);
+}
+
+VideoPipeline::Results VideoPipeline::RunFromEncodedFrames(
+    const std::vector<EncodedImage>& frames,
+    Stage first_stage) {
+  RTC_CHECK(first_stage == kPacketize || first_stage == kDecode);
+  RTC_CHECK_GE(config_.last_stage, first_stage);
+  encoded_frames_ = &frames;
+  return Run(first_stage);
+}
+
+bool VideoPipeline::RunStageThread(void* obj) {
+  StageThread* stage_thread = static_cast<StageThread*>(obj);
+  stage_thread->pipeline->RunStage(stage_thread->stage);
+  return false;
+}
+
+VideoPipeline::Results VideoPipeline::Run(Stage first_stage) {
+  RTC_CHECK(config_.last_stage < kDecode || decoder_);
+  results_ = Results();
+  for (int stage = first_stage + 1; stage <= config_.last_stage; ++stage)
+    queues_[stage].reset(new FrameQueue(config_.max_queued_frames));
+
+  static const char* const kThreadNames[kNumStages] = {
+      "PipelineEncode", "PipelinePacketize", "PipelineDepacketize",
+      "PipelineDecode"};
+  StageThread stage_threads[kNumStages];
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  int64_t start_time_us = rtc::TimeMicros();
+  for (int stage = first_stage; stage <= config_.last_stage; ++stage) {
+    stage_threads[stage] = {this, static_cast<Stage>(stage)};
+    threads.emplace_back(new rtc::PlatformThread(
+        &VideoPipeline::RunStageThread, &stage_threads[stage],
+        kThreadNames[stage]));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads)
+    thread->Stop();
+  results_.duration_us = rtc::TimeMicros() - start_time_us;
+
+  for (auto& queue : queues_)
+    queue.reset();
+  frame_reader_ = nullptr;
+  encoded_frames_ = nullptr;
+  return results_;
+}
+
+void VideoPipeline::RunStage(Stage stage) {
+  if (stage == kEncode) {
+    EncodeFrames();
+    Deliver(kEncode, nullptr);
+    return;
+  }
+  size_t next_encoded_frame = 0;
+  while (true) {
+    std::unique_ptr<Frame> frame;
+    if (queues_[stage]) {
+      frame = queues_[stage]->Pop();
+    } else if (next_encoded_frame < encoded_frames_->size()) {
+      frame.reset(new Frame());
+      frame->start_time_us = rtc::TimeMicros();
+      frame->encoded_image = (*encoded_frames_)[next_encoded_frame++];
+    }
+    if (!frame) {
+      // End of the stream, pass it on.
+      Deliver(stage, nullptr);
+      return;
+    }
+
+    int64_t start_time_us = rtc::TimeMicros();
+    bool success = false;
+    switch (stage) {
+      case kPacketize:
+        success = Packetize(frame.get());
+        break;
+      case kDepacketize:
+        success = Depacketize(frame.get());
+        break;
+      case kDecode:
+        success = Decode(frame.get());
+        break;
+      case kEncode:
+        RTC_NOTREACHED();
+    }
+    UpdateStats(rtc::TimeMicros() - start_time_us, &results_.stages[stage]);
+    if (success)
+      Deliver(stage, std::move(frame));
+  }
+}
+
+void VideoPipeline::EncodeFrames() {
+  const uint32_t timestamp_delta = kRtpTimestampRate / frame_rate_;
+  uint32_t timestamp = 0;
+  while (rtc::scoped_refptr<I420Buffer> buffer = frame_reader_->ReadFrame()) {
+    VideoFrame frame(buffer, timestamp, 0, kVideoRotation_0);
+    timestamp += timestamp_delta;
+    encode_start_time_us_ = rtc::TimeMicros();
+    hand_off_time_us_ = 0;
+    if (encoder_->Encode(frame, nullptr, nullptr) != WEBRTC_VIDEO_CODEC_OK)
+      LOG(LS_WARNING) << "Failed to encode frame " << timestamp;
+    UpdateStats(
+        rtc::TimeMicros() - encode_start_time_us_ - hand_off_time_us_,
+        &results_.stages[kEncode]);
+  }
+}
+
+void VideoPipeline::OnEncodedImage(const EncodedImage& encoded_image) {
+  // Called from within Encode, the time spent here isn't the encoder's.
+  int64_t start_time_us = rtc::TimeMicros();
+  if (config_.encoded_frame_writer)
+    config_.encoded_frame_writer->WriteFrame(encoded_image, config_.codec_type);
+
+  std::unique_ptr<Frame> frame(new Frame());
+  frame->start_time_us = encode_start_time_us_;
+  size_t padding = EncodedImage::GetBufferPaddingBytes(config_.codec_type);
+  frame->buffer.resize(encoded_image._length + padding);
+  memcpy(frame->buffer.data(), encoded_image._buffer, encoded_image._length);
+  frame->encoded_image = encoded_image;
+  frame->encoded_image._buffer = frame->buffer.data();
+  frame->encoded_image._size = frame->buffer.size();
+  Deliver(kEncode, std::move(frame));
+  hand_off_time_us_ += rtc::TimeMicros() - start_time_us;
+}
+
+void VideoPipeline::Deliver(Stage stage, std::unique_ptr<Frame> frame) {
+  if (stage < config_.last_stage) {
+    queues_[stage + 1]->Push(std::move(frame));
+    return;
+  }
+  if (!frame)
+    return;
+  int64_t latency_us = rtc::TimeMicros() - frame->start_time_us;
+  ++results_.frames;
+  results_.total_latency_us += latency_us;
+  results_.max_latency_us = std::max(results_.max_latency_us, latency_us);
+}
+
+bool VideoPipeline::Packetize(Frame* frame) {
+  const EncodedImage& image = frame->encoded_image;
+  RTPVideoTypeHeader type_header;
+  memset(&type_header, 0, sizeof(type_header));
+  RTPFragmentationHeader fragmentation;
+  switch (config_.codec_type) {
+    case kVideoCodecVP8:
+      type_header.VP8.InitRTPVideoHeaderVP8();
+      break;
+    case kVideoCodecVP9:
+      type_header.VP9.InitRTPVideoHeaderVP9();
+      break;
+    case kVideoCodecH264: {
+      type_header.H264.packetization_mode =
+          H264PacketizationMode::NonInterleaved;
+      std::vector<H264::NaluIndex> nalus =
+          H264::FindNaluIndices(image._buffer, image._length);
+      fragmentation.VerifyAndAllocateFragmentationHeader(nalus.size());
+      for (size_t i = 0; i < nalus.size(); ++i) {
+        fragmentation.fragmentationOffset[i] = nalus[i].payload_start_offset;
+        fragmentation.fragmentationLength[i] = nalus[i].payload_size;
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  const size_t max_payload_size =
+      config_.max_packet_size - kRtpHeaderSize -
+      (config_.media_crypto ? sender_crypto_.GetEncryptionOverhead() : 0);
+  std::unique_ptr<RtpPacketizer> packetizer(RtpPacketizer::Create(
+      RtpCodecType(config_.codec_type), max_payload_size, &type_header,
+      image._frameType));
+  packetizer->SetPayloadData(image._buffer, image._length, &fragmentation);
+
+  bool last_packet = false;
+  while (!last_packet) {
+    RtpPacketToSend packet(nullptr, IP_PACKET_SIZE);
+    packet.SetPayloadType(kPayloadType);
+    packet.SetSequenceNumber(sequence_number_++);
+    packet.SetTimestamp(image._timeStamp);
+    packet.SetSsrc(kSsrc);
+    if (!packetizer->NextPacket(&packet, &last_packet))
+      return false;
+    if (config_.media_crypto && !sender_crypto_.Encrypt(&packet))
+      return false;
+    frame->packets.push_back(packet.Buffer());
+  }
+  results_.packets += frame->packets.size();
+  return true;
+}
+
+bool VideoPipeline::Depacketize(Frame* frame) {
+  const bool h264 = config_.codec_type == kVideoCodecH264;
+  std::vector<uint8_t> buffer;
+  RTPHeader header;
+  FrameType frame_type = kVideoFrameDelta;
+  for (rtc::CopyOnWriteBuffer& packet : frame->packets) {
+    RtpUtility::RtpHeaderParser parser(packet.cdata(), packet.size());
+    if (!parser.Parse(&header))
+      return false;
+    // The packet holds the only reference to its buffer, so this won't copy.
+    uint8_t* payload = packet.data() + header.headerLength;
+    size_t payload_length =
+        packet.size() - header.headerLength - header.paddingLength;
+    if (config_.media_crypto &&
+        !receiver_crypto_.DecryptInPlace(&payload, &payload_length)) {
+      return false;
+    }
+    RtpDepacketizer::ParsedPayload parsed;
+    if (!depacketizer_->Parse(&parsed, payload, payload_length))
+      return false;
+    if (&packet == &frame->packets.front())
+      frame_type = parsed.frame_type;
+
+    // Same as VCMSessionInfo, H264 NAL units get their start code back.
+    if (h264 && parsed.type.Video.codecHeader.H264.packetization_type ==
+                    kH264StapA) {
+      const uint8_t* nalu = parsed.payload + kH264NalHeaderSize;
+      const uint8_t* end = parsed.payload + parsed.payload_length;
+      while (nalu + kH264LengthFieldSize <= end) {
+        size_t length = (nalu[0] << 8) | nalu[1];
+        nalu += kH264LengthFieldSize;
+        if (nalu + length > end)
+          return false;
+        buffer.insert(buffer.end(), kH264StartCode,
+                      kH264StartCode + sizeof(kH264StartCode));
+        buffer.insert(buffer.end(), nalu, nalu + length);
+        nalu += length;
+      }
+      continue;
+    }
+    if (h264 && parsed.type.Video.is_first_packet_in_frame) {
+      buffer.insert(buffer.end(), kH264StartCode,
+                    kH264StartCode + sizeof(kH264StartCode));
+    }
+    buffer.insert(buffer.end(), parsed.payload,
+                  parsed.payload + parsed.payload_length);
+  }
+  frame->packets.clear();
+
+  size_t length = buffer.size();
+  buffer.resize(length + EncodedImage::GetBufferPaddingBytes(
+                             config_.codec_type));
+  frame->buffer.swap(buffer);
+  EncodedImage image(frame->buffer.data(), length, frame->buffer.size());
+  image._encodedWidth = frame->encoded_image._encodedWidth;
+  image._encodedHeight = frame->encoded_image._encodedHeight;
+  image._timeStamp = header.timestamp;
+  image._frameType = frame_type;
+  image._completeFrame = true;
+  frame->encoded_image = image;
+  return true;
+}
+
+bool VideoPipeline::Decode(Frame* frame) {
+  return decoder_->Decode(frame->encoded_image, false, nullptr) ==
+         WEBRTC_VIDEO_CODEC_OK;
+}
+
+}  // namespace test
+}  // namespace webrtc
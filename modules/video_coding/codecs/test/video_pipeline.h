@@ -0,0 +1,149 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_VIDEO_CODING_CODECS_TEST_VIDEO_PIPELINE_H_
+#define WEBRTC_MODULES_VIDEO_CODING_CODECS_TEST_VIDEO_PIPELINE_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/modules/rtp_rtcp/source/media_crypto.h"
+#include "webrtc/modules/video_coding/include/video_codec_interface.h"
+#include "webrtc/modules/video_coding/utility/ivf_file_writer.h"
+#include "webrtc/test/testsupport/frame_reader.h"
+
+namespace webrtc {
+
+class RtpDepacketizer;
+
+namespace test {
+
+// Runs the media path of a video call, from the encoder to the decoder, as a
+// pipeline: the encoder, the packetizer, the depacketizer and the decoder each
+// run on their own thread and hand the frames over through bounded queues.
+// The time spent in each stage is measured separately, so the throughput of
+// the pipeline can be compared to the cost of its slowest stage.
+//
+// Unlike VideoProcessor there is no network simulation, and the frames don't
+// need an encoder: pre-encoded frames, e.g. from an IvfFileReader, can be
+// replayed from the packetizer or the decoder on, and the pipeline can stop after any stage
+// to benchmark e.g. the packetizer alone.
+class VideoPipeline {
+ public:
+  enum Stage { kEncode, kPacketize, kDepacketize, kDecode };
+  static const int kNumStages = kDecode + 1;
+
+  struct Config {
+    VideoCodecType codec_type = kVideoCodecVP8;
+    // Frames are dropped once through this stage.
+    Stage last_stage = kDecode;
+    size_t max_packet_size = 1200;
+    // Encrypts the packets with MediaCrypto after packetization, and decrypts
+    // them before depacketization.
+    bool media_crypto = false;
+    // Frames each stage can get ahead of the next one.
+    size_t max_queued_frames = 4;
+    // If set, the encoded frames are also written there, outside of the
+    // measured times, to be replayed later without the encoder.
+    IvfFileWriter* encoded_frame_writer = nullptr;
+  };
+
+  struct StageStats {
+    size_t frames = 0;
+    // Time spent processing the frames, not waiting for them.
+    int64_t total_time_us = 0;
+    int64_t max_time_us = 0;
+    double AverageTimeUs() const;
+  };
+
+  struct Results {
+    StageStats stages[kNumStages];
+    // Frames through the last stage.
+    size_t frames = 0;
+    size_t packets = 0;
+    int64_t duration_us = 0;
+    // From the start of the first stage to the end of the last one, queues
+    // included.
+    int64_t total_latency_us = 0;
+    int64_t max_latency_us = 0;
+    double FramesPerSecond() const;
+    double AverageLatencyUs() const;
+  };
+
+  // |encoder| and |decoder| must be initialized, and are only needed if the
+  // pipeline runs their stage.
+  VideoPipeline(const Config& config,
+                VideoEncoder* encoder,
+                VideoDecoder* decoder);
+  ~VideoPipeline();
+
+  // Encodes all the frames of |frame_reader|, with RTP timestamps at
+  // |frame_rate|. A PreloadedFrameReader keeps the disk out of the
+  // measurements.
+  Results RunFromRawFrames(FrameReader* frame_reader, int frame_rate);
+  // Starts from |first_stage|, kPacketize or kDecode, with |frames|, which
+  // must outlive the call. Starting from the decoder benchmarks it alone;
+  // |frames| then need the decoder's buffer padding, as IvfFileReader adds.
+  Results RunFromEncodedFrames(const std::vector<EncodedImage>& frames,
+                               Stage first_stage = kPacketize);
+
+ private:
+  struct Frame;
+  class FrameQueue;
+  class EncodeCallback;
+  class DecodeCallback;
+  struct StageThread {
+    VideoPipeline* pipeline;
+    Stage stage;
+  };
+
+  static bool RunStageThread(void* obj);
+  Results Run(Stage first_stage);
+  void RunStage(Stage stage);
+  void EncodeFrames();
+  void OnEncodedImage(const EncodedImage& encoded_image);
+  // Hands |frame| to the stage after |stage|, if any.
+  void Deliver(Stage stage, std::unique_ptr<Frame> frame);
+
+  bool Packetize(Frame* frame);
+  bool Depacketize(Frame* frame);
+  bool Decode(Frame* frame);
+
+  const Config config_;
+  VideoEncoder* const encoder_;
+  VideoDecoder* const decoder_;
+  const std::unique_ptr<EncodeCallback> encode_callback_;
+  const std::unique_ptr<DecodeCallback> decode_callback_;
+  const std::unique_ptr<RtpDepacketizer> depacketizer_;
+  MediaCrypto sender_crypto_;
+  MediaCrypto receiver_crypto_;
+
+  // Input of the current run.
+  FrameReader* frame_reader_;
+  int frame_rate_;
+  const std::vector<EncodedImage>* encoded_frames_;
+
+  // Input queue of each stage, the first stage has none.
+  std::unique_ptr<FrameQueue> queues_[kNumStages];
+  // Each field is only written by the thread of its stage.
+  Results results_;
+  int64_t encode_start_time_us_;
+  // Spent in OnEncodedImage during the current Encode call.
+  int64_t hand_off_time_us_;
+  uint16_t sequence_number_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(VideoPipeline);
+};
+
+}  // namespace test
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_VIDEO_CODING_CODECS_TEST_VIDEO_PIPELINE_H_
@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/video_coding/codecs/test/video_pipeline.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "webrtc/api/video/i420_buffer.h"
+#include "webrtc/modules/video_coding/include/mock/mock_video_codec_interface.h"
+#include "webrtc/test/gmock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/mock/mock_frame_reader.h"
+
+using ::testing::_;
+using ::testing::DoAll;
+using ::testing::Invoke;
+using ::testing::Return;
+using ::testing::SaveArg;
+
+namespace webrtc {
+namespace test {
+namespace {
+const size_t kNumFrames = 10;
+// Spans several packets.
+const size_t kFrameSize = 3000;
+}  // namespace
+
+class VideoPipelineTest : public ::testing::Test {
+ protected:
+  VideoPipelineTest() {
+    config_.codec_type = kVideoCodecGeneric;
+    for (size_t i = 0; i < kNumFrames; ++i) {
+      payloads_.emplace_back(kFrameSize);
+      for (size_t j = 0; j < kFrameSize; ++j)
+        payloads_.back()[j] = static_cast<uint8_t>(i + j);
+      EncodedImage frame(payloads_.back().data(), kFrameSize, kFrameSize);
+      frame._timeStamp = 3000 * i;
+      frame._frameType = i == 0 ? kVideoFrameKey : kVideoFrameDelta;
+      frame._completeFrame = true;
+      frames_.push_back(frame);
+    }
+  }
+
+  // Expects |frames_| to be decoded, in order.
+  void ExpectDecodedFrames() {
+    decoded_frames_ = 0;
+    EXPECT_CALL(decoder_, Decode(_, false, _, _, _))
+        .Times(kNumFrames)
+        .WillRepeatedly(Invoke([this](const EncodedImage& image, bool,
+                                      const RTPFragmentationHeader*,
+                                      const CodecSpecificInfo*, int64_t) {
+          const EncodedImage& expected = frames_[decoded_frames_++];
+          EXPECT_EQ(expected._timeStamp, image._timeStamp);
+          EXPECT_EQ(expected._frameType, image._frameType);
+          EXPECT_EQ(expected._length, image._length);
+          EXPECT_EQ(0, memcmp(expected._buffer, image._buffer,
+                              std::min(expected._length, image._length)));
+          return WEBRTC_VIDEO_CODEC_OK;
+        }));
+  }
+
+  void ExpectAllStagesFrom(VideoPipeline::Stage first_stage,
+                           const VideoPipeline::Results& results) {
+    EXPECT_EQ(kNumFrames, results.frames);
+    for (int stage = 0; stage < VideoPipeline::kNumStages; ++stage) {
+      bool ran = stage >= first_stage && stage <= config_.last_stage;
+      EXPECT_EQ(ran ? kNumFrames : 0u, results.stages[stage].frames);
+    }
+    if (first_stage <= VideoPipeline::kPacketize &&
+        config_.last_stage >= VideoPipeline::kPacketize) {
+      EXPECT_GT(results.packets, kNumFrames);
+    } else {
+      EXPECT_EQ(0u, results.packets);
+    }
+    EXPECT_GE(results.max_latency_us * static_cast<int64_t>(results.frames),
+              results.total_latency_us);
+  }
+
+  VideoPipeline::Config config_;
+  std::vector<std::vector<uint8_t>> payloads_;
+  std::vector<EncodedImage> frames_;
+  MockVideoEncoder encoder_;
+  MockVideoDecoder decoder_;
+  size_t decoded_frames_ = 0;
+};
+
+TEST_F(VideoPipelineTest, ReplaysEncodedFramesToDecoder) {
+  ExpectDecodedFrames();
+  VideoPipeline pipeline(config_, nullptr, &decoder_);
+  VideoPipeline::Results results = pipeline.RunFromEncodedFrames(frames_);
+  ExpectAllStagesFrom(VideoPipeline::kPacketize, results);
+}
+
+TEST_F(VideoPipelineTest, ReplaysEncodedFramesWithMediaCrypto) {
+  config_.media_crypto = true;
+  ExpectDecodedFrames();
+  VideoPipeline pipeline(config_, nullptr, &decoder_);
+  VideoPipeline::Results results = pipeline.RunFromEncodedFrames(frames_);
+  ExpectAllStagesFrom(VideoPipeline::kPacketize, results);
+}
+
+TEST_F(VideoPipelineTest, ReplaysEncodedFramesFromDecoder) {
+  ExpectDecodedFrames();
+  VideoPipeline pipeline(config_, nullptr, &decoder_);
+  VideoPipeline::Results results =
+      pipeline.RunFromEncodedFrames(frames_, VideoPipeline::kDecode);
+  ExpectAllStagesFrom(VideoPipeline::kDecode, results);
+}
+
+TEST_F(VideoPipelineTest, StopsAfterLastStage) {
+  config_.last_stage = VideoPipeline::kPacketize;
+  EXPECT_CALL(decoder_, Decode(_, _, _, _, _)).Times(0);
+  VideoPipeline pipeline(config_, nullptr, nullptr);
+  VideoPipeline::Results results = pipeline.RunFromEncodedFrames(frames_);
+  ExpectAllStagesFrom(VideoPipeline::kPacketize, results);
+  // Generic packets carry a one byte header.
+  const size_t kMaxPayloadSize = config_.max_packet_size - 12 - 1;
+  EXPECT_EQ(kNumFrames * ((kFrameSize + kMaxPayloadSize - 1) / kMaxPayloadSize),
+            results.packets);
+}
+
+TEST_F(VideoPipelineTest, EncodesRawFrames) {
+  EncodedImageCallback* encode_callback = nullptr;
+  EXPECT_CALL(encoder_, RegisterEncodeCompleteCallback(_))
+      .WillRepeatedly(DoAll(SaveArg<0>(&encode_callback), Return(0)));
+  size_t encoded_frames = 0;
+  EXPECT_CALL(encoder_, Encode(_, _, _))
+      .Times(kNumFrames)
+      .WillRepeatedly(Invoke([&](const VideoFrame& frame,
+                                 const CodecSpecificInfo*,
+                                 const std::vector<FrameType>*) {
+        EXPECT_EQ(frames_[encoded_frames]._timeStamp, frame.timestamp());
+        encode_callback->OnEncodedImage(frames_[encoded_frames++], nullptr,
+                                        nullptr);
+        return WEBRTC_VIDEO_CODEC_OK;
+      }));
+  MockFrameReader frame_reader;
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(16, 16);
+  size_t read_frames = 0;
+  EXPECT_CALL(frame_reader, ReadFrame())
+      .Times(kNumFrames + 1)
+      .WillRepeatedly(Invoke([&]() -> rtc::scoped_refptr<I420Buffer> {
+        return read_frames++ < kNumFrames ? buffer : nullptr;
+      }));
+  ExpectDecodedFrames();
+
+  VideoPipeline pipeline(config_, &encoder_, &decoder_);
+  VideoPipeline::Results results =
+      pipeline.RunFromRawFrames(&frame_reader, 30);
+  ExpectAllStagesFrom(VideoPipeline::kEncode, results);
+}
+
+}  // namespace test
+}  // namespace webrtc
@@ -10,6 +10,7 @@
 
 #include <math.h>
 
+#include "webrtc/media/base/mediaconstants.h"
 #include "webrtc/modules/video_coding/codecs/h264/include/h264.h"
 #include "webrtc/modules/video_coding/codecs/test/packet_manipulator.h"
 #include "webrtc/modules/video_coding/codecs/test/videoprocessor.h"
@@ -46,6 +47,9 @@ struct CodecConfigPars {
   bool denoising_on;
   bool frame_dropper_on;
   bool spatial_resize_on;
+  // Encode H264 with multiple slices per frame and let the encoder and
+  // decoder use all cores.
+  bool multi_slice_multi_core;
 };
 
 // Quality metrics.
@@ -149,13 +153,19 @@ class VideoProcessorIntegrationTest : public testing::Test {
   bool denoising_on_;
   bool frame_dropper_on_;
   bool spatial_resize_on_;
+  bool multi_slice_multi_core_;
 
   VideoProcessorIntegrationTest() {}
   virtual ~VideoProcessorIntegrationTest() {}
 
   void SetUpCodecConfig() {
     if (codec_type_ == kVideoCodecH264) {
-      encoder_ = H264Encoder::Create(cricket::VideoCodec("H264"));
+      cricket::VideoCodec codec("H264");
+      // Packetization mode 1 limits the size of the slices, so frames are
+      // split into several slices.
+      if (multi_slice_multi_core_)
+        codec.SetParam(cricket::kH264FmtpPacketizationMode, "1");
+      encoder_ = H264Encoder::Create(codec);
       decoder_ = H264Decoder::Create();
       VideoCodingModule::Codec(kVideoCodecH264, &codec_settings_);
     } else if (codec_type_ == kVideoCodecVP8) {
@@ -179,7 +189,7 @@ class VideoProcessorIntegrationTest : public testing::Test {
         CalcBufferSize(kI420, kCIFWidth, kCIFHeight);
     config_.verbose = false;
     // Only allow encoder/decoder to use single core, for predictability.
-    config_.use_single_core = true;
+    config_.use_single_core = !multi_slice_multi_core_;
     // Key frame interval and packet loss are set for each test.
     config_.keyframe_interval = key_frame_interval_;
     config_.networking_config.packet_loss_probability = packet_loss_;
@@ -437,6 +447,7 @@ class VideoProcessorIntegrationTest : public testing::Test {
     denoising_on_ = process.denoising_on;
     frame_dropper_on_ = process.frame_dropper_on;
     spatial_resize_on_ = process.spatial_resize_on;
+    multi_slice_multi_core_ = process.multi_slice_multi_core;
     SetUpCodecConfig();
     // Update the layers and the codec with the initial rates.
     bit_rate_ = rate_profile.target_bit_rate[0];
@@ -553,6 +564,7 @@ void SetCodecParameters(CodecConfigPars* process_settings,
   process_settings->denoising_on = denoising_on;
   process_settings->frame_dropper_on = frame_dropper_on;
   process_settings->spatial_resize_on = spatial_resize_on;
+  process_settings->multi_slice_multi_core = false;
 }
 
 void SetQualityMetrics(QualityMetrics* quality_metrics,
@@ -616,6 +628,44 @@ TEST_F(VideoProcessorIntegrationTest, Process0PercentPacketLossH264) {
                          rc_metrics);
 }
 
+// H264: Decode frames with multiple slices on several threads, and print the
+// decode throughput to compare with Process0PercentPacketLossH264.
+TEST_F(VideoProcessorIntegrationTest, ProcessMultiSliceMultiCoreH264) {
+  // Bitrate and frame rate profile.
+  RateProfile rate_profile;
+  SetRateProfilePars(&rate_profile, 0, 500, 30, 0);
+  rate_profile.frame_index_rate_update[1] = kNbrFramesShort + 1;
+  rate_profile.num_frames = kNbrFramesShort;
+  // Codec/network settings.
+  CodecConfigPars process_settings;
+  SetCodecParameters(&process_settings, kVideoCodecH264, 0.0f, -1, 1, false,
+                     false, true, false);
+  process_settings.multi_slice_multi_core = true;
+  // Metrics for expected quality.
+  QualityMetrics quality_metrics;
+  SetQualityMetrics(&quality_metrics, 35.0, 25.0, 0.93, 0.70);
+  // Metrics for rate control.
+  RateControlMetrics rc_metrics[1];
+  SetRateControlMetrics(rc_metrics, 0, 2, 60, 20, 10, 20, 0, 1);
+  ProcessFramesAndVerify(quality_metrics,
+                         rate_profile,
+                         process_settings,
+                         rc_metrics);
+
+  int64_t total_decode_time_us = 0;
+  int num_decoded_frames = 0;
+  for (const auto& frame_stat : stats_.stats_) {
+    if (frame_stat.decoding_successful) {
+      total_decode_time_us += frame_stat.decode_time_in_us;
+      ++num_decoded_frames;
+    }
+  }
+  ASSERT_GT(num_decoded_frames, 0);
+  ASSERT_GT(total_decode_time_us, 0);
+  printf("Decode throughput: %.1f fps\n",
+         num_decoded_frames * 1e6 / total_decode_time_us);
+}
+
 #endif  // defined(WEBRTC_VIDEOPROCESSOR_H264_TESTS)
 
 // Fails on iOS. See webrtc:4755.
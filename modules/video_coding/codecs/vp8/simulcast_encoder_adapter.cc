@@ -12,11 +12,8 @@
 
 #include <algorithm>
 
-// NOTE(ajm): Path provided by gyp.
-#include "libyuv/scale.h"  // NOLINT
-
-#include "webrtc/api/video/i420_buffer.h"
 #include "webrtc/base/checks.h"
+#include "webrtc/base/logging.h"
 #include "webrtc/modules/video_coding/codecs/vp8/screenshare_layers.h"
 #include "webrtc/modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "webrtc/system_wrappers/include/clock.h"
@@ -153,6 +150,7 @@ int SimulcastEncoderAdapter::Release() {
     delete callback;
     streaminfos_.pop_back();
   }
+  scale_pyramid_.Release();
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -254,34 +252,76 @@ int SimulcastEncoderAdapter::Encode(
     return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
   }
 
-  // All active streams should generate a key frame if
-  // a key frame is requested by any stream.
-  bool send_key_frame = false;
+  // Every stream has its own encoder, so a key frame is only generated for
+  // the streams it is requested for. Without a frame type per stream, a
+  // request applies to all of them.
+  std::vector<bool> send_key_frame(streaminfos_.size(), false);
   if (frame_types) {
+    const bool per_stream = frame_types->size() == streaminfos_.size();
     for (size_t i = 0; i < frame_types->size(); ++i) {
-      if (frame_types->at(i) == kVideoFrameKey) {
-        send_key_frame = true;
+      if (frame_types->at(i) != kVideoFrameKey)
+        continue;
+      if (!per_stream) {
+        std::fill(send_key_frame.begin(), send_key_frame.end(), true);
         break;
       }
+      send_key_frame[i] = true;
     }
   }
   for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
-    if (streaminfos_[stream_idx].key_frame_request &&
-        streaminfos_[stream_idx].send_stream) {
-      send_key_frame = true;
-      break;
-    }
+    if (streaminfos_[stream_idx].key_frame_request)
+      send_key_frame[stream_idx] = true;
   }
 
   int src_width = input_image.width();
   int src_height = input_image.height();
+  // If scaling isn't required, because the input resolution
+  // matches the destination or the input image is empty (e.g.
+  // a keyframe request for encoders with internal camera
+  // sources) or the source image has a native handle that the encoder can
+  // handle, pass the image on directly. Otherwise, we'll scale it to match
+  // what the encoder expects, from the next larger layer and into pooled
+  // buffers. Native frames are only mapped to I420, once, if some encoder
+  // needs their pixels, so that hardware encoders don't pay for a readback.
+  // For texture frames, the underlying encoder is expected to be able to
+  // correctly sample/scale the source texture.
+  // TODO(perkj): ensure that works going forward, and figure out how this
+  // affects webrtc:5683.
+  const bool native_input =
+      input_image.video_frame_buffer()->native_handle() != nullptr;
+  std::vector<bool> forward_native(streaminfos_.size(), false);
+  std::vector<I420ScalePyramid::Resolution> resolutions;
+  bool scale_input = false;
+  for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
+    const StreamInfo& streaminfo = streaminfos_[stream_idx];
+    forward_native[stream_idx] =
+        native_input && streaminfo.encoder->SupportsNativeHandle();
+    // Don't scale frames to resolutions that we don't intend to send.
+    if (streaminfo.send_stream && !forward_native[stream_idx]) {
+      resolutions.emplace_back(streaminfo.width, streaminfo.height);
+      scale_input = true;
+    } else {
+      resolutions.emplace_back(0, 0);
+    }
+  }
+  if (scale_input) {
+    rtc::scoped_refptr<VideoFrameBuffer> i420_buffer =
+        native_input ? input_image.video_frame_buffer()->NativeToI420Buffer()
+                     : input_image.video_frame_buffer();
+    if (!i420_buffer) {
+      LOG(LS_WARNING) << "Failed to map native frame to I420, dropping it.";
+      return WEBRTC_VIDEO_CODEC_ERROR;
+    }
+    scale_pyramid_.Update(i420_buffer, resolutions);
+  }
+
   for (size_t stream_idx = 0; stream_idx < streaminfos_.size(); ++stream_idx) {
     // Don't encode frames in resolutions that we don't intend to send.
     if (!streaminfos_[stream_idx].send_stream)
       continue;
 
     std::vector<FrameType> stream_frame_types;
-    if (send_key_frame) {
+    if (send_key_frame[stream_idx]) {
       stream_frame_types.push_back(kVideoFrameKey);
       streaminfos_[stream_idx].key_frame_request = false;
     } else {
@@ -290,48 +330,26 @@ int SimulcastEncoderAdapter::Encode(
 
     int dst_width = streaminfos_[stream_idx].width;
     int dst_height = streaminfos_[stream_idx].height;
-    // If scaling isn't required, because the input resolution
-    // matches the destination or the input image is empty (e.g.
-    // a keyframe request for encoders with internal camera
-    // sources) or the source image has a native handle, pass the image on
-    // directly. Otherwise, we'll scale it to match what the encoder expects
-    // (below).
-    // For texture frames, the underlying encoder is expected to be able to
-    // correctly sample/scale the source texture.
-    // TODO(perkj): ensure that works going forward, and figure out how this
-    // affects webrtc:5683.
-    if ((dst_width == src_width && dst_height == src_height) ||
-        input_image.video_frame_buffer()->native_handle()) {
-      int ret = streaminfos_[stream_idx].encoder->Encode(
+    int ret;
+    if (forward_native[stream_idx] ||
+        (!native_input && dst_width == src_width &&
+         dst_height == src_height)) {
+      ret = streaminfos_[stream_idx].encoder->Encode(
           input_image, codec_specific_info, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
+    } else if (dst_width == src_width && dst_height == src_height) {
+      // Native input mapped to I420 at its own resolution.
+      ret = streaminfos_[stream_idx].encoder->Encode(
+          VideoFrame(scale_pyramid_.layer(stream_idx), input_image.timestamp(),
+                     input_image.render_time_ms(), input_image.rotation()),
+          codec_specific_info, &stream_frame_types);
     } else {
-      // Aligning stride values based on width.
-      rtc::scoped_refptr<I420Buffer> dst_buffer =
-          I420Buffer::Create(dst_width, dst_height, dst_width,
-                             (dst_width + 1) / 2, (dst_width + 1) / 2);
-      libyuv::I420Scale(input_image.video_frame_buffer()->DataY(),
-                        input_image.video_frame_buffer()->StrideY(),
-                        input_image.video_frame_buffer()->DataU(),
-                        input_image.video_frame_buffer()->StrideU(),
-                        input_image.video_frame_buffer()->DataV(),
-                        input_image.video_frame_buffer()->StrideV(),
-                        src_width, src_height,
-                        dst_buffer->MutableDataY(), dst_buffer->StrideY(),
-                        dst_buffer->MutableDataU(), dst_buffer->StrideU(),
-                        dst_buffer->MutableDataV(), dst_buffer->StrideV(),
-                        dst_width, dst_height,
-                        libyuv::kFilterBilinear);
-
-      int ret = streaminfos_[stream_idx].encoder->Encode(
-          VideoFrame(dst_buffer, input_image.timestamp(),
+      ret = streaminfos_[stream_idx].encoder->Encode(
+          VideoFrame(scale_pyramid_.layer(stream_idx), input_image.timestamp(),
                      input_image.render_time_ms(), webrtc::kVideoRotation_0),
           codec_specific_info, &stream_frame_types);
-      if (ret != WEBRTC_VIDEO_CODEC_OK) {
-        return ret;
-      }
+    }
+    if (ret != WEBRTC_VIDEO_CODEC_OK) {
+      return ret;
     }
   }
 
@@ -457,11 +475,13 @@ bool SimulcastEncoderAdapter::Initialized() const {
 bool SimulcastEncoderAdapter::SupportsNativeHandle() const {
   // We should not be calling this method before streaminfos_ are configured.
   RTC_DCHECK(!streaminfos_.empty());
+  // Native frames are mapped to I420 in Encode() for the encoders that don't
+  // support them, so one encoder supporting them is enough.
   for (const auto& streaminfo : streaminfos_) {
-    if (!streaminfo.encoder->SupportsNativeHandle())
-      return false;
+    if (streaminfo.encoder->SupportsNativeHandle())
+      return true;
   }
-  return true;
+  return false;
 }
 
 VideoEncoder::ScalingSettings SimulcastEncoderAdapter::GetScalingSettings()
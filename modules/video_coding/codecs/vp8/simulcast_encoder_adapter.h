@@ -16,6 +16,7 @@
 #include <string>
 #include <vector>
 
+#include "webrtc/common_video/include/i420_scale_pyramid.h"
 #include "webrtc/modules/video_coding/codecs/vp8/include/vp8.h"
 
 namespace webrtc {
@@ -108,6 +109,8 @@ class SimulcastEncoderAdapter : public VP8Encoder {
   std::vector<StreamInfo> streaminfos_;
   EncodedImageCallback* encoded_complete_callback_;
   std::string implementation_name_;
+  // Scaled input of the streams that don't have the input resolution.
+  I420ScalePyramid scale_pyramid_;
 };
 
 }  // namespace webrtc
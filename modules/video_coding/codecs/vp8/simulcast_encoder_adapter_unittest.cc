@@ -40,8 +40,8 @@ class TestSimulcastEncoderAdapter : public TestVp8Simulcast {
   virtual void TearDown() { TestVp8Simulcast::TearDown(); }
 };
 
-TEST_F(TestSimulcastEncoderAdapter, TestKeyFrameRequestsOnAllStreams) {
-  TestVp8Simulcast::TestKeyFrameRequestsOnAllStreams();
+TEST_F(TestSimulcastEncoderAdapter, TestKeyFrameRequestsOnRequestedStreams) {
+  TestVp8Simulcast::TestKeyFrameRequestsOnRequestedStreams();
 }
 
 TEST_F(TestSimulcastEncoderAdapter, TestPaddingAllStreams) {
@@ -494,11 +494,11 @@ TEST_F(TestSimulcastEncoderAdapterFake,
   adapter_->RegisterEncodeCompleteCallback(this);
   ASSERT_EQ(3u, helper_->factory()->encoders().size());
   for (MockVideoEncoder* encoder : helper_->factory()->encoders())
-    encoder->set_supports_native_handle(true);
-  // If one encoder doesn't support it, then overall support is disabled.
-  helper_->factory()->encoders()[0]->set_supports_native_handle(false);
+    encoder->set_supports_native_handle(false);
+  // If no encoder supports it, then overall support is disabled.
   EXPECT_FALSE(adapter_->SupportsNativeHandle());
-  // Once all do, then the adapter claims support.
+  // Once one does, then the adapter claims support, and maps native frames
+  // for the others.
   helper_->factory()->encoders()[0]->set_supports_native_handle(true);
   EXPECT_TRUE(adapter_->SupportsNativeHandle());
 }
@@ -540,6 +540,59 @@ TEST_F(TestSimulcastEncoderAdapterFake,
   EXPECT_EQ(0, adapter_->Encode(input_frame, NULL, &frame_types));
 }
 
+class MappableNativeHandleBuffer : public NativeHandleBuffer {
+ public:
+  MappableNativeHandleBuffer(void* native_handle, int width, int height)
+      : NativeHandleBuffer(native_handle, width, height) {}
+  rtc::scoped_refptr<VideoFrameBuffer> NativeToI420Buffer() override {
+    ++num_mapped_;
+    rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(width_, height_);
+    buffer->InitializeData();
+    return buffer;
+  }
+  int num_mapped_ = 0;
+};
+
+TEST_F(TestSimulcastEncoderAdapterFake,
+       NativeHandleMappedOnceForEncodersWithoutSupport) {
+  TestVp8Simulcast::DefaultSettings(
+      &codec_, static_cast<const int*>(kTestTemporalLayerProfile));
+  codec_.VP8()->tl_factory = &tl_factory_;
+  codec_.numberOfSimulcastStreams = 3;
+  // High start bitrate, so all streams are enabled.
+  codec_.startBitrate = 3000;
+  EXPECT_EQ(0, adapter_->InitEncode(&codec_, 1, 1200));
+  adapter_->RegisterEncodeCompleteCallback(this);
+  ASSERT_EQ(3u, helper_->factory()->encoders().size());
+  // Only the top stream has a hardware encoder.
+  helper_->factory()->encoders()[2]->set_supports_native_handle(true);
+  EXPECT_TRUE(adapter_->SupportsNativeHandle());
+
+  rtc::scoped_refptr<MappableNativeHandleBuffer> buffer(
+      new rtc::RefCountedObject<MappableNativeHandleBuffer>(
+          this, kDefaultWidth, kDefaultHeight));
+  VideoFrame input_frame(buffer, 100, 1000, kVideoRotation_0);
+  EXPECT_CALL(*helper_->factory()->encoders()[2],
+              Encode(::testing::Ref(input_frame), _, _))
+      .Times(1);
+  for (int i = 0; i < 2; ++i) {
+    MockVideoEncoder* encoder = helper_->factory()->encoders()[i];
+    EXPECT_CALL(*encoder, Encode(_, _, _))
+        .WillOnce(::testing::Invoke(
+            [encoder](const VideoFrame& frame,
+                      const CodecSpecificInfo* codec_specific_info,
+                      const std::vector<FrameType>* frame_types) {
+              EXPECT_EQ(nullptr, frame.video_frame_buffer()->native_handle());
+              EXPECT_EQ(encoder->codec().width, frame.width());
+              EXPECT_EQ(encoder->codec().height, frame.height());
+              return WEBRTC_VIDEO_CODEC_OK;
+            }));
+  }
+  std::vector<FrameType> frame_types(3, kVideoFrameKey);
+  EXPECT_EQ(0, adapter_->Encode(input_frame, NULL, &frame_types));
+  EXPECT_EQ(1, buffer->num_mapped_);
+}
+
 TEST_F(TestSimulcastEncoderAdapterFake, TestFailureReturnCodesFromEncodeCalls) {
   TestVp8Simulcast::DefaultSettings(
       &codec_, static_cast<const int*>(kTestTemporalLayerProfile));
@@ -10,6 +10,8 @@
 
 #include "webrtc/modules/video_coding/codecs/vp8/simulcast_unittest.h"
 
+#include "webrtc/test/field_trial.h"
+
 namespace webrtc {
 namespace testing {
 
@@ -86,5 +88,30 @@ TEST_F(TestVp8Impl, TestSpatioTemporalLayers321PatternEncoder) {
 TEST_F(TestVp8Impl, TestStrideEncodeDecode) {
   TestVp8Simulcast::TestStrideEncodeDecode();
 }
+
+class TestVp8ImplParallelLayers : public TestVp8Impl {
+ public:
+  TestVp8ImplParallelLayers()
+      : field_trials_("WebRTC-VP8-ParallelSimulcastEncoding/Enabled/") {}
+
+ private:
+  test::ScopedFieldTrials field_trials_;
+};
+
+TEST_F(TestVp8ImplParallelLayers, TestKeyFrameRequestsOnRequestedStreams) {
+  TestVp8Simulcast::TestKeyFrameRequestsOnRequestedStreams();
+}
+
+TEST_F(TestVp8ImplParallelLayers, TestSendAllStreams) {
+  TestVp8Simulcast::TestSendAllStreams();
+}
+
+TEST_F(TestVp8ImplParallelLayers, TestDisablingStreams) {
+  TestVp8Simulcast::TestDisablingStreams();
+}
+
+TEST_F(TestVp8ImplParallelLayers, TestStrideEncodeDecode) {
+  TestVp8Simulcast::TestStrideEncodeDecode();
+}
 }  // namespace testing
 }  // namespace webrtc
@@ -276,6 +276,20 @@ class TestVp8Simulcast : public ::testing::Test {
         rate_allocator_->GetAllocation(bitrate_kbps * 1000, fps), fps);
   }
 
+  void ExpectStream(FrameType frame_type, int stream) {
+    const int scale = 1 << (kNumberOfSimulcastStreams - 1 - stream);
+    EXPECT_CALL(
+        encoder_callback_,
+        OnEncodedImage(
+            AllOf(Field(&EncodedImage::_frameType, frame_type),
+                  Field(&EncodedImage::_encodedWidth, kDefaultWidth / scale),
+                  Field(&EncodedImage::_encodedHeight, kDefaultHeight / scale)),
+            _, _))
+        .Times(1)
+        .WillRepeatedly(Return(
+            EncodedImageCallback::Result(EncodedImageCallback::Result::OK, 0)));
+  }
+
   void ExpectStreams(FrameType frame_type, int expected_video_streams) {
     ASSERT_GE(expected_video_streams, 0);
     ASSERT_LE(expected_video_streams, kNumberOfSimulcastStreams);
@@ -369,6 +383,29 @@ class TestVp8Simulcast : public ::testing::Test {
     EXPECT_EQ(0, encoder_->Encode(*input_frame_, NULL, &frame_types));
   }
 
+  // For encoders with independent encoders per stream.
+  void TestKeyFrameRequestsOnRequestedStreams() {
+    SetRates(kMaxBitrates[2], 30);  // To get all three streams.
+    std::vector<FrameType> frame_types(kNumberOfSimulcastStreams,
+                                       kVideoFrameDelta);
+    ExpectStreams(kVideoFrameKey, kNumberOfSimulcastStreams);
+    EXPECT_EQ(0, encoder_->Encode(*input_frame_, NULL, &frame_types));
+
+    for (int stream = 0; stream < kNumberOfSimulcastStreams; ++stream) {
+      std::fill(frame_types.begin(), frame_types.end(), kVideoFrameDelta);
+      frame_types[stream] = kVideoFrameKey;
+      for (int i = 0; i < kNumberOfSimulcastStreams; ++i)
+        ExpectStream(i == stream ? kVideoFrameKey : kVideoFrameDelta, i);
+      input_frame_->set_timestamp(input_frame_->timestamp() + 3000);
+      EXPECT_EQ(0, encoder_->Encode(*input_frame_, NULL, &frame_types));
+    }
+
+    std::fill(frame_types.begin(), frame_types.end(), kVideoFrameDelta);
+    ExpectStreams(kVideoFrameDelta, kNumberOfSimulcastStreams);
+    input_frame_->set_timestamp(input_frame_->timestamp() + 3000);
+    EXPECT_EQ(0, encoder_->Encode(*input_frame_, NULL, &frame_types));
+  }
+
   void TestPaddingAllStreams() {
     // We should always encode the base layer.
     SetRates(kMinBitrates[0] - 1, 30);
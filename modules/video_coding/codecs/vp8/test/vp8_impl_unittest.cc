@@ -19,6 +19,8 @@
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
 #include "webrtc/modules/video_coding/codecs/vp8/include/vp8.h"
 #include "webrtc/modules/video_coding/codecs/vp8/temporal_layers.h"
+#include "webrtc/modules/video_coding/utility/encoder_thread_budget.h"
+#include "webrtc/system_wrappers/include/cpu_info.h"
 #include "webrtc/test/frame_utils.h"
 #include "webrtc/test/gtest.h"
 #include "webrtc/test/testsupport/fileutils.h"
@@ -287,4 +289,69 @@ TEST_F(TestVp8Impl, MAYBE_DecodeWithACompleteKeyFrame) {
   EXPECT_GT(I420PSNR(input_frame_.get(), &*decoded_frame_), 36);
 }
 
+TEST_F(TestVp8Impl, ReconfigureEncodeChangesResolutionInPlace) {
+  SetUpEncodeDecode();
+  encoder_->Encode(*input_frame_, NULL, NULL);
+  EXPECT_GT(WaitForEncodedFrame(), 0u);
+
+  VideoCodec resized_codec = codec_inst_;
+  resized_codec.width = kWidth / 2;
+  resized_codec.height = kHeight / 2;
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, encoder_->ReconfigureEncode(&resized_codec));
+
+  rtc::scoped_refptr<I420Buffer> scaled_buffer(
+      I420Buffer::Create(resized_codec.width, resized_codec.height));
+  scaled_buffer->ScaleFrom(*input_frame_->video_frame_buffer());
+  VideoFrame scaled_frame(scaled_buffer, kVideoRotation_0, 0);
+  encoder_->Encode(scaled_frame, NULL, NULL);
+  EXPECT_GT(WaitForEncodedFrame(), 0u);
+  EXPECT_EQ(resized_codec.width, encoded_frame_._encodedWidth);
+  EXPECT_EQ(resized_codec.height, encoded_frame_._encodedHeight);
+}
+
+TEST_F(TestVp8Impl, ReconfigureEncodeRejectsNewTemporalLayers) {
+  SetUpEncodeDecode();
+  VideoCodec new_codec = codec_inst_;
+  new_codec.VP8()->numberOfTemporalLayers = 2;
+  EXPECT_NE(WEBRTC_VIDEO_CODEC_OK, encoder_->ReconfigureEncode(&new_codec));
+}
+
+TEST_F(TestVp8Impl, ReinitializesEncoderWhenThreadGrantChanges) {
+  EncoderThreadBudget* budget = EncoderThreadBudget::GetInstance();
+  budget->SetTotalThreads(4);
+  SetUpEncodeDecode();
+  // Large enough for the encoder to ask for two threads.
+  codec_inst_.width = 1280;
+  codec_inst_.height = 720;
+  const int kNumberOfCores = 4;
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->InitEncode(&codec_inst_, kNumberOfCores, 1440));
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK, decoder_->InitDecode(&codec_inst_, 1));
+  rtc::scoped_refptr<I420Buffer> buffer(
+      I420Buffer::Create(codec_inst_.width, codec_inst_.height));
+  I420Buffer::SetBlack(buffer.get());
+  VideoFrame frame(buffer, kVideoRotation_0, 0);
+  encoder_->Encode(frame, NULL, NULL);
+  EXPECT_GT(WaitForEncodedFrame(), 0u);
+  encoder_->Encode(frame, NULL, NULL);
+  EXPECT_GT(WaitForEncodedFrame(), 0u);
+  EXPECT_EQ(kVideoFrameDelta, encoded_frame_._frameType);
+
+  // libvpx takes the new thread count at init, which restarts the stream.
+  budget->SetTotalThreads(1);
+  BitrateAllocation bitrate_allocation;
+  bitrate_allocation.SetBitrate(0, 0, codec_inst_.startBitrate * 1000);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            encoder_->SetRateAllocation(bitrate_allocation,
+                                        codec_inst_.maxFramerate));
+  encoder_->Encode(frame, NULL, NULL);
+  EXPECT_GT(WaitForEncodedFrame(), 0u);
+  EXPECT_EQ(kVideoFrameKey, encoded_frame_._frameType);
+  EXPECT_EQ(WEBRTC_VIDEO_CODEC_OK,
+            decoder_->Decode(encoded_frame_, false, NULL));
+  EXPECT_GT(WaitForDecodedFrame(), 0u);
+
+  budget->SetTotalThreads(CpuInfo::DetectNumberOfCores());
+}
+
 }  // namespace webrtc
@@ -19,7 +19,9 @@
 #include "libyuv/scale.h"    // NOLINT
 #include "libyuv/convert.h"  // NOLINT
 
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/checks.h"
+#include "webrtc/base/event.h"
 #include "webrtc/base/timeutils.h"
 #include "webrtc/base/trace_event.h"
 #include "webrtc/common_types.h"
@@ -29,8 +31,10 @@
 #include "webrtc/modules/video_coding/codecs/vp8/include/vp8_common_types.h"
 #include "webrtc/modules/video_coding/codecs/vp8/screenshare_layers.h"
 #include "webrtc/modules/video_coding/codecs/vp8/temporal_layers.h"
+#include "webrtc/modules/video_coding/utility/encoder_thread_budget.h"
 #include "webrtc/modules/video_coding/utility/simulcast_rate_allocator.h"
 #include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/system_wrappers/include/field_trial.h"
 #include "webrtc/system_wrappers/include/metrics.h"
 
 namespace webrtc {
@@ -39,6 +43,9 @@ namespace {
 enum { kVp8ErrorPropagationTh = 30 };
 enum { kVp832ByteAlign = 32 };
 
+const char kParallelSimulcastEncodingFieldTrial[] =
+    "WebRTC-VP8-ParallelSimulcastEncoding";
+
 // VP8 denoiser states.
 enum denoiserState {
   kDenoiserOff,
@@ -119,11 +126,13 @@ VP8EncoderImpl::VP8EncoderImpl()
       qp_max_(56),  // Setting for max quantizer.
       cpu_speed_default_(-6),
       number_of_cores_(0),
+      thread_budget_id_(-1),
       rc_max_intra_target_(0),
       token_partitions_(VP8_ONE_TOKENPARTITION),
       down_scale_requested_(false),
       down_scale_bitrate_(0),
-      key_frame_request_(kMaxSimulcastStreams, false) {
+      key_frame_request_(kMaxSimulcastStreams, false),
+      encode_layers_in_parallel_(false) {
   uint32_t seed = rtc::Time32();
   srand(seed);
 
@@ -146,6 +155,13 @@ VP8EncoderImpl::~VP8EncoderImpl() {
 int VP8EncoderImpl::Release() {
   int ret_val = WEBRTC_VIDEO_CODEC_OK;
 
+  layer_encode_queues_.clear();
+
+  if (thread_budget_id_ != -1) {
+    EncoderThreadBudget::GetInstance()->Unregister(thread_budget_id_);
+    thread_budget_id_ = -1;
+  }
+
   while (!encoded_images_.empty()) {
     EncodedImage& image = encoded_images_.back();
     delete[] image._buffer;
@@ -236,6 +252,15 @@ int VP8EncoderImpl::SetRateAllocation(const BitrateAllocation& bitrate,
     }
   }
 
+  // Follow the thread budget as other encoders come and go. libvpx only
+  // sets up the VP8 encoder threads when the encoder is initialized, so the
+  // encoders are initialized again when the grant changes. The lower
+  // simulcast streams always use one thread.
+  const unsigned int threads =
+      EncoderThreadBudget::GetInstance()->GetGrantedThreads(thread_budget_id_);
+  const bool reinit = threads != configurations_[0].g_threads;
+  configurations_[0].g_threads = threads;
+
   size_t stream_idx = encoders_.size() - 1;
   for (size_t i = 0; i < encoders_.size(); ++i, --stream_idx) {
     unsigned int target_bitrate_kbps =
@@ -248,10 +273,13 @@ int VP8EncoderImpl::SetRateAllocation(const BitrateAllocation& bitrate,
     configurations_[i].rc_target_bitrate = target_bitrate_kbps;
     temporal_layers_[stream_idx]->UpdateConfiguration(&configurations_[i]);
 
-    if (vpx_codec_enc_config_set(&encoders_[i], &configurations_[i])) {
+    if (!reinit &&
+        vpx_codec_enc_config_set(&encoders_[i], &configurations_[i])) {
       return WEBRTC_VIDEO_CODEC_ERROR;
     }
   }
+  if (reinit)
+    return ReinitEncoders();
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
@@ -336,6 +364,20 @@ int VP8EncoderImpl::InitEncode(const VideoCodec* inst,
   timestamp_ = 0;
   codec_ = *inst;
 
+  // Encoding the layers with independent encoders in parallel loses libvpx's
+  // reuse of the motion search of the higher resolutions for the lower ones,
+  // but no longer has a single thread encode all the layers one by one.
+  encode_layers_in_parallel_ =
+      number_of_streams > 1 &&
+      field_trial::FindFullName(kParallelSimulcastEncodingFieldTrial) ==
+          "Enabled";
+  if (encode_layers_in_parallel_) {
+    for (int i = 1; i < number_of_streams; ++i) {
+      layer_encode_queues_.emplace_back(
+          new rtc::TaskQueue("VP8LayerEncodeQueue"));
+    }
+  }
+
   // Code expects simulcastStream resolutions to be correct, make sure they are
   // filled even when there are no simulcast layers.
   if (codec_.numberOfSimulcastStreams == 0) {
@@ -473,8 +515,14 @@ int VP8EncoderImpl::InitEncode(const VideoCodec* inst,
 
   // Determine number of threads based on the image size and #cores.
   // TODO(fbarchard): Consider number of Simulcast layers.
-  configurations_[0].g_threads = NumberOfThreads(
-      configurations_[0].g_w, configurations_[0].g_h, number_of_cores);
+  // The thread count NumberOfThreads() picks is what this encoder would use
+  // on an otherwise idle machine; the budget shares the cores between all
+  // encoders in the process.
+  thread_budget_id_ = EncoderThreadBudget::GetInstance()->Register(
+      NumberOfThreads(configurations_[0].g_w, configurations_[0].g_h,
+                      number_of_cores));
+  configurations_[0].g_threads =
+      EncoderThreadBudget::GetInstance()->GetGrantedThreads(thread_budget_id_);
 
   // Creating a wrapper to the image - setting image data to NULL.
   // Actual pointer will be set in encode. Setting align to 1, as it
@@ -526,6 +574,40 @@ int VP8EncoderImpl::InitEncode(const VideoCodec* inst,
   return InitAndSetControlSettings();
 }
 
+int VP8EncoderImpl::ReconfigureEncode(const VideoCodec* inst) {
+  if (!inited_)
+    return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+  if (inst == NULL || inst->width <= 1 || inst->height <= 1 ||
+      (inst->maxBitrate > 0 && inst->startBitrate > inst->maxBitrate)) {
+    return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
+  }
+  // Simulcast layers are sized relative to each other and the temporal layers
+  // are set up at InitEncode(), so only a single stream with otherwise
+  // unchanged settings can be resized in place.
+  if (encoders_.size() != 1 || NumberOfStreams(*inst) != 1 ||
+      inst->codecType != kVideoCodecVP8 || inst->mode != codec_.mode ||
+      inst->qpMax != codec_.qpMax ||
+      memcmp(&inst->VP8(), codec_.VP8(), sizeof(inst->VP8())) != 0) {
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+  if (inst->numberOfSimulcastStreams == 1 &&
+      inst->simulcastStream[0].numberOfTemporalLayers !=
+          codec_.simulcastStream[0].numberOfTemporalLayers) {
+    return WEBRTC_VIDEO_CODEC_ERROR;
+  }
+
+  codec_.startBitrate = inst->startBitrate;
+  codec_.minBitrate = inst->minBitrate;
+  codec_.maxBitrate = inst->maxBitrate;
+  codec_.numberOfSimulcastStreams = inst->numberOfSimulcastStreams;
+  codec_.simulcastStream[0] = inst->simulcastStream[0];
+  if (inst->width == codec_.width && inst->height == codec_.height)
+    return WEBRTC_VIDEO_CODEC_OK;
+  // Keeps the rate control, temporal layer and picture id state; libvpx
+  // encodes a key frame at the new size.
+  return UpdateCodecFrameSize(inst->width, inst->height);
+}
+
 int VP8EncoderImpl::SetCpuSpeed(int width, int height) {
 #if defined(WEBRTC_ARCH_ARM) || defined(WEBRTC_ARCH_ARM64) || defined(ANDROID)
   // On mobile platform, use a lower speed setting for lower resolutions for
@@ -585,7 +667,7 @@ int VP8EncoderImpl::InitAndSetControlSettings() {
   vpx_codec_flags_t flags = 0;
   flags |= VPX_CODEC_USE_OUTPUT_PARTITION;
 
-  if (encoders_.size() > 1) {
+  if (encoders_.size() > 1 && !encode_layers_in_parallel_) {
     int error = vpx_codec_enc_init_multi(&encoders_[0], vpx_codec_vp8_cx(),
                                          &configurations_[0], encoders_.size(),
                                          flags, &downsampling_factors_[0]);
@@ -593,9 +675,11 @@ int VP8EncoderImpl::InitAndSetControlSettings() {
       return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
     }
   } else {
-    if (vpx_codec_enc_init(&encoders_[0], vpx_codec_vp8_cx(),
-                           &configurations_[0], flags)) {
-      return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+    for (size_t i = 0; i < encoders_.size(); ++i) {
+      if (vpx_codec_enc_init(&encoders_[i], vpx_codec_vp8_cx(),
+                             &configurations_[i], flags)) {
+        return WEBRTC_VIDEO_CODEC_UNINITIALIZED;
+      }
     }
   }
   // Enable denoising for the highest resolution stream, and for
@@ -636,6 +720,21 @@ int VP8EncoderImpl::InitAndSetControlSettings() {
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+int VP8EncoderImpl::ReinitEncoders() {
+  inited_ = false;
+  // In reverse, as in Release().
+  for (auto it = encoders_.rbegin(); it != encoders_.rend(); ++it) {
+    if (vpx_codec_destroy(&*it))
+      return WEBRTC_VIDEO_CODEC_MEMORY;
+  }
+  int ret = InitAndSetControlSettings();
+  if (ret != WEBRTC_VIDEO_CODEC_OK)
+    return ret;
+  // The new encoders start from a key frame.
+  std::fill(key_frame_request_.begin(), key_frame_request_.end(), true);
+  return WEBRTC_VIDEO_CODEC_OK;
+}
+
 uint32_t VP8EncoderImpl::MaxIntraTarget(uint32_t optimalBuffersize) {
   // Set max to the optimal buffer level (normalized by target BR),
   // and scaled by a scalePar.
@@ -684,20 +783,25 @@ int VP8EncoderImpl::Encode(const VideoFrame& frame,
   raw_images_[0].stride[VPX_PLANE_U] = input_image->StrideU();
   raw_images_[0].stride[VPX_PLANE_V] = input_image->StrideV();
 
-  for (size_t i = 1; i < encoders_.size(); ++i) {
-    // Scale the image down a number of times by downsampling factor
-    libyuv::I420Scale(
-        raw_images_[i - 1].planes[VPX_PLANE_Y],
-        raw_images_[i - 1].stride[VPX_PLANE_Y],
-        raw_images_[i - 1].planes[VPX_PLANE_U],
-        raw_images_[i - 1].stride[VPX_PLANE_U],
-        raw_images_[i - 1].planes[VPX_PLANE_V],
-        raw_images_[i - 1].stride[VPX_PLANE_V], raw_images_[i - 1].d_w,
-        raw_images_[i - 1].d_h, raw_images_[i].planes[VPX_PLANE_Y],
-        raw_images_[i].stride[VPX_PLANE_Y], raw_images_[i].planes[VPX_PLANE_U],
-        raw_images_[i].stride[VPX_PLANE_U], raw_images_[i].planes[VPX_PLANE_V],
-        raw_images_[i].stride[VPX_PLANE_V], raw_images_[i].d_w,
-        raw_images_[i].d_h, libyuv::kFilterBilinear);
+  // When encoding in parallel, each layer is downscaled by EncodeLayer.
+  if (!encode_layers_in_parallel_) {
+    for (size_t i = 1; i < encoders_.size(); ++i) {
+      // Scale the image down a number of times by downsampling factor
+      libyuv::I420Scale(
+          raw_images_[i - 1].planes[VPX_PLANE_Y],
+          raw_images_[i - 1].stride[VPX_PLANE_Y],
+          raw_images_[i - 1].planes[VPX_PLANE_U],
+          raw_images_[i - 1].stride[VPX_PLANE_U],
+          raw_images_[i - 1].planes[VPX_PLANE_V],
+          raw_images_[i - 1].stride[VPX_PLANE_V], raw_images_[i - 1].d_w,
+          raw_images_[i - 1].d_h, raw_images_[i].planes[VPX_PLANE_Y],
+          raw_images_[i].stride[VPX_PLANE_Y],
+          raw_images_[i].planes[VPX_PLANE_U],
+          raw_images_[i].stride[VPX_PLANE_U],
+          raw_images_[i].planes[VPX_PLANE_V],
+          raw_images_[i].stride[VPX_PLANE_V], raw_images_[i].d_w,
+          raw_images_[i].d_h, libyuv::kFilterBilinear);
+    }
   }
   vpx_enc_frame_flags_t flags[kMaxSimulcastStreams];
   for (size_t i = 0; i < encoders_.size(); ++i) {
@@ -708,26 +812,29 @@ int VP8EncoderImpl::Encode(const VideoFrame& frame,
     }
     flags[i] = ret;
   }
+  bool key_frame_requested[kMaxSimulcastStreams] = {false};
   bool send_key_frame = false;
   for (size_t i = 0; i < key_frame_request_.size() && i < send_stream_.size();
        ++i) {
     if (key_frame_request_[i] && send_stream_[i]) {
+      key_frame_requested[i] = true;
       send_key_frame = true;
-      break;
     }
   }
-  if (!send_key_frame && frame_types) {
+  if (frame_types) {
     for (size_t i = 0; i < frame_types->size() && i < send_stream_.size();
          ++i) {
       if ((*frame_types)[i] == kVideoFrameKey && send_stream_[i]) {
+        key_frame_requested[i] = true;
         send_key_frame = true;
-        break;
       }
     }
   }
-  // The flag modification below (due to forced key frame, RPS, etc.,) for now
-  // will be the same for all encoders/spatial layers.
-  // TODO(marpan/holmer): Allow for key frame request to be set per encoder.
+  // The flag modification below (due to RPS, etc.,) for now will be the same
+  // for all encoders/spatial layers. Key frames are too when the layers share
+  // one multi-resolution encoder, since libvpx takes the frame type of all
+  // the layers from the lowest one; independent encoders only restart the
+  // layers a key frame was requested for.
   bool only_predict_from_key_frame = false;
   if (send_key_frame) {
     // Adapt the size of the key frame when in screenshare with 1 temporal
@@ -741,9 +848,11 @@ int VP8EncoderImpl::Encode(const VideoFrame& frame,
     // Key frame request from caller.
     // Will update both golden and alt-ref.
     for (size_t i = 0; i < encoders_.size(); ++i) {
-      flags[i] = VPX_EFLAG_FORCE_KF;
+      if (key_frame_requested[i] || !encode_layers_in_parallel_) {
+        flags[i] = VPX_EFLAG_FORCE_KF;
+        key_frame_request_[i] = false;
+      }
     }
-    std::fill(key_frame_request_.begin(), key_frame_request_.end(), false);
   } else if (codec_specific_info &&
              codec_specific_info->codecType == kVideoCodecVP8) {
     if (feedback_mode_) {
@@ -815,8 +924,13 @@ int VP8EncoderImpl::Encode(const VideoFrame& frame,
 
   // Note we must pass 0 for |flags| field in encode call below since they are
   // set above in |vpx_codec_control| function for each encoder/spatial layer.
-  int error = vpx_codec_encode(&encoders_[0], &raw_images_[0], timestamp_,
-                               duration, 0, VPX_DL_REALTIME);
+  int error;
+  if (encode_layers_in_parallel_) {
+    error = EncodeLayersInParallel(duration);
+  } else {
+    error = vpx_codec_encode(&encoders_[0], &raw_images_[0], timestamp_,
+                             duration, 0, VPX_DL_REALTIME);
+  }
   // Reset specific intra frame thresholds, following the key frame.
   if (send_key_frame) {
     vpx_codec_control(&(encoders_[0]), VP8E_SET_MAX_INTRA_BITRATE_PCT,
@@ -829,6 +943,60 @@ int VP8EncoderImpl::Encode(const VideoFrame& frame,
   return GetEncodedPartitions(frame, only_predict_from_key_frame);
 }
 
+int VP8EncoderImpl::EncodeLayer(size_t encoder_idx, uint32_t duration) {
+  int64_t start_ms = rtc::TimeMillis();
+  if (encoder_idx > 0) {
+    // Scale from the input image rather than from the next higher resolution,
+    // so that the layers don't depend on each other.
+    libyuv::I420Scale(
+        raw_images_[0].planes[VPX_PLANE_Y], raw_images_[0].stride[VPX_PLANE_Y],
+        raw_images_[0].planes[VPX_PLANE_U], raw_images_[0].stride[VPX_PLANE_U],
+        raw_images_[0].planes[VPX_PLANE_V], raw_images_[0].stride[VPX_PLANE_V],
+        raw_images_[0].d_w, raw_images_[0].d_h,
+        raw_images_[encoder_idx].planes[VPX_PLANE_Y],
+        raw_images_[encoder_idx].stride[VPX_PLANE_Y],
+        raw_images_[encoder_idx].planes[VPX_PLANE_U],
+        raw_images_[encoder_idx].stride[VPX_PLANE_U],
+        raw_images_[encoder_idx].planes[VPX_PLANE_V],
+        raw_images_[encoder_idx].stride[VPX_PLANE_V],
+        raw_images_[encoder_idx].d_w, raw_images_[encoder_idx].d_h,
+        libyuv::kFilterBilinear);
+  }
+  int error = vpx_codec_encode(&encoders_[encoder_idx],
+                               &raw_images_[encoder_idx], timestamp_, duration,
+                               0, VPX_DL_REALTIME);
+  encoded_images_[encoder_idx].encode_time_ms_ =
+      static_cast<int>(rtc::TimeMillis() - start_ms);
+  return error;
+}
+
+int VP8EncoderImpl::EncodeLayersInParallel(uint32_t duration) {
+  RTC_DCHECK_EQ(encoders_.size() - 1, layer_encode_queues_.size());
+  std::vector<int> errors(encoders_.size(), 0);
+  volatile int num_pending = static_cast<int>(layer_encode_queues_.size());
+  rtc::Event done(false, false);
+  for (size_t i = 1; i < encoders_.size(); ++i) {
+    layer_encode_queues_[i - 1]->PostTask(
+        [this, i, duration, &errors, &num_pending, &done]() {
+          // Unlike the multi-resolution encoder, an independent encoder
+          // doesn't drop frames of a layer that has no bitrate.
+          if (send_stream_[encoders_.size() - 1 - i])
+            errors[i] = EncodeLayer(i, duration);
+          if (rtc::AtomicOps::Decrement(&num_pending) == 0)
+            done.Set();
+        });
+  }
+  if (send_stream_[encoders_.size() - 1])
+    errors[0] = EncodeLayer(0, duration);
+  done.Wait(rtc::Event::kForever);
+
+  for (int error : errors) {
+    if (error)
+      return error;
+  }
+  return 0;
+}
+
 // TODO(pbos): Make sure this works for properly for >1 encoders.
 int VP8EncoderImpl::UpdateCodecFrameSize(int width, int height) {
   codec_.width = width;
@@ -1222,6 +1390,12 @@ int VP8DecoderImpl::ReturnFrame(const vpx_image_t* img,
     return WEBRTC_VIDEO_CODEC_NO_OUTPUT;
   }
 
+  // Unlike VP9, see Vp9FrameBufferPool, libvpx can't decode VP8 into external
+  // frame buffers (vpx_codec_set_frame_buffer_functions is only supported by
+  // the VP9 decoder), and |img| points into buffers that the decoder reuses
+  // when decoding the next frame, like its post-processing buffer. Decoded
+  // frames may be rendered after that, so they can't wrap |img| and have to be
+  // copied out.
   libyuv::I420Copy(img->planes[VPX_PLANE_Y], img->stride[VPX_PLANE_Y],
                    img->planes[VPX_PLANE_U], img->stride[VPX_PLANE_U],
                    img->planes[VPX_PLANE_V], img->stride[VPX_PLANE_V],
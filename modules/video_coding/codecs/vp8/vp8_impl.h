@@ -24,6 +24,7 @@
 #include "vpx/vp8dx.h"
 
 #include "webrtc/api/video/video_frame.h"
+#include "webrtc/base/task_queue.h"
 #include "webrtc/common_video/include/i420_buffer_pool.h"
 #include "webrtc/modules/video_coding/include/video_codec_interface.h"
 #include "webrtc/modules/video_coding/codecs/vp8/include/vp8.h"
@@ -47,6 +48,10 @@ class VP8EncoderImpl : public VP8Encoder {
                  int number_of_cores,
                  size_t max_payload_size) override;
 
+  // Applies a new resolution or new bitrate limits of a single stream encoder
+  // in place. Everything else needs a new InitEncode().
+  int ReconfigureEncode(const VideoCodec* codec_settings) override;
+
   int Encode(const VideoFrame& input_image,
              const CodecSpecificInfo* codec_specific_info,
              const std::vector<FrameType>* frame_types) override;
@@ -76,6 +81,10 @@ class VP8EncoderImpl : public VP8Encoder {
   // Call encoder initialize function and set control settings.
   int InitAndSetControlSettings();
 
+  // Destroys the initialized encoders and initializes them again with
+  // |configurations_|, for changes that libvpx only applies at init.
+  int ReinitEncoders();
+
   // Update frame size for codec.
   int UpdateCodecFrameSize(int width, int height);
 
@@ -85,6 +94,15 @@ class VP8EncoderImpl : public VP8Encoder {
                              uint32_t timestamp,
                              bool only_predicting_from_key_frame);
 
+  // Downscales the input image for |encoders_[encoder_idx]|, unless it's the
+  // highest resolution, and encodes it. Only used when the simulcast layers
+  // are encoded in parallel, as independent encoders.
+  int EncodeLayer(size_t encoder_idx, uint32_t duration);
+
+  // Encodes the lower resolution layers on |layer_encode_queues_| and the
+  // highest one on the calling thread, and waits until all are encoded.
+  int EncodeLayersInParallel(uint32_t duration);
+
   int GetEncodedPartitions(const VideoFrame& input_image,
                            bool only_predicting_from_key_frame);
 
@@ -101,6 +119,9 @@ class VP8EncoderImpl : public VP8Encoder {
   int qp_max_;
   int cpu_speed_default_;
   int number_of_cores_;
+  // Registration of the highest resolution stream with the process-wide
+  // EncoderThreadBudget, or -1 while not initialized.
+  int thread_budget_id_;
   uint32_t rc_max_intra_target_;
   int token_partitions_;
   ReferencePictureSelection rps_;
@@ -117,6 +138,12 @@ class VP8EncoderImpl : public VP8Encoder {
   std::vector<vpx_codec_ctx_t> encoders_;
   std::vector<vpx_codec_enc_cfg_t> configurations_;
   std::vector<vpx_rational_t> downsampling_factors_;
+  // Set by the "WebRTC-VP8-ParallelSimulcastEncoding" field trial when
+  // encoding more than one simulcast layer.
+  bool encode_layers_in_parallel_;
+  // One queue per simulcast layer except the highest resolution one, in the
+  // same order as |encoders_|.
+  std::vector<std::unique_ptr<rtc::TaskQueue>> layer_encode_queues_;
 };  // end of VP8EncoderImpl class
 
 class VP8DecoderImpl : public VP8Decoder {
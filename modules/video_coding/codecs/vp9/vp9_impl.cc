@@ -29,10 +29,26 @@
 #include "webrtc/common_video/include/video_frame_buffer.h"
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
 #include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/modules/video_coding/utility/encoder_thread_budget.h"
 #include "webrtc/modules/video_coding/codecs/vp9/screenshare_layers.h"
 
 namespace webrtc {
 
+namespace {
+// Fastest speed UpdateCpuSpeed() will step up to.
+const int kMaxCpuSpeed = 8;
+// Encode usage thresholds, in percent, matching the defaults of the
+// OveruseFrameDetector. The low threshold is half of the high one so that a
+// speed step does not jump all the way across the interval.
+const int kHighEncodeUsagePercent = 85;
+const int kLowEncodeUsagePercent = (kHighEncodeUsagePercent - 1) / 2;
+// Number of frames between speed changes, which is also the number of
+// samples needed before the first one.
+const int kCpuSpeedCheckIntervalFrames = 30;
+const float kEncodeTimeFilterAlpha = 0.9f;
+const float kFrameIntervalFilterAlpha = 0.95f;
+}  // namespace
+
 // Only positive speeds, range for real-time coding currently is: 5 - 8.
 // Lower means slower/better quality, higher means fastest/lower quality.
 int GetCpuSpeed(int width, int height) {
@@ -69,6 +85,11 @@ VP9EncoderImpl::VP9EncoderImpl()
       timestamp_(0),
       picture_id_(0),
       cpu_speed_(3),
+      min_cpu_speed_(3),
+      filtered_encode_time_us_(kEncodeTimeFilterAlpha),
+      filtered_frame_interval_us_(kFrameIntervalFilterAlpha),
+      frames_since_cpu_speed_check_(0),
+      thread_budget_id_(-1),
       rc_max_intra_target_(0),
       encoder_(NULL),
       config_(NULL),
@@ -93,6 +114,10 @@ VP9EncoderImpl::~VP9EncoderImpl() {
 }
 
 int VP9EncoderImpl::Release() {
+  if (thread_budget_id_ != -1) {
+    EncoderThreadBudget::GetInstance()->Unregister(thread_budget_id_);
+    thread_budget_id_ = -1;
+  }
   if (encoded_image_._buffer != NULL) {
     delete[] encoded_image_._buffer;
     encoded_image_._buffer = NULL;
@@ -222,6 +247,16 @@ int VP9EncoderImpl::SetRateAllocation(
     return WEBRTC_VIDEO_CODEC_ERR_PARAMETER;
   }
 
+  // Follow the thread budget as other encoders come and go. Keep the tile
+  // columns matching the thread count, as in InitAndSetControlSettings().
+  unsigned int threads =
+      EncoderThreadBudget::GetInstance()->GetGrantedThreads(thread_budget_id_);
+  if (threads != config_->g_threads) {
+    config_->g_threads = threads;
+    vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS,
+                      (config_->g_threads >> 1));
+  }
+
   // Update encoder context
   if (vpx_codec_enc_config_set(encoder_, config_)) {
     return WEBRTC_VIDEO_CODEC_ERROR;
@@ -328,11 +363,19 @@ int VP9EncoderImpl::InitEncode(const VideoCodec* inst,
     config_->kf_mode = VPX_KF_DISABLED;
   }
   config_->rc_resize_allowed = inst->VP9().automaticResizeOn ? 1 : 0;
-  // Determine number of threads based on the image size and #cores.
+  // Determine number of threads based on the image size and #cores, within
+  // the budget shared by all encoders in the process.
+  thread_budget_id_ = EncoderThreadBudget::GetInstance()->Register(
+      NumberOfThreads(config_->g_w, config_->g_h, number_of_cores));
   config_->g_threads =
-      NumberOfThreads(config_->g_w, config_->g_h, number_of_cores);
+      EncoderThreadBudget::GetInstance()->GetGrantedThreads(thread_budget_id_);
 
   cpu_speed_ = GetCpuSpeed(config_->g_w, config_->g_h);
+  min_cpu_speed_ = cpu_speed_;
+  filtered_encode_time_us_.Reset(kEncodeTimeFilterAlpha);
+  filtered_frame_interval_us_.Reset(kFrameIntervalFilterAlpha);
+  last_rtp_timestamp_.reset();
+  frames_since_cpu_speed_check_ = 0;
 
   // TODO(asapersson): Check configuration of temporal switch up and increase
   // pattern length.
@@ -384,6 +427,12 @@ int VP9EncoderImpl::NumberOfThreads(int width,
   // tiles, which is (1, 2, 4, 8). See comments below for VP9E_SET_TILE_COLUMNS.
   if (width * height >= 1280 * 720 && number_of_cores > 4) {
     return 4;
+#if defined(VPX_CTRL_VP9E_SET_ROW_MT)
+  } else if (width * height >= 1280 * 720 && number_of_cores == 4) {
+    // With row based multithreading the threads are no longer bound to the
+    // two tile columns available at 720p, so use all but one core.
+    return 3;
+#endif
   } else if (width * height >= 640 * 480 && number_of_cores > 2) {
     return 2;
   } else {
@@ -449,6 +498,14 @@ int VP9EncoderImpl::InitAndSetControlSettings(const VideoCodec* inst) {
   // The number tile columns will be capped by the encoder based on image size
   // (minimum width of tile column is 256 pixels, maximum is 4096).
   vpx_codec_control(encoder_, VP9E_SET_TILE_COLUMNS, (config_->g_threads >> 1));
+#if defined(VPX_CTRL_VP9E_SET_ROW_MT)
+  // Let the threads also split the superblock rows within each tile column,
+  // so that resolutions with few tile columns still use all threads.
+  vpx_codec_control(encoder_, VP9E_SET_ROW_MT, 1);
+#endif
+  // Frames never depend on probability context updates of previous frames,
+  // which allows the receiver to decode them in parallel.
+  vpx_codec_control(encoder_, VP9E_SET_FRAME_PARALLEL_DECODING, 1);
 #if !defined(WEBRTC_ARCH_ARM) && !defined(WEBRTC_ARCH_ARM64) && \
   !defined(ANDROID)
   // Note denoiser is still off by default until further testing/optimization,
@@ -547,15 +604,57 @@ int VP9EncoderImpl::Encode(const VideoFrame& input_image,
 
   assert(codec_.maxFramerate > 0);
   uint32_t duration = 90000 / codec_.maxFramerate;
+  int64_t encode_start_us = rtc::TimeMicros();
   if (vpx_codec_encode(encoder_, raw_, timestamp_, duration, flags,
                        VPX_DL_REALTIME)) {
     return WEBRTC_VIDEO_CODEC_ERROR;
   }
   timestamp_ += duration;
+  UpdateCpuSpeed(input_image.timestamp(), rtc::TimeMicros() - encode_start_us);
 
   return WEBRTC_VIDEO_CODEC_OK;
 }
 
+void VP9EncoderImpl::UpdateCpuSpeed(uint32_t rtp_timestamp,
+                                    int64_t encode_time_us) {
+  // Screen content keeps its speed; frame intervals there are irregular.
+  if (codec_.mode != kRealtimeVideo)
+    return;
+  if (last_rtp_timestamp_) {
+    // 90 kHz RTP clock.
+    int64_t frame_interval_us =
+        static_cast<uint32_t>(rtp_timestamp - *last_rtp_timestamp_) * 100 / 9;
+    if (frame_interval_us > 0) {
+      filtered_frame_interval_us_.Apply(1.0f, frame_interval_us);
+      filtered_encode_time_us_.Apply(1.0f, encode_time_us);
+    }
+  }
+  last_rtp_timestamp_ = rtc::Optional<uint32_t>(rtp_timestamp);
+
+  if (++frames_since_cpu_speed_check_ < kCpuSpeedCheckIntervalFrames)
+    return;
+  frames_since_cpu_speed_check_ = 0;
+  if (filtered_frame_interval_us_.filtered() <= 0)
+    return;
+  int usage_percent = static_cast<int>(
+      100 * filtered_encode_time_us_.filtered() /
+      filtered_frame_interval_us_.filtered());
+  int cpu_speed = cpu_speed_;
+  if (usage_percent > kHighEncodeUsagePercent && cpu_speed < kMaxCpuSpeed) {
+    ++cpu_speed;
+  } else if (usage_percent < kLowEncodeUsagePercent &&
+             cpu_speed > min_cpu_speed_) {
+    --cpu_speed;
+  }
+  if (cpu_speed != cpu_speed_) {
+    LOG(LS_INFO) << "VP9 encode usage " << usage_percent
+                 << "%, changing cpu speed from " << cpu_speed_ << " to "
+                 << cpu_speed;
+    cpu_speed_ = cpu_speed;
+    vpx_codec_control(encoder_, VP8E_SET_CPUUSED, cpu_speed_);
+  }
+}
+
 void VP9EncoderImpl::PopulateCodecSpecific(CodecSpecificInfo* codec_specific,
                                            const vpx_codec_cx_pkt& pkt,
                                            uint32_t timestamp) {
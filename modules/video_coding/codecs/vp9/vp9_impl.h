@@ -15,6 +15,8 @@
 #include <memory>
 #include <vector>
 
+#include "webrtc/base/numerics/exp_filter.h"
+#include "webrtc/base/optional.h"
 #include "webrtc/modules/video_coding/codecs/vp9/include/vp9.h"
 #include "webrtc/modules/video_coding/codecs/vp9/vp9_frame_buffer_pool.h"
 
@@ -102,6 +104,12 @@ class VP9EncoderImpl : public VP9Encoder {
   //                            percentage of the per frame bandwidth
   uint32_t MaxIntraTarget(uint32_t optimal_buffer_size);
 
+  // Tracks the encode usage (the average encode time divided by the average
+  // time between frames) and steps |cpu_speed_| up when the encoder is close
+  // to running out of headroom, and back down towards |min_cpu_speed_| when
+  // there is plenty of it.
+  void UpdateCpuSpeed(uint32_t rtp_timestamp, int64_t encode_time_us);
+
   EncodedImage encoded_image_;
   EncodedImageCallback* encoded_complete_callback_;
   VideoCodec codec_;
@@ -109,6 +117,16 @@ class VP9EncoderImpl : public VP9Encoder {
   int64_t timestamp_;
   uint16_t picture_id_;
   int cpu_speed_;
+  // The resolution based speed set at InitEncode(), which is the slowest
+  // (best quality) speed UpdateCpuSpeed() will go back to.
+  int min_cpu_speed_;
+  rtc::ExpFilter filtered_encode_time_us_;
+  rtc::ExpFilter filtered_frame_interval_us_;
+  rtc::Optional<uint32_t> last_rtp_timestamp_;
+  int frames_since_cpu_speed_check_;
+  // Registration with the process-wide EncoderThreadBudget, or -1 while not
+  // initialized.
+  int thread_budget_id_;
   uint32_t rc_max_intra_target_;
   vpx_codec_ctx_t* encoder_;
   vpx_codec_enc_cfg_t* config_;
@@ -0,0 +1,154 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_VIDEO_CODING_FLAT_MAP_H_
+#define WEBRTC_MODULES_VIDEO_CODING_FLAT_MAP_H_
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace webrtc {
+namespace video_coding {
+
+// Sorted vector drop-in replacements for the subset of std::map and std::set
+// used to track frames by sequence number or picture id. These containers
+// only hold a bounded window of ids, so a contiguous vector makes the lookups
+// cache friendly and inserting and erasing allocation free once it has grown.
+// Positions are found with the same binary searches std::map uses, so they
+// also behave the same with the wrap around aware comparators of
+// sequence_number_util.h. Unlike std::map, inserting or erasing invalidates
+// all iterators and references.
+template <typename Key, typename Value, typename Compare = std::less<Key>>
+class FlatMap {
+ public:
+  using value_type = std::pair<Key, Value>;
+  using iterator = typename std::vector<value_type>::iterator;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+  iterator begin() { return values_.begin(); }
+  iterator end() { return values_.end(); }
+  const_iterator begin() const { return values_.begin(); }
+  const_iterator end() const { return values_.end(); }
+  bool empty() const { return values_.empty(); }
+  size_t size() const { return values_.size(); }
+  void clear() { values_.clear(); }
+
+  iterator lower_bound(const Key& key) {
+    return std::lower_bound(
+        values_.begin(), values_.end(), key,
+        [this](const value_type& value, const Key& other) {
+          return comp_(value.first, other);
+        });
+  }
+  const_iterator lower_bound(const Key& key) const {
+    return std::lower_bound(
+        values_.begin(), values_.end(), key,
+        [this](const value_type& value, const Key& other) {
+          return comp_(value.first, other);
+        });
+  }
+  iterator upper_bound(const Key& key) {
+    return std::upper_bound(
+        values_.begin(), values_.end(), key,
+        [this](const Key& other, const value_type& value) {
+          return comp_(other, value.first);
+        });
+  }
+  iterator find(const Key& key) {
+    iterator it = lower_bound(key);
+    return it != end() && !comp_(key, it->first) ? it : end();
+  }
+  const_iterator find(const Key& key) const {
+    const_iterator it = lower_bound(key);
+    return it != end() && !comp_(key, it->first) ? it : end();
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    iterator it = lower_bound(value.first);
+    if (it != end() && !comp_(value.first, it->first))
+      return std::make_pair(it, false);
+    return std::make_pair(values_.insert(it, value), true);
+  }
+  Value& operator[](const Key& key) {
+    return insert(value_type(key, Value())).first->second;
+  }
+
+  iterator erase(iterator it) { return values_.erase(it); }
+  iterator erase(iterator first, iterator last) {
+    return values_.erase(first, last);
+  }
+  size_t erase(const Key& key) {
+    iterator it = find(key);
+    if (it == end())
+      return 0;
+    values_.erase(it);
+    return 1;
+  }
+
+ private:
+  Compare comp_;
+  std::vector<value_type> values_;
+};
+
+template <typename Key, typename Compare = std::less<Key>>
+class FlatSet {
+ public:
+  using iterator = typename std::vector<Key>::iterator;
+  using const_iterator = typename std::vector<Key>::const_iterator;
+
+  iterator begin() { return keys_.begin(); }
+  iterator end() { return keys_.end(); }
+  const_iterator begin() const { return keys_.begin(); }
+  const_iterator end() const { return keys_.end(); }
+  bool empty() const { return keys_.empty(); }
+  size_t size() const { return keys_.size(); }
+  void clear() { keys_.clear(); }
+
+  iterator lower_bound(const Key& key) {
+    return std::lower_bound(keys_.begin(), keys_.end(), key, comp_);
+  }
+  iterator upper_bound(const Key& key) {
+    return std::upper_bound(keys_.begin(), keys_.end(), key, comp_);
+  }
+  iterator find(const Key& key) {
+    iterator it = lower_bound(key);
+    return it != end() && !comp_(key, *it) ? it : end();
+  }
+
+  std::pair<iterator, bool> insert(const Key& key) {
+    iterator it = lower_bound(key);
+    if (it != end() && !comp_(key, *it))
+      return std::make_pair(it, false);
+    return std::make_pair(keys_.insert(it, key), true);
+  }
+
+  iterator erase(iterator it) { return keys_.erase(it); }
+  iterator erase(iterator first, iterator last) {
+    return keys_.erase(first, last);
+  }
+  size_t erase(const Key& key) {
+    iterator it = find(key);
+    if (it == end())
+      return 0;
+    keys_.erase(it);
+    return 1;
+  }
+
+ private:
+  Compare comp_;
+  std::vector<Key> keys_;
+};
+
+}  // namespace video_coding
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_VIDEO_CODING_FLAT_MAP_H_
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <map>
+#include <set>
+
+#include "webrtc/base/random.h"
+#include "webrtc/modules/video_coding/flat_map.h"
+#include "webrtc/modules/video_coding/sequence_number_util.h"
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+namespace video_coding {
+
+TEST(FlatMapTest, InsertFindErase) {
+  FlatMap<int, int> map;
+  EXPECT_TRUE(map.insert(std::make_pair(3, 30)).second);
+  EXPECT_TRUE(map.insert(std::make_pair(1, 10)).second);
+  EXPECT_FALSE(map.insert(std::make_pair(3, 31)).second);
+  map[2] = 20;
+
+  ASSERT_EQ(3u, map.size());
+  EXPECT_EQ(1, map.begin()->first);
+  EXPECT_EQ(30, map.find(3)->second);
+  EXPECT_EQ(20, map[2]);
+  EXPECT_TRUE(map.find(4) == map.end());
+
+  EXPECT_EQ(1u, map.erase(2));
+  EXPECT_EQ(0u, map.erase(2));
+  map.erase(map.begin(), map.lower_bound(3));
+  ASSERT_EQ(1u, map.size());
+  EXPECT_EQ(3, map.begin()->first);
+}
+
+// The containers must order wrapping sequence numbers exactly like the
+// std::map and std::set they replace.
+TEST(FlatMapTest, MatchesStdContainersWithSeqNumComp) {
+  using Comp = DescendingSeqNumComp<uint16_t>;
+  FlatMap<uint16_t, int, Comp> flat_map;
+  FlatSet<uint16_t, Comp> flat_set;
+  std::map<uint16_t, int, Comp> map;
+  std::set<uint16_t, Comp> set;
+
+  Random random(0x1234);
+  uint16_t seq_num = 0xff00;
+  for (int i = 0; i < 2000; ++i) {
+    seq_num += random.Rand(0, 3);
+    uint16_t key = seq_num - random.Rand(0, 50);
+    EXPECT_EQ(map.insert(std::make_pair(key, i)).second,
+              flat_map.insert(std::make_pair(key, i)).second);
+    EXPECT_EQ(set.insert(key).second, flat_set.insert(key).second);
+
+    uint16_t old_seq_num = seq_num - 100;
+    map.erase(map.begin(), map.lower_bound(old_seq_num));
+    flat_map.erase(flat_map.begin(), flat_map.lower_bound(old_seq_num));
+    set.erase(set.begin(), set.lower_bound(old_seq_num));
+    flat_set.erase(flat_set.begin(), flat_set.lower_bound(old_seq_num));
+
+    uint16_t probe = seq_num - random.Rand(0, 60);
+    EXPECT_EQ(map.upper_bound(probe) == map.end(),
+              flat_map.upper_bound(probe) == flat_map.end());
+    if (map.upper_bound(probe) != map.end()) {
+      EXPECT_EQ(map.upper_bound(probe)->first,
+                flat_map.upper_bound(probe)->first);
+    }
+    EXPECT_EQ(set.count(probe) == 1, flat_set.find(probe) != flat_set.end());
+  }
+
+  ASSERT_EQ(map.size(), flat_map.size());
+  ASSERT_EQ(set.size(), flat_set.size());
+  auto flat_map_it = flat_map.begin();
+  for (const auto& entry : map) {
+    EXPECT_EQ(entry.first, flat_map_it->first);
+    EXPECT_EQ(entry.second, flat_map_it->second);
+    ++flat_map_it;
+  }
+  auto flat_set_it = flat_set.begin();
+  for (uint16_t key : set)
+    EXPECT_EQ(key, *flat_set_it++);
+}
+
+}  // namespace video_coding
+}  // namespace webrtc
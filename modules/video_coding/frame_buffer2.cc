@@ -45,7 +45,8 @@ FrameBuffer::FrameBuffer(Clock* clock,
       num_frames_history_(0),
       num_frames_buffered_(0),
       stopped_(false),
-      protection_mode_(kProtectionNack) {}
+      protection_mode_(kProtectionNack),
+      decode_base_layer_only_(false) {}
 
 FrameBuffer::~FrameBuffer() {
   UpdateHistograms();
@@ -71,44 +72,7 @@ FrameBuffer::ReturnReason FrameBuffer::NextFrame(
       // Need to hold |crit_| in order to use |frames_|, therefore we
       // set it here in the loop instead of outside the loop in order to not
       // acquire the lock unnecesserily.
-      next_frame_it = frames_.end();
-
-      // |frame_it| points to the first frame after the
-      // |last_decoded_frame_it_|.
-      auto frame_it = frames_.end();
-      if (last_decoded_frame_it_ == frames_.end()) {
-        frame_it = frames_.begin();
-      } else {
-        frame_it = last_decoded_frame_it_;
-        ++frame_it;
-      }
-
-      // |continuous_end_it| points to the first frame after the
-      // |last_continuous_frame_it_|.
-      auto continuous_end_it = last_continuous_frame_it_;
-      if (continuous_end_it != frames_.end())
-        ++continuous_end_it;
-
-      for (; frame_it != continuous_end_it; ++frame_it) {
-        if (!frame_it->second.continuous ||
-            frame_it->second.num_missing_decodable > 0) {
-          continue;
-        }
-
-        FrameObject* frame = frame_it->second.frame.get();
-        next_frame_it = frame_it;
-        if (frame->RenderTime() == -1)
-          frame->SetRenderTime(timing_->RenderTimeMs(frame->timestamp, now_ms));
-        wait_ms = timing_->MaxWaitingTime(frame->RenderTime(), now_ms);
-
-        // This will cause the frame buffer to prefer high framerate rather
-        // than high resolution in the case of the decoder not decoding fast
-        // enough and the stream has multiple spatial and temporal layers.
-        if (wait_ms == 0)
-          continue;
-
-        break;
-      }
+      next_frame_it = FindNextFrame(now_ms, &wait_ms);
     }  // rtc::Critscope lock(&crit_);
 
     wait_ms = std::min<int64_t>(wait_ms, latest_return_time - now_ms);
@@ -117,36 +81,105 @@ FrameBuffer::ReturnReason FrameBuffer::NextFrame(
 
   rtc::CritScope lock(&crit_);
   if (next_frame_it != frames_.end()) {
-    std::unique_ptr<FrameObject> frame = std::move(next_frame_it->second.frame);
-    int64_t received_time = frame->ReceivedTime();
-    uint32_t timestamp = frame->timestamp;
-
-    int64_t frame_delay;
-    if (inter_frame_delay_.CalculateDelay(timestamp, &frame_delay,
-                                          received_time)) {
-      jitter_estimator_->UpdateEstimate(frame_delay, frame->size());
-    }
-    float rtt_mult = protection_mode_ == kProtectionNackFEC ? 0.0 : 1.0;
-    timing_->SetJitterDelay(jitter_estimator_->GetJitterEstimate(rtt_mult));
-    timing_->UpdateCurrentDelay(frame->RenderTime(),
-                                clock_->TimeInMilliseconds());
-
-    UpdateJitterDelay();
-
-    PropagateDecodability(next_frame_it->second);
-    AdvanceLastDecodedFrame(next_frame_it);
-    *frame_out = std::move(frame);
+    *frame_out = ExtractFrame(next_frame_it);
     return kFrameFound;
   } else {
     return kTimeout;
   }
 }
 
+FrameBuffer::ReturnReason FrameBuffer::NextFrameIfReady(
+    std::unique_ptr<FrameObject>* frame_out,
+    int64_t* wait_ms) {
+  rtc::CritScope lock(&crit_);
+  if (stopped_)
+    return kStopped;
+
+  *wait_ms = -1;
+  FrameMap::iterator next_frame_it =
+      FindNextFrame(clock_->TimeInMilliseconds(), wait_ms);
+  if (next_frame_it == frames_.end() || *wait_ms > 0)
+    return kTimeout;
+
+  *frame_out = ExtractFrame(next_frame_it);
+  return kFrameFound;
+}
+
+FrameBuffer::FrameMap::iterator FrameBuffer::FindNextFrame(int64_t now_ms,
+                                                           int64_t* wait_ms) {
+  FrameMap::iterator next_frame_it = frames_.end();
+  for (const auto& decodable_frame : decodable_frames_) {
+    auto frame_it = decodable_frame.second;
+    RTC_DCHECK(frame_it->second.continuous);
+    RTC_DCHECK_EQ(0U, frame_it->second.num_missing_decodable);
+
+    FrameObject* frame = frame_it->second.frame.get();
+    if (decode_base_layer_only_ && frame->temporal_layer != kNoTemporalIdx &&
+        frame->temporal_layer > 0) {
+      continue;
+    }
+
+    next_frame_it = frame_it;
+    if (frame->RenderTime() == -1) {
+      // Apply the playout delay requested for this frame with the
+      // PlayoutDelay extension before its render time is decided.
+      const PlayoutDelay& playout_delay = frame->EncodedImage().playout_delay_;
+      if (playout_delay.min_ms >= 0)
+        timing_->set_min_playout_delay(playout_delay.min_ms);
+      if (playout_delay.max_ms >= 0)
+        timing_->set_max_playout_delay(playout_delay.max_ms);
+      frame->SetRenderTime(timing_->RenderTimeMs(frame->timestamp, now_ms));
+    }
+    *wait_ms = timing_->MaxWaitingTime(frame->RenderTime(), now_ms);
+
+    // This will cause the frame buffer to prefer high framerate rather
+    // than high resolution in the case of the decoder not decoding fast
+    // enough and the stream has multiple spatial and temporal layers.
+    // In low latency playout frames are decoded as soon as they are
+    // complete, so a wait time of 0 doesn't mean that the frame is late.
+    if (*wait_ms == 0 && !timing_->LowLatencyPlayout())
+      continue;
+
+    break;
+  }
+  return next_frame_it;
+}
+
+std::unique_ptr<FrameObject> FrameBuffer::ExtractFrame(
+    FrameMap::iterator frame_it) {
+  std::unique_ptr<FrameObject> frame = std::move(frame_it->second.frame);
+  int64_t received_time = frame->ReceivedTime();
+  uint32_t timestamp = frame->timestamp;
+
+  int64_t frame_delay;
+  if (inter_frame_delay_.CalculateDelay(timestamp, &frame_delay,
+                                        received_time)) {
+    jitter_estimator_->UpdateEstimate(frame_delay, frame->size());
+  }
+  float rtt_mult = protection_mode_ == kProtectionNackFEC ? 0.0 : 1.0;
+  timing_->SetJitterDelay(jitter_estimator_->GetJitterEstimate(rtt_mult));
+  timing_->UpdateCurrentDelay(frame->RenderTime(),
+                              clock_->TimeInMilliseconds());
+
+  UpdateJitterDelay();
+
+  PropagateDecodability(frame_it->second);
+  AdvanceLastDecodedFrame(frame_it);
+  return frame;
+}
+
 void FrameBuffer::SetProtectionMode(VCMVideoProtection mode) {
   rtc::CritScope lock(&crit_);
   protection_mode_ = mode;
 }
 
+void FrameBuffer::SetDecodeBaseLayerOnly(bool base_layer_only) {
+  rtc::CritScope lock(&crit_);
+  decode_base_layer_only_ = base_layer_only;
+  // Frames that were skipped may be decodable now.
+  new_countinuous_frame_event_.Set();
+}
+
 void FrameBuffer::Start() {
   rtc::CritScope lock(&crit_);
   stopped_ = false;
@@ -243,6 +276,7 @@ void FrameBuffer::PropagateContinuity(FrameMap::iterator start) {
 
     if (last_continuous_frame_it_->first < frame->first)
       last_continuous_frame_it_ = frame;
+    AddIfDecodable(frame);
 
     // Loop through all dependent frames, and if that frame no longer has
     // any unfulfilled dependencies then that frame is continuous as well.
@@ -264,6 +298,14 @@ void FrameBuffer::PropagateDecodability(const FrameInfo& info) {
     RTC_DCHECK(ref_info != frames_.end());
     RTC_DCHECK_GT(ref_info->second.num_missing_decodable, 0U);
     --ref_info->second.num_missing_decodable;
+    AddIfDecodable(ref_info);
+  }
+}
+
+void FrameBuffer::AddIfDecodable(FrameMap::iterator frame) {
+  if (frame->second.frame && frame->second.continuous &&
+      frame->second.num_missing_decodable == 0) {
+    decodable_frames_.insert(std::make_pair(frame->first, frame));
   }
 }
 
@@ -277,6 +319,10 @@ void FrameBuffer::AdvanceLastDecodedFrame(FrameMap::iterator decoded) {
   --num_frames_buffered_;
   ++num_frames_history_;
 
+  // Frames up to |decoded| are either decoded or will be deleted below.
+  decodable_frames_.erase(decodable_frames_.begin(),
+                          decodable_frames_.upper_bound(decoded->first));
+
   // First, delete non-decoded frames from the history.
   while (last_decoded_frame_it_ != decoded) {
     if (last_decoded_frame_it_->second.frame)
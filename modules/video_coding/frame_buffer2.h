@@ -20,6 +20,7 @@
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/event.h"
 #include "webrtc/base/thread_annotations.h"
+#include "webrtc/modules/video_coding/flat_map.h"
 #include "webrtc/modules/video_coding/frame_object.h"
 #include "webrtc/modules/video_coding/include/video_coding_defines.h"
 #include "webrtc/modules/video_coding/inter_frame_delay.h"
@@ -57,12 +58,28 @@ class FrameBuffer {
   ReturnReason NextFrame(int64_t max_wait_time_ms,
                          std::unique_ptr<FrameObject>* frame_out);
 
+  // Non-blocking version of NextFrame, for callers that schedule decoding
+  // themselves.
+  //  - If a frame is due for decoding it will return kFrameFound and set
+  //    |frame_out| to the resulting frame.
+  //  - Otherwise it will return kTimeout and set |wait_ms| to the time until
+  //    the next frame is due, or to -1 if there is no decodable frame.
+  //  - If the FrameBuffer is stopped then it will return kStopped.
+  ReturnReason NextFrameIfReady(std::unique_ptr<FrameObject>* frame_out,
+                                int64_t* wait_ms);
+
   // Tells the FrameBuffer which protection mode that is in use. Affects
   // the frame timing.
   // TODO(philipel): Remove this when new timing calculations has been
   //                 implemented.
   void SetProtectionMode(VCMVideoProtection mode);
 
+  // When set, only frames of the base temporal layer are handed off for
+  // decoding, e.g. while the stream isn't rendered. Frames of higher layers
+  // are kept until a later base layer frame is decoded, so decoding can
+  // resume from them as soon as this is unset.
+  void SetDecodeBaseLayerOnly(bool base_layer_only);
+
   // Start the frame buffer, has no effect if the frame buffer is started.
   // The frame buffer is started upon construction.
   void Start();
@@ -118,12 +135,27 @@ class FrameBuffer {
 
   using FrameMap = std::map<FrameKey, FrameInfo>;
 
+  // Returns the frame to decode next and sets |wait_ms| to how long to wait
+  // before decoding it, or returns |frames_|.end() if no frame is decodable.
+  FrameMap::iterator FindNextFrame(int64_t now_ms, int64_t* wait_ms)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Hands off the frame at |frame_it| for decoding and updates the timing
+  // and the state of the buffer.
+  std::unique_ptr<FrameObject> ExtractFrame(FrameMap::iterator frame_it)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  // Adds |frame| to |decodable_frames_| if it has been inserted, is
+  // continuous and all its referenced frames have been decoded.
+  void AddIfDecodable(FrameMap::iterator frame) EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Update all directly dependent and indirectly dependent frames and mark
   // them as continuous if all their references has been fulfilled.
   void PropagateContinuity(FrameMap::iterator start)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
-  // Marks the frame as decoded and updates all directly dependent frames.
+  // Marks the frame as decoded and updates all directly dependent frames,
+  // adding the ones that became decodable to |decodable_frames_|.
   void PropagateDecodability(const FrameInfo& info)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
@@ -144,6 +176,9 @@ class FrameBuffer {
   void UpdateHistograms() const;
 
   FrameMap frames_ GUARDED_BY(crit_);
+  // The frames after |last_decoded_frame_it_| that can be decoded right away,
+  // so NextFrame only has to look at these instead of scanning |frames_|.
+  FlatMap<FrameKey, FrameMap::iterator> decodable_frames_ GUARDED_BY(crit_);
 
   rtc::CriticalSection crit_;
   Clock* const clock_;
@@ -157,6 +192,7 @@ class FrameBuffer {
   int num_frames_buffered_ GUARDED_BY(crit_);
   bool stopped_ GUARDED_BY(crit_);
   VCMVideoProtection protection_mode_ GUARDED_BY(crit_);
+  bool decode_base_layer_only_ GUARDED_BY(crit_);
 
   RTC_DISALLOW_IMPLICIT_CONSTRUCTORS(FrameBuffer);
 
@@ -51,6 +51,8 @@ class VCMTimingFake : public VCMTiming {
 
   uint32_t MaxWaitingTime(int64_t render_time_ms,
                           int64_t now_ms) const override {
+    if (LowLatencyPlayout())
+      return 0;
     return std::max<int>(0, render_time_ms - now_ms - kDecodeTime);
   }
 
@@ -126,6 +128,7 @@ class TestFrameBuffer2 : public ::testing::Test {
     frame->timestamp = ts_ms * 90;
     frame->num_references = references.size();
     frame->inter_layer_predicted = inter_layer_predicted;
+    frame->temporal_layer = temporal_layer_;
     for (size_t r = 0; r < references.size(); ++r)
       frame->references[r] = references[r];
 
@@ -190,6 +193,8 @@ class TestFrameBuffer2 : public ::testing::Test {
   FrameBuffer buffer_;
   std::vector<std::unique_ptr<FrameObject>> frames_;
   Random rand_;
+  // Temporal layer of the frames inserted with InsertFrame.
+  uint8_t temporal_layer_ = kNoTemporalIdx;
 
   int64_t max_wait_time_;
   bool tear_down_;
@@ -323,6 +328,29 @@ TEST_F(TestFrameBuffer2, DropTemporalLayerSlowDecoder) {
   CheckNoFrame(9);
 }
 
+TEST_F(TestFrameBuffer2, DoesNotDropFramesInLowLatencyPlayout) {
+  timing_.set_min_playout_delay(0);
+  timing_.set_max_playout_delay(0);
+  uint16_t pid = Rand();
+  uint32_t ts = Rand();
+
+  InsertFrame(pid, 0, ts, false);
+  InsertFrame(pid + 1, 0, ts + kFps20, false, pid);
+  for (int i = 2; i < 10; i += 2) {
+    uint32_t ts_tl0 = ts + i / 2 * kFps10;
+    InsertFrame(pid + i, 0, ts_tl0, false, pid + i - 2);
+    InsertFrame(pid + i + 1, 0, ts_tl0 + kFps20, false, pid + i, pid + i - 1);
+  }
+
+  // No wait time doesn't mean that the frames are late, so none are skipped.
+  for (int i = 0; i < 10; ++i) {
+    ExtractFrame();
+    clock_.AdvanceTimeMilliseconds(60);
+  }
+  for (int i = 0; i < 10; ++i)
+    CheckFrame(i, pid + i, 0);
+}
+
 TEST_F(TestFrameBuffer2, DropSpatialLayerSlowDecoder) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
@@ -357,6 +385,55 @@ TEST_F(TestFrameBuffer2, DropSpatialLayerSlowDecoder) {
   CheckNoFrame(11);
 }
 
+TEST_F(TestFrameBuffer2, FramesBecomeDecodableInOrder) {
+  uint16_t pid = Rand();
+  uint32_t ts = Rand();
+
+  InsertFrame(pid + 2, 0, ts + 2 * kFps10, false, pid);
+  InsertFrame(pid + 1, 0, ts + kFps10, false, pid);
+  InsertFrame(pid, 0, ts, false);
+  for (int i = 0; i < 3; ++i) {
+    ExtractFrame();
+    clock_.AdvanceTimeMilliseconds(kFps10);
+  }
+
+  CheckFrame(0, pid, 0);
+  CheckFrame(1, pid + 1, 0);
+  CheckFrame(2, pid + 2, 0);
+}
+
+TEST_F(TestFrameBuffer2, DecodeBaseLayerOnly) {
+  uint16_t pid = Rand();
+  uint32_t ts = Rand();
+
+  buffer_.SetDecodeBaseLayerOnly(true);
+  temporal_layer_ = 0;
+  InsertFrame(pid, 0, ts, false);
+  temporal_layer_ = 1;
+  InsertFrame(pid + 1, 0, ts + kFps20, false, pid);
+  temporal_layer_ = 0;
+  InsertFrame(pid + 2, 0, ts + kFps10, false, pid);
+  temporal_layer_ = 1;
+  InsertFrame(pid + 3, 0, ts + kFps10 + kFps20, false, pid + 2);
+  ExtractFrame();
+  ExtractFrame();
+  ExtractFrame();
+
+  // Decoding resumes with the upper layer frame referencing the last decoded
+  // base layer frame, without waiting for the next base layer frame.
+  buffer_.SetDecodeBaseLayerOnly(false);
+  temporal_layer_ = 0;
+  InsertFrame(pid + 4, 0, ts + 2 * kFps10, false, pid + 2);
+  ExtractFrame();
+  ExtractFrame();
+
+  CheckFrame(0, pid, 0);
+  CheckFrame(1, pid + 2, 0);
+  CheckNoFrame(2);
+  CheckFrame(3, pid + 3, 0);
+  CheckFrame(4, pid + 4, 0);
+}
+
 TEST_F(TestFrameBuffer2, InsertLateFrame) {
   uint16_t pid = Rand();
   uint32_t ts = Rand();
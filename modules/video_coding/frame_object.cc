@@ -19,6 +19,7 @@ FrameObject::FrameObject()
     : picture_id(0),
       spatial_layer(0),
       timestamp(0),
+      temporal_layer(kNoTemporalIdx),
       num_references(0),
       inter_layer_predicted(false) {}
 
@@ -47,6 +48,7 @@ RtpFrameObject::RtpFrameObject(PacketBuffer* packet_buffer,
   _payloadType = first_packet->payloadType;
   _timeStamp = first_packet->timestamp;
   ntp_time_ms_ = first_packet->ntp_time_ms_;
+  playout_delay_ = first_packet->video_header.playout_delay;
 
   // Since FFmpeg use an optimized bitstream reader that reads in chunks of
   // 32/64 bits we have to add at least that much padding to the buffer
@@ -59,7 +61,7 @@ RtpFrameObject::RtpFrameObject(PacketBuffer* packet_buffer,
   else
     _size = frame_size;
 
-  _buffer = new uint8_t[_size];
+  _buffer = packet_buffer_->AllocateBitstreamBuffer(&_size);
   _length = frame_size;
   _frameType = first_packet->frameType;
   GetBitstream(_buffer);
@@ -68,6 +70,7 @@ RtpFrameObject::RtpFrameObject(PacketBuffer* packet_buffer,
 
   // FrameObject members
   timestamp = first_packet->timestamp;
+  temporal_layer = first_packet->temporal_layer;
 
   VCMPacket* last_packet = packet_buffer_->GetPacket(last_seq_num);
   RTC_DCHECK(last_packet && last_packet->markerBit);
@@ -83,6 +86,10 @@ RtpFrameObject::RtpFrameObject(PacketBuffer* packet_buffer,
 
 RtpFrameObject::~RtpFrameObject() {
   packet_buffer_->ReturnFrame(this);
+  // Hand the bitstream buffer back for reuse instead of letting
+  // ~VCMEncodedFrame free it.
+  packet_buffer_->ReturnBitstreamBuffer(_buffer, _size);
+  _buffer = nullptr;
 }
 
 uint16_t RtpFrameObject::first_seq_num() const {
@@ -46,6 +46,9 @@ class FrameObject : public webrtc::VCMEncodedFrame {
   uint8_t spatial_layer;
   uint32_t timestamp;
 
+  // Temporal layer signaled with FrameMarking, or kNoTemporalIdx.
+  uint8_t temporal_layer;
+
   size_t num_references;
   uint16_t references[kMaxFrameReferences];
   bool inter_layer_predicted;
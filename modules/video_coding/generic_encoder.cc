@@ -56,6 +56,15 @@ int32_t VCMGenericEncoder::InitEncode(const VideoCodec* settings,
   return 0;
 }
 
+int32_t VCMGenericEncoder::ReconfigureEncode(const VideoCodec* settings) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  TRACE_EVENT0("webrtc", "VCMGenericEncoder::ReconfigureEncode");
+  if (encoder_->ReconfigureEncode(settings) != 0)
+    return -1;
+  is_screenshare_ = settings->mode == VideoCodecMode::kScreensharing;
+  return 0;
+}
+
 int32_t VCMGenericEncoder::Encode(const VideoFrame& frame,
                                   const CodecSpecificInfo* codec_specific,
                                   const std::vector<FrameType>& frame_types) {
@@ -67,6 +67,7 @@ class VCMGenericEncoder {
   int32_t InitEncode(const VideoCodec* settings,
                      int32_t number_of_cores,
                      size_t max_payload_size);
+  int32_t ReconfigureEncode(const VideoCodec* settings);
   int32_t Encode(const VideoFrame& frame,
                  const CodecSpecificInfo* codec_specific,
                  const std::vector<FrameType>& frame_types);
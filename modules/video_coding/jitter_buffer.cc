@@ -223,7 +223,7 @@ VCMJitterBuffer::VCMJitterBuffer(Clock* clock,
       running_(false),
       crit_sect_(CriticalSectionWrapper::CreateCriticalSection()),
       frame_event_(std::move(event)),
-      max_number_of_frames_(kStartNumberOfFrames),
+      max_number_of_frames_(0),
       free_frames_(),
       decodable_frames_(),
       incomplete_frames_(),
@@ -254,8 +254,9 @@ VCMJitterBuffer::VCMJitterBuffer(Clock* clock,
       decode_error_mode_(kNoErrors),
       average_packets_per_frame_(0.0f),
       frame_counter_(0) {
-  for (int i = 0; i < kStartNumberOfFrames; i++)
-    free_frames_.push_back(new VCMFrameBuffer());
+  // Frames are allocated by GetEmptyFrame() as packets arrive, so that a
+  // jitter buffer that is never fed, as with the PacketBuffer and FrameBuffer
+  // receive path, costs no frames.
 }
 
 VCMJitterBuffer::~VCMJitterBuffer() {
@@ -20,7 +20,6 @@ static const float kFastConvergeMultiplier = 0.4f;
 static const float kNormalConvergeMultiplier = 0.2f;
 
 enum { kMaxNumberOfFrames = 300 };
-enum { kStartNumberOfFrames = 6 };
 enum { kMaxVideoDelayMs = 10000 };
 enum { kPacketsPerFrameMultiplier = 5 };
 enum { kFastConvergeThreshold = 5 };
@@ -9,6 +9,7 @@
  */
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 
 #include "webrtc/modules/video_coding/nack_module.h"
@@ -28,6 +29,23 @@ const int kProcessFrequency = 50;
 const int kProcessIntervalMs = 1000 / kProcessFrequency;
 const int kMaxReorderedPackets = 128;
 const int kNumReorderingBuckets = 10;
+// Number of sequence numbers covered by the missing packets bitmap. A power of
+// two, so that it divides the sequence number space.
+const size_t kNackWindowSize = 1 << 14;
+const size_t kBitsPerWord = 64;
+static_assert(kNackWindowSize >= static_cast<size_t>(kMaxPacketAge),
+              "The nack window must cover kMaxPacketAge packets.");
+
+size_t WindowIndex(uint16_t seq_num) {
+  return seq_num % kNackWindowSize;
+}
+
+size_t CountBits(uint64_t bits) {
+  size_t count = 0;
+  for (; bits != 0; bits &= bits - 1)
+    ++count;
+  return count;
+}
 }  // namespace
 
 NackModule::NackInfo::NackInfo()
@@ -45,6 +63,9 @@ NackModule::NackModule(Clock* clock,
     : clock_(clock),
       nack_sender_(nack_sender),
       keyframe_request_sender_(keyframe_request_sender),
+      missing_(kNackWindowSize / kBitsPerWord, 0),
+      retries_(kNackWindowSize, 0),
+      num_missing_(0),
       reordering_histogram_(kNumReorderingBuckets, kMaxReorderedPackets),
       running_(true),
       initialized_(false),
@@ -84,11 +105,10 @@ int NackModule::OnReceivedPacket(const VCMPacket& packet) {
 
   if (AheadOf(newest_seq_num_, seq_num)) {
     // An out of order packet has been received.
-    auto nack_list_it = nack_list_.find(seq_num);
     int nacks_sent_for_packet = 0;
-    if (nack_list_it != nack_list_.end()) {
-      nacks_sent_for_packet = nack_list_it->second.retries;
-      nack_list_.erase(nack_list_it);
+    if (IsMissing(seq_num)) {
+      nacks_sent_for_packet = retries_[WindowIndex(seq_num)];
+      RemoveMissing(seq_num, seq_num + 1);
     }
     if (!is_retransmitted)
       UpdateReorderingStatistics(seq_num);
@@ -116,7 +136,12 @@ int NackModule::OnReceivedPacket(const VCMPacket& packet) {
 
 void NackModule::ClearUpTo(uint16_t seq_num) {
   rtc::CritScope lock(&crit_);
-  nack_list_.erase(nack_list_.begin(), nack_list_.lower_bound(seq_num));
+  uint16_t oldest_seq_num = newest_seq_num_ - kMaxPacketAge;
+  if (AheadOf(seq_num, oldest_seq_num)) {
+    RemoveMissing(oldest_seq_num, AheadOf(seq_num, newest_seq_num_)
+                                      ? newest_seq_num_
+                                      : seq_num);
+  }
   keyframe_list_.erase(keyframe_list_.begin(),
                        keyframe_list_.lower_bound(seq_num));
 }
@@ -128,7 +153,7 @@ void NackModule::UpdateRtt(int64_t rtt_ms) {
 
 void NackModule::Clear() {
   rtc::CritScope lock(&crit_);
-  nack_list_.clear();
+  ClearNackList();
   keyframe_list_.clear();
 }
 
@@ -167,14 +192,13 @@ void NackModule::Process() {
 }
 
 bool NackModule::RemovePacketsUntilKeyFrame() {
+  uint16_t oldest_seq_num = newest_seq_num_ - kMaxPacketAge;
   while (!keyframe_list_.empty()) {
-    auto it = nack_list_.lower_bound(*keyframe_list_.begin());
-
-    if (it != nack_list_.begin()) {
-      // We have found a keyframe that actually is newer than at least one
-      // packet in the nack list.
-      RTC_DCHECK(it != nack_list_.end());
-      nack_list_.erase(nack_list_.begin(), it);
+    // If the keyframe actually is newer than at least one packet in the nack
+    // list, remove the packets before it.
+    uint16_t keyframe_seq_num = *keyframe_list_.begin();
+    if (AheadOf(keyframe_seq_num, oldest_seq_num) &&
+        RemoveMissing(oldest_seq_num, keyframe_seq_num) > 0) {
       return true;
     }
 
@@ -187,21 +211,22 @@ bool NackModule::RemovePacketsUntilKeyFrame() {
 
 void NackModule::AddPacketsToNack(uint16_t seq_num_start,
                                   uint16_t seq_num_end) {
-  // Remove old packets.
-  auto it = nack_list_.lower_bound(seq_num_end - kMaxPacketAge);
-  nack_list_.erase(nack_list_.begin(), it);
+  // Remove packets that became too old since the previous newest packet.
+  uint16_t prev_newest_seq_num = seq_num_start - 1;
+  RemoveMissing(prev_newest_seq_num - kMaxPacketAge,
+                seq_num_end - kMaxPacketAge);
 
   // If the nack list is too large, remove packets from the nack list until
   // the latest first packet of a keyframe. If the list is still too large,
   // clear it and request a keyframe.
   uint16_t num_new_nacks = ForwardDiff(seq_num_start, seq_num_end);
-  if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
+  if (num_missing_ + num_new_nacks > kMaxNackPackets) {
     while (RemovePacketsUntilKeyFrame() &&
-           nack_list_.size() + num_new_nacks > kMaxNackPackets) {
+           num_missing_ + num_new_nacks > kMaxNackPackets) {
     }
 
-    if (nack_list_.size() + num_new_nacks > kMaxNackPackets) {
-      nack_list_.clear();
+    if (num_missing_ + num_new_nacks > kMaxNackPackets) {
+      ClearNackList();
       LOG(LS_WARNING) << "NACK list full, clearing NACK"
                          " list and requesting keyframe.";
       keyframe_request_sender_->RequestKeyFrame();
@@ -209,11 +234,87 @@ void NackModule::AddPacketsToNack(uint16_t seq_num_start,
     }
   }
 
+  // The wait shrinks when the reordering statistics do, so the new nacks may
+  // be due before some of the queued ones. Insert them in |send_at_seq_num|
+  // order, GetNackBatch stops at the first nack that is not due yet.
+  uint16_t wait_packets = WaitNumberOfPackets(0.5);
+  auto insert_it = nacks_to_send_.end();
+  while (insert_it != nacks_to_send_.begin() &&
+         AheadOf(std::prev(insert_it)->send_at_seq_num,
+                 static_cast<uint16_t>(seq_num_start + wait_packets))) {
+    --insert_it;
+  }
   for (uint16_t seq_num = seq_num_start; seq_num != seq_num_end; ++seq_num) {
-    NackInfo nack_info(seq_num, seq_num + WaitNumberOfPackets(0.5));
-    RTC_DCHECK(nack_list_.find(seq_num) == nack_list_.end());
-    nack_list_[seq_num] = nack_info;
+    size_t index = WindowIndex(seq_num);
+    uint64_t bit = uint64_t{1} << (index % kBitsPerWord);
+    RTC_DCHECK(!(missing_[index / kBitsPerWord] & bit));
+    missing_[index / kBitsPerWord] |= bit;
+    retries_[index] = 0;
+    insert_it = nacks_to_send_.emplace(insert_it, seq_num,
+                                       seq_num + wait_packets);
+    ++insert_it;
   }
+  num_missing_ += num_new_nacks;
+}
+
+bool NackModule::IsMissing(uint16_t seq_num) const {
+  if (!AheadOf(newest_seq_num_, seq_num) ||
+      ForwardDiff(seq_num, newest_seq_num_) > kMaxPacketAge) {
+    return false;
+  }
+  size_t index = WindowIndex(seq_num);
+  return (missing_[index / kBitsPerWord] >> (index % kBitsPerWord)) & 1;
+}
+
+bool NackModule::IsCurrent(const NackInfo& nack_info) const {
+  return IsMissing(nack_info.seq_num) &&
+         retries_[WindowIndex(nack_info.seq_num)] == nack_info.retries;
+}
+
+size_t NackModule::RemoveMissing(uint16_t seq_num_start,
+                                 uint16_t seq_num_end) {
+  size_t num_removed = 0;
+  size_t count = std::min<size_t>(ForwardDiff(seq_num_start, seq_num_end),
+                                  kNackWindowSize);
+  size_t index = WindowIndex(seq_num_start);
+  while (count > 0) {
+    size_t offset = index % kBitsPerWord;
+    size_t num_bits = std::min(count, kBitsPerWord - offset);
+    uint64_t mask = num_bits == kBitsPerWord
+                        ? ~uint64_t{0}
+                        : ((uint64_t{1} << num_bits) - 1) << offset;
+    uint64_t& word = missing_[index / kBitsPerWord];
+    num_removed += CountBits(word & mask);
+    word &= ~mask;
+    count -= num_bits;
+    index = (index + num_bits) % kNackWindowSize;
+  }
+  num_missing_ -= num_removed;
+  return num_removed;
+}
+
+void NackModule::ClearNackList() {
+  std::fill(missing_.begin(), missing_.end(), 0);
+  num_missing_ = 0;
+  nacks_to_send_.clear();
+  nacks_sent_.clear();
+}
+
+void NackModule::NackPacket(const NackInfo& nack_info,
+                            int64_t now_ms,
+                            std::vector<uint16_t>* nack_batch) {
+  nack_batch->emplace_back(nack_info.seq_num);
+  int retries = ++retries_[WindowIndex(nack_info.seq_num)];
+  if (retries >= kMaxNackRetries) {
+    LOG(LS_WARNING) << "Sequence number " << nack_info.seq_num
+                    << " removed from NACK list due to max retries.";
+    RemoveMissing(nack_info.seq_num, nack_info.seq_num + 1);
+    return;
+  }
+  NackInfo sent_nack_info(nack_info.seq_num, nack_info.send_at_seq_num);
+  sent_nack_info.sent_at_time = now_ms;
+  sent_nack_info.retries = retries;
+  nacks_sent_.push_back(sent_nack_info);
 }
 
 std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
@@ -221,38 +322,43 @@ std::vector<uint16_t> NackModule::GetNackBatch(NackFilterOptions options) {
   bool consider_timestamp = options != kSeqNumOnly;
   int64_t now_ms = clock_->TimeInMilliseconds();
   std::vector<uint16_t> nack_batch;
-  auto it = nack_list_.begin();
-  while (it != nack_list_.end()) {
-    if (consider_seq_num && it->second.sent_at_time == -1 &&
-        AheadOrAt(newest_seq_num_, it->second.send_at_seq_num)) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now_ms;
-      if (it->second.retries >= kMaxNackRetries) {
-        LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
-                        << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
-      }
-      continue;
+
+  // Stale entries are dropped when they reach the front of the queues. Only
+  // look at the resends queued before this call, so they are not resent
+  // again within the same batch.
+  if (consider_timestamp) {
+    size_t num_sent = nacks_sent_.size();
+    for (size_t i = 0; i < num_sent; ++i) {
+      NackInfo nack_info = nacks_sent_.front();
+      if (nack_info.sent_at_time + rtt_ms_ > now_ms)
+        break;
+      nacks_sent_.pop_front();
+      if (IsCurrent(nack_info))
+        NackPacket(nack_info, now_ms, &nack_batch);
     }
+  }
 
-    if (consider_timestamp && it->second.sent_at_time + rtt_ms_ <= now_ms) {
-      nack_batch.emplace_back(it->second.seq_num);
-      ++it->second.retries;
-      it->second.sent_at_time = now_ms;
-      if (it->second.retries >= kMaxNackRetries) {
-        LOG(LS_WARNING) << "Sequence number " << it->second.seq_num
-                        << " removed from NACK list due to max retries.";
-        it = nack_list_.erase(it);
-      } else {
-        ++it;
-      }
-      continue;
+  while (!nacks_to_send_.empty()) {
+    NackInfo nack_info = nacks_to_send_.front();
+    if (IsCurrent(nack_info)) {
+      // The queue is sorted by |send_at_seq_num|, so no packet after the
+      // first one that is not due yet can be due either.
+      bool send =
+          (consider_seq_num &&
+           AheadOrAt(newest_seq_num_, nack_info.send_at_seq_num)) ||
+          (consider_timestamp && nack_info.sent_at_time + rtt_ms_ <= now_ms);
+      if (!send)
+        break;
+      NackPacket(nack_info, now_ms, &nack_batch);
     }
-    ++it;
+    nacks_to_send_.pop_front();
   }
+
+  // Resends and first nacks may interleave, keep the batch in sequence number
+  // order so it packs tightly into the NACK message.
+  DescendingSeqNumComp<uint16_t> seq_num_comp;
+  if (!std::is_sorted(nack_batch.begin(), nack_batch.end(), seq_num_comp))
+    std::sort(nack_batch.begin(), nack_batch.end(), seq_num_comp);
   return nack_batch;
 }
 
@@ -11,13 +11,13 @@
 #ifndef WEBRTC_MODULES_VIDEO_CODING_NACK_MODULE_H_
 #define WEBRTC_MODULES_VIDEO_CODING_NACK_MODULE_H_
 
-#include <map>
+#include <deque>
 #include <vector>
-#include <set>
 
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/modules/include/module.h"
+#include "webrtc/modules/video_coding/flat_map.h"
 #include "webrtc/modules/video_coding/include/video_coding_defines.h"
 #include "webrtc/modules/video_coding/packet.h"
 #include "webrtc/modules/video_coding/histogram.h"
@@ -47,9 +47,9 @@ class NackModule : public Module {
   // GetNackBatch.
   enum NackFilterOptions { kSeqNumOnly, kTimeOnly, kSeqNumAndTime };
 
-  // This class holds the sequence number of the packet that is in the nack list
-  // as well as the meta data about when it should be nacked and how many times
-  // we have tried to nack this packet.
+  // This class holds the sequence number of a packet queued to be nacked as
+  // well as the meta data about when it should be nacked and how many times
+  // we had tried to nack this packet when it was queued.
   struct NackInfo {
     NackInfo();
     NackInfo(uint16_t seq_num, uint16_t send_at_seq_num);
@@ -62,6 +62,25 @@ class NackModule : public Module {
   void AddPacketsToNack(uint16_t seq_num_start, uint16_t seq_num_end)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Returns true if |seq_num| is in the nack list.
+  bool IsMissing(uint16_t seq_num) const EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Returns true if |nack_info| still describes the latest nack of a packet
+  // in the nack list. Queue entries become stale when the packet is received,
+  // cleared or nacked again.
+  bool IsCurrent(const NackInfo& nack_info) const
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Removes the packets in [seq_num_start, seq_num_end) from the nack list
+  // and returns how many were removed.
+  size_t RemoveMissing(uint16_t seq_num_start, uint16_t seq_num_end)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  void ClearNackList() EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Adds the packet of |nack_info| to |nack_batch| and, unless it has reached
+  // the max number of retries, queues it to be nacked again after an rtt.
+  void NackPacket(const NackInfo& nack_info,
+                  int64_t now_ms,
+                  std::vector<uint16_t>* nack_batch)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Removes packets from the nack list until the next keyframe. Returns true
   // if packets were removed.
   bool RemovePacketsUntilKeyFrame() EXCLUSIVE_LOCKS_REQUIRED(crit_);
@@ -82,10 +101,23 @@ class NackModule : public Module {
   NackSender* const nack_sender_;
   KeyFrameRequestSender* const keyframe_request_sender_;
 
-  std::map<uint16_t, NackInfo, DescendingSeqNumComp<uint16_t>> nack_list_
-      GUARDED_BY(crit_);
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> keyframe_list_
-      GUARDED_BY(crit_);
+  // The nack list is a bitmap of the missing packets within the last
+  // kMaxPacketAge sequence numbers, indexed by sequence number modulo the
+  // window size, so receiving or clearing packets never searches a list.
+  std::vector<uint64_t> missing_ GUARDED_BY(crit_);
+  // Number of times each missing packet has been nacked, indexed like
+  // |missing_|.
+  std::vector<uint8_t> retries_ GUARDED_BY(crit_);
+  size_t num_missing_ GUARDED_BY(crit_);
+  // Packets not nacked yet, in the order they are due, i.e. sorted by
+  // |send_at_seq_num|.
+  std::deque<NackInfo> nacks_to_send_ GUARDED_BY(crit_);
+  // Packets already nacked, in the order they were last nacked. Since a nack
+  // is resent one rtt after it was sent, this is also the order in which
+  // the resends are due, so only the front of the queue has to be checked.
+  std::deque<NackInfo> nacks_sent_ GUARDED_BY(crit_);
+  video_coding::FlatSet<uint16_t, DescendingSeqNumComp<uint16_t>>
+      keyframe_list_ GUARDED_BY(crit_);
   video_coding::Histogram reordering_histogram_ GUARDED_BY(crit_);
   bool running_ GUARDED_BY(crit_);
   bool initialized_ GUARDED_BY(crit_);
@@ -314,4 +314,75 @@ TEST_F(TestNackModule, PacketNackCount) {
   EXPECT_EQ(0, nack_module_.OnReceivedPacket(packet));
 }
 
+TEST_F(TestNackModule, ResendOnlyPacketsStillMissing) {
+  VCMPacket packet;
+  packet.seqNum = 0;
+  nack_module_.OnReceivedPacket(packet);
+  packet.seqNum = 200;
+  nack_module_.OnReceivedPacket(packet);
+  EXPECT_EQ(199u, sent_nacks_.size());
+
+  // Receive every other missing packet.
+  for (uint16_t seq_num = 1; seq_num < 200; seq_num += 2) {
+    packet.seqNum = seq_num;
+    EXPECT_EQ(1, nack_module_.OnReceivedPacket(packet));
+  }
+
+  sent_nacks_.clear();
+  clock_->AdvanceTimeMilliseconds(100);
+  nack_module_.Process();
+  ASSERT_EQ(99u, sent_nacks_.size());
+  for (size_t i = 0; i < sent_nacks_.size(); ++i)
+    EXPECT_EQ(2 * (i + 1), sent_nacks_[i]);
+}
+
+TEST_F(TestNackModule, ResendsStayInSequenceNumberOrder) {
+  VCMPacket packet;
+  packet.seqNum = 0;
+  nack_module_.OnReceivedPacket(packet);
+  packet.seqNum = 2;
+  nack_module_.OnReceivedPacket(packet);
+  clock_->AdvanceTimeMilliseconds(50);
+  packet.seqNum = 4;
+  nack_module_.OnReceivedPacket(packet);
+  EXPECT_EQ(2u, sent_nacks_.size());
+
+  // Packet 1 is resent first, then a lower rtt makes both due at once.
+  clock_->AdvanceTimeMilliseconds(50);
+  nack_module_.Process();
+  EXPECT_EQ(3u, sent_nacks_.size());
+  EXPECT_EQ(1, sent_nacks_[2]);
+
+  sent_nacks_.clear();
+  nack_module_.UpdateRtt(10);
+  clock_->AdvanceTimeMilliseconds(20);
+  nack_module_.Process();
+  ASSERT_EQ(2u, sent_nacks_.size());
+  EXPECT_EQ(1, sent_nacks_[0]);
+  EXPECT_EQ(3, sent_nacks_[1]);
+}
+
+TEST_F(TestNackModule, ForgetsPacketsOlderThanMaxAge) {
+  VCMPacket packet;
+  packet.seqNum = 0;
+  nack_module_.OnReceivedPacket(packet);
+  packet.seqNum = 2;
+  nack_module_.OnReceivedPacket(packet);
+  ASSERT_EQ(1u, sent_nacks_.size());
+
+  // Advance well past the window so the bitmap slots of the first packets
+  // are reused.
+  for (uint16_t seq_num = 3; seq_num != 20003; ++seq_num) {
+    packet.seqNum = seq_num;
+    nack_module_.OnReceivedPacket(packet);
+  }
+  packet.seqNum = 1;
+  EXPECT_EQ(0, nack_module_.OnReceivedPacket(packet));
+
+  sent_nacks_.clear();
+  clock_->AdvanceTimeMilliseconds(100);
+  nack_module_.Process();
+  EXPECT_TRUE(sent_nacks_.empty());
+}
+
 }  // namespace webrtc
@@ -32,6 +32,7 @@ VCMPacket::VCMPacket()
       insertStartCode(false),
       width(0),
       height(0),
+      temporal_layer(kNoTemporalIdx),
       video_header() {
   video_header.playout_delay = {-1, -1};
 }
@@ -54,6 +55,9 @@ VCMPacket::VCMPacket(const uint8_t* ptr,
       insertStartCode(false),
       width(rtpHeader.type.Video.width),
       height(rtpHeader.type.Video.height),
+      temporal_layer(rtpHeader.header.extension.hasFrameMarks
+                         ? rtpHeader.header.extension.frameMarks.temporalLayerId
+                         : kNoTemporalIdx),
       video_header(rtpHeader.type.Video) {
   CopyCodecSpecifics(rtpHeader.type.Video);
 
@@ -84,6 +88,7 @@ void VCMPacket::Reset() {
   insertStartCode = false;
   width = 0;
   height = 0;
+  temporal_layer = kNoTemporalIdx;
   memset(&video_header, 0, sizeof(RTPVideoHeader));
 }
 
@@ -49,6 +49,9 @@ class VCMPacket {
                          // packet.
   int width;
   int height;
+  // Temporal layer id from the FrameMarking header extension, or
+  // kNoTemporalIdx if the packet doesn't carry one.
+  uint8_t temporal_layer;
   RTPVideoHeader video_header;
 
  protected:
@@ -17,12 +17,13 @@
 #include "webrtc/base/atomicops.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/base/logratelimiter.h"
+#include "webrtc/base/refcount.h"
 #include "webrtc/modules/video_coding/frame_object.h"
 #include "webrtc/system_wrappers/include/clock.h"
 
 namespace webrtc {
 namespace video_coding {
-
 rtc::scoped_refptr<PacketBuffer> PacketBuffer::Create(
     Clock* clock,
     size_t start_buffer_size,
@@ -32,10 +33,33 @@ rtc::scoped_refptr<PacketBuffer> PacketBuffer::Create(
       clock, start_buffer_size, max_buffer_size, received_frame_callback));
 }
 
+rtc::scoped_refptr<PacketBuffer> PacketBuffer::Create(
+    Clock* clock,
+    size_t start_buffer_size,
+    size_t max_buffer_size,
+    OnReceivedFrameCallback* received_frame_callback,
+    rtc::scoped_refptr<EncodedImageBufferPool> bitstream_buffer_pool) {
+  return rtc::scoped_refptr<PacketBuffer>(
+      new PacketBuffer(clock, start_buffer_size, max_buffer_size,
+                       received_frame_callback, bitstream_buffer_pool));
+}
+
 PacketBuffer::PacketBuffer(Clock* clock,
                            size_t start_buffer_size,
                            size_t max_buffer_size,
                            OnReceivedFrameCallback* received_frame_callback)
+    : PacketBuffer(clock,
+                   start_buffer_size,
+                   max_buffer_size,
+                   received_frame_callback,
+                   new rtc::RefCountedObject<EncodedImageBufferPool>()) {}
+
+PacketBuffer::PacketBuffer(
+    Clock* clock,
+    size_t start_buffer_size,
+    size_t max_buffer_size,
+    OnReceivedFrameCallback* received_frame_callback,
+    rtc::scoped_refptr<EncodedImageBufferPool> bitstream_buffer_pool)
     : clock_(clock),
       size_(start_buffer_size),
       max_size_(max_buffer_size),
@@ -44,7 +68,9 @@ PacketBuffer::PacketBuffer(Clock* clock,
       is_cleared_to_first_seq_num_(false),
       data_buffer_(start_buffer_size),
       sequence_buffer_(start_buffer_size),
+      bitstream_buffer_pool_(bitstream_buffer_pool),
       received_frame_callback_(received_frame_callback) {
+  RTC_DCHECK(bitstream_buffer_pool_);
   RTC_DCHECK_LE(start_buffer_size, max_buffer_size);
   // Buffer size must always be a power of 2.
   RTC_DCHECK((start_buffer_size & (start_buffer_size - 1)) == 0);
@@ -147,8 +173,9 @@ void PacketBuffer::Clear() {
 
 bool PacketBuffer::ExpandBufferSize() {
   if (size_ == max_size_) {
-    LOG(LS_WARNING) << "PacketBuffer is already at max size (" << max_size_
-                    << "), failed to increase size.";
+    LOG_RATE_LIMITED(LS_WARNING, 5) << "PacketBuffer is already at max size ("
+                                    << max_size_
+                                    << "), failed to increase size.";
     return false;
   }
 
@@ -274,6 +301,14 @@ bool PacketBuffer::GetBitstream(const RtpFrameObject& frame,
   return true;
 }
 
+uint8_t* PacketBuffer::AllocateBitstreamBuffer(size_t* size) {
+  return bitstream_buffer_pool_->Allocate(size);
+}
+
+void PacketBuffer::ReturnBitstreamBuffer(uint8_t* buffer, size_t size) {
+  bitstream_buffer_pool_->Return(buffer, size);
+}
+
 VCMPacket* PacketBuffer::GetPacket(uint16_t seq_num) {
   size_t index = seq_num % size_;
   if (!sequence_buffer_[index].used ||
@@ -17,6 +17,7 @@
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/scoped_ref_ptr.h"
 #include "webrtc/base/thread_annotations.h"
+#include "webrtc/common_video/include/encoded_image_buffer_pool.h"
 #include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/modules/video_coding/packet.h"
 #include "webrtc/modules/video_coding/rtp_frame_reference_finder.h"
@@ -45,6 +46,14 @@ class PacketBuffer {
       size_t start_buffer_size,
       size_t max_buffer_size,
       OnReceivedFrameCallback* frame_callback);
+  // Same as above, with the bitstream buffers of the frames taken from
+  // |bitstream_buffer_pool| instead of a pool of its own.
+  static rtc::scoped_refptr<PacketBuffer> Create(
+      Clock* clock,
+      size_t start_buffer_size,
+      size_t max_buffer_size,
+      OnReceivedFrameCallback* frame_callback,
+      rtc::scoped_refptr<EncodedImageBufferPool> bitstream_buffer_pool);
 
   virtual ~PacketBuffer();
 
@@ -64,6 +73,11 @@ class PacketBuffer {
                size_t start_buffer_size,
                size_t max_buffer_size,
                OnReceivedFrameCallback* frame_callback);
+  PacketBuffer(Clock* clock,
+               size_t start_buffer_size,
+               size_t max_buffer_size,
+               OnReceivedFrameCallback* frame_callback,
+               rtc::scoped_refptr<EncodedImageBufferPool> bitstream_buffer_pool);
 
  private:
   friend RtpFrameObject;
@@ -117,6 +131,13 @@ class PacketBuffer {
   // Virtual for testing.
   virtual void ReturnFrame(RtpFrameObject* frame);
 
+  // Returns a buffer of at least |*size| bytes for the bitstream of a frame
+  // and sets |*size| to the capacity of the buffer.
+  uint8_t* AllocateBitstreamBuffer(size_t* size);
+
+  // Gives a buffer from AllocateBitstreamBuffer back to the pool.
+  void ReturnBitstreamBuffer(uint8_t* buffer, size_t size);
+
   rtc::CriticalSection crit_;
 
   // Buffer size_ and max_size_ must always be a power of two.
@@ -139,6 +160,10 @@ class PacketBuffer {
   // and information needed to determine the continuity between packets.
   std::vector<ContinuityInfo> sequence_buffer_ GUARDED_BY(crit_);
 
+  // Holds the bitstream buffers of destroyed frames so that large frames
+  // don't allocate and fault in new memory for every frame.
+  const rtc::scoped_refptr<EncodedImageBufferPool> bitstream_buffer_pool_;
+
   // Called when a received frame is found.
   OnReceivedFrameCallback* const received_frame_callback_;
 
@@ -12,15 +12,14 @@
 #define WEBRTC_MODULES_VIDEO_CODING_RTP_FRAME_REFERENCE_FINDER_H_
 
 #include <array>
-#include <map>
 #include <memory>
 #include <deque>
-#include <set>
 #include <utility>
 
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/modules/include/module_common_types.h"
+#include "webrtc/modules/video_coding/flat_map.h"
 #include "webrtc/modules/video_coding/sequence_number_util.h"
 
 namespace webrtc {
@@ -66,6 +65,8 @@ class RtpFrameReferenceFinder {
   static const int kMaxPaddingAge = 100;
 
 
+  enum FrameDecision { kStash, kHandOff, kDrop };
+
   struct GofInfo {
     GofInfo(GofInfoVP9* gof, uint16_t last_picture_id)
         : gof(gof), last_picture_id(last_picture_id) {}
@@ -84,30 +85,35 @@ class RtpFrameReferenceFinder {
   // all information needed.
   void RetryStashedFrames() EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
+  // Find the references of |frame|. Returns kHandOff if they were found, in
+  // which case |frame| is ready to be passed to |frame_callback_|, kStash if
+  // more frames are needed to find them, and kDrop if |frame| must be
+  // discarded.
+  FrameDecision ManageFrameInternal(RtpFrameObject* frame)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
   // Find references for generic frames. If |picture_id| is unspecified
   // then packet sequence numbers will be used to determine the references
   // of the frames.
-  void ManageFrameGeneric(std::unique_ptr<RtpFrameObject> frame,
-                          int picture_id) EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  FrameDecision ManageFrameGeneric(RtpFrameObject* frame, int picture_id)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   // Find references for Vp8 frames
-  void ManageFrameVp8(std::unique_ptr<RtpFrameObject> frame)
+  FrameDecision ManageFrameVp8(RtpFrameObject* frame)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   // Updates all necessary state used to determine frame references
-  // for Vp8 and then calls the |frame_callback| callback with the
-  // completed frame.
-  void CompletedFrameVp8(std::unique_ptr<RtpFrameObject> frame)
+  // for Vp8 and unwraps the picture ids of the completed |frame|.
+  void UpdateLayerInfoVp8(RtpFrameObject* frame,
+                          const RTPVideoHeaderVP8& codec_header)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   // Find references for Vp9 frames
-  void ManageFrameVp9(std::unique_ptr<RtpFrameObject> frame)
+  FrameDecision ManageFrameVp9(RtpFrameObject* frame)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
-  // Unwrap the picture id and the frame references  and then call the
-  // |frame_callback| callback with the completed frame.
-  void CompletedFrameVp9(std::unique_ptr<RtpFrameObject> frame)
-      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  // Unwrap the picture id and the frame references of a completed frame.
+  void UnwrapPictureIds(RtpFrameObject* frame) EXCLUSIVE_LOCKS_REQUIRED(crit_);
 
   // Check if we are missing a frame necessary to determine the references
   // for this frame.
@@ -152,9 +158,9 @@ class RtpFrameReferenceFinder {
   // the sequence number of the last packet of the last completed frame, and
   // the second being the sequence number of the last packet of the last
   // completed frame advanced by any potential continuous packets of padding.
-  std::map<uint16_t,
-           std::pair<uint16_t, uint16_t>,
-           DescendingSeqNumComp<uint16_t>>
+  FlatMap<uint16_t,
+          std::pair<uint16_t, uint16_t>,
+          DescendingSeqNumComp<uint16_t>>
       last_seq_num_gop_ GUARDED_BY(crit_);
 
   // Save the last picture id in order to detect when there is a gap in frames
@@ -163,7 +169,7 @@ class RtpFrameReferenceFinder {
 
   // Padding packets that have been received but that are not yet continuous
   // with any group of pictures.
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t>> stashed_padding_
+  FlatSet<uint16_t, DescendingSeqNumComp<uint16_t>> stashed_padding_
       GUARDED_BY(crit_);
 
   // The last unwrapped picture id. Used to unwrap the picture id from a length
@@ -172,7 +178,7 @@ class RtpFrameReferenceFinder {
 
   // Frames earlier than the last received frame that have not yet been
   // fully received.
-  std::set<uint16_t, DescendingSeqNumComp<uint16_t, kPicIdLength>>
+  FlatSet<uint16_t, DescendingSeqNumComp<uint16_t, kPicIdLength>>
       not_yet_received_frames_ GUARDED_BY(crit_);
 
   // Frames that have been fully received but didn't have all the information
@@ -181,9 +187,9 @@ class RtpFrameReferenceFinder {
 
   // Holds the information about the last completed frame for a given temporal
   // layer given a Tl0 picture index.
-  std::map<uint8_t,
-           std::array<int16_t, kMaxTemporalLayers>,
-           DescendingSeqNumComp<uint8_t>>
+  FlatMap<uint8_t,
+          std::array<int16_t, kMaxTemporalLayers>,
+          DescendingSeqNumComp<uint8_t>>
       layer_info_ GUARDED_BY(crit_);
 
   // Where the current scalability structure is in the
@@ -195,16 +201,16 @@ class RtpFrameReferenceFinder {
       GUARDED_BY(crit_);
 
   // Holds the the Gof information for a given TL0 picture index.
-  std::map<uint8_t, GofInfo, DescendingSeqNumComp<uint8_t>> gof_info_
+  FlatMap<uint8_t, GofInfo, DescendingSeqNumComp<uint8_t>> gof_info_
       GUARDED_BY(crit_);
 
   // Keep track of which picture id and which temporal layer that had the
   // up switch flag set.
-  std::map<uint16_t, uint8_t, DescendingSeqNumComp<uint16_t, kPicIdLength>>
+  FlatMap<uint16_t, uint8_t, DescendingSeqNumComp<uint16_t, kPicIdLength>>
       up_switch_ GUARDED_BY(crit_);
 
   // For every temporal layer, keep a set of which frames that are missing.
-  std::array<std::set<uint16_t, DescendingSeqNumComp<uint16_t, kPicIdLength>>,
+  std::array<FlatSet<uint16_t, DescendingSeqNumComp<uint16_t, kPicIdLength>>,
              kMaxTemporalLayers>
       missing_frames_for_layer_ GUARDED_BY(crit_);
 
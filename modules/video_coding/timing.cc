@@ -117,6 +117,15 @@ int VCMTiming::max_playout_delay() {
   return max_playout_delay_ms_;
 }
 
+bool VCMTiming::LowLatencyPlayout() const {
+  CriticalSectionScoped cs(crit_sect_);
+  return LowLatencyPlayoutInternal();
+}
+
+bool VCMTiming::LowLatencyPlayoutInternal() const {
+  return min_playout_delay_ms_ == 0 && max_playout_delay_ms_ == 0;
+}
+
 void VCMTiming::SetJitterDelay(int jitter_delay_ms) {
   CriticalSectionScoped cs(crit_sect_);
   if (jitter_delay_ms != jitter_delay_ms_) {
@@ -172,6 +181,9 @@ void VCMTiming::UpdateCurrentDelay(uint32_t frame_timestamp) {
 void VCMTiming::UpdateCurrentDelay(int64_t render_time_ms,
                                    int64_t actual_decode_time_ms) {
   CriticalSectionScoped cs(crit_sect_);
+  // Frames are rendered as they are decoded, so they can't be late.
+  if (LowLatencyPlayoutInternal())
+    return;
   uint32_t target_delay_ms = TargetDelayInternal();
   int64_t delayed_ms =
       actual_decode_time_ms -
@@ -201,7 +213,7 @@ int32_t VCMTiming::StopDecodeTimer(uint32_t time_stamp,
     first_decoded_frame_ms_ = now_ms;
   }
   int time_until_rendering_ms = render_time_ms - render_delay_ms_ - now_ms;
-  if (time_until_rendering_ms < 0) {
+  if (time_until_rendering_ms < 0 && !LowLatencyPlayoutInternal()) {
     sum_missed_render_deadline_ms_ += -time_until_rendering_ms;
     ++num_delayed_decoded_frames_;
   }
@@ -228,7 +240,7 @@ int64_t VCMTiming::RenderTimeMsInternal(uint32_t frame_timestamp,
     estimated_complete_time_ms = now_ms;
   }
 
-  if (min_playout_delay_ms_ == 0 && max_playout_delay_ms_ == 0) {
+  if (LowLatencyPlayoutInternal()) {
     // Render as soon as possible
     return now_ms;
   }
@@ -250,6 +262,8 @@ int VCMTiming::RequiredDecodeTimeMs() const {
 uint32_t VCMTiming::MaxWaitingTime(int64_t render_time_ms,
                                    int64_t now_ms) const {
   CriticalSectionScoped cs(crit_sect_);
+  if (LowLatencyPlayoutInternal())
+    return 0;
 
   const int64_t max_wait_time_ms =
       render_time_ms - now_ms - RequiredDecodeTimeMs() - render_delay_ms_;
@@ -284,6 +298,8 @@ int VCMTiming::TargetVideoDelay() const {
 }
 
 int VCMTiming::TargetDelayInternal() const {
+  if (LowLatencyPlayoutInternal())
+    return 0;
   return std::max(min_playout_delay_ms_,
                   jitter_delay_ms_ + RequiredDecodeTimeMs() + render_delay_ms_);
 }
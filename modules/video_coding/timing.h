@@ -53,6 +53,12 @@ class VCMTiming {
   // Returns the maximum playout delay from capture to render in ms.
   int max_playout_delay();
 
+  // Returns true if both the minimum and maximum playout delay are 0, as
+  // requested with the PlayoutDelay extension for low latency streams. Frames
+  // are then decoded as soon as they are complete and rendered right away,
+  // without margins for jitter, decode time or render delay.
+  bool LowLatencyPlayout() const;
+
   // Increases or decreases the current delay to get closer to the target delay.
   // Calculates how long it has been since the previous call to this function,
   // and increases/decreases the delay in proportion to the time difference.
@@ -110,6 +116,7 @@ class VCMTiming {
   int64_t RenderTimeMsInternal(uint32_t frame_timestamp, int64_t now_ms) const
       EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
   int TargetDelayInternal() const EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
+  bool LowLatencyPlayoutInternal() const EXCLUSIVE_LOCKS_REQUIRED(crit_sect_);
 
  private:
   void UpdateHistograms() const;
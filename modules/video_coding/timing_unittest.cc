@@ -145,4 +145,30 @@ TEST(ReceiverTiming, WrapAround) {
   }
 }
 
+TEST(ReceiverTiming, LowLatencyPlayout) {
+  SimulatedClock clock(0);
+  VCMTiming timing(&clock);
+  uint32_t timestamp = 0;
+  timing.SetJitterDelay(100);
+  timing.UpdateCurrentDelay(timestamp);
+  EXPECT_FALSE(timing.LowLatencyPlayout());
+  EXPECT_GT(timing.TargetVideoDelay(), 0);
+
+  timing.set_min_playout_delay(0);
+  timing.set_max_playout_delay(0);
+  EXPECT_TRUE(timing.LowLatencyPlayout());
+  for (int i = 0; i < 10; ++i) {
+    timing.IncomingTimestamp(timestamp, clock.TimeInMilliseconds());
+    int64_t render_time_ms =
+        timing.RenderTimeMs(timestamp, clock.TimeInMilliseconds());
+    // Decoded and rendered right away, without a render delay margin.
+    EXPECT_EQ(clock.TimeInMilliseconds(), render_time_ms);
+    EXPECT_EQ(0u, timing.MaxWaitingTime(render_time_ms,
+                                        clock.TimeInMilliseconds()));
+    clock.AdvanceTimeMilliseconds(33);
+    timestamp += 90000 / 30;
+  }
+  EXPECT_EQ(0, timing.TargetVideoDelay());
+}
+
 }  // namespace webrtc
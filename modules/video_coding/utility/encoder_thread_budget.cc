@@ -0,0 +1,91 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/video_coding/utility/encoder_thread_budget.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/system_wrappers/include/cpu_info.h"
+
+namespace webrtc {
+
+// static
+EncoderThreadBudget* EncoderThreadBudget::GetInstance() {
+  static EncoderThreadBudget* const budget =
+      new EncoderThreadBudget(CpuInfo::DetectNumberOfCores());
+  return budget;
+}
+
+EncoderThreadBudget::EncoderThreadBudget(int total_threads)
+    : total_threads_(std::max(total_threads, 1)) {}
+
+EncoderThreadBudget::~EncoderThreadBudget() {
+  RTC_DCHECK(encoders_.empty());
+}
+
+void EncoderThreadBudget::SetTotalThreads(int total_threads) {
+  rtc::CritScope lock(&crit_);
+  total_threads_ = std::max(total_threads, 1);
+  UpdateGrants();
+}
+
+int EncoderThreadBudget::Register(int wanted_threads) {
+  rtc::CritScope lock(&crit_);
+  int id = next_id_++;
+  encoders_[id] = {std::max(wanted_threads, 1), 1};
+  UpdateGrants();
+  return id;
+}
+
+void EncoderThreadBudget::Unregister(int id) {
+  rtc::CritScope lock(&crit_);
+  RTC_DCHECK(encoders_.find(id) != encoders_.end());
+  encoders_.erase(id);
+  UpdateGrants();
+}
+
+int EncoderThreadBudget::GetGrantedThreads(int id) const {
+  rtc::CritScope lock(&crit_);
+  auto it = encoders_.find(id);
+  RTC_DCHECK(it != encoders_.end());
+  return it != encoders_.end() ? it->second.granted_threads : 1;
+}
+
+void EncoderThreadBudget::UpdateGrants() {
+  // Order by demand, largest first. Ties go to the encoder registered first.
+  std::vector<Encoder*> by_demand;
+  for (auto& kv : encoders_) {
+    kv.second.granted_threads = 1;
+    by_demand.push_back(&kv.second);
+  }
+  std::stable_sort(by_demand.begin(), by_demand.end(),
+                   [](const Encoder* a, const Encoder* b) {
+                     return a->wanted_threads > b->wanted_threads;
+                   });
+
+  int spare_threads = total_threads_ - static_cast<int>(encoders_.size());
+  bool granted = true;
+  while (spare_threads > 0 && granted) {
+    granted = false;
+    for (Encoder* encoder : by_demand) {
+      if (spare_threads == 0)
+        break;
+      if (encoder->granted_threads < encoder->wanted_threads) {
+        ++encoder->granted_threads;
+        --spare_threads;
+        granted = true;
+      }
+    }
+  }
+}
+
+}  // namespace webrtc
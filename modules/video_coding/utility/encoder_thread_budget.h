@@ -0,0 +1,67 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_VIDEO_CODING_UTILITY_ENCODER_THREAD_BUDGET_H_
+#define WEBRTC_MODULES_VIDEO_CODING_UTILITY_ENCODER_THREAD_BUDGET_H_
+
+#include <map>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/thread_annotations.h"
+
+namespace webrtc {
+
+// Shares a number of encoder threads between all encoders that register with
+// it, so that many concurrent encoders don't each size their thread pool as if
+// they had the machine to themselves. Every encoder is granted at least one
+// thread and at most as many as it asked for. Threads beyond the first are
+// handed out one at a time in round-robin, to the encoders asking for the most
+// threads (the highest resolution streams) first. Grants change as encoders
+// register and unregister; encoders pick them up when reconfigured.
+class EncoderThreadBudget {
+ public:
+  // The budget shared by all encoders in the process. It starts out with one
+  // thread per core.
+  static EncoderThreadBudget* GetInstance();
+
+  explicit EncoderThreadBudget(int total_threads);
+  ~EncoderThreadBudget();
+
+  // Changes the number of threads to share, e.g. to leave cores to other work.
+  void SetTotalThreads(int total_threads);
+
+  // Registers an encoder that would use |wanted_threads| threads on its own.
+  // Returns an id to pass to the other methods.
+  int Register(int wanted_threads);
+  void Unregister(int id);
+
+  // Returns the number of threads currently granted to encoder |id|.
+  int GetGrantedThreads(int id) const;
+
+ private:
+  void UpdateGrants() EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  struct Encoder {
+    int wanted_threads;
+    int granted_threads;
+  };
+
+  rtc::CriticalSection crit_;
+  int total_threads_ GUARDED_BY(crit_);
+  int next_id_ GUARDED_BY(crit_) = 0;
+  std::map<int, Encoder> encoders_ GUARDED_BY(crit_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(EncoderThreadBudget);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_VIDEO_CODING_UTILITY_ENCODER_THREAD_BUDGET_H_
@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/video_coding/utility/encoder_thread_budget.h"
+
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+TEST(EncoderThreadBudgetTest, GrantsWhatIsWantedWhenAvailable) {
+  EncoderThreadBudget budget(8);
+  int id1 = budget.Register(3);
+  int id2 = budget.Register(2);
+  EXPECT_EQ(3, budget.GetGrantedThreads(id1));
+  EXPECT_EQ(2, budget.GetGrantedThreads(id2));
+  budget.Unregister(id1);
+  budget.Unregister(id2);
+}
+
+TEST(EncoderThreadBudgetTest, GrantsAtLeastOneThread) {
+  EncoderThreadBudget budget(2);
+  int id1 = budget.Register(4);
+  int id2 = budget.Register(4);
+  int id3 = budget.Register(4);
+  EXPECT_EQ(1, budget.GetGrantedThreads(id1));
+  EXPECT_EQ(1, budget.GetGrantedThreads(id2));
+  EXPECT_EQ(1, budget.GetGrantedThreads(id3));
+  budget.Unregister(id1);
+  budget.Unregister(id2);
+  budget.Unregister(id3);
+}
+
+TEST(EncoderThreadBudgetTest, SharesSpareThreadsLargestDemandFirst) {
+  EncoderThreadBudget budget(6);
+  int small = budget.Register(2);
+  int large = budget.Register(8);
+  int medium = budget.Register(3);
+  // Each gets one, then the three spare threads go round-robin by demand.
+  EXPECT_EQ(2, budget.GetGrantedThreads(large));
+  EXPECT_EQ(2, budget.GetGrantedThreads(medium));
+  EXPECT_EQ(2, budget.GetGrantedThreads(small));
+  budget.Unregister(small);
+  budget.Unregister(large);
+  budget.Unregister(medium);
+}
+
+TEST(EncoderThreadBudgetTest, RebalancesWhenEncodersComeAndGo) {
+  EncoderThreadBudget budget(4);
+  int id1 = budget.Register(4);
+  EXPECT_EQ(4, budget.GetGrantedThreads(id1));
+
+  int id2 = budget.Register(4);
+  EXPECT_EQ(2, budget.GetGrantedThreads(id1));
+  EXPECT_EQ(2, budget.GetGrantedThreads(id2));
+
+  budget.Unregister(id2);
+  EXPECT_EQ(4, budget.GetGrantedThreads(id1));
+
+  budget.SetTotalThreads(2);
+  EXPECT_EQ(2, budget.GetGrantedThreads(id1));
+  budget.Unregister(id1);
+}
+
+}  // namespace webrtc
@@ -0,0 +1,168 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/video_coding/utility/ivf_file_reader.h"
+
+#include <string.h>
+
+#include <utility>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/logging.h"
+#include "webrtc/common_video/h264/h264_common.h"
+#include "webrtc/modules/rtp_rtcp/source/byte_io.h"
+
+namespace webrtc {
+namespace {
+const size_t kIvfHeaderSize = 32;
+const size_t kIvfFrameHeaderSize = 12;
+const uint32_t kRtpTimestampRate = 90000;
+const size_t kReadChunkSize = 64 * 1024;
+
+VideoCodecType CodecTypeFromFourcc(const uint8_t* fourcc) {
+  if (memcmp(fourcc, "VP80", 4) == 0)
+    return kVideoCodecVP8;
+  if (memcmp(fourcc, "VP90", 4) == 0)
+    return kVideoCodecVP9;
+  if (memcmp(fourcc, "H264", 4) == 0)
+    return kVideoCodecH264;
+  return kVideoCodecUnknown;
+}
+}  // namespace
+
+IvfFileReader::IvfFileReader(VideoCodecType codec_type,
+                             uint16_t width,
+                             uint16_t height)
+    : codec_type_(codec_type), width_(width), height_(height) {}
+
+IvfFileReader::~IvfFileReader() = default;
+
+std::unique_ptr<IvfFileReader> IvfFileReader::Create(rtc::File file) {
+  if (!file.IsOpen())
+    return nullptr;
+  std::vector<uint8_t> file_data;
+  size_t read = 0;
+  do {
+    file_data.resize(file_data.size() + kReadChunkSize);
+    read = file.Read(file_data.data() + file_data.size() - kReadChunkSize,
+                     kReadChunkSize);
+    file_data.resize(file_data.size() - kReadChunkSize + read);
+  } while (read > 0);
+  file.Close();
+
+  const uint8_t* header = file_data.data();
+  if (file_data.size() < kIvfHeaderSize || memcmp(header, "DKIF", 4) != 0) {
+    LOG(LS_ERROR) << "Not an IVF file.";
+    return nullptr;
+  }
+  VideoCodecType codec_type = CodecTypeFromFourcc(&header[8]);
+  if (codec_type == kVideoCodecUnknown) {
+    LOG(LS_ERROR) << "Unsupported codec in IVF file.";
+    return nullptr;
+  }
+  uint32_t time_base_rate = ByteReader<uint32_t>::ReadLittleEndian(&header[16]);
+  uint32_t time_base_scale =
+      ByteReader<uint32_t>::ReadLittleEndian(&header[20]);
+  if (time_base_rate == 0 || time_base_scale == 0) {
+    LOG(LS_ERROR) << "Invalid time base in IVF file.";
+    return nullptr;
+  }
+
+  std::unique_ptr<IvfFileReader> reader(new IvfFileReader(
+      codec_type, ByteReader<uint16_t>::ReadLittleEndian(&header[12]),
+      ByteReader<uint16_t>::ReadLittleEndian(&header[14])));
+  if (!reader->ParseFrames(file_data, time_base_rate, time_base_scale))
+    return nullptr;
+  return reader;
+}
+
+bool IvfFileReader::ParseFrames(const std::vector<uint8_t>& file_data,
+                                uint32_t time_base_rate,
+                                uint32_t time_base_scale) {
+  const size_t padding = EncodedImage::GetBufferPaddingBytes(codec_type_);
+  buffer_.reserve(file_data.size());
+  size_t offset = ByteReader<uint16_t>::ReadLittleEndian(&file_data[6]);
+  while (offset < file_data.size()) {
+    if (file_data.size() - offset < kIvfFrameHeaderSize) {
+      LOG(LS_ERROR) << "Truncated frame header in IVF file.";
+      return false;
+    }
+    const uint8_t* frame_header = &file_data[offset];
+    size_t length = ByteReader<uint32_t>::ReadLittleEndian(&frame_header[0]);
+    uint64_t timestamp =
+        ByteReader<uint64_t>::ReadLittleEndian(&frame_header[4]);
+    offset += kIvfFrameHeaderSize;
+    if (file_data.size() - offset < length) {
+      LOG(LS_ERROR) << "Truncated frame in IVF file.";
+      return false;
+    }
+    Frame frame;
+    frame.offset = buffer_.size();
+    frame.length = length;
+    frame.timestamp = static_cast<uint32_t>(
+        timestamp * kRtpTimestampRate * time_base_scale / time_base_rate);
+    frames_.push_back(frame);
+    buffer_.insert(buffer_.end(), file_data.begin() + offset,
+                   file_data.begin() + offset + length);
+    buffer_.resize(buffer_.size() + padding, 0);
+    offset += length;
+  }
+  return true;
+}
+
+EncodedImage IvfFileReader::GetFrame(size_t index) const {
+  RTC_DCHECK_LT(index, frames_.size());
+  const Frame& frame = frames_[index];
+  // The decoders and packetizers only read the buffer.
+  uint8_t* data = const_cast<uint8_t*>(&buffer_[frame.offset]);
+  EncodedImage image(
+      data, frame.length,
+      frame.length + EncodedImage::GetBufferPaddingBytes(codec_type_));
+  image._encodedWidth = width_;
+  image._encodedHeight = height_;
+  image._timeStamp = frame.timestamp;
+  image._frameType = ParseFrameType(data, frame.length);
+  image._completeFrame = true;
+  return image;
+}
+
+FrameType IvfFileReader::ParseFrameType(const uint8_t* data,
+                                        size_t length) const {
+  if (length == 0)
+    return kEmptyFrame;
+  switch (codec_type_) {
+    case kVideoCodecVP8:
+      // The inverse key frame flag is the first bit of the frame tag.
+      return (data[0] & 0x01) == 0 ? kVideoFrameKey : kVideoFrameDelta;
+    case kVideoCodecVP9: {
+      // frame_marker(2), profile_low_bit(1), profile_high_bit(1), then a
+      // reserved bit for profile 3, show_existing_frame(1) and frame_type(1).
+      int profile = ((data[0] >> 5) & 0x01) | ((data[0] >> 3) & 0x02);
+      int shift = profile == 3 ? 2 : 3;
+      bool show_existing_frame = (data[0] >> shift) & 0x01;
+      bool non_key_frame = (data[0] >> (shift - 1)) & 0x01;
+      return !show_existing_frame && !non_key_frame ? kVideoFrameKey
+                                                    : kVideoFrameDelta;
+    }
+    case kVideoCodecH264:
+      for (const H264::NaluIndex& index : H264::FindNaluIndices(data, length)) {
+        if (H264::ParseNaluType(data[index.payload_start_offset]) ==
+            H264::NaluType::kIdr) {
+          return kVideoFrameKey;
+        }
+      }
+      return kVideoFrameDelta;
+    default:
+      RTC_NOTREACHED();
+      return kVideoFrameDelta;
+  }
+}
+
+}  // namespace webrtc
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_MODULES_VIDEO_CODING_UTILITY_IVF_FILE_READER_H_
+#define WEBRTC_MODULES_VIDEO_CODING_UTILITY_IVF_FILE_READER_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/file.h"
+#include "webrtc/common_types.h"
+#include "webrtc/video_frame.h"
+
+namespace webrtc {
+
+// Reads the files written by IvfFileWriter. The whole file is loaded in
+// memory up front, so that replaying the frames into a decoder or packetizer
+// doesn't measure the disk.
+class IvfFileReader {
+ public:
+  // Returns null if |file| isn't a valid IVF file of a supported codec.
+  static std::unique_ptr<IvfFileReader> Create(rtc::File file);
+  ~IvfFileReader();
+
+  VideoCodecType codec_type() const { return codec_type_; }
+  size_t num_frames() const { return frames_.size(); }
+
+  // Returns the frame at |index|, pointing into the buffer of the reader.
+  // Its timestamp is converted to the 90 kHz RTP clock, and its frame type
+  // is parsed from the bitstream since IVF doesn't store it.
+  EncodedImage GetFrame(size_t index) const;
+
+ private:
+  struct Frame {
+    size_t offset;
+    size_t length;
+    uint32_t timestamp;
+  };
+
+  IvfFileReader(VideoCodecType codec_type, uint16_t width, uint16_t height);
+
+  // Copies the frames of |file_data| to |buffer_|, each followed by the
+  // padding the decoders of |codec_type_| need.
+  bool ParseFrames(const std::vector<uint8_t>& file_data,
+                   uint32_t time_base_rate,
+                   uint32_t time_base_scale);
+  FrameType ParseFrameType(const uint8_t* data, size_t length) const;
+
+  const VideoCodecType codec_type_;
+  const uint16_t width_;
+  const uint16_t height_;
+  std::vector<uint8_t> buffer_;
+  std::vector<Frame> frames_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(IvfFileReader);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_MODULES_VIDEO_CODING_UTILITY_IVF_FILE_READER_H_
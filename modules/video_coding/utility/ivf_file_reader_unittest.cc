@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/modules/video_coding/utility/ivf_file_reader.h"
+
+#include <memory>
+#include <string>
+
+#include "webrtc/base/fileutils.h"
+#include "webrtc/modules/video_coding/utility/ivf_file_writer.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/fileutils.h"
+
+namespace webrtc {
+
+namespace {
+const int kWidth = 320;
+const int kHeight = 240;
+const size_t kNumFrames = 10;
+// A VP8 key frame tag followed by a delta frame tag.
+uint8_t vp8_key_frame[] = {0x10, 0x02, 0x00, 0x9d, 0x01, 0x2a};
+uint8_t vp8_delta_frame[] = {0x31, 0x02, 0x00};
+// An SPS and an IDR slice, then a non-IDR slice.
+uint8_t h264_key_frame[] = {0, 0, 0, 1, 0x67, 0x42, 0, 0, 0, 1, 0x65, 0x88};
+uint8_t h264_delta_frame[] = {0, 0, 0, 1, 0x41, 0x9a};
+}  // namespace
+
+class IvfFileReaderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    file_name_ =
+        webrtc::test::TempFilename(webrtc::test::OutputPath(), "test_file");
+  }
+  void TearDown() override { rtc::RemoveFile(file_name_); }
+
+  // Writes a key frame followed by delta frames, 30 fps apart.
+  void WriteFrames(VideoCodecType codec_type,
+                   bool use_capture_time_ms,
+                   uint8_t* key_frame,
+                   size_t key_frame_length,
+                   uint8_t* delta_frame,
+                   size_t delta_frame_length) {
+    std::unique_ptr<IvfFileWriter> writer =
+        IvfFileWriter::Wrap(rtc::File::Open(file_name_), 0);
+    for (size_t i = 0; i < kNumFrames; ++i) {
+      EncodedImage frame(i == 0 ? key_frame : delta_frame,
+                         i == 0 ? key_frame_length : delta_frame_length, 0);
+      frame._encodedWidth = kWidth;
+      frame._encodedHeight = kHeight;
+      if (use_capture_time_ms) {
+        frame.capture_time_ms_ = 1 + i * 33;
+      } else {
+        frame._timeStamp = 3000 * (i + 1);
+      }
+      ASSERT_TRUE(writer->WriteFrame(frame, codec_type));
+    }
+    ASSERT_TRUE(writer->Close());
+  }
+
+  std::string file_name_;
+};
+
+TEST_F(IvfFileReaderTest, ReadsFramesWrittenWithRtpTimestamps) {
+  WriteFrames(kVideoCodecVP8, false, vp8_key_frame, sizeof(vp8_key_frame),
+              vp8_delta_frame, sizeof(vp8_delta_frame));
+  std::unique_ptr<IvfFileReader> reader =
+      IvfFileReader::Create(rtc::File::Open(file_name_));
+  ASSERT_TRUE(reader);
+  EXPECT_EQ(kVideoCodecVP8, reader->codec_type());
+  ASSERT_EQ(kNumFrames, reader->num_frames());
+
+  EncodedImage key_frame = reader->GetFrame(0);
+  EXPECT_EQ(kVideoFrameKey, key_frame._frameType);
+  EXPECT_EQ(3000u, key_frame._timeStamp);
+  EXPECT_EQ(static_cast<uint32_t>(kWidth), key_frame._encodedWidth);
+  EXPECT_EQ(static_cast<uint32_t>(kHeight), key_frame._encodedHeight);
+  ASSERT_EQ(sizeof(vp8_key_frame), key_frame._length);
+  EXPECT_EQ(0, memcmp(vp8_key_frame, key_frame._buffer, key_frame._length));
+
+  for (size_t i = 1; i < kNumFrames; ++i) {
+    EncodedImage frame = reader->GetFrame(i);
+    EXPECT_EQ(kVideoFrameDelta, frame._frameType);
+    EXPECT_EQ(3000 * (i + 1), frame._timeStamp);
+    ASSERT_EQ(sizeof(vp8_delta_frame), frame._length);
+    EXPECT_EQ(0, memcmp(vp8_delta_frame, frame._buffer, frame._length));
+  }
+}
+
+TEST_F(IvfFileReaderTest, ConvertsMsTimestampsToRtpClock) {
+  WriteFrames(kVideoCodecVP8, true, vp8_key_frame, sizeof(vp8_key_frame),
+              vp8_delta_frame, sizeof(vp8_delta_frame));
+  std::unique_ptr<IvfFileReader> reader =
+      IvfFileReader::Create(rtc::File::Open(file_name_));
+  ASSERT_TRUE(reader);
+  EXPECT_EQ(90u, reader->GetFrame(0)._timeStamp);
+  EXPECT_EQ(34 * 90u, reader->GetFrame(1)._timeStamp);
+}
+
+TEST_F(IvfFileReaderTest, ParsesH264FrameTypesAndPadsFrames) {
+  WriteFrames(kVideoCodecH264, false, h264_key_frame, sizeof(h264_key_frame),
+              h264_delta_frame, sizeof(h264_delta_frame));
+  std::unique_ptr<IvfFileReader> reader =
+      IvfFileReader::Create(rtc::File::Open(file_name_));
+  ASSERT_TRUE(reader);
+  EXPECT_EQ(kVideoCodecH264, reader->codec_type());
+  EncodedImage key_frame = reader->GetFrame(0);
+  EXPECT_EQ(kVideoFrameKey, key_frame._frameType);
+  EXPECT_EQ(key_frame._length + EncodedImage::kBufferPaddingBytesH264,
+            key_frame._size);
+  EXPECT_EQ(kVideoFrameDelta, reader->GetFrame(1)._frameType);
+}
+
+TEST_F(IvfFileReaderTest, RejectsInvalidFiles) {
+  EXPECT_FALSE(IvfFileReader::Create(rtc::File()));
+  rtc::File file = rtc::File::Create(file_name_);
+  const uint8_t kNotIvf[] = "RIFF and some more bytes to fill a header";
+  file.Write(kNotIvf, sizeof(kNotIvf));
+  file.Close();
+  EXPECT_FALSE(IvfFileReader::Create(rtc::File::Open(file_name_)));
+}
+
+}  // namespace webrtc
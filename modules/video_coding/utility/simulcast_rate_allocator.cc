@@ -46,19 +46,33 @@ BitrateAllocation SimulcastRateAllocator::GetAllocation(
     allocated_bitrates_bps.SetBitrate(
         0, 0, std::max(codec_.minBitrate * 1000, left_to_allocate));
   } else {
+    // Paused streams get no bitrate at all, and are skipped over by the
+    // allocation of the others.
+    size_t first_layer = 0;
+    while (first_layer < codec_.numberOfSimulcastStreams &&
+           paused_streams_[first_layer]) {
+      ++first_layer;
+    }
+
     // Always allocate enough bitrate for the minimum bitrate of the first
     // layer. Suspending below min bitrate is controlled outside the codec
     // implementation and is not overridden by this.
-    left_to_allocate =
-        std::max(codec_.simulcastStream[0].minBitrate * 1000, left_to_allocate);
+    if (first_layer < codec_.numberOfSimulcastStreams) {
+      left_to_allocate =
+          std::max(codec_.simulcastStream[first_layer].minBitrate * 1000,
+                   left_to_allocate);
+    }
 
     // Begin by allocating bitrate to simulcast streams, putting all bitrate in
     // temporal layer 0. We'll then distribute this bitrate, across potential
     // temporal layers, when stream allocation is done.
 
     // Allocate up to the target bitrate for each simulcast layer.
-    size_t layer = 0;
-    for (; layer < codec_.numberOfSimulcastStreams; ++layer) {
+    size_t active_layer = first_layer;
+    for (size_t layer = first_layer; layer < codec_.numberOfSimulcastStreams;
+         ++layer) {
+      if (paused_streams_[layer])
+        continue;
       const SimulcastStream& stream = codec_.simulcastStream[layer];
       if (left_to_allocate < stream.minBitrate * 1000)
         break;
@@ -67,13 +81,14 @@ BitrateAllocation SimulcastRateAllocator::GetAllocation(
       allocated_bitrates_bps.SetBitrate(layer, 0, allocation);
       RTC_DCHECK_LE(allocation, left_to_allocate);
       left_to_allocate -= allocation;
+      active_layer = layer;
     }
 
     // Next, try allocate remaining bitrate, up to max bitrate, in top stream.
     // TODO(sprang): Allocate up to max bitrate for all layers once we have a
     //               better idea of possible performance implications.
-    if (left_to_allocate > 0) {
-      size_t active_layer = layer - 1;
+    if (left_to_allocate > 0 &&
+        first_layer < codec_.numberOfSimulcastStreams) {
       const SimulcastStream& stream = codec_.simulcastStream[active_layer];
       uint32_t bitrate_bps =
           allocated_bitrates_bps.GetSpatialLayerSum(active_layer);
@@ -150,11 +165,18 @@ uint32_t SimulcastRateAllocator::GetPreferredBitrateBps(uint32_t framerate) {
   // Create a temporary instance without temporal layers, as they may be
   // stateful, and updating the bitrate to max here can cause side effects.
   SimulcastRateAllocator temp_allocator(codec_, nullptr);
+  temp_allocator.paused_streams_ = paused_streams_;
   BitrateAllocation allocation =
       temp_allocator.GetAllocation(codec_.maxBitrate * 1000, framerate);
   return allocation.get_sum_bps();
 }
 
+void SimulcastRateAllocator::SetStreamPaused(size_t simulcast_id,
+                                             bool paused) {
+  RTC_DCHECK_LT(simulcast_id, paused_streams_.size());
+  paused_streams_[simulcast_id] = paused;
+}
+
 const VideoCodec& webrtc::SimulcastRateAllocator::GetCodec() const {
   return codec_;
 }
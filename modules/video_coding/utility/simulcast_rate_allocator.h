@@ -13,6 +13,7 @@
 
 #include <stdint.h>
 
+#include <bitset>
 #include <map>
 #include <memory>
 
@@ -36,10 +37,12 @@ class SimulcastRateAllocator : public VideoBitrateAllocator,
   BitrateAllocation GetAllocation(uint32_t total_bitrate_bps,
                                   uint32_t framerate) override;
   uint32_t GetPreferredBitrateBps(uint32_t framerate) override;
+  void SetStreamPaused(size_t simulcast_id, bool paused) override;
   const VideoCodec& GetCodec() const;
 
  private:
   const VideoCodec codec_;
+  std::bitset<kMaxSimulcastStreams> paused_streams_;
   std::map<uint32_t, TemporalLayers*> temporal_layers_;
   std::unique_ptr<TemporalLayersFactory> tl_factory_;
 
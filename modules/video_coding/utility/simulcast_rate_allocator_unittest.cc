@@ -264,6 +264,59 @@ TEST_F(SimulcastRateAllocatorTest, OneToThreeStreams) {
   }
 }
 
+TEST_F(SimulcastRateAllocatorTest, PausedStreamsGetNoBitrate) {
+  codec_.numberOfSimulcastStreams = 3;
+  codec_.maxBitrate = 0;
+  codec_.simulcastStream[0].minBitrate = 10;
+  codec_.simulcastStream[0].targetBitrate = 100;
+  codec_.simulcastStream[0].maxBitrate = 500;
+  codec_.simulcastStream[1].minBitrate = 50;
+  codec_.simulcastStream[1].targetBitrate = 500;
+  codec_.simulcastStream[1].maxBitrate = 1000;
+  codec_.simulcastStream[2].minBitrate = 2000;
+  codec_.simulcastStream[2].targetBitrate = 3000;
+  codec_.simulcastStream[2].maxBitrate = 4000;
+  CreateAllocator();
+
+  {
+    // The middle stream's share goes to the top one.
+    allocator_->SetStreamPaused(1, true);
+    const uint32_t bitrate = codec_.simulcastStream[0].targetBitrate +
+                             codec_.simulcastStream[2].minBitrate;
+    uint32_t expected[] = {codec_.simulcastStream[0].targetBitrate, 0,
+                           codec_.simulcastStream[2].minBitrate};
+    ExpectEqual(expected, GetAllocation(bitrate));
+  }
+
+  {
+    // The minimum bitrate applies to the lowest stream still sent.
+    allocator_->SetStreamPaused(0, true);
+    allocator_->SetStreamPaused(1, false);
+    allocator_->SetStreamPaused(2, true);
+    uint32_t expected[] = {0, codec_.simulcastStream[1].minBitrate, 0};
+    ExpectEqual(expected, GetAllocation(0));
+  }
+
+  {
+    allocator_->SetStreamPaused(1, true);
+    uint32_t expected[] = {0, 0, 0};
+    ExpectEqual(expected, GetAllocation(1000));
+  }
+
+  {
+    allocator_->SetStreamPaused(0, false);
+    allocator_->SetStreamPaused(1, false);
+    allocator_->SetStreamPaused(2, false);
+    const uint32_t bitrate = codec_.simulcastStream[0].targetBitrate +
+                             codec_.simulcastStream[1].targetBitrate +
+                             codec_.simulcastStream[2].minBitrate;
+    uint32_t expected[] = {codec_.simulcastStream[0].targetBitrate,
+                           codec_.simulcastStream[1].targetBitrate,
+                           codec_.simulcastStream[2].minBitrate};
+    ExpectEqual(expected, GetAllocation(bitrate));
+  }
+}
+
 TEST_F(SimulcastRateAllocatorTest, GetPreferredBitrateBps) {
   MockTemporalLayers mock_layers;
   allocator_.reset(new SimulcastRateAllocator(codec_, nullptr));
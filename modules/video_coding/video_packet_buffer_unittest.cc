@@ -378,12 +378,40 @@ TEST_F(TestPacketBuffer, GetBitstreamH264BufferPadding) {
   ASSERT_EQ(1UL, frames_from_callback_.size());
   EXPECT_EQ(frames_from_callback_[seq_num]->EncodedImage()._length,
             sizeof(data_data));
-  EXPECT_EQ(frames_from_callback_[seq_num]->EncodedImage()._size,
+  EXPECT_GE(frames_from_callback_[seq_num]->EncodedImage()._size,
             sizeof(data_data) + EncodedImage::kBufferPaddingBytesH264);
   EXPECT_TRUE(frames_from_callback_[seq_num]->GetBitstream(result.get()));
   EXPECT_EQ(memcmp(result.get(), data, sizeof(data_data)), 0);
 }
 
+TEST_F(TestPacketBuffer, ReusesBitstreamBufferOfDestroyedFrame) {
+  uint8_t payload[100] = {0};
+  const uint16_t seq_num = Rand();
+
+  EXPECT_TRUE(Insert(seq_num, kKeyFrame, kFirst, kNotLast, sizeof(payload),
+                     new uint8_t[sizeof(payload)]));
+  EXPECT_TRUE(Insert(seq_num + 1, kKeyFrame, kNotFirst, kLast,
+                     sizeof(payload), new uint8_t[sizeof(payload)]));
+  ASSERT_EQ(1UL, frames_from_callback_.size());
+  const uint8_t* key_frame_buffer =
+      frames_from_callback_[seq_num]->EncodedImage()._buffer;
+  frames_from_callback_.clear();
+
+  // A smaller frame gets the buffer of the key frame.
+  memset(payload, 0x17, sizeof(payload));
+  uint8_t* data = new uint8_t[sizeof(payload)];
+  memcpy(data, payload, sizeof(payload));
+  EXPECT_TRUE(
+      Insert(seq_num + 2, kDeltaFrame, kFirst, kLast, sizeof(payload), data));
+  ASSERT_EQ(1UL, frames_from_callback_.size());
+  const EncodedImage& image =
+      frames_from_callback_[seq_num + 2]->EncodedImage();
+  EXPECT_EQ(key_frame_buffer, image._buffer);
+  EXPECT_GE(image._size, 2 * sizeof(payload));
+  EXPECT_EQ(sizeof(payload), image._length);
+  EXPECT_EQ(0, memcmp(payload, image._buffer, sizeof(payload)));
+}
+
 TEST_F(TestPacketBuffer, FreeSlotsOnFrameDestruction) {
   const uint16_t seq_num = Rand();
 
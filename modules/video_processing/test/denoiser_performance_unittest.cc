@@ -0,0 +1,72 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "webrtc/api/video/i420_buffer.h"
+#include "webrtc/base/random.h"
+#include "webrtc/modules/video_processing/video_denoiser.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+constexpr int kWidth = 1280;
+constexpr int kHeight = 720;
+constexpr int kNumFrames = 100;
+
+// Noisy frames with a block moving a little every frame, so that both the
+// filtering and the moving object detection have something to do.
+rtc::scoped_refptr<I420Buffer> CreateFrame(int frame, Random* random) {
+  rtc::scoped_refptr<I420Buffer> buffer = I420Buffer::Create(kWidth, kHeight);
+  for (int y = 0; y < kHeight; ++y) {
+    uint8_t* row = buffer->MutableDataY() + y * buffer->StrideY();
+    for (int x = 0; x < kWidth; ++x) {
+      const bool in_block = x >= 4 * frame && x < 4 * frame + 160 &&
+                            y >= kHeight / 4 && y < kHeight / 2;
+      row[x] = (in_block ? 200 : 100) + random->Rand(-4, 4);
+    }
+  }
+  memset(buffer->MutableDataU(), 128,
+         buffer->StrideU() * ((kHeight + 1) / 2));
+  memset(buffer->MutableDataV(), 128,
+         buffer->StrideV() * ((kHeight + 1) / 2));
+  return buffer;
+}
+}  // namespace
+
+// Time to denoise a noisy 720p frame, with the macroblock rows split into
+// bands denoised in parallel by an increasing number of threads.
+TEST(VideoDenoiserPerformanceTest, DenoiseFrame) {
+  Random random(0x1234);
+  std::vector<rtc::scoped_refptr<VideoFrameBuffer>> frames;
+  for (int i = 0; i < kNumFrames; ++i)
+    frames.push_back(CreateFrame(i, &random));
+  Clock* clock = Clock::GetRealTimeClock();
+
+  for (int num_threads : {1, 2, 4}) {
+    VideoDenoiser denoiser(true, num_threads);
+    int64_t start_time_us = clock->TimeInMicroseconds();
+    for (const auto& frame : frames)
+      denoiser.DenoiseFrame(frame, true);
+    int64_t denoise_time_us = clock->TimeInMicroseconds() - start_time_us;
+
+    test::PrintResult("denoise_frame", "",
+                      "720p_" + std::to_string(num_threads) + "_threads",
+                      static_cast<double>(denoise_time_us) / kNumFrames, "us",
+                      false);
+  }
+}
+
+}  // namespace webrtc
@@ -158,4 +158,37 @@ TEST(VideoDenoiserTest, Denoiser) {
   ASSERT_NE(0, feof(source_file)) << "Error reading source file";
 }
 
+TEST(VideoDenoiserTest, MultiThreadedDenoiserMatchesSingleThreaded) {
+  const int kWidth = 352;
+  const int kHeight = 288;
+
+  const std::string video_file =
+      webrtc::test::ResourcePath("foreman_cif", "yuv");
+  FILE* source_file = fopen(video_file.c_str(), "rb");
+  ASSERT_TRUE(source_file != nullptr)
+      << "Cannot open source file: " << video_file;
+
+  VideoDenoiser denoiser_single(true, 1);
+  VideoDenoiser denoiser_multi(true, 4);
+
+  for (;;) {
+    rtc::scoped_refptr<VideoFrameBuffer> video_frame_buffer(
+        test::ReadI420Buffer(kWidth, kHeight, source_file));
+    if (!video_frame_buffer)
+      break;
+
+    rtc::scoped_refptr<VideoFrameBuffer> denoised_frame_single(
+        denoiser_single.DenoiseFrame(video_frame_buffer, true));
+    rtc::scoped_refptr<VideoFrameBuffer> denoised_frame_multi(
+        denoiser_multi.DenoiseFrame(video_frame_buffer, true));
+
+    // Splitting the frame into bands must not change the result, including
+    // the noise level estimated from previous frames.
+    ASSERT_TRUE(
+        test::FrameBufsEqual(denoised_frame_single, denoised_frame_multi));
+  }
+  ASSERT_NE(0, feof(source_file)) << "Error reading source file";
+  fclose(source_file);
+}
+
 }  // namespace webrtc
@@ -27,19 +27,34 @@ void NoiseEstimation::Init(int width, int height, CpuType cpu_type) {
 }
 
 void NoiseEstimation::GetNoise(int mb_index, uint32_t var, uint32_t luma) {
+  Samples samples;
+  GetNoise(mb_index, var, luma, &samples);
+  AddSamples(samples);
+}
+
+void NoiseEstimation::GetNoise(int mb_index,
+                               uint32_t var,
+                               uint32_t luma,
+                               Samples* samples) {
   consec_low_var_[mb_index]++;
-  num_static_block_++;
+  samples->num_static_block++;
   if (consec_low_var_[mb_index] >= kConsecLowVarFrame &&
       (luma >> 6) < kAverageLumaMax && (luma >> 6) > kAverageLumaMin) {
     // Normalized var by the average luma value, this gives more weight to
     // darker blocks.
     int nor_var = var / (luma >> 10);
-    noise_var_ +=
+    samples->noise_var +=
         nor_var > kBlockSelectionVarMax ? kBlockSelectionVarMax : nor_var;
-    num_noisy_block_++;
+    samples->num_noisy_block++;
   }
 }
 
+void NoiseEstimation::AddSamples(const Samples& samples) {
+  num_static_block_ += samples.num_static_block;
+  num_noisy_block_ += samples.num_noisy_block;
+  noise_var_ += samples.noise_var;
+}
+
 void NoiseEstimation::ResetConsecLowVar(int mb_index) {
   consec_low_var_[mb_index] = 0;
 }
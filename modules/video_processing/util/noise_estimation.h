@@ -34,9 +34,21 @@ const int kBlockSelectionVarMax = kNoiseThreshold << 1;
 
 class NoiseEstimation {
  public:
+  // Noise data collected from a number of blocks.
+  struct Samples {
+    Samples() : num_static_block(0), num_noisy_block(0), noise_var(0) {}
+    int num_static_block;
+    int num_noisy_block;
+    uint32_t noise_var;
+  };
+
   void Init(int width, int height, CpuType cpu_type);
   // Collect noise data from one qualified block.
   void GetNoise(int mb_index, uint32_t var, uint32_t luma);
+  // Same as above, but collects the noise data into |samples| instead, to be
+  // added with AddSamples(). Can be called concurrently for different blocks.
+  void GetNoise(int mb_index, uint32_t var, uint32_t luma, Samples* samples);
+  void AddSamples(const Samples& samples);
   // Reset the counter for consecutive low-var blocks.
   void ResetConsecLowVar(int mb_index);
   // Update noise level for current frame.
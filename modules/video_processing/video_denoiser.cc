@@ -10,7 +10,13 @@
 
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
 #include "webrtc/modules/video_processing/video_denoiser.h"
+
+#include <algorithm>
+
 #include "libyuv/planar_functions.h"
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/event.h"
 
 namespace webrtc {
 
@@ -67,10 +73,18 @@ static void ShowRect(const std::unique_ptr<DenoiserFilter>& filter,
 #endif
 
 VideoDenoiser::VideoDenoiser(bool runtime_cpu_detection)
+    : VideoDenoiser(runtime_cpu_detection, 1) {}
+
+VideoDenoiser::VideoDenoiser(bool runtime_cpu_detection, int num_threads)
     : width_(0),
       height_(0),
       filter_(DenoiserFilter::Create(runtime_cpu_detection, &cpu_type_)),
-      ne_(new NoiseEstimation()) {}
+      ne_(new NoiseEstimation()),
+      num_bands_(1) {
+  RTC_DCHECK_GE(num_threads, 1);
+  for (int i = 1; i < num_threads; ++i)
+    band_queues_.emplace_back(new rtc::TaskQueue("VideoDenoiserBandQueue"));
+}
 
 void VideoDenoiser::DenoiserReset(rtc::scoped_refptr<VideoFrameBuffer> frame) {
   width_ = frame->width();
@@ -85,6 +99,31 @@ void VideoDenoiser::DenoiserReset(rtc::scoped_refptr<VideoFrameBuffer> frame) {
   x_density_.reset(new uint8_t[mb_cols_]);
   y_density_.reset(new uint8_t[mb_rows_]);
   moving_object_.reset(new uint8_t[mb_cols_ * mb_rows_]);
+
+  // Each band gets at least one row of macroblocks.
+  num_bands_ = std::max(
+      1, std::min(static_cast<int>(band_queues_.size()) + 1, mb_rows_));
+  band_x_density_.reset(new uint8_t[num_bands_ * mb_cols_]);
+  band_noise_samples_.resize(num_bands_);
+}
+
+void VideoDenoiser::ForEachBand(
+    const std::function<void(int band, int mb_row_begin, int mb_row_end)>&
+        process_band) {
+  volatile int num_pending = num_bands_ - 1;
+  rtc::Event done(false, false);
+  for (int band = 1; band < num_bands_; ++band) {
+    band_queues_[band - 1]->PostTask(
+        [this, band, &process_band, &num_pending, &done]() {
+          process_band(band, band * mb_rows_ / num_bands_,
+                       (band + 1) * mb_rows_ / num_bands_);
+          if (rtc::AtomicOps::Decrement(&num_pending) == 0)
+            done.Set();
+        });
+  }
+  process_band(0, 0, mb_rows_ / num_bands_);
+  if (num_bands_ > 1)
+    done.Wait(rtc::Event::kForever);
 }
 
 int VideoDenoiser::PositionCheck(int mb_row, int mb_col, int noise_level) {
@@ -163,13 +202,15 @@ bool VideoDenoiser::IsTrailingBlock(const std::unique_ptr<uint8_t[]>& d_status,
   return ret;
 }
 
-void VideoDenoiser::CopySrcOnMOB(const uint8_t* y_src,
+void VideoDenoiser::CopySrcOnMOB(int mb_row_begin,
+                                 int mb_row_end,
+                                 const uint8_t* y_src,
                                  int stride_src,
                                  uint8_t* y_dst,
                                  int stride_dst) {
   // Loop over to copy src block if the block is marked as moving object block
   // or if the block may cause trailing artifacts.
-  for (int mb_row = 0; mb_row < mb_rows_; ++mb_row) {
+  for (int mb_row = mb_row_begin; mb_row < mb_row_end; ++mb_row) {
     const int mb_index_base = mb_row * mb_cols_;
     const uint8_t* mb_src_base = y_src + (mb_row << 4) * stride_src;
     uint8_t* mb_dst_base = y_dst + (mb_row << 4) * stride_dst;
@@ -211,38 +252,22 @@ void VideoDenoiser::CopyLumaOnMargin(const uint8_t* y_src,
   }
 }
 
-rtc::scoped_refptr<VideoFrameBuffer> VideoDenoiser::DenoiseFrame(
-    rtc::scoped_refptr<VideoFrameBuffer> frame,
-    bool noise_estimation_enabled) {
-  // If previous width and height are different from current frame's, need to
-  // reallocate the buffers and no denoising for the current frame.
-  if (!prev_buffer_ || width_ != frame->width() || height_ != frame->height()) {
-    DenoiserReset(frame);
-    prev_buffer_ = frame;
-    return frame;
-  }
-
-  // Set buffer pointers.
-  const uint8_t* y_src = frame->DataY();
-  int stride_y_src = frame->StrideY();
-  rtc::scoped_refptr<I420Buffer> dst =
-      buffer_pool_.CreateBuffer(width_, height_);
-
-  uint8_t* y_dst = dst->MutableDataY();
-  int stride_y_dst = dst->StrideY();
-
-  const uint8_t* y_dst_prev = prev_buffer_->DataY();
-  int stride_prev = prev_buffer_->StrideY();
-
-  memset(x_density_.get(), 0, mb_cols_);
-  memset(y_density_.get(), 0, mb_rows_);
-  memset(moving_object_.get(), 1, mb_cols_ * mb_rows_);
-
-  uint8_t noise_level = noise_estimation_enabled ? ne_->GetNoiseLevel() : 0;
+void VideoDenoiser::DenoiseBand(int band,
+                                int mb_row_begin,
+                                int mb_row_end,
+                                const uint8_t* y_src,
+                                int stride_y_src,
+                                uint8_t* y_dst,
+                                int stride_y_dst,
+                                const uint8_t* y_dst_prev,
+                                int stride_prev,
+                                uint8_t noise_level) {
   int thr_var_base = 16 * 16 * 2;
+  uint8_t* x_density = &band_x_density_[band * mb_cols_];
+  NoiseEstimation::Samples* noise_samples = &band_noise_samples_[band];
   // Loop over blocks to accumulate/extract noise level and update x/y_density
   // factors for moving object detection.
-  for (int mb_row = 0; mb_row < mb_rows_; ++mb_row) {
+  for (int mb_row = mb_row_begin; mb_row < mb_row_end; ++mb_row) {
     const int mb_index_base = mb_row * mb_cols_;
     const uint8_t* mb_src_base = y_src + (mb_row << 4) * stride_y_src;
     uint8_t* mb_dst_base = y_dst + (mb_row << 4) * stride_y_dst;
@@ -282,7 +307,7 @@ rtc::scoped_refptr<VideoFrameBuffer> VideoDenoiser::DenoiseFrame(
           // time t (mb_src) and filtered block in time t-1 (mb_dist_prev).
           uint32_t noise_var = filter_->Variance16x8(
               mb_dst_prev, stride_y_dst, mb_src, stride_y_src, &sse_t);
-          ne_->GetNoise(mb_index, noise_var, luma);
+          ne_->GetNoise(mb_index, noise_var, luma, noise_samples);
         }
         moving_edge_[mb_index] = 0;  // Not a moving edge block.
       } else {
@@ -296,7 +321,7 @@ rtc::scoped_refptr<VideoFrameBuffer> VideoDenoiser::DenoiseFrame(
             ne_->ResetConsecLowVar(mb_index);
           }
           moving_edge_[mb_index] = 1;  // Mark as moving edge block.
-          x_density_[mb_col] += (pos_factor < 3);
+          x_density[mb_col] += (pos_factor < 3);
           y_density_[mb_row] += (pos_factor < 3);
         } else {
           moving_edge_[mb_index] = 0;
@@ -305,16 +330,64 @@ rtc::scoped_refptr<VideoFrameBuffer> VideoDenoiser::DenoiseFrame(
             // in time t (mb_src) and filtered block in time t-1 (mb_dist_prev).
             uint32_t noise_var = filter_->Variance16x8(
                 mb_dst_prev, stride_prev, mb_src, stride_y_src, &sse_t);
-            ne_->GetNoise(mb_index, noise_var, luma);
+            ne_->GetNoise(mb_index, noise_var, luma, noise_samples);
           }
         }
       }
     }  // End of for loop
   }    // End of for loop
+}
+
+rtc::scoped_refptr<VideoFrameBuffer> VideoDenoiser::DenoiseFrame(
+    rtc::scoped_refptr<VideoFrameBuffer> frame,
+    bool noise_estimation_enabled) {
+  // If previous width and height are different from current frame's, need to
+  // reallocate the buffers and no denoising for the current frame.
+  if (!prev_buffer_ || width_ != frame->width() || height_ != frame->height()) {
+    DenoiserReset(frame);
+    prev_buffer_ = frame;
+    return frame;
+  }
+
+  // Set buffer pointers.
+  const uint8_t* y_src = frame->DataY();
+  int stride_y_src = frame->StrideY();
+  rtc::scoped_refptr<I420Buffer> dst =
+      buffer_pool_.CreateBuffer(width_, height_);
+
+  uint8_t* y_dst = dst->MutableDataY();
+  int stride_y_dst = dst->StrideY();
+
+  const uint8_t* y_dst_prev = prev_buffer_->DataY();
+  int stride_prev = prev_buffer_->StrideY();
+
+  memset(x_density_.get(), 0, mb_cols_);
+  memset(y_density_.get(), 0, mb_rows_);
+  memset(moving_object_.get(), 1, mb_cols_ * mb_rows_);
+
+  uint8_t noise_level = noise_estimation_enabled ? ne_->GetNoiseLevel() : 0;
+  memset(band_x_density_.get(), 0, num_bands_ * mb_cols_);
+  std::fill(band_noise_samples_.begin(), band_noise_samples_.end(),
+            NoiseEstimation::Samples());
+  ForEachBand([&](int band, int mb_row_begin, int mb_row_end) {
+    DenoiseBand(band, mb_row_begin, mb_row_end, y_src, stride_y_src, y_dst,
+                stride_y_dst, y_dst_prev, stride_prev, noise_level);
+  });
+  // The densities are sums of counts, so adding up those of the bands gives
+  // the same result as counting over the whole frame.
+  for (int band = 0; band < num_bands_; ++band) {
+    const uint8_t* band_x_density = &band_x_density_[band * mb_cols_];
+    for (int mb_col = 0; mb_col < mb_cols_; ++mb_col)
+      x_density_[mb_col] += band_x_density[mb_col];
+    ne_->AddSamples(band_noise_samples_[band]);
+  }
 
   ReduceFalseDetection(moving_edge_, &moving_object_, noise_level);
 
-  CopySrcOnMOB(y_src, stride_y_src, y_dst, stride_y_dst);
+  ForEachBand([&](int band, int mb_row_begin, int mb_row_end) {
+    CopySrcOnMOB(mb_row_begin, mb_row_end, y_src, stride_y_src, y_dst,
+                 stride_y_dst);
+  });
 
   // When frame width/height not divisible by 16, copy the margin to
   // denoised_frame.
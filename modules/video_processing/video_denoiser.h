@@ -11,8 +11,11 @@
 #ifndef WEBRTC_MODULES_VIDEO_PROCESSING_VIDEO_DENOISER_H_
 #define WEBRTC_MODULES_VIDEO_PROCESSING_VIDEO_DENOISER_H_
 
+#include <functional>
 #include <memory>
+#include <vector>
 
+#include "webrtc/base/task_queue.h"
 #include "webrtc/common_video/include/i420_buffer_pool.h"
 #include "webrtc/modules/video_processing/util/denoiser_filter.h"
 #include "webrtc/modules/video_processing/util/noise_estimation.h"
@@ -23,6 +26,9 @@ namespace webrtc {
 class VideoDenoiser {
  public:
   explicit VideoDenoiser(bool runtime_cpu_detection);
+  // Splits frames into up to |num_threads| bands of macroblock rows which are
+  // denoised in parallel, with the same output as with a single thread.
+  VideoDenoiser(bool runtime_cpu_detection, int num_threads);
 
   rtc::scoped_refptr<VideoFrameBuffer> DenoiseFrame(
       rtc::scoped_refptr<VideoFrameBuffer> frame,
@@ -31,6 +37,25 @@ class VideoDenoiser {
  private:
   void DenoiserReset(rtc::scoped_refptr<VideoFrameBuffer> frame);
 
+  // Calls |process_band| for each band with the band index and its range of
+  // macroblock rows, on the calling thread and on |band_queues_|, and returns
+  // when all bands are processed.
+  void ForEachBand(
+      const std::function<void(int band, int mb_row_begin, int mb_row_end)>&
+          process_band);
+
+  // Filters the blocks of the rows [|mb_row_begin|, |mb_row_end|), and
+  // collects their noise and moving object detection data.
+  void DenoiseBand(int band,
+                   int mb_row_begin,
+                   int mb_row_end,
+                   const uint8_t* y_src,
+                   int stride_y_src,
+                   uint8_t* y_dst,
+                   int stride_y_dst,
+                   const uint8_t* y_dst_prev,
+                   int stride_prev,
+                   uint8_t noise_level);
   // Check the mb position, return 1: close to the frame center (between 1/8
   // and 7/8 of width/height), 3: close to the border (out of 1/16 and 15/16
   // of width/height), 2: in between.
@@ -48,7 +73,9 @@ class VideoDenoiser {
                        int mb_col);
 
   // Copy input blocks to dst buffer on moving object blocks (MOB).
-  void CopySrcOnMOB(const uint8_t* y_src,
+  void CopySrcOnMOB(int mb_row_begin,
+                    int mb_row_end,
+                    const uint8_t* y_src,
                     int stride_src,
                     uint8_t* y_dst,
                     int stride_dst);
@@ -75,6 +102,12 @@ class VideoDenoiser {
   std::unique_ptr<uint8_t[]> y_density_;
   // Save the return values by MbDenoise for each block.
   std::unique_ptr<DenoiserDecision[]> mb_filter_decision_;
+  // Per band x_density_ and noise data, summed up once all bands are done.
+  int num_bands_;
+  std::unique_ptr<uint8_t[]> band_x_density_;
+  std::vector<NoiseEstimation::Samples> band_noise_samples_;
+  // Queues for all bands but the first, which is run on the calling thread.
+  std::vector<std::unique_ptr<rtc::TaskQueue>> band_queues_;
   I420BufferPool buffer_pool_;
   rtc::scoped_refptr<VideoFrameBuffer> prev_buffer_;
 };
@@ -12,6 +12,7 @@
 #include <utility>
 
 #include "webrtc/p2p/base/dtlstransportchannel.h"
+#include "webrtc/api/umametrics.h"
 
 #include "webrtc/p2p/base/common.h"
 #include "webrtc/p2p/base/packettransportinterface.h"
@@ -22,6 +23,7 @@
 #include "webrtc/base/sslstreamadapter.h"
 #include "webrtc/base/stream.h"
 #include "webrtc/base/thread.h"
+#include "webrtc/base/timeutils.h"
 
 namespace cricket {
 
@@ -300,6 +302,8 @@ bool DtlsTransportChannelWrapper::SetupDtls() {
   dtls_->SetMode(rtc::SSL_MODE_DTLS);
   dtls_->SetMaxProtocolVersion(ssl_max_version_);
   dtls_->SetServerRole(ssl_role_);
+  if (ssl_session_cache_)
+    dtls_->SetSessionCache(ssl_session_cache_);
   dtls_->SignalEvent.connect(this, &DtlsTransportChannelWrapper::OnDtlsEvent);
   dtls_->SignalSSLHandshakeError.connect(
       this, &DtlsTransportChannelWrapper::OnDtlsHandshakeError);
@@ -589,6 +593,7 @@ void DtlsTransportChannelWrapper::OnDtlsEvent(rtc::StreamInterface* dtls,
       // sure we don't accidentally frob the state if it's closed.
       set_dtls_state(DTLS_TRANSPORT_CONNECTED);
       set_writable(true);
+      ReportDtlsHandshakeTime();
     }
   }
   if (sig & rtc::SE_READ) {
@@ -623,6 +628,20 @@ void DtlsTransportChannelWrapper::OnDtlsEvent(rtc::StreamInterface* dtls,
   }
 }
 
+void DtlsTransportChannelWrapper::ReportDtlsHandshakeTime() {
+  int handshake_time_ms =
+      static_cast<int>(rtc::TimeMillis() - dtls_handshake_start_ms_);
+  bool resumed = dtls_->IsSessionResumed();
+  LOG_J(LS_INFO, this) << "DTLS handshake took " << handshake_time_ms << " ms"
+                       << (resumed ? ", resumed session." : ".");
+  if (metrics_observer_) {
+    metrics_observer_->AddHistogramSample(
+        resumed ? webrtc::kDtlsResumedHandshakeTime
+                : webrtc::kDtlsHandshakeTime,
+        handshake_time_ms);
+  }
+}
+
 void DtlsTransportChannelWrapper::MaybeStartDtls() {
   if (dtls_ && channel_->writable()) {
     if (dtls_->StartSSL()) {
@@ -639,6 +658,7 @@ void DtlsTransportChannelWrapper::MaybeStartDtls() {
     }
     LOG_J(LS_INFO, this)
       << "DtlsTransportChannelWrapper: Started DTLS handshake";
+    dtls_handshake_start_ms_ = rtc::TimeMillis();
     set_dtls_state(DTLS_TRANSPORT_CONNECTING);
     // Now that the handshake has started, we can process a cached ClientHello
     // (if one exists).
@@ -126,6 +126,12 @@ class DtlsTransportChannelWrapper : public TransportChannelImpl {
 
   virtual bool SetSslMaxProtocolVersion(rtc::SSLProtocolVersion version);
 
+  // Lets the DTLS handshake resume a session from |cache|, which must outlive
+  // this channel. Must be called before the remote fingerprint is set.
+  void SetSslSessionCache(rtc::SSLSessionCache* cache) {
+    ssl_session_cache_ = cache;
+  }
+
   // Set up the ciphers to use for DTLS-SRTP. If this method is not called
   // before DTLS starts, or |ciphers| is empty, SRTP keys won't be negotiated.
   // This method should be called before SetupDtls.
@@ -190,6 +196,7 @@ class DtlsTransportChannelWrapper : public TransportChannelImpl {
   }
 
   void SetMetricsObserver(webrtc::MetricsObserverInterface* observer) override {
+    metrics_observer_ = observer;
     channel_->SetMetricsObserver(observer);
   }
 
@@ -219,6 +226,7 @@ class DtlsTransportChannelWrapper : public TransportChannelImpl {
   void OnDtlsEvent(rtc::StreamInterface* stream_, int sig, int err);
   bool SetupDtls();
   void MaybeStartDtls();
+  void ReportDtlsHandshakeTime();
   bool HandleDtlsPacket(const char* data, size_t size);
   void OnGatheringState(IceTransportInternal* channel);
   void OnCandidateGathered(IceTransportInternal* channel, const Candidate& c);
@@ -246,6 +254,10 @@ class DtlsTransportChannelWrapper : public TransportChannelImpl {
   rtc::SSLProtocolVersion ssl_max_version_;
   rtc::Buffer remote_fingerprint_value_;
   std::string remote_fingerprint_algorithm_;
+  rtc::SSLSessionCache* ssl_session_cache_ = nullptr;
+  webrtc::MetricsObserverInterface* metrics_observer_ = nullptr;
+  // When the DTLS handshake started, to report how long it took.
+  int64_t dtls_handshake_start_ms_ = 0;
 
   // Cached DTLS ClientHello packet that was received before we started the
   // DTLS handshake. This could happen if the hello was received before the
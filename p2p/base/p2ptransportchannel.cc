@@ -58,6 +58,25 @@ cricket::PortInterface::CandidateOrigin GetOrigin(cricket::PortInterface* port,
     return cricket::PortInterface::ORIGIN_OTHER_PORT;
 }
 
+// Sorts like std::stable_sort, but an element that is already in order costs
+// a single comparison. The connections are re-sorted after every state change,
+// which typically moves only a few of them, so this needs O(n) instead of
+// O(n log n) calls to the expensive comparator. Elements that are out of order
+// are placed by binary search.
+template <typename Iter, typename Less>
+void StableSortNearlySorted(Iter begin, Iter end, Less less) {
+  if (begin == end)
+    return;
+  for (Iter it = begin + 1; it != end; ++it) {
+    if (!less(*it, *(it - 1)))
+      continue;
+    auto value = std::move(*it);
+    Iter pos = std::upper_bound(begin, it, value, less);
+    std::move_backward(pos, it, it + 1);
+    *pos = std::move(value);
+  }
+}
+
 }  // unnamed namespace
 
 namespace cricket {
@@ -1235,17 +1254,18 @@ void P2PTransportChannel::SortConnectionsAndUpdateState() {
   // that amongst equal preference, writable connections, this will choose the
   // one whose estimated latency is lowest.  So it is the only one that we
   // need to consider switching to.
-  // TODO(honghaiz): Don't sort;  Just use std::max_element in the right places.
-  std::stable_sort(connections_.begin(), connections_.end(),
-                   [this](const Connection* a, const Connection* b) {
-                     int cmp = CompareConnections(
-                         a, b, rtc::Optional<int64_t>(), nullptr);
-                     if (cmp != 0) {
-                       return cmp > 0;
-                     }
-                     // Otherwise, sort based on latency estimate.
-                     return a->rtt() < b->rtt();
-                   });
+  // The previous order is kept as the starting point, so only the connections
+  // whose state changed since the last sort have to be moved.
+  StableSortNearlySorted(connections_.begin(), connections_.end(),
+                         [this](const Connection* a, const Connection* b) {
+                           int cmp = CompareConnections(
+                               a, b, rtc::Optional<int64_t>(), nullptr);
+                           if (cmp != 0) {
+                             return cmp > 0;
+                           }
+                           // Otherwise, sort based on latency estimate.
+                           return a->rtt() < b->rtt();
+                         });
 
   LOG(LS_VERBOSE) << "Sorting " << connections_.size()
                   << " available connections:";
@@ -1660,10 +1680,18 @@ Connection* P2PTransportChannel::FindNextPingableConnection() {
     }
   }
 
+  // The remaining rules only consider pingable connections, in the order of
+  // |connections_|. Evaluate IsPingable once for each of them.
+  std::vector<Connection*> pingable_connections;
+  pingable_connections.reserve(connections_.size());
+  std::copy_if(connections_.begin(), connections_.end(),
+               std::back_inserter(pingable_connections),
+               [this, now](Connection* conn) { return IsPingable(conn, now); });
+
   // Rule 3: Triggered checks have priority over non-triggered connections.
   // Rule 3.1: Among triggered checks, oldest takes precedence.
   Connection* oldest_triggered_check =
-      FindOldestConnectionNeedingTriggeredCheck(now);
+      FindOldestConnectionNeedingTriggeredCheck(pingable_connections);
   if (oldest_triggered_check) {
     return oldest_triggered_check;
   }
@@ -1675,29 +1703,28 @@ Connection* P2PTransportChannel::FindNextPingableConnection() {
   // Otherwise, treat everything as unpinged.
   // TODO(honghaiz): Instead of adding two separate vectors, we can add a state
   // "pinged" to filter out unpinged connections.
-  if (std::find_if(unpinged_connections_.begin(), unpinged_connections_.end(),
-                   [this, now](Connection* conn) {
-                     return this->IsPingable(conn, now);
-                   }) == unpinged_connections_.end()) {
+  std::vector<Connection*> unpinged_pingable_connections;
+  std::copy_if(pingable_connections.begin(), pingable_connections.end(),
+               std::back_inserter(unpinged_pingable_connections),
+               [this](Connection* conn) {
+                 return unpinged_connections_.count(conn) > 0;
+               });
+  if (unpinged_pingable_connections.empty()) {
     unpinged_connections_.insert(pinged_connections_.begin(),
                                  pinged_connections_.end());
     pinged_connections_.clear();
+    unpinged_pingable_connections.swap(pingable_connections);
   }
 
   // Among un-pinged pingable connections, "more pingable" takes precedence.
-  std::vector<Connection*> pingable_connections;
-  std::copy_if(unpinged_connections_.begin(), unpinged_connections_.end(),
-               std::back_inserter(pingable_connections),
-               [this, now](Connection* conn) { return IsPingable(conn, now); });
-  auto iter =
-      std::max_element(pingable_connections.begin(), pingable_connections.end(),
-                       [this](Connection* conn1, Connection* conn2) {
-                         return MorePingable(conn1, conn2) == conn2;
-                       });
-  if (iter != pingable_connections.end()) {
-    return *iter;
+  // Of equally pingable connections, the first one in |connections_| wins.
+  Connection* most_pingable = nullptr;
+  for (Connection* conn : unpinged_pingable_connections) {
+    if (!most_pingable || MorePingable(most_pingable, conn) == conn) {
+      most_pingable = conn;
+    }
   }
-  return nullptr;
+  return most_pingable;
 }
 
 void P2PTransportChannel::MarkConnectionPinged(Connection* conn) {
@@ -1942,12 +1969,9 @@ void P2PTransportChannel::OnReadyToSend(Connection* connection) {
 // (last_ping_received > last_ping_sent).  But we shouldn't do
 // triggered checks if the connection is already writable.
 Connection* P2PTransportChannel::FindOldestConnectionNeedingTriggeredCheck(
-    int64_t now) {
+    const std::vector<Connection*>& pingable_connections) {
   Connection* oldest_needing_triggered_check = nullptr;
-  for (auto conn : connections_) {
-    if (!IsPingable(conn, now)) {
-      continue;
-    }
+  for (auto conn : pingable_connections) {
     bool needs_triggered_check =
         (!conn->writable() &&
          conn->last_ping_received() > conn->last_ping_sent());
@@ -2012,12 +2036,10 @@ Connection* P2PTransportChannel::MorePingable(Connection* conn1,
     return least_recently_pinged_conn;
   }
 
-  // During the initial state when nothing has been pinged yet, return the first
-  // one in the ordered |connections_|.
-  return *(std::find_if(connections_.begin(), connections_.end(),
-                        [conn1, conn2](Connection* conn) {
-                          return conn == conn1 || conn == conn2;
-                        }));
+  // During the initial state when nothing has been pinged yet, return the one
+  // that comes first in the ordered |connections_|, which the caller passes as
+  // |conn1|.
+  return conn1;
 }
 
 void P2PTransportChannel::set_writable(bool writable) {
@@ -281,9 +281,13 @@ class P2PTransportChannel : public IceTransportInternal,
   void PruneConnections();
   bool IsBackupConnection(const Connection* conn) const;
 
-  Connection* FindOldestConnectionNeedingTriggeredCheck(int64_t now);
+  // |pingable_connections| are the connections that IsPingable returned true
+  // for.
+  Connection* FindOldestConnectionNeedingTriggeredCheck(
+      const std::vector<Connection*>& pingable_connections);
   // Between |conn1| and |conn2|, this function returns the one which should
-  // be pinged first.
+  // be pinged first. |conn1| must precede |conn2| in |connections_|, it is
+  // returned if neither is preferred.
   Connection* MorePingable(Connection* conn1, Connection* conn2);
   // Select the connection which is Relay/Relay. If both of them are,
   // UDP relay protocol takes precedence.
@@ -74,6 +74,16 @@ enum {
   // candidates. Doing so ensures that even if a cellular network type was not
   // detected initially, it would not be used if a Wi-Fi network is present.
   PORTALLOCATOR_DISABLE_COSTLY_NETWORKS = 0x2000,
+
+  // Start all the allocation phases (UDP and STUN, relay, TCP) at once rather
+  // than one step delay apart, so that the first candidates of every type are
+  // gathered as soon as possible.
+  PORTALLOCATOR_ENABLE_PARALLEL_PHASES = 0x4000,
+
+  // Use the process-wide ServerAddressCache, so that STUN and TURN server
+  // hostnames resolved on a network by an earlier session aren't looked up
+  // again.
+  PORTALLOCATOR_ENABLE_SERVER_ADDRESS_CACHE = 0x8000,
 };
 
 // Defines various reasons that have caused ICE regathering.
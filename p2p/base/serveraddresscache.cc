@@ -0,0 +1,98 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/p2p/base/serveraddresscache.h"
+
+#include "webrtc/base/basictypes.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/timeutils.h"
+
+namespace cricket {
+
+namespace {
+
+// Returns true if |address| was created from a hostname rather than from a
+// literal IP.
+bool HasHostname(const rtc::SocketAddress& address) {
+  rtc::IPAddress ip;
+  return !address.hostname().empty() &&
+         !rtc::IPFromString(address.hostname(), &ip);
+}
+
+}  // namespace
+
+const int ServerAddressCache::kDefaultMaxAgeMs;
+
+ServerAddressCache::ServerAddressCache() : max_age_ms_(kDefaultMaxAgeMs) {}
+
+ServerAddressCache::~ServerAddressCache() {}
+
+// static
+ServerAddressCache* ServerAddressCache::Instance() {
+  RTC_DEFINE_STATIC_LOCAL(ServerAddressCache, cache, ());
+  return &cache;
+}
+
+bool ServerAddressCache::Lookup(const std::string& network_key,
+                                const rtc::SocketAddress& address,
+                                int family,
+                                rtc::SocketAddress* resolved) const {
+  RTC_DCHECK(resolved);
+  if (!HasHostname(address))
+    return false;
+  rtc::CritScope cs(&crit_);
+  auto it = entries_.find(Key(network_key, address.hostname(), family));
+  if (it == entries_.end() ||
+      rtc::TimeSince(it->second.stored_ms) >= max_age_ms_) {
+    return false;
+  }
+  *resolved = address;
+  resolved->SetResolvedIP(it->second.ip);
+  return true;
+}
+
+void ServerAddressCache::Store(const std::string& network_key,
+                               const rtc::SocketAddress& resolved) {
+  if (!HasHostname(resolved) || resolved.IsUnresolvedIP())
+    return;
+  rtc::CritScope cs(&crit_);
+  Entry& entry = entries_[Key(network_key, resolved.hostname(),
+                              resolved.ipaddr().family())];
+  entry.ip = resolved.ipaddr();
+  entry.stored_ms = rtc::TimeMillis();
+}
+
+void ServerAddressCache::Remove(const std::string& network_key,
+                                const rtc::SocketAddress& address) {
+  if (!HasHostname(address) || address.IsUnresolvedIP())
+    return;
+  rtc::CritScope cs(&crit_);
+  auto it = entries_.find(
+      Key(network_key, address.hostname(), address.ipaddr().family()));
+  if (it != entries_.end() && it->second.ip == address.ipaddr())
+    entries_.erase(it);
+}
+
+void ServerAddressCache::Clear() {
+  rtc::CritScope cs(&crit_);
+  entries_.clear();
+}
+
+void ServerAddressCache::set_max_age_ms(int max_age_ms) {
+  rtc::CritScope cs(&crit_);
+  max_age_ms_ = max_age_ms;
+}
+
+size_t ServerAddressCache::size() const {
+  rtc::CritScope cs(&crit_);
+  return entries_.size();
+}
+
+}  // namespace cricket
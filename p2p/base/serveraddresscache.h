@@ -0,0 +1,73 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_P2P_BASE_SERVERADDRESSCACHE_H_
+#define WEBRTC_P2P_BASE_SERVERADDRESSCACHE_H_
+
+#include <map>
+#include <string>
+#include <tuple>
+
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/socketaddress.h"
+#include "webrtc/base/thread_annotations.h"
+
+namespace cricket {
+
+// Remembers the addresses that STUN and TURN server hostnames resolved to on
+// each network, so that the ports of new sessions can contact the servers
+// right away instead of waiting for a DNS lookup. An address is used until it
+// is older than the maximum age, or until a server stops answering at it.
+// Thread safe.
+class ServerAddressCache {
+ public:
+  static const int kDefaultMaxAgeMs = 5 * 60 * 1000;  // 5 minutes.
+
+  ServerAddressCache();
+  ~ServerAddressCache();
+
+  // The cache shared by all the ports of the process.
+  static ServerAddressCache* Instance();
+
+  // Returns true and sets |resolved| to |address| with the cached IP, if
+  // the hostname of |address| was resolved to an IP of |family| on the
+  // network with key |network_key| less than the maximum age ago.
+  bool Lookup(const std::string& network_key,
+              const rtc::SocketAddress& address,
+              int family,
+              rtc::SocketAddress* resolved) const;
+  // Stores the IP that the hostname of |resolved| resolved to.
+  void Store(const std::string& network_key,
+             const rtc::SocketAddress& resolved);
+  // Forgets the IP that the hostname of |address| resolved to, if |address|
+  // is where it came from.
+  void Remove(const std::string& network_key,
+              const rtc::SocketAddress& address);
+  void Clear();
+
+  void set_max_age_ms(int max_age_ms);
+  size_t size() const;
+
+ private:
+  struct Entry {
+    rtc::IPAddress ip;
+    int64_t stored_ms;
+  };
+  // Network key, hostname and address family.
+  typedef std::tuple<std::string, std::string, int> Key;
+
+  mutable rtc::CriticalSection crit_;
+  int max_age_ms_ GUARDED_BY(crit_);
+  std::map<Key, Entry> entries_ GUARDED_BY(crit_);
+};
+
+}  // namespace cricket
+
+#endif  // WEBRTC_P2P_BASE_SERVERADDRESSCACHE_H_
@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/p2p/base/serveraddresscache.h"
+#include "webrtc/base/fakeclock.h"
+#include "webrtc/base/gunit.h"
+
+namespace cricket {
+
+namespace {
+
+const char kNetworkKey1[] = "eth0%192.168.1.0/24";
+const char kNetworkKey2[] = "wlan0%10.0.0.0/8";
+const char kHostname[] = "stun.example.org";
+
+rtc::SocketAddress Resolved(const std::string& ip) {
+  rtc::SocketAddress address(kHostname, 3478);
+  rtc::IPAddress resolved_ip;
+  EXPECT_TRUE(rtc::IPFromString(ip, &resolved_ip));
+  address.SetResolvedIP(resolved_ip);
+  return address;
+}
+
+}  // namespace
+
+TEST(ServerAddressCacheTest, LookupReturnsStoredAddress) {
+  ServerAddressCache cache;
+  rtc::SocketAddress resolved;
+  EXPECT_FALSE(cache.Lookup(kNetworkKey1, rtc::SocketAddress(kHostname, 3478),
+                            AF_INET, &resolved));
+
+  cache.Store(kNetworkKey1, Resolved("1.2.3.4"));
+  // The port of the looked up address is kept.
+  ASSERT_TRUE(cache.Lookup(kNetworkKey1, rtc::SocketAddress(kHostname, 19302),
+                           AF_INET, &resolved));
+  EXPECT_EQ(kHostname, resolved.hostname());
+  EXPECT_EQ("1.2.3.4", resolved.ipaddr().ToString());
+  EXPECT_EQ(19302, resolved.port());
+}
+
+TEST(ServerAddressCacheTest, AddressesAreKeptPerNetworkAndFamily) {
+  ServerAddressCache cache;
+  cache.Store(kNetworkKey1, Resolved("1.2.3.4"));
+  cache.Store(kNetworkKey1, Resolved("2001:db8::1"));
+  cache.Store(kNetworkKey2, Resolved("5.6.7.8"));
+  EXPECT_EQ(3U, cache.size());
+
+  rtc::SocketAddress unresolved(kHostname, 3478);
+  rtc::SocketAddress resolved;
+  ASSERT_TRUE(cache.Lookup(kNetworkKey1, unresolved, AF_INET6, &resolved));
+  EXPECT_EQ("2001:db8::1", resolved.ipaddr().ToString());
+  ASSERT_TRUE(cache.Lookup(kNetworkKey2, unresolved, AF_INET, &resolved));
+  EXPECT_EQ("5.6.7.8", resolved.ipaddr().ToString());
+  EXPECT_FALSE(cache.Lookup(kNetworkKey2, unresolved, AF_INET6, &resolved));
+}
+
+TEST(ServerAddressCacheTest, AddressesExpire) {
+  rtc::ScopedFakeClock clock;
+  ServerAddressCache cache;
+  cache.set_max_age_ms(1000);
+  cache.Store(kNetworkKey1, Resolved("1.2.3.4"));
+
+  rtc::SocketAddress unresolved(kHostname, 3478);
+  rtc::SocketAddress resolved;
+  clock.AdvanceTime(rtc::TimeDelta::FromMilliseconds(999));
+  EXPECT_TRUE(cache.Lookup(kNetworkKey1, unresolved, AF_INET, &resolved));
+  clock.AdvanceTime(rtc::TimeDelta::FromMilliseconds(1));
+  EXPECT_FALSE(cache.Lookup(kNetworkKey1, unresolved, AF_INET, &resolved));
+
+  // Storing the address again refreshes it.
+  cache.Store(kNetworkKey1, Resolved("1.2.3.4"));
+  EXPECT_TRUE(cache.Lookup(kNetworkKey1, unresolved, AF_INET, &resolved));
+}
+
+TEST(ServerAddressCacheTest, RemoveOnlyForgetsMatchingAddress) {
+  ServerAddressCache cache;
+  cache.Store(kNetworkKey1, Resolved("1.2.3.4"));
+
+  // The hostname resolves to a different address now.
+  cache.Remove(kNetworkKey1, Resolved("5.6.7.8"));
+  EXPECT_EQ(1U, cache.size());
+
+  cache.Remove(kNetworkKey1, Resolved("1.2.3.4"));
+  EXPECT_EQ(0U, cache.size());
+}
+
+TEST(ServerAddressCacheTest, IgnoresAddressesWithoutHostname) {
+  ServerAddressCache cache;
+  cache.Store(kNetworkKey1, rtc::SocketAddress("1.2.3.4", 3478));
+  EXPECT_EQ(0U, cache.size());
+
+  rtc::SocketAddress resolved;
+  EXPECT_FALSE(cache.Lookup(kNetworkKey1, rtc::SocketAddress("1.2.3.4", 3478),
+                            AF_INET, &resolved));
+}
+
+}  // namespace cricket
@@ -43,6 +43,10 @@ const char TURN_MAGIC_COOKIE_VALUE[] = { '\x72', '\xC6', '\x4B', '\xC6' };
 const char EMPTY_TRANSACTION_ID[] = "0000000000000000";
 const uint32_t STUN_FINGERPRINT_XOR_VALUE = 0x5354554E;
 
+// USERNAME, PRIORITY, ICE-CONTROLLING, USE-CANDIDATE, NETWORK-INFO,
+// MESSAGE-INTEGRITY and FINGERPRINT, with room to spare.
+static const size_t kTypicalAttributeCount = 8;
+
 // StunMessage
 
 StunMessage::StunMessage()
@@ -50,14 +54,9 @@ StunMessage::StunMessage()
       length_(0),
       transaction_id_(EMPTY_TRANSACTION_ID) {
   RTC_DCHECK(IsValidTransactionId(transaction_id_));
-  attrs_ = new std::vector<StunAttribute*>();
 }
 
-StunMessage::~StunMessage() {
-  for (size_t i = 0; i < attrs_->size(); i++)
-    delete (*attrs_)[i];
-  delete attrs_;
-}
+StunMessage::~StunMessage() {}
 
 bool StunMessage::IsLegacy() const {
   if (transaction_id_.size() == kStunLegacyTransactionIdLength)
@@ -79,7 +78,7 @@ bool StunMessage::AddAttribute(StunAttribute* attr) {
   if (attr->value_type() != GetAttributeValueType(attr->type())) {
     return false;
   }
-  attrs_->push_back(attr);
+  attrs_.push_back(std::unique_ptr<StunAttribute>(attr));
   attr->SetOwner(this);
   size_t attr_length = attr->length();
   if (attr_length % 4 != 0) {
@@ -174,10 +173,11 @@ bool StunMessage::ValidateMessageIntegrity(const char* data, size_t size,
     return false;
   }
 
-  // Getting length of the message to calculate Message Integrity.
+  // Getting length of the message to calculate Message Integrity. Only the
+  // header is copied, the rest of the message is hashed in place.
   size_t mi_pos = current_pos;
-  std::unique_ptr<char[]> temp_data(new char[current_pos]);
-  memcpy(temp_data.get(), data, current_pos);
+  char header[kStunHeaderSize];
+  memcpy(header, data, kStunHeaderSize);
   if (size > mi_pos + kStunAttributeHeaderSize + kStunMessageIntegritySize) {
     // Stun message has other attributes after message integrity.
     // Adjust the length parameter in stun message to calculate HMAC.
@@ -191,14 +191,18 @@ bool StunMessage::ValidateMessageIntegrity(const char* data, size_t size,
     //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
     //     |0 0|     STUN Message Type     |         Message Length        |
     //     +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
-    rtc::SetBE16(temp_data.get() + 2, static_cast<uint16_t>(new_adjusted_len));
+    rtc::SetBE16(header + 2, static_cast<uint16_t>(new_adjusted_len));
   }
 
+  std::unique_ptr<rtc::MessageDigest> digest(
+      rtc::MessageDigestFactory::Create(rtc::DIGEST_SHA_1));
+  if (!digest)
+    return false;
   char hmac[kStunMessageIntegritySize];
-  size_t ret = rtc::ComputeHmac(rtc::DIGEST_SHA_1,
-                                      password.c_str(), password.size(),
-                                      temp_data.get(), mi_pos,
-                                      hmac, sizeof(hmac));
+  size_t ret = rtc::ComputeHmac(digest.get(), password.c_str(),
+                                password.size(), header, kStunHeaderSize,
+                                data + kStunHeaderSize,
+                                mi_pos - kStunHeaderSize, hmac, sizeof(hmac));
   RTC_DCHECK(ret == sizeof(hmac));
   if (ret != sizeof(hmac))
     return false;
@@ -331,7 +335,10 @@ bool StunMessage::Read(ByteBufferReader* buf) {
   if (length_ != buf->Length())
     return false;
 
-  attrs_->resize(0);
+  attrs_.clear();
+  // Enough for a typical connectivity check, so that the vector doesn't
+  // grow while the attributes are read.
+  attrs_.reserve(kTypicalAttributeCount);
 
   size_t rest = buf->Length() - length_;
   while (buf->Length() > rest) {
@@ -353,8 +360,7 @@ bool StunMessage::Read(ByteBufferReader* buf) {
     } else {
       if (!attr->Read(buf))
         return false;
-      // TODO(honghaiz): Change |attrs_| to be a vector of unique_ptrs.
-      attrs_->push_back(attr.release());
+      attrs_.push_back(std::move(attr));
     }
   }
 
@@ -369,10 +375,10 @@ bool StunMessage::Write(ByteBufferWriter* buf) const {
     buf->WriteUInt32(kStunMagicCookie);
   buf->WriteString(transaction_id_);
 
-  for (size_t i = 0; i < attrs_->size(); ++i) {
-    buf->WriteUInt16((*attrs_)[i]->type());
-    buf->WriteUInt16(static_cast<uint16_t>((*attrs_)[i]->length()));
-    if (!(*attrs_)[i]->Write(buf))
+  for (const auto& attr : attrs_) {
+    buf->WriteUInt16(attr->type());
+    buf->WriteUInt16(static_cast<uint16_t>(attr->length()));
+    if (!attr->Write(buf))
       return false;
   }
 
@@ -405,9 +411,9 @@ StunAttribute* StunMessage::CreateAttribute(int type, size_t length) /*const*/ {
 }
 
 const StunAttribute* StunMessage::GetAttribute(int type) const {
-  for (size_t i = 0; i < attrs_->size(); ++i) {
-    if ((*attrs_)[i]->type() == type)
-      return (*attrs_)[i];
+  for (const auto& attr : attrs_) {
+    if (attr->type() == type)
+      return attr.get();
   }
   return NULL;
 }
@@ -718,7 +724,8 @@ StunByteStringAttribute::StunByteStringAttribute(uint16_t type, uint16_t length)
 }
 
 StunByteStringAttribute::~StunByteStringAttribute() {
-  delete [] bytes_;
+  if (bytes_ != inline_bytes_)
+    delete [] bytes_;
 }
 
 void StunByteStringAttribute::CopyBytes(const char* bytes) {
@@ -726,9 +733,14 @@ void StunByteStringAttribute::CopyBytes(const char* bytes) {
 }
 
 void StunByteStringAttribute::CopyBytes(const void* bytes, size_t length) {
-  char* new_bytes = new char[length];
-  memcpy(new_bytes, bytes, length);
-  SetBytes(new_bytes, length);
+  if (bytes_ && bytes >= bytes_ && bytes < bytes_ + this->length()) {
+    // Copying part of the current value; take a copy first, since resizing
+    // may release it.
+    std::string copy(static_cast<const char*>(bytes), length);
+    memcpy(ResizeBytes(length), copy.data(), length);
+    return;
+  }
+  memcpy(ResizeBytes(length), bytes, length);
 }
 
 uint8_t StunByteStringAttribute::GetByte(size_t index) const {
@@ -744,8 +756,7 @@ void StunByteStringAttribute::SetByte(size_t index, uint8_t value) {
 }
 
 bool StunByteStringAttribute::Read(ByteBufferReader* buf) {
-  bytes_ = new char[length()];
-  if (!buf->ReadBytes(bytes_, length())) {
+  if (!buf->ReadBytes(ResizeBytes(length()), length())) {
     return false;
   }
 
@@ -759,10 +770,12 @@ bool StunByteStringAttribute::Write(ByteBufferWriter* buf) const {
   return true;
 }
 
-void StunByteStringAttribute::SetBytes(char* bytes, size_t length) {
-  delete [] bytes_;
-  bytes_ = bytes;
+char* StunByteStringAttribute::ResizeBytes(size_t length) {
+  if (bytes_ != inline_bytes_)
+    delete [] bytes_;
+  bytes_ = (length <= kInlineSize) ? inline_bytes_ : new char[length];
   SetLength(static_cast<uint16_t>(length));
+  return bytes_;
 }
 
 StunErrorCodeAttribute::StunErrorCodeAttribute(uint16_t type,
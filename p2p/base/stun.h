@@ -14,6 +14,7 @@
 // This file contains classes for dealing with the STUN protocol, as specified
 // in RFC 5389, and its descendants.
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -201,7 +202,7 @@ class StunMessage {
   uint16_t type_;
   uint16_t length_;
   std::string transaction_id_;
-  std::vector<StunAttribute*>* attrs_;
+  std::vector<std::unique_ptr<StunAttribute>> attrs_;
 };
 
 // Base class for all STUN/TURN attributes.
@@ -405,9 +406,16 @@ class StunByteStringAttribute : public StunAttribute {
   virtual bool Write(rtc::ByteBufferWriter* buf) const;
 
  private:
-  void SetBytes(char* bytes, size_t length);
+  // Values up to this size, which covers MESSAGE-INTEGRITY and typical ICE
+  // usernames, are stored in |inline_bytes_| instead of on the heap.
+  static const size_t kInlineSize = 32;
+
+  // Returns storage for |length| bytes and makes it the value. The previous
+  // value is released.
+  char* ResizeBytes(size_t length);
 
   char* bytes_;
+  char inline_bytes_[kInlineSize];
 };
 
 // Implements STUN attributes that record an error code.
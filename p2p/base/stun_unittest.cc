@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <memory>
 #include <string>
 
 #include "webrtc/p2p/base/stun.h"
@@ -1016,6 +1017,22 @@ TEST_F(StunTest, ReadPaddedByteStringAttribute) {
   EXPECT_EQ(kTestUserName2, username->GetString());
 }
 
+// Short byte strings are stored inline, longer ones on the heap; check that
+// switching between the two and copying from itself keeps the contents.
+TEST_F(StunTest, ResizeByteStringAttribute) {
+  std::unique_ptr<StunByteStringAttribute> bytes(
+      StunAttribute::CreateByteString(STUN_ATTR_USERNAME));
+  bytes->CopyBytes("short");
+  EXPECT_EQ("short", bytes->GetString());
+  const std::string long_string(100, 'x');
+  bytes->CopyBytes(long_string.c_str());
+  EXPECT_EQ(long_string, bytes->GetString());
+  bytes->CopyBytes(bytes->bytes() + 90, 10);
+  EXPECT_EQ(std::string(10, 'x'), bytes->GetString());
+  bytes->CopyBytes(bytes->bytes() + 5, 5);
+  EXPECT_EQ(std::string(5, 'x'), bytes->GetString());
+}
+
 TEST_F(StunTest, ReadErrorCodeAttribute) {
   StunMessage msg;
   size_t size = ReadStunMessage(&msg, kStunMessageWithErrorAttribute);
@@ -89,6 +89,11 @@ class StunBindingRequest : public StunRequest {
     LOG(LS_ERROR) << "Binding request timed out from "
                   << port_->GetLocalAddress().ToSensitiveString() << " ("
                   << port_->Network()->name() << ")";
+    // A cached address of the server may be stale.
+    if (port_->server_address_cache_) {
+      port_->server_address_cache_->Remove(port_->Network()->key(),
+                                           server_addr_);
+    }
 
     port_->OnStunBindingOrResolveRequestFailed(server_addr_);
   }
@@ -358,8 +363,11 @@ void UDPPort::SendStunBindingRequests() {
   // open until the deadline (specified in SendStunBindingRequest).
   RTC_DCHECK(requests_.empty());
 
-  for (ServerAddresses::const_iterator it = server_addresses_.begin();
-       it != server_addresses_.end(); ++it) {
+  // Iterate over a copy, since servers whose cached address is used are
+  // replaced in |server_addresses_|.
+  ServerAddresses servers = server_addresses_;
+  for (ServerAddresses::const_iterator it = servers.begin();
+       it != servers.end(); ++it) {
     SendStunBindingRequest(*it);
   }
 }
@@ -388,6 +396,9 @@ void UDPPort::OnResolveResult(const rtc::SocketAddress& input,
     return;
   }
 
+  if (server_address_cache_)
+    server_address_cache_->Store(Network()->key(), resolved);
+
   server_addresses_.erase(input);
 
   if (server_addresses_.find(resolved) == server_addresses_.end()) {
@@ -397,7 +408,18 @@ void UDPPort::OnResolveResult(const rtc::SocketAddress& input,
 }
 
 void UDPPort::SendStunBindingRequest(const rtc::SocketAddress& stun_addr) {
-  if (stun_addr.IsUnresolvedIP()) {
+  rtc::SocketAddress cached;
+  if (stun_addr.IsUnresolvedIP() && server_address_cache_ &&
+      server_address_cache_->Lookup(Network()->key(), stun_addr,
+                                    ip().family(), &cached)) {
+    LOG_J(LS_INFO, this) << "Using cached address of STUN server "
+                         << stun_addr.ToSensitiveString();
+    server_addresses_.erase(stun_addr);
+    if (server_addresses_.find(cached) == server_addresses_.end()) {
+      server_addresses_.insert(cached);
+      SendStunBindingRequest(cached);
+    }
+  } else if (stun_addr.IsUnresolvedIP()) {
     ResolveStunAddress(stun_addr);
 
   } else if (socket_->GetState() == rtc::AsyncPacketSocket::STATE_BOUND) {
@@ -15,6 +15,7 @@
 #include <string>
 
 #include "webrtc/p2p/base/port.h"
+#include "webrtc/p2p/base/serveraddresscache.h"
 #include "webrtc/p2p/base/stunrequest.h"
 #include "webrtc/base/asyncpacketsocket.h"
 
@@ -113,6 +114,12 @@ class UDPPort : public Port {
     return stun_keepalive_delay_;
   }
 
+  // If set, STUN server hostnames that |cache| knows the address of aren't
+  // looked up again, and the addresses looked up are stored in |cache|.
+  void set_server_address_cache(ServerAddressCache* cache) {
+    server_address_cache_ = cache;
+  }
+
   // Visible for testing.
   int stun_keepalive_lifetime() const { return stun_keepalive_lifetime_; }
   void set_stun_keepalive_lifetime(int lifetime) {
@@ -246,6 +253,7 @@ class UDPPort : public Port {
   bool ready_;
   int stun_keepalive_delay_;
   int stun_keepalive_lifetime_ = INFINITE_LIFETIME;
+  ServerAddressCache* server_address_cache_ = nullptr;
 
   // This is true by default and false when
   // PORTALLOCATOR_DISABLE_DEFAULT_LOCAL_CANDIDATE is specified.
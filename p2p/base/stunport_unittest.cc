@@ -221,6 +221,35 @@ TEST_F(StunPortTest, TestPrepareAddressHostname) {
   EXPECT_EQ(kStunCandidatePriority, port()->Candidates()[0].priority());
 }
 
+// Test that the address a STUN server hostname resolves to is stored in the
+// server address cache.
+TEST_F(StunPortTest, TestPrepareAddressHostnameStoresAddressInCache) {
+  cricket::ServerAddressCache cache;
+  CreateStunPort(kStunHostnameAddr);
+  port()->set_server_address_cache(&cache);
+  PrepareAddress();
+  EXPECT_TRUE_WAIT(done(), kTimeoutMs);
+  ASSERT_EQ(1U, port()->Candidates().size());
+  EXPECT_EQ(1U, cache.size());
+}
+
+// Test that a STUN server hostname with a cached address isn't looked up.
+TEST_F(StunPortTest, TestPrepareAddressHostnameUsesCachedAddress) {
+  cricket::ServerAddressCache cache;
+  // This hostname can't be resolved, so only the cache can provide the
+  // address of the server.
+  CreateStunPort(kBadHostnameAddr);
+  SocketAddress cached_addr(kBadHostnameAddr);
+  cached_addr.SetResolvedIP(kStunAddr1.ipaddr());
+  cache.Store(port()->Network()->key(), cached_addr);
+  port()->set_server_address_cache(&cache);
+  PrepareAddress();
+  EXPECT_TRUE_WAIT(done(), kTimeoutMs);
+  EXPECT_FALSE(error());
+  ASSERT_EQ(1U, port()->Candidates().size());
+  EXPECT_TRUE(kLocalAddr.EqualIPs(port()->Candidates()[0].address()));
+}
+
 // Test that we handle hostname lookup failures properly.
 TEST_F(StunPortTest, TestPrepareAddressHostnameFail) {
   CreateStunPort(kBadHostnameAddr);
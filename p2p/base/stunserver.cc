@@ -10,11 +10,16 @@
 
 #include "webrtc/p2p/base/stunserver.h"
 
+#include <string.h>
+
+#include "webrtc/base/byteorder.h"
 #include "webrtc/base/bytebuffer.h"
 #include "webrtc/base/logging.h"
 
 namespace cricket {
 
+const size_t StunServer::kMaxBindingResponseSize;
+
 StunServer::StunServer(rtc::AsyncUDPSocket* socket) : socket_(socket) {
   socket_->SignalReadPacket.connect(this, &StunServer::OnPacket);
 }
@@ -27,6 +32,16 @@ void StunServer::OnPacket(
     rtc::AsyncPacketSocket* socket, const char* buf, size_t size,
     const rtc::SocketAddress& remote_addr,
     const rtc::PacketTime& packet_time) {
+  char response[kMaxBindingResponseSize];
+  size_t response_size = WriteBindingResponse(
+      buf, size, GetMappedAddress(remote_addr), response);
+  if (response_size > 0) {
+    rtc::PacketOptions options;
+    if (socket_->SendTo(response, response_size, remote_addr, options) < 0)
+      LOG_ERR(LS_ERROR) << "sendto";
+    return;
+  }
+
   // Parse the STUN message; eat any messages that fail to parse.
   rtc::ByteBufferReader bbuf(buf, size);
   StunMessage msg;
@@ -51,10 +66,77 @@ void StunServer::OnPacket(
 void StunServer::OnBindingRequest(
     StunMessage* msg, const rtc::SocketAddress& remote_addr) {
   StunMessage response;
-  GetStunBindReqponse(msg, remote_addr, &response);
+  GetStunBindReqponse(msg, GetMappedAddress(remote_addr), &response);
   SendResponse(response, remote_addr);
 }
 
+rtc::SocketAddress StunServer::GetMappedAddress(
+    const rtc::SocketAddress& remote_addr) const {
+  return remote_addr;
+}
+
+size_t StunServer::WriteBindingResponse(const char* request,
+                                        size_t size,
+                                        const rtc::SocketAddress& mapped_addr,
+                                        char* response) {
+  // Legacy RFC 3489 requests, which lack the magic cookie, are left to the
+  // regular path.
+  if (size < kStunHeaderSize ||
+      rtc::GetBE16(request) != STUN_BINDING_REQUEST ||
+      rtc::GetBE16(request + 2) != size - kStunHeaderSize ||
+      rtc::GetBE32(request + 4) != kStunMagicCookie) {
+    return 0;
+  }
+  // None of the attributes matter for the response, but like
+  // StunMessage::Read() drop requests whose attributes overrun the message.
+  size_t offset = kStunHeaderSize;
+  while (offset < size) {
+    if (size - offset < 4)
+      return 0;
+    size_t attr_length = rtc::GetBE16(request + offset + 2);
+    attr_length = (attr_length + 3) & ~static_cast<size_t>(3);
+    if (attr_length > size - offset - 4)
+      return 0;
+    offset += 4 + attr_length;
+  }
+
+  uint8_t family;
+  uint16_t attr_length;
+  switch (mapped_addr.family()) {
+    case AF_INET:
+      family = STUN_ADDRESS_IPV4;
+      attr_length = StunAddressAttribute::SIZE_IP4;
+      break;
+    case AF_INET6:
+      family = STUN_ADDRESS_IPV6;
+      attr_length = StunAddressAttribute::SIZE_IP6;
+      break;
+    default:
+      return 0;
+  }
+
+  // Same layout as the StunMessage built by GetStunBindReqponse(): the header
+  // with the request's magic cookie and transaction ID, then MAPPED-ADDRESS.
+  rtc::SetBE16(response, STUN_BINDING_RESPONSE);
+  rtc::SetBE16(response + 2, static_cast<uint16_t>(4 + attr_length));
+  memcpy(response + 4, request + 4,
+         kStunMagicCookieLength + kStunTransactionIdLength);
+  char* attr = response + kStunHeaderSize;
+  rtc::SetBE16(attr, STUN_ATTR_MAPPED_ADDRESS);
+  rtc::SetBE16(attr + 2, attr_length);
+  rtc::Set8(attr, 4, 0);
+  rtc::Set8(attr, 5, family);
+  rtc::SetBE16(attr + 6, mapped_addr.port());
+  if (family == STUN_ADDRESS_IPV4) {
+    in_addr v4addr = mapped_addr.ipaddr().ipv4_address();
+    memcpy(attr + 8, &v4addr, sizeof(v4addr));
+  } else {
+    in6_addr v6addr = mapped_addr.ipaddr().ipv6_address();
+    memcpy(attr + 8, &v6addr, sizeof(v6addr));
+  }
+  return kStunHeaderSize + 4 + attr_length;
+}
+
 void StunServer::SendErrorResponse(
     const StunMessage& msg, const rtc::SocketAddress& addr,
     int error_code, const char* error_desc) {
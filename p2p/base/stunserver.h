@@ -20,14 +20,40 @@ namespace cricket {
 
 const int STUN_SERVER_PORT = 3478;
 
+// Answers STUN binding requests on a UDP socket. RFC 5389 binding requests,
+// by far the most common message, are answered by WriteBindingResponse()
+// without parsing them into a StunMessage, so that a request costs no heap
+// allocation. Other messages take the regular path through OnPacket().
+//
+// A StunServer runs on the thread of its socket. To receive on several
+// threads, run one StunServer per thread, each with its own socket bound to
+// the same address with rtc::Socket::OPT_REUSEPORT set before binding.
 class StunServer : public sigslot::has_slots<> {
  public:
+  // Size of the largest response written by WriteBindingResponse().
+  static const size_t kMaxBindingResponseSize = kStunHeaderSize + 4 +
+                                                StunAddressAttribute::SIZE_IP6;
+
   // Creates a STUN server, which will listen on the given socket.
   explicit StunServer(rtc::AsyncUDPSocket* socket);
   // Removes the STUN server from the socket and deletes the socket.
   ~StunServer();
 
+  // Writes the response to |request| reporting |mapped_addr| to |response|,
+  // which must hold kMaxBindingResponseSize bytes, and returns its size.
+  // Returns 0 if |request| is not a well-formed RFC 5389 binding request;
+  // the attributes of the request are skipped but not validated further.
+  static size_t WriteBindingResponse(const char* request,
+                                     size_t size,
+                                     const rtc::SocketAddress& mapped_addr,
+                                     char* response);
+
  protected:
+  // Returns the address reported to the client that sent a binding request
+  // from |remote_addr|.
+  virtual rtc::SocketAddress GetMappedAddress(
+      const rtc::SocketAddress& remote_addr) const;
+
   // Slot for AsyncSocket.PacketRead:
   void OnPacket(
       rtc::AsyncPacketSocket* socket, const char* buf, size_t size,
@@ -35,8 +61,7 @@ class StunServer : public sigslot::has_slots<> {
       const rtc::PacketTime& packet_time);
 
   // Handlers for the different types of STUN/TURN requests:
-  virtual void OnBindingRequest(StunMessage* msg,
-      const rtc::SocketAddress& addr);
+  void OnBindingRequest(StunMessage* msg, const rtc::SocketAddress& addr);
   void OnAllocateRequest(StunMessage* msg,
       const rtc::SocketAddress& addr);
   void OnSharedSecretRequest(StunMessage* msg,
@@ -8,15 +8,18 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <memory>
 #include <string>
 
 #include "webrtc/p2p/base/stunserver.h"
+#include "webrtc/base/byteorder.h"
 #include "webrtc/base/gunit.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/base/physicalsocketserver.h"
 #include "webrtc/base/testclient.h"
 #include "webrtc/base/thread.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/base/virtualsocketserver.h"
 
 using namespace cricket;
@@ -111,3 +114,116 @@ TEST_F(StunServerTest, TestBad) {
 
   ASSERT_TRUE(ReceiveFails());
 }
+
+namespace {
+
+std::string WriteMessage(const StunMessage& msg) {
+  rtc::ByteBufferWriter buf;
+  msg.Write(&buf);
+  return std::string(buf.Data(), buf.Length());
+}
+
+// Builds the response the regular path sends for a binding request.
+std::string RegularBindingResponse(const StunMessage& request,
+                                   const rtc::SocketAddress& mapped_addr) {
+  StunMessage response;
+  response.SetType(STUN_BINDING_RESPONSE);
+  response.SetTransactionID(request.transaction_id());
+  StunAddressAttribute* attr =
+      StunAttribute::CreateAddress(STUN_ATTR_MAPPED_ADDRESS);
+  attr->SetAddress(mapped_addr);
+  response.AddAttribute(attr);
+  return WriteMessage(response);
+}
+
+std::string FastBindingResponse(const std::string& request,
+                                const rtc::SocketAddress& mapped_addr) {
+  char response[StunServer::kMaxBindingResponseSize];
+  size_t size = StunServer::WriteBindingResponse(
+      request.data(), request.size(), mapped_addr, response);
+  return std::string(response, size);
+}
+
+void InitBindingRequest(StunMessage* request) {
+  request->SetType(STUN_BINDING_REQUEST);
+  request->SetTransactionID("0123456789ab");
+  request->AddAttribute(
+      new StunByteStringAttribute(STUN_ATTR_SOFTWARE, "test client"));
+}
+
+}  // namespace
+
+TEST(StunServerBindingResponseTest, MatchesRegularResponse) {
+  StunMessage request;
+  InitBindingRequest(&request);
+  std::string request_data = WriteMessage(request);
+  const rtc::SocketAddress kAddresses[] = {
+      rtc::SocketAddress("1.2.3.4", 1234),
+      rtc::SocketAddress("2001:db8::1", 5678)};
+  for (const rtc::SocketAddress& addr : kAddresses) {
+    EXPECT_EQ(RegularBindingResponse(request, addr),
+              FastBindingResponse(request_data, addr));
+  }
+}
+
+TEST(StunServerBindingResponseTest, LeavesOtherMessagesToRegularPath) {
+  const rtc::SocketAddress kAddress("1.2.3.4", 1234);
+  StunMessage request;
+  InitBindingRequest(&request);
+  std::string request_data = WriteMessage(request);
+
+  // Truncated attribute.
+  std::string truncated = request_data.substr(0, request_data.size() - 4);
+  rtc::SetBE16(&truncated[2],
+               static_cast<uint16_t>(truncated.size() - kStunHeaderSize));
+  EXPECT_EQ("", FastBindingResponse(truncated, kAddress));
+
+  // Length field not matching the size.
+  EXPECT_EQ("", FastBindingResponse(request_data + "1234", kAddress));
+
+  // Not a binding request.
+  StunMessage allocate;
+  allocate.SetType(STUN_ALLOCATE_REQUEST);
+  allocate.SetTransactionID("0123456789ab");
+  EXPECT_EQ("", FastBindingResponse(WriteMessage(allocate), kAddress));
+
+  // RFC 3489 request without magic cookie.
+  StunMessage legacy;
+  legacy.SetType(STUN_BINDING_REQUEST);
+  legacy.SetTransactionID("0123456789abcdef");
+  EXPECT_EQ("", FastBindingResponse(WriteMessage(legacy), kAddress));
+}
+
+// Compares the cost of answering a binding request with and without parsing
+// it into a StunMessage. Disabled since it only logs the results.
+TEST(StunServerBindingResponseTest, DISABLED_BindingResponseBenchmark) {
+  const int kNumRequests = 1000000;
+  const rtc::SocketAddress kAddress("1.2.3.4", 1234);
+  StunMessage request;
+  InitBindingRequest(&request);
+  std::string request_data = WriteMessage(request);
+
+  int64_t start_us = rtc::TimeMicros();
+  size_t total_size = 0;
+  for (int i = 0; i < kNumRequests; ++i) {
+    rtc::ByteBufferReader buf(request_data.data(), request_data.size());
+    StunMessage msg;
+    ASSERT_TRUE(msg.Read(&buf));
+    total_size += RegularBindingResponse(msg, kAddress).size();
+  }
+  int64_t regular_us = rtc::TimeMicros() - start_us;
+
+  start_us = rtc::TimeMicros();
+  char response[StunServer::kMaxBindingResponseSize];
+  for (int i = 0; i < kNumRequests; ++i) {
+    total_size += StunServer::WriteBindingResponse(
+        request_data.data(), request_data.size(), kAddress, response);
+  }
+  int64_t fast_us = rtc::TimeMicros() - start_us;
+
+  EXPECT_GT(total_size, 0u);
+  LOG(LS_INFO) << "Binding responses per second: regular "
+               << kNumRequests * 1000000LL / std::max<int64_t>(regular_us, 1)
+               << ", without parsing "
+               << kNumRequests * 1000000LL / std::max<int64_t>(fast_us, 1);
+}
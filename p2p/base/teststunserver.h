@@ -38,15 +38,9 @@ class TestStunServer : StunServer {
  private:
   explicit TestStunServer(rtc::AsyncUDPSocket* socket) : StunServer(socket) {}
 
-  void OnBindingRequest(StunMessage* msg,
-                        const rtc::SocketAddress& remote_addr) override {
-    if (fake_stun_addr_.IsNil()) {
-      StunServer::OnBindingRequest(msg, remote_addr);
-    } else {
-      StunMessage response;
-      GetStunBindReqponse(msg, fake_stun_addr_, &response);
-      SendResponse(response, remote_addr);
-    }
+  rtc::SocketAddress GetMappedAddress(
+      const rtc::SocketAddress& remote_addr) const override {
+    return fake_stun_addr_.IsNil() ? remote_addr : fake_stun_addr_;
   }
 
  private:
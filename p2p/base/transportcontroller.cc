@@ -355,6 +355,7 @@ TransportChannelImpl* TransportController::CreateDtlsTransportChannel_n(
     IceTransportInternal* ice) {
   DtlsTransportChannelWrapper* dtls = new DtlsTransportChannelWrapper(ice);
   dtls->SetSslMaxProtocolVersion(ssl_max_version_);
+  dtls->SetSslSessionCache(ssl_session_cache_);
   return dtls;
 }
 
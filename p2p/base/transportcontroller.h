@@ -63,6 +63,12 @@ class TransportController : public sigslot::has_slots<>,
   // and WebRtcSession are combined
   bool SetSslMaxProtocolVersion(rtc::SSLProtocolVersion version);
 
+  // Lets DTLS resume sessions from |cache|, which must outlive the
+  // controller. Can only be set before transports are created.
+  void SetSslSessionCache(rtc::SSLSessionCache* cache) {
+    ssl_session_cache_ = cache;
+  }
+
   void SetIceConfig(const IceConfig& config);
   void SetIceRole(IceRole ice_role);
 
@@ -261,6 +267,7 @@ class TransportController : public sigslot::has_slots<>,
   bool redetermine_role_on_ice_restart_;
   uint64_t ice_tiebreaker_ = rtc::CreateRandomId64();
   rtc::SSLProtocolVersion ssl_max_version_ = rtc::SSL_PROTOCOL_DTLS_12;
+  rtc::SSLSessionCache* ssl_session_cache_ = nullptr;
   rtc::scoped_refptr<rtc::RTCCertificate> certificate_;
   rtc::AsyncInvoker invoker_;
   // True if QUIC is used instead of DTLS.
@@ -286,6 +286,17 @@ void TurnPort::PrepareAddress() {
     server_address_.address.SetPort(TURN_DEFAULT_PORT);
   }
 
+  rtc::SocketAddress cached_address;
+  if (server_address_.address.IsUnresolvedIP() && server_address_cache_ &&
+      server_address_cache_->Lookup(Network()->key(), server_address_.address,
+                                    ip().family(), &cached_address)) {
+    LOG_J(LS_INFO, this) << "Using cached address of TURN server "
+                         << server_address_.address.ToSensitiveString();
+    SignalResolvedServerAddress(this, server_address_.address,
+                                cached_address);
+    server_address_.address = cached_address;
+  }
+
   if (server_address_.address.IsUnresolvedIP()) {
     ResolveTurnAddress(server_address_.address);
   } else {
@@ -706,6 +717,8 @@ void TurnPort::OnResolveResult(rtc::AsyncResolverInterface* resolver) {
   }
   // Signal needs both resolved and unresolved address. After signal is sent
   // we can copy resolved address back into |server_address_|.
+  if (server_address_cache_)
+    server_address_cache_->Store(Network()->key(), resolved_address);
   SignalResolvedServerAddress(this, server_address_.address,
                               resolved_address);
   server_address_.address = resolved_address;
@@ -818,6 +831,9 @@ void TurnPort::OnMessage(rtc::Message* message) {
 }
 
 void TurnPort::OnAllocateRequestTimeout() {
+  // A cached address of the server may be stale.
+  if (server_address_cache_)
+    server_address_cache_->Remove(Network()->key(), server_address_.address);
   OnAllocateError();
 }
 
@@ -19,6 +19,7 @@
 #include "webrtc/base/asyncinvoker.h"
 #include "webrtc/base/asyncpacketsocket.h"
 #include "webrtc/p2p/base/port.h"
+#include "webrtc/p2p/base/serveraddresscache.h"
 #include "webrtc/p2p/client/basicportallocator.h"
 
 namespace rtc {
@@ -93,6 +94,12 @@ class TurnPort : public Port {
     tls_cert_policy_ = tls_cert_policy;
   }
 
+  // If set, a server hostname that |cache| knows the address of isn't looked
+  // up again, and the address looked up is stored in |cache|.
+  void set_server_address_cache(ServerAddressCache* cache) {
+    server_address_cache_ = cache;
+  }
+
   virtual void PrepareAddress();
   virtual Connection* CreateConnection(
       const Candidate& c, PortInterface::CandidateOrigin origin);
@@ -262,6 +269,7 @@ class TurnPort : public Port {
 
   ProtocolAddress server_address_;
   TlsCertPolicy tls_cert_policy_ = TlsCertPolicy::TLS_CERT_POLICY_SECURE;
+  ServerAddressCache* server_address_cache_ = nullptr;
   RelayCredentials credentials_;
   AttemptedServerSet attempted_server_addresses_;
 
@@ -10,6 +10,8 @@
 
 #include "webrtc/p2p/base/turnserver.h"
 
+#include <string.h>
+
 #include <tuple>  // for std::tie
 
 #include "webrtc/p2p/base/asyncstuntcpsocket.h"
@@ -501,8 +503,14 @@ void TurnServer::SendStun(TurnServerConnection* conn, StunMessage* msg) {
 
 void TurnServer::Send(TurnServerConnection* conn,
                       const rtc::ByteBufferWriter& buf) {
+  Send(conn, buf.Data(), buf.Length());
+}
+
+void TurnServer::Send(TurnServerConnection* conn,
+                      const char* data,
+                      size_t size) {
   rtc::PacketOptions options;
-  conn->socket()->SendTo(buf.Data(), buf.Length(), conn->src(), options);
+  conn->socket()->SendTo(data, size, conn->src(), options);
 }
 
 void TurnServer::OnAllocationDestroyed(TurnServerAllocation* allocation) {
@@ -560,6 +568,10 @@ bool TurnServerConnection::operator<(const TurnServerConnection& c) const {
   return std::tie(src_, dst_, proto_) < std::tie(c.src_, c.dst_, c.proto_);
 }
 
+size_t TurnServerConnection::Hash() const {
+  return src_.Hash() ^ (dst_.Hash() << 1) ^ static_cast<size_t>(proto_);
+}
+
 std::string TurnServerConnection::ToString() const {
   const char* const kProtos[] = {
       "unknown", "udp", "tcp", "ssltcp"
@@ -584,13 +596,13 @@ TurnServerAllocation::TurnServerAllocation(TurnServer* server,
 }
 
 TurnServerAllocation::~TurnServerAllocation() {
-  for (ChannelList::iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    delete *it;
+  for (ChannelIdMap::iterator it = channels_by_id_.begin();
+       it != channels_by_id_.end(); ++it) {
+    delete it->second;
   }
-  for (PermissionList::iterator it = perms_.begin();
+  for (PermissionMap::iterator it = perms_.begin();
        it != perms_.end(); ++it) {
-    delete *it;
+    delete it->second;
   }
   thread_->Clear(this, MSG_ALLOCATION_TIMEOUT);
   LOG_J(LS_INFO, this) << "Allocation destroyed";
@@ -767,7 +779,8 @@ void TurnServerAllocation::HandleChannelBindRequest(const TurnMessage* msg) {
     channel1 = new Channel(thread_, channel_id, peer_attr->GetAddress());
     channel1->SignalDestroyed.connect(this,
         &TurnServerAllocation::OnChannelDestroyed);
-    channels_.push_back(channel1);
+    channels_by_id_[channel_id] = channel1;
+    channels_by_addr_[channel1->peer()] = channel1;
   } else {
     channel1->Refresh();
   }
@@ -787,11 +800,17 @@ void TurnServerAllocation::HandleChannelBindRequest(const TurnMessage* msg) {
 void TurnServerAllocation::HandleChannelData(const char* data, size_t size) {
   // Extract the channel number from the data.
   uint16_t channel_id = rtc::GetBE16(data);
+  // The length excludes the padding added over stream transports.
+  size_t length = rtc::GetBE16(data + 2);
+  if (length > size - TURN_CHANNEL_HEADER_SIZE) {
+    LOG_J(LS_WARNING, this) << "Received truncated channel data, id="
+                            << channel_id;
+    return;
+  }
   Channel* channel = FindChannel(channel_id);
   if (channel) {
-    // Send the data to the peer address.
-    SendExternal(data + TURN_CHANNEL_HEADER_SIZE,
-                 size - TURN_CHANNEL_HEADER_SIZE, channel->peer());
+    // Send the data to the peer address, straight from the receive buffer.
+    SendExternal(data + TURN_CHANNEL_HEADER_SIZE, length, channel->peer());
   } else {
     LOG_J(LS_WARNING, this) << "Received channel data for invalid channel, id="
                             << channel_id;
@@ -807,11 +826,19 @@ void TurnServerAllocation::OnExternalPacket(
   Channel* channel = FindChannel(addr);
   if (channel) {
     // There is a channel bound to this address. Send as a channel message.
-    rtc::ByteBufferWriter buf;
-    buf.WriteUInt16(channel->id());
-    buf.WriteUInt16(static_cast<uint16_t>(size));
-    buf.WriteBytes(data, size);
-    server_->Send(&conn_, buf);
+    char* message;
+    if (socket->GetReceiveHeadroom() >= TURN_CHANNEL_HEADER_SIZE) {
+      // Prepend the header in the socket's receive buffer, so that the
+      // payload isn't copied.
+      message = const_cast<char*>(data) - TURN_CHANNEL_HEADER_SIZE;
+    } else {
+      channel_data_buffer_.SetSize(TURN_CHANNEL_HEADER_SIZE + size);
+      message = channel_data_buffer_.data<char>();
+      memcpy(message + TURN_CHANNEL_HEADER_SIZE, data, size);
+    }
+    rtc::SetBE16(message, static_cast<uint16_t>(channel->id()));
+    rtc::SetBE16(message + 2, static_cast<uint16_t>(size));
+    server_->Send(&conn_, message, TURN_CHANNEL_HEADER_SIZE + size);
   } else if (!server_->enable_permission_checks_ ||
              HasPermission(addr.ipaddr())) {
     // No channel, but a permission exists. Send as a data indication.
@@ -850,7 +877,7 @@ void TurnServerAllocation::AddPermission(const rtc::IPAddress& addr) {
     perm = new Permission(thread_, addr);
     perm->SignalDestroyed.connect(
         this, &TurnServerAllocation::OnPermissionDestroyed);
-    perms_.push_back(perm);
+    perms_[addr] = perm;
   } else {
     perm->Refresh();
   }
@@ -858,32 +885,20 @@ void TurnServerAllocation::AddPermission(const rtc::IPAddress& addr) {
 
 TurnServerAllocation::Permission* TurnServerAllocation::FindPermission(
     const rtc::IPAddress& addr) const {
-  for (PermissionList::const_iterator it = perms_.begin();
-       it != perms_.end(); ++it) {
-    if ((*it)->peer() == addr)
-      return *it;
-  }
-  return NULL;
+  PermissionMap::const_iterator it = perms_.find(addr);
+  return (it != perms_.end()) ? it->second : NULL;
 }
 
 TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
     int channel_id) const {
-  for (ChannelList::const_iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    if ((*it)->id() == channel_id)
-      return *it;
-  }
-  return NULL;
+  ChannelIdMap::const_iterator it = channels_by_id_.find(channel_id);
+  return (it != channels_by_id_.end()) ? it->second : NULL;
 }
 
 TurnServerAllocation::Channel* TurnServerAllocation::FindChannel(
     const rtc::SocketAddress& addr) const {
-  for (ChannelList::const_iterator it = channels_.begin();
-       it != channels_.end(); ++it) {
-    if ((*it)->peer() == addr)
-      return *it;
-  }
-  return NULL;
+  ChannelAddressMap::const_iterator it = channels_by_addr_.find(addr);
+  return (it != channels_by_addr_.end()) ? it->second : NULL;
 }
 
 void TurnServerAllocation::SendResponse(TurnMessage* msg) {
@@ -914,16 +929,15 @@ void TurnServerAllocation::OnMessage(rtc::Message* msg) {
 }
 
 void TurnServerAllocation::OnPermissionDestroyed(Permission* perm) {
-  PermissionList::iterator it = std::find(perms_.begin(), perms_.end(), perm);
-  RTC_DCHECK(it != perms_.end());
-  perms_.erase(it);
+  size_t erased = perms_.erase(perm->peer());
+  RTC_DCHECK_EQ(1u, erased);
 }
 
 void TurnServerAllocation::OnChannelDestroyed(Channel* channel) {
-  ChannelList::iterator it =
-      std::find(channels_.begin(), channels_.end(), channel);
-  RTC_DCHECK(it != channels_.end());
-  channels_.erase(it);
+  size_t erased = channels_by_id_.erase(channel->id());
+  RTC_DCHECK_EQ(1u, erased);
+  erased = channels_by_addr_.erase(channel->peer());
+  RTC_DCHECK_EQ(1u, erased);
 }
 
 TurnServerAllocation::Permission::Permission(rtc::Thread* thread,
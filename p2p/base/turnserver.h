@@ -11,16 +11,17 @@
 #ifndef WEBRTC_P2P_BASE_TURNSERVER_H_
 #define WEBRTC_P2P_BASE_TURNSERVER_H_
 
-#include <list>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "webrtc/p2p/base/portinterface.h"
 #include "webrtc/base/asyncinvoker.h"
 #include "webrtc/base/asyncpacketsocket.h"
+#include "webrtc/base/buffer.h"
 #include "webrtc/base/messagequeue.h"
 #include "webrtc/base/sigslot.h"
 #include "webrtc/base/socketaddress.h"
@@ -51,8 +52,13 @@ class TurnServerConnection {
   rtc::AsyncPacketSocket* socket() { return socket_; }
   bool operator==(const TurnServerConnection& t) const;
   bool operator<(const TurnServerConnection& t) const;
+  size_t Hash() const;
   std::string ToString() const;
 
+  struct Hasher {
+    size_t operator()(const TurnServerConnection& c) const { return c.Hash(); }
+  };
+
  private:
   rtc::SocketAddress src_;
   rtc::SocketAddress dst_;
@@ -93,8 +99,23 @@ class TurnServerAllocation : public rtc::MessageHandler,
  private:
   class Channel;
   class Permission;
-  typedef std::list<Permission*> PermissionList;
-  typedef std::list<Channel*> ChannelList;
+  struct IPAddressHasher {
+    size_t operator()(const rtc::IPAddress& ip) const {
+      return rtc::HashIP(ip);
+    }
+  };
+  struct SocketAddressHasher {
+    size_t operator()(const rtc::SocketAddress& addr) const {
+      return addr.Hash();
+    }
+  };
+  // Permissions and channels are looked up for every relayed packet, so they
+  // are indexed by hash rather than searched.
+  typedef std::unordered_map<rtc::IPAddress, Permission*, IPAddressHasher>
+      PermissionMap;
+  typedef std::unordered_map<int, Channel*> ChannelIdMap;
+  typedef std::unordered_map<rtc::SocketAddress, Channel*, SocketAddressHasher>
+      ChannelAddressMap;
 
   void HandleAllocateRequest(const TurnMessage* msg);
   void HandleRefreshRequest(const TurnMessage* msg);
@@ -134,8 +155,12 @@ class TurnServerAllocation : public rtc::MessageHandler,
   std::string username_;
   std::string origin_;
   std::string last_nonce_;
-  PermissionList perms_;
-  ChannelList channels_;
+  PermissionMap perms_;
+  ChannelIdMap channels_by_id_;
+  ChannelAddressMap channels_by_addr_;
+  // Reused for the channel data messages relayed to the client if the
+  // external socket has no receive headroom to build them in place.
+  rtc::Buffer channel_data_buffer_;
 };
 
 // An interface through which the MD5 credential hash can be retrieved.
@@ -161,9 +186,18 @@ class TurnRedirectInterface {
 // AddInternalServerSocket, and a factory to create external sockets via
 // SetExternalSocketFactory, and it's ready to go.
 // Not yet wired up: TCP support.
+//
+// A TurnServer runs on a single thread. To spread the load over several
+// threads, run one TurnServer per thread and give each of them its own
+// internal UDP socket bound to the same address with
+// rtc::Socket::OPT_REUSEPORT set before binding. The kernel then hashes the
+// packets of each client 5-tuple to the same socket, so every allocation
+// lives on exactly one of the servers.
 class TurnServer : public sigslot::has_slots<> {
  public:
-  typedef std::map<TurnServerConnection, std::unique_ptr<TurnServerAllocation>>
+  typedef std::unordered_map<TurnServerConnection,
+                             std::unique_ptr<TurnServerAllocation>,
+                             TurnServerConnection::Hasher>
       AllocationMap;
 
   explicit TurnServer(rtc::Thread* thread);
@@ -256,6 +290,7 @@ class TurnServer : public sigslot::has_slots<> {
 
   void SendStun(TurnServerConnection* conn, StunMessage* msg);
   void Send(TurnServerConnection* conn, const rtc::ByteBufferWriter& buf);
+  void Send(TurnServerConnection* conn, const char* data, size_t size);
 
   void OnAllocationDestroyed(TurnServerAllocation* allocation);
   void DestroyInternalSocket(rtc::AsyncPacketSocket* socket);
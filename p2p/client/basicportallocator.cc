@@ -19,6 +19,7 @@
 #include "webrtc/p2p/base/common.h"
 #include "webrtc/p2p/base/port.h"
 #include "webrtc/p2p/base/relayport.h"
+#include "webrtc/p2p/base/serveraddresscache.h"
 #include "webrtc/p2p/base/stunport.h"
 #include "webrtc/p2p/base/tcpport.h"
 #include "webrtc/p2p/base/turnport.h"
@@ -27,6 +28,7 @@
 #include "webrtc/base/common.h"
 #include "webrtc/base/helpers.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/base/timeutils.h"
 
 using rtc::CreateRandomId;
 
@@ -39,6 +41,7 @@ enum {
   MSG_ALLOCATION_PHASE,
   MSG_SEQUENCEOBJECTS_CREATED,
   MSG_CONFIG_STOP,
+  MSG_NETWORKS_CHANGED,
 };
 
 const int PHASE_UDP = 0;
@@ -454,6 +457,10 @@ void BasicPortAllocatorSession::OnMessage(rtc::Message *message) {
     RTC_DCHECK(rtc::Thread::Current() == network_thread_);
     OnConfigStop();
     break;
+  case MSG_NETWORKS_CHANGED:
+    RTC_DCHECK(rtc::Thread::Current() == network_thread_);
+    HandleNetworksChanged();
+    break;
   default:
     RTC_NOTREACHED();
   }
@@ -582,8 +589,9 @@ std::vector<rtc::Network*> BasicPortAllocatorSession::GetNetworks() {
 
 // For each network, see if we have a sequence that covers it already.  If not,
 // create a new sequence to create the appropriate ports.
-void BasicPortAllocatorSession::DoAllocate() {
+bool BasicPortAllocatorSession::DoAllocate() {
   bool done_signal_needed = false;
+  bool sequences_started = false;
   std::vector<rtc::Network*> networks = GetNetworks();
   if (networks.empty()) {
     LOG(LS_WARNING) << "Machine has no networks; no ports will be allocated";
@@ -628,14 +636,39 @@ void BasicPortAllocatorSession::DoAllocate() {
       sequence->Start();
       sequences_.push_back(sequence);
       done_signal_needed = true;
+      sequences_started = true;
     }
   }
   if (done_signal_needed) {
     network_thread_->Post(RTC_FROM_HERE, this, MSG_SEQUENCEOBJECTS_CREATED);
   }
+  return sequences_started;
 }
 
 void BasicPortAllocatorSession::OnNetworksChanged() {
+  int interval = allocator_->network_change_interval_ms();
+  if (interval <= 0 || !network_thread_ || !network_manager_started_) {
+    HandleNetworksChanged();
+    return;
+  }
+  if (network_change_pending_) {
+    // The pending update will pick up this change too.
+    return;
+  }
+  int64_t elapsed = rtc::TimeSince(last_network_change_ms_);
+  if (elapsed >= interval) {
+    HandleNetworksChanged();
+    return;
+  }
+  network_change_pending_ = true;
+  network_thread_->PostDelayed(RTC_FROM_HERE,
+                               static_cast<int>(interval - elapsed), this,
+                               MSG_NETWORKS_CHANGED);
+}
+
+void BasicPortAllocatorSession::HandleNetworksChanged() {
+  last_network_change_ms_ = rtc::TimeMillis();
+  network_change_pending_ = false;
   std::vector<rtc::Network*> networks = GetNetworks();
   std::vector<rtc::Network*> failed_networks;
   for (AllocationSequence* sequence : sequences_) {
@@ -655,12 +688,12 @@ void BasicPortAllocatorSession::OnNetworksChanged() {
     PrunePortsAndRemoveCandidates(ports_to_prune);
   }
 
-  if (allocation_started_ && !IsStopped()) {
-    if (network_manager_started_) {
-      // If the network manager has started, it must be regathering.
-      SignalIceRegathering(this, IceRegatheringReason::NETWORK_CHANGE);
-    }
-    DoAllocate();
+  // Only networks without an equivalent allocation sequence get new ports, so
+  // the sessions that a change doesn't affect don't regather.
+  if (allocation_started_ && !IsStopped() && DoAllocate() &&
+      network_manager_started_) {
+    // If the network manager has started, it must be regathering.
+    SignalIceRegathering(this, IceRegatheringReason::NETWORK_CHANGE);
   }
 
   if (!network_manager_started_) {
@@ -1161,9 +1194,11 @@ void AllocationSequence::OnMessage(rtc::Message* msg) {
 
   if (state() == kRunning) {
     ++phase_;
-    session_->network_thread()->PostDelayed(RTC_FROM_HERE,
-                                            session_->allocator()->step_delay(),
-                                            this, MSG_ALLOCATION_PHASE);
+    int delay = IsFlagSet(PORTALLOCATOR_ENABLE_PARALLEL_PHASES)
+                    ? 0
+                    : session_->allocator()->step_delay();
+    session_->network_thread()->PostDelayed(RTC_FROM_HERE, delay, this,
+                                            MSG_ALLOCATION_PHASE);
   } else {
     // If all phases in AllocationSequence are completed, no allocation
     // steps needed further. Canceling  pending signal.
@@ -1213,6 +1248,8 @@ void AllocationSequence::CreateUDPPorts() {
   }
 
   if (port) {
+    if (IsFlagSet(PORTALLOCATOR_ENABLE_SERVER_ADDRESS_CACHE))
+      port->set_server_address_cache(ServerAddressCache::Instance());
     // If shared socket is enabled, STUN candidate will be allocated by the
     // UDPPort.
     if (IsFlagSet(PORTALLOCATOR_ENABLE_SHARED_SOCKET)) {
@@ -1278,6 +1315,8 @@ void AllocationSequence::CreateStunPorts() {
                                 config_->StunServers(),
                                 session_->allocator()->origin());
   if (port) {
+    if (IsFlagSet(PORTALLOCATOR_ENABLE_SERVER_ADDRESS_CACHE))
+      port->set_server_address_cache(ServerAddressCache::Instance());
     session_->AddAllocatedPort(port, this, true);
     // Since StunPort is not created using shared socket, |port| will not be
     // added to the dequeue.
@@ -1395,6 +1434,8 @@ void AllocationSequence::CreateTurnPort(const RelayServerConfig& config) {
     }
     RTC_DCHECK(port != NULL);
     port->SetTlsCertPolicy(config.tls_cert_policy);
+    if (IsFlagSet(PORTALLOCATOR_ENABLE_SERVER_ADDRESS_CACHE))
+      port->set_server_address_cache(ServerAddressCache::Instance());
     session_->AddAllocatedPort(port, this, true);
   }
 }
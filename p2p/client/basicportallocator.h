@@ -63,6 +63,16 @@ class BasicPortAllocator : public PortAllocator {
   // Convenience method that adds a TURN server to the configuration.
   void AddTurnServer(const RelayServerConfig& turn_server);
 
+  // Each session handles network changes at most once per |interval_ms|. The
+  // changes that arrive in between are coalesced into a single update at the
+  // end of the interval, so that an interface flapping doesn't make every
+  // session regather over and over. 0 (the default) handles every change
+  // right away.
+  void set_network_change_interval_ms(int interval_ms) {
+    network_change_interval_ms_ = interval_ms;
+  }
+  int network_change_interval_ms() const { return network_change_interval_ms_; }
+
  private:
   void Construct();
 
@@ -73,6 +83,7 @@ class BasicPortAllocator : public PortAllocator {
   rtc::PacketSocketFactory* socket_factory_;
   bool allow_tcp_listen_;
   int network_ignore_mask_ = rtc::kDefaultNetworkIgnoreMask;
+  int network_change_interval_ms_ = 0;
 };
 
 struct PortConfiguration;
@@ -185,8 +196,13 @@ class BasicPortAllocatorSession : public PortAllocatorSession,
   void OnConfigStop();
   void AllocatePorts();
   void OnAllocate();
-  void DoAllocate();
+  // Returns true if allocation sequences were started on new networks.
+  bool DoAllocate();
+  // Rate limits network changes as set by the allocator.
   void OnNetworksChanged();
+  // Prunes the ports on networks that are gone and allocates ports on the new
+  // ones.
+  void HandleNetworksChanged();
   void OnAllocationSequenceObjectsCreated();
   void DisableEquivalentPhases(rtc::Network* network,
                                PortConfiguration* config,
@@ -231,6 +247,10 @@ class BasicPortAllocatorSession : public PortAllocatorSession,
   bool allocation_started_;
   bool network_manager_started_;
   bool allocation_sequences_created_;
+  // Time the last network change was handled, and whether one is waiting for
+  // the network change interval to pass.
+  int64_t last_network_change_ms_ = 0;
+  bool network_change_pending_ = false;
   std::vector<PortConfiguration*> configs_;
   std::vector<AllocationSequence*> sequences_;
   std::vector<PortData> ports_;
@@ -833,6 +833,23 @@ TEST_F(BasicPortAllocatorTest, TestSameNetworkDownAndUpWhenSessionNotStopped) {
   EXPECT_TRUE(candidate_allocation_done_);
 }
 
+// Test that a network change arriving within the network change interval of
+// the previous one is only handled once the interval has passed.
+TEST_F(BasicPortAllocatorTest, TestNetworkChangesAreRateLimited) {
+  const int kNetworkChangeIntervalMs = 2000;
+  allocator_->set_network_change_interval_ms(kNetworkChangeIntervalMs);
+  AddInterface(kClientAddr);
+  EXPECT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP));
+  session_->StartGettingPorts();
+  ASSERT_EQ_WAIT(7U, candidates_.size(), kDefaultAllocationTimeout);
+
+  AddInterface(kClientAddr2, "net2");
+  rtc::Thread::Current()->ProcessMessages(100);
+  EXPECT_FALSE(HasCandidate(candidates_, "local", "udp", kClientAddr2));
+  EXPECT_TRUE_WAIT(HasCandidate(candidates_, "local", "udp", kClientAddr2),
+                   kNetworkChangeIntervalMs + kDefaultAllocationTimeout);
+}
+
 // Test that when the same network interface is brought down and up, the
 // port allocator session will not restart a new allocation sequence if
 // it is stopped.
@@ -885,6 +902,22 @@ TEST_F(BasicPortAllocatorTest, TestGetAllPortsWithOneSecondStepDelay) {
   session_->StopGettingPorts();
 }
 
+// Verify that with parallel phases, all the candidates are gathered well
+// within a single step delay of 1sec.
+TEST_F(BasicPortAllocatorTest, TestGetAllPortsWithParallelPhases) {
+  AddInterface(kClientAddr);
+  allocator_->set_step_delay(kDefaultStepDelay);
+  allocator_->set_flags(allocator().flags() |
+                        PORTALLOCATOR_ENABLE_PARALLEL_PHASES);
+  EXPECT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP));
+  session_->StartGettingPorts();
+  ASSERT_EQ_WAIT(7U, candidates_.size(), 500);
+  EXPECT_EQ(4U, ports_.size());
+  EXPECT_PRED4(HasCandidate, candidates_, "relay", "ssltcp",
+               kRelaySslTcpIntAddr);
+  EXPECT_TRUE_WAIT(candidate_allocation_done_, 500);
+}
+
 TEST_F(BasicPortAllocatorTest, TestSetupVideoRtpPortsWithNormalSendBuffers) {
   AddInterface(kClientAddr);
   EXPECT_TRUE(CreateSession(ICE_CANDIDATE_COMPONENT_RTP, CN_VIDEO));
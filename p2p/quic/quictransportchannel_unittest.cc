@@ -10,14 +10,17 @@
 
 #include "webrtc/p2p/quic/quictransportchannel.h"
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
 #include "webrtc/base/common.h"
+#include "webrtc/base/copyonwritebuffer.h"
 #include "webrtc/base/gunit.h"
 #include "webrtc/base/sslidentity.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/p2p/base/faketransportcontroller.h"
 
 using cricket::ConnectionRole;
@@ -204,6 +207,9 @@ class QuicTestPeer : public sigslot::has_slots<> {
 
   size_t incoming_stream_count() const { return incoming_stream_count_; }
 
+  // Bytes received on all the incoming QUIC streams.
+  size_t stream_bytes_received() const { return stream_bytes_received_; }
+
   bool signal_closed_emitted() const { return signal_closed_emitted_; }
 
  private:
@@ -221,6 +227,10 @@ class QuicTestPeer : public sigslot::has_slots<> {
   void OnIncomingStream(ReliableQuicStream* stream) {
     incoming_quic_stream_ = stream;
     ++incoming_stream_count_;
+    stream->SignalDataReceived.connect(this, &QuicTestPeer::OnStreamData);
+  }
+  void OnStreamData(net::QuicStreamId id, const char* data, size_t len) {
+    stream_bytes_received_ += len;
   }
   void OnClosed() { signal_closed_emitted_ = true; }
 
@@ -232,6 +242,7 @@ class QuicTestPeer : public sigslot::has_slots<> {
   std::unique_ptr<rtc::SSLFingerprint> local_fingerprint_;
   ReliableQuicStream* incoming_quic_stream_ = nullptr;
   size_t incoming_stream_count_;
+  size_t stream_bytes_received_ = 0;
   bool signal_closed_emitted_ = false;
 };
 
@@ -549,3 +560,35 @@ TEST_F(QuicTransportChannelTest, SignalClosedEmitted) {
   EXPECT_TRUE(peer1_.signal_closed_emitted());
   EXPECT_TRUE_WAIT(peer2_.signal_closed_emitted(), kTimeoutMs);
 }
+
+// Measures the throughput of bulk data written on a QUIC stream over the
+// loopback transport channels, with data copied into QUIC's buffers and with
+// data queued by reference. Disabled since it only logs the results.
+TEST_F(QuicTransportChannelTest, DISABLED_StreamThroughputBenchmark) {
+  static const size_t kMessageSize = 64 * 1024;
+  static const size_t kNumMessages = 160;
+  static const int kBenchmarkTimeoutMs = 60000;
+  Connect();
+  ASSERT_TRUE_WAIT(quic_connected(), kTimeoutMs);
+  rtc::CopyOnWriteBuffer message(kMessageSize);
+  memset(message.data(), 'x', kMessageSize);
+  for (bool copy : {true, false}) {
+    ReliableQuicStream* stream = peer1_.quic_channel()->CreateQuicStream();
+    ASSERT_NE(nullptr, stream);
+    size_t start_bytes = peer2_.stream_bytes_received();
+    int64_t start_ms = rtc::TimeMillis();
+    for (size_t i = 0; i < kNumMessages; ++i) {
+      if (copy)
+        stream->Write(message.data<char>(), message.size());
+      else
+        stream->Write(message);
+    }
+    ASSERT_EQ_WAIT(kMessageSize * kNumMessages,
+                   peer2_.stream_bytes_received() - start_bytes,
+                   kBenchmarkTimeoutMs);
+    int64_t elapsed_ms = std::max<int64_t>(rtc::TimeMillis() - start_ms, 1);
+    LOG(LS_INFO) << (copy ? "Copied" : "Referenced") << " writes: "
+                 << kMessageSize * kNumMessages / elapsed_ms / 1000
+                 << " MB/s";
+  }
+}
@@ -42,6 +42,12 @@ void ReliableQuicStream::OnClose() {
 rtc::StreamResult ReliableQuicStream::Write(const char* data,
                                             size_t len,
                                             bool fin) {
+  if (!pending_writes_.empty()) {
+    // Keep the order of the data queued by the other Write().
+    pending_writes_.push_back({rtc::CopyOnWriteBuffer(data, len), 0, fin});
+    pending_bytes_ += len;
+    return rtc::StreamResult(rtc::SR_BLOCK);
+  }
   // Writes the data, or buffers it.
   WriteOrBufferData(base::StringPiece(data, len), fin, nullptr);
   if (HasBufferedData()) {
@@ -50,15 +56,61 @@ rtc::StreamResult ReliableQuicStream::Write(const char* data,
   return rtc::StreamResult(rtc::SR_SUCCESS);
 }
 
+rtc::StreamResult ReliableQuicStream::Write(const rtc::CopyOnWriteBuffer& data,
+                                            bool fin) {
+  size_t written = 0;
+  bool fin_written = false;
+  if (!HasBufferedData() && pending_writes_.empty())
+    written = WriteData(data, 0, fin, &fin_written);
+  if (written == data.size() && fin_written == fin)
+    return rtc::StreamResult(rtc::SR_SUCCESS);
+  // Copying |data| only takes a reference to its buffer.
+  pending_writes_.push_back({data, written, fin});
+  pending_bytes_ += data.size() - written;
+  return rtc::StreamResult(rtc::SR_BLOCK);
+}
+
 void ReliableQuicStream::Close() {
   net::ReliableQuicStream::session()->CloseStream(id());
 }
 
 void ReliableQuicStream::OnCanWrite() {
-  uint64_t prev_queued_bytes = queued_data_bytes();
+  uint64_t prev_queued_bytes = buffered_bytes();
   net::ReliableQuicStream::OnCanWrite();
-  uint64_t queued_bytes_written = prev_queued_bytes - queued_data_bytes();
+  if (!HasBufferedData())
+    WritePendingData();
+  uint64_t queued_bytes_written = prev_queued_bytes - buffered_bytes();
   SignalQueuedBytesWritten(id(), queued_bytes_written);
 }
 
+void ReliableQuicStream::WritePendingData() {
+  while (!pending_writes_.empty()) {
+    PendingWrite& pending = pending_writes_.front();
+    bool fin_written = false;
+    size_t written =
+        WriteData(pending.data, pending.offset, pending.fin, &fin_written);
+    pending.offset += written;
+    pending_bytes_ -= written;
+    if (pending.offset < pending.data.size() || fin_written != pending.fin) {
+      // QUIC calls OnCanWrite() again once it accepts more data.
+      return;
+    }
+    pending_writes_.pop_front();
+  }
+}
+
+size_t ReliableQuicStream::WriteData(const rtc::CopyOnWriteBuffer& data,
+                                     size_t offset,
+                                     bool fin,
+                                     bool* fin_written) {
+  struct iovec iov;
+  iov.iov_base = const_cast<uint8_t*>(data.cdata() + offset);
+  iov.iov_len = data.size() - offset;
+  // QUIC copies the data into packets as it consumes it, and registers the
+  // stream to be called back with OnCanWrite() if it doesn't consume all.
+  net::QuicConsumedData consumed = WritevData(&iov, 1, fin, nullptr);
+  *fin_written = consumed.fin_consumed;
+  return consumed.bytes_consumed;
+}
+
 }  // namespace cricket
@@ -11,8 +11,11 @@
 #ifndef WEBRTC_P2P_QUIC_RELIABLEQUICSTREAM_H_
 #define WEBRTC_P2P_QUIC_RELIABLEQUICSTREAM_H_
 
+#include <deque>
+
 #include "net/quic/reliable_quic_stream.h"
 #include "webrtc/base/constructormagic.h"
+#include "webrtc/base/copyonwritebuffer.h"
 #include "webrtc/base/sigslot.h"
 #include "webrtc/base/stream.h"
 
@@ -36,6 +39,16 @@ class ReliableQuicStream : public net::ReliableQuicStream,
   // of writing, in which case the data is queued until OnCanWrite() is called.
   // If |fin| == true, then this stream closes after sending data.
   rtc::StreamResult Write(const char* data, size_t len, bool fin = false);
+  // Same as above, except that data which can't be written right away is
+  // queued by holding a reference to |data| rather than by copying it into
+  // QUIC's buffers. Meant for large messages, which are likely to exceed the
+  // flow control window.
+  rtc::StreamResult Write(const rtc::CopyOnWriteBuffer& data,
+                          bool fin = false);
+  // Bytes queued by either Write(), waiting to be written.
+  uint64_t buffered_bytes() const {
+    return queued_data_bytes() + pending_bytes_;
+  }
   // Removes this stream from the QuicSession's stream map.
   void Close();
 
@@ -48,6 +61,26 @@ class ReliableQuicStream : public net::ReliableQuicStream,
   sigslot::signal2<net::QuicStreamId, uint64_t> SignalQueuedBytesWritten;
 
  private:
+  struct PendingWrite {
+    rtc::CopyOnWriteBuffer data;
+    // Bytes of |data| that were already written.
+    size_t offset;
+    bool fin;
+  };
+
+  // Writes as much of |pending_writes_| as QUIC accepts.
+  void WritePendingData();
+  // Writes |data| from |offset|, and returns the number of bytes written.
+  // Sets |fin_written| if |fin| was written too.
+  size_t WriteData(const rtc::CopyOnWriteBuffer& data,
+                   size_t offset,
+                   bool fin,
+                   bool* fin_written);
+
+  // Writes that wait behind the data queued by QUIC, in order.
+  std::deque<PendingWrite> pending_writes_;
+  uint64_t pending_bytes_ = 0;
+
   RTC_DISALLOW_COPY_AND_ASSIGN(ReliableQuicStream);
 };
 
@@ -229,6 +229,30 @@ TEST_F(ReliableQuicStreamTest, BufferData) {
   EXPECT_EQ("Foo barxyzzy", write_buffer_);
 }
 
+// Test that buffers are queued by reference, in order with the strings
+// written after them.
+TEST_F(ReliableQuicStreamTest, BufferCopyOnWriteData) {
+  CreateReliableQuicStream();
+
+  session_->set_writable(false);
+  rtc::CopyOnWriteBuffer data("Foo bar", 7);
+  EXPECT_EQ(SR_BLOCK, stream_->Write(data));
+  EXPECT_EQ(SR_BLOCK, stream_->Write("xyzzy", 5));
+
+  EXPECT_EQ(0ul, write_buffer_.size());
+  EXPECT_EQ(12u, stream_->buffered_bytes());
+
+  session_->set_writable(true);
+  stream_->OnCanWrite();
+  EXPECT_EQ(12ul, queued_bytes_written_);
+
+  EXPECT_EQ(0u, stream_->buffered_bytes());
+  EXPECT_EQ("Foo barxyzzy", write_buffer_);
+
+  EXPECT_EQ(SR_SUCCESS, stream_->Write(data));
+  EXPECT_EQ("Foo barxyzzyFoo bar", write_buffer_);
+}
+
 // Read an entire string.
 TEST_F(ReliableQuicStreamTest, ReadDataWhole) {
   CreateReliableQuicStream();
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <set>
@@ -32,6 +33,10 @@ namespace {
 
 const int THREAD_WAKE_UP_INTERVAL_MS = 5;
 
+// Receive timestamps taken by the kernel are only trusted if they are at most
+// this old when the response is processed.
+const int64_t kMaxReceiveQueueDelayUs = rtc::kNumMicrosecsPerSec;
+
 template <typename T>
 void IncrementCounterByAddress(std::map<T, int>* counter_per_ip, const T& ip) {
   counter_per_ip->insert(std::make_pair(ip, 0)).first->second++;
@@ -45,18 +50,20 @@ class StunProber::Requester : public sigslot::has_slots<> {
  public:
   // Each Request maps to a request and response.
   struct Request {
-    // Actual time the STUN bind request was sent.
-    int64_t sent_time_ms = 0;
-    // Time the response was received.
-    int64_t received_time_ms = 0;
+    // Actual time the STUN bind request was sent, in microseconds.
+    int64_t sent_time_us = 0;
+    // Time the response was received, in microseconds.
+    int64_t received_time_us = 0;
 
     // Server reflexive address from STUN response for this given request.
     rtc::SocketAddress srflx_addr;
 
     rtc::IPAddress server_addr;
 
-    int64_t rtt() { return received_time_ms - sent_time_ms; }
-    void ProcessResponse(const char* buf, size_t buf_len);
+    int64_t rtt_us() { return received_time_us - sent_time_us; }
+    void ProcessResponse(const char* buf,
+                         size_t buf_len,
+                         int64_t response_time_us);
   };
 
   // StunProber provides |server_ips| for Requester to probe. For shared
@@ -67,10 +74,12 @@ class StunProber::Requester : public sigslot::has_slots<> {
             const std::vector<rtc::SocketAddress>& server_ips);
   virtual ~Requester();
 
-  // There is no callback for SendStunRequest as the underneath socket send is
-  // expected to be completed immediately. Otherwise, it'll skip this request
-  // and move to the next one.
-  void SendStunRequest();
+  // Sends requests to the next |count| servers not probed yet, with as few
+  // socket calls as the socket allows. Returns how many requests were due,
+  // which is less than |count| if fewer servers remain. There is no callback
+  // as the underneath socket send is expected to be completed immediately.
+  // Otherwise, it'll skip the requests that were not sent.
+  size_t SendStunRequests(size_t count);
 
   void OnStunResponseReceived(rtc::AsyncPacketSocket* socket,
                               const char* buf,
@@ -81,12 +90,11 @@ class StunProber::Requester : public sigslot::has_slots<> {
   const std::vector<Request*>& requests() { return requests_; }
 
   // Whether this Requester has completed all requests.
-  bool Done() {
-    return static_cast<size_t>(num_request_sent_) == server_ips_.size();
-  }
+  bool Done() { return num_request_sent_ == server_ips_.size(); }
 
  private:
   Request* GetRequestByAddress(const rtc::IPAddress& ip);
+  std::unique_ptr<rtc::ByteBufferWriter> CreateRequestPacket();
 
   StunProber* prober_;
 
@@ -98,9 +106,12 @@ class StunProber::Requester : public sigslot::has_slots<> {
   std::unique_ptr<rtc::ByteBufferWriter> response_packet_;
 
   std::vector<Request*> requests_;
+  // The requests of |requests_| by the IP they were sent to. Each server IP
+  // is probed at most once per Requester.
+  std::map<rtc::IPAddress, Request*> requests_by_server_;
   std::vector<rtc::SocketAddress> server_ips_;
-  int16_t num_request_sent_ = 0;
-  int16_t num_response_received_ = 0;
+  size_t num_request_sent_ = 0;
+  size_t num_response_received_ = 0;
 
   rtc::ThreadChecker& thread_checker_;
 
@@ -131,10 +142,8 @@ StunProber::Requester::~Requester() {
   }
 }
 
-void StunProber::Requester::SendStunRequest() {
-  RTC_DCHECK(thread_checker_.CalledOnValidThread());
-  requests_.push_back(new Request());
-  Request& request = *(requests_.back());
+std::unique_ptr<rtc::ByteBufferWriter>
+StunProber::Requester::CreateRequestPacket() {
   cricket::StunMessage message;
 
   // Random transaction ID, STUN_BINDING_REQUEST
@@ -145,38 +154,61 @@ void StunProber::Requester::SendStunRequest() {
   std::unique_ptr<rtc::ByteBufferWriter> request_packet(
       new rtc::ByteBufferWriter(nullptr, kMaxUdpBufferSize));
   if (!message.Write(request_packet.get())) {
-    prober_->ReportOnFinished(WRITE_FAILED);
-    return;
+    return nullptr;
   }
+  return request_packet;
+}
 
-  auto addr = server_ips_[num_request_sent_];
-  request.server_addr = addr.ipaddr();
+size_t StunProber::Requester::SendStunRequests(size_t count) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  count = std::min(count, server_ips_.size() - num_request_sent_);
 
-  // The write must succeed immediately. Otherwise, the calculating of the STUN
-  // request timing could become too complicated. Callback is ignored by passing
-  // empty AsyncCallback.
   rtc::PacketOptions options;
-  int rv = socket_->SendTo(const_cast<char*>(request_packet->Data()),
-                           request_packet->Length(), addr, options);
-  if (rv < 0) {
-    prober_->ReportOnFinished(WRITE_FAILED);
-    return;
+  std::vector<std::unique_ptr<rtc::ByteBufferWriter>> request_packets;
+  std::vector<rtc::OutgoingPacket> packets;
+  for (size_t i = 0; i < count; ++i) {
+    requests_.push_back(new Request());
+    Request* request = requests_.back();
+    const rtc::SocketAddress& addr = server_ips_[num_request_sent_ + i];
+    request->server_addr = addr.ipaddr();
+    requests_by_server_.insert(std::make_pair(addr.ipaddr(), request));
+
+    std::unique_ptr<rtc::ByteBufferWriter> request_packet =
+        CreateRequestPacket();
+    if (!request_packet) {
+      prober_->ReportOnFinished(WRITE_FAILED);
+      return count;
+    }
+    packets.push_back(
+        {request_packet->Data(), request_packet->Length(), addr, &options});
+    request_packets.push_back(std::move(request_packet));
   }
 
-  request.sent_time_ms = rtc::TimeMillis();
+  // The writes must succeed immediately. Otherwise, the calculating of the
+  // STUN request timing could become too complicated.
+  int rv = socket_->SendPacketsTo(packets.data(), packets.size());
+  size_t num_sent = static_cast<size_t>(std::max(rv, 0));
+  int64_t sent_time_us = rtc::TimeMicros();
+  for (size_t i = 0; i < num_sent; ++i) {
+    requests_[requests_.size() - count + i]->sent_time_us = sent_time_us;
+  }
+  num_request_sent_ += num_sent;
+  RTC_DCHECK(num_request_sent_ <= server_ips_.size());
 
-  num_request_sent_++;
-  RTC_DCHECK(static_cast<size_t>(num_request_sent_) <= server_ips_.size());
+  if (num_sent < count) {
+    prober_->ReportOnFinished(WRITE_FAILED);
+  }
+  return count;
 }
 
 void StunProber::Requester::Request::ProcessResponse(const char* buf,
-                                                     size_t buf_len) {
-  int64_t now = rtc::TimeMillis();
+                                                     size_t buf_len,
+                                                     int64_t response_time_us) {
   rtc::ByteBufferReader message(buf, buf_len);
   cricket::StunMessage stun_response;
   if (!stun_response.Read(&message)) {
     // Invalid or incomplete STUN packet.
-    received_time_ms = 0;
+    received_time_us = 0;
     return;
   }
 
@@ -193,7 +225,7 @@ void StunProber::Requester::Request::ProcessResponse(const char* buf,
     return;
   }
 
-  received_time_ms = now;
+  received_time_us = response_time_us;
 
   srflx_addr = addr_attr->GetAddress();
 }
@@ -206,6 +238,19 @@ void StunProber::Requester::OnStunResponseReceived(
     const rtc::PacketTime& time) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
   RTC_DCHECK(socket_);
+  int64_t received_time_us = rtc::TimeMicros();
+  // Sockets reading with recvmmsg() report when the kernel received the
+  // datagram (SO_TIMESTAMP), on the wall clock. Move that onto the
+  // rtc::TimeMicros() clock by subtracting how long the datagram was queued,
+  // so the RTT doesn't include the time until this thread got to read it.
+  // Timestamps from other sockets fail the plausibility check and are ignored.
+  if (time.timestamp > 0) {
+    int64_t queued_us = rtc::TimeUTCMicros() - time.timestamp;
+    if (queued_us >= 0 && queued_us < kMaxReceiveQueueDelayUs) {
+      received_time_us -= queued_us;
+    }
+  }
+
   Request* request = GetRequestByAddress(addr.ipaddr());
   if (!request) {
     // Something is wrong, finish the test.
@@ -214,19 +259,14 @@ void StunProber::Requester::OnStunResponseReceived(
   }
 
   num_response_received_++;
-  request->ProcessResponse(buf, size);
+  request->ProcessResponse(buf, size, received_time_us);
 }
 
 StunProber::Requester::Request* StunProber::Requester::GetRequestByAddress(
     const rtc::IPAddress& ipaddr) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
-  for (auto request : requests_) {
-    if (request->server_addr == ipaddr) {
-      return request;
-    }
-  }
-
-  return nullptr;
+  auto it = requests_by_server_.find(ipaddr);
+  return it != requests_by_server_.end() ? it->second : nullptr;
 }
 
 StunProber::StunProber(rtc::PacketSocketFactory* socket_factory,
@@ -391,9 +431,22 @@ bool StunProber::SendNextRequest() {
   if (!current_requester_) {
     return false;
   }
-  current_requester_->SendStunRequest();
-  num_request_sent_++;
-  return true;
+  // In batch mode a round covers every resolved IP. In non-shared mode that
+  // spans one requester (and socket) per IP.
+  size_t remaining = batch_mode_ ? all_servers_addrs_.size() : 1;
+  while (true) {
+    size_t num_sent = current_requester_->SendStunRequests(remaining);
+    num_request_sent_ += num_sent;
+    remaining -= num_sent;
+    if (!remaining) {
+      return true;
+    }
+    current_requester_ = CreateRequester();
+    if (!current_requester_) {
+      return false;
+    }
+    requesters_.push_back(current_requester_);
+  }
 }
 
 bool StunProber::should_send_next_request(int64_t now) {
@@ -443,7 +496,7 @@ bool StunProber::GetStats(StunProber::Stats* prob_stats) const {
 
   StunProber::Stats stats;
 
-  int rtt_sum = 0;
+  int64_t rtt_sum_us = 0;
   int64_t first_sent_time = 0;
   int64_t last_sent_time = 0;
   NatType nat_type = NATTYPE_INVALID;
@@ -459,7 +512,7 @@ bool StunProber::GetStats(StunProber::Stats* prob_stats) const {
   for (auto* requester : requesters_) {
     std::map<rtc::SocketAddress, int> num_response_per_srflx_addr;
     for (auto request : requester->requests()) {
-      if (request->sent_time_ms <= 0) {
+      if (request->sent_time_us <= 0) {
         continue;
       }
 
@@ -467,18 +520,19 @@ bool StunProber::GetStats(StunProber::Stats* prob_stats) const {
       IncrementCounterByAddress(&num_request_per_server, request->server_addr);
 
       if (!first_sent_time) {
-        first_sent_time = request->sent_time_ms;
+        first_sent_time = request->sent_time_us;
       }
-      last_sent_time = request->sent_time_ms;
+      last_sent_time = request->sent_time_us;
 
-      if (request->received_time_ms < request->sent_time_ms) {
+      if (request->received_time_us < request->sent_time_us) {
         continue;
       }
 
       IncrementCounterByAddress(&num_response_per_server, request->server_addr);
       IncrementCounterByAddress(&num_response_per_srflx_addr,
                                 request->srflx_addr);
-      rtt_sum += request->rtt();
+      rtt_sum_us += request->rtt_us();
+      stats.rtts_us.push_back(static_cast<int>(request->rtt_us()));
       stats.srflx_addrs.insert(request->srflx_addr.ToString());
       srflx_ips.insert(request->srflx_addr.ipaddr());
     }
@@ -546,13 +600,15 @@ bool StunProber::GetStats(StunProber::Stats* prob_stats) const {
 
   if (stats.raw_num_request_sent > 1) {
     stats.actual_request_interval_ns =
-        (1000 * (last_sent_time - first_sent_time)) /
-        (stats.raw_num_request_sent - 1);
+        (last_sent_time - first_sent_time) / (stats.raw_num_request_sent - 1);
   }
 
   if (num_received) {
-    stats.average_rtt_ms = static_cast<int>((rtt_sum / num_received));
+    stats.average_rtt_ms =
+        static_cast<int>(rtt_sum_us / rtc::kNumMicrosecsPerMillisec /
+                         num_received);
   }
+  std::sort(stats.rtts_us.begin(), stats.rtts_us.end());
 
   *prob_stats = stats;
   return true;
@@ -82,6 +82,9 @@ class StunProber : public sigslot::has_slots<> {
     int num_response_received = 0;
     NatType nat_type = NATTYPE_INVALID;
     int average_rtt_ms = -1;
+    // Round trip times of all requests counted in |num_response_received|, in
+    // microseconds and sorted in ascending order.
+    std::vector<int> rtts_us;
     int success_percent = 0;
     int target_request_interval_ns = 0;
     int actual_request_interval_ns = 0;
@@ -134,13 +137,19 @@ class StunProber : public sigslot::has_slots<> {
   // Start to send out the STUN probes.
   bool Start(StunProber::Observer* observer);
 
+  // If set before Prepare() or Start(), every request interval sends one
+  // request to each resolved IP instead of a single request. In shared socket
+  // mode, the requests of a round go out on one socket in a single batch.
+  void set_batch_mode(bool batch_mode) { batch_mode_ = batch_mode; }
+
   // Method to retrieve the Stats once |finish_callback| is invoked. Returning
   // false when the result is inconclusive, for example, whether it's behind a
   // NAT or not.
   bool GetStats(Stats* stats) const;
 
   int estimated_execution_time() {
-    return static_cast<int>(requests_per_ip_ * all_servers_addrs_.size() *
+    return static_cast<int>(requests_per_ip_ *
+                            (batch_mode_ ? 1 : all_servers_addrs_.size()) *
                             interval_ms_);
   }
 
@@ -208,6 +217,9 @@ class StunProber : public sigslot::has_slots<> {
 
   bool shared_socket_mode_ = false;
 
+  // Whether a request interval sends a request to every resolved IP.
+  bool batch_mode_ = false;
+
   // How many requests should be done against each resolved IP.
   uint32_t requests_per_ip_ = 0;
 
@@ -10,6 +10,7 @@
 
 #include <stdint.h>
 
+#include <algorithm>
 #include <memory>
 
 #include "webrtc/base/asyncresolverinterface.h"
@@ -61,17 +62,19 @@ class StunProberTest : public testing::Test {
                     const std::vector<rtc::SocketAddress>& addrs,
                     const rtc::NetworkManager::NetworkList& networks,
                     bool shared_socket,
+                    bool batch_mode,
                     uint16_t interval,
                     uint16_t pings_per_ip) {
     prober.reset(
         new StunProber(socket_factory, rtc::Thread::Current(), networks));
+    prober->set_batch_mode(batch_mode);
     prober->Start(addrs, shared_socket, interval, pings_per_ip,
                   100 /* timeout_ms */, [this](StunProber* prober, int result) {
                     this->StopCallback(prober, result);
                   });
   }
 
-  void RunProber(bool shared_mode) {
+  void RunProber(bool shared_mode, bool batch_mode) {
     const int pings_per_ip = 3;
     std::vector<rtc::SocketAddress> addrs;
     addrs.push_back(kStunAddr1);
@@ -98,8 +101,8 @@ class StunProberTest : public testing::Test {
     // kFailedStunAddr.
     const uint32_t total_pings_reported = total_pings_tried - pings_per_ip;
 
-    StartProbing(socket_factory.get(), addrs, networks, shared_mode, 3,
-                 pings_per_ip);
+    StartProbing(socket_factory.get(), addrs, networks, shared_mode,
+                 batch_mode, 3, pings_per_ip);
 
     WAIT(stopped_, 1000);
 
@@ -112,6 +115,9 @@ class StunProberTest : public testing::Test {
               total_pings_reported);
     EXPECT_EQ(static_cast<uint32_t>(stats.num_response_received),
               total_pings_reported);
+    EXPECT_EQ(static_cast<uint32_t>(stats.rtts_us.size()),
+              total_pings_reported);
+    EXPECT_TRUE(std::is_sorted(stats.rtts_us.begin(), stats.rtts_us.end()));
   }
 
  private:
@@ -132,11 +138,19 @@ class StunProberTest : public testing::Test {
 };
 
 TEST_F(StunProberTest, NonSharedMode) {
-  RunProber(false);
+  RunProber(false, false);
 }
 
 TEST_F(StunProberTest, SharedMode) {
-  RunProber(true);
+  RunProber(true, false);
+}
+
+TEST_F(StunProberTest, NonSharedBatchMode) {
+  RunProber(false, true);
+}
+
+TEST_F(StunProberTest, SharedBatchMode) {
+  RunProber(true, true);
 }
 
 }  // namespace stunprober
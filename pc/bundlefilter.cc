@@ -35,15 +35,21 @@ bool BundleFilter::DemuxPacket(const uint8_t* data, size_t len) {
 }
 
 void BundleFilter::AddPayloadType(int payload_type) {
-  payload_types_.insert(payload_type);
+  if (payload_type < 0 ||
+      static_cast<size_t>(payload_type) >= payload_types_.size()) {
+    LOG(LS_WARNING) << "Ignoring invalid RTP payload type " << payload_type;
+    return;
+  }
+  payload_types_.set(payload_type);
 }
 
 bool BundleFilter::FindPayloadType(int pl_type) const {
-  return payload_types_.find(pl_type) != payload_types_.end();
+  return pl_type >= 0 && static_cast<size_t>(pl_type) < payload_types_.size() &&
+         payload_types_.test(pl_type);
 }
 
 void BundleFilter::ClearAllPayloadTypes() {
-  payload_types_.clear();
+  payload_types_.reset();
 }
 
 }  // namespace cricket
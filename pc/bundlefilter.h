@@ -13,7 +13,7 @@
 
 #include <stdint.h>
 
-#include <set>
+#include <bitset>
 #include <vector>
 
 #include "webrtc/base/basictypes.h"
@@ -46,7 +46,9 @@ class BundleFilter {
   void ClearAllPayloadTypes();
 
  private:
-  std::set<int> payload_types_;
+  // RTP payload types are 7 bits, so a bitmap is checked per packet instead
+  // of searching a set.
+  std::bitset<128> payload_types_;
 };
 
 }  // namespace cricket
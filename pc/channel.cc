@@ -8,6 +8,9 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <algorithm>
+#include <iterator>
+#include <set>
 #include <utility>
 
 #include "webrtc/pc/channel.h"
@@ -21,6 +24,7 @@
 #include "webrtc/base/dscp.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/base/networkroute.h"
+#include "webrtc/base/packet_trace.h"
 #include "webrtc/base/trace_event.h"
 #include "webrtc/media/base/mediaconstants.h"
 #include "webrtc/media/base/rtputils.h"
@@ -40,6 +44,12 @@ bool SetRawAudioSink_w(VoiceMediaChannel* channel,
   return true;
 }
 
+bool SetAudioLevelSink_w(VoiceMediaChannel* channel,
+                         webrtc::AudioLevelSinkInterface* sink) {
+  channel->SetAudioLevelSink(sink);
+  return true;
+}
+
 struct SendPacketMessageData : public rtc::MessageData {
   rtc::CopyOnWriteBuffer packet;
   rtc::PacketOptions options;
@@ -82,6 +92,16 @@ static void SafeSetError(const std::string& message, std::string* error_desc) {
   }
 }
 
+// Returns the SSRCs of all of |streams|, so that looking up the stream of an
+// SSRC doesn't take time linear in the number of streams.
+static std::set<uint32_t> GetAllSsrcs(
+    const std::vector<StreamParams>& streams) {
+  std::set<uint32_t> ssrcs;
+  for (const StreamParams& stream : streams)
+    ssrcs.insert(stream.ssrcs.begin(), stream.ssrcs.end());
+  return ssrcs;
+}
+
 struct VoiceChannelErrorMessageData : public rtc::MessageData {
   VoiceChannelErrorMessageData(uint32_t in_ssrc,
                                VoiceMediaChannel::Error in_error)
@@ -217,12 +237,15 @@ bool BaseChannel::Init_w(TransportChannel* rtp_transport,
                               rtcp_transport))) {
     return false;
   }
+  InitMedia_w();
+  return true;
+}
 
+void BaseChannel::InitMedia_w() {
   // Both RTP and RTCP channels are set, we can call SetInterface on
   // media channel and it can set network options.
   RTC_DCHECK(worker_thread_->IsCurrent());
   media_channel_->SetInterface(this);
-  return true;
 }
 
 bool BaseChannel::InitNetwork_n(TransportChannel* rtp_transport,
@@ -254,6 +277,31 @@ void BaseChannel::Deinit() {
   // derived classes destructor.
   network_thread_->Invoke<void>(
       RTC_FROM_HERE, Bind(&BaseChannel::DisconnectTransportChannels_n, this));
+  // No more packets are queued for the worker pool once the transport is
+  // disconnected. Wait for the queued ones, which use |this|.
+  if (srtp_worker_pool_)
+    srtp_worker_pool_->Flush();
+}
+
+bool BaseChannel::GetSrtpCryptoStats_n(SrtpCryptoStats* stats) const {
+  RTC_DCHECK(network_thread_->IsCurrent());
+  if (!srtp_filter_.IsActive())
+    return false;
+  *stats = srtp_filter_.GetCryptoStats();
+  return true;
+}
+
+void BaseChannel::SetSrtpWorkerPool(SrtpWorkerPool* srtp_worker_pool) {
+  RTC_DCHECK(worker_thread_->IsCurrent());
+  RTC_DCHECK(!rtp_transport_);
+  srtp_worker_pool_ = srtp_worker_pool;
+  unprotect_shards_.clear();
+  size_t num_shards = srtp_worker_pool_ ? srtp_worker_pool_->size() : 0;
+  srtp_filter_.SetRecvShards(num_shards);
+  for (size_t i = 0; i < num_shards; ++i) {
+    unprotect_shards_.push_back(
+        std::unique_ptr<UnprotectShard>(new UnprotectShard()));
+  }
 }
 
 bool BaseChannel::SetTransport(TransportChannel* rtp_transport,
@@ -665,6 +713,9 @@ bool BaseChannel::SendPacket(bool rtcp,
   // Protect if needed.
   if (srtp_filter_.IsActive()) {
     TRACE_EVENT0("webrtc", "SRTP Encode");
+    // Senders normally reserve room for the trailer; if one didn't, grow the
+    // buffer once here rather than failing to protect the packet.
+    packet->EnsureCapacity(packet->size() + kMaxSrtpTrailerLen);
     bool res;
     uint8_t* data = packet->data();
     int len = static_cast<int>(packet->size());
@@ -707,6 +758,8 @@ bool BaseChannel::SendPacket(bool rtcp,
                       << ", seqnum=" << seq_num << ", SSRC=" << ssrc;
         return false;
       }
+      rtc::packet_trace::RecordRtp(rtc::packet_trace::Stage::kSrtpProtected,
+                                   data, len);
     } else {
       res = srtp_filter_.ProtectRtcp(data, len,
                                      static_cast<int>(packet->capacity()),
@@ -748,6 +801,10 @@ bool BaseChannel::SendPacket(bool rtcp,
     }
     return false;
   }
+  if (!rtcp) {
+    rtc::packet_trace::RecordRtp(rtc::packet_trace::Stage::kSocketSent,
+                                 packet->data(), packet->size());
+  }
   return true;
 }
 
@@ -773,6 +830,10 @@ void BaseChannel::HandlePacket(bool rtcp, rtc::CopyOnWriteBuffer* packet,
   if (!WantsPacket(rtcp, packet)) {
     return;
   }
+  if (!rtcp) {
+    rtc::packet_trace::RecordRtp(rtc::packet_trace::Stage::kSocketReceived,
+                                 packet->data(), packet->size());
+  }
 
   // We are only interested in the first rtp packet because that
   // indicates the media has started flowing.
@@ -782,6 +843,26 @@ void BaseChannel::HandlePacket(bool rtcp, rtc::CopyOnWriteBuffer* packet,
   }
 
   // Unprotect the packet, if needed.
+  uint32_t ssrc;
+  if (srtp_filter_.IsActive() && !rtcp && srtp_worker_pool_ &&
+      GetRtpSsrc(packet->cdata(), packet->size(), &ssrc)) {
+    // All the packets of an SSRC go to the same thread, in order.
+    size_t shard = srtp_worker_pool_->GetIndex(ssrc);
+    UnprotectShard* unprotect_shard = unprotect_shards_[shard].get();
+    bool post_unprotect;
+    {
+      rtc::CritScope cs(&unprotect_shard->crit);
+      post_unprotect = unprotect_shard->pending.empty();
+      unprotect_shard->pending.push_back(
+          {rtcp, std::move(*packet), packet_time});
+    }
+    if (post_unprotect) {
+      invoker_.AsyncInvoke<void>(
+          RTC_FROM_HERE, srtp_worker_pool_->thread(shard),
+          Bind(&BaseChannel::UnprotectPackets_s, this, shard));
+    }
+    return;
+  }
   if (srtp_filter_.IsActive()) {
     TRACE_EVENT0("webrtc", "SRTP Decode");
     char* data = packet->data<char>();
@@ -827,23 +908,88 @@ void BaseChannel::HandlePacket(bool rtcp, rtc::CopyOnWriteBuffer* packet,
     return;
   }
 
-  invoker_.AsyncInvoke<void>(
-      RTC_FROM_HERE, worker_thread_,
-      Bind(&BaseChannel::OnPacketReceived, this, rtcp, *packet, packet_time));
+  bool post_delivery;
+  {
+    rtc::CritScope cs(&received_packets_crit_);
+    post_delivery = received_packets_.empty();
+    received_packets_.push_back({rtcp, std::move(*packet), packet_time});
+  }
+  if (post_delivery) {
+    invoker_.AsyncInvoke<void>(
+        RTC_FROM_HERE, worker_thread_,
+        Bind(&BaseChannel::OnPacketsReceived_w, this));
+  }
 }
 
-void BaseChannel::OnPacketReceived(bool rtcp,
-                                   const rtc::CopyOnWriteBuffer& packet,
-                                   const rtc::PacketTime& packet_time) {
+void BaseChannel::QueueReceivedPackets(std::vector<ReceivedPacket>* packets) {
+  bool post_delivery;
+  {
+    rtc::CritScope cs(&received_packets_crit_);
+    post_delivery = received_packets_.empty();
+    if (post_delivery) {
+      received_packets_.swap(*packets);
+    } else {
+      std::move(packets->begin(), packets->end(),
+                std::back_inserter(received_packets_));
+      packets->clear();
+    }
+  }
+  if (post_delivery) {
+    invoker_.AsyncInvoke<void>(
+        RTC_FROM_HERE, worker_thread_,
+        Bind(&BaseChannel::OnPacketsReceived_w, this));
+  }
+}
+
+void BaseChannel::UnprotectPackets_s(size_t shard) {
+  UnprotectShard* unprotect_shard = unprotect_shards_[shard].get();
+  std::vector<ReceivedPacket>& packets = unprotect_shard->unprotecting;
+  RTC_DCHECK(packets.empty());
+  {
+    rtc::CritScope cs(&unprotect_shard->crit);
+    packets.swap(unprotect_shard->pending);
+  }
+  TRACE_EVENT0("webrtc", "SRTP Decode");
+  auto unprotected = packets.begin();
+  for (ReceivedPacket& received : packets) {
+    char* data = received.packet.data<char>();
+    int len = static_cast<int>(received.packet.size());
+    if (!srtp_filter_.UnprotectRtp(shard, data, len, &len)) {
+      int seq_num = -1;
+      uint32_t ssrc = 0;
+      GetRtpSeqNum(data, len, &seq_num);
+      GetRtpSsrc(data, len, &ssrc);
+      LOG(LS_ERROR) << "Failed to unprotect " << content_name_
+                    << " RTP packet: size=" << len
+                    << ", seqnum=" << seq_num << ", SSRC=" << ssrc;
+      continue;
+    }
+    received.packet.SetSize(len);
+    if (&*unprotected != &received)
+      *unprotected = std::move(received);
+    ++unprotected;
+  }
+  packets.erase(unprotected, packets.end());
+  if (!packets.empty())
+    QueueReceivedPackets(&packets);
+  packets.clear();
+}
+
+void BaseChannel::OnPacketsReceived_w() {
   RTC_DCHECK(worker_thread_->IsCurrent());
-  // Need to copy variable because OnRtcpReceived/OnPacketReceived
-  // requires non-const pointer to buffer. This doesn't memcpy the actual data.
-  rtc::CopyOnWriteBuffer data(packet);
-  if (rtcp) {
-    media_channel_->OnRtcpReceived(&data, packet_time);
-  } else {
-    media_channel_->OnPacketReceived(&data, packet_time);
+  RTC_DCHECK(delivered_packets_.empty());
+  {
+    rtc::CritScope cs(&received_packets_crit_);
+    delivered_packets_.swap(received_packets_);
+  }
+  for (ReceivedPacket& received : delivered_packets_) {
+    if (received.rtcp) {
+      media_channel_->OnRtcpReceived(&received.packet, received.packet_time);
+    } else {
+      media_channel_->OnPacketReceived(&received.packet, received.packet_time);
+    }
   }
+  delivered_packets_.clear();
 }
 
 bool BaseChannel::PushdownLocalDescription(
@@ -1284,9 +1430,11 @@ bool BaseChannel::UpdateLocalStreams_w(const std::vector<StreamParams>& streams,
 
   // Check for streams that have been removed.
   bool ret = true;
+  const std::set<uint32_t> new_ssrcs = GetAllSsrcs(streams);
+  const std::set<uint32_t> old_ssrcs = GetAllSsrcs(local_streams_);
   for (StreamParamsVec::const_iterator it = local_streams_.begin();
        it != local_streams_.end(); ++it) {
-    if (!GetStreamBySsrc(streams, it->first_ssrc())) {
+    if (new_ssrcs.count(it->first_ssrc()) == 0) {
       if (!media_channel()->RemoveSendStream(it->first_ssrc())) {
         std::ostringstream desc;
         desc << "Failed to remove send stream with ssrc "
@@ -1299,7 +1447,7 @@ bool BaseChannel::UpdateLocalStreams_w(const std::vector<StreamParams>& streams,
   // Check for new streams.
   for (StreamParamsVec::const_iterator it = streams.begin();
        it != streams.end(); ++it) {
-    if (!GetStreamBySsrc(local_streams_, it->first_ssrc())) {
+    if (old_ssrcs.count(it->first_ssrc()) == 0) {
       if (media_channel()->AddSendStream(*it)) {
         LOG(LS_INFO) << "Add send stream ssrc: " << it->ssrcs[0];
       } else {
@@ -1359,9 +1507,11 @@ bool BaseChannel::UpdateRemoteStreams_w(
 
   // Check for streams that have been removed.
   bool ret = true;
+  const std::set<uint32_t> new_ssrcs = GetAllSsrcs(streams);
+  const std::set<uint32_t> old_ssrcs = GetAllSsrcs(remote_streams_);
   for (StreamParamsVec::const_iterator it = remote_streams_.begin();
        it != remote_streams_.end(); ++it) {
-    if (!GetStreamBySsrc(streams, it->first_ssrc())) {
+    if (new_ssrcs.count(it->first_ssrc()) == 0) {
       if (!RemoveRecvStream_w(it->first_ssrc())) {
         std::ostringstream desc;
         desc << "Failed to remove remote stream with ssrc "
@@ -1374,7 +1524,7 @@ bool BaseChannel::UpdateRemoteStreams_w(
   // Check for new streams.
   for (StreamParamsVec::const_iterator it = streams.begin();
       it != streams.end(); ++it) {
-    if (!GetStreamBySsrc(remote_streams_, it->first_ssrc())) {
+    if (old_ssrcs.count(it->first_ssrc()) == 0) {
       if (AddRecvStream_w(*it)) {
         LOG(LS_INFO) << "Add remote ssrc: " << it->ssrcs[0];
       } else {
@@ -1541,6 +1691,11 @@ void VoiceChannel::SetRawAudioSink(
                  Bind(&SetRawAudioSink_w, media_channel(), ssrc, &sink));
 }
 
+void VoiceChannel::SetAudioLevelSink(webrtc::AudioLevelSinkInterface* sink) {
+  InvokeOnWorker(RTC_FROM_HERE,
+                 Bind(&SetAudioLevelSink_w, media_channel(), sink));
+}
+
 webrtc::RtpParameters VoiceChannel::GetRtpSendParameters(uint32_t ssrc) const {
   return worker_thread()->Invoke<webrtc::RtpParameters>(
       RTC_FROM_HERE, Bind(&VoiceChannel::GetRtpSendParameters_w, this, ssrc));
@@ -2156,16 +2311,12 @@ RtpDataChannel::~RtpDataChannel() {
   Deinit();
 }
 
-bool RtpDataChannel::Init_w(TransportChannel* rtp_transport,
-                            TransportChannel* rtcp_transport) {
-  if (!BaseChannel::Init_w(rtp_transport, rtcp_transport)) {
-    return false;
-  }
+void RtpDataChannel::InitMedia_w() {
+  BaseChannel::InitMedia_w();
   media_channel()->SignalDataReceived.connect(this,
                                               &RtpDataChannel::OnDataReceived);
   media_channel()->SignalReadyToSend.connect(
       this, &RtpDataChannel::OnDataChannelReadyToSend);
-  return true;
 }
 
 bool RtpDataChannel::SendData(const SendDataParams& params,
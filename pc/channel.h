@@ -18,12 +18,14 @@
 #include <utility>
 #include <vector>
 
+#include "webrtc/api/call/audio_level_sink.h"
 #include "webrtc/api/call/audio_sink.h"
 #include "webrtc/base/asyncinvoker.h"
 #include "webrtc/base/asyncudpsocket.h"
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/network.h"
 #include "webrtc/base/sigslot.h"
+#include "webrtc/base/thread_annotations.h"
 #include "webrtc/base/window.h"
 #include "webrtc/config.h"
 #include "webrtc/media/base/mediachannel.h"
@@ -39,6 +41,7 @@
 #include "webrtc/pc/mediasession.h"
 #include "webrtc/pc/rtcpmuxfilter.h"
 #include "webrtc/pc/srtpfilter.h"
+#include "webrtc/pc/srtpworkerpool.h"
 
 namespace rtc {
 class PacketTransportInterface;
@@ -89,9 +92,18 @@ class BaseChannel
   virtual ~BaseChannel();
   bool Init_w(TransportChannel* rtp_transport,
               TransportChannel* rtcp_transport);
+  // The two steps of Init_w, so that several channels can be initialized with
+  // a single hop to the network thread. InitMedia_w must be called on the
+  // worker thread once InitNetwork_n has succeeded on the network thread.
+  bool InitNetwork_n(TransportChannel* rtp_transport,
+                     TransportChannel* rtcp_transport);
+  virtual void InitMedia_w();
   // Deinit may be called multiple times and is simply ignored if it's already
   // done.
   void Deinit();
+  // Unprotects received SRTP packets on the threads of |srtp_worker_pool|,
+  // which must outlive the channel. Must be called before Init_w.
+  void SetSrtpWorkerPool(SrtpWorkerPool* srtp_worker_pool);
 
   rtc::Thread* worker_thread() const { return worker_thread_; }
   rtc::Thread* network_thread() const { return network_thread_; }
@@ -105,6 +117,9 @@ class BaseChannel
   // DTLS-based keying. If you turned off SRTP later, however
   // you could have secure() == false and dtls_secure() == true.
   bool secure_dtls() const { return dtls_keyed_; }
+  // Gets the cost of the SRTP transformations of the channel. Returns false
+  // if SRTP isn't used. Must be called on the network thread.
+  bool GetSrtpCryptoStats_n(SrtpCryptoStats* stats) const;
 
   bool writable() const { return writable_; }
 
@@ -267,9 +282,8 @@ class BaseChannel
   bool WantsPacket(bool rtcp, const rtc::CopyOnWriteBuffer* packet);
   void HandlePacket(bool rtcp, rtc::CopyOnWriteBuffer* packet,
                     const rtc::PacketTime& packet_time);
-  void OnPacketReceived(bool rtcp,
-                        const rtc::CopyOnWriteBuffer& packet,
-                        const rtc::PacketTime& packet_time);
+  // Delivers all packets queued by HandlePacket() to the media channel.
+  void OnPacketsReceived_w();
 
   void EnableMedia_w();
   void DisableMedia_w();
@@ -361,8 +375,6 @@ class BaseChannel
   }
 
  private:
-  bool InitNetwork_n(TransportChannel* rtp_transport,
-                     TransportChannel* rtcp_transport);
   void DisconnectTransportChannels_n();
   void SignalSentPacket_n(rtc::PacketTransportInterface* transport,
                           const rtc::SentPacket& sent_packet);
@@ -414,6 +426,38 @@ class BaseChannel
   MediaContentDirection local_content_direction_ = MD_INACTIVE;
   MediaContentDirection remote_content_direction_ = MD_INACTIVE;
   CandidatePairInterface* selected_candidate_pair_;
+
+  // Packets received on the network thread that wait to be delivered on the
+  // worker thread. Only one delivery task is posted for all packets that
+  // arrive before the worker thread gets to it.
+  struct ReceivedPacket {
+    bool rtcp;
+    rtc::CopyOnWriteBuffer packet;
+    rtc::PacketTime packet_time;
+  };
+  rtc::CriticalSection received_packets_crit_;
+  std::vector<ReceivedPacket> received_packets_
+      GUARDED_BY(received_packets_crit_);
+  // Swapped with |received_packets_| by the worker thread, so that the
+  // storage of both is reused.
+  std::vector<ReceivedPacket> delivered_packets_;
+
+  // Moves |packets| to |received_packets_|, posting their delivery to the
+  // worker thread unless it is already pending.
+  void QueueReceivedPackets(std::vector<ReceivedPacket>* packets);
+  // Unprotects the RTP packets queued for |shard| on its worker pool thread.
+  void UnprotectPackets_s(size_t shard);
+
+  // RTP packets that wait to be unprotected on a thread of the SRTP worker
+  // pool, one queue per thread, in the same way.
+  struct UnprotectShard {
+    rtc::CriticalSection crit;
+    std::vector<ReceivedPacket> pending GUARDED_BY(crit);
+    // Only accessed on the thread of the shard.
+    std::vector<ReceivedPacket> unprotecting;
+  };
+  SrtpWorkerPool* srtp_worker_pool_ = nullptr;
+  std::vector<std::unique_ptr<UnprotectShard>> unprotect_shards_;
 };
 
 // VoiceChannel is a specialization that adds support for early media, DTMF,
@@ -461,6 +505,10 @@ class VoiceChannel : public BaseChannel {
   bool SetOutputVolume(uint32_t ssrc, double volume);
   void SetRawAudioSink(uint32_t ssrc,
                        std::unique_ptr<webrtc::AudioSinkInterface> sink);
+  // Sets a sink for the audio level header extension of all the received
+  // streams, e.g. an RtpAudioLevelMonitor. The sink is called on the packet
+  // receive path and is not owned.
+  void SetAudioLevelSink(webrtc::AudioLevelSinkInterface* sink);
   webrtc::RtpParameters GetRtpSendParameters(uint32_t ssrc) const;
   bool SetRtpSendParameters(uint32_t ssrc,
                             const webrtc::RtpParameters& parameters);
@@ -628,8 +676,7 @@ class RtpDataChannel : public BaseChannel {
                  bool rtcp_mux_required,
                  bool srtp_required);
   ~RtpDataChannel();
-  bool Init_w(TransportChannel* rtp_transport,
-              TransportChannel* rtcp_transport);
+  void InitMedia_w() override;
 
   virtual bool SendData(const SendDataParams& params,
                         const rtc::CopyOnWriteBuffer& payload,
@@ -1054,6 +1054,21 @@ class ChannelTest : public testing::Test, public sigslot::has_slots<> {
     EXPECT_TRUE(CheckNoRtp2());
   }
 
+  // Send a burst of RTP packets that is delivered to the worker thread at
+  // once, and ensure they all arrive in order.
+  void SendRtpBurstToRtp() {
+    const int kNumPackets = 20;
+    CreateChannels(RTCP_MUX | RTCP_MUX_REQUIRED, RTCP_MUX | RTCP_MUX_REQUIRED);
+    EXPECT_TRUE(SendInitiate());
+    EXPECT_TRUE(SendAccept());
+    for (int i = 0; i < kNumPackets; ++i)
+      SendCustomRtp1(kSsrc1, i);
+    WaitForThreads();
+    for (int i = 0; i < kNumPackets; ++i)
+      EXPECT_TRUE(CheckCustomRtp2(kSsrc1, i));
+    EXPECT_TRUE(CheckNoRtp2());
+  }
+
   void TestDeinit() {
     CreateChannels(0, 0);
     EXPECT_TRUE(SendInitiate());
@@ -2189,6 +2204,10 @@ TEST_F(VoiceChannelSingleThreadTest, SendRtpToRtp) {
   Base::SendRtpToRtp();
 }
 
+TEST_F(VoiceChannelSingleThreadTest, SendRtpBurstToRtp) {
+  Base::SendRtpBurstToRtp();
+}
+
 TEST_F(VoiceChannelSingleThreadTest, SendRtcpToRtcp) {
   Base::SendRtcpToRtcp();
 }
@@ -2522,6 +2541,10 @@ TEST_F(VoiceChannelDoubleThreadTest, SendRtpToRtp) {
   Base::SendRtpToRtp();
 }
 
+TEST_F(VoiceChannelDoubleThreadTest, SendRtpBurstToRtp) {
+  Base::SendRtpBurstToRtp();
+}
+
 TEST_F(VoiceChannelDoubleThreadTest, SendRtcpToRtcp) {
   Base::SendRtcpToRtcp();
 }
@@ -102,11 +102,27 @@ bool ChannelManager::SetCryptoOptions(
 
 bool ChannelManager::SetCryptoOptions_w(
     const rtc::CryptoOptions& crypto_options) {
-  if (!video_channels_.empty() || !voice_channels_.empty() ||
-      !data_channels_.empty()) {
+  bool has_channels = !video_channels_.empty() || !voice_channels_.empty() ||
+                      !data_channels_.empty();
+  if (has_channels) {
     LOG(LS_WARNING) << "Not changing crypto options in existing channels.";
   }
   crypto_options_ = crypto_options;
+  size_t srtp_unprotect_threads =
+      static_cast<size_t>(std::max(0, crypto_options_.srtp_unprotect_threads));
+  size_t pool_size = srtp_worker_pool_ ? srtp_worker_pool_->size() : 0;
+  if (srtp_unprotect_threads != pool_size) {
+    // Existing channels use the pool, so it can only be replaced without them.
+    if (has_channels) {
+      LOG(LS_WARNING) << "Not changing the SRTP unprotect threads while "
+                      << "channels exist.";
+    } else {
+      srtp_worker_pool_.reset(
+          srtp_unprotect_threads
+              ? new SrtpWorkerPool(srtp_unprotect_threads)
+              : nullptr);
+    }
+  }
 #if defined(ENABLE_EXTERNAL_AUTH)
   if (crypto_options_.enable_gcm_crypto_suites) {
     // TODO(jbauch): Re-enable once https://crbug.com/628400 is resolved.
@@ -235,26 +251,19 @@ VoiceChannel* ChannelManager::CreateVoiceChannel_w(
     bool rtcp_mux_required,
     bool srtp_required,
     const AudioOptions& options) {
-  RTC_DCHECK(initialized_);
-  RTC_DCHECK(worker_thread_ == rtc::Thread::Current());
-  RTC_DCHECK(nullptr != media_controller);
-
-  VoiceMediaChannel* media_channel = media_engine_->CreateChannel(
-      media_controller->call_w(), media_controller->config(), options);
-  if (!media_channel)
-    return nullptr;
-
-  VoiceChannel* voice_channel = new VoiceChannel(
-      worker_thread_, network_thread_, signaling_thread, media_engine_.get(),
-      media_channel, content_name, rtcp_mux_required, srtp_required);
-  voice_channel->SetCryptoOptions(crypto_options_);
-
-  if (!voice_channel->Init_w(rtp_transport, rtcp_transport)) {
-    delete voice_channel;
-    return nullptr;
-  }
-  voice_channels_.push_back(voice_channel);
-  return voice_channel;
+  ChannelConfig config;
+  config.media_type = MEDIA_TYPE_AUDIO;
+  config.rtp_transport = rtp_transport;
+  config.rtcp_transport = rtcp_transport;
+  config.content_name = content_name;
+  config.bundle_transport_name = bundle_transport_name;
+  config.rtcp_mux_required = rtcp_mux_required;
+  config.srtp_required = srtp_required;
+  config.audio_options = options;
+  std::vector<BaseChannel*> channels =
+      CreateChannels_w(media_controller, signaling_thread, {config});
+  return channels.empty() ? nullptr
+                          : static_cast<VoiceChannel*>(channels[0]);
 }
 
 void ChannelManager::DestroyVoiceChannel(VoiceChannel* voice_channel) {
@@ -307,25 +316,19 @@ VideoChannel* ChannelManager::CreateVideoChannel_w(
     bool rtcp_mux_required,
     bool srtp_required,
     const VideoOptions& options) {
-  RTC_DCHECK(initialized_);
-  RTC_DCHECK(worker_thread_ == rtc::Thread::Current());
-  RTC_DCHECK(nullptr != media_controller);
-  VideoMediaChannel* media_channel = media_engine_->CreateVideoChannel(
-      media_controller->call_w(), media_controller->config(), options);
-  if (media_channel == NULL) {
-    return NULL;
-  }
-
-  VideoChannel* video_channel = new VideoChannel(
-      worker_thread_, network_thread_, signaling_thread, media_channel,
-      content_name, rtcp_mux_required, srtp_required);
-  video_channel->SetCryptoOptions(crypto_options_);
-  if (!video_channel->Init_w(rtp_transport, rtcp_transport)) {
-    delete video_channel;
-    return NULL;
-  }
-  video_channels_.push_back(video_channel);
-  return video_channel;
+  ChannelConfig config;
+  config.media_type = MEDIA_TYPE_VIDEO;
+  config.rtp_transport = rtp_transport;
+  config.rtcp_transport = rtcp_transport;
+  config.content_name = content_name;
+  config.bundle_transport_name = bundle_transport_name;
+  config.rtcp_mux_required = rtcp_mux_required;
+  config.srtp_required = srtp_required;
+  config.video_options = options;
+  std::vector<BaseChannel*> channels =
+      CreateChannels_w(media_controller, signaling_thread, {config});
+  return channels.empty() ? nullptr
+                          : static_cast<VideoChannel*>(channels[0]);
 }
 
 void ChannelManager::DestroyVideoChannel(VideoChannel* video_channel) {
@@ -377,29 +380,18 @@ RtpDataChannel* ChannelManager::CreateRtpDataChannel_w(
     const std::string* bundle_transport_name,
     bool rtcp_mux_required,
     bool srtp_required) {
-  // This is ok to alloc from a thread other than the worker thread.
-  RTC_DCHECK(initialized_);
-  MediaConfig config;
-  if (media_controller) {
-    config = media_controller->config();
-  }
-  DataMediaChannel* media_channel = data_media_engine_->CreateChannel(config);
-  if (!media_channel) {
-    LOG(LS_WARNING) << "Failed to create RTP data channel.";
-    return nullptr;
-  }
-
-  RtpDataChannel* data_channel = new RtpDataChannel(
-      worker_thread_, network_thread_, signaling_thread, media_channel,
-      content_name, rtcp_mux_required, srtp_required);
-  data_channel->SetCryptoOptions(crypto_options_);
-  if (!data_channel->Init_w(rtp_transport, rtcp_transport)) {
-    LOG(LS_WARNING) << "Failed to init data channel.";
-    delete data_channel;
-    return nullptr;
-  }
-  data_channels_.push_back(data_channel);
-  return data_channel;
+  ChannelConfig config;
+  config.media_type = MEDIA_TYPE_DATA;
+  config.rtp_transport = rtp_transport;
+  config.rtcp_transport = rtcp_transport;
+  config.content_name = content_name;
+  config.bundle_transport_name = bundle_transport_name;
+  config.rtcp_mux_required = rtcp_mux_required;
+  config.srtp_required = srtp_required;
+  std::vector<BaseChannel*> channels =
+      CreateChannels_w(media_controller, signaling_thread, {config});
+  return channels.empty() ? nullptr
+                          : static_cast<RtpDataChannel*>(channels[0]);
 }
 
 void ChannelManager::DestroyRtpDataChannel(RtpDataChannel* data_channel) {
@@ -425,6 +417,122 @@ void ChannelManager::DestroyRtpDataChannel_w(RtpDataChannel* data_channel) {
   delete data_channel;
 }
 
+std::vector<BaseChannel*> ChannelManager::CreateChannels(
+    webrtc::MediaControllerInterface* media_controller,
+    rtc::Thread* signaling_thread,
+    const std::vector<ChannelConfig>& configs) {
+  TRACE_EVENT0("webrtc", "ChannelManager::CreateChannels");
+  return worker_thread_->Invoke<std::vector<BaseChannel*>>(
+      RTC_FROM_HERE, Bind(&ChannelManager::CreateChannels_w, this,
+                          media_controller, signaling_thread, configs));
+}
+
+std::vector<BaseChannel*> ChannelManager::CreateChannels_w(
+    webrtc::MediaControllerInterface* media_controller,
+    rtc::Thread* signaling_thread,
+    const std::vector<ChannelConfig>& configs) {
+  RTC_DCHECK(initialized_);
+  RTC_DCHECK(worker_thread_ == rtc::Thread::Current());
+  std::vector<BaseChannel*> channels;
+  for (const ChannelConfig& config : configs) {
+    BaseChannel* channel =
+        NewChannel_w(media_controller, signaling_thread, config);
+    if (!channel)
+      break;
+    channels.push_back(channel);
+  }
+
+  bool success = channels.size() == configs.size() &&
+                 network_thread_->Invoke<bool>(RTC_FROM_HERE, [&] {
+                   for (size_t i = 0; i < channels.size(); ++i) {
+                     if (!channels[i]->InitNetwork_n(
+                             configs[i].rtp_transport,
+                             configs[i].rtcp_transport)) {
+                       return false;
+                     }
+                   }
+                   return true;
+                 });
+  if (!success) {
+    LOG(LS_WARNING) << "Failed to create channels.";
+    for (BaseChannel* channel : channels)
+      delete channel;
+    return std::vector<BaseChannel*>();
+  }
+
+  for (size_t i = 0; i < channels.size(); ++i) {
+    channels[i]->InitMedia_w();
+    switch (configs[i].media_type) {
+      case MEDIA_TYPE_AUDIO:
+        voice_channels_.push_back(static_cast<VoiceChannel*>(channels[i]));
+        break;
+      case MEDIA_TYPE_VIDEO:
+        video_channels_.push_back(static_cast<VideoChannel*>(channels[i]));
+        break;
+      case MEDIA_TYPE_DATA:
+        data_channels_.push_back(static_cast<RtpDataChannel*>(channels[i]));
+        break;
+    }
+  }
+  return channels;
+}
+
+BaseChannel* ChannelManager::NewChannel_w(
+    webrtc::MediaControllerInterface* media_controller,
+    rtc::Thread* signaling_thread,
+    const ChannelConfig& config) {
+  BaseChannel* channel = nullptr;
+  switch (config.media_type) {
+    case MEDIA_TYPE_AUDIO: {
+      RTC_DCHECK(nullptr != media_controller);
+      VoiceMediaChannel* media_channel = media_engine_->CreateChannel(
+          media_controller->call_w(), media_controller->config(),
+          config.audio_options);
+      if (!media_channel)
+        return nullptr;
+      channel = new VoiceChannel(
+          worker_thread_, network_thread_, signaling_thread,
+          media_engine_.get(), media_channel, config.content_name,
+          config.rtcp_mux_required, config.srtp_required);
+      break;
+    }
+    case MEDIA_TYPE_VIDEO: {
+      RTC_DCHECK(nullptr != media_controller);
+      VideoMediaChannel* media_channel = media_engine_->CreateVideoChannel(
+          media_controller->call_w(), media_controller->config(),
+          config.video_options);
+      if (!media_channel)
+        return nullptr;
+      channel = new VideoChannel(worker_thread_, network_thread_,
+                                 signaling_thread, media_channel,
+                                 config.content_name, config.rtcp_mux_required,
+                                 config.srtp_required);
+      break;
+    }
+    case MEDIA_TYPE_DATA: {
+      MediaConfig media_config;
+      if (media_controller) {
+        media_config = media_controller->config();
+      }
+      DataMediaChannel* media_channel =
+          data_media_engine_->CreateChannel(media_config);
+      if (!media_channel) {
+        LOG(LS_WARNING) << "Failed to create RTP data channel.";
+        return nullptr;
+      }
+      channel = new RtpDataChannel(worker_thread_, network_thread_,
+                                   signaling_thread, media_channel,
+                                   config.content_name,
+                                   config.rtcp_mux_required,
+                                   config.srtp_required);
+      break;
+    }
+  }
+  channel->SetCryptoOptions(crypto_options_);
+  channel->SetSrtpWorkerPool(srtp_worker_pool_.get());
+  return channel;
+}
+
 bool ChannelManager::StartAecDump(rtc::PlatformFile file,
                                   int64_t max_size_bytes) {
   return worker_thread_->Invoke<bool>(
@@ -18,6 +18,7 @@
 #include "webrtc/base/fileutils.h"
 #include "webrtc/base/thread.h"
 #include "webrtc/media/base/mediaengine.h"
+#include "webrtc/pc/srtpworkerpool.h"
 #include "webrtc/pc/voicechannel.h"
 
 namespace webrtc {
@@ -126,6 +127,29 @@ class ChannelManager {
   // Destroys a data channel created with the Create API.
   void DestroyRtpDataChannel(RtpDataChannel* data_channel);
 
+  // A channel to create with CreateChannels.
+  struct ChannelConfig {
+    // MEDIA_TYPE_DATA creates an RtpDataChannel.
+    MediaType media_type = MEDIA_TYPE_AUDIO;
+    TransportChannel* rtp_transport = nullptr;
+    TransportChannel* rtcp_transport = nullptr;
+    std::string content_name;
+    const std::string* bundle_transport_name = nullptr;
+    bool rtcp_mux_required = false;
+    bool srtp_required = false;
+    AudioOptions audio_options;
+    VideoOptions video_options;
+  };
+  // Creates the channels of |configs| with a single hop to the worker thread
+  // and a single hop to the network thread, instead of one of each per
+  // channel. Returns the channels in the order of |configs|, to be destroyed
+  // with the Destroy method of their type, or an empty vector if any of them
+  // couldn't be created.
+  std::vector<BaseChannel*> CreateChannels(
+      webrtc::MediaControllerInterface* media_controller,
+      rtc::Thread* signaling_thread,
+      const std::vector<ChannelConfig>& configs);
+
   // Indicates whether any channels exist.
   bool has_channels() const {
     return (!voice_channels_.empty() || !video_channels_.empty());
@@ -197,6 +221,14 @@ class ChannelManager {
       bool rtcp_mux_required,
       bool srtp_required);
   void DestroyRtpDataChannel_w(RtpDataChannel* data_channel);
+  std::vector<BaseChannel*> CreateChannels_w(
+      webrtc::MediaControllerInterface* media_controller,
+      rtc::Thread* signaling_thread,
+      const std::vector<ChannelConfig>& configs);
+  // Creates the channel of |config| without initializing it.
+  BaseChannel* NewChannel_w(webrtc::MediaControllerInterface* media_controller,
+                            rtc::Thread* signaling_thread,
+                            const ChannelConfig& config);
 
   std::unique_ptr<MediaEngineInterface> media_engine_;
   std::unique_ptr<DataEngineInterface> data_media_engine_;
@@ -211,6 +243,8 @@ class ChannelManager {
 
   bool enable_rtx_;
   rtc::CryptoOptions crypto_options_;
+  // Shared by all the channels, created with |crypto_options_|.
+  std::unique_ptr<SrtpWorkerPool> srtp_worker_pool_;
 
   bool capturing_;
 };
@@ -160,6 +160,44 @@ TEST_F(ChannelManagerTest, CreateDestroyChannelsOnThread) {
   cm_->Terminate();
 }
 
+// Test that channels of all types can be created with a single call.
+TEST_F(ChannelManagerTest, CreateChannelsInBatch) {
+  network_.Start();
+  worker_.Start();
+  EXPECT_TRUE(cm_->set_worker_thread(&worker_));
+  EXPECT_TRUE(cm_->set_network_thread(&network_));
+  EXPECT_TRUE(cm_->Init());
+  delete transport_controller_;
+  transport_controller_ =
+      new cricket::FakeTransportController(&network_, ICEROLE_CONTROLLING);
+  std::vector<cricket::ChannelManager::ChannelConfig> configs(3);
+  configs[0].media_type = cricket::MEDIA_TYPE_AUDIO;
+  configs[0].content_name = cricket::CN_AUDIO;
+  configs[1].media_type = cricket::MEDIA_TYPE_VIDEO;
+  configs[1].content_name = cricket::CN_VIDEO;
+  configs[2].media_type = cricket::MEDIA_TYPE_DATA;
+  configs[2].content_name = cricket::CN_DATA;
+  for (cricket::ChannelManager::ChannelConfig& config : configs) {
+    config.rtp_transport = transport_controller_->CreateTransportChannel(
+        config.content_name, cricket::ICE_CANDIDATE_COMPONENT_RTP);
+    config.rtcp_mux_required = kDefaultRtcpMuxRequired;
+    config.srtp_required = kDefaultSrtpRequired;
+  }
+  std::vector<cricket::BaseChannel*> channels =
+      cm_->CreateChannels(&fake_mc_, rtc::Thread::Current(), configs);
+  ASSERT_EQ(3u, channels.size());
+  EXPECT_EQ(cricket::CN_AUDIO, channels[0]->content_name());
+  EXPECT_EQ(cricket::CN_VIDEO, channels[1]->content_name());
+  EXPECT_EQ(cricket::CN_DATA, channels[2]->content_name());
+  EXPECT_TRUE(cm_->has_channels());
+  cm_->DestroyVoiceChannel(static_cast<cricket::VoiceChannel*>(channels[0]));
+  cm_->DestroyVideoChannel(static_cast<cricket::VideoChannel*>(channels[1]));
+  cm_->DestroyRtpDataChannel(
+      static_cast<cricket::RtpDataChannel*>(channels[2]));
+  EXPECT_FALSE(cm_->has_channels());
+  cm_->Terminate();
+}
+
 TEST_F(ChannelManagerTest, SetVideoRtxEnabled) {
   std::vector<VideoCodec> codecs;
   const VideoCodec rtx_codec(96, "rtx");
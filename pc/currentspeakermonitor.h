@@ -42,7 +42,8 @@ class AudioSourceContext {
 // SignalAudioInfoMonitor - provides audio info of the all current speakers.
 // SignalMediaSourcesUpdated - provides updates when a speaker leaves or joins.
 // Note that the AudioSourceContext's audio monitor must be started
-// before this is started.
+// before this is started. RtpAudioLevelMonitor is an AudioSourceContext fed
+// by the RTP audio level header extension, which works without decoding.
 // It's recommended that the audio monitor be started with a 100 ms period.
 class CurrentSpeakerMonitor : public sigslot::has_slots<> {
  public:
@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/pc/rtpaudiolevelmonitor.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/pc/audiomonitor.h"
+
+namespace cricket {
+
+namespace {
+const uint32_t MSG_MONITOR_POLL = 1;
+
+// Levels are handled in dB above the silence level of the extension,
+// -127 dBov.
+const int kSilenceDbov = 127;
+// A stream becomes active above -45 dBov and inactive below -55 dBov.
+const int32_t kActivateQ8 = (kSilenceDbov - 45) << 8;
+const int32_t kDeactivateQ8 = (kSilenceDbov - 55) << 8;
+// Smoothing shifts for rising and falling levels. With 20 ms packets the
+// level rises with a time constant of 40 ms and falls with one of 640 ms,
+// which bridges the pauses between words.
+const int kAttackShift = 1;
+const int kReleaseShift = 5;
+// Streams without packets are silent after |kStreamTimeoutMs| and forgotten
+// after |kStreamRemovalMs|.
+const int64_t kStreamTimeoutMs = 1000;
+const int64_t kStreamRemovalMs = 10000;
+// The range of the levels reported in AudioInfo, as those of AudioLevel.
+const int kMaxAudioLevel = 9;
+}  // namespace
+
+RtpAudioLevelMonitor::RtpAudioLevelMonitor(rtc::Thread* monitor_thread)
+    : monitor_thread_(monitor_thread) {
+  RTC_DCHECK(monitor_thread_);
+}
+
+RtpAudioLevelMonitor::~RtpAudioLevelMonitor() {
+  monitor_thread_->Clear(this);
+}
+
+void RtpAudioLevelMonitor::Start(int cms) {
+  RTC_DCHECK(monitor_thread_->IsCurrent());
+  rate_ms_ = std::max(cms, 10);
+  if (!monitoring_) {
+    monitoring_ = true;
+    monitor_thread_->PostDelayed(RTC_FROM_HERE, rate_ms_, this,
+                                 MSG_MONITOR_POLL);
+  }
+}
+
+void RtpAudioLevelMonitor::Stop() {
+  RTC_DCHECK(monitor_thread_->IsCurrent());
+  monitoring_ = false;
+  monitor_thread_->Clear(this);
+}
+
+void RtpAudioLevelMonitor::OnAudioLevel(uint32_t ssrc,
+                                        uint8_t level_dbov,
+                                        bool voice_activity) {
+  const int32_t level_q8 =
+      (kSilenceDbov - std::min<int>(level_dbov, kSilenceDbov)) << 8;
+  const int64_t now_ms = rtc::TimeMillis();
+  rtc::CritScope cs(&crit_);
+  StreamLevel& stream = streams_[ssrc];
+  if (now_ms - stream.last_packet_ms > kStreamTimeoutMs) {
+    // First packet, or first after a long gap: restart the smoothing.
+    stream.smoothed_q8 = 0;
+  }
+  // The voice activity bit is not used, since senders only set it
+  // meaningfully when they run a VAD.
+  const int32_t diff = level_q8 - stream.smoothed_q8;
+  if (diff > 0) {
+    stream.smoothed_q8 += diff >> kAttackShift;
+  } else {
+    stream.smoothed_q8 -= -diff >> kReleaseShift;
+  }
+  stream.last_packet_ms = now_ms;
+}
+
+void RtpAudioLevelMonitor::Update() {
+  const int64_t now_ms = rtc::TimeMillis();
+  AudioInfo info;
+  info.input_level = 0;
+  info.output_level = 0;
+  {
+    rtc::CritScope cs(&crit_);
+    for (auto it = streams_.begin(); it != streams_.end();) {
+      StreamLevel& stream = it->second;
+      const int64_t since_last_packet_ms = now_ms - stream.last_packet_ms;
+      if (since_last_packet_ms > kStreamRemovalMs) {
+        it = streams_.erase(it);
+        continue;
+      }
+      // Hysteresis between the activation and deactivation thresholds.
+      if (since_last_packet_ms > kStreamTimeoutMs ||
+          stream.smoothed_q8 < kDeactivateQ8) {
+        stream.active = false;
+      } else if (stream.smoothed_q8 >= kActivateQ8) {
+        stream.active = true;
+      }
+      if (stream.active) {
+        // Map the levels above the deactivation threshold onto 1-9.
+        const int level = 1 + (stream.smoothed_q8 - kDeactivateQ8) *
+                                  (kMaxAudioLevel - 1) /
+                                  ((kSilenceDbov << 8) - kDeactivateQ8);
+        info.active_streams.push_back(
+            std::make_pair(it->first, std::min(level, kMaxAudioLevel)));
+      }
+      ++it;
+    }
+  }
+
+  // Rank the active streams, loudest first.
+  std::stable_sort(info.active_streams.begin(), info.active_streams.end(),
+                   [](const std::pair<uint32_t, int>& a,
+                      const std::pair<uint32_t, int>& b) {
+                     return a.second > b.second;
+                   });
+  if (!info.active_streams.empty())
+    info.output_level = info.active_streams.front().second;
+  SignalAudioMonitor(this, info);
+}
+
+void RtpAudioLevelMonitor::OnMessage(rtc::Message* message) {
+  RTC_DCHECK_EQ(MSG_MONITOR_POLL, message->message_id);
+  if (!monitoring_)
+    return;
+  Update();
+  monitor_thread_->PostDelayed(RTC_FROM_HERE, rate_ms_, this,
+                               MSG_MONITOR_POLL);
+}
+
+}  // namespace cricket
@@ -0,0 +1,80 @@
+/*
+ *  Copyright 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// RtpAudioLevelMonitor derives the audio levels of the streams of a session
+// from the RTP audio level header extension, for CurrentSpeakerMonitor.
+
+#ifndef WEBRTC_PC_RTPAUDIOLEVELMONITOR_H_
+#define WEBRTC_PC_RTPAUDIOLEVELMONITOR_H_
+
+#include <stdint.h>
+
+#include <map>
+
+#include "webrtc/api/call/audio_level_sink.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/messagehandler.h"
+#include "webrtc/base/thread.h"
+#include "webrtc/pc/currentspeakermonitor.h"
+
+namespace cricket {
+
+// An AudioSourceContext whose audio levels come from the audio level header
+// extension of the received RTP packets instead of from the decoded audio,
+// so that speakers can be detected on streams that are not decoded, e.g.
+// end-to-end encrypted (PERC) streams on a media server. Set it as the audio
+// level sink of a VoiceChannel and pass it to a CurrentSpeakerMonitor.
+//
+// The levels of each stream are smoothed per packet, with a fast attack and
+// a slow release, and a stream is only reported as active once its smoothed
+// level exceeds an activation threshold, until it falls below a lower
+// deactivation threshold. The active streams are reported in order of
+// decreasing level on |monitor_thread|, every |cms| ms after Start().
+class RtpAudioLevelMonitor : public AudioSourceContext,
+                             public webrtc::AudioLevelSinkInterface,
+                             public rtc::MessageHandler {
+ public:
+  explicit RtpAudioLevelMonitor(rtc::Thread* monitor_thread);
+  ~RtpAudioLevelMonitor() override;
+
+  void Start(int cms);
+  void Stop();
+
+  // webrtc::AudioLevelSinkInterface implementation. May be called on any
+  // thread.
+  void OnAudioLevel(uint32_t ssrc,
+                    uint8_t level_dbov,
+                    bool voice_activity) override;
+
+  // Fires SignalAudioMonitor with the current levels. Called periodically on
+  // |monitor_thread| after Start(), and by tests.
+  void Update();
+
+ protected:
+  void OnMessage(rtc::Message* message) override;
+
+ private:
+  struct StreamLevel {
+    // Smoothed level in dB above -127 dBov, in Q8.
+    int32_t smoothed_q8 = 0;
+    int64_t last_packet_ms = 0;
+    bool active = false;
+  };
+
+  rtc::Thread* const monitor_thread_;
+  int rate_ms_ = 0;
+  bool monitoring_ = false;
+  rtc::CriticalSection crit_;
+  std::map<uint32_t, StreamLevel> streams_ GUARDED_BY(crit_);
+};
+
+}  // namespace cricket
+
+#endif  // WEBRTC_PC_RTPAUDIOLEVELMONITOR_H_
@@ -0,0 +1,150 @@
+/*
+ *  Copyright 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/base/fakeclock.h"
+#include "webrtc/base/gunit.h"
+#include "webrtc/base/thread.h"
+#include "webrtc/pc/audiomonitor.h"
+#include "webrtc/pc/currentspeakermonitor.h"
+#include "webrtc/pc/rtpaudiolevelmonitor.h"
+
+namespace cricket {
+
+static const uint32_t kSsrc1 = 1001;
+static const uint32_t kSsrc2 = 1002;
+static const uint8_t kLoudDbov = 20;
+static const uint8_t kQuietDbov = 30;
+static const uint8_t kSilentDbov = 127;
+// Between the activation and deactivation thresholds.
+static const uint8_t kHysteresisDbov = 50;
+static const int kPacketMs = 20;
+
+class RtpAudioLevelMonitorTest : public testing::Test,
+                                 public sigslot::has_slots<> {
+ public:
+  RtpAudioLevelMonitorTest() : monitor_(rtc::Thread::Current()) {
+    clock_.AdvanceTime(rtc::TimeDelta::FromSeconds(1));
+    monitor_.SignalAudioMonitor.connect(
+        this, &RtpAudioLevelMonitorTest::OnAudioMonitor);
+  }
+
+  void OnAudioMonitor(AudioSourceContext* context, const AudioInfo& info) {
+    EXPECT_EQ(&monitor_, context);
+    info_ = info;
+  }
+
+  void OnSpeakerUpdate(CurrentSpeakerMonitor* monitor, uint32_t ssrc) {
+    current_speaker_ = ssrc;
+  }
+
+ protected:
+  void ConnectSpeakerMonitor(CurrentSpeakerMonitor* speaker_monitor) {
+    speaker_monitor->SignalUpdate.connect(
+        this, &RtpAudioLevelMonitorTest::OnSpeakerUpdate);
+  }
+
+  // Sends |num_packets| packets of each stream, with the given levels.
+  void SendPackets(int num_packets, uint8_t level1, uint8_t level2) {
+    for (int i = 0; i < num_packets; ++i) {
+      monitor_.OnAudioLevel(kSsrc1, level1, true);
+      monitor_.OnAudioLevel(kSsrc2, level2, true);
+      clock_.AdvanceTime(rtc::TimeDelta::FromMilliseconds(kPacketMs));
+    }
+  }
+
+  rtc::ScopedFakeClock clock_;
+  RtpAudioLevelMonitor monitor_;
+  AudioInfo info_;
+  uint32_t current_speaker_ = 0;
+};
+
+TEST_F(RtpAudioLevelMonitorTest, RanksActiveStreams) {
+  SendPackets(10, kQuietDbov, kLoudDbov);
+  monitor_.Update();
+  ASSERT_EQ(2u, info_.active_streams.size());
+  EXPECT_EQ(kSsrc2, info_.active_streams[0].first);
+  EXPECT_EQ(kSsrc1, info_.active_streams[1].first);
+  EXPECT_GT(info_.active_streams[0].second, info_.active_streams[1].second);
+  EXPECT_EQ(info_.active_streams[0].second, info_.output_level);
+
+  // Swap the levels; the ranking follows once the smoothed levels cross.
+  SendPackets(50, kLoudDbov, kQuietDbov);
+  monitor_.Update();
+  ASSERT_EQ(2u, info_.active_streams.size());
+  EXPECT_EQ(kSsrc1, info_.active_streams[0].first);
+}
+
+TEST_F(RtpAudioLevelMonitorTest, SilentStreamsAreNotActive) {
+  SendPackets(10, kSilentDbov, kLoudDbov);
+  monitor_.Update();
+  ASSERT_EQ(1u, info_.active_streams.size());
+  EXPECT_EQ(kSsrc2, info_.active_streams[0].first);
+}
+
+TEST_F(RtpAudioLevelMonitorTest, Hysteresis) {
+  // A level between the thresholds does not activate a stream...
+  SendPackets(50, kHysteresisDbov, kSilentDbov);
+  monitor_.Update();
+  EXPECT_TRUE(info_.active_streams.empty());
+
+  // ...but keeps an active one active.
+  SendPackets(10, kLoudDbov, kSilentDbov);
+  monitor_.Update();
+  ASSERT_EQ(1u, info_.active_streams.size());
+  SendPackets(100, kHysteresisDbov, kSilentDbov);
+  monitor_.Update();
+  ASSERT_EQ(1u, info_.active_streams.size());
+  EXPECT_EQ(kSsrc1, info_.active_streams[0].first);
+
+  // Silence deactivates it, after the release of the smoothing.
+  SendPackets(1, kSilentDbov, kSilentDbov);
+  monitor_.Update();
+  EXPECT_EQ(1u, info_.active_streams.size());
+  SendPackets(100, kSilentDbov, kSilentDbov);
+  monitor_.Update();
+  EXPECT_TRUE(info_.active_streams.empty());
+}
+
+TEST_F(RtpAudioLevelMonitorTest, StreamsWithoutPacketsTimeOut) {
+  SendPackets(10, kLoudDbov, kLoudDbov);
+  monitor_.Update();
+  EXPECT_EQ(2u, info_.active_streams.size());
+
+  for (int i = 0; i < 100; ++i) {
+    monitor_.OnAudioLevel(kSsrc2, kLoudDbov, true);
+    clock_.AdvanceTime(rtc::TimeDelta::FromMilliseconds(kPacketMs));
+  }
+  monitor_.Update();
+  ASSERT_EQ(1u, info_.active_streams.size());
+  EXPECT_EQ(kSsrc2, info_.active_streams[0].first);
+}
+
+TEST_F(RtpAudioLevelMonitorTest, DrivesCurrentSpeakerMonitor) {
+  CurrentSpeakerMonitor speaker_monitor(&monitor_);
+  speaker_monitor.set_min_time_between_switches(0);
+  speaker_monitor.Start();
+  ConnectSpeakerMonitor(&speaker_monitor);
+
+  // The speaker monitor needs two updates to recognize a speaker.
+  for (int i = 0; i < 2; ++i) {
+    SendPackets(5, kQuietDbov, kLoudDbov);
+    monitor_.Update();
+  }
+  EXPECT_EQ(kSsrc2, current_speaker_);
+
+  for (int i = 0; i < 4; ++i) {
+    SendPackets(25, kLoudDbov, kSilentDbov);
+    monitor_.Update();
+  }
+  EXPECT_EQ(kSsrc1, current_speaker_);
+  speaker_monitor.Stop();
+}
+
+}  // namespace cricket
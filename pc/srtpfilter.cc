@@ -22,6 +22,7 @@
 #include "webrtc/base/checks.h"
 #include "webrtc/base/common.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/base/packet_trace.h"
 #include "webrtc/base/stringencode.h"
 #include "webrtc/base/timeutils.h"
 #include "webrtc/media/base/rtputils.h"
@@ -56,6 +57,17 @@ void ShutdownSrtp() {
 #endif
 }
 
+SrtpCryptoStats& SrtpCryptoStats::operator+=(const SrtpCryptoStats& other) {
+  encrypt_time_ns += other.encrypt_time_ns;
+  decrypt_time_ns += other.decrypt_time_ns;
+  bytes_encrypted += other.bytes_encrypted;
+  bytes_decrypted += other.bytes_decrypted;
+  encrypt_failures += other.encrypt_failures;
+  decrypt_failures += other.decrypt_failures;
+  replay_drops += other.replay_drops;
+  return *this;
+}
+
 SrtpFilter::SrtpFilter()
     : state_(ST_INIT),
       signal_silent_time_in_ms_(0) {
@@ -102,7 +114,7 @@ bool SrtpFilter::SetRtpParams(int send_cs,
   if (!send_session_->SetSend(send_cs, send_key, send_key_len))
     return false;
 
-  if (!recv_session_->SetRecv(recv_cs, recv_key, recv_key_len))
+  if (!SetRecvKey(recv_cs, recv_key, recv_key_len))
     return false;
 
   state_ = ST_ACTIVE;
@@ -194,7 +206,38 @@ bool SrtpFilter::UnprotectRtp(void* p, int in_len, int* out_len) {
     return false;
   }
   RTC_CHECK(recv_session_);
-  return recv_session_->UnprotectRtp(p, in_len, out_len);
+  if (!recv_session_->UnprotectRtp(p, in_len, out_len))
+    return false;
+  rtc::packet_trace::RecordRtp(rtc::packet_trace::Stage::kSrtpUnprotected,
+                               static_cast<const uint8_t*>(p), *out_len);
+  return true;
+}
+
+void SrtpFilter::SetRecvShards(size_t num_shards) {
+  RTC_DCHECK(!IsActive());
+  recv_shards_.clear();
+  for (size_t i = 0; i < num_shards; ++i)
+    recv_shards_.push_back(std::unique_ptr<RecvShard>(new RecvShard()));
+}
+
+bool SrtpFilter::UnprotectRtp(size_t shard,
+                              void* p,
+                              int in_len,
+                              int* out_len) {
+  RTC_DCHECK_LT(shard, recv_shards_.size());
+  RecvShard* recv_shard = recv_shards_[shard].get();
+  rtc::CritScope cs(&recv_shard->crit);
+  // The shard has no session until the filter is active, or after it has been
+  // reset.
+  if (!recv_shard->session) {
+    LOG(LS_WARNING) << "Failed to UnprotectRtp: SRTP not active";
+    return false;
+  }
+  if (!recv_shard->session->UnprotectRtp(p, in_len, out_len))
+    return false;
+  rtc::packet_trace::RecordRtp(rtc::packet_trace::Stage::kSrtpUnprotected,
+                               static_cast<const uint8_t*>(p), *out_len);
+  return true;
 }
 
 bool SrtpFilter::UnprotectRtcp(void* p, int in_len, int* out_len) {
@@ -320,9 +363,27 @@ bool SrtpFilter::DoSetAnswer(const std::vector<CryptoParams>& answer_params,
   return true;
 }
 
+SrtpCryptoStats SrtpFilter::GetCryptoStats() const {
+  SrtpCryptoStats stats = retired_crypto_stats_;
+  for (const SrtpSession* session :
+       {send_session_.get(), recv_session_.get(), send_rtcp_session_.get(),
+        recv_rtcp_session_.get()}) {
+    if (session)
+      stats += session->crypto_stats();
+  }
+  for (const auto& recv_shard : recv_shards_) {
+    rtc::CritScope cs(&recv_shard->crit);
+    if (recv_shard->session)
+      stats += recv_shard->session->crypto_stats();
+  }
+  return stats;
+}
+
 void SrtpFilter::CreateSrtpSessions() {
+  RetireSession(send_session_.get());
   send_session_.reset(new SrtpSession());
   applied_send_params_ = CryptoParams();
+  RetireSession(recv_session_.get());
   recv_session_.reset(new SrtpSession());
   applied_recv_params_ = CryptoParams();
 
@@ -410,9 +471,8 @@ bool SrtpFilter::ApplyParams(const CryptoParams& send_params,
     ret = (send_session_->SetSend(
                rtc::SrtpCryptoSuiteFromName(send_params.cipher_suite),
                send_key.data(), send_key.size()) &&
-           recv_session_->SetRecv(
-               rtc::SrtpCryptoSuiteFromName(recv_params.cipher_suite),
-               recv_key.data(), recv_key.size()));
+           SetRecvKey(rtc::SrtpCryptoSuiteFromName(recv_params.cipher_suite),
+                      recv_key.data(), recv_key.size()));
   }
   if (ret) {
     LOG(LS_INFO) << "SRTP activated with negotiated parameters:"
@@ -426,13 +486,56 @@ bool SrtpFilter::ApplyParams(const CryptoParams& send_params,
   return ret;
 }
 
+bool SrtpFilter::SetRecvKey(int cs, const uint8_t* key, size_t len) {
+  if (!recv_session_->SetRecv(cs, key, len)) {
+    ResetRecvShards();
+    return false;
+  }
+  for (const auto& recv_shard : recv_shards_) {
+    // The shard sessions are used on other threads, so they don't repeat their
+    // errors to SignalSrtpError, which isn't thread safe. Callers log them.
+    std::unique_ptr<SrtpSession> session(new SrtpSession());
+    if (!session->SetRecv(cs, key, len)) {
+      ResetRecvShards();
+      return false;
+    }
+    session->DetachFromThread();
+    {
+      rtc::CritScope lock(&recv_shard->crit);
+      recv_shard->session.swap(session);
+    }
+    // The previous session is destroyed outside of the lock.
+    RetireSession(session.get());
+  }
+  return true;
+}
+
+void SrtpFilter::ResetRecvShards() {
+  for (const auto& recv_shard : recv_shards_) {
+    std::unique_ptr<SrtpSession> session;
+    {
+      rtc::CritScope cs(&recv_shard->crit);
+      recv_shard->session.swap(session);
+    }
+    RetireSession(session.get());
+  }
+}
+
+void SrtpFilter::RetireSession(const SrtpSession* session) {
+  if (session)
+    retired_crypto_stats_ += session->crypto_stats();
+}
+
 bool SrtpFilter::ResetParams() {
   offer_params_.clear();
   state_ = ST_INIT;
-  send_session_ = nullptr;
-  recv_session_ = nullptr;
-  send_rtcp_session_ = nullptr;
-  recv_rtcp_session_ = nullptr;
+  for (std::unique_ptr<SrtpSession>* session :
+       {&send_session_, &recv_session_, &send_rtcp_session_,
+        &recv_rtcp_session_}) {
+    RetireSession(session->get());
+    session->reset();
+  }
+  ResetRecvShards();
   LOG(LS_INFO) << "SRTP reset to init state";
   return true;
 }
@@ -507,7 +610,9 @@ bool SrtpSession::ProtectRtp(void* p, int in_len, int max_len, int* out_len) {
   }
 
   *out_len = in_len;
+  int64_t start_ns = rtc::SystemTimeNanos();
   int err = srtp_protect(session_, p, out_len);
+  AddCryptoResult(true, err, in_len, start_ns);
   uint32_t ssrc;
   if (GetRtpSsrc(p, in_len, &ssrc)) {
     srtp_stat_->AddProtectRtpResult(ssrc, err);
@@ -550,7 +655,9 @@ bool SrtpSession::ProtectRtcp(void* p, int in_len, int max_len, int* out_len) {
   }
 
   *out_len = in_len;
+  int64_t start_ns = rtc::SystemTimeNanos();
   int err = srtp_protect_rtcp(session_, p, out_len);
+  AddCryptoResult(true, err, in_len, start_ns);
   srtp_stat_->AddProtectRtcpResult(err);
   if (err != srtp_err_status_ok) {
     LOG(LS_WARNING) << "Failed to protect SRTCP packet, err=" << err;
@@ -567,7 +674,9 @@ bool SrtpSession::UnprotectRtp(void* p, int in_len, int* out_len) {
   }
 
   *out_len = in_len;
+  int64_t start_ns = rtc::SystemTimeNanos();
   int err = srtp_unprotect(session_, p, out_len);
+  AddCryptoResult(false, err, in_len, start_ns);
   uint32_t ssrc;
   if (GetRtpSsrc(p, in_len, &ssrc)) {
     srtp_stat_->AddUnprotectRtpResult(ssrc, err);
@@ -587,7 +696,9 @@ bool SrtpSession::UnprotectRtcp(void* p, int in_len, int* out_len) {
   }
 
   *out_len = in_len;
+  int64_t start_ns = rtc::SystemTimeNanos();
   int err = srtp_unprotect_rtcp(session_, p, out_len);
+  AddCryptoResult(false, err, in_len, start_ns);
   srtp_stat_->AddUnprotectRtcpResult(err);
   if (err != srtp_err_status_ok) {
     LOG(LS_WARNING) << "Failed to unprotect SRTCP packet, err=" << err;
@@ -647,6 +758,29 @@ void SrtpSession::set_signal_silent_time(int signal_silent_time_in_ms) {
   srtp_stat_->set_signal_silent_time(signal_silent_time_in_ms);
 }
 
+void SrtpSession::AddCryptoResult(bool encrypt,
+                                  int err,
+                                  int len,
+                                  int64_t start_ns) {
+  int64_t elapsed_ns = rtc::SystemTimeNanos() - start_ns;
+  if (encrypt) {
+    crypto_stats_.encrypt_time_ns += elapsed_ns;
+    if (err == srtp_err_status_ok)
+      crypto_stats_.bytes_encrypted += len;
+    else
+      ++crypto_stats_.encrypt_failures;
+  } else {
+    crypto_stats_.decrypt_time_ns += elapsed_ns;
+    if (err == srtp_err_status_ok)
+      crypto_stats_.bytes_decrypted += len;
+    else if (err == srtp_err_status_replay_fail ||
+             err == srtp_err_status_replay_old)
+      ++crypto_stats_.replay_drops;
+    else
+      ++crypto_stats_.decrypt_failures;
+  }
+}
+
 bool SrtpSession::SetKey(int type, int cs, const uint8_t* key, size_t len) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
   if (session_) {
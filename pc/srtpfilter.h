@@ -22,6 +22,7 @@
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/sigslotrepeater.h"
 #include "webrtc/base/sslstreamadapter.h"
+#include "webrtc/base/thread_annotations.h"
 #include "webrtc/base/thread_checker.h"
 #include "webrtc/media/base/cryptoparams.h"
 #include "webrtc/p2p/base/sessiondescription.h"
@@ -38,6 +39,22 @@ class SrtpStat;
 void InitializeSrtp();
 void ShutdownSrtp();
 
+// Cumulative cost of the packets transformed by SRTP sessions.
+struct SrtpCryptoStats {
+  SrtpCryptoStats& operator+=(const SrtpCryptoStats& other);
+
+  int64_t encrypt_time_ns = 0;
+  int64_t decrypt_time_ns = 0;
+  // Size of the packets transformed successfully, before the transformation.
+  uint64_t bytes_encrypted = 0;
+  uint64_t bytes_decrypted = 0;
+  uint32_t encrypt_failures = 0;
+  // Packets that failed to decrypt for other reasons than a replay.
+  uint32_t decrypt_failures = 0;
+  // Received packets dropped as replayed or too old.
+  uint32_t replay_drops = 0;
+};
+
 // Class to transform SRTP to/from RTP.
 // Initialize by calling SetSend with the local security params, then call
 // SetRecv once the remote security params are received. At that point
@@ -109,6 +126,16 @@ class SrtpFilter {
   bool UnprotectRtp(void* data, int in_len, int* out_len);
   bool UnprotectRtcp(void* data, int in_len, int* out_len);
 
+  // Keeps |num_shards| more receive sessions, keyed like the main one, so
+  // that RTP packets can be unprotected on |num_shards| threads at once. Must
+  // be called before the filter is activated.
+  void SetRecvShards(size_t num_shards);
+  size_t num_recv_shards() const { return recv_shards_.size(); }
+  // Decrypts/verifies an RTP packet with the receive session of |shard|. Can
+  // be called on any thread, but the packets of an SSRC must always go to the
+  // same shard, since each session tracks the replay state of its streams.
+  bool UnprotectRtp(size_t shard, void* data, int in_len, int* out_len);
+
   // Returns rtp auth params from srtp context.
   bool GetRtpAuthParams(uint8_t** key, int* key_len, int* tag_len);
 
@@ -118,6 +145,11 @@ class SrtpFilter {
   // Update the silent threshold (in ms) for signaling errors.
   void set_signal_silent_time(int signal_silent_time_in_ms);
 
+  // Returns the cost of all the packets transformed since the filter was
+  // created, including by sessions since replaced. Must be called on the
+  // thread that protects packets.
+  SrtpCryptoStats GetCryptoStats() const;
+
   bool ResetParams();
 
   sigslot::repeater3<uint32_t, Mode, Error> SignalSrtpError;
@@ -135,6 +167,11 @@ class SrtpFilter {
                        CryptoParams* selected_params);
   bool ApplyParams(const CryptoParams& send_params,
                    const CryptoParams& recv_params);
+  // Keys the receive session and the sessions of the shards.
+  bool SetRecvKey(int cs, const uint8_t* key, size_t len);
+  void ResetRecvShards();
+  // Keeps the stats of |session|, which is about to be destroyed.
+  void RetireSession(const SrtpSession* session);
   static bool ParseKeyParams(const std::string& params,
                              uint8_t* key,
                              size_t len);
@@ -172,6 +209,13 @@ class SrtpFilter {
   std::unique_ptr<SrtpSession> recv_rtcp_session_;
   CryptoParams applied_send_params_;
   CryptoParams applied_recv_params_;
+  SrtpCryptoStats retired_crypto_stats_;
+
+  struct RecvShard {
+    rtc::CriticalSection crit;
+    std::unique_ptr<SrtpSession> session GUARDED_BY(crit);
+  };
+  std::vector<std::unique_ptr<RecvShard>> recv_shards_;
 };
 
 // Class that wraps a libSRTP session.
@@ -207,9 +251,14 @@ class SrtpSession {
 
   int GetSrtpOverhead() const;
 
+  const SrtpCryptoStats& crypto_stats() const { return crypto_stats_; }
+
   // Update the silent threshold (in ms) for signaling errors.
   void set_signal_silent_time(int signal_silent_time_in_ms);
 
+  // Lets the session be used on another thread than the one it was keyed on.
+  void DetachFromThread() { thread_checker_.DetachFromThread(); }
+
   // Calls srtp_shutdown if it's initialized.
   static bool Init();
   static void Terminate();
@@ -219,6 +268,9 @@ class SrtpSession {
 
  private:
   bool SetKey(int type, int cs, const uint8_t* key, size_t len);
+  // Accounts for a packet of |len| bytes that srtp_(un)protect started to
+  // transform at |start_ns| and finished with |err|.
+  void AddCryptoResult(bool encrypt, int err, int len, int64_t start_ns);
     // Returns send stream current packet index from srtp db.
   bool GetSendStreamPacketIndex(void* data, int in_len, int64_t* index);
 
@@ -230,6 +282,7 @@ class SrtpSession {
   int rtp_auth_tag_len_;
   int rtcp_auth_tag_len_;
   std::unique_ptr<SrtpStat> srtp_stat_;
+  SrtpCryptoStats crypto_stats_;
   static bool inited_;
   static rtc::GlobalLockPod lock_;
   int last_send_seq_num_;
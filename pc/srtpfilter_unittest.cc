@@ -14,7 +14,9 @@
 #include "webrtc/base/byteorder.h"
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/gunit.h"
+#include "webrtc/base/packet_trace.h"
 #include "webrtc/base/thread.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/media/base/cryptoparams.h"
 #include "webrtc/media/base/fakertp.h"
 #include "webrtc/p2p/base/sessiondescription.h"
@@ -560,6 +562,146 @@ TEST_F(SrtpFilterTest, TestProtect_SetParamsDirect_AES_CM_128_HMAC_SHA1_32) {
   TestProtectUnprotect(CS_AES_CM_128_HMAC_SHA1_32, CS_AES_CM_128_HMAC_SHA1_32);
 }
 
+// Test that the receive sessions of the shards unprotect packets on other
+// threads, with the keys of the main receive session.
+TEST_F(SrtpFilterTest, TestUnprotectRtpWithShards) {
+  f2_.SetRecvShards(2);
+  EXPECT_EQ(2u, f2_.num_recv_shards());
+  EXPECT_TRUE(f1_.SetRtpParams(rtc::SRTP_AES128_CM_SHA1_80, kTestKey1,
+                               kTestKeyLen, rtc::SRTP_AES128_CM_SHA1_80,
+                               kTestKey2, kTestKeyLen));
+  EXPECT_TRUE(f2_.SetRtpParams(rtc::SRTP_AES128_CM_SHA1_80, kTestKey2,
+                               kTestKeyLen, rtc::SRTP_AES128_CM_SHA1_80,
+                               kTestKey1, kTestKeyLen));
+  std::unique_ptr<rtc::Thread> thread = rtc::Thread::Create();
+  ASSERT_TRUE(thread->Start());
+
+  char protected_packet[sizeof(kPcmuFrame) + 10];
+  char rtp_packet[sizeof(kPcmuFrame) + 10];
+  int rtp_len = sizeof(kPcmuFrame), protected_len, out_len;
+  memcpy(protected_packet, kPcmuFrame, rtp_len);
+  EXPECT_TRUE(f1_.ProtectRtp(protected_packet, rtp_len,
+                             sizeof(protected_packet), &protected_len));
+  auto unprotect_on_thread = [&](size_t shard) {
+    memcpy(rtp_packet, protected_packet, protected_len);
+    return thread->Invoke<bool>(RTC_FROM_HERE, [&] {
+      return f2_.UnprotectRtp(shard, rtp_packet, protected_len, &out_len);
+    });
+  };
+  EXPECT_TRUE(unprotect_on_thread(1));
+  EXPECT_EQ(rtp_len, out_len);
+  EXPECT_EQ(0, memcmp(rtp_packet, kPcmuFrame, rtp_len));
+  // Each shard has its own replay state, which is why the packets of an SSRC
+  // must always go to the same shard.
+  EXPECT_FALSE(unprotect_on_thread(1));
+  EXPECT_TRUE(unprotect_on_thread(0));
+
+  EXPECT_TRUE(f2_.ResetParams());
+  EXPECT_FALSE(unprotect_on_thread(1));
+}
+
+static size_t g_num_unprotected_events = 0;
+
+static void CountUnprotectedEvents(const rtc::packet_trace::Event* events,
+                                   size_t num_events) {
+  for (size_t i = 0; i < num_events; ++i) {
+    if (events[i].stage == rtc::packet_trace::Stage::kSrtpUnprotected)
+      ++g_num_unprotected_events;
+  }
+}
+
+// Test that unprotecting on a shard records the packet trace stage, like the
+// main receive session does.
+TEST_F(SrtpFilterTest, TestUnprotectRtpWithShardsRecordsPacketTrace) {
+  f2_.SetRecvShards(1);
+  EXPECT_TRUE(f1_.SetRtpParams(rtc::SRTP_AES128_CM_SHA1_80, kTestKey1,
+                               kTestKeyLen, rtc::SRTP_AES128_CM_SHA1_80,
+                               kTestKey2, kTestKeyLen));
+  EXPECT_TRUE(f2_.SetRtpParams(rtc::SRTP_AES128_CM_SHA1_80, kTestKey2,
+                               kTestKeyLen, rtc::SRTP_AES128_CM_SHA1_80,
+                               kTestKey1, kTestKeyLen));
+  rtc::packet_trace::SetExportCallback(&CountUnprotectedEvents);
+  rtc::packet_trace::Export();
+  g_num_unprotected_events = 0;
+  rtc::packet_trace::Start(1);
+
+  char rtp_packet[sizeof(kPcmuFrame) + 10];
+  int rtp_len = sizeof(kPcmuFrame), out_len;
+  memcpy(rtp_packet, kPcmuFrame, rtp_len);
+  EXPECT_TRUE(
+      f1_.ProtectRtp(rtp_packet, rtp_len, sizeof(rtp_packet), &out_len));
+  EXPECT_TRUE(f2_.UnprotectRtp(0, rtp_packet, out_len, &out_len));
+  rtc::packet_trace::Export();
+  EXPECT_EQ(1u, g_num_unprotected_events);
+
+  rtc::packet_trace::Stop();
+  rtc::packet_trace::SetExportCallback(nullptr);
+}
+
+// Test that the cost of the transformed packets is accumulated, including by
+// the sessions that were reset.
+TEST_F(SrtpFilterTest, TestCryptoStats) {
+  EXPECT_TRUE(f1_.SetRtpParams(rtc::SRTP_AES128_CM_SHA1_80, kTestKey1,
+                               kTestKeyLen, rtc::SRTP_AES128_CM_SHA1_80,
+                               kTestKey2, kTestKeyLen));
+  EXPECT_TRUE(f2_.SetRtpParams(rtc::SRTP_AES128_CM_SHA1_80, kTestKey2,
+                               kTestKeyLen, rtc::SRTP_AES128_CM_SHA1_80,
+                               kTestKey1, kTestKeyLen));
+  char protected_packet[sizeof(kPcmuFrame) + 10];
+  char rtp_packet[sizeof(kPcmuFrame) + 10];
+  int rtp_len = sizeof(kPcmuFrame), protected_len, out_len;
+  memcpy(protected_packet, kPcmuFrame, rtp_len);
+  EXPECT_TRUE(f1_.ProtectRtp(protected_packet, rtp_len,
+                             sizeof(protected_packet), &protected_len));
+  for (int i = 0; i < 2; ++i) {
+    memcpy(rtp_packet, protected_packet, protected_len);
+    f2_.UnprotectRtp(rtp_packet, protected_len, &out_len);
+  }
+  // A packet that fails authentication.
+  memcpy(rtp_packet, protected_packet, protected_len);
+  rtc::SetBE16(reinterpret_cast<uint8_t*>(rtp_packet) + 2, 2);
+  EXPECT_FALSE(f2_.UnprotectRtp(rtp_packet, protected_len, &out_len));
+
+  cricket::SrtpCryptoStats stats = f1_.GetCryptoStats();
+  EXPECT_EQ(static_cast<uint64_t>(rtp_len), stats.bytes_encrypted);
+  EXPECT_EQ(0u, stats.bytes_decrypted);
+  EXPECT_EQ(0u, stats.encrypt_failures);
+  stats = f2_.GetCryptoStats();
+  EXPECT_EQ(0u, stats.bytes_encrypted);
+  EXPECT_EQ(static_cast<uint64_t>(protected_len), stats.bytes_decrypted);
+  EXPECT_EQ(1u, stats.replay_drops);
+  EXPECT_EQ(1u, stats.decrypt_failures);
+  EXPECT_GE(stats.decrypt_time_ns, 0);
+
+  EXPECT_TRUE(f2_.ResetParams());
+  stats = f2_.GetCryptoStats();
+  EXPECT_EQ(static_cast<uint64_t>(protected_len), stats.bytes_decrypted);
+  EXPECT_EQ(1u, stats.replay_drops);
+}
+
+// Test that the crypto time is measured within a batch sharing one reading of
+// the clock, such as the packets of one socket read.
+TEST_F(SrtpFilterTest, TestCryptoStatsTimeWithCachedTime) {
+  EXPECT_TRUE(f1_.SetRtpParams(rtc::SRTP_AES128_CM_SHA1_80, kTestKey1,
+                               kTestKeyLen, rtc::SRTP_AES128_CM_SHA1_80,
+                               kTestKey2, kTestKeyLen));
+  EXPECT_TRUE(f2_.SetRtpParams(rtc::SRTP_AES128_CM_SHA1_80, kTestKey2,
+                               kTestKeyLen, rtc::SRTP_AES128_CM_SHA1_80,
+                               kTestKey1, kTestKeyLen));
+  rtc::ScopedCachedTime cached_time;
+  char rtp_packet[sizeof(kPcmuFrame) + 10];
+  int rtp_len = sizeof(kPcmuFrame), protected_len, out_len;
+  for (int i = 0; i < 10; ++i) {
+    memcpy(rtp_packet, kPcmuFrame, rtp_len);
+    rtc::SetBE16(reinterpret_cast<uint8_t*>(rtp_packet) + 2, i + 1);
+    EXPECT_TRUE(f1_.ProtectRtp(rtp_packet, rtp_len, sizeof(rtp_packet),
+                               &protected_len));
+    EXPECT_TRUE(f2_.UnprotectRtp(rtp_packet, protected_len, &out_len));
+  }
+  EXPECT_GT(f1_.GetCryptoStats().encrypt_time_ns, 0);
+  EXPECT_GT(f2_.GetCryptoStats().decrypt_time_ns, 0);
+}
+
 // Test directly setting the params with bogus keys
 TEST_F(SrtpFilterTest, TestSetParamsKeyTooShort) {
   EXPECT_FALSE(f1_.SetRtpParams(rtc::SRTP_AES128_CM_SHA1_80, kTestKey1,
@@ -0,0 +1,47 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/pc/srtpworkerpool.h"
+
+#include <string>
+
+#include "webrtc/base/checks.h"
+
+namespace cricket {
+
+namespace {
+
+void DoNothing() {}
+
+}  // namespace
+
+SrtpWorkerPool::SrtpWorkerPool(size_t num_threads) {
+  RTC_DCHECK_GT(num_threads, 0u);
+  for (size_t i = 0; i < num_threads; ++i) {
+    std::unique_ptr<rtc::Thread> thread = rtc::Thread::Create();
+    thread->SetName("SrtpWorker" + std::to_string(i), nullptr);
+    RTC_CHECK(thread->Start());
+    threads_.push_back(std::move(thread));
+  }
+}
+
+SrtpWorkerPool::~SrtpWorkerPool() {
+  for (const auto& thread : threads_)
+    thread->Stop();
+}
+
+void SrtpWorkerPool::Flush() {
+  for (const auto& thread : threads_) {
+    RTC_DCHECK(!thread->IsCurrent());
+    thread->Invoke<void>(RTC_FROM_HERE, &DoNothing);
+  }
+}
+
+}  // namespace cricket
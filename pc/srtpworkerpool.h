@@ -0,0 +1,48 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_PC_SRTPWORKERPOOL_H_
+#define WEBRTC_PC_SRTPWORKERPOOL_H_
+
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/thread.h"
+
+namespace cricket {
+
+// Threads that unprotect received SRTP packets off the network thread, which
+// otherwise saturates first on transports with many bundled streams. All the
+// packets of an SSRC are unprotected on the same thread, so each stream keeps
+// its packet order while different streams are unprotected in parallel.
+class SrtpWorkerPool {
+ public:
+  explicit SrtpWorkerPool(size_t num_threads);
+  ~SrtpWorkerPool();
+
+  size_t size() const { return threads_.size(); }
+  // Index of the thread that unprotects the packets of |ssrc|.
+  size_t GetIndex(uint32_t ssrc) const { return ssrc % threads_.size(); }
+  rtc::Thread* thread(size_t index) const { return threads_[index].get(); }
+
+  // Blocks until the tasks posted to the threads so far have run. Must not be
+  // called from one of the threads.
+  void Flush();
+
+ private:
+  std::vector<std::unique_ptr<rtc::Thread>> threads_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(SrtpWorkerPool);
+};
+
+}  // namespace cricket
+
+#endif  // WEBRTC_PC_SRTPWORKERPOOL_H_
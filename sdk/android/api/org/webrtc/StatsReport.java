@@ -10,6 +10,9 @@
 
 package org.webrtc;
 
+import java.nio.ByteBuffer;
+import java.nio.charset.Charset;
+
 /** Java version of webrtc::StatsReport. */
 public class StatsReport {
   /** Java version of webrtc::StatsReport::Value. */
@@ -42,6 +45,34 @@ public class StatsReport {
     this.values = values;
   }
 
+  private static final Charset UTF_8 = Charset.forName("UTF-8");
+
+  /**
+   * Decodes the reports serialized by the native StatsObserverWrapper. Called from native code,
+   * which owns the memory of |buffer| only until this returns.
+   */
+  static StatsReport[] fromByteBuffer(ByteBuffer buffer) {
+    final StatsReport[] reports = new StatsReport[buffer.getInt()];
+    for (int i = 0; i < reports.length; ++i) {
+      final String id = readString(buffer);
+      final String type = readString(buffer);
+      final double timestamp = buffer.getDouble();
+      final Value[] values = new Value[buffer.getInt()];
+      for (int j = 0; j < values.length; ++j) {
+        final String name = readString(buffer);
+        values[j] = new Value(name, readString(buffer));
+      }
+      reports[i] = new StatsReport(id, type, timestamp, values);
+    }
+    return reports;
+  }
+
+  private static String readString(ByteBuffer buffer) {
+    final byte[] bytes = new byte[buffer.getInt()];
+    buffer.get(bytes);
+    return new String(bytes, UTF_8);
+  }
+
   public String toString() {
     StringBuilder builder = new StringBuilder();
     builder.append("id: ")
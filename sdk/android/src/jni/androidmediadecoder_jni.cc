@@ -124,6 +124,9 @@ class MediaCodecVideoDecoder : public webrtc::VideoDecoder,
   DecodedImageCallback* callback_;
   int frames_received_;  // Number of frames received by decoder.
   int frames_decoded_;  // Number of frames decoded by decoder.
+  // Number of decoded frames copied out of output byte buffers, which happens
+  // when no EGL context is set for decoding to texture.
+  int frames_copied_;
   // Number of decoded frames for which log information is displayed.
   int frames_decoded_logged_;
   int64_t start_time_ms_;  // Start time for statistics.
@@ -317,6 +320,7 @@ void MediaCodecVideoDecoder::ResetVariables() {
   key_frame_required_ = true;
   frames_received_ = 0;
   frames_decoded_ = 0;
+  frames_copied_ = 0;
   frames_decoded_logged_ = kMaxDecodedLogFrames;
   start_time_ms_ = rtc::TimeMillis();
   current_frames_ = 0;
@@ -449,7 +453,8 @@ int32_t MediaCodecVideoDecoder::ReleaseOnCodecThread() {
   CheckOnCodecThread();
   JNIEnv* jni = AttachCurrentThreadIfNeeded();
   ALOGD << "DecoderReleaseOnCodecThread: Frames received: " <<
-      frames_received_ << ". Frames decoded: " << frames_decoded_;
+      frames_received_ << ". Frames decoded: " << frames_decoded_ <<
+      ". Frames copied: " << frames_copied_;
   ScopedLocalRefFrame local_ref_frame(jni);
   for (size_t i = 0; i < input_buffers_.size(); i++) {
     jni->DeleteGlobalRef(input_buffers_[i]);
@@ -809,6 +814,7 @@ bool MediaCodecVideoDecoder::DeliverPendingOutputs(
                          width, height);
     }
     frame_buffer = i420_buffer;
+    ++frames_copied_;
 
     // Return output byte buffer back to codec.
     jni->CallVoidMethod(
@@ -847,6 +853,7 @@ bool MediaCodecVideoDecoder::DeliverPendingOutputs(
         ". Fps: " << current_fps <<
         ". DecTime: " << (current_decoding_time_ms_ / current_frames_) <<
         ". DelayTime: " << (current_delay_time_ms_ / current_frames_) <<
+        ". Copied: " << frames_copied_ <<
         " for last " << statistic_time_ms << " ms.";
     start_time_ms_ = rtc::TimeMillis();
     current_frames_ = 0;
@@ -224,6 +224,9 @@ class MediaCodecVideoEncoder : public webrtc::VideoEncoder,
   int frames_received_;  // Number of frames received by encoder.
   int frames_encoded_;  // Number of frames encoded by encoder.
   int frames_dropped_media_encoder_;  // Number of frames dropped by encoder.
+  // Number of frames copied into encoder input buffers instead of being
+  // encoded from texture.
+  int frames_copied_;
   // Number of dropped frames caused by full queue.
   int consecutive_full_queue_frame_drops_;
   int64_t stat_start_time_ms_;  // Start time for statistics.
@@ -545,6 +548,7 @@ int32_t MediaCodecVideoEncoder::InitEncodeOnCodecThread(
   frames_received_ = 0;
   frames_encoded_ = 0;
   frames_dropped_media_encoder_ = 0;
+  frames_copied_ = 0;
   consecutive_full_queue_frame_drops_ = 0;
   current_timestamp_us_ = 0;
   stat_start_time_ms_ = rtc::TimeMillis();
@@ -837,6 +841,7 @@ bool MediaCodecVideoEncoder::EncodeByteBufferOnCodecThread(JNIEnv* jni,
       frame.video_frame_buffer()->StrideV(),
       yuv_buffer, width_, width_, height_, encoder_fourcc_))
       << "ConvertFromI420 failed";
+  ++frames_copied_;
 
   bool encode_status = jni->CallBooleanMethod(*j_media_codec_video_encoder_,
                                               j_encode_buffer_method_,
@@ -890,7 +895,8 @@ int32_t MediaCodecVideoEncoder::ReleaseOnCodecThread() {
   JNIEnv* jni = AttachCurrentThreadIfNeeded();
   ALOGD << "EncoderReleaseOnCodecThread: Frames received: " <<
       frames_received_ << ". Encoded: " << frames_encoded_ <<
-      ". Dropped: " << frames_dropped_media_encoder_;
+      ". Dropped: " << frames_dropped_media_encoder_ <<
+      ". Copied: " << frames_copied_;
   ScopedLocalRefFrame local_ref_frame(jni);
   for (size_t i = 0; i < input_buffers_.size(); ++i)
     jni->DeleteGlobalRef(input_buffers_[i]);
@@ -1170,6 +1176,7 @@ void MediaCodecVideoEncoder::LogStatistics(bool force_log) {
         ", fps: " << current_fps <<
         ", encTime: " << (current_encoding_time_ms_ / current_frames_divider) <<
         ". QP: " << (current_acc_qp_ / current_frames_divider) <<
+        ". Copied frames: " << frames_copied_ <<
         " for last " << statistic_time_ms << " ms.";
     stat_start_time_ms_ = rtc::TimeMillis();
     current_frames_ = 0;
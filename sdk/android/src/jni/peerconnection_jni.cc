@@ -59,6 +59,7 @@
 #include "webrtc/api/videosourceproxy.h"
 #include "webrtc/api/webrtcsdp.h"
 #include "webrtc/base/bind.h"
+#include "webrtc/base/bytebuffer.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/event_tracer.h"
 #include "webrtc/base/logging.h"
@@ -719,85 +720,90 @@ class DataChannelObserverWrapper : public DataChannelObserver {
   const jmethodID j_buffer_ctor_;
 };
 
+// Method IDs used to deliver stats, looked up once since ClassReferenceHolder
+// keeps their classes loaded for the lifetime of the library.
+struct StatsMethodIds {
+  explicit StatsMethodIds(JNIEnv* jni)
+      : j_stats_report_class(FindClass(jni, "org/webrtc/StatsReport")),
+        j_from_byte_buffer_id(GetStaticMethodID(
+            jni, j_stats_report_class, "fromByteBuffer",
+            "(Ljava/nio/ByteBuffer;)[Lorg/webrtc/StatsReport;")),
+        j_on_complete_id(GetMethodID(
+            jni, FindClass(jni, "org/webrtc/StatsObserver"), "onComplete",
+            "([Lorg/webrtc/StatsReport;)V")) {}
+
+  const jclass j_stats_report_class;
+  const jmethodID j_from_byte_buffer_id;
+  const jmethodID j_on_complete_id;
+};
+
+static const StatsMethodIds& GetStatsMethodIds(JNIEnv* jni) {
+  static const StatsMethodIds ids(jni);
+  return ids;
+}
+
 // Adapter for a Java StatsObserver presenting a C++ StatsObserver and
-// dispatching the callback from C++ back to Java.
+// dispatching the callback from C++ back to Java. The reports are serialized
+// into a single direct ByteBuffer that StatsReport.fromByteBuffer() decodes,
+// instead of creating every Java object through separate JNI calls.
 class StatsObserverWrapper : public StatsObserver {
  public:
   StatsObserverWrapper(JNIEnv* jni, jobject j_observer)
-      : j_observer_global_(jni, j_observer),
-        j_observer_class_(jni, GetObjectClass(jni, j_observer)),
-        j_stats_report_class_(jni, FindClass(jni, "org/webrtc/StatsReport")),
-        j_stats_report_ctor_(GetMethodID(
-            jni, *j_stats_report_class_, "<init>",
-            "(Ljava/lang/String;Ljava/lang/String;D"
-            "[Lorg/webrtc/StatsReport$Value;)V")),
-        j_value_class_(jni, FindClass(
-            jni, "org/webrtc/StatsReport$Value")),
-        j_value_ctor_(GetMethodID(
-            jni, *j_value_class_, "<init>",
-            "(Ljava/lang/String;Ljava/lang/String;)V")) {
-  }
+      : j_observer_global_(jni, j_observer) {}
 
   virtual ~StatsObserverWrapper() {}
 
   void OnCompleteReports(std::unique_ptr<StatsReports> reports) override {
-    ScopedLocalRefFrame local_ref_frame(jni());
-    jobjectArray j_reports = ReportsToJava(jni(), *reports);
-    jmethodID m = GetMethodID(jni(), *j_observer_class_, "onComplete",
-                              "([Lorg/webrtc/StatsReport;)V");
-    jni()->CallVoidMethod(*j_observer_global_, m, j_reports);
-    CHECK_EXCEPTION(jni()) << "error during CallVoidMethod";
+    JNIEnv* jni = AttachCurrentThreadIfNeeded();
+    ScopedLocalRefFrame local_ref_frame(jni);
+    const StatsMethodIds& ids = GetStatsMethodIds(jni);
+    rtc::ByteBufferWriter buffer;
+    ReportsToBuffer(*reports, &buffer);
+    // The Java side decodes the buffer before fromByteBuffer() returns, so it
+    // may point to |buffer| directly.
+    jobject j_buffer = jni->NewDirectByteBuffer(
+        const_cast<char*>(buffer.Data()), buffer.Length());
+    CHECK_EXCEPTION(jni) << "error during NewDirectByteBuffer";
+    jobject j_reports = jni->CallStaticObjectMethod(
+        ids.j_stats_report_class, ids.j_from_byte_buffer_id, j_buffer);
+    CHECK_EXCEPTION(jni) << "error during CallStaticObjectMethod";
+    jni->CallVoidMethod(*j_observer_global_, ids.j_on_complete_id, j_reports);
+    CHECK_EXCEPTION(jni) << "error during CallVoidMethod";
   }
 
  private:
-  jobjectArray ReportsToJava(
-      JNIEnv* jni, const StatsReports& reports) {
-    jobjectArray reports_array = jni->NewObjectArray(
-        reports.size(), *j_stats_report_class_, NULL);
-    int i = 0;
+  // Writes the reports in the layout read by StatsReport.fromByteBuffer(),
+  // with integers and doubles in network byte order and strings as UTF-8
+  // prefixed by their length in bytes.
+  static void ReportsToBuffer(const StatsReports& reports,
+                              rtc::ByteBufferWriter* buffer) {
+    buffer->WriteUInt32(static_cast<uint32_t>(reports.size()));
     for (const auto* report : reports) {
-      ScopedLocalRefFrame local_ref_frame(jni);
-      jstring j_id = JavaStringFromStdString(jni, report->id()->ToString());
-      jstring j_type = JavaStringFromStdString(jni, report->TypeToString());
-      jobjectArray j_values = ValuesToJava(jni, report->values());
-      jobject j_report = jni->NewObject(*j_stats_report_class_,
-                                        j_stats_report_ctor_,
-                                        j_id,
-                                        j_type,
-                                        report->timestamp(),
-                                        j_values);
-      jni->SetObjectArrayElement(reports_array, i++, j_report);
+      WriteString(report->id()->ToString(), buffer);
+      WriteString(report->TypeToString(), buffer);
+      double timestamp = report->timestamp();
+      uint64_t timestamp_bits;
+      static_assert(sizeof(timestamp) == sizeof(timestamp_bits),
+                    "double is not 64 bits");
+      memcpy(&timestamp_bits, &timestamp, sizeof(timestamp_bits));
+      buffer->WriteUInt64(timestamp_bits);
+      buffer->WriteUInt32(static_cast<uint32_t>(report->values().size()));
+      for (const auto& it : report->values()) {
+        // Should we use the '.name' enum value here instead of converting the
+        // name to a string?
+        WriteString(it.second->display_name(), buffer);
+        WriteString(it.second->ToString(), buffer);
+      }
     }
-    return reports_array;
   }
 
-  jobjectArray ValuesToJava(JNIEnv* jni, const StatsReport::Values& values) {
-    jobjectArray j_values = jni->NewObjectArray(
-        values.size(), *j_value_class_, NULL);
-    int i = 0;
-    for (const auto& it : values) {
-      ScopedLocalRefFrame local_ref_frame(jni);
-      // Should we use the '.name' enum value here instead of converting the
-      // name to a string?
-      jstring j_name = JavaStringFromStdString(jni, it.second->display_name());
-      jstring j_value = JavaStringFromStdString(jni, it.second->ToString());
-      jobject j_element_value =
-          jni->NewObject(*j_value_class_, j_value_ctor_, j_name, j_value);
-      jni->SetObjectArrayElement(j_values, i++, j_element_value);
-    }
-    return j_values;
-  }
-
-  JNIEnv* jni() {
-    return AttachCurrentThreadIfNeeded();
+  static void WriteString(const std::string& str,
+                          rtc::ByteBufferWriter* buffer) {
+    buffer->WriteUInt32(static_cast<uint32_t>(str.size()));
+    buffer->WriteString(str);
   }
 
   const ScopedGlobalRef<jobject> j_observer_global_;
-  const ScopedGlobalRef<jclass> j_observer_class_;
-  const ScopedGlobalRef<jclass> j_stats_report_class_;
-  const jmethodID j_stats_report_ctor_;
-  const ScopedGlobalRef<jclass> j_value_class_;
-  const jmethodID j_value_ctor_;
 };
 
 // Wrapper dispatching rtc::VideoSinkInterface to a Java VideoRenderer
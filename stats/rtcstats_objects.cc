@@ -523,7 +523,11 @@ WEBRTC_RTCSTATS_IMPL(
     &burst_discard_rate,
     &gap_loss_rate,
     &gap_discard_rate,
-    &frames_decoded);
+    &frames_decoded,
+    &media_crypto_decrypt_time,
+    &media_crypto_bytes_decrypted,
+    &media_crypto_auth_failures,
+    &media_crypto_replay_drops);
 
 RTCInboundRTPStreamStats::RTCInboundRTPStreamStats(
     const std::string& id, int64_t timestamp_us)
@@ -548,7 +552,11 @@ RTCInboundRTPStreamStats::RTCInboundRTPStreamStats(
       burst_discard_rate("burstDiscardRate"),
       gap_loss_rate("gapLossRate"),
       gap_discard_rate("gapDiscardRate"),
-      frames_decoded("framesDecoded") {
+      frames_decoded("framesDecoded"),
+      media_crypto_decrypt_time("mediaCryptoDecryptTime"),
+      media_crypto_bytes_decrypted("mediaCryptoBytesDecrypted"),
+      media_crypto_auth_failures("mediaCryptoAuthFailures"),
+      media_crypto_replay_drops("mediaCryptoReplayDrops") {
 }
 
 RTCInboundRTPStreamStats::RTCInboundRTPStreamStats(
@@ -569,7 +577,11 @@ RTCInboundRTPStreamStats::RTCInboundRTPStreamStats(
       burst_discard_rate(other.burst_discard_rate),
       gap_loss_rate(other.gap_loss_rate),
       gap_discard_rate(other.gap_discard_rate),
-      frames_decoded(other.frames_decoded) {
+      frames_decoded(other.frames_decoded),
+      media_crypto_decrypt_time(other.media_crypto_decrypt_time),
+      media_crypto_bytes_decrypted(other.media_crypto_bytes_decrypted),
+      media_crypto_auth_failures(other.media_crypto_auth_failures),
+      media_crypto_replay_drops(other.media_crypto_replay_drops) {
 }
 
 RTCInboundRTPStreamStats::~RTCInboundRTPStreamStats() {
@@ -581,7 +593,19 @@ WEBRTC_RTCSTATS_IMPL(
     &bytes_sent,
     &target_bitrate,
     &round_trip_time,
-    &frames_encoded);
+    &frames_encoded,
+    &pacer_queue_time_p50,
+    &pacer_queue_time_p95,
+    &pacer_queue_time_p99,
+    &media_encrypt_time_p50,
+    &media_encrypt_time_p95,
+    &media_encrypt_time_p99,
+    &send_delay_p50,
+    &send_delay_p95,
+    &send_delay_p99,
+    &media_crypto_encrypt_time,
+    &media_crypto_bytes_encrypted,
+    &media_crypto_encrypt_failures);
 
 RTCOutboundRTPStreamStats::RTCOutboundRTPStreamStats(
     const std::string& id, int64_t timestamp_us)
@@ -595,7 +619,19 @@ RTCOutboundRTPStreamStats::RTCOutboundRTPStreamStats(
       bytes_sent("bytesSent"),
       target_bitrate("targetBitrate"),
       round_trip_time("roundTripTime"),
-      frames_encoded("framesEncoded") {
+      frames_encoded("framesEncoded"),
+      pacer_queue_time_p50("pacerQueueTimeP50"),
+      pacer_queue_time_p95("pacerQueueTimeP95"),
+      pacer_queue_time_p99("pacerQueueTimeP99"),
+      media_encrypt_time_p50("mediaEncryptTimeP50"),
+      media_encrypt_time_p95("mediaEncryptTimeP95"),
+      media_encrypt_time_p99("mediaEncryptTimeP99"),
+      send_delay_p50("sendDelayP50"),
+      send_delay_p95("sendDelayP95"),
+      send_delay_p99("sendDelayP99"),
+      media_crypto_encrypt_time("mediaCryptoEncryptTime"),
+      media_crypto_bytes_encrypted("mediaCryptoBytesEncrypted"),
+      media_crypto_encrypt_failures("mediaCryptoEncryptFailures") {
 }
 
 RTCOutboundRTPStreamStats::RTCOutboundRTPStreamStats(
@@ -605,7 +641,19 @@ RTCOutboundRTPStreamStats::RTCOutboundRTPStreamStats(
       bytes_sent(other.bytes_sent),
       target_bitrate(other.target_bitrate),
       round_trip_time(other.round_trip_time),
-      frames_encoded(other.frames_encoded) {
+      frames_encoded(other.frames_encoded),
+      pacer_queue_time_p50(other.pacer_queue_time_p50),
+      pacer_queue_time_p95(other.pacer_queue_time_p95),
+      pacer_queue_time_p99(other.pacer_queue_time_p99),
+      media_encrypt_time_p50(other.media_encrypt_time_p50),
+      media_encrypt_time_p95(other.media_encrypt_time_p95),
+      media_encrypt_time_p99(other.media_encrypt_time_p99),
+      send_delay_p50(other.send_delay_p50),
+      send_delay_p95(other.send_delay_p95),
+      send_delay_p99(other.send_delay_p99),
+      media_crypto_encrypt_time(other.media_crypto_encrypt_time),
+      media_crypto_bytes_encrypted(other.media_crypto_bytes_encrypted),
+      media_crypto_encrypt_failures(other.media_crypto_encrypt_failures) {
 }
 
 RTCOutboundRTPStreamStats::~RTCOutboundRTPStreamStats() {
@@ -618,7 +666,14 @@ WEBRTC_RTCSTATS_IMPL(RTCTransportStats, RTCStats, "transport",
     &dtls_state,
     &selected_candidate_pair_id,
     &local_certificate_id,
-    &remote_certificate_id);
+    &remote_certificate_id,
+    &srtp_encrypt_time,
+    &srtp_decrypt_time,
+    &srtp_bytes_encrypted,
+    &srtp_bytes_decrypted,
+    &srtp_encrypt_failures,
+    &srtp_decrypt_failures,
+    &srtp_replay_drops);
 
 RTCTransportStats::RTCTransportStats(
     const std::string& id, int64_t timestamp_us)
@@ -634,7 +689,14 @@ RTCTransportStats::RTCTransportStats(
       dtls_state("dtlsState"),
       selected_candidate_pair_id("selectedCandidatePairId"),
       local_certificate_id("localCertificateId"),
-      remote_certificate_id("remoteCertificateId") {
+      remote_certificate_id("remoteCertificateId"),
+      srtp_encrypt_time("srtpEncryptTime"),
+      srtp_decrypt_time("srtpDecryptTime"),
+      srtp_bytes_encrypted("srtpBytesEncrypted"),
+      srtp_bytes_decrypted("srtpBytesDecrypted"),
+      srtp_encrypt_failures("srtpEncryptFailures"),
+      srtp_decrypt_failures("srtpDecryptFailures"),
+      srtp_replay_drops("srtpReplayDrops") {
 }
 
 RTCTransportStats::RTCTransportStats(
@@ -646,7 +708,14 @@ RTCTransportStats::RTCTransportStats(
       dtls_state(other.dtls_state),
       selected_candidate_pair_id(other.selected_candidate_pair_id),
       local_certificate_id(other.local_certificate_id),
-      remote_certificate_id(other.remote_certificate_id) {
+      remote_certificate_id(other.remote_certificate_id),
+      srtp_encrypt_time(other.srtp_encrypt_time),
+      srtp_decrypt_time(other.srtp_decrypt_time),
+      srtp_bytes_encrypted(other.srtp_bytes_encrypted),
+      srtp_bytes_decrypted(other.srtp_bytes_decrypted),
+      srtp_encrypt_failures(other.srtp_encrypt_failures),
+      srtp_decrypt_failures(other.srtp_decrypt_failures),
+      srtp_replay_drops(other.srtp_replay_drops) {
 }
 
 RTCTransportStats::~RTCTransportStats() {
@@ -11,7 +11,7 @@
 #ifndef WEBRTC_SYSTEM_WRAPPERS_INCLUDE_RTP_TO_NTP_ESTIMATOR_H_
 #define WEBRTC_SYSTEM_WRAPPERS_INCLUDE_RTP_TO_NTP_ESTIMATOR_H_
 
-#include <list>
+#include <vector>
 
 #include "webrtc/system_wrappers/include/ntp_time.h"
 #include "webrtc/typedefs.h"
@@ -56,8 +56,13 @@ class RtpToNtpEstimator {
 
  private:
   void UpdateParameters();
+  const RtcpMeasurement& newest_measurement() const;
+  const RtcpMeasurement& oldest_measurement() const;
 
-  std::list<RtcpMeasurement> measurements_;
+  // Ring of the most recent RTCP SR reports. Reserved up front so that new
+  // reports overwrite the oldest entry instead of allocating.
+  std::vector<RtcpMeasurement> measurements_;
+  size_t newest_index_;
   Parameters params_;
 };
 
@@ -10,7 +10,9 @@
 #include "webrtc/system_wrappers/include/field_trial.h"
 #include "webrtc/system_wrappers/include/field_trial_default.h"
 
+#include <map>
 #include <string>
+#include <utility>
 
 // Simple field trial implementation, which allows client to
 // specify desired flags in InitFieldTrialsFromString.
@@ -18,15 +20,14 @@ namespace webrtc {
 namespace field_trial {
 
 static const char *trials_init_string = NULL;
+// |trials_init_string| split into name/value pairs, so that lookups don't
+// parse the string again. Heap allocated to avoid an exit-time destructor.
+static std::map<std::string, std::string>* trials = NULL;
 
-std::string FindFullName(const std::string& name) {
-  if (trials_init_string == NULL)
-    return std::string();
-
-  std::string trials_string(trials_init_string);
-  if (trials_string.empty())
-    return std::string();
-
+static std::map<std::string, std::string>* ParseTrials(
+    const std::string& trials_string) {
+  std::map<std::string, std::string>* parsed =
+      new std::map<std::string, std::string>();
   static const char kPersistentStringSeparator = '/';
   size_t next_item = 0;
   while (next_item < trials_string.length()) {
@@ -47,15 +48,27 @@ std::string FindFullName(const std::string& name) {
         field_value_end - field_name_end - 1);
     next_item = field_value_end + 1;
 
-    if (name == field_name)
-      return field_value;
+    // The first occurrence of a name wins, as it did when searching.
+    parsed->insert(std::make_pair(field_name, field_value));
   }
-  return std::string();
+  return parsed;
+}
+
+std::string FindFullName(const std::string& name) {
+  if (trials == NULL)
+    return std::string();
+
+  auto it = trials->find(name);
+  if (it == trials->end())
+    return std::string();
+  return it->second;
 }
 
 // Optionally initialize field trial from a string.
 void InitFieldTrialsFromString(const char* trials_string) {
   trials_init_string = trials_string;
+  delete trials;
+  trials = trials_string ? ParseTrials(trials_string) : NULL;
 }
 
 const char* GetFieldTrialString() {
@@ -10,7 +10,9 @@
 #include "webrtc/system_wrappers/include/metrics_default.h"
 
 #include <algorithm>
+#include <limits>
 
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/thread_annotations.h"
 #include "webrtc/system_wrappers/include/metrics.h"
@@ -28,72 +30,188 @@ namespace {
 // linearly/exponentially spaced buckets) if samples are logged more frequently.
 const int kMaxSampleMapSize = 300;
 
+// Number of occurrences of each sample value, in an open addressing hash table
+// that is updated without locks or allocations. Values are never removed, so
+// a table is cleared only while no samples are being added to it.
+class SampleTable {
+ public:
+  SampleTable() { Clear(); }
+
+  void Add(int sample) {
+    RTC_DCHECK_NE(kEmpty, sample);
+    int index = Hash(sample);
+    for (int probe = 0; probe < kSize; ++probe) {
+      Slot& slot = slots_[index];
+      int value = rtc::AtomicOps::AcquireLoad(&slot.value);
+      if (value == kEmpty) {
+        // The value isn't in the table. Claim the slot for it, unless the
+        // table already holds the maximum number of values. Racing adders
+        // can exceed the limit by a few values, which the table has room for.
+        if (rtc::AtomicOps::AcquireLoad(&num_values_) >= kMaxSampleMapSize)
+          return;
+        value = rtc::AtomicOps::CompareAndSwap(&slot.value, kEmpty, sample);
+        if (value == kEmpty) {
+          rtc::AtomicOps::Increment(&num_values_);
+          value = sample;
+        }
+      }
+      if (value == sample) {
+        rtc::AtomicOps::Increment(&slot.count);
+        return;
+      }
+      index = (index + 1) % kSize;
+    }
+  }
+
+  bool empty() const { return rtc::AtomicOps::AcquireLoad(&num_values_) == 0; }
+
+  // Adds the number of occurrences of each value to |samples|.
+  void CopyTo(std::map<int, int>* samples) const {
+    for (const Slot& slot : slots_) {
+      int value = rtc::AtomicOps::AcquireLoad(&slot.value);
+      int count = rtc::AtomicOps::AcquireLoad(&slot.count);
+      if (value != kEmpty && count > 0)
+        (*samples)[value] += count;
+    }
+  }
+
+  void Clear() {
+    for (Slot& slot : slots_) {
+      rtc::AtomicOps::ReleaseStore(&slot.value, kEmpty);
+      rtc::AtomicOps::ReleaseStore(&slot.count, 0);
+    }
+    rtc::AtomicOps::ReleaseStore(&num_values_, 0);
+  }
+
+ private:
+  // Room for kMaxSampleMapSize values with short probe sequences.
+  static const int kSize = 512;
+  // Sample values are clamped to [min - 1, max] and can't take this value.
+  static const int kEmpty = std::numeric_limits<int>::min();
+
+  struct Slot {
+    volatile int value;
+    volatile int count;
+  };
+
+  static int Hash(int sample) {
+    // Fibonacci hashing spreads consecutive values over the table.
+    return static_cast<int>((static_cast<uint32_t>(sample) * 2654435769u) >>
+                            23);
+  }
+
+  Slot slots_[kSize];
+  volatile int num_values_;
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(SampleTable);
+};
+
+const int SampleTable::kSize;
+const int SampleTable::kEmpty;
+
 class RtcHistogram {
  public:
   RtcHistogram(const std::string& name, int min, int max, int bucket_count)
-      : min_(min), max_(max), info_(name, min, max, bucket_count) {
+      : min_(min),
+        max_(max),
+        info_(name, min, max, bucket_count),
+        active_table_(nullptr) {
     RTC_DCHECK_GT(bucket_count, 0);
   }
 
+  ~RtcHistogram() { delete active_table_; }
+
+  // Called on media threads, and therefore doesn't take locks. Only the first
+  // sample allocates memory.
   void Add(int sample) {
     sample = std::min(sample, max_);
     sample = std::max(sample, min_ - 1);  // Underflow bucket.
 
-    rtc::CritScope cs(&crit_);
-    if (info_.samples.size() == kMaxSampleMapSize &&
-        info_.samples.find(sample) == info_.samples.end()) {
-      return;
+    SampleTable* table = rtc::AtomicOps::AcquireLoadPtr(&active_table_);
+    if (!table) {
+      SampleTable* new_table = new SampleTable();
+      table = rtc::AtomicOps::CompareAndSwapPtr(
+          &active_table_, static_cast<SampleTable*>(nullptr), new_table);
+      if (table) {
+        delete new_table;
+      } else {
+        table = new_table;
+      }
     }
-    ++info_.samples[sample];
+    table->Add(sample);
   }
 
   // Returns a copy (or nullptr if there are no samples) and clears samples.
   std::unique_ptr<SampleInfo> GetAndReset() {
     rtc::CritScope cs(&crit_);
-    if (info_.samples.empty())
+    SampleTable* table = rtc::AtomicOps::AcquireLoadPtr(&active_table_);
+    if (!table || table->empty())
       return nullptr;
 
+    // New samples go to the spare table from now on. The retired table is
+    // cleared when it becomes active again, which is after the next period of
+    // samples; by then no thread still adds to it. A sample that is added
+    // while the tables are switched may be lost.
+    if (spare_table_) {
+      spare_table_->Clear();
+    } else {
+      spare_table_.reset(new SampleTable());
+    }
+    rtc::AtomicOps::CompareAndSwapPtr(&active_table_, table,
+                                      spare_table_.release());
+    spare_table_.reset(table);
+
     SampleInfo* copy =
         new SampleInfo(info_.name, info_.min, info_.max, info_.bucket_count);
-
-    std::swap(info_.samples, copy->samples);
-
+    table->CopyTo(&copy->samples);
     return std::unique_ptr<SampleInfo>(copy);
   }
 
   const std::string& name() const { return info_.name; }
 
   // Functions only for testing.
-  void Reset() {
-    rtc::CritScope cs(&crit_);
-    info_.samples.clear();
-  }
+  void Reset() { GetAndReset(); }
 
   int NumEvents(int sample) const {
-    rtc::CritScope cs(&crit_);
-    const auto it = info_.samples.find(sample);
-    return (it == info_.samples.end()) ? 0 : it->second;
+    std::map<int, int> samples = GetSamples();
+    const auto it = samples.find(sample);
+    return (it == samples.end()) ? 0 : it->second;
   }
 
   int NumSamples() const {
     int num_samples = 0;
-    rtc::CritScope cs(&crit_);
-    for (const auto& sample : info_.samples) {
+    for (const auto& sample : GetSamples()) {
       num_samples += sample.second;
     }
     return num_samples;
   }
 
   int MinSample() const {
-    rtc::CritScope cs(&crit_);
-    return (info_.samples.empty()) ? -1 : info_.samples.begin()->first;
+    std::map<int, int> samples = GetSamples();
+    return (samples.empty()) ? -1 : samples.begin()->first;
   }
 
  private:
+  std::map<int, int> GetSamples() const {
+    std::map<int, int> samples;
+    rtc::CritScope cs(&crit_);
+    // Only replaced under |crit_|, once it has been allocated.
+    SampleTable* table = active_table_;
+    if (table)
+      table->CopyTo(&samples);
+    return samples;
+  }
+
+  // Serializes the functions that read or switch the tables. Not taken by
+  // Add.
   rtc::CriticalSection crit_;
   const int min_;
   const int max_;
-  SampleInfo info_ GUARDED_BY(crit_);
+  // The name and limits, without samples.
+  const SampleInfo info_;
+  // The table that samples are added to, allocated by the first sample.
+  SampleTable* volatile active_table_;
+  std::unique_ptr<SampleTable> spare_table_ GUARDED_BY(crit_);
 
   RTC_DISALLOW_COPY_AND_ASSIGN(RtcHistogram);
 };
@@ -8,6 +8,10 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/system_wrappers/include/metrics.h"
 #include "webrtc/system_wrappers/include/metrics_default.h"
 #include "webrtc/test/gtest.h"
@@ -47,6 +51,16 @@ int NumEvents(const std::string& name,
 
   return it_sample->second;
 }
+
+const char kThreadsName[] = "Threads";
+const int kSamplesPerThread = 1000;
+const int kNumValues = 50;
+
+bool AddSamples(void*) {
+  for (int i = 0; i < kSamplesPerThread; ++i)
+    RTC_HISTOGRAM_COUNTS_1000(kThreadsName, i % kNumValues);
+  return false;
+}
 }  // namespace
 
 class MetricsDefaultTest : public ::testing::Test {
@@ -160,4 +174,39 @@ TEST_F(MetricsDefaultTest, TestMinMaxBucket) {
   EXPECT_EQ(1u, histograms.begin()->second->samples.size());
 }
 
+TEST_F(MetricsDefaultTest, LimitsNumberOfSampleValues) {
+  const std::string kName = "Values";
+  for (int i = 0; i < 400; ++i)
+    RTC_HISTOGRAM_COUNTS_100000(kName, i);
+  // Samples with new values are dropped once 300 values are stored.
+  EXPECT_EQ(300, metrics::NumSamples(kName));
+  EXPECT_EQ(0, metrics::NumEvents(kName, 399));
+  RTC_HISTOGRAM_COUNTS_100000(kName, 10);
+  EXPECT_EQ(2, metrics::NumEvents(kName, 10));
+
+  // Reset makes room for new values.
+  metrics::Reset();
+  RTC_HISTOGRAM_COUNTS_100000(kName, 399);
+  EXPECT_EQ(1, metrics::NumEvents(kName, 399));
+}
+
+TEST_F(MetricsDefaultTest, AddsSamplesFromManyThreads) {
+  const int kNumThreads = 4;
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+  for (int i = 0; i < kNumThreads; ++i) {
+    threads.emplace_back(
+        new rtc::PlatformThread(&AddSamples, nullptr, "AddSamples"));
+    threads.back()->Start();
+  }
+  for (auto& thread : threads)
+    thread->Stop();
+
+  EXPECT_EQ(kNumThreads * kSamplesPerThread,
+            metrics::NumSamples(kThreadsName));
+  for (int value = 0; value < kNumValues; ++value) {
+    EXPECT_EQ(kNumThreads * kSamplesPerThread / kNumValues,
+              metrics::NumEvents(kThreadsName, value));
+  }
+}
+
 }  // namespace webrtc
@@ -46,7 +46,8 @@ bool CompensateForWrapAround(uint32_t new_timestamp,
   return true;
 }
 
-bool Contains(const std::list<RtpToNtpEstimator::RtcpMeasurement>& measurements,
+bool Contains(
+    const std::vector<RtpToNtpEstimator::RtcpMeasurement>& measurements,
               const RtpToNtpEstimator::RtcpMeasurement& other) {
   for (const auto& measurement : measurements) {
     if (measurement.IsEqual(other))
@@ -55,7 +56,8 @@ bool Contains(const std::list<RtpToNtpEstimator::RtcpMeasurement>& measurements,
   return false;
 }
 
-bool IsValid(const std::list<RtpToNtpEstimator::RtcpMeasurement>& measurements,
+bool IsValid(
+    const std::vector<RtpToNtpEstimator::RtcpMeasurement>& measurements,
              const RtpToNtpEstimator::RtcpMeasurement& other) {
   if (!other.ntp_time.Valid())
     return false;
@@ -93,20 +95,35 @@ bool RtpToNtpEstimator::RtcpMeasurement::IsEqual(
 }
 
 // Class for converting an RTP timestamp to the NTP domain.
-RtpToNtpEstimator::RtpToNtpEstimator() {}
+RtpToNtpEstimator::RtpToNtpEstimator() : newest_index_(0) {
+  measurements_.reserve(kNumRtcpReportsToUse);
+}
 RtpToNtpEstimator::~RtpToNtpEstimator() {}
 
+const RtpToNtpEstimator::RtcpMeasurement&
+RtpToNtpEstimator::newest_measurement() const {
+  return measurements_[newest_index_];
+}
+
+const RtpToNtpEstimator::RtcpMeasurement&
+RtpToNtpEstimator::oldest_measurement() const {
+  // Until the ring is full, reports are appended in arrival order.
+  if (measurements_.size() < kNumRtcpReportsToUse)
+    return measurements_.front();
+  return measurements_[(newest_index_ + 1) % kNumRtcpReportsToUse];
+}
+
 void RtpToNtpEstimator::UpdateParameters() {
   if (measurements_.size() != kNumRtcpReportsToUse)
     return;
 
-  int64_t timestamp_new = measurements_.front().rtp_timestamp;
-  int64_t timestamp_old = measurements_.back().rtp_timestamp;
+  int64_t timestamp_new = newest_measurement().rtp_timestamp;
+  int64_t timestamp_old = oldest_measurement().rtp_timestamp;
   if (!CompensateForWrapAround(timestamp_new, timestamp_old, &timestamp_new))
     return;
 
-  int64_t ntp_ms_new = measurements_.front().ntp_time.ToMs();
-  int64_t ntp_ms_old = measurements_.back().ntp_time.ToMs();
+  int64_t ntp_ms_new = newest_measurement().ntp_time.ToMs();
+  int64_t ntp_ms_old = oldest_measurement().ntp_time.ToMs();
 
   if (!CalculateFrequency(ntp_ms_new, timestamp_new, ntp_ms_old, timestamp_old,
                           &params_.frequency_khz)) {
@@ -132,11 +149,14 @@ bool RtpToNtpEstimator::UpdateMeasurements(uint32_t ntp_secs,
     return false;
   }
 
-  // Insert new RTCP SR report.
-  if (measurements_.size() == kNumRtcpReportsToUse)
-    measurements_.pop_back();
-
-  measurements_.push_front(measurement);
+  // Insert new RTCP SR report, replacing the oldest one if the ring is full.
+  if (measurements_.size() < kNumRtcpReportsToUse) {
+    measurements_.push_back(measurement);
+    newest_index_ = measurements_.size() - 1;
+  } else {
+    newest_index_ = (newest_index_ + 1) % kNumRtcpReportsToUse;
+    measurements_[newest_index_] = measurement;
+  }
   *new_rtcp_sr = true;
 
   // List updated, calculate new parameters.
@@ -149,7 +169,7 @@ bool RtpToNtpEstimator::Estimate(int64_t rtp_timestamp,
   if (!params_.calculated || measurements_.empty())
     return false;
 
-  uint32_t rtp_timestamp_old = measurements_.back().rtp_timestamp;
+  uint32_t rtp_timestamp_old = oldest_measurement().rtp_timestamp;
   int64_t rtp_timestamp_unwrapped;
   if (!CompensateForWrapAround(rtp_timestamp, rtp_timestamp_old,
                                &rtp_timestamp_unwrapped)) {
@@ -16,12 +16,18 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include "webrtc/call/call.h"
 #include "webrtc/system_wrappers/include/clock.h"
 
 namespace webrtc {
 
+namespace {
+// The number of delivered or dropped packets kept for reuse.
+const size_t kMaxFreePackets = 100;
+}  // namespace
+
 FakeNetworkPipe::FakeNetworkPipe(Clock* clock,
                                  const FakeNetworkPipe::Config& config)
     : FakeNetworkPipe(clock, config, 1) {}
@@ -36,8 +42,7 @@ FakeNetworkPipe::FakeNetworkPipe(Clock* clock,
       dropped_packets_(0),
       sent_packets_(0),
       total_packet_delay_(0),
-      bursting_(false),
-      next_process_time_(clock_->TimeInMilliseconds()) {
+      bursting_(false) {
   double prob_loss = config.loss_percent / 100.0;
   if (config_.avg_burst_loss_length == -1) {
     // Uniform loss
@@ -106,8 +111,14 @@ void FakeNetworkPipe::SendPacket(const uint8_t* data, size_t data_length) {
     network_start_time = capacity_link_.back()->arrival_time();
 
   int64_t arrival_time = network_start_time + capacity_delay_ms;
-  NetworkPacket* packet = new NetworkPacket(data, data_length, time_now,
-                                            arrival_time);
+  NetworkPacket* packet;
+  if (free_packets_.empty()) {
+    packet = new NetworkPacket(data, data_length, time_now, arrival_time);
+  } else {
+    packet = free_packets_.back().release();
+    free_packets_.pop_back();
+    packet->Reset(data, data_length, time_now, arrival_time);
+  }
   capacity_link_.push(packet);
 }
 
@@ -131,7 +142,7 @@ int FakeNetworkPipe::AverageDelay() {
 
 void FakeNetworkPipe::Process() {
   int64_t time_now = clock_->TimeInMilliseconds();
-  std::queue<NetworkPacket*> packets_to_deliver;
+  std::vector<NetworkPacket*> packets_to_deliver;
   {
     rtc::CritScope crit(&lock_);
     // Check the capacity link first.
@@ -146,7 +157,7 @@ void FakeNetworkPipe::Process() {
       if ((bursting_ && random_.Rand<double>() < prob_loss_bursting_) ||
           (!bursting_ && random_.Rand<double>() < prob_start_bursting_)) {
         bursting_ = true;
-        delete packet;
+        RecyclePacket(packet);
         continue;
       } else {
         bursting_ = false;
@@ -164,8 +175,6 @@ void FakeNetworkPipe::Process() {
             (*delay_link_.rbegin())->arrival_time() - packet->arrival_time();
       }
       packet->IncrementArrivalTime(arrival_time_jitter);
-      if (packet->arrival_time() < next_process_time_)
-        next_process_time_ = packet->arrival_time();
       delay_link_.insert(packet);
     }
 
@@ -174,7 +183,7 @@ void FakeNetworkPipe::Process() {
            time_now >= (*delay_link_.begin())->arrival_time()) {
       // Deliver this packet.
       NetworkPacket* packet = *delay_link_.begin();
-      packets_to_deliver.push(packet);
+      packets_to_deliver.push_back(packet);
       delay_link_.erase(delay_link_.begin());
       // |time_now| might be later than when the packet should have arrived, due
       // to NetworkProcess being called too late. For stats, use the time it
@@ -183,21 +192,38 @@ void FakeNetworkPipe::Process() {
     }
     sent_packets_ += packets_to_deliver.size();
   }
-  while (!packets_to_deliver.empty()) {
-    NetworkPacket* packet = packets_to_deliver.front();
-    packets_to_deliver.pop();
+  if (packets_to_deliver.empty())
+    return;
+  for (NetworkPacket* packet : packets_to_deliver) {
     packet_receiver_->DeliverPacket(MediaType::ANY, packet->data(),
                                     packet->data_length(), PacketTime());
-    delete packet;
   }
+  rtc::CritScope crit(&lock_);
+  for (NetworkPacket* packet : packets_to_deliver)
+    RecyclePacket(packet);
+}
+
+void FakeNetworkPipe::RecyclePacket(NetworkPacket* packet) {
+  if (free_packets_.size() < kMaxFreePackets)
+    free_packets_.emplace_back(packet);
+  else
+    delete packet;
 }
 
 int64_t FakeNetworkPipe::TimeUntilNextProcess() const {
   rtc::CritScope crit(&lock_);
   const int64_t kDefaultProcessIntervalMs = 5;
-  if (capacity_link_.empty() || delay_link_.empty())
+  if (capacity_link_.empty() && delay_link_.empty())
     return kDefaultProcessIntervalMs;
-  return std::max<int64_t>(next_process_time_ - clock_->TimeInMilliseconds(),
+  // Wake up when the next packet leaves either link, instead of polling.
+  int64_t next_process_time = std::numeric_limits<int64_t>::max();
+  if (!capacity_link_.empty())
+    next_process_time = capacity_link_.front()->arrival_time();
+  if (!delay_link_.empty()) {
+    next_process_time = std::min(next_process_time,
+                                 (*delay_link_.begin())->arrival_time());
+  }
+  return std::max<int64_t>(next_process_time - clock_->TimeInMilliseconds(),
                            0);
 }
 
@@ -15,6 +15,7 @@
 #include <set>
 #include <string.h>
 #include <queue>
+#include <vector>
 
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/criticalsection.h"
@@ -33,11 +34,24 @@ class NetworkPacket {
                 size_t length,
                 int64_t send_time,
                 int64_t arrival_time)
-      : data_(new uint8_t[length]),
-        data_length_(length),
-        send_time_(send_time),
-        arrival_time_(arrival_time) {
+      : data_capacity_(0) {
+    Reset(data, length, send_time, arrival_time);
+  }
+
+  // Replaces the contents of the packet, reusing its buffer if it is large
+  // enough.
+  void Reset(const uint8_t* data,
+             size_t length,
+             int64_t send_time,
+             int64_t arrival_time) {
+    if (length > data_capacity_) {
+      data_.reset(new uint8_t[length]);
+      data_capacity_ = length;
+    }
     memcpy(data_.get(), data, length);
+    data_length_ = length;
+    send_time_ = send_time;
+    arrival_time_ = arrival_time;
   }
 
   uint8_t* data() const { return data_.get(); }
@@ -51,10 +65,12 @@ class NetworkPacket {
  private:
   // The packet data.
   std::unique_ptr<uint8_t[]> data_;
+  // Allocated size of data_.
+  size_t data_capacity_;
   // Length of data_.
   size_t data_length_;
   // The time the packet was sent out on the network.
-  const int64_t send_time_;
+  int64_t send_time_;
   // The time the packet should arrive at the receiver.
   int64_t arrival_time_;
 };
@@ -110,6 +126,10 @@ class FakeNetworkPipe {
   size_t sent_packets() { return sent_packets_; }
 
  private:
+  // Keeps |packet| in |free_packets_| for reuse, or deletes it if there are
+  // enough free packets already. Must be called with |lock_| held.
+  void RecyclePacket(NetworkPacket* packet);
+
   Clock* const clock_;
   rtc::CriticalSection lock_;
   PacketReceiver* packet_receiver_;
@@ -126,6 +146,10 @@ class FakeNetworkPipe {
   };
   std::multiset<NetworkPacket*, PacketArrivalTimeComparator> delay_link_;
 
+  // Packets that have been delivered or dropped, reused by SendPacket instead
+  // of allocating a new packet and buffer for every packet sent.
+  std::vector<std::unique_ptr<NetworkPacket>> free_packets_;
+
   // Link configuration.
   Config config_;
 
@@ -144,8 +168,6 @@ class FakeNetworkPipe {
   // The probability to drop a burst of packets.
   double prob_start_bursting_;
 
-  int64_t next_process_time_;
-
   RTC_DISALLOW_COPY_AND_ASSIGN(FakeNetworkPipe);
 };
 
@@ -330,6 +330,41 @@ TEST_F(FakeNetworkPipeTest, ChangingCapacityWithPacketsInPipeTest) {
   pipe->Process();
 }
 
+// Verify that the pipe asks to be processed when the next packet leaves a link
+// rather than at a fixed interval.
+TEST_F(FakeNetworkPipeTest, TimeUntilNextProcessFollowsPackets) {
+  FakeNetworkPipe::Config config;
+  config.link_capacity_kbps = 80;
+  config.queue_delay_ms = 50;
+  std::unique_ptr<FakeNetworkPipe> pipe(
+      new FakeNetworkPipe(&fake_clock_, config));
+  pipe->SetReceiver(receiver_.get());
+
+  const int kPacketSize = 1000;
+  const int packet_time_ms =
+      PacketTimeMs(config.link_capacity_kbps, kPacketSize);
+  SendPackets(pipe.get(), 2, kPacketSize);
+  EXPECT_EQ(packet_time_ms, pipe->TimeUntilNextProcess());
+
+  // The first packet moves to the delay link, which it leaves before the
+  // second packet leaves the capacity link.
+  fake_clock_.AdvanceTimeMilliseconds(packet_time_ms);
+  EXPECT_CALL(*receiver_, DeliverPacket(_, _, _, _)).Times(0);
+  pipe->Process();
+  EXPECT_EQ(config.queue_delay_ms, pipe->TimeUntilNextProcess());
+
+  fake_clock_.AdvanceTimeMilliseconds(config.queue_delay_ms);
+  EXPECT_CALL(*receiver_, DeliverPacket(_, _, _, _)).Times(1);
+  pipe->Process();
+  EXPECT_EQ(packet_time_ms - config.queue_delay_ms,
+            pipe->TimeUntilNextProcess());
+
+  fake_clock_.AdvanceTimeMilliseconds(packet_time_ms);
+  EXPECT_CALL(*receiver_, DeliverPacket(_, _, _, _)).Times(1);
+  pipe->Process();
+  EXPECT_EQ(static_cast<size_t>(2), pipe->sent_packets());
+}
+
 // At first disallow reordering and then allow reordering.
 TEST_F(FakeNetworkPipeTest, DisallowReorderingThenAllowReordering) {
   FakeNetworkPipe::Config config;
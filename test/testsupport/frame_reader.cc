@@ -80,5 +80,45 @@ rtc::scoped_refptr<I420Buffer> FrameReaderImpl::ReadFrame() {
 size_t FrameReaderImpl::FrameLength() { return frame_length_in_bytes_; }
 int FrameReaderImpl::NumberOfFrames() { return number_of_frames_; }
 
+PreloadedFrameReader::PreloadedFrameReader(std::string input_filename,
+                                           int width,
+                                           int height)
+    : file_reader_(input_filename, width, height), next_frame_(0) {}
+
+PreloadedFrameReader::~PreloadedFrameReader() {
+  Close();
+}
+
+bool PreloadedFrameReader::Init() {
+  if (!file_reader_.Init())
+    return false;
+  frames_.reserve(file_reader_.NumberOfFrames());
+  while (rtc::scoped_refptr<I420Buffer> buffer = file_reader_.ReadFrame())
+    frames_.push_back(buffer);
+  file_reader_.Close();
+  next_frame_ = 0;
+  return true;
+}
+
+void PreloadedFrameReader::Close() {
+  file_reader_.Close();
+  frames_.clear();
+  next_frame_ = 0;
+}
+
+rtc::scoped_refptr<I420Buffer> PreloadedFrameReader::ReadFrame() {
+  if (next_frame_ >= frames_.size())
+    return nullptr;
+  return frames_[next_frame_++];
+}
+
+size_t PreloadedFrameReader::FrameLength() {
+  return file_reader_.FrameLength();
+}
+
+int PreloadedFrameReader::NumberOfFrames() {
+  return file_reader_.NumberOfFrames();
+}
+
 }  // namespace test
 }  // namespace webrtc
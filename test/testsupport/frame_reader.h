@@ -14,6 +14,7 @@
 #include <stdio.h>
 
 #include <string>
+#include <vector>
 
 #include "webrtc/base/scoped_ref_ptr.h"
 #include "webrtc/typedefs.h"
@@ -69,6 +70,25 @@ class FrameReaderImpl : public FrameReader {
   FILE* input_file_;
 };
 
+// Reads all the frames of the input file in Init, so that ReadFrame doesn't
+// touch the disk, e.g. when benchmarking an encoder. The returned buffers are
+// shared with the reader.
+class PreloadedFrameReader : public FrameReader {
+ public:
+  PreloadedFrameReader(std::string input_filename, int width, int height);
+  ~PreloadedFrameReader() override;
+  bool Init() override;
+  rtc::scoped_refptr<I420Buffer> ReadFrame() override;
+  void Close() override;
+  size_t FrameLength() override;
+  int NumberOfFrames() override;
+
+ private:
+  FrameReaderImpl file_reader_;
+  std::vector<rtc::scoped_refptr<I420Buffer>> frames_;
+  size_t next_frame_;
+};
+
 }  // namespace test
 }  // namespace webrtc
 
@@ -66,5 +66,20 @@ TEST_F(FrameReaderTest, ReadFrameUninitialized) {
   ASSERT_FALSE(file_reader.ReadFrame());
 }
 
+TEST_F(FrameReaderTest, PreloadedReadFrame) {
+  PreloadedFrameReader frame_reader(temp_filename_, 1, 1);
+  ASSERT_TRUE(frame_reader.Init());
+  EXPECT_EQ(kFrameLength, frame_reader.FrameLength());
+  EXPECT_EQ(1, frame_reader.NumberOfFrames());
+  // The file is no longer needed once loaded.
+  remove(temp_filename_.c_str());
+  rtc::scoped_refptr<VideoFrameBuffer> buffer = frame_reader.ReadFrame();
+  ASSERT_TRUE(buffer);
+  EXPECT_EQ(kInputFileContents[0], buffer->DataY()[0]);
+  EXPECT_EQ(kInputFileContents[1], buffer->DataU()[0]);
+  EXPECT_EQ(kInputFileContents[2], buffer->DataV()[0]);
+  EXPECT_FALSE(frame_reader.ReadFrame());  // End of file
+}
+
 }  // namespace test
 }  // namespace webrtc
@@ -19,6 +19,7 @@
 
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/base/platform_thread.h"
 #include "webrtc/base/rate_statistics.h"
 #include "webrtc/call/audio_receive_stream.h"
 #include "webrtc/call/audio_send_stream.h"
@@ -376,6 +377,8 @@ EventLogAnalyzer::EventLogAnalyzer(const ParsedRtcEventLog& log)
         uint64_t timestamp = parsed_log_.GetTimestamp(i);
         rtp_packets_[stream].push_back(
             LoggedRtpPacket(timestamp, parsed_header, total_length));
+        rtp_packet_sizes_[direction].push_back(
+            LoggedPacketSize(timestamp, total_length));
         break;
       }
       case ParsedRtcEventLog::RTCP_EVENT: {
@@ -427,6 +430,9 @@ EventLogAnalyzer::EventLogAnalyzer(const ParsedRtcEventLog& log)
         break;
       }
       case ParsedRtcEventLog::AUDIO_PLAYOUT_EVENT: {
+        uint32_t ssrc;
+        parsed_log_.GetAudioPlayout(i, &ssrc);
+        audio_playouts_[ssrc].push_back(parsed_log_.GetTimestamp(i));
         break;
       }
       case ParsedRtcEventLog::UNKNOWN_EVENT: {
@@ -435,6 +441,21 @@ EventLogAnalyzer::EventLogAnalyzer(const ParsedRtcEventLog& log)
     }
   }
 
+  for (const auto& kv : rtp_packets_) {
+    if (kv.first.GetDirection() == PacketDirection::kOutgoingPacket) {
+      for (const LoggedRtpPacket& rtp_packet : kv.second)
+        outgoing_rtp_.insert(std::make_pair(rtp_packet.timestamp, &rtp_packet));
+    }
+  }
+
+  for (const auto& kv : rtcp_packets_) {
+    if (kv.first.GetDirection() == PacketDirection::kIncomingPacket) {
+      for (const LoggedRtcpPacket& rtcp_packet : kv.second)
+        incoming_rtcp_.insert(
+            std::make_pair(rtcp_packet.timestamp, &rtcp_packet));
+    }
+  }
+
   if (last_timestamp < first_timestamp) {
     // No useful events in the log.
     first_timestamp = last_timestamp = 0;
@@ -585,35 +606,27 @@ void EventLogAnalyzer::CreateAccumulatedPacketsGraph(
 
 // For each SSRC, plot the time between the consecutive playouts.
 void EventLogAnalyzer::CreatePlayoutGraph(Plot* plot) {
-  std::map<uint32_t, TimeSeries> time_series;
-  std::map<uint32_t, uint64_t> last_playout;
-
-  uint32_t ssrc;
+  for (const auto& kv : audio_playouts_) {
+    uint32_t ssrc = kv.first;
+    if (!MatchingSsrc(ssrc, desired_ssrc_))
+      continue;
 
-  for (size_t i = 0; i < parsed_log_.GetNumberOfEvents(); i++) {
-    ParsedRtcEventLog::EventType event_type = parsed_log_.GetEventType(i);
-    if (event_type == ParsedRtcEventLog::AUDIO_PLAYOUT_EVENT) {
-      parsed_log_.GetAudioPlayout(i, &ssrc);
-      uint64_t timestamp = parsed_log_.GetTimestamp(i);
-      if (MatchingSsrc(ssrc, desired_ssrc_)) {
-        float x = static_cast<float>(timestamp - begin_time_) / 1000000;
-        float y = static_cast<float>(timestamp - last_playout[ssrc]) / 1000;
-        if (time_series[ssrc].points.size() == 0) {
-          // There were no previusly logged playout for this SSRC.
-          // Generate a point, but place it on the x-axis.
-          y = 0;
-        }
-        time_series[ssrc].points.push_back(TimeSeriesPoint(x, y));
-        last_playout[ssrc] = timestamp;
+    TimeSeries time_series;
+    time_series.label = SsrcToString(ssrc);
+    time_series.style = BAR_GRAPH;
+    uint64_t last_playout = 0;
+    for (uint64_t timestamp : kv.second) {
+      float x = static_cast<float>(timestamp - begin_time_) / 1000000;
+      float y = static_cast<float>(timestamp - last_playout) / 1000;
+      if (time_series.points.size() == 0) {
+        // There were no previusly logged playout for this SSRC.
+        // Generate a point, but place it on the x-axis.
+        y = 0;
       }
+      time_series.points.push_back(TimeSeriesPoint(x, y));
+      last_playout = timestamp;
     }
-  }
-
-  // Set labels and put in graph.
-  for (auto& kv : time_series) {
-    kv.second.label = SsrcToString(kv.first);
-    kv.second.style = BAR_GRAPH;
-    plot->series_list_.push_back(std::move(kv.second));
+    plot->series_list_.push_back(std::move(time_series));
   }
 
   plot->SetXAxis(0, call_duration_s_, "Time (s)", kLeftMargin, kRightMargin);
@@ -811,28 +824,8 @@ void EventLogAnalyzer::CreateFractionLossGraph(Plot* plot) {
 void EventLogAnalyzer::CreateTotalBitrateGraph(
     PacketDirection desired_direction,
     Plot* plot) {
-  struct TimestampSize {
-    TimestampSize(uint64_t t, size_t s) : timestamp(t), size(s) {}
-    uint64_t timestamp;
-    size_t size;
-  };
-  std::vector<TimestampSize> packets;
-
-  PacketDirection direction;
-  size_t total_length;
-
-  // Extract timestamps and sizes for the relevant packets.
-  for (size_t i = 0; i < parsed_log_.GetNumberOfEvents(); i++) {
-    ParsedRtcEventLog::EventType event_type = parsed_log_.GetEventType(i);
-    if (event_type == ParsedRtcEventLog::RTP_EVENT) {
-      parsed_log_.GetRtpHeader(i, &direction, nullptr, nullptr, nullptr,
-                               &total_length);
-      if (direction == desired_direction) {
-        uint64_t timestamp = parsed_log_.GetTimestamp(i);
-        packets.push_back(TimestampSize(timestamp, total_length));
-      }
-    }
-  }
+  const std::vector<LoggedPacketSize>& packets =
+      rtp_packet_sizes_[desired_direction];
 
   size_t window_index_begin = 0;
   size_t window_index_end = 0;
@@ -922,24 +915,6 @@ void EventLogAnalyzer::CreateStreamBitrateGraph(
 }
 
 void EventLogAnalyzer::CreateBweSimulationGraph(Plot* plot) {
-  std::map<uint64_t, const LoggedRtpPacket*> outgoing_rtp;
-  std::map<uint64_t, const LoggedRtcpPacket*> incoming_rtcp;
-
-  for (const auto& kv : rtp_packets_) {
-    if (kv.first.GetDirection() == PacketDirection::kOutgoingPacket) {
-      for (const LoggedRtpPacket& rtp_packet : kv.second)
-        outgoing_rtp.insert(std::make_pair(rtp_packet.timestamp, &rtp_packet));
-    }
-  }
-
-  for (const auto& kv : rtcp_packets_) {
-    if (kv.first.GetDirection() == PacketDirection::kIncomingPacket) {
-      for (const LoggedRtcpPacket& rtcp_packet : kv.second)
-        incoming_rtcp.insert(
-            std::make_pair(rtcp_packet.timestamp, &rtcp_packet));
-    }
-  }
-
   SimulatedClock clock(0);
   BitrateObserver observer;
   RtcEventLogNullImpl null_event_log;
@@ -957,24 +932,24 @@ void EventLogAnalyzer::CreateBweSimulationGraph(Plot* plot) {
   acked_time_series.label = "Acked bitrate";
   acked_time_series.style = LINE_DOT_GRAPH;
 
-  auto rtp_iterator = outgoing_rtp.begin();
-  auto rtcp_iterator = incoming_rtcp.begin();
+  auto rtp_iterator = outgoing_rtp_.begin();
+  auto rtcp_iterator = incoming_rtcp_.begin();
 
   auto NextRtpTime = [&]() {
-    if (rtp_iterator != outgoing_rtp.end())
+    if (rtp_iterator != outgoing_rtp_.end())
       return static_cast<int64_t>(rtp_iterator->first);
     return std::numeric_limits<int64_t>::max();
   };
 
   auto NextRtcpTime = [&]() {
-    if (rtcp_iterator != incoming_rtcp.end())
+    if (rtcp_iterator != incoming_rtcp_.end())
       return static_cast<int64_t>(rtcp_iterator->first);
     return std::numeric_limits<int64_t>::max();
   };
 
   auto NextProcessTime = [&]() {
-    if (rtcp_iterator != incoming_rtcp.end() ||
-        rtp_iterator != outgoing_rtp.end()) {
+    if (rtcp_iterator != incoming_rtcp_.end() ||
+        rtp_iterator != outgoing_rtp_.end()) {
       return clock.TimeInMicroseconds() +
              std::max<int64_t>(cc.TimeUntilNextProcess() * 1000, 0);
     }
@@ -1077,24 +1052,6 @@ class NullBitrateController : public BitrateController {
 };
 
 void EventLogAnalyzer::CreateNetworkDelayFeedbackGraph(Plot* plot) {
-  std::map<uint64_t, const LoggedRtpPacket*> outgoing_rtp;
-  std::map<uint64_t, const LoggedRtcpPacket*> incoming_rtcp;
-
-  for (const auto& kv : rtp_packets_) {
-    if (kv.first.GetDirection() == PacketDirection::kOutgoingPacket) {
-      for (const LoggedRtpPacket& rtp_packet : kv.second)
-        outgoing_rtp.insert(std::make_pair(rtp_packet.timestamp, &rtp_packet));
-    }
-  }
-
-  for (const auto& kv : rtcp_packets_) {
-    if (kv.first.GetDirection() == PacketDirection::kIncomingPacket) {
-      for (const LoggedRtcpPacket& rtcp_packet : kv.second)
-        incoming_rtcp.insert(
-            std::make_pair(rtcp_packet.timestamp, &rtcp_packet));
-    }
-  }
-
   SimulatedClock clock(0);
   NullBitrateController null_controller;
   TransportFeedbackAdapter feedback_adapter(&clock, &null_controller);
@@ -1105,17 +1062,17 @@ void EventLogAnalyzer::CreateNetworkDelayFeedbackGraph(Plot* plot) {
   time_series.style = LINE_DOT_GRAPH;
   int64_t estimated_base_delay_ms = std::numeric_limits<int64_t>::max();
 
-  auto rtp_iterator = outgoing_rtp.begin();
-  auto rtcp_iterator = incoming_rtcp.begin();
+  auto rtp_iterator = outgoing_rtp_.begin();
+  auto rtcp_iterator = incoming_rtcp_.begin();
 
   auto NextRtpTime = [&]() {
-    if (rtp_iterator != outgoing_rtp.end())
+    if (rtp_iterator != outgoing_rtp_.end())
       return static_cast<int64_t>(rtp_iterator->first);
     return std::numeric_limits<int64_t>::max();
   };
 
   auto NextRtcpTime = [&]() {
-    if (rtcp_iterator != incoming_rtcp.end())
+    if (rtcp_iterator != incoming_rtcp_.end())
       return static_cast<int64_t>(rtcp_iterator->first);
     return std::numeric_limits<int64_t>::max();
   };
@@ -1168,6 +1125,38 @@ void EventLogAnalyzer::CreateNetworkDelayFeedbackGraph(Plot* plot) {
   plot->SetTitle("Network Delay Change.");
 }
 
+namespace {
+struct SimulationGraphTask {
+  EventLogAnalyzer* analyzer;
+  Plot* plot;
+};
+
+bool CreateBweSimulationGraphThread(void* obj) {
+  SimulationGraphTask* task = static_cast<SimulationGraphTask*>(obj);
+  task->analyzer->CreateBweSimulationGraph(task->plot);
+  return false;
+}
+}  // namespace
+
+void EventLogAnalyzer::CreateSimulationGraphs(Plot* bwe_plot,
+                                              Plot* network_delay_plot) {
+  if (!bwe_plot || !network_delay_plot) {
+    if (bwe_plot)
+      CreateBweSimulationGraph(bwe_plot);
+    if (network_delay_plot)
+      CreateNetworkDelayFeedbackGraph(network_delay_plot);
+    return;
+  }
+  // The simulations only read the parsed packets and each use their own
+  // clock and controller, so they can run side by side.
+  SimulationGraphTask bwe_task = {this, bwe_plot};
+  rtc::PlatformThread bwe_thread(&CreateBweSimulationGraphThread, &bwe_task,
+                                 "BweSimulation");
+  bwe_thread.Start();
+  CreateNetworkDelayFeedbackGraph(network_delay_plot);
+  bwe_thread.Stop();
+}
+
 std::vector<std::pair<int64_t, int64_t>> EventLogAnalyzer::GetFrameTimestamps()
     const {
   std::vector<std::pair<int64_t, int64_t>> timestamps;
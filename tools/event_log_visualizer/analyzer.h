@@ -45,6 +45,13 @@ struct LoggedRtcpPacket {
   std::unique_ptr<rtcp::RtcpPacket> packet;
 };
 
+struct LoggedPacketSize {
+  LoggedPacketSize(uint64_t timestamp, size_t size)
+      : timestamp(timestamp), size(size) {}
+  uint64_t timestamp;
+  size_t size;
+};
+
 struct BwePacketLossEvent {
   uint64_t timestamp;
   int32_t new_bitrate;
@@ -86,6 +93,11 @@ class EventLogAnalyzer {
 
   void CreateNetworkDelayFeedbackGraph(Plot* plot);
 
+  // Creates the graphs of CreateBweSimulationGraph and
+  // CreateNetworkDelayFeedbackGraph in parallel. Both replay the whole log, so
+  // they take most of the time on long calls. Either plot may be null.
+  void CreateSimulationGraphs(Plot* bwe_plot, Plot* network_delay_plot);
+
   // Returns a vector of capture and arrival timestamps for the video frames
   // of the stream with the most number of frames.
   std::vector<std::pair<int64_t, int64_t>> GetFrameTimestamps() const;
@@ -148,6 +160,18 @@ class EventLogAnalyzer {
 
   std::map<StreamId, std::vector<LoggedRtcpPacket>> rtcp_packets_;
 
+  // The outgoing RTP and incoming RTCP packets of all streams ordered by
+  // time, as replayed by the simulations.
+  std::map<uint64_t, const LoggedRtpPacket*> outgoing_rtp_;
+  std::map<uint64_t, const LoggedRtcpPacket*> incoming_rtcp_;
+
+  // The time and size of each RTP packet of all streams in each direction, in
+  // log order.
+  std::map<PacketDirection, std::vector<LoggedPacketSize>> rtp_packet_sizes_;
+
+  // The times of the audio playout events of each SSRC.
+  std::map<uint32_t, std::vector<uint64_t>> audio_playouts_;
+
   // A list of all updates from the send-side loss-based bandwidth estimator.
   std::vector<BwePacketLossEvent> bwe_loss_updates_;
 
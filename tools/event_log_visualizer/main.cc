@@ -172,14 +172,18 @@ int main(int argc, char* argv[]) {
     }
   }
 
+  webrtc::plotting::Plot* bwe_plot = nullptr;
   if (FLAGS_plot_all || FLAGS_plot_bwe) {
-    analyzer.CreateBweSimulationGraph(collection->AppendNewPlot());
+    bwe_plot = collection->AppendNewPlot();
   }
 
+  webrtc::plotting::Plot* network_delay_plot = nullptr;
   if (FLAGS_plot_all || FLAGS_plot_network_delay_feedback) {
-    analyzer.CreateNetworkDelayFeedbackGraph(collection->AppendNewPlot());
+    network_delay_plot = collection->AppendNewPlot();
   }
 
+  analyzer.CreateSimulationGraphs(bwe_plot, network_delay_plot);
+
   collection->Draw();
 
   return 0;
@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 
+#include "webrtc/system_wrappers/include/cpu_info.h"
 #include "webrtc/tools/frame_analyzer/video_quality_analysis.h"
 #include "webrtc/tools/simple_command_line_parser.h"
 
@@ -37,7 +38,7 @@
  * frame_analyzer --label=<test_label> --reference_file=<name_of_file>
  * --test_file_ref=<name_of_file> --stats_file_test=<name_of_file>
  * --stats_file=<name_of_file> --width=<frame_width>
- * --height=<frame_height>
+ * --height=<frame_height> [--num_threads=<threads>] [--csv_file=<name_of_file>]
  */
 int main(int argc, char** argv) {
   std::string program_name = argv[0];
@@ -62,7 +63,11 @@ int main(int argc, char** argv) {
       "  - reference_file(string): The reference YUV file to compare against."
       " Default: ref.yuv\n"
       "  - test_file(string): The test YUV file to run the analysis for."
-      " Default: test_file.yuv\n";
+      " Default: test_file.yuv\n"
+      "  - num_threads(int): The number of threads computing the metrics, 0 for"
+      " one per CPU core. Default: 0\n"
+      "  - csv_file(string): If set, the file to write the metrics of each"
+      " frame to, as comma separated values. Default: \n";
 
   webrtc::test::CommandLineParser parser;
 
@@ -77,6 +82,8 @@ int main(int argc, char** argv) {
   parser.SetFlag("stats_file_test", "stats_test.txt");
   parser.SetFlag("reference_file", "ref.yuv");
   parser.SetFlag("test_file", "test.yuv");
+  parser.SetFlag("num_threads", "0");
+  parser.SetFlag("csv_file", "");
   parser.SetFlag("help", "false");
 
   parser.ProcessFlags();
@@ -94,13 +101,29 @@ int main(int argc, char** argv) {
     return -1;
   }
 
+  int num_threads = strtol((parser.GetFlag("num_threads")).c_str(), NULL, 10);
+  if (num_threads <= 0)
+    num_threads = webrtc::CpuInfo::DetectNumberOfCores();
+
   webrtc::test::ResultsContainer results;
 
   webrtc::test::RunAnalysis(parser.GetFlag("reference_file").c_str(),
                             parser.GetFlag("test_file").c_str(),
                             parser.GetFlag("stats_file_ref").c_str(),
                             parser.GetFlag("stats_file_test").c_str(), width,
-                            height, &results);
+                            height, num_threads, &results);
+
+  std::string csv_file_name = parser.GetFlag("csv_file");
+  if (!csv_file_name.empty()) {
+    FILE* csv_file = fopen(csv_file_name.c_str(), "w");
+    if (csv_file == NULL) {
+      fprintf(stderr, "Couldn't open CSV file for writing: %s\n",
+              csv_file_name.c_str());
+      return -1;
+    }
+    webrtc::test::PrintAnalysisResultsCsv(csv_file, results);
+    fclose(csv_file);
+  }
 
   std::string label = parser.GetFlag("label");
   webrtc::test::PrintAnalysisResults(label, &results);
@@ -14,10 +14,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <algorithm>
-#include <string>
 #include <map>
+#include <memory>
+#include <string>
 #include <utility>
 
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/platform_thread.h"
+
 #define STATS_LINE_LENGTH 32
 #define Y4M_FILE_HEADER_MAX_SIZE 200
 #define Y4M_FRAME_DELIMITER "FRAME"
@@ -227,6 +231,165 @@ double CalculateMetrics(VideoAnalysisMetricsType video_metrics_type,
   return result;
 }
 
+namespace {
+// A pair of frames to compare, identified by their position in the files.
+struct FramePair {
+  int reference_frame;
+  int test_frame;
+  int decoded_frame_number;
+};
+
+// Reads I420 frames from a raw YUV or Y4M file that stays open, instead of
+// opening the file again for every frame.
+class I420FrameReader {
+ public:
+  I420FrameReader(const char* file_name, int width, int height, bool y4m)
+      : file_(fopen(file_name, "rb")),
+        frame_size_(GetI420FrameSize(width, height)),
+        frame_header_size_(0),
+        first_frame_offset_(0) {
+    if (file_ == NULL) {
+      fprintf(stderr, "Couldn't open input file for reading: %s\n",
+              file_name);
+      return;
+    }
+    if (!y4m)
+      return;
+
+    // See ExtractFrameFromY4mFile for the layout of the file.
+    char file_header[Y4M_FILE_HEADER_MAX_SIZE];
+    size_t bytes_read =
+        fread(file_header, 1, Y4M_FILE_HEADER_MAX_SIZE - 1, file_);
+    file_header[bytes_read] = '\0';
+    std::string header_contents(file_header);
+    std::size_t found = header_contents.find(Y4M_FRAME_DELIMITER);
+    if (found == std::string::npos) {
+      fprintf(stdout, "Corrupted Y4M header, could not find \"FRAME\" in %s\n",
+              header_contents.c_str());
+      fclose(file_);
+      file_ = NULL;
+      return;
+    }
+    frame_header_size_ = Y4M_FRAME_HEADER_SIZE;
+    first_frame_offset_ = static_cast<long>(found) + Y4M_FRAME_HEADER_SIZE;
+  }
+
+  ~I420FrameReader() {
+    if (file_ != NULL)
+      fclose(file_);
+  }
+
+  bool ReadFrame(int frame_number, uint8_t* frame) {
+    if (file_ == NULL)
+      return false;
+    long offset = first_frame_offset_ +
+                  static_cast<long>(frame_number) *
+                      (frame_size_ + frame_header_size_);
+    if (fseek(file_, offset, SEEK_SET) != 0)
+      return false;
+    return fread(frame, 1, frame_size_, file_) ==
+           static_cast<size_t>(frame_size_);
+  }
+
+ private:
+  FILE* file_;
+  const int frame_size_;
+  int frame_header_size_;
+  long first_frame_offset_;
+};
+
+// Computes the metrics of the frame pairs on several threads. Each thread
+// takes the next pair to compare and writes the result at its index, so the
+// results are in the order of the pairs.
+class FrameAnalyzer {
+ public:
+  FrameAnalyzer(const char* reference_file_name,
+                const char* test_file_name,
+                int width,
+                int height,
+                bool y4m_mode,
+                const std::vector<FramePair>& frame_pairs)
+      : reference_file_name_(reference_file_name),
+        test_file_name_(test_file_name),
+        width_(width),
+        height_(height),
+        y4m_mode_(y4m_mode),
+        frame_pairs_(frame_pairs),
+        next_index_(0),
+        frame_results_(frame_pairs.size()),
+        frames_read_(frame_pairs.size(), false) {}
+
+  void Run(int num_threads, ResultsContainer* results) {
+    if (num_threads <= 1) {
+      AnalyzeFrames();
+    } else {
+      std::vector<std::unique_ptr<rtc::PlatformThread>> threads;
+      for (int i = 0; i < num_threads; ++i) {
+        threads.emplace_back(new rtc::PlatformThread(AnalyzeFramesThread, this,
+                                                     "FrameAnalyzer"));
+        threads.back()->Start();
+      }
+      for (auto& thread : threads)
+        thread->Stop();
+    }
+
+    for (size_t i = 0; i < frame_pairs_.size(); ++i) {
+      if (frames_read_[i])
+        results->frames.push_back(frame_results_[i]);
+    }
+  }
+
+ private:
+  static bool AnalyzeFramesThread(void* obj) {
+    static_cast<FrameAnalyzer*>(obj)->AnalyzeFrames();
+    return false;
+  }
+
+  void AnalyzeFrames() {
+    I420FrameReader reference_reader(reference_file_name_, width_, height_,
+                                     y4m_mode_);
+    I420FrameReader test_reader(test_file_name_, width_, height_, false);
+    int size = GetI420FrameSize(width_, height_);
+    std::unique_ptr<uint8_t[]> reference_frame(new uint8_t[size]);
+    std::unique_ptr<uint8_t[]> test_frame(new uint8_t[size]);
+
+    for (;;) {
+      int index = rtc::AtomicOps::Increment(&next_index_) - 1;
+      if (index >= static_cast<int>(frame_pairs_.size()))
+        return;
+      const FramePair& pair = frame_pairs_[index];
+      if (!test_reader.ReadFrame(pair.test_frame, test_frame.get()) ||
+          !reference_reader.ReadFrame(pair.reference_frame,
+                                      reference_frame.get())) {
+        fprintf(stdout, "Error while reading frame no %d\n",
+                pair.decoded_frame_number);
+        continue;
+      }
+
+      AnalysisResult& result = frame_results_[index];
+      result.frame_number = pair.decoded_frame_number;
+      result.psnr_value = CalculateMetrics(kPSNR, reference_frame.get(),
+                                           test_frame.get(), width_, height_);
+      result.ssim_value = CalculateMetrics(kSSIM, reference_frame.get(),
+                                           test_frame.get(), width_, height_);
+      frames_read_[index] = true;
+    }
+  }
+
+  const char* const reference_file_name_;
+  const char* const test_file_name_;
+  const int width_;
+  const int height_;
+  const bool y4m_mode_;
+  const std::vector<FramePair>& frame_pairs_;
+
+  volatile int next_index_;
+  // Each element is only written by the thread that took its index.
+  std::vector<AnalysisResult> frame_results_;
+  std::vector<char> frames_read_;
+};
+}  // namespace
+
 void RunAnalysis(const char* reference_file_name,
                  const char* test_file_name,
                  const char* stats_file_reference_name,
@@ -234,22 +397,30 @@ void RunAnalysis(const char* reference_file_name,
                  int width,
                  int height,
                  ResultsContainer* results) {
+  RunAnalysis(reference_file_name, test_file_name, stats_file_reference_name,
+              stats_file_test_name, width, height, 1, results);
+}
+
+void RunAnalysis(const char* reference_file_name,
+                 const char* test_file_name,
+                 const char* stats_file_reference_name,
+                 const char* stats_file_test_name,
+                 int width,
+                 int height,
+                 int num_threads,
+                 ResultsContainer* results) {
   // Check if the reference_file_name ends with "y4m".
   bool y4m_mode = false;
   if (std::string(reference_file_name).find("y4m") != std::string::npos) {
     y4m_mode = true;
   }
 
-  int size = GetI420FrameSize(width, height);
   FILE* stats_file_ref = fopen(stats_file_reference_name, "r");
   FILE* stats_file_test = fopen(stats_file_test_name, "r");
 
   // String buffer for the lines in the stats file.
   char line[STATS_LINE_LENGTH];
 
-  // Allocate buffers for test and reference frames.
-  uint8_t* test_frame = new uint8_t[size];
-  uint8_t* reference_frame = new uint8_t[size];
   int previous_frame_number = -1;
 
   // Maps barcode id to the frame id for the reference video.
@@ -265,6 +436,7 @@ void RunAnalysis(const char* reference_file_name,
         std::make_pair(decoded_frame_number, extracted_ref_frame));
   }
 
+  std::vector<FramePair> frame_pairs;
   while (GetNextStatsLine(stats_file_test, line)) {
     int extracted_test_frame = ExtractFrameSequenceNumber(line);
     int decoded_frame_number = ExtractDecodedFrameNumber(line);
@@ -286,38 +458,18 @@ void RunAnalysis(const char* reference_file_name,
     assert(extracted_test_frame != -1);
     assert(decoded_frame_number != -1);
 
-    ExtractFrameFromYuvFile(test_file_name, width, height, extracted_test_frame,
-                            test_frame);
-    if (y4m_mode) {
-      ExtractFrameFromY4mFile(reference_file_name, width, height,
-                              extracted_ref_frame, reference_frame);
-    } else {
-      ExtractFrameFromYuvFile(reference_file_name, width, height,
-                              extracted_ref_frame, reference_frame);
-    }
-
-    // Calculate the PSNR and SSIM.
-    double result_psnr =
-        CalculateMetrics(kPSNR, reference_frame, test_frame, width, height);
-    double result_ssim =
-        CalculateMetrics(kSSIM, reference_frame, test_frame, width, height);
-
+    frame_pairs.push_back(
+        {extracted_ref_frame, extracted_test_frame, decoded_frame_number});
     previous_frame_number = decoded_frame_number;
-
-    // Fill in the result struct.
-    AnalysisResult result;
-    result.frame_number = decoded_frame_number;
-    result.psnr_value = result_psnr;
-    result.ssim_value = result_ssim;
-
-    results->frames.push_back(result);
   }
 
   // Cleanup.
   fclose(stats_file_ref);
   fclose(stats_file_test);
-  delete[] test_frame;
-  delete[] reference_frame;
+
+  FrameAnalyzer analyzer(reference_file_name, test_file_name, width, height,
+                         y4m_mode, frame_pairs);
+  analyzer.Run(num_threads, results);
 }
 
 void PrintMaxRepeatedAndSkippedFrames(const std::string& label,
@@ -462,5 +614,13 @@ void PrintAnalysisResults(FILE* output, const std::string& label,
   }
 }
 
+void PrintAnalysisResultsCsv(FILE* output, const ResultsContainer& results) {
+  fprintf(output, "frame_number,psnr,ssim\n");
+  for (const AnalysisResult& result : results.frames) {
+    fprintf(output, "%d,%f,%f\n", result.frame_number, result.psnr_value,
+            result.ssim_value);
+  }
+}
+
 }  // namespace test
 }  // namespace webrtc
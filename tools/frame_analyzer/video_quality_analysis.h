@@ -63,6 +63,18 @@ void RunAnalysis(const char* reference_file_name,
                  int height,
                  ResultsContainer* results);
 
+// Same as above, but extracts the frames and computes their metrics on
+// |num_threads| threads, each keeping its own handles to the video files.
+// The results are in the same order as with a single thread.
+void RunAnalysis(const char* reference_file_name,
+                 const char* test_file_name,
+                 const char* stats_file_reference_name,
+                 const char* stats_file_test_name,
+                 int width,
+                 int height,
+                 int num_threads,
+                 ResultsContainer* results);
+
 // Compute PSNR or SSIM for an I420 frame (all planes). When we are calculating
 // PSNR values, the max return value (in the case where the test and reference
 // frames are exactly the same) will be 48. In the case of SSIM the max return
@@ -82,6 +94,10 @@ void PrintAnalysisResults(const std::string& label, ResultsContainer* results);
 void PrintAnalysisResults(FILE* output, const std::string& label,
                           ResultsContainer* results);
 
+// Prints the results as comma separated values, one line per frame with its
+// number, PSNR and SSIM, after a header line.
+void PrintAnalysisResultsCsv(FILE* output, const ResultsContainer& results);
+
 // Calculates max repeated and skipped frames and prints them to stdout in a
 // format that is compatible with Chromium performance numbers.
 void PrintMaxRepeatedAndSkippedFrames(const std::string& label,
@@ -84,6 +84,68 @@ TEST_F(VideoQualityAnalysisTest, PrintAnalysisResultsThreeFrames) {
   PrintAnalysisResults(logfile_, "ThreeFrames", &result);
 }
 
+TEST_F(VideoQualityAnalysisTest, PrintAnalysisResultsCsvThreeFrames) {
+  ResultsContainer result;
+  result.frames.push_back(AnalysisResult(0, 35.0, 0.9));
+  result.frames.push_back(AnalysisResult(1, 34.0, 0.8));
+  result.frames.push_back(AnalysisResult(2, 33.0, 0.7));
+  PrintAnalysisResultsCsv(logfile_, result);
+}
+
+TEST_F(VideoQualityAnalysisTest, RunAnalysisOnThreadsMatchesOneThread) {
+  const int kWidth = 32;
+  const int kHeight = 16;
+  const int kNumFrames = 10;
+  const int size = GetI420FrameSize(kWidth, kHeight);
+  std::string reference_filename = OutputPath() + "analysis-reference.yuv";
+  std::string test_filename = OutputPath() + "analysis-test.yuv";
+  std::string stats_filename_ref = OutputPath() + "analysis-stats-1.txt";
+  std::string stats_filename = OutputPath() + "analysis-stats-2.txt";
+
+  // Each test frame differs from its reference frame by a growing number of
+  // pixels, so that every frame has different metrics.
+  std::ofstream reference_file(reference_filename.c_str(), std::ios::binary);
+  std::ofstream test_file(test_filename.c_str(), std::ios::binary);
+  std::ofstream stats_file_ref(stats_filename_ref.c_str());
+  std::ofstream stats_file(stats_filename.c_str());
+  for (int i = 0; i < kNumFrames; ++i) {
+    std::string frame(size, static_cast<char>(16 * i));
+    reference_file << frame;
+    for (int j = 0; j <= i; ++j)
+      frame[j * 7] += 40;
+    test_file << frame;
+    stats_file_ref << "frame_" << i << " " << 100 + i << "\n";
+    stats_file << "frame_" << i << " " << 100 + i << "\n";
+  }
+  reference_file.close();
+  test_file.close();
+  stats_file_ref.close();
+  stats_file.close();
+
+  ResultsContainer one_thread_results;
+  RunAnalysis(reference_filename.c_str(), test_filename.c_str(),
+              stats_filename_ref.c_str(), stats_filename.c_str(), kWidth,
+              kHeight, &one_thread_results);
+  ResultsContainer results;
+  RunAnalysis(reference_filename.c_str(), test_filename.c_str(),
+              stats_filename_ref.c_str(), stats_filename.c_str(), kWidth,
+              kHeight, 3, &results);
+
+  ASSERT_EQ(static_cast<size_t>(kNumFrames), one_thread_results.frames.size());
+  ASSERT_EQ(one_thread_results.frames.size(), results.frames.size());
+  for (int i = 0; i < kNumFrames; ++i) {
+    EXPECT_EQ(100 + i, results.frames[i].frame_number);
+    EXPECT_EQ(one_thread_results.frames[i].psnr_value,
+              results.frames[i].psnr_value);
+    EXPECT_EQ(one_thread_results.frames[i].ssim_value,
+              results.frames[i].ssim_value);
+    if (i > 0) {
+      EXPECT_LT(results.frames[i].psnr_value,
+                results.frames[i - 1].psnr_value);
+    }
+  }
+}
+
 TEST_F(VideoQualityAnalysisTest, PrintMaxRepeatedAndSkippedFramesInvalidFile) {
   std::string stats_filename_ref =
       OutputPath() + "non-existing-stats-file-1.txt";
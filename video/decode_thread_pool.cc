@@ -0,0 +1,177 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/video/decode_thread_pool.h"
+
+#include <algorithm>
+
+#include "webrtc/base/checks.h"
+#include "webrtc/system_wrappers/include/clock.h"
+
+namespace webrtc {
+namespace {
+// Streams decoding frames of at least this size get the full head start over
+// streams that have been due for the same time, smaller streams get a head
+// start proportional to their frame size.
+constexpr int kFullPriorityPixels = 1280 * 720;
+constexpr int64_t kMaxPriorityHeadStartMs = 20;
+
+int64_t PriorityHeadStartMs(int pixels) {
+  return kMaxPriorityHeadStartMs *
+         std::min(std::max(pixels, 0), kFullPriorityPixels) /
+         kFullPriorityPixels;
+}
+}  // namespace
+
+DecodeThreadPool::StreamState::StreamState()
+    : next_run_ms(-1),
+      running(false),
+      woken_up(false),
+      removed(false),
+      stopped_event(new rtc::Event(false, false)) {}
+
+DecodeThreadPool::DecodeThreadPool(Clock* clock, int num_threads)
+    : clock_(clock), wake_up_event_(false, false), stopped_(false) {
+  RTC_DCHECK_GT(num_threads, 0);
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.emplace_back(new rtc::PlatformThread(DecodeThreadFunction, this,
+                                                  "SharedDecodingThread"));
+    threads_.back()->Start();
+    threads_.back()->SetPriority(rtc::kHighestPriority);
+  }
+}
+
+DecodeThreadPool::~DecodeThreadPool() {
+  {
+    rtc::CritScope lock(&crit_);
+    RTC_DCHECK(streams_.empty());
+    stopped_ = true;
+  }
+  wake_up_event_.Set();
+  for (auto& thread : threads_)
+    thread->Stop();
+}
+
+void DecodeThreadPool::AddStream(Stream* stream) {
+  rtc::CritScope lock(&crit_);
+  StreamState& state = streams_[stream];
+  RTC_DCHECK(!state.running);
+  state.next_run_ms = clock_->TimeInMilliseconds();
+  wake_up_event_.Set();
+}
+
+void DecodeThreadPool::RemoveStream(Stream* stream) {
+  rtc::Event* stopped_event;
+  {
+    rtc::CritScope lock(&crit_);
+    auto it = streams_.find(stream);
+    RTC_DCHECK(it != streams_.end());
+    if (!it->second.running) {
+      streams_.erase(it);
+      return;
+    }
+    it->second.removed = true;
+    stopped_event = it->second.stopped_event.get();
+  }
+  stopped_event->Wait(rtc::Event::kForever);
+
+  rtc::CritScope lock(&crit_);
+  streams_.erase(stream);
+}
+
+void DecodeThreadPool::WakeUp(Stream* stream) {
+  rtc::CritScope lock(&crit_);
+  auto it = streams_.find(stream);
+  if (it == streams_.end() || it->second.removed)
+    return;
+  StreamState& state = it->second;
+  if (state.running) {
+    state.woken_up = true;
+    return;
+  }
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  if (state.next_run_ms == -1 || state.next_run_ms > now_ms) {
+    state.next_run_ms = now_ms;
+    wake_up_event_.Set();
+  }
+}
+
+bool DecodeThreadPool::DecodeThreadFunction(void* ptr) {
+  return static_cast<DecodeThreadPool*>(ptr)->Run();
+}
+
+bool DecodeThreadPool::Run() {
+  Stream* stream;
+  int64_t wait_ms;
+  {
+    rtc::CritScope lock(&crit_);
+    if (stopped_) {
+      // Pass the wake up on so that every thread sees |stopped_|.
+      wake_up_event_.Set();
+      return false;
+    }
+    stream = SelectStream(clock_->TimeInMilliseconds(), &wait_ms);
+  }
+
+  if (!stream) {
+    wake_up_event_.Wait(static_cast<int>(wait_ms));
+    return true;
+  }
+
+  int64_t delay_ms = stream->DecodeOnce();
+
+  rtc::CritScope lock(&crit_);
+  StreamState& state = streams_[stream];
+  state.running = false;
+  if (state.removed) {
+    state.stopped_event->Set();
+    return true;
+  }
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  if (state.woken_up) {
+    state.next_run_ms = now_ms;
+  } else {
+    state.next_run_ms = delay_ms < 0 ? -1 : now_ms + delay_ms;
+  }
+  state.woken_up = false;
+  // Other threads may be waiting for a later deadline.
+  if (state.next_run_ms > now_ms)
+    wake_up_event_.Set();
+  return true;
+}
+
+DecodeThreadPool::Stream* DecodeThreadPool::SelectStream(int64_t now_ms,
+                                                         int64_t* wait_ms) {
+  *wait_ms = rtc::Event::kForever;
+  Stream* selected = nullptr;
+  int64_t selected_priority_time_ms = 0;
+  for (auto& entry : streams_) {
+    const StreamState& state = entry.second;
+    if (state.running || state.removed || state.next_run_ms == -1)
+      continue;
+    if (state.next_run_ms > now_ms) {
+      int64_t time_until_due_ms = state.next_run_ms - now_ms;
+      if (*wait_ms == rtc::Event::kForever || time_until_due_ms < *wait_ms)
+        *wait_ms = time_until_due_ms;
+      continue;
+    }
+    int64_t priority_time_ms =
+        state.next_run_ms - PriorityHeadStartMs(entry.first->DecodedPixels());
+    if (!selected || priority_time_ms < selected_priority_time_ms) {
+      selected = entry.first;
+      selected_priority_time_ms = priority_time_ms;
+    }
+  }
+  if (selected)
+    streams_[selected].running = true;
+  return selected;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,99 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_VIDEO_DECODE_THREAD_POOL_H_
+#define WEBRTC_VIDEO_DECODE_THREAD_POOL_H_
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/base/platform_thread.h"
+#include "webrtc/base/thread_annotations.h"
+
+namespace webrtc {
+
+class Clock;
+
+// A fixed set of threads decoding the frames of many video receive streams,
+// instead of one mostly idle thread per stream. A stream is run by at most
+// one thread at a time. When several streams are due, the one that has been
+// due the longest runs first, with streams decoding larger frames getting a
+// bounded head start so they are served first without starving the others.
+class DecodeThreadPool {
+ public:
+  class Stream {
+   public:
+    // Decodes at most one frame without blocking. Returns the time in ms
+    // until the stream should run again, or -1 to wait for WakeUp.
+    virtual int64_t DecodeOnce() = 0;
+
+    // Number of pixels of the frames the stream decodes, used to prioritize
+    // the streams rendered the largest.
+    virtual int DecodedPixels() const = 0;
+
+   protected:
+    virtual ~Stream() {}
+  };
+
+  DecodeThreadPool(Clock* clock, int num_threads);
+  ~DecodeThreadPool();
+
+  // Starts running |stream|, which must be removed before it is destroyed.
+  void AddStream(Stream* stream);
+  // Stops running |stream|. Blocks while a thread is decoding it.
+  void RemoveStream(Stream* stream);
+  // Runs |stream| as soon as a thread is available, typically because a new
+  // frame has become decodable.
+  void WakeUp(Stream* stream);
+
+ private:
+  struct StreamState {
+    StreamState();
+
+    // Time at which the stream should run next, -1 if it waits for WakeUp.
+    int64_t next_run_ms;
+    bool running;
+    // Set if WakeUp is called while the stream is running.
+    bool woken_up;
+    bool removed;
+    // Signaled when the stream stops running after being removed.
+    std::unique_ptr<rtc::Event> stopped_event;
+  };
+
+  static bool DecodeThreadFunction(void* ptr);
+  // Runs one due stream or waits until one is due. Returns false when the
+  // pool is being destroyed.
+  bool Run();
+
+  // Returns the due stream to run next, or nullptr and sets |wait_ms| to the
+  // time until the next stream is due.
+  Stream* SelectStream(int64_t now_ms, int64_t* wait_ms)
+      EXCLUSIVE_LOCKS_REQUIRED(crit_);
+
+  Clock* const clock_;
+  // Signaled when a stream may have become due earlier than the threads
+  // were waiting for.
+  rtc::Event wake_up_event_;
+  std::vector<std::unique_ptr<rtc::PlatformThread>> threads_;
+
+  rtc::CriticalSection crit_;
+  std::map<Stream*, StreamState> streams_ GUARDED_BY(crit_);
+  bool stopped_ GUARDED_BY(crit_);
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(DecodeThreadPool);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_VIDEO_DECODE_THREAD_POOL_H_
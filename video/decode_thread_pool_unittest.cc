@@ -0,0 +1,166 @@
+/*
+ *  Copyright (c) 2017 The WebRTC project authors. All Rights Reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <vector>
+
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/event.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/video/decode_thread_pool.h"
+
+namespace webrtc {
+namespace {
+constexpr int kTimeoutMs = 5000;
+
+class FakeStream : public DecodeThreadPool::Stream {
+ public:
+  explicit FakeStream(int pixels,
+                      std::vector<FakeStream*>* run_order = nullptr)
+      : pixels_(pixels),
+        run_order_(run_order),
+        run_event_(false, false),
+        release_event_(true, true),
+        num_runs_(0),
+        num_running_(0),
+        overlapped_(false),
+        delay_ms_(-1) {}
+  ~FakeStream() override {}
+
+  int64_t DecodeOnce() override {
+    {
+      rtc::CritScope lock(&crit_);
+      if (++num_running_ > 1)
+        overlapped_ = true;
+      ++num_runs_;
+      if (run_order_)
+        run_order_->push_back(this);
+    }
+    run_event_.Set();
+    release_event_.Wait(rtc::Event::kForever);
+    rtc::CritScope lock(&crit_);
+    --num_running_;
+    return delay_ms_;
+  }
+
+  int DecodedPixels() const override { return pixels_; }
+
+  // Makes DecodeOnce block until Release is called.
+  void Hold() { release_event_.Reset(); }
+  void Release() { release_event_.Set(); }
+
+  bool WaitForRun(int timeout_ms = kTimeoutMs) {
+    return run_event_.Wait(timeout_ms);
+  }
+
+  void set_delay_ms(int64_t delay_ms) {
+    rtc::CritScope lock(&crit_);
+    delay_ms_ = delay_ms;
+  }
+  int num_runs() const {
+    rtc::CritScope lock(&crit_);
+    return num_runs_;
+  }
+  bool overlapped() const {
+    rtc::CritScope lock(&crit_);
+    return overlapped_;
+  }
+
+ private:
+  const int pixels_;
+  std::vector<FakeStream*>* const run_order_;
+  rtc::Event run_event_;
+  rtc::Event release_event_;
+  rtc::CriticalSection crit_;
+  int num_runs_ GUARDED_BY(crit_);
+  int num_running_ GUARDED_BY(crit_);
+  bool overlapped_ GUARDED_BY(crit_);
+  int64_t delay_ms_ GUARDED_BY(crit_);
+};
+}  // namespace
+
+TEST(DecodeThreadPoolTest, RunsStreamWhenAddedAndWokenUp) {
+  DecodeThreadPool pool(Clock::GetRealTimeClock(), 2);
+  FakeStream stream(0);
+  pool.AddStream(&stream);
+  EXPECT_TRUE(stream.WaitForRun());
+
+  pool.WakeUp(&stream);
+  EXPECT_TRUE(stream.WaitForRun());
+  pool.RemoveStream(&stream);
+}
+
+TEST(DecodeThreadPoolTest, RunsStreamAgainAfterReturnedDelay) {
+  DecodeThreadPool pool(Clock::GetRealTimeClock(), 1);
+  FakeStream stream(0);
+  stream.set_delay_ms(10);
+  pool.AddStream(&stream);
+  EXPECT_TRUE(stream.WaitForRun());
+  EXPECT_TRUE(stream.WaitForRun());
+  pool.RemoveStream(&stream);
+}
+
+TEST(DecodeThreadPoolTest, NeverRunsAStreamOnTwoThreads) {
+  DecodeThreadPool pool(Clock::GetRealTimeClock(), 4);
+  FakeStream stream(0);
+  pool.AddStream(&stream);
+  for (int i = 0; i < 100; ++i) {
+    ASSERT_TRUE(stream.WaitForRun());
+    pool.WakeUp(&stream);
+  }
+  pool.RemoveStream(&stream);
+  EXPECT_FALSE(stream.overlapped());
+}
+
+TEST(DecodeThreadPoolTest, DoesNotRunRemovedStream) {
+  DecodeThreadPool pool(Clock::GetRealTimeClock(), 1);
+  FakeStream stream(0);
+  pool.AddStream(&stream);
+  ASSERT_TRUE(stream.WaitForRun());
+  pool.RemoveStream(&stream);
+  int num_runs = stream.num_runs();
+
+  pool.WakeUp(&stream);
+  stream.WaitForRun(50);
+  EXPECT_EQ(num_runs, stream.num_runs());
+}
+
+TEST(DecodeThreadPoolTest, PrefersStreamsWithLargerFrames) {
+  DecodeThreadPool pool(Clock::GetRealTimeClock(), 1);
+  std::vector<FakeStream*> run_order;
+  FakeStream blocking_stream(0);
+  FakeStream small_stream(320 * 180, &run_order);
+  FakeStream large_stream(1280 * 720, &run_order);
+
+  pool.AddStream(&small_stream);
+  ASSERT_TRUE(small_stream.WaitForRun());
+  pool.AddStream(&large_stream);
+  ASSERT_TRUE(large_stream.WaitForRun());
+  run_order.clear();
+
+  // Keep the only thread busy while both streams become due.
+  blocking_stream.Hold();
+  pool.AddStream(&blocking_stream);
+  ASSERT_TRUE(blocking_stream.WaitForRun());
+  pool.WakeUp(&small_stream);
+  pool.WakeUp(&large_stream);
+  blocking_stream.Release();
+
+  ASSERT_TRUE(small_stream.WaitForRun());
+  ASSERT_EQ(2u, run_order.size());
+  EXPECT_EQ(&large_stream, run_order[0]);
+  EXPECT_EQ(&small_stream, run_order[1]);
+
+  pool.RemoveStream(&blocking_stream);
+  pool.RemoveStream(&small_stream);
+  pool.RemoveStream(&large_stream);
+}
+
+}  // namespace webrtc
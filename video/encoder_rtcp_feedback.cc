@@ -74,4 +74,10 @@ void EncoderRtcpFeedback::OnReceivedRPSI(uint32_t ssrc, uint64_t picture_id) {
 
   vie_encoder_->OnReceivedRPSI(picture_id);
 }
+
+void EncoderRtcpFeedback::OnReceivedPauseRequest(uint32_t ssrc, bool paused) {
+  RTC_DCHECK(HasSsrc(ssrc));
+
+  vie_encoder_->OnStreamPauseRequest(GetStreamIndex(ssrc), paused);
+}
 }  // namespace webrtc
@@ -29,6 +29,7 @@ class EncoderRtcpFeedback : public RtcpIntraFrameObserver {
   void OnReceivedIntraFrameRequest(uint32_t ssrc) override;
   void OnReceivedSLI(uint32_t ssrc, uint8_t picture_id) override;
   void OnReceivedRPSI(uint32_t ssrc, uint64_t picture_id) override;
+  void OnReceivedPauseRequest(uint32_t ssrc, bool paused) override;
 
  private:
   bool HasSsrc(uint32_t ssrc);
@@ -32,6 +32,7 @@ class MockVieEncoder : public ViEEncoder {
   MOCK_METHOD1(OnReceivedIntraFrameRequest, void(size_t));
   MOCK_METHOD1(OnReceivedSLI, void(uint8_t picture_id));
   MOCK_METHOD1(OnReceivedRPSI, void(uint64_t picture_id));
+  MOCK_METHOD2(OnStreamPauseRequest, void(size_t, bool));
 };
 
 class VieKeyRequestTest : public ::testing::Test {
@@ -61,6 +62,9 @@ TEST_F(VieKeyRequestTest, CreateAndTriggerRequests) {
   const uint64_t rpsi_picture_id = 9;
   EXPECT_CALL(encoder_, OnReceivedRPSI(rpsi_picture_id)).Times(1);
   encoder_rtcp_feedback_.OnReceivedRPSI(kSsrc, rpsi_picture_id);
+
+  EXPECT_CALL(encoder_, OnStreamPauseRequest(0, true)).Times(1);
+  encoder_rtcp_feedback_.OnReceivedPauseRequest(kSsrc, true);
 }
 
 TEST_F(VieKeyRequestTest, TooManyOnReceivedIntraFrameRequest) {
@@ -79,6 +79,16 @@ TEST_F(FullStackTest, ForemanCifWithoutPacketLoss) {
   RunTest(foreman_cif);
 }
 
+TEST_F(FullStackTest, ForemanCifLowLatencyPlayout) {
+  VideoQualityTest::Params foreman_cif;
+  foreman_cif.call.send_side_bwe = true;
+  foreman_cif.video = {true, 352, 288, 30, 700000, 700000, 700000, false, "VP8",
+                       1, 0, 0, false, false, "", "foreman_cif", true};
+  foreman_cif.analyzer = {"foreman_cif_net_delay_0_0_plr_0_low_latency", 0.0,
+                          0.0, kFullStackTestDurationSecs};
+  RunTest(foreman_cif);
+}
+
 TEST_F(FullStackTest, ForemanCif30kbpsWithoutPacketLoss) {
   VideoQualityTest::Params foreman_cif;
   foreman_cif.call.send_side_bwe = true;
@@ -0,0 +1,86 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/video/latency_histogram.h"
+
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+
+namespace webrtc {
+
+const int64_t LatencyHistogram::kMaxValue;
+
+LatencyHistogram::LatencyHistogram() {
+  for (int i = 0; i < kNumBuckets; ++i)
+    counts_[i] = 0;
+}
+
+void LatencyHistogram::Add(int64_t value) {
+  rtc::AtomicOps::Increment(&counts_[BucketIndex(value)]);
+}
+
+int64_t LatencyHistogram::Percentile(int percentile) const {
+  RTC_DCHECK_GE(percentile, 0);
+  RTC_DCHECK_LE(percentile, 100);
+  int counts[kNumBuckets];
+  int64_t num_samples = 0;
+  for (int i = 0; i < kNumBuckets; ++i) {
+    counts[i] = rtc::AtomicOps::AcquireLoad(&counts_[i]);
+    num_samples += counts[i];
+  }
+  if (num_samples == 0)
+    return -1;
+
+  // The rank of the sample, counting from 1.
+  int64_t rank = (num_samples * percentile + 99) / 100;
+  if (rank == 0)
+    rank = 1;
+  for (int i = 0; i < kNumBuckets; ++i) {
+    rank -= counts[i];
+    if (rank <= 0)
+      return BucketUpperBound(i);
+  }
+  RTC_NOTREACHED();
+  return kMaxValue;
+}
+
+int64_t LatencyHistogram::NumSamples() const {
+  int64_t num_samples = 0;
+  for (int i = 0; i < kNumBuckets; ++i)
+    num_samples += rtc::AtomicOps::AcquireLoad(&counts_[i]);
+  return num_samples;
+}
+
+int LatencyHistogram::BucketIndex(int64_t value) {
+  if (value < kNumExactBuckets)
+    return value < 0 ? 0 : static_cast<int>(value);
+  if (value >= kMaxValue)
+    return kNumBuckets - 1;
+  int power = 4;
+  while ((value >> (power + 1)) != 0)
+    ++power;
+  const int bucket_in_power = (value >> (power - 2)) & 3;
+  return kNumExactBuckets + (power - 4) * kBucketsPerPowerOfTwo +
+         bucket_in_power;
+}
+
+int64_t LatencyHistogram::BucketUpperBound(int index) {
+  if (index < kNumExactBuckets)
+    return index;
+  if (index == kNumBuckets - 1)
+    return kMaxValue;
+  const int power = 4 + (index - kNumExactBuckets) / kBucketsPerPowerOfTwo;
+  const int bucket_in_power =
+      (index - kNumExactBuckets) % kBucketsPerPowerOfTwo;
+  return (static_cast<int64_t>(kBucketsPerPowerOfTwo + bucket_in_power + 1)
+          << (power - 2)) - 1;
+}
+
+}  // namespace webrtc
@@ -0,0 +1,57 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef WEBRTC_VIDEO_LATENCY_HISTOGRAM_H_
+#define WEBRTC_VIDEO_LATENCY_HISTOGRAM_H_
+
+#include "webrtc/base/constructormagic.h"
+#include "webrtc/typedefs.h"
+
+namespace webrtc {
+
+// Histogram of non-negative durations, in any unit, with fixed buckets.
+// Adding a sample is lock free, so it can be done for every packet from any
+// thread, while the percentiles are read from another.
+//
+// Values below 16 have a bucket of their own. Each power of two above that is
+// split in four buckets, so percentiles are within 25% of the exact value.
+// Values of kMaxValue and above all go to the last bucket.
+class LatencyHistogram {
+ public:
+  static const int64_t kMaxValue = 1 << 16;
+
+  LatencyHistogram();
+
+  void Add(int64_t value);
+
+  // Returns the value below or at which |percentile| percent of the samples
+  // are, rounded up to the largest value of its bucket, or -1 if there are no
+  // samples. |percentile| is in [0, 100].
+  int64_t Percentile(int percentile) const;
+
+  int64_t NumSamples() const;
+
+ private:
+  static const int kNumExactBuckets = 16;
+  static const int kBucketsPerPowerOfTwo = 4;
+  static const int kNumBuckets =
+      kNumExactBuckets + kBucketsPerPowerOfTwo * (16 - 4) + 1;
+
+  static int BucketIndex(int64_t value);
+  static int64_t BucketUpperBound(int index);
+
+  volatile int counts_[kNumBuckets];
+
+  RTC_DISALLOW_COPY_AND_ASSIGN(LatencyHistogram);
+};
+
+}  // namespace webrtc
+
+#endif  // WEBRTC_VIDEO_LATENCY_HISTOGRAM_H_
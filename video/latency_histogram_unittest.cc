@@ -0,0 +1,67 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "webrtc/video/latency_histogram.h"
+
+#include "webrtc/test/gtest.h"
+
+namespace webrtc {
+
+TEST(LatencyHistogramTest, NoSamples) {
+  LatencyHistogram histogram;
+  EXPECT_EQ(0, histogram.NumSamples());
+  EXPECT_EQ(-1, histogram.Percentile(50));
+}
+
+TEST(LatencyHistogramTest, SmallValuesAreExact) {
+  LatencyHistogram histogram;
+  for (int i = 1; i <= 10; ++i)
+    histogram.Add(i);
+  EXPECT_EQ(10, histogram.NumSamples());
+  EXPECT_EQ(1, histogram.Percentile(0));
+  EXPECT_EQ(1, histogram.Percentile(10));
+  EXPECT_EQ(5, histogram.Percentile(50));
+  EXPECT_EQ(10, histogram.Percentile(95));
+  EXPECT_EQ(10, histogram.Percentile(100));
+}
+
+TEST(LatencyHistogramTest, LargeValuesAreRoundedUpToBucket) {
+  LatencyHistogram histogram;
+  histogram.Add(16);
+  EXPECT_EQ(19, histogram.Percentile(50));
+  histogram.Add(1000);
+  histogram.Add(1000);
+  // 1000 is in the bucket [896, 1023].
+  EXPECT_EQ(1023, histogram.Percentile(50));
+  EXPECT_EQ(1023, histogram.Percentile(99));
+}
+
+TEST(LatencyHistogramTest, ClampsValues) {
+  LatencyHistogram histogram;
+  histogram.Add(-5);
+  histogram.Add(LatencyHistogram::kMaxValue * 10);
+  EXPECT_EQ(0, histogram.Percentile(50));
+  EXPECT_EQ(LatencyHistogram::kMaxValue, histogram.Percentile(100));
+}
+
+TEST(LatencyHistogramTest, PercentilesOfUniformDistribution) {
+  LatencyHistogram histogram;
+  for (int i = 0; i < 1000; ++i)
+    histogram.Add(i);
+  // Within 25% above the exact percentiles.
+  EXPECT_GE(histogram.Percentile(50), 499);
+  EXPECT_LE(histogram.Percentile(50), 499 * 5 / 4);
+  EXPECT_GE(histogram.Percentile(95), 949);
+  EXPECT_LE(histogram.Percentile(95), 949 * 5 / 4);
+  EXPECT_GE(histogram.Percentile(99), 989);
+  EXPECT_LE(histogram.Percentile(99), 989 * 5 / 4);
+}
+
+}  // namespace webrtc
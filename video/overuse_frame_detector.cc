@@ -14,13 +14,13 @@
 #include <math.h>
 
 #include <algorithm>
-#include <list>
 #include <map>
 
 #include "webrtc/api/video/video_frame.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/base/numerics/exp_filter.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/common_video/include/frame_callback.h"
 #include "webrtc/system_wrappers/include/clock.h"
 
@@ -57,7 +57,8 @@ CpuOveruseOptions::CpuOveruseOptions()
       frame_timeout_interval_ms(1500),
       min_frame_samples(120),
       min_process_count(3),
-      high_threshold_consecutive_count(2) {
+      high_threshold_consecutive_count(2),
+      use_thread_cpu_time(false) {
 #if defined(WEBRTC_MAC) && !defined(WEBRTC_IOS)
   // This is proof-of-concept code for letting the physical core count affect
   // the interval into which we attempt to scale. For now, the code is Mac OS
@@ -224,7 +225,13 @@ OveruseFrameDetector::OveruseFrameDetector(
       last_rampup_time_ms_(-1),
       in_quick_rampup_(false),
       current_rampup_delay_ms_(kStandardRampUpDelayMs),
-      usage_(new SendProcessingUsage(options)) {
+      last_thread_cpu_time_ns_(-1),
+      last_cpu_check_time_ms_(-1),
+      encode_cpu_usage_percent_(-1),
+      usage_(new SendProcessingUsage(options)),
+      frame_timing_(kMaxFrameTimings),
+      first_frame_timing_(0),
+      num_frame_timings_(0) {
   task_checker_.Detach();
 }
 
@@ -248,6 +255,7 @@ void OveruseFrameDetector::EncodedFrameTimeMeasured(int encode_duration_ms) {
   if (!metrics_)
     metrics_ = rtc::Optional<CpuOveruseMetrics>(CpuOveruseMetrics());
   metrics_->encode_usage_percent = usage_->Value();
+  metrics_->encode_cpu_usage_percent = encode_cpu_usage_percent_;
 
   metrics_observer_->OnEncodedFrameTimeMeasured(encode_duration_ms, *metrics_);
 }
@@ -271,7 +279,8 @@ void OveruseFrameDetector::ResetAll(int num_pixels) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&task_checker_);
   num_pixels_ = num_pixels;
   usage_->Reset();
-  frame_timing_.clear();
+  first_frame_timing_ = 0;
+  num_frame_timings_ = 0;
   last_capture_time_ms_ = -1;
   last_processed_capture_time_ms_ = -1;
   num_process_times_ = 0;
@@ -292,8 +301,29 @@ void OveruseFrameDetector::FrameCaptured(const VideoFrame& frame,
 
   last_capture_time_ms_ = time_when_first_seen_ms;
 
-  frame_timing_.push_back(FrameTiming(frame.ntp_time_ms(), frame.timestamp(),
-                                      time_when_first_seen_ms));
+  PushFrameTiming(FrameTiming(frame.ntp_time_ms(), frame.timestamp(),
+                              time_when_first_seen_ms));
+}
+
+OveruseFrameDetector::FrameTiming& OveruseFrameDetector::frame_timing(
+    size_t index) {
+  RTC_DCHECK_LT(index, num_frame_timings_);
+  return frame_timing_[(first_frame_timing_ + index) % kMaxFrameTimings];
+}
+
+void OveruseFrameDetector::PushFrameTiming(const FrameTiming& timing) {
+  // Frames that are neither sent nor timed out within kMaxFrameTimings
+  // captures are not going to be measured anyway.
+  if (num_frame_timings_ == kMaxFrameTimings)
+    PopFrameTiming();
+  ++num_frame_timings_;
+  frame_timing(num_frame_timings_ - 1) = timing;
+}
+
+void OveruseFrameDetector::PopFrameTiming() {
+  RTC_DCHECK_GT(num_frame_timings_, 0u);
+  first_frame_timing_ = (first_frame_timing_ + 1) % kMaxFrameTimings;
+  --num_frame_timings_;
 }
 
 void OveruseFrameDetector::FrameSent(uint32_t timestamp,
@@ -305,9 +335,12 @@ void OveruseFrameDetector::FrameSent(uint32_t timestamp,
   // samples before one second to trigger an overuse even when this is not the
   // case).
   static const int64_t kEncodingTimeMeasureWindowMs = 1000;
-  for (auto& it : frame_timing_) {
-    if (it.timestamp == timestamp) {
-      it.last_send_ms = time_sent_in_ms;
+  // The frame sent is usually one of the most recently captured ones, so
+  // search from the back.
+  for (size_t i = num_frame_timings_; i > 0; --i) {
+    FrameTiming& timing = frame_timing(i - 1);
+    if (timing.timestamp == timestamp) {
+      timing.last_send_ms = time_sent_in_ms;
       break;
     }
   }
@@ -317,8 +350,8 @@ void OveruseFrameDetector::FrameSent(uint32_t timestamp,
   // This is currently the case for all frames on ChromeOS, so logging them
   // would be spammy, and triggering overuse would be wrong.
   // https://crbug.com/350106
-  while (!frame_timing_.empty()) {
-    FrameTiming timing = frame_timing_.front();
+  while (num_frame_timings_ > 0) {
+    const FrameTiming& timing = frame_timing(0);
     if (time_sent_in_ms - timing.capture_ms < kEncodingTimeMeasureWindowMs)
       break;
     if (timing.last_send_ms != -1) {
@@ -335,12 +368,45 @@ void OveruseFrameDetector::FrameSent(uint32_t timestamp,
       last_processed_capture_time_ms_ = timing.capture_ms;
       EncodedFrameTimeMeasured(encode_duration_ms);
     }
-    frame_timing_.pop_front();
+    PopFrameTiming();
   }
 }
 
+void OveruseFrameDetector::MeasureThreadCpuTime() {
+  RTC_DCHECK_CALLED_SEQUENTIALLY(&task_checker_);
+  // The detector is checked on the encoder thread, so this is the CPU time
+  // spent encoding, plus whatever else is run on that thread.
+  int64_t cpu_time_ns = rtc::ThreadCpuTimeNanos();
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  if (cpu_time_ns < 0)
+    return;  // Not supported on this platform.
+  if (last_thread_cpu_time_ns_ >= 0 && now_ms > last_cpu_check_time_ms_) {
+    int64_t cpu_time_ms =
+        (cpu_time_ns - last_thread_cpu_time_ns_) / rtc::kNumNanosecsPerMillisec;
+    int64_t interval_ms = now_ms - last_cpu_check_time_ms_;
+    encode_cpu_usage_percent_ =
+        static_cast<int>((100 * cpu_time_ms + interval_ms / 2) / interval_ms);
+    if (metrics_) {
+      metrics_->encode_cpu_usage_percent = encode_cpu_usage_percent_;
+      metrics_observer_->OnEncoderCpuTimeMeasured(cpu_time_ms, interval_ms,
+                                                  *metrics_);
+    }
+  }
+  last_thread_cpu_time_ns_ = cpu_time_ns;
+  last_cpu_check_time_ms_ = now_ms;
+}
+
+int OveruseFrameDetector::UsagePercent(
+    const CpuOveruseMetrics& metrics) const {
+  if (options_.use_thread_cpu_time && metrics.encode_cpu_usage_percent >= 0)
+    return metrics.encode_cpu_usage_percent;
+  return metrics.encode_usage_percent;
+}
+
 void OveruseFrameDetector::CheckForOveruse() {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&task_checker_);
+  if (options_.use_thread_cpu_time)
+    MeasureThreadCpuTime();
   ++num_process_times_;
   if (num_process_times_ <= options_.min_process_count || !metrics_)
     return;
@@ -385,14 +451,14 @@ void OveruseFrameDetector::CheckForOveruse() {
 
   LOG(LS_VERBOSE) << " Frame stats: "
                   << " encode usage " << metrics_->encode_usage_percent
+                  << " encode cpu usage " << metrics_->encode_cpu_usage_percent
                   << " overuse detections " << num_overuse_detections_
                   << " rampup delay " << rampup_delay;
 }
 
 bool OveruseFrameDetector::IsOverusing(const CpuOveruseMetrics& metrics) {
   RTC_DCHECK_CALLED_SEQUENTIALLY(&task_checker_);
-  if (metrics.encode_usage_percent >=
-      options_.high_encode_usage_threshold_percent) {
+  if (UsagePercent(metrics) >= options_.high_encode_usage_threshold_percent) {
     ++checks_above_threshold_;
   } else {
     checks_above_threshold_ = 0;
@@ -407,7 +473,6 @@ bool OveruseFrameDetector::IsUnderusing(const CpuOveruseMetrics& metrics,
   if (time_now < last_rampup_time_ms_ + delay)
     return false;
 
-  return metrics.encode_usage_percent <
-         options_.low_encode_usage_threshold_percent;
+  return UsagePercent(metrics) < options_.low_encode_usage_threshold_percent;
 }
 }  // namespace webrtc
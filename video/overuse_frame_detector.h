@@ -11,8 +11,8 @@
 #ifndef WEBRTC_VIDEO_OVERUSE_FRAME_DETECTOR_H_
 #define WEBRTC_VIDEO_OVERUSE_FRAME_DETECTOR_H_
 
-#include <list>
 #include <memory>
+#include <vector>
 
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/numerics/exp_filter.h"
@@ -42,6 +42,9 @@ struct CpuOveruseOptions {
   int high_threshold_consecutive_count;  // The number of consecutive checks
                                          // above the high threshold before
                                          // triggering an overuse.
+  bool use_thread_cpu_time;  // Adapt on the CPU time used by the thread the
+                             // detector runs on, instead of on the wall-clock
+                             // time from capture to send.
 };
 
 struct CpuOveruseMetrics {
@@ -49,6 +52,9 @@ struct CpuOveruseMetrics {
 
   int encode_usage_percent;  // Average encode time divided by the average time
                              // difference between incoming captured frames.
+  int encode_cpu_usage_percent = -1;  // CPU time used by the encoder thread
+                                      // divided by the wall-clock time, -1 if
+                                      // not measured.
 };
 
 class CpuOveruseMetricsObserver {
@@ -56,6 +62,12 @@ class CpuOveruseMetricsObserver {
   virtual ~CpuOveruseMetricsObserver() {}
   virtual void OnEncodedFrameTimeMeasured(int encode_duration_ms,
                                           const CpuOveruseMetrics& metrics) = 0;
+  // Called on every overuse check when CpuOveruseOptions::use_thread_cpu_time
+  // is set, with the CPU time the encoder thread used during the
+  // |interval_ms| since the previous check.
+  virtual void OnEncoderCpuTimeMeasured(int64_t cpu_time_ms,
+                                        int64_t interval_ms,
+                                        const CpuOveruseMetrics& metrics) {}
 };
 
 // Use to detect system overuse based on the send-side processing time of
@@ -92,6 +104,7 @@ class OveruseFrameDetector {
   class SendProcessingUsage;
   class CheckOveruseTask;
   struct FrameTiming {
+    FrameTiming() : FrameTiming(0, 0, 0) {}
     FrameTiming(int64_t capture_ntp_ms, uint32_t timestamp, int64_t now)
         : capture_ntp_ms(capture_ntp_ms),
           timestamp(timestamp),
@@ -103,7 +116,19 @@ class OveruseFrameDetector {
     int64_t last_send_ms;
   };
 
+  // Capacity of |frame_timing_|. When full, the oldest frame is dropped
+  // without being measured.
+  static const size_t kMaxFrameTimings = 128;
+
   void EncodedFrameTimeMeasured(int encode_duration_ms);
+  void MeasureThreadCpuTime();
+  // The usage overuse and underuse are detected on, depending on
+  // |options_.use_thread_cpu_time|.
+  int UsagePercent(const CpuOveruseMetrics& metrics) const;
+
+  FrameTiming& frame_timing(size_t index);
+  void PushFrameTiming(const FrameTiming& timing);
+  void PopFrameTiming();
   bool IsOverusing(const CpuOveruseMetrics& metrics);
   bool IsUnderusing(const CpuOveruseMetrics& metrics, int64_t time_now);
 
@@ -141,10 +166,19 @@ class OveruseFrameDetector {
   bool in_quick_rampup_ GUARDED_BY(task_checker_);
   int current_rampup_delay_ms_ GUARDED_BY(task_checker_);
 
+  // Thread CPU time and wall-clock time of the previous overuse check.
+  int64_t last_thread_cpu_time_ns_ GUARDED_BY(task_checker_);
+  int64_t last_cpu_check_time_ms_ GUARDED_BY(task_checker_);
+  int encode_cpu_usage_percent_ GUARDED_BY(task_checker_);
+
   // TODO(asapersson): Can these be regular members (avoid separate heap
   // allocs)?
   const std::unique_ptr<SendProcessingUsage> usage_ GUARDED_BY(task_checker_);
-  std::list<FrameTiming> frame_timing_ GUARDED_BY(task_checker_);
+  // Ring buffer of the frames in flight, oldest first, of kMaxFrameTimings
+  // entries of which |num_frame_timings_| from |first_frame_timing_| are used.
+  std::vector<FrameTiming> frame_timing_ GUARDED_BY(task_checker_);
+  size_t first_frame_timing_ GUARDED_BY(task_checker_);
+  size_t num_frame_timings_ GUARDED_BY(task_checker_);
 
   RTC_DISALLOW_COPY_AND_ASSIGN(OveruseFrameDetector);
 };
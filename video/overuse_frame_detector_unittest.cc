@@ -12,6 +12,7 @@
 
 #include "webrtc/api/video/i420_buffer.h"
 #include "webrtc/base/event.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/system_wrappers/include/clock.h"
 #include "webrtc/test/gmock.h"
 #include "webrtc/test/gtest.h"
@@ -91,6 +92,12 @@ class OveruseFrameDetectorTest : public ::testing::Test,
     metrics_ = metrics;
   }
 
+  void OnEncoderCpuTimeMeasured(int64_t cpu_time_ms,
+                                int64_t interval_ms,
+                                const CpuOveruseMetrics& metrics) override {
+    metrics_ = metrics;
+  }
+
   int InitialUsage() {
     return ((options_.low_encode_usage_threshold_percent +
              options_.high_encode_usage_threshold_percent) / 2.0f) + 0.5;
@@ -326,6 +333,39 @@ TEST_F(OveruseFrameDetectorTest, UpdatesExistingSamples) {
   }
 }
 
+TEST_F(OveruseFrameDetectorTest, MeasuresFramesAfterMoreThanMaxInFlight) {
+  // None of these frames are sent, so they are dropped from the detector
+  // without being measured.
+  VideoFrame frame(I420Buffer::Create(kWidth, kHeight),
+                   webrtc::kVideoRotation_0, 0);
+  for (uint32_t i = 0; i < 500; ++i) {
+    frame.set_timestamp(i);
+    overuse_detector_->FrameCaptured(frame, clock_->TimeInMilliseconds());
+    clock_->AdvanceTimeMilliseconds(1);
+  }
+  // >85% encoding time should still trigger overuse.
+  EXPECT_CALL(*(observer_.get()), ScaleDown(reason_)).Times(1);
+  TriggerOveruse(options_.high_threshold_consecutive_count);
+}
+
+TEST_F(OveruseFrameDetectorTest, UsesThreadCpuTimeWhenEnabled) {
+  if (rtc::ThreadCpuTimeNanos() < 0)
+    return;  // Not supported on this platform.
+  options_.use_thread_cpu_time = true;
+  ReinitializeOveruseDetector();
+  // The encode times are simulated, so the thread spends next to no CPU time
+  // during the simulated seconds between checks and overuse should not be
+  // triggered even though the encode usage is high.
+  EXPECT_CALL(*(observer_.get()), ScaleDown(reason_)).Times(0);
+  overuse_detector_->CheckForOveruse();
+  TriggerOveruse(options_.high_threshold_consecutive_count);
+  EXPECT_GE(metrics_.encode_usage_percent,
+            options_.high_encode_usage_threshold_percent);
+  EXPECT_GE(metrics_.encode_cpu_usage_percent, 0);
+  EXPECT_LT(metrics_.encode_cpu_usage_percent,
+            options_.high_encode_usage_threshold_percent);
+}
+
 TEST_F(OveruseFrameDetectorTest, RunOnTqNormalUsage) {
   rtc::TaskQueue queue("OveruseFrameDetectorTestQueue");
 
@@ -0,0 +1,280 @@
+/*
+ *  Copyright 2017 The WebRTC Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS.  All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include <algorithm>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/sslstreamadapter.h"
+#include "webrtc/base/timeutils.h"
+#include "webrtc/call/call.h"
+#include "webrtc/config.h"
+#include "webrtc/logging/rtc_event_log/rtc_event_log.h"
+#include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/system_wrappers/include/sleep.h"
+#include "webrtc/test/call_test.h"
+#include "webrtc/test/direct_transport.h"
+#include "webrtc/test/encoder_settings.h"
+#include "webrtc/test/fake_encoder.h"
+#include "webrtc/test/frame_generator_capturer.h"
+#include "webrtc/test/gtest.h"
+#include "webrtc/test/testsupport/perf_test.h"
+
+namespace webrtc {
+namespace {
+
+constexpr int kRunTimeMs = 10000;
+constexpr int kWidth = 640;
+constexpr int kHeight = 360;
+constexpr int kFramerate = 30;
+constexpr uint32_t kVideoSsrc = 0x10000;
+// AES-256-GCM uses a 32 bytes key and a 12 bytes salt.
+constexpr size_t kKeyAndSaltSize = 44;
+
+MediaCryptoKey CreateKey() {
+  MediaCryptoKey key;
+  key.type = rtc::SRTP_AEAD_AES_256_GCM;
+  for (size_t i = 0; i < kKeyAndSaltSize; ++i)
+    key.buffer.push_back(static_cast<uint8_t>(i));
+  return key;
+}
+
+// Delivers packets to a receiving Call and measures the CPU time spent doing
+// it, which includes parsing and decrypting the packets. Called on the thread
+// of a single DirectTransport, so the totals must only be read once that
+// transport has stopped.
+class TimedReceiver : public PacketReceiver {
+ public:
+  explicit TimedReceiver(PacketReceiver* receiver)
+      : receiver_(receiver), cpu_time_ns_(0), packets_(0) {}
+
+  DeliveryStatus DeliverPacket(MediaType media_type,
+                               const uint8_t* packet,
+                               size_t length,
+                               const PacketTime& packet_time) override {
+    const int64_t start_ns = rtc::ThreadCpuTimeNanos();
+    DeliveryStatus status =
+        receiver_->DeliverPacket(media_type, packet, length, packet_time);
+    const int64_t end_ns = rtc::ThreadCpuTimeNanos();
+    if (start_ns >= 0 && end_ns >= 0) {
+      cpu_time_ns_ += end_ns - start_ns;
+      ++packets_;
+    }
+    return status;
+  }
+
+  int64_t cpu_time_ns() const { return cpu_time_ns_; }
+  int64_t packets() const { return packets_; }
+
+ private:
+  PacketReceiver* const receiver_;
+  int64_t cpu_time_ns_;
+  int64_t packets_;
+};
+
+// Stands in for a PERC media distributor between the sender and the
+// receivers. The media is encrypted end to end, so the distributor only
+// handles the outer packet: it forwards each packet from the sender to every
+// receiver over a link of its own.
+class MediaDistributor : public Transport {
+ public:
+  void AddReceiver(test::DirectTransport* downlink) {
+    downlinks_.push_back(downlink);
+  }
+
+  bool SendRtp(const uint8_t* packet,
+               size_t length,
+               const PacketOptions& options) override {
+    for (test::DirectTransport* downlink : downlinks_)
+      downlink->SendRtp(packet, length, options);
+    return true;
+  }
+
+  bool SendRtcp(const uint8_t* packet, size_t length) override {
+    for (test::DirectTransport* downlink : downlinks_)
+      downlink->SendRtcp(packet, length);
+    return true;
+  }
+
+ private:
+  std::vector<test::DirectTransport*> downlinks_;
+};
+
+// Collects the time from capture to render of the frames of all receivers.
+class LatencyObserver : public rtc::VideoSinkInterface<VideoFrame> {
+ public:
+  explicit LatencyObserver(Clock* clock) : clock_(clock) {}
+
+  void OnFrame(const VideoFrame& video_frame) override {
+    // The capture time is estimated from the RTCP sender reports, and isn't
+    // known until the first one has been received.
+    if (video_frame.ntp_time_ms() <= 0)
+      return;
+    // The estimate can be off by a few ms, so a latency can be negative.
+    const int64_t latency_ms = std::max<int64_t>(
+        clock_->CurrentNtpInMilliseconds() - video_frame.ntp_time_ms(), 0);
+    rtc::CritScope lock(&crit_);
+    latencies_ms_.push_back(latency_ms);
+  }
+
+  // Returns the |percentile| of the latencies, in [0, 100].
+  int64_t Percentile(int percentile) {
+    rtc::CritScope lock(&crit_);
+    if (latencies_ms_.empty())
+      return 0;
+    std::sort(latencies_ms_.begin(), latencies_ms_.end());
+    size_t index = (latencies_ms_.size() - 1) * percentile / 100;
+    return latencies_ms_[index];
+  }
+
+  size_t num_frames() {
+    rtc::CritScope lock(&crit_);
+    return latencies_ms_.size();
+  }
+
+ private:
+  Clock* const clock_;
+  rtc::CriticalSection crit_;
+  std::vector<int64_t> latencies_ms_ GUARDED_BY(crit_);
+};
+
+// Sends one media encrypted video stream through a MediaDistributor to
+// |num_receivers| receivers, each in a Call of its own, and reports the CPU
+// used and the capture to render latency.
+void RunLoadTest(size_t num_receivers) {
+  Clock* clock = Clock::GetRealTimeClock();
+  const MediaCryptoKey key = CreateKey();
+  const std::string trace = std::to_string(num_receivers) + "_receivers";
+
+  RtcEventLogNullImpl event_log;
+  Call::Config call_config(&event_log);
+  std::unique_ptr<Call> sender_call(Call::Create(call_config));
+  // The RTCP of all the receivers shares one link back to the sender.
+  test::DirectTransport uplink(nullptr);
+  uplink.SetReceiver(sender_call->Receiver());
+
+  MediaDistributor distributor;
+  std::vector<std::unique_ptr<Call>> receiver_calls;
+  std::vector<std::unique_ptr<TimedReceiver>> timed_receivers;
+  std::vector<std::unique_ptr<test::DirectTransport>> downlinks;
+  for (size_t i = 0; i < num_receivers; ++i) {
+    receiver_calls.emplace_back(Call::Create(call_config));
+    timed_receivers.emplace_back(
+        new TimedReceiver(receiver_calls.back()->Receiver()));
+    downlinks.emplace_back(new test::DirectTransport(nullptr));
+    downlinks.back()->SetReceiver(timed_receivers.back().get());
+    distributor.AddReceiver(downlinks.back().get());
+  }
+
+  test::FakeEncoder encoder(clock);
+  VideoSendStream::Config send_config(&distributor);
+  send_config.rtp.ssrcs.push_back(kVideoSsrc);
+  send_config.encoder_settings.encoder = &encoder;
+  send_config.encoder_settings.payload_name = "FAKE";
+  send_config.encoder_settings.payload_type =
+      test::CallTest::kFakeVideoSendPayloadType;
+  send_config.media_crypto_enabled = true;
+  send_config.media_crypto_key = key;
+  VideoEncoderConfig encoder_config;
+  test::FillEncoderConfiguration(1, &encoder_config);
+  VideoSendStream* send_stream = sender_call->CreateVideoSendStream(
+      send_config.Copy(), encoder_config.Copy());
+
+  LatencyObserver latency_observer(clock);
+  std::vector<std::unique_ptr<VideoDecoder>> allocated_decoders;
+  std::vector<VideoReceiveStream*> receive_streams;
+  for (size_t i = 0; i < num_receivers; ++i) {
+    VideoReceiveStream::Config receive_config(&uplink);
+    receive_config.rtp.remote_ssrc = kVideoSsrc;
+    receive_config.rtp.local_ssrc =
+        test::CallTest::kReceiverLocalVideoSsrc + static_cast<uint32_t>(i);
+    receive_config.renderer = &latency_observer;
+    receive_config.media_crypto_enabled = true;
+    receive_config.media_crypto_key = key;
+    VideoReceiveStream::Decoder decoder =
+        test::CreateMatchingDecoder(send_config.encoder_settings);
+    allocated_decoders.emplace_back(decoder.decoder);
+    receive_config.decoders.push_back(decoder);
+    receive_streams.push_back(receiver_calls[i]->CreateVideoReceiveStream(
+        std::move(receive_config)));
+    receive_streams.back()->Start();
+  }
+
+  std::unique_ptr<test::FrameGeneratorCapturer> capturer(
+      test::FrameGeneratorCapturer::Create(kWidth, kHeight, kFramerate, clock));
+  send_stream->SetSource(capturer.get(),
+                         VideoSendStream::DegradationPreference::kBalanced);
+  send_stream->Start();
+  capturer->Start();
+
+  const std::clock_t start_cpu = std::clock();
+  SleepMs(kRunTimeMs);
+  const std::clock_t end_cpu = std::clock();
+
+  capturer->Stop();
+  send_stream->Stop();
+  for (VideoReceiveStream* receive_stream : receive_streams)
+    receive_stream->Stop();
+  for (auto& downlink : downlinks)
+    downlink->StopSending();
+  uplink.StopSending();
+
+  int64_t receive_cpu_time_ns = 0;
+  int64_t received_packets = 0;
+  for (const auto& timed_receiver : timed_receivers) {
+    receive_cpu_time_ns += timed_receiver->cpu_time_ns();
+    received_packets += timed_receiver->packets();
+  }
+  EXPECT_GT(latency_observer.num_frames(), 0u);
+
+  // The CPU time of all the threads of the process, in percent of one core.
+  test::PrintResult(
+      "perc_load_cpu", "", trace,
+      static_cast<size_t>(100 * (end_cpu - start_cpu) / CLOCKS_PER_SEC *
+                          1000 / kRunTimeMs),
+      "%", false);
+  test::PrintResult(
+      "perc_load_receive_cpu_per_packet", "", trace,
+      static_cast<size_t>(
+          received_packets > 0 ? receive_cpu_time_ns / received_packets : 0),
+      "ns", false);
+  test::PrintResult("perc_load_latency_p50", "", trace,
+                    static_cast<size_t>(latency_observer.Percentile(50)), "ms",
+                    false);
+  test::PrintResult("perc_load_latency_p95", "", trace,
+                    static_cast<size_t>(latency_observer.Percentile(95)), "ms",
+                    false);
+  test::PrintResult("perc_load_latency_p99", "", trace,
+                    static_cast<size_t>(latency_observer.Percentile(99)), "ms",
+                    false);
+
+  sender_call->DestroyVideoSendStream(send_stream);
+  for (size_t i = 0; i < num_receivers; ++i)
+    receiver_calls[i]->DestroyVideoReceiveStream(receive_streams[i]);
+}
+
+}  // namespace
+
+TEST(PercLoadTest, OneReceiver) {
+  RunLoadTest(1);
+}
+
+TEST(PercLoadTest, TenReceivers) {
+  RunLoadTest(10);
+}
+
+TEST(PercLoadTest, FiftyReceivers) {
+  RunLoadTest(50);
+}
+
+}  // namespace webrtc
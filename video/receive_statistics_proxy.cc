@@ -10,6 +10,7 @@
 
 #include "webrtc/video/receive_statistics_proxy.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "webrtc/base/checks.h"
@@ -132,8 +133,8 @@ void ReceiveStatisticsProxy::UpdateHistograms() {
   if (decode_ms != -1)
     RTC_HISTOGRAM_COUNTS_1000("WebRTC.Video.DecodeTimeInMs", decode_ms);
 
-  if (field_trial::FindFullName("WebRTC-NewVideoJitterBuffer") !=
-        "Enabled") {
+  if (field_trial::FindFullName("WebRTC-NewVideoJitterBuffer") ==
+        "Disabled") {
     int jb_delay_ms =
         jitter_buffer_delay_counter_.Avg(kMinRequiredDecodeSamples);
     if (jb_delay_ms != -1) {
@@ -471,6 +472,12 @@ void ReceiveStatisticsProxy::OnPreDecode(
   }
 }
 
+void ReceiveStatisticsProxy::OnFecRecoveredPacket(uint8_t temporal_layer) {
+  rtc::CritScope lock(&crit_);
+  ++stats_.fec_recovered_packets[std::min<int>(temporal_layer,
+                                               kMaxTemporalStreams - 1)];
+}
+
 void ReceiveStatisticsProxy::SampleCounter::Add(int sample) {
   sum += sample;
   ++num_samples;
@@ -146,6 +146,19 @@ TEST_F(ReceiveStatisticsProxyTest, GetStatsReportsDiscardedPackets) {
   EXPECT_EQ(kDiscardedPackets, statistics_proxy_->GetStats().discarded_packets);
 }
 
+TEST_F(ReceiveStatisticsProxyTest, GetStatsReportsFecRecoveredPacketsPerLayer) {
+  statistics_proxy_->OnFecRecoveredPacket(0);
+  statistics_proxy_->OnFecRecoveredPacket(2);
+  statistics_proxy_->OnFecRecoveredPacket(2);
+  // Layers beyond the last one are counted in it.
+  statistics_proxy_->OnFecRecoveredPacket(7);
+  VideoReceiveStream::Stats stats = statistics_proxy_->GetStats();
+  EXPECT_EQ(1u, stats.fec_recovered_packets[0]);
+  EXPECT_EQ(0u, stats.fec_recovered_packets[1]);
+  EXPECT_EQ(2u, stats.fec_recovered_packets[2]);
+  EXPECT_EQ(1u, stats.fec_recovered_packets[3]);
+}
+
 TEST_F(ReceiveStatisticsProxyTest, GetStatsReportsRtcpStats) {
   const uint8_t kFracLost = 0;
   const uint32_t kCumLost = 1;
@@ -13,13 +13,19 @@
 #include <map>
 #include <memory>
 #include <sstream>
+#include <vector>
 
 #include "gflags/gflags.h"
 #include "webrtc/base/checks.h"
+#include "webrtc/base/criticalsection.h"
+#include "webrtc/base/sslstreamadapter.h"
+#include "webrtc/base/timeutils.h"
 #include "webrtc/call/call.h"
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
+#include "webrtc/config.h"
 #include "webrtc/logging/rtc_event_log/rtc_event_log.h"
 #include "webrtc/modules/rtp_rtcp/include/rtp_header_parser.h"
+#include "webrtc/modules/rtp_rtcp/source/byte_io.h"
 #include "webrtc/system_wrappers/include/clock.h"
 #include "webrtc/system_wrappers/include/sleep.h"
 #include "webrtc/test/encoder_settings.h"
@@ -37,8 +43,6 @@
 namespace webrtc {
 namespace flags {
 
-// TODO(pbos): Multiple receivers.
-
 // Flag for payload type.
 static bool ValidatePayloadType(const char* flagname, int32_t payload_type) {
   return payload_type > 0 && payload_type <= 127;
@@ -132,6 +136,34 @@ static std::string DecoderBitstreamFilename() {
 DEFINE_string(codec, "VP8", "Video codec");
 static std::string Codec() { return static_cast<std::string>(FLAGS_codec); }
 
+// Flag for the number of receive streams.
+static bool ValidateNumStreams(const char* flagname, int32_t num_streams) {
+  return num_streams > 0;
+}
+DEFINE_int32(num_streams,
+             1,
+             "Number of receive streams. Each packet of --ssrc is delivered "
+             "to stream i with the SSRC --ssrc + i");
+static size_t NumStreams() { return static_cast<size_t>(FLAGS_num_streams); }
+static const bool num_streams_dummy =
+    google::RegisterFlagValidator(&FLAGS_num_streams, &ValidateNumStreams);
+
+// Flag for the end to end media encryption key.
+DEFINE_string(media_crypto_key,
+              "",
+              "Base64 AES-256-GCM key and salt of the inner media encryption. "
+              "Media encryption is disabled if empty");
+static std::string MediaCryptoKeyString() {
+  return static_cast<std::string>(FLAGS_media_crypto_key);
+}
+
+// Flag for the benchmark mode.
+DEFINE_bool(benchmark,
+            false,
+            "Deliver the packets as fast as possible without rendering them, "
+            "and print the receive performance");
+static bool Benchmark() { return FLAGS_benchmark; }
+
 }  // namespace flags
 
 static const uint32_t kReceiverLocalSsrc = 0x123456;
@@ -206,53 +238,182 @@ class DecoderBitstreamFileWriter : public EncodedFrameObserver {
   FILE* file_;
 };
 
+// Measures the time spent in the wrapped decoder, for the benchmark mode.
+class TimedDecoder : public VideoDecoder {
+ public:
+  explicit TimedDecoder(VideoDecoder* decoder)
+      : decoder_(decoder), decode_time_us_(0), decoded_frames_(0) {}
+
+  int32_t InitDecode(const VideoCodec* codec_settings,
+                     int32_t number_of_cores) override {
+    return decoder_->InitDecode(codec_settings, number_of_cores);
+  }
+
+  int32_t Decode(const EncodedImage& input_image,
+                 bool missing_frames,
+                 const RTPFragmentationHeader* fragmentation,
+                 const CodecSpecificInfo* codec_specific_info,
+                 int64_t render_time_ms) override {
+    const int64_t start_us = rtc::TimeMicros();
+    int32_t result = decoder_->Decode(input_image, missing_frames,
+                                      fragmentation, codec_specific_info,
+                                      render_time_ms);
+    const int64_t decode_time_us = rtc::TimeMicros() - start_us;
+    rtc::CritScope lock(&crit_);
+    decode_time_us_ += decode_time_us;
+    ++decoded_frames_;
+    return result;
+  }
+
+  int32_t RegisterDecodeCompleteCallback(
+      DecodedImageCallback* callback) override {
+    return decoder_->RegisterDecodeCompleteCallback(callback);
+  }
+
+  int32_t Release() override { return decoder_->Release(); }
+
+  bool PrefersLateDecoding() const override {
+    return decoder_->PrefersLateDecoding();
+  }
+
+  const char* ImplementationName() const override {
+    return decoder_->ImplementationName();
+  }
+
+  int64_t decode_time_us() {
+    rtc::CritScope lock(&crit_);
+    return decode_time_us_;
+  }
+
+  int decoded_frames() {
+    rtc::CritScope lock(&crit_);
+    return decoded_frames_;
+  }
+
+ private:
+  const std::unique_ptr<VideoDecoder> decoder_;
+  rtc::CriticalSection crit_;
+  int64_t decode_time_us_ GUARDED_BY(crit_);
+  int decoded_frames_ GUARDED_BY(crit_);
+};
+
+// Delivers |packet| to |call| once for each receive stream. The media packets
+// of --ssrc are delivered to stream i with the SSRC --ssrc + i, other packets
+// are delivered once. Counts the packets of unknown SSRCs in
+// |unknown_packets|.
+void DeliverPacket(Call* call,
+                   uint8_t* packet,
+                   size_t length,
+                   std::map<uint32_t, int>* unknown_packets) {
+  const bool is_media = !RtpHeaderParser::IsRtcp(packet, length) &&
+                        length >= 12 &&
+                        ByteReader<uint32_t>::ReadBigEndian(&packet[8]) ==
+                            flags::Ssrc();
+  const size_t num_deliveries = is_media ? flags::NumStreams() : 1;
+  for (size_t i = 0; i < num_deliveries; ++i) {
+    if (is_media) {
+      ByteWriter<uint32_t>::WriteBigEndian(
+          &packet[8], flags::Ssrc() + static_cast<uint32_t>(i));
+    }
+    switch (call->Receiver()->DeliverPacket(webrtc::MediaType::ANY, packet,
+                                            length, PacketTime())) {
+      case PacketReceiver::DELIVERY_OK:
+        break;
+      case PacketReceiver::DELIVERY_UNKNOWN_SSRC: {
+        RTPHeader header;
+        std::unique_ptr<RtpHeaderParser> parser(RtpHeaderParser::Create());
+        parser->Parse(packet, length, &header);
+        if ((*unknown_packets)[header.ssrc] == 0)
+          fprintf(stderr, "Unknown SSRC: %u!\n", header.ssrc);
+        ++(*unknown_packets)[header.ssrc];
+        break;
+      }
+      case PacketReceiver::DELIVERY_PACKET_ERROR:
+        fprintf(stderr, "Packet error, corrupt packets or incorrect setup?\n");
+        break;
+    }
+  }
+  if (is_media)
+    ByteWriter<uint32_t>::WriteBigEndian(&packet[8], flags::Ssrc());
+}
+
 void RtpReplay() {
-  std::unique_ptr<test::VideoRenderer> playback_video(
-      test::VideoRenderer::Create("Playback Video", 640, 480));
+  std::unique_ptr<test::VideoRenderer> playback_video;
+  if (!flags::Benchmark()) {
+    playback_video.reset(
+        test::VideoRenderer::Create("Playback Video", 640, 480));
+  }
   FileRenderPassthrough file_passthrough(flags::OutBase(),
                                          playback_video.get());
 
+  MediaCryptoKey media_crypto_key;
+  const bool media_crypto_enabled = !flags::MediaCryptoKeyString().empty();
+  if (media_crypto_enabled &&
+      !media_crypto_key.Parse(rtc::SRTP_AEAD_AES_256_GCM,
+                              flags::MediaCryptoKeyString())) {
+    fprintf(stderr, "Invalid media crypto key\n");
+    return;
+  }
+
   webrtc::RtcEventLogNullImpl event_log;
   std::unique_ptr<Call> call(Call::Create(Call::Config(&event_log)));
 
   test::NullTransport transport;
-  VideoReceiveStream::Config receive_config(&transport);
-  receive_config.rtp.remote_ssrc = flags::Ssrc();
-  receive_config.rtp.local_ssrc = kReceiverLocalSsrc;
-  receive_config.rtp.ulpfec.ulpfec_payload_type = flags::FecPayloadType();
-  receive_config.rtp.ulpfec.red_payload_type = flags::RedPayloadType();
-  receive_config.rtp.nack.rtp_history_ms = 1000;
-  if (flags::TransmissionOffsetId() != -1) {
-    receive_config.rtp.extensions.push_back(RtpExtension(
-        RtpExtension::kTimestampOffsetUri, flags::TransmissionOffsetId()));
-  }
-  if (flags::AbsSendTimeId() != -1) {
-    receive_config.rtp.extensions.push_back(
-        RtpExtension(RtpExtension::kAbsSendTimeUri, flags::AbsSendTimeId()));
-  }
-  receive_config.renderer = &file_passthrough;
-
   VideoSendStream::Config::EncoderSettings encoder_settings;
   encoder_settings.payload_name = flags::Codec();
   encoder_settings.payload_type = flags::PayloadType();
-  VideoReceiveStream::Decoder decoder;
   std::unique_ptr<DecoderBitstreamFileWriter> bitstream_writer;
   if (!flags::DecoderBitstreamFilename().empty()) {
     bitstream_writer.reset(new DecoderBitstreamFileWriter(
         flags::DecoderBitstreamFilename().c_str()));
-    receive_config.pre_decode_callback = bitstream_writer.get();
-  }
-  decoder = test::CreateMatchingDecoder(encoder_settings);
-  if (!flags::DecoderBitstreamFilename().empty()) {
-    // Replace with a null decoder if we're writing the bitstream to a file
-    // instead.
-    delete decoder.decoder;
-    decoder.decoder = new test::FakeNullDecoder();
   }
-  receive_config.decoders.push_back(decoder);
 
-  VideoReceiveStream* receive_stream =
-      call->CreateVideoReceiveStream(std::move(receive_config));
+  std::vector<VideoReceiveStream*> receive_streams;
+  std::vector<std::unique_ptr<VideoDecoder>> decoders;
+  std::vector<TimedDecoder*> timed_decoders;
+  for (size_t i = 0; i < flags::NumStreams(); ++i) {
+    VideoReceiveStream::Config receive_config(&transport);
+    receive_config.rtp.remote_ssrc = flags::Ssrc() + static_cast<uint32_t>(i);
+    receive_config.rtp.local_ssrc =
+        kReceiverLocalSsrc + static_cast<uint32_t>(i);
+    receive_config.rtp.ulpfec.ulpfec_payload_type = flags::FecPayloadType();
+    receive_config.rtp.ulpfec.red_payload_type = flags::RedPayloadType();
+    receive_config.rtp.nack.rtp_history_ms = 1000;
+    if (flags::TransmissionOffsetId() != -1) {
+      receive_config.rtp.extensions.push_back(RtpExtension(
+          RtpExtension::kTimestampOffsetUri, flags::TransmissionOffsetId()));
+    }
+    if (flags::AbsSendTimeId() != -1) {
+      receive_config.rtp.extensions.push_back(
+          RtpExtension(RtpExtension::kAbsSendTimeUri, flags::AbsSendTimeId()));
+    }
+    receive_config.media_crypto_enabled = media_crypto_enabled;
+    receive_config.media_crypto_key = media_crypto_key;
+    // Only the first stream is rendered and written to files.
+    if (i == 0) {
+      receive_config.renderer = &file_passthrough;
+      receive_config.pre_decode_callback = bitstream_writer.get();
+    }
+
+    VideoReceiveStream::Decoder decoder =
+        test::CreateMatchingDecoder(encoder_settings);
+    if (!flags::DecoderBitstreamFilename().empty()) {
+      // Replace with a null decoder if we're writing the bitstream to a file
+      // instead.
+      delete decoder.decoder;
+      decoder.decoder = new test::FakeNullDecoder();
+    }
+    if (flags::Benchmark()) {
+      TimedDecoder* timed_decoder = new TimedDecoder(decoder.decoder);
+      timed_decoders.push_back(timed_decoder);
+      decoder.decoder = timed_decoder;
+    }
+    decoders.emplace_back(decoder.decoder);
+    receive_config.decoders.push_back(decoder);
+
+    receive_streams.push_back(
+        call->CreateVideoReceiveStream(std::move(receive_config)));
+  }
 
   std::unique_ptr<test::RtpFileReader> rtp_reader(test::RtpFileReader::Create(
       test::RtpFileReader::kRtpDump, flags::InputFile()));
@@ -273,37 +434,70 @@ void RtpReplay() {
       }
     }
   }
-  receive_stream->Start();
+  for (VideoReceiveStream* receive_stream : receive_streams)
+    receive_stream->Start();
 
-  uint32_t last_time_ms = 0;
   int num_packets = 0;
   std::map<uint32_t, int> unknown_packets;
-  while (true) {
+  if (flags::Benchmark()) {
+    // Read the whole file first so that only the receive side is timed.
+    std::vector<std::vector<uint8_t>> packets;
     test::RtpPacket packet;
-    if (!rtp_reader->NextPacket(&packet))
-      break;
-    ++num_packets;
-    switch (call->Receiver()->DeliverPacket(webrtc::MediaType::ANY, packet.data,
-                                            packet.length, PacketTime())) {
-      case PacketReceiver::DELIVERY_OK:
-        break;
-      case PacketReceiver::DELIVERY_UNKNOWN_SSRC: {
-        RTPHeader header;
-        std::unique_ptr<RtpHeaderParser> parser(RtpHeaderParser::Create());
-        parser->Parse(packet.data, packet.length, &header);
-        if (unknown_packets[header.ssrc] == 0)
-          fprintf(stderr, "Unknown SSRC: %u!\n", header.ssrc);
-        ++unknown_packets[header.ssrc];
-        break;
+    while (rtp_reader->NextPacket(&packet))
+      packets.emplace_back(packet.data, packet.data + packet.length);
+    num_packets = static_cast<int>(packets.size());
+
+    const int64_t start_us = rtc::TimeMicros();
+    for (std::vector<uint8_t>& packet : packets)
+      DeliverPacket(call.get(), packet.data(), packet.size(), &unknown_packets);
+    const int64_t deliver_time_us = rtc::TimeMicros() - start_us;
+
+    // Decoding runs on the decoder threads; wait until they are idle.
+    const int kIdleWaitMs = 500;
+    int decoded_frames = -1;
+    int64_t decode_time_us = 0;
+    while (true) {
+      int frames = 0;
+      decode_time_us = 0;
+      for (TimedDecoder* timed_decoder : timed_decoders) {
+        frames += timed_decoder->decoded_frames();
+        decode_time_us += timed_decoder->decode_time_us();
       }
-      case PacketReceiver::DELIVERY_PACKET_ERROR:
-        fprintf(stderr, "Packet error, corrupt packets or incorrect setup?\n");
+      if (frames == decoded_frames)
         break;
+      decoded_frames = frames;
+      SleepMs(kIdleWaitMs);
     }
-    if (last_time_ms != 0 && last_time_ms != packet.time_ms) {
-      SleepMs(packet.time_ms - last_time_ms);
+
+    const int64_t deliveries =
+        static_cast<int64_t>(num_packets) * flags::NumStreams();
+    fprintf(stderr, "streams: %zu\n", flags::NumStreams());
+    fprintf(stderr, "media_crypto: %s\n",
+            media_crypto_enabled ? "enabled" : "disabled");
+    fprintf(stderr, "packets_per_second: %.0f\n",
+            deliver_time_us > 0
+                ? 1e6 * deliveries / deliver_time_us
+                : 0.0);
+    // Demuxing, parsing, decryption, the packet buffer and the reference
+    // finder all run on the delivering thread.
+    fprintf(stderr, "deliver_time_per_packet_us: %.2f\n",
+            deliveries > 0 ? 1.0 * deliver_time_us / deliveries : 0.0);
+    fprintf(stderr, "decoded_frames: %d\n", decoded_frames);
+    fprintf(stderr, "decode_time_per_frame_us: %.2f\n",
+            decoded_frames > 0 ? 1.0 * decode_time_us / decoded_frames : 0.0);
+  } else {
+    uint32_t last_time_ms = 0;
+    while (true) {
+      test::RtpPacket packet;
+      if (!rtp_reader->NextPacket(&packet))
+        break;
+      ++num_packets;
+      DeliverPacket(call.get(), packet.data, packet.length, &unknown_packets);
+      if (last_time_ms != 0 && last_time_ms != packet.time_ms) {
+        SleepMs(packet.time_ms - last_time_ms);
+      }
+      last_time_ms = packet.time_ms;
     }
-    last_time_ms = packet.time_ms;
   }
   fprintf(stderr, "num_packets: %d\n", num_packets);
 
@@ -314,9 +508,8 @@ void RtpReplay() {
         stderr, "Packets for unknown ssrc '%u': %d\n", it->first, it->second);
   }
 
-  call->DestroyVideoReceiveStream(receive_stream);
-
-  delete decoder.decoder;
+  for (VideoReceiveStream* receive_stream : receive_streams)
+    call->DestroyVideoReceiveStream(receive_stream);
 }
 }  // namespace webrtc
 
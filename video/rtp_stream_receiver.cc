@@ -15,6 +15,7 @@
 
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/base/refcount.h"
 #include "webrtc/base/sslstreamadapter.h"
 #include "webrtc/common_types.h"
 #include "webrtc/config.h"
@@ -93,6 +94,7 @@ RtpStreamReceiver::RtpStreamReceiver(
     PacedSender* paced_sender,
     PacketRouter* packet_router,
     VieRemb* remb,
+    MediaCryptoContext* media_crypto_context,
     const VideoReceiveStream::Config* config,
     ReceiveStatisticsProxy* receive_stats_proxy,
     ProcessThread* process_thread,
@@ -108,6 +110,7 @@ RtpStreamReceiver::RtpStreamReceiver(
       packet_router_(packet_router),
       remb_(remb),
       process_thread_(process_thread),
+      receive_stats_proxy_(receive_stats_proxy),
       ntp_estimator_(clock_),
       rtp_header_parser_(RtpHeaderParser::Create()),
       rtp_receiver_(RtpReceiver::CreateVideoReceiver(clock_,
@@ -116,6 +119,7 @@ RtpStreamReceiver::RtpStreamReceiver(
                                                      &rtp_payload_registry_)),
       rtp_receive_statistics_(ReceiveStatistics::Create(clock_)),
       ulpfec_receiver_(UlpfecReceiver::Create(this)),
+      ulpfec_recovered_packets_(0),
       receiving_(false),
       restored_packet_in_use_(false),
       last_packet_log_ms_(-1),
@@ -129,7 +133,8 @@ RtpStreamReceiver::RtpStreamReceiver(
                                     retransmission_rate_limiter)),
       complete_frame_callback_(complete_frame_callback),
       keyframe_request_sender_(keyframe_request_sender),
-      timing_(timing) {
+      timing_(timing),
+      encoded_buffer_pool_(new rtc::RefCountedObject<EncodedImageBufferPool>()) {
   packet_router_->AddRtpModule(rtp_rtcp_.get());
   rtp_receive_statistics_->RegisterRtpStatisticsCallback(receive_stats_proxy);
   rtp_receive_statistics_->RegisterRtcpStatisticsCallback(receive_stats_proxy);
@@ -200,28 +205,32 @@ RtpStreamReceiver::RtpStreamReceiver(
 
   process_thread_->RegisterModule(rtp_rtcp_.get());
 
-  jitter_buffer_experiment_ =
-      field_trial::FindFullName("WebRTC-NewVideoJitterBuffer") == "Enabled";
+  // The PacketBuffer, RtpFrameReferenceFinder and FrameBuffer path is the
+  // default. The legacy VCMJitterBuffer path is kept behind the field trial
+  // until it is removed.
+  use_frame_buffer_ =
+      field_trial::FindFullName("WebRTC-NewVideoJitterBuffer") != "Disabled";
 
-  if (jitter_buffer_experiment_) {
+  if (use_frame_buffer_) {
     nack_module_.reset(
         new NackModule(clock_, nack_sender, keyframe_request_sender));
     process_thread_->RegisterModule(nack_module_.get());
 
     packet_buffer_ = video_coding::PacketBuffer::Create(
-        clock_, kPacketBufferStartSize, kPacketBufferMaxSixe, this);
+        clock_, kPacketBufferStartSize, kPacketBufferMaxSixe, this,
+        encoded_buffer_pool_);
     reference_finder_.reset(new video_coding::RtpFrameReferenceFinder(this));
   }
   
   // Check if end to end media encryption is enabled
-  if (config->media_crypto_enabled)
-    rtp_receiver_->EnableMediaCrypto(config->media_crypto_key);
+  if (media_crypto_context)
+    rtp_receiver_->EnableMediaCrypto(media_crypto_context);
 }
 
 RtpStreamReceiver::~RtpStreamReceiver() {
   process_thread_->DeRegisterModule(rtp_rtcp_.get());
 
-  if (jitter_buffer_experiment_)
+  if (use_frame_buffer_)
     process_thread_->DeRegisterModule(nack_module_.get());
 
   packet_router_->RemoveRtpModule(rtp_rtcp_.get());
@@ -254,6 +263,11 @@ int RtpStreamReceiver::GetCsrcs(uint32_t* csrcs) const {
   return rtp_receiver_->CSRCs(csrcs);
 }
 
+EncodedImageBufferPool::Stats RtpStreamReceiver::GetEncodedBufferPoolStats()
+    const {
+  return encoded_buffer_pool_->GetStats();
+}
+
 RtpReceiver* RtpStreamReceiver::GetRtpReceiver() const {
   return rtp_receiver_.get();
 }
@@ -266,7 +280,7 @@ int32_t RtpStreamReceiver::OnReceivedPayloadData(
   WebRtcRTPHeader rtp_header_with_ntp = *rtp_header;
   rtp_header_with_ntp.ntp_time_ms =
       ntp_estimator_.Estimate(rtp_header->header.timestamp);
-  if (jitter_buffer_experiment_) {
+  if (use_frame_buffer_) {
     VCMPacket packet(payload_data, payload_size, rtp_header_with_ntp);
     timing_->IncomingTimestamp(packet.timestamp, clock_->TimeInMilliseconds());
     packet.timesNacked = nack_module_->OnReceivedPacket(packet);
@@ -308,11 +322,34 @@ int32_t RtpStreamReceiver::OnReceivedPayloadData(
 
 bool RtpStreamReceiver::OnRecoveredPacket(const uint8_t* rtp_packet,
                                           size_t rtp_packet_length) {
+  // Called by |ulpfec_receiver_| for both the media packets of RED and the
+  // recovered ones, which are counted before the callback.
+  size_t recovered_packets =
+      ulpfec_receiver_->GetPacketCounter().num_recovered_packets;
+  bool fec_recovered = recovered_packets != ulpfec_recovered_packets_;
+  ulpfec_recovered_packets_ = recovered_packets;
+  return ReceiveRestoredPacket(rtp_packet, rtp_packet_length, fec_recovered);
+}
+
+bool RtpStreamReceiver::OnFecRecoveredPacket(const uint8_t* rtp_packet,
+                                             size_t rtp_packet_length) {
+  return ReceiveRestoredPacket(rtp_packet, rtp_packet_length, true);
+}
+
+bool RtpStreamReceiver::ReceiveRestoredPacket(const uint8_t* rtp_packet,
+                                              size_t rtp_packet_length,
+                                              bool fec_recovered) {
   RTPHeader header;
   if (!rtp_header_parser_->Parse(rtp_packet, rtp_packet_length, &header)) {
     return false;
   }
   header.payload_type_frequency = kVideoPayloadTypeFrequency;
+  if (fec_recovered) {
+    receive_stats_proxy_->OnFecRecoveredPacket(
+        header.extension.hasFrameMarks
+            ? header.extension.frameMarks.temporalLayerId
+            : 0);
+  }
   bool in_order = IsPacketInOrder(header);
   return ReceivePacket(rtp_packet, rtp_packet_length, header, in_order);
 }
@@ -439,7 +476,7 @@ void RtpStreamReceiver::OnCompleteFrame(
 }
 
 void RtpStreamReceiver::OnRttUpdate(int64_t avg_rtt_ms, int64_t max_rtt_ms) {
-  if (jitter_buffer_experiment_)
+  if (use_frame_buffer_)
     nack_module_->UpdateRtt(max_rtt_ms);
 }
 
@@ -502,7 +539,7 @@ bool RtpStreamReceiver::ParseAndHandleEncapsulatingHeader(
       return false;
     }
     restored_packet_in_use_ = true;
-    bool ret = OnRecoveredPacket(restored_packet_, packet_length);
+    bool ret = ReceiveRestoredPacket(restored_packet_, packet_length, false);
     restored_packet_in_use_ = false;
     return ret;
   }
@@ -568,7 +605,7 @@ bool RtpStreamReceiver::DeliverRtcp(const uint8_t* rtcp_packet,
 }
 
 void RtpStreamReceiver::FrameContinuous(uint16_t picture_id) {
-  if (jitter_buffer_experiment_) {
+  if (use_frame_buffer_) {
     int seq_num = -1;
     {
       rtc::CritScope lock(&last_seq_num_cs_);
@@ -582,7 +619,7 @@ void RtpStreamReceiver::FrameContinuous(uint16_t picture_id) {
 }
 
 void RtpStreamReceiver::FrameDecoded(uint16_t picture_id) {
-  if (jitter_buffer_experiment_) {
+  if (use_frame_buffer_) {
     int seq_num = -1;
     {
       rtc::CritScope lock(&last_seq_num_cs_);
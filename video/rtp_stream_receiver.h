@@ -19,6 +19,7 @@
 
 #include "webrtc/base/constructormagic.h"
 #include "webrtc/base/criticalsection.h"
+#include "webrtc/common_video/include/encoded_image_buffer_pool.h"
 #include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/modules/rtp_rtcp/include/receive_statistics.h"
 #include "webrtc/modules/rtp_rtcp/include/remote_ntp_time_estimator.h"
@@ -35,6 +36,7 @@
 
 namespace webrtc {
 
+class MediaCryptoContext;
 class NackModule;
 class PacedSender;
 class PacketRouter;
@@ -72,6 +74,7 @@ class RtpStreamReceiver : public RtpData,
       PacedSender* paced_sender,
       PacketRouter* packet_router,
       VieRemb* remb,
+      MediaCryptoContext* media_crypto_context,
       const VideoReceiveStream::Config* config,
       ReceiveStatisticsProxy* receive_stats_proxy,
       ProcessThread* process_thread,
@@ -107,12 +110,18 @@ class RtpStreamReceiver : public RtpData,
 
   void SignalNetworkState(NetworkState state);
 
+  // Buffers of the frames assembled from the received packets.
+  EncodedImageBufferPool::Stats GetEncodedBufferPoolStats() const;
+
   // Implements RtpData.
   int32_t OnReceivedPayloadData(const uint8_t* payload_data,
                                 size_t payload_size,
                                 const WebRtcRTPHeader* rtp_header) override;
   bool OnRecoveredPacket(const uint8_t* packet, size_t packet_length) override;
 
+  // Handles a media packet recovered by FlexFEC.
+  bool OnFecRecoveredPacket(const uint8_t* packet, size_t packet_length);
+
   // Implements RtpFeedback.
   int32_t OnInitializeDecoder(int8_t payload_type,
                               const char payload_name[RTP_PAYLOAD_NAME_SIZE],
@@ -155,6 +164,10 @@ class RtpStreamReceiver : public RtpData,
   bool ParseAndHandleEncapsulatingHeader(const uint8_t* packet,
                                          size_t packet_length,
                                          const RTPHeader& header);
+  // Handles a packet unwrapped from RTX or RED, or recovered by FEC.
+  bool ReceiveRestoredPacket(const uint8_t* packet,
+                             size_t packet_length,
+                             bool fec_recovered);
   void NotifyReceiverOfFecPacket(const RTPHeader& header);
   bool IsPacketInOrder(const RTPHeader& header) const;
   bool IsPacketRetransmitted(const RTPHeader& header, bool in_order) const;
@@ -171,6 +184,7 @@ class RtpStreamReceiver : public RtpData,
   PacketRouter* const packet_router_;
   VieRemb* const remb_;
   ProcessThread* const process_thread_;
+  ReceiveStatisticsProxy* const receive_stats_proxy_;
 
   RemoteNtpTimeEstimator ntp_estimator_;
   RTPPayloadRegistry rtp_payload_registry_;
@@ -179,6 +193,9 @@ class RtpStreamReceiver : public RtpData,
   const std::unique_ptr<RtpReceiver> rtp_receiver_;
   const std::unique_ptr<ReceiveStatistics> rtp_receive_statistics_;
   std::unique_ptr<UlpfecReceiver> ulpfec_receiver_;
+  // Recovered packets of |ulpfec_receiver_| already reported, to tell them
+  // apart from the media packets it unwraps from RED.
+  size_t ulpfec_recovered_packets_;
 
   rtc::CriticalSection receive_cs_;
   bool receiving_ GUARDED_BY(receive_cs_);
@@ -188,12 +205,14 @@ class RtpStreamReceiver : public RtpData,
 
   const std::unique_ptr<RtpRtcp> rtp_rtcp_;
 
-  // Members for the new jitter buffer experiment.
-  bool jitter_buffer_experiment_;
+  // Members for the PacketBuffer and FrameBuffer receive path, which is used
+  // unless the WebRTC-NewVideoJitterBuffer field trial is disabled.
+  bool use_frame_buffer_;
   video_coding::OnCompleteFrameCallback* complete_frame_callback_;
   KeyFrameRequestSender* keyframe_request_sender_;
   VCMTiming* timing_;
   std::unique_ptr<NackModule> nack_module_;
+  const rtc::scoped_refptr<EncodedImageBufferPool> encoded_buffer_pool_;
   rtc::scoped_refptr<video_coding::PacketBuffer> packet_buffer_;
   std::unique_ptr<video_coding::RtpFrameReferenceFinder> reference_finder_;
   rtc::CriticalSection last_seq_num_cs_;
@@ -114,6 +114,18 @@ void RtpStreamsSynchronizer::Process() {
   RTC_DCHECK(voe_sync_interface_);
   RTC_DCHECK(sync_.get());
 
+  int64_t last_video_receive_ms = video_measurement_.latest_receive_time_ms;
+  if (!UpdateMeasurements(&video_measurement_, video_rtp_rtcp_,
+                          video_rtp_receiver_)) {
+    return;
+  }
+
+  if (last_video_receive_ms == video_measurement_.latest_receive_time_ms) {
+    // No new video packet has been received since last update, so there is
+    // nothing to resync. Check this before touching the audio channel.
+    return;
+  }
+
   int audio_jitter_buffer_delay_ms = 0;
   int playout_buffer_delay_ms = 0;
   if (voe_sync_interface_->GetDelayEstimate(voe_channel_id_,
@@ -124,22 +136,11 @@ void RtpStreamsSynchronizer::Process() {
   const int current_audio_delay_ms = audio_jitter_buffer_delay_ms +
       playout_buffer_delay_ms;
 
-  int64_t last_video_receive_ms = video_measurement_.latest_receive_time_ms;
-  if (!UpdateMeasurements(&video_measurement_, video_rtp_rtcp_,
-                          video_rtp_receiver_)) {
-    return;
-  }
-
   if (!UpdateMeasurements(&audio_measurement_, audio_rtp_rtcp_,
                           audio_rtp_receiver_)) {
     return;
   }
 
-  if (last_video_receive_ms == video_measurement_.latest_receive_time_ms) {
-    // No new video packet has been received since last update.
-    return;
-  }
-
   int relative_delay_ms;
   // Calculate how much later or earlier the audio stream is compared to video.
   if (!sync_->ComputeRelativeDelay(audio_measurement_, video_measurement_,
@@ -25,8 +25,19 @@ const size_t kMaxPacketMapSize = 2000;
 // Limit for the maximum number of streams to calculate stats for.
 const size_t kMaxSsrcMapSize = 50;
 const int kMinRequiredPeriodicSamples = 5;
+
+void SetPercentiles(const LatencyHistogram& histogram,
+                    VideoSendStream::LatencyPercentiles* percentiles) {
+  percentiles->p50 = histogram.Percentile(50);
+  percentiles->p95 = histogram.Percentile(95);
+  percentiles->p99 = histogram.Percentile(99);
+}
 }  // namespace
 
+SendDelayStats::FrameStageCounters::FrameStageCounters(Clock* clock)
+    : queue_delay_ms(clock, nullptr, false),
+      packetization_time_ms(clock, nullptr, false) {}
+
 SendDelayStats::SendDelayStats(Clock* clock)
     : clock_(clock), num_old_packets_(0), num_skipped_packets_(0) {}
 
@@ -48,14 +59,35 @@ void SendDelayStats::UpdateHistograms() {
       LOG(LS_INFO) << "WebRTC.Video.SendDelayInMs, " << stats.ToString();
     }
   }
+  for (const auto& it : frame_stage_counters_) {
+    AggregatedStats queue_delay = it.second->queue_delay_ms.GetStats();
+    if (queue_delay.num_samples >= kMinRequiredPeriodicSamples) {
+      RTC_HISTOGRAM_COUNTS_10000("WebRTC.Video.SendQueueDelayInMs",
+                                 queue_delay.average);
+      LOG(LS_INFO) << "WebRTC.Video.SendQueueDelayInMs, "
+                   << queue_delay.ToString();
+    }
+    AggregatedStats packetization =
+        it.second->packetization_time_ms.GetStats();
+    if (packetization.num_samples >= kMinRequiredPeriodicSamples) {
+      RTC_HISTOGRAM_COUNTS_1000("WebRTC.Video.PacketizationTimeInMs",
+                                packetization.average);
+      LOG(LS_INFO) << "WebRTC.Video.PacketizationTimeInMs, "
+                   << packetization.ToString();
+    }
+  }
 }
 
 void SendDelayStats::AddSsrcs(const VideoSendStream::Config& config) {
   rtc::CritScope lock(&crit_);
   if (ssrcs_.size() > kMaxSsrcMapSize)
     return;
-  for (const auto& ssrc : config.rtp.ssrcs)
+  for (const auto& ssrc : config.rtp.ssrcs) {
     ssrcs_.insert(ssrc);
+    std::unique_ptr<LatencyHistograms>& histograms = latency_histograms_[ssrc];
+    if (!histograms)
+      histograms.reset(new LatencyHistograms());
+  }
 }
 
 AvgCounter* SendDelayStats::GetSendDelayCounter(uint32_t ssrc) {
@@ -68,6 +100,13 @@ AvgCounter* SendDelayStats::GetSendDelayCounter(uint32_t ssrc) {
   return counter;
 }
 
+SendDelayStats::LatencyHistograms* SendDelayStats::GetLatencyHistograms(
+    uint32_t ssrc) {
+  rtc::CritScope lock(&crit_);
+  const auto& it = latency_histograms_.find(ssrc);
+  return it != latency_histograms_.end() ? it->second.get() : nullptr;
+}
+
 void SendDelayStats::OnSendPacket(uint16_t packet_id,
                                   int64_t capture_time_ms,
                                   uint32_t ssrc) {
@@ -101,10 +140,54 @@ bool SendDelayStats::OnSentPacket(int packet_id, int64_t time_ms) {
   // Elapsed time from send (to transport) -> sent (leaving socket).
   int diff_ms = time_ms - it->second.send_time_ms;
   GetSendDelayCounter(it->second.ssrc)->Add(diff_ms);
+  const auto& histograms = latency_histograms_.find(it->second.ssrc);
+  if (histograms != latency_histograms_.end())
+    histograms->second->send_delay_ms.Add(diff_ms);
   packets_.erase(it);
   return true;
 }
 
+void SendDelayStats::OnPacketDequeued(uint32_t ssrc, int64_t queue_time_ms) {
+  LatencyHistograms* histograms = GetLatencyHistograms(ssrc);
+  if (histograms)
+    histograms->pacer_queue_time_ms.Add(queue_time_ms);
+}
+
+void SendDelayStats::OnMediaEncrypted(uint32_t ssrc,
+                                      int64_t encryption_time_us) {
+  LatencyHistograms* histograms = GetLatencyHistograms(ssrc);
+  if (histograms)
+    histograms->media_encryption_time_us.Add(encryption_time_us);
+}
+
+void SendDelayStats::GetLatencyPercentiles(
+    uint32_t ssrc,
+    VideoSendStream::StreamStats* stats) {
+  LatencyHistograms* histograms = GetLatencyHistograms(ssrc);
+  if (!histograms)
+    return;
+  SetPercentiles(histograms->pacer_queue_time_ms,
+                 &stats->pacer_queue_time_ms);
+  SetPercentiles(histograms->media_encryption_time_us,
+                 &stats->media_encryption_time_us);
+  SetPercentiles(histograms->send_delay_ms, &stats->send_delay_ms);
+}
+
+void SendDelayStats::OnEncodedFrameSent(uint32_t ssrc,
+                                        int64_t queue_delay_ms,
+                                        int64_t packetization_time_ms) {
+  rtc::CritScope lock(&crit_);
+  if (ssrcs_.find(ssrc) == ssrcs_.end())
+    return;
+
+  std::unique_ptr<FrameStageCounters>& counters = frame_stage_counters_[ssrc];
+  if (!counters)
+    counters.reset(new FrameStageCounters(clock_));
+  counters->queue_delay_ms.Add(static_cast<int>(queue_delay_ms));
+  counters->packetization_time_ms.Add(
+      static_cast<int>(packetization_time_ms));
+}
+
 void SendDelayStats::RemoveOld(int64_t now, PacketMap* packets) {
   while (!packets->empty()) {
     auto it = packets->begin();
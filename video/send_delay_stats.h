@@ -20,6 +20,7 @@
 #include "webrtc/common_types.h"
 #include "webrtc/modules/include/module_common_types.h"
 #include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/video/latency_histogram.h"
 #include "webrtc/video/stats_counter.h"
 #include "webrtc/video_send_stream.h"
 
@@ -37,12 +38,27 @@ class SendDelayStats : public SendPacketObserver {
   // Called when a packet is sent (leaving socket).
   bool OnSentPacket(int packet_id, int64_t time_ms);
 
+  // Called when an encoded frame has been handed to the RTP module of |ssrc|.
+  // |queue_delay_ms| is the time from the encoder delivering the frame until
+  // packetization started, |packetization_time_ms| the time spent
+  // packetizing, encrypting and protecting it.
+  void OnEncodedFrameSent(uint32_t ssrc,
+                          int64_t queue_delay_ms,
+                          int64_t packetization_time_ms);
+
+  // Sets the send path latency percentiles of |stats| to those of the
+  // packets of |ssrc|.
+  void GetLatencyPercentiles(uint32_t ssrc,
+                             VideoSendStream::StreamStats* stats);
+
  protected:
   // From SendPacketObserver.
   // Called when a packet is sent to the transport.
   void OnSendPacket(uint16_t packet_id,
                     int64_t capture_time_ms,
                     uint32_t ssrc) override;
+  void OnPacketDequeued(uint32_t ssrc, int64_t queue_time_ms) override;
+  void OnMediaEncrypted(uint32_t ssrc, int64_t encryption_time_us) override;
 
  private:
   // Map holding sent packets (mapped by sequence number).
@@ -62,11 +78,24 @@ class SendDelayStats : public SendPacketObserver {
   };
   typedef std::map<uint16_t, Packet, SequenceNumberOlderThan> PacketMap;
 
+  struct FrameStageCounters {
+    explicit FrameStageCounters(Clock* clock);
+    AvgCounter queue_delay_ms;
+    AvgCounter packetization_time_ms;
+  };
+
+  struct LatencyHistograms {
+    LatencyHistogram pacer_queue_time_ms;
+    LatencyHistogram media_encryption_time_us;
+    LatencyHistogram send_delay_ms;
+  };
+
   void UpdateHistograms();
   void RemoveOld(int64_t now, PacketMap* packets)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
   AvgCounter* GetSendDelayCounter(uint32_t ssrc)
       EXCLUSIVE_LOCKS_REQUIRED(crit_);
+  LatencyHistograms* GetLatencyHistograms(uint32_t ssrc);
 
   Clock* const clock_;
   rtc::CriticalSection crit_;
@@ -80,6 +109,13 @@ class SendDelayStats : public SendPacketObserver {
   // Mapped by SSRC.
   std::map<uint32_t, std::unique_ptr<AvgCounter>> send_delay_counters_
       GUARDED_BY(crit_);
+  // Mapped by SSRC.
+  std::map<uint32_t, std::unique_ptr<FrameStageCounters>> frame_stage_counters_
+      GUARDED_BY(crit_);
+  // Mapped by SSRC. Added with the SSRCs and never removed, so the histograms
+  // can be updated without holding |crit_|.
+  std::map<uint32_t, std::unique_ptr<LatencyHistograms>> latency_histograms_
+      GUARDED_BY(crit_);
 };
 
 }  // namespace webrtc
@@ -124,4 +124,50 @@ TEST_F(SendDelayStatsTest, HistogramsAreUpdated) {
   EXPECT_EQ(1, metrics::NumEvents("WebRTC.Video.SendDelayInMs", kDelayMs2));
 }
 
+TEST_F(SendDelayStatsTest, FrameStageHistogramsAreUpdated) {
+  metrics::Reset();
+  const int64_t kFrameIntervalMs = 33;
+  const int kNumFrames =
+      kMinRequiredPeriodicSamples * kProcessIntervalMs / kFrameIntervalMs + 1;
+  for (int i = 0; i < kNumFrames; ++i) {
+    stats_->OnEncodedFrameSent(kSsrc1, 2, 4);
+    // Not a registered ssrc, ignored.
+    stats_->OnEncodedFrameSent(kRtxSsrc1, 20, 40);
+    clock_.AdvanceTimeMilliseconds(kFrameIntervalMs);
+  }
+  stats_.reset();
+  EXPECT_EQ(1, metrics::NumSamples("WebRTC.Video.SendQueueDelayInMs"));
+  EXPECT_EQ(1, metrics::NumEvents("WebRTC.Video.SendQueueDelayInMs", 2));
+  EXPECT_EQ(1, metrics::NumSamples("WebRTC.Video.PacketizationTimeInMs"));
+  EXPECT_EQ(1, metrics::NumEvents("WebRTC.Video.PacketizationTimeInMs", 4));
+}
+
+TEST_F(SendDelayStatsTest, LatencyPercentilesAreReported) {
+  VideoSendStream::StreamStats stream_stats;
+  stats_->GetLatencyPercentiles(kSsrc1, &stream_stats);
+  EXPECT_EQ(-1, stream_stats.pacer_queue_time_ms.p50);
+  EXPECT_EQ(-1, stream_stats.send_delay_ms.p50);
+
+  SendPacketObserver* observer = stats_.get();
+  for (int i = 1; i <= 100; ++i)
+    observer->OnPacketDequeued(kSsrc1, i < 96 ? 2 : 10);
+  observer->OnMediaEncrypted(kSsrc1, 7);
+  // Not a registered ssrc, ignored.
+  observer->OnPacketDequeued(kRtxSsrc1, 100);
+  OnSendPacket(kPacketId, kSsrc1);
+  clock_.AdvanceTimeMilliseconds(3);
+  EXPECT_TRUE(OnSentPacket(kPacketId));
+
+  stats_->GetLatencyPercentiles(kSsrc1, &stream_stats);
+  EXPECT_EQ(2, stream_stats.pacer_queue_time_ms.p50);
+  EXPECT_EQ(2, stream_stats.pacer_queue_time_ms.p95);
+  EXPECT_EQ(10, stream_stats.pacer_queue_time_ms.p99);
+  EXPECT_EQ(7, stream_stats.media_encryption_time_us.p50);
+  EXPECT_EQ(3, stream_stats.send_delay_ms.p99);
+
+  VideoSendStream::StreamStats other_stream_stats;
+  stats_->GetLatencyPercentiles(kSsrc2, &other_stream_stats);
+  EXPECT_EQ(-1, other_stream_stats.pacer_queue_time_ms.p50);
+}
+
 }  // namespace webrtc
@@ -475,6 +475,11 @@ void SendStatisticsProxy::OnInactiveSsrc(uint32_t ssrc) {
   stats->width = 0;
 }
 
+void SendStatisticsProxy::OnAlrSuppressedPadding(uint64_t total_bytes) {
+  rtc::CritScope lock(&crit_);
+  stats_.alr_suppressed_padding_bytes = total_bytes;
+}
+
 void SendStatisticsProxy::OnSetEncoderTargetRate(uint32_t bitrate_bps) {
   rtc::CritScope lock(&crit_);
   if (uma_container_->target_rate_updates_.last_ms == -1 && bitrate_bps == 0)
@@ -532,6 +537,18 @@ void SendStatisticsProxy::OnSendEncodedImage(
   stats->height = encoded_image._encodedHeight;
   update_times_[ssrc].resolution_update_ms = clock_->TimeInMilliseconds();
 
+  if (encoded_image.encode_time_ms_ != -1) {
+    auto it = layer_encode_times_.find(ssrc);
+    if (it == layer_encode_times_.end()) {
+      it = layer_encode_times_
+               .insert(std::make_pair(
+                   ssrc, rtc::ExpFilter(kEncodeTimeWeigthFactor)))
+               .first;
+    }
+    it->second.Apply(1.0f, encoded_image.encode_time_ms_);
+    stats->avg_encode_time_ms = round(it->second.filtered());
+  }
+
   uma_container_->key_frame_counter_.Add(encoded_image._frameType ==
                                          kVideoFrameKey);
   stats_.bw_limited_resolution =
@@ -74,6 +74,8 @@ class SendStatisticsProxy : public CpuOveruseMetricsObserver,
 
   // Used to update the encoder target rate.
   void OnSetEncoderTargetRate(uint32_t bitrate_bps);
+  // Total padding bytes suppressed by the pacer while application-limited.
+  void OnAlrSuppressedPadding(uint64_t total_bytes);
 
   // Implements CpuOveruseMetricsObserver.
   void OnEncodedFrameTimeMeasured(int encode_time_ms,
@@ -164,6 +166,8 @@ class SendStatisticsProxy : public CpuOveruseMetricsObserver,
   uint32_t last_sent_frame_timestamp_ GUARDED_BY(crit_);
   std::map<uint32_t, StatsUpdateTimes> update_times_ GUARDED_BY(crit_);
   rtc::ExpFilter encode_time_ GUARDED_BY(crit_);
+  // Per ssrc, for encoders that measure the encode time of each layer.
+  std::map<uint32_t, rtc::ExpFilter> layer_encode_times_ GUARDED_BY(crit_);
   int quality_downscales_ GUARDED_BY(crit_) = 0;
 
   // Contains stats used for UMA histograms. These stats will be reset if
@@ -119,6 +119,7 @@ class SendStatisticsProxyTest : public ::testing::Test {
       EXPECT_EQ(a.total_bitrate_bps, b.total_bitrate_bps);
       EXPECT_EQ(a.avg_delay_ms, b.avg_delay_ms);
       EXPECT_EQ(a.max_delay_ms, b.max_delay_ms);
+      EXPECT_EQ(a.avg_encode_time_ms, b.avg_encode_time_ms);
 
       EXPECT_EQ(a.rtp_stats.transmitted.payload_bytes,
                 b.rtp_stats.transmitted.payload_bytes);
@@ -367,6 +368,27 @@ TEST_F(SendStatisticsProxyTest, OnSendEncodedImageWithoutQpQpSumWontExist) {
   EXPECT_EQ(rtc::Optional<uint64_t>(), statistics_proxy_->GetStats().qp_sum);
 }
 
+TEST_F(SendStatisticsProxyTest, OnSendEncodedImageUpdatesLayerEncodeTimes) {
+  EncodedImage encoded_image;
+  CodecSpecificInfo codec_info;
+  codec_info.codecType = kVideoCodecVP8;
+  codec_info.codecSpecific.VP8.simulcastIdx = 0;
+  encoded_image.encode_time_ms_ = 10;
+  statistics_proxy_->OnSendEncodedImage(encoded_image, &codec_info);
+  encoded_image.encode_time_ms_ = 20;
+  statistics_proxy_->OnSendEncodedImage(encoded_image, &codec_info);
+  codec_info.codecSpecific.VP8.simulcastIdx = 1;
+  encoded_image.encode_time_ms_ = 4;
+  statistics_proxy_->OnSendEncodedImage(encoded_image, &codec_info);
+  // Not measured per image, doesn't update the stats.
+  encoded_image.encode_time_ms_ = -1;
+  statistics_proxy_->OnSendEncodedImage(encoded_image, &codec_info);
+
+  VideoSendStream::Stats stats = statistics_proxy_->GetStats();
+  EXPECT_EQ(15, stats.substreams[kFirstSsrc].avg_encode_time_ms);
+  EXPECT_EQ(4, stats.substreams[kSecondSsrc].avg_encode_time_ms);
+}
+
 TEST_F(SendStatisticsProxyTest, SwitchContentTypeUpdatesHistograms) {
   for (int i = 0; i < SendStatisticsProxy::kMinRequiredMetricsSamples; ++i)
     statistics_proxy_->OnIncomingFrame(kWidth, kHeight);
@@ -113,6 +113,64 @@ class VideoStreamFactory
   std::vector<webrtc::VideoStream> streams_;
 };
 
+// Requests low latency playout, min = max = 0 ms, with the PlayoutDelay
+// extension on every frame produced by the wrapped encoder.
+class LowLatencyPlayoutEncoder : public webrtc::VideoEncoder,
+                                 public webrtc::EncodedImageCallback {
+ public:
+  explicit LowLatencyPlayoutEncoder(webrtc::VideoEncoder* encoder)
+      : encoder_(encoder), callback_(nullptr) {}
+
+  int32_t InitEncode(const webrtc::VideoCodec* codec_settings,
+                     int32_t number_of_cores,
+                     size_t max_payload_size) override {
+    return encoder_->InitEncode(codec_settings, number_of_cores,
+                                max_payload_size);
+  }
+  int32_t RegisterEncodeCompleteCallback(
+      webrtc::EncodedImageCallback* callback) override {
+    callback_ = callback;
+    return encoder_->RegisterEncodeCompleteCallback(this);
+  }
+  int32_t Release() override { return encoder_->Release(); }
+  int32_t Encode(const webrtc::VideoFrame& frame,
+                 const webrtc::CodecSpecificInfo* codec_specific_info,
+                 const std::vector<webrtc::FrameType>* frame_types) override {
+    return encoder_->Encode(frame, codec_specific_info, frame_types);
+  }
+  int32_t SetChannelParameters(uint32_t packet_loss, int64_t rtt) override {
+    return encoder_->SetChannelParameters(packet_loss, rtt);
+  }
+  int32_t SetRateAllocation(const webrtc::BitrateAllocation& allocation,
+                            uint32_t framerate) override {
+    return encoder_->SetRateAllocation(allocation, framerate);
+  }
+  ScalingSettings GetScalingSettings() const override {
+    return encoder_->GetScalingSettings();
+  }
+  bool SupportsNativeHandle() const override {
+    return encoder_->SupportsNativeHandle();
+  }
+  const char* ImplementationName() const override {
+    return encoder_->ImplementationName();
+  }
+
+  Result OnEncodedImage(
+      const webrtc::EncodedImage& encoded_image,
+      const webrtc::CodecSpecificInfo* codec_specific_info,
+      const webrtc::RTPFragmentationHeader* fragmentation) override {
+    webrtc::EncodedImage image(encoded_image);
+    image.playout_delay_ = {0, 0};
+    return callback_->OnEncodedImage(image, codec_specific_info,
+                                     fragmentation);
+  }
+  void OnDroppedFrame() override { callback_->OnDroppedFrame(); }
+
+ private:
+  const std::unique_ptr<webrtc::VideoEncoder> encoder_;
+  webrtc::EncodedImageCallback* callback_;
+};
+
 bool IsFlexfec(int payload_type) {
   return payload_type == webrtc::VideoQualityTest::kFlexfecPayloadType;
 }
@@ -861,7 +919,7 @@ VideoQualityTest::VideoQualityTest()
 VideoQualityTest::Params::Params()
     : call({false, Call::Config::BitrateConfig()}),
       video({false, 640, 480, 30, 50, 800, 800, false, "VP8", 1, -1, 0, false,
-             false, "", ""}),
+             false, "", "", false}),
       audio({false, false}),
       screenshare({false, 10, 0}),
       analyzer({"", 0.0, 0.0, 0, "", ""}),
@@ -1062,6 +1120,9 @@ void VideoQualityTest::SetupVideo(Transport* send_transport,
     RTC_NOTREACHED() << "Codec not supported!";
     return;
   }
+  if (params_.video.low_latency_playout)
+    video_encoder_.reset(
+        new LowLatencyPlayoutEncoder(video_encoder_.release()));
   video_send_config_.encoder_settings.encoder = video_encoder_.get();
   video_send_config_.encoder_settings.payload_name = params_.video.codec;
   video_send_config_.encoder_settings.payload_type = payload_type;
@@ -1079,6 +1140,10 @@ void VideoQualityTest::SetupVideo(Transport* send_transport,
     video_send_config_.rtp.extensions.push_back(RtpExtension(
         RtpExtension::kAbsSendTimeUri, test::kAbsSendTimeExtensionId));
   }
+  if (params_.video.low_latency_playout) {
+    video_send_config_.rtp.extensions.push_back(RtpExtension(
+        RtpExtension::kPlayoutDelayUri, RtpExtension::kPlayoutDelayDefaultId));
+  }
 
   video_encoder_config_.min_transmit_bitrate_bps =
       params_.video.min_transmit_bps;
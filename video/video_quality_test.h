@@ -50,6 +50,8 @@ class VideoQualityTest : public test::CallTest {
       bool flexfec;
       std::string encoded_frame_base_path;
       std::string clip_name;
+      // Request playout without buffering, see VCMTiming::LowLatencyPlayout.
+      bool low_latency_playout;
     } video;
     struct {
       bool enabled;
@@ -12,16 +12,19 @@
 
 #include <stdlib.h>
 
+#include <algorithm>
 #include <set>
 #include <string>
 #include <utility>
 
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/base/optional.h"
 #include "webrtc/common_video/h264/profile_level_id.h"
 #include "webrtc/common_video/libyuv/include/webrtc_libyuv.h"
 #include "webrtc/modules/congestion_controller/include/congestion_controller.h"
+#include "webrtc/modules/rtp_rtcp/include/rtp_receiver.h"
 #include "webrtc/modules/utility/include/process_thread.h"
 #include "webrtc/modules/video_coding/frame_object.h"
 #include "webrtc/modules/video_coding/include/video_coding.h"
@@ -56,6 +59,7 @@ std::string VideoReceiveStream::Decoder::ToString() const {
   for (const auto& it : codec_params)
     ss << it.first << ": " << it.second;
   ss << '}';
+  ss << ", number_of_cores: " << number_of_cores;
   ss << '}';
 
   return ss.str();
@@ -137,6 +141,8 @@ std::string VideoReceiveStream::Stats::ToString(int64_t time_ms) const {
   ss << "jb_delay_ms: " << jitter_buffer_ms << ", ";
   ss << "min_playout_delay_ms: " << min_playout_delay_ms << ", ";
   ss << "discarded: " << discarded_packets << ", ";
+  ss << "encoded_buffer_allocations: " << encoded_buffer_allocations << ", ";
+  ss << "encoded_buffer_reuses: " << encoded_buffer_reuses << ", ";
   ss << "sync_offset_ms: " << sync_offset_ms << ", ";
   ss << "cum_loss: " << rtcp_stats.cumulative_lost << ", ";
   ss << "max_ext_seq: " << rtcp_stats.extended_max_sequence_number << ", ";
@@ -148,6 +154,12 @@ std::string VideoReceiveStream::Stats::ToString(int64_t time_ms) const {
 }
 
 namespace {
+// Time without a decodable frame after which a keyframe is requested.
+constexpr int kMaxWaitForFrameMs = 3000;
+// Same as above for streams played out with low latency, where there is no
+// buffer to hide a missing frame and a freeze is noticed right away.
+constexpr int kMaxWaitForFrameLowLatencyMs = 500;
+
 VideoCodec CreateDecoderVideoCodec(const VideoReceiveStream::Decoder& decoder) {
   VideoCodec codec;
   memset(&codec, 0, sizeof(codec));
@@ -194,7 +206,10 @@ VideoReceiveStream::VideoReceiveStream(
     webrtc::VoiceEngine* voice_engine,
     ProcessThread* process_thread,
     CallStats* call_stats,
-    VieRemb* remb)
+    VieRemb* remb,
+    MediaCryptoContext* media_crypto_context,
+    DecodeThreadPool* decode_thread_pool,
+    VideoRenderScheduler* render_scheduler)
     : transport_adapter_(config.rtcp_send_transport),
       config_(std::move(config)),
       num_cpu_cores_(num_cpu_cores),
@@ -215,6 +230,7 @@ VideoReceiveStream::VideoReceiveStream(
           congestion_controller_->pacer(),
           packet_router,
           remb,
+          media_crypto_context,
           &config_,
           &stats_proxy_,
           process_thread_,
@@ -224,9 +240,14 @@ VideoReceiveStream::VideoReceiveStream(
           this,  // OnCompleteFrameCallback
           timing_.get()),
       rtp_stream_sync_(&video_receiver_, &rtp_stream_receiver_),
-      jitter_buffer_experiment_(
-          field_trial::FindFullName("WebRTC-NewVideoJitterBuffer") ==
-          "Enabled") {
+      use_frame_buffer_(
+          field_trial::FindFullName("WebRTC-NewVideoJitterBuffer") !=
+          "Disabled"),
+      decode_thread_pool_(use_frame_buffer_ ? decode_thread_pool : nullptr),
+      decoding_in_pool_(false),
+      waiting_for_frame_since_ms_(-1),
+      decoded_pixels_(0),
+      render_scheduler_(render_scheduler) {
   LOG(LS_INFO) << "VideoReceiveStream: " << config_.ToString();
 
   RTC_DCHECK(process_thread_);
@@ -246,7 +267,7 @@ VideoReceiveStream::VideoReceiveStream(
 
   video_receiver_.SetRenderDelay(config.render_delay_ms);
 
-  if (jitter_buffer_experiment_) {
+  if (use_frame_buffer_) {
     jitter_estimator_.reset(new VCMJitterEstimator(clock_));
     frame_buffer_.reset(new video_coding::FrameBuffer(
         clock_, jitter_estimator_.get(), timing_.get()));
@@ -284,13 +305,13 @@ bool VideoReceiveStream::DeliverRtp(const uint8_t* packet,
 
 bool VideoReceiveStream::OnRecoveredPacket(const uint8_t* packet,
                                            size_t length) {
-  return rtp_stream_receiver_.OnRecoveredPacket(packet, length);
+  return rtp_stream_receiver_.OnFecRecoveredPacket(packet, length);
 }
 
 void VideoReceiveStream::Start() {
-  if (decode_thread_.IsRunning())
+  if (decode_thread_.IsRunning() || decoding_in_pool_)
     return;
-  if (jitter_buffer_experiment_) {
+  if (use_frame_buffer_) {
     frame_buffer_->Start();
     call_stats_->RegisterStatsObserver(&rtp_stream_receiver_);
 
@@ -306,7 +327,8 @@ void VideoReceiveStream::Start() {
       renderer = this;
     } else {
       incoming_video_stream_.reset(
-          new IncomingVideoStream(config_.render_delay_ms, this));
+          new IncomingVideoStream(config_.render_delay_ms, this,
+                                  render_scheduler_));
       renderer = incoming_video_stream_.get();
     }
   }
@@ -319,8 +341,10 @@ void VideoReceiveStream::Start() {
     // which holds H264SpsPpsTracker
     VideoCodec codec = CreateDecoderVideoCodec(decoder);
     RTC_CHECK(rtp_stream_receiver_.AddReceiveCodec(codec));
+    int number_of_cores =
+        std::max(1, std::min(decoder.number_of_cores, num_cpu_cores_));
     RTC_CHECK_EQ(VCM_OK, video_receiver_.RegisterReceiveCodec(
-                             &codec, num_cpu_cores_, false));
+                             &codec, number_of_cores, false));
   }
 
   video_stream_decoder_.reset(new VideoStreamDecoder(
@@ -330,9 +354,15 @@ void VideoReceiveStream::Start() {
       config_.pre_render_callback));
   // Register the channel to receive stats updates.
   call_stats_->RegisterStatsObserver(video_stream_decoder_.get());
-  // Start the decode thread
-  decode_thread_.Start();
-  decode_thread_.SetPriority(rtc::kHighestPriority);
+  if (decode_thread_pool_) {
+    waiting_for_frame_since_ms_ = clock_->TimeInMilliseconds();
+    decode_thread_pool_->AddStream(this);
+    decoding_in_pool_ = true;
+  } else {
+    // Start the decode thread
+    decode_thread_.Start();
+    decode_thread_.SetPriority(rtc::kHighestPriority);
+  }
   rtp_stream_receiver_.StartReceive();
 }
 
@@ -343,13 +373,18 @@ void VideoReceiveStream::Stop() {
   // before joining the decoder thread thread.
   video_receiver_.TriggerDecoderShutdown();
 
-  if (jitter_buffer_experiment_) {
+  if (use_frame_buffer_) {
     frame_buffer_->Stop();
     call_stats_->DeregisterStatsObserver(&rtp_stream_receiver_);
   }
 
-  if (decode_thread_.IsRunning()) {
-    decode_thread_.Stop();
+  if (decode_thread_.IsRunning() || decoding_in_pool_) {
+    if (decoding_in_pool_) {
+      decode_thread_pool_->RemoveStream(this);
+      decoding_in_pool_ = false;
+    } else {
+      decode_thread_.Stop();
+    }
     // Deregister external decoders so they are no longer running during
     // destruction. This effectively stops the VCM since the decoder thread is
     // stopped, the VCM is deregistered and no asynchronous decoder threads are
@@ -364,6 +399,18 @@ void VideoReceiveStream::Stop() {
   transport_adapter_.Disable();
 }
 
+void VideoReceiveStream::SetSinkActive(bool active) {
+  // Only the new jitter buffer knows the temporal layer of each frame.
+  if (!use_frame_buffer_)
+    return;
+  frame_buffer_->SetDecodeBaseLayerOnly(!active);
+  // Upper layer frames would only be kept around in the buffer, so don't
+  // spend the inner PERC decryption on them either.
+  rtp_stream_receiver_.GetRtpReceiver()->SetDecryptBaseLayerOnly(!active);
+  if (active && decode_thread_pool_)
+    decode_thread_pool_->WakeUp(this);
+}
+
 void VideoReceiveStream::SetSyncChannel(VoiceEngine* voice_engine,
                                         int audio_channel_id) {
   if (voice_engine && audio_channel_id != -1) {
@@ -376,11 +423,25 @@ void VideoReceiveStream::SetSyncChannel(VoiceEngine* voice_engine,
 }
 
 VideoReceiveStream::Stats VideoReceiveStream::GetStats() const {
-  return stats_proxy_.GetStats();
+  Stats stats = stats_proxy_.GetStats();
+  EncodedImageBufferPool::Stats pool_stats =
+      rtp_stream_receiver_.GetEncodedBufferPoolStats();
+  stats.encoded_buffer_allocations = pool_stats.allocations;
+  stats.encoded_buffer_reuses = pool_stats.reuses;
+  stats.encoded_buffer_pool_bytes = pool_stats.pooled_bytes;
+  MediaCryptoStats media_crypto_stats;
+  if (rtp_stream_receiver_.GetRtpReceiver()->GetMediaCryptoStats(
+          &media_crypto_stats)) {
+    stats.media_crypto = rtc::Optional<MediaCryptoStats>(media_crypto_stats);
+  }
+  return stats;
 }
 
 // TODO(tommi): This method grabs a lock 6 times.
 void VideoReceiveStream::OnFrame(const VideoFrame& video_frame) {
+  rtc::AtomicOps::ReleaseStore(&decoded_pixels_,
+                               video_frame.width() * video_frame.height());
+
   // TODO(tommi): OnDecodedFrame grabs a lock, incidentally the same lock
   // that OnSyncOffsetUpdated() and OnRenderedFrame() below grab.
   stats_proxy_.OnDecodedFrame();
@@ -409,6 +470,8 @@ void VideoReceiveStream::OnCompleteFrame(
   int last_continuous_pid = frame_buffer_->InsertFrame(std::move(frame));
   if (last_continuous_pid != -1)
     rtp_stream_receiver_.FrameContinuous(last_continuous_pid);
+  if (decode_thread_pool_)
+    decode_thread_pool_->WakeUp(this);
 }
 
 // TODO(asapersson): Consider moving callback from video_encoder.h or
@@ -443,11 +506,11 @@ bool VideoReceiveStream::DecodeThreadFunction(void* ptr) {
 
 void VideoReceiveStream::Decode() {
   static const int kMaxDecodeWaitTimeMs = 50;
-  if (jitter_buffer_experiment_) {
-    static const int kMaxWaitForFrameMs = 3000;
+  if (use_frame_buffer_) {
+    const int max_wait_for_frame_ms = MaxWaitForFrameMs();
     std::unique_ptr<video_coding::FrameObject> frame;
     video_coding::FrameBuffer::ReturnReason res =
-        frame_buffer_->NextFrame(kMaxWaitForFrameMs, &frame);
+        frame_buffer_->NextFrame(max_wait_for_frame_ms, &frame);
 
     if (res == video_coding::FrameBuffer::ReturnReason::kStopped)
       return;
@@ -456,7 +519,7 @@ void VideoReceiveStream::Decode() {
       if (video_receiver_.Decode(frame.get()) == VCM_OK)
         rtp_stream_receiver_.FrameDecoded(frame->picture_id);
     } else {
-      LOG(LS_WARNING) << "No decodable frame in " << kMaxWaitForFrameMs
+      LOG(LS_WARNING) << "No decodable frame in " << max_wait_for_frame_ms
                       << " ms, requesting keyframe.";
       RequestKeyFrame();
     }
@@ -465,6 +528,48 @@ void VideoReceiveStream::Decode() {
   }
 }
 
+int64_t VideoReceiveStream::DecodeOnce() {
+  std::unique_ptr<video_coding::FrameObject> frame;
+  int64_t wait_ms;
+  video_coding::FrameBuffer::ReturnReason res =
+      frame_buffer_->NextFrameIfReady(&frame, &wait_ms);
+
+  if (res == video_coding::FrameBuffer::ReturnReason::kStopped)
+    return -1;
+
+  int64_t now_ms = clock_->TimeInMilliseconds();
+  if (frame) {
+    if (video_receiver_.Decode(frame.get()) == VCM_OK)
+      rtp_stream_receiver_.FrameDecoded(frame->picture_id);
+    waiting_for_frame_since_ms_ = now_ms;
+    // There may be more frames due already.
+    return 0;
+  }
+
+  const int max_wait_for_frame_ms = MaxWaitForFrameMs();
+  int64_t time_until_keyframe_request_ms =
+      waiting_for_frame_since_ms_ + max_wait_for_frame_ms - now_ms;
+  if (time_until_keyframe_request_ms <= 0) {
+    LOG(LS_WARNING) << "No decodable frame in " << max_wait_for_frame_ms
+                    << " ms, requesting keyframe.";
+    RequestKeyFrame();
+    waiting_for_frame_since_ms_ = now_ms;
+    time_until_keyframe_request_ms = max_wait_for_frame_ms;
+  }
+  return wait_ms == -1
+             ? time_until_keyframe_request_ms
+             : std::min(wait_ms, time_until_keyframe_request_ms);
+}
+
+int VideoReceiveStream::MaxWaitForFrameMs() const {
+  return timing_->LowLatencyPlayout() ? kMaxWaitForFrameLowLatencyMs
+                                      : kMaxWaitForFrameMs;
+}
+
+int VideoReceiveStream::DecodedPixels() const {
+  return rtc::AtomicOps::AcquireLoad(&decoded_pixels_);
+}
+
 void VideoReceiveStream::SendNack(
     const std::vector<uint16_t>& sequence_numbers) {
   rtp_stream_receiver_.RequestPacketRetransmit(sequence_numbers);
@@ -20,6 +20,7 @@
 #include "webrtc/modules/video_coding/frame_buffer2.h"
 #include "webrtc/modules/video_coding/video_coding_impl.h"
 #include "webrtc/system_wrappers/include/clock.h"
+#include "webrtc/video/decode_thread_pool.h"
 #include "webrtc/video/receive_statistics_proxy.h"
 #include "webrtc/video/rtp_stream_receiver.h"
 #include "webrtc/video/rtp_streams_synchronizer.h"
@@ -32,6 +33,7 @@ namespace webrtc {
 class CallStats;
 class CongestionController;
 class IvfFileWriter;
+class MediaCryptoContext;
 class ProcessThread;
 class RTPFragmentationHeader;
 class VoiceEngine;
@@ -46,8 +48,12 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
                            public EncodedImageCallback,
                            public NackSender,
                            public KeyFrameRequestSender,
-                           public video_coding::OnCompleteFrameCallback {
+                           public video_coding::OnCompleteFrameCallback,
+                           public DecodeThreadPool::Stream {
  public:
+  // If |decode_thread_pool| is not null and the new jitter buffer is used,
+  // frames are decoded by the pool instead of a thread of this stream. If
+  // |render_scheduler| is not null, it releases the frames to the renderer.
   VideoReceiveStream(int num_cpu_cores,
                      CongestionController* congestion_controller,
                      PacketRouter* packet_router,
@@ -55,7 +61,10 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
                      webrtc::VoiceEngine* voice_engine,
                      ProcessThread* process_thread,
                      CallStats* call_stats,
-                     VieRemb* remb);
+                     VieRemb* remb,
+                     MediaCryptoContext* media_crypto_context,
+                     DecodeThreadPool* decode_thread_pool,
+                     VideoRenderScheduler* render_scheduler);
   ~VideoReceiveStream() override;
 
   void SignalNetworkState(NetworkState state);
@@ -69,6 +78,7 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   // webrtc::VideoReceiveStream implementation.
   void Start() override;
   void Stop() override;
+  void SetSinkActive(bool active) override;
 
   webrtc::VideoReceiveStream::Stats GetStats() const override;
 
@@ -103,9 +113,15 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   void EnableEncodedFrameRecording(rtc::PlatformFile file,
                                    size_t byte_limit) override;
 
+  // Implements DecodeThreadPool::Stream.
+  int64_t DecodeOnce() override;
+  int DecodedPixels() const override;
+
  private:
   static bool DecodeThreadFunction(void* ptr);
   void Decode();
+  // Time without a decodable frame after which a keyframe is requested.
+  int MaxWaitForFrameMs() const;
 
   TransportAdapter transport_adapter_;
   const VideoReceiveStream::Config config_;
@@ -129,10 +145,22 @@ class VideoReceiveStream : public webrtc::VideoReceiveStream,
   rtc::CriticalSection ivf_writer_lock_;
   std::unique_ptr<IvfFileWriter> ivf_writer_ GUARDED_BY(ivf_writer_lock_);
 
-  // Members for the new jitter buffer experiment.
-  const bool jitter_buffer_experiment_;
+  // Members for the FrameBuffer receive path, which is used unless the
+  // WebRTC-NewVideoJitterBuffer field trial is disabled.
+  const bool use_frame_buffer_;
   std::unique_ptr<VCMJitterEstimator> jitter_estimator_;
   std::unique_ptr<video_coding::FrameBuffer> frame_buffer_;
+  // Set if frames are decoded by the pool instead of |decode_thread_|.
+  DecodeThreadPool* const decode_thread_pool_;
+  bool decoding_in_pool_;
+  // Time since when DecodeOnce has not found a decodable frame, used to
+  // request keyframes. Only accessed by the stream's runs in the pool.
+  int64_t waiting_for_frame_since_ms_;
+  // Size of the last decoded frame, used as decode priority.
+  volatile int decoded_pixels_;
+
+  // Releases the frames of |incoming_video_stream_| if not null.
+  VideoRenderScheduler* const render_scheduler_;
 };
 }  // namespace internal
 }  // namespace webrtc
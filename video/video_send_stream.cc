@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -56,7 +57,7 @@ std::vector<RtpRtcp*> CreateRtpRtcpModules(
     RtcEventLog* event_log,
     RateLimiter* retransmission_rate_limiter,
     OverheadObserver* overhead_observer,
-    const MediaCryptoKey* media_crypto_key,                                          
+    MediaCryptoContext* media_crypto_context,
     size_t num_modules) {
   RTC_DCHECK_GT(num_modules, 0);
   RtpRtcp::Configuration configuration;
@@ -81,9 +82,9 @@ std::vector<RtpRtcp*> CreateRtpRtcpModules(
   configuration.event_log = event_log;
   configuration.retransmission_rate_limiter = retransmission_rate_limiter;
   configuration.overhead_observer = overhead_observer;
-  if (media_crypto_key) {
+  if (media_crypto_context) {
     configuration.media_crypto_enabled = true;
-    configuration.media_crypto_key = media_crypto_key;
+    configuration.media_crypto_context = media_crypto_context;
   }
   std::vector<RtpRtcp*> modules;
   for (size_t i = 0; i < num_modules; ++i) {
@@ -98,7 +99,8 @@ std::vector<RtpRtcp*> CreateRtpRtcpModules(
 
 // TODO(brandtr): Update this function when we support multistream protection.
 std::unique_ptr<FlexfecSender> MaybeCreateFlexfecSender(
-    const VideoSendStream::Config& config) {
+    const VideoSendStream::Config& config,
+    Clock* clock) {
   if (config.rtp.flexfec.payload_type < 0) {
     return nullptr;
   }
@@ -135,7 +137,7 @@ std::unique_ptr<FlexfecSender> MaybeCreateFlexfecSender(
   return std::unique_ptr<FlexfecSender>(new FlexfecSender(
       config.rtp.flexfec.payload_type, config.rtp.flexfec.ssrc,
       config.rtp.flexfec.protected_media_ssrcs[0], config.rtp.extensions,
-      Clock::GetRealTimeClock()));
+      clock));
 }
 
 }  // namespace
@@ -233,7 +235,8 @@ std::string VideoSendStream::Stats::ToString(int64_t time_ms) const {
   ss << "media_bps: " << media_bitrate_bps << ", ";
   ss << "preferred_media_bitrate_bps: " << preferred_media_bitrate_bps << ", ";
   ss << "suspended: " << (suspended ? "true" : "false") << ", ";
-  ss << "bw_adapted: " << (bw_limited_resolution ? "true" : "false");
+  ss << "bw_adapted: " << (bw_limited_resolution ? "true" : "false") << ", ";
+  ss << "alr_suppressed_padding_bytes: " << alr_suppressed_padding_bytes;
   ss << '}';
   for (const auto& substream : substreams) {
     if (!substream.second.is_rtx && !substream.second.is_flexfec) {
@@ -255,6 +258,10 @@ std::string VideoSendStream::StreamStats::ToString() const {
   ss << "retransmit_bps: " << retransmit_bitrate_bps << ", ";
   ss << "avg_delay_ms: " << avg_delay_ms << ", ";
   ss << "max_delay_ms: " << max_delay_ms << ", ";
+  ss << "avg_encode_time_ms: " << avg_encode_time_ms << ", ";
+  ss << "pacer_queue_p95_ms: " << pacer_queue_time_ms.p95 << ", ";
+  ss << "media_encryption_p95_us: " << media_encryption_time_us.p95 << ", ";
+  ss << "send_delay_p95_ms: " << send_delay_ms.p95 << ", ";
   ss << "cum_loss: " << rtcp_stats.cumulative_lost << ", ";
   ss << "max_ext_seq: " << rtcp_stats.extended_max_sequence_number << ", ";
   ss << "nack: " << rtcp_packet_type_counts.nack_packets << ", ";
@@ -298,6 +305,13 @@ int CalculateMaxPadBitrateBps(std::vector<VideoStream> streams,
 
 namespace internal {
 
+namespace {
+// Packetizes encoded frames on a separate task queue, so that the encoder can
+// start on the next frame while the previous one is packetized, encrypted and
+// protected.
+const char kPipelinedVideoSendFieldTrial[] = "WebRTC-PipelinedVideoSend";
+}  // namespace
+
 // VideoSendStreamImpl implements internal::VideoSendStream.
 // It is created and destroyed on |worker_queue|. The intent is to decrease the
 // need for locking and to ensure methods are called in sequence.
@@ -311,7 +325,8 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
                             public ViEEncoder::EncoderSink,
                             public VideoBitrateAllocationObserver {
  public:
-  VideoSendStreamImpl(SendStatisticsProxy* stats_proxy,
+  VideoSendStreamImpl(Clock* clock,
+                      SendStatisticsProxy* stats_proxy,
                       rtc::TaskQueue* worker_queue,
                       CallStats* call_stats,
                       CongestionController* congestion_controller,
@@ -321,6 +336,7 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
                       VieRemb* remb,
                       ViEEncoder* vie_encoder,
                       RtcEventLog* event_log,
+                      MediaCryptoContext* media_crypto_context,
                       const VideoSendStream::Config* config,
                       int initial_encoder_max_bitrate,
                       std::map<uint32_t, RtpState> suspended_ssrcs);
@@ -340,6 +356,9 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
   void Stop();
 
   VideoSendStream::RtpStateMap GetRtpStates() const;
+  // Adds the media crypto stats of the RTP modules to their substreams. Can be
+  // called on any thread.
+  void GetMediaCryptoStats(VideoSendStream::Stats* stats) const;
 
   void EnableEncodedFrameRecording(const std::vector<rtc::PlatformFile>& files,
                                    size_t byte_limit);
@@ -349,6 +368,7 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
  private:
   class CheckEncoderActivityTask;
   class EncoderReconfiguredTask;
+  class EncodedFrameTask;
 
   // Implements BitrateAllocatorObserver.
   uint32_t OnBitrateUpdated(uint32_t bitrate_bps,
@@ -377,6 +397,16 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
       const CodecSpecificInfo* codec_specific_info,
       const RTPFragmentationHeader* fragmentation) override;
 
+  // Routes an encoded frame to the |payload_router_| and the IVF writers and
+  // reports the time spent to |send_delay_stats_|. |encoded_time_ms| is when
+  // the encoder delivered the frame. Called on |send_queue_| if set,
+  // otherwise on the encoder callback thread.
+  EncodedImageCallback::Result SendEncodedImage(
+      const EncodedImage& encoded_image,
+      const CodecSpecificInfo* codec_specific_info,
+      const RTPFragmentationHeader* fragmentation,
+      int64_t encoded_time_ms);
+
   // Implements VideoBitrateAllocationObserver.
   void OnBitrateAllocationUpdated(const BitrateAllocation& allocation) override;
 
@@ -385,6 +415,7 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
   void SignalEncoderTimedOut();
   void SignalEncoderActive();
 
+  Clock* const clock_;
   SendStatisticsProxy* const stats_proxy_;
   const VideoSendStream::Config* const config_;
   std::map<uint32_t, RtpState> suspended_ssrcs_;
@@ -401,6 +432,7 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
   CongestionController* const congestion_controller_;
   PacketRouter* const packet_router_;
   BitrateAllocator* const bitrate_allocator_;
+  SendDelayStats* const send_delay_stats_;
   VieRemb* const remb_;
 
   // TODO(brandtr): Consider moving this to a new FlexfecSendStream class.
@@ -423,6 +455,9 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
   // RtpRtcp modules, declared here as they use other members on construction.
   const std::vector<RtpRtcp*> rtp_rtcp_modules_;
   PayloadRouter payload_router_;
+  // Set by the "WebRTC-PipelinedVideoSend" field trial. Destroyed first
+  // thing in the destructor, while the RTP modules are still alive.
+  std::unique_ptr<rtc::TaskQueue> send_queue_;
 
   // |weak_ptr_| to our self. This is used since we can not call
   // |weak_ptr_factory_.GetWeakPtr| from multiple sequences but it is ok to copy
@@ -435,6 +470,7 @@ class VideoSendStreamImpl : public webrtc::BitrateAllocatorObserver,
   rtc::CriticalSection overhead_bytes_per_packet_crit_;
   size_t overhead_bytes_per_packet_ GUARDED_BY(overhead_bytes_per_packet_crit_);
   size_t transport_overhead_bytes_per_packet_;
+  const bool send_side_bwe_with_overhead_;
 };
 
 // TODO(tommi): See if there's a more elegant way to create a task that creates
@@ -443,6 +479,7 @@ class VideoSendStream::ConstructionTask : public rtc::QueuedTask {
  public:
   ConstructionTask(std::unique_ptr<VideoSendStreamImpl>* send_stream,
                    rtc::Event* done_event,
+                   Clock* clock,
                    SendStatisticsProxy* stats_proxy,
                    ViEEncoder* vie_encoder,
                    ProcessThread* module_process_thread,
@@ -453,11 +490,13 @@ class VideoSendStream::ConstructionTask : public rtc::QueuedTask {
                    SendDelayStats* send_delay_stats,
                    VieRemb* remb,
                    RtcEventLog* event_log,
+                   MediaCryptoContext* media_crypto_context,
                    const VideoSendStream::Config* config,
                    int initial_encoder_max_bitrate,
                    const std::map<uint32_t, RtpState>& suspended_ssrcs)
       : send_stream_(send_stream),
         done_event_(done_event),
+        clock_(clock),
         stats_proxy_(stats_proxy),
         vie_encoder_(vie_encoder),
         call_stats_(call_stats),
@@ -467,6 +506,7 @@ class VideoSendStream::ConstructionTask : public rtc::QueuedTask {
         send_delay_stats_(send_delay_stats),
         remb_(remb),
         event_log_(event_log),
+        media_crypto_context_(media_crypto_context),
         config_(config),
         initial_encoder_max_bitrate_(initial_encoder_max_bitrate),
         suspended_ssrcs_(suspended_ssrcs) {}
@@ -476,15 +516,17 @@ class VideoSendStream::ConstructionTask : public rtc::QueuedTask {
  private:
   bool Run() override {
     send_stream_->reset(new VideoSendStreamImpl(
-        stats_proxy_, rtc::TaskQueue::Current(), call_stats_,
+        clock_, stats_proxy_, rtc::TaskQueue::Current(), call_stats_,
         congestion_controller_, packet_router_, bitrate_allocator_,
-        send_delay_stats_, remb_, vie_encoder_, event_log_, config_,
-        initial_encoder_max_bitrate_, std::move(suspended_ssrcs_)));
+        send_delay_stats_, remb_, vie_encoder_, event_log_,
+        media_crypto_context_, config_, initial_encoder_max_bitrate_,
+        std::move(suspended_ssrcs_)));
     return true;
   }
 
   std::unique_ptr<VideoSendStreamImpl>* const send_stream_;
   rtc::Event* const done_event_;
+  Clock* const clock_;
   SendStatisticsProxy* const stats_proxy_;
   ViEEncoder* const vie_encoder_;
   CallStats* const call_stats_;
@@ -494,6 +536,7 @@ class VideoSendStream::ConstructionTask : public rtc::QueuedTask {
   SendDelayStats* const send_delay_stats_;
   VieRemb* const remb_;
   RtcEventLog* const event_log_;
+  MediaCryptoContext* const media_crypto_context_;
   const VideoSendStream::Config* config_;
   int initial_encoder_max_bitrate_;
   std::map<uint32_t, RtpState> suspended_ssrcs_;
@@ -576,6 +619,49 @@ class VideoSendStreamImpl::CheckEncoderActivityTask : public rtc::QueuedTask {
   bool timed_out_;
 };
 
+// EncodedFrameTask owns a copy of an encoded frame, since the encoder reuses
+// its buffer for the next frame, and sends it on |send_queue_|.
+class VideoSendStreamImpl::EncodedFrameTask : public rtc::QueuedTask {
+ public:
+  EncodedFrameTask(VideoSendStreamImpl* send_stream,
+                   const EncodedImage& encoded_image,
+                   const CodecSpecificInfo* codec_specific_info,
+                   const RTPFragmentationHeader* fragmentation,
+                   int64_t encoded_time_ms)
+      : send_stream_(send_stream),
+        buffer_(new uint8_t[encoded_image._length]),
+        encoded_image_(encoded_image),
+        has_codec_specific_info_(codec_specific_info != nullptr),
+        encoded_time_ms_(encoded_time_ms) {
+    memcpy(buffer_.get(), encoded_image._buffer, encoded_image._length);
+    encoded_image_._buffer = buffer_.get();
+    encoded_image_._size = encoded_image._length;
+    if (codec_specific_info)
+      codec_specific_info_ = *codec_specific_info;
+    if (fragmentation) {
+      fragmentation_.reset(new RTPFragmentationHeader());
+      fragmentation_->CopyFrom(*fragmentation);
+    }
+  }
+
+ private:
+  bool Run() override {
+    send_stream_->SendEncodedImage(
+        encoded_image_,
+        has_codec_specific_info_ ? &codec_specific_info_ : nullptr,
+        fragmentation_.get(), encoded_time_ms_);
+    return true;
+  }
+
+  VideoSendStreamImpl* const send_stream_;
+  const std::unique_ptr<uint8_t[]> buffer_;
+  EncodedImage encoded_image_;
+  const bool has_codec_specific_info_;
+  CodecSpecificInfo codec_specific_info_;
+  std::unique_ptr<RTPFragmentationHeader> fragmentation_;
+  const int64_t encoded_time_ms_;
+};
+
 class VideoSendStreamImpl::EncoderReconfiguredTask : public rtc::QueuedTask {
  public:
   EncoderReconfiguredTask(const rtc::WeakPtr<VideoSendStreamImpl>& send_stream,
@@ -600,6 +686,7 @@ class VideoSendStreamImpl::EncoderReconfiguredTask : public rtc::QueuedTask {
 
 VideoSendStream::VideoSendStream(
     int num_cpu_cores,
+    Clock* clock,
     ProcessThread* module_process_thread,
     rtc::TaskQueue* worker_queue,
     CallStats* call_stats,
@@ -609,22 +696,23 @@ VideoSendStream::VideoSendStream(
     SendDelayStats* send_delay_stats,
     VieRemb* remb,
     RtcEventLog* event_log,
+    MediaCryptoContext* media_crypto_context,
     VideoSendStream::Config config,
     VideoEncoderConfig encoder_config,
     const std::map<uint32_t, RtpState>& suspended_ssrcs)
     : worker_queue_(worker_queue),
       thread_sync_event_(false /* manual_reset */, false),
-      stats_proxy_(Clock::GetRealTimeClock(),
-                   config,
-                   encoder_config.content_type),
+      stats_proxy_(clock, config, encoder_config.content_type),
+      send_delay_stats_(send_delay_stats),
       config_(std::move(config)) {
   vie_encoder_.reset(new ViEEncoder(
       num_cpu_cores, &stats_proxy_, config_.encoder_settings,
       config_.pre_encode_callback, config_.post_encode_callback));
   worker_queue_->PostTask(std::unique_ptr<rtc::QueuedTask>(new ConstructionTask(
-      &send_stream_, &thread_sync_event_, &stats_proxy_, vie_encoder_.get(),
-      module_process_thread, call_stats, congestion_controller, packet_router,
-      bitrate_allocator, send_delay_stats, remb, event_log, &config_,
+      &send_stream_, &thread_sync_event_, clock, &stats_proxy_,
+      vie_encoder_.get(), module_process_thread, call_stats,
+      congestion_controller, packet_router, bitrate_allocator,
+      send_delay_stats, remb, event_log, media_crypto_context, &config_,
       encoder_config.max_bitrate_bps, suspended_ssrcs)));
 
   // Wait for ConstructionTask to complete so that |send_stream_| can be used.
@@ -688,7 +776,14 @@ VideoSendStream::Stats VideoSendStream::GetStats() {
   // TODO(perkj, solenberg): Some test cases in EndToEndTest call GetStats from
   // a network thread. See comment in Call::GetStats().
   // RTC_DCHECK_RUN_ON(&thread_checker_);
-  return stats_proxy_.GetStats();
+  VideoSendStream::Stats stats = stats_proxy_.GetStats();
+  if (send_delay_stats_) {
+    for (auto& kv : stats.substreams)
+      send_delay_stats_->GetLatencyPercentiles(kv.first, &kv.second);
+  }
+  if (send_stream_)
+    send_stream_->GetMediaCryptoStats(&stats);
+  return stats;
 }
 
 void VideoSendStream::SignalNetworkState(NetworkState state) {
@@ -732,6 +827,7 @@ void VideoSendStream::EnableEncodedFrameRecording(
 }
 
 VideoSendStreamImpl::VideoSendStreamImpl(
+    Clock* clock,
     SendStatisticsProxy* stats_proxy,
     rtc::TaskQueue* worker_queue,
     CallStats* call_stats,
@@ -742,10 +838,12 @@ VideoSendStreamImpl::VideoSendStreamImpl(
     VieRemb* remb,
     ViEEncoder* vie_encoder,
     RtcEventLog* event_log,
+    MediaCryptoContext* media_crypto_context,
     const VideoSendStream::Config* config,
     int initial_encoder_max_bitrate,
     std::map<uint32_t, RtpState> suspended_ssrcs)
-    : stats_proxy_(stats_proxy),
+    : clock_(clock),
+      stats_proxy_(stats_proxy),
       config_(config),
       suspended_ssrcs_(std::move(suspended_ssrcs)),
       module_process_thread_(nullptr),
@@ -755,17 +853,16 @@ VideoSendStreamImpl::VideoSendStreamImpl(
       congestion_controller_(congestion_controller),
       packet_router_(packet_router),
       bitrate_allocator_(bitrate_allocator),
+      send_delay_stats_(send_delay_stats),
       remb_(remb),
-      flexfec_sender_(MaybeCreateFlexfecSender(*config_)),
+      flexfec_sender_(MaybeCreateFlexfecSender(*config_, clock_)),
       max_padding_bitrate_(0),
       encoder_min_bitrate_bps_(0),
       encoder_max_bitrate_bps_(initial_encoder_max_bitrate),
       encoder_target_rate_bps_(0),
       vie_encoder_(vie_encoder),
-      encoder_feedback_(Clock::GetRealTimeClock(),
-                        config_->rtp.ssrcs,
-                        vie_encoder),
-      protection_bitrate_calculator_(Clock::GetRealTimeClock(), this),
+      encoder_feedback_(clock_, config_->rtp.ssrcs, vie_encoder),
+      protection_bitrate_calculator_(clock_, this),
       bandwidth_observer_(congestion_controller_->GetBitrateController()
                               ->CreateRtcpBandwidthObserver()),
       rtp_rtcp_modules_(CreateRtpRtcpModules(
@@ -782,25 +879,34 @@ VideoSendStreamImpl::VideoSendStreamImpl(
           event_log,
           congestion_controller_->GetRetransmissionRateLimiter(),
           this,
-          config->media_crypto_enabled ? &(config->media_crypto_key) : NULL,
+          media_crypto_context,
           config_->rtp.ssrcs.size())),
       payload_router_(rtp_rtcp_modules_,
                       config_->encoder_settings.payload_type),
       weak_ptr_factory_(this),
       overhead_bytes_per_packet_(0),
-      transport_overhead_bytes_per_packet_(0) {
+      transport_overhead_bytes_per_packet_(0),
+      send_side_bwe_with_overhead_(
+          webrtc::field_trial::FindFullName(
+              "WebRTC-SendSideBwe-WithOverhead") == "Enabled") {
   RTC_DCHECK_RUN_ON(worker_queue_);
   LOG(LS_INFO) << "VideoSendStreamInternal: " << config_->ToString();
   weak_ptr_ = weak_ptr_factory_.GetWeakPtr();
   module_process_thread_checker_.DetachFromThread();
 
+  if (field_trial::FindFullName(kPipelinedVideoSendFieldTrial) == "Enabled")
+    send_queue_.reset(new rtc::TaskQueue("VideoSendQueue"));
+
   RTC_DCHECK(!config_->rtp.ssrcs.empty());
   RTC_DCHECK(call_stats_);
   RTC_DCHECK(congestion_controller_);
   RTC_DCHECK(remb_);
 
   congestion_controller_->EnablePeriodicAlrProbing(
-      config_->periodic_alr_bandwidth_probing);
+      config_->periodic_alr_bandwidth_probing ||
+      config_->suppress_padding_in_alr);
+  congestion_controller_->EnableAlrPaddingSuppression(
+      config_->suppress_padding_in_alr);
 
   // RTP/RTCP initialization.
   for (RtpRtcp* rtp_rtcp : rtp_rtcp_modules_) {
@@ -880,6 +986,9 @@ VideoSendStreamImpl::~VideoSendStreamImpl() {
       << "VideoSendStreamImpl::Stop not called";
   LOG(LS_INFO) << "~VideoSendStreamInternal: " << config_->ToString();
 
+  // Waits for the frame being sent, if any, and drops the queued ones.
+  send_queue_.reset();
+
   rtp_rtcp_modules_[0]->SetREMBStatus(false);
   remb_->RemoveRembSender(rtp_rtcp_modules_[0]);
 
@@ -1025,6 +1134,25 @@ EncodedImageCallback::Result VideoSendStreamImpl::OnEncodedImage(
   }
 
   protection_bitrate_calculator_.UpdateWithEncodedData(encoded_image);
+
+  int64_t encoded_time_ms = clock_->TimeInMilliseconds();
+  if (send_queue_) {
+    send_queue_->PostTask(std::unique_ptr<rtc::QueuedTask>(
+        new EncodedFrameTask(this, encoded_image, codec_specific_info,
+                             fragmentation, encoded_time_ms)));
+    // The RTP timestamp is the frame id of frames that are yet to be sent.
+    return Result(Result::OK, encoded_image._timeStamp);
+  }
+  return SendEncodedImage(encoded_image, codec_specific_info, fragmentation,
+                          encoded_time_ms);
+}
+
+EncodedImageCallback::Result VideoSendStreamImpl::SendEncodedImage(
+    const EncodedImage& encoded_image,
+    const CodecSpecificInfo* codec_specific_info,
+    const RTPFragmentationHeader* fragmentation,
+    int64_t encoded_time_ms) {
+  int64_t start_ms = clock_->TimeInMilliseconds();
   EncodedImageCallback::Result result = payload_router_.OnEncodedImage(
       encoded_image, codec_specific_info, fragmentation);
 
@@ -1033,6 +1161,12 @@ EncodedImageCallback::Result VideoSendStreamImpl::OnEncodedImage(
   int layer = codec_specific_info->codecType == kVideoCodecVP8
                   ? codec_specific_info->codecSpecific.VP8.simulcastIdx
                   : 0;
+  if (send_delay_stats_ &&
+      static_cast<size_t>(layer) < config_->rtp.ssrcs.size()) {
+    send_delay_stats_->OnEncodedFrameSent(
+        config_->rtp.ssrcs[layer], start_ms - encoded_time_ms,
+        clock_->TimeInMilliseconds() - start_ms);
+  }
   {
     rtc::CritScope lock(&ivf_writers_crit_);
     if (file_writers_[layer].get()) {
@@ -1193,6 +1327,17 @@ std::map<uint32_t, RtpState> VideoSendStreamImpl::GetRtpStates() const {
   return rtp_states;
 }
 
+void VideoSendStreamImpl::GetMediaCryptoStats(
+    VideoSendStream::Stats* stats) const {
+  for (size_t i = 0; i < config_->rtp.ssrcs.size(); ++i) {
+    MediaCryptoStats media_crypto_stats;
+    if (!rtp_rtcp_modules_[i]->GetMediaCryptoStats(&media_crypto_stats))
+      continue;
+    stats->substreams[config_->rtp.ssrcs[i]].media_crypto =
+        rtc::Optional<MediaCryptoStats>(media_crypto_stats);
+  }
+}
+
 void VideoSendStreamImpl::SignalNetworkState(NetworkState state) {
   RTC_DCHECK_RUN_ON(worker_queue_);
   for (RtpRtcp* rtp_rtcp : rtp_rtcp_modules_) {
@@ -1209,8 +1354,7 @@ uint32_t VideoSendStreamImpl::OnBitrateUpdated(uint32_t bitrate_bps,
   RTC_DCHECK(payload_router_.IsActive())
       << "VideoSendStream::Start has not been called.";
 
-  if (webrtc::field_trial::FindFullName("WebRTC-SendSideBwe-WithOverhead") ==
-      "Enabled") {
+  if (send_side_bwe_with_overhead_) {
     // Subtract total overhead (transport + rtp) from bitrate.
     size_t rtp_overhead;
     {
@@ -1234,6 +1378,11 @@ uint32_t VideoSendStreamImpl::OnBitrateUpdated(uint32_t bitrate_bps,
     }
   }
 
+  if (config_->suppress_padding_in_alr) {
+    stats_proxy_->OnAlrSuppressedPadding(
+        congestion_controller_->pacer()->AlrSuppressedPaddingBytes());
+  }
+
   // Get the encoder target rate. It is the estimated network rate -
   // protection overhead.
   encoder_target_rate_bps_ = protection_bitrate_calculator_.SetTargetRates(
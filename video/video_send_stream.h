@@ -35,6 +35,7 @@ class BitrateAllocator;
 class CallStats;
 class CongestionController;
 class IvfFileWriter;
+class MediaCryptoContext;
 class PacketRouter;
 class ProcessThread;
 class RtpRtcp;
@@ -51,6 +52,7 @@ class VideoSendStreamImpl;
 class VideoSendStream : public webrtc::VideoSendStream {
  public:
   VideoSendStream(int num_cpu_cores,
+                  Clock* clock,
                   ProcessThread* module_process_thread,
                   rtc::TaskQueue* worker_queue,
                   CallStats* call_stats,
@@ -60,6 +62,7 @@ class VideoSendStream : public webrtc::VideoSendStream {
                   SendDelayStats* send_delay_stats,
                   VieRemb* remb,
                   RtcEventLog* event_log,
+                  MediaCryptoContext* media_crypto_context,
                   VideoSendStream::Config config,
                   VideoEncoderConfig encoder_config,
                   const std::map<uint32_t, RtpState>& suspended_ssrcs);
@@ -103,6 +106,7 @@ class VideoSendStream : public webrtc::VideoSendStream {
   rtc::Event thread_sync_event_;
 
   SendStatisticsProxy stats_proxy_;
+  SendDelayStats* const send_delay_stats_;
   const VideoSendStream::Config config_;
   std::unique_ptr<VideoSendStreamImpl> send_stream_;
   std::unique_ptr<ViEEncoder> vie_encoder_;
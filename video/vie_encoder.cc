@@ -11,11 +11,13 @@
 #include "webrtc/video/vie_encoder.h"
 
 #include <algorithm>
+#include <cstdlib>
 #include <limits>
 #include <utility>
 
 #include "webrtc/modules/video_coding/include/video_codec_initializer.h"
 #include "webrtc/base/arraysize.h"
+#include "webrtc/base/atomicops.h"
 #include "webrtc/base/checks.h"
 #include "webrtc/base/logging.h"
 #include "webrtc/base/trace_event.h"
@@ -25,6 +27,7 @@
 #include "webrtc/modules/video_coding/codecs/vp8/temporal_layers.h"
 #include "webrtc/modules/video_coding/include/video_coding.h"
 #include "webrtc/modules/video_coding/include/video_coding_defines.h"
+#include "webrtc/system_wrappers/include/field_trial.h"
 #include "webrtc/video/overuse_frame_detector.h"
 #include "webrtc/video/send_statistics_proxy.h"
 #include "webrtc/video_frame.h"
@@ -41,6 +44,16 @@ const int kMinPixelsPerFrame = 320 * 180;
 #else
 const int kMinPixelsPerFrame = 120 * 90;
 #endif
+// We will never ask for a framerate lower than this.
+const int kMinFramerateFps = 5;
+// Upper bound on the time key frame requests are coalesced for after a key
+// frame, so that a receiver that lost it recovers in reasonable time.
+const int64_t kMaxKeyFrameCoalescingWindowMs = 1000;
+
+// True if the source marked the frame as identical to the previous one.
+bool IsUnchanged(const VideoFrame& frame) {
+  return frame.update_rect() && frame.update_rect()->IsEmpty();
+}
 
 // TODO(pbos): Lower these thresholds (to closer to 100%) when we handle
 // pipelining encoders better (multiple input frames before something comes
@@ -52,6 +65,8 @@ CpuOveruseOptions GetCpuOveruseOptions(bool full_overuse_time) {
     options.low_encode_usage_threshold_percent = 150;
     options.high_encode_usage_threshold_percent = 200;
   }
+  options.use_thread_cpu_time =
+      field_trial::FindFullName("WebRTC-CpuOveruseThreadCpuTime") == "Enabled";
   return options;
 }
 
@@ -108,6 +123,11 @@ class ViEEncoder::EncodeTask : public rtc::QueuedTask {
       LOG(LS_VERBOSE)
           << "Incoming frame dropped due to that the encoder is blocked.";
       ++vie_encoder_->dropped_frame_count_;
+      // The newer frame may be marked unchanged relative to this one.
+      if (!IsUnchanged(frame_)) {
+        vie_encoder_->last_content_change_ms_ =
+            vie_encoder_->clock_->TimeInMilliseconds();
+      }
     }
     if (log_stats_) {
       LOG(LS_INFO) << "Number of frames: captured "
@@ -194,6 +214,16 @@ class ViEEncoder::VideoSourceProxy {
       source_->AddOrUpdateSink(vie_encoder_, sink_wants_);
   }
 
+  void RequestMaxFramerate(rtc::Optional<int> max_framerate_fps) {
+    // Called on the encoder task queue.
+    rtc::CritScope lock(&crit_);
+    // The framerate is only reduced when the resolution must be maintained,
+    // otherwise the resolution is reduced instead.
+    disabled_scaling_sink_wants_.max_framerate_fps = max_framerate_fps;
+    if (source_ && !IsResolutionScalingEnabledLocked())
+      source_->AddOrUpdateSink(vie_encoder_, disabled_scaling_sink_wants_);
+  }
+
   void RequestHigherResolutionThan(int pixel_count) {
     rtc::CritScope lock(&crit_);
     if (!IsResolutionScalingEnabledLocked()) {
@@ -263,11 +293,20 @@ ViEEncoder::ViEEncoder(uint32_t number_of_cores,
       max_data_payload_length_(0),
       nack_enabled_(false),
       last_observed_bitrate_bps_(0),
+      last_observed_fraction_lost_(0),
+      last_observed_rtt_ms_(0),
       encoder_paused_and_dropped_frame_(false),
       has_received_sli_(false),
       picture_id_sli_(0),
       has_received_rpsi_(false),
       picture_id_rpsi_(0),
+      skip_unchanged_frames_(
+          field_trial::FindFullName("WebRTC-SkipUnchangedFrames") ==
+          "Enabled"),
+      key_frame_requested_(false),
+      last_key_frames_(kMaxSimulcastStreams),
+      last_content_change_ms_(0),
+      last_frame_to_encoder_ms_(0),
       clock_(Clock::GetRealTimeClock()),
       scale_counter_(kScaleReasonSize, 0),
       last_captured_timestamp_(0),
@@ -276,6 +315,8 @@ ViEEncoder::ViEEncoder(uint32_t number_of_cores,
       last_frame_log_ms_(clock_->TimeInMilliseconds()),
       captured_frame_count_(0),
       dropped_frame_count_(0),
+      max_framerate_fps_(0),
+      dropped_changed_frame_(false),
       bitrate_observer_(nullptr),
       encoder_queue_("EncoderQueue") {
   encoder_queue_.PostTask([this] {
@@ -341,6 +382,7 @@ void ViEEncoder::SetSource(
     RTC_DCHECK_RUN_ON(&encoder_queue_);
     scaling_enabled_ = (degradation_preference !=
          VideoSendStream::DegradationPreference::kMaintainResolution);
+    UpdateMaxFramerate();
     stats_proxy_->SetResolutionRestrictionStats(
         scaling_enabled_, scale_counter_[kCpu] > 0, scale_counter_[kQuality]);
   });
@@ -407,11 +449,15 @@ void ViEEncoder::ReconfigureEncoder() {
                                          &rate_allocator_)) {
     LOG(LS_ERROR) << "Failed to create encoder configuration.";
   }
+  for (size_t stream_index : paused_streams_)
+    rate_allocator_->SetStreamPaused(stream_index, true);
 
   codec.startBitrate =
       std::max(encoder_start_bitrate_bps_ / 1000, codec.minBitrate);
   codec.startBitrate = std::min(codec.startBitrate, codec.maxBitrate);
   codec.expect_encode_from_texture = last_frame_info_->is_texture;
+  encoder_max_framerate_ = codec.maxFramerate;
+  UpdateMaxFramerate();
 
   bool success = video_sender_.RegisterSendCodec(
                      &codec, number_of_cores_,
@@ -482,6 +528,8 @@ void ViEEncoder::OnFrame(const VideoFrame& video_frame) {
                     << incoming_frame.ntp_time_ms()
                     << " <= " << last_captured_timestamp_
                     << ") for incoming frame. Dropping.";
+    if (!IsUnchanged(incoming_frame))
+      dropped_changed_frame_ = true;
     return;
   }
 
@@ -492,10 +540,51 @@ void ViEEncoder::OnFrame(const VideoFrame& video_frame) {
   }
 
   last_captured_timestamp_ = incoming_frame.ntp_time_ms();
+
+  // Drop frames above the framerate requested from the source here too, before
+  // they are queued, in case the source doesn't honor the request.
+  const int max_framerate_fps =
+      rtc::AtomicOps::AcquireLoad(&max_framerate_fps_);
+  if (max_framerate_fps > 0 &&
+      !KeepFrame(incoming_frame.ntp_time_ms(), max_framerate_fps)) {
+    LOG(LS_VERBOSE) << "Incoming frame dropped to limit the framerate to "
+                    << max_framerate_fps << " fps.";
+    if (!IsUnchanged(incoming_frame))
+      dropped_changed_frame_ = true;
+    return;
+  }
+
+  if (dropped_changed_frame_) {
+    incoming_frame.set_update_rect(rtc::Optional<VideoFrame::UpdateRect>());
+    dropped_changed_frame_ = false;
+  }
+
   encoder_queue_.PostTask(std::unique_ptr<rtc::QueuedTask>(new EncodeTask(
       incoming_frame, this, clock_->TimeInMilliseconds(), log_stats)));
 }
 
+bool ViEEncoder::KeepFrame(int64_t capture_time_ms, int max_framerate_fps) {
+  RTC_DCHECK_RUNS_SERIALIZED(&incoming_frame_race_checker_);
+  // Same pacing as cricket::VideoAdapter::KeepFrame, which the source uses.
+  const int64_t interval_ms = rtc::kNumMillisecsPerSec / max_framerate_fps;
+  if (next_frame_time_ms_) {
+    const int64_t time_until_next_frame_ms =
+        *next_frame_time_ms_ - capture_time_ms;
+    if (std::abs(time_until_next_frame_ms) < 2 * interval_ms) {
+      if (time_until_next_frame_ms > 0)
+        return false;
+      *next_frame_time_ms_ += interval_ms;
+      return true;
+    }
+  }
+  // First frame or a capture time way outside the expected range, so reset.
+  // The first target is half an interval away to prefer keeping frames in
+  // case of jitter.
+  next_frame_time_ms_ =
+      rtc::Optional<int64_t>(capture_time_ms + interval_ms / 2);
+  return true;
+}
+
 bool ViEEncoder::EncoderPaused() const {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
   // Pause video if paused by caller or as long as the network is down or the
@@ -546,6 +635,8 @@ void ViEEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
   }
 
   int64_t now_ms = clock_->TimeInMilliseconds();
+  if (pending_encoder_reconfiguration_ || !IsUnchanged(video_frame))
+    last_content_change_ms_ = now_ms;
   if (pending_encoder_reconfiguration_) {
     ReconfigureEncoder();
   } else if (!last_parameters_update_ms_ ||
@@ -562,6 +653,18 @@ void ViEEncoder::EncodeVideoFrame(const VideoFrame& video_frame,
   }
   TraceFrameDropEnd();
 
+  // Skip frames identical to the previous one, unless the encoder may still
+  // be refining the quality or the receiver would otherwise go too long
+  // without a frame.
+  if (skip_unchanged_frames_ && IsUnchanged(video_frame) &&
+      !key_frame_requested_ &&
+      now_ms - last_content_change_ms_ >= kUnchangedFrameIntervalMs &&
+      now_ms - last_frame_to_encoder_ms_ < kUnchangedFrameIntervalMs) {
+    return;
+  }
+  last_frame_to_encoder_ms_ = now_ms;
+  key_frame_requested_ = false;
+
   TRACE_EVENT_ASYNC_STEP0("webrtc", "Video", video_frame.render_time_ms(),
                           "Encode");
 
@@ -590,6 +693,7 @@ void ViEEncoder::SendKeyFrame() {
     return;
   }
   RTC_DCHECK_RUN_ON(&encoder_queue_);
+  key_frame_requested_ = true;
   video_sender_.IntraFrameRequest(0);
 }
 
@@ -609,12 +713,26 @@ EncodedImageCallback::Result ViEEncoder::OnEncodedImage(
   int64_t time_sent = clock_->TimeInMilliseconds();
   uint32_t timestamp = encoded_image._timeStamp;
   const int qp = encoded_image.qp_;
-  encoder_queue_.PostTask([this, timestamp, time_sent, qp] {
-    RTC_DCHECK_RUN_ON(&encoder_queue_);
-    overuse_detector_.FrameSent(timestamp, time_sent);
-    if (quality_scaler_)
-      quality_scaler_->ReportQP(qp);
-  });
+  const bool key_frame = encoded_image._frameType == kVideoFrameKey;
+  const size_t size_bytes = encoded_image._length;
+  size_t stream_index = 0;
+  if (codec_specific_info) {
+    stream_index = codec_specific_info->codecType == kVideoCodecVP8
+                       ? codec_specific_info->codecSpecific.VP8.simulcastIdx
+                       : codec_specific_info->codecSpecific.generic
+                             .simulcast_idx;
+  }
+  encoder_queue_.PostTask(
+      [this, timestamp, time_sent, qp, key_frame, size_bytes, stream_index] {
+        RTC_DCHECK_RUN_ON(&encoder_queue_);
+        overuse_detector_.FrameSent(timestamp, time_sent);
+        if (quality_scaler_)
+          quality_scaler_->ReportQP(qp);
+        if (key_frame && stream_index < last_key_frames_.size()) {
+          last_key_frames_[stream_index].time_ms = time_sent;
+          last_key_frames_[stream_index].size_bytes = size_bytes;
+        }
+      });
 
   return result;
 }
@@ -660,11 +778,61 @@ void ViEEncoder::OnReceivedIntraFrameRequest(size_t stream_index) {
     return;
   }
   RTC_DCHECK_RUN_ON(&encoder_queue_);
+  // A request that arrives before the last key frame could have reached its
+  // sender is satisfied by that key frame. With a distributor relaying the
+  // requests of many receivers this avoids back to back key frames.
+  if (stream_index < last_key_frames_.size() &&
+      last_key_frames_[stream_index].time_ms >= 0 &&
+      clock_->TimeInMilliseconds() - last_key_frames_[stream_index].time_ms <
+          KeyFrameCoalescingWindowMs(stream_index)) {
+    return;
+  }
   // Key frame request from remote side, signal to VCM.
   TRACE_EVENT0("webrtc", "OnKeyFrameRequest");
+  key_frame_requested_ = true;
   video_sender_.IntraFrameRequest(stream_index);
 }
 
+int64_t ViEEncoder::KeyFrameCoalescingWindowMs(size_t stream_index) const {
+  RTC_DCHECK_RUN_ON(&encoder_queue_);
+  // The key frame needs to be sent out at the target bitrate and make its
+  // way to the receiver, which then needs to tell if it could decode it.
+  int64_t send_time_ms = 0;
+  if (last_observed_bitrate_bps_ > 0) {
+    send_time_ms = static_cast<int64_t>(
+        last_key_frames_[stream_index].size_bytes * 8 * 1000 /
+        last_observed_bitrate_bps_);
+  }
+  return std::min(last_observed_rtt_ms_ + send_time_ms,
+                  kMaxKeyFrameCoalescingWindowMs);
+}
+
+void ViEEncoder::OnStreamPauseRequest(size_t stream_index, bool paused) {
+  if (!encoder_queue_.IsCurrent()) {
+    encoder_queue_.PostTask([this, stream_index, paused] {
+      OnStreamPauseRequest(stream_index, paused);
+    });
+    return;
+  }
+  RTC_DCHECK_RUN_ON(&encoder_queue_);
+  LOG(LS_INFO) << "Simulcast stream " << stream_index
+               << (paused ? " paused" : " resumed") << " by the remote end.";
+  if (paused) {
+    paused_streams_.insert(stream_index);
+  } else {
+    paused_streams_.erase(stream_index);
+  }
+  // Applied by ReconfigureEncoder once the encoder is created.
+  if (!rate_allocator_)
+    return;
+  rate_allocator_->SetStreamPaused(stream_index, paused);
+  // Reallocate the last target bitrate. The encoder stops encoding streams
+  // allocated nothing, and starts a resumed one with a key frame.
+  video_sender_.SetChannelParameters(
+      last_observed_bitrate_bps_, last_observed_fraction_lost_,
+      last_observed_rtt_ms_, rate_allocator_.get(), bitrate_observer_);
+}
+
 void ViEEncoder::OnBitrateUpdated(uint32_t bitrate_bps,
                                   uint8_t fraction_lost,
                                   int64_t round_trip_time_ms) {
@@ -691,6 +859,8 @@ void ViEEncoder::OnBitrateUpdated(uint32_t bitrate_bps,
   bool video_is_suspended = bitrate_bps == 0;
   bool video_suspension_changed = video_is_suspended != EncoderPaused();
   last_observed_bitrate_bps_ = bitrate_bps;
+  last_observed_fraction_lost_ = fraction_lost;
+  last_observed_rtt_ms_ = round_trip_time_ms;
 
   if (stats_proxy_ && video_suspension_changed) {
     LOG(LS_INFO) << "Video suspend state changed to: "
@@ -701,8 +871,18 @@ void ViEEncoder::OnBitrateUpdated(uint32_t bitrate_bps,
 
 void ViEEncoder::ScaleDown(ScaleReason reason) {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
-  if (!scaling_enabled_)
+  if (!scaling_enabled_) {
+    // The resolution must be maintained, reduce the framerate on CPU overuse
+    // instead so that the source drops frames before any pixel work.
+    if (reason == kCpu && framerate_downgrades_ < kMaxCpuDowngrades &&
+        encoder_max_framerate_ > kMinFramerateFps) {
+      ++framerate_downgrades_;
+      UpdateMaxFramerate();
+      LOG(LS_INFO) << "Scaling down framerate, downgrades: "
+                   << framerate_downgrades_;
+    }
     return;
+  }
   // Request lower resolution if the current resolution is lower than last time
   // we asked for the resolution to be lowered.
   int current_pixel_count =
@@ -734,7 +914,16 @@ void ViEEncoder::ScaleDown(ScaleReason reason) {
 
 void ViEEncoder::ScaleUp(ScaleReason reason) {
   RTC_DCHECK_RUN_ON(&encoder_queue_);
-  if (scale_counter_[reason] == 0 || !scaling_enabled_)
+  if (!scaling_enabled_) {
+    if (reason == kCpu && framerate_downgrades_ > 0) {
+      --framerate_downgrades_;
+      UpdateMaxFramerate();
+      LOG(LS_INFO) << "Scaling up framerate, downgrades: "
+                   << framerate_downgrades_;
+    }
+    return;
+  }
+  if (scale_counter_[reason] == 0)
     return;
   // Only scale if resolution is higher than last time
   // we requested higher resolution.
@@ -764,4 +953,25 @@ void ViEEncoder::ScaleUp(ScaleReason reason) {
   }
 }
 
+void ViEEncoder::UpdateMaxFramerate() {
+  RTC_DCHECK_RUN_ON(&encoder_queue_);
+  rtc::Optional<int> max_framerate_fps;
+  if (framerate_downgrades_ > 0) {
+    int framerate_fps = encoder_max_framerate_;
+    for (int i = 0; i < framerate_downgrades_; ++i)
+      framerate_fps = framerate_fps * 2 / 3;
+    max_framerate_fps =
+        rtc::Optional<int>(std::max(framerate_fps, kMinFramerateFps));
+  }
+  if (max_framerate_fps != requested_max_framerate_fps_) {
+    requested_max_framerate_fps_ = max_framerate_fps;
+    source_proxy_->RequestMaxFramerate(max_framerate_fps);
+  }
+  // The restriction is kept while the resolution may be scaled, and applied
+  // again if the resolution must be maintained later.
+  rtc::AtomicOps::ReleaseStore(
+      &max_framerate_fps_,
+      scaling_enabled_ ? 0 : max_framerate_fps.value_or(0));
+}
+
 }  // namespace webrtc
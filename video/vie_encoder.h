@@ -12,6 +12,7 @@
 #define WEBRTC_VIDEO_VIE_ENCODER_H_
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -61,9 +62,15 @@ class ViEEncoder : public rtc::VideoSinkInterface<VideoFrame>,
         int min_transmit_bitrate_bps) = 0;
   };
 
-  // Downscale resolution at most 2 times for CPU reasons.
+  // Downscale resolution, or framerate if the resolution must be maintained,
+  // at most 2 times for CPU reasons.
   static const int kMaxCpuDowngrades = 2;
 
+  // Frames marked by the source as identical to the previous one are encoded
+  // for this long after the last change, so the encoder can refine the
+  // quality, and then only once per this interval.
+  static const int64_t kUnchangedFrameIntervalMs = 1000;
+
   ViEEncoder(uint32_t number_of_cores,
              SendStatisticsProxy* stats_proxy,
              const VideoSendStream::Config::EncoderSettings& settings,
@@ -108,6 +115,9 @@ class ViEEncoder : public rtc::VideoSinkInterface<VideoFrame>,
   virtual void OnReceivedIntraFrameRequest(size_t stream_index);
   virtual void OnReceivedSLI(uint8_t picture_id);
   virtual void OnReceivedRPSI(uint64_t picture_id);
+  // Stops encoding the simulcast stream |stream_index| while |paused|, for
+  // streams nobody subscribes to. Its bitrate goes to the other streams.
+  virtual void OnStreamPauseRequest(size_t stream_index, bool paused);
 
   void OnBitrateUpdated(uint32_t bitrate_bps,
                         uint8_t fraction_lost,
@@ -149,6 +159,7 @@ class ViEEncoder : public rtc::VideoSinkInterface<VideoFrame>,
                                    size_t max_data_payload_length,
                                    bool nack_enabled);
   void ReconfigureEncoder();
+  int64_t KeyFrameCoalescingWindowMs(size_t stream_index) const;
 
   // Implements VideoSinkInterface.
   void OnFrame(const VideoFrame& video_frame) override;
@@ -168,6 +179,12 @@ class ViEEncoder : public rtc::VideoSinkInterface<VideoFrame>,
 
   void OnDroppedFrame() override;
 
+  // Paces incoming frames to |max_framerate_fps| by their capture time.
+  bool KeepFrame(int64_t capture_time_ms, int max_framerate_fps);
+  // Computes the framerate restriction from |framerate_downgrades_| and
+  // requests it from the source.
+  void UpdateMaxFramerate();
+
   bool EncoderPaused() const;
   void TraceFrameDropStart();
   void TraceFrameDropEnd();
@@ -205,11 +222,32 @@ class ViEEncoder : public rtc::VideoSinkInterface<VideoFrame>,
   size_t max_data_payload_length_ ACCESS_ON(&encoder_queue_);
   bool nack_enabled_ ACCESS_ON(&encoder_queue_);
   uint32_t last_observed_bitrate_bps_ ACCESS_ON(&encoder_queue_);
+  uint8_t last_observed_fraction_lost_ ACCESS_ON(&encoder_queue_);
+  int64_t last_observed_rtt_ms_ ACCESS_ON(&encoder_queue_);
+  // Simulcast streams paused by the remote end, kept across reconfigurations.
+  std::set<size_t> paused_streams_ ACCESS_ON(&encoder_queue_);
   bool encoder_paused_and_dropped_frame_ ACCESS_ON(&encoder_queue_);
   bool has_received_sli_ ACCESS_ON(&encoder_queue_);
   uint8_t picture_id_sli_ ACCESS_ON(&encoder_queue_);
   bool has_received_rpsi_ ACCESS_ON(&encoder_queue_);
   uint64_t picture_id_rpsi_ ACCESS_ON(&encoder_queue_);
+  // Whether frames marked unchanged are skipped. Off unless the
+  // "WebRTC-SkipUnchangedFrames" field trial is enabled, as no source in the
+  // tree sets the update rect yet, nor do the adapters that drop frames carry
+  // the update rects of the frames they drop over to the next frame.
+  const bool skip_unchanged_frames_;
+  // Set when a key frame is requested, so the next frame isn't skipped even
+  // if it is unchanged.
+  bool key_frame_requested_ ACCESS_ON(&encoder_queue_);
+  struct KeyFrameInfo {
+    int64_t time_ms = -1;
+    size_t size_bytes = 0;
+  };
+  // Last key frame of each simulcast stream, for coalescing the requests
+  // that were sent before it could reach their receivers.
+  std::vector<KeyFrameInfo> last_key_frames_ ACCESS_ON(&encoder_queue_);
+  int64_t last_content_change_ms_ ACCESS_ON(&encoder_queue_);
+  int64_t last_frame_to_encoder_ms_ ACCESS_ON(&encoder_queue_);
   Clock* const clock_;
   // Counters used for deciding if the video resolution is currently
   // restricted, and if so, why.
@@ -221,6 +259,11 @@ class ViEEncoder : public rtc::VideoSinkInterface<VideoFrame>,
   rtc::Optional<int> max_pixel_count_ ACCESS_ON(&encoder_queue_);
   // Pixel count last time the resolution was requested to be changed up.
   rtc::Optional<int> max_pixel_count_step_up_ ACCESS_ON(&encoder_queue_);
+  // Number of times the framerate was reduced for CPU reasons while the
+  // resolution must be maintained.
+  int framerate_downgrades_ ACCESS_ON(&encoder_queue_) = 0;
+  int encoder_max_framerate_ ACCESS_ON(&encoder_queue_) = 0;
+  rtc::Optional<int> requested_max_framerate_fps_ ACCESS_ON(&encoder_queue_);
 
   rtc::RaceChecker incoming_frame_race_checker_
       GUARDED_BY(incoming_frame_race_checker_);
@@ -233,6 +276,16 @@ class ViEEncoder : public rtc::VideoSinkInterface<VideoFrame>,
   int64_t last_frame_log_ms_ GUARDED_BY(incoming_frame_race_checker_);
   int captured_frame_count_ ACCESS_ON(&encoder_queue_);
   int dropped_frame_count_ ACCESS_ON(&encoder_queue_);
+  // Framerate limit of the incoming frames, 0 if not limited. Written on
+  // |encoder_queue_| and read without locking on every incoming frame.
+  volatile int max_framerate_fps_;
+  // Capture time at which the next frame is admitted when the framerate is
+  // limited.
+  rtc::Optional<int64_t> next_frame_time_ms_
+      GUARDED_BY(incoming_frame_race_checker_);
+  // Set when a frame that may have changed is dropped before being queued, so
+  // that the next frame isn't treated as unchanged.
+  bool dropped_changed_frame_ GUARDED_BY(incoming_frame_race_checker_);
 
   VideoBitrateAllocationObserver* bitrate_observer_ ACCESS_ON(&encoder_queue_);
   rtc::Optional<int64_t> last_parameters_update_ms_ ACCESS_ON(&encoder_queue_);
@@ -18,6 +18,7 @@
 #include "webrtc/system_wrappers/include/sleep.h"
 #include "webrtc/test/encoder_settings.h"
 #include "webrtc/test/fake_encoder.h"
+#include "webrtc/test/field_trial.h"
 #include "webrtc/test/frame_generator.h"
 #include "webrtc/test/gmock.h"
 #include "webrtc/test/gtest.h"
@@ -278,6 +279,11 @@ class ViEEncoderTest : public ::testing::Test {
       return min_transmit_bitrate_bps_;
     }
 
+    FrameType last_frame_type() {
+      rtc::CritScope lock(&crit_);
+      return frame_type_;
+    }
+
    private:
     Result OnEncodedImage(
         const EncodedImage& encoded_image,
@@ -286,6 +292,7 @@ class ViEEncoderTest : public ::testing::Test {
       rtc::CritScope lock(&crit_);
       EXPECT_TRUE(expect_frames_);
       timestamp_ = encoded_image._timeStamp;
+      frame_type_ = encoded_image._frameType;
       encoded_frame_event_.Set();
       return Result(Result::OK, timestamp_);
     }
@@ -301,6 +308,7 @@ class ViEEncoderTest : public ::testing::Test {
     TestEncoder* test_encoder_;
     rtc::Event encoded_frame_event_;
     uint32_t timestamp_ = 0;
+    FrameType frame_type_ = kEmptyFrame;
     bool expect_frames_ = true;
     int number_of_reconfigurations_ = 0;
     int min_transmit_bitrate_bps_ = 0;
@@ -326,6 +334,68 @@ TEST_F(ViEEncoderTest, EncodeOneFrame) {
   vie_encoder_->Stop();
 }
 
+TEST_F(ViEEncoderTest, EncodesUnchangedFramesByDefault) {
+  vie_encoder_->OnBitrateUpdated(kTargetBitrateBps, 0, 0);
+  VideoFrame::UpdateRect unchanged = {0, 0, 0, 0};
+
+  video_source_.IncomingCapturedFrame(CreateFrame(1, nullptr));
+  sink_.WaitForEncodedFrame(1);
+
+  SleepMs(ViEEncoder::kUnchangedFrameIntervalMs);
+  for (int64_t ntp_time_ms = 2; ntp_time_ms <= 3; ++ntp_time_ms) {
+    VideoFrame frame = CreateFrame(ntp_time_ms, nullptr);
+    frame.set_update_rect(rtc::Optional<VideoFrame::UpdateRect>(unchanged));
+    video_source_.IncomingCapturedFrame(frame);
+    sink_.WaitForEncodedFrame(ntp_time_ms);
+  }
+  vie_encoder_->Stop();
+}
+
+TEST_F(ViEEncoderTest, SkipsUnchangedFramesAfterRefinementInterval) {
+  test::ScopedFieldTrials field_trials("WebRTC-SkipUnchangedFrames/Enabled/");
+  ConfigureEncoder(video_encoder_config_.Copy(), true /* nack_enabled */);
+  vie_encoder_->OnBitrateUpdated(kTargetBitrateBps, 0, 0);
+  VideoFrame::UpdateRect unchanged = {0, 0, 0, 0};
+
+  video_source_.IncomingCapturedFrame(CreateFrame(1, nullptr));
+  sink_.WaitForEncodedFrame(1);
+
+  // Encoded to refine the quality of the last change.
+  VideoFrame frame = CreateFrame(2, nullptr);
+  frame.set_update_rect(rtc::Optional<VideoFrame::UpdateRect>(unchanged));
+  video_source_.IncomingCapturedFrame(frame);
+  sink_.WaitForEncodedFrame(2);
+
+  // Encoded since no frame was encoded for a whole interval.
+  SleepMs(ViEEncoder::kUnchangedFrameIntervalMs);
+  frame = CreateFrame(3, nullptr);
+  frame.set_update_rect(rtc::Optional<VideoFrame::UpdateRect>(unchanged));
+  video_source_.IncomingCapturedFrame(frame);
+  sink_.WaitForEncodedFrame(3);
+
+  // Skipped.
+  rtc::Event frame_destroyed_event(false, false);
+  frame = CreateFrame(4, &frame_destroyed_event);
+  frame.set_update_rect(rtc::Optional<VideoFrame::UpdateRect>(unchanged));
+  video_source_.IncomingCapturedFrame(frame);
+  frame = CreateFrame(5, nullptr);
+  EXPECT_TRUE(frame_destroyed_event.Wait(kDefaultTimeoutMs));
+
+  // Encoded since a key frame was requested.
+  vie_encoder_->SendKeyFrame();
+  frame.set_update_rect(rtc::Optional<VideoFrame::UpdateRect>(unchanged));
+  video_source_.IncomingCapturedFrame(frame);
+  sink_.WaitForEncodedFrame(5);
+
+  // Changed frames are always encoded.
+  frame = CreateFrame(6, nullptr);
+  frame.set_update_rect(
+      rtc::Optional<VideoFrame::UpdateRect>({10, 10, 16, 16}));
+  video_source_.IncomingCapturedFrame(frame);
+  sink_.WaitForEncodedFrame(6);
+  vie_encoder_->Stop();
+}
+
 TEST_F(ViEEncoderTest, DropsFramesBeforeFirstOnBitrateUpdated) {
   // Dropped since no target bitrate has been set.
   rtc::Event frame_destroyed_event(false, false);
@@ -354,6 +424,24 @@ TEST_F(ViEEncoderTest, DropsFramesWhenRateSetToZero) {
   vie_encoder_->Stop();
 }
 
+TEST_F(ViEEncoderTest, CoalescesKeyFrameRequestsWithinRtt) {
+  const int64_t kRttMs = 1000;
+  vie_encoder_->OnBitrateUpdated(kTargetBitrateBps, 0, kRttMs);
+  video_source_.IncomingCapturedFrame(CreateFrame(1, nullptr));
+  sink_.WaitForEncodedFrame(1);
+  EXPECT_EQ(kVideoFrameKey, sink_.last_frame_type());
+  video_source_.IncomingCapturedFrame(CreateFrame(2, nullptr));
+  sink_.WaitForEncodedFrame(2);
+  EXPECT_EQ(kVideoFrameDelta, sink_.last_frame_type());
+
+  // Sent before the receiver could have gotten the first key frame.
+  vie_encoder_->OnReceivedIntraFrameRequest(0);
+  video_source_.IncomingCapturedFrame(CreateFrame(3, nullptr));
+  sink_.WaitForEncodedFrame(3);
+  EXPECT_EQ(kVideoFrameDelta, sink_.last_frame_type());
+  vie_encoder_->Stop();
+}
+
 TEST_F(ViEEncoderTest, DropsFramesWithSameOrOldNtpTimestamp) {
   vie_encoder_->OnBitrateUpdated(kTargetBitrateBps, 0, 0);
   video_source_.IncomingCapturedFrame(CreateFrame(1, nullptr));
@@ -937,6 +1025,49 @@ TEST_F(ViEEncoderTest, ScalingUpAndDownDoesNothingWithMaintainResolution) {
   vie_encoder_->Stop();
 }
 
+TEST_F(ViEEncoderTest, CpuOveruseLimitsFramerateWithMaintainResolution) {
+  const int kTargetBitrateBps = 100000;
+  int frame_width = 1280;
+  int frame_height = 720;
+  vie_encoder_->OnBitrateUpdated(kTargetBitrateBps, 0, 0);
+
+  test::FrameForwarder new_video_source;
+  vie_encoder_->SetSource(
+      &new_video_source,
+      VideoSendStream::DegradationPreference::kMaintainResolution);
+  EXPECT_FALSE(new_video_source.sink_wants().max_framerate_fps);
+
+  new_video_source.IncomingCapturedFrame(
+      CreateFrame(1000, frame_width, frame_height));
+  sink_.WaitForEncodedFrame(1000);
+
+  // Trigger CPU overuse, the source is asked for two thirds of the max
+  // framerate of 30 fps and the resolution is left alone.
+  vie_encoder_->TriggerCpuOveruse();
+  EXPECT_EQ(rtc::Optional<int>(20),
+            new_video_source.sink_wants().max_framerate_fps);
+  EXPECT_FALSE(new_video_source.sink_wants().max_pixel_count);
+
+  // Frames faster than that are dropped before they reach the encoder.
+  new_video_source.IncomingCapturedFrame(
+      CreateFrame(2000, frame_width, frame_height));
+  sink_.WaitForEncodedFrame(2000);
+  new_video_source.IncomingCapturedFrame(
+      CreateFrame(2010, frame_width, frame_height));
+  new_video_source.IncomingCapturedFrame(
+      CreateFrame(2100, frame_width, frame_height));
+  sink_.WaitForEncodedFrame(2100);
+
+  // Trigger CPU normal use, the framerate is no longer limited.
+  vie_encoder_->TriggerCpuNormalUsage();
+  EXPECT_FALSE(new_video_source.sink_wants().max_framerate_fps);
+  new_video_source.IncomingCapturedFrame(
+      CreateFrame(2110, frame_width, frame_height));
+  sink_.WaitForEncodedFrame(2110);
+
+  vie_encoder_->Stop();
+}
+
 TEST_F(ViEEncoderTest, DoesNotScaleBelowSetLimit) {
   const int kTargetBitrateBps = 100000;
   int frame_width = 1280;
@@ -117,6 +117,16 @@ class VideoEncoder {
                              int32_t number_of_cores,
                              size_t max_payload_size) = 0;
 
+  // Applies new settings to an initialized encoder without a new InitEncode(),
+  // keeping its rate control and reference state. Encoders that can't apply
+  // |codec_settings| in place return a negative value, in which case the
+  // caller reinitializes them instead.
+  //
+  // Return value                : WEBRTC_VIDEO_CODEC_OK if OK, < 0 otherwise.
+  virtual int32_t ReconfigureEncode(const VideoCodec* codec_settings) {
+    return -1;
+  }
+
   // Register an encode complete callback object.
   //
   // Input:
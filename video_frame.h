@@ -60,6 +60,9 @@ class EncodedImage {
   bool _completeFrame = false;
   AdaptReason adapt_reason_;
   int qp_ = -1;  // Quantizer value.
+  // Time spent encoding this image, -1 if the encoder doesn't measure it per
+  // image.
+  int encode_time_ms_ = -1;
 
   // When an application indicates non-zero values here, it is taken as an
   // indication that all future frames will be constrained with those limits
@@ -49,6 +49,11 @@ class VideoReceiveStream {
     // parameters. It is the same as cricket::CodecParameterMap used in
     // cricket::VideoCodec.
     std::map<std::string, std::string> codec_params;
+
+    // Number of CPU cores the decoder may use to decode a frame, e.g. to
+    // decode the slices of an H.264 frame in parallel. Capped by the number
+    // of cores given to the call.
+    int number_of_cores = 1;
   };
 
   struct Stats {
@@ -74,6 +79,18 @@ class VideoReceiveStream {
 
     int total_bitrate_bps = 0;
     int discarded_packets = 0;
+    // Media packets recovered by ULPFEC or FlexFEC, by the temporal layer of
+    // their frame marking; packets without one count as layer 0.
+    uint32_t fec_recovered_packets[kMaxTemporalStreams] = {};
+
+    // Encoded frame buffers allocated from the heap and reused from the pool
+    // of the stream, and the bytes held by its free buffers.
+    uint32_t encoded_buffer_allocations = 0;
+    uint32_t encoded_buffer_reuses = 0;
+    size_t encoded_buffer_pool_bytes = 0;
+
+    // Only set when end to end media encryption is enabled.
+    rtc::Optional<MediaCryptoStats> media_crypto;
 
     int width = 0;
     int height = 0;
@@ -208,6 +225,15 @@ class VideoReceiveStream {
   // When a stream is stopped, it can't receive, process or deliver packets.
   virtual void Stop() = 0;
 
+  // Tells the stream whether the frames delivered to |renderer| are shown.
+  // While they aren't, e.g. for a minimized or off-screen participant, only
+  // key frames and frames of the base temporal layer are decoded, given that
+  // the sender signals temporal layers with the FrameMarking extension. With
+  // PERC media crypto the upper layers are not decrypted meanwhile either, so
+  // decoding them resumes from the next frame that only references the base
+  // layer.
+  virtual void SetSinkActive(bool active) = 0;
+
   // TODO(pbos): Add info on currently-received codec to Stats.
   virtual Stats GetStats() const = 0;
 
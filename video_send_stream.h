@@ -31,6 +31,14 @@ class VideoEncoder;
 
 class VideoSendStream {
  public:
+  // Percentiles of the time spent in a stage of the send path, -1 if no
+  // packet of the stream went through it yet.
+  struct LatencyPercentiles {
+    int64_t p50 = -1;
+    int64_t p95 = -1;
+    int64_t p99 = -1;
+  };
+
   struct StreamStats {
     std::string ToString() const;
 
@@ -44,6 +52,14 @@ class VideoSendStream {
     int retransmit_bitrate_bps = 0;
     int avg_delay_ms = 0;
     int max_delay_ms = 0;
+    // Only set by encoders that measure the encode time of each layer.
+    int avg_encode_time_ms = 0;
+    LatencyPercentiles pacer_queue_time_ms;
+    // Only set when end to end media encryption is enabled.
+    LatencyPercentiles media_encryption_time_us;
+    rtc::Optional<MediaCryptoStats> media_crypto;
+    // From the packet being sent to the transport until it leaves the socket.
+    LatencyPercentiles send_delay_ms;
     StreamDataCounters rtp_stats;
     RtcpPacketTypeCounter rtcp_packet_type_counts;
     RtcpStatistics rtcp_stats;
@@ -72,6 +88,10 @@ class VideoSendStream {
     // Total number of times resolution as been requested to be changed due to
     // CPU adaptation.
     int number_of_cpu_adapt_changes = 0;
+    // Padding the pacer did not send because of suppress_padding_in_alr. The
+    // pacer is shared by all the streams of the call, so this is not specific
+    // to this stream.
+    uint64_t alr_suppressed_padding_bytes = 0;
     std::map<uint32_t, StreamStats> substreams;
   };
 
@@ -199,6 +219,12 @@ class VideoSendStream {
     // Enables periodic bandwidth probing in application-limited region.
     bool periodic_alr_bandwidth_probing = false;
 
+    // Stops the padding sent to keep the bandwidth estimate up once the
+    // sender has been application-limited for a while, and validates the
+    // estimate with periodic probing instead. Saves the padding bandwidth on
+    // metered links, at the cost of a slower ramp up when the media resumes.
+    bool suppress_padding_in_alr = false;
+
     // End to End media encryption
     bool media_crypto_enabled = false;
     MediaCryptoKey media_crypto_key;
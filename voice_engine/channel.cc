@@ -11,6 +11,7 @@
 #include "webrtc/voice_engine/channel.h"
 
 #include <algorithm>
+#include <sstream>
 #include <utility>
 
 #include "webrtc/audio/utility/audio_frame_operations.h"
@@ -390,6 +391,13 @@ int32_t Channel::SendData(FrameType frameType,
                " payloadSize=%" PRIuS ", fragmentation=0x%x)",
                frameType, payloadType, timeStamp, payloadSize, fragmentation);
 
+  // Send the audio on the channels sharing it, with their own timestamps.
+  for (const auto& follower : shared_encoding_followers_) {
+    follower.first->SendData(frameType, payloadType,
+                             timeStamp + follower.second, payloadData,
+                             payloadSize, fragmentation);
+  }
+
   if (_includeAudioLevelIndication) {
     // Store current audio level in the RTP/RTCP module.
     // The level will be used in combination with voice-activity state
@@ -759,6 +767,18 @@ AudioMixer::Source::AudioFrameInfo Channel::GetAudioFrameWithInfo(
   return new_audio_frame_info;
 }
 
+void Channel::SkipAudioFrame(int sample_rate_hz, AudioFrame* audio_frame) {
+  // NetEq has to decode to keep the decoder state, but the audio won't be
+  // mixed, so don't resample it to the mixing rate.
+  audio_frame->sample_rate_hz_ = -1;
+  GetAudioFrameWithMuted(-1, audio_frame);
+}
+
+rtc::Optional<int> Channel::ReceivedAudioLevelDbov() const {
+  rtc::CritScope lock(&received_audio_level_lock_);
+  return received_audio_level_dbov_;
+}
+
 int32_t Channel::NeededFrequency(int32_t id) const {
   WEBRTC_TRACE(kTraceStream, kTraceVoice, VoEId(_instanceId, _channelId),
                "Channel::NeededFrequency(id=%d)", id);
@@ -1151,6 +1171,11 @@ void Channel::SetSink(std::unique_ptr<AudioSinkInterface> sink) {
   audio_sink_ = std::move(sink);
 }
 
+void Channel::SetAudioLevelSink(AudioLevelSinkInterface* sink) {
+  rtc::CritScope lock(&received_audio_level_lock_);
+  audio_level_sink_ = sink;
+}
+
 const rtc::scoped_refptr<AudioDecoderFactory>&
 Channel::GetAudioDecoderFactory() const {
   return decoder_factory_;
@@ -1341,6 +1366,8 @@ void Channel::SetBitRate(int bitrate_bps, int64_t probing_interval_ms) {
     }
   });
   retransmission_rate_limiter_->SetMaxRate(bitrate_bps);
+  rtc::CritScope lock(&encoder_settings_lock_);
+  send_bitrate_bps_ = bitrate_bps;
 }
 
 void Channel::OnIncomingFractionLoss(int fraction_lost) {
@@ -1540,6 +1567,8 @@ bool Channel::EnableAudioNetworkAdaptor(const std::string& config_string) {
           config_string, event_log_proxy_.get(), Clock::GetRealTimeClock());
     }
   });
+  rtc::CritScope lock(&encoder_settings_lock_);
+  audio_network_adaptor_enabled_ = success;
   return success;
 }
 
@@ -1548,6 +1577,8 @@ void Channel::DisableAudioNetworkAdaptor() {
     if (*encoder)
       (*encoder)->DisableAudioNetworkAdaptor();
   });
+  rtc::CritScope lock(&encoder_settings_lock_);
+  audio_network_adaptor_enabled_ = false;
 }
 
 void Channel::SetReceiverFrameLengthRange(int min_frame_length_ms,
@@ -1601,19 +1632,36 @@ int32_t Channel::ReceivedRTPPacket(const uint8_t* received_packet,
   WEBRTC_TRACE(kTraceStream, kTraceVoice, VoEId(_instanceId, _channelId),
                "Channel::ReceivedRTPPacket()");
 
-  // Store playout timestamp for the received RTP packet
-  UpdatePlayoutTimestamp(false);
-
   RTPHeader header;
   if (!rtp_header_parser_->Parse(received_packet, length, &header)) {
     WEBRTC_TRACE(webrtc::kTraceDebug, webrtc::kTraceVoice, _channelId,
                  "Incoming packet: invalid RTP header");
     return -1;
   }
+  return ReceivedRTPPacket(received_packet, length, header, packet_time);
+}
+
+int32_t Channel::ReceivedRTPPacket(const uint8_t* received_packet,
+                                   size_t length,
+                                   const RTPHeader& parsed_header,
+                                   const PacketTime& packet_time) {
+  // Store playout timestamp for the received RTP packet
+  UpdatePlayoutTimestamp(false);
+
+  RTPHeader header = parsed_header;
   header.payload_type_frequency =
       rtp_payload_registry_->GetPayloadTypeFrequency(header.payloadType);
   if (header.payload_type_frequency < 0)
     return -1;
+  if (header.extension.hasAudioLevel) {
+    rtc::CritScope lock(&received_audio_level_lock_);
+    received_audio_level_dbov_ =
+        rtc::Optional<int>(header.extension.audioLevel);
+    if (audio_level_sink_) {
+      audio_level_sink_->OnAudioLevel(header.ssrc, header.extension.audioLevel,
+                                      header.extension.voiceActivity);
+    }
+  }
   bool in_order = IsPacketInOrder(header);
   rtp_receive_statistics_->IncomingPacket(
       header, length, IsPacketRetransmitted(header, in_order));
@@ -2809,7 +2857,23 @@ uint32_t Channel::PrepareEncodeAndSend(int mixingFrequency) {
   return 0;
 }
 
+void Channel::PrepareSharedEncodeAndSend(const AudioFrame& audio_frame) {
+  // SharedEncodingKey() rules out muted channels, so the audio is used as is.
+  if (_includeAudioLevelIndication) {
+    size_t length =
+        audio_frame.samples_per_channel_ * audio_frame.num_channels_;
+    RTC_CHECK_LE(length, sizeof(audio_frame.data_));
+    rms_level_.Analyze(
+        rtc::ArrayView<const int16_t>(audio_frame.data_, length));
+  }
+  previous_frame_muted_ = false;
+}
+
 uint32_t Channel::EncodeAndSend() {
+  return EncodeAndSend(std::vector<Channel*>());
+}
+
+uint32_t Channel::EncodeAndSend(const std::vector<Channel*>& followers) {
   WEBRTC_TRACE(kTraceStream, kTraceVoice, VoEId(_instanceId, _channelId),
                "Channel::EncodeAndSend()");
 
@@ -2826,17 +2890,59 @@ uint32_t Channel::EncodeAndSend() {
 
   // The ACM resamples internally.
   _audioFrame.timestamp_ = _timeStamp;
+  for (Channel* follower : followers) {
+    shared_encoding_followers_.push_back(
+        std::make_pair(follower, follower->_timeStamp - _timeStamp));
+  }
   // This call will trigger AudioPacketizationCallback::SendData if encoding
   // is done and payload is ready for packetization and transmission.
   // Otherwise, it will return without invoking the callback.
-  if (audio_coding_->Add10MsData((AudioFrame&)_audioFrame) < 0) {
+  const int result = audio_coding_->Add10MsData((AudioFrame&)_audioFrame);
+  shared_encoding_followers_.clear();
+  if (result < 0) {
     WEBRTC_TRACE(kTraceError, kTraceVoice, VoEId(_instanceId, _channelId),
                  "Channel::EncodeAndSend() ACM encoding failed");
     return 0xFFFFFFFF;
   }
 
-  _timeStamp += static_cast<uint32_t>(_audioFrame.samples_per_channel_);
-  return 0;
+  const uint32_t samples =
+      static_cast<uint32_t>(_audioFrame.samples_per_channel_);
+  _timeStamp += samples;
+  for (Channel* follower : followers)
+    follower->_timeStamp += samples;
+  return 0;
+}
+
+rtc::Optional<std::string> Channel::SharedEncodingKey() {
+  // Audio altered by the channel itself before encoding can't be shared,
+  // including the fade in after unmuting.
+  const ChannelState::State state = channel_state_.Get();
+  if (state.input_file_playing || state.input_external_media || InputMute() ||
+      previous_frame_muted_) {
+    return rtc::Optional<std::string>();
+  }
+
+  const rtc::Optional<CodecInst> codec = audio_coding_->SendCodec();
+  if (!codec)
+    return rtc::Optional<std::string>();
+  bool dtx_enabled;
+  bool vad_enabled;
+  ACMVADMode vad_mode;
+  if (audio_coding_->VAD(&dtx_enabled, &vad_enabled, &vad_mode) != 0)
+    return rtc::Optional<std::string>();
+
+  rtc::CritScope lock(&encoder_settings_lock_);
+  // The network adaptor adapts the encoder to the network of each channel.
+  if (audio_network_adaptor_enabled_)
+    return rtc::Optional<std::string>();
+
+  std::ostringstream key;
+  key << codec->plname << "/" << codec->pltype << "/" << codec->plfreq << "/"
+      << codec->pacsize << "/" << codec->channels << "/" << codec->rate << "/"
+      << send_bitrate_bps_ << "/" << audio_coding_->REDStatus() << "/"
+      << audio_coding_->CodecFEC() << "/" << dtx_enabled << "/" << vad_enabled
+      << "/" << vad_mode;
+  return rtc::Optional<std::string>(key.str());
 }
 
 void Channel::set_associate_send_channel(const ChannelOwner& channel) {
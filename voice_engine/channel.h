@@ -12,8 +12,12 @@
 #define WEBRTC_VOICE_ENGINE_CHANNEL_H_
 
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "webrtc/api/audio/audio_mixer.h"
+#include "webrtc/api/call/audio_level_sink.h"
 #include "webrtc/api/call/audio_sink.h"
 #include "webrtc/base/criticalsection.h"
 #include "webrtc/base/optional.h"
@@ -170,6 +174,9 @@ class Channel
   int32_t UpdateLocalTimeStamp();
 
   void SetSink(std::unique_ptr<AudioSinkInterface> sink);
+  // Sets a sink that receives the audio level header extension of every
+  // received packet, on the packet receive path. Passing null clears it.
+  void SetAudioLevelSink(AudioLevelSinkInterface* sink);
 
   // TODO(ossu): Don't use! It's only here to confirm that the decoder factory
   // passed into AudioReceiveStream is the same as the one set when creating the
@@ -212,6 +219,13 @@ class Channel
   int32_t ReceivedRTPPacket(const uint8_t* received_packet,
                             size_t length,
                             const PacketTime& packet_time);
+  // Same as above for a packet whose |header| the caller has already parsed
+  // with the same header extensions registered, so that it is not parsed a
+  // second time.
+  int32_t ReceivedRTPPacket(const uint8_t* received_packet,
+                            size_t length,
+                            const RTPHeader& header,
+                            const PacketTime& packet_time);
   int32_t ReceivedRTCPPacket(const uint8_t* data, size_t length);
 
   // VoEFile
@@ -375,6 +389,10 @@ class Channel
   AudioMixer::Source::AudioFrameInfo GetAudioFrameWithInfo(
       int sample_rate_hz,
       AudioFrame* audio_frame);
+  void SkipAudioFrame(int sample_rate_hz, AudioFrame* audio_frame);
+  // The audio level of the last received packet, if it had the audio level
+  // header extension.
+  rtc::Optional<int> ReceivedAudioLevelDbov() const;
 
   // From FileCallback
   void PlayNotification(int32_t id, uint32_t durationMs) override;
@@ -402,7 +420,21 @@ class Channel
                    size_t number_of_frames,
                    size_t number_of_channels);
   uint32_t PrepareEncodeAndSend(int mixingFrequency);
+  // Replaces Demultiplex() and PrepareEncodeAndSend() for a channel sending
+  // the audio encoded by another channel of the same SharedEncodingKey(),
+  // updating the state that follows the captured |audio_frame| without
+  // copying it.
+  void PrepareSharedEncodeAndSend(const AudioFrame& audio_frame);
   uint32_t EncodeAndSend();
+  // Encodes the audio like EncodeAndSend(), and also sends the encoded audio
+  // on |followers|, which must have the same SharedEncodingKey() as this
+  // channel and aren't encoded themselves.
+  uint32_t EncodeAndSend(const std::vector<Channel*>& followers);
+  // Returns a description of what the encoded audio of the channel depends
+  // on, if the audio can be encoded once for all sending channels having the
+  // same description. Adaptation of the encoder to packet loss and RTT
+  // follows the channel doing the encoding.
+  rtc::Optional<std::string> SharedEncodingKey();
 
   // Associate to a send channel.
   // Used for obtaining RTT for a receive-only channel.
@@ -506,6 +538,23 @@ protected:
   // frame.
   int64_t capture_start_ntp_time_ms_ GUARDED_BY(ts_stats_lock_);
 
+  rtc::CriticalSection received_audio_level_lock_;
+  rtc::Optional<int> received_audio_level_dbov_
+      GUARDED_BY(received_audio_level_lock_);
+  AudioLevelSinkInterface* audio_level_sink_
+      GUARDED_BY(received_audio_level_lock_) = nullptr;
+
+  // Encoder settings that aren't available from |audio_coding_|, used by
+  // SharedEncodingKey().
+  rtc::CriticalSection encoder_settings_lock_;
+  int send_bitrate_bps_ GUARDED_BY(encoder_settings_lock_) = 0;
+  bool audio_network_adaptor_enabled_ GUARDED_BY(encoder_settings_lock_) =
+      false;
+  // The channels sending the audio encoded by this channel, with the offset
+  // of their RTP timestamps. Only accessed from EncodeAndSend() and the
+  // SendData() it triggers.
+  std::vector<std::pair<Channel*, uint32_t>> shared_encoding_followers_;
+
   // uses
   Statistics* _engineStatisticsPtr;
   OutputMixer* _outputMixerPtr;
@@ -522,7 +571,7 @@ protected:
   bool _mixFileWithMicrophone;
   // VoEVolumeControl
   bool input_mute_ GUARDED_BY(volume_settings_critsect_);
-  bool previous_frame_muted_;  // Only accessed from PrepareEncodeAndSend().
+  bool previous_frame_muted_;  // Only accessed on the capture thread.
   float _panLeft GUARDED_BY(volume_settings_critsect_);
   float _panRight GUARDED_BY(volume_settings_critsect_);
   float _outputGain GUARDED_BY(volume_settings_critsect_);
@@ -158,6 +158,11 @@ void ChannelProxy::SetSink(std::unique_ptr<AudioSinkInterface> sink) {
   channel()->SetSink(std::move(sink));
 }
 
+void ChannelProxy::SetAudioLevelSink(AudioLevelSinkInterface* sink) {
+  RTC_DCHECK(thread_checker_.CalledOnValidThread());
+  channel()->SetAudioLevelSink(sink);
+}
+
 void ChannelProxy::SetInputMute(bool muted) {
   RTC_DCHECK(thread_checker_.CalledOnValidThread());
   int error = channel()->SetInputMute(muted);
@@ -177,9 +182,11 @@ void ChannelProxy::DeRegisterExternalTransport() {
 
 bool ChannelProxy::ReceivedRTPPacket(const uint8_t* packet,
                                      size_t length,
+                                     const RTPHeader& header,
                                      const PacketTime& packet_time) {
   // May be called on either worker thread or network thread.
-  return channel()->ReceivedRTPPacket(packet, length, packet_time) == 0;
+  return channel()->ReceivedRTPPacket(packet, length, header, packet_time) ==
+         0;
 }
 
 bool ChannelProxy::ReceivedRTCPPacket(const uint8_t* packet, size_t length) {
@@ -229,6 +236,16 @@ AudioMixer::Source::AudioFrameInfo ChannelProxy::GetAudioFrameWithInfo(
   return channel()->GetAudioFrameWithInfo(sample_rate_hz, audio_frame);
 }
 
+void ChannelProxy::SkipAudioFrame(int sample_rate_hz,
+                                  AudioFrame* audio_frame) {
+  RTC_DCHECK_RUNS_SERIALIZED(&race_checker_);
+  channel()->SkipAudioFrame(sample_rate_hz, audio_frame);
+}
+
+rtc::Optional<int> ChannelProxy::ReceivedAudioLevelDbov() const {
+  return channel()->ReceivedAudioLevelDbov();
+}
+
 int ChannelProxy::NeededFrequency() const {
   return static_cast<int>(channel()->NeededFrequency(-1));
 }
@@ -24,6 +24,7 @@
 
 namespace webrtc {
 
+class AudioLevelSinkInterface;
 class AudioSinkInterface;
 class PacketRouter;
 class RtcEventLog;
@@ -75,11 +76,15 @@ class ChannelProxy {
   virtual bool SendTelephoneEventOutband(int event, int duration_ms);
   virtual void SetBitrate(int bitrate_bps, int64_t probing_interval_ms);
   virtual void SetSink(std::unique_ptr<AudioSinkInterface> sink);
+  virtual void SetAudioLevelSink(AudioLevelSinkInterface* sink);
   virtual void SetInputMute(bool muted);
   virtual void RegisterExternalTransport(Transport* transport);
   virtual void DeRegisterExternalTransport();
+  // |header| must have been parsed with the same header extensions that are
+  // registered on the channel.
   virtual bool ReceivedRTPPacket(const uint8_t* packet,
                                  size_t length,
+                                 const RTPHeader& header,
                                  const PacketTime& packet_time);
   virtual bool ReceivedRTCPPacket(const uint8_t* packet, size_t length);
   virtual const rtc::scoped_refptr<AudioDecoderFactory>&
@@ -93,6 +98,8 @@ class ChannelProxy {
   virtual AudioMixer::Source::AudioFrameInfo GetAudioFrameWithInfo(
       int sample_rate_hz,
       AudioFrame* audio_frame);
+  virtual void SkipAudioFrame(int sample_rate_hz, AudioFrame* audio_frame);
+  virtual rtc::Optional<int> ReceivedAudioLevelDbov() const;
   virtual int NeededFrequency() const;
   virtual void SetTransportOverhead(int transport_overhead_per_packet);
   virtual void AssociateSendChannel(const ChannelProxy& send_channel_proxy);
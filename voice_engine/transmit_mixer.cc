@@ -10,12 +10,20 @@
 
 #include "webrtc/voice_engine/transmit_mixer.h"
 
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <string>
 
 #include "webrtc/audio/utility/audio_frame_operations.h"
+#include "webrtc/base/atomicops.h"
+#include "webrtc/base/checks.h"
+#include "webrtc/base/event.h"
 #include "webrtc/base/format_macros.h"
 #include "webrtc/base/logging.h"
+#include "webrtc/system_wrappers/include/cpu_info.h"
 #include "webrtc/system_wrappers/include/event_wrapper.h"
+#include "webrtc/system_wrappers/include/field_trial.h"
 #include "webrtc/system_wrappers/include/trace.h"
 #include "webrtc/voice_engine/channel.h"
 #include "webrtc/voice_engine/channel_manager.h"
@@ -26,6 +34,13 @@
 
 namespace webrtc {
 namespace voe {
+namespace {
+
+// The maximum number of threads encoding audio in parallel with the capture
+// thread.
+const size_t kMaxEncoderQueues = 3;
+
+}  // namespace
 
 // TODO(ajm): The thread safety of this is dubious...
 void
@@ -203,7 +218,10 @@ TransmitMixer::TransmitMixer(uint32_t instanceId) :
     external_preproc_ptr_(NULL),
     _mute(false),
     stereo_codec_(false),
-    swap_stereo_channels_(false)
+    swap_stereo_channels_(false),
+    shared_encoding_enabled_(
+        webrtc::field_trial::FindFullName("WebRTC-Audio-SharedEncoding") ==
+        "Enabled")
 {
     WEBRTC_TRACE(kTraceMemory, kTraceVoice, VoEId(_instanceId, -1),
                  "TransmitMixer::TransmitMixer() - ctor");
@@ -388,32 +406,68 @@ TransmitMixer::DemuxAndMix()
     WEBRTC_TRACE(kTraceStream, kTraceVoice, VoEId(_instanceId, -1),
                  "TransmitMixer::DemuxAndMix()");
 
+    std::vector<ChannelOwner> channels;
     for (ChannelManager::Iterator it(_channelManagerPtr); it.IsValid();
          it.Increment())
     {
         Channel* channelPtr = it.GetChannel();
         if (channelPtr->Sending())
         {
-            // Demultiplex makes a copy of its input.
-            channelPtr->Demultiplex(_audioFrame);
-            channelPtr->PrepareEncodeAndSend(_audioFrame.sample_rate_hz_);
+            channels.push_back(
+                _channelManagerPtr->GetChannel(channelPtr->ChannelId()));
         }
     }
+    DemuxAndMix(channels);
     return 0;
 }
 
 void TransmitMixer::DemuxAndMix(const int voe_channels[],
                                 size_t number_of_voe_channels) {
+  std::vector<ChannelOwner> channels;
   for (size_t i = 0; i < number_of_voe_channels; ++i) {
     voe::ChannelOwner ch = _channelManagerPtr->GetChannel(voe_channels[i]);
     voe::Channel* channel_ptr = ch.channel();
-    if (channel_ptr) {
-      if (channel_ptr->Sending()) {
-        // Demultiplex makes a copy of its input.
-        channel_ptr->Demultiplex(_audioFrame);
-        channel_ptr->PrepareEncodeAndSend(_audioFrame.sample_rate_hz_);
+    if (channel_ptr && channel_ptr->Sending())
+      channels.push_back(ch);
+  }
+  DemuxAndMix(channels);
+}
+
+void TransmitMixer::DemuxAndMix(const std::vector<ChannelOwner>& channels) {
+  if (!shared_encoding_enabled_) {
+    for (const ChannelOwner& owner : channels) {
+      // Demultiplex makes a copy of its input.
+      owner.channel()->Demultiplex(_audioFrame);
+      owner.channel()->PrepareEncodeAndSend(_audioFrame.sample_rate_hz_);
+    }
+    return;
+  }
+
+  // Group the channels sharing their encoded audio, the first channel of each
+  // group encoding it. Only that one needs a copy of the audio, the others
+  // just follow it.
+  send_channels_ = channels;
+  send_groups_.clear();
+  std::map<std::string, size_t> group_indices;
+  for (const ChannelOwner& owner : send_channels_) {
+    Channel* channel = owner.channel();
+    const rtc::Optional<std::string> key = channel->SharedEncodingKey();
+    if (key) {
+      auto it = group_indices.find(*key);
+      if (it != group_indices.end()) {
+        send_groups_[it->second].push_back(channel);
+        continue;
       }
+      group_indices[*key] = send_groups_.size();
     }
+    send_groups_.push_back(std::vector<Channel*>(1, channel));
+  }
+
+  for (const std::vector<Channel*>& group : send_groups_) {
+    group[0]->Demultiplex(_audioFrame);
+    group[0]->PrepareEncodeAndSend(_audioFrame.sample_rate_hz_);
+    for (size_t i = 1; i < group.size(); ++i)
+      group[i]->PrepareSharedEncodeAndSend(_audioFrame);
   }
 }
 
@@ -423,6 +477,11 @@ TransmitMixer::EncodeAndSend()
     WEBRTC_TRACE(kTraceStream, kTraceVoice, VoEId(_instanceId, -1),
                  "TransmitMixer::EncodeAndSend()");
 
+    if (shared_encoding_enabled_)
+    {
+        EncodeAndSendGroups();
+        return 0;
+    }
     for (ChannelManager::Iterator it(_channelManagerPtr); it.IsValid();
          it.Increment())
     {
@@ -437,6 +496,22 @@ TransmitMixer::EncodeAndSend()
 
 void TransmitMixer::EncodeAndSend(const int voe_channels[],
                                   size_t number_of_voe_channels) {
+  if (shared_encoding_enabled_) {
+    // Only the first channel of each group got the audio, so the groups
+    // can't be made here and must be those of DemuxAndMix() for the same
+    // channels.
+#if RTC_DCHECK_IS_ON
+    const int* voe_channels_end = voe_channels + number_of_voe_channels;
+    for (const ChannelOwner& owner : send_channels_) {
+      RTC_DCHECK(std::find(voe_channels, voe_channels_end,
+                           owner.channel()->ChannelId()) != voe_channels_end)
+          << "Channel " << owner.channel()->ChannelId()
+          << " was demuxed but isn't encoded.";
+    }
+#endif
+    EncodeAndSendGroups();
+    return;
+  }
   for (size_t i = 0; i < number_of_voe_channels; ++i) {
     voe::ChannelOwner ch = _channelManagerPtr->GetChannel(voe_channels[i]);
     voe::Channel* channel_ptr = ch.channel();
@@ -445,6 +520,50 @@ void TransmitMixer::EncodeAndSend(const int voe_channels[],
   }
 }
 
+void TransmitMixer::EncodeAndSendGroups() {
+  if (send_groups_.size() > 1) {
+    EncodeInParallel(send_groups_);
+  } else {
+    for (const std::vector<Channel*>& group : send_groups_) {
+      group[0]->EncodeAndSend(
+          std::vector<Channel*>(group.begin() + 1, group.end()));
+    }
+  }
+  send_groups_.clear();
+  send_channels_.clear();
+}
+
+void TransmitMixer::EncodeInParallel(
+    const std::vector<std::vector<Channel*>>& groups) {
+  const size_t num_cores = CpuInfo::DetectNumberOfCores();
+  const size_t num_queues = std::min(
+      {groups.size() - 1, kMaxEncoderQueues, num_cores > 0 ? num_cores - 1 : 0});
+  while (encoder_queues_.size() < num_queues)
+    encoder_queues_.emplace_back(new rtc::TaskQueue("AudioEncoderQueue"));
+
+  // Group i is encoded by queue i % (num_queues + 1) - 1, or by this thread
+  // when that's -1.
+  auto encode_groups = [&groups, num_queues](size_t first_group) {
+    for (size_t i = first_group; i < groups.size(); i += num_queues + 1) {
+      groups[i][0]->EncodeAndSend(
+          std::vector<Channel*>(groups[i].begin() + 1, groups[i].end()));
+    }
+  };
+  rtc::Event done(false, false);
+  volatile int remaining_queues = static_cast<int>(num_queues);
+  for (size_t i = 0; i < num_queues; ++i) {
+    encoder_queues_[i]->PostTask([&encode_groups, &done, &remaining_queues,
+                                  i]() {
+      encode_groups(i + 1);
+      if (rtc::AtomicOps::Decrement(&remaining_queues) == 0)
+        done.Set();
+    });
+  }
+  encode_groups(0);
+  if (num_queues > 0)
+    done.Wait(rtc::Event::kForever);
+}
+
 uint32_t TransmitMixer::CaptureLevel() const
 {
     return _captureLevel;
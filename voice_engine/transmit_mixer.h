@@ -12,8 +12,10 @@
 #define WEBRTC_VOICE_ENGINE_TRANSMIT_MIXER_H
 
 #include <memory>
+#include <vector>
 
 #include "webrtc/base/criticalsection.h"
+#include "webrtc/base/task_queue.h"
 #include "webrtc/common_audio/resampler/include/push_resampler.h"
 #include "webrtc/common_types.h"
 #include "webrtc/modules/audio_processing/typing_detection.h"
@@ -40,7 +42,9 @@ class VoEMediaProcess;
 
 namespace voe {
 
+class Channel;
 class ChannelManager;
+class ChannelOwner;
 class MixedAudio;
 class Statistics;
 
@@ -75,7 +79,8 @@ public:
 
     int32_t EncodeAndSend();
     // Used by the Chrome to pass the recording data to the specific VoE
-    // channels for encoding and sending to the network.
+    // channels for encoding and sending to the network. Must follow a
+    // DemuxAndMix() for the same channels.
     void EncodeAndSend(const int voe_channels[], size_t number_of_voe_channels);
 
     // Must be called on the same thread as PrepareDemux().
@@ -189,6 +194,18 @@ private:
     void ProcessAudio(int delay_ms, int clock_drift, int current_mic_level,
                       bool key_pressed);
 
+    // Passes the captured audio to the sending |channels|. If shared encoding
+    // is enabled, channels with the same Channel::SharedEncodingKey() are
+    // grouped in |send_groups_|, and only the first channel of each group
+    // gets a copy of the audio to encode for all of them.
+    void DemuxAndMix(const std::vector<ChannelOwner>& channels);
+    // Encodes and sends the audio of the groups made by the last DemuxAndMix(),
+    // the groups encoding different audio in parallel.
+    void EncodeAndSendGroups();
+    // Encodes the audio of |groups| of channels, each one in the first channel
+    // of the group, using |encoder_queues_| as well as the calling thread.
+    void EncodeInParallel(const std::vector<std::vector<Channel*>>& groups);
+
 #if WEBRTC_VOICE_ENGINE_TYPING_DETECTION
     void TypingDetection(bool keyPressed);
 #endif
@@ -233,6 +250,16 @@ private:
     bool _mute;
     bool stereo_codec_;
     bool swap_stereo_channels_;
+
+    const bool shared_encoding_enabled_;
+    // The sending channels grouped by DemuxAndMix() for EncodeAndSend(), and
+    // the references keeping them alive in between. Only accessed from the
+    // capture thread.
+    std::vector<ChannelOwner> send_channels_;
+    std::vector<std::vector<Channel*>> send_groups_;
+    // Queues encoding audio in parallel with the capture thread, created
+    // when first needed. Only accessed from the capture thread.
+    std::vector<std::unique_ptr<rtc::TaskQueue>> encoder_queues_;
 };
 
 }  // namespace voe